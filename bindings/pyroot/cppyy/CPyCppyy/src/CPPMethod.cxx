@@ -41,6 +41,8 @@ inline void CPyCppyy::CPPMethod::Copy_(const CPPMethod& /* other */)
 // do not copy caches
     fExecutor     = nullptr;
     fArgIndices   = nullptr;
+    fOffsetType   = (Cppyy::TCppType_t)0;
+    fOffset       = 0;
     fArgsRequired = -1;
 }
 
@@ -295,7 +297,7 @@ void CPyCppyy::CPPMethod::SetPyError_(PyObject* msg)
 CPyCppyy::CPPMethod::CPPMethod(
         Cppyy::TCppScope_t scope, Cppyy::TCppMethod_t method) :
     fMethod(method), fScope(scope), fExecutor(nullptr), fArgIndices(nullptr),
-    fArgsRequired(-1)
+    fOffsetType((Cppyy::TCppType_t)0), fOffset(0), fArgsRequired(-1)
 {
    // empty
 }
@@ -774,10 +776,18 @@ PyObject* CPyCppyy::CPPMethod::Call(
 // get its class
     Cppyy::TCppType_t derived = self->ObjectIsA();
 
-// calculate offset (the method expects 'this' to be an object of fScope)
+// calculate offset (the method expects 'this' to be an object of fScope); unless there
+// is a virtual base in between, it is the same for all objects of the derived type
     ptrdiff_t offset = 0;
-    if (derived && derived != fScope)
-        offset = Cppyy::GetBaseOffset(derived, fScope, object, 1 /* up-cast */);
+    if (derived && derived != fScope) {
+        if (derived == fOffsetType)
+            offset = fOffset;
+        else if ((offset = Cppyy::GetStaticBaseOffset(derived, fScope)) != -1) {
+            fOffsetType = derived;
+            fOffset     = offset;
+        } else
+            offset = Cppyy::GetBaseOffset(derived, fScope, object, 1 /* up-cast */);
+    }
 
 // actual call; recycle self instead of returning new object for same address objects
     CPPInstance* pyobj = (CPPInstance*)Execute(object, offset, ctxt);
@@ -80,6 +80,10 @@ private:
     std::vector<Converter*>     fConverters;
     std::map<std::string, int>* fArgIndices;
 
+// up-cast offset of the objects of the last seen derived type, if static
+    Cppyy::TCppType_t fOffsetType;
+    ptrdiff_t         fOffset;
+
 protected:
 // cached value that doubles as initialized flag (uninitialized if -1)
     int fArgsRequired;
@@ -1631,6 +1631,24 @@ bool CPyCppyy::NullptrConverter::SetArg(PyObject* pyobject, Parameter& para, Cal
 }
 
 
+//----------------------------------------------------------------------------
+// reuse the memory of the string buffers of the converters from call to call
+static inline void AssignString(std::string& buf, const char* cstr, Py_ssize_t len)
+{
+    buf.assign(cstr, len);
+}
+
+static inline void AssignString(TString& buf, const char* cstr, Py_ssize_t len)
+{
+    buf.Replace(0, buf.Length(), cstr, (Ssiz_t)len);
+}
+
+template<typename T>
+static inline void AssignString(T& buf, const char* cstr, Py_ssize_t len)
+{
+    buf = T(cstr, len);
+}
+
 //----------------------------------------------------------------------------
 #define CPPYY_IMPL_STRING_AS_PRIMITIVE_CONVERTER(name, type, F1, F2)         \
 CPyCppyy::name##Converter::name##Converter(bool keepControl) :               \
@@ -1642,7 +1660,7 @@ bool CPyCppyy::name##Converter::SetArg(                                      \
     Py_ssize_t len;                                                          \
     const char* cstr = CPyCppyy_PyText_AsStringAndSize(pyobject, &len);      \
     if (cstr) {                                                              \
-        fBuffer = type(cstr, len);                                           \
+        AssignString(fBuffer, cstr, len);                                    \
         para.fValue.fVoidp = &fBuffer;                                       \
         para.fTypeCode = 'V';                                                \
         return true;                                                         \
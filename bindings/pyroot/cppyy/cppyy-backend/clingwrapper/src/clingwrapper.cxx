@@ -1315,6 +1315,44 @@ ptrdiff_t Cppyy::GetBaseOffset(TCppType_t derived, TCppType_t base,
     return (ptrdiff_t)(direction < 0 ? -offset : offset);
 }
 
+static ptrdiff_t StaticBaseOffset(TClass* derived, TClass* base)
+{
+// walk the non-virtual inheritance paths, -1 if base is not found in any of them
+    TList* bases = derived->GetListOfBases();
+    if (!bases)
+        return (ptrdiff_t)-1;
+
+    for (auto obj : *bases) {
+        TBaseClass* bc = (TBaseClass*)obj;
+        if (bc->Property() & kIsVirtualBase)
+            continue;
+        TClass* klass = bc->GetClassPointer();
+        if (!klass)
+            continue;
+        ptrdiff_t offset = (klass == base) ? 0 : StaticBaseOffset(klass, base);
+        if (offset != -1) {
+            Long_t delta = bc->GetDelta();
+            return delta < 0 ? (ptrdiff_t)-1 : (ptrdiff_t)delta + offset;
+        }
+    }
+    return (ptrdiff_t)-1;
+}
+
+ptrdiff_t Cppyy::GetStaticBaseOffset(TCppType_t derived, TCppType_t base)
+{
+// offsets through virtual bases depend on the actual object and are not static
+    if (derived == base || !(base && derived))
+        return (ptrdiff_t)0;
+
+    TClassRef& cd = type_from_handle(derived);
+    TClassRef& cb = type_from_handle(base);
+
+    if (!cd.GetClass() || !cb.GetClass())
+        return (ptrdiff_t)-1;
+
+    return StaticBaseOffset(cd.GetClass(), cb.GetClass());
+}
+
 
 // method/function reflection information ------------------------------------
 Cppyy::TCppIndex_t Cppyy::GetNumMethods(TCppScope_t scope)
@@ -148,6 +148,9 @@ namespace Cppyy {
     RPY_EXPORTED
     ptrdiff_t GetBaseOffset(
         TCppType_t derived, TCppType_t base, TCppObject_t address, int direction, bool rerror = false);
+// up-cast offset if it is the same for all objects, i.e. without virtual base in between; -1 otherwise
+    RPY_EXPORTED
+    ptrdiff_t GetStaticBaseOffset(TCppType_t derived, TCppType_t base);
 
 // method/function reflection information ------------------------------------
     RPY_EXPORTED
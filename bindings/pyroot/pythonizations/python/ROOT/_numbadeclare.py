@@ -1,7 +1,7 @@
 from cppyy import gbl as gbl_namespace
 
 
-def _NumbaDeclareDecorator(input_types, return_type, name=None):
+def _NumbaDeclareDecorator(input_types, return_type, name=None, vectorize=False):
     '''
     Decorator for making Python callables accessible in C++ by just-in-time compilation
     with numba and cling
@@ -19,6 +19,18 @@ def _NumbaDeclareDecorator(input_types, return_type, name=None):
     making the original Python callable accessible in C++. The wrapper code in C++ is accessible by
     the attribute __cpp_wrapper__.
 
+    With vectorize=True, the Python callable takes and returns fundamental types only and is compiled
+    into a loop over arrays of values, similar to numba.vectorize. The C++ wrappers are then a function
+    taking scalars, usable in RDataFrame Defines and Filters, an overload taking RVecs of equal sizes
+    which applies the callable on all their elements at once, e.g. on the values of collection columns,
+    and a function with the suffix _batch taking the number of values and pointers to the input and output
+    buffers, for the evaluation on whole batches of values, e.g. the arrays of RDataFrame.AsNumpy.
+    The loop runs without any copy or allocation besides that of the returned RVec.
+    Finally, the function with the suffix _define books a Define of the callable on an RDataFrame node,
+    e.g. Numba.<name>_define(ROOT.RDF.AsRNode(df), "y", ["x"]). In batched execution, enabled with
+    RDataFrame.SetBatchSize, this Define calls the callable once per batch of entries, on the values of
+    all the entries of the batch, instead of once per entry.
+
     Note that the callable is fully compiled without side-effects. The numba jitting uses the nopython
     option which does not allow interaction with the Python interpreter. This means that you can use
     the resulting function also safely in multi-threaded environments.
@@ -118,10 +130,151 @@ def _NumbaDeclareDecorator(input_types, return_type, name=None):
             nb_return_type = get_numba_type(return_type)
         return nb_return_type, nb_input_types
 
+    def get_pointer_type(t):
+        '''
+        Get the C++ type of the buffers of the vectorized wrappers, numpy stores bools in bytes
+        '''
+        return 'char' if t == 'bool' else t
+
+    def inner_vectorized(func, input_types=input_types, return_type=return_type, name=name):
+        '''
+        Inner decorator without arguments for vectorize=True, see outer decorator for documentation
+        '''
+        for t in input_types + [return_type]:
+            if 'RVec' in t:
+                raise Exception(
+                        'Type {} is not supported for vectorized jitting with numba, use fundamental types'.format(t))
+        if 'bool' in input_types:
+            raise Exception('Type bool is not supported as input type for vectorized jitting with numba')
+
+        # Jit the given Python callable with numba
+        nb_return_type, nb_input_types = get_numba_signature(input_types, return_type)
+        try:
+            nbjit = nb.jit(nb_return_type(*nb_input_types), nopython=True, inline='always')(func)
+        except:
+            raise Exception('Failed to jit Python callable {} with numba.jit'.format(func))
+        func.numba_func = nbjit
+
+        # Create Python wrapper looping over the buffers
+        pywrappercode = '''\
+def pywrapper(size, {SIGNATURE}, ptr_r):
+    """
+    Wrapper function applying the jitted Python callable on arrays of values
+    """
+    {ARGS_DEF}
+    r = nb.carray(ptr_r, (size,))
+    for i in range(size):
+        r[i] = nbjit({ARGS})
+        '''.format(
+                SIGNATURE=', '.join('ptr_{}'.format(i) for i in range(len(input_types))),
+                ARGS_DEF='\n    '.join(
+                    'x_{0} = nb.carray(ptr_{0}, (size,))'.format(i) for i in range(len(input_types))),
+                ARGS=', '.join('x_{}[i]'.format(i) for i in range(len(input_types))))
+
+        glob = dict(globals()) # Make a shallow copy of the dictionary so we don't pollute the global scope
+        glob['nb'] = nb
+        glob['nbjit'] = nbjit
+
+        if sys.version_info[0] >= 3:
+            exec(pywrappercode, glob, locals()) in {}
+        else:
+            exec(pywrappercode) in glob, locals()
+
+        if not 'pywrapper' in locals():
+            raise Exception('Failed to create Python wrapper function:\n{}'.format(pywrappercode))
+
+        # Jit the Python wrapper code, bools are returned as bytes
+        c_input_types = [nb.int64] + [nb.types.CPointer(get_numba_type(t)) for t in input_types]
+        c_input_types.append(nb.types.CPointer(nb.uint8 if return_type == 'bool' else get_numba_type(return_type)))
+        try:
+            nbcfunc = nb.cfunc(nb.void(*c_input_types), nopython=True)(locals()['pywrapper'])
+        except:
+            raise Exception('Failed to jit Python wrapper with numba.cfunc')
+        func.__py_wrapper__ = pywrappercode
+        func.__numba_cfunc__ = nbcfunc
+
+        # Infer name of the C++ wrapper functions
+        if not name:
+            name = func.__name__
+
+        # Build C++ wrappers for jitting with cling
+        return_ptr_type = get_pointer_type(return_type)
+        func_ptr_type = 'void(*)(long, {}, {}*)'.format(
+                ', '.join('const {}*'.format(t) for t in input_types), return_ptr_type)
+        size_checks = [
+                'if (x_{}.size() != size) throw std::runtime_error("{}: the RVecs have different sizes");'.format(
+                    i, name) for i in range(1, len(input_types))]
+        if return_type == 'bool':
+            rvec_return = 'return ROOT::RVec<bool>(r.begin(), r.end());'
+        else:
+            rvec_return = 'return r;'
+
+        cppwrappercode = """\
+#include "ROOT/RDataFrame.hxx"
+
+namespace Numba {{
+/*
+ * C++ wrapper functions around the jitted Python wrapper which applies the jitted Python callable on arrays
+ */
+void {FUNC_NAME}_batch(long size, {BATCH_SIGNATURE}, {RETURN_PTR_TYPE} *r) {{
+    // Create a function pointer from the jitted Python wrapper
+    const auto funcptr = reinterpret_cast<{FUNC_PTR_TYPE}>({FUNC_PTR});
+    funcptr(size, {BATCH_ARGS}, r);
+}}
+
+{RETURN_TYPE} {FUNC_NAME}({SCALAR_SIGNATURE}) {{
+    {RETURN_PTR_TYPE} r;
+    {FUNC_NAME}_batch(1, {SCALAR_ARGS}, &r);
+    return r;
+}}
+
+ROOT::RVec<{RETURN_TYPE}> {FUNC_NAME}({RVEC_SIGNATURE}) {{
+    const auto size = x_0.size();
+    {SIZE_CHECKS}
+    ROOT::RVec<{RETURN_PTR_TYPE}> r(size);
+    {FUNC_NAME}_batch(size, {RVEC_ARGS}, r.data());
+    {RVEC_RETURN}
+}}
+
+ROOT::RDF::RNode {FUNC_NAME}_define(ROOT::RDF::RNode df, std::string_view colName,
+                                    const ROOT::RDF::ColumnNames_t &columns) {{
+    // The Define calls the batch wrapper once per batch in batched execution, see RDataFrame::SetBatchSize
+    return df.Define(colName,
+                     ROOT::RDF::Experimental::RBatchFunction<{RETURN_TYPE}, {INPUT_TYPES}>(&{FUNC_NAME}_batch),
+                     columns);
+}}
+}}""".format(
+                FUNC_NAME=name,
+                FUNC_PTR=nbcfunc.address,
+                FUNC_PTR_TYPE=func_ptr_type,
+                RETURN_TYPE=return_type,
+                RETURN_PTR_TYPE=return_ptr_type,
+                INPUT_TYPES=', '.join(input_types),
+                BATCH_SIGNATURE=', '.join('const {} *x_{}'.format(t, i) for i, t in enumerate(input_types)),
+                BATCH_ARGS=', '.join('x_{}'.format(i) for i in range(len(input_types))),
+                SCALAR_SIGNATURE=', '.join('{} x_{}'.format(t, i) for i, t in enumerate(input_types)),
+                SCALAR_ARGS=', '.join('&x_{}'.format(i) for i in range(len(input_types))),
+                RVEC_SIGNATURE=', '.join(
+                    'const ROOT::RVec<{}> &x_{}'.format(t, i) for i, t in enumerate(input_types)),
+                SIZE_CHECKS='\n    '.join(size_checks),
+                RVEC_ARGS=', '.join('x_{}.data()'.format(i) for i in range(len(input_types))),
+                RVEC_RETURN=rvec_return)
+
+        # Jit wrapper C++ code
+        err = gbl_namespace.gInterpreter.Declare(cppwrappercode)
+        if not err:
+            raise Exception('Failed to jit C++ wrapper code with cling:\n{}'.format(cppwrappercode))
+        func.__cpp_wrapper__ = cppwrappercode
+
+        return func
+
     def inner(func, input_types=input_types, return_type=return_type, name=name):
         '''
         Inner decorator without arguments, see outer decorator for documentation
         '''
+        if vectorize:
+            return inner_vectorized(func, input_types, return_type, name)
+
 
         # Jit the given Python callable with numba
         nb_return_type, nb_input_types = get_numba_signature(input_types, return_type)
@@ -25,7 +25,23 @@ except ImportError:
             return partial(self.func, instance, *(self.args or ()), **(self.keywords or {}))
 
 
-def RDataFrameAsNumpy(df, columns=None, exclude=None):
+# The value types of the collections read out as jagged arrays, i.e. those of the
+# std::vector classes with a numpy array interface
+_jagged_value_types = ["float", "double", "int", "long", "unsigned int", "unsigned long",
+                       "Float_t", "Double_t", "Int_t", "UInt_t", "Long64_t", "ULong64_t"]
+
+
+def _jagged_value_type(column_type):
+    # Returns the value type T if column_type is ROOT::VecOps::RVec<T> or std::vector<T>
+    # with T one of _jagged_value_types, None otherwise
+    import re
+    match = re.match(r"^(?:ROOT::VecOps::RVec|ROOT::RVec|RVec|std::vector|vector)<\s*(.+?)\s*>$", column_type)
+    if match and match.group(1) in _jagged_value_types:
+        return match.group(1)
+    return None
+
+
+def RDataFrameAsNumpy(df, columns=None, exclude=None, jagged=False):
     """Read-out the RDataFrame as a collection of numpy arrays.
 
     The values of the dataframe are read out as numpy array of the respective type
@@ -39,12 +55,19 @@ def RDataFrameAsNumpy(df, columns=None, exclude=None):
     The reading is performed in multiple threads if the implicit multi-threading of
     ROOT is enabled.
 
+    With `jagged=True`, the columns of type ROOT::VecOps::RVec<T> or std::vector<T>,
+    with T a numerical type such as float or int, are read out without a C++ object
+    per entry: the values of all entries are appended to a single buffer, and the
+    result is a jagged_array made of the numpy arrays `content` and `offsets`, the
+    values of entry i being `content[offsets[i]:offsets[i + 1]]`.
+
     Note that this is an instant action of the RDataFrame graph and will trigger the
     event-loop.
 
     Parameters:
         columns: If None return all branches as columns, otherwise specify names in iterable.
         exclude: Exclude branches from selection.
+        jagged: Read out the collections of numerical types as jagged arrays.
 
     Returns:
         dict: Dict with column names as keys and 1D numpy arrays with content as values
@@ -73,15 +96,29 @@ def RDataFrameAsNumpy(df, columns=None, exclude=None):
 
     # Register Take action for each column
     result_ptrs = {}
+    jagged_columns = set()
     for column in columns:
         column_type = df.GetColumnType(column)
-        result_ptrs[column] = df.Take[column_type](column)
+        value_type = _jagged_value_type(column_type) if jagged else None
+        if value_type is not None:
+            import ROOT
+            take_jagged = ROOT.Internal.RDF.RDataFrameTakeJagged[value_type, column_type]
+            result_ptrs[column] = take_jagged(ROOT.RDF.AsRNode(df), column)
+            jagged_columns.add(column)
+        else:
+            result_ptrs[column] = df.Take[column_type](column)
 
     # Convert the C++ vectors to numpy arrays
     py_arrays = {}
     for column in columns:
         cpp_reference = result_ptrs[column].GetValue()
-        if hasattr(cpp_reference, "__array_interface__"):
+        if column in jagged_columns:
+            from ROOT.pythonization._rdf_utils import jagged_array
+            # Both arrays adopt the memory of the C++ object.
+            content = ndarray(numpy.asarray(cpp_reference.fContent), result_ptrs[column])
+            offsets = ndarray(numpy.asarray(cpp_reference.fOffsets), result_ptrs[column])
+            py_arrays[column] = jagged_array(content, offsets)
+        elif hasattr(cpp_reference, "__array_interface__"):
             tmp = numpy.asarray(cpp_reference) # This adopts the memory of the C++ object.
             py_arrays[column] = ndarray(tmp, result_ptrs[column])
         else:
@@ -36,3 +36,43 @@ class ndarray(numpy.ndarray):
         """
         if obj is None: return
         self.result_ptr = getattr(obj, "result_ptr", None)
+
+
+class jagged_array(object):
+    """
+    A jagged array made of two numpy arrays, the flattened values of a
+    collection column and the offsets of its entries, as returned by the
+    `TakeJagged` action of `RDataFrame.AsNumpy`. The values of entry `i` are
+    `content[offsets[i]:offsets[i + 1]]`. Both arrays adopt the memory of the
+    C++ result, whose result pointer is attached to them.
+    """
+    def __init__(self, content, offsets):
+        """
+        Dunder method invoked at the creation of an instance of this class,
+        from the `content` and `offsets` arrays.
+        """
+        self.content = content
+        self.offsets = offsets
+
+    def __len__(self):
+        return len(self.offsets) - 1
+
+    def __getitem__(self, i):
+        """
+        Returns the values of entry `i` as a view of the content array.
+        """
+        if i < 0:
+            i += len(self)
+        if i < 0 or i >= len(self):
+            raise IndexError("jagged_array index out of range")
+        return self.content[self.offsets[i]:self.offsets[i + 1]]
+
+    def __iter__(self):
+        for i in range(len(self)):
+            yield self[i]
+
+    def sizes(self):
+        """
+        Returns the number of values of each entry.
+        """
+        return numpy.diff(self.offsets)
@@ -54,6 +54,14 @@ PyObject *PyROOT::AsRVec(PyObject * /*self*/, PyObject * obj)
       size *= PyLong_AsLong(PyTuple_GetItem(pyshape, i));
    }
 
+   // The RVec adopts the memory as a contiguous array, e.g. the values of a sliced numpy array would be misread
+   auto pystrides = PyDict_GetItemString(pyinterface, "strides");
+   if (pystrides && pystrides != Py_None) {
+      PyErr_SetString(PyExc_RuntimeError, "Object not convertible: __array_interface__['strides'] describes "
+                                          "non-contiguous memory, use e.g. numpy.ascontiguousarray first.");
+      return NULL;
+   }
+
    // Get the typestring and properties thereof
    const auto typestr = GetTypestrFromArrayInterface(pyinterface);
    if (typestr.compare("") == 0)
@@ -557,5 +557,93 @@ class NumbaDeclareArray(unittest.TestCase):
             self.assertEqual(x1[1], bool(x2[1]))
 
 
+
+class NumbaDeclareVectorized(unittest.TestCase):
+    """
+    Test decorator to create C++ wrappers applying Python callables on arrays using numba
+    """
+
+    @unittest.skipIf(skip, skip_reason)
+    def test_scalar(self):
+        """
+        Test scalar wrapper of vectorized callable
+        """
+        @ROOT.Numba.Declare(["float", "int"], "float", vectorize=True)
+        def vec_scalar(x, y):
+            return x * y + 1
+        for x in default_test_inputs:
+            self.assertEqual(ROOT.Numba.vec_scalar(x, 2), x * 2 + 1)
+
+    @unittest.skipIf(skip, skip_reason)
+    def test_rvec(self):
+        """
+        Test RVec wrapper of vectorized callable
+        """
+        @ROOT.Numba.Declare(["double", "double"], "bool", vectorize=True)
+        def vec_rvec(x, y):
+            return x > y
+        x = ROOT.VecOps.RVec("double")([1.0, 2.0, 3.0])
+        y = ROOT.VecOps.RVec("double")([3.0, 2.0, 1.0])
+        r = ROOT.Numba.vec_rvec(x, y)
+        self.assertEqual(list(r), [False, False, True])
+        with self.assertRaises(Exception):
+            ROOT.Numba.vec_rvec(x, ROOT.VecOps.RVec("double")([1.0]))
+
+    @unittest.skipIf(skip, skip_reason)
+    def test_batch(self):
+        """
+        Test batch wrapper of vectorized callable on numpy arrays
+        """
+        @ROOT.Numba.Declare(["double"], "double", vectorize=True)
+        def vec_batch(x):
+            return 2 * x
+        x = np.arange(10, dtype=np.float64)
+        r = np.zeros(10, dtype=np.float64)
+        ROOT.Numba.vec_batch_batch(len(x), x, r)
+        self.assertTrue(np.all(r == 2 * x))
+
+    @unittest.skipIf(skip, skip_reason)
+    def test_rdataframe(self):
+        """
+        Test vectorized callable in RDataFrame on scalar and collection columns
+        """
+        @ROOT.Numba.Declare(["float"], "float", vectorize=True)
+        def vec_rdf(x):
+            return x * x
+        df = ROOT.RDataFrame(4).Define("x", "(float)rdfentry_") \
+                               .Define("v", "ROOT::RVec<float>(3, x)") \
+                               .Define("y", "Numba::vec_rdf(x)") \
+                               .Define("w", "Numba::vec_rdf(v)")
+        self.assertEqual(df.Sum("y").GetValue(), 0 + 1 + 4 + 9)
+        self.assertEqual(df.Sum("w").GetValue(), 3 * (0 + 1 + 4 + 9))
+
+    @unittest.skipIf(skip, skip_reason)
+    def test_batched_define(self):
+        """
+        Test Define of vectorized callable in batched execution of RDataFrame
+        """
+        @ROOT.Numba.Declare(["float", "int"], "bool", vectorize=True)
+        def vec_define(x, y):
+            return x > y
+        for batch_size in [1, 16]:
+            df = ROOT.RDataFrame(100)
+            df.SetBatchSize(batch_size)
+            node = ROOT.RDF.AsRNode(df.Define("x", "(float)rdfentry_").Define("y", "50"))
+            df2 = ROOT.Numba.vec_define_define(node, "z", ["x", "y"])
+            self.assertEqual(df2.Filter("z").Count().GetValue(), 49)
+
+    @unittest.skipIf(skip, skip_reason)
+    def test_unsupported_types(self):
+        """
+        Test that RVecs and bool inputs are refused for vectorized callables
+        """
+        def f(x):
+            return x
+        with self.assertRaises(Exception):
+            ROOT.Numba.Declare(["RVec<float>"], "float", vectorize=True)(f)
+        with self.assertRaises(Exception):
+            ROOT.Numba.Declare(["bool"], "bool", vectorize=True)(f)
+
+
 if __name__ == '__main__':
     unittest.main()
@@ -308,6 +308,30 @@ class RDataFrameAsNumpy(unittest.TestCase):
         pyarr[0][0] = 42
         self.assertTrue(cpparr[0][0] == pyarr[0][0])
 
+    def test_jagged(self):
+        """
+        Testing the read-out of collections of fundamental types as jagged arrays
+        """
+        df = ROOT.ROOT.RDataFrame(5).Define("n", "(int)rdfentry_") \
+                                    .Define("x", "ROOT::VecOps::RVec<float>(n, 0.5f * n)") \
+                                    .Define("y", "std::vector<int>(n % 2, n)")
+        npy = df.AsNumpy(["n", "x", "y"], jagged=True)
+        x = npy["x"]
+        y = npy["y"]
+        self.assertEqual(len(x), 5)
+        self.assertEqual(len(y), 5)
+        self.assertEqual(x.content.dtype, np.float32)
+        self.assertEqual(y.content.dtype, np.int32)
+        self.assertEqual(list(x.offsets), [0, 0, 1, 3, 6, 10])
+        self.assertEqual(list(y.sizes()), [0, 1, 0, 1, 0])
+        for n, xi, yi in zip(npy["n"], x, y):
+            self.assertEqual(list(xi), [0.5 * n] * n)
+            self.assertEqual(list(yi), [n] * (n % 2))
+        # The arrays adopt the memory of the C++ result
+        cpparr = x.content.result_ptr.GetValue()
+        x.content[0] = 42
+        self.assertEqual(cpparr.fContent[0], 42)
+
 
 if __name__ == '__main__':
     unittest.main()
@@ -113,6 +113,16 @@ class AsRVec(unittest.TestCase):
         gc.collect()
         self.assertEqual(sys.getrefcount(np_obj), 2)
 
+    def test_noncontiguous(self):
+        """
+        Test that the memory of non-contiguous arrays is not adopted
+        """
+        np_obj = np.arange(10, dtype="float32")[::2]
+        with self.assertRaises(RuntimeError):
+            ROOT.VecOps.AsRVec(np_obj)
+        rvec = ROOT.VecOps.AsRVec(np.ascontiguousarray(np_obj))
+        self.assertEqual(list(rvec), [0, 2, 4, 6, 8])
+
 
 if __name__ == '__main__':
     unittest.main()
@@ -140,6 +140,7 @@ ROOT_BUILD_OPTION(jemalloc OFF "Use jemalloc memory allocator")
 ROOT_BUILD_OPTION(libcxx OFF "Build using libc++")
 ROOT_BUILD_OPTION(macos_native OFF "Disable looking for libraries, includes and binaries in locations other than a native installation (MacOS only)")
 ROOT_BUILD_OPTION(mathmore ON "Build libMathMore extended math library (requires GSL)")
+ROOT_BUILD_OPTION(matrix-blas OFF "Use BLAS and LAPACK (e.g. OpenBLAS, MKL) for the operations on large matrices of libMatrix")
 ROOT_BUILD_OPTION(memory_termination OFF "Free internal ROOT memory before process termination (experimental, used for leak checking)")
 ROOT_BUILD_OPTION(mlp ON "Enable support for TMultilayerPerceptron classes' federation")
 ROOT_BUILD_OPTION(minuit2 ON "Build Minuit2 minimization library")
@@ -189,6 +190,7 @@ ROOT_BUILD_OPTION(xrootd ON "Enable support for XRootD file server and client")
 ROOT_BUILD_OPTION(xproofd OFF "Enable LEGACY support for XProofD file server and client (requires XRootD v4 with private-devel)")
 
 option(all "Enable all optional components by default" OFF)
+option(benchmarks "Build the microbenchmarks of test/benchmarks, downloading Google Benchmark" OFF)
 option(clingtest "Enable cling tests (Note: that this makes llvm/clang symbols visible in libCling)" OFF)
 option(fail-on-missing "Fail at configure time if a required package cannot be found" OFF)
 option(gminimal "Enable only required options by default, but include X11" OFF)
@@ -370,8 +372,8 @@ endif()
 #---Define at moment the options with the selected default values------------------------------
 ROOT_APPLY_OPTIONS()
 
-#---roottest option implies testing
-if(roottest OR rootbench)
+#---roottest, rootbench and benchmarks options imply testing
+if(roottest OR rootbench OR benchmarks)
   set(testing ON CACHE BOOL "" FORCE)
 endif()
 
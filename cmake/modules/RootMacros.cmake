@@ -1737,9 +1737,10 @@ endfunction()
 #                        [LABELS label1 label2...] -- Labels to annotate the test
 #                        [INCLUDE_DIRS label1 label2...] -- Extra target include directories
 #                        [REPEATS number] -- Repeats testsuite `number` times, stopping at the first failure.
+#                        [ENVIRONMENT var1=val1 var2=val2...] -- Environment variables of the test process
 
 function(ROOT_ADD_GTEST test_suite)
-  CMAKE_PARSE_ARGUMENTS(ARG "WILLFAIL" "REPEATS" "COPY_TO_BUILDDIR;LIBRARIES;LABELS;INCLUDE_DIRS" ${ARGN})
+  CMAKE_PARSE_ARGUMENTS(ARG "WILLFAIL" "REPEATS" "COPY_TO_BUILDDIR;LIBRARIES;LABELS;INCLUDE_DIRS;ENVIRONMENT" ${ARGN})
 
   # ROOTUnitTestSupport
   if(NOT TARGET ROOTUnitTestSupport)
@@ -1775,6 +1776,9 @@ function(ROOT_ADD_GTEST test_suite)
   if(ARG_REPEATS)
     set(extra_command --gtest_repeat=${ARG_REPEATS} --gtest_break_on_failure)
   endif()
+  if(ARG_ENVIRONMENT)
+    set(environment ENVIRONMENT ${ARG_ENVIRONMENT})
+  endif()
 
   ROOT_PATH_TO_STRING(mangled_name ${test_suite} PATH_SEPARATOR_REPLACEMENT "-")
   ROOT_ADD_TEST(
@@ -1782,11 +1786,42 @@ function(ROOT_ADD_GTEST test_suite)
     COMMAND ${test_suite} ${extra_command}
     WORKING_DIR ${CMAKE_CURRENT_BINARY_DIR}
     COPY_TO_BUILDDIR ${ARG_COPY_TO_BUILDDIR}
+    ${environment}
     ${willfail}
     ${labels}
   )
 endfunction()
 
+#----------------------------------------------------------------------------
+# function ROOT_ADD_BENCHMARK(<benchmark> source1 source2...
+#                            [LIBRARIES lib1 lib2...] -- Libraries to link against
+#                            [LABELS label1 label2...] -- Labels to annotate the test, in addition to 'benchmark'
+#                            [OPTIONS opt1 opt2...] -- Extra command line options for the benchmark run
+#
+# Builds a Google Benchmark executable and runs it as the test bench-<benchmark>, which writes the
+# results in JSON to <benchmark>.json in the binary directory, e.g. with `ctest -L benchmark`. Two
+# such result files can be compared with test/benchmarks/compare_benchmarks.py.
+#----------------------------------------------------------------------------
+function(ROOT_ADD_BENCHMARK benchmark)
+  CMAKE_PARSE_ARGUMENTS(ARG "" "" "LIBRARIES;LABELS;OPTIONS" ${ARGN})
+  if(NOT benchmarks)
+    return()
+  endif()
+
+  ROOT_GET_SOURCES(source_files . ${ARG_UNPARSED_ARGUMENTS})
+  ROOT_EXECUTABLE(${benchmark} ${source_files} LIBRARIES ${ARG_LIBRARIES})
+  target_link_libraries(${benchmark} benchmark benchmark_main ${CMAKE_THREAD_LIBS_INIT})
+
+  ROOT_PATH_TO_STRING(mangled_name ${benchmark} PATH_SEPARATOR_REPLACEMENT "-")
+  ROOT_ADD_TEST(
+    bench-${mangled_name}
+    COMMAND ${benchmark} --benchmark_out=${CMAKE_CURRENT_BINARY_DIR}/${benchmark}.json
+                         --benchmark_out_format=json ${ARG_OPTIONS}
+    WORKING_DIR ${CMAKE_CURRENT_BINARY_DIR}
+    LABELS benchmark ${ARG_LABELS}
+  )
+endfunction()
+
 
 #----------------------------------------------------------------------------
 # ROOT_ADD_TEST_SUBDIRECTORY( <name> )
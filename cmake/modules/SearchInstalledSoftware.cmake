@@ -1094,6 +1094,19 @@ if(arrow)
     endif()
   endif()
 
+  #---Parquet is optional, it is usually built and installed together with Arrow
+  if(ARROW_FOUND)
+    find_path(PARQUET_INCLUDE_DIR parquet/arrow/reader.h HINTS ${ARROW_HOME}/include ${ARROW_INCLUDE_DIR})
+    find_library(PARQUET_SHARED_LIB parquet HINTS ${ARROW_HOME}/lib ${ARROW_LIB_DIR})
+    if(PARQUET_INCLUDE_DIR AND PARQUET_SHARED_LIB)
+      set(PARQUET_FOUND TRUE)
+      message(STATUS "Found Parquet: ${PARQUET_SHARED_LIB}")
+    else()
+      set(PARQUET_FOUND FALSE)
+      message(STATUS "Parquet not found, RDataFrame will not read and write Parquet files")
+    endif()
+  endif()
+
 endif()
 
 #---Check for gfal-------------------------------------------------------------------
@@ -1256,6 +1269,21 @@ if (uring)
   endif()
 endif()
 
+#---Check for BLAS and LAPACK for libMatrix---------------------------------------
+if(matrix-blas)
+  message(STATUS "Looking for BLAS and LAPACK")
+  find_package(BLAS)
+  find_package(LAPACK)
+  if(NOT BLAS_FOUND OR NOT LAPACK_FOUND)
+    if(fail-on-missing)
+      message(FATAL_ERROR "BLAS/LAPACK not found and matrix-blas option required")
+    else()
+      message(STATUS "BLAS/LAPACK not found. Switching off matrix-blas option")
+      set(matrix-blas OFF CACHE BOOL "Disabled because BLAS/LAPACK was not found (${matrix-blas_description})" FORCE)
+    endif()
+  endif()
+endif()
+
 #---Check for DAOS----------------------------------------------------------------
 if (daos AND daos_mock)
   message(FATAL_ERROR "Options `daos` and `daos_mock` are mutually exclusive; only one of them should be specified.")
@@ -2011,6 +2039,71 @@ if (testing)
 
 endif()
 
+#---Download Google Benchmark---------------------------------------------------------
+if (benchmarks AND NO_CONNECTION)
+  if(fail-on-missing)
+    message(FATAL_ERROR "No internet connection. Please check your connection, or either disable the 'benchmarks' option or the 'fail-on-missing' to automatically disable options requiring internet access")
+  else()
+    message(STATUS "No internet connection, disabling 'benchmarks' option")
+    set(benchmarks OFF CACHE BOOL "Disabled because there is no internet connection" FORCE)
+  endif()
+endif()
+
+if (benchmarks)
+  set(_gbench_byproduct_binary_dir
+    ${CMAKE_CURRENT_BINARY_DIR}/googlebenchmark-prefix/src/googlebenchmark-build)
+  set(_gbench_byproducts
+    ${_gbench_byproduct_binary_dir}/src/${CMAKE_STATIC_LIBRARY_PREFIX}benchmark${CMAKE_STATIC_LIBRARY_SUFFIX}
+    ${_gbench_byproduct_binary_dir}/src/${CMAKE_STATIC_LIBRARY_PREFIX}benchmark_main${CMAKE_STATIC_LIBRARY_SUFFIX}
+    )
+
+  if(APPLE)
+    set(EXTRA_GBENCH_OPTS
+      -DCMAKE_OSX_SYSROOT=${CMAKE_OSX_SYSROOT})
+  endif()
+
+  ExternalProject_Add(
+    googlebenchmark
+    GIT_REPOSITORY https://github.com/google/benchmark.git
+    GIT_SHALLOW 1
+    GIT_TAG v1.5.2
+    UPDATE_COMMAND ""
+    CMAKE_ARGS -G ${CMAKE_GENERATOR}
+                  -DCMAKE_BUILD_TYPE=Release
+                  -DCMAKE_C_COMPILER=${CMAKE_C_COMPILER}
+                  -DCMAKE_C_FLAGS=${CMAKE_C_FLAGS}
+                  -DCMAKE_CXX_COMPILER=${CMAKE_CXX_COMPILER}
+                  -DCMAKE_CXX_FLAGS=${ROOT_EXTERNAL_CXX_FLAGS}
+                  -DCMAKE_AR=${CMAKE_AR}
+                  -DBENCHMARK_ENABLE_TESTING=OFF
+                  -DBENCHMARK_ENABLE_GTEST_TESTS=OFF
+                  -DBENCHMARK_ENABLE_INSTALL=OFF
+                  ${EXTRA_GBENCH_OPTS}
+    # Disable install step
+    INSTALL_COMMAND ""
+    BUILD_BYPRODUCTS ${_gbench_byproducts}
+    # Wrap download, configure and build steps in a script to log output
+    LOG_DOWNLOAD ON
+    LOG_CONFIGURE ON
+    LOG_BUILD ON
+    TIMEOUT 600
+  )
+
+  ExternalProject_Get_Property(googlebenchmark source_dir)
+  set(GBENCH_INCLUDE_DIR ${source_dir}/include)
+  # Create the directory. Prevents bug https://gitlab.kitware.com/cmake/cmake/issues/15052
+  file(MAKE_DIRECTORY ${GBENCH_INCLUDE_DIR})
+
+  foreach(lib benchmark benchmark_main)
+    add_library(${lib} IMPORTED STATIC GLOBAL)
+    set_target_properties(${lib} PROPERTIES
+      IMPORTED_LOCATION "${_gbench_byproduct_binary_dir}/src/${CMAKE_STATIC_LIBRARY_PREFIX}${lib}${CMAKE_STATIC_LIBRARY_SUFFIX}"
+    )
+    SET_PROPERTY(TARGET ${lib} APPEND PROPERTY INTERFACE_INCLUDE_DIRECTORIES ${GBENCH_INCLUDE_DIR})
+    add_dependencies(${lib} googlebenchmark)
+  endforeach()
+endif()
+
 if(webgui AND NOT builtin_openui5 AND NO_CONNECTION)
   if(fail-on-missing)
     message(FATAL_ERROR "No internet connection. Please check your connection, or either enable the 'builtin_openui5' option or the 'fail-on-missing' to automatically disable options requiring internet access")
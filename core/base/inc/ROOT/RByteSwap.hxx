@@ -0,0 +1,37 @@
+/// \file ROOT/RByteSwap.hxx
+/// \date 2021-06-21
+
+/*************************************************************************
+ * Copyright (C) 1995-2021, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#ifndef ROOT_RByteSwap
+#define ROOT_RByteSwap
+
+#include <cstddef>
+
+namespace ROOT {
+namespace Internal {
+
+/// \name Byte-swapping copies of arrays
+/// Copy `n` elements of 2, 4 or 8 bytes from `from` to `to`, reversing the order of the bytes of every element,
+/// i.e. converting between the big-endian on-file representation and a little-endian host.
+/// `to` and `from` may be equal, for an in-place swap, but must not overlap otherwise; none needs to be aligned.
+/// The widest kernel supported by the CPU (SSSE3 or AVX2 on x86-64, NEON on AArch64) is selected at first use.
+///@{
+void ByteSwapCopy16(void *to, const void *from, std::size_t n);
+void ByteSwapCopy32(void *to, const void *from, std::size_t n);
+void ByteSwapCopy64(void *to, const void *from, std::size_t n);
+///@}
+
+/// Name of the byte-swapping kernel used on this CPU: "avx2", "ssse3", "neon" or "scalar"
+const char *GetByteSwapKernelName();
+
+} // namespace Internal
+} // namespace ROOT
+
+#endif
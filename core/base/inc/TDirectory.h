@@ -25,6 +25,8 @@
 #include "TClass.h"
 #include "TUUID.h"
 #include <atomic>
+#include <mutex>
+#include <vector>
 
 #ifdef R__LESS_INCLUDES
 class TList;
@@ -132,6 +134,56 @@ can be replaced with the simpler and exception safe:
       ~TContext();
    };
 
+/** \class TDeferredRegistration
+\ingroup Base
+
+TDirectory::TDeferredRegistration defers the registration of the objects
+appended to a directory by the current thread, e.g. by the constructors of
+the histograms, until it is flushed or destroyed. The objects are then
+appended to their directories in one go, taking the lock of each directory
+once, so that threads creating many objects do not contend on the lock for
+each of them.
+
+~~~ {.cpp}
+   {
+      TDirectory::TDeferredRegistration registration;
+      for (int i = 0; i < 1000; ++i)
+         histos.push_back(new TH1F(TString::Format("h_%d_%d", slot, i), "", 100, 0., 1.));
+   } // the histograms are appended to gDirectory here
+~~~
+
+Until they are registered, the objects are found by FindObject and removed
+by Remove of their directory, but only on the thread that created them; they
+are not in the list of the directory (GetList), so they are not written by
+TDirectory::Write. The objects must not be deleted by another thread before
+they are registered.
+*/
+
+   class TDeferredRegistration {
+   private:
+      struct TEntry {
+         TDirectory *fDirectory; ///< Directory the object is appended to
+         TObject *fObject;       ///< Object to append
+         Bool_t fReplace;        ///< Whether the object replaces the objects with the same name
+      };
+
+      TDeferredRegistration *fPrevious{nullptr}; ///< Enclosing deferred registration of this thread
+      std::vector<TEntry> fEntries;              ///< Objects waiting for their registration
+
+      TDeferredRegistration(const TDeferredRegistration &) = delete;
+      TDeferredRegistration &operator=(const TDeferredRegistration &) = delete;
+
+      static TDeferredRegistration *&Current();
+      static TObject *FindObject(const TDirectory *dir, const char *name, const TObject *obj);
+      static Bool_t Remove(const TDirectory *dir, TObject *obj);
+      void Flush(const TDirectory *dir);
+      friend class TDirectory;
+   public:
+      TDeferredRegistration();
+      ~TDeferredRegistration();
+      void Flush() { Flush(nullptr); }
+   };
+
 protected:
 
    TObject         *fMother{nullptr};   // pointer to mother of the directory
@@ -144,6 +196,7 @@ protected:
 
    std::atomic<size_t> fContextPeg;     //!Counter delaying the TDirectory destructor from finishing.
    mutable std::atomic_flag fSpinLock;  //! MSVC doesn't support = ATOMIC_FLAG_INIT;
+   mutable std::recursive_mutex fListMutex; //! Serializes the changes of fList done through Append and Remove
 
    static Bool_t fgAddDirectory;        //!flag to add histograms, graphs,etc to the directory
 
@@ -25,6 +25,8 @@
 #include "TObject.h"
 #include "TString.h"
 
+#include <utility>
+
 
 class TNamed : public TObject {
 
@@ -36,6 +38,7 @@ public:
    TNamed(): fName(), fTitle() { }
    TNamed(const char *name, const char *title) : fName(name), fTitle(title) { }
    TNamed(const TString &name, const TString &title) : fName(name), fTitle(title) { }
+   TNamed(TString &&name, TString &&title) : fName(std::move(name)), fTitle(std::move(title)) { }
    TNamed(const TNamed &named);
    TNamed& operator=(const TNamed& rhs);
    virtual ~TNamed();
@@ -24,6 +24,8 @@
 #include "TObject.h"
 #include "TString.h"
 
+#include <utility>
+
 
 class TObjString : public TObject {
 
@@ -32,6 +34,8 @@ private:
 
 public:
    TObjString(const char *s = "") : fString(s) { }
+   TObjString(const TString &s) : fString(s) { }
+   TObjString(TString &&s) : fString(std::move(s)) { }
    ~TObjString();
    Int_t       Compare(const TObject *obj) const;
    TString     CopyString() const { return fString; }
@@ -43,6 +47,8 @@ public:
    Bool_t      IsEqual(const TObject *obj) const;
    void        ReadBuffer(char *&buffer) { fString.ReadBuffer(buffer); }
    void        SetString(const char *s) { fString = s; }
+   void        SetString(const TString &s) { fString = s; }
+   void        SetString(TString &&s) { fString = std::move(s); }
    const TString &GetString() const { return fString; }
    Int_t       Sizeof() const { return fString.Sizeof(); }
    TString    &String() { return fString; }
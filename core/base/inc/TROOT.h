@@ -67,6 +67,7 @@ namespace Internal {
    class TROOTAllocator;
 
    TROOT *GetROOT2();
+   void InitDeferredInterpreter();
 
    // Manage parallel branch processing
    void EnableParBranchProcessing();
@@ -77,6 +78,17 @@ namespace Internal {
       TParBranchProcessingRAII()  { EnableParBranchProcessing();  }
       ~TParBranchProcessingRAII() { DisableParBranchProcessing(); }
    };
+
+   // Run tasks on the implicit multi-threading pool, for the libraries that cannot depend on libImt
+   void RunInImplicitMTPool(UInt_t ntasks, void (*task)(void *arg, UInt_t i), void *arg);
+   // Start a task on the implicit multi-threading pool without waiting for it; false if the pool is not enabled
+   Bool_t EnqueueInImplicitMTPool(void (*task)(void *arg), void *arg);
+   /// Run f(i) for each i in [0, ntasks), concurrently if implicit multi-threading is enabled.
+   template <typename F>
+   void ForEachInImplicitMTPool(UInt_t ntasks, F &f)
+   {
+      RunInImplicitMTPool(ntasks, [](void *arg, UInt_t i) { (*static_cast<F *>(arg))(i); }, &f);
+   }
 } } // End ROOT::Internal
 
 namespace ROOT {
@@ -86,6 +98,8 @@ namespace ROOT {
    /// \brief Enable ROOT's implicit multi-threading for all objects and methods that provide an internal
    /// parallelisation mechanism.
    void EnableImplicitMT(UInt_t numthreads = 0);
+   /// \brief Enable ROOT's implicit multi-threading, pinning the threads of the pool to the NUMA nodes of the machine.
+   void EnableNUMAAwareImplicitMT(UInt_t numthreads = 0);
    void DisableImplicitMT();
    Bool_t IsImplicitMTEnabled();
    UInt_t GetThreadPoolSize();
@@ -95,6 +109,7 @@ class TROOT : public TDirectory {
 
 friend class TCling;
 friend TROOT *ROOT::Internal::GetROOT2();
+friend void ROOT::Internal::InitDeferredInterpreter();
 
 private:
    Int_t           fLineIsProcessing;     //To synchronize multi-threads
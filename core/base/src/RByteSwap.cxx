@@ -0,0 +1,180 @@
+/// \file RByteSwap.cxx
+/// \date 2021-06-21
+
+/*************************************************************************
+ * Copyright (C) 1995-2021, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#include "ROOT/RByteSwap.hxx"
+
+#include "Byteswap.h"
+
+#include <cstdint>
+#include <cstring>
+
+#if defined(__x86_64__) && defined(__GNUC__)
+#define R__BYTESWAP_X86
+#include <immintrin.h>
+#elif defined(__aarch64__) && defined(__ARM_NEON)
+#define R__BYTESWAP_NEON
+#include <arm_neon.h>
+#endif
+
+namespace {
+
+/// The elements are loaded and stored with memcpy: the arrays need not be aligned, and `to == from` is fine
+template <typename T, T (*Swap)(T)>
+void SwapScalar(char *to, const char *from, std::size_t n)
+{
+   for (std::size_t i = 0; i < n; ++i) {
+      T x;
+      std::memcpy(&x, from + i * sizeof(T), sizeof(T));
+      x = Swap(x);
+      std::memcpy(to + i * sizeof(T), &x, sizeof(T));
+   }
+}
+
+std::uint16_t Swap16(std::uint16_t x)
+{
+   return Rbswap_16(x);
+}
+std::uint32_t Swap32(std::uint32_t x)
+{
+   return Rbswap_32(x);
+}
+std::uint64_t Swap64(std::uint64_t x)
+{
+   return Rbswap_64(x);
+}
+
+#ifdef R__BYTESWAP_X86
+
+/// The pshufb masks reversing the bytes of the elements of 2, 4 and 8 bytes, for the two 128-bit lanes of AVX2
+alignas(32) const char kMasks[3][32] = {
+   {1, 0, 3, 2, 5, 4, 7, 6, 9, 8, 11, 10, 13, 12, 15, 14, 1, 0, 3, 2, 5, 4, 7, 6, 9, 8, 11, 10, 13, 12, 15, 14},
+   {3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12, 3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12},
+   {7, 6, 5, 4, 3, 2, 1, 0, 15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1, 0, 15, 14, 13, 12, 11, 10, 9, 8}};
+
+/// Swaps the first bytes of the array, by blocks of 16 bytes; returns how many were swapped
+__attribute__((target("ssse3"))) std::size_t SwapSSSE3(char *to, const char *from, std::size_t nBytes,
+                                                       const char *mask)
+{
+   const __m128i m = _mm_load_si128(reinterpret_cast<const __m128i *>(mask));
+   std::size_t i = 0;
+   for (; i + 16 <= nBytes; i += 16) {
+      const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i *>(from + i));
+      _mm_storeu_si128(reinterpret_cast<__m128i *>(to + i), _mm_shuffle_epi8(v, m));
+   }
+   return i;
+}
+
+/// Swaps the first bytes of the array, by blocks of 32 bytes; returns how many were swapped
+__attribute__((target("avx2"))) std::size_t SwapAVX2(char *to, const char *from, std::size_t nBytes,
+                                                     const char *mask)
+{
+   const __m256i m = _mm256_load_si256(reinterpret_cast<const __m256i *>(mask));
+   std::size_t i = 0;
+   for (; i + 64 <= nBytes; i += 64) {
+      const __m256i v0 = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(from + i));
+      const __m256i v1 = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(from + i + 32));
+      _mm256_storeu_si256(reinterpret_cast<__m256i *>(to + i), _mm256_shuffle_epi8(v0, m));
+      _mm256_storeu_si256(reinterpret_cast<__m256i *>(to + i + 32), _mm256_shuffle_epi8(v1, m));
+   }
+   for (; i + 32 <= nBytes; i += 32) {
+      const __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(from + i));
+      _mm256_storeu_si256(reinterpret_cast<__m256i *>(to + i), _mm256_shuffle_epi8(v, m));
+   }
+   return i;
+}
+
+enum class EKernel { kScalar, kSSSE3, kAVX2 };
+
+EKernel GetKernel()
+{
+   static const EKernel kernel = []() {
+      __builtin_cpu_init();
+      if (__builtin_cpu_supports("avx2"))
+         return EKernel::kAVX2;
+      if (__builtin_cpu_supports("ssse3"))
+         return EKernel::kSSSE3;
+      return EKernel::kScalar;
+   }();
+   return kernel;
+}
+
+/// Swaps the first bytes of the array with the vector kernel; returns how many were swapped
+std::size_t SwapVector(char *to, const char *from, std::size_t nBytes, int log2Size)
+{
+   switch (GetKernel()) {
+   case EKernel::kAVX2: return SwapAVX2(to, from, nBytes, kMasks[log2Size - 1]);
+   case EKernel::kSSSE3: return SwapSSSE3(to, from, nBytes, kMasks[log2Size - 1]);
+   default: return 0;
+   }
+}
+
+#elif defined(R__BYTESWAP_NEON)
+
+std::size_t SwapVector(char *to, const char *from, std::size_t nBytes, int log2Size)
+{
+   std::size_t i = 0;
+   for (; i + 16 <= nBytes; i += 16) {
+      const uint8x16_t v = vld1q_u8(reinterpret_cast<const std::uint8_t *>(from + i));
+      const uint8x16_t r = (log2Size == 1) ? vrev16q_u8(v) : (log2Size == 2) ? vrev32q_u8(v) : vrev64q_u8(v);
+      vst1q_u8(reinterpret_cast<std::uint8_t *>(to + i), r);
+   }
+   return i;
+}
+
+#else
+
+std::size_t SwapVector(char *, const char *, std::size_t, int)
+{
+   return 0;
+}
+
+#endif
+
+} // anonymous namespace
+
+void ROOT::Internal::ByteSwapCopy16(void *to, const void *from, std::size_t n)
+{
+   auto dst = static_cast<char *>(to);
+   auto src = static_cast<const char *>(from);
+   const std::size_t done = SwapVector(dst, src, 2 * n, 1);
+   SwapScalar<std::uint16_t, Swap16>(dst + done, src + done, n - done / 2);
+}
+
+void ROOT::Internal::ByteSwapCopy32(void *to, const void *from, std::size_t n)
+{
+   auto dst = static_cast<char *>(to);
+   auto src = static_cast<const char *>(from);
+   const std::size_t done = SwapVector(dst, src, 4 * n, 2);
+   SwapScalar<std::uint32_t, Swap32>(dst + done, src + done, n - done / 4);
+}
+
+void ROOT::Internal::ByteSwapCopy64(void *to, const void *from, std::size_t n)
+{
+   auto dst = static_cast<char *>(to);
+   auto src = static_cast<const char *>(from);
+   const std::size_t done = SwapVector(dst, src, 8 * n, 3);
+   SwapScalar<std::uint64_t, Swap64>(dst + done, src + done, n - done / 8);
+}
+
+const char *ROOT::Internal::GetByteSwapKernelName()
+{
+#if defined(R__BYTESWAP_X86)
+   switch (GetKernel()) {
+   case EKernel::kAVX2: return "avx2";
+   case EKernel::kSSSE3: return "ssse3";
+   default: return "scalar";
+   }
+#elif defined(R__BYTESWAP_NEON)
+   return "neon";
+#else
+   return "scalar";
+#endif
+}
@@ -26,6 +26,9 @@
 #include "TVirtualMutex.h"
 #include "TThreadSlots.h"
 #include "TMethod.h"
+#include "ThreadLocalStorage.h"
+
+#include <algorithm>
 
 #include "TSpinLockGuard.h"
 
@@ -95,6 +98,9 @@ TDirectory::~TDirectory()
       return; //when called by TROOT destructor
    }
 
+   for (auto registration = TDeferredRegistration::Current(); registration; registration = registration->fPrevious)
+      registration->Flush(this);
+
    if (fList) {
       if (!fList->IsUsingRWLock())
          Fatal("~TDirectory","In %s:%p the fList (%p) is not using the RWLock\n",
@@ -153,6 +159,108 @@ TDirectory::TContext::~TContext()
    while(fDirectoryWait);
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Start deferring the registration of the objects appended to the directories
+/// by the current thread.
+
+TDirectory::TDeferredRegistration::TDeferredRegistration() : fPrevious(Current())
+{
+   Current() = this;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Destructor.
+///
+/// Append the objects to their directories, and stop deferring their
+/// registration unless an enclosing TDeferredRegistration is still alive.
+
+TDirectory::TDeferredRegistration::~TDeferredRegistration()
+{
+   Flush();
+   Current() = fPrevious;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return the innermost deferred registration of the current thread, if any.
+
+TDirectory::TDeferredRegistration *&TDirectory::TDeferredRegistration::Current()
+{
+   TTHREAD_TLS(TDeferredRegistration *) current(nullptr);
+   return current;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Find an object of `dir` waiting for its registration on the current thread,
+/// by name if `name` is not null, otherwise by address.
+
+TObject *TDirectory::TDeferredRegistration::FindObject(const TDirectory *dir, const char *name, const TObject *obj)
+{
+   for (auto registration = Current(); registration; registration = registration->fPrevious) {
+      for (const auto &entry : registration->fEntries) {
+         if (entry.fDirectory != dir)
+            continue;
+         if (name ? !strcmp(name, entry.fObject->GetName()) : entry.fObject == obj)
+            return entry.fObject;
+      }
+   }
+   return nullptr;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Drop an object of `dir` waiting for its registration on the current thread.
+/// Return true if it was found.
+
+Bool_t TDirectory::TDeferredRegistration::Remove(const TDirectory *dir, TObject *obj)
+{
+   for (auto registration = Current(); registration; registration = registration->fPrevious) {
+      auto &entries = registration->fEntries;
+      auto it = std::find_if(entries.begin(), entries.end(),
+                             [dir, obj](const TEntry &entry) { return entry.fDirectory == dir && entry.fObject == obj; });
+      if (it != entries.end()) {
+         entries.erase(it);
+         return kTRUE;
+      }
+   }
+   return kFALSE;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Append the objects waiting for their registration to their directories,
+/// only those of `dir` if it is not null.
+///
+/// The objects of each directory are appended in the order of the calls to
+/// Append, while holding the lock of the directory.
+
+void TDirectory::TDeferredRegistration::Flush(const TDirectory *dir)
+{
+   std::vector<TEntry> entries;
+   if (dir) {
+      auto first = std::stable_partition(fEntries.begin(), fEntries.end(),
+                                         [dir](const TEntry &entry) { return entry.fDirectory != dir; });
+      entries.assign(first, fEntries.end());
+      fEntries.erase(first, fEntries.end());
+   } else {
+      entries.swap(fEntries);
+      std::stable_sort(entries.begin(), entries.end(),
+                       [](const TEntry &a, const TEntry &b) { return a.fDirectory < b.fDirectory; });
+   }
+   if (entries.empty())
+      return;
+
+   // The objects appended while registering these, e.g. by the replaced
+   // objects, are not deferred.
+   auto &current = Current();
+   auto *saved = current;
+   current = nullptr;
+   for (auto first = entries.begin(); first != entries.end();) {
+      TDirectory *directory = first->fDirectory;
+      std::lock_guard<std::recursive_mutex> lock(directory->fListMutex);
+      for (; first != entries.end() && first->fDirectory == directory; ++first)
+         directory->TDirectory::Append(first->fObject, first->fReplace);
+   }
+   current = saved;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Sets the flag controlling the automatic add objects like histograms, TGraph2D, etc
 /// in memory
@@ -187,11 +295,23 @@ Bool_t TDirectory::AddDirectoryStatus()
 ///
 /// If `replace` is true:
 ///   remove any existing objects with the same name (if the name is not "")
+///
+/// The changes of the list of objects of the directory are serialized by a lock
+/// of the directory. If a TDirectory::TDeferredRegistration is alive on the
+/// current thread, the object is only appended when it is flushed.
 
 void TDirectory::Append(TObject *obj, Bool_t replace /* = kFALSE */)
 {
    if (!obj || !fList) return;
 
+   if (auto registration = TDeferredRegistration::Current()) {
+      registration->fEntries.push_back({this, obj, replace});
+      obj->SetBit(kMustCleanup);
+      return;
+   }
+
+   std::lock_guard<std::recursive_mutex> lock(fListMutex);
+
    if (replace && obj->GetName() && obj->GetName()[0]) {
       TObject *old;
       while (nullptr != (old = GetList()->FindObject(obj->GetName()))) {
@@ -723,7 +843,10 @@ void TDirectory::Draw(Option_t *option)
 
 TObject *TDirectory::FindObject(const TObject *obj) const
 {
-   return fList->FindObject(obj);
+   TObject *found = fList->FindObject(obj);
+   if (!found && TDeferredRegistration::Current())
+      found = TDeferredRegistration::FindObject(this, nullptr, obj);
+   return found;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -731,7 +854,10 @@ TObject *TDirectory::FindObject(const TObject *obj) const
 
 TObject *TDirectory::FindObject(const char *name) const
 {
-   return fList->FindObject(name);
+   TObject *found = fList->FindObject(name);
+   if (!found && name && TDeferredRegistration::Current())
+      found = TDeferredRegistration::FindObject(this, name, nullptr);
+   return found;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -1158,8 +1284,11 @@ void TDirectory::RecursiveRemove(TObject *obj)
 
 TObject *TDirectory::Remove(TObject* obj)
 {
+   if (TDeferredRegistration::Current() && TDeferredRegistration::Remove(this, obj))
+      return obj;
    TObject *p = nullptr;
    if (fList) {
+      std::lock_guard<std::recursive_mutex> lock(fListMutex);
       p = fList->Remove(obj);
    }
    return p;
@@ -74,7 +74,9 @@ of a main program creating an interactive version is shown below:
 #include "RGitCommit.h"
 #include <string>
 #include <map>
+#include <atomic>
 #include <cstdlib>
+#include <mutex>
 #ifdef WIN32
 #include <io.h>
 #include "Windows4Root.h"
@@ -165,6 +167,7 @@ FARPROC dlsym(void *library, const char *function_name)
 #endif
 
 extern "C" void R__SetZipMode(int);
+extern "C" int R__SetZlibBackend(const char *name);
 
 static DestroyInterpreter_t *gDestroyInterpreter = nullptr;
 static void *gInterpreterLib = nullptr;
@@ -280,6 +283,11 @@ namespace {
       static std::vector<ModuleHeaderInfo_t> moduleHeaderInfoBuffer;
       return moduleHeaderInfoBuffer;
    }
+
+   std::mutex &GetModuleHeaderInfoBufferMutex() {
+      static std::mutex moduleHeaderInfoBufferMutex;
+      return moduleHeaderInfoBufferMutex;
+   }
 }
 
 Int_t  TROOT::fgDirLevel = 0;
@@ -376,16 +384,51 @@ namespace Internal {
       return gROOTLocal;
    }
 
+   // Set when the initialization of the interpreter is deferred until its first
+   // use, see Root.LazyInterpreter.
+   static std::atomic<bool> gInterpreterInitDeferred{false};
+
+   static Bool_t IsLazyInterpreter()
+   {
+      const char *lazy = gSystem->Getenv("ROOT_LAZY_INTERPRETER");
+      if (lazy && lazy[0])
+         return atoi(lazy) != 0;
+      return gEnv->GetValue("Root.LazyInterpreter", 0) != 0;
+   }
+
    TROOT *GetROOT2() {
       static Bool_t initInterpreter = kFALSE;
       if (!initInterpreter) {
          initInterpreter = kTRUE;
-         gROOTLocal->InitInterpreter();
+         if (IsLazyInterpreter())
+            gInterpreterInitDeferred = true;
+         else
+            gROOTLocal->InitInterpreter();
          // Load and init threads library
          gROOTLocal->InitThreads();
       }
       return gROOTLocal;
    }
+
+   ////////////////////////////////////////////////////////////////////////////////
+   /// Initialize the interpreter if its initialization was deferred until its
+   /// first use (see Root.LazyInterpreter) and did not happen yet. Called by
+   /// TInterpreter::Instance.
+
+   void InitDeferredInterpreter()
+   {
+      if (!gInterpreterInitDeferred)
+         return;
+      // Recursive, since the initialization itself uses gInterpreter; other
+      // threads wait until the interpreter is ready.
+      static std::recursive_mutex initMutex;
+      std::lock_guard<std::recursive_mutex> lock(initMutex);
+      static Bool_t initialized = kFALSE;
+      if (initialized)
+         return;
+      initialized = kTRUE;
+      gROOTLocal->InitInterpreter();
+   }
    typedef TROOT *(*GetROOTFun_t)();
 
    static GetROOTFun_t gGetROOT = &GetROOT1;
@@ -449,6 +492,49 @@ namespace Internal {
 #endif
    }
 
+   ////////////////////////////////////////////////////////////////////////////////
+   /// Runs task(arg, i) for each i in [0, ntasks) on the implicit multi-threading
+   /// pool, for the libraries that cannot depend on libImt, and returns once all
+   /// the tasks are done. The tasks are run serially if implicit multi-threading
+   /// is disabled.
+   void RunInImplicitMTPool(UInt_t ntasks, void (*task)(void *arg, UInt_t i), void *arg)
+   {
+#ifdef R__USE_IMT
+      if (ntasks > 1 && ROOT::IsImplicitMTEnabled()) {
+         static void (*sym)(UInt_t, void (*)(void *, UInt_t), void *) =
+            (void (*)(UInt_t, void (*)(void *, UInt_t), void *))Internal::GetSymInLibImt("ROOT_TImplicitMT_ForEach");
+         if (sym) {
+            sym(ntasks, task, arg);
+            return;
+         }
+      }
+#endif
+      for (UInt_t i = 0; i < ntasks; ++i)
+         task(arg, i);
+   }
+
+   ////////////////////////////////////////////////////////////////////////////////
+   /// Starts task(arg) on the implicit multi-threading pool and returns without
+   /// waiting for it, for the libraries that cannot depend on libImt. Returns
+   /// kFALSE, without running the task, if implicit multi-threading is disabled.
+   Bool_t EnqueueInImplicitMTPool(void (*task)(void *arg), void *arg)
+   {
+#ifdef R__USE_IMT
+      if (ROOT::IsImplicitMTEnabled()) {
+         static void (*sym)(void (*)(void *), void *) =
+            (void (*)(void (*)(void *), void *))Internal::GetSymInLibImt("ROOT_TImplicitMT_Enqueue");
+         if (sym) {
+            sym(task, arg);
+            return kTRUE;
+         }
+      }
+#else
+      (void)task;
+      (void)arg;
+#endif
+      return kFALSE;
+   }
+
    ////////////////////////////////////////////////////////////////////////////////
    /// Keeps track of the status of ImplicitMT w/o resorting to the load of
    /// libImt
@@ -539,6 +625,31 @@ namespace Internal {
 #endif
    }
 
+   ////////////////////////////////////////////////////////////////////////////////
+   /// Same as EnableImplicitMT(), but on machines with several NUMA nodes (e.g. sockets) the threads of the pool are
+   /// pinned to the cores of one node each, in blocks proportional to the number of cores of the nodes. Threads do not
+   /// migrate across nodes, so their data stays in the memory of their node, while idle threads can still steal work
+   /// from the other nodes. See ROOT::Internal::RTaskArenaWrapper. Linux only, elsewhere and on single-node machines
+   /// this is the same as EnableImplicitMT().
+   ///
+   /// @param[in] numthreads Number of threads to use, as in EnableImplicitMT().
+   void EnableNUMAAwareImplicitMT(UInt_t numthreads)
+   {
+#ifdef R__USE_IMT
+      if (ROOT::Internal::IsImplicitMTEnabledImpl())
+         return;
+      EnableThreadSafety();
+      static void (*sym)(UInt_t) =
+         (void (*)(UInt_t))Internal::GetSymInLibImt("ROOT_TImplicitMT_EnableNUMAAwareImplicitMT");
+      if (sym)
+         sym(numthreads);
+      ROOT::Internal::IsImplicitMTEnabledImpl() = true;
+#else
+      ::Warning("EnableNUMAAwareImplicitMT",
+                "Cannot enable implicit multi-threading with %d threads, please build ROOT with -Dimt=ON", numthreads);
+#endif
+   }
+
    ////////////////////////////////////////////////////////////////////////////////
    /// Disables the implicit multi-threading in ROOT (see EnableImplicitMT).
    void DisableImplicitMT()
@@ -1028,7 +1139,8 @@ void TROOT::AddClassGenerator(TClassGenerator *generator)
 
 void TROOT::Append(TObject *obj, Bool_t replace /* = kFALSE */)
 {
-   R__LOCKGUARD(gROOTMutex);
+   // Protected by the lock of the directory, not by gROOTMutex, so that
+   // appending objects to gROOT does not contend with the interpreter.
    TDirectory::Append(obj,replace);
 }
 
@@ -1636,7 +1748,7 @@ TFunction *TROOT::GetGlobalFunction(const char *function, const char *params,
       R__LOCKGUARD(gROOTMutex);
       return (TFunction *)GetListOfGlobalFunctions(load)->FindObject(function);
    } else {
-      if (!fInterpreter)
+      if (!gInterpreter)
          Fatal("GetGlobalFunction", "fInterpreter not initialized");
 
       R__LOCKGUARD(gROOTMutex);
@@ -1669,7 +1781,7 @@ TFunction *TROOT::GetGlobalFunctionWithPrototype(const char *function,
       R__LOCKGUARD(gROOTMutex);
       return (TFunction *)GetListOfGlobalFunctions(load)->FindObject(function);
    } else {
-      if (!fInterpreter)
+      if (!gInterpreter)
          Fatal("GetGlobalFunctionWithPrototype", "fInterpreter not initialized");
 
       R__LOCKGUARD(gROOTMutex);
@@ -1754,7 +1866,7 @@ TCollection *TROOT::GetListOfGlobals(Bool_t load)
       TGlobalMappedFunction::GetEarlyRegisteredGlobals().Clear();
    }
 
-   if (!fInterpreter)
+   if (!gInterpreter)
       Fatal("GetListOfGlobals", "fInterpreter not initialized");
 
    if (load) fGlobals->Load();
@@ -1778,7 +1890,7 @@ TCollection *TROOT::GetListOfGlobalFunctions(Bool_t load)
       fGlobalFunctions = new TListOfFunctions(nullptr);
    }
 
-   if (!fInterpreter)
+   if (!gInterpreter)
       Fatal("GetListOfGlobalFunctions", "fInterpreter not initialized");
 
    // A thread that calls with load==true and a thread that calls with load==false
@@ -1811,7 +1923,7 @@ TCollection *TROOT::GetListOfGlobalFunctions(Bool_t load)
 
 TCollection *TROOT::GetListOfTypes(Bool_t /* load */)
 {
-   if (!fInterpreter)
+   if (!gInterpreter)
       Fatal("GetListOfTypes", "fInterpreter not initialized");
 
    return fTypes;
@@ -1976,6 +2088,12 @@ void TROOT::InitSystem()
       Int_t zipmode = gEnv->GetValue("Root.CompressionAlgorithm", oldzipmode);
       if (zipmode != 0) R__SetZipMode(zipmode);
 
+      // Implementation of the ZLIB compression algorithm, registered by the library that provides it
+      const char *zlibBackend = gSystem->Getenv("ROOT_ZLIB_BACKEND");
+      if (!zlibBackend || !zlibBackend[0])
+         zlibBackend = gEnv->GetValue("Root.ZlibBackend", "zlib");
+      if (strcmp(zlibBackend, "zlib") != 0) R__SetZlibBackend(zlibBackend);
+
       const char *sdeb;
       if ((sdeb = gSystem->Getenv("ROOTDEBUG")))
          gDebug = atoi(sdeb);
@@ -2075,7 +2193,14 @@ void TROOT::InitInterpreter()
    fCleanups->Add(fInterpreter);
    fInterpreter->SetBit(kMustCleanup);
 
-   fgRootInit = kTRUE;
+   // Registrations are buffered until fgRootInit is set; take over the ones
+   // done so far.
+   std::vector<ModuleHeaderInfo_t> moduleHeaderInfos;
+   {
+      std::lock_guard<std::mutex> lock(GetModuleHeaderInfoBufferMutex());
+      fgRootInit = kTRUE;
+      moduleHeaderInfos.swap(GetModuleHeaderInfoBuffer());
+   }
 
    // initialize gClassTable is not already done
    if (!gClassTable)
@@ -2083,8 +2208,8 @@ void TROOT::InitInterpreter()
 
    // Initialize all registered dictionaries.
    for (std::vector<ModuleHeaderInfo_t>::const_iterator
-           li = GetModuleHeaderInfoBuffer().begin(),
-           le = GetModuleHeaderInfoBuffer().end(); li != le; ++li) {
+           li = moduleHeaderInfos.begin(),
+           le = moduleHeaderInfos.end(); li != le; ++li) {
          // process buffered module registrations
       fInterpreter->RegisterModule(li->fModuleName,
                                    li->fHeaders,
@@ -2097,7 +2222,6 @@ void TROOT::InitInterpreter()
                                    kTRUE /*lateRegistration*/,
                                    li->fHasCxxModule);
    }
-   GetModuleHeaderInfoBuffer().clear();
 
    fInterpreter->Initialize();
 }
@@ -2221,7 +2345,7 @@ Int_t TROOT::LoadMacro(const char *filename, int *error, Bool_t check)
    else
       terr = &lerr;
 
-   if (fInterpreter) {
+   if (gInterpreter) {
       TString aclicMode;
       TString arguments;
       TString io;
@@ -2264,7 +2388,7 @@ Longptr_t TROOT::Macro(const char *filename, Int_t *error, Bool_t padUpdate)
 {
    Longptr_t result = 0;
 
-   if (fInterpreter) {
+   if (gInterpreter) {
       TString aclicMode;
       TString arguments;
       TString io;
@@ -2361,7 +2485,7 @@ Longptr_t TROOT::ProcessLineFast(const char *line, Int_t *error)
 
    Longptr_t result = 0;
 
-   if (fInterpreter) {
+   if (gInterpreter) {
       TInterpreter::EErrorCode *code = (TInterpreter::EErrorCode*)error;
       result = gInterpreter->Calc(sline, code);
    }
@@ -2474,7 +2598,8 @@ void TROOT::RefreshBrowsers()
 
 static void CallCloseFiles()
 {
-   if (TROOT::Initialized() && ROOT::Internal::gROOTLocal) {
+   // TROOT::Initialized() stays false as long as a deferred interpreter did not start.
+   if ((TROOT::Initialized() || ROOT::Internal::gInterpreterInitDeferred) && ROOT::Internal::gROOTLocal) {
       gROOT->CloseFiles();
    }
 }
@@ -2553,24 +2678,28 @@ void TROOT::RegisterModule(const char* modulename,
 
    atexit(CallCloseFiles);
 
-   // Now register with TCling.
-   if (TROOT::Initialized()) {
-      gCling->RegisterModule(modulename, headers, includePaths, payloadCode, fwdDeclCode, triggerFunc,
-                             fwdDeclsArgToSkip, classesHeaders, false, hasCxxModule);
-   } else {
-      GetModuleHeaderInfoBuffer().push_back(ModuleHeaderInfo_t(modulename, headers, includePaths, payloadCode,
-                                                               fwdDeclCode, triggerFunc, fwdDeclsArgToSkip,
-                                                               classesHeaders, hasCxxModule));
+   // Now register with TCling. With a deferred interpreter (see Root.LazyInterpreter)
+   // another thread might be starting it and replaying the buffered registrations.
+   {
+      std::lock_guard<std::mutex> lock(GetModuleHeaderInfoBufferMutex());
+      if (!TROOT::Initialized()) {
+         GetModuleHeaderInfoBuffer().push_back(ModuleHeaderInfo_t(modulename, headers, includePaths, payloadCode,
+                                                                  fwdDeclCode, triggerFunc, fwdDeclsArgToSkip,
+                                                                  classesHeaders, hasCxxModule));
+         return;
+      }
    }
+   gCling->RegisterModule(modulename, headers, includePaths, payloadCode, fwdDeclCode, triggerFunc,
+                          fwdDeclsArgToSkip, classesHeaders, false, hasCxxModule);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 /// Remove an object from the in-memory list.
-///    Since TROOT is global resource, this is lock protected.
+///    Since TROOT is global resource, this is protected by the lock of the
+///    directory (see TDirectory::Append).
 
 TObject *TROOT::Remove(TObject* obj)
 {
-   R__LOCKGUARD(gROOTMutex);
    return TDirectory::Remove(obj);
 }
 
@@ -2604,6 +2733,8 @@ void TROOT::RemoveClass(TClass *oldcl)
 void TROOT::Reset(Option_t *option)
 {
    if (IsExecutingMacro()) return;  //True when TMacro::Exec runs
+   // An interpreter whose initialization is deferred and did not happen yet
+   // (see Root.LazyInterpreter) has nothing to reset; do not start it for that.
    if (fInterpreter) {
       if (!strncmp(option, "a", 1)) {
          fInterpreter->Reset();
@@ -0,0 +1,79 @@
+#include "ROOT/RByteSwap.hxx"
+
+#include "gtest/gtest.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+namespace {
+
+// Reverses the bytes of every element of `size` bytes, one byte at a time
+std::vector<unsigned char> ReferenceSwap(const std::vector<unsigned char> &in, std::size_t size)
+{
+   std::vector<unsigned char> out(in.size());
+   for (std::size_t i = 0; i < in.size(); i += size) {
+      for (std::size_t b = 0; b < size; ++b)
+         out[i + b] = in[i + size - 1 - b];
+   }
+   return out;
+}
+
+void CheckSwap(void (*swap)(void *, const void *, std::size_t), std::size_t size)
+{
+   // Sizes around the vector widths, and arrays starting at unaligned addresses
+   for (std::size_t n : {0, 1, 3, 7, 8, 15, 16, 17, 31, 33, 64, 100, 1000}) {
+      for (std::size_t offset : {0, 1, 3}) {
+         std::vector<unsigned char> in(n * size);
+         for (std::size_t i = 0; i < in.size(); ++i)
+            in[i] = static_cast<unsigned char>(i * 7 + 1);
+         const auto expected = ReferenceSwap(in, size);
+
+         std::vector<unsigned char> from(in.size() + offset), to(in.size() + offset);
+         std::copy(in.begin(), in.end(), from.begin() + offset);
+         swap(to.data() + offset, from.data() + offset, n);
+         EXPECT_TRUE(std::equal(expected.begin(), expected.end(), to.begin() + offset))
+            << "size " << size << ", n " << n << ", offset " << offset;
+
+         // In place
+         swap(from.data() + offset, from.data() + offset, n);
+         EXPECT_TRUE(std::equal(expected.begin(), expected.end(), from.begin() + offset))
+            << "in place, size " << size << ", n " << n << ", offset " << offset;
+      }
+   }
+}
+
+} // anonymous namespace
+
+TEST(RByteSwap, Copy16)
+{
+   CheckSwap(ROOT::Internal::ByteSwapCopy16, 2);
+}
+
+TEST(RByteSwap, Copy32)
+{
+   CheckSwap(ROOT::Internal::ByteSwapCopy32, 4);
+}
+
+TEST(RByteSwap, Copy64)
+{
+   CheckSwap(ROOT::Internal::ByteSwapCopy64, 8);
+}
+
+TEST(RByteSwap, Values)
+{
+   const float f = 1.5f;
+   std::uint32_t fBits;
+   std::memcpy(&fBits, &f, sizeof(f));
+   std::uint32_t swapped;
+   ROOT::Internal::ByteSwapCopy32(&swapped, &f, 1);
+   EXPECT_EQ(swapped, ((fBits & 0xff) << 24) | ((fBits & 0xff00) << 8) | ((fBits >> 8) & 0xff00) | (fBits >> 24));
+
+   const std::uint64_t l = 0x0102030405060708ULL;
+   std::uint64_t lSwapped;
+   ROOT::Internal::ByteSwapCopy64(&lSwapped, &l, 1);
+   EXPECT_EQ(lSwapped, 0x0807060504030201ULL);
+
+   EXPECT_NE(ROOT::Internal::GetByteSwapKernelName(), nullptr);
+}
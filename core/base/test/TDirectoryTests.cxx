@@ -0,0 +1,48 @@
+#include "gtest/gtest.h"
+
+#include "TDirectory.h"
+#include "TList.h"
+#include "TNamed.h"
+#include "TString.h"
+
+#include <thread>
+#include <vector>
+
+TEST(TDirectory, DeferredRegistration)
+{
+   TDirectory dir("dir", "dir");
+   auto a = new TNamed("a", "a");
+   auto b = new TNamed("b", "b");
+   {
+      TDirectory::TDeferredRegistration registration;
+      dir.Append(a);
+      dir.Append(b);
+      EXPECT_EQ(0, dir.GetList()->GetSize());
+      EXPECT_EQ(a, dir.FindObject("a"));
+      EXPECT_EQ(b, dir.FindObject(b));
+      EXPECT_EQ(b, dir.Remove(b));
+      EXPECT_EQ(nullptr, dir.FindObject("b"));
+   }
+   EXPECT_EQ(1, dir.GetList()->GetSize());
+   EXPECT_EQ(a, dir.GetList()->First());
+   EXPECT_EQ(a, dir.FindObject("a"));
+   delete b;
+}
+
+TEST(TDirectory, DeferredRegistrationFromThreads)
+{
+   TDirectory dir("dir", "dir");
+   const int nThreads = 4;
+   const int nObjects = 1000;
+   std::vector<std::thread> threads;
+   for (int t = 0; t < nThreads; ++t) {
+      threads.emplace_back([&dir, t]() {
+         TDirectory::TDeferredRegistration registration;
+         for (int i = 0; i < nObjects; ++i)
+            dir.Append(new TNamed(TString::Format("obj_%d_%d", t, i).Data(), ""));
+      });
+   }
+   for (auto &thread : threads)
+      thread.join();
+   EXPECT_EQ(nThreads * nObjects, dir.GetList()->GetSize());
+}
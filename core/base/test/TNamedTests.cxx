@@ -2,6 +2,9 @@
 #include "gmock/gmock.h"
 
 #include "TNamed.h"
+#include "TObjString.h"
+
+#include <utility>
 
 TEST(TNamed, Sanity)
 {
@@ -9,3 +12,32 @@ TEST(TNamed, Sanity)
    EXPECT_STREQ("Name", n.GetName());
    EXPECT_STREQ("Title", n.GetTitle());
 }
+
+TEST(TNamed, MoveNameTitle)
+{
+   TString name("A name too long for the short string storage");
+   TString title("A title too long for the short string storage");
+   const char *nameData = name.Data();
+   TNamed n(std::move(name), std::move(title));
+   EXPECT_STREQ("A name too long for the short string storage", n.GetName());
+   EXPECT_STREQ("A title too long for the short string storage", n.GetTitle());
+   // the long string buffer was moved into the TNamed
+   EXPECT_EQ(nameData, n.GetName());
+}
+
+TEST(TObjString, MoveString)
+{
+   TString s("A string too long for the short string storage");
+   const char *data = s.Data();
+   TObjString os(std::move(s));
+   EXPECT_EQ(data, os.GetName());
+
+   TString other("Another string too long for the short string storage");
+   data = other.Data();
+   os.SetString(std::move(other));
+   EXPECT_EQ(data, os.GetName());
+
+   TObjString copy(os.GetString());
+   EXPECT_STREQ(os.GetName(), copy.GetName());
+   EXPECT_NE(os.GetName(), copy.GetName());
+}
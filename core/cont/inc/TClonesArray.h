@@ -26,11 +26,22 @@
 
 class TClass;
 
+namespace ROOT {
+namespace Internal {
+class TClonesArrayArena;
+}
+}
+
 class TClonesArray : public TObjArray {
 
 protected:
    TClass       *fClass;       //!Pointer to the class of the elements
    TObjArray    *fKeep;        //!Saved copies of pointers to objects
+   ROOT::Internal::TClonesArrayArena *fArena = nullptr; //!Blocks of memory of the objects, see UseArena
+
+private:
+   TObject         *NewObject();
+   void             ReleaseObject(TObject *obj);
 
 public:
    enum EStatusBits {
@@ -66,6 +77,8 @@ public:
    TObject         *ConstructedAt(Int_t idx, Option_t *clear_options);
    void             SetClass(const char *classname,Int_t size=1000);
    void             SetClass(const TClass *cl,Int_t size=1000);
+   void             UseArena(Bool_t use = kTRUE);
+   Bool_t           IsUsingArena() const;
 
    void             AbsorbObjects(TClonesArray *tc);
    void             AbsorbObjects(TClonesArray *tc, Int_t idx1, Int_t idx2);
@@ -68,6 +68,7 @@ public:
    TObject   *Remove(TObject *obj);
    TObject   *Remove(TObjLink *lnk);
    bool       UseRWLock();
+   void       UseNameIndex();
 
    ClassDef(THashList,0)  //Doubly linked list with hashtable for lookup
 };
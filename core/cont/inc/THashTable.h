@@ -31,6 +31,12 @@ class TList;
 class TListIter;
 class THashTableIter;
 
+namespace ROOT {
+namespace Internal {
+class THashTableNameIndex;
+}
+}
+
 
 class THashTable : public TCollection {
 
@@ -41,6 +47,7 @@ private:
    Int_t       fEntries;       //Number of objects in table
    Int_t       fUsedSlots;     //Number of used slots
    Int_t       fRehashLevel;   //Average collision rate which triggers rehash
+   ROOT::Internal::THashTableNameIndex *fNameIndex; //!Index of the objects by name, see UseNameIndex
 
    Int_t       GetCheckedHashValue(TObject *obj) const;
    Int_t       GetHashValue(const TObject *obj) const;
@@ -48,6 +55,7 @@ private:
    Int_t       GetHashValue(const char *str) const { return ::Hash(str) % fSize; }
 
    void        AddImpl(Int_t slot, TObject *object);
+   void        RebuildNameIndex();
 
    THashTable(const THashTable&) = delete;
    THashTable& operator=(const THashTable&) = delete;
@@ -78,6 +86,8 @@ public:
    TObject      *Remove(TObject *obj);
    TObject      *RemoveSlow(TObject *obj);
    void          SetRehashLevel(Int_t rehash) { fRehashLevel = rehash; }
+   void          UseNameIndex();
+   Bool_t        HasNameIndex() const { return fNameIndex != nullptr; }
 
    ClassDef(THashTable,0)  //A hash table
 };
@@ -52,7 +52,8 @@ public:
       kIsAssociative = BIT(2),
       kIsEmulated    = BIT(3),
       kNeedDelete    = BIT(4),  // Flag to indicate that this collection that contains directly or indirectly (only via other collection) some pointers that will need explicit deletions.
-      kCustomAlloc   = BIT(5)   // The collection has a custom allocator.
+      kCustomAlloc   = BIT(5),  // The collection has a custom allocator.
+      kIsContiguous  = BIT(6)   // The elements are stored one after the other, i.e. At(i) == (char*)At(0) + i * element size.
    };
 
    class TPushPop {
@@ -121,6 +121,17 @@ When investigating misuse of TClonesArray, please make sure of the following:
      TClonesArrays are not destroyed and created on every event. They
      must only be constructed/destructed at the beginning/end of the
      run.
+
+### NOTE 3
+
+By default each object is allocated individually on the heap the first
+time its slot is used. After UseArena(), the objects are instead
+allocated in large blocks of memory owned by the array. This replaces the
+many small allocations of a large array (e.g. when reading a branch of
+objects with many threads) by a few large ones, and keeps the objects
+contiguous in memory. The objects of an arena are not on the heap
+(TObject::IsOnHeap returns false): like all objects of a TClonesArray,
+they must not be deleted.
 */
 
 #include "TClonesArray.h"
@@ -133,10 +144,92 @@ When investigating misuse of TClonesArray, please make sure of the following:
 #include "TObjectTable.h"
 #include "snprintf.h"
 
+#include <algorithm>
+#include <cstddef>
 #include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <vector>
 
 ClassImp(TClonesArray);
 
+namespace ROOT {
+namespace Internal {
+
+/// Memory of the objects of a TClonesArray, allocated in blocks of increasing
+/// size and freed with the last array using it, see TClonesArray::UseArena.
+class TClonesArrayArena {
+   struct Block {
+      std::shared_ptr<char> fMemory;
+      std::size_t fSize;
+   };
+
+   std::size_t fObjectSize;           ///< Size of the slots, aligned for any object
+   std::vector<Block> fBlocks;        ///< Blocks holding the objects, possibly shared with other arenas
+   std::vector<void *> fFree;         ///< Released slots, reused first
+   char *fNext = nullptr;             ///< Next unused slot of the last block
+   char *fEnd = nullptr;              ///< End of the last block
+   std::size_t fNextBlockObjects = 16; ///< Number of objects of the next block
+   bool fEnabled = true;              ///< Whether new objects are allocated in the arena
+
+public:
+   explicit TClonesArrayArena(std::size_t objectSize)
+      : fObjectSize((objectSize + alignof(std::max_align_t) - 1) / alignof(std::max_align_t) *
+                    alignof(std::max_align_t))
+   {
+   }
+
+   bool IsEnabled() const { return fEnabled; }
+   void SetEnabled(bool enabled) { fEnabled = enabled; }
+
+   /// Return zeroed memory for an object of the given size, or nullptr if it
+   /// does not fit in the slots of the arena.
+   void *Allocate(std::size_t size)
+   {
+      if (size > fObjectSize)
+         return nullptr;
+      if (!fFree.empty()) {
+         void *slot = fFree.back();
+         fFree.pop_back();
+         memset(slot, 0, fObjectSize);
+         return slot;
+      }
+      if (fNext == fEnd) {
+         const std::size_t blockSize = fNextBlockObjects * fObjectSize;
+         fBlocks.push_back({std::shared_ptr<char>(new char[blockSize](), std::default_delete<char[]>()), blockSize});
+         fNext = fBlocks.back().fMemory.get();
+         fEnd = fNext + blockSize;
+         fNextBlockObjects = std::min<std::size_t>(2 * fNextBlockObjects, 1024);
+      }
+      void *slot = fNext;
+      fNext += fObjectSize;
+      return slot;
+   }
+
+   /// Make the slot of a destructed object available again.
+   void Release(void *slot) { fFree.push_back(slot); }
+
+   bool Contains(const void *ptr) const
+   {
+      auto p = static_cast<const char *>(ptr);
+      return std::any_of(fBlocks.begin(), fBlocks.end(), [p](const Block &block) {
+         return block.fMemory.get() <= p && p < block.fMemory.get() + block.fSize;
+      });
+   }
+
+   /// Keep the blocks of another arena alive, since some of its objects are moved here.
+   void Share(const TClonesArrayArena &other)
+   {
+      for (const auto &block : other.fBlocks) {
+         if (!Contains(block.fMemory.get()))
+            fBlocks.insert(fBlocks.begin(), block);
+      }
+   }
+};
+
+} // namespace Internal
+} // namespace ROOT
+
 // To allow backward compatibility of TClonesArray of v5 TF1 objects
 // that were stored member-wise.
 using Updater_t = void (*)(Int_t nobjects, TObject **from, TObject **to);
@@ -154,9 +247,17 @@ bool R__SetClonesArrayTFormulaUpdater(Updater_t func) {
 }
 
 /// Internal Utility routine to correctly release the memory for an object
-static inline void R__ReleaseMemory(TClass *cl, TObject *obj)
+static inline void R__ReleaseMemory(TClass *cl, TObject *obj, ROOT::Internal::TClonesArrayArena *arena)
 {
-   if (obj && obj->TestBit(TObject::kNotDeleted)) {
+   if (obj && arena && arena->Contains(obj)) {
+      // -- The memory belongs to the arena, only call the destructor.
+      if (obj->TestBit(TObject::kNotDeleted)) {
+         cl->Destructor(obj, kTRUE);
+      } else if (TObject::GetObjectStat() && gObjectTable) {
+         gObjectTable->RemoveQuietly(obj);
+      }
+      arena->Release(obj);
+   } else if (obj && obj->TestBit(TObject::kNotDeleted)) {
       // -- The TObject destructor has not been called.
       cl->Destructor(obj);
    } else {
@@ -247,7 +348,7 @@ TClonesArray& TClonesArray::operator=(const TClonesArray& tc)
 
    for (i = 0; i < fSize; i++)
       if (fKeep->fCont[i]) {
-         R__ReleaseMemory(fClass,fKeep->fCont[i]);
+         ReleaseObject(fKeep->fCont[i]);
          fKeep->fCont[i] = nullptr;
          fCont[i] = nullptr;
       }
@@ -271,16 +372,67 @@ TClonesArray::~TClonesArray()
 {
    if (fKeep) {
       for (Int_t i = 0; i < fKeep->fSize; i++) {
-         R__ReleaseMemory(fClass,fKeep->fCont[i]);
+         ReleaseObject(fKeep->fCont[i]);
          fKeep->fCont[i] = nullptr;
       }
    }
    SafeDelete(fKeep);
+   delete fArena;
 
    // Protect against erroneously setting of owner bit
    SetOwner(kFALSE);
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Create an object of the class of the array with its default constructor,
+/// in the arena if enabled.
+
+TObject *TClonesArray::NewObject()
+{
+   if (fArena && fArena->IsEnabled()) {
+      if (void *slot = fArena->Allocate(fClass->Size()))
+         return (TObject*)fClass->New(slot);
+   }
+   return (TObject*)fClass->New();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Destruct an object of the array and release its memory.
+
+void TClonesArray::ReleaseObject(TObject *obj)
+{
+   R__ReleaseMemory(fClass, obj, fArena);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Allocate the objects created from now on in blocks of memory owned by the
+/// array instead of individually on the heap (see NOTE 3 of the class
+/// documentation). The objects already allocated in the arena keep their
+/// memory when it is disabled.
+
+void TClonesArray::UseArena(Bool_t use)
+{
+   if (!fClass) {
+      Error("UseArena", "invalid class specified in TClonesArray ctor");
+      return;
+   }
+   if (!fArena) {
+      if (!use)
+         return;
+      fArena = new ROOT::Internal::TClonesArrayArena(fClass->Size());
+   }
+   fArena->SetEnabled(use);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return true if the objects created from now on are allocated in the arena,
+/// see UseArena.
+
+Bool_t TClonesArray::IsUsingArena() const
+{
+   return fArena && fArena->IsEnabled();
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// When the kBypassStreamer bit is set, the automatically
 /// generated Streamer can call directly TClass::WriteBuffer.
@@ -482,7 +634,7 @@ void TClonesArray::Expand(Int_t newSize)
       // Expand() will shrink correctly
       for (int i = newSize; i < fSize; i++)
          if (fKeep->fCont[i]) {
-            R__ReleaseMemory(fClass,fKeep->fCont[i]);
+            ReleaseObject(fKeep->fCont[i]);
             fKeep->fCont[i] = nullptr;
          }
    }
@@ -515,7 +667,7 @@ void TClonesArray::ExpandCreate(Int_t n)
    Int_t i;
    for (i = 0; i < n; i++) {
       if (!fKeep->fCont[i]) {
-         fKeep->fCont[i] = (TObject*)fClass->New();
+         fKeep->fCont[i] = NewObject();
       } else if (!fKeep->fCont[i]->TestBit(kNotDeleted)) {
          // The object has been deleted (or never initialized)
          fClass->New(fKeep->fCont[i]);
@@ -525,7 +677,7 @@ void TClonesArray::ExpandCreate(Int_t n)
 
    for (i = n; i < fSize; i++)
       if (fKeep->fCont[i]) {
-         R__ReleaseMemory(fClass,fKeep->fCont[i]);
+         ReleaseObject(fKeep->fCont[i]);
          fKeep->fCont[i] = nullptr;
          fCont[i] = nullptr;
       }
@@ -552,7 +704,7 @@ void TClonesArray::ExpandCreateFast(Int_t n)
    Int_t i;
    for (i = 0; i < n; i++) {
       if (i >= oldSize || !fKeep->fCont[i]) {
-         fKeep->fCont[i] = (TObject*)fClass->New();
+         fKeep->fCont[i] = NewObject();
       } else if (!fKeep->fCont[i]->TestBit(kNotDeleted)) {
          // The object has been deleted (or never initialized)
          fClass->New(fKeep->fCont[i]);
@@ -800,7 +952,7 @@ void TClonesArray::Streamer(TBuffer &b)
       if (CanBypassStreamer() && !b.TestBit(TBuffer::kCannotHandleMemberWiseStreaming)) {
          for (Int_t i = 0; i < nobjects; i++) {
             if (!fKeep->fCont[i]) {
-               fKeep->fCont[i] = (TObject*)fClass->New();
+               fKeep->fCont[i] = NewObject();
             } else if (!fKeep->fCont[i]->TestBit(kNotDeleted)) {
                // The object has been deleted (or never initialized)
                fClass->New(fKeep->fCont[i]);
@@ -835,7 +987,7 @@ void TClonesArray::Streamer(TBuffer &b)
             b >> nch;
             if (nch) {
                if (!fKeep->fCont[i])
-                  fKeep->fCont[i] = (TObject*)fClass->New();
+                  fKeep->fCont[i] = NewObject();
                else if (!fKeep->fCont[i]->TestBit(kNotDeleted)) {
                   // The object has been deleted (or never initialized)
                   fClass->New(fKeep->fCont[i]);
@@ -919,7 +1071,8 @@ TObject *&TClonesArray::operator[](Int_t idx)
       Expand(TMath::Max(idx+1, GrowBy(fSize)));
 
    if (!fKeep->fCont[idx]) {
-      fKeep->fCont[idx] = (TObject*) TStorage::ObjectAlloc(fClass->Size());
+      void *arenaSlot = fArena && fArena->IsEnabled() ? fArena->Allocate(fClass->Size()) : nullptr;
+      fKeep->fCont[idx] = (TObject*) (arenaSlot ? arenaSlot : TStorage::ObjectAlloc(fClass->Size()));
       // Reset the bit so that:
       //    obj = myClonesArray[i];
       //    obj->TestBit(TObject::kNotDeleted)
@@ -1018,11 +1171,20 @@ void TClonesArray::AbsorbObjects(TClonesArray *tc, Int_t idx1, Int_t idx2)
    if(newSize > fSize)
       Expand(newSize);
 
+   // the objects of the arena of tc must stay valid after tc is deleted
+   if (tc->fArena) {
+      if (!fArena) {
+         fArena = new ROOT::Internal::TClonesArrayArena(fClass->Size());
+         fArena->SetEnabled(false);
+      }
+      fArena->Share(*tc->fArena);
+   }
+
    // move
    for (Int_t i = idx1; i <= idx2; i++) {
       Int_t newindex = oldSize+i -idx1;
       fCont[newindex] = tc->fCont[i];
-      R__ReleaseMemory(fClass,fKeep->fCont[newindex]);
+      ReleaseObject(fKeep->fCont[newindex]);
       (*fKeep)[newindex] = (*(tc->fKeep))[i];
       tc->fCont[i] = 0;
       (*(tc->fKeep))[i] = 0;
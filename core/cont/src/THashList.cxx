@@ -410,4 +410,14 @@ bool THashList::UseRWLock()
 {
    fTable->UseRWLock();
    return TCollection::UseRWLock();
-}
\ No newline at end of file
+}
+////////////////////////////////////////////////////////////////////////////////
+/// Index the objects by name for faster lookups by name, see
+/// THashTable::UseNameIndex.
+
+void THashList::UseNameIndex()
+{
+   R__COLLECTION_WRITE_LOCKGUARD(ROOT::gCoreMutex);
+
+   fTable->UseNameIndex();
+}
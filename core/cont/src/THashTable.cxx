@@ -19,6 +19,11 @@ Hash() as it sees fit.
 THashTable does not preserve the insertion order of the objects.
 If the insertion order is important AND fast retrieval is needed
 use THashList instead.
+
+Large tables of named objects, e.g. the list of keys of a directory,
+can in addition index their objects by name with UseNameIndex(), which
+makes FindObject(const char*) independent of the length of the lists
+of the slots.
 */
 
 #include "THashTable.h"
@@ -27,8 +32,123 @@ use THashList instead.
 #include "TError.h"
 #include "TROOT.h"
 
+#include <cstring>
+#include <vector>
+
 ClassImp(THashTable);
 
+namespace ROOT {
+namespace Internal {
+
+/// Open addressing (linear probing) index of the objects of a THashTable by
+/// their hash value, used to find objects by name without walking the list
+/// of their slot. The entries hold the full hash value, so that only the
+/// names of the objects with the same hash value are compared.
+class THashTableNameIndex {
+   struct Entry {
+      ULong_t fHash;
+      TObject *fObject; ///< nullptr if the entry is empty, Removed() if its object was removed
+   };
+
+   std::vector<Entry> fEntries; ///< Number of entries is a power of two
+   std::size_t fUsed = 0;       ///< Number of entries not empty, including the removed ones
+
+   static TObject *Removed()
+   {
+      static char removed;
+      return reinterpret_cast<TObject *>(&removed);
+   }
+
+   std::size_t Start(ULong_t hash) const
+   {
+      // Fibonacci hashing: spread the hash values over the entries
+      return (std::size_t)(((ULong64_t)hash * 0x9E3779B97F4A7C15ull) >> 32) & (fEntries.size() - 1);
+   }
+
+   void Grow()
+   {
+      std::vector<Entry> old;
+      old.swap(fEntries);
+      std::size_t size = 64;
+      while (size < 4 * (fUsed + 1))
+         size *= 2;
+      fEntries.assign(size, Entry{0, nullptr});
+      fUsed = 0;
+      for (const auto &entry : old) {
+         if (entry.fObject && entry.fObject != Removed())
+            Insert(entry.fHash, entry.fObject);
+      }
+   }
+
+public:
+   void Clear()
+   {
+      fEntries.clear();
+      fUsed = 0;
+   }
+
+   void Insert(ULong_t hash, TObject *obj)
+   {
+      if (2 * (fUsed + 1) > fEntries.size())
+         Grow();
+      const std::size_t mask = fEntries.size() - 1;
+      std::size_t i = Start(hash);
+      while (fEntries[i].fObject)
+         i = (i + 1) & mask;
+      fEntries[i] = Entry{hash, obj};
+      ++fUsed;
+   }
+
+   /// Remove the object, looking it up by its hash value first and in all the
+   /// entries if its hash value changed.
+   void Remove(ULong_t hash, TObject *obj)
+   {
+      if (fEntries.empty())
+         return;
+      const std::size_t mask = fEntries.size() - 1;
+      for (std::size_t i = Start(hash); fEntries[i].fObject; i = (i + 1) & mask) {
+         if (fEntries[i].fObject == obj) {
+            fEntries[i].fObject = Removed();
+            return;
+         }
+      }
+      for (auto &entry : fEntries) {
+         if (entry.fObject == obj) {
+            entry.fObject = Removed();
+            return;
+         }
+      }
+   }
+
+   /// Return the object with the given name and hash value, and set unique to
+   /// false if there is more than one.
+   TObject *Find(ULong_t hash, const char *name, Bool_t &unique) const
+   {
+      unique = kTRUE;
+      if (fEntries.empty())
+         return nullptr;
+      TObject *found = nullptr;
+      const std::size_t mask = fEntries.size() - 1;
+      for (std::size_t i = Start(hash); fEntries[i].fObject; i = (i + 1) & mask) {
+         const Entry &entry = fEntries[i];
+         if (entry.fHash != hash || entry.fObject == Removed())
+            continue;
+         const char *objname = entry.fObject->GetName();
+         if (objname && strcmp(name, objname) == 0) {
+            if (found) {
+               unique = kFALSE;
+               return found;
+            }
+            found = entry.fObject;
+         }
+      }
+      return found;
+   }
+};
+
+} // namespace Internal
+} // namespace ROOT
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Create a THashTable object. Capacity is the initial hashtable capacity
 /// (i.e. number of slots), by default kInitHashTableCapacity = 17, and
@@ -56,6 +176,7 @@ THashTable::THashTable(Int_t capacity, Int_t rehashlevel)
    fUsedSlots = 0;
    if (rehashlevel < 2) rehashlevel = 0;
    fRehashLevel = rehashlevel;
+   fNameIndex = nullptr;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -66,6 +187,7 @@ THashTable::~THashTable()
 {
    if (fCont) Clear();
    delete [] fCont;
+   delete fNameIndex;
    fCont = 0;
    fSize = 0;
 }
@@ -93,11 +215,13 @@ void THashTable::Add(TObject *obj)
 {
    if (IsArgNull("Add", obj)) return;
 
-   Int_t slot = GetCheckedHashValue(obj);
+   ULong_t hash = obj->CheckedHash();
+   Int_t slot = Int_t(hash % fSize);
 
    R__COLLECTION_WRITE_LOCKGUARD(ROOT::gCoreMutex);
 
    AddImpl(slot,obj);
+   if (fNameIndex) fNameIndex->Insert(hash, obj);
 
    if (fRehashLevel && AverageCollisions() > fRehashLevel)
       Rehash(fEntries);
@@ -113,9 +237,11 @@ void THashTable::AddBefore(const TObject *before, TObject *obj)
 {
    if (IsArgNull("Add", obj)) return;
 
-   Int_t slot = GetCheckedHashValue(obj);
+   ULong_t hash = obj->CheckedHash();
+   Int_t slot = Int_t(hash % fSize);
 
    R__COLLECTION_WRITE_LOCKGUARD(ROOT::gCoreMutex);
+   if (fNameIndex) fNameIndex->Insert(hash, obj);
    if (!fCont[slot]) {
       fCont[slot] = new TList;
       fUsedSlots++;
@@ -178,6 +304,7 @@ void THashTable::Clear(Option_t *option)
       }
       SafeDelete(fCont[i]);
    }
+   if (fNameIndex) fNameIndex->Clear();
 
    fEntries   = 0;
    fUsedSlots = 0;
@@ -226,6 +353,7 @@ void THashTable::Delete(Option_t *)
          fCont[i]->Delete();
          SafeDelete(fCont[i]);
       }
+   if (fNameIndex) fNameIndex->Clear();
 
    fEntries   = 0;
    fUsedSlots = 0;
@@ -237,10 +365,17 @@ void THashTable::Delete(Option_t *)
 
 TObject *THashTable::FindObject(const char *name) const
 {
-   Int_t slot = GetHashValue(name);
+   UInt_t hash = ::Hash(name);
+   Int_t slot = hash % fSize;
 
    R__COLLECTION_READ_LOCKGUARD(ROOT::gCoreMutex);
 
+   if (fNameIndex && name) {
+      // Objects with the same name are returned in the order of their slot's list.
+      Bool_t unique;
+      TObject *obj = fNameIndex->Find(hash, name, unique);
+      if (unique) return obj;
+   }
    if (fCont[slot]) return fCont[slot]->FindObject(name);
    return 0;
 }
@@ -394,7 +529,10 @@ void THashTable::Rehash(Int_t newCapacity, Bool_t checkObjValidity)
 
    }
 
+   auto nameIndex = fNameIndex;
+   fNameIndex = nullptr;
    Clear("nodelete");
+   fNameIndex = nameIndex;
    delete [] fCont;
    fCont = ht->fCont;
    ht->fCont = 0;
@@ -409,6 +547,39 @@ void THashTable::Rehash(Int_t newCapacity, Bool_t checkObjValidity)
       fRehashLevel = (int)AverageCollisions() + 1;
 
    delete ht;
+
+   // the objects no longer valid were dropped
+   if (fNameIndex && checkObjValidity) RebuildNameIndex();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Refill the name index with the objects of the table.
+
+void THashTable::RebuildNameIndex()
+{
+   fNameIndex->Clear();
+   TIter next(this);
+   while (TObject *obj = next())
+      fNameIndex->Insert(obj->Hash(), obj);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Index the objects of the table by name and hash value, in an open
+/// addressing table, so that FindObject(const char*) only compares the names
+/// of the objects with the same hash value instead of walking the list of a
+/// slot. This pays off for large tables with long lists, e.g. to look up the
+/// keys of a directory, and costs about two pointers of memory per object.
+///
+/// The hash value of the objects must be the hash value of their name, as for
+/// TNamed.
+
+void THashTable::UseNameIndex()
+{
+   R__COLLECTION_WRITE_LOCKGUARD(ROOT::gCoreMutex);
+
+   if (fNameIndex) return;
+   fNameIndex = new ROOT::Internal::THashTableNameIndex;
+   RebuildNameIndex();
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -425,6 +596,7 @@ TObject *THashTable::Remove(TObject *obj)
 
       TObject *ob = fCont[slot]->Remove(obj);
       if (ob) {
+         if (fNameIndex) fNameIndex->Remove(ob->Hash(), ob);
          fEntries--;
          if (fCont[slot]->GetSize() == 0) {
             SafeDelete(fCont[slot]);
@@ -448,6 +620,8 @@ TObject *THashTable::RemoveSlow(TObject *obj)
       if (fCont[i]) {
          TObject *ob = fCont[i]->Remove(obj);
          if (ob) {
+            // the hash value of the object may have changed
+            if (fNameIndex) fNameIndex->Remove(0, ob);
             fEntries--;
             if (fCont[i]->GetSize() == 0) {
                SafeDelete(fCont[i]);
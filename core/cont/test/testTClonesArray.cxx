@@ -0,0 +1,44 @@
+#include "TClonesArray.h"
+#include "TNamed.h"
+
+#include "gtest/gtest.h"
+
+TEST(TClonesArray, Arena)
+{
+   TClonesArray arr("TNamed", 4);
+   EXPECT_FALSE(arr.IsUsingArena());
+   arr.UseArena();
+   EXPECT_TRUE(arr.IsUsingArena());
+
+   for (int event = 0; event < 3; ++event) {
+      const int n = 100 + 50 * event;
+      for (int i = 0; i < n; ++i)
+         new (arr[i]) TNamed(TString::Format("n%d", i).Data(), "title");
+      EXPECT_EQ(n, arr.GetEntriesFast());
+      auto named = static_cast<TNamed *>(arr.At(n - 1));
+      EXPECT_STREQ(TString::Format("n%d", n - 1).Data(), named->GetName());
+      EXPECT_FALSE(named->IsOnHeap());
+      arr.Delete();
+   }
+
+   arr.ExpandCreate(500);
+   EXPECT_EQ(500, arr.GetEntriesFast());
+   arr.ExpandCreate(10);
+   arr.ExpandCreate(500);
+   EXPECT_STREQ("", static_cast<TNamed *>(arr.At(499))->GetName());
+
+   // The absorbed objects outlive the array they were allocated by.
+   TClonesArray other("TNamed");
+   {
+      TClonesArray source("TNamed");
+      source.UseArena();
+      new (source[0]) TNamed("absorbed", "title");
+      new (source[1]) TNamed("kept", "title");
+      other.AbsorbObjects(&source, 0, 0);
+      EXPECT_STREQ("kept", static_cast<TNamed *>(source.At(0))->GetName());
+   }
+   ASSERT_EQ(1, other.GetEntriesFast());
+   EXPECT_STREQ("absorbed", static_cast<TNamed *>(other.At(0))->GetName());
+   EXPECT_FALSE(other.IsUsingArena());
+   other.Delete();
+}
@@ -0,0 +1,45 @@
+#include "THashList.h"
+#include "THashTable.h"
+#include "TNamed.h"
+
+#include "gtest/gtest.h"
+
+TEST(THashList, NameIndex)
+{
+   THashList list(100, 50);
+   list.SetOwner(kTRUE);
+   for (int i = 0; i < 10000; ++i)
+      list.Add(new TNamed(TString::Format("obj%d", i).Data(), "first"));
+   list.UseNameIndex();
+   for (int i = 10000; i < 20000; ++i)
+      list.Add(new TNamed(TString::Format("obj%d", i).Data(), "first"));
+
+   EXPECT_EQ(nullptr, list.FindObject("missing"));
+   for (int i = 0; i < 20000; i += 999) {
+      auto found = list.FindObject(TString::Format("obj%d", i).Data());
+      ASSERT_NE(nullptr, found);
+      EXPECT_STREQ(TString::Format("obj%d", i).Data(), found->GetName());
+   }
+
+   // Objects with the same name are found in the order of the list of their slot.
+   auto first = list.FindObject("obj5");
+   auto second = new TNamed("obj5", "second");
+   list.Add(second);
+   EXPECT_EQ(first, list.FindObject("obj5"));
+   delete list.Remove(second);
+   second = new TNamed("obj5", "second");
+   list.AddBefore(first, second);
+   EXPECT_EQ(second, list.FindObject("obj5"));
+   delete list.Remove(second);
+   EXPECT_STREQ("first", list.FindObject("obj5")->GetTitle());
+
+   auto removed = list.FindObject("obj7");
+   list.Remove(removed);
+   EXPECT_EQ(nullptr, list.FindObject("obj7"));
+   delete removed;
+
+   list.Rehash(40000);
+   EXPECT_NE(nullptr, list.FindObject("obj19999"));
+   list.Delete();
+   EXPECT_EQ(nullptr, list.FindObject("obj1"));
+}
@@ -0,0 +1,112 @@
+/// \file ROOT/RTrace.hxx
+/// \ingroup Base
+/// \date 2021-06-14
+/// \warning This is part of the ROOT 7 prototype! It will change without notice. It might trigger earthquakes. Feedback
+/// is welcome!
+
+/*************************************************************************
+ * Copyright (C) 1995-2021, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#ifndef ROOT7_RTrace
+#define ROOT7_RTrace
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <string>
+
+namespace ROOT {
+namespace Experimental {
+
+/**
+\class ROOT::Experimental::RTrace
+\ingroup Base
+\brief Records the time spans of the concurrent work of ROOT, exported in the Chrome trace event format.
+
+Tracing is compiled in and off by default; when off, a span costs the load of an atomic flag. When on, every
+thread records its spans into its own ring buffer, which keeps the last `bufferSize` spans of the thread: tracing
+a long job keeps a bounded amount of memory and shows what happened before the moment of interest, e.g. a stall.
+
+~~~{.cpp}
+ROOT::Experimental::RTrace::Enable();
+// ... run the job ...
+ROOT::Experimental::RTrace::WriteChromeTrace("trace.json");
+~~~
+
+The file is opened with chrome://tracing or https://ui.perfetto.dev. Setting the environment variable
+`ROOT_TRACE=<file name>` enables tracing at startup and writes the trace to that file at exit.
+
+The category and name of a span are not copied: they must be string literals or otherwise outlive the trace.
+*/
+class RTrace {
+   static std::atomic<bool> fgIsEnabled;
+
+public:
+   static constexpr std::size_t kDefaultBufferSize = 1 << 16;
+
+   /// Starts recording the spans, in buffers of bufferSize spans per thread
+   static void Enable(std::size_t bufferSize = kDefaultBufferSize);
+   /// Stops recording the spans; the ones recorded are kept
+   static void Disable();
+   static bool IsEnabled() { return fgIsEnabled.load(std::memory_order_relaxed); }
+   /// Discards the spans recorded so far
+   static void Clear();
+
+   /// The time in nanoseconds since an arbitrary origin, from a monotonic clock
+   static std::uint64_t Now();
+   /// Adds a span to the buffer of the calling thread; `arg` is exported as the argument of the span unless negative
+   static void Record(const char *category, const char *name, std::uint64_t start, std::uint64_t end,
+                      std::int64_t arg = -1);
+
+   /// Writes the spans recorded so far as a Chrome trace event JSON document; threads can keep recording meanwhile
+   static void WriteChromeTrace(std::ostream &os);
+   static bool WriteChromeTrace(const std::string &fileName);
+};
+
+/**
+\class ROOT::Experimental::RTraceSpan
+\ingroup Base
+\brief Records the lifetime of the object as a span, if tracing is enabled at construction. See RTrace.
+*/
+class RTraceSpan {
+   const char *fCategory;
+   const char *fName;
+   std::int64_t fArg;
+   std::uint64_t fStart = 0;
+   bool fIsActive;
+
+public:
+   RTraceSpan(const char *category, const char *name, std::int64_t arg = -1)
+      : fCategory(category), fName(name), fArg(arg), fIsActive(RTrace::IsEnabled())
+   {
+      if (fIsActive)
+         fStart = RTrace::Now();
+   }
+   RTraceSpan(const RTraceSpan &) = delete;
+   RTraceSpan &operator=(const RTraceSpan &) = delete;
+   ~RTraceSpan()
+   {
+      if (fIsActive)
+         RTrace::Record(fCategory, fName, fStart, RTrace::Now(), fArg);
+   }
+
+   /// Sets the argument of the span if it is known only after the work started, e.g. a number of bytes read
+   void SetArg(std::int64_t arg) { fArg = arg; }
+};
+
+} // namespace Experimental
+} // namespace ROOT
+
+#define R__TRACE_CONCAT_IMPL(A, B) A##B
+#define R__TRACE_CONCAT(A, B) R__TRACE_CONCAT_IMPL(A, B)
+
+/// Traces the rest of the enclosing scope as a span of the given category and name, with an optional integer argument
+#define R__TRACE_SPAN(...) ::ROOT::Experimental::RTraceSpan R__TRACE_CONCAT(rTraceSpan, __LINE__)(__VA_ARGS__)
+
+#endif
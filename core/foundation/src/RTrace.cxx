@@ -0,0 +1,229 @@
+/// \file RTrace.cxx
+/// \ingroup Base
+/// \date 2021-06-14
+/// \warning This is part of the ROOT 7 prototype! It will change without notice. It might trigger earthquakes. Feedback
+/// is welcome!
+
+/*************************************************************************
+ * Copyright (C) 1995-2021, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#include "ROOT/RTrace.hxx"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace {
+
+struct RSpan {
+   const char *fCategory = nullptr;
+   const char *fName = nullptr;
+   std::uint64_t fStart = 0;
+   std::uint64_t fEnd = 0;
+   std::int64_t fArg = -1;
+};
+
+/// The spans of one thread. The mutex is only contended while a trace is written or cleared.
+struct RThreadBuffer {
+   std::mutex fLock;
+   std::vector<RSpan> fSpans;
+   std::size_t fNext = 0; ///< Where the next span goes, the oldest span once the buffer wrapped around
+   bool fWrapped = false;
+   unsigned int fThreadId;
+
+   RThreadBuffer(std::size_t size, unsigned int threadId) : fSpans(size), fThreadId(threadId) {}
+};
+
+/// Owns the buffers of all the threads, which stay readable after their thread exited
+struct RTraceRegistry {
+   std::mutex fLock;
+   std::vector<std::shared_ptr<RThreadBuffer>> fBuffers;
+   std::size_t fBufferSize = ROOT::Experimental::RTrace::kDefaultBufferSize;
+};
+
+RTraceRegistry &GetRegistry()
+{
+   static RTraceRegistry registry;
+   return registry;
+}
+
+RThreadBuffer &GetThreadBuffer()
+{
+   thread_local std::shared_ptr<RThreadBuffer> buffer;
+   if (!buffer) {
+      auto &registry = GetRegistry();
+      std::lock_guard<std::mutex> guard(registry.fLock);
+      buffer = std::make_shared<RThreadBuffer>(registry.fBufferSize, registry.fBuffers.size() + 1);
+      registry.fBuffers.push_back(buffer);
+   }
+   return *buffer;
+}
+
+void WriteJSONString(std::ostream &os, const char *str)
+{
+   os << '"';
+   for (; str && *str; ++str) {
+      const char c = *str;
+      if (c == '"' || c == '\\')
+         os << '\\' << c;
+      else if (static_cast<unsigned char>(c) < 0x20)
+         os << ' ';
+      else
+         os << c;
+   }
+   os << '"';
+}
+
+/// Enables the tracing if ROOT_TRACE is set, and writes the trace to the file it names at exit
+struct RTraceFromEnvironment {
+   std::string fFileName;
+
+   RTraceFromEnvironment()
+   {
+      if (const char *fileName = std::getenv("ROOT_TRACE")) {
+         fFileName = fileName;
+         if (!fFileName.empty())
+            ROOT::Experimental::RTrace::Enable();
+      }
+   }
+   ~RTraceFromEnvironment()
+   {
+      if (!fFileName.empty())
+         ROOT::Experimental::RTrace::WriteChromeTrace(fFileName);
+   }
+};
+
+RTraceFromEnvironment gTraceFromEnvironment;
+
+} // anonymous namespace
+
+std::atomic<bool> ROOT::Experimental::RTrace::fgIsEnabled{false};
+
+void ROOT::Experimental::RTrace::Enable(std::size_t bufferSize)
+{
+   auto &registry = GetRegistry();
+   {
+      std::lock_guard<std::mutex> guard(registry.fLock);
+      if (bufferSize == 0)
+         bufferSize = 1;
+      if (bufferSize != registry.fBufferSize) {
+         registry.fBufferSize = bufferSize;
+         for (auto &buffer : registry.fBuffers) {
+            std::lock_guard<std::mutex> bufferGuard(buffer->fLock);
+            buffer->fSpans.assign(bufferSize, RSpan());
+            buffer->fNext = 0;
+            buffer->fWrapped = false;
+         }
+      }
+   }
+   fgIsEnabled = true;
+}
+
+void ROOT::Experimental::RTrace::Disable()
+{
+   fgIsEnabled = false;
+}
+
+void ROOT::Experimental::RTrace::Clear()
+{
+   auto &registry = GetRegistry();
+   std::lock_guard<std::mutex> guard(registry.fLock);
+   for (auto &buffer : registry.fBuffers) {
+      std::lock_guard<std::mutex> bufferGuard(buffer->fLock);
+      buffer->fNext = 0;
+      buffer->fWrapped = false;
+   }
+}
+
+std::uint64_t ROOT::Experimental::RTrace::Now()
+{
+   return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+}
+
+void ROOT::Experimental::RTrace::Record(const char *category, const char *name, std::uint64_t start,
+                                        std::uint64_t end, std::int64_t arg)
+{
+   auto &buffer = GetThreadBuffer();
+   std::lock_guard<std::mutex> guard(buffer.fLock);
+   auto &span = buffer.fSpans[buffer.fNext];
+   span.fCategory = category;
+   span.fName = name;
+   span.fStart = start;
+   span.fEnd = end;
+   span.fArg = arg;
+   if (++buffer.fNext == buffer.fSpans.size()) {
+      buffer.fNext = 0;
+      buffer.fWrapped = true;
+   }
+}
+
+void ROOT::Experimental::RTrace::WriteChromeTrace(std::ostream &os)
+{
+   auto &registry = GetRegistry();
+   std::vector<std::shared_ptr<RThreadBuffer>> buffers;
+   {
+      std::lock_guard<std::mutex> guard(registry.fLock);
+      buffers = registry.fBuffers;
+   }
+
+   // The spans of each buffer are copied first not to block its thread while writing
+   std::vector<std::vector<RSpan>> spans(buffers.size());
+   std::uint64_t origin = UINT64_MAX;
+   for (std::size_t i = 0; i < buffers.size(); ++i) {
+      std::lock_guard<std::mutex> guard(buffers[i]->fLock);
+      const auto &ring = buffers[i]->fSpans;
+      const auto next = buffers[i]->fNext;
+      if (buffers[i]->fWrapped)
+         spans[i].insert(spans[i].end(), ring.begin() + next, ring.end());
+      spans[i].insert(spans[i].end(), ring.begin(), ring.begin() + next);
+      for (const auto &span : spans[i])
+         origin = std::min(origin, span.fStart);
+   }
+
+   const auto flags = os.flags();
+   const auto precision = os.precision();
+   os << std::fixed;
+   os.precision(3);
+   os << "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[\n";
+   bool first = true;
+   for (std::size_t i = 0; i < buffers.size(); ++i) {
+      const auto tid = buffers[i]->fThreadId;
+      os << (first ? "" : ",\n") << "{\"ph\":\"M\",\"name\":\"thread_name\",\"pid\":1,\"tid\":" << tid
+         << ",\"args\":{\"name\":\"thread " << tid << "\"}}";
+      first = false;
+      for (const auto &span : spans[i]) {
+         os << ",\n{\"ph\":\"X\",\"pid\":1,\"tid\":" << tid << ",\"cat\":";
+         WriteJSONString(os, span.fCategory);
+         os << ",\"name\":";
+         WriteJSONString(os, span.fName);
+         // Timestamps and durations are in microseconds
+         os << ",\"ts\":" << (span.fStart - origin) * 1e-3 << ",\"dur\":" << (span.fEnd - span.fStart) * 1e-3;
+         if (span.fArg >= 0)
+            os << ",\"args\":{\"value\":" << span.fArg << "}";
+         os << "}";
+      }
+   }
+   os << "\n]}\n";
+   os.flags(flags);
+   os.precision(precision);
+}
+
+bool ROOT::Experimental::RTrace::WriteChromeTrace(const std::string &fileName)
+{
+   std::ofstream file(fileName);
+   if (!file)
+      return false;
+   WriteChromeTrace(file);
+   return static_cast<bool>(file);
+}
@@ -0,0 +1,83 @@
+#include "ROOT/RTrace.hxx"
+
+#include "gtest/gtest.h"
+
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+using ROOT::Experimental::RTrace;
+
+namespace {
+
+std::size_t CountOccurrences(const std::string &str, const std::string &what)
+{
+   std::size_t n = 0;
+   for (auto pos = str.find(what); pos != std::string::npos; pos = str.find(what, pos + what.size()))
+      ++n;
+   return n;
+}
+
+std::string GetTrace()
+{
+   std::ostringstream os;
+   RTrace::WriteChromeTrace(os);
+   return os.str();
+}
+
+} // anonymous namespace
+
+TEST(RTrace, Disabled)
+{
+   RTrace::Disable();
+   RTrace::Clear();
+   {
+      R__TRACE_SPAN("test", "disabled span");
+   }
+   EXPECT_EQ(0u, CountOccurrences(GetTrace(), "disabled span"));
+}
+
+TEST(RTrace, Spans)
+{
+   RTrace::Enable();
+   RTrace::Clear();
+   {
+      R__TRACE_SPAN("test", "outer span", 42);
+      R__TRACE_SPAN("test", "inner \"span\"");
+   }
+   std::vector<std::thread> threads;
+   for (int i = 0; i < 4; ++i)
+      threads.emplace_back([] { R__TRACE_SPAN("test", "thread span"); });
+   for (auto &t : threads)
+      t.join();
+   RTrace::Disable();
+
+   const auto trace = GetTrace();
+   EXPECT_EQ(0u, trace.find("{\"displayTimeUnit\":\"ns\",\"traceEvents\":["));
+   EXPECT_EQ(1u, CountOccurrences(trace, "\"name\":\"outer span\""));
+   EXPECT_EQ(1u, CountOccurrences(trace, "\"args\":{\"value\":42}"));
+   EXPECT_EQ(1u, CountOccurrences(trace, "\"name\":\"inner \\\"span\\\"\""));
+   EXPECT_EQ(4u, CountOccurrences(trace, "\"name\":\"thread span\""));
+   EXPECT_EQ(6u, CountOccurrences(trace, "\"ph\":\"X\""));
+}
+
+TEST(RTrace, RingBuffer)
+{
+   RTrace::Enable(4);
+   RTrace::Clear();
+   const auto start = RTrace::Now();
+   for (int i = 0; i < 10; ++i)
+      RTrace::Record("test", "ring span", start, start + 1000, i);
+   RTrace::Disable();
+
+   // Only the last 4 spans are kept
+   const auto trace = GetTrace();
+   EXPECT_EQ(4u, CountOccurrences(trace, "\"name\":\"ring span\""));
+   EXPECT_EQ(0u, CountOccurrences(trace, "\"value\":5}"));
+   for (int i = 6; i < 10; ++i)
+      EXPECT_EQ(1u, CountOccurrences(trace, "\"value\":" + std::to_string(i) + "}"));
+   EXPECT_EQ(4u, CountOccurrences(trace, "\"dur\":1.000"));
+   RTrace::Enable(RTrace::kDefaultBufferSize);
+   RTrace::Disable();
+}
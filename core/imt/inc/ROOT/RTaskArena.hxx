@@ -25,6 +25,7 @@
 
 #include "RConfigure.h"
 #include <memory>
+#include <vector>
 
 // exclude in case ROOT does not have IMT support
 #ifndef R__USE_IMT
@@ -43,6 +44,8 @@ class ROpaqueTaskArena;
 
 namespace Internal {
 
+class RNUMAPinningObserver;
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Returns the available number of logical cores.
 ///
@@ -53,6 +56,13 @@ namespace Internal {
 ////////////////////////////////////////////////////////////////////////////////
 int LogicalCPUBandwithControl();
 
+////////////////////////////////////////////////////////////////////////////////
+/// Returns the logical cores of each NUMA node that this process can run on,
+/// as read from sysfs (linux only). Nodes without such cores are skipped, and
+/// non-NUMA systems have a single node.
+////////////////////////////////////////////////////////////////////////////////
+std::vector<std::vector<unsigned>> GetNUMANodesCPUs();
+
 
 ////////////////////////////////////////////////////////////////////////////////
 /// Wrapper for tbb::task_arena.
@@ -64,11 +74,15 @@ class RTaskArenaWrapper {
 public:
    ~RTaskArenaWrapper(); // necessary to set size back to zero
    static unsigned TaskArenaSize(); // A static getter lets us check for RTaskArenaWrapper's existence
+   static int GetCurrentThreadIndex();
    ROOT::ROpaqueTaskArena &Access();
+   bool IsPinnedToNUMANodes() const { return fNUMAObserver != nullptr; }
 private:
-   RTaskArenaWrapper(unsigned maxConcurrency = 0);
-   friend std::shared_ptr<ROOT::Internal::RTaskArenaWrapper> GetGlobalTaskArena(unsigned maxConcurrency);
+   RTaskArenaWrapper(unsigned maxConcurrency = 0, bool pinToNUMANodes = false);
+   friend std::shared_ptr<ROOT::Internal::RTaskArenaWrapper>
+   GetGlobalTaskArena(unsigned maxConcurrency, bool pinToNUMANodes);
    std::unique_ptr<ROOT::ROpaqueTaskArena> fTBBArena;
+   std::unique_ptr<RNUMAPinningObserver> fNUMAObserver; ///< Pins the threads of the arena, if requested
    static unsigned fNWorkers;
 };
 
@@ -79,8 +93,12 @@ private:
 ///
 /// Allows for reinstantiation of the global RTaskArenaWrapper once all the
 /// references to the previous one are gone and the object destroyed.
+///
+/// With pinToNUMANodes, the threads of a new arena are pinned to the NUMA nodes
+/// of the machine, see RTaskArenaWrapper.
 ////////////////////////////////////////////////////////////////////////////////
-std::shared_ptr<ROOT::Internal::RTaskArenaWrapper> GetGlobalTaskArena(unsigned maxConcurrency = 0);
+std::shared_ptr<ROOT::Internal::RTaskArenaWrapper>
+GetGlobalTaskArena(unsigned maxConcurrency = 0, bool pinToNUMANodes = false);
 
 } // namespace Internal
 } // namespace ROOT
@@ -16,8 +16,18 @@
 
 #include "ROOT/TTaskGroup.hxx"
 
-#include <type_traits>
+#include <atomic>
+#include <chrono>
+#include <functional>
 #include <future>
+#include <memory>
+#include <mutex>
+#include <type_traits>
+#include <vector>
+
+#if defined(__cpp_impl_coroutine) && __has_include(<coroutine>)
+#include <coroutine>
+#endif
 
 // exclude in case ROOT does not have IMT support
 #ifndef R__USE_IMT
@@ -36,25 +46,174 @@ class TFuture;
 }
 
 namespace Detail {
+
+////////////////////////////////////////////////////////////////////////////////
+/// Run a function in the task arena of ROOT without waiting for it, as the
+/// continuations of the TFutures do. It runs right away if IMT is disabled.
+void EnqueueInTaskArena(const std::function<void(void)> &f);
+
+////////////////////////////////////////////////////////////////////////////////
+/// The readiness of the value of a TFuture, which runs the functions waiting
+/// for it once the task producing it sets it.
+class TFutureState {
+   std::mutex fMutex;
+   bool fReady = false;
+   std::vector<std::function<void(void)>> fCallbacks;
+
+public:
+   /// Called by the task producing the value once it is set: the waiting functions run in that task.
+   void SetReady()
+   {
+      std::vector<std::function<void(void)>> callbacks;
+      {
+         std::lock_guard<std::mutex> lock(fMutex);
+         fReady = true;
+         std::swap(callbacks, fCallbacks);
+      }
+      for (auto &callback : callbacks)
+         callback();
+   }
+
+   /// Run f when the value is set, or right away if it already is.
+   void OnReady(std::function<void(void)> f)
+   {
+      {
+         std::lock_guard<std::mutex> lock(fMutex);
+         if (!fReady) {
+            fCallbacks.emplace_back(std::move(f));
+            return;
+         }
+      }
+      f();
+   }
+};
+
+/// The type returned by a continuation taking the value of a std::future<T>, or nothing if T is void.
+template <typename F, typename T>
+struct TContinuationResult {
+   using type = typename std::result_of<F(T)>::type;
+};
+
+template <typename F>
+struct TContinuationResult<F, void> {
+   using type = typename std::result_of<F()>::type;
+};
+
+template <typename F, typename T>
+typename TContinuationResult<F, T>::type InvokeWithFutureValue(F &f, std::future<T> &fut)
+{
+   return f(fut.get());
+}
+
+template <typename F>
+typename TContinuationResult<F, void>::type InvokeWithFutureValue(F &f, std::future<void> &fut)
+{
+   fut.get();
+   return f();
+}
+
+template <typename T>
+class TFutureImpl;
+
+/// Gives the continuations access to the internals of the TFutures.
+struct TFutureAccess {
+   using TTaskGroups_t = std::vector<std::unique_ptr<Experimental::TTaskGroup>>;
+
+   template <typename T>
+   static Experimental::TFuture<T>
+   MakeFuture(std::future<T> &&fut, TTaskGroups_t &&tgs, const std::shared_ptr<TFutureState> &state)
+   {
+      return Experimental::TFuture<T>(std::move(fut), std::move(tgs), state);
+   }
+
+   /// Move the parts of a TFuture out of it, e.g. to feed a continuation: the TFuture becomes invalid.
+   template <typename T>
+   static std::future<T> Release(TFutureImpl<T> &f, TTaskGroups_t &tgs, std::vector<std::shared_ptr<TFutureState>> &states)
+   {
+      for (auto &tg : f.fTgs)
+         tgs.emplace_back(std::move(tg));
+      f.fTgs.clear();
+      if (f.fState)
+         states.emplace_back(std::move(f.fState));
+      return std::move(f.fStdFut);
+   }
+
+   /// Run f when the value of the TFuture is set. For TFutures built from a std::future, a task of the arena waits
+   /// for it: the TFuture must then outlive the call of f.
+   template <typename T>
+   static void OnReady(TFutureImpl<T> &f, std::function<void(void)> callback)
+   {
+      if (f.fState) {
+         f.fState->OnReady(std::move(callback));
+      } else {
+         auto fut = &f.fStdFut;
+         EnqueueInTaskArena([fut, callback] {
+            fut->wait();
+            callback();
+         });
+      }
+   }
+};
+
+////////////////////////////////////////////////////////////////////////////////
+/// Build the TFuture of the value returned by f, which runs in the task arena
+/// once all the states are ready. The TFuture owns the task groups of the
+/// futures it continues.
+template <typename Ret_t, typename F>
+Experimental::TFuture<Ret_t> RunWhenReady(const std::vector<std::shared_ptr<TFutureState>> &states, F &&f,
+                                          TFutureAccess::TTaskGroups_t &&tgs)
+{
+   auto task = std::make_shared<std::packaged_task<Ret_t()>>(std::forward<F>(f));
+   auto state = std::make_shared<TFutureState>();
+   auto run = [task, state] {
+      EnqueueInTaskArena([task, state] {
+         (*task)();
+         state->SetReady();
+      });
+   };
+   if (states.empty()) {
+      run();
+   } else {
+      auto nWaiting = std::make_shared<std::atomic<std::size_t>>(states.size());
+      for (auto &s : states)
+         s->OnReady([nWaiting, run] {
+            if (--(*nWaiting) == 0)
+               run();
+         });
+   }
+   return TFutureAccess::MakeFuture<Ret_t>(task->get_future(), std::move(tgs), state);
+}
+
 template <typename T>
 class TFutureImpl {
    template <typename V>
    friend class Experimental::TFuture;
+   friend struct TFutureAccess;
 
 protected:
    using TTaskGroup = Experimental::TTaskGroup;
    std::future<T> fStdFut;
-   std::unique_ptr<TTaskGroup> fTg{nullptr};
+   /// The task groups of the tasks producing the value, or of the futures it continues
+   std::vector<std::unique_ptr<TTaskGroup>> fTgs;
+   /// Set for the futures of Async and of the continuations, null for the ones built from a std::future
+   std::shared_ptr<TFutureState> fState;
 
-   TFutureImpl(std::future<T> &&fut, std::unique_ptr<TTaskGroup> &&tg) : fStdFut(std::move(fut))
+   TFutureImpl(std::future<T> &&fut, std::unique_ptr<TTaskGroup> &&tg, const std::shared_ptr<TFutureState> &state)
+      : fStdFut(std::move(fut)), fState(state)
    {
-      fTg = std::move(tg);
+      fTgs.emplace_back(std::move(tg));
    };
+   TFutureImpl(std::future<T> &&fut, std::vector<std::unique_ptr<TTaskGroup>> &&tgs,
+               const std::shared_ptr<TFutureState> &state)
+      : fStdFut(std::move(fut)), fTgs(std::move(tgs)), fState(state){};
    TFutureImpl(){};
 
    TFutureImpl(std::future<T> &&fut) : fStdFut(std::move(fut)) {}
 
-   TFutureImpl(TFutureImpl<T> &&other) : fStdFut(std::move(other.fStdFut)), fTg(std::move(other.fTg)) {}
+   TFutureImpl(TFutureImpl<T> &&other)
+      : fStdFut(std::move(other.fStdFut)), fTgs(std::move(other.fTgs)), fState(std::move(other.fState))
+   {
+   }
 
    TFutureImpl &operator=(std::future<T> &&other) { fStdFut = std::move(other); }
 
@@ -67,13 +226,42 @@ public:
 
    void wait()
    {
-      if (fTg)
-         fTg->Wait();
+      for (auto &tg : fTgs)
+         tg->Wait();
+      if (fStdFut.valid())
+         fStdFut.wait();
    }
 
    bool valid() const { return fStdFut.valid(); };
+
+   /// Whether the value is set, i.e. get() does not block.
+   bool is_ready() const
+   {
+      return fStdFut.valid() && fStdFut.wait_for(std::chrono::seconds(0)) == std::future_status::ready;
+   }
+
+   ////////////////////////////////////////////////////////////////////////////////
+   /// Chain a continuation: f is called with the value of this future (with no
+   /// arguments if it is void) in a task of the arena once the value is set,
+   /// without blocking any thread meanwhile. Returns the future of the value
+   /// returned by f: an exception thrown while producing this value or by f is
+   /// rethrown by its get(). This future becomes invalid.
+   /// The continuations of the futures built from a std::future need a thread of
+   /// the arena to wait for the value. IMT must stay enabled until they run.
+   template <typename F>
+   Experimental::TFuture<typename TContinuationResult<typename std::decay<F>::type, T>::type> then(F &&f)
+   {
+      using Func_t = typename std::decay<F>::type;
+      using Ret_t = typename TContinuationResult<Func_t, T>::type;
+      TFutureAccess::TTaskGroups_t tgs;
+      std::vector<std::shared_ptr<TFutureState>> states;
+      auto parent = std::make_shared<std::future<T>>(TFutureAccess::Release(*this, tgs, states));
+      Func_t func(std::forward<F>(f));
+      return RunWhenReady<Ret_t>(states, [parent, func]() mutable -> Ret_t { return InvokeWithFutureValue(func, *parent); },
+                                 std::move(tgs));
+   }
 };
-}
+} // namespace Detail
 
 namespace Experimental {
 
@@ -85,10 +273,15 @@ class TFuture final : public ROOT::Detail::TFutureImpl<T> {
    friend TFuture<
       typename std::result_of<typename std::decay<Function>::type(typename std::decay<Args>::type...)>::type>
    Async(Function &&f, Args &&... args);
+   friend struct ROOT::Detail::TFutureAccess;
 
 private:
-   TFuture(std::future<T> &&fut, std::unique_ptr<TTaskGroup> &&tg)
-      : ROOT::Detail::TFutureImpl<T>(std::forward<std::future<T>>(fut), std::move(tg)){};
+   TFuture(std::future<T> &&fut, std::unique_ptr<TTaskGroup> &&tg,
+           const std::shared_ptr<ROOT::Detail::TFutureState> &state)
+      : ROOT::Detail::TFutureImpl<T>(std::forward<std::future<T>>(fut), std::move(tg), state){};
+   TFuture(std::future<T> &&fut, std::vector<std::unique_ptr<TTaskGroup>> &&tgs,
+           const std::shared_ptr<ROOT::Detail::TFutureState> &state)
+      : ROOT::Detail::TFutureImpl<T>(std::forward<std::future<T>>(fut), std::move(tgs), state){};
 
 public:
    TFuture(std::future<T> &&fut) : ROOT::Detail::TFutureImpl<T>(std::forward<std::future<T>>(fut)){};
@@ -107,10 +300,15 @@ class TFuture<void> final : public ROOT::Detail::TFutureImpl<void> {
    friend TFuture<
       typename std::result_of<typename std::decay<Function>::type(typename std::decay<Args>::type...)>::type>
    Async(Function &&f, Args &&... args);
+   friend struct ROOT::Detail::TFutureAccess;
 
 private:
-   TFuture(std::future<void> &&fut, std::unique_ptr<TTaskGroup> &&tg)
-      : ROOT::Detail::TFutureImpl<void>(std::forward<std::future<void>>(fut), std::move(tg)){};
+   TFuture(std::future<void> &&fut, std::unique_ptr<TTaskGroup> &&tg,
+           const std::shared_ptr<ROOT::Detail::TFutureState> &state)
+      : ROOT::Detail::TFutureImpl<void>(std::forward<std::future<void>>(fut), std::move(tg), state){};
+   TFuture(std::future<void> &&fut, std::vector<std::unique_ptr<TTaskGroup>> &&tgs,
+           const std::shared_ptr<ROOT::Detail::TFutureState> &state)
+      : ROOT::Detail::TFutureImpl<void>(std::forward<std::future<void>>(fut), std::move(tgs), state){};
 
 public:
    TFuture(std::future<void> &&fut) : ROOT::Detail::TFutureImpl<void>(std::forward<std::future<void>>(fut)){};
@@ -128,10 +326,15 @@ class TFuture<T &> final : public ROOT::Detail::TFutureImpl<T &> {
    friend TFuture<
       typename std::result_of<typename std::decay<Function>::type(typename std::decay<Args>::type...)>::type>
    Async(Function &&f, Args &&... args);
+   friend struct ROOT::Detail::TFutureAccess;
 
 private:
-   TFuture(std::future<T &> &&fut, std::unique_ptr<TTaskGroup> &&tg)
-      : ROOT::Detail::TFutureImpl<T &>(std::forward<std::future<T &>>(fut), std::move(tg)){};
+   TFuture(std::future<T &> &&fut, std::unique_ptr<TTaskGroup> &&tg,
+           const std::shared_ptr<ROOT::Detail::TFutureState> &state)
+      : ROOT::Detail::TFutureImpl<T &>(std::forward<std::future<T &>>(fut), std::move(tg), state){};
+   TFuture(std::future<T &> &&fut, std::vector<std::unique_ptr<TTaskGroup>> &&tgs,
+           const std::shared_ptr<ROOT::Detail::TFutureState> &state)
+      : ROOT::Detail::TFutureImpl<T &>(std::forward<std::future<T &>>(fut), std::move(tgs), state){};
 
 public:
    TFuture(std::future<T &> &&fut) : ROOT::Detail::TFutureImpl<T &>(std::forward<std::future<T &>>(fut)){};
@@ -158,13 +361,91 @@ Async(Function &&f, Args &&... args)
    using Ret_t = typename std::result_of<typename std::decay<Function>::type(typename std::decay<Args>::type...)>::type;
 
    auto thisPt = std::make_shared<std::packaged_task<Ret_t()>>(std::bind(f, args...));
+   auto state = std::make_shared<ROOT::Detail::TFutureState>();
    std::unique_ptr<ROOT::Experimental::TTaskGroup> tg(new ROOT::Experimental::TTaskGroup());
-   tg->Run([thisPt]() { (*thisPt)(); });
+   tg->Run([thisPt, state]() {
+      (*thisPt)();
+      state->SetReady();
+   });
 
-   return ROOT::Experimental::TFuture<Ret_t>(thisPt->get_future(), std::move(tg));
+   return ROOT::Experimental::TFuture<Ret_t>(thisPt->get_future(), std::move(tg), state);
 }
+
+////////////////////////////////////////////////////////////////////////////////
+/// Returns a TFuture of the values of all the futures, in the same order, which
+/// is set once they all are without blocking a thread meanwhile. The futures
+/// become invalid. An exception thrown while producing one of the values is
+/// rethrown by its get().
+template <typename T>
+TFuture<std::vector<T>> WhenAll(std::vector<TFuture<T>> &&futures)
+{
+   ROOT::Detail::TFutureAccess::TTaskGroups_t tgs;
+   std::vector<std::shared_ptr<ROOT::Detail::TFutureState>> states;
+   auto inputs = std::make_shared<std::vector<std::future<T>>>();
+   for (auto &f : futures)
+      inputs->emplace_back(ROOT::Detail::TFutureAccess::Release(f, tgs, states));
+   return ROOT::Detail::RunWhenReady<std::vector<T>>(states,
+                                                     [inputs] {
+                                                        std::vector<T> values;
+                                                        values.reserve(inputs->size());
+                                                        for (auto &f : *inputs)
+                                                           values.emplace_back(f.get());
+                                                        return values;
+                                                     },
+                                                     std::move(tgs));
 }
+
+/// \cond
+inline TFuture<void> WhenAll(std::vector<TFuture<void>> &&futures)
+{
+   ROOT::Detail::TFutureAccess::TTaskGroups_t tgs;
+   std::vector<std::shared_ptr<ROOT::Detail::TFutureState>> states;
+   auto inputs = std::make_shared<std::vector<std::future<void>>>();
+   for (auto &f : futures)
+      inputs->emplace_back(ROOT::Detail::TFutureAccess::Release(f, tgs, states));
+   return ROOT::Detail::RunWhenReady<void>(states,
+                                           [inputs] {
+                                              for (auto &f : *inputs)
+                                                 f.get();
+                                           },
+                                           std::move(tgs));
 }
+/// \endcond
 
+#if defined(__cpp_impl_coroutine) && __has_include(<coroutine>)
+////////////////////////////////////////////////////////////////////////////////
+/// Makes a TFuture awaitable in a C++20 coroutine: `co_await future` suspends
+/// the coroutine until the value is set, then resumes it in a task of the arena
+/// and returns the value.
+template <typename T>
+class TFutureAwaiter {
+   TFuture<T> &fFuture; // in the coroutine frame while the coroutine is suspended
+
+public:
+   TFutureAwaiter(TFuture<T> &f) : fFuture(f) {}
+   bool await_ready() { return fFuture.is_ready(); }
+   void await_suspend(std::coroutine_handle<> h)
+   {
+      ROOT::Detail::TFutureAccess::OnReady(fFuture,
+                                           [h] { ROOT::Detail::EnqueueInTaskArena([h] { h.resume(); }); });
+   }
+   decltype(auto) await_resume() { return fFuture.get(); }
+};
+
+template <typename T>
+TFutureAwaiter<T> operator co_await(TFuture<T> &f)
+{
+   return TFutureAwaiter<T>(f);
+}
+
+template <typename T>
+TFutureAwaiter<T> operator co_await(TFuture<T> &&f)
+{
+   return TFutureAwaiter<T>(f);
+}
+#endif
+}
+}
+
+#endif
 #endif
-#endif
\ No newline at end of file
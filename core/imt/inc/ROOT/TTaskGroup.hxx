@@ -14,8 +14,13 @@
 
 #include <atomic>
 #include <functional>
+#include <memory>
 
 namespace ROOT {
+namespace Internal {
+class RTaskArenaWrapper;
+}
+
 namespace Experimental {
 
 class TTaskGroup {
@@ -25,10 +30,12 @@ class TTaskGroup {
    \brief A class to manage the asynchronous execution of work items.
 
    A TTaskGroup represents concurrent execution of a group of tasks. Tasks may be dynamically added to the group as it
-   is executing.
+   is executing. Tasks are executed in ROOT's global task arena, also if they are added from a thread that is not
+   a worker of the thread pool.
    */
 private:
    void *fTaskContainer{nullptr};
+   std::shared_ptr<ROOT::Internal::RTaskArenaWrapper> fTaskArenaW;
    std::atomic<bool> fCanRun{true};
    void ExecuteInIsolation(const std::function<void(void)> &operation);
 
@@ -29,6 +29,7 @@
 
 #include <functional> //std::function
 #include <initializer_list>
+#include <iterator> //std::next
 #include <memory>
 #include <numeric> //std::accumulate
 #include <type_traits> //std::enable_if, std::result_of
@@ -37,6 +38,94 @@
 
 namespace ROOT {
 
+   namespace Internal {
+      /// The partial result of a map-reduce over a range of indices, accumulated by the tasks of
+      /// TThreadExecutor::ParallelReduceRange. Bodies are split only when a task is stolen, and joined pairwise.
+      class TReduceBody {
+      public:
+         virtual ~TReduceBody() = default;
+         /// Return an empty body, accumulating the ranges of another task
+         virtual std::unique_ptr<TReduceBody> Split() const = 0;
+         /// Accumulate the indices [begin, end), which follow the ones accumulated so far
+         virtual void Accumulate(unsigned begin, unsigned end) = 0;
+         /// Accumulate the partial result of other, whose indices follow the ones of this body
+         virtual void Join(TReduceBody &other) = 0;
+      };
+
+      /// Reduce the results of a chunk with a function taking a vector of objects...
+      template<class T, class R>
+      auto ReduceChunk(const std::vector<T> &objs, R &redfunc) -> decltype(redfunc(objs))
+      {
+         return redfunc(objs);
+      }
+
+      /// ...or with a binary function
+      template<class T, class BINARYOP>
+      auto ReduceChunk(const std::vector<T> &objs, BINARYOP &redfunc) -> decltype(redfunc(objs.front(), objs.front()))
+      {
+         if (objs.empty())
+            return T{};
+         return std::accumulate(std::next(objs.begin()), objs.end(), objs.front(), redfunc);
+      }
+
+      /// F maps an index to a value, R reduces the values
+      template<class F, class R>
+      class TMapReduceBody final : public TReduceBody {
+         using Result_t = decltype(std::declval<F &>()(0u));
+         F &fMapFunc;
+         R &fRedFunc;
+         std::vector<Result_t> fPartialResult; // empty, or the reduction of the indices accumulated so far
+
+         void SetPartialResult(std::vector<Result_t> &objs)
+         {
+            auto result = ReduceChunk(objs, fRedFunc);
+            fPartialResult.clear();
+            fPartialResult.emplace_back(std::move(result));
+         }
+
+      public:
+         TMapReduceBody(F &mapFunc, R &redFunc) : fMapFunc(mapFunc), fRedFunc(redFunc) {}
+
+         std::unique_ptr<TReduceBody> Split() const final
+         {
+            return std::unique_ptr<TReduceBody>(new TMapReduceBody(fMapFunc, fRedFunc));
+         }
+
+         void Accumulate(unsigned begin, unsigned end) final
+         {
+            // only the results of this range are gathered, together with the partial result
+            std::vector<Result_t> objs;
+            objs.reserve(fPartialResult.size() + end - begin);
+            for (auto &obj : fPartialResult)
+               objs.emplace_back(std::move(obj));
+            for (auto i = begin; i < end; ++i)
+               objs.emplace_back(fMapFunc(i));
+            SetPartialResult(objs);
+         }
+
+         void Join(TReduceBody &other) final
+         {
+            auto &rhs = static_cast<TMapReduceBody &>(other);
+            if (rhs.fPartialResult.empty())
+               return;
+            if (fPartialResult.empty()) {
+               std::swap(fPartialResult, rhs.fPartialResult);
+               return;
+            }
+            fPartialResult.emplace_back(std::move(rhs.fPartialResult.front()));
+            SetPartialResult(fPartialResult);
+         }
+
+         Result_t GetResult()
+         {
+            // reducing nothing gives the same result as the reduction of an empty vector of results
+            if (fPartialResult.empty())
+               return ReduceChunk(fPartialResult, fRedFunc);
+            return std::move(fPartialResult.front());
+         }
+      };
+   } // namespace Internal
+
    class TThreadExecutor: public TExecutorCRTP<TThreadExecutor> {
       friend TExecutorCRTP;
    public:
@@ -107,21 +196,16 @@ namespace ROOT {
       template<class F, class T, class Cond = noReferenceCond<F, T>>
       auto MapImpl(F func, const std::vector<T> &args) -> std::vector<typename std::result_of<F(T)>::type>;
 
-      // Extension of the Map interfaces with chunking, specific to this class and
-      // only available from a MapReduce call.
-      template<class F, class R, class Cond = noReferenceCond<F>>
-      auto Map(F func, unsigned nTimes, R redfunc, unsigned nChunks) -> std::vector<typename std::result_of<F()>::type>;
-      template<class F, class INTEGER, class R, class Cond = noReferenceCond<F, INTEGER>>
-      auto Map(F func, ROOT::TSeq<INTEGER> args, R redfunc, unsigned nChunks) -> std::vector<typename std::result_of<F(INTEGER)>::type>;
-      template<class F, class T, class R, class Cond = noReferenceCond<F, T>>
-      auto Map(F func, std::initializer_list<T> args, R redfunc, unsigned nChunks) -> std::vector<typename std::result_of<F(T)>::type>;
-      template<class F, class T, class R, class Cond = noReferenceCond<F, T>>
-      auto Map(F func, std::vector<T> &args, R redfunc, unsigned nChunks) -> std::vector<typename std::result_of<F(T)>::type>;
-      template<class F, class T, class R, class Cond = noReferenceCond<F, T>>
-      auto Map(F func, const std::vector<T> &args, R redfunc, unsigned nChunks) -> std::vector<typename std::result_of<F(T)>::type>;
+      // Map and reduce through a reduction tree over adaptively split ranges of indices, see MapReduceImpl
+      template<class F, class R>
+      auto MapReduceImpl(unsigned nItems, F mapFunc, R &redfunc, unsigned nChunks) -> decltype(mapFunc(0u));
+      static unsigned GetGrainSize(unsigned nItems, unsigned nChunks);
 
       // Functions that interface with the parallel library used as a backend
       void   ParallelFor(unsigned start, unsigned end, unsigned step, const std::function<void(unsigned int i)> &f);
+      void   ParallelForRange(unsigned nItems, unsigned grainSize,
+                              const std::function<void(unsigned int begin, unsigned int end)> &f);
+      void   ParallelReduceRange(unsigned nItems, unsigned grainSize, Internal::TReduceBody &body);
       double ParallelReduce(const std::vector<double> &objs, const std::function<double(double a, double b)> &redfunc);
       float  ParallelReduce(const std::vector<float> &objs, const std::function<float(float a, float b)> &redfunc);
       template<class T, class R>
@@ -141,19 +225,10 @@ namespace ROOT {
    /// \param nChunks Number of chunks to split the input data for processing.
    template<class F>
    void TThreadExecutor::Foreach(F func, unsigned nTimes, unsigned nChunks) {
-      if (nChunks == 0) {
-         ParallelFor(0U, nTimes, 1, [&](unsigned int){func();});
-         return;
-      }
-
-      unsigned step = (nTimes + nChunks - 1) / nChunks;
-      auto lambda = [&](unsigned int i)
-      {
-         for (unsigned j = 0; j < step && (i + j) < nTimes; j++) {
+      ParallelForRange(nTimes, GetGrainSize(nTimes, nChunks), [&](unsigned int begin, unsigned int end) {
+         for (auto i = begin; i < end; ++i)
             func();
-         }
-      };
-      ParallelFor(0U, nTimes, step, lambda);
+      });
    }
 
    //////////////////////////////////////////////////////////////////////////
@@ -164,22 +239,13 @@ namespace ROOT {
    /// \param nChunks Number of chunks to split the input data for processing.
    template<class F, class INTEGER>
    void TThreadExecutor::Foreach(F func, ROOT::TSeq<INTEGER> args, unsigned nChunks) {
-      if (nChunks == 0) {
-         ParallelFor(*args.begin(), *args.end(), args.step(), [&](unsigned int i){func(i);});
-         return;
-      }
-      unsigned start = *args.begin();
-      unsigned end = *args.end();
-      unsigned seqStep = args.step();
-      unsigned step = (end - start + nChunks - 1) / nChunks; //ceiling the division
-
-      auto lambda = [&](unsigned int i)
-      {
-         for (unsigned j = 0; j < step && (i + j) < end; j+=seqStep) {
-            func(i + j);
-         }
-      };
-      ParallelFor(start, end, step, lambda);
+      const unsigned start = *args.begin();
+      const unsigned seqStep = args.step();
+      const unsigned nItems = args.size();
+      ParallelForRange(nItems, GetGrainSize(nItems, nChunks), [&](unsigned int begin, unsigned int end) {
+         for (auto i = begin; i < end; ++i)
+            func(start + i * seqStep);
+      });
    }
 
    //////////////////////////////////////////////////////////////////////////
@@ -202,20 +268,11 @@ namespace ROOT {
    /// \param nChunks Number of chunks to split the input data for processing.
    template<class F, class T>
    void TThreadExecutor::Foreach(F func, std::vector<T> &args, unsigned nChunks) {
-      unsigned int nToProcess = args.size();
-      if (nChunks == 0) {
-         ParallelFor(0U, nToProcess, 1, [&](unsigned int i){func(args[i]);});
-         return;
-      }
-
-      unsigned step = (nToProcess + nChunks - 1) / nChunks; //ceiling the division
-      auto lambda = [&](unsigned int i)
-      {
-         for (unsigned j = 0; j < step && (i + j) < nToProcess; j++) {
-            func(args[i + j]);
-         }
-      };
-      ParallelFor(0U, nToProcess, step, lambda);
+      const unsigned nItems = args.size();
+      ParallelForRange(nItems, GetGrainSize(nItems, nChunks), [&](unsigned int begin, unsigned int end) {
+         for (auto i = begin; i < end; ++i)
+            func(args[i]);
+      });
    }
 
    //////////////////////////////////////////////////////////////////////////
@@ -226,20 +283,11 @@ namespace ROOT {
    /// \param nChunks Number of chunks to split the input data for processing.
    template<class F, class T>
    void TThreadExecutor::Foreach(F func, const std::vector<T> &args, unsigned nChunks) {
-      unsigned int nToProcess = args.size();
-      if (nChunks == 0) {
-         ParallelFor(0U, nToProcess, 1, [&](unsigned int i){func(args[i]);});
-         return;
-      }
-
-      unsigned step = (nToProcess + nChunks - 1) / nChunks; //ceiling the division
-      auto lambda = [&](unsigned int i)
-      {
-         for (unsigned j = 0; j < step && (i + j) < nToProcess; j++) {
-            func(args[i + j]);
-         }
-      };
-      ParallelFor(0U, nToProcess, step, lambda);
+      const unsigned nItems = args.size();
+      ParallelForRange(nItems, GetGrainSize(nItems, nChunks), [&](unsigned int begin, unsigned int end) {
+         for (auto i = begin; i < end; ++i)
+            func(args[i]);
+      });
    }
 
    //////////////////////////////////////////////////////////////////////////
@@ -282,36 +330,6 @@ namespace ROOT {
       return reslist;
    }
 
-   //////////////////////////////////////////////////////////////////////////
-   /// \brief Execute a function `nTimes` in parallel, dividing the execution in nChunks and
-   /// providing a result per chunk.
-   ///
-   /// \copydetails ROOT::Internal::TExecutor::Map(F func,unsigned nTimes,R redfunc,unsigned nChunks)
-   template<class F, class R, class Cond>
-   auto TThreadExecutor::Map(F func, unsigned nTimes, R redfunc, unsigned nChunks) -> std::vector<typename std::result_of<F()>::type> {
-      if (nChunks == 0)
-      {
-         return Map(func, nTimes);
-      }
-
-      unsigned step = (nTimes + nChunks - 1) / nChunks;
-      // Avoid empty chunks
-      unsigned actualChunks = (nTimes + step - 1) / step;
-      using retType = decltype(func());
-      std::vector<retType> reslist(actualChunks);
-      auto lambda = [&](unsigned int i)
-      {
-         std::vector<retType> partialResults(std::min(nTimes-i, step));
-         for (unsigned j = 0; j < step && (i + j) < nTimes; j++) {
-            partialResults[j] = func();
-         }
-         reslist[i / step] = Reduce(partialResults, redfunc);
-      };
-      ParallelFor(0U, nTimes, step, lambda);
-
-      return reslist;
-   }
-
    //////////////////////////////////////////////////////////////////////////
    /// \brief Execute a function over the elements of a vector in parallel.
    /// Implementation of the Map method.
@@ -358,124 +376,12 @@ namespace ROOT {
       return reslist;
    }
 
-   //////////////////////////////////////////////////////////////////////////
-   /// \brief Execute a function in parallel over the elements of a sequence, dividing the execution in nChunks and
-   /// providing a result per chunk.
-   ///
-   /// \copydetails ROOT::Internal::TExecutor::Map(F func,ROOT::TSeq<INTEGER> args,R redfunc,unsigned nChunks)
-   template<class F, class INTEGER, class R, class Cond>
-   auto TThreadExecutor::Map(F func, ROOT::TSeq<INTEGER> args, R redfunc, unsigned nChunks) -> std::vector<typename std::result_of<F(INTEGER)>::type> {
-      if (nChunks == 0)
-      {
-         return Map(func, args);
-      }
-
-      unsigned start = *args.begin();
-      unsigned end = *args.end();
-      unsigned seqStep = args.step();
-      unsigned step = (end - start + nChunks - 1) / nChunks; //ceiling the division
-      // Avoid empty chunks
-      unsigned actualChunks = (end - start + step - 1) / step;
-
-      using retType = decltype(func(start));
-      std::vector<retType> reslist(actualChunks);
-      auto lambda = [&](unsigned int i)
-      {
-         std::vector<retType> partialResults(std::min(end-i, step));
-         for (unsigned j = 0; j < step && (i + j) < end; j+=seqStep) {
-            partialResults[j] = func(i + j);
-         }
-         reslist[i / step] = Reduce(partialResults, redfunc);
-      };
-      ParallelFor(start, end, step, lambda);
-
-      return reslist;
-   }
-
-   //////////////////////////////////////////////////////////////////////////
-   /// \brief Execute a function in parallel over the elements of a vector, dividing the execution in nChunks and
-   /// providing a result per chunk.
-   ///
-   /// \copydetails ROOT::Internal::TExecutor::Map(F func,std::vector<T> &args,R redfunc,unsigned nChunks)
-   template<class F, class T, class R, class Cond>
-   auto TThreadExecutor::Map(F func, std::vector<T> &args, R redfunc, unsigned nChunks) -> std::vector<typename std::result_of<F(T)>::type> {
-      if (nChunks == 0)
-      {
-         return Map(func, args);
-      }
-
-      unsigned int nToProcess = args.size();
-      unsigned step = (nToProcess + nChunks - 1) / nChunks; //ceiling the division
-      // Avoid empty chunks
-      unsigned actualChunks = (nToProcess + step - 1) / step;
-
-      using retType = decltype(func(args.front()));
-      std::vector<retType> reslist(actualChunks);
-      auto lambda = [&](unsigned int i)
-      {
-         std::vector<T> partialResults(step);
-         for (unsigned j = 0; j < step && (i + j) < nToProcess; j++) {
-            partialResults[j] = func(args[i + j]);
-         }
-         reslist[i / step] = Reduce(partialResults, redfunc);
-      };
-
-      ParallelFor(0U, nToProcess, step, lambda);
-
-      return reslist;
-   }
-
-   //////////////////////////////////////////////////////////////////////////
-   /// \brief Execute a function in parallel over the elements of an immutable vector, dividing the execution in nChunks and
-   /// providing a result per chunk.
-   ///
-   /// \copydetails ROOT::Internal::TExecutor::Map(F func,const std::vector<T> &args,R redfunc,unsigned nChunks)
-   template<class F, class T, class R, class Cond>
-   auto TThreadExecutor::Map(F func, const std::vector<T> &args, R redfunc, unsigned nChunks) -> std::vector<typename std::result_of<F(T)>::type> {
-      if (nChunks == 0)
-      {
-         return Map(func, args);
-      }
-
-      unsigned int nToProcess = args.size();
-      unsigned step = (nToProcess + nChunks - 1) / nChunks; //ceiling the division
-      // Avoid empty chunks
-      unsigned actualChunks = (nToProcess + step - 1) / step;
-
-      using retType = decltype(func(args.front()));
-      std::vector<retType> reslist(actualChunks);
-      auto lambda = [&](unsigned int i)
-      {
-         std::vector<T> partialResults(step);
-         for (unsigned j = 0; j < step && (i + j) < nToProcess; j++) {
-            partialResults[j] = func(args[i + j]);
-         }
-         reslist[i / step] = Reduce(partialResults, redfunc);
-      };
-
-      ParallelFor(0U, nToProcess, step, lambda);
-
-      return reslist;
-   }
-
-   //////////////////////////////////////////////////////////////////////////
-   /// \brief Execute a function in parallel over the elements of an initializer_list, dividing the execution in nChunks and
-   /// providing a result per chunk.
-   ///
-   /// \copydetails ROOT::Internal::TExecutor::Map(F func,std::initializer_list<T> args,R redfunc,unsigned nChunks)
-   template<class F, class T, class R, class Cond>
-   auto TThreadExecutor::Map(F func, std::initializer_list<T> args, R redfunc, unsigned nChunks) -> std::vector<typename std::result_of<F(T)>::type> {
-      std::vector<T> vargs(std::move(args));
-      const auto &reslist = Map(func, vargs, redfunc, nChunks);
-      return reslist;
-   }
-
    //////////////////////////////////////////////////////////////////////////
    /// \brief Execute a function `nTimes` in parallel (Map) and accumulate the results into a single value (Reduce).
    /// \copydetails  ROOT::Internal::TExecutor::MapReduce(F func,unsigned nTimes,R redfunc)
    template<class F, class R, class Cond>
    auto TThreadExecutor::MapReduce(F func, unsigned nTimes, R redfunc) -> typename std::result_of<F()>::type {
-      return Reduce(Map(func, nTimes), redfunc);
+      return MapReduceImpl(nTimes, [&func](unsigned int) { return func(); }, redfunc, 0);
    }
 
    //////////////////////////////////////////////////////////////////////////
@@ -485,7 +391,7 @@ namespace ROOT {
    /// \copydetails ROOT::Internal::TExecutor::MapReduce(F func,unsigned nTimes,R redfunc,unsigned nChunks)
    template<class F, class R, class Cond>
    auto TThreadExecutor::MapReduce(F func, unsigned nTimes, R redfunc, unsigned nChunks) -> typename std::result_of<F()>::type {
-      return Reduce(Map(func, nTimes, redfunc, nChunks), redfunc);
+      return MapReduceImpl(nTimes, [&func](unsigned int) { return func(); }, redfunc, nChunks);
    }
 
    //////////////////////////////////////////////////////////////////////////
@@ -495,7 +401,9 @@ namespace ROOT {
    /// \copydetails ROOT::Internal::TExecutor::MapReduce(F func,ROOT::TSeq<INTEGER> args,R redfunc,unsigned nChunks)
    template<class F, class INTEGER, class R, class Cond>
    auto TThreadExecutor::MapReduce(F func, ROOT::TSeq<INTEGER> args, R redfunc, unsigned nChunks) -> typename std::result_of<F(INTEGER)>::type {
-      return Reduce(Map(func, args, redfunc, nChunks), redfunc);
+      const unsigned start = *args.begin();
+      const unsigned seqStep = args.step();
+      return MapReduceImpl(args.size(), [&](unsigned int i) { return func(start + i * seqStep); }, redfunc, nChunks);
    }
 
    //////////////////////////////////////////////////////////////////////////
@@ -505,7 +413,8 @@ namespace ROOT {
    /// \copydetails ROOT::Internal::TExecutor::MapReduce(F func,std::initializer_list<T> args,R redfunc,unsigned nChunks)
    template<class F, class T, class R, class Cond>
    auto TThreadExecutor::MapReduce(F func, std::initializer_list<T> args, R redfunc, unsigned nChunks) -> typename std::result_of<F(T)>::type {
-      return Reduce(Map(func, args, redfunc, nChunks), redfunc);
+      std::vector<T> vargs(std::move(args));
+      return MapReduce(func, vargs, redfunc, nChunks);
    }
 
    //////////////////////////////////////////////////////////////////////////
@@ -513,7 +422,7 @@ namespace ROOT {
    /// \copydetails  ROOT::Internal::TExecutor::MapReduce(F func,std::vector<T> &args,R redfunc)
    template<class F, class T, class R, class Cond>
    auto TThreadExecutor::MapReduce(F func, std::vector<T> &args, R redfunc) -> typename std::result_of<F(T)>::type {
-      return Reduce(Map(func, args), redfunc);
+      return MapReduceImpl(args.size(), [&](unsigned int i) { return func(args[i]); }, redfunc, 0);
    }
 
    //////////////////////////////////////////////////////////////////////////
@@ -521,7 +430,7 @@ namespace ROOT {
    /// \copydetails  ROOT::Internal::TExecutor::MapReduce(F func,const std::vector<T> &args,R redfunc)
    template<class F, class T, class R, class Cond>
    auto TThreadExecutor::MapReduce(F func, const std::vector<T> &args, R redfunc) -> typename std::result_of<F(T)>::type {
-      return Reduce(Map(func, args), redfunc);
+      return MapReduceImpl(args.size(), [&](unsigned int i) { return func(args[i]); }, redfunc, 0);
    }
 
    //////////////////////////////////////////////////////////////////////////
@@ -531,7 +440,7 @@ namespace ROOT {
    /// \copydetails ROOT::Internal::TExecutor::MapReduce(F func,std::vector<T> &args,R redfunc,unsigned nChunks)
    template<class F, class T, class R, class Cond>
    auto TThreadExecutor::MapReduce(F func, std::vector<T> &args, R redfunc, unsigned nChunks) -> typename std::result_of<F(T)>::type {
-      return Reduce(Map(func, args, redfunc, nChunks), redfunc);
+      return MapReduceImpl(args.size(), [&](unsigned int i) { return func(args[i]); }, redfunc, nChunks);
    }
 
    //////////////////////////////////////////////////////////////////////////
@@ -541,7 +450,32 @@ namespace ROOT {
    /// \copydetails ROOT::Internal::TExecutor::MapReduce(F func,const std::vector<T> &args,R redfunc,unsigned nChunks)
    template<class F, class T, class R, class Cond>
    auto TThreadExecutor::MapReduce(F func, const std::vector<T> &args, R redfunc, unsigned nChunks) -> typename std::result_of<F(T)>::type {
-      return Reduce(Map(func, args, redfunc, nChunks), redfunc);
+      return MapReduceImpl(args.size(), [&](unsigned int i) { return func(args[i]); }, redfunc, nChunks);
+   }
+
+   //////////////////////////////////////////////////////////////////////////
+   /// \brief Map the indices [0, nItems) with `mapFunc` and reduce the results with `redfunc`, in parallel.
+   ///
+   /// The range of indices is split lazily, only when idle threads steal work, so tasks with irregular costs keep
+   /// all threads busy while cheap ones run in a few large chunks. If nChunks is not 0, chunks are never split below
+   /// half of nItems / nChunks indices. Every task reduces the results of its chunks as they are produced and the
+   /// partial results are reduced pairwise, in order: the results of all indices are never gathered at once.
+   ///
+   /// \param nItems Number of indices to map.
+   /// \param mapFunc Function mapping an index to a value.
+   /// \param redfunc Reduction function, taking a vector of values or two values.
+   /// \param nChunks Number of chunks the indices can be split into, 0 to let the scheduler decide.
+   template<class F, class R>
+   auto TThreadExecutor::MapReduceImpl(unsigned nItems, F mapFunc, R &redfunc, unsigned nChunks) -> decltype(mapFunc(0u))
+   {
+      using retType = decltype(mapFunc(0u));
+      // check we can apply reduce to the results
+      static_assert(std::is_same<decltype(Internal::ReduceChunk(std::declval<const std::vector<retType> &>(), redfunc)),
+                                 retType>::value,
+                    "redfunc does not have the correct signature");
+      Internal::TMapReduceBody<F, R> body(mapFunc, redfunc);
+      ParallelReduceRange(nItems, GetGrainSize(nItems, nChunks), body);
+      return body.GetResult();
    }
 
    //////////////////////////////////////////////////////////////////////////
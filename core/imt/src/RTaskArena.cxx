@@ -8,10 +8,20 @@
 #include "TThread.h"
 #include <fstream>
 #include <mutex>
+#include <sstream>
+#include <string>
 #include <thread>
+#include <vector>
 #include "tbb/task_arena.h"
 #define TBB_PREVIEW_GLOBAL_CONTROL 1 // required for TBB versions preceding 2019_U4
 #include "tbb/global_control.h"
+#define TBB_PREVIEW_LOCAL_OBSERVER 1 // required for the observers of a task arena with TBB versions preceding 2020
+#include "tbb/task_scheduler_observer.h"
+
+#ifdef R__LINUX
+#include <pthread.h>
+#include <sched.h>
+#endif
 
 //////////////////////////////////////////////////////////////////////////
 ///
@@ -38,6 +48,19 @@
 /// root[] gTA->Access().max_concurrency() // call to tbb::task_arena::max_concurrency()
 /// ~~~
 ///
+/// #### NUMA systems
+/// On machines with several NUMA nodes (typically, sockets), the threads of the
+/// arena can be pinned to the nodes (see ROOT::EnableNUMAAwareImplicitMT()).
+/// The arena slots are split in contiguous blocks, one per node and
+/// proportional to its number of cores, and a worker thread is pinned to the
+/// cores of the node of its slot while it runs in the arena: the threads of the
+/// first slots run on the first node, and so on. A single arena is kept, so
+/// that idle threads can still steal work across nodes.
+/// Data that a thread allocates and touches first, e.g. the per-slot state
+/// that RDataFrame creates within its tasks, is then placed on the memory of
+/// its node by the kernel, and RDataFrame gives a thread the processing slot
+/// matching its arena slot, keeping the slots on the same node across event loops.
+///
 //////////////////////////////////////////////////////////////////////////
 
 namespace ROOT {
@@ -65,6 +88,129 @@ int LogicalCPUBandwithControl()
    return std::thread::hardware_concurrency();
 }
 
+#ifdef R__LINUX
+namespace {
+/// Parse a sysfs CPU list such as "0-3,8-11"
+std::vector<unsigned> ParseCPUList(const std::string &cpuList)
+{
+   std::vector<unsigned> cpus;
+   std::stringstream ss(cpuList);
+   std::string range;
+   while (std::getline(ss, range, ',')) {
+      if (range.empty() || range == "\n")
+         continue;
+      const auto dash = range.find('-');
+      const unsigned first = std::stoul(range.substr(0, dash));
+      const unsigned last = dash == std::string::npos ? first : std::stoul(range.substr(dash + 1));
+      for (auto cpu = first; cpu <= last; ++cpu)
+         cpus.push_back(cpu);
+   }
+   return cpus;
+}
+} // anonymous namespace
+#endif
+
+std::vector<std::vector<unsigned>> GetNUMANodesCPUs()
+{
+   std::vector<std::vector<unsigned>> nodes;
+#ifdef R__LINUX
+   cpu_set_t allowed;
+   CPU_ZERO(&allowed);
+   if (sched_getaffinity(0, sizeof(allowed), &allowed) == 0) {
+      // node ids can have gaps, e.g. with memory-only nodes: stop after a run of missing ones
+      for (unsigned node = 0, nMissing = 0; nMissing < 64; ++node) {
+         std::ifstream f("/sys/devices/system/node/node" + std::to_string(node) + "/cpulist");
+         if (!f) {
+            ++nMissing;
+            continue;
+         }
+         nMissing = 0;
+         std::string cpuList;
+         std::getline(f, cpuList);
+         std::vector<unsigned> cpus;
+         for (auto cpu : ParseCPUList(cpuList)) {
+            if (cpu < CPU_SETSIZE && CPU_ISSET(cpu, &allowed))
+               cpus.push_back(cpu);
+         }
+         if (!cpus.empty())
+            nodes.emplace_back(std::move(cpus));
+      }
+   }
+#endif
+   if (nodes.empty()) {
+      nodes.emplace_back();
+      for (unsigned cpu = 0; cpu < std::thread::hardware_concurrency(); ++cpu)
+         nodes.back().push_back(cpu);
+   }
+   return nodes;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Pins the worker threads of a task arena to the NUMA node of their arena slot
+/// while they run in the arena, see RTaskArenaWrapper.
+////////////////////////////////////////////////////////////////////////////////
+class RNUMAPinningObserver final : public tbb::task_scheduler_observer {
+#ifdef R__LINUX
+   std::vector<cpu_set_t> fSlotCPUs; ///< The cores of the node of each arena slot
+   cpu_set_t fProcessCPUs;           ///< Restored when a worker thread leaves the arena
+#endif
+
+public:
+   RNUMAPinningObserver(tbb::task_arena &arena, unsigned nSlots, const std::vector<std::vector<unsigned>> &nodes)
+      : tbb::task_scheduler_observer(arena)
+   {
+#ifdef R__LINUX
+      CPU_ZERO(&fProcessCPUs);
+      sched_getaffinity(0, sizeof(fProcessCPUs), &fProcessCPUs);
+      std::size_t nCPUs = 0;
+      for (auto &node : nodes)
+         nCPUs += node.size();
+      for (unsigned slot = 0; slot < nSlots; ++slot) {
+         // the position of the slot in the list of the cores of all nodes gives its node
+         auto cpu = slot * nCPUs / nSlots;
+         std::size_t node = 0;
+         while (cpu >= nodes[node].size()) {
+            cpu -= nodes[node].size();
+            ++node;
+         }
+         cpu_set_t cpus;
+         CPU_ZERO(&cpus);
+         for (auto c : nodes[node])
+            CPU_SET(c, &cpus);
+         fSlotCPUs.push_back(cpus);
+      }
+#else
+      (void)nSlots;
+      (void)nodes;
+#endif
+      observe(true);
+   }
+
+   ~RNUMAPinningObserver() { observe(false); }
+
+   // The threads that called into the arena, e.g. the main thread, are left alone
+   void on_scheduler_entry(bool isWorker) final
+   {
+#ifdef R__LINUX
+      const int slot = tbb::this_task_arena::current_thread_index();
+      if (isWorker && slot >= 0 && static_cast<std::size_t>(slot) < fSlotCPUs.size())
+         pthread_setaffinity_np(pthread_self(), sizeof(cpu_set_t), &fSlotCPUs[slot]);
+#else
+      (void)isWorker;
+#endif
+   }
+
+   void on_scheduler_exit(bool isWorker) final
+   {
+#ifdef R__LINUX
+      if (isWorker)
+         pthread_setaffinity_np(pthread_self(), sizeof(cpu_set_t), &fProcessCPUs);
+#else
+      (void)isWorker;
+#endif
+   }
+};
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Initializes the tbb::task_arena within RTaskArenaWrapper.
 ///
@@ -73,7 +219,7 @@ int LogicalCPUBandwithControl()
 /// * If no BC in place and maxConcurrency<1, defaults to the default tbb number of threads,
 /// which is CPU affinity aware
 ////////////////////////////////////////////////////////////////////////////////
-RTaskArenaWrapper::RTaskArenaWrapper(unsigned maxConcurrency) : fTBBArena(new ROpaqueTaskArena{})
+RTaskArenaWrapper::RTaskArenaWrapper(unsigned maxConcurrency, bool pinToNUMANodes) : fTBBArena(new ROpaqueTaskArena{})
 {
    const unsigned tbbDefaultNumberThreads = fTBBArena->max_concurrency(); // not initialized, automatic state
    maxConcurrency = maxConcurrency > 0 ? std::min(maxConcurrency, tbbDefaultNumberThreads) : tbbDefaultNumberThreads;
@@ -88,11 +234,20 @@ RTaskArenaWrapper::RTaskArenaWrapper(unsigned maxConcurrency) : fTBBArena(new RO
    }
    fTBBArena->initialize(maxConcurrency);
    fNWorkers = maxConcurrency;
+   if (pinToNUMANodes) {
+      const auto nodes = GetNUMANodesCPUs();
+      if (nodes.size() > 1)
+         fNUMAObserver.reset(new RNUMAPinningObserver(*fTBBArena, maxConcurrency, nodes));
+      else
+         Info("RTaskArenaWrapper", "Only one NUMA node found, the threads are not pinned");
+   }
    ROOT::EnableThreadSafety();
 }
 
 RTaskArenaWrapper::~RTaskArenaWrapper()
 {
+   // stop observing before the arena goes away
+   fNUMAObserver.reset();
    fNWorkers = 0u;
 }
 
@@ -102,6 +257,17 @@ unsigned RTaskArenaWrapper::TaskArenaSize()
 {
    return fNWorkers;
 }
+////////////////////////////////////////////////////////////////////////////////
+/// Returns the arena slot of the calling thread in the task arena that it is
+/// running (TBB's implicit one, with its slot 0, for threads that are not
+/// running tasks), -1 if the slot is beyond the size of ROOT's arena.
+////////////////////////////////////////////////////////////////////////////////
+int RTaskArenaWrapper::GetCurrentThreadIndex()
+{
+   const int index = tbb::this_task_arena::current_thread_index();
+   return index >= 0 && static_cast<unsigned>(index) < fNWorkers ? index : -1;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Provides access to the wrapped tbb::task_arena.
 ////////////////////////////////////////////////////////////////////////////////
@@ -110,7 +276,7 @@ ROOT::ROpaqueTaskArena &RTaskArenaWrapper::Access()
    return *fTBBArena;
 }
 
-std::shared_ptr<ROOT::Internal::RTaskArenaWrapper> GetGlobalTaskArena(unsigned maxConcurrency)
+std::shared_ptr<ROOT::Internal::RTaskArenaWrapper> GetGlobalTaskArena(unsigned maxConcurrency, bool pinToNUMANodes)
 {
    static std::weak_ptr<ROOT::Internal::RTaskArenaWrapper> weak_GTAWrapper;
 
@@ -121,9 +287,14 @@ std::shared_ptr<ROOT::Internal::RTaskArenaWrapper> GetGlobalTaskArena(unsigned m
          Warning("RTaskArenaWrapper", "There's already an active task arena. Proceeding with the current %d threads",
                  sp->TaskArenaSize());
       }
+      if (pinToNUMANodes && !sp->IsPinnedToNUMANodes()) {
+         Warning("RTaskArenaWrapper", "There's already an active task arena. Proceeding without pinning its threads "
+                                      "to the NUMA nodes");
+      }
       return sp;
    }
-   std::shared_ptr<ROOT::Internal::RTaskArenaWrapper> sp(new ROOT::Internal::RTaskArenaWrapper(maxConcurrency));
+   std::shared_ptr<ROOT::Internal::RTaskArenaWrapper> sp(
+      new ROOT::Internal::RTaskArenaWrapper(maxConcurrency, pinToNUMANodes));
    weak_GTAWrapper = sp;
    return sp;
 }
@@ -0,0 +1,34 @@
+// @(#)root/thread:$Id$
+
+/*************************************************************************
+ * Copyright (C) 1995-2021, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#include "ROOT/TFuture.hxx"
+
+#include "TROOT.h"
+#include "ROOT/RTaskArena.hxx"
+#include "ROpaqueTaskArena.hxx"
+
+namespace ROOT {
+namespace Detail {
+
+////////////////////////////////////////////////////////////////////////////////
+/// The function is enqueued in the global task arena: contrary to
+/// TTaskGroup::Run, nothing waits for it, so that a continuation never holds a
+/// thread while the value it needs is being produced.
+void EnqueueInTaskArena(const std::function<void(void)> &f)
+{
+   if (!ROOT::IsImplicitMTEnabled()) {
+      f();
+      return;
+   }
+   ROOT::Internal::GetGlobalTaskArena()->Access().enqueue(f);
+}
+
+} // namespace Detail
+} // namespace ROOT
@@ -20,6 +20,9 @@
 
 #include "TError.h"
 #include "ROOT/RTaskArena.hxx"
+#include "ROOT/TFuture.hxx"
+#include "ROOT/TSeq.hxx"
+#include "ROOT/TThreadExecutor.hxx"
 #include <atomic>
 
 static std::shared_ptr<ROOT::Internal::RTaskArenaWrapper> &R__GetTaskArena4IMT()
@@ -55,6 +58,16 @@ extern "C" void ROOT_TImplicitMT_EnableImplicitMT(UInt_t numthreads)
    }
 };
 
+extern "C" void ROOT_TImplicitMT_EnableNUMAAwareImplicitMT(UInt_t numthreads)
+{
+   if (!GetImplicitMTFlag()) {
+      R__GetTaskArena4IMT() = ROOT::Internal::GetGlobalTaskArena(numthreads, /*pinToNUMANodes*/ true);
+      GetImplicitMTFlag() = true;
+   } else {
+      ::Warning("ROOT_TImplicitMT_EnableNUMAAwareImplicitMT", "Implicit multi-threading is already enabled");
+   }
+};
+
 extern "C" void ROOT_TImplicitMT_DisableImplicitMT()
 {
    if (GetImplicitMTFlag()) {
@@ -79,3 +92,13 @@ extern "C" bool ROOT_TImplicitMT_IsParBranchProcessingEnabled()
 {
    return GetParBranchProcessingCount() > 0;
 };
+
+extern "C" void ROOT_TImplicitMT_ForEach(UInt_t ntasks, void (*task)(void *, UInt_t), void *arg)
+{
+   ROOT::TThreadExecutor().Foreach([task, arg](UInt_t i) { task(arg, i); }, ROOT::TSeqU(ntasks));
+};
+
+extern "C" void ROOT_TImplicitMT_Enqueue(void (*task)(void *), void *arg)
+{
+   ROOT::Detail::EnqueueInTaskArena([task, arg] { task(arg); });
+};
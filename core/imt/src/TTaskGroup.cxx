@@ -12,9 +12,12 @@
 #include "RConfigure.h"
 
 #include "ROOT/TTaskGroup.hxx"
+#include "ROOT/RTrace.hxx"
 
 #ifdef R__USE_IMT
 #include "TROOT.h"
+#include "ROOT/RTaskArena.hxx"
+#include "ROpaqueTaskArena.hxx"
 #include "tbb/task_group.h"
 #include "tbb/task_arena.h"
 #endif
@@ -30,6 +33,10 @@
 A TTaskGroup represents concurrent execution of a group of tasks.
 Tasks may be dynamically added to the group as it is executing.
 Nesting TTaskGroup instances may result in a runtime overhead.
+
+Tasks are spawned and waited for inside ROOT's global task arena. Without that, tasks added from a thread
+that is not part of the thread pool (e.g. a dedicated I/O thread) would end up in the implicit TBB arena of
+that thread and thus ignore the number of threads requested by ROOT::EnableImplicitMT().
 */
 
 namespace ROOT {
@@ -59,6 +66,7 @@ TTaskGroup::TTaskGroup()
    if (!ROOT::IsImplicitMTEnabled()) {
       throw std::runtime_error("Implicit parallelism not enabled. Cannot instantiate a TTaskGroup.");
    }
+   fTaskArenaW = ROOT::Internal::GetGlobalTaskArena();
    fTaskContainer = ((void *)new tbb::task_group());
 #endif
 }
@@ -72,6 +80,7 @@ TTaskGroup &TTaskGroup::operator=(TTaskGroup &&other)
 {
    fTaskContainer = other.fTaskContainer;
    other.fTaskContainer = nullptr;
+   fTaskArenaW = std::move(other.fTaskArenaW);
    fCanRun.store(other.fCanRun);
    return *this;
 }
@@ -111,7 +120,12 @@ void TTaskGroup::Run(const std::function<void(void)> &closure)
    while (!fCanRun)
       /* empty */;
 
-   CastToTG(fTaskContainer)->run(closure);
+   fTaskArenaW->Access().execute([&] {
+      CastToTG(fTaskContainer)->run([closure] {
+         R__TRACE_SPAN("imt", "TTaskGroup task");
+         closure();
+      });
+   });
 #else
    closure();
 #endif
@@ -124,7 +138,7 @@ void TTaskGroup::Wait()
 {
 #ifdef R__USE_IMT
    fCanRun = false;
-   CastToTG(fTaskContainer)->wait();
+   fTaskArenaW->Access().execute([&] { CastToTG(fTaskContainer)->wait(); });
    fCanRun = true;
 #endif
 }
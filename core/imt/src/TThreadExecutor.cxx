@@ -2,6 +2,7 @@
 #define TBB_USE_CAPTURED_EXCEPTION 0
 
 #include "ROOT/TThreadExecutor.hxx"
+#include "ROOT/RTrace.hxx"
 #include "ROpaqueTaskArena.hxx"
 #if !defined(_MSC_VER)
 #pragma GCC diagnostic push
@@ -82,6 +83,12 @@
 /// An integer can be passed as the fourth argument indicating the number of chunks we want to divide our work in.
 /// This may be useful to avoid the overhead introduced when running really short tasks.
 ///
+/// The work is not split into a fixed number of chunks: as in TBB's auto_partitioner, ranges of arguments are split
+/// lazily, when idle threads steal them, so that iterations of very different costs keep all threads busy. The number
+/// of chunks only bounds how finely the arguments are split. Each thread reduces the results of its chunks as they are
+/// produced, and the partial results are then reduced pairwise, in order, so the results of all executions are never
+/// held in memory at the same time. The same partitioning is used by `Foreach`.
+///
 /// #### Examples:
 /// ~~~{.cpp}
 /// root[] ROOT::TThreadExecutor pool; auto ten = pool.MapReduce([]() { return 1; }, 10, [](const std::vector<int> &v) { return std::accumulate(v.begin(), v.end(), 0); })
@@ -135,6 +142,36 @@ static T ParallelReduceHelper(const std::vector<T> &objs, const std::function<T(
 
 }
 
+/// Adapts a TReduceBody to the requirements of tbb::parallel_reduce, which splits the body of a task only when the
+/// task is stolen
+class TReduceBodyAdaptor {
+   std::unique_ptr<TReduceBody> fSplitBody; // owned by the adaptors of the split bodies
+   TReduceBody *fBody;
+
+public:
+   explicit TReduceBodyAdaptor(TReduceBody &body) : fBody(&body) {}
+   TReduceBodyAdaptor(TReduceBodyAdaptor &other, tbb::split) : fSplitBody(other.fBody->Split()), fBody(fSplitBody.get())
+   {
+   }
+   void operator()(const tbb::blocked_range<unsigned int> &range)
+   {
+      R__TRACE_SPAN("imt", "TThreadExecutor task", range.begin());
+      fBody->Accumulate(range.begin(), range.end());
+   }
+   void join(TReduceBodyAdaptor &rhs) { fBody->Join(*rhs.fBody); }
+};
+
+/// Warn if tbb::global_control allows fewer workers than the pool has
+static void CheckGlobalControl(const char *where, unsigned poolSize)
+{
+   if (poolSize > tbb::global_control::active_value(tbb::global_control::max_allowed_parallelism)) {
+      Warning(where,
+              "tbb::global_control is limiting the number of parallel workers."
+              " Proceeding with %zu threads this time",
+              tbb::global_control::active_value(tbb::global_control::max_allowed_parallelism));
+   }
+}
+
 } // End NS Internal
 
 //////////////////////////////////////////////////////////////////////////
@@ -161,19 +198,70 @@ TThreadExecutor::TThreadExecutor(UInt_t nThreads)
 void TThreadExecutor::ParallelFor(unsigned int start, unsigned int end, unsigned step,
                                   const std::function<void(unsigned int i)> &f)
 {
-   if (GetPoolSize() > tbb::global_control::active_value(tbb::global_control::max_allowed_parallelism)) {
-      Warning("TThreadExecutor::ParallelFor",
-              "tbb::global_control is limiting the number of parallel workers."
-              " Proceeding with %zu threads this time",
-              tbb::global_control::active_value(tbb::global_control::max_allowed_parallelism));
-   }
+   ROOT::Internal::CheckGlobalControl("TThreadExecutor::ParallelFor", GetPoolSize());
+   fTaskArenaW->Access().execute([&] {
+      tbb::this_task_arena::isolate([&] {
+         tbb::parallel_for(start, end, step, [&f](unsigned int i) {
+            R__TRACE_SPAN("imt", "TThreadExecutor task", i);
+            f(i);
+         });
+      });
+   });
+}
+
+//////////////////////////////////////////////////////////////////////////
+/// \brief Execute a function in parallel over the ranges of indices that [0, nItems) is split into.
+///
+/// The range is split adaptively by TBB's auto_partitioner: only as much as needed to keep the threads busy, and never
+/// into chunks of less than grainSize / 2 indices.
+/// \param nItems Number of indices.
+/// \param grainSize Size of the chunks that are not split further.
+/// \param f function to execute on the begin and end of a chunk.
+void TThreadExecutor::ParallelForRange(unsigned int nItems, unsigned int grainSize,
+                                       const std::function<void(unsigned int begin, unsigned int end)> &f)
+{
+   ROOT::Internal::CheckGlobalControl("TThreadExecutor::ParallelForRange", GetPoolSize());
+   fTaskArenaW->Access().execute([&] {
+      tbb::this_task_arena::isolate([&] {
+         tbb::parallel_for(tbb::blocked_range<unsigned int>(0u, nItems, grainSize),
+                           [&](const tbb::blocked_range<unsigned int> &range) {
+                              R__TRACE_SPAN("imt", "TThreadExecutor task", range.begin());
+                              f(range.begin(), range.end());
+                           },
+                           tbb::auto_partitioner());
+      });
+   });
+}
+
+//////////////////////////////////////////////////////////////////////////
+/// \brief Accumulate in parallel the indices [0, nItems) into body, see MapReduceImpl.
+///
+/// \param nItems Number of indices.
+/// \param grainSize Size of the chunks that are not split further.
+/// \param body Partial result of the main task, holds the result at the end.
+void TThreadExecutor::ParallelReduceRange(unsigned int nItems, unsigned int grainSize, Internal::TReduceBody &body)
+{
+   ROOT::Internal::CheckGlobalControl("TThreadExecutor::ParallelReduceRange", GetPoolSize());
+   ROOT::Internal::TReduceBodyAdaptor adaptor(body);
    fTaskArenaW->Access().execute([&] {
       tbb::this_task_arena::isolate([&] {
-         tbb::parallel_for(start, end, step, f);
+         tbb::parallel_reduce(tbb::blocked_range<unsigned int>(0u, nItems, grainSize), adaptor,
+                              tbb::auto_partitioner());
       });
    });
 }
 
+//////////////////////////////////////////////////////////////////////////
+/// \brief Size of the chunks of nItems indices that are not split further.
+/// \param nItems Number of indices.
+/// \param nChunks Number of chunks requested by the user, 0 if none.
+unsigned TThreadExecutor::GetGrainSize(unsigned nItems, unsigned nChunks)
+{
+   if (nChunks == 0 || nItems <= nChunks)
+      return 1u;
+   return (nItems + nChunks - 1) / nChunks; // ceiling the division
+}
+
 //////////////////////////////////////////////////////////////////////////
 /// \brief "Reduce" in parallel an std::vector<double> into a single double value
 ///
@@ -183,12 +271,7 @@ void TThreadExecutor::ParallelFor(unsigned int start, unsigned int end, unsigned
 double TThreadExecutor::ParallelReduce(const std::vector<double> &objs,
                                        const std::function<double(double a, double b)> &redfunc)
 {
-   if (GetPoolSize() > tbb::global_control::active_value(tbb::global_control::max_allowed_parallelism)) {
-      Warning("TThreadExecutor::ParallelReduce",
-              "tbb::global_control is limiting the number of parallel workers."
-              " Proceeding with %zu threads this time",
-              tbb::global_control::active_value(tbb::global_control::max_allowed_parallelism));
-   }
+   ROOT::Internal::CheckGlobalControl("TThreadExecutor::ParallelReduce", GetPoolSize());
    return fTaskArenaW->Access().execute([&] { return ROOT::Internal::ParallelReduceHelper<double>(objs, redfunc); });
 }
 
@@ -201,12 +284,7 @@ double TThreadExecutor::ParallelReduce(const std::vector<double> &objs,
 float TThreadExecutor::ParallelReduce(const std::vector<float> &objs,
                                       const std::function<float(float a, float b)> &redfunc)
 {
-   if (GetPoolSize() > tbb::global_control::active_value(tbb::global_control::max_allowed_parallelism)) {
-      Warning("TThreadExecutor::ParallelReduce",
-              "tbb::global_control is limiting the number of parallel workers."
-              " Proceeding with %zu threads this time",
-              tbb::global_control::active_value(tbb::global_control::max_allowed_parallelism));
-   }
+   ROOT::Internal::CheckGlobalControl("TThreadExecutor::ParallelReduce", GetPoolSize());
    return fTaskArenaW->Access().execute([&] { return ROOT::Internal::ParallelReduceHelper<float>(objs, redfunc); });
 }
 
@@ -8,6 +8,7 @@
 #include <chrono>
 #include <condition_variable>
 #include <mutex>
+#include <set>
 #include "gtest/gtest.h"
 
 #ifdef R__USE_IMT
@@ -233,4 +234,39 @@ TEST(TThreadExecutor, ThreadSafety) {
    EXPECT_TRUE(std::equal(counters.begin(), counters.end(), target.begin()));
 }
 
+TEST(RTaskArena, NUMANodes)
+{
+   const auto nodes = ROOT::Internal::GetNUMANodesCPUs();
+   ASSERT_FALSE(nodes.empty());
+   std::set<unsigned> cpus;
+   for (auto &node : nodes) {
+      EXPECT_FALSE(node.empty());
+      cpus.insert(node.begin(), node.end());
+   }
+   // every core is in one node only
+   std::size_t nCPUs = 0;
+   for (auto &node : nodes)
+      nCPUs += node.size();
+   EXPECT_EQ(cpus.size(), nCPUs);
+}
+
+TEST(RTaskArena, PinToNUMANodes)
+{
+   const unsigned nCores = plausibleNCores(randGenerator);
+   auto gTAInstance = ROOT::Internal::GetGlobalTaskArena(nCores, /*pinToNUMANodes*/ true);
+   ASSERT_EQ(ROOT::Internal::RTaskArenaWrapper::TaskArenaSize(), nCores);
+   EXPECT_EQ(gTAInstance->IsPinnedToNUMANodes(), ROOT::Internal::GetNUMANodesCPUs().size() > 1);
+
+   // the work runs as usual, on the threads of the arena
+   std::atomic<int> nOutsideArena{0};
+   ROOT::TThreadExecutor ttex;
+   ttex.Foreach(
+      [&] {
+         if (ROOT::Internal::RTaskArenaWrapper::GetCurrentThreadIndex() < 0)
+            ++nOutsideArena;
+      },
+      1000);
+   EXPECT_EQ(nOutsideArena, 0);
+}
+
 #endif
@@ -1,7 +1,11 @@
 #include "TROOT.h"
 #include "ROOT/TFuture.hxx"
 
+#include <atomic>
 #include <future>
+#include <numeric>
+#include <stdexcept>
+#include <vector>
 
 #include "gtest/gtest.h"
 
@@ -50,4 +54,99 @@ TEST(TFuture, BuildFromAsync_void)
    f.get();
 }
 
+TEST(TFuture, Then)
+{
+   auto f = Async([]() { return 1; }).then([](int i) { return i + 1; }).then([](int i) { return 2. * i; });
+   ASSERT_DOUBLE_EQ(4., f.get());
+}
+
+TEST(TFuture, Then_ref)
+{
+   int a(0);
+   auto f = Async([&a]() -> int & { return a; }).then([](int &r) -> int & { return r; });
+   auto &&r = f.get();
+   ASSERT_EQ(&a, &(r));
+}
+
+TEST(TFuture, Then_void)
+{
+   std::atomic<int> n(0);
+   auto f = Async([&n]() { ++n; }).then([&n]() { ++n; return n.load(); }).then([&n](int) { ++n; });
+   f.get();
+   ASSERT_EQ(3, n);
+}
+
+TEST(TFuture, ThenFromSTLFuture)
+{
+   TFuture<int> f = std::async([]() { return 1; });
+   auto g = f.then([](int i) { return i + 1; });
+   ASSERT_FALSE(f.valid());
+   ASSERT_EQ(2, g.get());
+}
+
+TEST(TFuture, ThenException)
+{
+   auto f = Async([]() -> int { throw std::runtime_error("in the task"); }).then([](int i) { return i + 1; });
+   ASSERT_THROW(f.get(), std::runtime_error);
+   auto g = Async([]() { return 1; }).then([](int) -> int { throw std::runtime_error("in the continuation"); });
+   ASSERT_THROW(g.get(), std::runtime_error);
+}
+
+TEST(TFuture, WhenAll)
+{
+   std::vector<TFuture<int>> futures;
+   for (int i = 0; i < 8; ++i)
+      futures.emplace_back(Async([i]() { return i * i; }));
+   auto all = WhenAll(std::move(futures)).then([](const std::vector<int> &v) {
+      return std::accumulate(v.begin(), v.end(), 0);
+   });
+   ASSERT_EQ(140, all.get());
+
+   std::atomic<int> n(0);
+   std::vector<TFuture<void>> voids;
+   for (int i = 0; i < 8; ++i)
+      voids.emplace_back(Async([&n]() { ++n; }));
+   WhenAll(std::move(voids)).get();
+   ASSERT_EQ(8, n);
+
+   ASSERT_TRUE(WhenAll(std::vector<TFuture<int>>()).get().empty());
+}
+
+TEST(TFuture, IsReady)
+{
+   std::promise<int> p;
+   auto f = TFuture<int>(p.get_future()).then([](int i) { return i; });
+   ASSERT_FALSE(f.is_ready());
+   p.set_value(1);
+   f.wait();
+   ASSERT_TRUE(f.is_ready());
+   ASSERT_EQ(1, f.get());
+}
+
+#if defined(__cpp_impl_coroutine) && __has_include(<coroutine>)
+// A minimal coroutine type, which does not suspend until it awaits a TFuture.
+struct TestCoroutine {
+   struct promise_type {
+      TestCoroutine get_return_object() { return {}; }
+      std::suspend_never initial_suspend() { return {}; }
+      std::suspend_never final_suspend() noexcept { return {}; }
+      void return_void() {}
+      void unhandled_exception() { std::terminate(); }
+   };
+};
+
+TestCoroutine AddOne(std::promise<int> &result)
+{
+   auto i = co_await Async([]() { return 41; });
+   result.set_value(i + 1);
+}
+
+TEST(TFuture, CoAwait)
+{
+   std::promise<int> result;
+   AddOne(result);
+   ASSERT_EQ(42, result.get_future().get());
+}
+#endif
+
 #endif
@@ -4,6 +4,9 @@
 
 #ifdef R__USE_IMT
 #include "ROOT/TTaskGroup.hxx"
+#include "tbb/task_arena.h"
+
+#include <thread>
 
 using namespace ROOT::Experimental;
 
@@ -27,4 +30,19 @@ TEST(TTaskGroup, NestedExecution)
    EXPECT_EQ(Fibonacci(7), 13);
 }
 
-#endif
\ No newline at end of file
+TEST(TTaskGroup, ForeignThreadUsesGlobalArena)
+{
+   ROOT::EnableImplicitMT(2);
+   const int poolSize = ROOT::GetThreadPoolSize();
+   int arenaConcurrency = 0;
+   // Tasks added from a thread outside the thread pool must still execute in ROOT's task arena
+   std::thread foreignThread([&] {
+      ROOT::Experimental::TTaskGroup tg;
+      tg.Run([&] { arenaConcurrency = tbb::this_task_arena::max_concurrency(); });
+      tg.Wait();
+   });
+   foreignThread.join();
+   EXPECT_EQ(poolSize, arenaConcurrency);
+}
+
+#endif
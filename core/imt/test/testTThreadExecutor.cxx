@@ -0,0 +1,66 @@
+#include "RConfigure.h"
+
+#include "gtest/gtest.h"
+
+#ifdef R__USE_IMT
+#include "ROOT/TSeq.hxx"
+#include "ROOT/TThreadExecutor.hxx"
+
+#include <atomic>
+#include <numeric>
+#include <string>
+#include <vector>
+
+TEST(TThreadExecutor, MapReduceChunks)
+{
+   ROOT::TThreadExecutor pool(4);
+   std::vector<int> v(10000);
+   std::iota(v.begin(), v.end(), 0);
+   auto sum = [](const std::vector<long> &x) { return std::accumulate(x.begin(), x.end(), 0L); };
+   for (unsigned nChunks : {0u, 1u, 3u, 7u, 100u, 20000u})
+      EXPECT_EQ(49995000L, pool.MapReduce([](int i) { return long(i); }, v, sum, nChunks));
+   EXPECT_EQ(49995000L, pool.MapReduce([](int i) { return long(i); }, v, sum));
+   EXPECT_EQ(10L, pool.MapReduce([] { return 1L; }, 10, sum));
+   // the reduction of no results is the one of an empty vector
+   EXPECT_EQ(0L, pool.MapReduce([] { return 1L; }, 0, sum));
+}
+
+TEST(TThreadExecutor, MapReduceOrder)
+{
+   // the partial results are joined in order, also for non-commutative reductions
+   ROOT::TThreadExecutor pool(4);
+   auto concat = [](const std::string &a, const std::string &b) { return a + b; };
+   std::string expected;
+   for (int i = 0; i < 500; ++i)
+      expected += std::to_string(i % 10);
+   for (unsigned nChunks : {0u, 4u, 50u}) {
+      EXPECT_EQ(expected, pool.MapReduce([](unsigned i) { return std::to_string(i % 10); },
+                                         ROOT::TSeq<unsigned>(500), concat, nChunks));
+   }
+   EXPECT_EQ("02468", pool.MapReduce([](unsigned i) { return std::to_string(i); }, ROOT::TSeq<unsigned>(0, 10, 2),
+                                     concat, 2));
+   EXPECT_DOUBLE_EQ(4.5, pool.MapReduce([](double x) { return x; }, {1.5, 3.}, [](double a, double b) { return a + b; }, 2));
+}
+
+TEST(TThreadExecutor, ForeachChunks)
+{
+   ROOT::TThreadExecutor pool(4);
+   std::vector<std::atomic<int>> counts(1000);
+   for (unsigned nChunks : {0u, 1u, 7u, 5000u}) {
+      for (auto &c : counts)
+         c = 0;
+      pool.Foreach([&](unsigned i) { counts[i]++; }, ROOT::TSeq<unsigned>(1000), nChunks);
+      for (auto &c : counts)
+         EXPECT_EQ(1, c.load());
+   }
+
+   std::atomic<int> n{0};
+   pool.Foreach([&] { n++; }, 123, 5);
+   EXPECT_EQ(123, n.load());
+
+   std::vector<int> v(77, 2);
+   pool.Foreach([](int &x) { x *= 2; }, v, 3);
+   EXPECT_EQ(77 * 4, std::accumulate(v.begin(), v.end(), 0));
+}
+
+#endif
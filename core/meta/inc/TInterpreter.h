@@ -51,10 +51,13 @@ R__EXTERN TVirtualMutex *gInterpreterMutex;
 # define R__LOCKGUARD_CLING(mutex)  (void)(mutex); { }
 #endif
 
+class TInterpreter;
+
 namespace ROOT {
 namespace Internal {
 struct InterpreterMutexRegistrationRAII {
    TLockGuard fLockGuard;
+   TInterpreter *fInterpreter = nullptr; ///< Interpreter whose mutex state was snapshot, null if there was none yet
    InterpreterMutexRegistrationRAII(TVirtualMutex* mutex);
    ~InterpreterMutexRegistrationRAII();
 };
@@ -566,13 +569,16 @@ R__EXTERN TInterpreter* gCling;
 inline ROOT::Internal::InterpreterMutexRegistrationRAII::InterpreterMutexRegistrationRAII(TVirtualMutex* mutex):
    fLockGuard(mutex)
 {
-   if (gCoreMutex)
-      ::gCling->SnapshotMutexState(gCoreMutex);
+   // The interpreter might not be initialized yet, see Root.LazyInterpreter.
+   if (gCoreMutex && ::gCling) {
+      fInterpreter = ::gCling;
+      fInterpreter->SnapshotMutexState(gCoreMutex);
+   }
 }
 inline ROOT::Internal::InterpreterMutexRegistrationRAII::~InterpreterMutexRegistrationRAII()
 {
-   if (gCoreMutex)
-      ::gCling->ForgetMutexState();
+   if (fInterpreter)
+      fInterpreter->ForgetMutexState();
 }
 
 #endif
@@ -94,7 +94,11 @@ In order to access the name of a class within the ROOT type system, the method T
 #include <sstream>
 #include <string>
 #include <map>
+#include <atomic>
+#include <deque>
+#include <string_view>
 #include <typeinfo>
+#include <unordered_map>
 #include <cmath>
 #include <cassert>
 #include <vector>
@@ -135,6 +139,15 @@ namespace {
 
    static constexpr const char kUndeterminedClassInfoName[] = "<NOT YET DETERMINED FROM fClassInfo>";
 
+   // Incremented whenever a TClass is added, removed, unloaded or deleted, which
+   // invalidates the lookup caches of TClass::GetClass.
+   std::atomic<ULong64_t> gClassLookupEpoch{0};
+
+   void InvalidateClassLookupCaches()
+   {
+      ++gClassLookupEpoch;
+   }
+
    class TMmallocDescTemp {
    private:
       void *fSave;
@@ -496,6 +509,7 @@ void TClass::AddClass(TClass *cl)
    if (!cl) return;
 
    R__LOCKGUARD(gInterpreterMutex);
+   InvalidateClassLookupCaches();
    gROOT->GetListOfClasses()->Add(cl);
    if (cl->GetTypeInfo()) {
       GetIdMap()->Add(cl->GetTypeInfo()->name(),cl);
@@ -522,6 +536,7 @@ void TClass::RemoveClass(TClass *oldcl)
    if (!oldcl) return;
 
    R__LOCKGUARD(gInterpreterMutex);
+   InvalidateClassLookupCaches();
    gROOT->GetListOfClasses()->Remove(oldcl);
    if (oldcl->GetTypeInfo()) {
       GetIdMap()->Remove(oldcl->GetTypeInfo()->name());
@@ -1647,6 +1662,7 @@ void TClass::Init(const char *name, Version_t cversion,
 TClass::~TClass()
 {
    R__LOCKGUARD(gInterpreterMutex);
+   InvalidateClassLookupCaches();
 
    // Remove from the typedef hashtables.
    if (fgClassTypedefHash && TestBit (kHasNameMapNode)) {
@@ -2944,6 +2960,84 @@ TVirtualIsAProxy* TClass::GetIsAProxy() const
    return fIsA;
 }
 
+namespace {
+   // Loaded classes found by TClass::GetClass, by the name and by the type_info
+   // they were requested with. Each thread has its own cache, so hits need no
+   // lock; the cache is cleared when the epoch has changed since it was
+   // filled, i.e. before any of its classes can be deleted.
+   struct TClassLookupCache {
+      static constexpr std::size_t kMaxEntries = 4096;
+
+      ULong64_t fEpoch = 0;
+      std::deque<std::string> fNames; // Storage of the keys of fByName
+      std::unordered_map<std::string_view, TClass *> fByName;
+      std::unordered_map<const std::type_info *, TClass *> fByTypeInfo;
+
+      ~TClassLookupCache() { Destroyed() = true; }
+
+      static bool &Destroyed()
+      {
+         TTHREAD_TLS(bool) destroyed = false;
+         return destroyed;
+      }
+
+      // Return the cache of this thread, or nullptr if it was already destroyed
+      // because the thread is exiting.
+      static TClassLookupCache *Get()
+      {
+         if (Destroyed())
+            return nullptr;
+         TTHREAD_TLS_DECL(TClassLookupCache, cache);
+         const ULong64_t epoch = gClassLookupEpoch;
+         if (cache.fEpoch != epoch) {
+            cache.Clear();
+            cache.fEpoch = epoch;
+         }
+         return &cache;
+      }
+
+      void Clear()
+      {
+         fByName.clear();
+         fNames.clear();
+         fByTypeInfo.clear();
+      }
+
+      TClass *Find(const char *name) const
+      {
+         auto entry = fByName.find(name);
+         return entry == fByName.end() ? nullptr : entry->second;
+      }
+
+      TClass *Find(const std::type_info &typeinfo) const
+      {
+         auto entry = fByTypeInfo.find(&typeinfo);
+         return entry == fByTypeInfo.end() ? nullptr : entry->second;
+      }
+
+      // Cache a class found since the cache was returned by Get with the given epoch.
+      template <typename Key>
+      static TClass *Add(TClassLookupCache *cache, ULong64_t epoch, const Key &key, TClass *cl)
+      {
+         // kReservedLoading is kUnloading once the class is loaded
+         if (!cache || cache->fEpoch != epoch || !cl->IsLoaded() || cl->TestBit(TClass::kReservedLoading))
+            return cl;
+         if (cache->fByName.size() + cache->fByTypeInfo.size() >= kMaxEntries)
+            cache->Clear();
+         cache->Insert(key, cl);
+         return cl;
+      }
+
+      void Insert(const char *name, TClass *cl)
+      {
+         fNames.emplace_back(name);
+         fByName.emplace(fNames.back(), cl);
+      }
+
+      void Insert(const std::type_info &typeinfo, TClass *cl) { fByTypeInfo.emplace(&typeinfo, cl); }
+   };
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Static method returning pointer to TClass of the specified class name.
 /// If load is true an attempt is made to obtain the class by loading
@@ -2961,6 +3055,11 @@ TClass *TClass::GetClass(const char *name, Bool_t load, Bool_t silent, size_t hi
 {
    if (!name || !name[0]) return nullptr;
 
+   auto cache = TClassLookupCache::Get();
+   if (TClass *cached = cache ? cache->Find(name) : nullptr) return cached;
+   const ULong64_t epoch = cache ? cache->fEpoch : 0;
+   const char *requestedName = name;
+
    if (strstr(name, "(anonymous)")) return nullptr;
    if (strncmp(name,"class ",6)==0) name += 6;
    if (strncmp(name,"struct ",7)==0) name += 7;
@@ -2974,7 +3073,7 @@ TClass *TClass::GetClass(const char *name, Bool_t load, Bool_t silent, size_t hi
 
    // Early return to release the lock without having to execute the
    // long-ish normalization.
-   if (cl && (cl->IsLoaded() || cl->TestBit(kUnloading))) return cl;
+   if (cl && (cl->IsLoaded() || cl->TestBit(kUnloading))) return TClassLookupCache::Add(cache, epoch, requestedName, cl);
 
    R__WRITE_LOCKGUARD(ROOT::gCoreMutex);
 
@@ -2983,7 +3082,7 @@ TClass *TClass::GetClass(const char *name, Bool_t load, Bool_t silent, size_t hi
 
    cl = (TClass*)gROOT->GetListOfClasses()->FindObject(name);
    if (cl) {
-      if (cl->IsLoaded() || cl->TestBit(kUnloading)) return cl;
+      if (cl->IsLoaded() || cl->TestBit(kUnloading)) return TClassLookupCache::Add(cache, epoch, requestedName, cl);
 
       // We could speed-up some of the search by adding (the equivalent of)
       //
@@ -3025,7 +3124,7 @@ TClass *TClass::GetClass(const char *name, Bool_t load, Bool_t silent, size_t hi
       TClass *loadedcl = (dict)();
       if (loadedcl) {
          loadedcl->PostLoadCheck();
-         return loadedcl;
+         return TClassLookupCache::Add(cache, epoch, requestedName, loadedcl);
       }
 
       // We should really not fall through to here, but if we do, let's just
@@ -3045,7 +3144,7 @@ TClass *TClass::GetClass(const char *name, Bool_t load, Bool_t silent, size_t hi
          cl = (TClass*)gROOT->GetListOfClasses()->FindObject(normalizedName.c_str());
 
          if (cl) {
-            if (cl->IsLoaded() || cl->TestBit(kUnloading)) return cl;
+            if (cl->IsLoaded() || cl->TestBit(kUnloading)) return TClassLookupCache::Add(cache, epoch, requestedName, cl);
 
             //we may pass here in case of a dummy class created by TVirtualStreamerInfo
             load = kTRUE;
@@ -3107,7 +3206,7 @@ TClass *TClass::GetClass(const char *name, Bool_t load, Bool_t silent, size_t hi
          }
       }
    }
-   if (loadedcl) return loadedcl;
+   if (loadedcl) return TClassLookupCache::Add(cache, epoch, requestedName, loadedcl);
 
    // See if the TClassGenerator can produce the TClass we need.
    loadedcl = LoadClassCustom(normalizedName.c_str(),silent);
@@ -3131,7 +3230,7 @@ TClass *TClass::GetClass(const char *name, Bool_t load, Bool_t silent, size_t hi
    if (!ispairbase) {
       std::string::size_type posLess = normalizedName.find('<');
       if (posLess != std::string::npos) {
-         gCling->AutoParse(normalizedName.substr(0, posLess).c_str());
+         gInterpreter->AutoParse(normalizedName.substr(0, posLess).c_str());
       }
    }
 
@@ -3209,12 +3308,16 @@ TClass *TClass::GetClass(const std::type_info& typeinfo, Bool_t load, Bool_t /*
    if (!gROOT->GetListOfClasses())
       return nullptr;
 
+   auto cache = TClassLookupCache::Get();
+   if (TClass *cached = cache ? cache->Find(typeinfo) : nullptr) return cached;
+   const ULong64_t epoch = cache ? cache->fEpoch : 0;
+
    //protect access to TROOT::GetIdMap
    R__READ_LOCKGUARD(ROOT::gCoreMutex);
 
    TClass* cl = GetIdMap()->Find(typeinfo.name());
 
-   if (cl && cl->IsLoaded()) return cl;
+   if (cl && cl->IsLoaded()) return TClassLookupCache::Add(cache, epoch, typeinfo, cl);
 
    R__WRITE_LOCKGUARD(ROOT::gCoreMutex);
 
@@ -3224,7 +3327,7 @@ TClass *TClass::GetClass(const std::type_info& typeinfo, Bool_t load, Bool_t /*
    cl = GetIdMap()->Find(typeinfo.name());
 
    if (cl) {
-      if (cl->IsLoaded()) return cl;
+      if (cl->IsLoaded()) return TClassLookupCache::Add(cache, epoch, typeinfo, cl);
       //we may pass here in case of a dummy class created by TVirtualStreamerInfo
       load = kTRUE;
    } else {
@@ -3245,7 +3348,10 @@ TClass *TClass::GetClass(const std::type_info& typeinfo, Bool_t load, Bool_t /*
    DictFuncPtr_t dict = TClassTable::GetDict(typeinfo);
    if (dict) {
       cl = (dict)();
-      if (cl) cl->PostLoadCheck();
+      if (cl) {
+         cl->PostLoadCheck();
+         TClassLookupCache::Add(cache, epoch, typeinfo, cl);
+      }
       return cl;
    }
    if (cl) return cl;
@@ -3261,7 +3367,7 @@ TClass *TClass::GetClass(const std::type_info& typeinfo, Bool_t load, Bool_t /*
    }
 
    // try AutoLoading the typeinfo
-   int autoload_old = gCling->SetClassAutoLoading(1);
+   int autoload_old = gInterpreter->SetClassAutoLoading(1);
    if (!autoload_old) {
       // Re-disable, we just meant to test
       gCling->SetClassAutoLoading(0);
@@ -6265,6 +6371,7 @@ void TClass::SetUnloaded()
       return;
    }
    SetBit(kUnloading);
+   InvalidateClassLookupCaches();
 
    //R__ASSERT(fState == kLoaded);
    if (fState != kLoaded) {
@@ -272,7 +272,7 @@ void TDataMember::Init(bool afterReading)
 
 TDataMember::TDataMember(const TDataMember& dm) :
   TDictionary(dm),
-  fInfo(gCling->DataMemberInfo_FactoryCopy(dm.fInfo)),
+  fInfo(dm.fInfo ? gCling->DataMemberInfo_FactoryCopy(dm.fInfo) : nullptr),
   fClass(dm.fClass),
   fDataType(dm.fDataType),
   fOffset(dm.fOffset),
@@ -298,7 +298,7 @@ TDataMember::TDataMember(const TDataMember& dm) :
 TDataMember& TDataMember::operator=(const TDataMember& dm)
 {
    if(this!=&dm) {
-      gCling->DataMemberInfo_Delete(fInfo);
+      if (fInfo) gCling->DataMemberInfo_Delete(fInfo);
       delete fValueSetter; fValueSetter = nullptr;
       delete fValueGetter; fValueGetter = nullptr;
       if (fOptions) {
@@ -308,7 +308,7 @@ TDataMember& TDataMember::operator=(const TDataMember& dm)
       }
 
       TDictionary::operator=(dm);
-      fInfo= gCling->DataMemberInfo_FactoryCopy(dm.fInfo);
+      fInfo= dm.fInfo ? gCling->DataMemberInfo_FactoryCopy(dm.fInfo) : nullptr;
       fClass=dm.fClass;
       fDataType=dm.fDataType;
       fOffset=dm.fOffset;
@@ -333,7 +333,7 @@ TDataMember& TDataMember::operator=(const TDataMember& dm)
 TDataMember::~TDataMember()
 {
    delete [] fArrayMaxIndex;
-   gCling->DataMemberInfo_Delete(fInfo);
+   if (fInfo) gCling->DataMemberInfo_Delete(fInfo);
    delete fValueSetter;
    delete fValueGetter;
    if (fOptions) {
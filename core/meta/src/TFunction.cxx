@@ -64,7 +64,7 @@ TFunction& TFunction::operator=(const TFunction &rhs)
 {
    if (this != &rhs) {
       R__LOCKGUARD(gInterpreterMutex);
-      gCling->MethodInfo_Delete(fInfo);
+      if (fInfo) gCling->MethodInfo_Delete(fInfo);
       if (fMethodArgs) fMethodArgs->Delete();
       delete fMethodArgs;
       if (rhs.fInfo) {
@@ -85,7 +85,7 @@ TFunction& TFunction::operator=(const TFunction &rhs)
 TFunction::~TFunction()
 {
    R__LOCKGUARD(gInterpreterMutex);
-   gCling->MethodInfo_Delete(fInfo);
+   if (fInfo) gCling->MethodInfo_Delete(fInfo);
 
    if (fMethodArgs) fMethodArgs->Delete();
    delete fMethodArgs;
@@ -62,6 +62,8 @@ TInterpreter *TInterpreter::Instance()
       if (!getROOT) {
          ::Fatal("TInterpreter::Instance","TROOT object is required before accessing a TInterpreter");
       }
+      if (gInterpreterLocal == nullptr)
+         ROOT::Internal::InitDeferredInterpreter();
    }
    return gInterpreterLocal;
 }
@@ -104,7 +104,7 @@ fDtorOnly(orig.fDtorOnly), fRetType(orig.fRetType)
 TMethodCall &TMethodCall::operator=(const TMethodCall &rhs)
 {
    if (this != &rhs) {
-      gCling->CallFunc_Delete(fFunc);
+      if (fFunc) gCling->CallFunc_Delete(fFunc);
       fFunc     = rhs.fFunc ? gCling->CallFunc_FactoryCopy(rhs.fFunc) : nullptr;
       fOffset   = rhs.fOffset;
       fClass    = rhs.fClass;
@@ -126,7 +126,7 @@ TMethodCall &TMethodCall::operator=(const TMethodCall &rhs)
 
 TMethodCall::~TMethodCall()
 {
-   gCling->CallFunc_Delete(fFunc);
+   if (fFunc) gCling->CallFunc_Delete(fFunc);
    delete fMetPtr;
 }
 
@@ -225,7 +225,7 @@ void TMethodCall::Init(const TFunction *function)
    if (!function) return;
 
    if (!fFunc)
-      fFunc = gCling->CallFunc_Factory();
+      fFunc = gInterpreter->CallFunc_Factory();
    else
       gCling->CallFunc_Init(fFunc);
 
@@ -256,7 +256,7 @@ void TMethodCall::Init(const TFunction *function)
 
 void TMethodCall::Init(TClass *cl, const char *method, const char *params, Bool_t objectIsConst /* = kFALSE */)
 {
-   ClassInfo_t *cinfo = gCling->ClassInfo_Factory();
+   ClassInfo_t *cinfo = gInterpreter->ClassInfo_Factory();
    if (!cl) {
       UInt_t pos = 0;
       cl = R__FindScope(method,pos,cinfo);
@@ -278,7 +278,7 @@ void TMethodCall::Init(TClass *cl, const char *method, const char *params, Bool_
 void TMethodCall::Init(const char *function, const char *params)
 {
    UInt_t pos = 0;
-   ClassInfo_t *cinfo = gCling->ClassInfo_Factory();
+   ClassInfo_t *cinfo = gInterpreter->ClassInfo_Factory();
    TClass *cl = R__FindScope(function,pos,cinfo);
    InitImplementation(function+pos, params, nullptr, false, cl, cinfo);
    gCling->ClassInfo_Delete(cinfo);
@@ -338,7 +338,7 @@ void TMethodCall::InitImplementation(const char *methodname, const char *params,
 
 void TMethodCall::InitWithPrototype(TClass *cl, const char *method, const char *proto, Bool_t objectIsConst /* = kFALSE */, ROOT::EFunctionMatchMode mode /* = ROOT::kConversionMatch */)
 {
-   ClassInfo_t *cinfo = gCling->ClassInfo_Factory();
+   ClassInfo_t *cinfo = gInterpreter->ClassInfo_Factory();
    if (!cl) {
       UInt_t pos = 0;
       cl = R__FindScope(method,pos,cinfo);
@@ -360,7 +360,7 @@ void TMethodCall::InitWithPrototype(TClass *cl, const char *method, const char *
 void TMethodCall::InitWithPrototype(const char *function, const char *proto, ROOT::EFunctionMatchMode mode /* = ROOT::kConversionMatch */)
 {
    UInt_t pos = 0;
-   ClassInfo_t *cinfo = gCling->ClassInfo_Factory();
+   ClassInfo_t *cinfo = gInterpreter->ClassInfo_Factory();
    TClass *cl = R__FindScope(function,pos,cinfo);
    InitImplementation(function+pos, nullptr, proto, false, cl, cinfo, mode);
    gCling->ClassInfo_Delete(cinfo);
@@ -1,6 +1,7 @@
 #include "TClass.h"
 #include "THashTable.h"
 #include "TInterpreter.h"
+#include "TNamed.h"
 
 #include "gtest/gtest.h"
 
@@ -22,3 +23,21 @@ TEST(TClass, DictCheck)
 
    EXPECT_STREQ(errMsg.c_str(), "Missing dictionary for C, ") << errMsg;
 }
+
+TEST(TClass, GetClassLookupCache)
+{
+   // The second lookups are served by the lookup cache of the thread.
+   auto byName = TClass::GetClass("TNamed");
+   ASSERT_NE(byName, nullptr);
+   EXPECT_EQ(TClass::GetClass("TNamed"), byName);
+   EXPECT_EQ(TClass::GetClass(typeid(TNamed)), byName);
+   EXPECT_EQ(TClass::GetClass(typeid(TNamed)), byName);
+
+   // Declaring a new class invalidates the caches.
+   EXPECT_EQ(TClass::GetClass("GetClassLookupCacheTest", true, true), nullptr);
+   gInterpreter->Declare("class GetClassLookupCacheTest {};");
+   auto declared = TClass::GetClass("GetClassLookupCacheTest");
+   ASSERT_NE(declared, nullptr);
+   EXPECT_EQ(TClass::GetClass("GetClassLookupCacheTest"), declared);
+   EXPECT_EQ(TClass::GetClass("TNamed"), byName);
+}
@@ -39,6 +39,14 @@ using MPCodeBufPair = std::pair<unsigned, std::unique_ptr<TBufferFile>>;
 // to send a code and an object of any non-pointer type.
 int MPSend(TSocket *s, unsigned code);
 
+// Send a code and an object already streamed into objBuf. Used by the templated
+// versions of MPSend for class types and TObject pointers.
+int MPSendObjBuf(TSocket *s, unsigned code, const TBufferFile &objBuf);
+
+// Remove the shared memory segments of the large objects sent by this process
+// which were not received.
+void MPRemoveShmSegments();
+
 template<class T, typename std::enable_if<std::is_class<T>::value>::type * = nullptr>
 int MPSend(TSocket *s, unsigned code, T obj);
 
@@ -98,11 +106,7 @@ int MPSend(TSocket *s, unsigned code, T obj)
    }
    TBufferFile objBuf(TBuffer::kWrite);
    objBuf.WriteObjectAny(&obj, c);
-   TBufferFile wBuf(TBuffer::kWrite);
-   wBuf.WriteUInt(code);
-   wBuf.WriteULong(objBuf.Length());
-   wBuf.WriteBuf(objBuf.Buffer(), objBuf.Length());
-   return s->SendRaw(wBuf.Buffer(), wBuf.Length());
+   return MPSendObjBuf(s, code, objBuf);
 }
 
 /// \cond
@@ -138,13 +142,7 @@ int MPSend(TSocket *s, unsigned code, T obj)
    if(obj != nullptr)
       objBuf.WriteObjectAny(obj, obj->IsA());
 
-   //write everything together in a buffer
-   TBufferFile wBuf(TBuffer::kWrite);
-   wBuf.WriteUInt(code);
-   wBuf.WriteULong(objBuf.Length());
-   if(objBuf.Length())
-      wBuf.WriteBuf(objBuf.Buffer(), objBuf.Length());
-   return s->SendRaw(wBuf.Buffer(), wBuf.Length());
+   return MPSendObjBuf(s, code, objBuf);
 }
 
 /// \endcond
@@ -159,7 +157,7 @@ T ReadBuffer(TBufferFile *buf)
 {
    TClass *c = TClass::GetClass(typeid(T));
    T *objp = (T *)buf->ReadObjectAny(c);
-   T obj = *objp; //this is slow, but couldn't find a better way of returning a T without leaking memory
+   T obj = std::move(*objp); // e.g. the data of std::vector and RVec results are not copied
    delete objp;
    return obj;
 }
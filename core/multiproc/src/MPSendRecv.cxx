@@ -11,8 +11,107 @@
  
 #include "MPSendRecv.h"
 #include "TBufferFile.h"
+#include "TSystem.h"
 #include "MPCode.h"
+#include <atomic>
 #include <memory> //unique_ptr
+#include <mutex>
+#include <utility> //pair
+#include <vector>
+#include <fcntl.h> //open
+#include <sys/mman.h> //mmap
+#include <sys/stat.h> //fstat
+#include <unistd.h> //write, close
+
+namespace {
+
+/// Objects streamed into more bytes than this are passed through shared memory instead of the socket
+constexpr ULong_t kShmThreshold = 1024 * 1024;
+/// Set in the size of the messages whose object is in shared memory; the size is then the one of the segment name
+constexpr ULong_t kShmFlag = 1UL << (8 * sizeof(ULong_t) - 1);
+
+//////////////////////////////////////////////////////////////////////////
+/// Directory of the shared memory segments: /dev/shm if it exists, where the files
+/// are never written to disk, otherwise the temporary directory
+const std::string &GetShmDirectory()
+{
+   static const std::string dir = gSystem->AccessPathName("/dev/shm") ? gSystem->TempDirectory() : "/dev/shm";
+   return dir;
+}
+
+std::mutex gShmSegmentsMutex;
+
+//////////////////////////////////////////////////////////////////////////
+/// The shared memory segments written by this process, with the pid of the writer,
+/// since a forked worker inherits the list of its client
+std::vector<std::pair<Int_t, std::string>> &GetShmSegments()
+{
+   static std::vector<std::pair<Int_t, std::string>> segments;
+   return segments;
+}
+
+//////////////////////////////////////////////////////////////////////////
+/// Write the buffer into a new shared memory segment, returns its path or an empty string on failure
+std::string WriteShmSegment(const char *buf, ULong_t len)
+{
+   static std::atomic<unsigned> counter{0};
+   const Int_t pid = gSystem->GetPid();
+   std::string path = GetShmDirectory() + "/root_mp_" + std::to_string(pid) + "_" + std::to_string(counter++);
+   int fd = open(path.c_str(), O_RDWR | O_CREAT | O_EXCL, 0600);
+   if (fd < 0)
+      return std::string();
+   {
+      std::lock_guard<std::mutex> lock(gShmSegmentsMutex);
+      GetShmSegments().emplace_back(pid, path);
+   }
+   ULong_t written = 0;
+   while (written < len) {
+      ssize_t n = write(fd, buf + written, len - written);
+      if (n <= 0)
+         break;
+      written += n;
+   }
+   close(fd);
+   if (written != len) {
+      unlink(path.c_str());
+      return std::string();
+   }
+   return path;
+}
+
+//////////////////////////////////////////////////////////////////////////
+/// A TBufferFile reading an object directly from a mapped shared memory segment,
+/// which is unmapped when the buffer is destroyed
+class TMPShmBuffer : public TBufferFile {
+   void *fMapped;
+   size_t fMappedLen;
+
+public:
+   TMPShmBuffer(void *mapped, size_t len)
+      : TBufferFile(TBuffer::kRead, len, mapped, kFALSE), fMapped(mapped), fMappedLen(len) {}
+   ~TMPShmBuffer() { munmap(fMapped, fMappedLen); }
+};
+
+//////////////////////////////////////////////////////////////////////////
+/// Map and remove the shared memory segment at path, returns nullptr on failure
+std::unique_ptr<TBufferFile> ReadShmSegment(const std::string &path)
+{
+   int fd = open(path.c_str(), O_RDONLY);
+   // the segment is not needed anymore once it is mapped
+   unlink(path.c_str());
+   if (fd < 0)
+      return nullptr;
+   struct stat st;
+   void *mapped = MAP_FAILED;
+   if (fstat(fd, &st) == 0 && st.st_size > 0)
+      mapped = mmap(nullptr, st.st_size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+   close(fd);
+   if (mapped == MAP_FAILED)
+      return nullptr;
+   return std::unique_ptr<TBufferFile>(new TMPShmBuffer(mapped, st.st_size));
+}
+
+} // anonymous namespace
 
 //////////////////////////////////////////////////////////////////////////
 /// Send a message with the specified code on the specified socket.
@@ -38,6 +137,58 @@ int MPSend(TSocket *s, unsigned code)
 }
 
 
+//////////////////////////////////////////////////////////////////////////
+/// Send a message with a code and an object already streamed into objBuf.
+/// Smaller objects are sent from objBuf right after the code and the size,
+/// without being copied.
+/// Objects larger than 1 MB, like big histograms or the results of
+/// TProcessExecutor::MapReduce, are written into a shared memory segment (a file
+/// in /dev/shm when available) which is mapped by the receiver, and only the name
+/// of the segment goes through the socket. MPRecv() handles both transports.
+/// The receiver removes the segment once it is mapped, MPRemoveShmSegments()
+/// the ones that were never received.
+/// \param s a pointer to a valid TSocket. No validity checks are performed\n
+/// \param code the code to be sent
+/// \param objBuf the streamed object, possibly empty
+/// \return the number of bytes sent, as per TSocket::SendRaw
+int MPSendObjBuf(TSocket *s, unsigned code, const TBufferFile &objBuf)
+{
+   ULong_t len = objBuf.Length();
+   std::string shmPath;
+   if (len >= kShmThreshold)
+      shmPath = WriteShmSegment(objBuf.Buffer(), len);
+
+   TBufferFile wBuf(TBuffer::kWrite);
+   wBuf.WriteUInt(code);
+   if (!shmPath.empty()) {
+      wBuf.WriteULong(kShmFlag | shmPath.length());
+      wBuf.WriteFastArray(shmPath.c_str(), shmPath.length());
+      return s->SendRaw(wBuf.Buffer(), wBuf.Length());
+   }
+   wBuf.WriteULong(len);
+   int nBytes = s->SendRaw(wBuf.Buffer(), wBuf.Length());
+   if (nBytes <= 0 || len == 0)
+      return nBytes;
+   int nObjBytes = s->SendRaw(objBuf.Buffer(), len);
+   return nObjBytes < 0 ? nObjBytes : nBytes + nObjBytes;
+}
+
+
+//////////////////////////////////////////////////////////////////////////
+/// Remove the shared memory segments written by this process that are still
+/// there, i.e. whose message was never received. Called by the workers before
+/// they exit and by the client once its workers are gone.
+void MPRemoveShmSegments()
+{
+   const Int_t pid = gSystem->GetPid();
+   std::lock_guard<std::mutex> lock(gShmSegmentsMutex);
+   for (const auto &segment : GetShmSegments())
+      if (segment.first == pid)
+         unlink(segment.second.c_str());
+   GetShmSegments().clear();
+}
+
+
 //////////////////////////////////////////////////////////////////////////
 /// Receive message from a socket.
 /// This standalone function can be used to read a message that
@@ -76,7 +227,16 @@ MPCodeBufPair MPRecv(TSocket *s)
 
    //receive object if needed
    std::unique_ptr<TBufferFile> objBuf; //defaults to nullptr
-   if (classBufSize != 0) {
+   if (classBufSize & kShmFlag) {
+      //object in a shared memory segment, the message contains its name
+      std::string shmPath(classBufSize & ~kShmFlag, '\0');
+      s->RecvRaw(&shmPath[0], shmPath.length());
+      objBuf = ReadShmSegment(shmPath);
+      if (!objBuf) {
+         Error("MPRecv", "[E] Could not read the shared memory segment %s\n", shmPath.c_str());
+         return std::make_pair(MPCode::kRecvError, nullptr);
+      }
+   } else if (classBufSize != 0) {
       char *classBuf = new char[classBufSize];
       s->RecvRaw(classBuf, classBufSize);
       objBuf.reset(new TBufferFile(TBuffer::kRead, classBufSize, classBuf, true)); //the buffer is deleted by TBuffer's dtor
@@ -316,6 +316,8 @@ void TMPClient::ReapWorkers()
       waitpid(pid, nullptr, 0);
    }
    fWorkerPids.clear();
+   // the workers cannot read the objects sent to them anymore
+   MPRemoveShmSegments();
 }
 
 
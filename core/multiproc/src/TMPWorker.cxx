@@ -64,6 +64,7 @@ void TMPWorker::Run()
       MPCodeBufPair msg = MPRecv(fS.get());
       if (msg.first == MPCode::kRecvError) {
          Error("TMPWorker::Run", "Lost connection to client\n");
+         MPRemoveShmSegments();
          gSystem->Exit(0);
       }
 
@@ -99,6 +100,8 @@ void TMPWorker::HandleInput(MPCodeBufPair &msg)
    } else if (code == MPCode::kShutdownOrder || code == MPCode::kFatalError) {
       //client is asking the server to shutdown or client is dying
       MPSend(fS.get(), MPCode::kShutdownNotice, reply.c_str());
+      // the client read all the results it asked for before the shutdown order
+      MPRemoveShmSegments();
       gSystem->Exit(0);
    } else {
       reply += ": unknown code received. code=" + std::to_string(code);
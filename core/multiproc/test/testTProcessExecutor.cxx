@@ -0,0 +1,68 @@
+#include "ROOT/TProcessExecutor.hxx"
+#include "ROOT/TSeq.hxx"
+#include "TSystem.h"
+
+#include "gtest/gtest.h"
+
+#include <algorithm>
+#include <string>
+#include <vector>
+
+namespace {
+
+// The number of shared memory segments of the multiproc messages that are left in the shared memory directory
+int CountShmSegments()
+{
+   const char *dirName = gSystem->AccessPathName("/dev/shm") ? gSystem->TempDirectory() : "/dev/shm";
+   void *dir = gSystem->OpenDirectory(dirName);
+   if (!dir)
+      return 0;
+   int n = 0;
+   while (const char *entry = gSystem->GetDirEntry(dir))
+      if (std::string(entry).compare(0, 8, "root_mp_") == 0)
+         ++n;
+   gSystem->FreeDirectory(dir);
+   return n;
+}
+
+} // namespace
+
+// Results larger than 1 MB go through shared memory instead of the socket, the smaller ones are sent directly
+TEST(TProcessExecutor, LargeResults)
+{
+   const int nSegments = CountShmSegments();
+   ROOT::TProcessExecutor pool(3);
+
+   constexpr std::size_t size = 500000; // 4 MB of doubles
+   auto makeVector = [](unsigned i) { return std::vector<double>(size, 1. * i); };
+   auto results = pool.Map(makeVector, ROOT::TSeq<unsigned>(6));
+   ASSERT_EQ(6u, results.size());
+   std::vector<double> values;
+   for (const auto &r : results) {
+      ASSERT_EQ(size, r.size());
+      values.push_back(r.front());
+      EXPECT_EQ(r.front(), r.back());
+   }
+   std::sort(values.begin(), values.end());
+   EXPECT_EQ(std::vector<double>({0., 1., 2., 3., 4., 5.}), values);
+
+   auto add = [](const std::vector<std::vector<double>> &vs) {
+      std::vector<double> res(vs.empty() ? 0 : vs.front().size(), 0.);
+      for (const auto &v : vs)
+         for (std::size_t i = 0; i < v.size(); ++i)
+            res[i] += v[i];
+      return res;
+   };
+   auto reduced = pool.MapReduce(makeVector, ROOT::TSeq<unsigned>(6), add);
+   ASSERT_EQ(size, reduced.size());
+   EXPECT_EQ(15., reduced.front());
+   EXPECT_EQ(15., reduced.back());
+
+   auto small = pool.Map([](unsigned i) { return std::vector<double>(10, 1. * i); }, ROOT::TSeq<unsigned>(4));
+   ASSERT_EQ(4u, small.size());
+   for (const auto &r : small)
+      EXPECT_EQ(10u, r.size());
+
+   // the segments are removed once received
+   EXPECT_EQ(nSegments, CountShmSegments());
+}
@@ -20,6 +20,7 @@
 
 
 #include <algorithm>
+#include <cstdint>
 #include <exception>
 #include <deque>
 #include <functional>
@@ -110,6 +111,20 @@ namespace ROOT {
             static TDirectory *Create() { return nullptr; }
          };
 
+         /// Return a number identifying a new TThreadedObject, never zero
+         std::uint64_t GetNewObjectId();
+
+         /// The slot numbers of the calling thread in the last TThreadedObjects it used, by object id
+         struct RSlotCache {
+            static constexpr unsigned kSize = 8;
+            std::uint64_t fIds[kSize] = {};
+            unsigned fSlots[kSize] = {};
+            unsigned fNext = 0; ///< The entry to replace next
+         };
+
+         /// Return the slot cache of the calling thread
+         RSlotCache &GetSlotCache();
+
       } // End of namespace TThreadedObjectUtils
    } // End of namespace Internal
 
@@ -146,6 +161,12 @@ namespace ROOT {
     * In case an elaborate thread management is in place, e.g. in presence of
     * stream of operations or "processing slots", it is also possible to
     * manually select the correct object pointer explicitly.
+    *
+    * Long-running applications can bound the memory taken by the thread private
+    * objects: MergeThisSlot() folds the object of the calling thread into an
+    * accumulated result and releases it, and SetAutoMerge() makes the threads do
+    * so every given number of calls to Get(). Merge() and SnapshotMerge() include
+    * the accumulated result.
     */
    template<class T>
    class TThreadedObject {
@@ -163,10 +184,12 @@ namespace ROOT {
       /// This form of the constructor is useful to manually pre-set the content of a given number of slots
       /// when used in combination with TThreadedObject::SetAtSlot().
       template <class... ARGS>
-      TThreadedObject(TNumSlots initSlots, ARGS &&... args) : fIsMerged(false)
+      TThreadedObject(TNumSlots initSlots, ARGS &&... args)
+         : fId(Internal::TThreadedObjectUtils::GetNewObjectId()), fIsMerged(false)
       {
          const auto nSlots = initSlots.fVal;
          fObjPointers.resize(nSlots);
+         fNGets.resize(nSlots, 0u);
 
          // create at least one directory (we need it for fModel), plus others as needed by the size of fObjPointers
          fDirectories.emplace_back(Internal::TThreadedObjectUtils::DirCreator<T>::Create());
@@ -278,7 +301,13 @@ namespace ROOT {
       /// ~~~
       std::shared_ptr<T> Get()
       {
-         return GetAtSlot(GetThisSlotNumber());
+         const auto slot = GetThisSlotNumber();
+         // the object must not be used elsewhere to be merged, e.g. by copies of the pointer still on the stack
+         if (fAutoMergeInterval > 0 && ++fNGets[slot] >= fAutoMergeInterval && fObjPointers[slot].use_count() == 1) {
+            fNGets[slot] = 0;
+            MergeSlot(slot, fAutoMergeFunction);
+         }
+         return GetAtSlot(slot);
       }
 
       /// Access the wrapped object and allow to call its methods.
@@ -287,6 +316,43 @@ namespace ROOT {
          return Get().get();
       }
 
+      /// Merge the object of slot i into the accumulated result and release it: the slot gets a new copy of the
+      /// model when it is accessed again.
+      /// This method is thread-safe as long as no other thread accesses slot `i`. The object must not be used after
+      /// it was merged, i.e. the pointers previously returned for slot `i` must have been discarded.
+      void MergeSlot(unsigned i, TThreadedObjectUtils::MergeFunctionType<T> mergeFunction = TThreadedObjectUtils::MergeTObjects<T>)
+      {
+         auto &objPointer = fObjPointers[i];
+         if (!objPointer)
+            return;
+         std::lock_guard<std::mutex> lg(fAccumulatedMutex);
+         if (!fAccumulated) {
+            // the first object merged becomes the accumulated result
+            fAccumulated = std::move(objPointer);
+            return;
+         }
+         std::vector<std::shared_ptr<T>> objs{objPointer};
+         mergeFunction(fAccumulated, objs);
+         objPointer.reset();
+      }
+
+      /// Merge the object of the calling thread into the accumulated result and release it, see MergeSlot.
+      void MergeThisSlot(TThreadedObjectUtils::MergeFunctionType<T> mergeFunction = TThreadedObjectUtils::MergeTObjects<T>)
+      {
+         MergeSlot(GetThisSlotNumber(), mergeFunction);
+      }
+
+      /// Make each thread merge its object into the accumulated result every nGets calls to Get() or to the arrow
+      /// operator, see MergeSlot: the thread private objects are then released regularly, which bounds their memory
+      /// if they grow as they are filled. The object is only merged if the thread holds no other pointer to it,
+      /// e.g. one returned by the previous call to Get(). 0, the default, disables the automatic merging.
+      /// Must not be called concurrently to the other TThreadedObject methods.
+      void SetAutoMerge(unsigned nGets, TThreadedObjectUtils::MergeFunctionType<T> mergeFunction = TThreadedObjectUtils::MergeTObjects<T>)
+      {
+         fAutoMergeInterval = nGets;
+         fAutoMergeFunction = mergeFunction;
+      }
+
       /// Merge all the thread private objects. Can be called once: it does not
       /// create any new object but destroys the present bookkeping collapsing
       /// all objects into the one at slot 0.
@@ -299,6 +365,12 @@ namespace ROOT {
          }
          // need to convert to std::vector because historically mergeFunction requires a vector
          auto vecOfObjPtrs = std::vector<std::shared_ptr<T>>(fObjPointers.begin(), fObjPointers.end());
+         if (fAccumulated) {
+            // slot 0 might have been released by MergeSlot
+            if (!fObjPointers[0])
+               fObjPointers[0] = fAccumulated;
+            vecOfObjPtrs.emplace_back(std::move(fAccumulated));
+         }
          mergeFunction(fObjPointers[0], vecOfObjPtrs);
          fIsMerged = true;
          return fObjPointers[0];
@@ -318,6 +390,11 @@ namespace ROOT {
          std::shared_ptr<T> targetPtrShared(targetPtr, [](T *) {});
          // need to convert to std::vector because historically mergeFunction requires a vector
          auto vecOfObjPtrs = std::vector<std::shared_ptr<T>>(fObjPointers.begin(), fObjPointers.end());
+         {
+            std::lock_guard<std::mutex> lg(fAccumulatedMutex);
+            if (fAccumulated)
+               vecOfObjPtrs.emplace_back(fAccumulated);
+         }
          mergeFunction(targetPtrShared, vecOfObjPtrs);
          return std::unique_ptr<T>(targetPtr);
       }
@@ -331,24 +408,46 @@ namespace ROOT {
       std::deque<TDirectory*> fDirectories;              ///< A TDirectory per slot
       std::map<std::thread::id, unsigned> fThrIDSlotMap; ///< A mapping between the thread IDs and the slots
       mutable ROOT::TSpinMutex fSpinMutex;               ///< Protects concurrent access to fThrIDSlotMap, fObjPointers
+      const std::uint64_t fId;                           ///< Identifies this object in the thread-local slot caches
+      std::deque<unsigned> fNGets;                       ///< Calls to Get() per slot since its last automatic merge
+      unsigned fAutoMergeInterval = 0;                   ///< See SetAutoMerge
+      TThreadedObjectUtils::MergeFunctionType<T> fAutoMergeFunction;
+      std::shared_ptr<T> fAccumulated;                   ///< The objects merged by MergeSlot, if any
+      std::mutex fAccumulatedMutex;                      ///< Protects fAccumulated
       bool fIsMerged : 1;                                ///< Remember if the objects have been merged already
 
       /// Get the slot number for this threadID, make a slot if needed
       unsigned GetThisSlotNumber()
       {
+         // most lookups are served by the cache of the thread, without locking
+         auto &cache = Internal::TThreadedObjectUtils::GetSlotCache();
+         for (auto i = 0u; i < cache.kSize; ++i) {
+            if (cache.fIds[i] == fId)
+               return cache.fSlots[i];
+         }
+
          const auto thisThreadID = std::this_thread::get_id();
-         std::lock_guard<ROOT::TSpinMutex> lg(fSpinMutex);
-         const auto thisSlotNumIt = fThrIDSlotMap.find(thisThreadID);
-         if (thisSlotNumIt != fThrIDSlotMap.end())
-            return thisSlotNumIt->second;
-         const auto newIndex = fThrIDSlotMap.size();
-         fThrIDSlotMap[thisThreadID] = newIndex;
-         R__ASSERT(newIndex <= fObjPointers.size() && "This should never happen, we should create new slots as needed");
-         if (newIndex == fObjPointers.size()) {
-            fDirectories.emplace_back(Internal::TThreadedObjectUtils::DirCreator<T>::Create());
-            fObjPointers.emplace_back(nullptr);
+         unsigned slot;
+         {
+            std::lock_guard<ROOT::TSpinMutex> lg(fSpinMutex);
+            const auto thisSlotNumIt = fThrIDSlotMap.find(thisThreadID);
+            if (thisSlotNumIt != fThrIDSlotMap.end()) {
+               slot = thisSlotNumIt->second;
+            } else {
+               slot = fThrIDSlotMap.size();
+               fThrIDSlotMap[thisThreadID] = slot;
+               R__ASSERT(slot <= fObjPointers.size() && "This should never happen, we should create new slots as needed");
+               if (slot == fObjPointers.size()) {
+                  fDirectories.emplace_back(Internal::TThreadedObjectUtils::DirCreator<T>::Create());
+                  fObjPointers.emplace_back(nullptr);
+                  fNGets.emplace_back(0u);
+               }
+            }
          }
-         return newIndex;
+         cache.fIds[cache.fNext] = fId;
+         cache.fSlots[cache.fNext] = slot;
+         cache.fNext = (cache.fNext + 1) % cache.kSize;
+         return slot;
       }
    };
 
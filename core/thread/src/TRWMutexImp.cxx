@@ -27,8 +27,8 @@ namespace ROOT {
 ////////////////////////////////////////////////////////////////////////////////
 /// Take the Read Lock of the mutex.
 
-template <typename MutexT, typename RecurseCountsT>
-TVirtualRWMutex::Hint_t *TRWMutexImp<MutexT, RecurseCountsT>::ReadLock()
+template <typename MutexT, typename RecurseCountsT, unsigned NReaderStripes>
+TVirtualRWMutex::Hint_t *TRWMutexImp<MutexT, RecurseCountsT, NReaderStripes>::ReadLock()
 {
    return fMutexImp.ReadLock();
 }
@@ -36,8 +36,8 @@ TVirtualRWMutex::Hint_t *TRWMutexImp<MutexT, RecurseCountsT>::ReadLock()
 ////////////////////////////////////////////////////////////////////////////////
 /// Take the Write Lock of the mutex.
 
-template <typename MutexT, typename RecurseCountsT>
-TVirtualRWMutex::Hint_t *TRWMutexImp<MutexT, RecurseCountsT>::WriteLock()
+template <typename MutexT, typename RecurseCountsT, unsigned NReaderStripes>
+TVirtualRWMutex::Hint_t *TRWMutexImp<MutexT, RecurseCountsT, NReaderStripes>::WriteLock()
 {
    return fMutexImp.WriteLock();
 }
@@ -45,8 +45,8 @@ TVirtualRWMutex::Hint_t *TRWMutexImp<MutexT, RecurseCountsT>::WriteLock()
 ////////////////////////////////////////////////////////////////////////////////
 /// Release the read lock of the mutex
 
-template <typename MutexT, typename RecurseCountsT>
-void TRWMutexImp<MutexT, RecurseCountsT>::ReadUnLock(TVirtualRWMutex::Hint_t *hint)
+template <typename MutexT, typename RecurseCountsT, unsigned NReaderStripes>
+void TRWMutexImp<MutexT, RecurseCountsT, NReaderStripes>::ReadUnLock(TVirtualRWMutex::Hint_t *hint)
 {
    fMutexImp.ReadUnLock(hint);
 }
@@ -54,8 +54,8 @@ void TRWMutexImp<MutexT, RecurseCountsT>::ReadUnLock(TVirtualRWMutex::Hint_t *hi
 ////////////////////////////////////////////////////////////////////////////////
 /// Release the read lock of the mutex
 
-template <typename MutexT, typename RecurseCountsT>
-void TRWMutexImp<MutexT, RecurseCountsT>::WriteUnLock(TVirtualRWMutex::Hint_t *hint)
+template <typename MutexT, typename RecurseCountsT, unsigned NReaderStripes>
+void TRWMutexImp<MutexT, RecurseCountsT, NReaderStripes>::WriteUnLock(TVirtualRWMutex::Hint_t *hint)
 {
    fMutexImp.WriteUnLock(hint);
 }
@@ -63,8 +63,8 @@ void TRWMutexImp<MutexT, RecurseCountsT>::WriteUnLock(TVirtualRWMutex::Hint_t *h
 ////////////////////////////////////////////////////////////////////////////////
 /// Create mutex and return pointer to it.
 
-template <typename MutexT, typename RecurseCountsT>
-TVirtualRWMutex *TRWMutexImp<MutexT, RecurseCountsT>::Factory(Bool_t /*recursive = kFALSE*/)
+template <typename MutexT, typename RecurseCountsT, unsigned NReaderStripes>
+TVirtualRWMutex *TRWMutexImp<MutexT, RecurseCountsT, NReaderStripes>::Factory(Bool_t /*recursive = kFALSE*/)
 {
    return new TRWMutexImp();
 }
@@ -79,9 +79,9 @@ TVirtualRWMutex *TRWMutexImp<MutexT, RecurseCountsT>::Factory(Bool_t /*recursive
 ///     current_lock_count -= delta;
 ///     return delta;
 
-template <typename MutexT, typename RecurseCountsT>
+template <typename MutexT, typename RecurseCountsT, unsigned NReaderStripes>
 std::unique_ptr<TVirtualRWMutex::StateDelta>
-TRWMutexImp<MutexT, RecurseCountsT>::Rewind(const TVirtualRWMutex::State &earlierState)
+TRWMutexImp<MutexT, RecurseCountsT, NReaderStripes>::Rewind(const TVirtualRWMutex::State &earlierState)
 {
    return fMutexImp.Rewind(earlierState);
 }
@@ -91,8 +91,8 @@ TRWMutexImp<MutexT, RecurseCountsT>::Rewind(const TVirtualRWMutex::State &earlie
 /// In pseudo-code:
 ///     current_lock_count += delta;
 
-template <typename MutexT, typename RecurseCountsT>
-void TRWMutexImp<MutexT, RecurseCountsT>::Apply(std::unique_ptr<TVirtualRWMutex::StateDelta> &&delta)
+template <typename MutexT, typename RecurseCountsT, unsigned NReaderStripes>
+void TRWMutexImp<MutexT, RecurseCountsT, NReaderStripes>::Apply(std::unique_ptr<TVirtualRWMutex::StateDelta> &&delta)
 {
    fMutexImp.Apply(std::move(delta));
 }
@@ -101,9 +101,9 @@ void TRWMutexImp<MutexT, RecurseCountsT>::Apply(std::unique_ptr<TVirtualRWMutex:
 /// Get the mutex state *before* the current lock was taken. This function must
 /// only be called while the mutex is locked.
 
-template <typename MutexT, typename RecurseCountsT>
+template <typename MutexT, typename RecurseCountsT, unsigned NReaderStripes>
 std::unique_ptr<TVirtualRWMutex::State>
-TRWMutexImp<MutexT, RecurseCountsT>::GetStateBefore()
+TRWMutexImp<MutexT, RecurseCountsT, NReaderStripes>::GetStateBefore()
 {
    return fMutexImp.GetStateBefore();
 }
@@ -111,12 +111,14 @@ TRWMutexImp<MutexT, RecurseCountsT>::GetStateBefore()
 template class TRWMutexImp<TMutex>;
 template class TRWMutexImp<ROOT::TSpinMutex>;
 template class TRWMutexImp<std::mutex>;
+template class TRWMutexImp<std::mutex, ROOT::Internal::RecurseCounts, ROOT::Internal::kCoreMutexReaderStripes>;
 template class TRWMutexImp<TMutex, ROOT::Internal::UniqueLockRecurseCount>;
 template class TRWMutexImp<ROOT::TSpinMutex, ROOT::Internal::UniqueLockRecurseCount>;
 
 #ifdef R__HAS_TBB
 template class TRWMutexImp<std::mutex, ROOT::Internal::RecurseCountsTBB>;
 template class TRWMutexImp<std::mutex, ROOT::Internal::RecurseCountsTBBUnique>;
+template class TRWMutexImp<std::mutex, ROOT::Internal::RecurseCountsTBBUnique, ROOT::Internal::kCoreMutexReaderStripes>;
 #endif
 
 } // End of namespace ROOT
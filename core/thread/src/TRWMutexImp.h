@@ -18,9 +18,9 @@
 #include "TBuffer.h" // Needed by ClassDefInlineOverride
 
 namespace ROOT {
-template <typename MutexT, typename RecurseCountsT = ROOT::Internal::RecurseCounts>
+template <typename MutexT, typename RecurseCountsT = ROOT::Internal::RecurseCounts, unsigned NReaderStripes = 1>
 class TRWMutexImp : public TVirtualRWMutex {
-   ROOT::TReentrantRWLock<MutexT, RecurseCountsT> fMutexImp;
+   ROOT::TReentrantRWLock<MutexT, RecurseCountsT, NReaderStripes> fMutexImp;
 
 public:
    Hint_t * ReadLock() override;
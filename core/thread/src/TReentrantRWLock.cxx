@@ -66,10 +66,10 @@ Internal::UniqueLockRecurseCount::UniqueLockRecurseCount()
 
 ////////////////////////////////////////////////////////////////////////////
 /// Acquire the lock in read mode.
-template <typename MutexT, typename RecurseCountsT>
-TVirtualRWMutex::Hint_t *TReentrantRWLock<MutexT, RecurseCountsT>::ReadLock()
+template <typename MutexT, typename RecurseCountsT, unsigned NReaderStripes>
+TVirtualRWMutex::Hint_t *TReentrantRWLock<MutexT, RecurseCountsT, NReaderStripes>::ReadLock()
 {
-   ++fReaderReservation;
+   fReaderReservation.Add(1);
 
    // if (fReaders == std::numeric_limits<decltype(fReaders)>::max()) {
    //    ::Fatal("TRWSpinLock::WriteLock", "Too many recursions in TRWSpinLock!");
@@ -81,25 +81,25 @@ TVirtualRWMutex::Hint_t *TReentrantRWLock<MutexT, RecurseCountsT>::ReadLock()
 
    if (!fWriter) {
       // There is no writer, go freely to the critical section
-      ++fReaders;
-      --fReaderReservation;
+      fReaders.Add(1);
+      fReaderReservation.Add(-1);
 
       hint = fRecurseCounts.IncrementReadCount(local, fMutex);
 
    } else if (fRecurseCounts.IsCurrentWriter(local)) {
 
-      --fReaderReservation;
+      fReaderReservation.Add(-1);
       // This can run concurrently with another thread trying to get
       // the read lock and ending up in the next section ("Wait for writers, if any")
       // which need to also get the local readers count and thus can
       // modify the map.
       hint = fRecurseCounts.IncrementReadCount(local, fMutex);
-      ++fReaders;
+      fReaders.Add(1);
 
    } else {
       // A writer claimed the RW lock, we will need to wait on the
       // internal lock
-      --fReaderReservation;
+      fReaderReservation.Add(-1);
 
       std::unique_lock<MutexT> lock(fMutex);
 
@@ -123,7 +123,7 @@ TVirtualRWMutex::Hint_t *TReentrantRWLock<MutexT, RecurseCountsT>::ReadLock()
       hint = fRecurseCounts.IncrementReadCount(local);
 
       // This RW lock now belongs to the readers
-      ++fReaders;
+      fReaders.Add(1);
 
       lock.unlock();
    }
@@ -133,8 +133,8 @@ TVirtualRWMutex::Hint_t *TReentrantRWLock<MutexT, RecurseCountsT>::ReadLock()
 
 //////////////////////////////////////////////////////////////////////////
 /// Release the lock in read mode.
-template <typename MutexT, typename RecurseCountsT>
-void TReentrantRWLock<MutexT, RecurseCountsT>::ReadUnLock(TVirtualRWMutex::Hint_t *hint)
+template <typename MutexT, typename RecurseCountsT, unsigned NReaderStripes>
+void TReentrantRWLock<MutexT, RecurseCountsT, NReaderStripes>::ReadUnLock(TVirtualRWMutex::Hint_t *hint)
 {
    size_t *localReaderCount;
    if (!hint) {
@@ -146,8 +146,8 @@ void TReentrantRWLock<MutexT, RecurseCountsT>::ReadUnLock(TVirtualRWMutex::Hint_
       localReaderCount = reinterpret_cast<size_t*>(hint);
    }
 
-   --fReaders;
-   if (fWriterReservation && fReaders == 0) {
+   fReaders.Add(-1);
+   if (fWriterReservation && fReaders.Load() == 0) {
       // We still need to lock here to prevent interleaving with a writer
       std::lock_guard<MutexT> lock(fMutex);
 
@@ -165,8 +165,8 @@ void TReentrantRWLock<MutexT, RecurseCountsT>::ReadUnLock(TVirtualRWMutex::Hint_
 
 //////////////////////////////////////////////////////////////////////////
 /// Acquire the lock in write mode.
-template <typename MutexT, typename RecurseCountsT>
-TVirtualRWMutex::Hint_t *TReentrantRWLock<MutexT, RecurseCountsT>::WriteLock()
+template <typename MutexT, typename RecurseCountsT, unsigned NReaderStripes>
+TVirtualRWMutex::Hint_t *TReentrantRWLock<MutexT, RecurseCountsT, NReaderStripes>::WriteLock()
 {
    ++fWriterReservation;
 
@@ -178,11 +178,11 @@ TVirtualRWMutex::Hint_t *TReentrantRWLock<MutexT, RecurseCountsT>::WriteLock()
    auto &readerCount = fRecurseCounts.GetLocalReadersCount(local);
    TVirtualRWMutex::Hint_t *hint = reinterpret_cast<TVirtualRWMutex::Hint_t *>(&readerCount);
 
-   fReaders -= readerCount;
+   fReaders.Add(-static_cast<int>(readerCount));
 
    // Wait for other writers, if any
    if (fWriter && fRecurseCounts.IsNotCurrentWriter(local)) {
-      if (readerCount && fReaders == 0) {
+      if (readerCount && fReaders.Load() == 0) {
          // we decrease fReaders to zero, let's wake up the
          // other writer.
          fCond.notify_all();
@@ -195,14 +195,14 @@ TVirtualRWMutex::Hint_t *TReentrantRWLock<MutexT, RecurseCountsT>::WriteLock()
    fRecurseCounts.SetIsWriter(local);
 
    // Wait until all reader reservations finish
-   while (fReaderReservation) {
+   while (fReaderReservation.Load()) {
    };
 
    // Wait for remaining readers
-   fCond.wait(lock, [this] { return fReaders == 0; });
+   fCond.wait(lock, [this] { return fReaders.Load() == 0; });
 
    // Restore this thread's reader lock(s)
-   fReaders += readerCount;
+   fReaders.Add(static_cast<int>(readerCount));
 
    --fWriterReservation;
 
@@ -213,8 +213,8 @@ TVirtualRWMutex::Hint_t *TReentrantRWLock<MutexT, RecurseCountsT>::WriteLock()
 
 //////////////////////////////////////////////////////////////////////////
 /// Release the lock in write mode.
-template <typename MutexT, typename RecurseCountsT>
-void TReentrantRWLock<MutexT, RecurseCountsT>::WriteUnLock(TVirtualRWMutex::Hint_t *)
+template <typename MutexT, typename RecurseCountsT, unsigned NReaderStripes>
+void TReentrantRWLock<MutexT, RecurseCountsT, NReaderStripes>::WriteUnLock(TVirtualRWMutex::Hint_t *)
 {
    // We need to lock here to prevent interleaving with a reader
    std::lock_guard<MutexT> lock(fMutex);
@@ -255,9 +255,9 @@ struct TReentrantRWLockStateDelta: public TVirtualRWMutex::StateDelta {
 //////////////////////////////////////////////////////////////////////////
 /// Get the lock state before the most recent write lock was taken.
 
-template <typename MutexT, typename RecurseCountsT>
+template <typename MutexT, typename RecurseCountsT, unsigned NReaderStripes>
 std::unique_ptr<TVirtualRWMutex::State>
-TReentrantRWLock<MutexT, RecurseCountsT>::GetStateBefore()
+TReentrantRWLock<MutexT, RecurseCountsT, NReaderStripes>::GetStateBefore()
 {
    using State_t = TReentrantRWLockState<MutexT, RecurseCountsT>;
 
@@ -295,9 +295,9 @@ TReentrantRWLock<MutexT, RecurseCountsT>::GetStateBefore()
 //////////////////////////////////////////////////////////////////////////
 /// Rewind to an earlier mutex state, returning the delta.
 
-template <typename MutexT, typename RecurseCountsT>
+template <typename MutexT, typename RecurseCountsT, unsigned NReaderStripes>
 std::unique_ptr<TVirtualRWMutex::StateDelta>
-TReentrantRWLock<MutexT, RecurseCountsT>::Rewind(const State &earlierState) {
+TReentrantRWLock<MutexT, RecurseCountsT, NReaderStripes>::Rewind(const State &earlierState) {
    using State_t = TReentrantRWLockState<MutexT, RecurseCountsT>;
    using StateDelta_t = TReentrantRWLockStateDelta<MutexT, RecurseCountsT>;
    auto& typedState = static_cast<const State_t&>(earlierState);
@@ -342,7 +342,7 @@ TReentrantRWLock<MutexT, RecurseCountsT>::Rewind(const State &earlierState) {
       // the snapshot and the rewind ... humm unless the lock held is a WriteLock
       // (the actual use case) in which case there is no other thread that can update fReaders
       // and we also assume that the "user code" is balanced and release all read locks it takes.
-      fReaders = typedState.fReadersCount + 1;
+      fReaders.Add(typedState.fReadersCount + 1 - fReaders.Load());
       // Release this thread's reader lock(s)
       ReadUnLock(hint);
    }
@@ -354,8 +354,8 @@ TReentrantRWLock<MutexT, RecurseCountsT>::Rewind(const State &earlierState) {
 //////////////////////////////////////////////////////////////////////////
 /// Re-apply a delta.
 
-template <typename MutexT, typename RecurseCountsT>
-void TReentrantRWLock<MutexT, RecurseCountsT>::Apply(std::unique_ptr<StateDelta> &&state) {
+template <typename MutexT, typename RecurseCountsT, unsigned NReaderStripes>
+void TReentrantRWLock<MutexT, RecurseCountsT, NReaderStripes>::Apply(std::unique_ptr<StateDelta> &&state) {
    if (!state) {
       Error("TReentrantRWLock::Apply", "Cannot apply empty delta!");
       return;
@@ -381,7 +381,7 @@ void TReentrantRWLock<MutexT, RecurseCountsT>::Apply(std::unique_ptr<StateDelta>
    if (typedDelta->fDeltaReadersCount != 0) {
       ReadLock();
       // "- 1" due to ReadLock() above.
-      fReaders += typedDelta->fDeltaReadersCount - 1;
+      fReaders.Add(typedDelta->fDeltaReadersCount - 1);
       *typedDelta->fReadersCountLoc += typedDelta->fDeltaReadersCount - 1;
    }
 }
@@ -390,8 +390,8 @@ void TReentrantRWLock<MutexT, RecurseCountsT>::Apply(std::unique_ptr<StateDelta>
 /// Assert that presumedLocalReadersCount really matches the local read count.
 /// Print an error message if not.
 
-template <typename MutexT, typename RecurseCountsT>
-void TReentrantRWLock<MutexT, RecurseCountsT>::AssertReadCountLocIsFromCurrentThread(const size_t* presumedLocalReadersCount)
+template <typename MutexT, typename RecurseCountsT, unsigned NReaderStripes>
+void TReentrantRWLock<MutexT, RecurseCountsT, NReaderStripes>::AssertReadCountLocIsFromCurrentThread(const size_t* presumedLocalReadersCount)
 {
    auto local = fRecurseCounts.GetLocal();
    size_t* localReadersCount;
@@ -414,8 +414,12 @@ template class TReentrantRWLock<ROOT::TSpinMutex, ROOT::Internal::UniqueLockRecu
 template class TReentrantRWLock<TMutex, ROOT::Internal::UniqueLockRecurseCount>;
 template class TReentrantRWLock<std::mutex, ROOT::Internal::UniqueLockRecurseCount>;
 
+template class TReentrantRWLock<std::mutex, ROOT::Internal::RecurseCounts, ROOT::Internal::kCoreMutexReaderStripes>;
+
 #ifdef R__HAS_TBB
 template class TReentrantRWLock<std::mutex, ROOT::Internal::RecurseCountsTBB>;
 template class TReentrantRWLock<std::mutex, ROOT::Internal::RecurseCountsTBBUnique>;
+template class TReentrantRWLock<std::mutex, ROOT::Internal::RecurseCountsTBBUnique,
+                                ROOT::Internal::kCoreMutexReaderStripes>;
 #endif
 }
@@ -18,7 +18,9 @@
 #include "TVirtualRWMutex.h"
 
 #include <atomic>
+#include <cstdint>
 #include <condition_variable>
+#include <functional>
 #include <thread>
 #include <unordered_map>
 
@@ -28,6 +30,43 @@
 
 namespace ROOT {
 namespace Internal {
+
+/// An atomic counter split in NStripes stripes, each on its own cache line. The threads update the stripe selected
+/// by their thread id, so that concurrent updates do not bounce a cache line between all cores; reading the value,
+/// which sums the stripes, is then NStripes times more expensive.
+/// The stripe is not selected with a thread_local variable, whose lookup can deadlock within shared library openings
+/// (see TThread::Init). With a single stripe, the counter is a plain atomic.
+template <unsigned NStripes>
+class RStripedCount {
+   struct RStripe {
+      std::atomic<int> fCount{0};
+      char fPadding[64 - sizeof(std::atomic<int>)];
+   };
+   RStripe fStripes[NStripes];
+
+   static unsigned GetThisThreadStripe()
+   {
+      if (NStripes == 1)
+         return 0;
+      // thread ids are often addresses: mix the bits before selecting the stripe
+      const auto h = static_cast<std::uint64_t>(std::hash<std::thread::id>()(std::this_thread::get_id()));
+      return static_cast<unsigned>((h * 0x9E3779B97F4A7C15ull) >> 32) % NStripes;
+   }
+
+public:
+   void Add(int n) { fStripes[GetThisThreadStripe()].fCount += n; }
+   int Load() const
+   {
+      int sum = 0;
+      for (const auto &stripe : fStripes)
+         sum += stripe.fCount;
+      return sum;
+   }
+};
+
+/// Number of reader stripes of gCoreMutex, which is read locked by all the threads on the interpreter and I/O paths
+constexpr unsigned kCoreMutexReaderStripes = 64;
+
 struct UniqueLockRecurseCount {
    using Hint_t = TVirtualRWMutex::Hint_t;
 
@@ -275,12 +314,15 @@ struct RecurseCountsTBBUnique {
 
 } // Internal
 
-template <typename MutexT = ROOT::TSpinMutex, typename RecurseCountsT = Internal::RecurseCounts>
+/// NReaderStripes > 1 spreads the counts of readers over as many cache lines, see Internal::RStripedCount: the read
+/// locks then scale with the number of threads, at the price of slower write locks.
+template <typename MutexT = ROOT::TSpinMutex, typename RecurseCountsT = Internal::RecurseCounts,
+          unsigned NReaderStripes = 1>
 class TReentrantRWLock {
 private:
 
-   std::atomic<int> fReaders;           ///<! Number of readers
-   std::atomic<int> fReaderReservation; ///<! A reader wants access
+   Internal::RStripedCount<NReaderStripes> fReaders;           ///<! Number of readers
+   Internal::RStripedCount<NReaderStripes> fReaderReservation; ///<! A reader wants access
    std::atomic<int> fWriterReservation; ///<! A writer wants access
    std::atomic<bool> fWriter;           ///<! Is there a writer?
    MutexT fMutex;                       ///<! RWlock internal mutex
@@ -301,7 +343,7 @@ public:
 
    ////////////////////////////////////////////////////////////////////////
    /// Regular constructor.
-   TReentrantRWLock() : fReaders(0), fReaderReservation(0), fWriterReservation(0), fWriter(false) {}
+   TReentrantRWLock() : fWriterReservation(0), fWriter(false) {}
 
    TVirtualRWMutex::Hint_t *ReadLock();
    void ReadUnLock(TVirtualRWMutex::Hint_t *);
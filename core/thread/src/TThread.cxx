@@ -352,10 +352,14 @@ void TThread::Init()
      if (!ROOT::gCoreMutex) {
         // To avoid dead locks, caused by shared library opening and/or static initialization
         // taking the same lock as 'tls_get_addr_tail', we can not use UniqueLockRecurseCount.
+        // The readers are counted on kCoreMutexReaderStripes cache lines: almost all the
+        // threads take the read lock, and a single counter would bounce between all the cores.
 #ifdef R__HAS_TBB
-        ROOT::gCoreMutex = new ROOT::TRWMutexImp<std::mutex, ROOT::Internal::RecurseCountsTBBUnique>();
+        ROOT::gCoreMutex = new ROOT::TRWMutexImp<std::mutex, ROOT::Internal::RecurseCountsTBBUnique,
+                                                 ROOT::Internal::kCoreMutexReaderStripes>();
 #else
-        ROOT::gCoreMutex = new ROOT::TRWMutexImp<std::mutex, ROOT::Internal::RecurseCounts>();
+        ROOT::gCoreMutex = new ROOT::TRWMutexImp<std::mutex, ROOT::Internal::RecurseCounts,
+                                                 ROOT::Internal::kCoreMutexReaderStripes>();
 #endif
      }
      gInterpreterMutex = ROOT::gCoreMutex;
@@ -0,0 +1,35 @@
+// @(#)root/thread:$Id$
+
+/*************************************************************************
+ * Copyright (C) 1995-2021, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#include "ROOT/TThreadedObject.hxx"
+
+#include <atomic>
+
+namespace ROOT {
+namespace Internal {
+namespace TThreadedObjectUtils {
+
+// The ids and the caches are defined here, not in the header, for all libraries to share them
+
+std::uint64_t GetNewObjectId()
+{
+   static std::atomic<std::uint64_t> lastId{0};
+   return ++lastId;
+}
+
+RSlotCache &GetSlotCache()
+{
+   thread_local RSlotCache cache;
+   return cache;
+}
+
+} // namespace TThreadedObjectUtils
+} // namespace Internal
+} // namespace ROOT
@@ -251,6 +251,8 @@ auto gMutex = new TMutex(kTRUE);
 auto gRWMutex = new TRWMutexImp<TMutex>();
 auto gRWMutexSpin = new TRWMutexImp<ROOT::TSpinMutex>();
 auto gRWMutexStd = new TRWMutexImp<std::mutex>();
+auto gRWMutexStdStriped =
+   new TRWMutexImp<std::mutex, ROOT::Internal::RecurseCounts, ROOT::Internal::kCoreMutexReaderStripes>();
 #ifdef R__HAS_TBB
 auto gRWMutexStdTBB = new TRWMutexImp<std::mutex, ROOT::Internal::RecurseCountsTBB>();
 auto gRWMutexStdTBBUnique = new TRWMutexImp<std::mutex, ROOT::Internal::RecurseCountsTBBUnique>();
@@ -258,6 +260,8 @@ auto gRWMutexStdTBBUnique = new TRWMutexImp<std::mutex, ROOT::Internal::RecurseC
 auto gReentrantRWMutex = new ROOT::TReentrantRWLock<TMutex>();
 auto gReentrantRWMutexSM = new ROOT::TReentrantRWLock<ROOT::TSpinMutex>();
 auto gReentrantRWMutexStd = new ROOT::TReentrantRWLock<std::mutex>();
+auto gReentrantRWMutexStdStriped =
+   new ROOT::TReentrantRWLock<std::mutex, ROOT::Internal::RecurseCounts, ROOT::Internal::kCoreMutexReaderStripes>();
 #ifdef R__HAS_TBB
 auto gReentrantRWMutexStdTBB = new ROOT::TReentrantRWLock<std::mutex, ROOT::Internal::RecurseCountsTBB>();
 auto gReentrantRWMutexStdTBBUnique = new ROOT::TReentrantRWLock<std::mutex, ROOT::Internal::RecurseCountsTBBUnique>();
@@ -495,6 +499,11 @@ TEST(RWLock, ReentrantStd)
    Reentrant(*gReentrantRWMutexStd);
 }
 
+TEST(RWLock, ReentrantStdStriped)
+{
+   Reentrant(*gReentrantRWMutexStdStriped);
+}
+
 #ifdef R__HAS_TBB
 TEST(RWLock, ReentrantStdTBB)
 {
@@ -532,6 +541,11 @@ TEST(RWLock, ResetRestoreStd)
    ResetRestore(*gReentrantRWMutexStd);
 }
 
+TEST(RWLock, ResetRestoreStdStriped)
+{
+   ResetRestore(*gReentrantRWMutexStdStriped);
+}
+
 #ifdef R__HAS_TBB
 TEST(RWLock, ResetRestoreStdTBB)
 {
@@ -580,6 +594,11 @@ TEST(RWLock, concurrentResetRestoreStd)
    concurrentResetRestore(gRWMutexStd, 2, gRepetition / 10000);
 }
 
+TEST(RWLock, concurrentResetRestoreStdStriped)
+{
+   concurrentResetRestore(gRWMutexStdStriped, 2, gRepetition / 10000);
+}
+
 #ifdef R__HAS_TBB
 TEST(RWLock, concurrentResetRestoreStdTBB)
 {
@@ -679,6 +698,11 @@ TEST(RWLock, VeryLargeconcurrentReadsAndWritesStd)
    concurrentReadsAndWrites(gRWMutexStd, 10, 200, gRepetition / 10000);
 }
 
+TEST(RWLock, VeryLargeconcurrentReadsAndWritesStdStriped)
+{
+   concurrentReadsAndWrites(gRWMutexStdStriped, 10, 200, gRepetition / 10000);
+}
+
 #ifdef R__HAS_TBB
 TEST(RWLock, VeryLargeconcurrentReadsAndWritesStdTBB)
 {
@@ -707,6 +731,11 @@ TEST(RWLock, VeryLargeconcurrentReadsStd)
    concurrentReadsAndWrites(gRWMutexStd, 0, 200, gRepetition / 10000);
 }
 
+TEST(RWLock, VeryLargeconcurrentReadsStdStriped)
+{
+   concurrentReadsAndWrites(gRWMutexStdStriped, 0, 200, gRepetition / 10000);
+}
+
 #ifdef R__HAS_TBB
 TEST(RWLock, VeryLargeconcurrentReadsStdTBB)
 {
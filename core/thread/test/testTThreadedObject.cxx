@@ -128,6 +128,57 @@ TEST(TThreadedObject, SnapshotMerge)
    EXPECT_TRUE(hsum1 != hsum0);
 }
 
+TEST(TThreadedObject, MergeThisSlot)
+{
+   TH1::AddDirectory(false);
+
+   ROOT::TThreadedObject<TH1F> tto("h", "h", 64, -4, 4);
+   tto->Fill(1);
+   tto.MergeThisSlot();
+   // the object of the slot was released...
+   EXPECT_EQ(tto.GetAtSlotUnchecked(0), nullptr);
+   // ...and a new one is created when needed
+   tto->Fill(2);
+   tto.MergeThisSlot();
+   tto->Fill(3);
+   EXPECT_EQ(tto.GetAtSlotUnchecked(0)->GetEntries(), 1);
+
+   EXPECT_EQ(tto.SnapshotMerge()->GetEntries(), 3);
+   auto hsum = tto.Merge();
+   EXPECT_EQ(hsum->GetEntries(), 3);
+   EXPECT_EQ(hsum->GetBinContent(hsum->FindBin(2)), 1);
+}
+
+TEST(TThreadedObject, AutoMerge)
+{
+   ROOT::TThreadedObject<int> tto(ROOT::TNumSlots{0}, 0);
+   std::mutex m;
+   std::vector<std::shared_ptr<int>> merged;
+   auto sum_ints = [&](std::shared_ptr<int> first, std::vector<std::shared_ptr<int>> &all) {
+      std::lock_guard<std::mutex> lg(m);
+      for (auto &e : all)
+         if (e && e != first) {
+            *first += *e;
+            merged.emplace_back(e);
+         }
+   };
+   tto.SetAutoMerge(10, sum_ints);
+
+   auto task = [&tto] {
+      for (int i = 0; i < 1000; ++i)
+         ++*tto.Get();
+   };
+   std::vector<std::thread> threads;
+   for (int i = 0; i < 4; ++i)
+      threads.emplace_back(task);
+   for (auto &t : threads)
+      t.join();
+
+   // the objects of the threads were merged and released regularly
+   EXPECT_GT(merged.size(), 4u * 1000u / 10u / 2u);
+   EXPECT_EQ(*tto.Merge(sum_ints), 4000);
+}
+
 TEST(TThreadedObject, GrowSlots)
 {
    // create a TThreadedObject with 3 slots...
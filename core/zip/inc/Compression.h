@@ -39,6 +39,9 @@ namespace ROOT {
 ///   [207 - 208]
 ///  - LZ4 is recommended to be used with compression level 4 [404]
 ///  - ZSTD is recommended to be used with compression level 5 [505]
+///  - ZSTD with dictionary improves the compression ratio of files with many small
+///    payloads, e.g. baskets of branches with few entries or many small objects, and
+///    is recommended to be used with compression level 5 [605]
 
 struct RCompressionSetting {
    struct EDefaults { /// Note: this is only temporarily a struct and will become a enum class hence the name convention
@@ -96,6 +99,10 @@ struct RCompressionSetting {
          kLZ4,
          /// Use ZSTD compression
          kZSTD,
+         /// Use ZSTD compression with a dictionary trained on the first payloads written to the file, which are
+         /// compressed without dictionary; the dictionary is stored in the file. Other users of the compression,
+         /// e.g. RNTuple, use ZSTD compression without dictionary.
+         kZSTDDict,
          /// Undefined compression algorithm (must be kept the last of the list in case a new algorithm is added).
          kUndefined
       };
@@ -10,6 +10,8 @@
  *************************************************************************/
 #include "Compression.h"
 
+#include <cstddef>
+
 /**
  * These are definitions of various free functions for the C-style compression routines in ROOT.
  */
@@ -31,6 +33,49 @@ extern "C" void R__zip(int cxlevel, int *srcsize, char *src, int *tgtsize, char
 
 extern "C" void R__unzip(int *srcsize, unsigned char *src, int *tgtsize, unsigned char *tgt, int *irep);
 
+/**
+ * Dictionaries of the ZSTD compression with dictionary (see ROOT::RCompressionSetting::EAlgorithm::kZSTDDict), kept in
+ * a process-wide registry by the ID stored in the dictionary. R__unzip decompresses the buffers compressed with a
+ * registered dictionary; the dictionaries are reference counted and stay registered until their last reference is
+ * released.
+ */
+extern "C" int R__ZSTDTrainDictionary(const char *samples, const size_t *sampleSizes, unsigned nSamples, char *dict,
+                                      int dictCapacity);
+extern "C" unsigned R__ZSTDAddDictionary(const char *dict, int dictSize);
+extern "C" void R__ZSTDReleaseDictionary(unsigned dictID);
+extern "C" void R__zipZSTDDictionary(int cxlevel, unsigned dictID, int *srcsize, char *src, int *tgtsize, char *tgt,
+                                     int *irep);
+
+/**
+ * Implementation of the ZLIB compression algorithm (ROOT::RCompressionSetting::EAlgorithm::kZLIB), e.g. an
+ * optimized or hardware-accelerated zlib. The compress function deflates src into a zlib stream (RFC 1950) at the
+ * given level (1 to 9) and returns its size, or 0 on failure (e.g. if tgt is too small). The decompress function
+ * inflates a zlib stream and returns the size of the decompressed data, or 0 on failure. The streams must be
+ * readable by any zlib: the compressed bytes may differ from one backend to the other. If a backend fails, the
+ * builtin zlib is used instead.
+ */
+struct R__ZlibBackend {
+   const char *fName;
+   int (*fCompress)(int cxlevel, const char *src, int srcsize, char *tgt, int tgtsize);
+   int (*fDecompress)(const unsigned char *src, int srcsize, unsigned char *tgt, int tgtsize);
+};
+
+/**
+ * Register a ZLIB backend, which must stay valid until the end of the process. It is used once it is selected with
+ * R__SetZlibBackend, e.g. through the "Root.ZlibBackend" rootrc setting or the ROOT_ZLIB_BACKEND environment
+ * variable. Returns 0 if a backend with the same name is already registered.
+ */
+extern "C" int R__RegisterZlibBackend(const R__ZlibBackend *backend);
+
+/**
+ * Select the ZLIB backend by name; "zlib" is the builtin zlib. If the backend is not registered yet, the builtin
+ * zlib is used until it is. Returns 1 if the backend is in use.
+ */
+extern "C" int R__SetZlibBackend(const char *name);
+
+/// Name of the ZLIB backend in use.
+extern "C" const char *R__GetZlibBackend();
+
 extern "C" int R__unzip_header(int *srcsize, unsigned char *src, int *tgtsize);
 
 enum { kMAXZIPBUF = 0xffffff };
@@ -16,8 +16,13 @@
 
 #include "zlib.h"
 
+#include <atomic>
 #include <cstdio>
 #include <cassert>
+#include <cstring>
+#include <mutex>
+#include <string>
+#include <vector>
 
 // The size of the ROOT block framing headers for compression:
 // - 3 bytes to identify the compression algorithm and version.
@@ -98,7 +103,9 @@ void R__zipMultipleAlgorithm(int cxlevel, int *srcsize, char *src, int *tgtsize,
      R__zipLZMA(cxlevel, srcsize, src, tgtsize, tgt, irep);
   } else if (compressionAlgorithm == ROOT::RCompressionSetting::EAlgorithm::kLZ4) {
      R__zipLZ4(cxlevel, srcsize, src, tgtsize, tgt, irep);
-  } else if (compressionAlgorithm == ROOT::RCompressionSetting::EAlgorithm::kZSTD) {
+  } else if (compressionAlgorithm == ROOT::RCompressionSetting::EAlgorithm::kZSTD ||
+             compressionAlgorithm == ROOT::RCompressionSetting::EAlgorithm::kZSTDDict) {
+     // The dictionaries are managed by the file, see TFile::CompressBuffer: without file, no dictionary is used
      R__zipZSTD(cxlevel, srcsize, src, tgtsize, tgt, irep);
   } else if (compressionAlgorithm == ROOT::RCompressionSetting::EAlgorithm::kOldCompressionAlgo || compressionAlgorithm == ROOT::RCompressionSetting::EAlgorithm::kUseGlobal) {
      R__zipOld(cxlevel, srcsize, src, tgtsize, tgt, irep);
@@ -172,48 +179,33 @@ static void R__zipOld(int cxlevel, int *srcsize, char *src, int *tgtsize, char *
 }
 
 /**
- * Compress buffer contents using the venerable zlib algorithm.
+ * Compress buffer contents using the venerable zlib algorithm, as the builtin ZLIB backend.
  */
-static void R__zipZLIB(int cxlevel, int *srcsize, char *src, int *tgtsize, char *tgt, int *irep)
+static int R__compressZLIB(int cxlevel, const char *src, int srcsize, char *tgt, int tgtsize)
 {
-  int err;
-  int method   = Z_DEFLATED;
-
+    int err;
     z_stream stream;
-    //Don't use the globals but want name similar to help see similarities in code
-    unsigned l_in_size, l_out_size;
-    *irep = 0;
-
-    if (*tgtsize <= 0) {
-       R__error("target buffer too small");
-       return;
-    }
-    if (*srcsize > 0xffffff) {
-       R__error("source buffer too big");
-       return;
-    }
 
     stream.next_in   = (Bytef*)src;
-    stream.avail_in  = (uInt)(*srcsize);
+    stream.avail_in  = (uInt)(srcsize);
 
-    stream.next_out  = (Bytef*)(&tgt[HDRSIZE]);
-    stream.avail_out = (uInt)(*tgtsize);
+    stream.next_out  = (Bytef*)tgt;
+    stream.avail_out = (uInt)(tgtsize);
 
     stream.zalloc    = (alloc_func)0;
     stream.zfree     = (free_func)0;
     stream.opaque    = (voidpf)0;
 
-    if (cxlevel > 9) cxlevel = 9;
     err = deflateInit(&stream, cxlevel);
     if (err != Z_OK) {
        printf("error %d in deflateInit (zlib)\n",err);
-       return;
+       return 0;
     }
 
     while ((err = deflate(&stream, Z_FINISH)) != Z_STREAM_END) {
        if (err != Z_OK) {
           deflateEnd(&stream);
-          return;
+          return 0;
        }
     }
 
@@ -221,12 +213,136 @@ static void R__zipZLIB(int cxlevel, int *srcsize, char *src, int *tgtsize, char
     if (err != Z_OK)
        printf("error %d in deflateEnd (zlib)\n",err);
 
+    return stream.total_out;
+}
+
+/**
+ * Decompress a zlib stream, as the builtin ZLIB backend.
+ */
+static int R__decompressZLIB(const unsigned char *src, int srcsize, unsigned char *tgt, int tgtsize)
+{
+     z_stream stream; /* decompression stream */
+     int err = 0;
+
+     stream.next_in = (Bytef *)src;
+     stream.avail_in = (uInt)(srcsize);
+     stream.next_out = (Bytef *)tgt;
+     stream.avail_out = (uInt)(tgtsize);
+     stream.zalloc = (alloc_func)0;
+     stream.zfree = (free_func)0;
+     stream.opaque = (voidpf)0;
+
+     err = inflateInit(&stream);
+     if (err != Z_OK) {
+        fprintf(stderr, "R__unzip: error %d in inflateInit (zlib)\n", err);
+        return 0;
+     }
+
+     while ((err = inflate(&stream, Z_FINISH)) != Z_STREAM_END) {
+        if (err != Z_OK) {
+           inflateEnd(&stream);
+           fprintf(stderr, "R__unzip: error %d in inflate (zlib)\n", err);
+           return 0;
+        }
+     }
+
+     inflateEnd(&stream);
+
+     return stream.total_out;
+}
+
+/* ===========================================================================
+   Registry of the ZLIB backends, see R__RegisterZlibBackend. The backend in
+   use is read without lock by the compression functions.
+ */
+static const R__ZlibBackend gBuiltinZlibBackend = {"zlib", &R__compressZLIB, &R__decompressZLIB};
+
+static std::atomic<const R__ZlibBackend *> gZlibBackend{&gBuiltinZlibBackend};
+
+static std::mutex &R__GetZlibBackendMutex()
+{
+   static std::mutex mutex;
+   return mutex;
+}
+
+static std::vector<const R__ZlibBackend *> &R__GetZlibBackends()
+{
+   static std::vector<const R__ZlibBackend *> backends{&gBuiltinZlibBackend};
+   return backends;
+}
+
+static std::string &R__GetSelectedZlibBackend()
+{
+   static std::string name = "zlib";
+   return name;
+}
+
+int R__RegisterZlibBackend(const R__ZlibBackend *backend)
+{
+   std::lock_guard<std::mutex> lock(R__GetZlibBackendMutex());
+   for (auto registered : R__GetZlibBackends()) {
+      if (strcmp(registered->fName, backend->fName) == 0)
+         return 0;
+   }
+   R__GetZlibBackends().push_back(backend);
+   if (R__GetSelectedZlibBackend() == backend->fName)
+      gZlibBackend = backend;
+   return 1;
+}
+
+int R__SetZlibBackend(const char *name)
+{
+   std::lock_guard<std::mutex> lock(R__GetZlibBackendMutex());
+   R__GetSelectedZlibBackend() = name;
+   for (auto registered : R__GetZlibBackends()) {
+      if (strcmp(registered->fName, name) == 0) {
+         gZlibBackend = registered;
+         return 1;
+      }
+   }
+   gZlibBackend = &gBuiltinZlibBackend;
+   return 0;
+}
+
+const char *R__GetZlibBackend()
+{
+   return gZlibBackend.load()->fName;
+}
+
+/**
+ * Compress buffer contents with the ZLIB backend in use.
+ */
+static void R__zipZLIB(int cxlevel, int *srcsize, char *src, int *tgtsize, char *tgt, int *irep)
+{
+  int method   = Z_DEFLATED;
+
+    //Don't use the globals but want name similar to help see similarities in code
+    unsigned l_in_size, l_out_size;
+    *irep = 0;
+
+    if (*tgtsize <= 0) {
+       R__error("target buffer too small");
+       return;
+    }
+    if (*srcsize > 0xffffff) {
+       R__error("source buffer too big");
+       return;
+    }
+
+    if (cxlevel > 9) cxlevel = 9;
+    const R__ZlibBackend *backend = gZlibBackend;
+    int nout = backend->fCompress(cxlevel, src, *srcsize, &tgt[HDRSIZE], *tgtsize);
+    if (nout == 0 && backend != &gBuiltinZlibBackend)
+       nout = R__compressZLIB(cxlevel, src, *srcsize, &tgt[HDRSIZE], *tgtsize);
+    if (nout == 0)
+       return;
+
     tgt[0] = 'Z';               /* Signature ZLib */
     tgt[1] = 'L';
     tgt[2] = (char) method;
 
     l_in_size   = (unsigned) (*srcsize);
-    l_out_size  = stream.total_out;             /* compressed size */
+    l_out_size  = nout;                         /* compressed size */
     tgt[3] = (char)(l_out_size & 0xff);
     tgt[4] = (char)((l_out_size >> 8) & 0xff);
     tgt[5] = (char)((l_out_size >> 16) & 0xff);
@@ -235,7 +351,7 @@ static void R__zipZLIB(int cxlevel, int *srcsize, char *src, int *tgtsize, char
     tgt[7] = (char)((l_in_size >> 8) & 0xff);
     tgt[8] = (char)((l_in_size >> 16) & 0xff);
 
-    *irep = stream.total_out + HDRSIZE;
+    *irep = nout + HDRSIZE;
 }
 
 
@@ -391,33 +507,8 @@ void R__unzip(int *srcsize, uch *src, int *tgtsize, uch *tgt, int *irep)
 
 void R__unzipZLIB(int *srcsize, unsigned char *src, int *tgtsize, unsigned char *tgt, int *irep)
 {
-     z_stream stream; /* decompression stream */
-     int err = 0;
-
-     stream.next_in = (Bytef *)(&src[HDRSIZE]);
-     stream.avail_in = (uInt)(*srcsize) - HDRSIZE;
-     stream.next_out = (Bytef *)tgt;
-     stream.avail_out = (uInt)(*tgtsize);
-     stream.zalloc = (alloc_func)0;
-     stream.zfree = (free_func)0;
-     stream.opaque = (voidpf)0;
-
-     err = inflateInit(&stream);
-     if (err != Z_OK) {
-        fprintf(stderr, "R__unzip: error %d in inflateInit (zlib)\n", err);
-        return;
-     }
-
-     while ((err = inflate(&stream, Z_FINISH)) != Z_STREAM_END) {
-        if (err != Z_OK) {
-           inflateEnd(&stream);
-           fprintf(stderr, "R__unzip: error %d in inflate (zlib)\n", err);
-           return;
-        }
-     }
-
-     inflateEnd(&stream);
-
-     *irep = stream.total_out;
-     return;
+     const R__ZlibBackend *backend = gZlibBackend;
+     *irep = backend->fDecompress(&src[HDRSIZE], *srcsize - HDRSIZE, tgt, *tgtsize);
+     if (*irep == 0 && backend != &gBuiltinZlibBackend)
+        *irep = R__decompressZLIB(&src[HDRSIZE], *srcsize - HDRSIZE, tgt, *tgtsize);
 }
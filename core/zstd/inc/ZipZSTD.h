@@ -10,6 +10,8 @@
 #ifndef ROOT_ZipZSTD
 #define ROOT_ZipZSTD
 
+#include <stddef.h>
+
 // NOTE: the ROOT compression libraries aren't consistently written in C++; hence the
 // #ifdef's to avoid problems with C code.
 #ifdef __cplusplus
@@ -17,6 +19,14 @@ extern "C" {
 #endif
 void R__zipZSTD(int cxlevel, int *srcsize, char *src, int *tgtsize, char *tgt, int *irep);
 void R__unzipZSTD(int *srcsize, unsigned char *src, int *tgtsize, unsigned char *tgt, int *irep);
+
+// Dictionaries of the ZSTD compression with dictionary. The dictionaries are kept in a process-wide registry, keyed
+// by the ID stored in the dictionary, so that R__unzipZSTD finds the dictionary of a frame from the ID in its header.
+int R__ZSTDTrainDictionary(const char *samples, const size_t *sampleSizes, unsigned nSamples, char *dict,
+                           int dictCapacity);
+unsigned R__ZSTDAddDictionary(const char *dict, int dictSize);
+void R__ZSTDReleaseDictionary(unsigned dictID);
+void R__zipZSTDDictionary(int cxlevel, unsigned dictID, int *srcsize, char *src, int *tgtsize, char *tgt, int *irep);
 #ifdef __cplusplus
 }
 #endif
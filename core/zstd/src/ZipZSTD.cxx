@@ -14,7 +14,10 @@
 
 #include "zdict.h"
 #include <zstd.h>
+#include <map>
 #include <memory>
+#include <mutex>
+#include <string>
 
 #include <iostream>
 
@@ -22,18 +25,73 @@ static const int kHeaderSize = 9;
 
 static const size_t errorCodeSmallBuffer = (size_t)-70;
 
-void R__zipZSTD(int cxlevel, int *srcsize, char *src, int *tgtsize, char *tgt, int *irep)
+namespace {
+
+/// A dictionary of the registry, with its digested forms for compression (one per level) and decompression.
+struct RZSTDDictionary {
+   struct RCDictDeleter {
+      void operator()(ZSTD_CDict *cdict) const { ZSTD_freeCDict(cdict); }
+   };
+   struct RDDictDeleter {
+      void operator()(ZSTD_DDict *ddict) const { ZSTD_freeDDict(ddict); }
+   };
+
+   std::string fContent;
+   unsigned fRefCount = 0;
+   std::unique_ptr<ZSTD_DDict, RDDictDeleter> fDDict;
+   std::map<int, std::unique_ptr<ZSTD_CDict, RCDictDeleter>> fCDicts;
+};
+
+std::mutex &GetDictionaryMutex()
 {
-    using Ctx_ptr = std::unique_ptr<ZSTD_CCtx, decltype(&ZSTD_freeCCtx)>;
-    Ctx_ptr fCtx{ZSTD_createCCtx(), &ZSTD_freeCCtx};
+   static std::mutex mutex;
+   return mutex;
+}
 
-    *irep = 0;
+std::map<unsigned, RZSTDDictionary> &GetDictionaries()
+{
+   static std::map<unsigned, RZSTDDictionary> dictionaries;
+   return dictionaries;
+}
 
-    size_t retval = ZSTD_compressCCtx(fCtx.get(),
-                                        &tgt[kHeaderSize], static_cast<size_t>(*tgtsize - kHeaderSize),
-                                        src, static_cast<size_t>(*srcsize),
-                                        2*cxlevel);
+/// Digested dictionary for the compression at the given level, created on first use. The digested dictionaries are
+/// read only and can be used concurrently; they live as long as a reference to the dictionary is held.
+const ZSTD_CDict *GetCDict(unsigned dictID, int level)
+{
+   std::lock_guard<std::mutex> lock(GetDictionaryMutex());
+   auto entry = GetDictionaries().find(dictID);
+   if (entry == GetDictionaries().end())
+      return nullptr;
+   auto &cdict = entry->second.fCDicts[level];
+   if (!cdict) {
+      const auto &content = entry->second.fContent;
+      cdict.reset(ZSTD_createCDict(content.data(), content.size(), level));
+   }
+   return cdict.get();
+}
 
+const ZSTD_DDict *GetDDict(unsigned dictID)
+{
+   std::lock_guard<std::mutex> lock(GetDictionaryMutex());
+   auto entry = GetDictionaries().find(dictID);
+   return entry == GetDictionaries().end() ? nullptr : entry->second.fDDict.get();
+}
+
+void WriteHeader(size_t deflate_size, size_t inflate_size, char *tgt)
+{
+    tgt[0] = 'Z';
+    tgt[1] = 'S';
+    tgt[2] = '\1';
+    tgt[3] = deflate_size & 0xff;
+    tgt[4] = (deflate_size >> 8) & 0xff;
+    tgt[5] = (deflate_size >> 16) & 0xff;
+    tgt[6] = inflate_size & 0xff;
+    tgt[7] = (inflate_size >> 8) & 0xff;
+    tgt[8] = (inflate_size >> 16) & 0xff;
+}
+
+void CompressionDone(size_t retval, int *srcsize, char *tgt, int *irep)
+{
     if (R__unlikely(ZSTD_isError(retval))) {
         if (R__unlikely(retval != errorCodeSmallBuffer)) {
             std::cerr << "Error in zip ZSTD. Type = " << ZSTD_getErrorName(retval) <<
@@ -45,17 +103,94 @@ void R__zipZSTD(int cxlevel, int *srcsize, char *src, int *tgtsize, char *tgt, i
         *irep = static_cast<size_t>(retval + kHeaderSize);
     }
 
-    size_t deflate_size = retval;
-    size_t inflate_size = static_cast<size_t>(*srcsize);
-    tgt[0] = 'Z';
-    tgt[1] = 'S';
-    tgt[2] = '\1';
-    tgt[3] = deflate_size & 0xff;
-    tgt[4] = (deflate_size >> 8) & 0xff;
-    tgt[5] = (deflate_size >> 16) & 0xff;
-    tgt[6] = inflate_size & 0xff;
-    tgt[7] = (inflate_size >> 8) & 0xff;
-    tgt[8] = (inflate_size >> 16) & 0xff;
+    WriteHeader(retval, static_cast<size_t>(*srcsize), tgt);
+}
+
+} // anonymous namespace
+
+void R__zipZSTD(int cxlevel, int *srcsize, char *src, int *tgtsize, char *tgt, int *irep)
+{
+    using Ctx_ptr = std::unique_ptr<ZSTD_CCtx, decltype(&ZSTD_freeCCtx)>;
+    Ctx_ptr fCtx{ZSTD_createCCtx(), &ZSTD_freeCCtx};
+
+    *irep = 0;
+
+    size_t retval = ZSTD_compressCCtx(fCtx.get(),
+                                        &tgt[kHeaderSize], static_cast<size_t>(*tgtsize - kHeaderSize),
+                                        src, static_cast<size_t>(*srcsize),
+                                        2*cxlevel);
+
+    CompressionDone(retval, srcsize, tgt, irep);
+}
+
+/// Compress with a dictionary of the registry, see R__ZSTDAddDictionary. The buffer has the same header as with
+/// R__zipZSTD; the ZSTD frame records the ID of the dictionary, from which R__unzipZSTD finds it. Falls back to the
+/// compression without dictionary if the dictionary is not registered.
+void R__zipZSTDDictionary(int cxlevel, unsigned dictID, int *srcsize, char *src, int *tgtsize, char *tgt, int *irep)
+{
+    const ZSTD_CDict *cdict = GetCDict(dictID, 2*cxlevel);
+    if (R__unlikely(!cdict)) {
+        R__zipZSTD(cxlevel, srcsize, src, tgtsize, tgt, irep);
+        return;
+    }
+
+    using Ctx_ptr = std::unique_ptr<ZSTD_CCtx, decltype(&ZSTD_freeCCtx)>;
+    Ctx_ptr fCtx{ZSTD_createCCtx(), &ZSTD_freeCCtx};
+
+    *irep = 0;
+
+    size_t retval = ZSTD_compress_usingCDict(fCtx.get(),
+                                             &tgt[kHeaderSize], static_cast<size_t>(*tgtsize - kHeaderSize),
+                                             src, static_cast<size_t>(*srcsize),
+                                             cdict);
+
+    CompressionDone(retval, srcsize, tgt, irep);
+}
+
+/// Train a dictionary on the concatenated samples; returns the size of the dictionary, or 0 if the training failed,
+/// e.g. because there are too few samples.
+int R__ZSTDTrainDictionary(const char *samples, const size_t *sampleSizes, unsigned nSamples, char *dict,
+                           int dictCapacity)
+{
+    size_t retval = ZDICT_trainFromBuffer(dict, static_cast<size_t>(dictCapacity), samples, sampleSizes, nSamples);
+    if (ZDICT_isError(retval))
+        return 0;
+    return static_cast<int>(retval);
+}
+
+/// Add a reference to a dictionary, registering it if needed. Returns the ID of the dictionary, or 0 if it is not a
+/// valid dictionary or conflicts with a registered dictionary of the same ID.
+unsigned R__ZSTDAddDictionary(const char *dict, int dictSize)
+{
+    unsigned dictID = ZDICT_getDictID(dict, static_cast<size_t>(dictSize));
+    if (dictID == 0)
+        return 0;
+
+    std::lock_guard<std::mutex> lock(GetDictionaryMutex());
+    auto &entry = GetDictionaries()[dictID];
+    if (entry.fRefCount == 0) {
+        entry.fContent.assign(dict, dictSize);
+        entry.fDDict.reset(ZSTD_createDDict(dict, static_cast<size_t>(dictSize)));
+        if (!entry.fDDict) {
+            GetDictionaries().erase(dictID);
+            return 0;
+        }
+    } else if (entry.fContent.compare(0, std::string::npos, dict, dictSize) != 0) {
+        std::cerr << "R__ZSTDAddDictionary: a different dictionary with ID " << dictID << " is already in use."
+                  << std::endl;
+        return 0;
+    }
+    entry.fRefCount++;
+    return dictID;
+}
+
+/// Release a reference to a dictionary, which is removed from the registry with its last reference.
+void R__ZSTDReleaseDictionary(unsigned dictID)
+{
+    std::lock_guard<std::mutex> lock(GetDictionaryMutex());
+    auto entry = GetDictionaries().find(dictID);
+    if (entry != GetDictionaries().end() && --entry->second.fRefCount == 0)
+        GetDictionaries().erase(entry);
 }
 
 void R__unzipZSTD(int *srcsize, unsigned char *src, int *tgtsize, unsigned char *tgt, int *irep)
@@ -77,9 +212,24 @@ void R__unzipZSTD(int *srcsize, unsigned char *src, int *tgtsize, unsigned char
       return;
     }
 
-    size_t retval = ZSTD_decompressDCtx(fCtx.get(),
-                                        (char *)tgt, static_cast<size_t>(*tgtsize),
-                                        (char *)&src[kHeaderSize], static_cast<size_t>(*srcsize - kHeaderSize));
+    size_t retval;
+    unsigned dictID = ZSTD_getDictID_fromFrame(&src[kHeaderSize], static_cast<size_t>(*srcsize - kHeaderSize));
+    if (dictID != 0) {
+        const ZSTD_DDict *ddict = GetDDict(dictID);
+        if (R__unlikely(!ddict)) {
+            std::cerr << "R__unzipZSTD: the buffer was compressed with the dictionary " << dictID <<
+            ", which is not loaded." << std::endl;
+            return;
+        }
+        retval = ZSTD_decompress_usingDDict(fCtx.get(),
+                                            (char *)tgt, static_cast<size_t>(*tgtsize),
+                                            (char *)&src[kHeaderSize], static_cast<size_t>(*srcsize - kHeaderSize),
+                                            ddict);
+    } else {
+        retval = ZSTD_decompressDCtx(fCtx.get(),
+                                     (char *)tgt, static_cast<size_t>(*tgtsize),
+                                     (char *)&src[kHeaderSize], static_cast<size_t>(*srcsize - kHeaderSize));
+    }
 
     /* The error code 18446744073709551546 arises when the tgt buffer is too small
      * However this error is already handled outside of the compression algorithm
@@ -118,6 +118,7 @@ public:
 
 private:
 
+   Bool_t            ParseGDMLFile(TXMLEngine* gdml, const char* filename);
    const char*       ParseGDML(TXMLEngine* gdml, XMLNodePointer_t node) ;
    TString           GetScale(const char* unit);
    double            GetScaleVal(const char* unit);
@@ -152,8 +152,8 @@ TGDMLParse::TGDMLParse()
 
 ////////////////////////////////////////////////////////////////////////////////
 /// Creates the new instance of the XMLEngine called 'gdml', using the filename >>
-/// then parses the file and creates the DOM tree. Then passes the DOM to the
-/// next function to translate it.
+/// then reads the file section after section, see ParseGDMLFile, and passes each
+/// section to the next function to translate it.
 
 TGeoVolume *TGDMLParse::GDMLReadFile(const char *filename)
 {
@@ -161,28 +161,46 @@ TGeoVolume *TGDMLParse::GDMLReadFile(const char *filename)
    TXMLEngine *gdml = new TXMLEngine;
    gdml->SetSkipComments(kTRUE);
 
-   // Now try to parse xml file
-   XMLDocPointer_t gdmldoc = gdml->ParseFile(filename);
-   if (gdmldoc == 0) {
-      delete gdml;
-      return 0;
-   } else {
+   fFileEngine[fFILENO] = gdml;
+   fStartFile = filename;
+   fCurrentFile = filename;
 
-      // take access to main node
-      XMLNodePointer_t mainnode = gdml->DocGetRootElement(gdmldoc);
+   // Now try to read xml file
+   Bool_t ok = ParseGDMLFile(gdml, filename);
 
-      fFileEngine[fFILENO] = gdml;
-      fStartFile = filename;
-      fCurrentFile = filename;
+   // Release memory before exit
+   delete gdml;
+   return ok ? fWorld : 0;
+}
 
-      // display recursively all nodes and subnodes
-      ParseGDML(gdml, mainnode);
+////////////////////////////////////////////////////////////////////////////////
+/// Reads the GDML file with the streaming reader of the XMLEngine: the sections of
+/// the main node are translated by ParseGDML one after the other, and each of them
+/// is released before the next one is read, such that the DOM tree of the complete
+/// file is never kept in memory. Returns kFALSE if the file cannot be read.
+
+Bool_t TGDMLParse::ParseGDMLFile(TXMLEngine *gdml, const char *filename)
+{
+   XMLReaderPointer_t reader = gdml->OpenReader(filename);
+   if (reader == 0)
+      return kFALSE;
 
-      // Release memory before exit
-      gdml->FreeDoc(gdmldoc);
-      delete gdml;
+   Int_t event;
+   while ((event = gdml->ReadNext(reader)) > 0) {
+      if (event != TXMLEngine::kReaderStartNode)
+         continue;
+      if (gdml->GetReaderDepth(reader) == 0) {
+         // main node, its children are not read yet
+         ParseGDML(gdml, gdml->GetReaderNode(reader));
+      } else {
+         // in case of error in the section, the next ReadNext stops the reading
+         XMLNodePointer_t section = gdml->ReadSubtree(reader);
+         if (section)
+            ParseGDML(gdml, section);
+      }
    }
-   return fWorld;
+   gdml->CloseReader(reader);
+   return event == TXMLEngine::kReaderEnd;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -1792,12 +1810,6 @@ XMLNodePointer_t TGDMLParse::VolProcess(TXMLEngine *gdml, XMLNodePointer_t node)
 
                TXMLEngine *gdml2 = new TXMLEngine;
                gdml2->SetSkipComments(kTRUE);
-               XMLDocPointer_t filedoc1 = gdml2->ParseFile(fCurrentFile);
-               if (filedoc1 == 0) {
-                  Fatal("VolProcess", "Bad filename given %s", fCurrentFile);
-               }
-               // take access to main node
-               XMLNodePointer_t mainnode2 = gdml2->DocGetRootElement(filedoc1);
                // increase depth counter + add DOM pointer
                fFILENO = fFILENO + 1;
                fFileEngine[fFILENO] = gdml2;
@@ -1805,7 +1817,10 @@ XMLNodePointer_t TGDMLParse::VolProcess(TXMLEngine *gdml, XMLNodePointer_t node)
                if (ffilemap.find(fCurrentFile) != ffilemap.end()) {
                   volref = ffilemap[fCurrentFile];
                } else {
-                  volref = ParseGDML(gdml2, mainnode2);
+                  if (!ParseGDMLFile(gdml2, fCurrentFile)) {
+                     Fatal("VolProcess", "Bad filename given %s", fCurrentFile);
+                  }
+                  volref = fWorldName;
                   ffilemap[fCurrentFile] = volref;
                }
 
@@ -1823,7 +1838,6 @@ XMLNodePointer_t TGDMLParse::VolProcess(TXMLEngine *gdml, XMLNodePointer_t node)
                lv = fvolmap[volref.Data()];
                // File tree complete - Release memory before exit
 
-               gdml->FreeDoc(filedoc1);
                delete gdml2;
             } else if (tempattr == "position") {
                attr = gdml->GetFirstAttr(subchild);
@@ -0,0 +1,165 @@
+#include "TGDMLParse.h"
+#include "TGeoBBox.h"
+#include "TGeoManager.h"
+#include "TGeoMaterial.h"
+#include "TGeoMatrix.h"
+#include "TGeoNode.h"
+#include "TGeoTube.h"
+#include "TGeoVolume.h"
+
+#include "gtest/gtest.h"
+
+#include <cstdio>
+#include <fstream>
+
+namespace {
+
+const char *gMainFile = "testGDMLParse.gdml";
+const char *gSubFile = "testGDMLParse_sub.gdml";
+
+// The main file places the volume of the sub file twice, the second time it is taken from the cache of the parser
+void WriteFiles()
+{
+   std::ofstream main(gMainFile);
+   main << "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n"
+           "<!-- geometry for testGDMLParse -->\n"
+           "<gdml xmlns:xsi=\"http://www.w3.org/2001/XMLSchema-instance\" xsi:noNamespaceSchemaLocation=\"gdml.xsd\">\n"
+           "  <define>\n"
+           "    <constant name=\"HALFLENGTH\" value=\"25\"/>\n"
+           "    <position name=\"tubepos\" x=\"0\" y=\"0\" z=\"HALFLENGTH/5\" unit=\"cm\"/>\n"
+           "  </define>\n"
+           "  <!-- materials -->\n"
+           "  <materials>\n"
+           "    <material name=\"Al\" Z=\"13\"><D value=\"2.7\"/><atom value=\"26.98\"/></material>\n"
+           "  </materials>\n"
+           "  <solids>\n"
+           "    <box name=\"WorldBox\" x=\"4*HALFLENGTH\" y=\"100\" z=\"100\" lunit=\"cm\"/>\n"
+           "    <tube name=\"Tube\" rmin=\"1\" rmax=\"10\" z=\"20\" deltaphi=\"360\" aunit=\"deg\" lunit=\"cm\"/>\n"
+           "  </solids>\n"
+           "  <structure>\n"
+           "    <volume name=\"TubeVol\">\n"
+           "      <materialref ref=\"Al\"/>\n"
+           "      <solidref ref=\"Tube\"/>\n"
+           "    </volume>\n"
+           "    <volume name=\"World\">\n"
+           "      <materialref ref=\"Al\"/>\n"
+           "      <solidref ref=\"WorldBox\"/>\n"
+           "      <!-- daughters -->\n"
+           "      <physvol name=\"tube_pv\"><volumeref ref=\"TubeVol\"/><positionref ref=\"tubepos\"/></physvol>\n"
+           "      <physvol name=\"sub_pv1\">\n"
+           "        <file name=\""
+        << gSubFile
+        << "\"/>\n"
+           "        <position name=\"sub1pos\" x=\"-30\" y=\"0\" z=\"0\" unit=\"cm\"/>\n"
+           "      </physvol>\n"
+           "      <physvol name=\"sub_pv2\">\n"
+           "        <file name=\""
+        << gSubFile
+        << "\"/>\n"
+           "        <position name=\"sub2pos\" x=\"300\" y=\"0\" z=\"0\" unit=\"mm\"/>\n"
+           "      </physvol>\n"
+           "    </volume>\n"
+           "  </structure>\n"
+           "  <setup name=\"Default\" version=\"1.0\">\n"
+           "    <world ref=\"World\"/>\n"
+           "  </setup>\n"
+           "</gdml>\n";
+
+   std::ofstream sub(gSubFile);
+   sub << "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n"
+          "<gdml>\n"
+          "  <materials>\n"
+          "    <material name=\"Al\" Z=\"13\"><D value=\"2.7\"/><atom value=\"26.98\"/></material>\n"
+          "  </materials>\n"
+          "  <solids>\n"
+          "    <box name=\"SubBox\" x=\"20\" y=\"20\" z=\"20\" lunit=\"cm\"/>\n"
+          "  </solids>\n"
+          "  <structure>\n"
+          "    <volume name=\"Sub\"><materialref ref=\"Al\"/><solidref ref=\"SubBox\"/></volume>\n"
+          "  </structure>\n"
+          "  <setup name=\"Default\" version=\"1.0\"><world ref=\"Sub\"/></setup>\n"
+          "</gdml>\n";
+}
+
+} // namespace
+
+TEST(TGDMLParse, ReadFile)
+{
+   WriteFiles();
+   auto geom = new TGeoManager("gdmltest", "GDML parser test");
+
+   TGDMLParse parser;
+   TGeoVolume *world = parser.GDMLReadFile(gMainFile);
+   ASSERT_NE(world, nullptr);
+   EXPECT_STREQ(world->GetName(), "World");
+   EXPECT_EQ(parser.fWorld, world);
+
+   auto worldBox = dynamic_cast<TGeoBBox *>(world->GetShape());
+   ASSERT_NE(worldBox, nullptr);
+   EXPECT_DOUBLE_EQ(worldBox->GetDX(), 50.);
+   EXPECT_DOUBLE_EQ(worldBox->GetDY(), 50.);
+   EXPECT_DOUBLE_EQ(worldBox->GetDZ(), 50.);
+
+   TGeoMaterial *mat = world->GetMaterial();
+   ASSERT_NE(mat, nullptr);
+   EXPECT_STREQ(mat->GetName(), "Al");
+   EXPECT_DOUBLE_EQ(mat->GetDensity(), 2.7);
+   EXPECT_DOUBLE_EQ(mat->GetZ(), 13.);
+   EXPECT_DOUBLE_EQ(mat->GetA(), 26.98);
+
+   ASSERT_EQ(world->GetNdaughters(), 3);
+
+   TGeoNode *tubeNode = world->GetNode(0);
+   EXPECT_STREQ(tubeNode->GetName(), "tube_pv");
+   TGeoVolume *tubeVol = tubeNode->GetVolume();
+   EXPECT_STREQ(tubeVol->GetName(), "TubeVol");
+   EXPECT_EQ(tubeVol->GetMaterial(), mat);
+   auto tube = dynamic_cast<TGeoTube *>(tubeVol->GetShape());
+   ASSERT_NE(tube, nullptr);
+   EXPECT_DOUBLE_EQ(tube->GetRmin(), 1.);
+   EXPECT_DOUBLE_EQ(tube->GetRmax(), 10.);
+   EXPECT_DOUBLE_EQ(tube->GetDz(), 10.);
+   const Double_t *tubePos = tubeNode->GetMatrix()->GetTranslation();
+   EXPECT_DOUBLE_EQ(tubePos[0], 0.);
+   EXPECT_DOUBLE_EQ(tubePos[2], 5.);
+
+   // the volume of the included file is read once and placed twice
+   TGeoNode *subNode1 = world->GetNode(1);
+   TGeoNode *subNode2 = world->GetNode(2);
+   EXPECT_STREQ(subNode1->GetName(), "sub_pv1");
+   EXPECT_STREQ(subNode2->GetName(), "sub_pv2");
+   TGeoVolume *subVol = subNode1->GetVolume();
+   ASSERT_NE(subVol, nullptr);
+   EXPECT_EQ(subNode2->GetVolume(), subVol);
+   EXPECT_EQ(TString(subVol->GetName()), TString::Format("Sub_%s", gSubFile));
+   auto subBox = dynamic_cast<TGeoBBox *>(subVol->GetShape());
+   ASSERT_NE(subBox, nullptr);
+   EXPECT_DOUBLE_EQ(subBox->GetDX(), 10.);
+   EXPECT_DOUBLE_EQ(subNode1->GetMatrix()->GetTranslation()[0], -30.);
+   EXPECT_DOUBLE_EQ(subNode2->GetMatrix()->GetTranslation()[0], 30.);
+   EXPECT_EQ(subVol->GetNdaughters(), 0);
+
+   delete geom;
+   std::remove(gMainFile);
+   std::remove(gSubFile);
+}
+
+TEST(TGDMLParse, InvalidFile)
+{
+   const char *filename = "testGDMLParse_invalid.gdml";
+   {
+      std::ofstream f(filename);
+      f << "<?xml version=\"1.0\"?>\n<gdml>\n  <solids>\n    <box name=\"b\" x=\"1\" y=\"1\" z=\"1\"/>\n  </materials>\n</gdml>\n";
+   }
+   auto geom = new TGeoManager("gdmltest", "GDML parser test");
+   {
+      TGDMLParse parser;
+      EXPECT_EQ(parser.GDMLReadFile(filename), nullptr);
+   }
+   {
+      TGDMLParse parser;
+      EXPECT_EQ(parser.GDMLReadFile("testGDMLParse_missing.gdml"), nullptr);
+   }
+   delete geom;
+   std::remove(filename);
+}
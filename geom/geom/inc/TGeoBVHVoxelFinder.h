@@ -0,0 +1,58 @@
+// @(#)root/geom:$Id$
+
+/*************************************************************************
+ * Copyright (C) 1995-2021, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#ifndef ROOT_TGeoBVHVoxelFinder
+#define ROOT_TGeoBVHVoxelFinder
+
+#include "TGeoVoxelFinder.h"
+
+class TGeoBVHVoxelFinder : public TGeoVoxelFinder
+{
+public:
+   enum EBVHLimits {
+      kMaxLeafSize = 4,     // maximum number of daughters in a leaf
+      kMaxDepth    = 64     // maximum depth of the hierarchy
+   };
+
+private:
+   TGeoBVHVoxelFinder(const TGeoBVHVoxelFinder&) = delete;
+   TGeoBVHVoxelFinder& operator=(const TGeoBVHVoxelFinder&) = delete;
+
+protected:
+   Int_t             fNnodes;         // number of nodes of the hierarchy
+   Int_t             fNbounds;        // length of the array of node bounds
+   Int_t             fNlinks;         // length of the array of node links
+   Int_t             fNindices;       // length of the array of daughter indices
+   Float_t          *fBounds;         //[fNbounds] xmin,xmax,ymin,ymax,zmin,zmax of the nodes, rounded outwards
+   Int_t            *fLinks;          //[fNlinks] right child or first index, number of daughters (0 for inner nodes)
+   Int_t            *fIndices;        //[fNindices] daughter indices, contiguous for each leaf
+
+   void                ClearHierarchy();
+   Bool_t              NodeContains(Int_t inode, const Double_t *point) const;
+   Double_t            NodeDistance(Int_t inode, const Double_t *point, const Double_t *invdir) const;
+
+public :
+   TGeoBVHVoxelFinder();
+   TGeoBVHVoxelFinder(TGeoVolume *vol);
+   virtual ~TGeoBVHVoxelFinder();
+   using TGeoVoxelFinder::GetCheckList;
+   virtual Int_t      *GetCheckList(const Double_t *point, Int_t &nelem, TGeoStateInfo &td);
+   virtual Int_t      *GetNextCandidates(const Double_t *point, Int_t &ncheck, TGeoStateInfo &td);
+   virtual void        FindOverlaps(Int_t inode) const;
+   Int_t               GetNnodes() const {return fNnodes;}
+   virtual void        Print(Option_t *option="") const;
+   virtual Int_t      *GetNextVoxel(const Double_t *point, const Double_t *dir, Int_t &ncheck, TGeoStateInfo &td);
+   virtual void        SortCrossedVoxels(const Double_t *point, const Double_t *dir, TGeoStateInfo &td, Double_t step=TGeoShape::Big());
+   virtual void        Voxelize(Option_t *option="");
+
+   ClassDef(TGeoBVHVoxelFinder, 1)             // bounding volume hierarchy finder class
+};
+
+#endif
@@ -57,6 +57,7 @@ protected:
    static Int_t          fgMaxDaughters;    //! Maximum number of daughters
    static Int_t          fgMaxXtruVert;     //! Maximum number of Xtru vertices
    static UInt_t         fgExportPrecision; //! Precision to be used in ASCII exports
+   static Int_t          fgBVHThreshold;    //! Minimum number of daughters of the volumes using a BVH finder
    static EDefaultUnits  fgDefaultUnits;    //! Default units in GDML if not explicit in some tags
 
    TGeoManager(const TGeoManager&) = delete;
@@ -477,6 +478,8 @@ public:
    static Bool_t          IsLocked();
    static void            SetExportPrecision(UInt_t prec) {fgExportPrecision = prec;}
    static UInt_t          GetExportPrecision() {return fgExportPrecision;}
+   static void            SetBVHThreshold(Int_t ndaughters) {fgBVHThreshold = ndaughters;}
+   static Int_t           GetBVHThreshold() {return fgBVHThreshold;}
    static void            SetDefaultUnits(EDefaultUnits new_value);
    static EDefaultUnits   GetDefaultUnits();
    static Bool_t          LockDefaultUnits(Bool_t new_value);
@@ -50,6 +50,7 @@ public:
    virtual Int_t         GetNmeshVertices() const {return 0;}
    virtual void          InspectShape() const;
    virtual Bool_t        IsAssembly() const {return kTRUE;}
+   Bool_t                IsBBoxOK() const {return fBBoxOK;}
    virtual Bool_t        IsCylType() const {return kFALSE;}
    void                  NeedsBBoxRecompute() {fBBoxOK = kFALSE;}
    void                  RecomputeBoxLast();
@@ -13,6 +13,7 @@
 #define ROOT_TGeoVoxelFinder
 
 #include "TObject.h"
+#include "TGeoShape.h"
 
 class TGeoVolume;
 struct TGeoStateInfo;
@@ -110,7 +111,7 @@ public :
    void                SetInvalid(Bool_t flag=kTRUE) {TObject::SetBit(kGeoInvalidVoxels, flag);}
    void                SetNeedRebuild(Bool_t flag=kTRUE) {TObject::SetBit(kGeoRebuildVoxels, flag);}
    virtual Int_t      *GetNextVoxel(const Double_t *point, const Double_t *dir, Int_t &ncheck, TGeoStateInfo &td);
-   virtual void        SortCrossedVoxels(const Double_t *point, const Double_t *dir, TGeoStateInfo &td);
+   virtual void        SortCrossedVoxels(const Double_t *point, const Double_t *dir, TGeoStateInfo &td, Double_t step=TGeoShape::Big());
    virtual void        Voxelize(Option_t *option="");
 
    ClassDef(TGeoVoxelFinder, 4)                // voxel finder class
@@ -1046,10 +1046,16 @@ void TGeoBBox::FillBuffer3D(TBuffer3D & buffer, Int_t reqSections, Bool_t localF
 /// Check the inside status for each of the points in the array.
 /// Input: Array of point coordinates + vector size
 /// Output: Array of Booleans for the inside of each point
+/// The loop has no branches, so that the compiler can vectorize it.
 
 void TGeoBBox::Contains_v(const Double_t *points, Bool_t *inside, Int_t vecsize) const
 {
-   for (Int_t i=0; i<vecsize; i++) inside[i] = Contains(&points[3*i]);
+   for (Int_t i=0; i<vecsize; i++) {
+      const Double_t *point = &points[3*i];
+      inside[i] = (TMath::Abs(point[0]-fOrigin[0]) <= fDX) &
+                  (TMath::Abs(point[1]-fOrigin[1]) <= fDY) &
+                  (TMath::Abs(point[2]-fOrigin[2]) <= fDZ);
+   }
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -1064,10 +1070,25 @@ void TGeoBBox::ComputeNormal_v(const Double_t *points, const Double_t *dirs, Dou
 
 ////////////////////////////////////////////////////////////////////////////////
 /// Compute distance from array of input points having directions specified by dirs. Store output in dists
+/// Same result as DistFromInside(point, dir, 3), computed without early returns so that the
+/// compiler can vectorize the loop.
 
-void TGeoBBox::DistFromInside_v(const Double_t *points, const Double_t *dirs, Double_t *dists, Int_t vecsize, Double_t* step) const
+void TGeoBBox::DistFromInside_v(const Double_t *points, const Double_t *dirs, Double_t *dists, Int_t vecsize, Double_t* /*step*/) const
 {
-   for (Int_t i=0; i<vecsize; i++) dists[i] = DistFromInside(&points[3*i], &dirs[3*i], 3, step[i]);
+   const Double_t half[3] = {fDX, fDY, fDZ};
+   for (Int_t i=0; i<vecsize; i++) {
+      const Double_t *point = &points[3*i];
+      const Double_t *dir = &dirs[3*i];
+      Double_t smin = TGeoShape::Big();
+      for (Int_t j=0; j<3; j++) {
+         const Double_t pt = point[j] - fOrigin[j];
+         // distance to the face crossed along dir[j], none if parallel to the faces
+         const Double_t s = (dir[j]>0) ? (half[j]-pt)/dir[j] : ((dir[j]<0) ? (-half[j]-pt)/dir[j] : TGeoShape::Big());
+         smin = TMath::Min(smin, s);
+      }
+      // points outside the box are on a boundary
+      dists[i] = TMath::Max(smin, 0.);
+   }
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -1085,5 +1106,12 @@ void TGeoBBox::DistFromOutside_v(const Double_t *points, const Double_t *dirs, D
 
 void TGeoBBox::Safety_v(const Double_t *points, const Bool_t *inside, Double_t *safe, Int_t vecsize) const
 {
-   for (Int_t i=0; i<vecsize; i++) safe[i] = Safety(&points[3*i], inside[i]);
+   for (Int_t i=0; i<vecsize; i++) {
+      const Double_t *point = &points[3*i];
+      // the outside safety is the opposite of the inside one
+      const Double_t saf = TMath::Min(fDX - TMath::Abs(point[0]-fOrigin[0]),
+                           TMath::Min(fDY - TMath::Abs(point[1]-fOrigin[1]),
+                                      fDZ - TMath::Abs(point[2]-fOrigin[2])));
+      safe[i] = inside[i] ? saf : -saf;
+   }
 }
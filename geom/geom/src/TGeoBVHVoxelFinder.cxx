@@ -0,0 +1,553 @@
+// @(#)root/geom:$Id$
+
+/*************************************************************************
+ * Copyright (C) 1995-2021, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+/** \class TGeoBVHVoxelFinder
+\ingroup Geometry_classes
+
+Finder class using a bounding volume hierarchy of the daughters instead of
+slicing voxels.
+
+The bounding boxes of the daughters in the mother frame are grouped in a binary
+tree built with a binned surface area heuristic, with at most kMaxLeafSize
+daughters per leaf. The tree takes memory linear in the number of daughters and
+is built in N*log(N), so it is better suited than the slices of TGeoVoxelFinder
+to volumes with thousands of daughters, e.g. calorimeter cells or tracker modules.
+
+The nodes are stored depth first in flat arrays: six float bounds per node,
+rounded outwards so that they contain the double precision boxes, followed by
+two integers which are the index of the right child for inner nodes, whose left
+child is the next node, or the first position in the array of daughter indices
+and the number of daughters for leaves.
+
+The finder answers the same queries as the voxels: GetCheckList() returns the
+daughters whose box contains a point and SortCrossedVoxels() collects at once
+the daughters whose box is crossed by a ray within a step, which
+GetNextVoxel() returns as a single list.
+
+The hierarchy is used for the volumes having at least
+TGeoManager::GetBVHThreshold() daughters, or for a given volume by setting its
+finder before closing the geometry:
+~~~{.cpp}
+vol->SetVoxelFinder(new TGeoBVHVoxelFinder(vol));
+~~~
+*/
+
+#include "TGeoBVHVoxelFinder.h"
+
+#include "TMath.h"
+#include "TGeoBBox.h"
+#include "TGeoNode.h"
+#include "TGeoVolume.h"
+#include "TGeoStateInfo.h"
+
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <cstring>
+#include <vector>
+
+ClassImp(TGeoBVHVoxelFinder);
+
+namespace {
+
+////////////////////////////////////////////////////////////////////////////////
+/// Round a bound to the next float towards -infinity
+
+Float_t RoundDown(Double_t x)
+{
+   Float_t f = (Float_t)x;
+   return (f > x) ? std::nextafter(f, -FLT_MAX) : f;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Round a bound to the next float towards +infinity
+
+Float_t RoundUp(Double_t x)
+{
+   Float_t f = (Float_t)x;
+   return (f < x) ? std::nextafter(f, FLT_MAX) : f;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Half of the surface of an axis aligned box given as xmin,xmax,ymin,ymax,zmin,zmax
+
+Double_t HalfArea(const Double_t *b)
+{
+   Double_t dx = b[1]-b[0];
+   Double_t dy = b[3]-b[2];
+   Double_t dz = b[5]-b[4];
+   return dx*dy + dy*dz + dz*dx;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Extend an axis aligned box with the box of daughter id
+
+void Extend(Double_t *b, const Double_t *boxes, Int_t id)
+{
+   const Double_t *box = &boxes[6*id];
+   for (Int_t j=0; j<3; j++) {
+      b[2*j]   = TMath::Min(b[2*j],   box[3+j]-box[j]);
+      b[2*j+1] = TMath::Max(b[2*j+1], box[3+j]+box[j]);
+   }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Set an axis aligned box to the empty box
+
+void Reset(Double_t *b)
+{
+   for (Int_t j=0; j<3; j++) {
+      b[2*j]   = TGeoShape::Big();
+      b[2*j+1] = -TGeoShape::Big();
+   }
+}
+
+/// Builder of the hierarchy in growing arrays
+struct TGeoBVHBuilder {
+   const Double_t      *fBoxes;    // dX,dY,dZ,oX,oY,oZ of the daughters
+   std::vector<Float_t> fBounds;   // bounds of the nodes
+   std::vector<Int_t>   fLinks;    // links of the nodes
+   std::vector<Int_t>   fIndices;  // daughter indices
+
+   Int_t Build(Int_t first, Int_t n, Int_t depth);
+};
+
+////////////////////////////////////////////////////////////////////////////////
+/// Build the node of the daughters fIndices[first, first+n) and its children.
+/// Returns the index of the node.
+
+Int_t TGeoBVHBuilder::Build(Int_t first, Int_t n, Int_t depth)
+{
+   const Int_t kNbins = 16;
+   Int_t inode = fLinks.size()/2;
+   Int_t *indices = &fIndices[first];
+   // bounds of the boxes and of their centers
+   Double_t bounds[6], centers[6];
+   Reset(bounds);
+   Reset(centers);
+   Int_t i, j;
+   for (i=0; i<n; i++) {
+      Extend(bounds, fBoxes, indices[i]);
+      for (j=0; j<3; j++) {
+         Double_t c = fBoxes[6*indices[i]+3+j];
+         centers[2*j]   = TMath::Min(centers[2*j], c);
+         centers[2*j+1] = TMath::Max(centers[2*j+1], c);
+      }
+   }
+   for (j=0; j<3; j++) {
+      fBounds.push_back(RoundDown(bounds[2*j]));
+      fBounds.push_back(RoundUp(bounds[2*j+1]));
+   }
+   fLinks.push_back(first);
+   fLinks.push_back(n);
+   if (n <= TGeoBVHVoxelFinder::kMaxLeafSize) return inode;
+
+   // split along the largest extent of the centers
+   Int_t axis = 0;
+   for (j=1; j<3; j++) {
+      if (centers[2*j+1]-centers[2*j] > centers[2*axis+1]-centers[2*axis]) axis = j;
+   }
+   Double_t cmin = centers[2*axis];
+   Double_t extent = centers[2*axis+1] - cmin;
+   auto center = [this, axis](Int_t id) { return fBoxes[6*id+3+axis]; };
+   auto bin = [&](Int_t id) {
+      Int_t ibin = Int_t(kNbins*(center(id)-cmin)/extent);
+      return TMath::Min(ibin, kNbins-1);
+   };
+   Int_t nleft = 0;
+   // surface area heuristic on bins of the centers, down to half of the maximum depth
+   if (extent > 0 && depth < TGeoBVHVoxelFinder::kMaxDepth/2) {
+      Int_t counts[kNbins] = {0};
+      Double_t binbounds[kNbins][6];
+      for (i=0; i<kNbins; i++) Reset(binbounds[i]);
+      for (i=0; i<n; i++) {
+         Int_t ibin = bin(indices[i]);
+         counts[ibin]++;
+         Extend(binbounds[ibin], fBoxes, indices[i]);
+      }
+      // cost of the right side of each split, sweeping from the right
+      Double_t rcost[kNbins];
+      Double_t acc[6];
+      Reset(acc);
+      Int_t count = 0;
+      for (i=kNbins-1; i>0; i--) {
+         count += counts[i];
+         for (j=0; j<3; j++) {
+            acc[2*j]   = TMath::Min(acc[2*j], binbounds[i][2*j]);
+            acc[2*j+1] = TMath::Max(acc[2*j+1], binbounds[i][2*j+1]);
+         }
+         rcost[i] = count ? count*HalfArea(acc) : 0.;
+      }
+      Reset(acc);
+      count = 0;
+      Double_t best = TGeoShape::Big();
+      Int_t split = 0;
+      for (i=0; i<kNbins-1; i++) {
+         count += counts[i];
+         for (j=0; j<3; j++) {
+            acc[2*j]   = TMath::Min(acc[2*j], binbounds[i][2*j]);
+            acc[2*j+1] = TMath::Max(acc[2*j+1], binbounds[i][2*j+1]);
+         }
+         if (!count || count == n) continue;
+         Double_t cost = count*HalfArea(acc) + rcost[i+1];
+         if (cost < best) {
+            best = cost;
+            split = i+1;
+         }
+      }
+      if (split) nleft = std::partition(indices, indices+n, [&](Int_t id) { return bin(id) < split; }) - indices;
+   }
+   // otherwise split at the median of the centers
+   if (nleft <= 0 || nleft >= n) {
+      nleft = n/2;
+      std::nth_element(indices, indices+nleft, indices+n, [&](Int_t a, Int_t b) { return center(a) < center(b); });
+   }
+   Build(first, nleft, depth+1);
+   Int_t right = Build(first+nleft, n-nleft, depth+1);
+   fLinks[2*inode]   = right;
+   fLinks[2*inode+1] = 0;
+   return inode;
+}
+
+} // anonymous namespace
+
+////////////////////////////////////////////////////////////////////////////////
+/// Default constructor
+
+TGeoBVHVoxelFinder::TGeoBVHVoxelFinder()
+{
+   fNnodes   = 0;
+   fNbounds  = 0;
+   fNlinks   = 0;
+   fNindices = 0;
+   fBounds   = 0;
+   fLinks    = 0;
+   fIndices  = 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Constructor for a volume. The hierarchy is built by Voxelize().
+
+TGeoBVHVoxelFinder::TGeoBVHVoxelFinder(TGeoVolume *vol)
+                   :TGeoVoxelFinder(vol)
+{
+   fNnodes   = 0;
+   fNbounds  = 0;
+   fNlinks   = 0;
+   fNindices = 0;
+   fBounds   = 0;
+   fLinks    = 0;
+   fIndices  = 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Destructor
+
+TGeoBVHVoxelFinder::~TGeoBVHVoxelFinder()
+{
+   ClearHierarchy();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Delete the hierarchy
+
+void TGeoBVHVoxelFinder::ClearHierarchy()
+{
+   if (fBounds) delete [] fBounds;
+   if (fLinks) delete [] fLinks;
+   if (fIndices) delete [] fIndices;
+   fBounds   = 0;
+   fLinks    = 0;
+   fIndices  = 0;
+   fNnodes   = 0;
+   fNbounds  = 0;
+   fNlinks   = 0;
+   fNindices = 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Check if point is inside the bounds of node inode
+
+Bool_t TGeoBVHVoxelFinder::NodeContains(Int_t inode, const Double_t *point) const
+{
+   const Float_t *b = &fBounds[6*inode];
+   return (point[0] >= b[0]) & (point[0] <= b[1]) &
+          (point[1] >= b[2]) & (point[1] <= b[3]) &
+          (point[2] >= b[4]) & (point[2] <= b[5]);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Distance along a ray to the bounds of node inode, zero if the point is inside
+/// and TGeoShape::Big() if the ray misses them. The components of invdir are the
+/// inverses of the director cosines, TGeoShape::Big() for null ones.
+
+Double_t TGeoBVHVoxelFinder::NodeDistance(Int_t inode, const Double_t *point, const Double_t *invdir) const
+{
+   const Float_t *b = &fBounds[6*inode];
+   Double_t tmin = 0.;
+   Double_t tmax = TGeoShape::Big();
+   for (Int_t j=0; j<3; j++) {
+      Double_t t1 = (b[2*j]-point[j])*invdir[j];
+      Double_t t2 = (b[2*j+1]-point[j])*invdir[j];
+      tmin = TMath::Max(tmin, TMath::Min(t1, t2));
+      tmax = TMath::Min(tmax, TMath::Max(t1, t2));
+   }
+   return (tmin <= tmax) ? tmin : TGeoShape::Big();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// get the list of daughter indices for which point is inside their bbox
+
+Int_t *TGeoBVHVoxelFinder::GetCheckList(const Double_t *point, Int_t &nelem, TGeoStateInfo &td)
+{
+   if (NeedRebuild()) {
+      Voxelize();
+      fVolume->FindOverlaps();
+   }
+   nelem = 0;
+   if (!fNnodes) return 0;
+   Int_t stack[kMaxDepth];
+   Int_t nstack = 0;
+   Int_t inode = 0;
+   while (1) {
+      if (NodeContains(inode, point)) {
+         Int_t n = fLinks[2*inode+1];
+         if (!n) {
+            stack[nstack++] = fLinks[2*inode];
+            inode++;
+            continue;
+         }
+         const Int_t *indices = &fIndices[fLinks[2*inode]];
+         for (Int_t i=0; i<n; i++) {
+            const Double_t *box = &fBoxes[6*indices[i]];
+            if (TMath::Abs(point[0]-box[3]) > box[0]) continue;
+            if (TMath::Abs(point[1]-box[4]) > box[1]) continue;
+            if (TMath::Abs(point[2]-box[5]) > box[2]) continue;
+            td.fVoxCheckList[nelem++] = indices[i];
+         }
+      }
+      if (!nstack) break;
+      inode = stack[--nstack];
+   }
+   if (!nelem) return 0;
+   // same order as for the voxels
+   std::sort(td.fVoxCheckList, td.fVoxCheckList+nelem);
+   return td.fVoxCheckList;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// All the candidates crossed by a ray are returned by the first call to
+/// GetNextVoxel(), so there are no further candidates.
+
+Int_t *TGeoBVHVoxelFinder::GetNextCandidates(const Double_t * /*point*/, Int_t &ncheck, TGeoStateInfo & /*td*/)
+{
+   ncheck = 0;
+   return 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// create the list of nodes for which the bboxes overlap with inode's bbox
+
+void TGeoBVHVoxelFinder::FindOverlaps(Int_t inode) const
+{
+   if (!fBoxes || !fNnodes) return;
+   Int_t nd = fVolume->GetNdaughters();
+   TGeoNode *node = fVolume->GetNode(inode);
+   const Double_t *box = &fBoxes[6*inode];
+   Int_t *otmp = new Int_t[nd];
+   Int_t novlp = 0;
+   Int_t stack[kMaxDepth];
+   Int_t nstack = 0;
+   Int_t ibvh = 0;
+   while (1) {
+      const Float_t *b = &fBounds[6*ibvh];
+      if ((box[3]+box[0] >= b[0]) && (box[3]-box[0] <= b[1]) &&
+          (box[4]+box[1] >= b[2]) && (box[4]-box[1] <= b[3]) &&
+          (box[5]+box[2] >= b[4]) && (box[5]-box[2] <= b[5])) {
+         Int_t n = fLinks[2*ibvh+1];
+         if (!n) {
+            stack[nstack++] = fLinks[2*ibvh];
+            ibvh++;
+            continue;
+         }
+         const Int_t *indices = &fIndices[fLinks[2*ibvh]];
+         for (Int_t i=0; i<n; i++) {
+            Int_t ib = indices[i];
+            if (ib == inode) continue; // everyone overlaps with itself
+            const Double_t *other = &fBoxes[6*ib];
+            // strict overlap on each axis, as for the voxels
+            Bool_t overlap = kTRUE;
+            for (Int_t j=0; j<3 && overlap; j++) {
+               Double_t ddx1 = box[3+j]+box[j] - (other[3+j]-other[j]);
+               Double_t ddx2 = other[3+j]+other[j] - (box[3+j]-box[j]);
+               if (ddx1*ddx2 <= 0.) overlap = kFALSE;
+            }
+            if (overlap) otmp[novlp++] = ib;
+         }
+      }
+      if (!nstack) break;
+      ibvh = stack[--nstack];
+   }
+   if (!novlp) {
+      delete [] otmp;
+      node->SetOverlaps(0, 0);
+      return;
+   }
+   std::sort(otmp, otmp+novlp);
+   Int_t *ovlps = new Int_t[novlp];
+   memcpy(ovlps, otmp, novlp*sizeof(Int_t));
+   delete [] otmp;
+   node->SetOverlaps(ovlps, novlp);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Print the hierarchy statistics
+
+void TGeoBVHVoxelFinder::Print(Option_t *) const
+{
+   if (NeedRebuild()) {
+      TGeoBVHVoxelFinder *vox = (TGeoBVHVoxelFinder*)this;
+      vox->Voxelize();
+      fVolume->FindOverlaps();
+   }
+   Int_t nleaves = 0;
+   Int_t maxdepth = 0;
+   if (fNnodes) {
+      Int_t stack[2*kMaxDepth];
+      Int_t nstack = 0;
+      Int_t inode = 0;
+      Int_t depth = 1;
+      while (1) {
+         maxdepth = TMath::Max(maxdepth, depth);
+         if (!fLinks[2*inode+1]) {
+            stack[nstack++] = fLinks[2*inode];
+            stack[nstack++] = depth+1;
+            inode++;
+            depth++;
+            continue;
+         }
+         nleaves++;
+         if (!nstack) break;
+         depth = stack[--nstack];
+         inode = stack[--nstack];
+      }
+   }
+   printf("BVH for volume %s (nd=%i)\n", fVolume->GetName(), fVolume->GetNdaughters());
+   printf("nodes : %i  leaves : %i  depth : %i\n", fNnodes, nleaves, maxdepth);
+   printf("memory : %i bytes\n", Int_t(fNbounds*sizeof(Float_t) + (fNlinks+fNindices)*sizeof(Int_t)));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// get the list of candidates crossed by the current ray, filled by SortCrossedVoxels()
+
+Int_t *TGeoBVHVoxelFinder::GetNextVoxel(const Double_t * /*point*/, const Double_t * /*dir*/, Int_t &ncheck, TGeoStateInfo &td)
+{
+   ncheck = 0;
+   if (td.fVoxCurrent) return 0;
+   td.fVoxCurrent++;
+   ncheck = td.fVoxNcandidates;
+   return ncheck ? td.fVoxCheckList : 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Collect the daughters whose bbox is crossed by the ray from point along dir
+/// within step, nearest nodes of the hierarchy first.
+
+void TGeoBVHVoxelFinder::SortCrossedVoxels(const Double_t *point, const Double_t *dir, TGeoStateInfo &td, Double_t step)
+{
+   if (NeedRebuild()) {
+      Voxelize();
+      fVolume->FindOverlaps();
+   }
+   td.fVoxCurrent = 0;
+   td.fVoxNcandidates = 0;
+   if (!fNnodes) return;
+   Int_t i;
+   for (i=0; i<3; i++) td.fVoxInvdir[i] = (dir[i] != 0) ? 1./dir[i] : TGeoShape::Big();
+   const Double_t *invdir = td.fVoxInvdir;
+   if (NodeDistance(0, point, invdir) > step) return;
+   Int_t stack[kMaxDepth];
+   Int_t nstack = 0;
+   Int_t inode = 0;
+   while (1) {
+      Int_t n = fLinks[2*inode+1];
+      if (n) {
+         const Int_t *indices = &fIndices[fLinks[2*inode]];
+         for (i=0; i<n; i++) {
+            // exact box of the daughter
+            const Double_t *box = &fBoxes[6*indices[i]];
+            Double_t tmin = 0.;
+            Double_t tmax = TGeoShape::Big();
+            for (Int_t j=0; j<3; j++) {
+               Double_t t1 = (box[3+j]-box[j]-point[j])*invdir[j];
+               Double_t t2 = (box[3+j]+box[j]-point[j])*invdir[j];
+               tmin = TMath::Max(tmin, TMath::Min(t1, t2));
+               tmax = TMath::Min(tmax, TMath::Max(t1, t2));
+            }
+            if (tmin <= tmax && tmin <= step) td.fVoxCheckList[td.fVoxNcandidates++] = indices[i];
+         }
+      } else {
+         // test both children and visit the nearest one first
+         Int_t left = inode+1;
+         Int_t right = fLinks[2*inode];
+         Double_t dleft = NodeDistance(left, point, invdir);
+         Double_t dright = NodeDistance(right, point, invdir);
+         Bool_t hitleft = dleft <= step;
+         Bool_t hitright = dright <= step;
+         if (hitleft && hitright) {
+            if (dright < dleft) std::swap(left, right);
+            stack[nstack++] = right;
+            inode = left;
+            continue;
+         }
+         if (hitleft || hitright) {
+            inode = hitleft ? left : right;
+            continue;
+         }
+      }
+      if (!nstack) break;
+      inode = stack[--nstack];
+   }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Build the hierarchy of the bounding boxes of the daughters.
+/// If the volume is an assembly, make sure the bbox is computed.
+
+void TGeoBVHVoxelFinder::Voxelize(Option_t * /*option*/)
+{
+   if (fVolume->IsAssembly()) fVolume->GetShape()->ComputeBBox();
+   Int_t nd = fVolume->GetNdaughters();
+   TGeoVolume *vd;
+   for (Int_t i=0; i<nd; i++) {
+      vd = fVolume->GetNode(i)->GetVolume();
+      if (vd->IsAssembly()) vd->GetShape()->ComputeBBox();
+   }
+   BuildVoxelLimits();
+   ClearHierarchy();
+   if (nd) {
+      TGeoBVHBuilder builder;
+      builder.fBoxes = fBoxes;
+      builder.fIndices.resize(nd);
+      for (Int_t i=0; i<nd; i++) builder.fIndices[i] = i;
+      builder.Build(0, nd, 0);
+      fNnodes   = builder.fLinks.size()/2;
+      fNbounds  = builder.fBounds.size();
+      fNlinks   = builder.fLinks.size();
+      fNindices = nd;
+      fBounds   = new Float_t[fNbounds];
+      fLinks    = new Int_t[fNlinks];
+      fIndices  = new Int_t[fNindices];
+      std::copy(builder.fBounds.begin(), builder.fBounds.end(), fBounds);
+      std::copy(builder.fLinks.begin(), builder.fLinks.end(), fLinks);
+      std::copy(builder.fIndices.begin(), builder.fIndices.end(), fIndices);
+   }
+   SetNeedRebuild(kFALSE);
+}
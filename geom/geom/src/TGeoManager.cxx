@@ -283,6 +283,12 @@ in order to enhance rays.
 #include "TGeoRegion.h"
 #include "TGDMLMatrix.h"
 #include "TGeoOpticalSurface.h"
+#include "TGeoShapeAssembly.h"
+
+#include <atomic>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
 
 // statics and globals
 
@@ -299,9 +305,18 @@ Int_t  TGeoManager::fgMaxDaughters    = 1;
 Int_t  TGeoManager::fgMaxXtruVert     = 1;
 Int_t  TGeoManager::fgNumThreads      = 0;
 UInt_t TGeoManager::fgExportPrecision = 17;
+Int_t  TGeoManager::fgBVHThreshold    = 0;
 TGeoManager::EDefaultUnits TGeoManager::fgDefaultUnits = TGeoManager::kRootUnits;
 TGeoManager::ThreadsMap_t *TGeoManager::fgThreadId = 0;
 static Bool_t gGeometryLocked = kTRUE;
+// Incremented when the map of thread ids is cleared, invalidating the ids cached by the threads
+static std::atomic<UInt_t> gThreadsGeneration(0);
+// Incremented when navigator arrays are added or removed, invalidating the arrays cached by the threads
+static std::atomic<UInt_t> gNavigatorsGeneration(0);
+// Protect the map of thread ids and the maps of navigators. They are locked only around the accesses to the maps,
+// so that the lookups can be done while fgMutex is held, e.g. by the navigators created in AddNavigator.
+static std::mutex gThreadIdMutex;
+static std::mutex gNavigatorsMutex;
 
 ////////////////////////////////////////////////////////////////////////////////
 /// Default constructor.
@@ -719,12 +734,12 @@ TGeoNavigator *TGeoManager::AddNavigator()
 {
    if (fMultiThread) { TGeoManager::ThreadId(); fgMutex.lock(); }
    std::thread::id threadId = std::this_thread::get_id();
-   NavigatorsMap_t::const_iterator it = fNavigators.find(threadId);
-   TGeoNavigatorArray *array = 0;
-   if (it != fNavigators.end()) array = it->second;
-   else {
+   TGeoNavigatorArray *array = GetListOfNavigators();
+   if (!array) {
       array = new TGeoNavigatorArray(this);
+      std::lock_guard<std::mutex> guard(gNavigatorsMutex);
       fNavigators.insert(NavigatorsMap_t::value_type(threadId, array));
+      gNavigatorsGeneration++;
    }
    TGeoNavigator *nav = array->AddNavigator();
    if (fClosed) nav->GetCache()->BuildInfoBranch();
@@ -737,28 +752,32 @@ TGeoNavigator *TGeoManager::AddNavigator()
 
 TGeoNavigator *TGeoManager::GetCurrentNavigator() const
 {
-   TTHREAD_TLS(TGeoNavigator*) tnav = 0;
    if (!fMultiThread) return fCurrentNavigator;
-   TGeoNavigator *nav = tnav; // TTHREAD_TLS_GET(TGeoNavigator*,tnav);
-   if (nav) return nav;
-   std::thread::id threadId = std::this_thread::get_id();
-   NavigatorsMap_t::const_iterator it = fNavigators.find(threadId);
-   if (it == fNavigators.end()) return 0;
-   TGeoNavigatorArray *array = it->second;
-   nav = array->GetCurrentNavigator();
-   tnav = nav; // TTHREAD_TLS_SET(TGeoNavigator*,tnav,nav);
-   return nav;
+   TGeoNavigatorArray *array = GetListOfNavigators();
+   return array ? array->GetCurrentNavigator() : 0;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 /// Get list of navigators for the calling thread.
+/// The array is cached by the thread, so that only the first call after navigator
+/// arrays were added or removed looks up the map under the lock.
 
 TGeoNavigatorArray *TGeoManager::GetListOfNavigators() const
 {
-   std::thread::id threadId = std::this_thread::get_id();
-   NavigatorsMap_t::const_iterator it = fNavigators.find(threadId);
-   if (it == fNavigators.end()) return 0;
-   TGeoNavigatorArray *array = it->second;
+   TTHREAD_TLS(const TGeoManager*) tmanager = 0;
+   TTHREAD_TLS(TGeoNavigatorArray*) tarray = 0;
+   TTHREAD_TLS(UInt_t) tgeneration = 0;
+   UInt_t generation = gNavigatorsGeneration.load(std::memory_order_acquire);
+   if (tarray && tmanager == this && tgeneration == generation) return tarray;
+   TGeoNavigatorArray *array = 0;
+   {
+      std::lock_guard<std::mutex> guard(gNavigatorsMutex);
+      NavigatorsMap_t::const_iterator it = fNavigators.find(std::this_thread::get_id());
+      if (it != fNavigators.end()) array = it->second;
+   }
+   tmanager = this;
+   tarray = array;
+   tgeneration = generation;
    return array;
 }
 
@@ -768,13 +787,12 @@ TGeoNavigatorArray *TGeoManager::GetListOfNavigators() const
 Bool_t TGeoManager::SetCurrentNavigator(Int_t index)
 {
    std::thread::id threadId = std::this_thread::get_id();
-   NavigatorsMap_t::const_iterator it = fNavigators.find(threadId);
-   if (it == fNavigators.end()) {
+   TGeoNavigatorArray *array = GetListOfNavigators();
+   if (!array) {
       Error("SetCurrentNavigator", "No navigator defined for this thread\n");
       std::cout << "  thread id: " << threadId << std::endl;
       return kFALSE;
    }
-   TGeoNavigatorArray *array = it->second;
    TGeoNavigator *nav = array->SetCurrentNavigator(index);
    if (!nav) {
       Error("SetCurrentNavigator", "Navigator %d not existing for this thread\n", index);
@@ -805,7 +823,11 @@ void TGeoManager::ClearNavigators()
       arr = (*it).second;
       if (arr) delete arr;
    }
-   fNavigators.clear();
+   {
+      std::lock_guard<std::mutex> guard(gNavigatorsMutex);
+      fNavigators.clear();
+      gNavigatorsGeneration++;
+   }
    if (fMultiThread) fgMutex.unlock();
 }
 
@@ -820,7 +842,11 @@ void TGeoManager::RemoveNavigator(const TGeoNavigator *nav)
       if (arr) {
          if ((TGeoNavigator*)arr->Remove((TObject*)nav)) {
             delete nav;
-            if (!arr->GetEntries()) fNavigators.erase(it);
+            if (!arr->GetEntries()) {
+               std::lock_guard<std::mutex> guard(gNavigatorsMutex);
+               fNavigators.erase(it);
+               gNavigatorsGeneration++;
+            }
             if (fMultiThread) fgMutex.unlock();
             return;
          }
@@ -842,6 +868,7 @@ void TGeoManager::SetMaxThreads(Int_t nthreads)
    if (!fMultiThread) {
       ROOT::EnableThreadSafety();
       std::thread::id threadId = std::this_thread::get_id();
+      std::lock_guard<std::mutex> guard(gNavigatorsMutex);
       NavigatorsMap_t::const_iterator it = fNavigators.find(threadId);
       if (it != fNavigators.end()) {
          TGeoNavigatorArray *array = it->second;
@@ -892,32 +919,37 @@ void TGeoManager::CreateThreadData() const
 void TGeoManager::ClearThreadsMap()
 {
    if (gGeoManager && !gGeoManager->IsMultiThread()) return;
-   fgMutex.lock();
+   std::lock_guard<std::mutex> guard(gThreadIdMutex);
    if (!fgThreadId->empty()) fgThreadId->clear();
    fgNumThreads = 0;
-   fgMutex.unlock();
+   gThreadsGeneration++;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 /// Translates the current thread id to an ordinal number. This can be used to
 /// manage data which is specific for a given thread.
+/// The id is cached by the thread, so that only the first call after the map of
+/// threads was cleared looks up the map under the lock.
 
 Int_t TGeoManager::ThreadId()
 {
    TTHREAD_TLS(Int_t) tid = -1;
-   Int_t ttid = tid; // TTHREAD_TLS_GET(Int_t,tid);
-   if (ttid > -1) return ttid;
+   TTHREAD_TLS(UInt_t) tgeneration = 0;
+   UInt_t generation = gThreadsGeneration.load(std::memory_order_acquire);
+   if (tid > -1 && tgeneration == generation) return tid;
    if (gGeoManager && !gGeoManager->IsMultiThread()) return 0;
    std::thread::id threadId = std::this_thread::get_id();
+   std::lock_guard<std::mutex> guard(gThreadIdMutex);
    TGeoManager::ThreadsMapIt_t it = fgThreadId->find(threadId);
-   if (it != fgThreadId->end()) return it->second;
-   // Map needs to be updated.
-   fgMutex.lock();
-   (*fgThreadId)[threadId] = fgNumThreads;
-   tid = fgNumThreads; // TTHREAD_TLS_SET(Int_t,tid,fgNumThreads);
-   ttid = fgNumThreads++;
-   fgMutex.unlock();
-   return ttid;
+   if (it != fgThreadId->end()) {
+      tid = it->second;
+   } else {
+      // Map needs to be updated.
+      (*fgThreadId)[threadId] = fgNumThreads;
+      tid = fgNumThreads++;
+   }
+   tgeneration = generation;
+   return tid;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -2879,20 +2911,49 @@ void TGeoManager::RestoreMasterVolume()
 
 ////////////////////////////////////////////////////////////////////////////////
 /// Voxelize all non-divided volumes.
+/// The volumes are voxelized concurrently if implicit multi-threading is enabled.
 
 void TGeoManager::Voxelize(Option_t *option)
 {
    TGeoVolume *vol;
-//   TGeoVoxelFinder *vox = 0;
    if (!fStreamVoxels && fgVerboseLevel>0) Info("Voxelize","Voxelizing...");
-//   Int_t nentries = fVolumes->GetSize();
+   // The voxels of a volume use the bounding boxes of its daughters, so the nodes are
+   // sorted and the boxes of the assemblies computed before voxelizing
    TIter next(fVolumes);
    while ((vol = (TGeoVolume*)next())) {
       if (!fIsGeomReading) vol->SortNodes();
-      if (!fStreamVoxels) {
-         vol->Voxelize(option);
+      if (vol->IsAssembly()) vol->GetShape()->ComputeBBox();
+   }
+   // A task modifies its volume and the overlaps of its daughter nodes. The volumes sharing
+   // nodes with other volumes (clones) and those which would compute again the box of an assembly
+   // (it is rewritten unless it is valid) are therefore voxelized serially after the others.
+   Int_t nvol = fVolumes->GetEntriesFast();
+   std::vector<Bool_t> serial(nvol, kFALSE);
+   std::unordered_map<const TGeoNode*, Int_t> owner;
+   for (Int_t i=0; i<nvol; i++) {
+      vol = (TGeoVolume*)fVolumes->At(i);
+      if (!vol) continue;
+      if (vol->IsAssembly() && !((TGeoShapeAssembly*)vol->GetShape())->IsBBoxOK()) serial[i] = kTRUE;
+      Int_t nd = vol->GetNdaughters();
+      for (Int_t id=0; id<nd; id++) {
+         TGeoNode *node = vol->GetNode(id);
+         TGeoVolume *vd = node->GetVolume();
+         if (vd && vd->IsAssembly() && !((TGeoShapeAssembly*)vd->GetShape())->IsBBoxOK()) serial[i] = kTRUE;
+         auto res = owner.emplace(node, i);
+         if (!res.second && res.first->second != i) serial[i] = serial[res.first->second] = kTRUE;
       }
-      if (!fIsGeomReading) vol->FindOverlaps();
+   }
+   auto voxelizeVolume = [this, option](TGeoVolume *v) {
+      if (!fStreamVoxels) v->Voxelize(option);
+      if (!fIsGeomReading) v->FindOverlaps();
+   };
+   auto voxelize = [this, &serial, &voxelizeVolume](UInt_t i) {
+      TGeoVolume *v = (TGeoVolume*)fVolumes->At(i);
+      if (v && !serial[i]) voxelizeVolume(v);
+   };
+   ROOT::Internal::ForEachInImplicitMTPool(nvol, voxelize);
+   for (Int_t i=0; i<nvol; i++) {
+      if (serial[i]) voxelizeVolume((TGeoVolume*)fVolumes->At(i));
    }
 }
 
@@ -3688,7 +3749,8 @@ void TGeoManager::ExecuteEvent(Int_t event, Int_t px, Int_t py)
 ///  - Case 1: root file or root/xml file
 ///    if filename end with ".root". The key will be named name
 ///    By default the geometry is saved without the voxelisation info.
-///    Use option 'v" to save the voxelisation info.
+///    Use option 'v" to save the voxelisation info, including the bounding volume
+///    hierarchies, so that closing the geometry read from the file does not rebuild them.
 ///    if filename end with ".xml" a root/xml file is produced.
 ///
 ///  - Case 2: C++ script
@@ -42,6 +42,9 @@ gGeoManager->SetCurrentNavigator(0);
 #include "TMath.h"
 #include "TGeoParallelWorld.h"
 #include "TGeoPhysicalNode.h"
+#include "TGeoBBox.h"
+
+#include <vector>
 
 static Double_t gTolerance = TGeoShape::Tolerance();
 const char *kGeoOutsidePath = " ";
@@ -1066,7 +1069,7 @@ TGeoNode *TGeoNavigator::FindNextDaughterBoundary(Double_t *point, Double_t *dir
    Int_t sumchecked = 0;
    Int_t *vlist = 0;
    TGeoStateInfo &info = *fCache->GetInfo();
-   voxels->SortCrossedVoxels(point, dir, info);
+   voxels->SortCrossedVoxels(point, dir, info, fStep);
    while ((sumchecked<nd) && (vlist=voxels->GetNextVoxel(point, dir, ncheck, info))) {
       for (i=0; i<ncheck; i++) {
          current = vol->GetNode(vlist[i]);
@@ -1114,6 +1117,69 @@ TGeoNode *TGeoNavigator::FindNextDaughterBoundary(Double_t *point, Double_t *dir
    return nodefound;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Computes the distances to the next boundary of a basket of tracks located in the
+/// current volume, without changing the state of the navigator.
+/// Input: points and directions of the tracks in the master frame, as consecutive
+///        triplets (x,y,z), number of tracks and maximum step
+/// Output: steps - distances to the next boundary
+///         idaughters - index of the daughter of the current volume entered first,
+///                      or -1 if the track exits the current volume
+///
+/// The distances are computed with the vectorized shape methods on the whole basket:
+/// the distance to exit the current volume, then for each daughter the distance to
+/// enter it for the tracks reaching its bounding box before their current step. The
+/// daughters are only checked up to stepmax, so a step larger than stepmax is the
+/// distance to exit the current volume. Overlapping (MANY) nodes, the voxels of the
+/// current volume and the parallel world are not considered: the result is the one of
+/// FindNextBoundary() for geometries without overlaps.
+
+void TGeoNavigator::FindNextBoundary_v(Int_t ntracks, const Double_t *points, const Double_t *dirs, Double_t *steps,
+                                       Int_t *idaughters, Double_t stepmax) const
+{
+   if (ntracks <= 0) return;
+   TGeoVolume *vol = fCurrentNode->GetVolume();
+   const TGeoHMatrix *mat = fCache->GetCurrentMatrix();
+   std::vector<Double_t> lpoints(3*ntracks), ldirs(3*ntracks);
+   for (Int_t i=0; i<ntracks; i++) {
+      mat->MasterToLocal(&points[3*i], &lpoints[3*i]);
+      mat->MasterToLocalVect(&dirs[3*i], &ldirs[3*i]);
+   }
+   std::vector<Double_t> limits(ntracks, stepmax);
+   vol->GetShape()->DistFromInside_v(lpoints.data(), ldirs.data(), steps, ntracks, limits.data());
+   for (Int_t i=0; i<ntracks; i++) idaughters[i] = -1;
+
+   Int_t nd = vol->GetNdaughters();
+   if (!nd) return;
+   // tracks reaching the bounding box of the daughter, in the daughter frame
+   std::vector<Double_t> dpoints(3*ntracks), ddirs(3*ntracks), dists(ntracks);
+   std::vector<Int_t> selected(ntracks);
+   for (Int_t id=0; id<nd; id++) {
+      TGeoNode *node = vol->GetNode(id);
+      TGeoMatrix *dmat = node->GetMatrix();
+      TGeoShape *shape = node->GetVolume()->GetShape();
+      TGeoBBox *box = (TGeoBBox*)shape;
+      Int_t nsel = 0;
+      for (Int_t i=0; i<ntracks; i++) {
+         Double_t *dpoint = &dpoints[3*nsel];
+         Double_t *ddir = &ddirs[3*nsel];
+         Double_t limit = TMath::Min(steps[i], stepmax);
+         dmat->MasterToLocal(&lpoints[3*i], dpoint);
+         dmat->MasterToLocalVect(&ldirs[3*i], ddir);
+         if (TGeoBBox::DistFromOutside(dpoint, ddir, box->GetDX(), box->GetDY(), box->GetDZ(), box->GetOrigin(), limit) >= limit) continue;
+         limits[nsel] = limit;
+         selected[nsel++] = i;
+      }
+      if (!nsel) continue;
+      shape->DistFromOutside_v(dpoints.data(), ddirs.data(), dists.data(), nsel, limits.data());
+      for (Int_t j=0; j<nsel; j++) {
+         if (dists[j] >= limits[j]) continue;
+         steps[selected[j]] = dists[j];
+         idaughters[selected[j]] = id;
+      }
+   }
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Compute distance to next boundary within STEPMAX. If no boundary is found,
 /// propagate current point along current direction with fStep=STEPMAX. Otherwise
@@ -400,6 +400,7 @@ volumes (or volume assemblies) as content.
 #include "TGeoScaledShape.h"
 #include "TGeoCompositeShape.h"
 #include "TGeoVoxelFinder.h"
+#include "TGeoBVHVoxelFinder.h"
 #include "TGeoExtension.h"
 
 ClassImp(TGeoVolume);
@@ -1743,7 +1744,8 @@ TGeoVolume *TGeoVolume::CloneVolume() const
    // copy voxels
    TGeoVoxelFinder *voxels = 0;
    if (fVoxels) {
-      voxels = new TGeoVoxelFinder(vol);
+      if (fVoxels->InheritsFrom(TGeoBVHVoxelFinder::Class())) voxels = new TGeoBVHVoxelFinder(vol);
+      else                                                    voxels = new TGeoVoxelFinder(vol);
       vol->SetVoxelFinder(voxels);
    }
    // copy option, uid
@@ -2312,13 +2314,17 @@ void TGeoVolume::Voxelize(Option_t *option)
    if (!nd) return;
    // If this is an assembly, re-compute bounding box
    if (IsAssembly()) fShape->ComputeBBox();
+   // A volume given a BVH finder keeps it, the others use it above the global threshold
+   Int_t nbvh = TGeoManager::GetBVHThreshold();
+   Bool_t bvh = fVoxels ? fVoxels->InheritsFrom(TGeoBVHVoxelFinder::Class()) : (nbvh > 0 && nd >= nbvh);
    // delete old voxelization if any
    if (fVoxels) {
       if (!TObject::TestBit(kVolumeClone)) delete fVoxels;
       fVoxels = 0;
    }
    // Create the voxels structure
-   fVoxels = new TGeoVoxelFinder(this);
+   if (bvh) fVoxels = new TGeoBVHVoxelFinder(this);
+   else     fVoxels = new TGeoVoxelFinder(this);
    fVoxels->Voxelize(option);
    if (fVoxels) {
       if (fVoxels->IsInvalid()) {
@@ -2846,7 +2852,8 @@ TGeoVolume *TGeoVolumeAssembly::CloneVolume() const
    // copy voxels
    TGeoVoxelFinder *voxels = 0;
    if (fVoxels) {
-      voxels = new TGeoVoxelFinder(vol);
+      if (fVoxels->InheritsFrom(TGeoBVHVoxelFinder::Class())) voxels = new TGeoBVHVoxelFinder(vol);
+      else                                                    voxels = new TGeoVoxelFinder(vol);
       vol->SetVoxelFinder(voxels);
    }
    // copy option, uid
@@ -2931,7 +2938,8 @@ TGeoVolumeAssembly *TGeoVolumeAssembly::MakeAssemblyFromVolume(TGeoVolume *volor
    // copy voxels
    TGeoVoxelFinder *voxels = 0;
    if (volorig->GetVoxels()) {
-      voxels = new TGeoVoxelFinder(vol);
+      if (volorig->GetVoxels()->InheritsFrom(TGeoBVHVoxelFinder::Class())) voxels = new TGeoBVHVoxelFinder(vol);
+      else                                                                 voxels = new TGeoVoxelFinder(vol);
       vol->SetVoxelFinder(voxels);
    }
    // copy option, uid
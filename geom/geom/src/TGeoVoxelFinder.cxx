@@ -1067,8 +1067,9 @@ Int_t *TGeoVoxelFinder::GetNextCandidates(const Double_t *point, Int_t &ncheck,
 
 ////////////////////////////////////////////////////////////////////////////////
 /// get the list in the next voxel crossed by a ray
+/// The step limit is not used by the voxels.
 
-void TGeoVoxelFinder::SortCrossedVoxels(const Double_t *point, const Double_t *dir, TGeoStateInfo &td)
+void TGeoVoxelFinder::SortCrossedVoxels(const Double_t *point, const Double_t *dir, TGeoStateInfo &td, Double_t /*step*/)
 {
    if (NeedRebuild()) {
       TGeoVoxelFinder *vox = (TGeoVoxelFinder*)this;
@@ -0,0 +1,160 @@
+#include "TGeoBVHVoxelFinder.h"
+#include "TGeoCache.h"
+#include "TGeoManager.h"
+#include "TGeoMaterial.h"
+#include "TGeoMatrix.h"
+#include "TGeoMedium.h"
+#include "TGeoNavigator.h"
+#include "TGeoNode.h"
+#include "TGeoShape.h"
+#include "TGeoVolume.h"
+#include "TGeoVoxelFinder.h"
+
+#include "gtest/gtest.h"
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <set>
+#include <string>
+#include <vector>
+
+namespace {
+
+// Spheres on two interleaved lattices: they do not touch, but the bounding box of each one overlaps with the ones
+// of its 8 neighbours on the other lattice. The second lattice is declared as overlapping, so that its overlaps
+// are searched.
+TGeoManager *MakeGeometry(Int_t bvhThreshold)
+{
+   TGeoManager::SetBVHThreshold(bvhThreshold);
+   auto geom = new TGeoManager("bvhgeom", "BVH voxel finder test");
+   auto mat = new TGeoMaterial("Al", 26.98, 13, 2.7);
+   auto med = new TGeoMedium("Al", 1, mat);
+   auto top = geom->MakeBox("TOP", med, 30, 30, 30);
+   geom->SetTopVolume(top);
+   auto sphere = geom->MakeSphere("SPHERE", med, 0, 4);
+   Int_t copy = 0;
+   for (Int_t i = 0; i < 5; ++i)
+      for (Int_t j = 0; j < 5; ++j)
+         for (Int_t k = 0; k < 5; ++k)
+            top->AddNode(sphere, copy++, new TGeoTranslation(10. * i - 20, 10. * j - 20, 10. * k - 20));
+   for (Int_t i = 0; i < 4; ++i)
+      for (Int_t j = 0; j < 4; ++j)
+         for (Int_t k = 0; k < 4; ++k)
+            top->AddNodeOverlap(sphere, copy++, new TGeoTranslation(10. * i - 15, 10. * j - 15, 10. * k - 15));
+   geom->SetVerboseLevel(0);
+   geom->CloseGeometry();
+   TGeoManager::SetBVHThreshold(0);
+   return geom;
+}
+
+struct Result_t {
+   std::vector<std::vector<Int_t>> fOverlaps; // overlapping bounding boxes of each daughter
+   std::vector<std::string> fPaths;           // paths found at the points
+   std::vector<std::string> fNextPaths;       // paths after crossing the next boundary
+   std::vector<Double_t> fSteps;              // distances to the next boundary
+};
+
+// The daughters of the top volume crossed by the ray (point, dir), or which contain point if dir is null
+std::set<Int_t> CrossedDaughters(TGeoVolume *top, const Double_t *point, const Double_t *dir)
+{
+   std::set<Int_t> res;
+   for (Int_t i = 0; i < top->GetNdaughters(); ++i) {
+      TGeoNode *node = top->GetNode(i);
+      Double_t lpoint[3], ldir[3];
+      node->MasterToLocal(point, lpoint);
+      TGeoShape *shape = node->GetVolume()->GetShape();
+      if (!dir) {
+         if (shape->Contains(lpoint))
+            res.insert(i);
+         continue;
+      }
+      node->MasterToLocalVect(dir, ldir);
+      if (shape->Contains(lpoint) || shape->DistFromOutside(lpoint, ldir) < TGeoShape::Big())
+         res.insert(i);
+   }
+   return res;
+}
+
+// Navigate the geometry at random points and directions. The candidates returned by the voxel finder of the top
+// volume must include all daughters containing the point and all daughters crossed by the ray.
+Result_t Navigate(TGeoManager *geom)
+{
+   Result_t res;
+   TGeoVolume *top = geom->GetTopVolume();
+   for (Int_t i = 0; i < top->GetNdaughters(); ++i) {
+      Int_t novlp = 0;
+      Int_t *ovlp = top->GetNode(i)->GetOverlaps(novlp);
+      res.fOverlaps.emplace_back(ovlp, ovlp + novlp);
+   }
+
+   TGeoVoxelFinder *voxels = top->GetVoxels();
+   TGeoNodeCache *cache = geom->GetCurrentNavigator()->GetCache();
+   std::mt19937 gen(1234);
+   std::uniform_real_distribution<Double_t> coord(-29.9, 29.9);
+   std::normal_distribution<Double_t> gaus;
+   for (Int_t n = 0; n < 2000; ++n) {
+      Double_t point[3] = {coord(gen), coord(gen), coord(gen)};
+      Double_t dir[3] = {gaus(gen), gaus(gen), gaus(gen)};
+      const Double_t norm = std::sqrt(dir[0] * dir[0] + dir[1] * dir[1] + dir[2] * dir[2]);
+      for (auto &d : dir)
+         d /= norm;
+
+      TGeoStateInfo &td = *cache->GetInfo();
+      Int_t nelem = 0;
+      Int_t *list = voxels->GetCheckList(point, nelem, td);
+      std::set<Int_t> candidates;
+      if (list)
+         candidates.insert(list, list + nelem);
+      for (Int_t i : CrossedDaughters(top, point, nullptr))
+         EXPECT_TRUE(candidates.count(i)) << "daughter " << i << " containing the point is not a candidate";
+
+      candidates.clear();
+      geom->SetStep(TGeoShape::Big());
+      voxels->SortCrossedVoxels(point, dir, td);
+      Int_t ncheck = 0;
+      while ((list = voxels->GetNextVoxel(point, dir, ncheck, td)))
+         candidates.insert(list, list + ncheck);
+      cache->ReleaseInfo();
+      for (Int_t i : CrossedDaughters(top, point, dir))
+         EXPECT_TRUE(candidates.count(i)) << "daughter " << i << " crossed by the ray is not a candidate";
+
+      geom->SetCurrentPoint(point);
+      geom->SetCurrentDirection(dir);
+      geom->FindNode();
+      res.fPaths.push_back(geom->GetPath());
+      geom->FindNextBoundary();
+      res.fSteps.push_back(geom->GetStep());
+      geom->FindNextBoundaryAndStep();
+      res.fNextPaths.push_back(geom->GetPath());
+   }
+   return res;
+}
+
+} // namespace
+
+// The BVH voxel finder gives the same navigation as the regular one, in a volume with many daughters whose
+// bounding boxes overlap
+TEST(TGeoBVHVoxelFinder, CompareWithVoxelFinder)
+{
+   auto geom = MakeGeometry(0);
+   EXPECT_FALSE(geom->GetTopVolume()->GetVoxels()->InheritsFrom(TGeoBVHVoxelFinder::Class()));
+   auto voxelResult = Navigate(geom);
+   delete geom;
+
+   geom = MakeGeometry(10);
+   ASSERT_TRUE(geom->GetTopVolume()->GetVoxels()->InheritsFrom(TGeoBVHVoxelFinder::Class()));
+   auto bvhResult = Navigate(geom);
+   delete geom;
+
+   EXPECT_EQ(voxelResult.fOverlaps, bvhResult.fOverlaps);
+   EXPECT_EQ(voxelResult.fPaths, bvhResult.fPaths);
+   EXPECT_EQ(voxelResult.fNextPaths, bvhResult.fNextPaths);
+   ASSERT_EQ(voxelResult.fSteps.size(), bvhResult.fSteps.size());
+   for (std::size_t i = 0; i < voxelResult.fSteps.size(); ++i)
+      EXPECT_DOUBLE_EQ(voxelResult.fSteps[i], bvhResult.fSteps[i]) << "at point " << i;
+
+   // each sphere of the second lattice has the 8 neighbours of the first one
+   EXPECT_EQ(8u, bvhResult.fOverlaps[125].size()); // at (-15, -15, -15)
+   EXPECT_TRUE(bvhResult.fOverlaps[0].empty());
+}
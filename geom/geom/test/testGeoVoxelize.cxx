@@ -0,0 +1,98 @@
+#include "TGeoManager.h"
+#include "TGeoMaterial.h"
+#include "TGeoMedium.h"
+#include "TGeoVolume.h"
+#include "TGeoNode.h"
+#include "TGeoMatrix.h"
+#include "TROOT.h"
+
+#include "gtest/gtest.h"
+
+#include <string>
+#include <vector>
+
+namespace {
+
+// Geometry with overlapping nodes, volumes sharing their nodes (clones) and nested assemblies
+TGeoManager *MakeGeometry()
+{
+   auto geom = new TGeoManager("voxgeom", "voxelization test");
+   auto mat = new TGeoMaterial("Al", 26.98, 13, 2.7);
+   auto med = new TGeoMedium("Al", 1, mat);
+   auto top = geom->MakeBox("TOP", med, 200, 200, 200);
+   geom->SetTopVolume(top);
+
+   auto box = geom->MakeBox("BOX", med, 1, 1, 1);
+   auto cont = geom->MakeBox("CONT", med, 30, 30, 30);
+   for (Int_t i = 0; i < 60; ++i)
+      cont->AddNodeOverlap(box, i, new TGeoTranslation(-25 + 0.7 * i, 0.3 * i - 9, 0.1 * i));
+   auto clone1 = cont->CloneVolume();
+   clone1->SetName("CLONE1");
+   auto clone2 = cont->CloneVolume();
+   clone2->SetName("CLONE2");
+
+   auto inner = geom->MakeVolumeAssembly("INNER");
+   for (Int_t i = 0; i < 10; ++i)
+      inner->AddNode(box, i, new TGeoTranslation(3 * i, 0, 0));
+   auto outer = geom->MakeVolumeAssembly("OUTER");
+   for (Int_t i = 0; i < 5; ++i)
+      outer->AddNode(inner, i, new TGeoTranslation(0, 3 * i, 0));
+   auto outerClone = outer->CloneVolume();
+   outerClone->SetName("OUTERCLONE");
+
+   top->AddNode(cont, 1, new TGeoTranslation(-100, -100, 0));
+   top->AddNode(clone1, 1, new TGeoTranslation(100, -100, 0));
+   top->AddNode(clone2, 1, new TGeoTranslation(0, 100, 0));
+   top->AddNode(outer, 1, new TGeoTranslation(-150, 120, 0));
+   top->AddNode(outerClone, 1, new TGeoTranslation(100, 100, 0));
+   geom->SetVerboseLevel(0);
+   geom->CloseGeometry();
+   return geom;
+}
+
+// The overlaps of all nodes and the paths found at a grid of points
+std::vector<std::string> Describe(TGeoManager *geom)
+{
+   std::vector<std::string> res;
+   TIter next(geom->GetListOfVolumes());
+   TGeoVolume *vol;
+   while ((vol = (TGeoVolume *)next())) {
+      for (Int_t i = 0; i < vol->GetNdaughters(); ++i) {
+         Int_t novlp = 0;
+         Int_t *ovlp = vol->GetNode(i)->GetOverlaps(novlp);
+         std::string s = std::string(vol->GetName()) + ":" + std::to_string(i);
+         for (Int_t j = 0; j < novlp; ++j)
+            s += " " + std::to_string(ovlp[j]);
+         res.push_back(s);
+      }
+   }
+   for (Double_t x = -180; x < 180; x += 3.7) {
+      for (Double_t y = -180; y < 180; y += 4.1) {
+         geom->FindNode(x, y, 0.5);
+         res.push_back(geom->GetPath());
+      }
+   }
+   return res;
+}
+
+} // namespace
+
+// The concurrent voxelization gives the same result as the serial one
+TEST(TGeoManager, VoxelizeMT)
+{
+   auto geom = MakeGeometry();
+   auto serial = Describe(geom);
+   delete geom;
+
+#ifdef R__USE_IMT
+   ROOT::EnableImplicitMT(4);
+#endif
+   for (Int_t i = 0; i < 5; ++i) {
+      geom = MakeGeometry();
+      EXPECT_EQ(Describe(geom), serial);
+      delete geom;
+   }
+#ifdef R__USE_IMT
+   ROOT::DisableImplicitMT();
+#endif
+}
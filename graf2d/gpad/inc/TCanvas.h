@@ -60,6 +60,7 @@ protected:
    Bool_t        fRetained;        ///< Retain structure flag
    Bool_t        fUseGL;           ///<! True when rendering is with GL
    Bool_t        fDrawn;           ///<! Set to True when the Draw method is called
+   Bool_t        fUseImageCache{kFALSE}; ///<! True when the pads keep their pixels for the next image output
    //
    TVirtualPadPainter *fPainter;   ///<! Canvas (pad) painter.
 
@@ -201,6 +202,7 @@ public:
    void              SetCanvasImp(TCanvasImp *i) { fCanvasImp = i; }
    void              SetCanvasSize(UInt_t ww, UInt_t wh) override; // *MENU*
    void              SetHighLightColor(Color_t col) { fHighLightColor = col; }
+   void              SetImageCache(Bool_t on = kTRUE);
    void              SetSelected(TObject *obj) override;
    void              SetClickSelected(TObject *obj) { fClickSelected = obj; }
    void              SetSelectedPad(TPad *pad) { fSelectedPad = pad; }
@@ -221,6 +223,7 @@ public:
    void              Update() override;
 
    Bool_t              UseGL() const { return fUseGL; }
+   Bool_t              UseImageCache() const { return fUseImageCache; }
    void                SetSupportGL(Bool_t support) {fUseGL = support;}
    TVirtualPadPainter *GetCanvasPainter();
    void                DeleteCanvasPainter();
@@ -22,6 +22,7 @@ class TBox;
 class TLegend;
 class TArrow;
 class TPoint;
+class TImage;
 
 class TPad : public TVirtualPad, public TAttBBox2D {
 
@@ -118,6 +119,12 @@ protected:
    // 3D Viewer support
    TVirtualViewer3D *fViewer3D;     ///<! Current 3D viewer
 
+   // Image output cache, see TCanvas::SetImageCache()
+   TImage       *fImageCache{nullptr};    ///<! Pixels of the pad in the last image output
+   Int_t         fImageCacheX{0};         ///<! X position of the pixels in the image
+   Int_t         fImageCacheY{0};         ///<! Y position of the pixels in the image
+   Bool_t        fImageCacheValid{kFALSE};///<! False when the pad was modified after the pixels were cached
+
    void          DestroyExternalViewer3D();
    Int_t         DistancetoPrimitive(Int_t px, Int_t py) override;
    void          ExecuteEvent(Int_t event, Int_t px, Int_t py) override;
@@ -136,6 +143,12 @@ private:
    void CopyBackgroundPixmaps(TPad *start, TPad *stop, Int_t x, Int_t y);
    void DrawDist(Rectangle_t aBBox, Rectangle_t bBBox, char mode);
 
+   TImage           *GetImageCacheOutput() const;
+   void              GetImageCacheRegion(Int_t &x, Int_t &y, Int_t &w, Int_t &h);
+   Bool_t            HasImageCache() const;
+   Bool_t            PaintImageCache(TImage *image);
+   void              FillImageCache(TImage *image);
+
    Bool_t            Collide(Int_t i, Int_t j, Int_t w, Int_t h);
    void              FillCollideGrid(TObject *o);
    void              FillCollideGridTBox(TObject *o);
@@ -414,6 +427,7 @@ public:
 inline void TPad::Modified(Bool_t flag)
 {
    if (!fModified && flag) Emit("Modified()");
+   if (flag) fImageCacheValid = kFALSE;
    fModified = flag;
 }
 
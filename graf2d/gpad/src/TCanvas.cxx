@@ -2574,6 +2574,30 @@ void TCanvas::SetGrayscale(Bool_t set /*= kTRUE*/)
    Paint(); // update canvas and all sub-pads, unconditionally!
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Keep the pixels of the pads produced when the canvas is printed to an
+/// image file (gif, png, jpg, ...), so that the next image output copies the
+/// pads that were not modified in between instead of painting them again.
+///
+/// This is meant for canvases printed again and again, e.g. on monitoring
+/// pages, where only some of the pads change. A pad is repainted only once
+/// Modified() has been called for it (or one of its sub-pads), following the
+/// same rule as Update() on the screen:
+/// ~~~ {.cpp}
+///    c1->SetImageCache();
+///    while (...) {
+///       h->Fill(...);
+///       c1->cd(3)->Modified();
+///       c1->Print("monitoring.png");
+///    }
+/// ~~~
+/// Transparent pads, and the pads drawn with a 3D viewer, are always repainted.
+
+void TCanvas::SetImageCache(Bool_t on)
+{
+   fUseImageCache = on;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Probably, TPadPainter must be placed in a separate ROOT module -
 /// "padpainter" (the same as "histpainter"). But now, it's directly in a
@@ -393,6 +393,7 @@ TPad::~TPad()
    delete primitives;
    SafeDelete(fExecs);
    delete fViewer3D;
+   delete fImageCache;
    if (fCollideGrid) delete [] fCollideGrid;
 
    // Required since we overload TObject::Hash.
@@ -3459,6 +3460,14 @@ void TPad::Paint(Option_t * /*option*/)
       return;
    }
 
+   TImage *image = GetImageCacheOutput();
+   if (!image) {
+      delete fImageCache;
+      fImageCache = nullptr;
+   } else if (PaintImageCache(image)) {
+      return;
+   }
+
    if (fCanvas) TColor::SetGrayscale(fCanvas->IsGrayscale());
 
    TPad *padsav = (TPad*)gPad;
@@ -3500,6 +3509,95 @@ void TPad::Paint(Option_t * /*option*/)
    if (began3DScene) {
       fViewer3D->EndScene();
    }
+
+   if (image) FillImageCache(image);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return the image being produced by TImageDump, if the canvas keeps the
+/// pixels of its pads for the image output (see TCanvas::SetImageCache()).
+
+TImage *TPad::GetImageCacheOutput() const
+{
+   if (!gVirtualPS || !fCanvas || !fCanvas->UseImageCache()) return nullptr;
+   if (!gVirtualPS->InheritsFrom("TImageDump")) return nullptr;
+   TImage *image = (TImage*)gVirtualPS->GetStream();
+   if (!image || !image->IsValid()) return nullptr;
+   return image;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Rectangle covered by the pad in the image output, as computed by TImageDump.
+
+void TPad::GetImageCacheRegion(Int_t &x, Int_t &y, Int_t &w, Int_t &h)
+{
+   Float_t scale = gStyle->GetImageScaling();
+   x = Int_t(XtoAbsPixel(fX1)*scale);
+   y = Int_t(YtoAbsPixel(fY2)*scale);
+   w = Int_t(XtoAbsPixel(fX2)*scale) - x + 1;
+   h = Int_t(YtoAbsPixel(fY1)*scale) - y + 1;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// True if the pixels of this pad and of all its sub-pads are cached and none
+/// of them was modified since.
+
+Bool_t TPad::HasImageCache() const
+{
+   if (!fImageCache || !fImageCacheValid) return kFALSE;
+   TObjLink *lnk = fPrimitives ? fPrimitives->FirstLink() : nullptr;
+   while (lnk) {
+      TObject *obj = lnk->GetObject();
+      if (obj->InheritsFrom(TPad::Class()) && !((TPad*)obj)->HasImageCache()) return kFALSE;
+      lnk = lnk->Next();
+   }
+   return kTRUE;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Copy the cached pixels of the pad into the image, instead of painting it.
+/// Return kFALSE if the pad has to be painted.
+
+Bool_t TPad::PaintImageCache(TImage *image)
+{
+   if (!HasImageCache()) return kFALSE;
+   Int_t x, y, w, h;
+   GetImageCacheRegion(x, y, w, h);
+   if (x != fImageCacheX || y != fImageCacheY ||
+       w != (Int_t)fImageCache->GetWidth() || h != (Int_t)fImageCache->GetHeight()) return kFALSE;
+   fImageCache->CopyArea(image, 0, 0, w, h, x, y);
+   return kTRUE;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Keep the pixels of the pad just painted in the image.
+
+void TPad::FillImageCache(TImage *image)
+{
+   fImageCacheValid = kFALSE;
+   if (fViewer3D || IsTransparent()) {
+      delete fImageCache;
+      fImageCache = nullptr;
+      return;
+   }
+   Int_t x, y, w, h;
+   GetImageCacheRegion(x, y, w, h);
+   if (x < 0 || y < 0 || w <= 0 || h <= 0 ||
+       x + w > (Int_t)image->GetWidth() || y + h > (Int_t)image->GetHeight()) {
+      delete fImageCache;
+      fImageCache = nullptr;
+      return;
+   }
+   if (!fImageCache || w != (Int_t)fImageCache->GetWidth() || h != (Int_t)fImageCache->GetHeight()) {
+      delete fImageCache;
+      fImageCache = TImage::Create();
+      if (!fImageCache) return;
+      fImageCache->FillRectangle("#ffffffff", 0, 0, w, h);
+   }
+   image->CopyArea(fImageCache, x, y, w, h, 0, 0);
+   fImageCacheX = x;
+   fImageCacheY = y;
+   fImageCacheValid = kTRUE;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
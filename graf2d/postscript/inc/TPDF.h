@@ -27,6 +27,8 @@
 
 class TPoints;
 
+struct z_stream_s;
+
 class TPDF : public TVirtualPS {
 
 protected:
@@ -48,6 +50,7 @@ protected:
    Int_t              fNbPage;          ///< Number of pages
    Bool_t             fPageNotEmpty;    ///< True if the current page is not empty
    Bool_t             fCompress;        ///< True when fBuffer must be compressed
+   z_stream_s        *fZStream;         ///<! Deflate stream of the current page content
    Bool_t             fRange;           ///< True when a range has been defined
 
    static Int_t       fgLineJoin;       ///< Appearance of joining lines
@@ -104,6 +107,8 @@ public:
    void     TextNDC(Double_t u, Double_t v, const char *string);
    void     TextNDC(Double_t, Double_t, const wchar_t *);
    void     WriteCompressedBuffer();
+   void     DeflateBuffer(Bool_t finish);
+   void     PrintCompressed(Int_t len, const char *str);
    virtual  void WriteReal(Float_t r, Bool_t space=kTRUE);
    Double_t UtoPDF(Double_t u);
    Double_t VtoPDF(Double_t v);
@@ -94,6 +94,70 @@ const Int_t kObjFirstPage        = 51; // First page object
 // Number of fonts
 const Int_t kNumberOfFonts = 15;
 
+// Size of the page content buffered before being given to the deflate stream
+const Int_t kDeflateChunk = 65536;
+
+namespace {
+
+////////////////////////////////////////////////////////////////////////////////
+/// Format z like "%g" (6 significant digits, no trailing zeros) without
+/// going through snprintf. Return the number of characters written in str,
+/// or 0 if z would be written with an exponent.
+
+Int_t FormatReal(char *str, Float_t z)
+{
+   if (z == 0) {
+      str[0] = '0';
+      str[1] = 0;
+      return 1;
+   }
+   Double_t a = TMath::Abs(z);
+   if (!(a >= 1e-4 && a < 1e6))
+      return 0;
+
+   // number of decimals giving 6 significant digits
+   Int_t ndec = 5;
+   for (Double_t p = 10; p <= a; p *= 10)
+      ndec--;
+   for (Double_t p = 1; p > a; p /= 10)
+      ndec++;
+
+   Long64_t scale = 1;
+   for (Int_t i = 0; i < ndec; i++)
+      scale *= 10;
+   Long64_t v = (Long64_t)(a * scale + 0.5);
+
+   // strip the trailing zeros of the decimals
+   while (ndec > 0 && v % 10 == 0) {
+      v /= 10;
+      scale /= 10;
+      ndec--;
+   }
+
+   char tmp[24];
+   Int_t n = 0;
+   for (Int_t i = 0; i < ndec; i++) {
+      tmp[n++] = '0' + v % 10;
+      v /= 10;
+   }
+   if (ndec > 0)
+      tmp[n++] = '.';
+   do {
+      tmp[n++] = '0' + v % 10;
+      v /= 10;
+   } while (v);
+
+   Int_t len = 0;
+   if (z < 0)
+      str[len++] = '-';
+   while (n > 0)
+      str[len++] = tmp[--n];
+   str[len] = 0;
+   return len;
+}
+
+} // anonymous namespace
+
 Int_t TPDF::fgLineJoin = 0;
 Int_t TPDF::fgLineCap  = 0;
 
@@ -105,6 +169,7 @@ ClassImp(TPDF);
 TPDF::TPDF() : TVirtualPS()
 {
    fStream          = 0;
+   fZStream         = nullptr;
    fCompress        = kFALSE;
    fPageNotEmpty    = kFALSE;
    gVirtualPS       = this;
@@ -139,6 +204,7 @@ TPDF::TPDF() : TVirtualPS()
 TPDF::TPDF(const char *fname, Int_t wtype) : TVirtualPS(fname, wtype)
 {
    fStream          = 0;
+   fZStream         = nullptr;
    fCompress        = kFALSE;
    fPageNotEmpty    = kFALSE;
    fRed             = 0.;
@@ -167,6 +233,10 @@ TPDF::~TPDF()
 {
    Close();
 
+   if (fZStream) {
+      deflateEnd(fZStream);
+      delete fZStream;
+   }
    if (fObjPos) delete [] fObjPos;
 }
 
@@ -1825,12 +1895,7 @@ void TPDF::PrintStr(const char *str)
    fPageNotEmpty = kTRUE;
 
    if (fCompress) {
-      if (fLenBuffer+len >= fSizBuffer) {
-         fBuffer  = TStorage::ReAllocChar(fBuffer, 2*fSizBuffer, fSizBuffer);
-         fSizBuffer = 2*fSizBuffer;
-      }
-      strcpy(fBuffer + fLenBuffer, str);
-      fLenBuffer += len;
+      PrintCompressed(len, str);
       return;
    }
 
@@ -1842,20 +1907,34 @@ void TPDF::PrintStr(const char *str)
 
 void TPDF::PrintFast(Int_t len, const char *str)
 {
+   if (!len || !str) return;
    fPageNotEmpty = kTRUE;
    if (fCompress) {
-      if (fLenBuffer+len >= fSizBuffer) {
-         fBuffer  = TStorage::ReAllocChar(fBuffer, 2*fSizBuffer, fSizBuffer);
-         fSizBuffer = 2*fSizBuffer;
-      }
-      strcpy(fBuffer + fLenBuffer, str);
-      fLenBuffer += len;
+      PrintCompressed(len, str);
       return;
    }
 
    TVirtualPS::PrintFast(len, str);
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Add len characters of str to the page content to be compressed. The
+/// content is given to the deflate stream by chunks, so that the memory used
+/// does not grow with the size of the page.
+
+void TPDF::PrintCompressed(Int_t len, const char *str)
+{
+   if ((fLenBuffer+len >= fSizBuffer) && (fLenBuffer >= kDeflateChunk))
+      DeflateBuffer(kFALSE);
+   while (fLenBuffer+len >= fSizBuffer) {
+      fBuffer  = TStorage::ReAllocChar(fBuffer, 2*fSizBuffer, fSizBuffer);
+      fSizBuffer = 2*fSizBuffer;
+   }
+   memcpy(fBuffer + fLenBuffer, str, len);
+   fLenBuffer += len;
+   fBuffer[fLenBuffer] = 0;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Set the range for the paper in centimetres
 
@@ -2374,48 +2453,60 @@ Double_t TPDF::YtoPDF(Double_t y)
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-/// Write the buffer in a compressed way
+/// Give the buffered page content to the deflate stream and write the
+/// compressed output in the file. When finish is true the stream of the
+/// current page is terminated.
 
-void TPDF::WriteCompressedBuffer()
+void TPDF::DeflateBuffer(Bool_t finish)
 {
-   z_stream stream;
-   int err;
-   char *out = new char[2*fLenBuffer];
-
-   stream.next_in   = (Bytef*)fBuffer;
-   stream.avail_in  = (uInt)fLenBuffer;
-   stream.next_out  = (Bytef*)out;
-   stream.avail_out = (uInt)2*fLenBuffer;
-   stream.zalloc    = (alloc_func)0;
-   stream.zfree     = (free_func)0;
-   stream.opaque    = (voidpf)0;
-
-   err = deflateInit(&stream, Z_DEFAULT_COMPRESSION);
-   if (err != Z_OK) {
-      Error("WriteCompressedBuffer", "error in deflateInit (zlib)");
-      delete [] out;
-      return;
+   if (!fZStream) {
+      fZStream = new z_stream;
+      fZStream->zalloc = (alloc_func)0;
+      fZStream->zfree  = (free_func)0;
+      fZStream->opaque = (voidpf)0;
+      if (deflateInit(fZStream, Z_DEFAULT_COMPRESSION) != Z_OK) {
+         Error("DeflateBuffer", "error in deflateInit (zlib)");
+         delete fZStream;
+         fZStream = nullptr;
+         fLenBuffer = 0;
+         return;
+      }
    }
 
-   err = deflate(&stream, Z_FINISH);
-   if (err != Z_STREAM_END) {
-      deflateEnd(&stream);
-      Error("WriteCompressedBuffer", "error in deflate (zlib)");
-      delete [] out;
-      return;
-   }
+   char out[16384];
+   fZStream->next_in  = (Bytef*)fBuffer;
+   fZStream->avail_in = (uInt)fLenBuffer;
+   int err;
+   do {
+      fZStream->next_out  = (Bytef*)out;
+      fZStream->avail_out = (uInt)sizeof(out);
+      err = deflate(fZStream, finish ? Z_FINISH : Z_NO_FLUSH);
+      if (err == Z_STREAM_ERROR) {
+         Error("DeflateBuffer", "error in deflate (zlib)");
+         break;
+      }
+      Int_t nout = sizeof(out) - fZStream->avail_out;
+      fStream->write(out, nout);
+      fNByte += nout;
+   } while (fZStream->avail_out == 0);
+   fLenBuffer = 0;
 
-   err = deflateEnd(&stream);
-   if (err != Z_OK) {
-      Error("WriteCompressedBuffer", "error in deflateEnd (zlib)");
+   if (finish) {
+      if (deflateEnd(fZStream) != Z_OK)
+         Error("DeflateBuffer", "error in deflateEnd (zlib)");
+      delete fZStream;
+      fZStream = nullptr;
    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Write the end of the compressed page content
 
-   fStream->write(out, stream.total_out);
+void TPDF::WriteCompressedBuffer()
+{
+   DeflateBuffer(kTRUE);
 
-   fNByte += stream.total_out;
    fStream->write("\n",1); fNByte++;
-   fLenBuffer = 0;
-   delete [] out;
    fCompress = kFALSE;
 }
 
@@ -2429,6 +2520,13 @@ void TPDF::WriteCompressedBuffer()
 void TPDF::WriteReal(Float_t z, Bool_t space)
 {
    char str[15];
+   Int_t len = space ? 1 : 0;
+   Int_t n = FormatReal(str + len, z);
+   if (n) {
+      if (space) str[0] = ' ';
+      PrintFast(len + n, str);
+      return;
+   }
    if (space) {
       snprintf(str,15," %g", z);
       if (strstr(str,"e") || strstr(str,"E")) snprintf(str,15," %10.8f", z);
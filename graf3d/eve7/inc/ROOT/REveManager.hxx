@@ -69,6 +69,7 @@ public:
       enum EConnState {Free, Processing, WaitingResponse };
       unsigned fId{0};
       EConnState   fState{Free};
+      int          fPending{0};   ///< number of published changes not yet acknowledged by the client
 
       Conn() = default;
       Conn(unsigned int cId) : fId(cId) {}
@@ -152,6 +153,7 @@ protected:
    // MIR execution
    std::thread       fMIRExecThread;
    ServerState       fServerState;
+   int               fMaxPendingUpdates{2};
    std::unordered_map<std::string, std::shared_ptr<TMethodCall> > fMethCallMap;
 
    Logger            fLogger;
@@ -191,6 +193,14 @@ public:
    void SceneSubscriberWaitingResponse(unsigned cinnId);
 
    bool ClientConnectionsFree() const;
+   int  MaxClientPendingUpdates() const;
+   void ClientsUpdatePublished();
+
+   /// Number of published changes a client may be still processing when the next
+   /// BeginChange() returns. With 1, BeginChange() waits until all the clients
+   /// have drawn the previous changes.
+   int  GetMaxPendingUpdates() const { return fMaxPendingUpdates; }
+   void SetMaxPendingUpdates(int n) { fMaxPendingUpdates = n > 0 ? n : 1; }
 
    void DisableRedraw() { printf("REveManager::DisableRedraw obsolete \n"); }
    void EnableRedraw()  { printf("REveManager::EnableRedraw obsolete \n");  }
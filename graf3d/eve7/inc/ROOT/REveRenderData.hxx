@@ -28,6 +28,8 @@ private:
    std::vector<float> fNormalBuffer;
    std::vector<int>   fIndexBuffer;
    std::vector<float> fMatrix;
+   std::vector<float> fInstanceBuffer;
+   int                fInstanceStride{0};
 
 public:
    // If Primitive_e is changed, change also definition in EveElements.js.
@@ -38,6 +40,7 @@ public:
    REveRenderData(const std::string &func, int size_vert = 0, int size_norm = 0, int size_idx = 0);
 
    void Reserve(int size_vert = 0, int size_norm = 0, int size_idx = 0);
+   void ReserveInstances(int n_inst, int stride);
 
    void PushV(float x) { fVertexBuffer.emplace_back(x); }
 
@@ -88,14 +91,31 @@ public:
 
    void SetMatrix(const double *arr);
 
+   // Per-instance data, stride floats per instance, for render functions drawing
+   // the geometry stored in the vertex buffer once per instance.
+   // The stride is set with ReserveInstances().
+
+   void PushInst(float x) { fInstanceBuffer.emplace_back(x); }
+
+   void PushInst(float x, float y, float z)
+   {
+      PushInst(x);
+      PushInst(y);
+      PushInst(z);
+   }
+
    const std::string GetRnrFunc() const { return fRnrFunc; }
 
    int SizeV() const { return fVertexBuffer.size(); }
    int SizeN() const { return fNormalBuffer.size(); }
    int SizeI() const { return fIndexBuffer.size(); }
    int SizeT() const { return fMatrix.size(); }
+   int SizeInst() const { return fInstanceBuffer.size(); }
+
+   int GetInstanceStride() const { return fInstanceStride; }
+   int GetNInstances() const { return fInstanceStride > 0 ? SizeInst() / fInstanceStride : 0; }
 
-   int GetBinarySize() { return (SizeV() + SizeN() + SizeT()) * sizeof(float) + SizeI() * sizeof(int); }
+   int GetBinarySize() { return (SizeV() + SizeN() + SizeT() + SizeInst()) * sizeof(float) + SizeI() * sizeof(int); }
 
    int Write(char *msg, int maxlen);
 };
@@ -343,6 +343,8 @@ Int_t REveBoxSet::WriteCoreJson(nlohmann::json &j, Int_t rnr_offset)
 
 ////////////////////////////////////////////////////////////////////////////////
 /// Crates 3D point array for rendering.
+/// Boxes with fixed dimensions are streamed as instances: the vertex buffer holds
+/// the common dimensions and the instance buffer the origin of each box.
 
 void REveBoxSet::BuildRenderData()
 {
@@ -377,8 +379,20 @@ void REveBoxSet::BuildRenderData()
          }
          break;
       }
+      case REveBoxSet::kBT_AABoxFixedDim:
+      {
+         fRenderData->PushV(fDefWidth, fDefHeight, fDefDepth);
+         fRenderData->ReserveInstances(fPlex.Size(), 3);
+         REveChunkManager::iterator bi(fPlex);
+         while (bi.next())
+         {
+            REveBoxSet::BAABoxFixedDim_t& b = * (REveBoxSet::BAABoxFixedDim_t*) bi();
+            fRenderData->PushInst(b.fA, b.fB, b.fC);
+         }
+         break;
+      }
       default:
-         assert(false && "REveBoxSet::BuildRenderData only kBT_FreeBox type supported");
+         assert(false && "REveBoxSet::BuildRenderData only box types kBT_FreeBox, kBT_AABox and kBT_AABoxFixedDim supported");
    }
 
    //
@@ -1490,6 +1490,8 @@ Int_t REveElement::WriteCoreJson(nlohmann::json &j, Int_t rnr_offset)
          rd["norm_size"] = fRenderData->SizeN();
          rd["index_size"] = fRenderData->SizeI();
          rd["trans_size"] = fRenderData->SizeT();
+         rd["inst_size"] = fRenderData->SizeInst();
+         rd["inst_stride"] = fRenderData->GetInstanceStride();
 
          j["render_data"] = rd;
 
@@ -39,6 +39,7 @@
 #include "TTimer.h"
 #include "TApplication.h"
 
+#include <algorithm>
 #include <fstream>
 #include <sstream>
 #include <iostream>
@@ -794,12 +795,16 @@ void REveManager::WindowData(unsigned connid, const std::string &arg)
 
       for (auto &conn : fConnList) {
          if (conn.fId == connid) {
-            conn.fState = Conn::Free;
+            if (conn.fPending > 0)
+               --conn.fPending;
+            if (conn.fPending == 0)
+               conn.fState = Conn::Free;
             break;
          }
       }
 
-      if (ClientConnectionsFree()) {
+      // with pipelined updates the next change can be already in progress
+      if (fServerState.fVal == ServerState::UpdatingClients && ClientConnectionsFree()) {
          fServerState.fVal = ServerState::Waiting;
          fServerState.fCV.notify_all();
       }
@@ -980,6 +985,7 @@ void REveManager::MIRExecThread()
 
          lock.lock();
          fServerState.fVal = fConnList.empty() ? ServerState::Waiting : ServerState::UpdatingClients;
+         ClientsUpdatePublished();
          PublishChanges();
       }
    }
@@ -1000,13 +1006,37 @@ void REveManager::SendBinary(unsigned connid, const void *data, std::size_t len)
 bool REveManager::ClientConnectionsFree() const
 {
    for (auto &conn : fConnList) {
-      if (conn.fState != Conn::Free)
+      if (conn.fState != Conn::Free || conn.fPending > 0)
          return false;
    }
 
    return true;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Largest number of published changes not yet acknowledged by a client.
+/// To be called with the server state mutex locked.
+
+int REveManager::MaxClientPendingUpdates() const
+{
+   int n = 0;
+   for (auto &conn : fConnList)
+      n = std::max(n, conn.fPending);
+   return n;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Count changes about to be published for all the connections, they are
+/// acknowledged one by one with "__REveDoneChanges".
+/// To be called with the server state mutex locked, before sending the changes
+/// such that an early acknowledgement is not lost.
+
+void REveManager::ClientsUpdatePublished()
+{
+   for (auto &conn : fConnList)
+      ++conn.fPending;
+}
+
 void REveManager::SceneSubscriberProcessingChanges(unsigned cinnId)
 {
    for (auto &conn : fConnList) {
@@ -1063,11 +1093,17 @@ std::shared_ptr<REveGeomViewer> REveManager::ShowGeometry(const RWebDisplayArgs
 }
 
 //____________________________________________________________________
+/// Start changing the scenes. While the clients are still processing the
+/// previously published changes, this only waits when one of them is more than
+/// GetMaxPendingUpdates() changes behind, such that the next event can be
+/// prepared while the previous one is being drawn.
+
 void REveManager::BeginChange()
 {
    {
       std::unique_lock<std::mutex> lock(fServerState.fMutex);
-      while (fServerState.fVal != ServerState::Waiting) {
+      while (fServerState.fVal == ServerState::UpdatingScenes ||
+             (fServerState.fVal == ServerState::UpdatingClients && MaxClientPendingUpdates() >= fMaxPendingUpdates)) {
          fServerState.fCV.wait(lock);
       }
       fServerState.fVal = ServerState::UpdatingScenes;
@@ -1082,10 +1118,15 @@ void REveManager::EndChange()
    GetScenes()->AcceptChanges(false);
    GetWorld()->EndAcceptingChanges();
 
+   {
+      std::unique_lock<std::mutex> lock(fServerState.fMutex);
+      ClientsUpdatePublished();
+   }
+
    PublishChanges();
 
    std::unique_lock<std::mutex> lock(fServerState.fMutex);
-   fServerState.fVal = fConnList.empty() ? ServerState::Waiting : ServerState::UpdatingClients;
+   fServerState.fVal = ClientConnectionsFree() ? ServerState::Waiting : ServerState::UpdatingClients;
    fServerState.fCV.notify_all();
 }
 
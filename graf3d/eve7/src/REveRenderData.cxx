@@ -40,7 +40,19 @@ void REveRenderData::Reserve(int size_vert, int size_norm, int size_idx)
 }
 
 /////////////////////////////////////////////////////////////////////////////////////////
-/// Write render data to binary buffer
+/// Reserve place for n_inst instances of stride floats each and set the instance stride
+
+void REveRenderData::ReserveInstances(int n_inst, int stride)
+{
+   fInstanceStride = stride;
+   if (n_inst > 0 && stride > 0)
+      fInstanceBuffer.reserve(n_inst * stride);
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////
+/// Write render data to binary buffer.
+/// The order is matrix, vertices, normals, indices and instance data,
+/// see EveManager.ImportSceneBinary().
 
 int REveRenderData::Write(char *msg, int maxlen)
 {
@@ -67,6 +79,9 @@ int REveRenderData::Write(char *msg, int maxlen)
    if (!fIndexBuffer.empty())
       append(&fIndexBuffer[0], fIndexBuffer.size() * sizeof(int));
 
+   if (!fInstanceBuffer.empty())
+      append(&fInstanceBuffer[0], fInstanceBuffer.size() * sizeof(float));
+
    return off;
 }
 
@@ -18,6 +18,7 @@
 #include <ROOT/RWebWindow.hxx>
 
 #include <cassert>
+#include <cstring>
 
 #include <nlohmann/json.hpp>
 
@@ -229,7 +230,10 @@ void REveScene::StreamJsonRecurse(REveElement *el, nlohmann::json &jarr)
 
 ////////////////////////////////////////////////////////////////////////////////
 //
-/// Prepare data for sending element changes
+/// Prepare data for sending element changes.
+/// Elements of which only the visibility changed are not streamed to json, they
+/// are packed as pairs of element id and rnr-self / rnr-children bits after the
+/// render data in the binary buffer.
 //
 ////////////////////////////////////////////////////////////////////////////////
 
@@ -255,10 +259,20 @@ void REveScene::StreamRepresentationChanges()
 
    // jarr.push_back(jhdr);
 
+   std::vector<UInt_t> visRecords;
+
    for (auto &el: fChangedElements)
    {
       UChar_t bits = el->GetChangeBits();
 
+      if (bits == kCBVisibility)
+      {
+         visRecords.push_back(el->GetElementId());
+         visRecords.push_back((el->GetRnrSelf() ? 1 : 0) | (el->GetRnrChildren() ? 2 : 0));
+         el->ClearStamps();
+         continue;
+      }
+
       nlohmann::json jobj = {};
       jobj["fElementId"] = el->GetElementId();
       jobj["changeBit"]  = bits;
@@ -304,17 +318,24 @@ void REveScene::StreamRepresentationChanges()
    fChangedElements.clear();
    fRemovedElements.clear();
 
-   // render data for total change
+   // render data for total change, followed by the visibility records
+   Int_t visOffset = fTotalBinarySize;
+   fTotalBinarySize += visRecords.size() * sizeof(UInt_t);
    fOutputBinary.resize(fTotalBinarySize);
    Int_t off = 0;
 
    for (auto &e : fElsWithBinaryData) {
-      auto rd_size = e->fRenderData->Write(&fOutputBinary[off], fOutputBinary.size() - off);
+      auto rd_size = e->fRenderData->Write(&fOutputBinary[off], visOffset - off);
 
       off += rd_size;
    }
-   assert(off == fTotalBinarySize);
+   assert(off == visOffset);
+
+   if (!visRecords.empty())
+      memcpy(&fOutputBinary[off], &visRecords[0], visRecords.size() * sizeof(UInt_t));
 
+   jhdr["numVisibilityChanges"] = visRecords.size() / 2;
+   jhdr["visibilityOffset"] = visOffset;
    jhdr["fTotalBinarySize"] = fTotalBinarySize;
 
    nlohmann::json msg = { {"header", jhdr}, {"arr", jarr}};
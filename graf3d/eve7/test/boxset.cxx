@@ -0,0 +1,59 @@
+// @(#)root/eve7:$Id$
+
+/*************************************************************************
+ * Copyright (C) 1995-2021, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#include "gtest/gtest.h"
+
+#include <ROOT/REveManager.hxx>
+#include <ROOT/REveScene.hxx>
+#include <ROOT/REveBoxSet.hxx>
+#include <ROOT/REveRenderData.hxx>
+
+#include <nlohmann/json.hpp>
+
+#include <vector>
+
+// Boxes with fixed dimensions are streamed as instances of one box
+TEST(REveBoxSet, FixedDimInstances) {
+   namespace REX = ROOT::Experimental;
+
+   auto eveMng = REX::REveManager::Create();
+
+   Int_t nboxes = 100;
+
+   auto bs = new REX::REveBoxSet();
+   bs->Reset(REX::REveBoxSet::kBT_AABoxFixedDim, kFALSE, 64);
+   bs->SetDefWidth(1);
+   bs->SetDefHeight(2);
+   bs->SetDefDepth(3);
+   bs->UseSingleColor();
+   for (Int_t i = 0; i < nboxes; ++i)
+      bs->AddBox(i, 2 * i, 3 * i);
+   eveMng->GetEventScene()->AddElement(bs);
+
+   nlohmann::json j;
+   Int_t size = bs->WriteCoreJson(j, 0);
+
+   auto &rd = j["render_data"];
+   EXPECT_EQ(rd["vert_size"].get<int>(), 3);
+   EXPECT_EQ(rd["inst_stride"].get<int>(), 3);
+   EXPECT_EQ(rd["inst_size"].get<int>(), 3 * nboxes);
+   EXPECT_EQ(size, (3 + 3 * nboxes) * (Int_t)sizeof(float));
+
+   std::vector<char> buf(size);
+   auto rdata = bs->GetRenderData();
+   ASSERT_NE(rdata, nullptr);
+   EXPECT_EQ(rdata->GetNInstances(), nboxes);
+   EXPECT_EQ(rdata->Write(buf.data(), size), size);
+
+   const float *f = (const float *)buf.data();
+   EXPECT_EQ(f[0], 1);
+   EXPECT_EQ(f[2], 3);
+   EXPECT_EQ(f[3 + 3 * 7 + 1], 14);
+}
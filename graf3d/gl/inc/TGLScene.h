@@ -14,6 +14,7 @@
 
 #include "TGLSceneBase.h"
 #include "TGLSceneInfo.h"
+#include "TGLBoundingBox.h"
 
 #include <map>
 #include <vector>
@@ -80,6 +81,9 @@ public:
    private:
       Bool_t CmpDrawElements(const DrawElement_t& de1, const DrawElement_t& de2);
 
+      void BuildCullTreeRecurse(Int_t node);
+      void CullTreeRecurse(const TGLPlaneSet_t& planes, Int_t node, UChar_t mask);
+
    protected:
       void ClearDrawElementVec(DrawElementVec_t& vec, Int_t maxSize);
       void ClearDrawElementPtrVec(DrawElementPtrVec_t& vec, Int_t maxSize);
@@ -95,6 +99,22 @@ public:
       DrawElementPtrVec_t fSelOpaqueElements;
       DrawElementPtrVec_t fSelTranspElements;
 
+      // Bounding-box tree over fShapesOfInterest for hierarchical culling.
+      struct CullNode_t
+      {
+         TGLBoundingBox fBox;   // Axis-aligned box containing all shapes of the node.
+         Int_t          fBegin; // Range of the node's shapes in fCullOrder.
+         Int_t          fEnd;
+         Int_t          fChild; // Index of the first of two consecutive children, -1 for leaves.
+      };
+
+      std::vector<CullNode_t> fCullNodes;
+      std::vector<Int_t>      fCullOrder;  // Indices into fShapesOfInterest, spatially grouped.
+      std::vector<UChar_t>    fCullPlanes; // Per shape of interest: planes it still has to be tested against.
+
+      void BuildCullTree();
+      void CullTree(const TGLPlaneSet_t& planes);
+
       TSceneInfo(TGLViewerBase* view=0, TGLScene* scene=0);
       virtual ~TSceneInfo();
 
@@ -139,6 +159,8 @@ protected:
    Float_t                   fLastPointSizeScale;
    Float_t                   fLastLineWidthScale;
 
+   Float_t                   fMinPixelSize;      // Shapes projected to fewer pixels are not drawn.
+
    // ----------------------------------------------------------------
    // ----------------------------------------------------------------
 
@@ -198,6 +220,10 @@ public:
 
    virtual UInt_t            GetMaxPhysicalID();
 
+   // Small-feature culling
+   Float_t GetMinPixelSize() const { return fMinPixelSize; }
+   void    SetMinPixelSize(Float_t s);
+
    // ----------------------------------------------------------------
    // Updates / removals of logical and physical shapes
 
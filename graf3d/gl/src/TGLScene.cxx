@@ -122,6 +122,144 @@ void TGLScene::TSceneInfo::ClearAfterUpdate()
    fMinorStamp = 0;
 }
 
+namespace {
+   // Number of shapes below which a node of the cull tree is not split.
+   const Int_t   kCullLeafSize = 32;
+   // Value of TSceneInfo::fCullPlanes for shapes outside one of the planes.
+   const UChar_t kCullOutside  = 0x80;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Build the bounding-box tree over fShapesOfInterest used by CullTree().
+/// The shapes are split recursively in two halves along the longest axis of
+/// the node, using the centers of their bounding boxes.
+
+void TGLScene::TSceneInfo::BuildCullTree()
+{
+   Int_t n = (Int_t) fShapesOfInterest.size();
+
+   fCullNodes.clear();
+   fCullOrder.resize(n);
+   for (Int_t i = 0; i < n; ++i)
+      fCullOrder[i] = i;
+   fCullPlanes.assign(n, 0);
+
+   if (n == 0)
+      return;
+
+   fCullNodes.reserve(4 * n / kCullLeafSize + 1);
+   fCullNodes.push_back(CullNode_t());
+   fCullNodes.back().fBegin = 0;
+   fCullNodes.back().fEnd   = n;
+   fCullNodes.back().fChild = -1;
+   BuildCullTreeRecurse(0);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Calculate the box of node and split it if it holds too many shapes.
+
+void TGLScene::TSceneInfo::BuildCullTreeRecurse(Int_t node)
+{
+   // fCullNodes can be reallocated below, do not keep references to it.
+   const Int_t begin = fCullNodes[node].fBegin;
+   const Int_t end   = fCullNodes[node].fEnd;
+
+   TGLVertex3 low (fShapesOfInterest[fCullOrder[begin]]->BoundingBox().MinAAVertex());
+   TGLVertex3 high(fShapesOfInterest[fCullOrder[begin]]->BoundingBox().MaxAAVertex());
+   for (Int_t i = begin + 1; i < end; ++i)
+   {
+      const TGLBoundingBox& bb = fShapesOfInterest[fCullOrder[i]]->BoundingBox();
+      low .Minimum(bb.MinAAVertex());
+      high.Maximum(bb.MaxAAVertex());
+   }
+   fCullNodes[node].fBox.SetAligned(low, high);
+
+   if (end - begin <= kCullLeafSize)
+      return;
+
+   TGLVector3 ext = high - low;
+   Int_t axis = 0;
+   if (ext[1] > ext[axis]) axis = 1;
+   if (ext[2] > ext[axis]) axis = 2;
+
+   const Int_t mid = (begin + end) / 2;
+   std::nth_element(fCullOrder.begin() + begin, fCullOrder.begin() + mid, fCullOrder.begin() + end,
+                    [&](Int_t a, Int_t b) {
+                       return fShapesOfInterest[a]->BoundingBox().Center()[axis] <
+                              fShapesOfInterest[b]->BoundingBox().Center()[axis];
+                    });
+
+   const Int_t child = (Int_t) fCullNodes.size();
+   fCullNodes[node].fChild = child;
+   fCullNodes.resize(child + 2);
+   fCullNodes[child].fBegin     = begin;
+   fCullNodes[child].fEnd       = mid;
+   fCullNodes[child].fChild     = -1;
+   fCullNodes[child + 1].fBegin = mid;
+   fCullNodes[child + 1].fEnd   = end;
+   fCullNodes[child + 1].fChild = -1;
+
+   BuildCullTreeRecurse(child);
+   BuildCullTreeRecurse(child + 1);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Test the nodes of the cull tree against planes and store in fCullPlanes,
+/// for each shape of interest, the bit-mask of the planes its own bounding
+/// box still has to be tested against: the planes the containing node
+/// is on the inner side of are removed, shapes of nodes outside of one of the
+/// planes are marked with kCullOutside.
+/// At most 7 planes are handled, further planes are always to be tested.
+
+void TGLScene::TSceneInfo::CullTree(const TGLPlaneSet_t& planes)
+{
+   const UChar_t mask = (planes.size() < 7) ? (1 << planes.size()) - 1 : 0x7f;
+
+   // Without a tree matching the shapes of interest all planes are to be tested.
+   if (fCullOrder.size() != fShapesOfInterest.size() || fCullNodes.empty())
+   {
+      fCullPlanes.assign(fShapesOfInterest.size(), mask);
+      return;
+   }
+
+   CullTreeRecurse(planes, 0, mask);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Test node against the planes given by mask and descend into its children
+/// if it is only partially inside.
+
+void TGLScene::TSceneInfo::CullTreeRecurse(const TGLPlaneSet_t& planes, Int_t node, UChar_t mask)
+{
+   const CullNode_t& cn = fCullNodes[node];
+
+   for (UInt_t p = 0; p < planes.size() && p < 7; ++p)
+   {
+      if ( ! (mask & (1 << p)))
+         continue;
+
+      Rgl::EOverlap ovlp = cn.fBox.Overlap(planes[p]);
+      if (ovlp == Rgl::kOutside)
+      {
+         mask = kCullOutside;
+         break;
+      }
+      if (ovlp == Rgl::kInside)
+         mask &= ~(1 << p);
+   }
+
+   if (cn.fChild < 0 || mask == 0 || mask == kCullOutside)
+   {
+      for (Int_t i = cn.fBegin; i < cn.fEnd; ++i)
+         fCullPlanes[fCullOrder[i]] = mask;
+      return;
+   }
+
+   const Int_t child = cn.fChild;
+   CullTreeRecurse(planes, child,     mask);
+   CullTreeRecurse(planes, child + 1, mask);
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Quantize LODs for given render-context.
 
@@ -280,7 +418,8 @@ TGLScene::TGLScene() :
    fGLCtxIdentity(0),
    fInSmartRefresh(kFALSE),
    fLastPointSizeScale (0),
-   fLastLineWidthScale (0)
+   fLastLineWidthScale (0),
+   fMinPixelSize       (0)
 {
    if (fSceneID == 1)
       TGLLogicalShape::SetEnvDefaults();
@@ -413,6 +552,8 @@ void TGLScene::RebuildSceneInfo(TGLRnrCtx& rnrCtx)
    std::sort(sinfo->fShapesOfInterest.begin(), sinfo->fShapesOfInterest.end(),
              TGLScene::ComparePhysicalDiagonals);
 
+   sinfo->BuildCullTree();
+
    sinfo->ClearAfterRebuild();
 }
 
@@ -422,6 +563,9 @@ void TGLScene::RebuildSceneInfo(TGLRnrCtx& rnrCtx)
 /// Here we have to iterate over all the physical shapes and select
 /// the visible ones. While at it, opaque and transparent shapes are
 /// divided into two groups.
+/// The frustum test is done hierarchically on the cull tree first, so that
+/// only shapes of nodes crossing a frustum plane are tested individually.
+/// Shapes smaller than GetMinPixelSize() pixels are not drawn.
 
 void TGLScene::UpdateSceneInfo(TGLRnrCtx& rnrCtx)
 {
@@ -440,6 +584,9 @@ void TGLScene::UpdateSceneInfo(TGLRnrCtx& rnrCtx)
 
    sinfo->fVisibleElements.clear();
 
+   const TGLPlaneSet_t& frustum = sinfo->FrustumPlanes();
+   sinfo->CullTree(frustum);
+
    // Check individual physicals, build DrawElementList.
 
    Int_t  checkCount = 0;
@@ -456,13 +603,16 @@ void TGLScene::UpdateSceneInfo(TGLRnrCtx& rnrCtx)
       // Profile relative costs? The frustum check could be done implicitly
       // from the LOD as we project all 8 vertices of the BB onto viewport
 
+      // Frustum planes the shape has to be tested against, from the cull tree.
+      const UChar_t planeMask = sinfo->fCullPlanes[checkCount];
+
       // Work out if we need to draw this shape - assume we do first
-      Bool_t drawNeeded = kTRUE;
+      Bool_t drawNeeded = (planeMask != kCullOutside);
 
       // Draw test against passed clipping planes.
       // Do before camera clipping on assumption clip planes remove
       // more objects.
-      if (sinfo->ClipMode() == TGLSceneInfo::kClipOutside)
+      if (drawNeeded && sinfo->ClipMode() == TGLSceneInfo::kClipOutside)
       {
          // Draw not needed if outside any of the planes.
          std::vector<TGLPlane>::iterator pi = sinfo->ClipPlanes().begin();
@@ -476,7 +626,7 @@ void TGLScene::UpdateSceneInfo(TGLRnrCtx& rnrCtx)
             ++pi;
          }
       }
-      else if (sinfo->ClipMode() == TGLSceneInfo::kClipInside)
+      else if (drawNeeded && sinfo->ClipMode() == TGLSceneInfo::kClipInside)
       {
          // Draw not needed if inside all the planes.
          std::vector<TGLPlane>::iterator pi = sinfo->ClipPlanes().begin();
@@ -498,15 +648,14 @@ void TGLScene::UpdateSceneInfo(TGLRnrCtx& rnrCtx)
       // implicitly).
       if (drawNeeded)
       {
-         std::vector<TGLPlane>::iterator pi = sinfo->FrustumPlanes().begin();
-         while (pi != sinfo->FrustumPlanes().end())
+         for (UInt_t p = 0; p < frustum.size(); ++p)
          {
-            if (drawShape->BoundingBox().Overlap(*pi) == Rgl::kOutside)
+            if ((p >= 7 || (planeMask & (1 << p))) &&
+                drawShape->BoundingBox().Overlap(frustum[p]) == Rgl::kOutside)
             {
                drawNeeded = kFALSE;
                break;
             }
-            ++pi;
          }
       }
 
@@ -515,7 +664,8 @@ void TGLScene::UpdateSceneInfo(TGLRnrCtx& rnrCtx)
       {
          DrawElement_t de(drawShape);
          drawShape->CalculateShapeLOD(rnrCtx, de.fPixelSize, de.fPixelLOD);
-         sinfo->fVisibleElements.push_back(de);
+         if (de.fPixelSize >= fMinPixelSize)
+            sinfo->fVisibleElements.push_back(de);
       }
 
       // Terminate the traversal if over scene rendering limit.
@@ -1234,6 +1384,21 @@ UInt_t TGLScene::GetMaxPhysicalID()
    return (--fPhysicalShapes.end())->first;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Set the size in pixels of the largest projected axis below which shapes
+/// are not drawn at all, instead of being drawn as points. This makes views
+/// of geometries with very many small volumes much faster.
+/// The default, 0, draws all shapes.
+
+void TGLScene::SetMinPixelSize(Float_t s)
+{
+   if (s == fMinPixelSize) return;
+
+   fMinPixelSize = s;
+   IncTimeStamp();
+   TagViewersChanged();
+}
+
 
 /**************************************************************************/
 // Update methods
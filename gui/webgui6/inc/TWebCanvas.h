@@ -54,6 +54,7 @@ protected:
       Long64_t fSendVersion{0};        ///<! canvas version send to the client
       Long64_t fDrawVersion{0};        ///<! canvas version drawn (confirmed) by client
       std::queue<std::string> fSend;   ///<! send queue, processed after sending draw data
+      std::size_t fSendHash{0};        ///<! hash of last sent snapshot, ignoring canvas version
       WebConn(unsigned id) : fConnId(id) {}
    };
 
@@ -37,9 +37,11 @@
 #include "TAtt3D.h"
 #include "TView.h"
 
+#include <cctype>
 #include <cstdio>
 #include <cstring>
 #include <fstream>
+#include <functional>
 #include <iostream>
 #include <memory>
 #include <sstream>
@@ -55,6 +57,29 @@ Major interactive features implemented in TWebCanvasFull class.
 
 using namespace std::string_literals;
 
+namespace {
+
+////////////////////////////////////////////////////////////////////////////////
+/// Hash of the canvas snapshot json, ignoring the canvas version.
+/// Version is changed with every Modified() call, even when nothing else changes
+
+std::size_t SnapshotHash(const std::string &json)
+{
+   auto pos = json.rfind("\"fScripts\":");
+   if (pos != std::string::npos)
+      pos = json.rfind("\"fVersion\":", pos);
+   if (pos == std::string::npos)
+      return std::hash<std::string>()(json);
+
+   auto end = pos + 11;
+   while ((end < json.length()) && std::isdigit(json[end]))
+      end++;
+
+   return std::hash<std::string>()(json.substr(0, pos) + json.substr(end));
+}
+
+} // anonymous namespace
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Constructor
 
@@ -65,7 +90,7 @@ TWebCanvas::TWebCanvas(TCanvas *c, const char *name, Int_t x, Int_t y, UInt_t wi
    fStyleDelivery = gEnv->GetValue("WebGui.StyleDelivery", 1);
    fPaletteDelivery = gEnv->GetValue("WebGui.PaletteDelivery", 1);
    fPrimitivesMerge = gEnv->GetValue("WebGui.PrimitivesMerge", 100);
-   fJsonComp = gEnv->GetValue("WebGui.JsonComp", TBufferJSON::kSameSuppression + TBufferJSON::kNoSpaces);
+   fJsonComp = gEnv->GetValue("WebGui.JsonComp", TBufferJSON::kBase64 + TBufferJSON::kNoSpaces);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -561,11 +586,30 @@ void TWebCanvas::CheckDataToSend(unsigned connid)
          if (!conn.fSendVersion)
             holder.SetScripts(fCustomScripts);
 
-         CreatePadSnapshot(holder, Canvas(), conn.fSendVersion, [&buf,this](TPadWebSnapshot *snap) {
-            buf.append(TBufferJSON::ToJSON(snap, fJsonComp).Data());
+         std::string json;
+
+         CreatePadSnapshot(holder, Canvas(), conn.fSendVersion, [&json,this](TPadWebSnapshot *snap) {
+            json = TBufferJSON::ToJSON(snap, fJsonComp).Data();
          });
 
+         auto hash = SnapshotHash(json);
+
+         // when nothing changed after last drawing, client does not need new data
+         // and version can be confirmed immediately
+         Bool_t same = conn.fSendVersion && (conn.fSendHash == hash);
+
          conn.fSendVersion = fCanvVersion;
+         conn.fSendHash = hash;
+
+         if (!same) {
+            buf.append(json);
+         } else {
+            conn.fDrawVersion = fCanvVersion;
+            if (!conn.fSend.empty()) {
+               std::swap(buf, conn.fSend.front());
+               conn.fSend.pop();
+            }
+         }
 
       } else if (!conn.fSend.empty()) {
 
@@ -865,6 +909,7 @@ Bool_t TWebCanvas::ProcessData(unsigned connid, const std::string &arg)
 
       // trigger reload of canvas data
       fWebConn[indx].fSendVersion = fWebConn[indx].fDrawVersion = 0;
+      fWebConn[indx].fSendHash = 0;
 
    } else if (arg.compare(0, 5, "SAVE:") == 0) {
 
@@ -50,6 +50,7 @@ struct Foption_t {
    int BinVolume;   // "WIDTH": scale content by the bin width/volume
    double hRobust;  //  value of h parameter used in robust fitting
    ROOT::EExecutionPolicy ExecPolicy;  //  Choose the execution Policy: "SERIAL", "MULTITHREAD" or "MULTIPROCESS"
+   int ExplicitPolicy; //  Set to 1 if ExecPolicy was chosen with an option, otherwise it is chosen from the size of the data
 
   Foption_t() :
       Quiet        (0),
@@ -75,7 +76,8 @@ struct Foption_t {
       StoreResult  (0),
       BinVolume    (0),
       hRobust      (0),
-      ExecPolicy   (ROOT::EExecutionPolicy::kSequential)
+      ExecPolicy   (ROOT::EExecutionPolicy::kSequential),
+      ExplicitPolicy (0)
    {}
 };
 
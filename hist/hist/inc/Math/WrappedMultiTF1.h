@@ -148,6 +148,9 @@ namespace ROOT {
             return fFunc->EvalPar(x, p);
          }
 
+         /// evaluate function at n points, in one call of TF1::EvalBatch for double
+         void DoEvalParBatch(unsigned int n, const T *x, const double *p, T *f) const;
+
          /// evaluate function using the cached parameter values (of TF1)
          /// re-implement for better efficiency
          T DoEvalVec(const T *x) const
@@ -209,6 +212,32 @@ namespace ROOT {
          }
       };
 
+      /**
+       * Auxiliar class to evaluate a TF1 on an array of points: TF1::EvalBatch exists only for double.
+       */
+      template <class T>
+      struct WrappedMultiTF1EvalBatch {
+         static void EvalParBatch(TF1 *func, unsigned int ndim, unsigned int n, const T *x, const double *p, T *f)
+         {
+            for (unsigned int i = 0; i < n; ++i)
+               f[i] = func->EvalPar(x + i * ndim, p);
+         }
+      };
+
+      template <>
+      struct WrappedMultiTF1EvalBatch<double> {
+         static void
+         EvalParBatch(TF1 *func, unsigned int ndim, unsigned int n, const double *x, const double *p, double *f)
+         {
+            if (ndim == (unsigned int)func->GetNdim()) {
+               func->EvalBatch(n, x, p, f);
+               return;
+            }
+            for (unsigned int i = 0; i < n; ++i)
+               f[i] = func->EvalPar(x + i * ndim, p);
+         }
+      };
+
       // implementations for WrappedMultiTF1Templ<T>
       template<class T>
       WrappedMultiTF1Templ<T>::WrappedMultiTF1Templ(TF1 &f, unsigned int dim)  :
@@ -314,6 +343,12 @@ namespace ROOT {
             return GeneralLinearFunctionDerivation<T>::DoParameterDerivative(this, x, ipar);
          }
       }
+      template <class T>
+      void WrappedMultiTF1Templ<T>::DoEvalParBatch(unsigned int n, const T *x, const double *p, T *f) const
+      {
+         WrappedMultiTF1EvalBatch<T>::EvalParBatch(fFunc, fDim, n, x, p, f);
+      }
+
       template<class T>
       void WrappedMultiTF1Templ<T>::SetDerivPrecision(double eps)
       {
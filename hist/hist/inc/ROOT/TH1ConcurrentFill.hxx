@@ -0,0 +1,196 @@
+// @(#)root/hist:$Id$
+
+/*************************************************************************
+ * Copyright (C) 1995-2021, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#ifndef ROOT_TH1ConcurrentFill
+#define ROOT_TH1ConcurrentFill
+
+#include "TH1.h"
+
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace ROOT {
+namespace Experimental {
+
+template <class HIST>
+class TH1ConcurrentFillManager;
+
+/**
+ \class ROOT::Experimental::TH1ConcurrentFiller
+ \ingroup Hist
+ Buffers the Fill calls of one thread and submits them to the
+ TH1ConcurrentFillManager when the buffer is full, when Flush is called and
+ at destruction.
+ **/
+template <class HIST>
+class TH1ConcurrentFiller {
+   TH1ConcurrentFillManager<HIST> *fManager;
+   std::size_t fBufferSize;      ///< Number of Fill calls buffered before they are submitted
+   unsigned int fNArgs = 0;      ///< Number of arguments of each of the buffered Fill calls
+   std::vector<Double_t> fBuffer; ///< Arguments of the buffered Fill calls
+
+public:
+   TH1ConcurrentFiller(TH1ConcurrentFillManager<HIST> &manager, std::size_t bufferSize)
+      : fManager(&manager), fBufferSize(bufferSize > 0 ? bufferSize : 1)
+   {
+   }
+   TH1ConcurrentFiller(TH1ConcurrentFiller &&) = default;
+   TH1ConcurrentFiller(const TH1ConcurrentFiller &) = delete;
+   TH1ConcurrentFiller &operator=(const TH1ConcurrentFiller &) = delete;
+   ~TH1ConcurrentFiller() { Flush(); }
+
+   /// Buffer a call to HIST::Fill with the same arguments, e.g. Fill(x, w) for a TH1 or Fill(x, y) for a TH2.
+   template <typename... Args>
+   auto Fill(Args... args) -> decltype(std::declval<HIST &>().Fill(Double_t(args)...), void())
+   {
+      constexpr unsigned int nArgs = sizeof...(Args);
+      if (nArgs != fNArgs) {
+         Flush();
+         fNArgs = nArgs;
+      }
+      const Double_t values[] = {Double_t(args)...};
+      fBuffer.insert(fBuffer.end(), values, values + nArgs);
+      if (fBuffer.size() >= fBufferSize * nArgs)
+         Flush();
+   }
+
+   /// Submit the buffered Fill calls to the histogram.
+   void Flush()
+   {
+      if (fBuffer.empty())
+         return;
+      fManager->FillN(fNArgs, fBuffer);
+      fBuffer.clear();
+   }
+};
+
+/**
+ \class ROOT::Experimental::TH1ConcurrentFillManager
+ \ingroup Hist
+ Lets several threads fill the same histogram of the TH1 family concurrently,
+ without one clone of the histogram per thread.
+
+ Each thread fills through its own TH1ConcurrentFiller, handed out by
+ MakeFiller, which buffers the Fill calls and periodically replays them on the
+ histogram while holding the lock of the manager. The memory used is that of
+ one histogram plus one buffer per filler, which pays off for large
+ histograms (e.g. TH3 or TH2Poly) filled by many threads; the threads contend
+ for the lock only once per buffer. The contents are the same as if the
+ histogram were filled sequentially, but in a different order, so the
+ statistics can differ by rounding. The histogram must not be read while
+ fillers are in use: it is complete once all of them were flushed or
+ destroyed.
+
+ ~~~{.cpp}
+ TH2D h("h", "h", 1000, 0., 1., 1000, 0., 1.);
+ ROOT::Experimental::TH1ConcurrentFillManager<TH2D> manager(h);
+ ROOT::TThreadExecutor pool;
+ pool.Foreach([&manager](int i) {
+    auto filler = manager.MakeFiller();
+    for (int j = 0; j < 1000; ++j)
+       filler.Fill(i / 1000., j / 1000.);
+ }, ROOT::TSeqI(1000));
+ ~~~
+ **/
+template <class HIST>
+class TH1ConcurrentFillManager {
+   friend class TH1ConcurrentFiller<HIST>;
+
+   HIST &fHist;
+   std::mutex fFillMutex;
+
+   template <unsigned int... Is>
+   auto CallFill(const Double_t *args, std::integer_sequence<unsigned int, Is...>)
+      -> decltype(std::declval<HIST &>().Fill(args[Is]...), void())
+   {
+      fHist.Fill(args[Is]...);
+   }
+
+   // never called: the fillers only buffer the calls to Fill that HIST provides
+   void CallFill(const Double_t *, ...) {}
+
+   /// Fill the 1D histograms in bulk, see TH1::FillN. Return false if the histogram is not one of them.
+   bool FillBulk(const std::vector<Double_t> &buffer, std::true_type)
+   {
+      ::TH1 &h = fHist;
+      if (h.GetDimension() != 1 || h.InheritsFrom("TProfile"))
+         return false;
+      h.FillN(buffer.size(), buffer.data(), nullptr);
+      return true;
+   }
+
+   // never called: managers can only be created for the TH1 family, but the fillers of other types must compile
+   bool FillBulk(const std::vector<Double_t> &, std::false_type) { return false; }
+
+   template <unsigned int N>
+   void FillN(const std::vector<Double_t> &buffer)
+   {
+      if (N == 1 && FillBulk(buffer, std::is_base_of<::TH1, HIST>{}))
+         return;
+      for (std::size_t i = 0; i < buffer.size(); i += N)
+         CallFill(&buffer[i], std::make_integer_sequence<unsigned int, N>());
+   }
+
+   /// Replay the buffered Fill calls, each with nArgs arguments.
+   void FillN(unsigned int nArgs, const std::vector<Double_t> &buffer)
+   {
+      std::lock_guard<std::mutex> lock(fFillMutex);
+      switch (nArgs) {
+      case 1: FillN<1>(buffer); break;
+      case 2: FillN<2>(buffer); break;
+      case 3: FillN<3>(buffer); break;
+      case 4: FillN<4>(buffer); break;
+      }
+   }
+
+public:
+   explicit TH1ConcurrentFillManager(HIST &hist) : fHist(hist)
+   {
+      static_assert(std::is_base_of<::TH1, HIST>::value, "TH1ConcurrentFillManager fills histograms of the TH1 family.");
+   }
+   TH1ConcurrentFillManager(const TH1ConcurrentFillManager &) = delete;
+   TH1ConcurrentFillManager &operator=(const TH1ConcurrentFillManager &) = delete;
+
+   /// Return a filler for one thread, which submits its Fill calls every bufferSize calls.
+   TH1ConcurrentFiller<HIST> MakeFiller(std::size_t bufferSize = 1024)
+   {
+      return TH1ConcurrentFiller<HIST>(*this, bufferSize);
+   }
+
+   /// Return the histogram. It must not be read while fillers may be submitting their calls, see WithLock.
+   HIST &GetHist() { return fHist; }
+
+   /// Call f with the histogram while no filler can submit its calls, and return its result.
+   template <typename F>
+   auto WithLock(F &&f) -> decltype(f(std::declval<HIST &>()))
+   {
+      std::lock_guard<std::mutex> lock(fFillMutex);
+      return f(fHist);
+   }
+
+   /// Return a copy of the histogram, not attached to any directory, made while no filler can submit its calls.
+   std::unique_ptr<HIST> Snapshot()
+   {
+      return WithLock([](HIST &h) {
+         std::unique_ptr<HIST> copy(new HIST(h));
+         copy->SetDirectory(nullptr);
+         return copy;
+      });
+   }
+};
+
+} // namespace Experimental
+} // namespace ROOT
+
+#endif
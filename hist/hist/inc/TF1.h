@@ -24,6 +24,7 @@
 #include "RConfigure.h"
 #include <functional>
 #include <cassert>
+#include <memory>
 #include <string>
 #include <vector>
 #include "TFormula.h"
@@ -32,6 +33,7 @@
 #include "TAttFill.h"
 #include "TAttMarker.h"
 #include "TF1AbsComposition.h"
+#include "TF1SamplingTable.h"
 #include "TMath.h"
 #include "Math/Types.h"
 #include "Math/ParamFunctor.h"
@@ -255,10 +257,10 @@ protected:
    std::vector<Double_t>    fParMin;                ///<  Array of lower limits of the fNpar parameters
    std::vector<Double_t>    fParMax;                ///<  Array of upper limits of the fNpar parameters
    std::vector<Double_t>    fSave;                  ///<  Array of fNsave function values
-   std::vector<Double_t>    fIntegral;              ///<! Integral of function binned on fNpx bins
-   std::vector<Double_t>    fAlpha;                 ///<! Array alpha. for each bin in x the deconvolution r of fIntegral
-   std::vector<Double_t>    fBeta;                  ///<! Array beta.  is approximated by x = alpha +beta*r *gamma*r**2
-   std::vector<Double_t>    fGamma;                 ///<! Array gamma.
+   std::vector<Double_t>    fIntegral;              ///<! Integral of function binned on cells, used by TF2::GetRandom and TF3::GetRandom
+   std::shared_ptr<const TF1SamplingTable> fSamplingTable; ///<! Cumulative integral tabulated at fNpx points, used by GetRandom
+   struct TF1IntegralCache;
+   std::shared_ptr<TF1IntegralCache> fIntegralCache;       ///<! Integrals already computed, by range and parameter values
    TObject     *fParent{nullptr};                   ///<! Parent object hooking this function (if one)
    TH1         *fHistogram{nullptr};                ///<! Pointer to histogram used for visualisation
    std::unique_ptr<TMethodCall> fMethodCall;        ///<! Pointer to MethodCall in case of interpreted function
@@ -311,8 +313,6 @@ protected:
    void DoInitialize(EAddToList addToGlobList);
 
    void IntegrateForNormalization();
-   // tabulate the cumulative function integral at  fNpx points. Used by GetRandom
-   Bool_t ComputeCdfTable(Option_t * opt);
 
    virtual Double_t GetMinMaxNDim(Double_t *x , Bool_t findmax, Double_t epsilon = 0, Int_t maxiter = 0) const;
    virtual void GetRange(Double_t *xmin, Double_t *xmax) const;
@@ -433,6 +433,7 @@ public:
    //template <class T> T Eval(T x, T y = 0, T z = 0, T t = 0) const;
    virtual Double_t EvalPar(const Double_t *x, const Double_t *params = 0);
    template <class T> T EvalPar(const T *x, const Double_t *params = 0);
+   void             EvalBatch(Int_t n, const Double_t *x, const Double_t *params, Double_t *out);
    virtual Double_t operator()(Double_t x, Double_t y = 0, Double_t z = 0, Double_t t = 0) const;
    template <class T> T operator()(const T *x, const Double_t *params = nullptr);
    virtual void     ExecuteEvent(Int_t event, Int_t px, Int_t py);
@@ -544,6 +545,8 @@ public:
    virtual Int_t    GetQuantiles(Int_t nprobSum, Double_t *q, const Double_t *probSum);
    virtual Double_t GetRandom(TRandom * rng = nullptr, Option_t * opt = nullptr);
    virtual Double_t GetRandom(Double_t xmin, Double_t xmax, TRandom * rng = nullptr, Option_t * opt = nullptr);
+   void             GetRandom(Int_t n, Double_t *x, TRandom * rng = nullptr, Option_t * opt = nullptr);
+   std::shared_ptr<const TF1SamplingTable> GetSamplingTable(Option_t * opt = nullptr);
    virtual void     GetRange(Double_t &xmin, Double_t &xmax) const;
    virtual void     GetRange(Double_t &xmin, Double_t &ymin, Double_t &xmax, Double_t &ymax) const;
    virtual void     GetRange(Double_t &xmin, Double_t &ymin, Double_t &zmin, Double_t &xmax, Double_t &ymax, Double_t &zmax) const;
@@ -579,6 +582,8 @@ public:
    virtual void     InitArgs(const Double_t *x, const Double_t *params);
    static  void     InitStandardFunctions();
    virtual Double_t Integral(Double_t a, Double_t b, Double_t epsrel = 1.e-12);
+   void             SetIntegralCache(Int_t maxEntries = 10000);
+   void             ClearIntegralCache();
    virtual Double_t IntegralOneDim(Double_t a, Double_t b, Double_t epsrel, Double_t epsabs, Double_t &err);
    virtual Double_t IntegralError(Double_t a, Double_t b, const Double_t *params = 0, const Double_t *covmat = 0, Double_t epsilon = 1.E-2);
    virtual Double_t IntegralError(Int_t n, const Double_t *a, const Double_t *b, const Double_t *params = 0, const Double_t *covmat = 0, Double_t epsilon = 1.E-2);
@@ -0,0 +1,64 @@
+// @(#)root/hist:$Id$
+
+/**********************************************************************
+ *                                                                    *
+ * Copyright (c) 2021  ROOT  Team, CERN/PH-SFT                        *
+ *                                                                    *
+ *                                                                    *
+ **********************************************************************/
+
+#ifndef ROOT_TF1SamplingTable
+#define ROOT_TF1SamplingTable
+
+#include "Rtypes.h"
+#include "TMath.h"
+#include <vector>
+
+class TF1;
+class TRandom;
+
+class TF1SamplingTable {
+
+private:
+   Int_t    fNpx{0};                 ///< Number of bins of the table
+   Double_t fXmin{0};                ///< Lower bound of the tabulated range
+   Double_t fXmax{0};                ///< Upper bound of the tabulated range
+   Bool_t   fLogScale{kFALSE};       ///< True if the bins are equidistant in log10(x)
+   std::vector<Double_t> fIntegral;  ///< Normalized cumulative integral at the fNpx+1 bin edges
+   std::vector<Double_t> fAlpha;     ///< For each bin the inverse of the cumulative integral r
+   std::vector<Double_t> fBeta;      ///< is approximated by x = alpha + beta*r + gamma*r**2
+   std::vector<Double_t> fGamma;
+
+   /// x of the cumulative integral value r in [0,1] that lies in the given bin
+   Double_t GetXInBin(Int_t bin, Double_t r) const
+   {
+      const Double_t rr = r - fIntegral[bin];
+      Double_t yy;
+      if (fGamma[bin] != 0)
+         yy = (-fBeta[bin] + TMath::Sqrt(fBeta[bin] * fBeta[bin] + 2 * fGamma[bin] * rr)) / fGamma[bin];
+      else
+         yy = rr / fBeta[bin];
+      const Double_t x = fAlpha[bin] + yy;
+      return fLogScale ? TMath::Power(10, x) : x;
+   }
+
+public:
+   TF1SamplingTable(TF1 &f, Option_t *option = nullptr);
+
+   /// False if the table could not be built, e.g. because the integral of the function is zero
+   Bool_t IsValid() const { return !fAlpha.empty(); }
+   Int_t GetNpx() const { return fNpx; }
+   Double_t GetXmin() const { return fXmin; }
+   Double_t GetXmax() const { return fXmax; }
+   Bool_t IsLogScale() const { return fLogScale; }
+   /// The normalized cumulative integral at the GetNpx()+1 bin edges
+   const std::vector<Double_t> &GetCdf() const { return fIntegral; }
+
+   Double_t GetX(Double_t r) const;
+   void GetX(Int_t n, const Double_t *r, Double_t *x) const;
+   Double_t GetRandom(TRandom *rng = nullptr) const;
+   void GetRandom(Int_t n, Double_t *x, TRandom *rng = nullptr) const;
+   Double_t GetRandom(Double_t xmin, Double_t xmax, TRandom *rng = nullptr) const;
+};
+
+#endif
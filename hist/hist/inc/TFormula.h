@@ -105,6 +105,7 @@ private:
    CallFuncSignature fFuncPtr = nullptr;           ///<! Function pointer, owned by the JIT.
    CallFuncSignature fGradFuncPtr = nullptr;       ///<! Function pointer, owned by the JIT.
    CallFuncSignature fHessFuncPtr = nullptr;       ///<! Function pointer, owned by the JIT.
+   mutable std::atomic<CallFuncSignature> fBatchFuncPtr{nullptr}; ///<! Function pointer of the loop over points, owned by the JIT.
    void *   fLambdaPtr = nullptr;                  ///<! Pointer to the lambda function
    static bool       fIsCladRuntimeIncluded;
 
@@ -137,6 +138,7 @@ private:
    bool HasHessianGenerationFailed() const {
       return !fHessFuncPtr && !fHessGenerationInput.empty();
    }
+   CallFuncSignature GetBatchFuncPtr() const;
 
 protected:
 
@@ -202,6 +204,7 @@ public:
    Double_t       Eval(Double_t x, Double_t y , Double_t z) const;
    Double_t       Eval(Double_t x, Double_t y , Double_t z , Double_t t ) const;
    Double_t       EvalPar(const Double_t *x, const Double_t *params=0) const;
+   void           EvalBatch(Int_t nPoints, const Double_t *x, const Double_t *params, Double_t *out) const;
 
    /// Generate gradient computation routine with respect to the parameters.
    /// \returns true if a gradient was generated and GradientPar can be called.
@@ -29,6 +29,8 @@
 #include "TVectorDfwd.h"
 #include "TFitResultPtr.h"
 
+#include <vector>
+
 class TBrowser;
 class TAxis;
 class TH1;
@@ -36,6 +38,7 @@ class TH1F;
 class TCollection;
 class TF1;
 class TSpline;
+class TSpline3;
 class TList;
 
 class TGraph : public TNamed, public TAttLine, public TAttFill, public TAttMarker {
@@ -51,6 +54,9 @@ protected:
    Double_t           fMinimum;   ///< Minimum value for plotting along y
    Double_t           fMaximum;   ///< Maximum value for plotting along y
 
+   mutable TSpline3  *fEvalSpline{nullptr}; ///<! Spline of the points used by Eval with option "S"
+   mutable std::vector<Double_t> fEvalSplinePoints; ///<! Points from which fEvalSpline was built
+
    static void        SwapValues(Double_t* arr, Int_t pos1, Int_t pos2);
    virtual void       SwapPoints(Int_t pos1, Int_t pos2);
 
@@ -62,6 +68,7 @@ protected:
    Double_t         **ExpandAndCopy(Int_t size, Int_t iend);
    virtual void       FillZero(Int_t begin, Int_t end, Bool_t from_ctor = kTRUE);
    Double_t         **ShrinkAndCopy(Int_t size, Int_t iend);
+   TSpline3          *GetEvalSpline() const;
    virtual Bool_t     DoMerge(const TGraph * g);
 
 public:
@@ -105,6 +112,7 @@ public:
    virtual void          DrawGraph(Int_t n, const Double_t *x=nullptr, const Double_t *y=nullptr, Option_t *option="");
    virtual void          DrawPanel(); // *MENU*
    virtual Double_t      Eval(Double_t x, TSpline *spline=nullptr, Option_t *option="") const;
+   void                  Eval(Int_t n, const Double_t *x, Double_t *y, TSpline *spline=nullptr, Option_t *option="") const;
    virtual void          ExecuteEvent(Int_t event, Int_t px, Int_t py);
    virtual void          Expand(Int_t newsize);
    virtual void          Expand(Int_t newsize, Int_t step);
@@ -149,6 +149,7 @@ protected:
                                Option_t * opt, Bool_t doerr = kFALSE) const;
 
    virtual void     DoFillN(Int_t ntimes, const Double_t *x, const Double_t *w, Int_t stride=1);
+   void             DoFillNFixBins(Int_t ntimes, const Double_t *x, const Double_t *w, Int_t stride);
    Bool_t    GetStatOverflowsBehaviour() const { return EStatOverflows::kNeutral == fStatOverflows ? fgStatOverflows : EStatOverflows::kConsider == fStatOverflows; }
 
    static bool CheckAxisLimits(const TAxis* a1, const TAxis* a2);
@@ -22,6 +22,8 @@
 
 #include "TH2.h"
 
+#include <atomic>
+
 class TH2PolyBin: public TObject{
 
 public:
@@ -63,6 +65,12 @@ class TGraph;
 class TMultiGraph;
 class TPad;
 
+namespace ROOT {
+namespace Internal {
+class TH2PolyBinIndex;
+}
+}
+
 class TH2Poly : public TH2 {
 
 public:
@@ -95,6 +103,7 @@ public:
    virtual Int_t Fill(const char* name, Double_t w);
    void         FillN(Int_t ntimes, const Double_t* x, const Double_t* y, const Double_t* w, Int_t stride = 1);
    Int_t        FindBin(Double_t x, Double_t y, Double_t z = 0);
+   void         FindBins(Int_t n, const Double_t *x, const Double_t *y, Int_t *bins) const;
    TList       *GetBins(){return fBins;} ///< Returns the TList of all bins in the histogram
    virtual Double_t     GetBinContent(Int_t bin) const;
    Bool_t       GetBinContentChanged() const{return fBinContentChanged;}
@@ -165,8 +174,11 @@ protected:
    Bool_t   fNewBinAdded;          ///<!For the 3D Painter
    Bool_t   fBinContentChanged;    ///<!For the 3D Painter
    TList   *fBins;                 ///< List of bins. The list owns the contained objects
+   mutable std::atomic<ROOT::Internal::TH2PolyBinIndex *> fBinIndex{nullptr}; ///<! Bounding volume hierarchy of the bins, built on first use
 
    void   AddBinToPartition(TH2PolyBin *bin);  // Adds the input bin into the partition matrix
+   TH2PolyBin *FindPolyBin(Double_t x, Double_t y) const; // Bin containing (x,y), without the overflow checks
+   const ROOT::Internal::TH2PolyBinIndex *GetBinIndex() const;
    void   Initialize(Double_t xlow, Double_t xup, Double_t ylow, Double_t yup, Int_t n, Int_t m);
    Bool_t IsIntersecting(TH2PolyBin *bin, Double_t xclipl, Double_t xclipr, Double_t yclipb, Double_t yclipt);
    Bool_t IsIntersectingPolygon(Int_t bn, Double_t *x, Double_t *y, Double_t xclipl, Double_t xclipr, Double_t yclipb, Double_t yclipt);
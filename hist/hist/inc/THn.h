@@ -35,6 +35,8 @@ private:
 protected:
    void AllocCoordBuf() const;
    void InitStorage(Int_t* nbins, Int_t chunkSize);
+   void AddInternal(const THnBase* h, Double_t c, Bool_t rebinned);
+   void AddBins(const THn* h, Double_t c, Long64_t first, Long64_t last);
 
    THn(): fCoordBuf() {}
    THn(const char* name, const char* title, Int_t dim, const Int_t* nbins,
@@ -172,6 +174,7 @@ public:
       return (THn*) RebinBase(group);
    }
 
+   Long64_t Merge(TCollection* list);
    void Reset(Option_t* option = "");
 
 protected:
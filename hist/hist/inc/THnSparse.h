@@ -21,7 +21,6 @@
 
 
 #include "THnBase.h"
-#include "TExMap.h"
 #include "THnSparse_Internal.h"
 
 // needed only for template instantiations of THnSparseT:
@@ -31,6 +30,8 @@
 #include "TArrayS.h"
 #include "TArrayC.h"
 
+#include <vector>
+
 class THnSparseCompactBinCoord;
 
 class THnSparse: public THnBase {
@@ -38,8 +39,7 @@ class THnSparse: public THnBase {
    Int_t      fChunkSize;                   ///<  Number of entries for each chunk
    Long64_t   fFilledBins;                  ///<  Number of filled bins
    TObjArray  fBinContent;                  ///<  Array of THnSparseArrayChunk
-   TExMap     fBins;                        ///<! Filled bins
-   TExMap     fBinsContinued;               ///<! Filled bins for non-unique hashes, containing pairs of (bin index 0, bin index 1)
+   std::vector<ULong64_t> fBins;            ///<! Open-addressing index of the filled bins: pairs of (hash, bin index + 1)
    THnSparseCompactBinCoord *fCompactCoord; ///<! Compact coordinate
 
    THnSparse(const THnSparse&); // Not implemented
@@ -58,8 +58,12 @@ class THnSparse: public THnBase {
    THnSparseArrayChunk* AddChunk();
    void Reserve(Long64_t nbins);
    void FillExMap();
+   void InsertBinIndex(ULong64_t hash, Long64_t idx);
+   Long64_t FindBinIndex(ULong64_t hash, const Char_t* buf) const;
    virtual TArray* GenerateArray() const = 0;
    Long64_t GetBinIndexForCurrentBin(Bool_t allocate);
+   Bool_t HasSameCompactCoord(const THnBase* h) const;
+   void AddInternal(const THnBase* h, Double_t c, Bool_t rebinned);
 
    /// Increment the bin content of "bin" by "w",
    /// return the bin index.
@@ -124,6 +128,9 @@ class THnSparse: public THnBase {
    Double_t GetBinContent(Long64_t bin, Int_t* idx = 0) const;
    Double_t GetBinError2(Long64_t linidx) const;
 
+   void FillN(Int_t n, const Double_t* x, const Double_t* w = nullptr);
+   Long64_t Merge(TCollection* list);
+
    Double_t GetSparseFractionBins() const;
    Double_t GetSparseFractionMem() const;
 
@@ -123,6 +123,7 @@ public:
    void SetUseBinsNEvents(UInt_t nEvents);
    void SetTuneFactor(Double_t rho);
    void SetRange(Double_t xMin, Double_t xMax); ///< By default computed from the data
+   void SetTolerance(Double_t tol);
 
    virtual void Draw(const Option_t* option = "");
 
@@ -130,6 +131,7 @@ public:
    Double_t operator()(const Double_t* x, const Double_t* p=0) const;  // Needed for creating TF1
 
    Double_t GetValue(Double_t x) const { return (*this)(x); }
+   void GetValues(UInt_t n, const Double_t* x, Double_t* values) const;
    Double_t GetError(Double_t x) const;
 
    Double_t GetBias(Double_t x) const;
@@ -138,6 +140,7 @@ public:
    Double_t GetRAMISE() const;
 
    Double_t GetFixedWeight() const;
+   Double_t GetTolerance() const { return fTolerance; }
 
    TF1* GetFunction(UInt_t npx = 100, Double_t xMin = 1.0, Double_t xMax = 0.0);
    TF1* GetUpperFunction(Double_t confidenceLevel = 0.95, UInt_t npx = 100, Double_t xMin = 1.0, Double_t xMax = 0.0);
@@ -164,6 +167,18 @@ public:
       TKDE *fKDE;
       UInt_t fNWeights;               ///< Number of kernel weights (bandwidth as vectorized for binning)
       std::vector<Double_t> fWeights; ///< Kernel weights (bandwidth)
+      std::vector<Double_t> fSourceX;        ///< Positions of the kernels, including the reflected ones, in ascending order
+      std::vector<Double_t> fSourceCount;    ///< Bin count of each kernel divided by its bandwidth
+      std::vector<Double_t> fSourceInvWeight; ///< Inverse of the bandwidth of each kernel
+      Double_t fSupport;                     ///< Distance beyond which the kernels vanish (0 if unknown)
+      UInt_t fNTerms;                        ///< Number of terms of the fast Gauss transform expansions (0 if not used)
+      UInt_t fNBoxes;                        ///< Number of boxes of the fast Gauss transform
+      Double_t fBoxMin;                      ///< Lower edge of the first box, in units of the bandwidth
+      Double_t fCutoff;                      ///< Distance, in units of the bandwidth, beyond which the boxes are neglected
+      std::vector<Double_t> fCoefficients;   ///< Taylor coefficients of the expansions of each box
+      void SetSources();
+      void SetExpansions();
+      Double_t EvaluateExpansions(Double_t x) const;
    public:
       TKernel(Double_t weight, TKDE *kde);
       void ComputeAdaptiveWeights();
@@ -221,6 +236,7 @@ private:
    Double_t fAdaptiveBandwidthFactor;  ///< Geometric mean of the kernel density estimation from the data for adaptive iteration
 
    Double_t fWeightSize;               ///< Caches the weight size
+   Double_t fTolerance;                ///< Tolerance of the fast Gauss transform (0 for the exact evaluation)
 
    std::vector<Double_t> fCanonicalBandwidths;
    std::vector<Double_t> fKernelSigmas2;
@@ -298,7 +314,7 @@ private:
    TF1* GetPDFUpperConfidenceInterval(Double_t confidenceLevel = 0.95, UInt_t npx = 100, Double_t xMin = 1.0, Double_t xMax = 0.0);
    TF1* GetPDFLowerConfidenceInterval(Double_t confidenceLevel = 0.95, UInt_t npx = 100, Double_t xMin = 1.0, Double_t xMax = 0.0);
 
-   ClassDef(TKDE, 3) // One dimensional semi-parametric Kernel Density Estimation
+   ClassDef(TKDE, 4) // One dimensional semi-parametric Kernel Density Estimation
 
 };
 
@@ -17,6 +17,7 @@
 #include "Fit/BinData.h"
 #include "Fit/UnBinData.h"
 #include "Fit/Chi2FCN.h"
+#include "Fit/FitUtil.h"
 #include "Fit/PoissonLikelihoodFCN.h"
 #include "HFitInterface.h"
 #include "Math/MinimizerOptions.h"
@@ -58,6 +59,8 @@ namespace HFit {
 
    void GetFunctionRange(const TF1 & f1, ROOT::Fit::DataRange & range);
 
+   bool GenerateCladGradient(TF1 * f1);
+
    void FitOptionsMake(const char *option, Foption_t &fitOption);
 
    void CheckGraphFitOptions(Foption_t &fitOption);
@@ -128,6 +131,17 @@ void HFit::GetFunctionRange(const TF1 & f1, ROOT::Fit::DataRange & range) {
    return;
 }
 
+bool HFit::GenerateCladGradient(TF1 * f1) {
+   // generate with Clad the gradient with respect to the parameters of a function defined by a formula,
+   // which is then used by TF1::GradientPar instead of the numerical derivatives
+   // (i.e. one evaluation of the gradient instead of 2*npar evaluations of the function)
+   TFormula * formula = f1->GetFormula();
+   if (!formula || !formula->IsValid() || formula->IsLinear() || formula->IsVectorized() ||
+       formula->TestBit(TFormula::kLambda) || f1->IsEvalNormalized())
+      return false;
+   return formula->GenerateGradientPar();
+}
+
 
 template<class FitObject>
 TFitResultPtr HFit::Fit(FitObject * h1, TF1 *f1 , Foption_t & fitOption , const ROOT::Math::MinimizerOptions & minOption, const char *goption, ROOT::Fit::DataRange & range)
@@ -231,7 +245,9 @@ TFitResultPtr HFit::Fit(FitObject * h1, TF1 *f1 , Foption_t & fitOption , const
 
 
    // set the fit function
-   // if option grad is specified use gradient
+   // if option grad is specified use gradient (computed with Clad for the functions defined by a formula)
+   if (fitOption.Gradient && !linear)
+      HFit::GenerateCladGradient(f1);
    if ( (linear || fitOption.Gradient) )
       fitter->SetFunction(ROOT::Math::WrappedMultiTF1(*f1));
 #ifdef R__HAS_VECCORE
@@ -355,6 +371,10 @@ TFitResultPtr HFit::Fit(FitObject * h1, TF1 *f1 , Foption_t & fitOption , const
    }
 
 
+   // without an explicit option, the evaluation is multi-threaded only if there are enough points
+   if (!fitOption.ExplicitPolicy)
+      fitOption.ExecPolicy = ROOT::Fit::FitUtil::GetAutomaticExecutionPolicy(fitdata->Size());
+
    if (fitOption.User && userFcn) // user provided fit objective function
       fitok = fitter->FitFCN( userFcn );
    else if (fitOption.Like)  {// likelihood fit
@@ -684,6 +704,8 @@ void HFit::StoreAndDrawFitFunction(FitObject * h1, TF1 * f1, const ROOT::Fit::Da
 void ROOT::Fit::FitOptionsMake(EFitObjectType type, const char *option, Foption_t &fitOption) {
    //   - Decode list of options into fitOption (used by both TGraph and TH1)
    //  works for both histograms and graph depending on the enum FitObjectType defined in HFit
+   //  unless "SERIAL" or "MULTITHREAD" is given, the policy is chosen again in the fit from the size of the data
+   //  (see ROOT::Fit::FitUtil::GetAutomaticExecutionPolicy)
    if(ROOT::IsImplicitMTEnabled()) {
       fitOption.ExecPolicy = ROOT::EExecutionPolicy::kMultiThread;
    }
@@ -716,11 +738,13 @@ void ROOT::Fit::FitOptionsMake(EFitObjectType type, const char *option, Foption_
 
       if (opt.Contains("SERIAL")) {
          fitOption.ExecPolicy = ROOT::EExecutionPolicy::kSequential;
+         fitOption.ExplicitPolicy = 1;
          opt.ReplaceAll("SERIAL","");
       }
 
       if (opt.Contains("MULTITHREAD")) {
          fitOption.ExecPolicy = ROOT::EExecutionPolicy::kMultiThread;
+         fitOption.ExplicitPolicy = 1;
          opt.ReplaceAll("MULTITHREAD","");
       }
 
@@ -844,6 +868,7 @@ TFitResultPtr ROOT::Fit::UnBinFit(ROOT::Fit::UnBinData * data, TF1 * fitfunc, Fo
    // need to create a wrapper for an automatic  normalized TF1 ???
    if ( fitOption.Gradient ) {
       assert ( (int) dim == fitfunc->GetNdim() );
+      HFit::GenerateCladGradient(fitfunc);
       fitter->SetFunction(ROOT::Math::WrappedMultiTF1(*fitfunc) );
    }
    else
@@ -908,6 +933,8 @@ TFitResultPtr ROOT::Fit::UnBinFit(ROOT::Fit::UnBinData * data, TF1 * fitfunc, Fo
    bool extended = (fitOption.Like & 1) == 1;
 
    bool fitok = false;
+   if (!fitOption.ExplicitPolicy)
+      fitOption.ExecPolicy = ROOT::Fit::FitUtil::GetAutomaticExecutionPolicy(fitdata->Size());
    fitok = fitter->LikelihoodFit(fitdata, extended, fitOption.ExecPolicy);
    if ( !fitok  && !fitOption.Quiet )
       Warning("UnBinFit","Abnormal termination of minimization.");
@@ -57,6 +57,12 @@ bool IsPointOutOfRange(const TF1 * func, const double * x) {
    return !func->IsInside(x);
 }
 
+bool MayRejectPoints(const TF1 * func) {
+   // points are rejected only by the functions written in C++ calling TF1::RejectPoint:
+   // the functions defined by a formula do not need to be evaluated to fill the data
+   return func != 0 && func->GetFormula() == 0;
+}
+
 bool AdjustError(const DataOptions & option, double & error, double value = 1) {
    // adjust the given error according to the option
    // return false when point must be skipped.
@@ -218,7 +224,7 @@ void FillData(BinData & dv, const TH1 * hfit, TF1 * func)
 
             // need to evaluate function to know about rejected points
             // hugly but no other solutions
-            if (func != 0) {
+            if (HFitInterface::MayRejectPoints(func)) {
                TF1::RejectPoint(false);
                (*func)( &x[0] );  // evaluate using stored function parameters
                if (TF1::RejectedPoint() ) continue;
@@ -606,7 +612,7 @@ void DoFillData ( BinData  & dv,  const TGraph * gr,  BinData::ErrorType type, T
 
       // need to evaluate function to know about rejected points
       // hugly but no other solutions
-      if (func) {
+      if (HFitInterface::MayRejectPoints(func)) {
          TF1::RejectPoint(false);
          (*func)( x ); // evaluate using stored function parameters
          if (TF1::RejectedPoint() ) continue;
@@ -920,7 +926,7 @@ void FillData ( BinData  & dv, const TGraph2D * gr, TF1 * func ) {
 
       // need to evaluate function to know about rejected points
       // hugly but no other solutions
-      if (func) {
+      if (HFitInterface::MayRejectPoints(func)) {
          TF1::RejectPoint(false);
          (*func)( x ); // evaluate using stored function parameters
          if (TF1::RejectedPoint() ) continue;
@@ -9,7 +9,11 @@
  * For the list of contributors see $ROOTSYS/README/CREDITS.             *
  *************************************************************************/
 
+#include <algorithm>
 #include <iostream>
+#include <map>
+#include <mutex>
+#include <vector>
 #include "strlcpy.h"
 #include "snprintf.h"
 #include "TROOT.h"
@@ -493,6 +497,13 @@ See also the tutorial __math/exampleFunctor.C__ for a running example.
 
 TF1 *TF1::fgCurrent = 0;
 
+/// Values of TF1::Integral, by integration range, tolerance, normalization flag and parameter values
+struct TF1::TF1IntegralCache {
+   std::mutex fMutex;
+   std::map<std::vector<Double_t>, Double_t> fValues;
+   std::size_t fMaxEntries = 0;
+};
+
 
 ////////////////////////////////////////////////////////////////////////////////
 /// TF1 default constructor.
@@ -994,7 +1005,7 @@ void TF1::Browse(TBrowser *b)
 
 ////////////////////////////////////////////////////////////////////////////////
 /// Copy this F1 to a new F1.
-/// Note that the cached integral with its related arrays are not copied
+/// Note that the cached integral table and the cached integral values are not copied
 /// (they are also set as transient data members)
 
 void TF1::Copy(TObject &obj) const
@@ -1027,6 +1038,10 @@ void TF1::Copy(TObject &obj) const
    ((TF1 &)obj).fNormalized = fNormalized;
    ((TF1 &)obj).fNormIntegral = fNormIntegral;
    ((TF1 &)obj).fFormula   = 0;
+   ((TF1 &)obj).fIntegral.clear();
+   std::atomic_store(&((TF1 &)obj).fSamplingTable, std::shared_ptr<const TF1SamplingTable>());
+   ((TF1 &)obj).fIntegralCache.reset();
+   if (fIntegralCache) ((TF1 &)obj).SetIntegralCache(fIntegralCache->fMaxEntries);
 
    if (fFormula) assert(fFormula->GetNpar() == fNpar);
 
@@ -1529,6 +1544,32 @@ Double_t TF1::EvalPar(const Double_t *x, const Double_t *params)
    return result;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Evaluate the function on n points, storing the values in out.
+/// The coordinates of point i are x[i * GetNdim()] to x[(i + 1) * GetNdim() - 1];
+/// params are used as in EvalPar().
+/// Functions defined by a formula are evaluated in one call of
+/// TFormula::EvalBatch(), the other ones point by point.
+
+void TF1::EvalBatch(Int_t n, const Double_t *x, const Double_t *params, Double_t *out)
+{
+   if (fType == EFType::kFormula) {
+      assert(fFormula);
+      fFormula->EvalBatch(n, x, params, out);
+      if (fNormalized && fNormIntegral != 0) {
+         for (Int_t i = 0; i < n; ++i)
+            out[i] /= fNormIntegral;
+      }
+      return;
+   }
+
+   for (Int_t i = 0; i < n; ++i) {
+      const Double_t *xi = x + i * fNdim;
+      InitArgs(xi, params);
+      out[i] = EvalPar(xi, params);
+   }
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Execute action corresponding to one event.
 ///
@@ -2068,90 +2109,6 @@ Int_t TF1::GetQuantiles(Int_t nprobSum, Double_t *q, const Double_t *probSum)
 
    return nprobSum;
 }
-////////////////////////////////////////////////////////////////////////////////
-///
-///  Compute the cumulative function at fNpx points between fXmin and fXmax.
-///  Option can be used to force a log scale (option = "log"), linear (option = "lin") or automatic if empty.
-Bool_t TF1::ComputeCdfTable(Option_t * option) {
-
-   fIntegral.resize(fNpx + 1);
-   fAlpha.resize(fNpx + 1);
-   fBeta.resize(fNpx);
-   fGamma.resize(fNpx);
-   fIntegral[0] = 0;
-   fAlpha[fNpx] = 0;
-   Double_t integ;
-   Int_t intNegative = 0;
-   Int_t i;
-   Bool_t logbin = kFALSE;
-   Double_t dx;
-   Double_t xmin = fXmin;
-   Double_t xmax = fXmax;
-   TString opt(option);
-   opt.ToUpper();
-   // perform a log binning if specified by user (option="Log") or if some conditions are met
-   // and the user explicitly does not specify a Linear binning option
-   if (opt.Contains("LOG") || ((xmin > 0 && xmax / xmin > fNpx) && !opt.Contains("LIN"))) {
-      logbin = kTRUE;
-      fAlpha[fNpx] = 1;
-      xmin = TMath::Log10(fXmin);
-      xmax = TMath::Log10(fXmax);
-      if (gDebug)
-         Info("GetRandom", "Use log scale for tabulating the integral in [%f,%f] with %d points", fXmin, fXmax, fNpx);
-   }
-   dx = (xmax - xmin) / fNpx;
-
-   std::vector<Double_t> xx(fNpx + 1);
-   for (i = 0; i < fNpx; i++) {
-      xx[i] = xmin + i * dx;
-   }
-   xx[fNpx] = xmax;
-   for (i = 0; i < fNpx; i++) {
-      if (logbin) {
-         integ = Integral(TMath::Power(10, xx[i]), TMath::Power(10, xx[i + 1]), 0.0);
-      } else {
-         integ = Integral(xx[i], xx[i + 1], 0.0);
-      }
-      if (integ < 0) {
-         intNegative++;
-         integ = -integ;
-      }
-      fIntegral[i + 1] = fIntegral[i] + integ;
-   }
-   if (intNegative > 0) {
-      Warning("GetRandom", "function:%s has %d negative values: abs assumed", GetName(), intNegative);
-   }
-   if (fIntegral[fNpx] == 0) {
-      Error("GetRandom", "Integral of function is zero");
-      return kFALSE;
-   }
-   Double_t total = fIntegral[fNpx];
-   for (i = 1; i <= fNpx; i++) { // normalize integral to 1
-      fIntegral[i] /= total;
-   }
-   // the integral r for each bin is approximated by a parabola
-   //  x = alpha + beta*r +gamma*r**2
-   // compute the coefficients alpha, beta, gamma for each bin
-   Double_t x0, r1, r2, r3;
-   for (i = 0; i < fNpx; i++) {
-      x0 = xx[i];
-      r2 = fIntegral[i + 1] - fIntegral[i];
-      if (logbin)
-         r1 = Integral(TMath::Power(10, x0), TMath::Power(10, x0 + 0.5 * dx), 0.0) / total;
-      else
-         r1 = Integral(x0, x0 + 0.5 * dx, 0.0) / total;
-      r3 = 2 * r2 - 4 * r1;
-      if (TMath::Abs(r3) > 1e-8)
-         fGamma[i] = r3 / (dx * dx);
-      else
-         fGamma[i] = 0;
-      fBeta[i] = r2 / dx - fGamma[i] * dx;
-      fAlpha[i] = x0;
-      fGamma[i] *= 2;
-   }
-   return kTRUE;
-}
-
 ////////////////////////////////////////////////////////////////////////////////
 /// Return a random number following this function shape.
 ///
@@ -2166,7 +2123,7 @@ Bool_t TF1::ComputeCdfTable(Option_t * option) {
 /// over the channel contents.
 /// It is normalized to 1.
 /// For each bin the integral is approximated by a parabola.
-/// The parabola coefficients are stored as non persistent data members
+/// The parabola coefficients are stored in the TF1SamplingTable returned by GetSamplingTable
 /// Getting one random number implies:
 ///  - Generating a random number between 0 and 1 (say r1)
 ///  - Look in which bin in the normalized integral r1 corresponds to
@@ -2185,26 +2142,47 @@ Bool_t TF1::ComputeCdfTable(Option_t * option) {
 
 Double_t TF1::GetRandom(TRandom * rng, Option_t * option)
 {
-   //  Check if integral array must be built
-   if (fIntegral.size() == 0) {
-      Bool_t ret = ComputeCdfTable(option);
-      if (!ret) return TMath::QuietNaN();
-   }
+   return GetSamplingTable(option)->GetRandom(rng);
+}
 
 
-   // return random number
-   Double_t r  = (rng) ? rng->Rndm() : gRandom->Rndm();
-   Int_t bin  = TMath::BinarySearch(fNpx, fIntegral.data(), r);
-   Double_t rr = r - fIntegral[bin];
+////////////////////////////////////////////////////////////////////////////////
+/// Fill the array x with n random numbers following this function shape.
+///
+/// The random numbers are generated as in GetRandom(TRandom *, Option_t *), but the
+/// n uniform numbers are generated at once and converted in a single pass over the table.
+///
+/// @param n  Number of random numbers to generate
+/// @param x  Array of (at least) n elements receiving the random numbers
+/// @param rng  Random number generator. By default (or when passing a nullptr) the global gRandom is used
+/// @param option `LOG` or `LIN` to force the usage of a log or linear scale for computing the cumulative integral table
 
-   Double_t yy;
-   if (fGamma[bin] != 0)
-      yy = (-fBeta[bin] + TMath::Sqrt(fBeta[bin] * fBeta[bin] + 2 * fGamma[bin] * rr)) / fGamma[bin];
-   else
-      yy = rr / fBeta[bin];
-   Double_t x = fAlpha[bin] + yy;
-   if (fAlpha[fNpx] > 0) return TMath::Power(10, x);
-   return x;
+void TF1::GetRandom(Int_t n, Double_t *x, TRandom * rng, Option_t * option)
+{
+   GetSamplingTable(option)->GetRandom(n, x, rng);
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return the table of the cumulative integral used by GetRandom, computing it at fNpx points
+/// if it does not exist yet.
+///
+/// Option is used only when the table is computed: `LOG` or `LIN` force the usage of a log or linear
+/// scale for tabulating the integral, by default a log scale is used if fXmax/fXmin > fNpx.
+/// The table is dropped by the function when its parameters, range or number of points change,
+/// but the returned table is never modified: it can be used by several threads at the same time to
+/// generate random numbers, each with its own random number generator, without cloning the function.
+/// If the integral of the function is zero the returned table is invalid (see TF1SamplingTable::IsValid)
+/// and generates NaN.
+
+std::shared_ptr<const TF1SamplingTable> TF1::GetSamplingTable(Option_t * option)
+{
+   std::shared_ptr<const TF1SamplingTable> table = std::atomic_load(&fSamplingTable);
+   if (!table) {
+      table = std::make_shared<TF1SamplingTable>(*this, option);
+      std::atomic_store(&fSamplingTable, table);
+   }
+   return table;
 }
 
 
@@ -2215,7 +2193,7 @@ Double_t TF1::GetRandom(TRandom * rng, Option_t * option)
 ///   over the channel contents.
 ///   It is normalized to 1.
 ///   For each bin the integral is approximated by a parabola.
-///   The parabola coefficients are stored as non persistent data members
+///   The parabola coefficients are stored in the TF1SamplingTable returned by GetSamplingTable
 ///   Getting one random number implies:
 ///     - Generating a random number between 0 and 1 (say r1)
 ///     - Look in which bin in the normalized integral r1 corresponds to
@@ -2238,35 +2216,7 @@ Double_t TF1::GetRandom(TRandom * rng, Option_t * option)
 
 Double_t TF1::GetRandom(Double_t xmin, Double_t xmax, TRandom * rng, Option_t * option)
 {
-   //  Check if integral array must be built
-   if (fIntegral.size() == 0) {
-      Bool_t ret = ComputeCdfTable(option);
-      if (!ret) return TMath::QuietNaN();
-   }
-
-   // return random number
-   Double_t dx   = (fXmax - fXmin) / fNpx;
-   Int_t nbinmin = (Int_t)((xmin - fXmin) / dx);
-   Int_t nbinmax = (Int_t)((xmax - fXmin) / dx) + 2;
-   if (nbinmax > fNpx) nbinmax = fNpx;
-
-   Double_t pmin = fIntegral[nbinmin];
-   Double_t pmax = fIntegral[nbinmax];
-
-   Double_t r, x, xx, rr;
-   do {
-      r  = (rng) ? rng->Uniform(pmin, pmax) : gRandom->Uniform(pmin, pmax);
-
-      Int_t bin  = TMath::BinarySearch(fNpx, fIntegral.data(), r);
-      rr = r - fIntegral[bin];
-
-      if (fGamma[bin] != 0)
-         xx = (-fBeta[bin] + TMath::Sqrt(fBeta[bin] * fBeta[bin] + 2 * fGamma[bin] * rr)) / fGamma[bin];
-      else
-         xx = rr / fBeta[bin];
-      x = fAlpha[bin] + xx;
-   } while (x < xmin || x > xmax);
-   return x;
+   return GetSamplingTable(option)->GetRandom(xmin, xmax, rng);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -2457,13 +2407,16 @@ Double_t TF1::GradientPar(Int_t ipar, const Double_t *x, Double_t eps)
 /// default value of eps = 0.01
 /// Method is the same as in Derivative() function
 ///
-/// If a parameter is fixed, the gradient on this parameter = 0
+/// If a parameter is fixed, the gradient on this parameter = 0,
+/// except when it is computed with CLAD. CLAD is not used for normalized functions.
 
 void TF1::GradientPar(const Double_t *x, Double_t *grad, Double_t eps)
 {
-   if (fFormula && fFormula->HasGeneratedGradient())
+   if (fFormula && fFormula->HasGeneratedGradient() && !fNormalized) {
+      // the gradient generated by CLAD is accumulated in grad
+      std::fill(grad, grad + fNpar, 0.);
       fFormula->GradientPar(x,grad);
-   else
+   } else
       GradientParTempl<Double_t>(x, grad, eps);
 }
 
@@ -2517,22 +2470,81 @@ void TF1::InitStandardFunctions()
 }
 ////////////////////////////////////////////////////////////////////////////////
 /// IntegralOneDim or analytical integral
+///
+/// If the integral cache is enabled (see SetIntegralCache) the result is looked up by
+/// integration range, tolerance and parameter values before being computed.
 
 Double_t TF1::Integral(Double_t a, Double_t b,  Double_t epsrel)
 {
-   Double_t error = 0;
+   std::vector<Double_t> key;
+   if (fIntegralCache) {
+      key.reserve(fNpar + 5);
+      key.push_back(a);
+      key.push_back(b);
+      key.push_back(epsrel);
+      key.push_back(fNormalized);
+      key.push_back(fgAbsValue);
+      if (fNpar > 0) key.insert(key.end(), GetParameters(), GetParameters() + fNpar);
+      std::lock_guard<std::mutex> lock(fIntegralCache->fMutex);
+      auto it = fIntegralCache->fValues.find(key);
+      if (it != fIntegralCache->fValues.end()) return it->second;
+   }
+
+   Double_t result = TMath::QuietNaN();
    if (GetNumber() > 0) {
-      Double_t result = 0.;
       if (gDebug) {
          Info("computing analytical integral for function %s with number %d", GetName(), GetNumber());
       }
       result = AnalyticalIntegral(this, a, b);
       // if it is a formula that havent been implemented in analytical integral a NaN is return
-      if (!TMath::IsNaN(result)) return result;
-      if (gDebug)
+      if (TMath::IsNaN(result) && gDebug)
          Warning("analytical integral not available for %s - with number %d  compute numerical integral", GetName(), GetNumber());
    }
-   return IntegralOneDim(a, b, epsrel, epsrel, error);
+   if (TMath::IsNaN(result)) {
+      Double_t error = 0;
+      result = IntegralOneDim(a, b, epsrel, epsrel, error);
+   }
+
+   if (fIntegralCache) {
+      std::lock_guard<std::mutex> lock(fIntegralCache->fMutex);
+      // the cache is emptied when full, the values are cheap to recompute compared to a bookkeeping of their usage
+      if (fIntegralCache->fValues.size() >= fIntegralCache->fMaxEntries) fIntegralCache->fValues.clear();
+      fIntegralCache->fValues.emplace(std::move(key), result);
+   }
+   return result;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Enable the memoization of Integral(a, b, epsrel) by integration range, tolerance and parameter values,
+/// keeping at most maxEntries values. A maxEntries of zero disables (and deletes) the cache.
+///
+/// The cache is useful when the same integrals are computed again for parameter values already seen,
+/// e.g. the normalization integrals or the GetRandom table of a function whose parameters alternate
+/// between a few sets of values. The cached values are looked up under a lock, such that concurrent
+/// calls of Integral are safe as long as the function itself can be evaluated concurrently.
+/// Only the parameters are part of the key: ClearIntegralCache must be called after changing
+/// the function otherwise, e.g. its formula.
+
+void TF1::SetIntegralCache(Int_t maxEntries)
+{
+   if (maxEntries <= 0) {
+      fIntegralCache.reset();
+      return;
+   }
+   if (!fIntegralCache) fIntegralCache = std::make_shared<TF1IntegralCache>();
+   std::lock_guard<std::mutex> lock(fIntegralCache->fMutex);
+   fIntegralCache->fMaxEntries = maxEntries;
+   if (fIntegralCache->fValues.size() > fIntegralCache->fMaxEntries) fIntegralCache->fValues.clear();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Forget the integrals memoized since SetIntegralCache was called.
+
+void TF1::ClearIntegralCache()
+{
+   if (!fIntegralCache) return;
+   std::lock_guard<std::mutex> lock(fIntegralCache->fMutex);
+   fIntegralCache->fValues.clear();
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -3112,10 +3124,20 @@ TH1   *TF1::DoCreateHistogram(Double_t xmin, Double_t  xmax, Bool_t recreate)
    histogram->GetYaxis()->SetTitle(ytitle.Data());
    Double_t *parameters = GetParameters();
 
-   InitArgs(xv, parameters);
-   for (i = 1; i <= fNpx; i++) {
-      xv[0] = histogram->GetBinCenter(i);
-      histogram->SetBinContent(i, EvalPar(xv, parameters));
+   if (fType == EFType::kFormula && fFormula->GetNdim() <= 1) {
+      // sample the function in one batch
+      std::vector<Double_t> x(fNpx), values(fNpx);
+      for (i = 1; i <= fNpx; i++)
+         x[i - 1] = histogram->GetBinCenter(i);
+      EvalBatch(fNpx, x.data(), parameters, values.data());
+      for (i = 1; i <= fNpx; i++)
+         histogram->SetBinContent(i, values[i - 1]);
+   } else {
+      InitArgs(xv, parameters);
+      for (i = 1; i <= fNpx; i++) {
+         xv[0] = histogram->GetBinCenter(i);
+         histogram->SetBinContent(i, EvalPar(xv, parameters));
+      }
    }
 
    // Copy Function attributes to histogram attributes.
@@ -3631,12 +3653,8 @@ void TF1::Update()
 {
    delete fHistogram;
    fHistogram = 0;
-   if (!fIntegral.empty()) {
-      fIntegral.clear();
-      fAlpha.clear();
-      fBeta.clear();
-      fGamma.clear();
-   }
+   fIntegral.clear();
+   std::atomic_store(&fSamplingTable, std::shared_ptr<const TF1SamplingTable>());
    if (fNormalized) {
       // need to compute the integral of the not-normalized function
       fNormalized = false;
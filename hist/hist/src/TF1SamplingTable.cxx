@@ -0,0 +1,202 @@
+// @(#)root/hist:$Id$
+
+/**********************************************************************
+ *                                                                    *
+ * Copyright (c) 2021  ROOT  Team, CERN/PH-SFT                        *
+ *                                                                    *
+ *                                                                    *
+ **********************************************************************/
+
+#include "TF1SamplingTable.h"
+#include "TF1.h"
+#include "TRandom.h"
+#include "TString.h"
+
+#include <algorithm>
+
+/** \class TF1SamplingTable
+    \ingroup Functions
+Tabulated inverse of the cumulative integral of a TF1, used to generate random numbers following
+the function shape.
+
+The table is built once from the function and its current parameter values and is never modified
+afterwards: the same table can be used by several threads at the same time, each thread passing
+its own random number generator. It is the table used by TF1::GetRandom, see TF1::GetSamplingTable:
+~~~ {.cpp}
+std::shared_ptr<const TF1SamplingTable> table = f1->GetSamplingTable();
+// in each thread
+TRandom3 rng(seed);
+std::vector<double> x(n);
+table->GetRandom(n, x.data(), &rng);
+~~~
+*/
+
+////////////////////////////////////////////////////////////////////////////////
+/// Compute the cumulative function of f at f.GetNpx() points in the range of f.
+/// Option can be used to force a log scale (option = "log"), linear (option = "lin") or automatic if empty.
+/// The table is invalid if the integral of the function is zero.
+
+TF1SamplingTable::TF1SamplingTable(TF1 &f, Option_t *option) : fNpx(f.GetNpx()), fXmin(f.GetXmin()), fXmax(f.GetXmax())
+{
+   fIntegral.resize(fNpx + 1);
+   fIntegral[0] = 0;
+   Double_t integ;
+   Int_t intNegative = 0;
+   Int_t i;
+   Double_t dx;
+   Double_t xmin = fXmin;
+   Double_t xmax = fXmax;
+   TString opt(option);
+   opt.ToUpper();
+   // perform a log binning if specified by user (option="Log") or if some conditions are met
+   // and the user explicitly does not specify a Linear binning option
+   if (opt.Contains("LOG") || ((xmin > 0 && xmax / xmin > fNpx) && !opt.Contains("LIN"))) {
+      fLogScale = kTRUE;
+      xmin = TMath::Log10(fXmin);
+      xmax = TMath::Log10(fXmax);
+      if (gDebug)
+         f.Info("GetRandom", "Use log scale for tabulating the integral in [%f,%f] with %d points", fXmin, fXmax, fNpx);
+   }
+   dx = (xmax - xmin) / fNpx;
+
+   std::vector<Double_t> xx(fNpx + 1);
+   for (i = 0; i < fNpx; i++) {
+      xx[i] = xmin + i * dx;
+   }
+   xx[fNpx] = xmax;
+   for (i = 0; i < fNpx; i++) {
+      if (fLogScale) {
+         integ = f.Integral(TMath::Power(10, xx[i]), TMath::Power(10, xx[i + 1]), 0.0);
+      } else {
+         integ = f.Integral(xx[i], xx[i + 1], 0.0);
+      }
+      if (integ < 0) {
+         intNegative++;
+         integ = -integ;
+      }
+      fIntegral[i + 1] = fIntegral[i] + integ;
+   }
+   if (intNegative > 0) {
+      f.Warning("GetRandom", "function:%s has %d negative values: abs assumed", f.GetName(), intNegative);
+   }
+   if (fIntegral[fNpx] == 0) {
+      f.Error("GetRandom", "Integral of function is zero");
+      return;
+   }
+   Double_t total = fIntegral[fNpx];
+   for (i = 1; i <= fNpx; i++) { // normalize integral to 1
+      fIntegral[i] /= total;
+   }
+   // the integral r for each bin is approximated by a parabola
+   //  x = alpha + beta*r +gamma*r**2
+   // compute the coefficients alpha, beta, gamma for each bin
+   fAlpha.resize(fNpx);
+   fBeta.resize(fNpx);
+   fGamma.resize(fNpx);
+   Double_t x0, r1, r2, r3;
+   for (i = 0; i < fNpx; i++) {
+      x0 = xx[i];
+      r2 = fIntegral[i + 1] - fIntegral[i];
+      if (fLogScale)
+         r1 = f.Integral(TMath::Power(10, x0), TMath::Power(10, x0 + 0.5 * dx), 0.0) / total;
+      else
+         r1 = f.Integral(x0, x0 + 0.5 * dx, 0.0) / total;
+      r3 = 2 * r2 - 4 * r1;
+      if (TMath::Abs(r3) > 1e-8)
+         fGamma[i] = r3 / (dx * dx);
+      else
+         fGamma[i] = 0;
+      fBeta[i] = r2 / dx - fGamma[i] * dx;
+      fAlpha[i] = x0;
+      fGamma[i] *= 2;
+   }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return the x value at which the normalized cumulative integral of the function is r, with r in [0,1].
+/// Within each bin the inverse of the cumulative integral is approximated by a parabola.
+
+Double_t TF1SamplingTable::GetX(Double_t r) const
+{
+   if (!IsValid())
+      return TMath::QuietNaN();
+   return GetXInBin(TMath::BinarySearch(fNpx, fIntegral.data(), r), r);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Compute the x values of n values r of the normalized cumulative integral. The arrays r and x may be the same.
+/// The bins of all the values are looked up first, such that the evaluation of the parabolas runs in a tight loop.
+
+void TF1SamplingTable::GetX(Int_t n, const Double_t *r, Double_t *x) const
+{
+   if (!IsValid()) {
+      std::fill(x, x + n, TMath::QuietNaN());
+      return;
+   }
+   std::vector<Int_t> bins(n);
+   for (Int_t i = 0; i < n; ++i)
+      bins[i] = TMath::BinarySearch(fNpx, fIntegral.data(), r[i]);
+   for (Int_t i = 0; i < n; ++i)
+      x[i] = GetXInBin(bins[i], r[i]);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return a random number following the tabulated function shape.
+/// By default (or when passing a nullptr) the global gRandom is used, which must not be shared by several threads.
+
+Double_t TF1SamplingTable::GetRandom(TRandom *rng) const
+{
+   return GetX((rng) ? rng->Rndm() : gRandom->Rndm());
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Fill the array x with n random numbers following the tabulated function shape.
+/// By default (or when passing a nullptr) the global gRandom is used, which must not be shared by several threads.
+
+void TF1SamplingTable::GetRandom(Int_t n, Double_t *x, TRandom *rng) const
+{
+   if (n <= 0)
+      return;
+   if (!rng)
+      rng = gRandom;
+   rng->RndmArray(n, x);
+   GetX(n, x, x);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return a random number following the tabulated function shape in [xmin,xmax].
+/// By default (or when passing a nullptr) the global gRandom is used, which must not be shared by several threads.
+
+Double_t TF1SamplingTable::GetRandom(Double_t xmin, Double_t xmax, TRandom *rng) const
+{
+   if (!IsValid())
+      return TMath::QuietNaN();
+   if (!rng)
+      rng = gRandom;
+
+   // the bins of the table containing xmin and xmax
+   Double_t tmin = fXmin;
+   Double_t tmax = fXmax;
+   Double_t a = xmin;
+   Double_t b = xmax;
+   if (fLogScale) {
+      tmin = TMath::Log10(fXmin);
+      tmax = TMath::Log10(fXmax);
+      a = (xmin > 0) ? TMath::Log10(xmin) : tmin;
+      b = (xmax > 0) ? TMath::Log10(xmax) : tmin;
+   }
+   Double_t dx   = (tmax - tmin) / fNpx;
+   Int_t nbinmin = (Int_t)((a - tmin) / dx);
+   Int_t nbinmax = (Int_t)((b - tmin) / dx) + 2;
+   if (nbinmin < 0) nbinmin = 0;
+   if (nbinmax > fNpx) nbinmax = fNpx;
+
+   Double_t pmin = fIntegral[nbinmin];
+   Double_t pmax = fIntegral[nbinmax];
+
+   Double_t x;
+   do {
+      x = GetX(rng->Uniform(pmin, pmax));
+   } while (x < xmin || x > xmax);
+   return x;
+}
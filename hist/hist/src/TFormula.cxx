@@ -759,6 +759,7 @@ void TFormula::Copy(TObject &obj) const
    fnew.fHessGenerationInput = fHessGenerationInput;
    fnew.fGradFuncPtr = fGradFuncPtr;
    fnew.fHessFuncPtr = fHessFuncPtr;
+   fnew.fBatchFuncPtr = fBatchFuncPtr.load();
 
 }
 
@@ -775,6 +776,7 @@ void TFormula::Clear(Option_t * )
    fClingName = "";
 
    fMethod.reset();
+   fBatchFuncPtr = nullptr;
 
    fClingVariables.clear();
    fClingParameters.clear();
@@ -2331,6 +2333,7 @@ void TFormula::ProcessFormula(TString &formula)
          // set the cling name using hash of the static formulae map
          auto hasher = gClingFunctions.hash_function();
          fClingName = TString::Format("%s__id%zu", gNamePrefix.Data(), hasher(inputFormulaVecFlag));
+         fBatchFuncPtr = nullptr;
 
          fClingInput = TString::Format("%s %s(%s){ return %s ; }", argType.Data(), fClingName.Data(),
                                        argumentsPrototype.Data(), inputFormula.c_str());
@@ -3403,6 +3406,90 @@ ROOT::Double_v TFormula::EvalParVec(const ROOT::Double_v *x, const Double_t *par
 }
 #endif
 
+////////////////////////////////////////////////////////////////////////////////
+/// Return the pointer to the function compiled by Cling that evaluates the
+/// formula on an array of points, declaring it the first time.
+/// Returns nullptr on failure.
+
+TFormula::CallFuncSignature TFormula::GetBatchFuncPtr() const
+{
+   CallFuncSignature batchFuncPtr = fBatchFuncPtr;
+   if (batchFuncPtr)
+      return batchFuncPtr;
+
+   R__LOCKGUARD(gROOTMutex);
+   // check again in case another thread has declared it meanwhile
+   batchFuncPtr = fBatchFuncPtr;
+   if (batchFuncPtr)
+      return batchFuncPtr;
+
+   // Formulas with identical expressions share the function, as for the gradient
+   const std::string batchFuncName = std::string(fClingName.Data()) + "_batch";
+   if (!functionExists(batchFuncName)) {
+      // see the prototype of the formula function in PrepareFormula
+      std::string call = fClingName.Data();
+      if (fNdim > 0 && fNpar > 0)
+         call += "(x + i * ndim, p)";
+      else if (fNdim > 0)
+         call += "(x + i * ndim)";
+      else if (fNpar > 0)
+         call += "(x, p)";
+      else
+         call += "()";
+      const std::string batchInput = "#pragma cling optimize(2)\n"
+         "void " + batchFuncName + "(Int_t n, Int_t ndim, Double_t *x, Double_t *p, Double_t *out) {\n"
+         "   for (Int_t i = 0; i < n; ++i)\n"
+         "      out[i] = " + call + ";\n"
+         "}";
+      if (!gInterpreter->Declare(batchInput.c_str()))
+         return nullptr;
+   }
+
+   TMethodCall method;
+   method.InitWithPrototype(batchFuncName.c_str(), "Int_t,Int_t,Double_t*,Double_t*,Double_t*");
+   if (!method.IsValid()) {
+      Error("EvalBatch", "Can't compile function %s", batchFuncName.c_str());
+      return nullptr;
+   }
+   batchFuncPtr = prepareFuncPtr(&method);
+   fBatchFuncPtr = batchFuncPtr;
+   return batchFuncPtr;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Evaluate the formula on nPoints points, storing the values in out.
+/// The coordinates of point i are x[i * GetNdim()] to x[(i + 1) * GetNdim() - 1];
+/// params are the parameters, or the ones of the formula if nullptr.
+/// The loop over the points is compiled by Cling together with the formula,
+/// which avoids the overhead of one call of EvalPar per point.
+
+void TFormula::EvalBatch(Int_t nPoints, const Double_t *x, const Double_t *params, Double_t *out) const
+{
+   if (nPoints <= 0)
+      return;
+
+   // the first point also takes care of the lazy initialization and of the errors
+   out[0] = EvalPar(x, params);
+
+   CallFuncSignature batchFuncPtr = nullptr;
+   if (nPoints > 1 && !fVectorized && !TestBit(TFormula::kLambda) && fClingInitialized && (x || fNdim == 0))
+      batchFuncPtr = GetBatchFuncPtr();
+
+   if (!batchFuncPtr) {
+      for (Int_t i = 1; i < nPoints; ++i)
+         out[i] = EvalPar(x ? x + i * fNdim : nullptr, params);
+      return;
+   }
+
+   Int_t n = nPoints - 1;
+   Int_t ndim = fNdim;
+   double *vars = (x) ? const_cast<double *>(x) + fNdim : const_cast<double *>(fClingVariables.data());
+   double *pars = (params) ? const_cast<double *>(params) : const_cast<double *>(fClingParameters.data());
+   double *res = out + 1;
+   void *args[5] = {&n, &ndim, &vars, &pars, &res};
+   (*batchFuncPtr)(0, 5, args, /*ret*/ nullptr); // We do not use ret in a return-void func.
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Sets first 4  variables (e.g. x, y, z, t) and evaluate formula.
 
@@ -30,7 +30,11 @@
 #include "TPluginManager.h"
 #include "strtok.h"
 
+#include <algorithm>
+#include <cmath>
 #include <cstdlib>
+#include <mutex>
+#include <numeric>
 #include <string>
 #include <cassert>
 #include <iostream>
@@ -537,6 +541,7 @@ TGraph::~TGraph()
       fFunctions = nullptr; //to avoid accessing a deleted object in RecursiveRemove
    }
    delete fHistogram;
+   delete fEvalSpline;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -877,12 +882,17 @@ void TGraph::DrawPanel()
 ///    extrapolation is computed.
 ///  - if spline==0 and option="S" a TSpline3 object is created using this graph
 ///    and the interpolated value from the spline is returned.
-///    the internally created spline is deleted on return.
+///    The spline is kept by the graph and reused by the next calls, as long as
+///    the points of the graph do not change.
 ///  - if spline is specified, it is used to return the interpolated value.
 ///
 ///   If the points are sorted in X a binary search is used (significantly faster)
 ///   One needs to set the bit  TGraph::SetBit(TGraph::kIsSortedX) before calling
 ///   TGraph::Eval to indicate that the graph is sorted in X.
+///
+///   To evaluate the graph at many points, use the overload taking arrays,
+///   which does the search of the neighbours without looping on all the points
+///   for each of them.
 
 Double_t TGraph::Eval(Double_t x, TSpline *spline, Option_t *option) const
 {
@@ -898,24 +908,9 @@ Double_t TGraph::Eval(Double_t x, TSpline *spline, Option_t *option) const
    if (option && *option) {
       TString opt = option;
       opt.ToLower();
-      // create a TSpline every time when using option "s" and no spline pointer is given
-      if (opt.Contains("s")) {
-
-         // points must be sorted before using a TSpline
-         std::vector<Double_t> xsort(fNpoints);
-         std::vector<Double_t> ysort(fNpoints);
-         std::vector<Int_t> indxsort(fNpoints);
-         TMath::Sort(fNpoints, fX, &indxsort[0], false);
-         for (Int_t i = 0; i < fNpoints; ++i) {
-            xsort[i] = fX[ indxsort[i] ];
-            ysort[i] = fY[ indxsort[i] ];
-         }
-
-         // spline interpolation creating a new spline
-         TSpline3 s("", &xsort[0], &ysort[0], fNpoints);
-         Double_t result = s.Eval(x);
-         return result;
-      }
+      // spline interpolation with the spline of the graph when using option "s" and no spline pointer is given
+      if (opt.Contains("s"))
+         return GetEvalSpline()->Eval(x);
    }
    //linear interpolation
    //In case x is < fX[0] or > fX[fNpoints-1] return the extrapolated point
@@ -976,6 +971,99 @@ Double_t TGraph::Eval(Double_t x, TSpline *spline, Option_t *option) const
    return yn;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Interpolate points in this graph at the n abscissas x, the results are
+/// written in y. The options are the ones of Eval(Double_t, TSpline*, Option_t*),
+/// which gives the same results.
+///
+/// When the points are not sorted in X, they are sorted once for all the
+/// abscissas, instead of looping on all the points for each of them.
+
+void TGraph::Eval(Int_t n, const Double_t *x, Double_t *y, TSpline *spline, Option_t *option) const
+{
+   if (spline) {
+      for (Int_t i = 0; i < n; ++i)
+         y[i] = spline->Eval(x[i]);
+      return;
+   }
+
+   TString opt = option;
+   opt.ToLower();
+   if (fNpoints > 1 && opt.Contains("s")) {
+      TSpline3 *s = GetEvalSpline();
+      for (Int_t i = 0; i < n; ++i)
+         y[i] = s->Eval(x[i]);
+      return;
+   }
+
+   Bool_t hasNaN = kFALSE;
+   for (Int_t i = 0; i < fNpoints && !hasNaN; ++i)
+      hasNaN = std::isnan(fX[i]);
+   if (fNpoints <= 2 || TestBit(kIsSortedX) || hasNaN) {
+      for (Int_t i = 0; i < n; ++i)
+         y[i] = Eval(x[i], nullptr, option);
+      return;
+   }
+
+   // sort the points keeping the order of the points with the same abscissa,
+   // the neighbours are then the same as the ones found by Eval
+   std::vector<Int_t> index(fNpoints);
+   std::iota(index.begin(), index.end(), 0);
+   std::stable_sort(index.begin(), index.end(), [this](Int_t i1, Int_t i2) { return fX[i1] < fX[i2]; });
+   std::vector<Double_t> xsort(fNpoints);
+   for (Int_t i = 0; i < fNpoints; ++i)
+      xsort[i] = fX[index[i]];
+
+   for (Int_t i = 0; i < n; ++i) {
+      // extrapolation (and NaN) outside of the range of the points
+      if (!(x[i] > xsort.front() && x[i] < xsort.back())) {
+         y[i] = Eval(x[i], nullptr, option);
+         continue;
+      }
+      auto iup = std::lower_bound(xsort.begin(), xsort.end(), x[i]);
+      if (*iup == x[i]) {
+         y[i] = fY[index[iup - xsort.begin()]];
+         continue;
+      }
+      auto ilow = std::lower_bound(xsort.begin(), iup, *(iup - 1));
+      Int_t low = index[ilow - xsort.begin()];
+      Int_t up = index[iup - xsort.begin()];
+      y[i] = fY[up] + (x[i] - fX[up]) * (fY[low] - fY[up]) / (fX[low] - fX[up]);
+   }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return the spline of the points used by Eval with option "S". It is built
+/// at the first call and again only when the points of the graph changed.
+
+TSpline3 *TGraph::GetEvalSpline() const
+{
+   // several threads can evaluate the same graph
+   static std::mutex evalSplineMutex;
+   std::lock_guard<std::mutex> lock(evalSplineMutex);
+
+   const std::size_t size = fNpoints * sizeof(Double_t);
+   if (fEvalSpline && fEvalSplinePoints.size() == 2 * std::size_t(fNpoints) &&
+       !memcmp(fEvalSplinePoints.data(), fX, size) && !memcmp(fEvalSplinePoints.data() + fNpoints, fY, size))
+      return fEvalSpline;
+
+   // points must be sorted before using a TSpline
+   std::vector<Double_t> xsort(fNpoints);
+   std::vector<Double_t> ysort(fNpoints);
+   std::vector<Int_t> indxsort(fNpoints);
+   TMath::Sort(fNpoints, fX, &indxsort[0], false);
+   for (Int_t i = 0; i < fNpoints; ++i) {
+      xsort[i] = fX[ indxsort[i] ];
+      ysort[i] = fY[ indxsort[i] ];
+   }
+
+   delete fEvalSpline;
+   fEvalSpline = new TSpline3("", &xsort[0], &ysort[0], fNpoints);
+   fEvalSplinePoints.assign(fX, fX + fNpoints);
+   fEvalSplinePoints.insert(fEvalSplinePoints.end(), fY, fY + fNpoints);
+   return fEvalSpline;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Execute action corresponding to one event.
 ///
@@ -1104,6 +1192,7 @@ TFitResultPtr TGraph::Fit(const char *fname, Option_t *option, Option_t *, Axis_
 /// "E" | Perform better Errors estimation using Minos technique
 /// "B" | User defined parameter settings are used for predefined functions like "gaus", "expo", "poln", "landau". Use this option when you want to fix one or more parameters for these functions.
 /// "M" | More. Improve fit results. It uses the IMPROVE command of TMinuit (see TMinuit::mnimpr). This algorithm attempts to improve the found local minimum by searching for a better one.
+/// "G" | Use the gradient of the function with respect to the parameters in the minimization. For a function defined by a formula, the gradient is computed with automatic differentiation (see TFormula::GenerateGradientPar), otherwise numerically.
 /// "R" | Use the Range specified in the function range
 /// "N" | Do not store the graphics function, do not draw
 /// "0" | Do not plot the result of the fit. By default the fitted function is drawn unless the option "N" above is specified.
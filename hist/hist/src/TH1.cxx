@@ -3481,6 +3481,12 @@ void TH1::FillN(Int_t ntimes, const Double_t *x, const Double_t *w, Int_t stride
 
 void TH1::DoFillN(Int_t ntimes, const Double_t *x, const Double_t *w, Int_t stride)
 {
+   // the bins of an axis with bins of fixed width, which cannot be extended, are computed in bulk
+   if (!fXaxis.GetXbins()->fN && !fXaxis.CanExtend()) {
+      DoFillNFixBins(ntimes, x, w, stride);
+      return;
+   }
+
    Int_t bin,i;
 
    fEntries += ntimes;
@@ -3505,6 +3511,86 @@ void TH1::DoFillN(Int_t ntimes, const Double_t *x, const Double_t *w, Int_t stri
    }
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Internal method to fill from a vector a histogram whose x axis has bins of
+/// fixed width and cannot be extended, called by TH1::DoFillN.
+///
+/// The entries are processed in chunks: first the bins of all the entries of
+/// the chunk are computed, with the same arithmetic as TAxis::FindBin but
+/// with no branches, then the contents are incremented entry by entry (so that
+/// entries falling in the same bin are all counted), and finally the
+/// statistics are accumulated in independent partial sums. These loops can be
+/// vectorized by the compiler. The statistics can differ from the ones of
+/// DoFillN by rounding only.
+
+void TH1::DoFillNFixBins(Int_t ntimes, const Double_t *x, const Double_t *w, Int_t stride)
+{
+   fEntries += ntimes;
+
+   // as in DoFillN, the storage of the sum of squares of weights is triggered by a weight different from 1
+   if (w && !fSumw2.fN && !TestBit(TH1::kIsNotW)) {
+      for (Int_t i = 0; i < ntimes; ++i) {
+         if (w[i * stride] != 1.) {
+            Sumw2();
+            break;
+         }
+      }
+   }
+
+   const Int_t nbins = fXaxis.GetNbins();
+   const Double_t xmin = fXaxis.GetXmin();
+   const Double_t xmax = fXaxis.GetXmax();
+   const Bool_t statOverflows = GetStatOverflowsBehaviour();
+   Double_t *sumw2 = fSumw2.fN ? fSumw2.fArray : nullptr;
+
+   constexpr Int_t kChunkSize = 64;
+   constexpr Int_t kNSums = 4;
+   Double_t xs[kChunkSize];
+   Double_t ws[kChunkSize];
+   Int_t bins[kChunkSize];
+   Double_t sumw[kNSums] = {0.}, sumw2Stat[kNSums] = {0.}, sumwx[kNSums] = {0.}, sumwx2[kNSums] = {0.};
+
+   for (Int_t first = 0; first < ntimes; first += kChunkSize) {
+      const Int_t n = TMath::Min(kChunkSize, ntimes - first);
+      for (Int_t j = 0; j < n; ++j) {
+         xs[j] = x[(first + j) * stride];
+         ws[j] = w ? w[(first + j) * stride] : 1.;
+      }
+
+      // same as TAxis::FindBin: NaNs go to the overflow bin
+      for (Int_t j = 0; j < n; ++j) {
+         const Bool_t inRange = xs[j] >= xmin && xs[j] < xmax;
+         const Double_t xIn = inRange ? xs[j] : xmin;
+         const Int_t binIn = 1 + int(nbins * (xIn - xmin) / (xmax - xmin));
+         bins[j] = inRange ? binIn : (xs[j] < xmin ? 0 : nbins + 1);
+      }
+
+      for (Int_t j = 0; j < n; ++j)
+         AddBinContent(bins[j], ws[j]);
+      if (sumw2)
+         for (Int_t j = 0; j < n; ++j)
+            sumw2[bins[j]] += ws[j] * ws[j];
+
+      // the masked out entries must not contribute, even with infinite or NaN values
+      for (Int_t j = 0; j < n; ++j) {
+         const Bool_t inStat = statOverflows || (bins[j] > 0 && bins[j] <= nbins);
+         const Double_t z = inStat ? ws[j] : 0.;
+         const Double_t zx = inStat ? ws[j] * xs[j] : 0.;
+         sumw[j % kNSums] += z;
+         sumw2Stat[j % kNSums] += z * z;
+         sumwx[j % kNSums] += zx;
+         sumwx2[j % kNSums] += inStat ? zx * xs[j] : 0.;
+      }
+   }
+
+   for (Int_t k = 0; k < kNSums; ++k) {
+      fTsumw += sumw[k];
+      fTsumw2 += sumw2Stat[k];
+      fTsumwx += sumwx[k];
+      fTsumwx2 += sumwx2[k];
+   }
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Fill histogram following distribution in function fname.
 ///
@@ -3944,6 +4030,9 @@ TFitResultPtr TH1::Fit(const char *fname ,Option_t *option ,Option_t *goption, D
 ///          It uses the IMPROVE command of TMinuit (see TMinuit::mnimpr).
 ///          This algorithm attempts to improve the found local minimum by searching for a
 ///          better one.
+///        - "G"  Use the gradient of the function with respect to the parameters in the minimization.
+///          For a function defined by a formula, the gradient is computed with automatic
+///          differentiation (see TFormula::GenerateGradientPar), otherwise numerically.
 ///        - "R"  Use the Range specified in the function range
 ///        - "N"  Do not store the graphics function, do not draw
 ///        - "0"  Do not plot the result of the fit. By default the fitted function
@@ -3952,6 +4041,9 @@ TFitResultPtr TH1::Fit(const char *fname ,Option_t *option ,Option_t *goption, D
 ///          (by default, any previous function is deleted)
 ///        - "C"  In case of linear fitting, don't calculate the chisquare
 ///          (saves time)
+///        - "SERIAL"  Evaluate the fit function sequentially. By default, the evaluation is
+///          multi-threaded when the implicit multi-threading is enabled and the data have enough points
+///        - "MULTITHREAD"  Evaluate the fit function with multiple threads (requires the implicit multi-threading)
 ///        - "F"  If fitting a polN, switch to minuit fitter
 ///        - "S"  The result of the fit is returned in the TFitResultPtr
 ///          (see below Access to the Fit Result)
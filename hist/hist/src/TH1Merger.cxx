@@ -8,10 +8,18 @@
 #include "TError.h"
 #include "THashList.h"
 #include "TClass.h"
+#include "RConfigure.h"
+#include <algorithm>
 #include <iostream>
 #include <limits>
 #include <utility>
 
+#ifdef R__USE_IMT
+#include "ROOT/TSeq.hxx"
+#include "ROOT/TThreadExecutor.hxx"
+#include "TROOT.h"
+#endif
+
 #define PRINTRANGE(a, b, bn)                                                                                          \
    Printf(" base: %f %f %d, %s: %f %f %d", a->GetXmin(), a->GetXmax(), a->GetNbins(), bn, b->GetXmin(), b->GetXmax(), \
           b->GetNbins());
@@ -794,6 +802,7 @@ Bool_t TH1Merger::SameAxesMerge() {
    fH0->GetStats(totstats);
    Double_t nentries = fH0->GetEntries();
 
+   std::vector<const TH1 *> hists;
    TIter next(&fInputList);
    while (TH1* hist=(TH1*)next()) {
       // process only if the histogram has limits; otherwise it was processed before
@@ -811,12 +820,29 @@ Bool_t TH1Merger::SameAxesMerge() {
          totstats[i] += stats[i];
       nentries += hist->GetEntries();
 
-         //Int_t nx = hist->GetXaxis()->GetNbins();
-         // loop on bins of the histogram and do the merge
-      for (Int_t ibin = 0; ibin < hist->fNcells; ibin++) {
-         MergeBin(hist, ibin, ibin);
-      }
+      hists.push_back(hist);
    }
+
+   // the histograms have the same axes: the ranges of bins are merged
+   // independently, concurrently if the histograms are large enough
+   const Int_t ncells = fH0->fNcells;
+#ifdef R__USE_IMT
+   // number of bins to merge above which the merge is parallelized
+   constexpr Long64_t kMinParallelMergeBins = 1 << 20;
+   // minimum number of bins of one task
+   constexpr Int_t kMinTaskBins = 1 << 14;
+   if (ROOT::IsImplicitMTEnabled() && ncells > kMinTaskBins &&
+       (Long64_t)ncells * hists.size() >= kMinParallelMergeBins) {
+      ROOT::TThreadExecutor pool;
+      const Int_t ntasks = std::min<Int_t>(4 * pool.GetPoolSize(), ncells / kMinTaskBins);
+      const Int_t taskBins = (ncells + ntasks - 1) / ntasks;
+      pool.Foreach([&](Int_t i) {
+         SameAxesMergeBins(hists, i * taskBins, std::min(ncells, (i + 1) * taskBins));
+      }, ROOT::TSeqI(ntasks));
+   } else
+#endif
+      SameAxesMergeBins(hists, 0, ncells);
+
    //copy merged stats
    fH0->PutStats(totstats);
    fH0->SetEntries(nentries);
@@ -824,6 +850,48 @@ Bool_t TH1Merger::SameAxesMerge() {
    return kTRUE;
 }
 
+/// Merge the bins [first, last) of the histograms into the same bins of fH0.
+void TH1Merger::SameAxesMergeBins(const std::vector<const TH1 *> &hists, Int_t first, Int_t last)
+{
+   for (const TH1 *hist : hists) {
+      if (AddBinArrays<TArrayD>(hist, first, last) || AddBinArrays<TArrayF>(hist, first, last))
+         continue;
+      // loop on bins of the histogram and do the merge
+      for (Int_t ibin = first; ibin < last; ibin++) {
+         MergeBin(hist, ibin, ibin);
+      }
+   }
+}
+
+/// Add the bins [first, last) of hist to fH0 directly on their arrays if both
+/// store their contents in an ARRAY, as MergeBin() would; otherwise return kFALSE.
+template <class ARRAY>
+Bool_t TH1Merger::AddBinArrays(const TH1 *hist, Int_t first, Int_t last)
+{
+   if (fIsProfileMerge) return kFALSE;
+   ARRAY *out = dynamic_cast<ARRAY *>(fH0);
+   const ARRAY *in = dynamic_cast<const ARRAY *>(hist);
+   if (!out || !in) return kFALSE;
+
+   auto outContent = out->fArray;
+   const auto inContent = in->fArray;
+   for (Int_t ibin = first; ibin < last; ibin++)
+      outContent[ibin] += inContent[ibin];
+
+   if (fH0->fSumw2.fN) {
+      Double_t *outSumw2 = fH0->fSumw2.fArray;
+      if (hist->fSumw2.fN) {
+         const Double_t *inSumw2 = hist->fSumw2.fArray;
+         for (Int_t ibin = first; ibin < last; ibin++)
+            outSumw2[ibin] += inSumw2[ibin];
+      } else {
+         for (Int_t ibin = first; ibin < last; ibin++)
+            outSumw2[ibin] += inContent[ibin];
+      }
+   }
+   return kTRUE;
+}
+
 
 /**
    Merged histogram when axis can be different.
@@ -17,6 +17,8 @@
 #include "TProfile3D.h"
 #include "TList.h"
 
+#include <vector>
+
 class TH1Merger {
 
 public:
@@ -115,6 +117,11 @@ private:
 
    Bool_t SameAxesMerge();
 
+   void SameAxesMergeBins(const std::vector<const TH1 *> &hists, Int_t first, Int_t last);
+
+   template <class ARRAY>
+   Bool_t AddBinArrays(const TH1 *hist, Int_t first, Int_t last);
+
    Bool_t DifferentAxesMerge();
 
    Bool_t LabelMerge();
@@ -16,7 +16,147 @@
 #include "Riostream.h"
 #include "TList.h"
 #include "TMath.h"
+#include <algorithm>
 #include <cassert>
+#include <mutex>
+#include <vector>
+
+namespace ROOT {
+namespace Internal {
+
+////////////////////////////////////////////////////////////////////////////////
+/// Bounding volume hierarchy of the bounding boxes of the bins of a TH2Poly.
+/// The nodes are stored depth first: the first child of an inner node is the
+/// next node. The leaves hold a few bins, whose bounding boxes are stored
+/// contiguously to reject most of the bins before the point-in-polygon test.
+
+class TH2PolyBinIndex {
+   struct Node {
+      Double_t fXmin, fXmax, fYmin, fYmax;
+      Int_t fMinNumber; ///< Smallest bin number of the subtree
+      Int_t fFirst;     ///< Leaf: first bin in fBins. Inner node: index of the second child
+      Int_t fCount;     ///< Leaf: number of bins. Inner node: 0
+   };
+   static const Int_t kLeafSize = 4;
+
+   const TList *fList; ///< List of bins the index was built from
+   Int_t fNBins;       ///< Size of that list when the index was built
+   std::vector<Node> fNodes;
+   std::vector<TH2PolyBin *> fBins;
+   std::vector<Double_t> fXmin, fXmax, fYmin, fYmax;
+
+   struct Item {
+      TH2PolyBin *fBin;
+      Double_t fXmin, fXmax, fYmin, fYmax;
+      Double_t CenterX() const { return 0.5 * (fXmin + fXmax); }
+      Double_t CenterY() const { return 0.5 * (fYmin + fYmax); }
+   };
+
+   void Build(std::vector<Item> &items, Int_t begin, Int_t end)
+   {
+      const Int_t inode = fNodes.size();
+      fNodes.push_back(Node());
+      Node node{items[begin].fXmin, items[begin].fXmax, items[begin].fYmin, items[begin].fYmax,
+                items[begin].fBin->GetBinNumber(), 0, 0};
+      Double_t cxmin = items[begin].CenterX(), cxmax = cxmin;
+      Double_t cymin = items[begin].CenterY(), cymax = cymin;
+      for (Int_t i = begin + 1; i < end; ++i) {
+         const Item &item = items[i];
+         node.fXmin = std::min(node.fXmin, item.fXmin);
+         node.fXmax = std::max(node.fXmax, item.fXmax);
+         node.fYmin = std::min(node.fYmin, item.fYmin);
+         node.fYmax = std::max(node.fYmax, item.fYmax);
+         node.fMinNumber = std::min(node.fMinNumber, item.fBin->GetBinNumber());
+         cxmin = std::min(cxmin, item.CenterX());
+         cxmax = std::max(cxmax, item.CenterX());
+         cymin = std::min(cymin, item.CenterY());
+         cymax = std::max(cymax, item.CenterY());
+      }
+
+      if (end - begin <= kLeafSize) {
+         node.fFirst = fBins.size();
+         node.fCount = end - begin;
+         for (Int_t i = begin; i < end; ++i) {
+            fBins.push_back(items[i].fBin);
+            fXmin.push_back(items[i].fXmin);
+            fXmax.push_back(items[i].fXmax);
+            fYmin.push_back(items[i].fYmin);
+            fYmax.push_back(items[i].fYmax);
+         }
+         fNodes[inode] = node;
+         return;
+      }
+
+      // Split at the median of the centers along the longest extent
+      const Int_t middle = begin + (end - begin) / 2;
+      if (cxmax - cxmin >= cymax - cymin)
+         std::nth_element(items.begin() + begin, items.begin() + middle, items.begin() + end,
+                          [](const Item &a, const Item &b) { return a.CenterX() < b.CenterX(); });
+      else
+         std::nth_element(items.begin() + begin, items.begin() + middle, items.begin() + end,
+                          [](const Item &a, const Item &b) { return a.CenterY() < b.CenterY(); });
+      Build(items, begin, middle);
+      node.fFirst = fNodes.size();
+      Build(items, middle, end);
+      fNodes[inode] = node;
+   }
+
+public:
+   TH2PolyBinIndex(TList *bins) : fList(bins), fNBins(bins->GetSize())
+   {
+      std::vector<Item> items;
+      items.reserve(fNBins);
+      TIter next(bins);
+      while (auto bin = (TH2PolyBin *)next())
+         items.push_back({bin, bin->GetXMin(), bin->GetXMax(), bin->GetYMin(), bin->GetYMax()});
+      fBins.reserve(fNBins);
+      fXmin.reserve(fNBins);
+      fXmax.reserve(fNBins);
+      fYmin.reserve(fNBins);
+      fYmax.reserve(fNBins);
+      if (!items.empty())
+         Build(items, 0, items.size());
+   }
+
+   Bool_t IsValidFor(const TList *bins) const { return bins == fList && bins->GetSize() == fNBins; }
+
+   /// Returns the bin of smallest number containing (x,y), as the search in
+   /// the partition cells would, or nullptr.
+   TH2PolyBin *Find(Double_t x, Double_t y) const
+   {
+      if (fNodes.empty())
+         return nullptr;
+      TH2PolyBin *found = nullptr;
+      Int_t number = kMaxInt;
+      // The depth of the tree is at most log2 of the number of bins
+      Int_t stack[64];
+      Int_t depth = 0;
+      stack[depth++] = 0;
+      while (depth) {
+         const Int_t inode = stack[--depth];
+         const Node &node = fNodes[inode];
+         if (node.fMinNumber >= number || x < node.fXmin || x > node.fXmax || y < node.fYmin || y > node.fYmax)
+            continue;
+         if (node.fCount) {
+            for (Int_t i = node.fFirst; i < node.fFirst + node.fCount; ++i) {
+               if (x < fXmin[i] || x > fXmax[i] || y < fYmin[i] || y > fYmax[i])
+                  continue;
+               if (fBins[i]->GetBinNumber() < number && fBins[i]->IsInside(x, y)) {
+                  found = fBins[i];
+                  number = found->GetBinNumber();
+               }
+            }
+         } else {
+            stack[depth++] = node.fFirst;
+            stack[depth++] = inode + 1;
+         }
+      }
+      return found;
+   }
+};
+
+} // namespace Internal
+} // namespace ROOT
 
 ClassImp(TH2Poly);
 
@@ -139,6 +279,22 @@ filling, it also adds a constant time delay into the code. When `Fill()`
 is to be called many times, it is more efficient to divide the histogram into
 a large number cells. However, if the histogram is to be filled only a few
 times, it is better to divide into a small number of cells.
+
+## Bin index
+`FindBin()` and `Fill()` do not search the partition cells: the cells have
+all the same size, while the bins of detector maps are often very different
+in size, so that some cells intersect many bins. Instead, the first search
+after bins were added builds a bounding volume hierarchy of the bounding
+boxes of the bins. A search visits only the nodes whose bounding box
+contains the point, and `IsInside()` is called only for the bins whose
+bounding box contains the point. The time of a search grows as the
+logarithm of the number of bins. The partition is still kept up to date, it
+is stored with the histogram.
+
+`FindBin()` and `FindBins()` can be called concurrently from several threads.
+To fill a histogram from several threads, each thread fills its own copy,
+e.g. with a `ROOT::TThreadedObject<TH2Poly>`, and the copies are merged at the
+end.
 */
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -186,6 +342,7 @@ TH2Poly::~TH2Poly()
    delete[] fCells;
    delete[] fIsEmpty;
    delete[] fCompletelyInside;
+   delete fBinIndex.load();
    // delete at the end the bin List since it owns the objects
    delete fBins;
 }
@@ -555,36 +712,77 @@ Int_t TH2Poly::FindBin(Double_t x, Double_t y, Double_t)
    else if (x > fXaxis.GetXmin()) overflow += -1;
    if (overflow != -5) return overflow;
 
-   // Finds the cell (x,y) coordinates belong to
-   Int_t n = (Int_t)(floor((x-fXaxis.GetXmin())/fStepX));
-   Int_t m = (Int_t)(floor((y-fYaxis.GetXmin())/fStepY));
+   // If the search does not return a bin, the point must be on "the sea"
+   TH2PolyBin *bin = FindPolyBin(x, y);
+   return bin ? bin->GetBinNumber() : -5;
+}
 
-   // Make sure the array indices are correct.
-   if (n>=fCellX) n = fCellX-1;
-   if (m>=fCellY) m = fCellY-1;
-   if (n<0)       n = 0;
-   if (m<0)       m = 0;
+////////////////////////////////////////////////////////////////////////////////
+/// Finds the bins of n points, as FindBin() does for each of them.
+/// This method can be called concurrently from several threads.
+///
+/// \param [in] n:     number of points
+/// \param [in] x:     array of the x coordinates of the points
+/// \param [in] y:     array of the y coordinates of the points
+/// \param [out] bins: array of the n bin numbers
 
-   if (fIsEmpty[n+fCellX*m]) return -5;
+void TH2Poly::FindBins(Int_t n, const Double_t *x, const Double_t *y, Int_t *bins) const
+{
+   const ROOT::Internal::TH2PolyBinIndex *index = GetBinIndex();
+   const Double_t xmin = fXaxis.GetXmin(), xmax = fXaxis.GetXmax();
+   const Double_t ymin = fYaxis.GetXmin(), ymax = fYaxis.GetXmax();
+   for (Int_t i = 0; i < n; ++i) {
+      Int_t overflow = 0;
+      if      (y[i] > ymax) overflow += -1;
+      else if (y[i] > ymin) overflow += -4;
+      else                  overflow += -7;
+      if      (x[i] > xmax) overflow += -2;
+      else if (x[i] > xmin) overflow += -1;
+      if (overflow != -5 || !index) {
+         bins[i] = overflow;
+         continue;
+      }
+      TH2PolyBin *bin = index->Find(x[i], y[i]);
+      bins[i] = bin ? bin->GetBinNumber() : -5;
+   }
+}
 
-   TH2PolyBin *bin;
+////////////////////////////////////////////////////////////////////////////////
+/// Returns the index of the bins, built again if bins were added since it
+/// was built, or nullptr if there are no bins.
 
-   TIter next(&fCells[n+fCellX*m]);
-   TObject *obj;
+const ROOT::Internal::TH2PolyBinIndex *TH2Poly::GetBinIndex() const
+{
+   if (!fBins)
+      return nullptr;
+   ROOT::Internal::TH2PolyBinIndex *index = fBinIndex.load(std::memory_order_acquire);
+   if (index && index->IsValidFor(fBins))
+      return index;
+
+   static std::mutex mutex;
+   std::lock_guard<std::mutex> lock(mutex);
+   index = fBinIndex.load(std::memory_order_acquire);
+   if (index && index->IsValidFor(fBins))
+      return index;
+   delete index;
+   index = new ROOT::Internal::TH2PolyBinIndex(fBins);
+   fBinIndex.store(index, std::memory_order_release);
+   return index;
+}
 
-   // Search for the bin in the cell
-   while ((obj=next())) {
-      bin  = (TH2PolyBin*)obj;
-      if (bin->IsInside(x,y)) return bin->GetBinNumber();
-   }
+////////////////////////////////////////////////////////////////////////////////
+/// Returns the bin containing (x,y), or nullptr if (x,y) is not in a bin.
+/// The point is not checked to be inside the histogram limits.
 
-   // If the search has not returned a bin, the point must be on "the sea"
-   return -5;
+TH2PolyBin *TH2Poly::FindPolyBin(Double_t x, Double_t y) const
+{
+   const ROOT::Internal::TH2PolyBinIndex *index = GetBinIndex();
+   return index ? index->Find(x, y) : nullptr;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 /// Increment the bin containing (x,y) by 1.
-/// Uses the partitioning algorithm.
+/// Uses the bin index, see the "Bin index" section.
 
 Int_t TH2Poly::Fill(Double_t x, Double_t y)
 {
@@ -593,7 +791,7 @@ Int_t TH2Poly::Fill(Double_t x, Double_t y)
 
 ////////////////////////////////////////////////////////////////////////////////
 /// Increment the bin containing (x,y) by w.
-/// Uses the partitioning algorithm.
+/// Uses the bin index, see the "Bin index" section.
 
 Int_t TH2Poly::Fill(Double_t x, Double_t y, Double_t w)
 {
@@ -621,57 +819,33 @@ Int_t TH2Poly::Fill(Double_t x, Double_t y, Double_t w)
       return overflow;
    }
 
-   // Finds the cell (x,y) coordinates belong to
-   Int_t n = (Int_t)(floor((x-fXaxis.GetXmin())/fStepX));
-   Int_t m = (Int_t)(floor((y-fYaxis.GetXmin())/fStepY));
-
-   // Make sure the array indices are correct.
-   if (n>=fCellX) n = fCellX-1;
-   if (m>=fCellY) m = fCellY-1;
-   if (n<0)       n = 0;
-   if (m<0)       m = 0;
-
-   if (fIsEmpty[n+fCellX*m]) {
+   TH2PolyBin *bin = FindPolyBin(x, y);
+   if (!bin) {
       fOverflow[4]+= w;
       if (fSumw2.fN) fSumw2.fArray[4] += w*w;
       return -5;
    }
 
-   TH2PolyBin *bin;
-   Int_t bi;
+   bin->Fill(w);
 
-   TIter next(&fCells[n+fCellX*m]);
-   TObject *obj;
-
-   while ((obj=next())) {
-      bin  = (TH2PolyBin*)obj;
+   // Statistics
+   fTsumw   = fTsumw + w;
+   fTsumw2  = fTsumw2 + w*w;
+   fTsumwx  = fTsumwx + w*x;
+   fTsumwx2 = fTsumwx2 + w*x*x;
+   fTsumwy  = fTsumwy + w*y;
+   fTsumwy2 = fTsumwy2 + w*y*y;
+   if (fSumw2.fN) {
       // needs to account offset in array for overflow bins
-      bi = bin->GetBinNumber()-1+kNOverflow;
-      if (bin->IsInside(x,y)) {
-         bin->Fill(w);
-
-         // Statistics
-         fTsumw   = fTsumw + w;
-         fTsumw2  = fTsumw2 + w*w;
-         fTsumwx  = fTsumwx + w*x;
-         fTsumwx2 = fTsumwx2 + w*x*x;
-         fTsumwy  = fTsumwy + w*y;
-         fTsumwy2 = fTsumwy2 + w*y*y;
-         if (fSumw2.fN) {
-            assert(bi < fSumw2.fN);
-            fSumw2.fArray[bi] += w*w;
-         }
-         fEntries++;
-
-         SetBinContentChanged(kTRUE);
-
-         return bin->GetBinNumber();
-      }
+      Int_t bi = bin->GetBinNumber()-1+kNOverflow;
+      assert(bi < fSumw2.fN);
+      fSumw2.fArray[bi] += w*w;
    }
+   fEntries++;
+
+   SetBinContentChanged(kTRUE);
 
-   fOverflow[4]+= w;
-   if (fSumw2.fN) fSumw2.fArray[4] += w*w;
-   return -5;
+   return bin->GetBinNumber();
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -705,14 +879,15 @@ Int_t TH2Poly::Fill(const char* name, Double_t w)
 ///                      (array size must be ntimes*stride)
 /// \param [in] x:       array of x values to be histogrammed
 /// \param [in] y:       array of y values to be histogrammed
-/// \param [in] w:       array of weights
+/// \param [in] w:       array of weights, or nullptr for weights 1
 /// \param [in] stride:  step size through arrays x, y and w
 
 void TH2Poly::FillN(Int_t ntimes, const Double_t* x, const Double_t* y,
                                const Double_t* w, Int_t stride)
 {
+   ntimes *= stride;
    for (int i = 0; i < ntimes; i += stride) {
-      Fill(x[i], y[i], w[i]);
+      Fill(x[i], y[i], w ? w[i] : 1.);
    }
 }
 
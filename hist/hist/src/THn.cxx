@@ -11,6 +11,17 @@
 
 #include "THn.h"
 
+#include "RConfigure.h"
+#include "TCollection.h"
+
+#ifdef R__USE_IMT
+#include "ROOT/TSeq.hxx"
+#include "ROOT/TThreadExecutor.hxx"
+#include "TROOT.h"
+#include <algorithm>
+#include <vector>
+#endif
+
 namespace {
    //______________________________________________________________________________
    //
@@ -220,6 +231,99 @@ void THn::Sumw2() {
 }
 
 
+////////////////////////////////////////////////////////////////////////////////
+/// Add c * h to this histogram, see THnBase::AddInternal(). If h is a THn
+/// with the same binning, its bins are added to the bins with the same linear
+/// index.
+
+void THn::AddInternal(const THnBase* h, Double_t c, Bool_t rebinned)
+{
+   const THn* hn = dynamic_cast<const THn*>(h);
+   if (rebinned || !hn || hn->GetNbins() != GetNbins()) {
+      THnBase::AddInternal(h, c, rebinned);
+      return;
+   }
+
+   // Trigger error calculation if h has it
+   if (!GetCalculateErrors() && h->GetCalculateErrors())
+      Sumw2();
+
+   AddBins(hn, c, 0, GetNbins());
+   SetEntries(GetEntries() + c * h->GetEntries());
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Add c times the bins [first, last) of h, which has the same binning, to
+/// the same bins of this histogram.
+
+void THn::AddBins(const THn* h, Double_t c, Long64_t first, Long64_t last)
+{
+   TNDArray& content = GetArray();
+   const TNDArray& hcontent = h->GetArray();
+   const Bool_t haveErrors = GetCalculateErrors();
+   for (Long64_t ibin = first; ibin < last; ++ibin) {
+      const Double_t v = hcontent.AtAsDouble(ibin);
+      if (haveErrors)
+         fSumw2.At(ibin) += h->GetBinError2(ibin) * c * c;
+      content.AddAt(ibin, c * v);
+   }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Merge this with a list of THnBase's, see THnBase::Merge(). With implicit
+/// multi-threading enabled, a large list of THn's is merged concurrently on
+/// separate ranges of bins.
+
+Long64_t THn::Merge(TCollection* list)
+{
+#ifdef R__USE_IMT
+   // number of bins to merge above which the merge is parallelized
+   constexpr Long64_t kMinParallelMergeBins = 1 << 20;
+   // minimum number of bins of one task
+   constexpr Long64_t kMinTaskBins = 1 << 14;
+
+   const Long64_t nbins = GetNbins();
+   if (!list || list->IsEmpty() || !ROOT::IsImplicitMTEnabled() || nbins <= kMinTaskBins
+       || nbins * list->GetSize() < kMinParallelMergeBins)
+      return THnBase::Merge(list);
+
+   std::vector<const THn*> hists;
+   TIter iter(list);
+   while (const TObject* addMeObj = iter()) {
+      const THn* addMe = dynamic_cast<const THn*>(addMeObj);
+      if (!addMe || addMe->GetNbins() != nbins)
+         return THnBase::Merge(list);
+      if (CheckConsistency(addMe, "Merge"))
+         hists.push_back(addMe);
+   }
+
+   Double_t nEntries = GetEntries();
+   for (const THn* addMe: hists) {
+      if (!GetCalculateErrors() && addMe->GetCalculateErrors())
+         Sumw2();
+      nEntries += addMe->GetEntries();
+   }
+
+   // Allocate the arrays before they are accessed concurrently
+   GetArray().AddAt(0, 0.);
+   if (GetCalculateErrors())
+      fSumw2.AddAt(0, 0.);
+
+   ROOT::TThreadExecutor pool;
+   const Long64_t ntasks = std::min<Long64_t>(4 * pool.GetPoolSize(), nbins / kMinTaskBins);
+   const Long64_t taskBins = (nbins + ntasks - 1) / ntasks;
+   pool.Foreach([&](Long64_t i) {
+      for (const THn* addMe: hists)
+         AddBins(addMe, 1., i * taskBins, std::min(nbins, (i + 1) * taskBins));
+   }, ROOT::TSeq<Long64_t>(ntasks));
+
+   SetEntries(nEntries);
+   return (Long64_t)GetEntries();
+#else
+   return THnBase::Merge(list);
+#endif
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Create the coordinate buffer. Outlined to hide allocation
 /// from inlined functions.
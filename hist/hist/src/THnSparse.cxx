@@ -15,8 +15,35 @@
 #include "TClass.h"
 #include "TDataMember.h"
 #include "TDataType.h"
+#include "RConfigure.h"
+
+#ifdef R__USE_IMT
+#include "ROOT/TSeq.hxx"
+#include "ROOT/TThreadExecutor.hxx"
+#include "TROOT.h"
+#endif
 
 namespace {
+   /// Return the slot of the bin index table for "hash", given the mask of
+   /// the number of slots. The hash of small compact coordinates is the compact
+   /// coordinate itself, so its bits must be mixed before they can address the
+   /// table.
+   inline ULong64_t GetBinIndexSlot(ULong64_t hash, ULong64_t mask) {
+      hash ^= hash >> 33;
+      hash *= 0xff51afd7ed558ccdULL;
+      hash ^= hash >> 33;
+      return hash & mask;
+   }
+
+   /// Return the number of slots of the bin index table that keeps its load
+   /// below one half for nbins filled bins.
+   inline ULong64_t GetNumBinIndexSlots(Long64_t nbins) {
+      ULong64_t nslots = 16;
+      while (nslots < 2 * (ULong64_t)nbins)
+         nslots *= 2;
+      return nslots;
+   }
+
 //______________________________________________________________________________
 //
 // THnSparseBinIter iterates over all filled bins of a THnSparse.
@@ -318,9 +345,9 @@ ULong64_t THnSparseCoordCompression::GetHashFromBuffer(const Char_t* buf) const
 {
    // Bins are addressed in two different modes, depending
    // on whether the compact bin index fits into a Long64_t or not.
-   // If it does, we can use it as a "perfect hash" for the TExMap.
+   // If it does, we can use it as a "perfect hash" for the bin index.
    // If not we build a hash from the compact bin index, and use that
-   // as the TExMap's hash.
+   // as the bin index's hash.
 
    if (fCoordBufferSize <= 8) {
       // fits into a Long64_t
@@ -570,14 +597,18 @@ Translation from an n-dimensional bin coordinate to the linear index within
 the chunks is done by GetBin(). It creates a hash from the compacted bin
 coordinates (the hash of a bin coordinate is the compacted coordinate itself
 if it takes less than 8 bytes, the size of a Long64_t.
-This hash is used to lookup the linear index in the TExMap member fBins;
-the coordinates of the entry fBins points to is compared to the coordinates
-passed to GetBin(). If they do not match, these two coordinates have the same
-hash - which is extremely unlikely but (for the case where the compact bin
-coordinates are larger than 4 bytes) possible. In this case, fBinsContinued
-contains a chain of linear indexes with the same hash. Iterating through this
-chain and comparing each bin coordinates with the one passed to GetBin() will
-retrieve the matching bin.
+This hash is used to lookup the linear index in the member fBins, a flat
+open-addressing table of pairs (hash, linear index + 1) with linear probing,
+kept at most half full. Probing stops at the first slot whose hash matches
+and whose bin has the coordinates passed to GetBin(); when the compact bin
+coordinates are larger than 8 bytes, different coordinates can have the same
+hash, and the probing continues past them. The table is transient: it is
+rebuilt from the chunks when it is first needed after reading a THnSparse.
+
+Add() and Merge() of THnSparse with the same binning copy the compact
+coordinates of the bins instead of decoding and encoding them. With implicit
+multi-threading enabled, Merge() looks up the bins of each merged histogram
+and then adds their contents concurrently.
 */
 
 
@@ -658,28 +689,14 @@ void THnSparse::FillExMap()
    THnSparseArrayChunk* chunk = 0;
    THnSparseCoordCompression compactCoord(*GetCompactCoord());
    Long64_t idx = 0;
-   if (2 * GetNbins() > fBins.Capacity())
-      fBins.Expand(3 * GetNbins());
+   fBins.assign(2 * GetNumBinIndexSlots(GetNbins()), 0);
    while ((chunk = (THnSparseArrayChunk*) iChunk())) {
       const Int_t chunkSize = chunk->GetEntries();
       Char_t* buf = chunk->fCoordinates;
       const Int_t singleCoordSize = chunk->fSingleCoordinateSize;
       const Char_t* endbuf = buf + singleCoordSize * chunkSize;
-      for (; buf < endbuf; buf += singleCoordSize, ++idx) {
-         Long64_t hash = compactCoord.GetHashFromBuffer(buf);
-         Long64_t linidx = fBins.GetValue(hash);
-         if (linidx) {
-            Long64_t nextidx = linidx;
-            while (nextidx) {
-               // must be a collision, so go to fBinsContinued.
-               linidx = nextidx;
-               nextidx = fBinsContinued.GetValue(linidx);
-            }
-            fBinsContinued.Add(linidx, idx + 1);
-         } else {
-            fBins.Add(hash, idx + 1);
-         }
-      }
+      for (; buf < endbuf; buf += singleCoordSize, ++idx)
+         InsertBinIndex(compactCoord.GetHashFromBuffer(buf), idx);
    }
 }
 
@@ -687,12 +704,52 @@ void THnSparse::FillExMap()
 /// Initialize storage for nbins
 
 void THnSparse::Reserve(Long64_t nbins) {
-   if (!fBins.GetSize() && fBinContent.GetSize()) {
+   if (fBins.empty()) {
       FillExMap();
    }
-   if (2 * nbins > fBins.Capacity()) {
-      fBins.Expand(3 * nbins);
+   const ULong64_t nslots = GetNumBinIndexSlots(nbins);
+   if (2 * nslots <= fBins.size())
+      return;
+
+   std::vector<ULong64_t> bins(2 * nslots, 0);
+   fBins.swap(bins);
+   for (size_t i = 0; i < bins.size(); i += 2)
+      if (bins[i + 1])
+         InsertBinIndex(bins[i], bins[i + 1] - 1);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Add the bin with index "idx" and hash "hash" to fBins, which must have
+/// a free slot.
+
+void THnSparse::InsertBinIndex(ULong64_t hash, Long64_t idx)
+{
+   const ULong64_t mask = fBins.size() / 2 - 1;
+   ULong64_t slot = GetBinIndexSlot(hash, mask);
+   while (fBins[2 * slot + 1])
+      slot = (slot + 1) & mask;
+   fBins[2 * slot] = hash;
+   fBins[2 * slot + 1] = idx + 1;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return the index of the bin with hash "hash" and compact coordinates "buf",
+/// or -1 if it is not filled. Does not modify fBins, which must be set up.
+
+Long64_t THnSparse::FindBinIndex(ULong64_t hash, const Char_t* buf) const
+{
+   const ULong64_t mask = fBins.size() / 2 - 1;
+   ULong64_t slot = GetBinIndexSlot(hash, mask);
+   while (fBins[2 * slot + 1]) {
+      if (fBins[2 * slot] == hash) {
+         // fBins stores index + 1!
+         const Long64_t linidx = fBins[2 * slot + 1] - 1;
+         if (GetChunk(linidx / fChunkSize)->Matches(linidx % fChunkSize, buf))
+            return linidx;
+      }
+      slot = (slot + 1) & mask;
    }
+   return -1;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -790,21 +847,11 @@ Long64_t THnSparse::GetBinIndexForCurrentBin(Bool_t allocate)
 {
    THnSparseCompactBinCoord* cc = GetCompactCoord();
    ULong64_t hash = cc->GetHash();
-   if (fBinContent.GetSize() && !fBins.GetSize())
+   if (fBins.empty())
       FillExMap();
-   Long64_t linidx = (Long64_t) fBins.GetValue(hash);
-   while (linidx) {
-      // fBins stores index + 1!
-      THnSparseArrayChunk* chunk = GetChunk((linidx - 1)/ fChunkSize);
-      if (chunk->Matches((linidx - 1) % fChunkSize, cc->GetBuffer()))
-         return linidx - 1; // we store idx+1, 0 is "TExMap: not found"
-
-      Long64_t nextlinidx = fBinsContinued.GetValue(linidx);
-      if (!nextlinidx) break;
-
-      linidx = nextlinidx;
-   }
-   if (!allocate) return -1;
+   Long64_t linidx = FindBinIndex(hash, cc->GetBuffer());
+   if (linidx >= 0 || !allocate)
+      return linidx;
 
    ++fFilledBins;
 
@@ -819,19 +866,173 @@ Long64_t THnSparse::GetBinIndexForCurrentBin(Bool_t allocate)
 
    // store translation between hash and bin
    newidx += (fBinContent.GetEntriesFast() - 1) * fChunkSize;
-   if (!linidx) {
-      // fBins didn't find it
-      if (2 * GetNbins() > fBins.Capacity())
-         fBins.Expand(3 * GetNbins());
-      fBins.Add(hash, newidx + 1);
-   } else {
-      // fBins contains one, but it's the wrong one;
-      // add entry to fBinsContinued.
-      fBinsContinued.Add(linidx, newidx + 1);
-   }
+   if (4 * (ULong64_t)GetNbins() > fBins.size())
+      Reserve(2 * GetNbins());
+   InsertBinIndex(hash, newidx);
    return newidx;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Whether h has the same number of bins on each axis as this histogram, i.e.
+/// the same compact bin coordinates.
+
+Bool_t THnSparse::HasSameCompactCoord(const THnBase* h) const
+{
+   if (h->GetNdimensions() != fNdimensions)
+      return kFALSE;
+   for (Int_t d = 0; d < fNdimensions; ++d)
+      if (h->GetAxis(d)->GetNbins() != GetAxis(d)->GetNbins())
+         return kFALSE;
+   return kTRUE;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Add c * h to this histogram, see THnBase::AddInternal(). The bins of a
+/// THnSparse with the same binning are found through their compact
+/// coordinates, without decoding them.
+
+void THnSparse::AddInternal(const THnBase* h, Double_t c, Bool_t rebinned)
+{
+   const THnSparse* hs = dynamic_cast<const THnSparse*>(h);
+   if (rebinned || !hs || !HasSameCompactCoord(hs)) {
+      THnBase::AddInternal(h, c, rebinned);
+      return;
+   }
+
+   // Trigger error calculation if h has it
+   if (!GetCalculateErrors() && h->GetCalculateErrors())
+      Sumw2();
+   Bool_t haveErrors = GetCalculateErrors();
+
+   Reserve(GetNbins() + h->GetNbins());
+
+   THnSparseCompactBinCoord* cc = GetCompactCoord();
+   const Int_t coordSize = cc->GetBufferSize();
+   for (Int_t i = 0; i < hs->GetNChunks(); ++i) {
+      const THnSparseArrayChunk* chunk = hs->GetChunk(i);
+      const Int_t nbins = chunk->GetEntries();
+      for (Int_t j = 0; j < nbins; ++j) {
+         cc->SetBuffer(chunk->fCoordinates + j * coordSize);
+         Long64_t mybinidx = GetBinIndexForCurrentBin(kTRUE);
+         Double_t v = chunk->fContent->GetAt(j);
+         if (haveErrors) {
+            Double_t err2 = (chunk->fSumw2 ? chunk->fSumw2->GetAt(j) : v) * c * c;
+            AddBinError2(mybinidx, err2);
+         }
+         AddBinContent(mybinidx, c * v);
+      }
+   }
+
+   SetEntries(GetEntries() + c * h->GetEntries());
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Fill n entries: the coordinates of entry i are x[i * GetNdimensions()] to
+/// x[(i + 1) * GetNdimensions() - 1], its weight is w[i], or 1 if w is null.
+
+void THnSparse::FillN(Int_t n, const Double_t* x, const Double_t* w /* = nullptr */)
+{
+   THnSparseCompactBinCoord* cc = GetCompactCoord();
+   Int_t *coord = cc->GetCoord();
+   for (Int_t i = 0; i < n; ++i, x += fNdimensions) {
+      const Double_t wi = w ? w[i] : 1.;
+      UpdateXStat(x, wi);
+      for (Int_t d = 0; d < fNdimensions; ++d)
+         coord[d] = GetAxis(d)->FindBin(x[d]);
+      cc->UpdateCoord();
+      THnSparse::FillBin(GetBinIndexForCurrentBin(kTRUE), wi);
+   }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Merge this with a list of THnBase's, see THnBase::Merge(). With implicit
+/// multi-threading enabled, the bins of each THnSparse with the same binning
+/// are first looked up concurrently; the missing ones are then allocated, and
+/// finally their contents are added concurrently.
+
+Long64_t THnSparse::Merge(TCollection* list)
+{
+#ifdef R__USE_IMT
+   if (!list || list->IsEmpty() || !ROOT::IsImplicitMTEnabled())
+      return THnBase::Merge(list);
+
+   Long64_t sumNbins = GetNbins();
+   TIter iter(list);
+   const TObject* addMeObj = 0;
+   while ((addMeObj = iter())) {
+      const THnBase* addMe = dynamic_cast<const THnBase*>(addMeObj);
+      if (addMe) {
+         sumNbins += addMe->GetNbins();
+      }
+   }
+   Reserve(sumNbins);
+
+   THnSparseCompactBinCoord* cc = GetCompactCoord();
+   const Int_t coordSize = cc->GetBufferSize();
+   ROOT::TThreadExecutor pool;
+   iter.Reset();
+   while ((addMeObj = iter())) {
+      const THnSparse* addMe = dynamic_cast<const THnSparse*>(addMeObj);
+      if (!addMe || !HasSameCompactCoord(addMe)) {
+         if (!dynamic_cast<const THnBase*>(addMeObj))
+            Error("Merge", "Object named %s is not THnBase! Skipping it.",
+                  addMeObj->GetName());
+         else
+            Add((const THnBase*)addMeObj);
+         continue;
+      }
+      if (!CheckConsistency(addMe, "Merge"))
+         continue;
+
+      if (!GetCalculateErrors() && addMe->GetCalculateErrors())
+         Sumw2();
+      const Bool_t haveErrors = GetCalculateErrors();
+      const Long64_t addMeChunkSize = addMe->GetChunkSize();
+      const auto chunks = ROOT::TSeqI(addMe->GetNChunks());
+
+      // Look up the bins of addMe; fBins is not modified meanwhile
+      std::vector<Long64_t> mybins(addMe->GetNbins());
+      pool.Foreach([&](Int_t i) {
+         const THnSparseArrayChunk* chunk = addMe->GetChunk(i);
+         const Int_t nbins = chunk->GetEntries();
+         for (Int_t j = 0; j < nbins; ++j) {
+            const Char_t* buf = chunk->fCoordinates + j * coordSize;
+            mybins[i * addMeChunkSize + j] = FindBinIndex(cc->GetHashFromBuffer(buf), buf);
+         }
+      }, chunks);
+
+      // Allocate the missing ones
+      for (Long64_t bin = 0; bin < (Long64_t)mybins.size(); ++bin) {
+         if (mybins[bin] >= 0)
+            continue;
+         const THnSparseArrayChunk* chunk = addMe->GetChunk(bin / addMeChunkSize);
+         cc->SetBuffer(chunk->fCoordinates + (bin % addMeChunkSize) * coordSize);
+         mybins[bin] = GetBinIndexForCurrentBin(kTRUE);
+      }
+
+      // Different bins of addMe are added to different bins of this
+      pool.Foreach([&](Int_t i) {
+         const THnSparseArrayChunk* chunk = addMe->GetChunk(i);
+         const Int_t nbins = chunk->GetEntries();
+         for (Int_t j = 0; j < nbins; ++j) {
+            const Long64_t mybinidx = mybins[i * addMeChunkSize + j];
+            THnSparseArrayChunk* mychunk = GetChunk(mybinidx / fChunkSize);
+            const Int_t myidx = mybinidx % fChunkSize;
+            const Double_t v = chunk->fContent->GetAt(j);
+            if (haveErrors)
+               (*mychunk->fSumw2)[myidx] += chunk->fSumw2 ? chunk->fSumw2->GetAt(j) : v;
+            mychunk->fContent->SetAt(v + mychunk->fContent->GetAt(myidx), myidx);
+         }
+      }, chunks);
+
+      SetEntries(GetEntries() + addMe->GetEntries());
+   }
+   return (Long64_t)GetEntries();
+#else
+   return THnBase::Merge(list);
+#endif
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Return THnSparseCompactBinCoord object.
 
@@ -880,7 +1081,7 @@ Double_t THnSparse::GetSparseFractionMem() const {
 
    Double_t size = 0.;
    size += fBinContent.GetEntries() * (GetChunkSize() * sizePerChunkElement + sizeof(THnSparseArrayChunk));
-   size += + 3 * sizeof(Long64_t) * fBins.GetSize() /* TExMap */;
+   size += sizeof(ULong64_t) * fBins.size() /* fBins */;
 
    Double_t nbinsTotal = 1.;
    for (Int_t d = 0; d < fNdimensions; ++d)
@@ -962,8 +1163,7 @@ void THnSparse::Sumw2()
 void THnSparse::Reset(Option_t *option /*= ""*/)
 {
    fFilledBins = 0;
-   fBins.Delete();
-   fBinsContinued.Clear();
+   std::vector<ULong64_t>().swap(fBins);
    fBinContent.Delete();
    ResetBase(option);
 }
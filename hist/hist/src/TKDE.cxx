@@ -22,6 +22,13 @@
 
  The algorithm is briefly described in (4). A binned version is also implemented to address the
  performance issue due to its data size dependance.
+
+ The estimate at a point sums only the kernels whose support contains the point, found by a binary
+ search in the sorted data. For the Gaussian kernel with a fixed bandwidth, a fast Gauss transform
+ can be used instead by setting a tolerance with SetTolerance(): the data are grouped in boxes of the
+ size of the bandwidth and the kernels of each box are replaced by a truncated Taylor expansion, so
+ that the evaluation cost no longer depends on the number of events. Many points can be evaluated at
+ once with GetValues(), in parallel when the implicit multi-threading is enabled.
  */
 
 
@@ -32,6 +39,7 @@
 #include <limits>
 #include <cassert>
 
+#include "RConfigure.h"
 #include "Math/Error.h"
 #include "TMath.h"
 #include "Math/Functor.h"
@@ -44,6 +52,12 @@
 #include "TVirtualPad.h"
 #include "TKDE.h"
 
+#ifdef R__USE_IMT
+#include "ROOT/TSeq.hxx"
+#include "ROOT/TThreadExecutor.hxx"
+#include "TROOT.h"
+#endif
+
 ClassImp(TKDE);
 
 
@@ -70,7 +84,7 @@ TKDE::TKDE() :
    fUseBins(false), fNewData(false), fUseMinMaxFromData(false),
    fNBins(0), fNEvents(0), fSumOfCounts(0), fUseBinsNEvents(0),
    fMean(0.),fSigma(0.), fSigmaRob(0.), fXMin(0.), fXMax(0.),
-   fRho(0.), fAdaptiveBandwidthFactor(0.), fWeightSize(0)
+   fRho(0.), fAdaptiveBandwidthFactor(0.), fWeightSize(0), fTolerance(0)
 {
 }
 
@@ -111,6 +125,7 @@ void TKDE::Instantiate(KernelFunction_Ptr kernfunc, UInt_t events, const Double_
    fAdaptiveBandwidthFactor = 1.;
    fRho = rho;
    fWeightSize = 0;
+   fTolerance = 0;
    fCanonicalBandwidths = std::vector<Double_t>(kTotalKernels, 0.0);
    fKernelSigmas2 = std::vector<Double_t>(kTotalKernels, -1.0);
    fSettedOptions = std::vector<Bool_t>(4, kFALSE);
@@ -389,6 +404,22 @@ void TKDE::SetRange(Double_t xMin, Double_t xMax) {
    fKernel.reset();
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Sets the tolerance of the fast Gauss transform used for the Gaussian kernel
+/// with a fixed bandwidth. The magnitude of the error on each kernel term is
+/// below tol, hence the absolute error on the estimate is bounded by tol times
+/// the height \f$ 1/(\sqrt{2\pi} h) \f$ of a single kernel of bandwidth h.
+/// With tol = 0 (the default) the estimate is computed exactly.
+
+void TKDE::SetTolerance(Double_t tol) {
+   if (tol < 0.0 || tol >= 1.0) {
+      Error("SetTolerance", "Tolerance must be in [0,1[ ! Present tolerance remains the same.");
+      return;
+   }
+   fTolerance = tol;
+   fKernel.reset();
+}
+
 // private methods
 
 void TKDE::SetUseBins() {
@@ -748,6 +779,39 @@ Double_t TKDE::operator()(Double_t x) const {
    return (*fKernel)(x);
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Returns the kernel density estimate at the n points x in the array values.
+/// The points are evaluated in parallel when the implicit multi-threading is enabled.
+
+void TKDE::GetValues(UInt_t n, const Double_t* x, Double_t* values) const {
+   if (!fKernel) {
+      (const_cast<TKDE*>(this))->ReInit();
+      if (!fKernel) {
+         std::fill(values, values + n, TMath::QuietNaN());
+         return;
+      }
+   }
+   const TKernel &kernel = *fKernel;
+#ifdef R__USE_IMT
+   // below this size the tasks do not pay off
+   const UInt_t kMinPointsPerTask = 64;
+   if (ROOT::IsImplicitMTEnabled() && n >= 2 * kMinPointsPerTask) {
+      ROOT::TThreadExecutor pool;
+      const UInt_t nTasks = std::min<UInt_t>(n / kMinPointsPerTask, 8 * pool.GetPoolSize());
+      auto evaluate = [&](UInt_t task) {
+         const UInt_t first = (UInt_t)((ULong64_t)n * task / nTasks);
+         const UInt_t last = (UInt_t)((ULong64_t)n * (task + 1) / nTasks);
+         for (UInt_t i = first; i < last; ++i)
+            values[i] = kernel(x[i]);
+      };
+      pool.Foreach(evaluate, ROOT::TSeqU(nTasks));
+      return;
+   }
+#endif
+   for (UInt_t i = 0; i < n; ++i)
+      values[i] = kernel(x[i]);
+}
+
 Double_t TKDE::GetMean() const {
    // return the mean of the data
    if (fNewData) (const_cast<TKDE*>(this))->InitFromNewData();
@@ -770,8 +834,11 @@ TKDE::TKernel::TKernel(Double_t weight, TKDE* kde) :
 // Internal class constructor
 fKDE(kde),
 fNWeights(kde->fData.size()),
-fWeights(1, weight)
-{}
+fWeights(1, weight),
+fSupport(0), fNTerms(0), fNBoxes(0), fBoxMin(0), fCutoff(0)
+{
+   SetSources();
+}
 
 void TKDE::TKernel::ComputeAdaptiveWeights() {
    // Gets the adaptive weights (bandwidths) for TKernel internal computation
@@ -809,6 +876,128 @@ void TKDE::TKernel::ComputeAdaptiveWeights() {
    transform(weights.begin(), weights.end(), fWeights.begin(),
              std::bind(std::multiplies<Double_t>(), std::placeholders::_1, fKDE->fAdaptiveBandwidthFactor));
    //printf("adaptive bandwidth factor % f weight 0 %f , %f \n",fKDE->fAdaptiveBandwidthFactor, weights[0],fWeights[0] );
+   SetSources();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Sets the kernels of the estimate, sorted by position. The reflected data of
+/// the asymmetric mirroring are added as kernels of their own, and the data with
+/// a null count or bandwidth are dropped since they do not contribute.
+
+void TKDE::TKernel::SetSources() {
+   UInt_t n = fKDE->fData.size();
+   Bool_t useCount = (fKDE->fBinCount.size() == n);
+   Bool_t hasAdaptiveWeights = (fWeights.size() == n);
+   std::vector<std::pair<Double_t, UInt_t>> sources;
+   sources.reserve((1 + fKDE->fAsymLeft + fKDE->fAsymRight) * n);
+   for (UInt_t i = 0; i < n; ++i) {
+      if ((useCount && fKDE->fBinCount[i] == 0) || (hasAdaptiveWeights && fWeights[i] == 0))
+         continue;
+      Double_t x = fKDE->fData[i];
+      sources.emplace_back(x, i);
+      if (fKDE->fAsymLeft)
+         sources.emplace_back(2. * fKDE->fXMin - x, i);
+      if (fKDE->fAsymRight)
+         sources.emplace_back(2. * fKDE->fXMax - x, i);
+   }
+   std::sort(sources.begin(), sources.end());
+
+   UInt_t nSources = sources.size();
+   fSourceX.resize(nSources);
+   fSourceCount.resize(nSources);
+   fSourceInvWeight.resize(nSources);
+   Double_t maxWeight = 0;
+   for (UInt_t j = 0; j < nSources; ++j) {
+      UInt_t i = sources[j].second;
+      Double_t weight = (hasAdaptiveWeights) ? fWeights[i] : fWeights[0];
+      fSourceX[j] = sources[j].first;
+      fSourceInvWeight[j] = 1. / weight;
+      fSourceCount[j] = ((useCount) ? fKDE->fBinCount[i] : 1.0) * fSourceInvWeight[j];
+      maxWeight = std::max(maxWeight, weight);
+   }
+
+   // the internal kernels vanish beyond these values (see TKDE::GaussianKernel), with a
+   // margin for the rounding of the scaled distance
+   switch (fKDE->fKernelType) {
+      case kGaussian: fSupport = 9. * maxWeight * (1. + 1.E-9); break;
+      case kEpanechnikov:
+      case kBiweight:
+      case kCosineArch: fSupport = maxWeight * (1. + 1.E-9); break;
+      default: fSupport = 0; // all the kernels are summed
+   }
+
+   fNTerms = 0;
+   fCoefficients.clear();
+   if (fKDE->fTolerance > 0 && fKDE->fKernelType == kGaussian && !hasAdaptiveWeights && nSources > 0)
+      SetExpansions();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Computes the expansions of the fast Gauss transform (the improved version of
+/// C. Yang, R. Duraiswami, N. Gumerov and L. Davis, ICCV 2003). In units of the
+/// bandwidth, the kernels of the sources s in a box of centre c and half width
+/// \f$ r_x = 1/2 \f$ are summed at a point t, with a = t - c and b = s - c, as
+/// \f[ e^{-(a-b)^2/2} = e^{-a^2/2} e^{-b^2/2} \sum_k \frac{a^k b^k}{k!} \f]
+/// truncated after p terms. For \f$ |a| < r_y \f$ the error on each kernel is below
+/// \f$ (r_x r_y)^p / p! \f$, and the boxes farther than \f$ r_y \f$ contribute less
+/// than \f$ e^{-(r_y - r_x)^2/2} \f$ each: both are set to half of the tolerance.
+
+void TKDE::TKernel::SetExpansions() {
+   const Double_t invWeight = 1. / fWeights[0];
+   const Double_t sMin = fSourceX.front() * invWeight;
+   const Double_t sMax = fSourceX.back() * invWeight;
+   // boxes of unit width: if they outnumber the sources the data are sparse and
+   // the sum over the support of the kernels is faster
+   if (sMax - sMin >= fSourceX.size())
+      return;
+   const Double_t halfTolerance = 0.5 * fKDE->fTolerance;
+   const Double_t rx = 0.5;
+   fCutoff = rx + std::sqrt(-2. * std::log(halfTolerance));
+   UInt_t p = 0;
+   for (Double_t error = 1.; error > halfTolerance; error *= rx * fCutoff / p)
+      ++p;
+   fNTerms = p;
+   fNBoxes = UInt_t(sMax - sMin) + 1;
+   fBoxMin = sMin;
+   fCoefficients.assign(fNBoxes * fNTerms, 0.);
+
+   for (UInt_t j = 0; j < fSourceX.size(); ++j) {
+      Double_t s = fSourceX[j] * invWeight;
+      UInt_t box = std::min(UInt_t(s - fBoxMin), fNBoxes - 1);
+      Double_t b = s - (fBoxMin + box + rx);
+      Double_t term = fSourceCount[j] * std::exp(-0.5 * b * b);
+      Double_t *c = &fCoefficients[box * fNTerms];
+      for (UInt_t k = 0; k < fNTerms; ++k) {
+         c[k] += term;
+         term *= b / (k + 1);
+      }
+   }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Returns the sum of the Gaussian kernels at x from the fast Gauss transform
+
+Double_t TKDE::TKernel::EvaluateExpansions(Double_t x) const {
+   const Double_t k2_PI_ROOT_INV = 0.398942280401432703; // (2 * M_PI)**-0.5
+   const Double_t rx = 0.5;
+   const Double_t t = x / fWeights[0];
+   // boxes whose centre fBoxMin + box + rx is within the cutoff of t
+   const Double_t firstBox = std::ceil(t - fCutoff - fBoxMin - rx);
+   const Double_t lastBox = std::floor(t + fCutoff - fBoxMin - rx);
+   if (lastBox < 0 || firstBox >= fNBoxes)
+      return 0;
+   const UInt_t first = (firstBox > 0) ? UInt_t(firstBox) : 0;
+   const UInt_t last = (lastBox < fNBoxes - 1) ? UInt_t(lastBox) : fNBoxes - 1;
+   Double_t result = 0;
+   for (UInt_t box = first; box <= last; ++box) {
+      Double_t a = t - (fBoxMin + box + rx);
+      const Double_t *c = &fCoefficients[box * fNTerms];
+      Double_t sum = c[fNTerms - 1];
+      for (UInt_t k = fNTerms - 1; k > 0; --k)
+         sum = sum * a + c[k - 1];
+      result += std::exp(-0.5 * a * a) * sum;
+   }
+   return k2_PI_ROOT_INV * result;
 }
 
 Double_t TKDE::TKernel::GetWeight(Double_t x) const {
@@ -1009,35 +1198,23 @@ const std::vector<Double_t> & TKDE::TKernel::GetAdaptiveWeights() const {
 
 Double_t TKDE::TKernel::operator()(Double_t x) const {
    // The internal class's unary function: returns the kernel density estimate
-   Double_t result(0.0);
-   UInt_t n = fKDE->fData.size();
-   // case of bins or weighted data
-   Bool_t useCount = (fKDE->fBinCount.size() == n);
    // also in case of unbinned unweighted data fSumOfCounts is sum of events in range
    // events outside range should be used to normalize the TKDE ??
    Double_t nSum = fKDE->fSumOfCounts; //(useBins) ? fKDE->fSumOfCounts : fKDE->fNEvents;
-   //if (!useCount) nSum = fKDE->fNEvents;
-   // in case of non-adaptive fWeights is a vector of size 1
-   Bool_t hasAdaptiveWeights = (fWeights.size() == n);
-   Double_t invWeight = (!hasAdaptiveWeights) ? 1. / fWeights[0] : 0;
-   for (UInt_t i = 0; i < n; ++i) {
-      Double_t binCount = (useCount) ? fKDE->fBinCount[i] : 1.0;
-      // uncommenting following line slows down so keep computation for
-      // zero bincounts
-      //if (binCount <= 0) continue;
-      if (hasAdaptiveWeights) {
-         // skip data points that have 0 bandwidth (this can happen, see TKernel::ComputeAdaptiveWeight)
-         if (fWeights[i] == 0) continue;
-         invWeight = 1. / fWeights[i];
-      }
-      result += binCount * invWeight * (*fKDE->fKernelFunction)((x - fKDE->fData[i]) * invWeight );
-      if (fKDE->fAsymLeft) {
-         result += binCount * invWeight * (*fKDE->fKernelFunction)((x - (2. * fKDE->fXMin - fKDE->fData[i])) * invWeight);
+   Double_t result(0.0);
+   if (fNTerms > 0) {
+      result = EvaluateExpansions(x);
+   } else {
+      // sum the kernels whose support contains x
+      UInt_t first = 0;
+      UInt_t last = fSourceX.size();
+      if (fSupport > 0) {
+         first = std::lower_bound(fSourceX.begin(), fSourceX.end(), x - fSupport) - fSourceX.begin();
+         last = std::upper_bound(fSourceX.begin() + first, fSourceX.end(), x + fSupport) - fSourceX.begin();
       }
-      if (fKDE->fAsymRight) {
-         result += binCount * invWeight * (*fKDE->fKernelFunction)((x - (2. * fKDE->fXMax - fKDE->fData[i])) * invWeight);
+      for (UInt_t i = first; i < last; ++i) {
+         result += fSourceCount[i] * (*fKDE->fKernelFunction)((x - fSourceX[i]) * fSourceInvWeight[i]);
       }
-      // printf("data point %i  %f  %f  count %f weight % f result % f\n",i,fKDE->fData[i],fKDE->fEvents[i],binCount,fWeights[i], result);
    }
    if ( TMath::IsNaN(result) ) {
       fKDE->Warning("operator()","Result is NaN for  x %f \n",x);
@@ -21,6 +21,7 @@
 #include <TFormula.h>
 #include <TF1.h>
 #include <TFitResult.h>
+#include <TH1D.h>
 
 TEST(TFormulaGradientPar, Sanity)
 {
@@ -144,3 +145,28 @@ TEST(TFormulaGradientPar, GetGradFormula)
 #endif // R__WIN32
 }
 
+
+// The fits with option G use the gradient generated by clad for the functions defined by a formula.
+TEST(TFormulaGradientPar, FitWithGradient)
+{
+   TH1D h("hGrad", "hGrad", 100, -5, 5);
+   for (int i = 1; i <= h.GetNbinsX(); ++i) {
+      double x = h.GetBinCenter(i);
+      h.SetBinContent(i, 50 * std::exp(-0.5 * (x - 0.5) * (x - 0.5) / 1.44) + 5);
+      h.SetBinError(i, 1);
+   }
+
+   TF1 f1("fGrad", "[0]*exp(-0.5*((x-[1])/[2])^2) + [3]", -5, 5);
+   f1.SetParameters(40, 0, 1, 1);
+   auto r1 = h.Fit(&f1, "S Q N G");
+   ASSERT_TRUE(f1.GetFormula()->HasGeneratedGradient());
+
+   TF1 f2("fNum", "[0]*exp(-0.5*((x-[1])/[2])^2) + [3]", -5, 5);
+   f2.SetParameters(40, 0, 1, 1);
+   auto r2 = h.Fit(&f2, "S Q N");
+   ASSERT_FALSE(f2.GetFormula()->HasGeneratedGradient());
+
+   ASSERT_EQ(0, r1->Status());
+   for (int i = 0; i < 4; ++i)
+      EXPECT_NEAR(r2->Parameter(i), r1->Parameter(i), 1e-4 * (1 + std::abs(r2->Parameter(i))));
+}
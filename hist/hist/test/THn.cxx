@@ -3,6 +3,8 @@
 #include "THn.h"
 #include "TH1.h"
 #include "TH2.h"
+#include "TList.h"
+#include "TROOT.h"
 
 // Filling THn
 TEST(THn, Fill) {
@@ -111,3 +113,41 @@ TEST(THn, Projection) {
    }
 
 }
+
+// Merging THn, concurrently on ranges of bins if IMT is enabled
+TEST(THn, Merge) {
+   Int_t bins[4] = {30, 30, 30, 30};
+   Double_t xmin[4] = {0., 0., 0., 0.};
+   Double_t xmax[4] = {30., 30., 30., 30.};
+   THnD hn("hn", "hn", 4, bins, xmin, xmax);
+   THnD hn1("hn1", "hn1", 4, bins, xmin, xmax);
+   THnD hn2("hn2", "hn2", 4, bins, xmin, xmax);
+   hn2.Sumw2();
+   for (Int_t i = 0; i < 30; ++i) {
+      Double_t x[4]{i + 0.5, 0.5, 29.5, i + 0.5};
+      hn.Fill(x);
+      hn1.Fill(x, 2.);
+      hn2.Fill(x, 3.);
+   }
+   TList list;
+   list.Add(&hn1);
+   list.Add(&hn2);
+
+#ifdef R__USE_IMT
+   ROOT::EnableImplicitMT(4);
+#endif
+   EXPECT_EQ(90, hn.Merge(&list));
+#ifdef R__USE_IMT
+   ROOT::DisableImplicitMT();
+#endif
+
+   EXPECT_TRUE(hn.GetCalculateErrors());
+   for (Int_t i = 0; i < 30; ++i) {
+      Int_t coord[4]{i + 1, 1, 30, i + 1};
+      EXPECT_DOUBLE_EQ(6., hn.GetBinContent(coord));
+      // squared errors: the contents 1 and 2 of the unweighted histograms, 9 for hn2
+      EXPECT_DOUBLE_EQ(12., hn.GetBinError2(hn.GetBin(coord)));
+   }
+   Int_t coord[4]{1, 2, 30, 1};
+   EXPECT_DOUBLE_EQ(0., hn.GetBinContent(coord));
+}
@@ -0,0 +1,122 @@
+#include "TF1.h"
+#include "TF1SamplingTable.h"
+#include "TRandom3.h"
+
+#include "gtest/gtest.h"
+
+#include <cmath>
+#include <thread>
+#include <vector>
+
+// The batch conversion gives the same values as the conversion of one value at a time
+TEST(TF1GetRandom, BatchSameAsScalar)
+{
+   TF1 f1("f1", "gaus", -5, 5);
+   f1.SetParameters(1, 0.5, 1.2);
+   auto table = f1.GetSamplingTable();
+   ASSERT_TRUE(table->IsValid());
+   EXPECT_EQ(table->GetNpx(), f1.GetNpx());
+
+   std::vector<double> r(1000);
+   TRandom3 rng(1);
+   rng.RndmArray(r.size(), r.data());
+   std::vector<double> x(r.size());
+   table->GetX(r.size(), r.data(), x.data());
+   for (std::size_t i = 0; i < r.size(); ++i)
+      EXPECT_EQ(x[i], table->GetX(r[i]));
+
+   // the table does not depend on the function any longer
+   f1.SetParameters(1, -2, 0.1);
+   EXPECT_NE(f1.GetSamplingTable(), table);
+   for (std::size_t i = 0; i < r.size(); ++i)
+      EXPECT_EQ(x[i], table->GetX(r[i]));
+}
+
+TEST(TF1GetRandom, Moments)
+{
+   TF1 f1("f1", "gaus", -10, 10);
+   f1.SetParameters(1, 1.5, 1.2);
+   f1.SetNpx(1000);
+   const int n = 100000;
+   std::vector<double> x(n);
+   TRandom3 rng(2);
+   f1.GetRandom(n, x.data(), &rng);
+   double sum = 0, sum2 = 0;
+   for (double xi : x) {
+      sum += xi;
+      sum2 += xi * xi;
+   }
+   const double mean = sum / n;
+   EXPECT_NEAR(mean, 1.5, 5 * 1.2 / std::sqrt(n));
+   EXPECT_NEAR(std::sqrt(sum2 / n - mean * mean), 1.2, 0.02);
+
+   // log scale table
+   TF1 f2("f2", "expo", 1, 1000);
+   f2.SetParameters(0, -0.01);
+   auto table = f2.GetSamplingTable("LOG");
+   EXPECT_TRUE(table->IsLogScale());
+   for (int i = 0; i < 1000; ++i) {
+      const double x2 = f2.GetRandom(10, 20, &rng);
+      EXPECT_GE(x2, 10);
+      EXPECT_LE(x2, 20);
+   }
+}
+
+TEST(TF1GetRandom, InvalidTable)
+{
+   TF1 f1("f1", "0*x", 0, 1);
+   EXPECT_FALSE(f1.GetSamplingTable()->IsValid());
+   EXPECT_TRUE(std::isnan(f1.GetRandom()));
+}
+
+// One table shared by several threads, each with its own generator
+TEST(TF1GetRandom, SharedTable)
+{
+   TF1 f1("f1", "landau", -5, 20);
+   f1.SetParameters(1, 0, 1);
+   auto table = f1.GetSamplingTable();
+
+   const int nThreads = 4;
+   const int n = 10000;
+   std::vector<std::vector<double>> results(nThreads, std::vector<double>(n));
+   std::vector<std::thread> threads;
+   for (int i = 0; i < nThreads; ++i) {
+      threads.emplace_back([&, i]() {
+         TRandom3 rng(100 + i);
+         table->GetRandom(n, results[i].data(), &rng);
+      });
+   }
+   for (auto &t : threads)
+      t.join();
+
+   for (int i = 0; i < nThreads; ++i) {
+      std::vector<double> expected(n);
+      TRandom3 rng(100 + i);
+      table->GetRandom(n, expected.data(), &rng);
+      EXPECT_EQ(results[i], expected);
+   }
+}
+
+TEST(TF1Integral, Cache)
+{
+   TF1 f1("f1", "[0]*exp(-0.5*((x-[1])/[2])^2)/(x*x+1)", -5, 5);
+   f1.SetParameters(1, 0, 1);
+   const double i1 = f1.Integral(-1, 2);
+   f1.SetIntegralCache();
+   EXPECT_EQ(f1.Integral(-1, 2), i1);
+   EXPECT_EQ(f1.Integral(-1, 2), i1);
+
+   // the parameter values are part of the key
+   f1.SetParameters(2, 0, 1);
+   EXPECT_NEAR(f1.Integral(-1, 2), 2 * i1, 1e-10);
+   f1.SetParameters(1, 0, 1);
+   EXPECT_EQ(f1.Integral(-1, 2), i1);
+
+   // the sampling table from cached integrals is the same as the one computed before
+   auto table = f1.GetSamplingTable();
+   f1.SetParameters(1, 0, 1);
+   EXPECT_EQ(f1.GetSamplingTable()->GetCdf(), table->GetCdf());
+
+   f1.SetIntegralCache(0);
+   EXPECT_NEAR(f1.Integral(-1, 2), i1, 1e-12);
+}
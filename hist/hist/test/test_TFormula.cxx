@@ -2,8 +2,34 @@
 
 #include "TFormula.h"
 
+#include <vector>
+
 // Test that autoloading works (ROOT-9840)
 TEST(TFormula, Interp)
 {
   TFormula f("func", "TGeoBBox::DeclFileLine()");
 }
+
+// Test that the batched evaluation gives the same values as the evaluation point by point
+TEST(TFormula, EvalBatch)
+{
+   TFormula f1("f1", "[0] + [1] * sin(x) + [2] * x * x");
+   const double p1[] = {1., 2., 0.5};
+   std::vector<double> x1(1000);
+   for (std::size_t i = 0; i < x1.size(); ++i)
+      x1[i] = -5. + 0.01 * i;
+   std::vector<double> out1(x1.size());
+   f1.EvalBatch(x1.size(), x1.data(), p1, out1.data());
+   for (std::size_t i = 0; i < x1.size(); ++i)
+      EXPECT_DOUBLE_EQ(f1.EvalPar(&x1[i], p1), out1[i]);
+
+   TFormula f2("f2", "[0] * x + y * y");
+   const double p2[] = {3.};
+   std::vector<double> x2(200);
+   for (std::size_t i = 0; i < x2.size(); ++i)
+      x2[i] = 0.1 * i;
+   std::vector<double> out2(x2.size() / 2);
+   f2.EvalBatch(out2.size(), x2.data(), p2, out2.data());
+   for (std::size_t i = 0; i < out2.size(); ++i)
+      EXPECT_DOUBLE_EQ(f2.EvalPar(&x2[2 * i], p2), out2[i]);
+}
@@ -0,0 +1,66 @@
+#include "TGraph.h"
+#include "TSpline.h"
+
+#include "gtest/gtest.h"
+
+#include <vector>
+
+// The overload of TGraph::Eval on arrays gives the same results as evaluating each point
+TEST(TGraphEval, ArraySameAsScalar)
+{
+   // not sorted, with points of the same abscissa
+   TGraph g;
+   const double px[] = {3., 1., 4., 1., 5., 9., 2., 6., 5., 3.};
+   const double py[] = {2., 7., 1., 8., 2., 8., 1., 8., 2., 8.};
+   for (int i = 0; i < 10; ++i)
+      g.SetPoint(i, px[i], py[i]);
+
+   std::vector<double> x;
+   for (int i = -8; i < 50; ++i)
+      x.push_back(0.25 * i);
+   std::vector<double> y(x.size());
+
+   for (auto option : {"", "S"}) {
+      g.Eval(x.size(), x.data(), y.data(), nullptr, option);
+      for (std::size_t i = 0; i < x.size(); ++i)
+         EXPECT_DOUBLE_EQ(g.Eval(x[i], nullptr, option), y[i]) << "option " << option << " x " << x[i];
+   }
+
+   g.Sort();
+   g.SetBit(TGraph::kIsSortedX);
+   g.Eval(x.size(), x.data(), y.data());
+   for (std::size_t i = 0; i < x.size(); ++i)
+      EXPECT_DOUBLE_EQ(g.Eval(x[i]), y[i]) << "sorted, x " << x[i];
+}
+
+// The spline kept by the graph for the option "S" follows the changes of the points
+TEST(TGraphEval, SplineUpdate)
+{
+   TGraph g;
+   for (int i = 0; i < 10; ++i)
+      g.SetPoint(i, 9 - i, (i - 4.5) * (i - 4.5));
+
+   auto splineEval = [&g](double x) {
+      std::vector<double> xs(g.GetX(), g.GetX() + g.GetN());
+      std::vector<double> ys(g.GetY(), g.GetY() + g.GetN());
+      TGraph sorted(g.GetN(), xs.data(), ys.data());
+      sorted.Sort();
+      TSpline3 s("", sorted.GetX(), sorted.GetY(), sorted.GetN());
+      return s.Eval(x);
+   };
+
+   EXPECT_DOUBLE_EQ(splineEval(2.3), g.Eval(2.3, nullptr, "S"));
+   EXPECT_DOUBLE_EQ(splineEval(6.1), g.Eval(6.1, nullptr, "S"));
+
+   g.SetPoint(3, 6., 10.);
+   EXPECT_DOUBLE_EQ(splineEval(6.1), g.Eval(6.1, nullptr, "S"));
+
+   g.GetY()[0] = -3.;
+   EXPECT_DOUBLE_EQ(splineEval(8.5), g.Eval(8.5, nullptr, "S"));
+
+   g.SetPoint(10, 12., 1.);
+   EXPECT_DOUBLE_EQ(splineEval(11.), g.Eval(11., nullptr, "S"));
+
+   TGraph copy(g);
+   EXPECT_DOUBLE_EQ(g.Eval(4.4, nullptr, "S"), copy.Eval(4.4, nullptr, "S"));
+}
@@ -1,8 +1,22 @@
 #include "gtest/gtest.h"
 
 #include "TH1.h"
+#include "TH1C.h"
 #include "TH1F.h"
+#include "TH1D.h"
+#include "TH1S.h"
+#include "TH2D.h"
+#include "TH3D.h"
+#include "TList.h"
+#include "TROOT.h"
 #include "THLimitsFinder.h"
+#include "ROOT/TH1ConcurrentFill.hxx"
+
+#include <cmath>
+#include <limits>
+#include <memory>
+#include <thread>
+#include <vector>
 
 // StatOverflows TH1
 TEST(TH1, StatOverflows)
@@ -46,3 +60,194 @@ TEST(THLimitsFinder, Degenerate)
    EXPECT_LE(xmin, centralValue - 5.);
    EXPECT_GE(xmax, centralValue + 5.);
 }
+
+// FillN on an axis of bins of fixed width must give the same contents and statistics as Fill
+TEST(TH1, FillNFixBins)
+{
+   std::vector<double> x, w;
+   for (int i = 0; i < 1000; ++i) {
+      x.push_back(-2. + 0.0137 * i); // in [-2, 11.7), with under- and overflows
+      w.push_back(i % 3 == 0 ? 1. : 0.5 * (i % 7));
+   }
+   x.push_back(std::numeric_limits<double>::quiet_NaN());
+   w.push_back(1.);
+   x.push_back(10.); // the upper edge goes to the overflow bin
+   w.push_back(2.);
+
+   for (auto statOverflows : {TH1::EStatOverflows::kIgnore, TH1::EStatOverflows::kConsider}) {
+      TH1D hFill("hFill", "", 37, 0., 10.);
+      TH1D hFillN("hFillN", "", 37, 0., 10.);
+      TH1D hFillNStride("hFillNStride", "", 37, 0., 10.);
+      hFill.SetStatOverflows(statOverflows);
+      hFillN.SetStatOverflows(statOverflows);
+      hFillNStride.SetStatOverflows(statOverflows);
+
+      std::vector<double> xw; // x and w interleaved
+      for (std::size_t i = 0; i < x.size(); ++i) {
+         hFill.Fill(x[i], w[i]);
+         xw.push_back(x[i]);
+         xw.push_back(w[i]);
+      }
+      hFillN.FillN(x.size(), x.data(), w.data());
+      hFillNStride.FillN(x.size(), xw.data(), xw.data() + 1, 2);
+
+      for (auto *h : {&hFillN, &hFillNStride}) {
+         EXPECT_EQ(hFill.GetEntries(), h->GetEntries());
+         for (int bin = 0; bin <= hFill.GetNbinsX() + 1; ++bin) {
+            EXPECT_DOUBLE_EQ(hFill.GetBinContent(bin), h->GetBinContent(bin));
+            EXPECT_DOUBLE_EQ(hFill.GetBinError(bin), h->GetBinError(bin));
+         }
+         double statsFill[4], stats[4];
+         hFill.GetStats(statsFill);
+         h->GetStats(stats);
+         if (statOverflows == TH1::EStatOverflows::kConsider) {
+            // the NaN entry is part of the statistics
+            EXPECT_TRUE(std::isnan(stats[2]));
+            continue;
+         }
+         // the statistics are summed in another order
+         for (int i = 0; i < 4; ++i)
+            EXPECT_NEAR(statsFill[i], stats[i], 1e-12 * statsFill[i]);
+      }
+   }
+
+   // without weights, the sum of squares of weights is not stored
+   TH1F h("h", "", 10, 0., 1.);
+   std::vector<double> ones(100, 0.5);
+   h.FillN(ones.size(), ones.data(), nullptr);
+   EXPECT_EQ(0, h.GetSumw2N());
+   EXPECT_EQ(100., h.GetBinContent(6));
+   EXPECT_DOUBLE_EQ(0.5, h.GetMean());
+}
+
+// The buffer of a histogram with fixed limits is emptied through DoFillN, for every type of contents
+TEST(TH1, FillNFixBinsBuffer)
+{
+   TH1D hFillD("hFillD", "", 20, -1., 1.);
+   TH1D hBufD("hBufD", "", 20, -1., 1.);
+   TH1S hFillS("hFillS", "", 20, -1., 1.);
+   TH1S hBufS("hBufS", "", 20, -1., 1.);
+   TH1C hFillC("hFillC", "", 20, -1., 1.);
+   TH1C hBufC("hBufC", "", 20, -1., 1.);
+   hBufD.SetBuffer(1000);
+   hBufS.SetBuffer(1000);
+   hBufC.SetBuffer(1000);
+
+   for (int i = 0; i < 500; ++i) {
+      double x = -1.2 + 0.0049 * i;
+      double w = 1. + (i % 4);
+      for (auto *h : {(TH1 *)&hFillD, (TH1 *)&hBufD, (TH1 *)&hFillS, (TH1 *)&hBufS})
+         h->Fill(x, w);
+      hFillC.Fill(x);
+      hBufC.Fill(x);
+   }
+   for (auto *h : {(TH1 *)&hBufD, (TH1 *)&hBufS, (TH1 *)&hBufC})
+      EXPECT_EQ(500, h->BufferEmpty(1)); // the number of entries in the buffer
+
+   for (auto hh : {std::make_pair((TH1 *)&hFillD, (TH1 *)&hBufD), std::make_pair((TH1 *)&hFillS, (TH1 *)&hBufS),
+                   std::make_pair((TH1 *)&hFillC, (TH1 *)&hBufC)}) {
+      EXPECT_EQ(hh.first->GetEntries(), hh.second->GetEntries());
+      EXPECT_EQ(hh.first->GetSumw2N(), hh.second->GetSumw2N());
+      for (int bin = 0; bin <= 21; ++bin) {
+         EXPECT_DOUBLE_EQ(hh.first->GetBinContent(bin), hh.second->GetBinContent(bin));
+         EXPECT_DOUBLE_EQ(hh.first->GetBinError(bin), hh.second->GetBinError(bin));
+      }
+      EXPECT_NEAR(hh.first->GetMean(), hh.second->GetMean(), 1e-12);
+      EXPECT_NEAR(hh.first->GetStdDev(), hh.second->GetStdDev(), 1e-12);
+   }
+}
+
+// TH1ConcurrentFillManager: several threads fill the same histogram through their own buffers
+TEST(TH1ConcurrentFill, Threads)
+{
+   TH2D h("h", "", 10, 0., 10., 10, 0., 10.);
+   TH1D h1("h1", "", 10, 0., 10.);
+   {
+      ROOT::Experimental::TH1ConcurrentFillManager<TH2D> manager(h);
+      ROOT::Experimental::TH1ConcurrentFillManager<TH1D> manager1(h1);
+      std::vector<std::thread> threads;
+      for (int t = 0; t < 4; ++t) {
+         threads.emplace_back([&manager, &manager1, t] {
+            auto filler = manager.MakeFiller(/*bufferSize=*/7);
+            auto filler1 = manager1.MakeFiller(/*bufferSize=*/7);
+            for (int i = 0; i < 100; ++i) {
+               filler.Fill(i % 10 + 0.5, t + 0.5);
+               filler.Fill(i % 10 + 0.5, t + 0.5, 2.); // weighted, in another buffer flush
+               filler1.Fill(i % 10 + 0.5);
+            }
+         });
+      }
+      for (auto &t : threads)
+         t.join();
+   }
+
+   EXPECT_EQ(800., h.GetEntries());
+   EXPECT_EQ(1200., h.Integral()); // 400 entries of weight 1, 400 of weight 2
+   for (int t = 0; t < 4; ++t)
+      EXPECT_EQ(30., h.GetBinContent(5, t + 1));
+   EXPECT_EQ(0., h.GetBinContent(5, 6));
+   EXPECT_EQ(400., h1.GetEntries());
+   EXPECT_EQ(40., h1.GetBinContent(3));
+}
+
+// TH1ConcurrentFillManager: copies of the histogram taken while other threads fill it
+TEST(TH1ConcurrentFill, Snapshot)
+{
+   TH1D h("h", "", 10, 0., 10.);
+   ROOT::Experimental::TH1ConcurrentFillManager<TH1D> manager(h);
+   std::vector<std::thread> threads;
+   for (int t = 0; t < 4; ++t) {
+      threads.emplace_back([&manager] {
+         auto filler = manager.MakeFiller(/*bufferSize=*/3);
+         for (int i = 0; i < 1000; ++i)
+            filler.Fill(i % 10 + 0.5);
+      });
+   }
+   double last = 0.;
+   for (int i = 0; i < 100; ++i) {
+      auto copy = manager.Snapshot();
+      EXPECT_EQ(nullptr, copy->GetDirectory());
+      EXPECT_GE(copy->GetEntries(), last);
+      EXPECT_EQ(copy->GetEntries(), copy->Integral());
+      last = copy->GetEntries();
+   }
+   for (auto &t : threads)
+      t.join();
+   EXPECT_EQ(4000., manager.WithLock([](TH1D &hist) { return hist.GetEntries(); }));
+}
+
+// Merge large histograms with the same axes, concurrently on ranges of bins if IMT is enabled
+TEST(TH1, MergeSameAxes)
+{
+   TH3D h("h", "", 60, 0., 60., 60, 0., 60., 60, 0., 60.);
+   TH3F hf("hf", "", 60, 0., 60., 60, 0., 60., 60, 0., 60.);
+   std::vector<std::unique_ptr<TH3D>> inputs;
+   TList list;
+   for (int i = 0; i < 8; ++i) {
+      inputs.emplace_back(new TH3D(Form("h%d", i), "", 60, 0., 60., 60, 0., 60., 60, 0., 60.));
+      if (i % 2)
+         inputs.back()->Sumw2();
+      for (int j = 0; j < 1000; ++j)
+         inputs.back()->Fill((i + j) % 60 + 0.5, j % 60 + 0.5, j / 60 + 0.5, 1. + i % 2);
+      list.Add(inputs.back().get());
+   }
+
+#ifdef R__USE_IMT
+   ROOT::EnableImplicitMT(4);
+#endif
+   EXPECT_EQ(8000, h.Merge(&list));
+   EXPECT_EQ(8000, hf.Merge(&list));
+#ifdef R__USE_IMT
+   ROOT::DisableImplicitMT();
+#endif
+
+   for (auto *hist : {static_cast<TH1 *>(&h), static_cast<TH1 *>(&hf)}) {
+      EXPECT_DOUBLE_EQ(12000., hist->Integral());
+      EXPECT_NE(0, hist->GetSumw2N());
+      // bin (1, 1, 1) is filled for i = 0 and j = 0, bin (2, 1, 1) for i = 1 and j = 0
+      EXPECT_DOUBLE_EQ(1., hist->GetBinContent(1, 1, 1));
+      EXPECT_DOUBLE_EQ(1., hist->GetBinError(1, 1, 1));
+      EXPECT_DOUBLE_EQ(2., hist->GetBinContent(2, 1, 1));
+      EXPECT_DOUBLE_EQ(2., hist->GetBinError(2, 1, 1));
+   }
+}
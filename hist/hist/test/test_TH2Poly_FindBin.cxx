@@ -0,0 +1,72 @@
+// test TH2Poly finding the bins of points
+
+#include "gtest/gtest.h"
+
+#include "TH2Poly.h"
+#include "TRandom.h"
+
+#include <vector>
+
+TEST(TH2Poly, FindBinHoneycomb)
+{
+   TH2Poly h2p("h2p", "honeycomb", 0., 30., 0., 30.);
+   h2p.Honeycomb(1., 1., 0.5, 25, 25);
+   // bins of very different sizes
+   h2p.AddBin(20., 28., 29., 29.5);
+   h2p.AddBin(25., 25., 25.5, 25.2);
+
+   TRandom r(42);
+   for (int i = 0; i < 10000; ++i) {
+      const Double_t x = r.Uniform(-1., 31.);
+      const Double_t y = r.Uniform(-1., 31.);
+      Int_t expected = -5;
+      if (x > 0. && x <= 30. && y > 0. && y <= 30.) {
+         for (Int_t bin = 0; bin < h2p.GetNumberOfBins(); ++bin) {
+            if (h2p.IsInsideBin(bin, x, y)) {
+               expected = bin + 1;
+               break;
+            }
+         }
+         EXPECT_EQ(expected, h2p.FindBin(x, y)) << x << " " << y;
+      } else {
+         EXPECT_NE(-5, h2p.FindBin(x, y)) << x << " " << y;
+      }
+   }
+
+   // Bins added after a search are found
+   h2p.AddBin(29., 29., 29.9, 29.9);
+   EXPECT_EQ(h2p.GetNumberOfBins(), h2p.FindBin(29.5, 29.5));
+}
+
+TEST(TH2Poly, FindBinsFillN)
+{
+   TH2Poly h2p("h2p", "honeycomb", 0., 20., 0., 20.);
+   h2p.Honeycomb(1., 1., 1., 10, 10);
+   TH2Poly ref("ref", "honeycomb", 0., 20., 0., 20.);
+   ref.Honeycomb(1., 1., 1., 10, 10);
+
+   const Int_t n = 1000;
+   std::vector<Double_t> x(2 * n), y(2 * n), w(2 * n);
+   TRandom r(7);
+   for (Int_t i = 0; i < 2 * n; ++i) {
+      x[i] = r.Uniform(-2., 22.);
+      y[i] = r.Uniform(-2., 22.);
+      w[i] = r.Uniform(0., 2.);
+   }
+
+   std::vector<Int_t> bins(2 * n);
+   h2p.FindBins(2 * n, x.data(), y.data(), bins.data());
+   for (Int_t i = 0; i < 2 * n; ++i)
+      EXPECT_EQ(h2p.FindBin(x[i], y[i]), bins[i]);
+
+   // FillN uses every second point
+   h2p.FillN(n, x.data(), y.data(), w.data(), 2);
+   for (Int_t i = 0; i < 2 * n; i += 2)
+      ref.Fill(x[i], y[i], w[i]);
+   EXPECT_EQ(ref.GetEntries(), h2p.GetEntries());
+   for (Int_t bin = -9; bin <= ref.GetNumberOfBins(); ++bin) {
+      if (bin == 0)
+         continue;
+      EXPECT_DOUBLE_EQ(ref.GetBinContent(bin), h2p.GetBinContent(bin)) << bin;
+   }
+}
@@ -0,0 +1,130 @@
+#include "gtest/gtest.h"
+
+#include "THnSparse.h"
+#include "TList.h"
+#include "TROOT.h"
+
+#include <memory>
+#include <vector>
+
+namespace {
+// 10 axes of 1000 bins: the compact bin coordinates do not fit into 8 bytes.
+std::unique_ptr<THnSparseD> MakeWide(const char *name)
+{
+   std::vector<Int_t> bins(10, 1000);
+   std::vector<Double_t> xmin(10, 0.);
+   std::vector<Double_t> xmax(10, 1000.);
+   return std::make_unique<THnSparseD>(name, name, 10, bins.data(), xmin.data(), xmax.data(), 128);
+}
+
+// Fill 1000 entries, two for each of 500 bins.
+void FillWide(THnSparse &h, Double_t offset)
+{
+   std::vector<Double_t> x(10);
+   for (Int_t i = 0; i < 1000; ++i) {
+      for (Int_t d = 0; d < 10; ++d)
+         x[d] = (i / 2 * (d + 1) + offset) / 10. + 0.5;
+      h.Fill(x.data(), 0.5);
+   }
+}
+} // namespace
+
+TEST(THnSparse, FillN)
+{
+   Int_t bins[2] = {10, 20};
+   Double_t xmin[2] = {0., 0.};
+   Double_t xmax[2] = {10., 20.};
+   THnSparseD h1("h1", "h1", 2, bins, xmin, xmax, 16);
+   THnSparseD h2("h2", "h2", 2, bins, xmin, xmax, 16);
+   h1.Sumw2();
+   h2.Sumw2();
+
+   std::vector<Double_t> x, w;
+   for (Int_t i = 0; i < 300; ++i) {
+      x.push_back(i % 13 - 1.5);
+      x.push_back(i % 23 - 0.5);
+      w.push_back(1. + i % 3);
+      h1.Fill(&x[2 * i], w.back());
+   }
+   h2.FillN(300, x.data(), w.data());
+
+   EXPECT_EQ(h1.GetNbins(), h2.GetNbins());
+   EXPECT_DOUBLE_EQ(h1.GetEntries(), h2.GetEntries());
+   EXPECT_DOUBLE_EQ(h1.GetWeightSum(), h2.GetWeightSum());
+   Int_t coord[2];
+   for (Long64_t bin = 0; bin < h1.GetNbins(); ++bin) {
+      Double_t v = h1.GetBinContent(bin, coord);
+      EXPECT_DOUBLE_EQ(v, h2.GetBinContent(coord));
+      EXPECT_DOUBLE_EQ(h1.GetBinError2(bin), h2.GetBinError2(h2.GetBin(coord)));
+   }
+}
+
+TEST(THnSparse, WideCoordinates)
+{
+   auto h = MakeWide("h");
+   FillWide(*h, 0.);
+   EXPECT_EQ(500, h->GetNbins());
+   EXPECT_DOUBLE_EQ(1000., h->GetEntries());
+
+   std::vector<Int_t> coord(10);
+   for (Long64_t bin = 0; bin < h->GetNbins(); ++bin) {
+      EXPECT_DOUBLE_EQ(1., h->GetBinContent(bin, coord.data()));
+      EXPECT_EQ(bin, h->GetBin(coord.data()));
+   }
+   coord[0] = 999;
+   EXPECT_EQ(-1, static_cast<const THnSparse &>(*h).GetBin(coord.data()));
+}
+
+TEST(THnSparse, Add)
+{
+   auto h1 = MakeWide("h1");
+   auto h2 = MakeWide("h2");
+   FillWide(*h1, 0.);
+   FillWide(*h2, 5000.);
+   h2->Sumw2();
+   FillWide(*h2, 0.);
+   h1->Add(h2.get(), 2.);
+
+   EXPECT_EQ(1000, h1->GetNbins());
+   EXPECT_DOUBLE_EQ(5000., h1->GetEntries());
+   EXPECT_TRUE(h1->GetCalculateErrors());
+   std::vector<Int_t> coord(10);
+   for (Long64_t bin = 0; bin < h2->GetNbins(); ++bin) {
+      Double_t v = h2->GetBinContent(bin, coord.data());
+      Long64_t mybin = h1->GetBin(coord.data());
+      ASSERT_GE(mybin, 0);
+      // the last 500 bins of h2 were filled in h1 too
+      EXPECT_DOUBLE_EQ(1., v);
+      EXPECT_DOUBLE_EQ(bin < 500 ? 2. : 3., h1->GetBinContent(mybin));
+   }
+}
+
+TEST(THnSparse, Merge)
+{
+   auto h = MakeWide("h");
+   auto h1 = MakeWide("h1");
+   auto h2 = MakeWide("h2");
+   FillWide(*h, 0.);
+   FillWide(*h1, 0.);
+   FillWide(*h2, 3000.);
+   TList list;
+   list.Add(h1.get());
+   list.Add(h2.get());
+
+#ifdef R__USE_IMT
+   ROOT::EnableImplicitMT(4);
+#endif
+   EXPECT_EQ(3000, h->Merge(&list));
+#ifdef R__USE_IMT
+   ROOT::DisableImplicitMT();
+#endif
+
+   EXPECT_EQ(1000, h->GetNbins());
+   std::vector<Int_t> coord(10);
+   for (Long64_t bin = 0; bin < h2->GetNbins(); ++bin) {
+      h1->GetBinContent(bin, coord.data());
+      EXPECT_DOUBLE_EQ(2., h->GetBinContent(coord.data()));
+      h2->GetBinContent(bin, coord.data());
+      EXPECT_DOUBLE_EQ(1., h->GetBinContent(coord.data()));
+   }
+}
@@ -2,10 +2,15 @@
 #include "TF1NormSum.h"
 #include "TObjString.h"
 #include "TObjArray.h"
+#include "TH1D.h"
+#include "TFitResult.h"
+#include "TROOT.h"
+#include "Fit/FitUtil.h"
 
 #include "gtest/gtest.h"
 
 #include <iostream>
+#include <vector>
 
 using namespace std;
 
@@ -220,3 +225,54 @@ TEST(TF1, Constructors)
    for (auto tf1 : vtf1)
       EXPECT_EQ(tf1(&x, &p), 2);
 }
+
+TEST(TF1, EvalBatch)
+{
+   TF1 f("gausBatch", "gaus", -5, 5);
+   f.SetParameters(2., 0.5, 1.5);
+   std::vector<double> x(100), out(100);
+   for (std::size_t i = 0; i < x.size(); ++i)
+      x[i] = -5. + 0.1 * i;
+   f.EvalBatch(x.size(), x.data(), f.GetParameters(), out.data());
+   for (std::size_t i = 0; i < x.size(); ++i)
+      EXPECT_DOUBLE_EQ(f.Eval(x[i]), out[i]);
+
+   // functions not defined by a formula are evaluated point by point
+   TF1 g("lambdaBatch", [](double *xx, double *pp) { return pp[0] * xx[0]; }, 0, 1, 1);
+   const double p[] = {3.};
+   g.EvalBatch(x.size(), x.data(), p, out.data());
+   for (std::size_t i = 0; i < x.size(); ++i)
+      EXPECT_DOUBLE_EQ(3. * x[i], out[i]);
+}
+
+// Without the options SERIAL or MULTITHREAD the fits choose the execution policy from the size of the data
+TEST(TF1, FitAutomaticExecutionPolicy)
+{
+   EXPECT_EQ(ROOT::EExecutionPolicy::kSequential, ROOT::Fit::FitUtil::GetAutomaticExecutionPolicy(10));
+
+   TH1D h("hPolicy", "hPolicy", 10000, -5, 5);
+   for (int i = 1; i <= h.GetNbinsX(); ++i) {
+      double x = h.GetBinCenter(i);
+      h.SetBinContent(i, 100 * std::exp(-0.5 * x * x) + 10);
+      h.SetBinError(i, 1);
+   }
+   TF1 f("fPolicy", "gaus(0) + [3]", -5, 5);
+   f.SetParameters(80, 0.5, 2, 5);
+   auto rSerial = h.Fit(&f, "S Q N SERIAL");
+
+#ifdef R__USE_IMT
+   ROOT::EnableImplicitMT(4);
+   if (ROOT::GetThreadPoolSize() > 1) {
+      EXPECT_EQ(ROOT::EExecutionPolicy::kMultiThread, ROOT::Fit::FitUtil::GetAutomaticExecutionPolicy(h.GetNbinsX()));
+   }
+#endif
+   f.SetParameters(80, 0.5, 2, 5);
+   auto rAuto = h.Fit(&f, "S Q N");
+#ifdef R__USE_IMT
+   ROOT::DisableImplicitMT();
+#endif
+
+   ASSERT_EQ(0, rAuto->Status());
+   for (int i = 0; i < 4; ++i)
+      EXPECT_NEAR(rSerial->Parameter(i), rAuto->Parameter(i), 1e-6 * (1 + std::abs(rSerial->Parameter(i))));
+}
@@ -496,4 +496,40 @@ TEST(TKDE, tkde_io_mirror)
    for (size_t i = 0; i < t.xtest.size(); ++i) {
       EXPECT_NEAR(t.values1[i], t.values2[i], delta);
    }
-}
\ No newline at end of file
+}
+/// Fast evaluation tests
+/// In this test we compare the exact estimate with the fast Gauss transform
+/// and the batched evaluation with the pointwise one
+TEST(TKDE, tkde_fast_gauss)
+{
+   TRandom3 r(1111);
+   int n = 100000;
+   std::vector<double> data(n);
+   for (int i = 0; i < n; ++i)
+      data[i] = (r.Rndm() < 0.2) ? r.Gaus(10, 1) : r.Gaus(10, 7);
+
+   TKDE kde(n, data.data(), 0., 20., "KernelType:Gaussian;Iteration:Fixed;Mirror:noMirror;Binning:Unbinned", 1);
+   const int npx = 101;
+   std::vector<double> x(npx), exact(npx), values(npx);
+   for (int i = 0; i < npx; ++i) {
+      x[i] = -5. + 0.3 * i;
+      exact[i] = kde(x[i]);
+   }
+
+   // the batched evaluation gives the same values
+   kde.GetValues(npx, x.data(), values.data());
+   for (int i = 0; i < npx; ++i)
+      EXPECT_EQ(exact[i], values[i]);
+
+   // the error is bounded by the tolerance times the height of a kernel
+   for (double tol : {1.E-3, 1.E-6, 1.E-10}) {
+      kde.SetTolerance(tol);
+      EXPECT_EQ(tol, kde.GetTolerance());
+      double maxError = tol / (std::sqrt(2. * TMath::Pi()) * kde.GetFixedWeight());
+      kde.GetValues(npx, x.data(), values.data());
+      for (int i = 0; i < npx; ++i) {
+         EXPECT_NEAR(exact[i], values[i], maxError);
+         EXPECT_EQ(kde(x[i]), values[i]);
+      }
+   }
+}
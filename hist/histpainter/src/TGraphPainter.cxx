@@ -35,9 +35,12 @@
 #include "TVirtualPadEditor.h"
 #include "TVirtualX.h"
 #include "TRegexp.h"
+#include "TEnv.h"
 #include "strlcpy.h"
 #include "snprintf.h"
 
+#include <vector>
+
 Double_t *gxwork, *gywork, *gxworkl, *gyworkl;
 Int_t TGraphPainter::fgMaxPointsPerLine = 50;
 
@@ -45,6 +48,70 @@ static Int_t    gHighlightPoint  = -1;         // highlight point of graph
 static TGraph  *gHighlightGraph  = nullptr;    // pointer to graph with highlight point
 static TMarker *gHighlightMarker = nullptr;    // highlight marker
 
+////////////////////////////////////////////////////////////////////////////////
+/// True if the polylines and polymarkers with many more points than pixels
+/// are reduced to the resolution of the pad before being painted.
+
+static Bool_t UseLevelOfDetail()
+{
+   return gEnv->GetValue("Hist.LevelOfDetail", 0) != 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Reduce in place the polyline (x,y), in pad coordinates, to at most four points
+/// per run of consecutive points falling in the same pixel column: the first, the
+/// lowest, the highest and the last. The line painted at the resolution of the pad
+/// is unchanged. Return the new number of points.
+
+static Int_t DecimatePolyLine(Int_t n, Double_t *x, Double_t *y)
+{
+   Int_t nout = 0;
+   Int_t first = 0;
+   while (first < n) {
+      Int_t column = gPad->XtoAbsPixel(x[first]);
+      Int_t last = first, imin = first, imax = first;
+      while (last+1 < n && gPad->XtoAbsPixel(x[last+1]) == column) {
+         last++;
+         if (y[last] < y[imin]) imin = last;
+         if (y[last] > y[imax]) imax = last;
+      }
+      Int_t keep[4] = {first, TMath::Min(imin, imax), TMath::Max(imin, imax), last};
+      for (Int_t k = 0; k < 4; k++) {
+         if (k > 0 && keep[k] == keep[k-1]) continue;
+         x[nout] = x[keep[k]];
+         y[nout] = y[keep[k]];
+         nout++;
+      }
+      first = last+1;
+   }
+   return nout;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Remove in place the markers (x,y), in pad coordinates, falling on the same
+/// pixel as a previous one: they paint the same pixels. Return the new number
+/// of markers.
+
+static Int_t DecimatePolyMarker(Int_t n, Double_t *x, Double_t *y)
+{
+   const Int_t nx = gPad->GetWw()+1;
+   const Int_t ny = gPad->GetWh()+1;
+   std::vector<Bool_t> used(nx*ny, kFALSE);
+   Int_t nout = 0;
+   for (Int_t i = 0; i < n; i++) {
+      Int_t px = gPad->XtoAbsPixel(x[i]);
+      Int_t py = gPad->YtoAbsPixel(y[i]);
+      if (px >= 0 && px < nx && py >= 0 && py < ny) {
+         if (used[py*nx+px]) continue;
+         used[py*nx+px] = kTRUE;
+      }
+      x[nout] = x[i];
+      y[nout] = y[i];
+      nout++;
+   }
+   return nout;
+}
+
 ClassImp(TGraphPainter);
 
 
@@ -67,6 +134,7 @@ ClassImp(TGraphPainter);
 - [Reverse graphs' axis](\ref GP06)
 - [Graphs in logarithmic scale](\ref GP07)
 - [Highlight mode for graph](\ref GP08)
+- [Graphs with millions of points](\ref GP09)
 
 
 \anchor GP00
@@ -644,6 +712,26 @@ NOTE all parameters of user function are taken from
 
 For more complex demo please see for example `$ROOTSYS/tutorials/math/hlquantiles.C` file.
 
+\anchor GP09
+### Graphs with millions of points
+
+A graph is painted with one polyline or polymarker of all its points, whatever
+the number of pixels available. With the level of detail mode, enabled in `.rootrc`
+with:
+
+    Hist.LevelOfDetail: true
+
+or with `gEnv->SetValue("Hist.LevelOfDetail", 1)`, the points are reduced to the
+resolution of the pad before being painted:
+
+  - the line (option "L") keeps, for each run of consecutive points in the same
+    pixel column, the first, the lowest, the highest and the last point,
+  - the markers (option "P") falling on a pixel already holding one are dropped.
+
+This does not change the picture at the resolution of the pad, and the PostScript,
+PDF and SVG files shrink accordingly. The same setting reduces the number of boxes
+of the 2D histograms drawn with option "COL", see THistPainter.
+
 */
 
 
@@ -1471,7 +1559,9 @@ void TGraphPainter::PaintGraph(TGraph *theGraph, Int_t npoints, const Double_t *
                }
                if (optionLine) {
                   if (TMath::Abs(theGraph->GetLineWidth())>99) PaintPolyLineHatches(theGraph, npt, gyworkl, gxworkl);
-                  gPad->PaintPolyLine(npt,gyworkl,gxworkl);
+                  Int_t nline = npt;
+                  if (npt > 4*(Int_t)gPad->GetWw() && UseLevelOfDetail()) nline = DecimatePolyLine(npt, gyworkl, gxworkl);
+                  gPad->PaintPolyLine(nline,gyworkl,gxworkl);
                }
             } else {
                if (optionFill) {
@@ -1480,7 +1570,9 @@ void TGraphPainter::PaintGraph(TGraph *theGraph, Int_t npoints, const Double_t *
                }
                if (optionLine) {
                   if (TMath::Abs(theGraph->GetLineWidth())>99) PaintPolyLineHatches(theGraph, npt, gxworkl, gyworkl);
-                  gPad->PaintPolyLine(npt,gxworkl,gyworkl);
+                  Int_t nline = npt;
+                  if (npt > 4*(Int_t)gPad->GetWw() && UseLevelOfDetail()) nline = DecimatePolyLine(npt, gxworkl, gyworkl);
+                  gPad->PaintPolyLine(nline,gxworkl,gyworkl);
                }
             }
             gxwork[0] = gxwork[npt-1];  gywork[0] = gywork[npt-1];
@@ -1579,6 +1671,10 @@ void TGraphPainter::PaintGraph(TGraph *theGraph, Int_t npoints, const Double_t *
          npt++;
          if (i == npoints) {
             ComputeLogs(npt, optionZ);
+            if (npt > 1000 && UseLevelOfDetail()) {
+               if (optionR) npt = DecimatePolyMarker(npt, gyworkl, gxworkl);
+               else         npt = DecimatePolyMarker(npt, gxworkl, gyworkl);
+            }
             if (optionR) gPad->PaintPolyMarker(npt,gyworkl,gxworkl);
             else         gPad->PaintPolyMarker(npt,gxworkl,gyworkl);
             npt = 0;
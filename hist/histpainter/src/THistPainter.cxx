@@ -1200,6 +1200,19 @@ COL2 option renders the histogram as a bitmap. Therefore it cannot be saved in v
 graphics file format like PostScript or PDF (an empty image will be generated). It can
 be saved only in bitmap files like PNG format for instance.
 
+When a histogram has many more bins than there are pixels to draw it, the COL
+option can also reduce the number of boxes to the resolution of the pad. This
+level of detail mode is enabled in `.rootrc` with:
+
+    Hist.LevelOfDetail: true
+
+or with `gEnv->SetValue("Hist.LevelOfDetail", 1)`. Each box then covers a cell of
+as many bins as there are per pixel along each axis, colored with the mean content
+of the bins of the cell. Unlike COL2, the result is still made of vector graphics,
+but the PostScript, PDF or SVG files shrink with the number of boxes. The mode
+applies to cartesian coordinates only. The same setting decimates the lines
+and markers of the graphs with millions of points, see TGraphPainter.
+
 
 \anchor HP140
 ### The CANDLE and VIOLIN options
@@ -5813,29 +5826,56 @@ void THistPainter::PaintColorLevels(Option_t*)
 
    Int_t color;
    TProfile2D* prof2d = dynamic_cast<TProfile2D*>(fH);
-   for (Int_t j=Hparam.yfirst; j<=Hparam.ylast;j++) {
+
+   // Content of bin (i,j), return kFALSE if the bin is not drawn
+   auto binContent = [&](Int_t i, Int_t j, Double_t &zbin) {
+      Int_t bin = j*(fXaxis->GetNbins()+2) + i;
+      Double_t xbin = fXaxis->GetBinLowEdge(i);
+      if (Hoption.System == kPOLAR && xbin<0) xbin= 2*TMath::Pi()+xbin;
+      if (!IsInside(xbin+0.5*fXaxis->GetBinWidth(i),fYaxis->GetBinCenter(j))) return kFALSE;
+      zbin = fH->GetBinContent(bin);
+      // if fH is a profile histogram do not draw empty bins
+      if (prof2d) return prof2d->GetBinEntries(bin) != 0;
+      // don't draw the empty bins for non-profile histograms
+      // with positive content
+      if (zbin == 0) {
+         if (zmin >= 0 || Hoption.Logz) return kFALSE;
+         if (Hoption.Color == 2) return kFALSE;
+      }
+      return kTRUE;
+   };
+
+   // Level of detail: with several bins per pixel, draw one box per cell of
+   // lodx*lody bins, painted with the mean content of its drawn bins
+   Int_t lodx = 1, lody = 1;
+   if (Hoption.System == kCARTESIAN && gEnv->GetValue("Hist.LevelOfDetail", 0)) {
+      Int_t npx = TMath::Abs(gPad->XtoAbsPixel(gPad->GetUxmax()) - gPad->XtoAbsPixel(gPad->GetUxmin()));
+      Int_t npy = TMath::Abs(gPad->YtoAbsPixel(gPad->GetUymax()) - gPad->YtoAbsPixel(gPad->GetUymin()));
+      if (npx > 0) lodx = TMath::Max(1, (Hparam.xlast-Hparam.xfirst+1)/npx);
+      if (npy > 0) lody = TMath::Max(1, (Hparam.ylast-Hparam.yfirst+1)/npy);
+   }
+
+   for (Int_t j=Hparam.yfirst; j<=Hparam.ylast;j+=lody) {
+      Int_t jlast = TMath::Min(j+lody-1, Hparam.ylast);
       yk    = fYaxis->GetBinLowEdge(j);
-      ystep = fYaxis->GetBinWidth(j);
-      for (Int_t i=Hparam.xfirst; i<=Hparam.xlast;i++) {
-         Int_t bin  = j*(fXaxis->GetNbins()+2) + i;
+      ystep = fYaxis->GetBinUpEdge(jlast) - yk;
+      for (Int_t i=Hparam.xfirst; i<=Hparam.xlast;i+=lodx) {
+         Int_t ilast = TMath::Min(i+lodx-1, Hparam.xlast);
          xk    = fXaxis->GetBinLowEdge(i);
-         xstep = fXaxis->GetBinWidth(i);
+         xstep = fXaxis->GetBinUpEdge(ilast) - xk;
          if (Hoption.System == kPOLAR && xk<0) xk= 2*TMath::Pi()+xk;
-         if (!IsInside(xk+0.5*xstep,yk+0.5*ystep)) continue;
-         z     = fH->GetBinContent(bin);
-         // if fH is a profile histogram do not draw empty bins
-         if (prof2d) {
-            const Double_t binEntries = prof2d->GetBinEntries(bin);
-            if (binEntries == 0)
-               continue;
-         } else {
-            // don't draw the empty bins for non-profile histograms
-            // with positive content
-            if (z == 0) {
-               if (zmin >= 0 || Hoption.Logz) continue;
-               if (Hoption.Color == 2) continue;
+         Int_t ndrawn = 0;
+         z = 0;
+         for (Int_t jj=j; jj<=jlast; jj++) {
+            for (Int_t ii=i; ii<=ilast; ii++) {
+               Double_t zbin;
+               if (!binContent(ii, jj, zbin)) continue;
+               z += zbin;
+               ndrawn++;
             }
          }
+         if (ndrawn == 0) continue;
+         z /= ndrawn;
 
          if (Hoption.Logz) {
             if (z > 0) z = TMath::Log10(z);
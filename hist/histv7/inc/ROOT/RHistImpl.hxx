@@ -19,6 +19,8 @@
 #include <cassert>
 #include <cctype>
 #include <functional>
+#include <tuple>
+#include <utility>
 #include "ROOT/RSpan.hxx"
 #include "ROOT/RTupleApply.hxx"
 
@@ -706,6 +708,47 @@ struct RLocalBinsToCoords {
    }
 };
 
+/// Finds the local bin index of a coordinate on an axis of type `AXIS` if it is
+/// a regular bin, for the fast path of `RHistImpl::FillN()`. Returns `0` for
+/// under- and overflows, which need the full bin computation. `FindBin()` is
+/// final for the concrete axis types, the call is resolved at compile time.
+template <class AXIS>
+class RRegularBinFinder {
+   const AXIS &fAxis;
+
+public:
+   explicit RRegularBinFinder(const AXIS &axis) : fAxis(axis) {}
+
+   int operator()(double x) const
+   {
+      const int bin = fAxis.FindBin(x);
+      return bin > 0 ? bin : 0;
+   }
+};
+
+/// Equidistant axes: the bin is computed from cached limits, without going
+/// through the virtual `CanGrow()` of `RAxisBase::AdjustOverflowBinNumber()`.
+template <>
+class RRegularBinFinder<RAxisEquidistant> {
+   double fLow;
+   double fInvBinWidth;
+   double fNBinsNoOver;
+
+public:
+   explicit RRegularBinFinder(const RAxisEquidistant &axis)
+      : fLow(axis.GetMinimum()), fInvBinWidth(axis.GetInverseBinWidth()), fNBinsNoOver(axis.GetNBinsNoOver())
+   {
+   }
+
+   int operator()(double x) const
+   {
+      const double rawbin = (x - fLow) * fInvBinWidth;
+      if (rawbin >= 0. && rawbin < fNBinsNoOver)
+         return (int)rawbin + 1;
+      return 0;
+   }
+};
+
 template <class... AXISCONFIG>
 static std::array<const RAxisBase *, sizeof...(AXISCONFIG)> GetAxisView(const AXISCONFIG &... axes) noexcept
 {
@@ -1058,9 +1101,7 @@ public:
       }
 #endif
 
-      for (size_t i = 0; i < xN.size(); ++i) {
-         Fill(xN[i], weightN[i]);
-      }
+      FillNImpl(xN, [&weightN](size_t i) { return weightN[i]; }, std::index_sequence_for<AXISCONFIG...>());
    }
 
    /// Fill an array of `weightN` to the bins specified by coordinates `xN`.
@@ -1068,8 +1109,37 @@ public:
    /// at the coordinate `xN[i]`
    void FillN(const std::span<const CoordArray_t> xN) final
    {
-      for (auto &&x: xN) {
-         Fill(x);
+      FillNImpl(xN, [](size_t) { return (Weight_t)1; }, std::index_sequence_for<AXISCONFIG...>());
+   }
+
+   /// Implementation of `FillN()`: the regular bins are computed directly from
+   /// the bins found on each axis, with search objects specialized on the axis
+   /// types (see `Internal::RRegularBinFinder`). Only under- and overflows go
+   /// through `GetBinIndexAndGrow()`.
+   template <class WEIGHTS, std::size_t... I>
+   void FillNImpl(const std::span<const CoordArray_t> xN, WEIGHTS weights, std::index_sequence<I...>)
+   {
+      constexpr int kNDim = DATA::GetNDim();
+      const std::tuple<Internal::RRegularBinFinder<AXISCONFIG>...> finders{
+         Internal::RRegularBinFinder<AXISCONFIG>(std::get<I>(fAxes))...};
+      const std::array<int, kNDim> nBins{{std::get<I>(fAxes).GetNBinsNoOver()...}};
+      std::array<int, kNDim> strides;
+      strides[0] = 1;
+      for (int d = 1; d < kNDim; ++d)
+         strides[d] = strides[d - 1] * nBins[d - 1];
+
+      for (size_t i = 0; i < xN.size(); ++i) {
+         const CoordArray_t &x = xN[i];
+         const std::array<int, kNDim> localBins{{std::get<I>(finders)(x[I])...}};
+         int bin = 1;
+         for (int d = 0; d < kNDim; ++d) {
+            if (localBins[d] == 0) {
+               bin = GetBinIndexAndGrow(x);
+               break;
+            }
+            bin += (localBins[d] - 1) * strides[d];
+         }
+         this->GetStat().Fill(x, bin, weights(i));
       }
    }
 
@@ -629,3 +629,36 @@ TEST(HistFillTest, FillN3DCoordsWeightsUncertainty)
    EXPECT_FLOAT_EQ(std::sqrt(weight2 * weight2), hist.GetBinUncertainty({0.2222, 4.33, 7.11}));
    EXPECT_FLOAT_EQ(std::sqrt((weight3 * weight3) + (weight2 * weight2)), hist.GetBinUncertainty({0.3333, 4.11, 7.22}));
 }
+
+// Test that FillN() fills the same bins as Fill(), including under- and overflows, for all the axis types
+TEST(HistFillTest, FillNSameAsFill)
+{
+   using ROOT::Experimental::RAxisConfig;
+   const RAxisConfig xaxis(20, 0., 1.);
+   const RAxisConfig yaxis(std::vector<double>{-1., 0., 0.5, 2., 5.});
+   ROOT::Experimental::RH2D histFill(xaxis, yaxis);
+   ROOT::Experimental::RH2D histFillN(xaxis, yaxis);
+
+   std::vector<ROOT::Experimental::RH2D::CoordArray_t> coords;
+   std::vector<double> weights;
+   for (int i = 0; i < 500; ++i) {
+      coords.push_back({-0.2 + 0.0029 * i, -1.5 + 0.0137 * i});
+      weights.push_back(0.5 + 0.01 * i);
+   }
+   coords.push_back({std::nan(""), 1.});
+   weights.push_back(2.);
+
+   for (std::size_t i = 0; i < coords.size(); ++i)
+      histFill.Fill(coords[i], weights[i]);
+   histFillN.FillN(coords, weights);
+
+   const auto &implFill = *histFill.GetImpl();
+   const auto &implFillN = *histFillN.GetImpl();
+   for (int bin = -implFill.GetNOverflowBins(); bin <= implFill.GetNBinsNoOver(); ++bin) {
+      if (bin == 0)
+         continue;
+      EXPECT_DOUBLE_EQ(implFill.GetBinContent(bin), implFillN.GetBinContent(bin)) << "bin " << bin;
+      EXPECT_DOUBLE_EQ(implFill.GetBinUncertainty(bin), implFillN.GetBinUncertainty(bin)) << "bin " << bin;
+   }
+   EXPECT_EQ(histFill.GetEntries(), histFillN.GetEntries());
+}
@@ -13,6 +13,8 @@
 
 #include "TNamed.h"
 
+#include <vector>
+
 class TH1;
 
 class TSpectrum : public TNamed {
@@ -72,6 +74,10 @@ public:
    Int_t               SearchHighRes(Double_t *source,Double_t *destVector, Int_t ssize,Double_t sigma, Double_t threshold,bool backgroundRemove,Int_t deconIterations,bool markov, Int_t averWindow);
    Int_t               Search1HighRes(Double_t *source,Double_t *destVector, Int_t ssize,Double_t sigma, Double_t threshold,bool backgroundRemove,Int_t deconIterations,bool markov, Int_t averWindow);
 
+   // batch processing of many spectra of the same size, e.g. the channels of a detector
+   const char         *Background(Double_t **spectra, Int_t nspectra, Int_t ssize,Int_t numberIterations,Int_t direction, Int_t filterOrder,bool smoothing,Int_t smoothWindow,bool compton);
+   Int_t               SearchHighRes(Double_t **source,Double_t **destVector, Int_t nspectra, Int_t ssize,Double_t sigma, Double_t threshold,bool backgroundRemove,Int_t deconIterations,bool markov, Int_t averWindow, std::vector<std::vector<Double_t>> &positions);
+
    static Int_t        StaticSearch(const TH1 *hist, Double_t sigma=2, Option_t *option="goff", Double_t threshold=0.05);
    static TH1         *StaticBackground(const TH1 *hist,Int_t niter=20, Option_t *option="");
 
@@ -8,6 +8,7 @@
 #include "TH1.h"
 #include "TMath.h"
 #include "snprintf.h"
+#include "TSpectrumKernels.h"
 
 /** \class TSpectrum
     \ingroup Spectrum
@@ -538,16 +539,10 @@ const char *TSpectrum::Background(Double_t *spectrum, int ssize,
       i = numberIterations;
    if (filterOrder == kBackOrder2) {
       do{
-         for (j = i; j < ssize - i; j++) {
-            if (smoothing == kFALSE){
-               a = working_space[ssize + j];
-               b = (working_space[ssize + j - i] + working_space[ssize + j + i]) / 2.0;
-               if (b < a)
-                  a = b;
-               working_space[j] = a;
-            }
-
-            else if (smoothing == kTRUE){
+         if (smoothing == kFALSE)
+            ROOT::Internal::Spectrum::ClipSNIP(working_space + ssize, working_space, i, ssize - i, i);
+         else {
+            for (j = i; j < ssize - i; j++) {
                a = working_space[ssize + j];
                av = 0;
                men = 0;
@@ -1468,10 +1463,10 @@ const char *TSpectrum::Deconvolution(Double_t *source, const Double_t *response,
       return "Wrong Parameters";
 
        //   working_space-pointer to the working vector
-       //   (its size must be 4*ssize of source spectrum)
-   Double_t *working_space = new Double_t[4 * ssize];
-   int i, j, k, lindex, posit, lh_gold, l, repet;
-   Double_t lda, ldb, ldc, area, maximum;
+       //   (its size must be 5*ssize of source spectrum)
+   Double_t *working_space = new Double_t[5 * ssize];
+   int i, j, lindex, posit, lh_gold, repet, m1, m2, mboth;
+   Double_t lda, ldb, area, maximum;
    area = 0;
    lh_gold = -1;
    posit = 0;
@@ -1500,26 +1495,8 @@ const char *TSpectrum::Deconvolution(Double_t *source, const Double_t *response,
 
 // create matrix at*a and vector at*y
    for (i = 0; i < ssize; i++){
-      lda = 0;
-      for (j = 0; j < ssize; j++){
-         ldb = working_space[j];
-         k = i + j;
-         if (k < ssize){
-            ldc = working_space[k];
-            lda = lda + ldb * ldc;
-         }
-      }
-      working_space[ssize + i] = lda;
-      lda = 0;
-      for (k = 0; k < ssize; k++){
-         l = k - i;
-         if (l >= 0){
-            ldb = working_space[l];
-            ldc = working_space[2 * ssize + k];
-            lda = lda + ldb * ldc;
-         }
-      }
-      working_space[3 * ssize + i]=lda;
+      working_space[ssize + i] = ROOT::Internal::Spectrum::DotProduct(working_space, working_space + i, ssize - i);
+      working_space[3 * ssize + i] = ROOT::Internal::Spectrum::DotProduct(working_space, working_space + 2 * ssize + i, ssize - i);
    }
 
 // move vector at*y
@@ -1538,26 +1515,25 @@ const char *TSpectrum::Deconvolution(Double_t *source, const Double_t *response,
             working_space[i] = TMath::Power(working_space[i], boost);
       }
       for (lindex = 0; lindex < numberIterations; lindex++) {
+         // the resulting vector in reverse order, such that the terms at i-j are contiguous as well
+         for (i = 0; i < ssize; i++)
+            working_space[4 * ssize + i] = working_space[ssize - 1 - i];
          for (i = 0; i < ssize; i++) {
             if (working_space[2 * ssize + i] > 0.000001
                  && working_space[i] > 0.000001) {
-               lda = 0;
-               for (j = 0; j < lh_gold; j++) {
-                  ldb = working_space[j + ssize];
-                  if (j != 0){
-                     k = i + j;
-                     ldc = 0;
-                     if (k < ssize)
-                        ldc = working_space[k];
-                     k = i - j;
-                     if (k >= 0)
-                        ldc += working_space[k];
-                  }
-
-                  else
-                     ldc = working_space[i];
-                  lda = lda + ldb * ldc;
-               }
+               // sum over j < lh_gold of at*a[j] * (x[i+j] + x[i-j]), the terms out of the spectrum being 0
+               m1 = TMath::Min(lh_gold - 1, ssize - 1 - i);
+               m2 = TMath::Min(lh_gold - 1, i);
+               mboth = TMath::Min(m1, m2);
+               lda = working_space[ssize] * working_space[i];
+               lda = ROOT::Internal::Spectrum::DotProductSum(working_space + ssize + 1, working_space + i + 1,
+                                                             working_space + 5 * ssize - i, mboth, lda);
+               if (m1 > mboth)
+                  lda = ROOT::Internal::Spectrum::DotProduct(working_space + ssize + 1 + mboth, working_space + i + 1 + mboth,
+                                                             m1 - mboth, lda);
+               else if (m2 > mboth)
+                  lda = ROOT::Internal::Spectrum::DotProduct(working_space + ssize + 1 + mboth, working_space + 5 * ssize - i + mboth,
+                                                             m2 - mboth, lda);
                ldb = working_space[2 * ssize + i];
                if (lda != 0)
                   lda = ldb / lda;
@@ -2132,7 +2108,7 @@ Int_t TSpectrum::SearchHighRes(Double_t *source,Double_t *destVector, int ssize,
    int i, j, numberIterations = (Int_t)(7 * sigma + 0.5);
    Double_t a, b, c;
    int k, lindex, posit, imin, imax, jmin, jmax, lh_gold, priz;
-   Double_t lda, ldb, ldc, area, maximum, maximum_decon;
+   Double_t lda, ldb, area, maximum, maximum_decon;
    int xmin, xmax, l, peak_index = 0, size_ext = ssize + 2 * numberIterations, shift = numberIterations, bw = 2, w;
    Double_t maxch;
    Double_t nom, nip, nim, sp, sm, plocha = 0;
@@ -2212,17 +2188,10 @@ Int_t TSpectrum::SearchHighRes(Double_t *source,Double_t *destVector, int ssize,
 
    if(backgroundRemove == true){
       for(i = 1; i <= numberIterations; i++){
-         for(j = i; j < size_ext - i; j++){
-            if(markov == false){
-               a = working_space[size_ext + j];
-               b = (working_space[size_ext + j - i] + working_space[size_ext + j + i]) / 2.0;
-               if(b < a)
-                  a = b;
-
-               working_space[j]=a;
-            }
-
-            else{
+         if(markov == false)
+            ROOT::Internal::Spectrum::ClipSNIP(working_space + size_ext, working_space, i, size_ext - i, i);
+         else{
+            for(j = i; j < size_ext - i; j++){
                a = working_space[size_ext + j];
                av = 0;
                men = 0;
@@ -2357,13 +2326,7 @@ Int_t TSpectrum::SearchHighRes(Double_t *source,Double_t *destVector, int ssize,
       }
       if(backgroundRemove == true){
          for(i = 1; i <= numberIterations; i++){
-            for(j = i; j < size_ext - i; j++){
-               a = working_space[size_ext + j];
-               b = (working_space[size_ext + j - i] + working_space[size_ext + j + i]) / 2.0;
-               if(b < a)
-                  a = b;
-               working_space[j] = a;
-            }
+            ROOT::Internal::Spectrum::ClipSNIP(working_space + size_ext, working_space, i, size_ext - i, i);
             for(j = i; j < size_ext - i; j++)
                working_space[size_ext + j] = working_space[j];
          }
@@ -2411,27 +2374,16 @@ Int_t TSpectrum::SearchHighRes(Double_t *source,Double_t *destVector, int ssize,
       if(jmax > (lh_gold - 1))
          jmax = lh_gold - 1;
 
-      for(j = jmin;j <= jmax; j++){
-         ldb = working_space[j];
-         ldc = working_space[i + j];
-         lda = lda + ldb * ldc;
-      }
+      lda = ROOT::Internal::Spectrum::DotProduct(working_space + jmin, working_space + i + jmin, jmax - jmin + 1);
       working_space[size_ext + i - imin] = lda;
    }
 //create vector p
    i = lh_gold - 1;
    imin = -i,imax = size_ext + i - 1;
    for(i = imin; i <= imax; i++){
-      lda = 0;
-      for(j = 0; j <= (lh_gold - 1); j++){
-         ldb = working_space[j];
-         k = i + j;
-         if(k >= 0 && k < size_ext){
-            ldc = working_space[2 * size_ext + k];
-            lda = lda + ldb * ldc;
-         }
-
-      }
+      jmin = TMath::Max(0, -i);
+      jmax = TMath::Min(lh_gold - 1, size_ext - 1 - i);
+      lda = ROOT::Internal::Spectrum::DotProduct(working_space + jmin, working_space + 2 * size_ext + i + jmin, jmax - jmin + 1);
       working_space[4 * size_ext + i - imin] = lda;
    }
 //move vector p
@@ -2454,11 +2406,8 @@ Int_t TSpectrum::SearchHighRes(Double_t *source,Double_t *destVector, int ssize,
             if(jmax > (size_ext - 1 - i))
                jmax=size_ext-1-i;
 
-            for(j = jmin; j <= jmax; j++){
-               ldb = working_space[j + lh_gold - 1 + size_ext];
-               ldc = working_space[i + j];
-               lda = lda + ldb * ldc;
-            }
+            lda = ROOT::Internal::Spectrum::DotProduct(working_space + jmin + lh_gold - 1 + size_ext, working_space + i + jmin,
+                                                       jmax - jmin + 1);
             ldb = working_space[2 * size_ext + i];
             if(lda != 0)
                lda = ldb / lda;
@@ -2557,6 +2506,65 @@ Int_t TSpectrum::SearchHighRes(Double_t *source,Double_t *destVector, int ssize,
    return fNPeaks;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Background estimation of nspectra spectra of ssize channels each, see
+/// Background(Double_t *, Int_t, Int_t, Int_t, Int_t, bool, Int_t, bool) for the meaning of the parameters.
+/// The spectra are processed on the implicit multi-threading pool if it is enabled.
+/// On successful completion it returns 0, otherwise the first error message encountered
+/// (the spectra with wrong parameters are left unchanged).
+
+const char *TSpectrum::Background(Double_t **spectra, Int_t nspectra, Int_t ssize,
+                                  Int_t numberIterations,
+                                  Int_t direction, Int_t filterOrder,
+                                  bool smoothing, Int_t smoothWindow,
+                                  bool compton)
+{
+   if (nspectra <= 0)
+      return "Wrong Parameters";
+   // Background does not use the data members: it can run concurrently on distinct spectra
+   std::vector<const char *> errors(nspectra, nullptr);
+   ROOT::Internal::Spectrum::ForEach(0, nspectra, (Long64_t)ssize * numberIterations, [&](Int_t i) {
+      errors[i] = Background(spectra[i], ssize, numberIterations, direction, filterOrder, smoothing, smoothWindow,
+                             compton);
+   });
+   for (auto error : errors) {
+      if (error)
+         return error;
+   }
+   return 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Peak search in nspectra spectra of ssize channels each, see
+/// SearchHighRes(Double_t *, Double_t *, Int_t, Double_t, Double_t, bool, Int_t, bool, Int_t)
+/// for the meaning of the parameters. The deconvolved spectra are written to destVector[i]
+/// and the positions of the peaks found in spectrum i to positions[i], at most fMaxPeaks
+/// per spectrum. The spectra are processed on the implicit multi-threading pool if it is enabled.
+/// The peak positions of this object (GetPositionX) are not changed.
+/// It returns the total number of peaks found.
+
+Int_t TSpectrum::SearchHighRes(Double_t **source, Double_t **destVector, Int_t nspectra, Int_t ssize,
+                               Double_t sigma, Double_t threshold,
+                               bool backgroundRemove, Int_t deconIterations,
+                               bool markov, Int_t averWindow,
+                               std::vector<std::vector<Double_t>> &positions)
+{
+   positions.assign(TMath::Max(nspectra, 0), std::vector<Double_t>());
+   if (nspectra <= 0)
+      return 0;
+   // one finder per spectrum, holding the peak positions of its spectrum
+   ROOT::Internal::Spectrum::ForEach(0, nspectra, (Long64_t)ssize * (deconIterations + 1), [&](Int_t i) {
+      TSpectrum spectrum(fMaxPeaks);
+      const Int_t npeaks = spectrum.SearchHighRes(source[i], destVector[i], ssize, sigma, threshold, backgroundRemove,
+                                                  deconIterations, markov, averWindow);
+      positions[i].assign(spectrum.GetPositionX(), spectrum.GetPositionX() + npeaks);
+   });
+   Int_t npeaks = 0;
+   for (const auto &peaks : positions)
+      npeaks += peaks.size();
+   return npeaks;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Old name of SearcHighRes introduced for back compatibility.
 /// This function will be removed after the June 2006 release
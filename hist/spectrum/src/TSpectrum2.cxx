@@ -44,6 +44,7 @@
 #include "TList.h"
 #include "TH1.h"
 #include "TMath.h"
+#include "TSpectrumKernels.h"
 #define PEAK_WINDOW 1024
 
 Int_t TSpectrum2::fgIterations    = 3;
@@ -371,8 +372,7 @@ const char *TSpectrum2::Background(Double_t **spectrum,
                        Int_t direction,
                        Int_t filterType)
 {
-   Int_t i, x, y, sampling, r1, r2;
-   Double_t a, b, p1, p2, p3, p4, s1, s2, s3, s4;
+   Int_t i, sampling, r1, r2;
    if (ssizex <= 0 || ssizey <= 0)
       return "Wrong parameters";
    if (numberIterationsX < 1 || numberIterationsY < 1)
@@ -385,151 +385,75 @@ const char *TSpectrum2::Background(Double_t **spectrum,
       working_space[i] = new Double_t[ssizey];
    sampling =
        (Int_t) TMath::Max(numberIterationsX, numberIterationsY);
-   if (direction == kBackIncreasingWindow) {
-      if (filterType == kBackSuccessiveFiltering) {
-         for (i = 1; i <= sampling; i++) {
-            r1 = (Int_t) TMath::Min(i, numberIterationsX), r2 =
-                (Int_t) TMath::Min(i, numberIterationsY);
-            for (y = r2; y < ssizey - r2; y++) {
-               for (x = r1; x < ssizex - r1; x++) {
-                  a = spectrum[x][y];
-                  p1 = spectrum[x - r1][y - r2];
-                  p2 = spectrum[x - r1][y + r2];
-                  p3 = spectrum[x + r1][y - r2];
-                  p4 = spectrum[x + r1][y + r2];
-                  s1 = spectrum[x][y - r2];
-                  s2 = spectrum[x - r1][y];
-                  s3 = spectrum[x + r1][y];
-                  s4 = spectrum[x][y + r2];
-                  b = (p1 + p2) / 2.0;
-                  if (b > s2)
-                     s2 = b;
-                  b = (p1 + p3) / 2.0;
-                  if (b > s1)
-                     s1 = b;
-                  b = (p2 + p4) / 2.0;
-                  if (b > s4)
-                     s4 = b;
-                  b = (p3 + p4) / 2.0;
-                  if (b > s3)
-                     s3 = b;
-                  s1 = s1 - (p1 + p3) / 2.0;
-                  s2 = s2 - (p1 + p2) / 2.0;
-                  s3 = s3 - (p3 + p4) / 2.0;
-                  s4 = s4 - (p2 + p4) / 2.0;
-                  b = (s1 + s4) / 2.0 + (s2 + s3) / 2.0 + (p1 + p2 +
-                                                            p3 +
-                                                            p4) / 4.0;
-                  if (b < a && b > 0)
-                     a = b;
-                  working_space[x][y] = a;
-               }
-            }
-            for (y = r2; y < ssizey - r2; y++) {
-               for (x = r1; x < ssizex - r1; x++) {
-                  spectrum[x][y] = working_space[x][y];
-               }
-            }
-         }
-      }
-
-      else if (filterType == kBackOneStepFiltering) {
-         for (i = 1; i <= sampling; i++) {
-            r1 = (Int_t) TMath::Min(i, numberIterationsX), r2 =
-                (Int_t) TMath::Min(i, numberIterationsY);
-            for (y = r2; y < ssizey - r2; y++) {
-               for (x = r1; x < ssizex - r1; x++) {
-                  a = spectrum[x][y];
-                  b = -(spectrum[x - r1][y - r2] +
-                         spectrum[x - r1][y + r2] + spectrum[x + r1][y -
-                                                                     r2]
-                         + spectrum[x + r1][y + r2]) / 4 +
-                      (spectrum[x][y - r2] + spectrum[x - r1][y] +
-                       spectrum[x + r1][y] + spectrum[x][y + r2]) / 2;
-                  if (b < a && b > 0)
-                     a = b;
-                  working_space[x][y] = a;
-               }
+   if ((direction != kBackIncreasingWindow && direction != kBackDecreasingWindow) ||
+       (filterType != kBackSuccessiveFiltering && filterType != kBackOneStepFiltering))
+      sampling = 0;
+   for (Int_t step = 0; step < sampling; step++) {
+      i = (direction == kBackIncreasingWindow) ? step + 1 : sampling - step;
+      r1 = (Int_t) TMath::Min(i, numberIterationsX), r2 =
+          (Int_t) TMath::Min(i, numberIterationsY);
+      // within a step the new value of each channel only depends on the old ones: the rows are independent
+      ROOT::Internal::Spectrum::ForEach(r1, ssizex - r1, ssizey - 2 * r2, [&](Int_t x) {
+         Double_t a, b, p1, p2, p3, p4, s1, s2, s3, s4;
+         if (filterType == kBackSuccessiveFiltering) {
+            for (Int_t y = r2; y < ssizey - r2; y++) {
+               a = spectrum[x][y];
+               p1 = spectrum[x - r1][y - r2];
+               p2 = spectrum[x - r1][y + r2];
+               p3 = spectrum[x + r1][y - r2];
+               p4 = spectrum[x + r1][y + r2];
+               s1 = spectrum[x][y - r2];
+               s2 = spectrum[x - r1][y];
+               s3 = spectrum[x + r1][y];
+               s4 = spectrum[x][y + r2];
+               b = (p1 + p2) / 2.0;
+               if (b > s2)
+                  s2 = b;
+               b = (p1 + p3) / 2.0;
+               if (b > s1)
+                  s1 = b;
+               b = (p2 + p4) / 2.0;
+               if (b > s4)
+                  s4 = b;
+               b = (p3 + p4) / 2.0;
+               if (b > s3)
+                  s3 = b;
+               s1 = s1 - (p1 + p3) / 2.0;
+               s2 = s2 - (p1 + p2) / 2.0;
+               s3 = s3 - (p3 + p4) / 2.0;
+               s4 = s4 - (p2 + p4) / 2.0;
+               b = (s1 + s4) / 2.0 + (s2 + s3) / 2.0 + (p1 + p2 +
+                                                      p3 +
+                                                      p4) / 4.0;
+               if (b < a && b > 0)
+                  a = b;
+               working_space[x][y] = a;
             }
-            for (y = i; y < ssizey - i; y++) {
-               for (x = i; x < ssizex - i; x++) {
-                  spectrum[x][y] = working_space[x][y];
-               }
+         } else {
+            for (Int_t y = r2; y < ssizey - r2; y++) {
+               a = spectrum[x][y];
+               b = -(spectrum[x - r1][y - r2] +
+                      spectrum[x - r1][y + r2] + spectrum[x + r1][y -
+                                                                  r2]
+                      + spectrum[x + r1][y + r2]) / 4 +
+                   (spectrum[x][y - r2] + spectrum[x - r1][y] +
+                    spectrum[x + r1][y] + spectrum[x][y + r2]) / 2;
+               if (b < a && b > 0)
+                  a = b;
+               working_space[x][y] = a;
             }
          }
-      }
-   }
-
-   else if (direction == kBackDecreasingWindow) {
+      });
       if (filterType == kBackSuccessiveFiltering) {
-         for (i = sampling; i >= 1; i--) {
-            r1 = (Int_t) TMath::Min(i, numberIterationsX), r2 =
-                (Int_t) TMath::Min(i, numberIterationsY);
-            for (y = r2; y < ssizey - r2; y++) {
-               for (x = r1; x < ssizex - r1; x++) {
-                  a = spectrum[x][y];
-                  p1 = spectrum[x - r1][y - r2];
-                  p2 = spectrum[x - r1][y + r2];
-                  p3 = spectrum[x + r1][y - r2];
-                  p4 = spectrum[x + r1][y + r2];
-                  s1 = spectrum[x][y - r2];
-                  s2 = spectrum[x - r1][y];
-                  s3 = spectrum[x + r1][y];
-                  s4 = spectrum[x][y + r2];
-                  b = (p1 + p2) / 2.0;
-                  if (b > s2)
-                     s2 = b;
-                  b = (p1 + p3) / 2.0;
-                  if (b > s1)
-                     s1 = b;
-                  b = (p2 + p4) / 2.0;
-                  if (b > s4)
-                     s4 = b;
-                  b = (p3 + p4) / 2.0;
-                  if (b > s3)
-                     s3 = b;
-                  s1 = s1 - (p1 + p3) / 2.0;
-                  s2 = s2 - (p1 + p2) / 2.0;
-                  s3 = s3 - (p3 + p4) / 2.0;
-                  s4 = s4 - (p2 + p4) / 2.0;
-                  b = (s1 + s4) / 2.0 + (s2 + s3) / 2.0 + (p1 + p2 +
-                                                            p3 +
-                                                            p4) / 4.0;
-                  if (b < a && b > 0)
-                     a = b;
-                  working_space[x][y] = a;
-               }
-            }
-            for (y = r2; y < ssizey - r2; y++) {
-               for (x = r1; x < ssizex - r1; x++) {
-                  spectrum[x][y] = working_space[x][y];
-               }
+         for (Int_t x = r1; x < ssizex - r1; x++) {
+            for (Int_t y = r2; y < ssizey - r2; y++) {
+               spectrum[x][y] = working_space[x][y];
             }
          }
-      }
-
-      else if (filterType == kBackOneStepFiltering) {
-         for (i = sampling; i >= 1; i--) {
-            r1 = (Int_t) TMath::Min(i, numberIterationsX), r2 =
-                (Int_t) TMath::Min(i, numberIterationsY);
-            for (y = r2; y < ssizey - r2; y++) {
-               for (x = r1; x < ssizex - r1; x++) {
-                  a = spectrum[x][y];
-                  b = -(spectrum[x - r1][y - r2] +
-                         spectrum[x - r1][y + r2] + spectrum[x + r1][y -
-                                                                     r2]
-                         + spectrum[x + r1][y + r2]) / 4 +
-                      (spectrum[x][y - r2] + spectrum[x - r1][y] +
-                       spectrum[x + r1][y] + spectrum[x][y + r2]) / 2;
-                  if (b < a && b > 0)
-                     a = b;
-                  working_space[x][y] = a;
-               }
-            }
-            for (y = i; y < ssizey - i; y++) {
-               for (x = i; x < ssizex - i; x++) {
-                  spectrum[x][y] = working_space[x][y];
-               }
+      } else {
+         for (Int_t x = i; x < ssizex - i; x++) {
+            for (Int_t y = i; y < ssizey - i; y++) {
+               spectrum[x][y] = working_space[x][y];
             }
          }
       }
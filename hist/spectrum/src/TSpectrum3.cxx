@@ -48,6 +48,7 @@
 #include "TSpectrum3.h"
 #include "TH1.h"
 #include "TMath.h"
+#include "TSpectrumKernels.h"
 #define PEAK_WINDOW 1024
 
 ClassImp(TSpectrum3);
@@ -389,8 +390,7 @@ const char *TSpectrum3::Background(Double_t***spectrum,
                        Int_t direction,
                        Int_t filterType)
 {
-   Int_t i, j, x, y, z, sampling, q1, q2, q3;
-   Double_t a, b, c, d, p1, p2, p3, p4, p5, p6, p7, p8, s1, s2, s3, s4, s5, s6, s7, s8, s9, s10, s11, s12, r1, r2, r3, r4, r5, r6;
+   Int_t i, j, sampling, q1, q2, q3;
    if (ssizex <= 0 || ssizey <= 0 || ssizez <= 0)
       return "Wrong parameters";
    if (numberIterationsX < 1 || numberIterationsY < 1 || numberIterationsZ < 1)
@@ -405,353 +405,167 @@ const char *TSpectrum3::Background(Double_t***spectrum,
    }
    sampling =(Int_t) TMath::Max(numberIterationsX, numberIterationsY);
    sampling =(Int_t) TMath::Max(sampling, numberIterationsZ);
-   if (direction == kBackIncreasingWindow) {
-      if (filterType == kBackSuccessiveFiltering) {
-         for (i = 1; i <= sampling; i++) {
-            q1 = (Int_t) TMath::Min(i, numberIterationsX), q2 =(Int_t) TMath::Min(i, numberIterationsY), q3 =(Int_t) TMath::Min(i, numberIterationsZ);
-            for (z = q3; z < ssizez - q3; z++) {
-               for (y = q2; y < ssizey - q2; y++) {
-                  for (x = q1; x < ssizex - q1; x++) {
-                     a = spectrum[x][y][z];
-                     p1 = spectrum[x + q1][y + q2][z - q3];
-                     p2 = spectrum[x - q1][y + q2][z - q3];
-                     p3 = spectrum[x + q1][y - q2][z - q3];
-                     p4 = spectrum[x - q1][y - q2][z - q3];
-                     p5 = spectrum[x + q1][y + q2][z + q3];
-                     p6 = spectrum[x - q1][y + q2][z + q3];
-                     p7 = spectrum[x + q1][y - q2][z + q3];
-                     p8 = spectrum[x - q1][y - q2][z + q3];
-                     s1 = spectrum[x + q1][y     ][z - q3];
-                     s2 = spectrum[x     ][y + q2][z - q3];
-                     s3 = spectrum[x - q1][y     ][z - q3];
-                     s4 = spectrum[x     ][y - q2][z - q3];
-                     s5 = spectrum[x + q1][y     ][z + q3];
-                     s6 = spectrum[x     ][y + q2][z + q3];
-                     s7 = spectrum[x - q1][y     ][z + q3];
-                     s8 = spectrum[x     ][y - q2][z + q3];
-                     s9 = spectrum[x - q1][y + q2][z     ];
-                     s10 = spectrum[x - q1][y - q2][z     ];
-                     s11 = spectrum[x + q1][y + q2][z     ];
-                     s12 = spectrum[x + q1][y - q2][z     ];
-                     r1 = spectrum[x     ][y     ][z - q3];
-                     r2 = spectrum[x     ][y     ][z + q3];
-                     r3 = spectrum[x - q1][y     ][z     ];
-                     r4 = spectrum[x + q1][y     ][z     ];
-                     r5 = spectrum[x     ][y + q2][z     ];
-                     r6 = spectrum[x     ][y - q2][z     ];
-                     b = (p1 + p3) / 2.0;
-                     if(b > s1)
-                        s1 = b;
-                     b = (p1 + p2) / 2.0;
-                     if(b > s2)
-                        s2 = b;
-                     b = (p2 + p4) / 2.0;
-                     if(b > s3)
-                        s3 = b;
-                     b = (p3 + p4) / 2.0;
-                     if(b > s4)
-                        s4 = b;
-                     b = (p5 + p7) / 2.0;
-                     if(b > s5)
-                        s5 = b;
-                     b = (p5 + p6) / 2.0;
-                     if(b > s6)
-                        s6 = b;
-                     b = (p6 + p8) / 2.0;
-                     if(b > s7)
-                        s7 = b;
-                     b = (p7 + p8) / 2.0;
-                     if(b > s8)
-                        s8 = b;
-                     b = (p2 + p6) / 2.0;
-                     if(b > s9)
-                        s9 = b;
-                     b = (p4 + p8) / 2.0;
-                     if(b > s10)
-                        s10 = b;
-                     b = (p1 + p5) / 2.0;
-                     if(b > s11)
-                        s11 = b;
-                     b = (p3 + p7) / 2.0;
-                     if(b > s12)
-                        s12 = b;
-                     s1 = s1 - (p1 + p3) / 2.0;
-                     s2 = s2 - (p1 + p2) / 2.0;
-                     s3 = s3 - (p2 + p4) / 2.0;
-                     s4 = s4 - (p3 + p4) / 2.0;
-                     s5 = s5 - (p5 + p7) / 2.0;
-                     s6 = s6 - (p5 + p6) / 2.0;
-                     s7 = s7 - (p6 + p8) / 2.0;
-                     s8 = s8 - (p7 + p8) / 2.0;
-                     s9 = s9 - (p2 + p6) / 2.0;
-                     s10 = s10 - (p4 + p8) / 2.0;
-                     s11 = s11 - (p1 + p5) / 2.0;
-                     s12 = s12 - (p3 + p7) / 2.0;
-                     b = (s1 + s3) / 2.0 + (s2 + s4) / 2.0 + (p1 + p2 + p3 + p4) / 4.0;
-                     if(b > r1)
-                        r1 = b;
-                     b = (s5 + s7) / 2.0 + (s6 + s8) / 2.0 + (p5 + p6 + p7 + p8) / 4.0;
-                     if(b > r2)
-                        r2 = b;
-                     b = (s3 + s7) / 2.0 + (s9 + s10) / 2.0 + (p2 + p4 + p6 + p8) / 4.0;
-                     if(b > r3)
-                        r3 = b;
-                     b = (s1 + s5) / 2.0 + (s11 + s12) / 2.0 + (p1 + p3 + p5 + p7) / 4.0;
-                     if(b > r4)
-                        r4 = b;
-                     b = (s9 + s11) / 2.0 + (s2 + s6) / 2.0 + (p1 + p2 + p5 + p6) / 4.0;
-                     if(b > r5)
-                        r5 = b;
-                     b = (s4 + s8) / 2.0 + (s10 + s12) / 2.0 + (p3 + p4 + p7 + p8) / 4.0;
-                     if(b > r6)
-                        r6 = b;
-                     r1 = r1 - ((s1 + s3) / 2.0 + (s2 + s4) / 2.0 + (p1 + p2 + p3 + p4) / 4.0);
-                     r2 = r2 - ((s5 + s7) / 2.0 + (s6 + s8) / 2.0 + (p5 + p6 + p7 + p8) / 4.0);
-                     r3 = r3 - ((s3 + s7) / 2.0 + (s9 + s10) / 2.0 + (p2 + p4 + p6 + p8) / 4.0);
-                     r4 = r4 - ((s1 + s5) / 2.0 + (s11 + s12) / 2.0 + (p1 + p3 + p5 + p7) / 4.0);
-                     r5 = r5 - ((s9 + s11) / 2.0 + (s2 + s6) / 2.0 + (p1 + p2 + p5 + p6) / 4.0);
-                     r6 = r6 - ((s4 + s8) / 2.0 + (s10 + s12) / 2.0 + (p3 + p4 + p7 + p8) / 4.0);
-                     b = (r1 + r2) / 2.0 + (r3 + r4) / 2.0 + (r5 + r6) / 2.0 + (s1 + s3 + s5 + s7) / 4.0 + (s2 + s4 + s6 + s8) / 4.0 + (s9 + s10 + s11 + s12) / 4.0 + (p1 + p2 + p3 + p4 + p5 + p6 + p7 + p8) / 8.0;
-                     if(b < a)
-                        a = b;
-                     working_space[x][y][z] = a;
-                  }
-               }
-            }
-            for (z = q3; z < ssizez - q3; z++) {
-               for (y = q2; y < ssizey - q2; y++) {
-                  for (x = q1; x < ssizex - q1; x++) {
-                     spectrum[x][y][z] = working_space[x][y][z];
-                  }
-               }
-            }
-         }
-      }
-
-      else if (filterType == kBackOneStepFiltering) {
-         for (i = 1; i <= sampling; i++) {
-            q1 = (Int_t) TMath::Min(i, numberIterationsX), q2 =(Int_t) TMath::Min(i, numberIterationsY), q3 =(Int_t) TMath::Min(i, numberIterationsZ);
-            for (z = q3; z < ssizez - q3; z++) {
-               for (y = q2; y < ssizey - q2; y++) {
-                  for (x = q1; x < ssizex - q1; x++) {
-                     a = spectrum[x][y][z];
-                     p1 = spectrum[x + q1][y + q2][z - q3];
-                     p2 = spectrum[x - q1][y + q2][z - q3];
-                     p3 = spectrum[x + q1][y - q2][z - q3];
-                     p4 = spectrum[x - q1][y - q2][z - q3];
-                     p5 = spectrum[x + q1][y + q2][z + q3];
-                     p6 = spectrum[x - q1][y + q2][z + q3];
-                     p7 = spectrum[x + q1][y - q2][z + q3];
-                     p8 = spectrum[x - q1][y - q2][z + q3];
-                     s1 = spectrum[x + q1][y     ][z - q3];
-                     s2 = spectrum[x     ][y + q2][z - q3];
-                     s3 = spectrum[x - q1][y     ][z - q3];
-                     s4 = spectrum[x     ][y - q2][z - q3];
-                     s5 = spectrum[x + q1][y     ][z + q3];
-                     s6 = spectrum[x     ][y + q2][z + q3];
-                     s7 = spectrum[x - q1][y     ][z + q3];
-                     s8 = spectrum[x     ][y - q2][z + q3];
-                     s9 = spectrum[x - q1][y + q2][z     ];
-                     s10 = spectrum[x - q1][y - q2][z     ];
-                     s11 = spectrum[x + q1][y + q2][z     ];
-                     s12 = spectrum[x + q1][y - q2][z     ];
-                     r1 = spectrum[x     ][y     ][z - q3];
-                     r2 = spectrum[x     ][y     ][z + q3];
-                     r3 = spectrum[x - q1][y     ][z     ];
-                     r4 = spectrum[x + q1][y     ][z     ];
-                     r5 = spectrum[x     ][y + q2][z     ];
-                     r6 = spectrum[x     ][y - q2][z     ];
-                     b=(p1 + p2 + p3 + p4 + p5 + p6 + p7 + p8) / 8 - (s1 + s2 + s3 + s4 + s5 + s6 + s7 + s8 + s9 + s10 + s11 + s12) / 4 + (r1 + r2 + r3 + r4 + r5 + r6) / 2;
-                     c = -(s1 + s2 + s3 + s4 + s5 + s6 + s7 + s8 + s9 + s10 + s11 + s12) / 4 + (r1 + r2 + r3 + r4 + r5 + r6) / 2;
-                     d = -(p1 + p2 + p3 + p4 + p5 + p6 + p7 + p8) / 8 + (s1 + s2 + s3 + s4 + s5 + s6 + s7 + s8 + s9 + s10 + s11 + s12) / 12;
-                     if(b < a && b >= 0 && c >=0 && d >= 0)
-                        a = b;
-                     working_space[x][y][z] = a;
-                  }
-               }
-            }
-            for (z = q3; z < ssizez - q3; z++) {
-               for (y = q2; y < ssizey - q2; y++) {
-                  for (x = q1; x < ssizex - q1; x++) {
-                     spectrum[x][y][z] = working_space[x][y][z];
-                  }
-               }
-            }
-         }
-      }
-   }
-
-   else if (direction == kBackDecreasingWindow) {
-      if (filterType == kBackSuccessiveFiltering) {
-         for (i = sampling; i >= 1; i--) {
-            q1 = (Int_t) TMath::Min(i, numberIterationsX), q2 =(Int_t) TMath::Min(i, numberIterationsY), q3 =(Int_t) TMath::Min(i, numberIterationsZ);
-            for (z = q3; z < ssizez - q3; z++) {
-               for (y = q2; y < ssizey - q2; y++) {
-                  for (x = q1; x < ssizex - q1; x++) {
-                     a = spectrum[x][y][z];
-                     p1 = spectrum[x + q1][y + q2][z - q3];
-                     p2 = spectrum[x - q1][y + q2][z - q3];
-                     p3 = spectrum[x + q1][y - q2][z - q3];
-                     p4 = spectrum[x - q1][y - q2][z - q3];
-                     p5 = spectrum[x + q1][y + q2][z + q3];
-                     p6 = spectrum[x - q1][y + q2][z + q3];
-                     p7 = spectrum[x + q1][y - q2][z + q3];
-                     p8 = spectrum[x - q1][y - q2][z + q3];
-                     s1 = spectrum[x + q1][y     ][z - q3];
-                     s2 = spectrum[x     ][y + q2][z - q3];
-                     s3 = spectrum[x - q1][y     ][z - q3];
-                     s4 = spectrum[x     ][y - q2][z - q3];
-                     s5 = spectrum[x + q1][y     ][z + q3];
-                     s6 = spectrum[x     ][y + q2][z + q3];
-                     s7 = spectrum[x - q1][y     ][z + q3];
-                     s8 = spectrum[x     ][y - q2][z + q3];
-                     s9 = spectrum[x - q1][y + q2][z     ];
-                     s10 = spectrum[x - q1][y - q2][z     ];
-                     s11 = spectrum[x + q1][y + q2][z     ];
-                     s12 = spectrum[x + q1][y - q2][z     ];
-                     r1 = spectrum[x     ][y     ][z - q3];
-                     r2 = spectrum[x     ][y     ][z + q3];
-                     r3 = spectrum[x - q1][y     ][z     ];
-                     r4 = spectrum[x + q1][y     ][z     ];
-                     r5 = spectrum[x     ][y + q2][z     ];
-                     r6 = spectrum[x     ][y - q2][z     ];
-                     b = (p1 + p3) / 2.0;
-                     if(b > s1)
-                        s1 = b;
-                     b = (p1 + p2) / 2.0;
-                     if(b > s2)
-                        s2 = b;
-                     b = (p2 + p4) / 2.0;
-                     if(b > s3)
-                        s3 = b;
-                     b = (p3 + p4) / 2.0;
-                     if(b > s4)
-                        s4 = b;
-                     b = (p5 + p7) / 2.0;
-                     if(b > s5)
-                        s5 = b;
-                     b = (p5 + p6) / 2.0;
-                     if(b > s6)
-                        s6 = b;
-                     b = (p6 + p8) / 2.0;
-                     if(b > s7)
-                        s7 = b;
-                     b = (p7 + p8) / 2.0;
-                     if(b > s8)
-                        s8 = b;
-                     b = (p2 + p6) / 2.0;
-                     if(b > s9)
-                        s9 = b;
-                     b = (p4 + p8) / 2.0;
-                     if(b > s10)
-                        s10 = b;
-                     b = (p1 + p5) / 2.0;
-                     if(b > s11)
-                        s11 = b;
-                     b = (p3 + p7) / 2.0;
-                     if(b > s12)
-                        s12 = b;
-                     s1 = s1 - (p1 + p3) / 2.0;
-                     s2 = s2 - (p1 + p2) / 2.0;
-                     s3 = s3 - (p2 + p4) / 2.0;
-                     s4 = s4 - (p3 + p4) / 2.0;
-                     s5 = s5 - (p5 + p7) / 2.0;
-                     s6 = s6 - (p5 + p6) / 2.0;
-                     s7 = s7 - (p6 + p8) / 2.0;
-                     s8 = s8 - (p7 + p8) / 2.0;
-                     s9 = s9 - (p2 + p6) / 2.0;
-                     s10 = s10 - (p4 + p8) / 2.0;
-                     s11 = s11 - (p1 + p5) / 2.0;
-                     s12 = s12 - (p3 + p7) / 2.0;
-                     b = (s1 + s3) / 2.0 + (s2 + s4) / 2.0 + (p1 + p2 + p3 + p4) / 4.0;
-                     if(b > r1)
-                        r1 = b;
-                     b = (s5 + s7) / 2.0 + (s6 + s8) / 2.0 + (p5 + p6 + p7 + p8) / 4.0;
-                     if(b > r2)
-                        r2 = b;
-                     b = (s3 + s7) / 2.0 + (s9 + s10) / 2.0 + (p2 + p4 + p6 + p8) / 4.0;
-                     if(b > r3)
-                        r3 = b;
-                     b = (s1 + s5) / 2.0 + (s11 + s12) / 2.0 + (p1 + p3 + p5 + p7) / 4.0;
-                     if(b > r4)
-                        r4 = b;
-                     b = (s9 + s11) / 2.0 + (s2 + s6) / 2.0 + (p1 + p2 + p5 + p6) / 4.0;
-                     if(b > r5)
-                        r5 = b;
-                     b = (s4 + s8) / 2.0 + (s10 + s12) / 2.0 + (p3 + p4 + p7 + p8) / 4.0;
-                     if(b > r6)
-                        r6 = b;
-                     r1 = r1 - ((s1 + s3) / 2.0 + (s2 + s4) / 2.0 + (p1 + p2 + p3 + p4) / 4.0);
-                     r2 = r2 - ((s5 + s7) / 2.0 + (s6 + s8) / 2.0 + (p5 + p6 + p7 + p8) / 4.0);
-                     r3 = r3 - ((s3 + s7) / 2.0 + (s9 + s10) / 2.0 + (p2 + p4 + p6 + p8) / 4.0);
-                     r4 = r4 - ((s1 + s5) / 2.0 + (s11 + s12) / 2.0 + (p1 + p3 + p5 + p7) / 4.0);
-                     r5 = r5 - ((s9 + s11) / 2.0 + (s2 + s6) / 2.0 + (p1 + p2 + p5 + p6) / 4.0);
-                     r6 = r6 - ((s4 + s8) / 2.0 + (s10 + s12) / 2.0 + (p3 + p4 + p7 + p8) / 4.0);
-                     b = (r1 + r2) / 2.0 + (r3 + r4) / 2.0 + (r5 + r6) / 2.0 + (s1 + s3 + s5 + s7) / 4.0 + (s2 + s4 + s6 + s8) / 4.0 + (s9 + s10 + s11 + s12) / 4.0 + (p1 + p2 + p3 + p4 + p5 + p6 + p7 + p8) / 8.0;
-                     if(b < a)
-                        a = b;
-                     working_space[x][y][z] = a;
-                  }
+   if ((direction != kBackIncreasingWindow && direction != kBackDecreasingWindow) ||
+       (filterType != kBackSuccessiveFiltering && filterType != kBackOneStepFiltering))
+      sampling = 0;
+   for (Int_t step = 0; step < sampling; step++) {
+      i = (direction == kBackIncreasingWindow) ? step + 1 : sampling - step;
+      q1 = (Int_t) TMath::Min(i, numberIterationsX), q2 =(Int_t) TMath::Min(i, numberIterationsY), q3 =(Int_t) TMath::Min(i, numberIterationsZ);
+      // within a step the new value of each channel only depends on the old ones: the planes are independent
+      ROOT::Internal::Spectrum::ForEach(q1, ssizex - q1, (Long64_t)(ssizey - 2 * q2) * (ssizez - 2 * q3), [&](Int_t x) {
+         Double_t a, b, c, d, p1, p2, p3, p4, p5, p6, p7, p8, s1, s2, s3, s4, s5, s6, s7, s8, s9, s10, s11, s12, r1, r2, r3, r4, r5, r6;
+         if (filterType == kBackSuccessiveFiltering) {
+            for (Int_t y = q2; y < ssizey - q2; y++) {
+               for (Int_t z = q3; z < ssizez - q3; z++) {
+                  a = spectrum[x][y][z];
+                  p1 = spectrum[x + q1][y + q2][z - q3];
+                  p2 = spectrum[x - q1][y + q2][z - q3];
+                  p3 = spectrum[x + q1][y - q2][z - q3];
+                  p4 = spectrum[x - q1][y - q2][z - q3];
+                  p5 = spectrum[x + q1][y + q2][z + q3];
+                  p6 = spectrum[x - q1][y + q2][z + q3];
+                  p7 = spectrum[x + q1][y - q2][z + q3];
+                  p8 = spectrum[x - q1][y - q2][z + q3];
+                  s1 = spectrum[x + q1][y     ][z - q3];
+                  s2 = spectrum[x     ][y + q2][z - q3];
+                  s3 = spectrum[x - q1][y     ][z - q3];
+                  s4 = spectrum[x     ][y - q2][z - q3];
+                  s5 = spectrum[x + q1][y     ][z + q3];
+                  s6 = spectrum[x     ][y + q2][z + q3];
+                  s7 = spectrum[x - q1][y     ][z + q3];
+                  s8 = spectrum[x     ][y - q2][z + q3];
+                  s9 = spectrum[x - q1][y + q2][z     ];
+                  s10 = spectrum[x - q1][y - q2][z     ];
+                  s11 = spectrum[x + q1][y + q2][z     ];
+                  s12 = spectrum[x + q1][y - q2][z     ];
+                  r1 = spectrum[x     ][y     ][z - q3];
+                  r2 = spectrum[x     ][y     ][z + q3];
+                  r3 = spectrum[x - q1][y     ][z     ];
+                  r4 = spectrum[x + q1][y     ][z     ];
+                  r5 = spectrum[x     ][y + q2][z     ];
+                  r6 = spectrum[x     ][y - q2][z     ];
+                  b = (p1 + p3) / 2.0;
+                  if(b > s1)
+                     s1 = b;
+                  b = (p1 + p2) / 2.0;
+                  if(b > s2)
+                     s2 = b;
+                  b = (p2 + p4) / 2.0;
+                  if(b > s3)
+                     s3 = b;
+                  b = (p3 + p4) / 2.0;
+                  if(b > s4)
+                     s4 = b;
+                  b = (p5 + p7) / 2.0;
+                  if(b > s5)
+                     s5 = b;
+                  b = (p5 + p6) / 2.0;
+                  if(b > s6)
+                     s6 = b;
+                  b = (p6 + p8) / 2.0;
+                  if(b > s7)
+                     s7 = b;
+                  b = (p7 + p8) / 2.0;
+                  if(b > s8)
+                     s8 = b;
+                  b = (p2 + p6) / 2.0;
+                  if(b > s9)
+                     s9 = b;
+                  b = (p4 + p8) / 2.0;
+                  if(b > s10)
+                     s10 = b;
+                  b = (p1 + p5) / 2.0;
+                  if(b > s11)
+                     s11 = b;
+                  b = (p3 + p7) / 2.0;
+                  if(b > s12)
+                     s12 = b;
+                  s1 = s1 - (p1 + p3) / 2.0;
+                  s2 = s2 - (p1 + p2) / 2.0;
+                  s3 = s3 - (p2 + p4) / 2.0;
+                  s4 = s4 - (p3 + p4) / 2.0;
+                  s5 = s5 - (p5 + p7) / 2.0;
+                  s6 = s6 - (p5 + p6) / 2.0;
+                  s7 = s7 - (p6 + p8) / 2.0;
+                  s8 = s8 - (p7 + p8) / 2.0;
+                  s9 = s9 - (p2 + p6) / 2.0;
+                  s10 = s10 - (p4 + p8) / 2.0;
+                  s11 = s11 - (p1 + p5) / 2.0;
+                  s12 = s12 - (p3 + p7) / 2.0;
+                  b = (s1 + s3) / 2.0 + (s2 + s4) / 2.0 + (p1 + p2 + p3 + p4) / 4.0;
+                  if(b > r1)
+                     r1 = b;
+                  b = (s5 + s7) / 2.0 + (s6 + s8) / 2.0 + (p5 + p6 + p7 + p8) / 4.0;
+                  if(b > r2)
+                     r2 = b;
+                  b = (s3 + s7) / 2.0 + (s9 + s10) / 2.0 + (p2 + p4 + p6 + p8) / 4.0;
+                  if(b > r3)
+                     r3 = b;
+                  b = (s1 + s5) / 2.0 + (s11 + s12) / 2.0 + (p1 + p3 + p5 + p7) / 4.0;
+                  if(b > r4)
+                     r4 = b;
+                  b = (s9 + s11) / 2.0 + (s2 + s6) / 2.0 + (p1 + p2 + p5 + p6) / 4.0;
+                  if(b > r5)
+                     r5 = b;
+                  b = (s4 + s8) / 2.0 + (s10 + s12) / 2.0 + (p3 + p4 + p7 + p8) / 4.0;
+                  if(b > r6)
+                     r6 = b;
+                  r1 = r1 - ((s1 + s3) / 2.0 + (s2 + s4) / 2.0 + (p1 + p2 + p3 + p4) / 4.0);
+                  r2 = r2 - ((s5 + s7) / 2.0 + (s6 + s8) / 2.0 + (p5 + p6 + p7 + p8) / 4.0);
+                  r3 = r3 - ((s3 + s7) / 2.0 + (s9 + s10) / 2.0 + (p2 + p4 + p6 + p8) / 4.0);
+                  r4 = r4 - ((s1 + s5) / 2.0 + (s11 + s12) / 2.0 + (p1 + p3 + p5 + p7) / 4.0);
+                  r5 = r5 - ((s9 + s11) / 2.0 + (s2 + s6) / 2.0 + (p1 + p2 + p5 + p6) / 4.0);
+                  r6 = r6 - ((s4 + s8) / 2.0 + (s10 + s12) / 2.0 + (p3 + p4 + p7 + p8) / 4.0);
+                  b = (r1 + r2) / 2.0 + (r3 + r4) / 2.0 + (r5 + r6) / 2.0 + (s1 + s3 + s5 + s7) / 4.0 + (s2 + s4 + s6 + s8) / 4.0 + (s9 + s10 + s11 + s12) / 4.0 + (p1 + p2 + p3 + p4 + p5 + p6 + p7 + p8) / 8.0;
+                  if(b < a)
+                     a = b;
+                  working_space[x][y][z] = a;
                }
             }
-            for (z = q3; z < ssizez - q3; z++) {
-               for (y = q2; y < ssizey - q2; y++) {
-                  for (x = q1; x < ssizex - q1; x++) {
-                     spectrum[x][y][z] = working_space[x][y][z];
-                  }
+         } else {
+            for (Int_t y = q2; y < ssizey - q2; y++) {
+               for (Int_t z = q3; z < ssizez - q3; z++) {
+                  a = spectrum[x][y][z];
+                  p1 = spectrum[x + q1][y + q2][z - q3];
+                  p2 = spectrum[x - q1][y + q2][z - q3];
+                  p3 = spectrum[x + q1][y - q2][z - q3];
+                  p4 = spectrum[x - q1][y - q2][z - q3];
+                  p5 = spectrum[x + q1][y + q2][z + q3];
+                  p6 = spectrum[x - q1][y + q2][z + q3];
+                  p7 = spectrum[x + q1][y - q2][z + q3];
+                  p8 = spectrum[x - q1][y - q2][z + q3];
+                  s1 = spectrum[x + q1][y     ][z - q3];
+                  s2 = spectrum[x     ][y + q2][z - q3];
+                  s3 = spectrum[x - q1][y     ][z - q3];
+                  s4 = spectrum[x     ][y - q2][z - q3];
+                  s5 = spectrum[x + q1][y     ][z + q3];
+                  s6 = spectrum[x     ][y + q2][z + q3];
+                  s7 = spectrum[x - q1][y     ][z + q3];
+                  s8 = spectrum[x     ][y - q2][z + q3];
+                  s9 = spectrum[x - q1][y + q2][z     ];
+                  s10 = spectrum[x - q1][y - q2][z     ];
+                  s11 = spectrum[x + q1][y + q2][z     ];
+                  s12 = spectrum[x + q1][y - q2][z     ];
+                  r1 = spectrum[x     ][y     ][z - q3];
+                  r2 = spectrum[x     ][y     ][z + q3];
+                  r3 = spectrum[x - q1][y     ][z     ];
+                  r4 = spectrum[x + q1][y     ][z     ];
+                  r5 = spectrum[x     ][y + q2][z     ];
+                  r6 = spectrum[x     ][y - q2][z     ];
+                  b=(p1 + p2 + p3 + p4 + p5 + p6 + p7 + p8) / 8 - (s1 + s2 + s3 + s4 + s5 + s6 + s7 + s8 + s9 + s10 + s11 + s12) / 4 + (r1 + r2 + r3 + r4 + r5 + r6) / 2;
+                  c = -(s1 + s2 + s3 + s4 + s5 + s6 + s7 + s8 + s9 + s10 + s11 + s12) / 4 + (r1 + r2 + r3 + r4 + r5 + r6) / 2;
+                  d = -(p1 + p2 + p3 + p4 + p5 + p6 + p7 + p8) / 8 + (s1 + s2 + s3 + s4 + s5 + s6 + s7 + s8 + s9 + s10 + s11 + s12) / 12;
+                  if(b < a && b >= 0 && c >=0 && d >= 0)
+                     a = b;
+                  working_space[x][y][z] = a;
                }
             }
          }
-      }
-
-      else if (filterType == kBackOneStepFiltering) {
-         for (i = sampling; i >= 1; i--) {
-            q1 = (Int_t) TMath::Min(i, numberIterationsX), q2 =(Int_t) TMath::Min(i, numberIterationsY), q3 =(Int_t) TMath::Min(i, numberIterationsZ);
-            for (z = q3; z < ssizez - q3; z++) {
-               for (y = q2; y < ssizey - q2; y++) {
-                  for (x = q1; x < ssizex - q1; x++) {
-                     a = spectrum[x][y][z];
-                     p1 = spectrum[x + q1][y + q2][z - q3];
-                     p2 = spectrum[x - q1][y + q2][z - q3];
-                     p3 = spectrum[x + q1][y - q2][z - q3];
-                     p4 = spectrum[x - q1][y - q2][z - q3];
-                     p5 = spectrum[x + q1][y + q2][z + q3];
-                     p6 = spectrum[x - q1][y + q2][z + q3];
-                     p7 = spectrum[x + q1][y - q2][z + q3];
-                     p8 = spectrum[x - q1][y - q2][z + q3];
-                     s1 = spectrum[x + q1][y     ][z - q3];
-                     s2 = spectrum[x     ][y + q2][z - q3];
-                     s3 = spectrum[x - q1][y     ][z - q3];
-                     s4 = spectrum[x     ][y - q2][z - q3];
-                     s5 = spectrum[x + q1][y     ][z + q3];
-                     s6 = spectrum[x     ][y + q2][z + q3];
-                     s7 = spectrum[x - q1][y     ][z + q3];
-                     s8 = spectrum[x     ][y - q2][z + q3];
-                     s9 = spectrum[x - q1][y + q2][z     ];
-                     s10 = spectrum[x - q1][y - q2][z     ];
-                     s11 = spectrum[x + q1][y + q2][z     ];
-                     s12 = spectrum[x + q1][y - q2][z     ];
-                     r1 = spectrum[x     ][y     ][z - q3];
-                     r2 = spectrum[x     ][y     ][z + q3];
-                     r3 = spectrum[x - q1][y     ][z     ];
-                     r4 = spectrum[x + q1][y     ][z     ];
-                     r5 = spectrum[x     ][y + q2][z     ];
-                     r6 = spectrum[x     ][y - q2][z     ];
-                     b = (p1 + p2 + p3 + p4 + p5 + p6 + p7 + p8) / 8 - (s1 + s2 + s3 + s4 + s5 + s6 + s7 + s8 + s9 + s10 + s11 + s12) / 4 + (r1 + r2 + r3 + r4 + r5 + r6) / 2;
-                     c = -(s1 + s2 + s3 + s4 + s5 + s6 + s7 + s8 + s9 + s10 + s11 + s12) / 4+(r1 + r2 + r3 + r4 + r5 + r6) / 2;
-                     d = -(p1 + p2 + p3 + p4 + p5 + p6 + p7 + p8)/8 + (s1 + s2 + s3 + s4 + s5 + s6 + s7 + s8 + s9 + s10 + s11 + s12) / 12;
-                     if(b < a && b >= 0 && c >=0 && d >= 0)
-                        a = b;
-                     working_space[x][y][z] = a;
-                  }
-               }
-            }
-            for (z = q3; z < ssizez - q3; z++) {
-               for (y = q2; y < ssizey - q2; y++) {
-                  for (x = q1; x < ssizex - q1; x++) {
-                     spectrum[x][y][z] = working_space[x][y][z];
-                  }
-               }
+      });
+      for (Int_t x = q1; x < ssizex - q1; x++) {
+         for (Int_t y = q2; y < ssizey - q2; y++) {
+            for (Int_t z = q3; z < ssizez - q3; z++) {
+               spectrum[x][y][z] = working_space[x][y][z];
             }
          }
       }
@@ -0,0 +1,135 @@
+// @(#)root/spectrum:$Id$
+
+/*************************************************************************
+ * Copyright (C) 1995-2021, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+// Inner loops shared by the TSpectrum classes: they are written over contiguous
+// arrays, explicitly vectorized when VecCore is available, and the loops over the
+// rows or planes of multi-dimensional spectra can run on the implicit MT pool.
+
+#ifndef ROOT_TSpectrumKernels
+#define ROOT_TSpectrumKernels
+
+#include "Rtypes.h"
+#include "Math/Types.h"
+
+#ifdef R__USE_IMT
+#include "TROOT.h"
+#include "ROOT/TThreadExecutor.hxx"
+#endif
+
+namespace ROOT {
+
+namespace Internal {
+
+namespace Spectrum {
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return init + sum of a[i]*b[i] for i in [0,n).
+/// Without VecCore the terms are added in the order of i.
+
+inline Double_t DotProduct(const Double_t *a, const Double_t *b, Int_t n, Double_t init = 0)
+{
+   Int_t i = 0;
+#ifdef R__HAS_VECCORE
+   const Int_t vecSize = vecCore::VectorSize<ROOT::Double_v>();
+   if (n >= vecSize) {
+      ROOT::Double_v sum(0.), va, vb;
+      for (; i + vecSize <= n; i += vecSize) {
+         vecCore::Load(va, a + i);
+         vecCore::Load(vb, b + i);
+         sum += va * vb;
+      }
+      init += vecCore::ReduceAdd(sum);
+   }
+#endif
+   for (; i < n; ++i)
+      init += a[i] * b[i];
+   return init;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return init + sum of w[i]*(x[i]+y[i]) for i in [0,n).
+/// Without VecCore the terms are added in the order of i.
+
+inline Double_t DotProductSum(const Double_t *w, const Double_t *x, const Double_t *y, Int_t n, Double_t init = 0)
+{
+   Int_t i = 0;
+#ifdef R__HAS_VECCORE
+   const Int_t vecSize = vecCore::VectorSize<ROOT::Double_v>();
+   if (n >= vecSize) {
+      ROOT::Double_v sum(0.), vw, vx, vy;
+      for (; i + vecSize <= n; i += vecSize) {
+         vecCore::Load(vw, w + i);
+         vecCore::Load(vx, x + i);
+         vecCore::Load(vy, y + i);
+         sum += vw * (vx + vy);
+      }
+      init += vecCore::ReduceAdd(sum);
+   }
+#endif
+   for (; i < n; ++i)
+      init += w[i] * (x[i] + y[i]);
+   return init;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// One step of the second order SNIP clipping with window p:
+/// out[j] = min(in[j], (in[j-p]+in[j+p])/2) for j in [begin,end).
+/// The arrays in and out must not overlap.
+
+inline void ClipSNIP(const Double_t *in, Double_t *out, Int_t begin, Int_t end, Int_t p)
+{
+   Int_t j = begin;
+#ifdef R__HAS_VECCORE
+   const Int_t vecSize = vecCore::VectorSize<ROOT::Double_v>();
+   ROOT::Double_v a, l, r;
+   for (; j + vecSize <= end; j += vecSize) {
+      vecCore::Load(a, in + j);
+      vecCore::Load(l, in + j - p);
+      vecCore::Load(r, in + j + p);
+      vecCore::Store(vecCore::math::Min(a, (l + r) / 2.0), out + j);
+   }
+#endif
+   for (; j < end; ++j) {
+      Double_t a = in[j];
+      Double_t b = (in[j - p] + in[j + p]) / 2.0;
+      out[j] = (b < a) ? b : a;
+   }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Call func(i) for i in [begin,end). The calls run on the implicit multi-threading pool
+/// if it is enabled and the total work, i.e. (end - begin) * workPerIndex, is large enough
+/// to be split: func must then be safe to call concurrently for different i.
+
+template <class F>
+void ForEach(Int_t begin, Int_t end, Long64_t workPerIndex, F &&func)
+{
+#ifdef R__USE_IMT
+   // below this number of channels the tasks would cost more than the work
+   const Long64_t kMinParallelWork = 1 << 15;
+   if (end - begin > 1 && (end - begin) * workPerIndex >= kMinParallelWork && ROOT::IsImplicitMTEnabled()) {
+      ROOT::TThreadExecutor pool;
+      pool.Foreach(func, ROOT::TSeq<Int_t>(begin, end));
+      return;
+   }
+#else
+   (void)workPerIndex;
+#endif
+   for (Int_t i = begin; i < end; ++i)
+      func(i);
+}
+
+} // namespace Spectrum
+
+} // namespace Internal
+
+} // namespace ROOT
+
+#endif
@@ -0,0 +1,270 @@
+#include "TSpectrum.h"
+#include "TSpectrum2.h"
+#include "TSpectrum3.h"
+#include "TH1D.h"
+#include "TROOT.h"
+
+#include "gtest/gtest.h"
+
+#include <cmath>
+#include <vector>
+
+// Reference values computed with the TSpectrum implementation preceding the vectorized kernels
+// (same inputs as below): the sum of the output, the sum weighted by (index + 1) and the output at the
+// indices (37 * k + 3) % size for k in [0, 10).
+struct RReference {
+   double fSum;
+   double fWeightedSum;
+   double fSamples[10];
+};
+
+// clang-format off
+const RReference kBkgDecO2{2720.6833083035485, 147608.65041848944, {21.861169204080131, 24.40882581764042, 31.073778919339933, 22.077407792021649, 26.715625606832603, 29.668670336774277, 24.405430089695642, 32.354034165190996, 35.425521578603295, 24.431924358844775}};
+const RReference kBkgIncO4{5087.2502789522077, 260215.86827593387, {21.861169204080131, 24.40882581764042, 57.672021268980174, 23.375970866893745, 28.956236658581616, 30.063889007091614, 121.25472756645296, 123.17183687594016, 35.425521578603295, 28.497657107466214}};
+const RReference kBkgSmoothCompton{3387.0098166624084, 183981.10697158772, {25.306718248776928, 30.116233852874878, 38.674131006465302, 25.57758143501616, 34.479245104174829, 36.296476761358768, 30.55823049516124, 44.408623857766841, 35.425521578603295, 30.180583911070428}};
+const RReference kMarkov{8140.4096874133656, 357639.88389406318, {18.463357152730566, 21.76789754930941, 79.065376105435504, 19.060284385988005, 21.407951228382352, 24.018019466895769, 1003.1232531612502, 231.18354448937566, 24.190766171323283, 20.876824111067236}};
+const RReference kDecon{8154.2776555932514, 387722.04521777842, {12.259142962739547, 35.392040783726294, 60.583961207606151, 30.95090110431298, 17.467051681095242, 45.237991903527892, 557.77454525498604, 145.51776786929847, 2.5726519428214855e-06, 19.909620663560258}};
+const RReference kSearch{6098.2182705813757, 281066.91416734725, {2.8014981641972754, 5.5358994031864981, 108.08250495493566, 1.3774619659750567, 1.3030764248329687, 4.7433234758345018, 563.59422425362266, 244.86362245895833, 4.7243255925863048, 1.6669341893189651}};
+const RReference kSearchMarkov{4854.2250567560141, 193295.39428251612, {0.58909368558015396, 0.3524225175254585, 45.8389801873357, 0.014963107826121874, 0.046792100955603322, 0.55939711465735342, 707.25865310420807, 159.99423818612848, 1.7484283961704039, 0.0038077111513831882}};
+const RReference kBkg2Successive{13935.789702489634, 4287823.4983560499, {11.882139651373299, 12.554796132933546, 11.980402456550264, 13.188272407205979, 19.490155755389445, 14.611961897385477, 54.328837379744499, 17.052289288516633, 25.597711643537842, 14.553564483330202}};
+const RReference kBkg2Onestep{9053.4015465491739, 2918137.4785206341, {11.882139651373299, 11.225879447075824, 7.5036402029715603, 5.7378518388239819, 12.771808035339639, 14.611961897385477, 28.43250698253879, 17.052289288516633, 7.5432345708381128, 14.553564483330202}};
+const RReference kBkg3Successive{13826.464222112711, 6916910.9805797171, {6.1242867787976936, 7.7787165073904809, 6.5328273787279514, 7.2515326832826572, 8.2806001373360356, 7.6241745654279658, 14.313733991377259, 8.8459846095509604, 8.5708846293265566, 69.992424665656714}};
+const RReference kBkg3Onestep{13350.963815548967, 6706495.227472554, {6.1242867787976936, 7.7787165073904809, 6.5328273787279514, 7.2515326832826572, 8.3812638327036577, 7.6241745654279658, 14.313733991377259, 8.8459846095509604, 8.5708846293265566, 54.711004886891573}};
+const double kSearchPeaks[] = {25.000499389438225, 59.998805758598003, 74.997725880108575};
+const double kSearchMarkovPeaks[] = {25.001634447325191, 59.996041670807045, 74.99927604227112};
+// clang-format on
+
+static void CheckReference(const double *v, int n, const RReference &ref)
+{
+   double sum = 0, weightedSum = 0;
+   for (int i = 0; i < n; ++i) {
+      sum += v[i];
+      weightedSum += (i + 1) * v[i];
+   }
+   // the vectorized kernels may add the terms in a different order
+   const double tol = 1e-10;
+   EXPECT_NEAR(sum, ref.fSum, tol * std::abs(ref.fSum));
+   EXPECT_NEAR(weightedSum, ref.fWeightedSum, tol * std::abs(ref.fWeightedSum));
+   for (int k = 0; k < 10; ++k) {
+      const double expected = ref.fSamples[k];
+      EXPECT_NEAR(v[(37 * k + 3) % n], expected, tol * std::abs(expected) + 1e-12) << "at index " << (37 * k + 3) % n;
+   }
+}
+
+static double Gaus(double x, double mean, double sigma)
+{
+   return std::exp(-0.5 * (x - mean) * (x - mean) / (sigma * sigma));
+}
+
+// Three peaks on a linear background, with a deterministic ripple
+static std::vector<double> MakeSource(int shift = 0)
+{
+   std::vector<double> v(100);
+   for (int i = 0; i < 100; ++i) {
+      v[i] = 25 + 0.1 * i + 500 * Gaus(i, 25 + shift, 2) + 300 * Gaus(i, 60 + shift, 2.5) +
+             150 * Gaus(i, 75 + shift, 2) + 5 * std::sin(1.3 * i);
+   }
+   return v;
+}
+
+static std::vector<double> MakeSource2D(int nx, int ny)
+{
+   std::vector<double> v(nx * ny);
+   for (int i = 0; i < nx; ++i) {
+      for (int j = 0; j < ny; ++j) {
+         v[i * ny + j] = 10 + 0.5 * i + 0.2 * j + 400 * Gaus(i, 8, 1.5) * Gaus(j, 12, 2) +
+                         200 * Gaus(i, 16, 2) * Gaus(j, 5, 1.5) + 3 * std::sin(i * 1.7 + j * 0.9);
+      }
+   }
+   return v;
+}
+
+static std::vector<double *> MakeRows(std::vector<double> &v, int nx, int ny)
+{
+   std::vector<double *> rows(nx);
+   for (int i = 0; i < nx; ++i)
+      rows[i] = v.data() + i * ny;
+   return rows;
+}
+
+TEST(TSpectrum, Background)
+{
+   TSpectrum s;
+   auto v = MakeSource();
+   s.Background(v.data(), 100, 8, TSpectrum::kBackDecreasingWindow, TSpectrum::kBackOrder2, false, 3, false);
+   CheckReference(v.data(), 100, kBkgDecO2);
+
+   v = MakeSource();
+   s.Background(v.data(), 100, 8, TSpectrum::kBackIncreasingWindow, TSpectrum::kBackOrder4, false, 3, false);
+   CheckReference(v.data(), 100, kBkgIncO4);
+
+   v = MakeSource();
+   s.Background(v.data(), 100, 8, TSpectrum::kBackDecreasingWindow, TSpectrum::kBackOrder2, true,
+                TSpectrum::kBackSmoothing5, true);
+   CheckReference(v.data(), 100, kBkgSmoothCompton);
+}
+
+TEST(TSpectrum, SmoothMarkov)
+{
+   TSpectrum s;
+   auto v = MakeSource();
+   s.SmoothMarkov(v.data(), 100, 3);
+   CheckReference(v.data(), 100, kMarkov);
+}
+
+TEST(TSpectrum, Deconvolution)
+{
+   TSpectrum s;
+   auto v = MakeSource();
+   std::vector<double> response(100);
+   for (int i = 0; i < 100; ++i)
+      response[i] = Gaus(i, 0, 2);
+   s.Deconvolution(v.data(), response.data(), 100, 100, 1, 1.);
+   CheckReference(v.data(), 100, kDecon);
+}
+
+TEST(TSpectrum, SearchHighRes)
+{
+   TSpectrum s;
+   for (bool markov : {false, true}) {
+      auto v = MakeSource();
+      std::vector<double> dest(100);
+      const int nPeaks = s.SearchHighRes(v.data(), dest.data(), 100, 2, 5, true, 3, markov, 3);
+      CheckReference(dest.data(), 100, markov ? kSearchMarkov : kSearch);
+      const double *expectedPeaks = markov ? kSearchMarkovPeaks : kSearchPeaks;
+      ASSERT_EQ(nPeaks, 3);
+      for (int i = 0; i < nPeaks; ++i)
+         EXPECT_NEAR(s.GetPositionX()[i], expectedPeaks[i], 1e-9);
+   }
+}
+
+TEST(TSpectrum, Search)
+{
+   TH1D h("h", "h", 100, 0, 100);
+   const auto v = MakeSource();
+   for (int i = 0; i < 100; ++i)
+      h.SetBinContent(i + 1, v[i]);
+
+   // Search runs SearchHighRes with background removal and Markov smoothing, and returns the bin centers
+   TSpectrum s;
+   ASSERT_EQ(s.Search(&h, 2, "goff", 0.05), 3);
+   for (int i = 0; i < 3; ++i) {
+      const int bin = 1 + int(kSearchMarkovPeaks[i] + 0.5);
+      EXPECT_DOUBLE_EQ(s.GetPositionX()[i], h.GetBinCenter(bin));
+      EXPECT_DOUBLE_EQ(s.GetPositionY()[i], h.GetBinContent(bin));
+   }
+}
+
+TEST(TSpectrum, BatchBackground)
+{
+   TSpectrum s;
+   std::vector<std::vector<double>> batch, single;
+   std::vector<double *> spectra;
+   for (int shift = 0; shift < 5; ++shift) {
+      batch.emplace_back(MakeSource(shift));
+      single.emplace_back(MakeSource(shift));
+   }
+   for (auto &v : batch)
+      spectra.push_back(v.data());
+
+   s.Background(spectra.data(), 5, 100, 8, TSpectrum::kBackDecreasingWindow, TSpectrum::kBackOrder2, false, 3, false);
+   for (int i = 0; i < 5; ++i) {
+      s.Background(single[i].data(), 100, 8, TSpectrum::kBackDecreasingWindow, TSpectrum::kBackOrder2, false, 3,
+                   false);
+      EXPECT_EQ(batch[i], single[i]) << "spectrum " << i;
+   }
+}
+
+TEST(TSpectrum, BatchSearchHighRes)
+{
+   TSpectrum s;
+   std::vector<std::vector<double>> sources, dests(5, std::vector<double>(100));
+   std::vector<double *> sourcePtrs, destPtrs;
+   for (int shift = 0; shift < 5; ++shift)
+      sources.emplace_back(MakeSource(shift));
+   for (int i = 0; i < 5; ++i) {
+      sourcePtrs.push_back(sources[i].data());
+      destPtrs.push_back(dests[i].data());
+   }
+
+   std::vector<std::vector<double>> positions;
+   const int nTotal = s.SearchHighRes(sourcePtrs.data(), destPtrs.data(), 5, 100, 2, 5, true, 3, false, 3, positions);
+   ASSERT_EQ(positions.size(), 5u);
+
+   int nExpected = 0;
+   for (int i = 0; i < 5; ++i) {
+      auto v = MakeSource(i);
+      std::vector<double> dest(100);
+      const int nPeaks = s.SearchHighRes(v.data(), dest.data(), 100, 2, 5, true, 3, false, 3);
+      nExpected += nPeaks;
+      EXPECT_EQ(dests[i], dest) << "spectrum " << i;
+      EXPECT_EQ(positions[i], std::vector<double>(s.GetPositionX(), s.GetPositionX() + nPeaks)) << "spectrum " << i;
+   }
+   EXPECT_EQ(nTotal, nExpected);
+}
+
+TEST(TSpectrum2, Background)
+{
+   const int nx = 24, ny = 24;
+   TSpectrum2 s;
+   auto v = MakeSource2D(nx, ny);
+   auto rows = MakeRows(v, nx, ny);
+   s.Background(rows.data(), nx, ny, 5, 4, TSpectrum2::kBackDecreasingWindow, TSpectrum2::kBackSuccessiveFiltering);
+   CheckReference(v.data(), nx * ny, kBkg2Successive);
+
+   v = MakeSource2D(nx, ny);
+   rows = MakeRows(v, nx, ny);
+   s.Background(rows.data(), nx, ny, 5, 4, TSpectrum2::kBackDecreasingWindow, TSpectrum2::kBackOneStepFiltering);
+   CheckReference(v.data(), nx * ny, kBkg2Onestep);
+}
+
+TEST(TSpectrum3, Background)
+{
+   const int n = 10;
+   TSpectrum3 s;
+   std::vector<double> v(n * n * n);
+   std::vector<double *> rows(n * n);
+   std::vector<double **> planes(n);
+   auto fill = [&] {
+      for (int i = 0; i < n; ++i) {
+         planes[i] = rows.data() + i * n;
+         for (int j = 0; j < n; ++j) {
+            planes[i][j] = v.data() + (i * n + j) * n;
+            for (int k = 0; k < n; ++k) {
+               planes[i][j][k] = 5 + 0.3 * i + 0.2 * j + 0.1 * k + 300 * Gaus(i, 4, 1.2) * Gaus(j, 5, 1.5) * Gaus(k, 6, 1) +
+                                 2 * std::sin(i + 2. * j + 3. * k);
+            }
+         }
+      }
+   };
+
+   fill();
+   s.Background(planes.data(), n, n, n, 3, 3, 2, TSpectrum3::kBackDecreasingWindow,
+                TSpectrum3::kBackSuccessiveFiltering);
+   CheckReference(v.data(), n * n * n, kBkg3Successive);
+
+   fill();
+   s.Background(planes.data(), n, n, n, 3, 3, 2, TSpectrum3::kBackDecreasingWindow, TSpectrum3::kBackOneStepFiltering);
+   CheckReference(v.data(), n * n * n, kBkg3Onestep);
+}
+
+#ifdef R__USE_IMT
+// Large enough for the steps of the background estimation to run on the thread pool
+TEST(TSpectrum2, BackgroundMT)
+{
+   const int nx = 256, ny = 256;
+   auto sequential = MakeSource2D(nx, ny);
+   auto parallel = sequential;
+   auto sequentialRows = MakeRows(sequential, nx, ny);
+   auto parallelRows = MakeRows(parallel, nx, ny);
+
+   TSpectrum2 s;
+   s.Background(sequentialRows.data(), nx, ny, 10, 10, TSpectrum2::kBackDecreasingWindow,
+                TSpectrum2::kBackSuccessiveFiltering);
+   ROOT::EnableImplicitMT(4);
+   s.Background(parallelRows.data(), nx, ny, 10, 10, TSpectrum2::kBackDecreasingWindow,
+                TSpectrum2::kBackSuccessiveFiltering);
+   ROOT::DisableImplicitMT();
+   EXPECT_EQ(sequential, parallel);
+}
+#endif
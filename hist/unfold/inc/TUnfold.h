@@ -207,6 +207,13 @@ class TUnfold : public TObject {
    TMatrixDSparse *fEinv;
    /// matrix E
    TMatrixDSparse *fE;
+   /// A<sup>T</sup>Vyy<sup>-1</sup>, kept across calls to DoUnfold() with the same input
+   TMatrixDSparse *fAtVyyInv; //!
+   /// A<sup>T</sup>Vyy<sup>-1</sup>A, kept across calls to DoUnfold() with the same input
+   TMatrixDSparse *fAtVyyInvA; //!
+   /// L<sup>T</sup>L, kept across calls to DoUnfold() with the same regularisation
+   TMatrixDSparse *fLSquared; //!
+   void ClearTauIndependentMatrices(void); // invalidate fAtVyyInv, fAtVyyInvA and fLSquared
  protected:
    // Int_t IsNotSymmetric(TMatrixDSparse const &m) const;
    virtual Double_t DoUnfold(void);     // the unfolding algorithm
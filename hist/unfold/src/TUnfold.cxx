@@ -124,6 +124,59 @@ along with TUnfold.  If not, see <http://www.gnu.org/licenses/>.
 #include <map>
 #include <vector>
 
+#include "RConfigure.h"
+#ifdef R__USE_IMT
+#include "ROOT/TSeq.hxx"
+#include "ROOT/TThreadExecutor.hxx"
+#include "TROOT.h"
+#include <algorithm>
+#endif
+
+namespace {
+
+////////////////////////////////////////////////////////////////////////////////
+/// Compute the nonzero elements of a sparse matrix row by row, by calling
+/// fill(firstRow,lastRow,rows,cols,data) to append the elements of the rows
+/// [firstRow,lastRow) to the three vectors, in row order.
+///
+/// With implicit multi-threading enabled and an estimated number of
+/// operations above a threshold, ranges of rows are filled concurrently.
+/// The elements are the same, in the same order, as in a sequential fill.
+
+template <typename F>
+void FillSparseRows(Int_t nRows, Double_t nOperations, std::vector<Int_t> &rows,
+                    std::vector<Int_t> &cols, std::vector<Double_t> &data, F fill)
+{
+#ifdef R__USE_IMT
+   // number of operations above which the rows are filled concurrently
+   constexpr Double_t kMinParallelOperations = 1 << 22;
+   // minimum number of rows filled by one task
+   constexpr Int_t kMinTaskRows = 16;
+
+   if (ROOT::IsImplicitMTEnabled() && nOperations >= kMinParallelOperations && nRows >= 2 * kMinTaskRows) {
+      ROOT::TThreadExecutor pool;
+      const Int_t nTasks = std::min<Int_t>(4 * pool.GetPoolSize(), nRows / kMinTaskRows);
+      const Int_t taskRows = (nRows + nTasks - 1) / nTasks;
+      std::vector<std::vector<Int_t>> taskRowsIdx(nTasks), taskCols(nTasks);
+      std::vector<std::vector<Double_t>> taskData(nTasks);
+      pool.Foreach([&](Int_t i) {
+         fill(i * taskRows, std::min(nRows, (i + 1) * taskRows), taskRowsIdx[i], taskCols[i], taskData[i]);
+      }, ROOT::TSeq<Int_t>(nTasks));
+      for (Int_t i = 0; i < nTasks; i++) {
+         rows.insert(rows.end(), taskRowsIdx[i].begin(), taskRowsIdx[i].end());
+         cols.insert(cols.end(), taskCols[i].begin(), taskCols[i].end());
+         data.insert(data.end(), taskData[i].begin(), taskData[i].end());
+      }
+      return;
+   }
+#else
+   (void)nOperations;
+#endif
+   fill(0, nRows, rows, cols, data);
+}
+
+} // anonymous namespace
+
 //#define DEBUG
 //#define DEBUG_DETAIL
 //#define FORCE_EIGENVALUE_DECOMPOSITION
@@ -140,6 +193,7 @@ TUnfold::~TUnfold(void)
    DeleteMatrix(&fY);
    DeleteMatrix(&fX0);
    DeleteMatrix(&fVyyInv);
+   ClearTauIndependentMatrices();
 
    ClearResults();
 }
@@ -181,6 +235,9 @@ void TUnfold::InitTUnfold(void)
    fDXDY = 0;
    fEinv = 0;
    fE = 0;
+   fAtVyyInv = 0;
+   fAtVyyInvA = 0;
+   fLSquared = 0;
    fEpsMatrix=1.E-13;
    fIgnoredBins=0;
 }
@@ -243,6 +300,20 @@ void TUnfold::ClearResults(void)
    fRhoAvg = -1.0;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Delete the products of the input and the regularisation which do not
+/// depend on tau.
+///
+/// They are calculated once by DoUnfold() and reused by the following calls,
+/// e.g. in a scan of tau, until the input or the regularisation changes.
+
+void TUnfold::ClearTauIndependentMatrices(void)
+{
+   DeleteMatrix(&fAtVyyInv);
+   DeleteMatrix(&fAtVyyInvA);
+   DeleteMatrix(&fLSquared);
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Only for use by root streamer or derived classes.
 
@@ -304,14 +375,23 @@ Double_t TUnfold::DoUnfold(void)
    //              T
    //            fA fV  = mAt_V
    //
-   TMatrixDSparse *AtVyyinv=MultiplyMSparseTranspMSparse(fA,fVyyInv);
+   // the products which do not depend on tau are kept for
+   // the next calls, until the input or the regularisation changes
+   if(!fAtVyyInv) {
+      fAtVyyInv=MultiplyMSparseTranspMSparse(fA,fVyyInv);
+      DeleteMatrix(&fAtVyyInvA);
+   }
+   const TMatrixDSparse *AtVyyinv=fAtVyyInv;
+   if(!fLSquared) {
+      fLSquared=MultiplyMSparseTranspMSparse(fL,fL);
+   }
+   const TMatrixDSparse *lSquared=fLSquared;
    //
    // get
    //       T
    //     fA fVyyinv fY + fTauSquared fBiasScale Lsquared fX0 = rhs
    //
    TMatrixDSparse *rhs=MultiplyMSparseM(AtVyyinv,fY);
-   TMatrixDSparse *lSquared=MultiplyMSparseTranspMSparse(fL,fL);
    if (fBiasScale != 0.0) {
      TMatrixDSparse *rhs2=MultiplyMSparseM(lSquared,fX0);
       AddMSparse(rhs, fTauSquared * fBiasScale ,rhs2);
@@ -322,7 +402,10 @@ Double_t TUnfold::DoUnfold(void)
    // get matrix
    //              T
    //           (fA fV)fA + fTauSquared*fLsquared  = fEinv
-   fEinv=MultiplyMSparseMSparse(AtVyyinv,fA);
+   if(!fAtVyyInvA) {
+      fAtVyyInvA=MultiplyMSparseMSparse(AtVyyinv,fA);
+   }
+   fEinv=new TMatrixDSparse(*fAtVyyInvA);
    AddMSparse(fEinv,fTauSquared,lSquared);
 
    //
@@ -428,8 +511,6 @@ Double_t TUnfold::DoUnfold(void)
       DeleteMatrix(&corr);
    }
 
-   DeleteMatrix(&AtVyyinv);
-
    //
    // get error matrix on x
    //   fDXDY * Vyy * fDXDY#
@@ -492,7 +573,6 @@ Double_t TUnfold::DoUnfold(void)
    DeleteMatrix(&epsilon);
 
    DeleteMatrix(&LsquaredDx);
-   DeleteMatrix(&lSquared);
 
    // calculate/store matrices defining the derivatives dx/dA
    fDXDAM[0]=new TMatrixDSparse(*fE);
@@ -637,42 +717,44 @@ TMatrixDSparse *TUnfold::MultiplyMSparseMSparse(const TMatrixDSparse *a,
       if(a_rows[irow+1]>a_rows[irow]) nMax += b->GetNcols();
    }
    if((nMax>0)&&(a_cols)&&(b_cols)) {
-      Int_t *r_rows=new Int_t[nMax];
-      Int_t *r_cols=new Int_t[nMax];
-      Double_t *r_data=new Double_t[nMax];
-      Double_t *row_data=new Double_t[b->GetNcols()];
-      Int_t n=0;
-      for (Int_t irow = 0; irow < a->GetNrows(); irow++) {
-         if(a_rows[irow+1]<=a_rows[irow]) continue;
-         // clear row data
-         for(Int_t icol=0;icol<b->GetNcols();icol++) {
-            row_data[icol]=0.0;
-         }
-         // loop over a-columns in this a-row
-         for(Int_t ia=a_rows[irow];ia<a_rows[irow+1];ia++) {
-            Int_t k=a_cols[ia];
-            // loop over b-columns in b-row k
-            for(Int_t ib=b_rows[k];ib<b_rows[k+1];ib++) {
-               row_data[b_cols[ib]] += a_data[ia]*b_data[ib];
+      const Int_t nColsB=b->GetNcols();
+      // estimated number of operations: one pass over the output row
+      // plus the average b-row length for each element of a
+      Double_t nOperations=Double_t(nMax)+Double_t(a_rows[a->GetNrows()])*
+         b_rows[b->GetNrows()]/TMath::Max(b->GetNrows(),1);
+      std::vector<Int_t> r_rows,r_cols;
+      std::vector<Double_t> r_data;
+      FillSparseRows(a->GetNrows(),nOperations,r_rows,r_cols,r_data,
+                     [&](Int_t firstRow,Int_t lastRow,std::vector<Int_t> &rows,
+                         std::vector<Int_t> &cols,std::vector<Double_t> &data) {
+         std::vector<Double_t> row_data(nColsB);
+         for (Int_t irow = firstRow; irow < lastRow; irow++) {
+            if(a_rows[irow+1]<=a_rows[irow]) continue;
+            // clear row data
+            for(Int_t icol=0;icol<nColsB;icol++) {
+               row_data[icol]=0.0;
             }
-         }
-         // store nonzero elements
-         for(Int_t icol=0;icol<b->GetNcols();icol++) {
-            if(row_data[icol] != 0.0) {
-               r_rows[n]=irow;
-               r_cols[n]=icol;
-               r_data[n]=row_data[icol];
-               n++;
+            // loop over a-columns in this a-row
+            for(Int_t ia=a_rows[irow];ia<a_rows[irow+1];ia++) {
+               Int_t k=a_cols[ia];
+               // loop over b-columns in b-row k
+               for(Int_t ib=b_rows[k];ib<b_rows[k+1];ib++) {
+                  row_data[b_cols[ib]] += a_data[ia]*b_data[ib];
+               }
+            }
+            // store nonzero elements
+            for(Int_t icol=0;icol<nColsB;icol++) {
+               if(row_data[icol] != 0.0) {
+                  rows.push_back(irow);
+                  cols.push_back(icol);
+                  data.push_back(row_data[icol]);
+               }
             }
          }
+      });
+      if(!r_data.empty()) {
+         r->SetMatrixArray(r_data.size(),r_rows.data(),r_cols.data(),r_data.data());
       }
-      if(n>0) {
-         r->SetMatrixArray(n,r_rows,r_cols,r_data);
-      }
-      delete[] r_rows;
-      delete[] r_cols;
-      delete[] r_data;
-      delete[] row_data;
    }
 
    return r;
@@ -866,52 +948,55 @@ TMatrixDSparse *TUnfold::MultiplyMSparseMSparseTranspVector
       v_rows=v_sparse->GetRowIndexArray();
       v_data=v_sparse->GetMatrixArray();
    }
-   Int_t num_r=num_m1*num_m2+1;
-   Int_t *row_r=new Int_t[num_r];
-   Int_t *col_r=new Int_t[num_r];
-   Double_t *data_r=new Double_t[num_r];
-   num_r=0;
-   for(Int_t i=0;i<m1->GetNrows();i++) {
-      for(Int_t j=0;j<m2->GetNrows();j++) {
-         data_r[num_r]=0.0;
-         Int_t index_m1=rows_m1[i];
-         Int_t index_m2=rows_m2[j];
-         while((index_m1<rows_m1[i+1])&&(index_m2<rows_m2[j+1])) {
-            Int_t k1=cols_m1[index_m1];
-            Int_t k2=cols_m2[index_m2];
-            if(k1<k2) {
-               index_m1++;
-            } else if(k1>k2) {
-               index_m2++;
-            } else {
-               if(v_sparse) {
-                  Int_t v_index=v_rows[k1];
-                  if(v_index<v_rows[k1+1]) {
-                     data_r[num_r] += data_m1[index_m1] * data_m2[index_m2]
-                        * v_data[v_index];
-                  }
-               } else if(v) {
-                  data_r[num_r] += data_m1[index_m1] * data_m2[index_m2]
-                     * (*v)(k1,0);
+   // estimated number of operations: the merge of two rows for each pair of rows
+   Double_t nOperations=Double_t(num_m1)*num_m2*
+      (Double_t(rows_m1[m1->GetNrows()])/TMath::Max(num_m1,1)+
+       Double_t(rows_m2[m2->GetNrows()])/TMath::Max(num_m2,1));
+   std::vector<Int_t> row_r,col_r;
+   std::vector<Double_t> data_r;
+   FillSparseRows(m1->GetNrows(),nOperations,row_r,col_r,data_r,
+                  [&](Int_t firstRow,Int_t lastRow,std::vector<Int_t> &rows,
+                      std::vector<Int_t> &cols,std::vector<Double_t> &data) {
+      for(Int_t i=firstRow;i<lastRow;i++) {
+         for(Int_t j=0;j<m2->GetNrows();j++) {
+            Double_t r_ij=0.0;
+            Int_t index_m1=rows_m1[i];
+            Int_t index_m2=rows_m2[j];
+            while((index_m1<rows_m1[i+1])&&(index_m2<rows_m2[j+1])) {
+               Int_t k1=cols_m1[index_m1];
+               Int_t k2=cols_m2[index_m2];
+               if(k1<k2) {
+                  index_m1++;
+               } else if(k1>k2) {
+                  index_m2++;
                } else {
-                  data_r[num_r] += data_m1[index_m1] * data_m2[index_m2];
+                  if(v_sparse) {
+                     Int_t v_index=v_rows[k1];
+                     if(v_index<v_rows[k1+1]) {
+                        r_ij += data_m1[index_m1] * data_m2[index_m2]
+                           * v_data[v_index];
+                     }
+                  } else if(v) {
+                     r_ij += data_m1[index_m1] * data_m2[index_m2]
+                        * (*v)(k1,0);
+                  } else {
+                     r_ij += data_m1[index_m1] * data_m2[index_m2];
+                  }
+                  index_m1++;
+                  index_m2++;
                }
-               index_m1++;
-               index_m2++;
             }
-         }
-         if(data_r[num_r] !=0.0) {
-            row_r[num_r]=i;
-            col_r[num_r]=j;
-            num_r++;
+            if(r_ij !=0.0) {
+               rows.push_back(i);
+               cols.push_back(j);
+               data.push_back(r_ij);
+            }
          }
       }
-   }
+   });
    TMatrixDSparse *r=CreateSparseMatrix(m1->GetNrows(),m2->GetNrows(),
-                                        num_r,row_r,col_r,data_r);
-   delete[] row_r;
-   delete[] col_r;
-   delete[] data_r;
+                                        data_r.size(),row_r.data(),
+                                        col_r.data(),data_r.data());
    return r;
 }
 
@@ -2017,6 +2102,7 @@ Bool_t TUnfold::AddRegularisationCondition
    if(r) {
       DeleteMatrix(&fL);
       fL=CreateSparseMatrix(rowMax+1,GetNx(),nF,l_row,l_col,l_data);
+      DeleteMatrix(&fLSquared);
    }
    delete [] l_row;
    delete [] l_col;
@@ -2303,6 +2389,7 @@ Int_t TUnfold::SetInput(const TH1 *input, Double_t scaleBias,
                         const TH2 *hist_vyy_inv)
 {
   DeleteMatrix(&fVyyInv);
+  ClearTauIndependentMatrices();
   fNdf=0;
 
   fBiasScale = scaleBias;
@@ -3064,6 +3151,7 @@ void TUnfold::GetInputInverseEmatrix(TH2 *out)
    // corresponding to the input data
    if(!fVyyInv) {
       Int_t rank=0;
+      ClearTauIndependentMatrices();
       fVyyInv=InvertMSparseSymmPos(fVyy,&rank);
       // and count number of degrees of freedom
       fNdf = rank-GetNpar();
@@ -0,0 +1,104 @@
+// @(#)root/io:$Id$
+
+/*************************************************************************
+ * Copyright (C) 1995-2021, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#ifndef ROOT_RBlockCache
+#define ROOT_RBlockCache
+
+#include <ROOT/RRawFile.hxx>
+#include <ROOT/RStringView.hxx>
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+
+namespace ROOT {
+namespace Internal {
+
+/**
+ * \class RBlockCache RBlockCache.hxx
+ * \ingroup IO
+ *
+ * A block cache of remote files on a local disk, shared by the processes of a node.
+ *
+ * The remote files are read in aligned blocks of fixed size, which are stored in one file each in the cache
+ * directory, named after the MD5 of the identity of the remote file and of the block index. The identity is the UUID
+ * of ROOT files, so that the replicas of a file share their blocks, and the URL and size of other files. Blocks are
+ * written to a temporary file, which is renamed once complete, so that concurrent readers only see complete blocks.
+ *
+ * The cache is bounded in size: when a process has written about a tenth of the limit, it removes the least
+ * recently used blocks, by modification time, which is updated on each hit, until the cache is below 90% of the
+ * limit. The eviction is done by at most one process at a time, guarded by a lock file in the cache directory.
+ *
+ * The cache is configured by
+ *   - TFile.BlockCacheDir: the cache directory; the cache is disabled if empty, the default
+ *   - TFile.BlockCacheSize: the size limit, in MB, 10240 by default
+ *   - TFile.BlockCacheBlockSize: the block size, in kB, 256 by default
+ *
+ * It is used for the vector reads of TNetXNGFile, TDavixFile and TWebFile, e.g. by the TTreeCache, and for the
+ * reads of the remote RRawFiles.
+ */
+class RBlockCache {
+public:
+   /// Counters of the cache of the process, see GetMetrics()
+   struct RMetrics {
+      std::uint64_t fNHits = 0;            ///< Number of blocks read from the cache
+      std::uint64_t fNMisses = 0;          ///< Number of blocks read from the remote file
+      std::uint64_t fBytesFromCache = 0;   ///< Number of bytes read from the cache
+      std::uint64_t fBytesFromRemote = 0;  ///< Number of bytes read from the remote files
+      std::uint64_t fNEvicted = 0;         ///< Number of blocks removed from the cache by this process
+   };
+
+   /// Reads the given ranges from the remote file and sets their fOutBytes. Returns false on failure.
+   using FetchFunc_t = std::function<bool(RRawFile::RIOVec *ioVec, unsigned int nReq)>;
+
+private:
+   std::string fDirectory;
+   std::uint64_t fMaxSize;
+   std::size_t fBlockSize;
+   /// Bytes written to the cache since the last eviction
+   std::atomic<std::uint64_t> fBytesWritten{0};
+
+   std::atomic<std::uint64_t> fNHits{0};
+   std::atomic<std::uint64_t> fNMisses{0};
+   std::atomic<std::uint64_t> fBytesFromCache{0};
+   std::atomic<std::uint64_t> fBytesFromRemote{0};
+   std::atomic<std::uint64_t> fNEvicted{0};
+
+   std::string GetBlockPath(std::string_view fileId, std::uint64_t blockIdx) const;
+   bool LoadBlock(const std::string &path, unsigned char *buffer, std::size_t size);
+   void StoreBlock(const std::string &path, const unsigned char *buffer, std::size_t size);
+   void Evict();
+
+public:
+   RBlockCache(std::string_view directory, std::uint64_t maxSize, std::size_t blockSize);
+   RBlockCache(const RBlockCache &) = delete;
+   RBlockCache &operator=(const RBlockCache &) = delete;
+
+   /// The cache configured by TFile.BlockCacheDir, or nullptr if the cache is disabled
+   static RBlockCache *Get();
+
+   /// Read the given ranges of the file identified by fileId, of size fileSize, from the cache, reading the missing
+   /// blocks with fetch. Sets the fOutBytes of the ranges, which are short at the end of the file. Returns false if
+   /// fetch failed.
+   bool ReadV(std::string_view fileId, std::uint64_t fileSize, RRawFile::RIOVec *ioVec, unsigned int nReq,
+              const FetchFunc_t &fetch);
+
+   RMetrics GetMetrics() const;
+   const std::string &GetDirectory() const { return fDirectory; }
+   std::size_t GetBlockSize() const { return fBlockSize; }
+   std::uint64_t GetMaxSize() const { return fMaxSize; }
+};
+
+} // namespace Internal
+} // namespace ROOT
+
+#endif
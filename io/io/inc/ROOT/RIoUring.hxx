@@ -9,10 +9,13 @@
 #ifndef ROOT_RIoUring
 #define ROOT_RIoUring
 
+#include <algorithm>
+#include <cerrno>
 #include <cstdint>
 #include <cstring>
 #include <stdexcept>
 #include <string>
+#include <vector>
 
 #include <liburing.h>
 #include <liburing/io_uring.h>
@@ -26,6 +29,8 @@ class RIoUring {
 private:
    struct io_uring fRing;
    std::uint32_t fDepth = 0;
+   /// The file descriptor registered with RegisterFile(), if any
+   int fRegisteredFileDes = -1;
 
 public:
    // Create an io_uring instance. The ring selects an appropriate queue depth. which can be queried
@@ -94,76 +99,108 @@ public:
       int fFileDes = -1;
    };
 
+   /// Registers `fileDes` with the ring. Reads from a registered file descriptor use the fixed file table of the
+   /// ring, which saves the kernel from looking up and reference counting the file on every submission.
+   /// Only a single file can be registered. Returns false if the kernel refuses the registration, in which case
+   /// reads fall back to the regular file descriptor.
+   bool RegisterFile(int fileDes) {
+      if (fRegisteredFileDes >= 0)
+         return fRegisteredFileDes == fileDes;
+      if (io_uring_register_files(&fRing, &fileDes, 1) != 0)
+         return false;
+      fRegisteredFileDes = fileDes;
+      return true;
+   }
+
    /// Submit a number of read events and wait for completion. Events are submitted in batches if
-   /// the number of events is larger than the submission queue depth.
+   /// the number of events is larger than the submission queue depth. Short reads are resubmitted for the missing
+   /// part of the request until either the request is complete or the end of the file is reached.
    void SubmitReadsAndWait(RReadEvent* readEvents, unsigned int nReads) {
       unsigned int batch = 0;
-      unsigned int batchSize = fDepth;
-      unsigned int readPos = 0;
 
-      while (readPos < nReads) {
-         if (readPos + batchSize > nReads) {
-            batchSize = nReads - readPos;
+      std::vector<unsigned int> pending(nReads);
+      for (unsigned int i = 0; i < nReads; ++i) {
+         if (readEvents[i].fFileDes == -1) {
+            throw std::runtime_error("bad fd (-1) for read request '" + std::to_string(i) + "'");
          }
-         // prep reads
-         struct io_uring_sqe *sqe;
-         for (std::size_t i = readPos; i < readPos + batchSize; ++i) {
-            sqe = io_uring_get_sqe(&fRing);
-            if (!sqe) {
-               throw std::runtime_error("batch " + std::to_string(batch) + ": "
-                  + "get SQE failed for read request '" + std::to_string(i)
-                  + "', error: " + std::string(strerror(errno)));
-            }
-            if (readEvents[i].fFileDes == -1) {
-               throw std::runtime_error("batch " + std::to_string(batch) + ": "
-                  + "bad fd (-1) for read request '" + std::to_string(i) + "'");
-            }
-            if (readEvents[i].fBuffer == nullptr) {
-               throw std::runtime_error("batch " + std::to_string(batch) + ": "
-                  + "null read buffer for read request '" + std::to_string(i) + "'");
-            }
-            io_uring_prep_read(sqe,
-               readEvents[i].fFileDes,
-               readEvents[i].fBuffer,
-               readEvents[i].fSize,
-               readEvents[i].fOffset
-            );
-            sqe->flags |= IOSQE_ASYNC; // maximize read event throughput
-            sqe->user_data = i;
+         if (readEvents[i].fBuffer == nullptr) {
+            throw std::runtime_error("null read buffer for read request '" + std::to_string(i) + "'");
          }
+         readEvents[i].fOutBytes = 0;
+         pending[i] = i;
+      }
 
-         // todo(max) check for any difference between submit vs. submit and wait for large nReq
-         int submitted = io_uring_submit_and_wait(&fRing, batchSize);
-         if (submitted <= 0) {
-            throw std::runtime_error("batch " + std::to_string(batch) + ": "
-               "ring submit failed, error: " + std::string(strerror(errno)));
-         }
-         if (submitted != static_cast<int>(batchSize)) {
-            throw std::runtime_error("ring submitted " + std::to_string(submitted) +
-               " events but requested " + std::to_string(batchSize));
-         }
-         // reap reads
-         struct io_uring_cqe *cqe;
-         int ret;
-         for (int i = 0; i < submitted; ++i) {
-            ret = io_uring_wait_cqe(&fRing, &cqe);
-            if (ret < 0) {
-               throw std::runtime_error("wait cqe failed, error: " + std::string(std::strerror(-ret)));
-            }
-            auto index = reinterpret_cast<std::size_t>(io_uring_cqe_get_data(cqe));
-            if (index >= nReads) {
-               throw std::runtime_error("bad cqe user data: " + std::to_string(index));
+      while (!pending.empty()) {
+         std::vector<unsigned int> incomplete;
+         unsigned int readPos = 0;
+         unsigned int nPending = pending.size();
+         while (readPos < nPending) {
+            unsigned int batchSize = std::min(fDepth, nPending - readPos);
+            // prep reads
+            struct io_uring_sqe *sqe;
+            for (std::size_t i = readPos; i < readPos + batchSize; ++i) {
+               sqe = io_uring_get_sqe(&fRing);
+               if (!sqe) {
+                  throw std::runtime_error("batch " + std::to_string(batch) + ": "
+                     + "get SQE failed for read request '" + std::to_string(pending[i])
+                     + "', error: " + std::string(strerror(errno)));
+               }
+               auto &ev = readEvents[pending[i]];
+               const bool isFixedFile = (ev.fFileDes == fRegisteredFileDes);
+               io_uring_prep_read(sqe,
+                  isFixedFile ? 0 /* index in the fixed file table */ : ev.fFileDes,
+                  reinterpret_cast<unsigned char *>(ev.fBuffer) + ev.fOutBytes,
+                  ev.fSize - ev.fOutBytes,
+                  ev.fOffset + ev.fOutBytes
+               );
+               sqe->flags |= IOSQE_ASYNC; // maximize read event throughput
+               if (isFixedFile)
+                  sqe->flags |= IOSQE_FIXED_FILE;
+               sqe->user_data = pending[i];
             }
-            if (cqe->res < 0) {
+
+            // todo(max) check for any difference between submit vs. submit and wait for large nReq
+            int submitted = io_uring_submit_and_wait(&fRing, batchSize);
+            if (submitted <= 0) {
                throw std::runtime_error("batch " + std::to_string(batch) + ": "
-                  + "read failed for ReadEvent[" + std::to_string(index) + "], "
-                  "error: " + std::string(std::strerror(-cqe->res)));
+                  "ring submit failed, error: " + std::string(strerror(errno)));
+            }
+            if (submitted != static_cast<int>(batchSize)) {
+               throw std::runtime_error("ring submitted " + std::to_string(submitted) +
+                  " events but requested " + std::to_string(batchSize));
+            }
+            // reap reads
+            struct io_uring_cqe *cqe;
+            int ret;
+            for (int i = 0; i < submitted; ++i) {
+               ret = io_uring_wait_cqe(&fRing, &cqe);
+               if (ret < 0) {
+                  throw std::runtime_error("wait cqe failed, error: " + std::string(std::strerror(-ret)));
+               }
+               auto index = reinterpret_cast<std::size_t>(io_uring_cqe_get_data(cqe));
+               if (index >= nReads) {
+                  throw std::runtime_error("bad cqe user data: " + std::to_string(index));
+               }
+               auto res = cqe->res;
+               io_uring_cqe_seen(&fRing, cqe);
+               if ((res == -EINTR) || (res == -EAGAIN)) {
+                  incomplete.push_back(index);
+                  continue;
+               }
+               if (res < 0) {
+                  throw std::runtime_error("batch " + std::to_string(batch) + ": "
+                     + "read failed for ReadEvent[" + std::to_string(index) + "], "
+                     "error: " + std::string(std::strerror(-res)));
+               }
+               readEvents[index].fOutBytes += static_cast<std::size_t>(res);
+               // A zero-byte read indicates the end of the file
+               if ((res > 0) && (readEvents[index].fOutBytes < readEvents[index].fSize))
+                  incomplete.push_back(index);
             }
-            readEvents[index].fOutBytes = static_cast<std::size_t>(cqe->res);
-            io_uring_cqe_seen(&fRing, cqe);
+            readPos += batchSize;
+            batch += 1;
          }
-         readPos += batchSize;
-         batch += 1;
+         pending.swap(incomplete);
       }
       return;
    }
@@ -22,6 +22,8 @@
 namespace ROOT {
 namespace Internal {
 
+class RBlockCache;
+
 /**
  * \class RRawFile RRawFile.hxx
  * \ingroup IO
@@ -108,6 +110,13 @@ private:
    std::uint64_t fFileSize;
    /// Files are opened lazily and only when required; the open state is kept by this flag
    bool fIsOpen;
+   /// Set while the block cache reads the missing blocks, which then bypass the cache
+   bool fIsFetchingBlocks = false;
+
+   /// The node-wide block cache for remote files if it is enabled, see RBlockCache, or nullptr
+   RBlockCache *GetBlockCache();
+   /// Calls ReadAtImpl, through the block cache if it is enabled
+   size_t ReadAtCached(void *buffer, size_t nbytes, std::uint64_t offset);
 
 protected:
    std::string fUrl;
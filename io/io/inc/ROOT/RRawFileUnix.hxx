@@ -15,22 +15,37 @@
 #include <ROOT/RRawFile.hxx>
 #include <ROOT/RStringView.hxx>
 
+#include <RConfigure.h>
+
 #include <cstddef>
 #include <cstdint>
+#include <memory>
 
 namespace ROOT {
 namespace Internal {
 
+#ifdef R__HAS_URING
+class RIoUring;
+#endif
+
 /**
  * \class RRawFileUnix RRawFileUnix.hxx
  * \ingroup IO
  *
  * The RRawFileUnix class uses POSIX calls to read from a mounted file system. Thus the path name can refer,
  * for instance, to a named pipe instead of a regular file.
+ *
+ * If ROOT is built with io_uring support, vector reads are submitted in batches to an io_uring instance. The ring
+ * is created on the first vector read and is reused for the lifetime of the file object, with the file descriptor
+ * registered in the ring's fixed file table.
  */
 class RRawFileUnix : public RRawFile {
 private:
    int fFileDes;
+#ifdef R__HAS_URING
+   /// Lazily created on the first ReadV() call; reused by subsequent ReadV() calls
+   std::unique_ptr<RIoUring> fIoUring;
+#endif
 
 protected:
    void OpenImpl() final;
@@ -36,6 +36,10 @@ class TBufferMergerFile;
  * socket, TBufferMerger uses threads that each write to a
  * TBufferMergerFile, which in turn push data into a queue
  * managed by the TBufferMerger.
+ *
+ * TTrees are merged with the fast method: the baskets compressed by the
+ * worker threads are copied as is into the output file (see TTreeCloner),
+ * so the merging thread neither decompresses nor re-streams them.
  */
 
 class TBufferMerger {
@@ -16,6 +16,8 @@
 #include "TString.h"
 
 #include <deque>
+#include <functional>
+#include <iosfwd>
 #include <memory>
 #include <string>
 #include <vector>
@@ -48,9 +50,14 @@ public:
      kSkipTypeInfo  = 100            ///< do not store typenames in JSON
    };
 
+   /// Receives the JSON code in chunks, see SetOutputSink()
+   using OutputSink_t = std::function<void(const char *data, Int_t len)>;
+
    TBufferJSON(TBuffer::EMode mode = TBuffer::kWrite);
    virtual ~TBufferJSON();
 
+   void SetOutputSink(OutputSink_t sink, Int_t chunk_size = 0x10000);
+
    void SetCompact(int level);
    void SetTypenameTag(const char *tag = "_typename");
    void SetTypeversionTag(const char *tag = nullptr);
@@ -65,6 +72,9 @@ public:
    ConvertToJSON(const void *obj, const TClass *cl, Int_t compact = 0, const char *member_name = nullptr);
    static TString ConvertToJSON(const void *obj, TDataMember *member, Int_t compact = 0, Int_t arraylen = -1);
 
+   static Long64_t ConvertToJSON(std::ostream &out, const TObject *obj, Int_t compact = 0);
+   static Long64_t ConvertToJSON(std::ostream &out, const void *obj, const TClass *cl, Int_t compact = 0);
+
    static Int_t ExportToFile(const char *filename, const TObject *obj, const char *option = nullptr);
    static Int_t ExportToFile(const char *filename, const void *obj, const TClass *cl, const char *option = nullptr);
 
@@ -77,6 +87,12 @@ public:
       return ConvertToJSON(obj, TClass::GetClass<T>(), compact, member_name);
    }
 
+   template <class T>
+   static Long64_t ToJSON(std::ostream &out, const T *obj, Int_t compact = 0)
+   {
+      return ConvertToJSON(out, obj, TClass::GetClass<T>(), compact);
+   }
+
    template <class T>
    static Bool_t FromJSON(T *&obj, const char *json)
    {
@@ -295,6 +311,7 @@ protected:
    void *JsonReadObject(void *obj, const TClass *objClass = nullptr, TClass **readClass = nullptr);
 
    void AppendOutput(const char *line0, const char *line1 = nullptr);
+   void FlushOutput();
 
    void JsonPushValue();
 
@@ -316,6 +333,9 @@ protected:
 
    TString fOutBuffer;                 ///<!  main output buffer for json code
    TString *fOutput{nullptr};          ///<!  current output buffer for json code
+   OutputSink_t fOutputSink;           ///<!  when set, receives main output buffer in chunks
+   Int_t fSinkChunkSize{0};            ///<!  size of main output buffer which is passed to the sink
+   Long64_t fSinkLength{0};            ///<!  total length of JSON code passed to the sink
    TString fValue;                     ///<!  buffer for current value
    unsigned fJsonrCnt{0};              ///<!  counter for all objects, used for referencing
    std::deque<std::unique_ptr<TJSONStackObj>> fStack; ///<!  hierarchy of currently streamed element
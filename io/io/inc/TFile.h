@@ -22,6 +22,7 @@
 //////////////////////////////////////////////////////////////////////////
 
 #include <atomic>
+#include <functional>
 #include <string>
 
 #include "Compression.h"
@@ -51,6 +52,12 @@ class TProcessID;
 class TStopwatch;
 class TFilePrefetch;
 
+namespace ROOT {
+namespace Internal {
+class RZstdFileDictionary;
+}
+}
+
 class TFile : public TDirectoryFile {
   friend class TDirectoryFile;
   friend class TFilePrefetch;
@@ -112,11 +119,12 @@ protected:
 
    TList           *fInfoCache{nullptr};      ///<!Cached list of the streamer infos in this file
    TList           *fOpenPhases{nullptr};     ///<!Time info about open phases
+   std::atomic<ROOT::Internal::RZstdFileDictionary *> fZstdDictionary{nullptr}; ///<!Dictionary of the ZSTD compression with dictionary (if any)
 
 #ifdef R__USE_IMT
    std::mutex                                 fWriteMutex;  ///<!Lock for writing baskets / keys into the file.
-   static ROOT::Internal::RConcurrentHashColl fgTsSIHashes; ///<!TS Set of hashes built from read streamer infos
 #endif
+   static ROOT::Internal::RConcurrentHashColl fgTsSIHashes; ///<!TS Set of hashes built from read streamer infos
 
    static TList    *fgAsyncOpenRequests; //List of handles for pending open requests
 
@@ -137,7 +145,11 @@ protected:
    virtual void        Init(Bool_t create);
            Bool_t      FlushWriteCache();
            Int_t       ReadBufferViaCache(char *buf, Int_t len);
+           Bool_t      ReadBuffersViaBlockCache(char *buf, Long64_t *pos, Int_t *len, Int_t nbuf,
+                                                const std::function<Bool_t(char *, Long64_t *, Int_t *, Int_t)> &readBuffers);
            Int_t       WriteBufferViaCache(const char *buf, Int_t len);
+           void        ReadZstdDictionary();
+           void        WriteZstdDictionary();
 
    ////////////////////////////////////////////////////////////////////////////////
    /// \brief Simple struct of the return value of GetStreamerInfoListImpl
@@ -200,6 +212,8 @@ public:
            void        Close(Option_t *option="") override; // *MENU*
            void        Copy(TObject &) const override { MayNotUse("Copy(TObject &)"); }
    virtual Bool_t      Cp(const char *dst, Bool_t progressbar = kTRUE,UInt_t buffersize = 1000000);
+           void        CompressBuffer(Int_t cxlevel, Int_t *srcsize, char *src, Int_t *tgtsize, char *tgt, Int_t *irep,
+                                      ROOT::RCompressionSetting::EAlgorithm::EValues algorithm);
    virtual TKey*       CreateKey(TDirectory* mother, const TObject* obj, const char* name, Int_t bufsize);
    virtual TKey*       CreateKey(TDirectory* mother, const void* obj, const TClass* cl,
                                  const char* name, Int_t bufsize);
@@ -234,6 +248,7 @@ public:
    virtual Long64_t    GetBytesReadExtra() const { return fBytesReadExtra; }
    virtual Long64_t    GetBytesWritten() const;
    virtual Int_t       GetReadCalls() const { return fReadCalls; }
+           UInt_t      GetZstdDictionaryID() const;
            Int_t       GetVersion() const { return fVersion; }
            Int_t       GetRecordHeader(char *buf, Long64_t first, Int_t maxbytes,
                                        Int_t &nbytes, Int_t &objlen, Int_t &keylen);
@@ -16,6 +16,7 @@
 #include "TList.h"
 #include "TString.h"
 #include "TStopwatch.h"
+#include <memory>
 #include <string>
 
 class TFile;
@@ -25,6 +26,10 @@ class TKey;
 
 namespace ROOT {
 class TIOFeatures;
+namespace Internal {
+class TFileMergerPrefetch;
+class TFileMergerJobs;
+}  // namespace Internal
 }  // namespace ROOT
 
 class TFileMerger : public TObject {
@@ -54,8 +59,13 @@ protected:
    TString        fObjectNames;               ///< List of object names to be either merged exclusively or skipped
    TList          fMergeList;                 ///< list of TObjString containing the name of the files need to be merged
    TList          fExcessFiles;               ///<! List of TObjString containing the name of the files not yet added to fFileList due to user or system limitation on the max number of files opened.
+   Int_t          fPrefetchFiles{0};          ///< Number of excess files opened in the background ahead of their merge
+   std::unique_ptr<ROOT::Internal::TFileMergerPrefetch> fPrefetch; ///<! Background openings of the first excess files
+   Int_t          fParallelMerges{0};         ///< Number of histograms of a directory merged concurrently on the implicit MT pool
+   ROOT::Internal::TFileMergerJobs *fJobs{nullptr}; ///<! Deferred merges of the directory being merged
 
    Bool_t         OpenExcessFiles();
+   void           PrefetchExcessFiles();
    virtual Bool_t AddFile(TFile *source, Bool_t own, Bool_t cpProgress);
    virtual Bool_t MergeRecursive(TDirectory *target, TList *sourcelist, Int_t type = kRegular | kAll);
 
@@ -92,6 +102,10 @@ public:
    TFile      *GetOutputFile() const { return fOutputFile; }
    Int_t       GetMaxOpenedFiles() const { return fMaxOpenedFiles; }
    void        SetMaxOpenedFiles(Int_t newmax);
+   Int_t       GetPrefetchFiles() const { return fPrefetchFiles; }
+   void        SetPrefetchFiles(Int_t nfiles);
+   Int_t       GetParallelMerges() const { return fParallelMerges; }
+   void        SetParallelMerges(Int_t nmerges);
    const char *GetMsgPrefix() const { return fMsgPrefix; }
    void        SetMsgPrefix(const char *prefix);
    const char *GetMergeOptions() { return fMergeOptions; }
@@ -124,7 +138,7 @@ public:
    virtual void   SetNotrees(Bool_t notrees=kFALSE) {fNoTrees = notrees;}
    virtual void        RecursiveRemove(TObject *obj);
 
-   ClassDef(TFileMerger, 6)  // File copying and merging services
+   ClassDef(TFileMerger, 8)  // File copying and merging services
 };
 
 #endif
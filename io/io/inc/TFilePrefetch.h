@@ -15,18 +15,18 @@
 #include "TObject.h"
 #include "TString.h"
 #include "TStopwatch.h"
-#include "TThread.h"
 #include "TFile.h"
 
 #include <atomic>
 #include <condition_variable>
+#include <deque>
 #include <mutex>
+#include <thread>
+#include <vector>
 
 #ifdef R__LESS_INCLUDES
-class TSemaphore;
 class TFPBlock;
 #else
-#include "TSemaphore.h"
 #include "TFPBlock.h"
 #endif
 
@@ -34,20 +34,27 @@ class TFilePrefetch : public TObject {
 
 private:
    TFile      *fFile;                       ///< reference to the file
-   TList      *fPendingBlocks;              ///< list of pending blocks to be read
-   TList      *fReadBlocks;                 ///< list of blocks read
-   TThread    *fConsumer;                   ///< consumer thread
-   std::mutex fMutexPendingList;            ///< mutex for the pending list
-   std::mutex fMutexReadList;               ///< mutex for the list of read blocks
+   std::deque<TFPBlock*> fPendingBlocks;    ///< blocks waiting to be read
+   std::deque<TFPBlock*> fReadBlocks;       ///< blocks read, the oldest first
+   std::vector<std::thread> fConsumers;     ///< consumer threads, if implicit multi-threading is disabled
+   std::mutex fMutex;                       ///< mutex for the lists of blocks and the counters
+   std::mutex fMutexFile;                   ///< serializes the reads of the files without concurrent vector reads
    std::condition_variable fNewBlockAdded;  ///< signal the addition of a new pending block
-   std::condition_variable fReadBlockAdded; ///< signal the addition of a new red block
-   TSemaphore *fSemChangeFile;              ///< semaphore used when changing a file in TChain
+   std::condition_variable fReadBlockAdded; ///< signal the addition of a new read block, or the end of a read
    TString     fPathCache;                  ///< path to the cache directory
    TStopwatch  fWaitTime;                   ///< time waiting to prefetch a buffer (in usec)
-   Bool_t      fThreadJoined;               ///< mark if async thread was joined
+   Int_t       fDepth;                      ///< maximum number of blocks read concurrently
+   Int_t       fNReading;                   ///< number of blocks being read
+   Int_t       fNTasks;                     ///< number of reading tasks in the implicit multi-threading pool
+   Int_t       fMaxQueueDepth;              ///< maximum number of pending and reading blocks
+   Long64_t    fNStalls;                    ///< number of ReadBuffer calls which waited for their block
+   Bool_t      fConcurrentReads;            ///< whether the vector reads of fFile can run concurrently
+   Bool_t      fThreadJoined;               ///< mark if async threads were joined
    std::atomic<Bool_t> fPrefetchFinished;   ///< true if prefetching is over
 
-   static TThread::VoidRtnFunc_t ThreadProc(void*);  //create a joinable worker thread
+   static void TaskProc(void*);
+   void        ReadPendingBlock(TFPBlock*, std::unique_lock<std::mutex>&);
+   TFPBlock   *FindBlock(const std::deque<TFPBlock*>&, Long64_t, Int_t, Int_t*);
 
 public:
    TFilePrefetch(TFile*);
@@ -64,7 +71,6 @@ public:
    void      ReadBlock(Long64_t*, Int_t*, Int_t);
    TFPBlock *CreateBlockObj(Long64_t*, Int_t*, Int_t);
 
-   TThread  *GetThread() const;
    Int_t     ThreadStart();
 
    Bool_t    SetCache(const char*);
@@ -75,6 +81,10 @@ public:
    Int_t     SumHex(const char*);
    Bool_t    BinarySearchReadList(TFPBlock*, Long64_t, Int_t, Int_t*);
    Long64_t  GetWaitTime();
+   Long64_t  GetNStalls() const { return fNStalls; }
+   Int_t     GetDepth() const { return fDepth; }
+   Int_t     GetQueueDepth();
+   Int_t     GetMaxQueueDepth() const { return fMaxQueueDepth; }
 
    void      SetFile(TFile* file, TFile::ECacheAction action = TFile::kDisconnect);
    std::condition_variable &GetCondNewBlock() { return fNewBlockAdded; };
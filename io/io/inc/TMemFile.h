@@ -51,6 +51,7 @@ protected:
    Long64_t     fSysOffset{0};            ///< Seek offset in file
    TMemBlock   *fBlockSeek{nullptr};      ///< Pointer to the block we seeked to.
    Long64_t     fBlockOffset{0};          ///< Seek offset within the block
+   std::shared_ptr<const void> fSharedMemory; ///<! Shared memory segment read, see OpenShared()
 
    constexpr static Long64_t fgDefaultBlockSize = 2 * 1024 * 1024;
    Long64_t fDefaultBlockSize = fgDefaultBlockSize;
@@ -101,6 +102,10 @@ public:
    virtual void     CopyTo(TBuffer &tobuf) const;
            Long64_t GetSize() const override;
 
+           Int_t    PublishShared(const char *shmName) const;
+   static  TMemFile *OpenShared(const char *shmName, const char *name = nullptr);
+   static  Int_t    UnlinkShared(const char *shmName);
+
            void ResetAfterMerge(TFileMergeInfo *) override;
            void ResetErrno() const override;
 
@@ -13,6 +13,7 @@
 #define ROOT_TStreamerInfoActions
 
 #include <memory>
+#include <string>
 #include <vector>
 
 #include "TStreamerInfo.h"
@@ -213,6 +214,7 @@ namespace TStreamerInfoActions {
       static TActionSequence *CreateReadMemberWiseActions(TVirtualStreamerInfo *info, TVirtualCollectionProxy &proxy);
       static TActionSequence *CreateWriteMemberWiseActions(TVirtualStreamerInfo *info, TVirtualCollectionProxy &proxy);
       TActionSequence *CreateSubSequence(const std::vector<Int_t> &element_ids, size_t offset);
+      TActionSequence *CreateProjection(const std::vector<std::string> &members);
 
       TActionSequence *CreateSubSequence(const TIDs &element_ids, size_t offset, SequenceGetter_t create);
       void AddToSubSequence(TActionSequence *sequence, const TIDs &element_ids, Int_t offset, SequenceGetter_t create);
@@ -0,0 +1,262 @@
+// @(#)root/io:$Id$
+
+/*************************************************************************
+ * Copyright (C) 1995-2021, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#include "ROOT/RBlockCache.hxx"
+
+#include "TEnv.h"
+#include "TError.h"
+#include "TMD5.h"
+#include "TString.h"
+#include "TSystem.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <ctime>
+#include <memory>
+#include <vector>
+
+namespace {
+/// An eviction lock older than this, in seconds, was left by a crashed process and is removed, as by TLockFile
+constexpr long kLockTimeLimit = 60;
+
+struct RCachedBlock {
+   std::string fPath;
+   Long64_t fSize;
+   Long_t fModTime;
+};
+} // anonymous namespace
+
+ROOT::Internal::RBlockCache::RBlockCache(std::string_view directory, std::uint64_t maxSize, std::size_t blockSize)
+   : fDirectory(directory), fMaxSize(maxSize), fBlockSize(std::max<std::size_t>(blockSize, 1))
+{
+}
+
+ROOT::Internal::RBlockCache *ROOT::Internal::RBlockCache::Get()
+{
+   static std::unique_ptr<RBlockCache> cache = []() -> std::unique_ptr<RBlockCache> {
+      TString directory = gEnv->GetValue("TFile.BlockCacheDir", "");
+      if (directory.IsNull())
+         return nullptr;
+      gSystem->ExpandPathName(directory);
+      if (gSystem->AccessPathName(directory) && gSystem->mkdir(directory, kTRUE) != 0) {
+         ::Error("RBlockCache::Get", "cannot create the block cache directory %s", directory.Data());
+         return nullptr;
+      }
+      const std::uint64_t maxSize = std::max(gEnv->GetValue("TFile.BlockCacheSize", 10240), 1);
+      const std::size_t blockSize = std::max(gEnv->GetValue("TFile.BlockCacheBlockSize", 256), 1);
+      return std::unique_ptr<RBlockCache>(new RBlockCache(directory.Data(), maxSize * 1024 * 1024, blockSize * 1024));
+   }();
+   return cache.get();
+}
+
+std::string ROOT::Internal::RBlockCache::GetBlockPath(std::string_view fileId, std::uint64_t blockIdx) const
+{
+   std::string key(fileId);
+   key += ":" + std::to_string(fBlockSize) + ":" + std::to_string(blockIdx);
+   TMD5 md5;
+   md5.Update(reinterpret_cast<const UChar_t *>(key.data()), key.size());
+   md5.Final();
+   const std::string name = md5.AsString();
+   // Spread the blocks over 256 subdirectories
+   return fDirectory + "/" + name.substr(0, 2) + "/" + name;
+}
+
+/// Read a block of the given size, and mark it as recently used. Incomplete blocks are ignored.
+bool ROOT::Internal::RBlockCache::LoadBlock(const std::string &path, unsigned char *buffer, std::size_t size)
+{
+   std::FILE *file = std::fopen(path.c_str(), "rb");
+   if (!file)
+      return false;
+   const bool complete = std::fread(buffer, 1, size, file) == size && std::fgetc(file) == EOF;
+   std::fclose(file);
+   if (!complete)
+      return false;
+   gSystem->Utime(path.c_str(), std::time(nullptr), 0);
+   return true;
+}
+
+/// Write a block to a temporary file, renamed to path once complete.
+void ROOT::Internal::RBlockCache::StoreBlock(const std::string &path, const unsigned char *buffer, std::size_t size)
+{
+   static std::atomic<unsigned int> gNTemporaries{0};
+
+   const std::string directory = path.substr(0, path.rfind('/'));
+   if (gSystem->AccessPathName(directory.c_str()))
+      gSystem->mkdir(directory.c_str(), kTRUE);
+
+   // Unique within the node, so that the processes and threads writing the same block do not interfere
+   const std::string tmpPath =
+      path + ".tmp." + std::to_string(gSystem->GetPid()) + "." + std::to_string(gNTemporaries++);
+   std::FILE *file = std::fopen(tmpPath.c_str(), "wb");
+   if (!file)
+      return;
+   bool written = std::fwrite(buffer, 1, size, file) == size;
+   written = (std::fclose(file) == 0) && written;
+   if (!written || gSystem->Rename(tmpPath.c_str(), path.c_str()) != 0) {
+      gSystem->Unlink(tmpPath.c_str());
+      return;
+   }
+
+   if ((fBytesWritten += size) > fMaxSize / 10)
+      Evict();
+}
+
+/// Remove the least recently used blocks until the cache is below 90% of its size limit. Does nothing if another
+/// thread or process is already evicting blocks.
+void ROOT::Internal::RBlockCache::Evict()
+{
+   fBytesWritten = 0;
+
+   const std::string lockPath = fDirectory + "/.lock";
+   FileStat_t lockStat;
+   if (gSystem->GetPathInfo(lockPath.c_str(), lockStat) == 0) {
+      if (std::time(nullptr) - lockStat.fMtime <= kLockTimeLimit)
+         return;
+      gSystem->Unlink(lockPath.c_str());
+   }
+   // Exclusive creation, fails if another process took the lock in the meantime
+   std::FILE *lock = std::fopen(lockPath.c_str(), "wx");
+   if (!lock)
+      return;
+   std::fclose(lock);
+
+   std::vector<RCachedBlock> blocks;
+   std::uint64_t totalSize = 0;
+   if (void *topDir = gSystem->OpenDirectory(fDirectory.c_str())) {
+      while (const char *subDirName = gSystem->GetDirEntry(topDir)) {
+         if (subDirName[0] == '.')
+            continue;
+         const std::string subDirPath = fDirectory + "/" + subDirName;
+         void *subDir = gSystem->OpenDirectory(subDirPath.c_str());
+         if (!subDir)
+            continue;
+         while (const char *blockName = gSystem->GetDirEntry(subDir)) {
+            if (blockName[0] == '.')
+               continue;
+            const std::string blockPath = subDirPath + "/" + blockName;
+            FileStat_t stat;
+            if (gSystem->GetPathInfo(blockPath.c_str(), stat) == 0 && !R_ISDIR(stat.fMode)) {
+               blocks.push_back({blockPath, stat.fSize, stat.fMtime});
+               totalSize += stat.fSize;
+            }
+         }
+         gSystem->FreeDirectory(subDir);
+      }
+      gSystem->FreeDirectory(topDir);
+   }
+
+   if (totalSize > fMaxSize) {
+      std::sort(blocks.begin(), blocks.end(),
+                [](const RCachedBlock &a, const RCachedBlock &b) { return a.fModTime < b.fModTime; });
+      const std::uint64_t targetSize = fMaxSize / 10 * 9;
+      for (const auto &block : blocks) {
+         if (totalSize <= targetSize)
+            break;
+         if (gSystem->Unlink(block.fPath.c_str()) == 0) {
+            totalSize -= block.fSize;
+            ++fNEvicted;
+         }
+      }
+   }
+
+   gSystem->Unlink(lockPath.c_str());
+}
+
+bool ROOT::Internal::RBlockCache::ReadV(std::string_view fileId, std::uint64_t fileSize, RRawFile::RIOVec *ioVec,
+                                        unsigned int nReq, const FetchFunc_t &fetch)
+{
+   // The blocks covering the ranges, in increasing order
+   std::vector<std::uint64_t> blockIdxs;
+   for (unsigned int i = 0; i < nReq; ++i) {
+      const std::uint64_t offset = ioVec[i].fOffset;
+      if (ioVec[i].fSize == 0 || offset >= fileSize)
+         continue;
+      const std::uint64_t end = std::min<std::uint64_t>(offset + ioVec[i].fSize, fileSize);
+      for (std::uint64_t idx = offset / fBlockSize; idx <= (end - 1) / fBlockSize; ++idx)
+         blockIdxs.push_back(idx);
+   }
+   std::sort(blockIdxs.begin(), blockIdxs.end());
+   blockIdxs.erase(std::unique(blockIdxs.begin(), blockIdxs.end()), blockIdxs.end());
+
+   // Load the cached blocks, and read the others from the remote file
+   std::unique_ptr<unsigned char[]> data(new unsigned char[blockIdxs.size() * fBlockSize]);
+   std::vector<std::size_t> validBytes(blockIdxs.size());
+   std::vector<RRawFile::RIOVec> missing;
+   std::vector<std::size_t> missingSlots;
+   std::vector<std::string> missingPaths;
+   for (std::size_t slot = 0; slot < blockIdxs.size(); ++slot) {
+      const std::uint64_t blockOffset = blockIdxs[slot] * fBlockSize;
+      const std::size_t blockSize = std::min<std::uint64_t>(fBlockSize, fileSize - blockOffset);
+      unsigned char *buffer = data.get() + slot * fBlockSize;
+      std::string path = GetBlockPath(fileId, blockIdxs[slot]);
+      if (LoadBlock(path, buffer, blockSize)) {
+         validBytes[slot] = blockSize;
+         ++fNHits;
+         fBytesFromCache += blockSize;
+         continue;
+      }
+      RRawFile::RIOVec request;
+      request.fBuffer = buffer;
+      request.fOffset = blockOffset;
+      request.fSize = blockSize;
+      missing.push_back(request);
+      missingSlots.push_back(slot);
+      missingPaths.emplace_back(std::move(path));
+   }
+   if (!missing.empty()) {
+      if (!fetch(missing.data(), missing.size()))
+         return false;
+      fNMisses += missing.size();
+      for (std::size_t j = 0; j < missing.size(); ++j) {
+         validBytes[missingSlots[j]] = missing[j].fOutBytes;
+         fBytesFromRemote += missing[j].fOutBytes;
+         // A short read means that the file changed since its size was taken; the block is not cached
+         if (missing[j].fOutBytes == missing[j].fSize)
+            StoreBlock(missingPaths[j], static_cast<unsigned char *>(missing[j].fBuffer), missing[j].fSize);
+      }
+   }
+
+   // Copy the ranges out of the blocks
+   for (unsigned int i = 0; i < nReq; ++i) {
+      ioVec[i].fOutBytes = 0;
+      std::uint64_t pos = ioVec[i].fOffset;
+      if (ioVec[i].fSize == 0 || pos >= fileSize)
+         continue;
+      const std::uint64_t end = std::min<std::uint64_t>(pos + ioVec[i].fSize, fileSize);
+      auto out = static_cast<unsigned char *>(ioVec[i].fBuffer);
+      while (pos < end) {
+         const std::uint64_t idx = pos / fBlockSize;
+         const std::size_t slot = std::lower_bound(blockIdxs.begin(), blockIdxs.end(), idx) - blockIdxs.begin();
+         const std::size_t inBlock = pos - idx * fBlockSize;
+         const std::size_t wanted = std::min<std::uint64_t>(fBlockSize - inBlock, end - pos);
+         const std::size_t available = validBytes[slot] > inBlock ? validBytes[slot] - inBlock : 0;
+         const std::size_t n = std::min(wanted, available);
+         memcpy(out, data.get() + slot * fBlockSize + inBlock, n);
+         out += n;
+         pos += n;
+         ioVec[i].fOutBytes += n;
+         if (n < wanted)
+            break;
+      }
+   }
+   return true;
+}
+
+ROOT::Internal::RBlockCache::RMetrics ROOT::Internal::RBlockCache::GetMetrics() const
+{
+   RMetrics metrics;
+   metrics.fNHits = fNHits;
+   metrics.fNMisses = fNMisses;
+   metrics.fBytesFromCache = fBytesFromCache;
+   metrics.fBytesFromRemote = fBytesFromRemote;
+   metrics.fNEvicted = fNEvicted;
+   return metrics;
+}
@@ -9,6 +9,7 @@
  * For the list of contributors see $ROOTSYS/README/CREDITS.             *
  *************************************************************************/
 
+#include <ROOT/RBlockCache.hxx>
 #include <ROOT/RConfig.h>
 #include <ROOT/RRawFile.hxx>
 #ifdef _WIN32
@@ -80,14 +81,17 @@ ROOT::Internal::RRawFile::Create(std::string_view url, ROptions options)
       return std::unique_ptr<RRawFile>(new RRawFileUnix(url, options));
 #endif
    }
-   if (transport == "http" || transport == "https") {
-      if (TPluginHandler *h = gROOT->GetPluginManager()->FindHandler("ROOT::Internal::RRawFile")) {
+   // Remote files are read by plugins: RRawFileDavix for HTTP and S3, RRawFileNetXNG for XRootD
+   if (transport == "http" || transport == "https" || transport == "s3" || transport == "s3s" ||
+       transport == "root" || transport == "roots" || transport == "xroot") {
+      const std::string urlStr(url);
+      if (TPluginHandler *h = gROOT->GetPluginManager()->FindHandler("ROOT::Internal::RRawFile", urlStr.c_str())) {
          if (h->LoadPlugin() == 0) {
             return std::unique_ptr<RRawFile>(reinterpret_cast<RRawFile *>(h->ExecPlugin(2, &url, &options)));
          }
-         throw std::runtime_error("Cannot load plugin handler for RRawFileDavix");
+         throw std::runtime_error(std::string("Cannot load plugin handler for ") + h->GetClass());
       }
-      throw std::runtime_error("Cannot find plugin handler for RRawFileDavix");
+      throw std::runtime_error("Cannot find plugin handler for transport protocol: " + transport);
    }
    throw std::runtime_error("Unsupported transport protocol: " + transport);
 }
@@ -167,7 +171,7 @@ size_t ROOT::Internal::RRawFile::ReadAt(void *buffer, size_t nbytes, std::uint64
 
    // "Large" reads are served directly, bypassing the cache
    if (nbytes > static_cast<unsigned int>(fOptions.fBlockSize))
-      return ReadAtImpl(buffer, nbytes, offset);
+      return ReadAtCached(buffer, nbytes, offset);
 
    if (fBufferSpace == nullptr) {
       fBufferSpace = new unsigned char[kNumBlockBuffers * fOptions.fBlockSize];
@@ -195,7 +199,7 @@ size_t ROOT::Internal::RRawFile::ReadAt(void *buffer, size_t nbytes, std::uint64
 
    /// The remaining bytes populate the newly promoted main buffer
    RBlockBuffer *thisBuffer = &fBlockBuffers[fBlockBufferIdx % kNumBlockBuffers];
-   size_t res = ReadAtImpl(thisBuffer->fBuffer, fOptions.fBlockSize, offset);
+   size_t res = ReadAtCached(thisBuffer->fBuffer, fOptions.fBlockSize, offset);
    thisBuffer->fBufferOffset = offset;
    thisBuffer->fBufferSize = res;
    size_t remainingBytes = std::min(res, nbytes);
@@ -209,9 +213,52 @@ void ROOT::Internal::RRawFile::ReadV(RIOVec *ioVec, unsigned int nReq)
    if (!fIsOpen)
       OpenImpl();
    fIsOpen = true;
+
+   if (RBlockCache *cache = GetBlockCache()) {
+      cache->ReadV("url:" + fUrl + ":" + std::to_string(fFileSize), fFileSize, ioVec, nReq,
+                   [this](RIOVec *missing, unsigned int nMissing) {
+                      fIsFetchingBlocks = true;
+                      ReadVImpl(missing, nMissing);
+                      fIsFetchingBlocks = false;
+                      return true;
+                   });
+      return;
+   }
    ReadVImpl(ioVec, nReq);
 }
 
+ROOT::Internal::RBlockCache *ROOT::Internal::RRawFile::GetBlockCache()
+{
+   // The default ReadVImpl reads the missing blocks with ReadAt
+   if (fIsFetchingBlocks || GetTransport(fUrl) == "file")
+      return nullptr;
+   RBlockCache *cache = RBlockCache::Get();
+   // Without the size, the blocks at the end of the file cannot be told from short reads
+   if (!cache || GetSize() == kUnknownFileSize)
+      return nullptr;
+   return cache;
+}
+
+size_t ROOT::Internal::RRawFile::ReadAtCached(void *buffer, size_t nbytes, std::uint64_t offset)
+{
+   RBlockCache *cache = GetBlockCache();
+   if (!cache)
+      return ReadAtImpl(buffer, nbytes, offset);
+
+   RIOVec ioVec;
+   ioVec.fBuffer = buffer;
+   ioVec.fOffset = offset;
+   ioVec.fSize = nbytes;
+   ioVec.fOutBytes = 0;
+   cache->ReadV("url:" + fUrl + ":" + std::to_string(fFileSize), fFileSize, &ioVec, 1,
+                [this](RIOVec *missing, unsigned int nMissing) {
+                   for (unsigned int i = 0; i < nMissing; ++i)
+                      missing[i].fOutBytes = ReadAtImpl(missing[i].fBuffer, missing[i].fSize, missing[i].fOffset);
+                   return true;
+                });
+   return ioVec.fOutBytes;
+}
+
 bool ROOT::Internal::RRawFile::Readln(std::string &line)
 {
    if (fOptions.fLineBreak == ELineBreaks::kAuto) {
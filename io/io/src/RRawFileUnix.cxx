@@ -118,7 +118,11 @@ void ROOT::Internal::RRawFileUnix::ReadVImpl(RIOVec *ioVec, unsigned int nReq)
    thread_local bool uring_failed = false;
    if (!uring_failed) {
       try {
-         RIoUring ring; // throws std::runtime_error
+         if (!fIoUring) {
+            fIoUring = std::make_unique<RIoUring>(); // throws std::runtime_error
+            // Failure to register the file is not fatal, reads will then use the plain file descriptor
+            fIoUring->RegisterFile(fFileDes);
+         }
          std::vector<RIoUring::RReadEvent> reads;
          reads.reserve(nReq);
          for (std::size_t i = 0; i < nReq; ++i) {
@@ -129,7 +133,7 @@ void ROOT::Internal::RRawFileUnix::ReadVImpl(RIOVec *ioVec, unsigned int nReq)
             ev.fFileDes = fFileDes;
             reads.push_back(ev);
          }
-         ring.SubmitReadsAndWait(reads.data(), nReq);
+         fIoUring->SubmitReadsAndWait(reads.data(), nReq);
          for (std::size_t i = 0; i < nReq; ++i) {
             ioVec[i].fOutBytes = reads.at(i).fOutBytes;
          }
@@ -139,6 +143,7 @@ void ROOT::Internal::RRawFileUnix::ReadVImpl(RIOVec *ioVec, unsigned int nReq)
          Warning("RIoUring", "io_uring is unexpectedly not available because:\n%s", e.what());
          Warning("RRawFileUnix",
               "io_uring setup failed, falling back to blocking I/O in ReadV");
+         fIoUring.reset();
          uring_failed = true;
       }
    }
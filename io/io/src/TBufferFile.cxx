@@ -35,14 +35,7 @@ The concrete implementation of TBuffer for writing/reading to/from a ROOT file o
 #include "TInterpreter.h"
 #include "TVirtualMutex.h"
 
-#if (defined(__linux) || defined(__APPLE__)) && defined(__i386__) && \
-     defined(__GNUC__)
-#define USE_BSWAPCPY
-#endif
-
-#ifdef USE_BSWAPCPY
-#include "Bswapcpy.h"
-#endif
+#include "ROOT/RByteSwap.hxx"
 
 
 const UInt_t kNewClassTag       = 0xFFFFFFFF;
@@ -761,13 +754,8 @@ Int_t TBufferFile::ReadArray(Short_t *&h)
    if (!h) h = new Short_t[n];
 
 #ifdef R__BYTESWAP
-# ifdef USE_BSWAPCPY
-   bswapcpy16(h, fBufCur, n);
+   ROOT::Internal::ByteSwapCopy16(h, fBufCur, n);
    fBufCur += l;
-# else
-   for (int i = 0; i < n; i++)
-      frombuf(fBufCur, &h[i]);
-# endif
 #else
    memcpy(h, fBufCur, l);
    fBufCur += l;
@@ -794,13 +782,8 @@ Int_t TBufferFile::ReadArray(Int_t *&ii)
    if (!ii) ii = new Int_t[n];
 
 #ifdef R__BYTESWAP
-# ifdef USE_BSWAPCPY
-   bswapcpy32(ii, fBufCur, n);
+   ROOT::Internal::ByteSwapCopy32(ii, fBufCur, n);
    fBufCur += l;
-# else
-   for (int i = 0; i < n; i++)
-      frombuf(fBufCur, &ii[i]);
-# endif
 #else
    memcpy(ii, fBufCur, l);
    fBufCur += l;
@@ -853,8 +836,8 @@ Int_t TBufferFile::ReadArray(Long64_t *&ll)
    if (!ll) ll = new Long64_t[n];
 
 #ifdef R__BYTESWAP
-   for (int i = 0; i < n; i++)
-      frombuf(fBufCur, &ll[i]);
+   ROOT::Internal::ByteSwapCopy64(ll, fBufCur, n);
+   fBufCur += l;
 #else
    memcpy(ll, fBufCur, l);
    fBufCur += l;
@@ -881,13 +864,8 @@ Int_t TBufferFile::ReadArray(Float_t *&f)
    if (!f) f = new Float_t[n];
 
 #ifdef R__BYTESWAP
-# ifdef USE_BSWAPCPY
-   bswapcpy32(f, fBufCur, n);
+   ROOT::Internal::ByteSwapCopy32(f, fBufCur, n);
    fBufCur += l;
-# else
-   for (int i = 0; i < n; i++)
-      frombuf(fBufCur, &f[i]);
-# endif
 #else
    memcpy(f, fBufCur, l);
    fBufCur += l;
@@ -914,8 +892,8 @@ Int_t TBufferFile::ReadArray(Double_t *&d)
    if (!d) d = new Double_t[n];
 
 #ifdef R__BYTESWAP
-   for (int i = 0; i < n; i++)
-      frombuf(fBufCur, &d[i]);
+   ROOT::Internal::ByteSwapCopy64(d, fBufCur, n);
+   fBufCur += l;
 #else
    memcpy(d, fBufCur, l);
    fBufCur += l;
@@ -1034,13 +1012,8 @@ Int_t TBufferFile::ReadStaticArray(Short_t *h)
    if (!h) return 0;
 
 #ifdef R__BYTESWAP
-# ifdef USE_BSWAPCPY
-   bswapcpy16(h, fBufCur, n);
+   ROOT::Internal::ByteSwapCopy16(h, fBufCur, n);
    fBufCur += l;
-# else
-   for (int i = 0; i < n; i++)
-      frombuf(fBufCur, &h[i]);
-# endif
 #else
    memcpy(h, fBufCur, l);
    fBufCur += l;
@@ -1066,13 +1039,8 @@ Int_t TBufferFile::ReadStaticArray(Int_t *ii)
    if (!ii) return 0;
 
 #ifdef R__BYTESWAP
-# ifdef USE_BSWAPCPY
-   bswapcpy32(ii, fBufCur, n);
+   ROOT::Internal::ByteSwapCopy32(ii, fBufCur, n);
    fBufCur += sizeof(Int_t)*n;
-# else
-   for (int i = 0; i < n; i++)
-      frombuf(fBufCur, &ii[i]);
-# endif
 #else
    memcpy(ii, fBufCur, l);
    fBufCur += l;
@@ -1123,8 +1091,8 @@ Int_t TBufferFile::ReadStaticArray(Long64_t *ll)
    if (!ll) return 0;
 
 #ifdef R__BYTESWAP
-   for (int i = 0; i < n; i++)
-      frombuf(fBufCur, &ll[i]);
+   ROOT::Internal::ByteSwapCopy64(ll, fBufCur, n);
+   fBufCur += l;
 #else
    memcpy(ll, fBufCur, l);
    fBufCur += l;
@@ -1150,13 +1118,8 @@ Int_t TBufferFile::ReadStaticArray(Float_t *f)
    if (!f) return 0;
 
 #ifdef R__BYTESWAP
-# ifdef USE_BSWAPCPY
-   bswapcpy32(f, fBufCur, n);
+   ROOT::Internal::ByteSwapCopy32(f, fBufCur, n);
    fBufCur += sizeof(Float_t)*n;
-# else
-   for (int i = 0; i < n; i++)
-      frombuf(fBufCur, &f[i]);
-# endif
 #else
    memcpy(f, fBufCur, l);
    fBufCur += l;
@@ -1182,8 +1145,8 @@ Int_t TBufferFile::ReadStaticArray(Double_t *d)
    if (!d) return 0;
 
 #ifdef R__BYTESWAP
-   for (int i = 0; i < n; i++)
-      frombuf(fBufCur, &d[i]);
+   ROOT::Internal::ByteSwapCopy64(d, fBufCur, n);
+   fBufCur += l;
 #else
    memcpy(d, fBufCur, l);
    fBufCur += l;
@@ -1300,13 +1263,8 @@ void TBufferFile::ReadFastArray(Short_t *h, Int_t n)
    if (n <= 0 || l > fBufSize) return;
 
 #ifdef R__BYTESWAP
-# ifdef USE_BSWAPCPY
-   bswapcpy16(h, fBufCur, n);
+   ROOT::Internal::ByteSwapCopy16(h, fBufCur, n);
    fBufCur += sizeof(Short_t)*n;
-# else
-   for (int i = 0; i < n; i++)
-      frombuf(fBufCur, &h[i]);
-# endif
 #else
    memcpy(h, fBufCur, l);
    fBufCur += l;
@@ -1322,13 +1280,8 @@ void TBufferFile::ReadFastArray(Int_t *ii, Int_t n)
    if (l <= 0 || l > fBufSize) return;
 
 #ifdef R__BYTESWAP
-# ifdef USE_BSWAPCPY
-   bswapcpy32(ii, fBufCur, n);
+   ROOT::Internal::ByteSwapCopy32(ii, fBufCur, n);
    fBufCur += sizeof(Int_t)*n;
-# else
-   for (int i = 0; i < n; i++)
-      frombuf(fBufCur, &ii[i]);
-# endif
 #else
    memcpy(ii, fBufCur, l);
    fBufCur += l;
@@ -1360,8 +1313,8 @@ void TBufferFile::ReadFastArray(Long64_t *ll, Int_t n)
    if (l <= 0 || l > fBufSize) return;
 
 #ifdef R__BYTESWAP
-   for (int i = 0; i < n; i++)
-      frombuf(fBufCur, &ll[i]);
+   ROOT::Internal::ByteSwapCopy64(ll, fBufCur, n);
+   fBufCur += l;
 #else
    memcpy(ll, fBufCur, l);
    fBufCur += l;
@@ -1377,13 +1330,8 @@ void TBufferFile::ReadFastArray(Float_t *f, Int_t n)
    if (l <= 0 || l > fBufSize) return;
 
 #ifdef R__BYTESWAP
-# ifdef USE_BSWAPCPY
-   bswapcpy32(f, fBufCur, n);
+   ROOT::Internal::ByteSwapCopy32(f, fBufCur, n);
    fBufCur += sizeof(Float_t)*n;
-# else
-   for (int i = 0; i < n; i++)
-      frombuf(fBufCur, &f[i]);
-# endif
 #else
    memcpy(f, fBufCur, l);
    fBufCur += l;
@@ -1399,8 +1347,8 @@ void TBufferFile::ReadFastArray(Double_t *d, Int_t n)
    if (l <= 0 || l > fBufSize) return;
 
 #ifdef R__BYTESWAP
-   for (int i = 0; i < n; i++)
-      frombuf(fBufCur, &d[i]);
+   ROOT::Internal::ByteSwapCopy64(d, fBufCur, n);
+   fBufCur += l;
 #else
    memcpy(d, fBufCur, l);
    fBufCur += l;
@@ -1733,13 +1681,8 @@ void TBufferFile::WriteArray(const Short_t *h, Int_t n)
    if (fBufCur + l > fBufMax) AutoExpand(fBufSize+l);
 
 #ifdef R__BYTESWAP
-# ifdef USE_BSWAPCPY
-   bswapcpy16(fBufCur, h, n);
+   ROOT::Internal::ByteSwapCopy16(fBufCur, h, n);
    fBufCur += l;
-# else
-   for (int i = 0; i < n; i++)
-      tobuf(fBufCur, h[i]);
-# endif
 #else
    memcpy(fBufCur, h, l);
    fBufCur += l;
@@ -1763,13 +1706,8 @@ void TBufferFile::WriteArray(const Int_t *ii, Int_t n)
    if (fBufCur + l > fBufMax) AutoExpand(fBufSize+l);
 
 #ifdef R__BYTESWAP
-# ifdef USE_BSWAPCPY
-   bswapcpy32(fBufCur, ii, n);
+   ROOT::Internal::ByteSwapCopy32(fBufCur, ii, n);
    fBufCur += l;
-# else
-   for (int i = 0; i < n; i++)
-      tobuf(fBufCur, ii[i]);
-# endif
 #else
    memcpy(fBufCur, ii, l);
    fBufCur += l;
@@ -1831,8 +1769,8 @@ void TBufferFile::WriteArray(const Long64_t *ll, Int_t n)
    if (fBufCur + l > fBufMax) AutoExpand(fBufSize+l);
 
 #ifdef R__BYTESWAP
-   for (int i = 0; i < n; i++)
-      tobuf(fBufCur, ll[i]);
+   ROOT::Internal::ByteSwapCopy64(fBufCur, ll, n);
+   fBufCur += l;
 #else
    memcpy(fBufCur, ll, l);
    fBufCur += l;
@@ -1856,13 +1794,8 @@ void TBufferFile::WriteArray(const Float_t *f, Int_t n)
    if (fBufCur + l > fBufMax) AutoExpand(fBufSize+l);
 
 #ifdef R__BYTESWAP
-# ifdef USE_BSWAPCPY
-   bswapcpy32(fBufCur, f, n);
+   ROOT::Internal::ByteSwapCopy32(fBufCur, f, n);
    fBufCur += l;
-# else
-   for (int i = 0; i < n; i++)
-      tobuf(fBufCur, f[i]);
-# endif
 #else
    memcpy(fBufCur, f, l);
    fBufCur += l;
@@ -1886,8 +1819,8 @@ void TBufferFile::WriteArray(const Double_t *d, Int_t n)
    if (fBufCur + l > fBufMax) AutoExpand(fBufSize+l);
 
 #ifdef R__BYTESWAP
-   for (int i = 0; i < n; i++)
-      tobuf(fBufCur, d[i]);
+   ROOT::Internal::ByteSwapCopy64(fBufCur, d, n);
+   fBufCur += l;
 #else
    memcpy(fBufCur, d, l);
    fBufCur += l;
@@ -1999,13 +1932,8 @@ void TBufferFile::WriteFastArray(const Short_t *h, Int_t n)
    if (fBufCur + l > fBufMax) AutoExpand(fBufSize+l);
 
 #ifdef R__BYTESWAP
-# ifdef USE_BSWAPCPY
-   bswapcpy16(fBufCur, h, n);
+   ROOT::Internal::ByteSwapCopy16(fBufCur, h, n);
    fBufCur += l;
-# else
-   for (int i = 0; i < n; i++)
-      tobuf(fBufCur, h[i]);
-# endif
 #else
    memcpy(fBufCur, h, l);
    fBufCur += l;
@@ -2023,13 +1951,8 @@ void TBufferFile::WriteFastArray(const Int_t *ii, Int_t n)
    if (fBufCur + l > fBufMax) AutoExpand(fBufSize+l);
 
 #ifdef R__BYTESWAP
-# ifdef USE_BSWAPCPY
-   bswapcpy32(fBufCur, ii, n);
+   ROOT::Internal::ByteSwapCopy32(fBufCur, ii, n);
    fBufCur += l;
-# else
-   for (int i = 0; i < n; i++)
-      tobuf(fBufCur, ii[i]);
-# endif
 #else
    memcpy(fBufCur, ii, l);
    fBufCur += l;
@@ -2075,8 +1998,8 @@ void TBufferFile::WriteFastArray(const Long64_t *ll, Int_t n)
    if (fBufCur + l > fBufMax) AutoExpand(fBufSize+l);
 
 #ifdef R__BYTESWAP
-   for (int i = 0; i < n; i++)
-      tobuf(fBufCur, ll[i]);
+   ROOT::Internal::ByteSwapCopy64(fBufCur, ll, n);
+   fBufCur += l;
 #else
    memcpy(fBufCur, ll, l);
    fBufCur += l;
@@ -2094,13 +2017,8 @@ void TBufferFile::WriteFastArray(const Float_t *f, Int_t n)
    if (fBufCur + l > fBufMax) AutoExpand(fBufSize+l);
 
 #ifdef R__BYTESWAP
-# ifdef USE_BSWAPCPY
-   bswapcpy32(fBufCur, f, n);
+   ROOT::Internal::ByteSwapCopy32(fBufCur, f, n);
    fBufCur += l;
-# else
-   for (int i = 0; i < n; i++)
-      tobuf(fBufCur, f[i]);
-# endif
 #else
    memcpy(fBufCur, f, l);
    fBufCur += l;
@@ -2118,8 +2036,8 @@ void TBufferFile::WriteFastArray(const Double_t *d, Int_t n)
    if (fBufCur + l > fBufMax) AutoExpand(fBufSize+l);
 
 #ifdef R__BYTESWAP
-   for (int i = 0; i < n; i++)
-      tobuf(fBufCur, d[i]);
+   ROOT::Internal::ByteSwapCopy64(fBufCur, d, n);
+   fBufCur += l;
 #else
    memcpy(fBufCur, d, l);
    fBufCur += l;
@@ -616,6 +616,22 @@ Bool_t TBufferJSON::IsSkipClassInfo(const TClass *cl) const
    return cl && (std::find(fSkipClasses.begin(), fSkipClasses.end(), cl) != fSkipClasses.end());
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Configure sink which receives produced JSON code in chunks of (at least) chunk_size bytes
+/// Main output buffer is passed to the sink and cleared when it exceeds chunk_size, therefore
+/// the complete JSON is never kept in memory. Useful for big objects like TH2 or TGraph with many points,
+/// which can be directly written into file or network socket.
+/// Must be called before StoreObject(), which then returns an empty string.
+/// See also TBufferJSON::ConvertToJSON(std::ostream &, const void *, const TClass *, Int_t)
+
+void TBufferJSON::SetOutputSink(OutputSink_t sink, Int_t chunk_size)
+{
+   fOutputSink = std::move(sink);
+   fSinkChunkSize = chunk_size > 0 ? chunk_size : 0x10000;
+   if (fOutputSink)
+      fOutBuffer.Capacity(fSinkChunkSize + 1000);
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Converts any type of object to JSON string
 /// One should provide pointer on object and its class name
@@ -712,6 +728,14 @@ TString TBufferJSON::StoreObject(const void *obj, const TClass *cl)
       Error("StoreObject", "Can not store object into TBuffer for reading");
    }
 
+   if (fOutputSink) {
+      // special classes like TArray or STL containers keep complete output in the value
+      if ((fSinkLength == 0) && (fOutBuffer.Length() == 0))
+         fOutBuffer.Swap(fValue);
+      FlushOutput();
+      return TString();
+   }
+
    return fOutBuffer.Length() ? fOutBuffer : fValue;
 }
 
@@ -743,6 +767,60 @@ TString TBufferJSON::ConvertToJSON(const void *ptr, TDataMember *member, Int_t c
    return buf.JsonWriteMember(ptr, member, mcl, arraylen);
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Converts object, inherited from TObject class, to JSON and writes it into the stream
+/// JSON code is produced in chunks and never kept completely in memory
+/// Returns length of produced JSON code
+/// See TBufferJSON::ConvertToJSON(const void *, const TClass *, Int_t, const char *) for compact parameter
+
+Long64_t TBufferJSON::ConvertToJSON(std::ostream &out, const TObject *obj, Int_t compact)
+{
+   TClass *clActual = nullptr;
+   void *ptr = (void *)obj;
+
+   if (obj) {
+      clActual = TObject::Class()->GetActualClass(obj);
+      if (!clActual)
+         clActual = TObject::Class();
+      else if (clActual != TObject::Class())
+         ptr = (void *)((Longptr_t)obj - clActual->GetBaseClassOffset(TObject::Class()));
+   }
+
+   return ConvertToJSON(out, ptr, clActual, compact);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Converts any type of object to JSON and writes it into the stream
+/// JSON code is produced in chunks and never kept completely in memory.
+/// For big numeric arrays like histogram bins, TBufferJSON::kBase64 compression
+/// reduces both size of JSON and time of conversion, such JSON directly supported by JSROOT.
+/// Returns length of produced JSON code
+///
+///   std::ofstream ofs("h2.json");
+///   TBufferJSON::ConvertToJSON(ofs, h2, TH2D::Class(), TBufferJSON::kNoSpaces + TBufferJSON::kBase64);
+///
+
+Long64_t TBufferJSON::ConvertToJSON(std::ostream &out, const void *obj, const TClass *cl, Int_t compact)
+{
+   TClass *clActual = obj ? cl->GetActualClass(obj) : nullptr;
+   const void *actualStart = obj;
+   if (clActual && (clActual != cl)) {
+      actualStart = (char *)obj - clActual->GetBaseClassOffset(cl);
+   } else {
+      clActual = const_cast<TClass *>(cl);
+   }
+
+   TBufferJSON buf;
+
+   buf.SetCompact(compact);
+
+   buf.SetOutputSink([&out](const char *data, Int_t len) { out.write(data, len); });
+
+   buf.StoreObject(actualStart, clActual);
+
+   return buf.fSinkLength;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Convert object into JSON and store in text file
 /// Returns size of the produce file
@@ -757,6 +835,12 @@ Int_t TBufferJSON::ExportToFile(const char *filename, const TObject *obj, const
    if (option && (*option >= '0') && (*option <= '3'))
       compact = TString(option).Atoi();
 
+   if (!strstr(filename, ".json.gz")) {
+      // plain JSON written directly into the file without intermediate string
+      std::ofstream ofs(filename);
+      return TBufferJSON::ConvertToJSON(ofs, obj, compact);
+   }
+
    TString json = TBufferJSON::ConvertToJSON(obj, compact);
 
    std::ofstream ofs(filename);
@@ -837,6 +921,12 @@ Int_t TBufferJSON::ExportToFile(const char *filename, const void *obj, const TCl
    if (option && (*option >= '0') && (*option <= '3'))
       compact = TString(option).Atoi();
 
+   if (!strstr(filename, ".json.gz")) {
+      // plain JSON written directly into the file without intermediate string
+      std::ofstream ofs(filename);
+      return TBufferJSON::ConvertToJSON(ofs, obj, cl, compact);
+   }
+
    TString json = TBufferJSON::ConvertToJSON(obj, cl, compact);
 
    std::ofstream ofs(filename);
@@ -1170,6 +1260,21 @@ void TBufferJSON::AppendOutput(const char *line0, const char *line1)
          fOutput->Append(line1);
       }
    }
+
+   if (fOutputSink && (fOutput == &fOutBuffer) && (fOutBuffer.Length() >= fSinkChunkSize))
+      FlushOutput();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Pass content of main output buffer to the sink and clear it
+
+void TBufferJSON::FlushOutput()
+{
+   if (fOutBuffer.Length() == 0)
+      return;
+   fOutputSink(fOutBuffer.Data(), fOutBuffer.Length());
+   fSinkLength += fOutBuffer.Length();
+   fOutBuffer.Clear();
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -827,6 +827,34 @@ const char *TBufferText::GetDoubleFormat()
    return fgDoubleFmt;
 }
 
+namespace {
+
+////////////////////////////////////////////////////////////////////////////////
+/// Print integral floating point value below 1e18, same as snprintf "%1.0f" but much faster
+/// Used for the bin contents and entries, which are very often integral numbers
+
+void ConvertIntegral(Double_t value, char *buf, unsigned len)
+{
+   char digits[24];
+   int n = 0;
+   ULong64_t uvalue = (ULong64_t) std::abs(value);
+   do {
+      digits[n++] = '0' + uvalue % 10;
+      uvalue /= 10;
+   } while (uvalue > 0);
+   if (std::signbit(value))
+      digits[n++] = '-';
+   if ((unsigned) n >= len) {
+      snprintf(buf, len, "%1.0f", value);
+      return;
+   }
+   for (int i = 0; i < n; ++i)
+      buf[i] = digits[n - 1 - i];
+   buf[n] = 0;
+}
+
+} // anonymous namespace
+
 ////////////////////////////////////////////////////////////////////////////////
 /// convert float to string with configured format
 
@@ -835,7 +863,7 @@ const char *TBufferText::ConvertFloat(Float_t value, char *buf, unsigned len, Bo
    if (not_optimize) {
       snprintf(buf, len, fgFloatFmt, value);
    } else if ((value == std::nearbyint(value)) && (std::abs(value) < 1e15)) {
-      snprintf(buf, len, "%1.0f", value);
+      ConvertIntegral(value, buf, len);
    } else {
       snprintf(buf, len, fgFloatFmt, value);
       CompactFloatString(buf, len);
@@ -850,6 +878,8 @@ const char *TBufferText::ConvertDouble(Double_t value, char *buf, unsigned len,
 {
    if (not_optimize) {
       snprintf(buf, len, fgFloatFmt, value);
+   } else if ((value == std::nearbyint(value)) && (std::abs(value) < 1e18)) {
+      ConvertIntegral(value, buf, len);
    } else if ((value == std::nearbyint(value)) && (std::abs(value) < 1e25)) {
       snprintf(buf, len, "%1.0f", value);
    } else {
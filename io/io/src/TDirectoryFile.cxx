@@ -54,6 +54,32 @@ const Int_t  kMaxLen = 2048;
 
 ClassImp(TDirectoryFile);
 
+namespace {
+
+/// Return the first key of the list with the given name for which match(key)
+/// is true, in the order of the list of its hash slot.
+template <typename Match>
+TKey *FindKeyByName(const THashList &keys, const char *name, Match match)
+{
+   // Fast path through the name index of the list: the first key with the name.
+   TObject *first = keys.FindObject(name);
+   if (!first)
+      return nullptr;
+   TKey *key = dynamic_cast<TKey *>(first);
+   if (key && match(key))
+      return key;
+
+   if (const TList *keyList = keys.GetListForObject(name)) {
+      for (auto k: TRangeDynCast<TKey>(*keyList)) {
+         if (k && !strcmp(k->GetName(), name) && match(k))
+            return k;
+      }
+   }
+   return nullptr;
+}
+
+} // namespace
+
 
 ////////////////////////////////////////////////////////////////////////////////
 /// Default TDirectoryFile constructor
@@ -320,7 +346,9 @@ void TDirectoryFile::BuildDirectoryFile(TFile* motherFile, TDirectory* motherDir
    fSeekParent = 0;
    fSeekKeys   = 0;
    fList       = new THashList(100,50);
-   fKeys       = new THashList(100,50);
+   auto keys   = new THashList(100,50);
+   keys->UseNameIndex();
+   fKeys       = keys;
    fList->UseRWLock();
    fMother     = motherDir;
    fFile       = motherFile ? motherFile : TFile::CurrentFile();
@@ -794,14 +822,10 @@ TKey *TDirectoryFile::FindKeyAny(const char *keyname) const
       return nullptr;
    }
 
-   if (const TList *keyList = listOfKeys->GetListForObject(name)) {
-      for (auto key: TRangeDynCast<TKey>(*keyList)) {
-         if (key && !strcmp(key->GetName(), name)
-             && (cycle == 9999 || cycle >= key->GetCycle())) {
-            const_cast<TDirectoryFile*>(this)->cd(); // may be we should not make cd ???
-            return key;
-         }
-      }
+   if (TKey *key = FindKeyByName(*listOfKeys, name,
+                                 [cycle](TKey *k) { return cycle == 9999 || cycle >= k->GetCycle(); })) {
+      const_cast<TDirectoryFile*>(this)->cd(); // may be we should not make cd ???
+      return key;
    }
 
    //try with subdirectories
@@ -967,14 +991,10 @@ TObject *TDirectoryFile::Get(const char *namecycle)
       return nullptr;
    }
 
-   if (const TList *keyList = listOfKeys->GetListForObject(namobj)) {
-      for (auto key: TRangeDynCast<TKey>(*keyList)) {
-         if (key && !strcmp(key->GetName(), namobj)
-             && (cycle == 9999 || cycle == key->GetCycle())) {
-            TDirectory::TContext ctxt(this);
-            return key->ReadObj();
-         }
-      }
+   if (TKey *key = FindKeyByName(*listOfKeys, namobj,
+                                 [cycle](TKey *k) { return cycle == 9999 || cycle == k->GetCycle(); })) {
+      TDirectory::TContext ctxt(this);
+      return key->ReadObj();
    }
 
    return nullptr;
@@ -1090,14 +1110,10 @@ void *TDirectoryFile::GetObjectChecked(const char *namecycle, const TClass* expe
       return nullptr;
    }
 
-   if (const TList *keyList = listOfKeys->GetListForObject(namobj)) {
-      for (auto key: TRangeDynCast<TKey>(*keyList)) {
-         if (key && !strcmp(key->GetName(), namobj)
-             && (cycle == 9999 || cycle == key->GetCycle())) {
-            TDirectory::TContext ctxt(this);
-            return key->ReadObjectAny(expectedClass);
-         }
-      }
+   if (TKey *key = FindKeyByName(*listOfKeys, namobj,
+                                 [cycle](TKey *k) { return cycle == 9999 || cycle == k->GetCycle(); })) {
+      TDirectory::TContext ctxt(this);
+      return key->ReadObjectAny(expectedClass);
    }
 
    return nullptr;
@@ -1131,16 +1147,8 @@ TKey *TDirectoryFile::GetKey(const char *name, Short_t cycle) const
       return nullptr;
    }
 
-   if (const TList *keyList = listOfKeys->GetListForObject(name)) {
-      for (auto key: TRangeDynCast<TKey>(*keyList)) {
-         if (key && !strcmp(key->GetName(), name)
-             && (cycle == 9999 || cycle >= key->GetCycle())) {
-            return key;
-         }
-      }
-   }
-
-   return nullptr;
+   return FindKeyByName(*listOfKeys, name,
+                        [cycle](TKey *k) { return cycle == 9999 || cycle >= k->GetCycle(); });
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -1456,12 +1464,8 @@ Int_t TDirectoryFile::ReadTObject(TObject *obj, const char *keyname)
       return 0;
    }
 
-   if (const TList *keyList = listOfKeys->GetListForObject(keyname)) {
-      for (auto key: TRangeDynCast<TKey>(*keyList)) {
-         if (key && !strcmp(key->GetName(), keyname) ) {
-            return key->Read(obj);
-         }
-      }
+   if (TKey *key = FindKeyByName(*listOfKeys, keyname, [](TKey *) { return true; })) {
+      return key->Read(obj);
    }
 
    Error("ReadTObject","Key not found");
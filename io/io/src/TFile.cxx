@@ -111,6 +111,7 @@ The structure of a directory is shown in TDirectoryFile::TDirectoryFile
 #include "TInterpreter.h"
 #include "TKey.h"
 #include "TMakeProject.h"
+#include "TMemFile.h"
 #include "TPluginManager.h"
 #include "TProcessUUID.h"
 #include "TRegexp.h"
@@ -130,15 +131,24 @@ The structure of a directory is shown in TDirectoryFile::TDirectoryFile
 #include "TObjString.h"
 #include "TStopwatch.h"
 #include "compiledata.h"
+#include "RZip.h"
+#include <algorithm>
 #include <cmath>
 #include <iostream>
+#include <map>
+#include <mutex>
 #include <set>
+#include <vector>
 #include "TSchemaRule.h"
 #include "TSchemaRuleSet.h"
 #include "TThreadSlots.h"
 #include "TGlobal.h"
+#include "ROOT/RBlockCache.hxx"
 #include "ROOT/RConcurrentHashColl.hxx"
+#include "ROOT/RRawFile.hxx"
+#include "ROOT/RTrace.hxx"
 #include <memory>
+#include <stdexcept>
 
 using std::sqrt;
 
@@ -154,9 +164,7 @@ Bool_t   TFile::fgCacheFileForce = kFALSE;
 Bool_t   TFile::fgCacheFileDisconnected = kTRUE;
 UInt_t   TFile::fgOpenTimeout = TFile::kEternalTimeout;
 Bool_t   TFile::fgOnlyStaged = kFALSE;
-#ifdef R__USE_IMT
 ROOT::Internal::RConcurrentHashColl TFile::fgTsSIHashes;
-#endif
 
 const Int_t kBEGIN = 100;
 
@@ -172,7 +180,118 @@ AddPseudoGlobals() {
    TGlobalMappedFunction::MakeFunctor("gFile", "TFile*", TFile::CurrentFile);
 }
 } gAddPseudoGlobals;
+
+/// Name of the key of the dictionary of the ZSTD compression with dictionary.
+const char *kZstdDictionaryKey = "ZSTDDictionary";
+
+/// Set while the dictionary is written, which cannot be compressed with itself.
+thread_local bool gWritingZstdDictionary = false;
+
+/// The slots of the class index set by each StreamerInfo record already
+/// processed, by hash of the record, see TFile::ReadStreamerInfo.
+std::mutex gStreamerInfoRecordsMutex;
+std::map<ROOT::Internal::RConcurrentHashColl::HashValue, std::vector<Int_t>> gStreamerInfoRecords;
 }
+
+namespace ROOT {
+namespace Internal {
+
+////////////////////////////////////////////////////////////////////////////////
+/// \brief The dictionary of the ZSTD compression with dictionary of a file, see
+/// ROOT::RCompressionSetting::EAlgorithm::kZSTDDict.
+///
+/// When writing, the first payloads are compressed without dictionary and kept as samples. Once enough samples are
+/// collected, the dictionary is trained on them and the following payloads are compressed with it. The dictionary is
+/// stored in the file by TFile::WriteStreamerInfo, and registered for the decompression when opening the file. The
+/// dictionary of a file opened in update mode is used for the new payloads as well.
+
+class RZstdFileDictionary {
+   static constexpr std::size_t kMaxSampleSize = 128 * 1024; ///< Larger payloads are truncated to this size
+   static constexpr std::size_t kMinSamples = 64;            ///< Minimum number of samples for the training
+   static constexpr std::size_t kMaxSamples = 1000;          ///< Number of samples that triggers the training
+   static constexpr std::size_t kTrainingSize = 1024 * 1024; ///< Size of the samples that triggers the training
+   static constexpr std::size_t kMaxDictionarySize = 112640; ///< Maximum size of the dictionary, as in the zstd tool
+
+   std::mutex fMutex;
+   std::atomic<unsigned> fID{0}; ///< ID of the registered dictionary, 0 until it is trained
+   std::string fDictionary;
+   std::string fSamples;
+   std::vector<std::size_t> fSampleSizes;
+   bool fTrainingDone = false;
+   bool fStored = false; ///< Whether the dictionary is stored in the file
+
+   void Register(const std::string &dictionary)
+   {
+      fDictionary = dictionary;
+      fID = R__ZSTDAddDictionary(fDictionary.data(), fDictionary.size());
+   }
+
+   void Train()
+   {
+      fTrainingDone = true;
+      std::string dictionary(std::min(kMaxDictionarySize, fSamples.size() / 10), '\0');
+      const int size = R__ZSTDTrainDictionary(fSamples.data(), fSampleSizes.data(), fSampleSizes.size(),
+                                              &dictionary[0], dictionary.size());
+      std::string().swap(fSamples);
+      std::vector<std::size_t>().swap(fSampleSizes);
+      if (size > 0) {
+         dictionary.resize(size);
+         Register(dictionary);
+      }
+   }
+
+public:
+   RZstdFileDictionary() = default;
+   /// Dictionary read from the file.
+   explicit RZstdFileDictionary(const std::string &dictionary) : fTrainingDone(true), fStored(true)
+   {
+      Register(dictionary);
+   }
+   RZstdFileDictionary(const RZstdFileDictionary &) = delete;
+   RZstdFileDictionary &operator=(const RZstdFileDictionary &) = delete;
+   ~RZstdFileDictionary()
+   {
+      if (fID)
+         R__ZSTDReleaseDictionary(fID);
+   }
+
+   unsigned GetID() const { return fID; }
+
+   /// Compress a payload with the dictionary, or collect it as sample and compress it without dictionary.
+   void Compress(int cxlevel, int *srcsize, char *src, int *tgtsize, char *tgt, int *irep)
+   {
+      if (const unsigned id = fID) {
+         R__zipZSTDDictionary(cxlevel, id, srcsize, src, tgtsize, tgt, irep);
+         return;
+      }
+      {
+         std::lock_guard<std::mutex> lock(fMutex);
+         if (!fTrainingDone) {
+            const std::size_t size = std::min<std::size_t>(*srcsize, kMaxSampleSize);
+            fSamples.append(src, size);
+            fSampleSizes.push_back(size);
+            if (fSampleSizes.size() >= kMaxSamples || (fSampleSizes.size() >= kMinSamples && fSamples.size() >= kTrainingSize))
+               Train();
+         }
+      }
+      R__zipMultipleAlgorithm(cxlevel, srcsize, src, tgtsize, tgt, irep, ROOT::RCompressionSetting::EAlgorithm::kZSTD);
+   }
+
+   /// Return whether the dictionary is trained but not stored in the file yet, in which case it is marked as stored.
+   bool TakeDictionaryToStore(std::string &dictionary)
+   {
+      std::lock_guard<std::mutex> lock(fMutex);
+      if (fStored || !fID)
+         return false;
+      fStored = true;
+      dictionary = fDictionary;
+      return true;
+   }
+};
+
+} // namespace Internal
+} // namespace ROOT
+
 ////////////////////////////////////////////////////////////////////////////////
 /// File default Constructor.
 
@@ -853,6 +972,8 @@ void TFile::Init(Bool_t create)
       }
    }
 
+   ReadZstdDictionary();
+
    // Count number of TProcessIDs in this file
    {
       TIter next(fKeys);
@@ -927,6 +1048,8 @@ void TFile::Close(Option_t *option)
    fMustFlush = kFALSE; // Make sure there is only one Flush.
    TDirectoryFile::Close(option);
 
+   delete fZstdDictionary.exchange(nullptr);
+
    if (IsWritable()) {
       TFree *f1 = (TFree*)fFree->First();
       if (f1) {
@@ -981,6 +1104,83 @@ void TFile::Close(Option_t *option)
    }
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Compress a payload of this file, e.g. of a TKey or a TBasket, see R__zipMultipleAlgorithm.
+///
+/// With ROOT::RCompressionSetting::EAlgorithm::kZSTDDict, the payloads are compressed with the ZSTD dictionary
+/// of the file, which is trained on the first payloads. This function can be called concurrently.
+
+void TFile::CompressBuffer(Int_t cxlevel, Int_t *srcsize, char *src, Int_t *tgtsize, char *tgt, Int_t *irep,
+                           ROOT::RCompressionSetting::EAlgorithm::EValues algorithm)
+{
+   // The smallest buffers are not compressed, see R__zipMultipleAlgorithm
+   if (algorithm != ROOT::RCompressionSetting::EAlgorithm::kZSTDDict || cxlevel <= 0 || *srcsize <= 10 ||
+       gWritingZstdDictionary) {
+      R__zipMultipleAlgorithm(cxlevel, srcsize, src, tgtsize, tgt, irep, algorithm);
+      return;
+   }
+
+   auto dictionary = fZstdDictionary.load();
+   if (!dictionary) {
+      auto created = new ROOT::Internal::RZstdFileDictionary();
+      if (fZstdDictionary.compare_exchange_strong(dictionary, created)) {
+         dictionary = created;
+      } else {
+         delete created;
+      }
+   }
+   dictionary->Compress(cxlevel, srcsize, src, tgtsize, tgt, irep);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return the ID of the ZSTD dictionary of this file, or 0 if the file has no dictionary (yet).
+///
+/// The payloads of files with different dictionaries cannot be copied from one file to the other without
+/// decompressing them, see TTreeCloner.
+
+UInt_t TFile::GetZstdDictionaryID() const
+{
+   auto dictionary = fZstdDictionary.load();
+   return dictionary ? dictionary->GetID() : 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Register the ZSTD dictionary stored in the file, if any, for the decompression of its payloads.
+
+void TFile::ReadZstdDictionary()
+{
+   TKey *key = GetKey(kZstdDictionaryKey);
+   if (!key)
+      return;
+   std::unique_ptr<TObjString> content(key->ReadObject<TObjString>());
+   if (!content) {
+      Error("ReadZstdDictionary", "cannot read the ZSTD dictionary of %s", GetName());
+      return;
+   }
+   auto dictionary = new ROOT::Internal::RZstdFileDictionary(std::string(content->String().Data(), content->String().Length()));
+   if (!dictionary->GetID())
+      Error("ReadZstdDictionary", "the ZSTD dictionary of %s is not valid", GetName());
+   delete fZstdDictionary.exchange(dictionary);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Store the ZSTD dictionary, once it is trained, in the file. The dictionary itself is compressed with ZSTD
+/// without dictionary.
+
+void TFile::WriteZstdDictionary()
+{
+   auto dictionary = fZstdDictionary.load();
+   std::string content;
+   if (!dictionary || !dictionary->TakeDictionaryToStore(content))
+      return;
+
+   TObjString key;
+   key.String() = TString(content.data(), content.size());
+   gWritingZstdDictionary = true;
+   WriteTObject(&key, kZstdDictionaryKey);
+   gWritingZstdDictionary = false;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Creates key for object and converts data to buffer.
 
@@ -1322,18 +1522,17 @@ TFile::InfoListRet TFile::GetStreamerInfoListImpl(bool lookupSICache)
          return {nullptr, 1, hash};
       }
 
-#ifdef R__USE_IMT
+      key->ReadKeyBuffer(buf);
       if (lookupSICache) {
-         hash = fgTsSIHashes.Hash(buf, fNbytesInfo);
+         // Skip the header of the key, which differs between files with the same record (e.g. by its date).
+         Int_t keylen = key->GetKeylen();
+         if (keylen <= 0 || keylen > fNbytesInfo) keylen = 0;
+         hash = fgTsSIHashes.Hash(buffer.data() + keylen, fNbytesInfo - keylen);
          if (fgTsSIHashes.Find(hash)) {
             if (gDebug > 0) Info("GetStreamerInfo", "The streamer info record for file %s has already been treated, skipping it.", GetName());
             return {nullptr, 0, hash};
          }
       }
-#else
-      (void) lookupSICache;
-#endif
-      key->ReadKeyBuffer(buf);
       list = dynamic_cast<TList*>(key->ReadObjWithBuffer(buffer.data()));
       if (list) list->SetOwner();
    } else {
@@ -1660,6 +1859,7 @@ Bool_t TFile::ReadBuffer(char *buf, Long64_t pos, Int_t len)
          return kFALSE;
       }
 
+      R__TRACE_SPAN("io", "TFile::ReadBuffer", len);
       Seek(pos);
       ssize_t siz;
 
@@ -1705,6 +1905,7 @@ Bool_t TFile::ReadBuffer(char *buf, Int_t len)
          return kFALSE;
       }
 
+      R__TRACE_SPAN("io", "TFile::ReadBuffer", len);
       ssize_t siz;
       Double_t start = 0;
 
@@ -1757,6 +1958,7 @@ Bool_t TFile::ReadBuffers(char *buf, Long64_t *pos, Int_t *len, Int_t nbuf)
       return kFALSE;
    }
 
+   R__TRACE_SPAN("io", "TFile::ReadBuffers", nbuf);
    Int_t k = 0;
    Bool_t result = kTRUE;
    TFileCacheRead *old = fCacheRead;
@@ -1807,6 +2009,64 @@ Bool_t TFile::ReadBuffers(char *buf, Long64_t *pos, Int_t *len, Int_t nbuf)
    return result;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Read the nbuf blocks of a remote file through the node-wide block cache,
+/// see ROOT::Internal::RBlockCache, if it is enabled with TFile.BlockCacheDir.
+///
+/// The blocks missing from the cache are read with readBuffers, which has the
+/// semantics of ReadBuffers(). The blocks are copied consecutively to buf.
+/// The cache is bypassed for the readahead requests (buf is null), for files
+/// being written and before the UUID of the file, which identifies its blocks
+/// in the cache, is read.
+/// Returns kTRUE in case of failure.
+
+Bool_t TFile::ReadBuffersViaBlockCache(char *buf, Long64_t *pos, Int_t *len, Int_t nbuf,
+                                       const std::function<Bool_t(char *, Long64_t *, Int_t *, Int_t)> &readBuffers)
+{
+   auto cache = ROOT::Internal::RBlockCache::Get();
+   if (!cache || !buf || !fInitDone || IsWritable() || nbuf <= 0)
+      return readBuffers(buf, pos, len, nbuf);
+
+   std::vector<ROOT::Internal::RRawFile::RIOVec> ioVec(nbuf);
+   Long64_t k = 0;
+   for (Int_t i = 0; i < nbuf; i++) {
+      ioVec[i].fBuffer = &buf[k];
+      ioVec[i].fOffset = pos[i];
+      ioVec[i].fSize = len[i];
+      k += len[i];
+   }
+
+   auto fetch = [&readBuffers](ROOT::Internal::RRawFile::RIOVec *missing, unsigned int nMissing) {
+      std::vector<Long64_t> missingPos(nMissing);
+      std::vector<Int_t> missingLen(nMissing);
+      std::size_t total = 0;
+      for (unsigned int i = 0; i < nMissing; i++) {
+         missingPos[i] = missing[i].fOffset;
+         missingLen[i] = missing[i].fSize;
+         total += missing[i].fSize;
+      }
+      // ReadBuffers reads the blocks consecutively in one buffer
+      std::unique_ptr<char[]> tmp(new char[total]);
+      if (readBuffers(tmp.get(), missingPos.data(), missingLen.data(), nMissing))
+         return false;
+      std::size_t offset = 0;
+      for (unsigned int i = 0; i < nMissing; i++) {
+         memcpy(missing[i].fBuffer, tmp.get() + offset, missing[i].fSize);
+         missing[i].fOutBytes = missing[i].fSize;
+         offset += missing[i].fSize;
+      }
+      return true;
+   };
+
+   if (!cache->ReadV(std::string("uuid:") + fUUID.AsString(), fEND, ioVec.data(), nbuf, fetch))
+      return kTRUE;
+   for (Int_t i = 0; i < nbuf; i++) {
+      if (ioVec[i].fOutBytes != ioVec[i].fSize)
+         return kTRUE;
+   }
+   return kFALSE;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Read buffer via cache.
 ///
@@ -3535,7 +3795,17 @@ void TFile::ReadStreamerInfo()
    TList *list = listRetcode.fList;
    auto retcode = listRetcode.fReturnCode;
    if (!list) {
-      if (retcode) MakeZombie();
+      if (retcode) {
+         MakeZombie();
+      } else {
+         // The same record was already read from another file: its TStreamerInfo
+         // are all known, only mark them as present in this file.
+         std::lock_guard<std::mutex> lock(gStreamerInfoRecordsMutex);
+         for (Int_t uid : gStreamerInfoRecords[listRetcode.fHash]) {
+            if (uid >= fClassIndex->GetSize()) fClassIndex->Set(2 * uid);
+            fClassIndex->fArray[uid] = 1;
+         }
+      }
       return;
    }
 
@@ -3636,11 +3906,21 @@ void TFile::ReadStreamerInfo()
    list->Clear();  //this will delete all TStreamerInfo objects with kCanDelete bit set
    delete list;
 
-#ifdef R__USE_IMT
-   // We are done processing the record, let future calls and other threads that it
-   // has been done.
-   fgTsSIHashes.Insert(listRetcode.fHash);
-#endif
+   // Record the TStreamerInfo of the record, so that the files with the same record
+   // (e.g. the other files of a dataset) skip reading and checking them.
+   if (fSeekInfo) {
+      std::vector<Int_t> uids;
+      for (Int_t uid = 1; uid < fClassIndex->GetSize(); ++uid) {
+         if (fClassIndex->fArray[uid]) uids.push_back(uid);
+      }
+      {
+         std::lock_guard<std::mutex> lock(gStreamerInfoRecordsMutex);
+         gStreamerInfoRecords[listRetcode.fHash] = std::move(uids);
+      }
+      // We are done processing the record, let future calls and other threads that it
+      // has been done.
+      fgTsSIHashes.Insert(listRetcode.fHash);
+   }
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -3718,6 +3998,7 @@ void TFile::WriteStreamerInfo()
 {
    //if (!gFile) return;
    if (!fWritable) return;
+   WriteZstdDictionary();
    if (!fClassIndex) return;
    if (fIsPcmFile) return; // No schema evolution for ROOT PCM files.
    if (fClassIndex->fArray[0] == 0
@@ -3971,6 +4252,61 @@ TFile *TFile::OpenFromCache(const char *name, Option_t *, const char *ftitle,
    return f;
 }
 
+namespace {
+
+/// A read-only TMemFile on the memory mapping of a local file (see the READ_MMAP option of TFile::Open).
+/// The processes reading the same file share its pages in the page cache instead of holding private copies.
+class TMemFileMapped : public TMemFile {
+   std::unique_ptr<ROOT::Internal::RRawFile> fRawFile; ///< The mapped file
+   void *fRegion;                                      ///< Start of the mapping
+   size_t fRegionSize;                                 ///< Length of the mapping
+
+public:
+   TMemFileMapped(const char *path, std::unique_ptr<ROOT::Internal::RRawFile> rawFile, void *region, size_t size)
+      : TMemFile(path, ZeroCopyView_t(static_cast<const char *>(region), size)), fRawFile(std::move(rawFile)),
+        fRegion(region), fRegionSize(size)
+   {
+   }
+
+   ~TMemFileMapped()
+   {
+      // The file must be closed while its content is still mapped.
+      Close();
+      fRawFile->Unmap(fRegion, fRegionSize);
+   }
+};
+
+/// Open the local file `path` for reading via a memory mapping. Fall back to a regular TFile
+/// if the platform does not support the mapping.
+
+TFile *R__OpenMapped(const char *path, const char *ftitle, Int_t compress)
+{
+   try {
+      auto rawFile = ROOT::Internal::RRawFile::Create(path);
+      if (rawFile->GetFeatures() & ROOT::Internal::RRawFile::kFeatureHasMmap) {
+         auto size = rawFile->GetSize();
+         std::uint64_t mapdOffset = 0;
+         if (!size) {
+            ::Error("TFile::Open", "cannot map the empty file %s", path);
+            return nullptr;
+         }
+         void *region = rawFile->Map(size, 0, mapdOffset);
+         if (!region) {
+            ::SysError("TFile::Open", "cannot map file %s (errno: %d)", path, errno);
+            return nullptr;
+         }
+         return new TMemFileMapped(path, std::move(rawFile), region, size);
+      }
+   } catch (const std::runtime_error &e) {
+      ::Error("TFile::Open", "cannot map file %s: %s", path, e.what());
+      return nullptr;
+   }
+   ::Warning("TFile::Open", "memory mapping is not supported for %s, it is read normally", path);
+   return new TFile(path, "READ", ftitle, compress);
+}
+
+} // anonymous namespace
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Create / open a file
 ///
@@ -4002,6 +4338,9 @@ TFile *TFile::OpenFromCache(const char *name, Option_t *, const char *ftitle,
 /// file for reading through the file cache. The file will be downloaded to
 /// the cache and opened from there. If the download fails, it will be opened remotely.
 /// The file will be downloaded to the directory specified by SetCacheFileDir().
+/// For local files there is the option: <b>READ_MMAP</b> opens an existing file
+/// read-only through a memory mapping of its content; the returned object is a TMemFile
+/// and the processes opening the same file share its pages instead of copying them.
 ///
 /// *The caller is responsible for deleting the pointer.*
 /// In READ mode, a nullptr is returned if the file does not exist or cannot be opened.
@@ -4141,7 +4480,10 @@ TFile *TFile::Open(const char *url, Option_t *options, const char *ftitle,
                urlname.SetProtocol("file");
                lfname = urlname.GetUrl();
             }
-            f = new TFile(lfname.Data(), option, ftitle, compress);
+            if (!strcasecmp(option, "READ_MMAP"))
+               f = R__OpenMapped(TUrl(lfname).GetFile(), ftitle, compress);
+            else
+               f = new TFile(lfname.Data(), option, ftitle, compress);
 
          } else if (type == kNet) {
 
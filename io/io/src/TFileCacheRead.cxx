@@ -336,7 +336,8 @@ void TFileCacheRead::Print(Option_t *option) const
    printf("Number of blocks in current cache..: %d, total size: %d\n",fNseek,fNtot);
    if (fPrefetch){
      printf("Prefetching .......................: %lli blocks\n", fPrefetchedBlocks);
-     printf("Prefetching Wait Time..............: %f seconds\n", fPrefetch->GetWaitTime() / 1e+6);
+     printf("Prefetching Wait Time..............: %f seconds in %lld stalls\n", fPrefetch->GetWaitTime() / 1e+6, fPrefetch->GetNStalls());
+     printf("Prefetching Queue Depth............: %d blocks, at most %d, %d read concurrently\n", fPrefetch->GetQueueDepth(), fPrefetch->GetMaxQueueDepth(), fPrefetch->GetDepth());
    }
 
    if (!opt.Contains("a")) return;
@@ -425,8 +426,9 @@ Int_t TFileCacheRead::ReadBufferExtPrefetch(char *buf, Long64_t pos, Int_t len,
    if (loc >= 0 && loc < fNseek && pos == fSeekSort[loc]) {
       if (buf && fPrefetch){
          // prefetch with the new method
-         fPrefetch->ReadBuffer(buf, pos, len);
-         return 1;
+         if (fPrefetch->ReadBuffer(buf, pos, len)) {
+            return 1;
+         }
       }
    }
    else if (buf && fPrefetch){
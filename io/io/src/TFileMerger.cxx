@@ -50,6 +50,10 @@ to be merged, like the standalone hadd program.
 #endif
 
 #include <cstring>
+#include <deque>
+#include <future>
+#include <memory>
+#include <vector>
 
 ClassImp(TFileMerger);
 
@@ -85,6 +89,85 @@ static Int_t R__GetSystemMaxOpenedFiles()
    }
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Open the source file `url` for reading, through a local copy of it if `local` is true.
+/// Return nullptr, after reporting the problem on behalf of `where`, if the file can not be opened.
+
+static TFile *R__OpenSourceFile(const char *url, Bool_t local, Bool_t cpProgress, const char *where)
+{
+   // We want gDirectory untouched by anything going on here
+   TDirectory::TContext ctxt;
+
+   TFile *newfile = nullptr;
+   TString localcopy;
+   if (local) {
+      TUUID uuid;
+      localcopy.Form("file:%s/ROOTMERGE-%s.root", gSystem->TempDirectory(), uuid.AsString());
+      if (!TFile::Cp(url, localcopy, cpProgress)) {
+         ::Error(where, "cannot get a local copy of file %s", url);
+         return nullptr;
+      }
+      newfile = TFile::Open(localcopy, "READ");
+   } else {
+      newfile = TFile::Open(url, "READ");
+   }
+
+   // Zombie files should also be skipped
+   if (newfile && newfile->IsZombie()) {
+      delete newfile;
+      newfile = nullptr;
+   }
+
+   if (!newfile) {
+      if (local)
+         ::Error(where, "cannot open local copy %s of URL %s", localcopy.Data(), url);
+      else
+         ::Error(where, "cannot open file %s", url);
+   }
+   return newfile;
+}
+
+namespace ROOT {
+namespace Internal {
+
+/// The source files of a TFileMerger that are being opened in the background.
+/// They are the first entries of TFileMerger::fExcessFiles, in the same order.
+class TFileMergerPrefetch {
+   std::deque<std::future<TFile *>> fPending;
+
+public:
+   ~TFileMergerPrefetch() { Clear(); }
+
+   Int_t GetSize() const { return fPending.size(); }
+
+   /// Start opening `url` in the background.
+   void Push(const char *url, Bool_t local)
+   {
+      std::string name(url);
+      fPending.emplace_back(std::async(std::launch::async, [name, local]() {
+         return R__OpenSourceFile(name.c_str(), local, kFALSE, "TFileMerger::OpenExcessFiles");
+      }));
+   }
+
+   /// Wait for the oldest background opening and return its file (nullptr on failure).
+   TFile *Pop()
+   {
+      TFile *file = fPending.front().get();
+      fPending.pop_front();
+      return file;
+   }
+
+   /// Wait for and close all the files being opened.
+   void Clear()
+   {
+      while (!fPending.empty())
+         delete Pop();
+   }
+};
+
+} // namespace Internal
+} // namespace ROOT
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Create file merger object.
 
@@ -116,6 +199,8 @@ TFileMerger::~TFileMerger()
 
 void TFileMerger::Reset()
 {
+   if (fPrefetch)
+      fPrefetch->Clear();
    fFileList.Clear();
    fMergeList.Clear();
    fExcessFiles.Clear();
@@ -131,9 +216,6 @@ Bool_t TFileMerger::AddFile(const char *url, Bool_t cpProgress)
       Printf("%s Source file %d: %s", fMsgPrefix.Data(), fFileList.GetEntries() + fExcessFiles.GetEntries() + 1, url);
    }
 
-   TFile *newfile = 0;
-   TString localcopy;
-
    if (fFileList.GetEntries() >= (fMaxOpenedFiles-1)) {
 
       TObjString *urlObj = new TObjString(url);
@@ -142,36 +224,12 @@ Bool_t TFileMerger::AddFile(const char *url, Bool_t cpProgress)
       urlObj = new TObjString(url);
       urlObj->SetBit(kCpProgress);
       fExcessFiles.Add(urlObj);
+      PrefetchExcessFiles();
       return kTRUE;
    }
 
-   // We want gDirectory untouched by anything going on here
-   TDirectory::TContext ctxt;
-
-   if (fLocal) {
-      TUUID uuid;
-      localcopy.Form("file:%s/ROOTMERGE-%s.root", gSystem->TempDirectory(), uuid.AsString());
-      if (!TFile::Cp(url, localcopy, cpProgress)) {
-         Error("AddFile", "cannot get a local copy of file %s", url);
-         return kFALSE;
-      }
-      newfile = TFile::Open(localcopy, "READ");
-   } else {
-      newfile = TFile::Open(url, "READ");
-   }
-
-   // Zombie files should also be skipped
-   if (newfile && newfile->IsZombie()) {
-      delete newfile;
-      newfile = 0;
-   }
-
+   TFile *newfile = R__OpenSourceFile(url, fLocal, cpProgress, "TFileMerger::AddFile");
    if (!newfile) {
-      if (fLocal)
-         Error("AddFile", "cannot open local copy %s of URL %s",
-               localcopy.Data(), url);
-      else
-         Error("AddFile", "cannot open file %s", url);
       return kFALSE;
    } else {
       if (fOutputFile && fOutputFile->GetCompressionLevel() != newfile->GetCompressionLevel()) fCompressionChange = kTRUE;
@@ -374,18 +432,6 @@ Bool_t TFileMerger::Merge(Bool_t)
 
 namespace {
 
-/// Merge a list of RNTuples
-Long64_t MergeRNTuples(TClass* rntupleHandle, const TString& /* target */, const TList& /* sources */) {
-   if (!rntupleHandle) {
-      return Long64_t(-1);
-   }
-   // todo(max) implement rntuple merger
-   // [ ] build complete list of sources (some sources may actually be a directory with RNTuples inside)
-   // [ ] merge them
-   ROOT::MergeFunc_t func = rntupleHandle->GetMerge();
-   return func(static_cast<void*>(rntupleHandle), nullptr, nullptr);
-}
-
 Bool_t IsMergeable(TClass *cl)
 {
    return (cl->GetMerge() || cl->InheritsFrom(TDirectory::Class()) ||
@@ -447,6 +493,82 @@ Bool_t WriteCycleInOrder(const TString &name, TIter &nextkey, TIter &peeknextkey
 
 } // anonymous namespace
 
+namespace ROOT {
+namespace Internal {
+
+/// The histograms of a directory whose merge is deferred, to run several merges
+/// concurrently on the implicit multi-threading pool (see TFileMerger::SetParallelMerges).
+/// The objects are read and written by the thread running the TFileMerger, only the
+/// calls to Merge run on the pool. Each merge only uses its own objects, which are
+/// detached from their directory.
+class TFileMergerJobs {
+   struct Job {
+      TString fName;
+      TClass *fClass;
+      TObject *fObj;
+      std::unique_ptr<TList> fInputs;
+      std::unique_ptr<TFileMergeInfo> fInfo;
+   };
+
+   TDirectory *fTarget;
+   Int_t fMaxJobs;
+   std::vector<Job> fJobs;
+
+   static void DetachFromDirectory(TObject *obj)
+   {
+      if (auto func = obj->IsA()->GetDirectoryAutoAdd())
+         func(obj, nullptr);
+   }
+
+public:
+   TFileMergerJobs(TDirectory *target, Int_t maxJobs) : fTarget(target), fMaxJobs(maxJobs) {}
+   ~TFileMergerJobs() { Flush(); }
+
+   /// Adopt obj and the objects in inputs, and merge them later.
+   /// Returns false if writing the merged objects failed.
+   Bool_t Push(const char *name, TClass *cl, TObject *obj, TList &inputs, const TFileMergeInfo &info)
+   {
+      Job job{name, cl, obj, std::unique_ptr<TList>(new TList), std::unique_ptr<TFileMergeInfo>(new TFileMergeInfo(fTarget))};
+      job.fInfo->fOptions = info.fOptions;
+      job.fInfo->fIOFeatures = info.fIOFeatures;
+      DetachFromDirectory(obj);
+      TIter next(&inputs);
+      while (TObject *input = next()) {
+         DetachFromDirectory(input);
+         job.fInputs->Add(input);
+      }
+      inputs.Clear();
+      fJobs.emplace_back(std::move(job));
+      return (Int_t)fJobs.size() < fMaxJobs ? kTRUE : Flush();
+   }
+
+   /// Merge the deferred objects and write them to the target directory, in the order of Push.
+   Bool_t Flush()
+   {
+      if (fJobs.empty())
+         return kTRUE;
+      auto merge = [this](UInt_t i) {
+         Job &job = fJobs[i];
+         ROOT::MergeFunc_t func = job.fClass->GetMerge();
+         if (func(job.fObj, job.fInputs.get(), job.fInfo.get()) < 0)
+            Error("MergeRecursive", "calling Merge() on '%s'", job.fName.Data());
+      };
+      ROOT::Internal::ForEachInImplicitMTPool(fJobs.size(), merge);
+
+      Bool_t status = kTRUE;
+      TDirectory::TContext ctxt(fTarget);
+      for (auto &job : fJobs) {
+         job.fInputs->Delete();
+         status = WriteOneAndDelete(job.fName, job.fClass, job.fObj, kTRUE, kTRUE, fTarget) && status;
+      }
+      fJobs.clear();
+      return status;
+   }
+};
+
+} // namespace Internal
+} // namespace ROOT
+
 Bool_t TFileMerger::MergeOne(TDirectory *target, TList *sourcelist, Int_t type, TFileMergeInfo &info,
                              TString &oldkeyname, THashList &allNames, Bool_t &status, Bool_t &onlyListed,
                              const TString &path, TDirectory *current_sourcedir, TFile *current_file, TKey *key,
@@ -596,14 +718,34 @@ Bool_t TFileMerger::MergeOne(TDirectory *target, TList *sourcelist, Int_t type,
    } else if (!cl->IsTObject() && cl->GetMerge()) {
       // merge objects that don't derive from TObject
       if (std::string(keyclassname) == "ROOT::Experimental::RNTuple") {
+         if (alreadyseen) return kTRUE;
          Warning("MergeRecursive", "merging RNTuples is experimental");
-         // todo(max): check if this works when a TDirectory is passed as the first
-         // input argument
-         Long64_t mergeResult = MergeRNTuples(cl, *path, *sourcelist);
+         // The merge is given the anchor keys of all the sources: it copies their pages and writes the merged
+         // anchor itself
+         TList inputs;
+         if (key)
+            inputs.Add(key);
+         TFile *nextsource = current_file ? (TFile*)sourcelist->After( current_file ) : (TFile*)sourcelist->First();
+         while (nextsource) {
+            TDirectory *ndir = getDirectory(nextsource, target->GetName(), path);
+            TKey *key2 = ndir ? (TKey*)ndir->GetListOfKeys()->FindObject(keyname) : nullptr;
+            if (key2)
+               inputs.Add(key2);
+            nextsource = (TFile*)sourcelist->After( nextsource );
+         }
+         ROOT::MergeFunc_t func = cl->GetMerge();
+         Long64_t mergeResult = func(obj, &inputs, &info);
+         inputs.Clear();
+         if (ownobj)
+            cl->Destructor(obj);
+         dirtodelete.Delete();
+         oldkeyname = keyname;
+         info.Reset();
          if (mergeResult < 0) {
             Error("MergeRecursive", "error merging RNTuples");
             return kFALSE;
          }
+         return kTRUE;
       } else {
          TFile *nextsource = current_file ? (TFile*)sourcelist->After( current_file ) : (TFile*)sourcelist->First();
          Error("MergeRecursive", "Merging objects that don't inherit from TObject is unimplemented (key: %s of type %s in file %s)",
@@ -617,6 +759,10 @@ Bool_t TFileMerger::MergeOne(TDirectory *target, TList *sourcelist, Int_t type,
       TList inputs;
       TList todelete;
       Bool_t oneGo = fHistoOneGo && cl->InheritsFrom(R__TH1_Class);
+      // Histograms merged concurrently are merged in one go
+      Bool_t deferred = fJobs && ownobj && !canBeFound && cl->InheritsFrom(R__TH1_Class);
+      if (deferred)
+         oneGo = kTRUE;
 
       // Loop over all source files and merge same-name object
       TFile *nextsource = current_file ? (TFile*)sourcelist->After( current_file ) : (TFile*)sourcelist->First();
@@ -670,6 +816,14 @@ Bool_t TFileMerger::MergeOne(TDirectory *target, TList *sourcelist, Int_t type,
             }
             nextsource = (TFile*)sourcelist->After( nextsource );
          } while (nextsource);
+         // Defer the merge if all the objects are owned here, to run it concurrently with others
+         if (deferred && todelete.GetSize() == inputs.GetSize()) {
+            todelete.Clear();
+            status = fJobs->Push(keyname, cl, obj, inputs, info) && status;
+            oldkeyname = keyname;
+            info.Reset();
+            return kTRUE;
+         }
          // Merge the list, if still to be done
          if (oneGo || info.fIsFirst) {
             ROOT::MergeFunc_t func = cl->GetMerge();
@@ -843,6 +997,18 @@ Bool_t TFileMerger::MergeRecursive(TDirectory *target, TList *sourcelist, Int_t
       info.fOptions.Append(" fast");
    }
 
+   // Histograms merged concurrently, the previous jobs are those of the parent directory
+   std::unique_ptr<ROOT::Internal::TFileMergerJobs> jobs;
+   if (fParallelMerges > 1 && ROOT::IsImplicitMTEnabled())
+      jobs.reset(new ROOT::Internal::TFileMergerJobs(target, fParallelMerges));
+   struct JobsRAII {
+      ROOT::Internal::TFileMergerJobs *&fCurrent;
+      ROOT::Internal::TFileMergerJobs *fPrevious;
+      JobsRAII(ROOT::Internal::TFileMergerJobs *&current, ROOT::Internal::TFileMergerJobs *jobs)
+         : fCurrent(current), fPrevious(current) { fCurrent = jobs; }
+      ~JobsRAII() { fCurrent = fPrevious; }
+   } jobsRAII(fJobs, jobs.get());
+
    TFile      *current_file;
    TDirectory *current_sourcedir;
    if (type & kIncremental) {
@@ -890,6 +1056,9 @@ Bool_t TFileMerger::MergeRecursive(TDirectory *target, TList *sourcelist, Int_t
          current_sourcedir = 0;
       }
    }
+   if (jobs)
+      status = jobs->Flush() && status;
+
    // save modifications to the target directory.
    if (!(type&kIncremental)) {
       // In case of incremental build, we will call Write on the top directory/file, so we do not need
@@ -965,6 +1134,8 @@ Bool_t TFileMerger::PartialMerge(Int_t in_type)
    Bool_t result = kTRUE;
    Int_t type = in_type;
    while (result && fFileList.GetEntries()>0) {
+      // Open the next source files while the current ones are being merged.
+      PrefetchExcessFiles();
       result = MergeRecursive(fOutputFile, &fFileList, type);
 
       // Remove local copies if there are any
@@ -1036,29 +1207,13 @@ Bool_t TFileMerger::OpenExcessFiles()
    Int_t nfiles = 0;
    TIter next(&fExcessFiles);
    TObjString *url = 0;
-   TString localcopy;
-   // We want gDirectory untouched by anything going on here
-   TDirectory::TContext ctxt;
    while( nfiles < (fMaxOpenedFiles-1) && ( url = (TObjString*)next() ) ) {
-      TFile *newfile = 0;
-      if (fLocal) {
-         TUUID uuid;
-         localcopy.Form("file:%s/ROOTMERGE-%s.root", gSystem->TempDirectory(), uuid.AsString());
-         if (!TFile::Cp(url->GetName(), localcopy, url->TestBit(kCpProgress))) {
-            Error("OpenExcessFiles", "cannot get a local copy of file %s", url->GetName());
-            return kFALSE;
-         }
-         newfile = TFile::Open(localcopy, "READ");
-      } else {
-         newfile = TFile::Open(url->GetName(), "READ");
-      }
-
+      // The first excess files might already be opened (or being opened) in the background.
+      TFile *newfile = (fPrefetch && fPrefetch->GetSize())
+                          ? fPrefetch->Pop()
+                          : R__OpenSourceFile(url->GetName(), fLocal, url->TestBit(kCpProgress),
+                                              "TFileMerger::OpenExcessFiles");
       if (!newfile) {
-         if (fLocal)
-            Error("OpenExcessFiles", "cannot open local copy %s of URL %s",
-                  localcopy.Data(), url->GetName());
-         else
-            Error("OpenExcessFiles", "cannot open file %s", url->GetName());
          return kFALSE;
       } else {
          if (fOutputFile && fOutputFile->GetCompressionLevel() != newfile->GetCompressionLevel()) fCompressionChange = kTRUE;
@@ -1072,6 +1227,27 @@ Bool_t TFileMerger::OpenExcessFiles()
    return kTRUE;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Start opening in the background the first fPrefetchFiles excess files that are
+/// not yet being opened, so that they are ready when OpenExcessFiles needs them.
+
+void TFileMerger::PrefetchExcessFiles()
+{
+   if (fPrefetchFiles <= 0)
+      return;
+   if (!fPrefetch)
+      fPrefetch.reset(new ROOT::Internal::TFileMergerPrefetch);
+
+   TIter next(&fExcessFiles);
+   TObjString *url = nullptr;
+   Int_t index = 0;
+   while (fPrefetch->GetSize() < fPrefetchFiles && (url = (TObjString *)next())) {
+      if (index++ < fPrefetch->GetSize())
+         continue;
+      fPrefetch->Push(url->GetName(), fLocal);
+   }
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Intercept the case where the output TFile is deleted!
 
@@ -1102,6 +1278,41 @@ void TFileMerger::SetMaxOpenedFiles(Int_t newmax)
    }
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Set the number of source files that TFileMerger opens in the background, ahead of
+/// their merge, when it can not open all of them at once (see SetMaxOpenedFiles).
+///
+/// This hides the latency of opening remote files: while a set of files is being merged,
+/// the next `nfiles` are opened, and are ready when the merge moves on to them. These
+/// files are opened in addition to the maximum number of opened files. A value of 0
+/// (the default) disables the prefetching. Enables ROOT's thread safety if `nfiles` > 0.
+
+void TFileMerger::SetPrefetchFiles(Int_t nfiles)
+{
+   fPrefetchFiles = nfiles > 0 ? nfiles : 0;
+   if (fPrefetchFiles)
+      ROOT::EnableThreadSafety();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Set the number of histograms of a directory that TFileMerger merges concurrently on
+/// the implicit multi-threading pool (see ROOT::EnableImplicitMT).
+///
+/// The histograms of a directory are read from all the source files, as when histograms
+/// are merged in one go, then the merges of up to `nmerges` of them run at the same time,
+/// then the results are written one after
+/// the other. Objects of other types, in particular trees, are merged one after the other
+/// as they write to the output file. The merged histograms can thus be written after
+/// objects that follow them in the source directories. A value of 0 or 1 (the default)
+/// merges the histograms one after the other. Enables ROOT's thread safety if `nmerges` > 1.
+
+void TFileMerger::SetParallelMerges(Int_t nmerges)
+{
+   fParallelMerges = nmerges > 1 ? nmerges : 0;
+   if (fParallelMerges)
+      ROOT::EnableThreadSafety();
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Set the prefix to be used when printing informational message.
 
@@ -10,23 +10,27 @@
  *************************************************************************/
 
 #include "TFilePrefetch.h"
+#include "TEnv.h"
+#include "TROOT.h"
 #include "TTimeStamp.h"
 #include "TSystem.h"
 #include "TMD5.h"
 #include "TVirtualPerfStats.h"
 #include "TVirtualMonitoring.h"
-#include "TSemaphore.h"
 #include "TFPBlock.h"
 #include "strlcpy.h"
 
+#include <algorithm>
 #include <string>
 #include <sstream>
 #include <cstdio>
 #include <cstdlib>
 #include <cctype>
 #include <cassert>
+#include <system_error>
 
-static const int kMAX_READ_SIZE    = 2;   //maximum size of the read list of blocks
+static const int kMAX_READ_SIZE    = 2;   //maximum number of prefetched lists of blocks kept in the read list
+static const Long64_t kMIN_PART_SIZE = 512 * 1024; //minimum size of the parts of a list of blocks read concurrently
 
 inline int xtod(char c) { return (c>='0' && c<='9') ? c-'0' : ((c>='A' && c<='F') ? c-'A'+10 : ((c>='a' && c<='f') ? c-'a'+10 : 0)); }
 
@@ -39,33 +43,51 @@ ClassImp(TFilePrefetch);
 \ingroup IO
 
 The prefetching mechanism uses two classes (TFilePrefetch and
-TFPBlock) to prefetch in advance a block of tree entries. There is
-a thread which takes care of actually transferring the blocks and
-making them available to the main requesting thread. Therefore,
-the time spent by the main thread waiting for the data before
-processing considerably decreases. Besides the prefetching
-mechanisms there is also a local caching option which can be
-enabled by the user. Both capabilities are disabled by default
-and must be explicitly enabled by the user.
+TFPBlock) to prefetch in advance a block of tree entries. The lists
+of blocks requested by TFileCacheRead are split into up to
+TFile.AsyncPrefetchingDepth parts (4 by default) which are read
+concurrently, by tasks of the implicit multi-threading pool if it is
+enabled, otherwise by as many prefetching threads, and are made
+available to the main requesting thread. Therefore, the time spent by
+the main thread waiting for the data before processing considerably
+decreases. A main thread which needs a part that is still pending
+reads it itself instead of waiting for a worker.
+
+The parts of files which do not support concurrent vector reads, i.e.
+other than TNetXNGFile and TDavixFile, are read one after the other.
+
+Besides the prefetching mechanisms there is also a local caching
+option which can be enabled by the user. Both capabilities are
+disabled by default and must be explicitly enabled by the user.
+
+The number of stalls of the main thread and the time it waited, see
+GetNStalls() and GetWaitTime(), and the number of outstanding parts,
+see GetQueueDepth() and GetMaxQueueDepth(), are shown by
+TFileCacheRead::Print().
 */
 
+////////////////////////////////////////////////////////////////////////////////
+/// Return whether the vector reads of file can run concurrently.
+
+static Bool_t HasConcurrentReads(TFile *file)
+{
+   return file && (file->InheritsFrom("TNetXNGFile") || file->InheritsFrom("TDavixFile"));
+}
 
 ////////////////////////////////////////////////////////////////////////////////
 /// Constructor.
 
 TFilePrefetch::TFilePrefetch(TFile* file) :
   fFile(file),
-  fConsumer(0),
+  fDepth(std::max(gEnv->GetValue("TFile.AsyncPrefetchingDepth", 4), 1)),
+  fNReading(0),
+  fNTasks(0),
+  fMaxQueueDepth(0),
+  fNStalls(0),
+  fConcurrentReads(HasConcurrentReads(file)),
   fThreadJoined(kTRUE),
   fPrefetchFinished(kFALSE)
 {
-   fPendingBlocks    = new TList();
-   fReadBlocks       = new TList();
-
-   fPendingBlocks->SetOwner();
-   fReadBlocks->SetOwner();
-
-   fSemChangeFile    = new TSemaphore(0);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -73,31 +95,36 @@ TFilePrefetch::TFilePrefetch(TFile* file) :
 
 TFilePrefetch::~TFilePrefetch()
 {
-   if (!fThreadJoined) {
-     WaitFinishPrefetch();
-   }
+   WaitFinishPrefetch();
 
-   SafeDelete(fConsumer);
-   SafeDelete(fPendingBlocks);
-   SafeDelete(fReadBlocks);
-   SafeDelete(fSemChangeFile);
+   for (auto block : fPendingBlocks)
+      delete block;
+   for (auto block : fReadBlocks)
+      delete block;
 }
 
 
 ////////////////////////////////////////////////////////////////////////////////
-/// Killing the async prefetching thread
+/// Stop the prefetching threads and wait for the blocks being read.
+///
+/// The blocks still pending are read by ReadBuffer() when they are needed.
 
 void TFilePrefetch::WaitFinishPrefetch()
 {
-   // Inform the consumer thread that prefetching is over
+   // Inform the consumer threads that prefetching is over
    {
-      std::lock_guard<std::mutex> lk(fMutexPendingList);
+      std::lock_guard<std::mutex> lk(fMutex);
       fPrefetchFinished = kTRUE;
    }
-   fNewBlockAdded.notify_one();
+   fNewBlockAdded.notify_all();
 
-   fConsumer->Join();
+   for (auto &consumer : fConsumers)
+      consumer.join();
+   fConsumers.clear();
    fThreadJoined = kTRUE;
+
+   std::unique_lock<std::mutex> lk(fMutex);
+   fReadBlockAdded.wait(lk, [&]{ return fNReading == 0 && fNTasks == 0; });
    fPrefetchFinished = kFALSE;
 }
 
@@ -114,6 +141,9 @@ void TFilePrefetch::ReadAsync(TFPBlock* block, Bool_t &inCache)
       inCache = kTRUE;
    }
    else{
+      std::unique_lock<std::mutex> lk(fMutexFile, std::defer_lock);
+      if (!fConcurrentReads)
+         lk.lock();
       fFile->ReadBuffers(block->GetBuffer(), block->GetPos(), block->GetLen(), block->GetNoElem());
       if (fFile->GetArchive()) {
          for (Int_t i = 0; i < block->GetNoElem(); i++)
@@ -125,19 +155,62 @@ void TFilePrefetch::ReadAsync(TFPBlock* block, Bool_t &inCache)
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-/// Get blocks specified in prefetchBlocks.
+/// Read a block taken from the pending list, with fMutex locked on entry
+/// and on return.
 
-void TFilePrefetch::ReadListOfBlocks()
+void TFilePrefetch::ReadPendingBlock(TFPBlock* block, std::unique_lock<std::mutex> &lk)
 {
+   fNReading++;
+   lk.unlock();
+
    Bool_t inCache = kFALSE;
-   TFPBlock*  block = 0;
+   ReadAsync(block, inCache);
+   if (!inCache)
+      SaveBlockInCache(block);
+
+   lk.lock();
+   fNReading--;
+   fReadBlocks.push_back(block);
+   while ((Int_t)fReadBlocks.size() > kMAX_READ_SIZE * fDepth) {
+      delete fReadBlocks.front();
+      fReadBlocks.pop_front();
+   }
+   fReadBlockAdded.notify_all();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Get blocks specified in prefetchBlocks, until prefetching is over.
+
+void TFilePrefetch::ReadListOfBlocks()
+{
+   std::unique_lock<std::mutex> lk(fMutex);
+   while (1) {
+      fNewBlockAdded.wait(lk, [&]{ return !fPendingBlocks.empty() || fPrefetchFinished; });
+      if (fPrefetchFinished)
+         return;
+      TFPBlock *block = fPendingBlocks.front();
+      fPendingBlocks.pop_front();
+      ReadPendingBlock(block, lk);
+   }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Execution of a reading task in the implicit multi-threading pool: read
+/// the pending blocks until there are none left.
 
-   while((block = GetPendingBlock())){
-      ReadAsync(block, inCache);
-      AddReadBlock(block);
-      if (!inCache)
-         SaveBlockInCache(block);
+void TFilePrefetch::TaskProc(void* arg)
+{
+   TFilePrefetch* pClass = (TFilePrefetch*) arg;
+
+   std::unique_lock<std::mutex> lk(pClass->fMutex);
+   while (!pClass->fPendingBlocks.empty()) {
+      TFPBlock *block = pClass->fPendingBlocks.front();
+      pClass->fPendingBlocks.pop_front();
+      pClass->ReadPendingBlock(block, lk);
    }
+   pClass->fNTasks--;
+   // Notify with the lock held: the prefetcher may be deleted as soon as it is released
+   pClass->fReadBlockAdded.notify_all();
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -166,6 +239,19 @@ Bool_t TFilePrefetch::BinarySearchReadList(TFPBlock* blockObj, Long64_t offset,
    return false;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Return the block of the list containing the requested element, the most
+/// recent first, and the index of the element, or nullptr.
+
+TFPBlock* TFilePrefetch::FindBlock(const std::deque<TFPBlock*> &blocks, Long64_t offset, Int_t len, Int_t* index)
+{
+   for (auto it = blocks.rbegin(); it != blocks.rend(); ++it) {
+      if (BinarySearchReadList(*it, offset, len, index))
+         return *it;
+   }
+   return nullptr;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Return the time spent wating for buffer to be read in microseconds.
 
@@ -174,84 +260,125 @@ Long64_t TFilePrefetch::GetWaitTime()
    return Long64_t(fWaitTime.RealTime()*1.e+6);
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Return the number of pending blocks and of blocks being read.
+
+Int_t TFilePrefetch::GetQueueDepth()
+{
+   std::lock_guard<std::mutex> lk(fMutex);
+   return fPendingBlocks.size() + fNReading;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Return a prefetched element.
+///
+/// Waits for the element if it is being read, and reads the pending block
+/// containing it right away. Returns false if the element was not
+/// prefetched.
 
 Bool_t TFilePrefetch::ReadBuffer(char* buf, Long64_t offset, Int_t len)
 {
-   Bool_t found = false;
    TFPBlock* blockObj = 0;
    Int_t index = -1;
+   Bool_t stalled = kFALSE;
 
-   std::unique_lock<std::mutex> lk(fMutexReadList);
+   std::unique_lock<std::mutex> lk(fMutex);
    while (1){
-      TIter iter(fReadBlocks);
-      while ((blockObj = (TFPBlock*) iter.Next())){
-         index = -1;
-         if (BinarySearchReadList(blockObj, offset, len, &index)){
-            found = true;
-            break;
-         }
-      }
-      if (found)
+      if ((blockObj = FindBlock(fReadBlocks, offset, len, &index)))
          break;
-      else{
+      if (!stalled) {
+         stalled = kTRUE;
+         fNStalls++;
          fWaitTime.Start(kFALSE);
+      }
+      if (TFPBlock *pending = FindBlock(fPendingBlocks, offset, len, &index)) {
+         fPendingBlocks.erase(std::find(fPendingBlocks.begin(), fPendingBlocks.end(), pending));
+         ReadPendingBlock(pending, lk);
+      } else if (fNReading > 0) {
          fReadBlockAdded.wait(lk); //wait for a new block to be added
-         fWaitTime.Stop();
+      } else {
+         break;
       }
    }
+   if (stalled)
+      fWaitTime.Stop();
 
-   if (found){
+   if (blockObj){
       char *pBuff = blockObj->GetPtrToPiece(index);
       pBuff += (offset - blockObj->GetPos(index));
       memcpy(buf, pBuff, len);
    }
-   return found;
+   return blockObj != nullptr;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-/// Create a TFPBlock object or recycle one and add it to the prefetchBlocks list.
+/// Split the list of blocks in up to fDepth parts of about the same size,
+/// which are read concurrently, and add them to the pending list.
 
 void TFilePrefetch::ReadBlock(Long64_t* offset, Int_t* len, Int_t nblock)
 {
-   TFPBlock* block = CreateBlockObj(offset, len, nblock);
-   AddPendingBlock(block);
+   if (nblock <= 0)
+      return;
+   Long64_t total = 0;
+   for (Int_t i = 0; i < nblock; i++)
+      total += len[i];
+   if (total <= 0) {
+      AddPendingBlock(CreateBlockObj(offset, len, nblock));
+      return;
+   }
+   const Long64_t nparts = std::min<Long64_t>({(Long64_t)fDepth, (Long64_t)nblock, 1 + total / kMIN_PART_SIZE});
+
+   Int_t first = 0;
+   Long64_t accumulated = 0;
+   for (Int_t i = 0; i < nblock; i++) {
+      accumulated += len[i];
+      const Long64_t npartsDone = (accumulated * nparts) / total;
+      const Bool_t last = (i == nblock - 1);
+      if (last || npartsDone > (accumulated - len[i]) * nparts / total) {
+         AddPendingBlock(CreateBlockObj(&offset[first], &len[first], i + 1 - first));
+         first = i + 1;
+      }
+   }
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 /// Safe method to add a block to the pendingList.
+///
+/// Starts a reading task in the implicit multi-threading pool, if it is
+/// enabled, unless fDepth blocks are already being read.
 
 void TFilePrefetch::AddPendingBlock(TFPBlock* block)
 {
-   fMutexPendingList.lock();
-   fPendingBlocks->Add(block);
-   fMutexPendingList.unlock();
+   Bool_t startTask = kFALSE;
+   {
+      std::lock_guard<std::mutex> lk(fMutex);
+      fPendingBlocks.push_back(block);
+      fMaxQueueDepth = std::max<Int_t>(fMaxQueueDepth, fPendingBlocks.size() + fNReading);
+      if (fConsumers.empty() && fNTasks < fDepth && ROOT::IsImplicitMTEnabled()) {
+         fNTasks++;
+         startTask = kTRUE;
+      }
+   }
 
+   if (startTask && !ROOT::Internal::EnqueueInImplicitMTPool(TaskProc, this)) {
+      std::lock_guard<std::mutex> lk(fMutex);
+      fNTasks--;
+   }
    fNewBlockAdded.notify_one();
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 /// Safe method to remove a block from the pendingList.
+///
+/// Returns nullptr if there is no pending block.
 
 TFPBlock* TFilePrefetch::GetPendingBlock()
 {
-   TFPBlock* block = 0;
-
-   // Use the semaphore to deal with the case when the file pointer
-   // is changed on the fly by TChain
-   fSemChangeFile->Post();
-   std::unique_lock<std::mutex> lk(fMutexPendingList);
-   // Wait unless there is a pending block or prefetching is over
-   fNewBlockAdded.wait(lk, [&]{ return fPendingBlocks->GetSize() > 0 || fPrefetchFinished; });
-   lk.unlock();
-   fSemChangeFile->Wait();
-
-   lk.lock();
-   if (fPendingBlocks->GetSize()){
-      block = (TFPBlock*)fPendingBlocks->First();
-      block = (TFPBlock*)fPendingBlocks->Remove(block);
-   }
+   std::lock_guard<std::mutex> lk(fMutex);
+   if (fPendingBlocks.empty())
+      return nullptr;
+   TFPBlock* block = fPendingBlocks.front();
+   fPendingBlocks.pop_front();
    return block;
 }
 
@@ -260,20 +387,17 @@ TFPBlock* TFilePrefetch::GetPendingBlock()
 
 void TFilePrefetch::AddReadBlock(TFPBlock* block)
 {
-   fMutexReadList.lock();
-
-   if (fReadBlocks->GetSize() >= kMAX_READ_SIZE){
-      TFPBlock* movedBlock = (TFPBlock*) fReadBlocks->First();
-      movedBlock = (TFPBlock*)fReadBlocks->Remove(movedBlock);
-      delete movedBlock;
-      movedBlock = 0;
+   {
+      std::lock_guard<std::mutex> lk(fMutex);
+      fReadBlocks.push_back(block);
+      while ((Int_t)fReadBlocks.size() > kMAX_READ_SIZE * fDepth) {
+         delete fReadBlocks.front();
+         fReadBlocks.pop_front();
+      }
    }
 
-   fReadBlocks->Add(block);
-   fMutexReadList.unlock();
-
    //signal the addition of a new block
-   fReadBlockAdded.notify_one();
+   fReadBlockAdded.notify_all();
 }
 
 
@@ -284,60 +408,47 @@ TFPBlock* TFilePrefetch::CreateBlockObj(Long64_t* offset, Int_t* len, Int_t nobl
 {
    TFPBlock* blockObj = 0;
 
-   fMutexReadList.lock();
+   fMutex.lock();
 
-   if (fReadBlocks->GetSize() >= kMAX_READ_SIZE){
-      blockObj = static_cast<TFPBlock*>(fReadBlocks->First());
-      fReadBlocks->Remove(blockObj);
-      fMutexReadList.unlock();
+   if ((Int_t)fReadBlocks.size() >= kMAX_READ_SIZE * fDepth){
+      blockObj = fReadBlocks.front();
+      fReadBlocks.pop_front();
+      fMutex.unlock();
       blockObj->ReallocBlock(offset, len, noblock);
    }
    else{
-      fMutexReadList.unlock();
+      fMutex.unlock();
       blockObj = new TFPBlock(offset, len, noblock);
    }
    return blockObj;
 }
 
-////////////////////////////////////////////////////////////////////////////////
-/// Return reference to the consumer thread.
-
-TThread* TFilePrefetch::GetThread() const
-{
-   return fConsumer;
-}
-
 
 ////////////////////////////////////////////////////////////////////////////////
 /// Change the file
 ///
 /// When prefetching is enabled we also need to:
-///  - make sure the async thread is not doing any work
 ///  - clear all blocks from prefetching and read list
 ///  - reset the file pointer
+///  - wait for the blocks of the previous file being read
 
 void TFilePrefetch::SetFile(TFile *file, TFile::ECacheAction action)
 {
    if (action == TFile::kDisconnect) {
-      if (!fThreadJoined) {
-        fSemChangeFile->Wait();
-      }
-
-      if (fFile) {
-        // Remove all pending and read blocks
-        fMutexPendingList.lock();
-        fPendingBlocks->Clear();
-        fMutexPendingList.unlock();
-
-        fMutexReadList.lock();
-        fReadBlocks->Clear();
-        fMutexReadList.unlock();
-      }
+      std::unique_lock<std::mutex> lk(fMutex);
+
+      // Remove all pending blocks, wait for the blocks being read and remove
+      // all read blocks
+      for (auto block : fPendingBlocks)
+         delete block;
+      fPendingBlocks.clear();
+      fReadBlockAdded.wait(lk, [&]{ return fNReading == 0; });
+      for (auto block : fReadBlocks)
+         delete block;
+      fReadBlocks.clear();
 
       fFile = file;
-      if (!fThreadJoined) {
-        fSemChangeFile->Post();
-      }
+      fConcurrentReads = HasConcurrentReads(file);
    } else {
       // kDoNotDisconnect must reconnect to the same file
       assert((fFile == file) && "kDoNotDisconnect must reattach to the same file");
@@ -346,33 +457,23 @@ void TFilePrefetch::SetFile(TFile *file, TFile::ECacheAction action)
 
 
 ////////////////////////////////////////////////////////////////////////////////
-/// Used to start the consumer thread.
+/// Start the fDepth consumer threads if implicit multi-threading is disabled,
+/// otherwise the blocks are read by tasks of its thread pool.
 
 Int_t TFilePrefetch::ThreadStart()
 {
-   int rc;
-
-   fConsumer = new TThread((TThread::VoidRtnFunc_t) ThreadProc, (void*) this);
-   rc = fConsumer->Run();
-   if ( !rc ) {
-      fThreadJoined = kFALSE;
+   if (ROOT::IsImplicitMTEnabled())
+      return 0;
+
+   try {
+      for (Int_t i = 0; i < fDepth; i++)
+         fConsumers.emplace_back([this] { ReadListOfBlocks(); });
+   } catch (const std::system_error &) {
+      if (fConsumers.empty())
+         return 1;
    }
-   return rc;
-}
-
-
-////////////////////////////////////////////////////////////////////////////////
-/// Execution loop of the consumer thread.
-
-TThread::VoidRtnFunc_t TFilePrefetch::ThreadProc(void* arg)
-{
-   TFilePrefetch* pClass = (TFilePrefetch*) arg;
-
-   while (!pClass->IsPrefetchFinished()) {
-      pClass->ReadListOfBlocks();
-   }
-
-   return (TThread::VoidRtnFunc_t) 1;
+   fThreadJoined = kFALSE;
+   return 0;
 }
 
 //############################# CACHING PART ###################################
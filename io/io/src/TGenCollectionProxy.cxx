@@ -945,6 +945,12 @@ TGenCollectionProxy *TGenCollectionProxy::InitializeEx(Bool_t silent)
          if (fPointers || (0 != (fVal->fProperties&kNeedDelete))) {
             fProperties |= kNeedDelete;
          }
+         // Readers can then access the elements of e.g. a std::vector<float> as a plain array, without calls to At().
+         // std::vector<bool> is excluded since At() returns the address of a copy of the element.
+         if ((fSTL_type == ROOT::kSTLvector || fSTL_type == ROOT::kROOTRVec) && !fPointers &&
+             fVal->fKind != kBool_t && size_t(fValDiff) == fVal->fSize) {
+            fProperties |= kIsContiguous;
+         }
          fClass = cl;
          //fValue must be set last since we use it to indicate that we are initialized
          fValue = newfValue;
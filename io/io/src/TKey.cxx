@@ -49,6 +49,7 @@
 
 #include <atomic>
 #include <iostream>
+#include <vector>
 
 #include "TROOT.h"
 #include "TClass.h"
@@ -82,6 +83,57 @@ const UChar_t kPidOffsetShift = 48;
 const static TString gTDirectoryString("TDirectory");
 std::atomic<UInt_t> keyAbsNumber{0};
 
+namespace {
+
+////////////////////////////////////////////////////////////////////////////////
+/// Compress the streamed object of a key into blocks of at most kMAXZIPBUF bytes
+/// each, with its own compression header (see R__unzip_header). The blocks of large
+/// objects are compressed concurrently if implicit multi-threading is enabled, the
+/// result is the same as when they are compressed one after the other.
+/// Returns the total size of the compressed blocks, or 0 if the object cannot be
+/// compressed.
+
+Int_t CompressObject(TFile *file, Int_t cxlevel, ROOT::RCompressionSetting::EAlgorithm::EValues algorithm,
+                     char *objbuf, Int_t objlen, char *buffer)
+{
+   const Int_t nbuffers = 1 + (objlen - 1) / kMAXZIPBUF;
+   auto blockSize = [=](Int_t i) { return i == nbuffers - 1 ? objlen - i * kMAXZIPBUF : kMAXZIPBUF; };
+
+   if (nbuffers == 1 || !ROOT::IsImplicitMTEnabled()) {
+      Int_t noutot = 0;
+      for (Int_t i = 0; i < nbuffers; ++i) {
+         Int_t bufmax = blockSize(i);
+         Int_t nout = 0;
+         file->CompressBuffer(cxlevel, &bufmax, objbuf + i * kMAXZIPBUF, &bufmax, buffer + noutot, &nout, algorithm);
+         if (nout == 0 || nout >= objlen)
+            return 0;
+         noutot += nout;
+      }
+      return noutot;
+   }
+
+   // Each block is compressed in place of its uncompressed size, then the blocks are moved next to each other
+   std::vector<Int_t> nouts(nbuffers, 0);
+   auto compressBlock = [&](UInt_t i) {
+      Int_t bufmax = blockSize(i);
+      file->CompressBuffer(cxlevel, &bufmax, objbuf + i * kMAXZIPBUF, &bufmax, buffer + i * kMAXZIPBUF, &nouts[i],
+                           algorithm);
+   };
+   ROOT::Internal::ForEachInImplicitMTPool(nbuffers, compressBlock);
+
+   Int_t noutot = 0;
+   for (Int_t i = 0; i < nbuffers; ++i) {
+      if (nouts[i] == 0 || nouts[i] >= objlen)
+         return 0;
+      if (noutot != i * kMAXZIPBUF)
+         memmove(buffer + noutot, buffer + i * kMAXZIPBUF, nouts[i]);
+      noutot += nouts[i];
+   }
+   return noutot;
+}
+
+} // anonymous namespace
+
 ClassImp(TKey);
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -238,7 +290,7 @@ TKey::TKey(const TObject *obj, const char *name, Int_t bufsize, TDirectory* moth
 
    Build(motherDir, obj->ClassName(), -1);
 
-   Int_t lbuf, nout, noutot, bufmax, nzip;
+   Int_t lbuf;
    fBufferRef = new TBufferFile(TBuffer::kWrite, bufsize);
    fBufferRef->SetParent(GetFile());
    fCycle     = fMotherDir->AppendKey(this);
@@ -256,25 +308,14 @@ TKey::TKey(const TObject *obj, const char *name, Int_t bufsize, TDirectory* moth
       Int_t nbuffers = 1 + (fObjlen - 1)/kMAXZIPBUF;
       Int_t buflen = TMath::Max(512,fKeylen + fObjlen + 9*nbuffers + 28); //add 28 bytes in case object is placed in a deleted gap
       fBuffer = new char[buflen];
-      char *objbuf = fBufferRef->Buffer() + fKeylen;
-      char *bufcur = &fBuffer[fKeylen];
-      noutot = 0;
-      nzip   = 0;
-      for (Int_t i = 0; i < nbuffers; ++i) {
-         if (i == nbuffers - 1) bufmax = fObjlen - nzip;
-         else               bufmax = kMAXZIPBUF;
-         R__zipMultipleAlgorithm(cxlevel, &bufmax, objbuf, &bufmax, bufcur, &nout, cxAlgorithm);
-         if (nout == 0 || nout >= fObjlen) { //this happens when the buffer cannot be compressed
-            fBuffer = fBufferRef->Buffer();
-            Create(fObjlen);
-            fBufferRef->SetBufferOffset(0);
-            Streamer(*fBufferRef);         //write key itself again
-            return;
-         }
-         bufcur += nout;
-         noutot += nout;
-         objbuf += kMAXZIPBUF;
-         nzip   += kMAXZIPBUF;
+      Int_t noutot = CompressObject(GetFile(), cxlevel, cxAlgorithm, fBufferRef->Buffer() + fKeylen, fObjlen, &fBuffer[fKeylen]);
+      if (noutot == 0) { //this happens when the buffer cannot be compressed
+         delete [] fBuffer;
+         fBuffer = fBufferRef->Buffer();
+         Create(fObjlen);
+         fBufferRef->SetBufferOffset(0);
+         Streamer(*fBufferRef);         //write key itself again
+         return;
       }
       Create(noutot);
       fBufferRef->SetBufferOffset(0);
@@ -334,7 +375,7 @@ TKey::TKey(const void *obj, const TClass *cl, const char *name, Int_t bufsize, T
    Streamer(*fBufferRef);         //write key itself
    fKeylen    = fBufferRef->Length();
 
-   Int_t lbuf, nout, noutot, bufmax, nzip;
+   Int_t lbuf;
 
    fBufferRef->MapObject(actualStart,clActual);         //register obj in map in case of self reference
    clActual->Streamer((void*)actualStart, *fBufferRef); //write object
@@ -347,25 +388,14 @@ TKey::TKey(const void *obj, const TClass *cl, const char *name, Int_t bufsize, T
       Int_t nbuffers = 1 + (fObjlen - 1)/kMAXZIPBUF;
       Int_t buflen = TMath::Max(512,fKeylen + fObjlen + 9*nbuffers + 28); //add 28 bytes in case object is placed in a deleted gap
       fBuffer = new char[buflen];
-      char *objbuf = fBufferRef->Buffer() + fKeylen;
-      char *bufcur = &fBuffer[fKeylen];
-      noutot = 0;
-      nzip   = 0;
-      for (Int_t i = 0; i < nbuffers; ++i) {
-         if (i == nbuffers - 1) bufmax = fObjlen - nzip;
-         else               bufmax = kMAXZIPBUF;
-         R__zipMultipleAlgorithm(cxlevel, &bufmax, objbuf, &bufmax, bufcur, &nout, cxAlgorithm);
-         if (nout == 0 || nout >= fObjlen) { //this happens when the buffer cannot be compressed
-            fBuffer = fBufferRef->Buffer();
-            Create(fObjlen);
-            fBufferRef->SetBufferOffset(0);
-            Streamer(*fBufferRef);         //write key itself again
-            return;
-         }
-         bufcur += nout;
-         noutot += nout;
-         objbuf += kMAXZIPBUF;
-         nzip   += kMAXZIPBUF;
+      Int_t noutot = CompressObject(GetFile(), cxlevel, cxAlgorithm, fBufferRef->Buffer() + fKeylen, fObjlen, &fBuffer[fKeylen]);
+      if (noutot == 0) { //this happens when the buffer cannot be compressed
+         delete [] fBuffer;
+         fBuffer = fBufferRef->Buffer();
+         Create(fObjlen);
+         fBufferRef->SetBufferOffset(0);
+         Streamer(*fBufferRef);         //write key itself again
+         return;
       }
       Create(noutot);
       fBufferRef->SetBufferOffset(0);
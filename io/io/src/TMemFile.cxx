@@ -15,6 +15,27 @@
 
 A TMemFile is like a normal TFile except that it reads and writes
 only from memory.
+
+### Sharing between processes
+
+A TMemFile can be published in a POSIX shared memory segment with
+PublishShared(), and opened read-only by other processes with OpenShared(),
+which reads the objects directly from the segment without copying it.
+ROOT files locate their records by offsets from their start, so the
+segment can be mapped at any address.
+~~~{.cpp}
+// producer
+TMemFile f("monitoring.root", "RECREATE");
+hpx->Write("", TObject::kOverwrite);
+f.Write();
+f.PublishShared("/monitoring");
+// consumer(s)
+std::unique_ptr<TMemFile> g(TMemFile::OpenShared("/monitoring"));
+auto h = g->Get<TH1F>("hpx");
+~~~
+Publishing again replaces the segment by a new one: the consumers that have
+it open keep reading the previous content, and get the new one when opening
+it again. The segment is removed with UnlinkShared().
 */
 
 #include "TBufferFile.h"
@@ -27,10 +48,18 @@ only from memory.
 #include "TKey.h"
 #include "TClass.h"
 #include "TVirtualMutex.h"
+#include <atomic>
+#include <cstring>
 #include <errno.h>
 #include <stdio.h>
 #include <sys/stat.h>
 
+#ifndef WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
 // The following snippet is used for developer-level debugging
 #define TMemFile_TRACE
 #ifndef TMemFile_TRACE
@@ -293,6 +322,138 @@ Long64_t TMemFile::GetSize() const
    return fSize;
 }
 
+#ifndef WIN32
+namespace {
+
+/// Header of the shared memory segments, followed by the content of the file
+struct SharedMemoryHeader {
+   char fMagic[8];
+   std::atomic<Long64_t> fSize; ///< Size of the file, set once the content is complete
+};
+
+constexpr char kSharedMemoryMagic[8] = {'R', 'O', 'O', 'T', 'S', 'H', 'M', '1'};
+/// The content starts at a cache line boundary
+constexpr Long64_t kSharedMemoryHeaderSize = 64;
+static_assert(sizeof(SharedMemoryHeader) <= kSharedMemoryHeaderSize, "Shared memory header too large");
+
+} // anonymous namespace
+#endif
+
+////////////////////////////////////////////////////////////////////////////////
+/// Copy the content of the file in a new POSIX shared memory segment named
+/// shmName (e.g. "/monitoring"), replacing the segment of that name if any,
+/// to be opened by other processes with OpenShared().
+///
+/// The content published is what was written to the file so far: call Write()
+/// first so that the file directory and header are up to date.
+/// Returns 0 on success, -1 on error.
+
+Int_t TMemFile::PublishShared(const char *shmName) const
+{
+#ifndef WIN32
+   const Long64_t size = GetSize();
+   const Long64_t total = kSharedMemoryHeaderSize + size;
+   // The consumers that mapped the previous segment keep it until they unmap it
+   shm_unlink(shmName);
+   int fd = shm_open(shmName, O_CREAT | O_EXCL | O_RDWR, 0644);
+   if (fd < 0) {
+      SysError("PublishShared", "cannot create shared memory segment %s", shmName);
+      return -1;
+   }
+   if (ftruncate(fd, total) < 0) {
+      SysError("PublishShared", "cannot resize shared memory segment %s to %lld bytes", shmName, total);
+      close(fd);
+      shm_unlink(shmName);
+      return -1;
+   }
+   void *addr = mmap(nullptr, total, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+   close(fd);
+   if (addr == MAP_FAILED) {
+      SysError("PublishShared", "cannot map shared memory segment %s", shmName);
+      shm_unlink(shmName);
+      return -1;
+   }
+   CopyTo(static_cast<char *>(addr) + kSharedMemoryHeaderSize, size);
+   auto header = new (addr) SharedMemoryHeader;
+   memcpy(header->fMagic, kSharedMemoryMagic, sizeof(kSharedMemoryMagic));
+   // Publish the size last: a consumer opening the segment before sees an empty one
+   header->fSize.store(size, std::memory_order_release);
+   munmap(addr, total);
+   return 0;
+#else
+   Error("PublishShared", "shared memory segments are not supported on this platform (%s)", shmName);
+   return -1;
+#endif
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Open read-only the TMemFile published by PublishShared() in the POSIX shared
+/// memory segment shmName. The objects are read directly from the segment,
+/// which stays mapped until the TMemFile is deleted. The file is named name, or
+/// shmName if not given.
+/// Returns nullptr if the segment does not exist or is not published yet.
+
+TMemFile *TMemFile::OpenShared(const char *shmName, const char *name)
+{
+#ifndef WIN32
+   int fd = shm_open(shmName, O_RDONLY, 0);
+   if (fd < 0) {
+      ::SysError("TMemFile::OpenShared", "cannot open shared memory segment %s", shmName);
+      return nullptr;
+   }
+   struct stat st;
+   if (fstat(fd, &st) < 0 || st.st_size < kSharedMemoryHeaderSize) {
+      ::Error("TMemFile::OpenShared", "shared memory segment %s is not published yet", shmName);
+      close(fd);
+      return nullptr;
+   }
+   const Long64_t total = st.st_size;
+   void *addr = mmap(nullptr, total, PROT_READ, MAP_SHARED, fd, 0);
+   close(fd);
+   if (addr == MAP_FAILED) {
+      ::SysError("TMemFile::OpenShared", "cannot map shared memory segment %s", shmName);
+      return nullptr;
+   }
+   std::shared_ptr<const void> mapping(addr, [total](const void *p) { munmap(const_cast<void *>(p), total); });
+
+   auto header = static_cast<const SharedMemoryHeader *>(addr);
+   const Long64_t size = header->fSize.load(std::memory_order_acquire);
+   if (memcmp(header->fMagic, kSharedMemoryMagic, sizeof(kSharedMemoryMagic)) != 0 || size <= 0 ||
+       kSharedMemoryHeaderSize + size > total) {
+      ::Error("TMemFile::OpenShared", "shared memory segment %s is not published yet", shmName);
+      return nullptr;
+   }
+
+   auto file = new TMemFile(name ? name : shmName,
+                            ZeroCopyView_t(static_cast<const char *>(addr) + kSharedMemoryHeaderSize, size));
+   file->fSharedMemory = std::move(mapping);
+   if (file->IsZombie()) {
+      delete file;
+      return nullptr;
+   }
+   return file;
+#else
+   (void)name;
+   ::Error("TMemFile::OpenShared", "shared memory segments are not supported on this platform (%s)", shmName);
+   return nullptr;
+#endif
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Remove the shared memory segment of a TMemFile published with PublishShared().
+/// The processes that have it open keep reading it. Returns 0 on success, -1
+/// on error.
+
+Int_t TMemFile::UnlinkShared(const char *shmName)
+{
+#ifndef WIN32
+   return shm_unlink(shmName);
+#else
+   (void)shmName;
+   return -1;
+#endif
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 
 void TMemFile::Print(Option_t *option /* = "" */) const
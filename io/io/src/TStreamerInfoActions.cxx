@@ -25,6 +25,8 @@
 #include "TProcessID.h"
 #include "TFile.h"
 
+#include <algorithm>
+
 static const Int_t kRegrouped = TStreamerInfo::kOffsetL;
 
 // More possible optimizations:
@@ -253,6 +255,22 @@ namespace TStreamerInfoActions
       return 0;
    }
 
+   template <typename T>
+   INLINE_TEMPLATE_ARGS Int_t ReadBasicTypeArray(TBuffer &buf, void *addr, const TConfiguration *config)
+   {
+      // Stream a fixed size array of a basic type, this includes the consecutive data
+      // members of the same type regrouped by TStreamerInfo::Compile.
+      buf.ReadFastArray((T *)(((char *)addr) + config->fOffset), config->fLength);
+      return 0;
+   }
+
+   template <typename T>
+   INLINE_TEMPLATE_ARGS Int_t WriteBasicTypeArray(TBuffer &buf, void *addr, const TConfiguration *config)
+   {
+      buf.WriteFastArray((T *)(((char *)addr) + config->fOffset), config->fLength);
+      return 0;
+   }
+
    INLINE_TEMPLATE_ARGS Int_t WriteTextTNamed(TBuffer &buf, void *addr, const TConfiguration *config)
    {
       void *x = (void *)(((char *)addr) + config->fOffset);
@@ -956,6 +974,62 @@ namespace TStreamerInfoActions
       return buf.ReadClassBuffer(TNamed_cl,(((char*)addr)+config->fOffset));
    }
 
+   class TConfigurationSkip : public TConfiguration {
+      // Configuration object for the data members skipped by a projection, see TActionSequence::CreateProjection.
+   public:
+      TConfiguredAction fAction; ///< Action reading the data member when it has no byte count.
+
+      TConfigurationSkip(TVirtualStreamerInfo *info, TConfiguredAction &action) :
+              TConfiguration(info,action.fConfiguration->fElemId,action.fConfiguration->fCompInfo,action.fConfiguration->fOffset),fAction(action) {};
+      virtual ~TConfigurationSkip() {};
+      virtual void AddToOffset(Int_t delta)
+      {
+         TConfiguration::AddToOffset(delta);
+         fAction.fConfiguration->AddToOffset(delta);
+      }
+      virtual void SetMissing()
+      {
+         TConfiguration::SetMissing();
+         fAction.fConfiguration->SetMissing();
+      }
+      virtual TConfiguration *Copy() {
+         TConfigurationSkip *copy = new TConfigurationSkip(*this);
+         fAction.fConfiguration = copy->fAction.fConfiguration->Copy(); // since the previous allocation did a 'move' of fAction we need to fix it.
+         return copy;
+      }
+   };
+
+   INLINE_TEMPLATE_ARGS Int_t SkipWithByteCount(TBuffer &buf, void *addr, const TConfiguration *conf)
+   {
+      // Skip an object, or a collection, using its byte count.
+      // Objects written without byte count are read.
+
+      static const UInt_t kByteCountMask = 0x40000000; // see TBufferFile
+
+      Int_t start = buf.Length();
+      UInt_t count;
+      buf >> count;
+      if (count & kByteCountMask) {
+         buf.SetBufferOffset(start + sizeof(UInt_t) + (count & ~kByteCountMask));
+         return 0;
+      }
+      buf.SetBufferOffset(start);
+      return ((TConfigurationSkip*)conf)->fAction(buf, addr);
+   }
+
+   INLINE_TEMPLATE_ARGS Int_t SkipTString(TBuffer &buf, void *, const TConfiguration *)
+   {
+      // Skip a TString, see TBufferFile::ReadTString.
+
+      UChar_t nwh;
+      buf >> nwh;
+      Int_t nbig = nwh;
+      if (nwh == 255)
+         buf >> nbig;
+      buf.SetBufferOffset(buf.Length() + nbig);
+      return 0;
+   }
+
    class TConfigSTL : public TConfiguration {
       // Configuration object for the kSTL case
    private:
@@ -3305,6 +3379,20 @@ void TStreamerInfo::AddReadAction(TStreamerInfoActions::TActionSequence *readSeq
          }
          break;
       }
+      // read fixed size arrays of basic types, including the regrouped consecutive members
+      case TStreamerInfo::kOffsetL + TStreamerInfo::kBool:    readSequence->AddAction( ReadBasicTypeArray<Bool_t>, new TConfiguration(this,i,compinfo,compinfo->fOffset,compinfo->fLength) ); break;
+      case TStreamerInfo::kOffsetL + TStreamerInfo::kChar:    readSequence->AddAction( ReadBasicTypeArray<Char_t>, new TConfiguration(this,i,compinfo,compinfo->fOffset,compinfo->fLength) ); break;
+      case TStreamerInfo::kOffsetL + TStreamerInfo::kShort:   readSequence->AddAction( ReadBasicTypeArray<Short_t>, new TConfiguration(this,i,compinfo,compinfo->fOffset,compinfo->fLength) ); break;
+      case TStreamerInfo::kOffsetL + TStreamerInfo::kInt:     readSequence->AddAction( ReadBasicTypeArray<Int_t>, new TConfiguration(this,i,compinfo,compinfo->fOffset,compinfo->fLength) ); break;
+      case TStreamerInfo::kOffsetL + TStreamerInfo::kLong:    readSequence->AddAction( ReadBasicTypeArray<Long_t>, new TConfiguration(this,i,compinfo,compinfo->fOffset,compinfo->fLength) ); break;
+      case TStreamerInfo::kOffsetL + TStreamerInfo::kLong64:  readSequence->AddAction( ReadBasicTypeArray<Long64_t>, new TConfiguration(this,i,compinfo,compinfo->fOffset,compinfo->fLength) ); break;
+      case TStreamerInfo::kOffsetL + TStreamerInfo::kFloat:   readSequence->AddAction( ReadBasicTypeArray<Float_t>, new TConfiguration(this,i,compinfo,compinfo->fOffset,compinfo->fLength) ); break;
+      case TStreamerInfo::kOffsetL + TStreamerInfo::kDouble:  readSequence->AddAction( ReadBasicTypeArray<Double_t>, new TConfiguration(this,i,compinfo,compinfo->fOffset,compinfo->fLength) ); break;
+      case TStreamerInfo::kOffsetL + TStreamerInfo::kUChar:   readSequence->AddAction( ReadBasicTypeArray<UChar_t>, new TConfiguration(this,i,compinfo,compinfo->fOffset,compinfo->fLength) ); break;
+      case TStreamerInfo::kOffsetL + TStreamerInfo::kUShort:  readSequence->AddAction( ReadBasicTypeArray<UShort_t>, new TConfiguration(this,i,compinfo,compinfo->fOffset,compinfo->fLength) ); break;
+      case TStreamerInfo::kOffsetL + TStreamerInfo::kUInt:    readSequence->AddAction( ReadBasicTypeArray<UInt_t>, new TConfiguration(this,i,compinfo,compinfo->fOffset,compinfo->fLength) ); break;
+      case TStreamerInfo::kOffsetL + TStreamerInfo::kULong:   readSequence->AddAction( ReadBasicTypeArray<ULong_t>, new TConfiguration(this,i,compinfo,compinfo->fOffset,compinfo->fLength) ); break;
+      case TStreamerInfo::kOffsetL + TStreamerInfo::kULong64: readSequence->AddAction( ReadBasicTypeArray<ULong64_t>, new TConfiguration(this,i,compinfo,compinfo->fOffset,compinfo->fLength) ); break;
       case TStreamerInfo::kTNamed:  readSequence->AddAction( ReadTNamed, new TConfiguration(this,i,compinfo,compinfo->fOffset) );    break;
          // Idea: We should calculate the CanIgnoreTObjectStreamer here and avoid calling the
          // Streamer alltogether.
@@ -3601,6 +3689,20 @@ void TStreamerInfo::AddWriteAction(TStreamerInfoActions::TActionSequence *writeS
       case TStreamerInfo::kUInt:    writeSequence->AddAction( WriteBasicType<UInt_t>, new TConfiguration(this,i,compinfo,compinfo->fOffset) );    break;
       case TStreamerInfo::kULong:   writeSequence->AddAction( WriteBasicType<ULong_t>, new TConfiguration(this,i,compinfo,compinfo->fOffset) );   break;
       case TStreamerInfo::kULong64: writeSequence->AddAction( WriteBasicType<ULong64_t>, new TConfiguration(this,i,compinfo,compinfo->fOffset) ); break;
+      // write fixed size arrays of basic types, including the regrouped consecutive members
+      case TStreamerInfo::kOffsetL + TStreamerInfo::kBool:    writeSequence->AddAction( WriteBasicTypeArray<Bool_t>, new TConfiguration(this,i,compinfo,compinfo->fOffset,compinfo->fLength) ); break;
+      case TStreamerInfo::kOffsetL + TStreamerInfo::kChar:    writeSequence->AddAction( WriteBasicTypeArray<Char_t>, new TConfiguration(this,i,compinfo,compinfo->fOffset,compinfo->fLength) ); break;
+      case TStreamerInfo::kOffsetL + TStreamerInfo::kShort:   writeSequence->AddAction( WriteBasicTypeArray<Short_t>, new TConfiguration(this,i,compinfo,compinfo->fOffset,compinfo->fLength) ); break;
+      case TStreamerInfo::kOffsetL + TStreamerInfo::kInt:     writeSequence->AddAction( WriteBasicTypeArray<Int_t>, new TConfiguration(this,i,compinfo,compinfo->fOffset,compinfo->fLength) ); break;
+      case TStreamerInfo::kOffsetL + TStreamerInfo::kLong:    writeSequence->AddAction( WriteBasicTypeArray<Long_t>, new TConfiguration(this,i,compinfo,compinfo->fOffset,compinfo->fLength) ); break;
+      case TStreamerInfo::kOffsetL + TStreamerInfo::kLong64:  writeSequence->AddAction( WriteBasicTypeArray<Long64_t>, new TConfiguration(this,i,compinfo,compinfo->fOffset,compinfo->fLength) ); break;
+      case TStreamerInfo::kOffsetL + TStreamerInfo::kFloat:   writeSequence->AddAction( WriteBasicTypeArray<Float_t>, new TConfiguration(this,i,compinfo,compinfo->fOffset,compinfo->fLength) ); break;
+      case TStreamerInfo::kOffsetL + TStreamerInfo::kDouble:  writeSequence->AddAction( WriteBasicTypeArray<Double_t>, new TConfiguration(this,i,compinfo,compinfo->fOffset,compinfo->fLength) ); break;
+      case TStreamerInfo::kOffsetL + TStreamerInfo::kUChar:   writeSequence->AddAction( WriteBasicTypeArray<UChar_t>, new TConfiguration(this,i,compinfo,compinfo->fOffset,compinfo->fLength) ); break;
+      case TStreamerInfo::kOffsetL + TStreamerInfo::kUShort:  writeSequence->AddAction( WriteBasicTypeArray<UShort_t>, new TConfiguration(this,i,compinfo,compinfo->fOffset,compinfo->fLength) ); break;
+      case TStreamerInfo::kOffsetL + TStreamerInfo::kUInt:    writeSequence->AddAction( WriteBasicTypeArray<UInt_t>, new TConfiguration(this,i,compinfo,compinfo->fOffset,compinfo->fLength) ); break;
+      case TStreamerInfo::kOffsetL + TStreamerInfo::kULong:   writeSequence->AddAction( WriteBasicTypeArray<ULong_t>, new TConfiguration(this,i,compinfo,compinfo->fOffset,compinfo->fLength) ); break;
+      case TStreamerInfo::kOffsetL + TStreamerInfo::kULong64: writeSequence->AddAction( WriteBasicTypeArray<ULong64_t>, new TConfiguration(this,i,compinfo,compinfo->fOffset,compinfo->fLength) ); break;
        // case TStreamerInfo::kBits:    writeSequence->AddAction( WriteBasicType<BitsMarker>, new TConfiguration(this,i,compinfo,compinfo->fOffset) );    break;
      /*case TStreamerInfo::kFloat16: {
          if (element->GetFactor() != 0) {
@@ -4236,6 +4338,50 @@ TStreamerInfoActions::TActionSequence *TStreamerInfoActions::TActionSequence::Cr
    return sequence;
 }
 
+TStreamerInfoActions::TActionSequence *TStreamerInfoActions::TActionSequence::CreateProjection(const std::vector<std::string> &members)
+{
+   // Create a copy of this (object-wise reading) sequence in which the data members not listed
+   // in 'members' are not read. The objects and collections are skipped using their byte count
+   // and the TString using their length, they keep the value they had in the object.
+   // The base classes and the data members of other types, which are cheap to read, are read.
+
+   TStreamerInfoActions::TActionSequence *sequence = new TStreamerInfoActions::TActionSequence(fStreamerInfo, fActions.size(), IsForVectorPtrLooper());
+
+   sequence->fLoopConfig = fLoopConfig ? fLoopConfig->Copy() : 0;
+
+   TStreamerInfoActions::ActionContainer_t::iterator end = fActions.end();
+   for(TStreamerInfoActions::ActionContainer_t::iterator iter = fActions.begin();
+       iter != end;
+       ++iter)
+   {
+      TConfiguration *conf = iter->fConfiguration->Copy();
+      TStreamerElement *element = (TStreamerElement*)conf->fInfo->GetElements()->At(conf->fElemId);
+      const Bool_t keep = fLoopConfig || IsForVectorPtrLooper() || !element || element->IsBase() ||
+                          element->TestBit(TStreamerElement::kCache) ||
+                          std::find(members.begin(), members.end(), element->GetName()) != members.end();
+      if (keep) {
+         sequence->AddAction( iter->fAction, conf );
+         continue;
+      }
+      switch (conf->fCompInfo->fType) {
+         case TStreamerInfo::kObject:
+         case TStreamerInfo::kAny:
+         case TStreamerInfo::kTNamed:
+         case TStreamerInfo::kSTL: {
+            TConfiguredAction original(iter->fAction, conf);
+            sequence->AddAction( SkipWithByteCount, new TConfigurationSkip(conf->fInfo, original) );
+            break;
+         }
+         case TStreamerInfo::kTString:
+            sequence->AddAction( SkipTString, conf );
+            break;
+         default:
+            sequence->AddAction( iter->fAction, conf );
+      }
+   }
+   return sequence;
+}
+
 void TStreamerInfoActions::TActionSequence::AddToSubSequence(TStreamerInfoActions::TActionSequence *sequence,
       const TStreamerInfoActions::TIDs &element_ids,
       Int_t offset,
@@ -0,0 +1,121 @@
+#include "ROOT/RBlockCache.hxx"
+#include "ROOT/RRawFile.hxx"
+
+#include "TSystem.h"
+
+#include <cstring>
+#include <string>
+
+#include "gtest/gtest.h"
+
+using RBlockCache = ROOT::Internal::RBlockCache;
+using RRawFile = ROOT::Internal::RRawFile;
+
+namespace {
+
+/// A cache in a temporary directory, removed with its blocks when going out of scope
+class RBlockCacheRaii {
+private:
+   std::string fDirectory;
+
+public:
+   RBlockCache fCache;
+
+   RBlockCacheRaii(const std::string &name, std::uint64_t maxSize, std::size_t blockSize)
+      : fDirectory(std::string(gSystem->TempDirectory()) + "/" + name), fCache(fDirectory, maxSize, blockSize)
+   {
+      gSystem->Exec(("rm -rf " + fDirectory).c_str());
+      gSystem->mkdir(fDirectory.c_str(), kTRUE);
+   }
+   ~RBlockCacheRaii() { gSystem->Exec(("rm -rf " + fDirectory).c_str()); }
+};
+
+/// Serves the ranges from a string, counting the fetched blocks
+struct RFakeRemote {
+   std::string fContent;
+   unsigned int fNFetched = 0;
+
+   bool operator()(RRawFile::RIOVec *ioVec, unsigned int nReq)
+   {
+      for (unsigned int i = 0; i < nReq; ++i) {
+         auto slice = fContent.substr(ioVec[i].fOffset, ioVec[i].fSize);
+         memcpy(ioVec[i].fBuffer, slice.data(), slice.size());
+         ioVec[i].fOutBytes = slice.size();
+      }
+      fNFetched += nReq;
+      return true;
+   }
+};
+
+} // anonymous namespace
+
+TEST(RBlockCache, ReadV)
+{
+   RBlockCacheRaii raii("RBlockCache_ReadV", 1024 * 1024, 4);
+   RFakeRemote remote;
+   remote.fContent = "0123456789abcdefghij";
+   auto fetch = [&remote](RRawFile::RIOVec *ioVec, unsigned int nReq) { return remote(ioVec, nReq); };
+
+   char a[6], b[6];
+   RRawFile::RIOVec ioVec[2];
+   ioVec[0].fBuffer = a;
+   ioVec[0].fOffset = 2;
+   ioVec[0].fSize = 5;
+   ioVec[1].fBuffer = b;
+   ioVec[1].fOffset = 17;
+   ioVec[1].fSize = 5;
+   EXPECT_TRUE(raii.fCache.ReadV("file", remote.fContent.size(), ioVec, 2, fetch));
+   EXPECT_EQ(5u, ioVec[0].fOutBytes);
+   EXPECT_EQ("23456", std::string(a, 5));
+   // Short read at the end of the file
+   EXPECT_EQ(3u, ioVec[1].fOutBytes);
+   EXPECT_EQ("hij", std::string(b, 3));
+   // Blocks 0, 1 and 4
+   EXPECT_EQ(3u, remote.fNFetched);
+   EXPECT_EQ(3u, raii.fCache.GetMetrics().fNMisses);
+
+   // Served from the cache
+   memset(a, 0, sizeof(a));
+   memset(b, 0, sizeof(b));
+   EXPECT_TRUE(raii.fCache.ReadV("file", remote.fContent.size(), ioVec, 2, fetch));
+   EXPECT_EQ("23456", std::string(a, 5));
+   EXPECT_EQ("hij", std::string(b, 3));
+   EXPECT_EQ(3u, remote.fNFetched);
+   EXPECT_EQ(3u, raii.fCache.GetMetrics().fNHits);
+
+   // Only the missing block is fetched
+   ioVec[0].fOffset = 6;
+   ioVec[0].fSize = 4;
+   EXPECT_TRUE(raii.fCache.ReadV("file", remote.fContent.size(), ioVec, 1, fetch));
+   EXPECT_EQ("6789", std::string(a, 4));
+   EXPECT_EQ(4u, remote.fNFetched);
+
+   // Other files do not share the blocks
+   EXPECT_TRUE(raii.fCache.ReadV("other", remote.fContent.size(), ioVec, 1, fetch));
+   EXPECT_EQ(6u, remote.fNFetched);
+
+   // Failed reads are reported
+   EXPECT_FALSE(raii.fCache.ReadV("failing", remote.fContent.size(), ioVec, 1,
+                                  [](RRawFile::RIOVec *, unsigned int) { return false; }));
+}
+
+TEST(RBlockCache, Evict)
+{
+   // Room for four blocks of 256 bytes
+   RBlockCacheRaii raii("RBlockCache_Evict", 1024, 256);
+   RFakeRemote remote;
+   remote.fContent = std::string(16 * 256, 'x');
+   auto fetch = [&remote](RRawFile::RIOVec *ioVec, unsigned int nReq) { return remote(ioVec, nReq); };
+
+   char buffer[256];
+   RRawFile::RIOVec ioVec;
+   ioVec.fBuffer = buffer;
+   ioVec.fSize = sizeof(buffer);
+   for (unsigned int i = 0; i < 16; ++i) {
+      ioVec.fOffset = i * 256;
+      EXPECT_TRUE(raii.fCache.ReadV("file", remote.fContent.size(), &ioVec, 1, fetch));
+      EXPECT_EQ(256u, ioVec.fOutBytes);
+   }
+   // At most four blocks are left
+   EXPECT_LE(12u, raii.fCache.GetMetrics().fNEvicted);
+}
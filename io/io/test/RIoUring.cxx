@@ -43,6 +43,56 @@ TEST(RRawFileUnix, ReadV)
    }
 }
 
+TEST(RRawFileUnix, ReadVReuseRing)
+{
+   auto file = "test_uring_readv_reuse";
+   FileRaii fileGuard(file, "abcdefghij");
+   auto f = RRawFileUnix::Create(file);
+
+   char buffer[2][8];
+   for (int round = 0; round < 3; ++round) {
+      RIOVec iovecs[2];
+      iovecs[0].fBuffer = buffer[0];
+      iovecs[0].fOffset = round;
+      iovecs[0].fSize = 2;
+      // Crosses the end of the file, results in a short read
+      iovecs[1].fBuffer = buffer[1];
+      iovecs[1].fOffset = 6;
+      iovecs[1].fSize = 8;
+      f->ReadV(iovecs, 2);
+
+      EXPECT_EQ(2U, iovecs[0].fOutBytes);
+      EXPECT_EQ(std::string("abcdefghij").substr(round, 2), std::string(buffer[0], 2));
+      EXPECT_EQ(4U, iovecs[1].fOutBytes);
+      EXPECT_EQ("ghij", std::string(buffer[1], 4));
+   }
+}
+
+TEST(RawUring, RegisteredFile)
+{
+   auto file = "test_uring_registered";
+   FileRaii fileGuard(file, "abcdefghij");
+   RRawFileUnix f(file, RRawFile::ROptions());
+   // files are opened lazily, force file open via GetSize
+   EXPECT_EQ(10U, f.GetSize());
+
+   RIoUring ring(4);
+   EXPECT_TRUE(ring.RegisterFile(f.GetFd()));
+   // Only a single file can be registered
+   EXPECT_TRUE(ring.RegisterFile(f.GetFd()));
+   EXPECT_FALSE(ring.RegisterFile(f.GetFd() + 1));
+
+   char buffer[4];
+   RIoUring::RReadEvent ev;
+   ev.fBuffer = buffer;
+   ev.fOffset = 3;
+   ev.fSize = 4;
+   ev.fFileDes = f.GetFd();
+   ring.SubmitReadsAndWait(&ev, 1);
+   EXPECT_EQ(4U, ev.fOutBytes);
+   EXPECT_EQ("defg", std::string(buffer, 4));
+}
+
 TEST(RawUring, NopRoundTrip)
 {
    struct io_uring ring;
@@ -1,5 +1,8 @@
 #include "TBufferJSON.h"
 #include "TNamed.h"
+#include "TList.h"
+#include "TArrayD.h"
+#include <sstream>
 #include <string>
 
 #include "gtest/gtest.h"
@@ -47,3 +50,42 @@ TEST(TBufferJSON, utf8_3)
    EXPECT_EQ(str0, named1->GetTitle());
 }
 
+
+// check that streamed JSON is the same as converted into string
+TEST(TBufferJSON, stream)
+{
+   TList lst;
+   lst.SetOwner(kTRUE);
+   for (int n = 0; n < 100; ++n)
+      lst.Add(new TNamed(TString::Format("name%d", n).Data(), "title"));
+
+   for (Int_t compact : {0, 3, 23}) {
+      auto json = TBufferJSON::ConvertToJSON(&lst, compact);
+
+      std::ostringstream out;
+      auto len = TBufferJSON::ConvertToJSON(out, &lst, compact);
+
+      EXPECT_EQ(len, (Long64_t) json.Length());
+      EXPECT_EQ(out.str(), std::string(json.Data()));
+   }
+
+   // chunks are produced while object is stored
+   int nchunks = 0;
+   std::string chunks;
+   TBufferJSON buf;
+   buf.SetOutputSink([&](const char *data, Int_t len) { chunks.append(data, len); ++nchunks; }, 100);
+   auto res = buf.StoreObject(&lst, TList::Class());
+   EXPECT_TRUE(res.IsNull());
+   EXPECT_GT(nchunks, 10);
+   EXPECT_EQ(chunks, std::string(TBufferJSON::ConvertToJSON(&lst).Data()));
+}
+
+// check formatting of values, including integral fast path
+TEST(TBufferJSON, values)
+{
+   Double_t vals[5] = {1., -2., 0., 123456789012., 1e17};
+   TArrayD arr(5, vals);
+   std::ostringstream out;
+   TBufferJSON::ConvertToJSON(out, &arr, TArrayD::Class(), TBufferJSON::kNoSpaces);
+   EXPECT_EQ(out.str(), "[1,-2,0,123456789012,100000000000000000]");
+}
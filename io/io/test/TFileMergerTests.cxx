@@ -2,7 +2,11 @@
 
 #include "TFileMerger.h"
 
+#include "TFile.h"
+#include "TH1.h"
 #include "TMemFile.h"
+#include "TROOT.h"
+#include "TSystem.h"
 #include "TTree.h"
 
 static void CreateATuple(TMemFile &file, const char *name, double value)
@@ -68,3 +72,89 @@ TEST(TFileMerger, CreateWithUnwritableTFilePointer)
    ROOT_EXPECT_ERROR(merger.OutputFile(std::move(output)), "TFileMerger::OutputFile",
                      "output file output.root is not writable");
 }
+
+TEST(TFileMerger, PrefetchExcessFiles)
+{
+   const int nInputs = 5;
+   for (int i = 0; i < nInputs; ++i) {
+      TFile f(TString::Format("tfilemerger_prefetch_%d.root", i), "RECREATE");
+      auto t = new TTree("t", "t");
+      t->SetImplicitMT(false);
+      int value = i;
+      t->Branch("value", &value);
+      t->Fill();
+      f.Write();
+   }
+
+   {
+      TFileMerger merger(kFALSE);
+      // One source file open at a time, the next two opened in the background.
+      merger.SetMaxOpenedFiles(2);
+      merger.SetPrefetchFiles(2);
+      EXPECT_EQ(2, merger.GetPrefetchFiles());
+      ASSERT_TRUE(merger.OutputFile("tfilemerger_prefetch_out.root", "RECREATE"));
+      for (int i = 0; i < nInputs; ++i)
+         ASSERT_TRUE(merger.AddFile(TString::Format("tfilemerger_prefetch_%d.root", i), kFALSE));
+      EXPECT_TRUE(merger.Merge());
+   }
+
+   TFile out("tfilemerger_prefetch_out.root");
+   auto t = out.Get<TTree>("t");
+   ASSERT_TRUE(t != nullptr);
+   EXPECT_EQ(nInputs, t->GetEntries());
+   int value = -1;
+   t->SetBranchAddress("value", &value);
+   for (int i = 0; i < nInputs; ++i) {
+      t->GetEntry(i);
+      EXPECT_EQ(i, value);
+   }
+   t->ResetBranchAddresses();
+
+   gSystem->Unlink("tfilemerger_prefetch_out.root");
+   for (int i = 0; i < nInputs; ++i)
+      gSystem->Unlink(TString::Format("tfilemerger_prefetch_%d.root", i));
+}
+
+TEST(TFileMerger, ParallelMerges)
+{
+   const int nInputs = 3;
+   const int nHists = 10;
+   for (int i = 0; i < nInputs; ++i) {
+      TFile f(TString::Format("tfilemerger_parallel_%d.root", i), "RECREATE");
+      TDirectory *dirs[] = {&f, f.mkdir("d")};
+      for (auto dir : dirs) {
+         dir->cd();
+         for (int j = 0; j < nHists; ++j) {
+            auto h = new TH1F(TString::Format("h%d", j), "h", 10, 0., 10.);
+            h->Fill(j, i + 1);
+         }
+         dir->Write();
+      }
+   }
+
+   ROOT::EnableImplicitMT(2);
+   {
+      TFileMerger merger(kFALSE, kFALSE);
+      merger.SetParallelMerges(4);
+      EXPECT_EQ(4, merger.GetParallelMerges());
+      ASSERT_TRUE(merger.OutputFile("tfilemerger_parallel_out.root", "RECREATE"));
+      for (int i = 0; i < nInputs; ++i)
+         ASSERT_TRUE(merger.AddFile(TString::Format("tfilemerger_parallel_%d.root", i), kFALSE));
+      EXPECT_TRUE(merger.Merge());
+   }
+   ROOT::DisableImplicitMT();
+
+   TFile out("tfilemerger_parallel_out.root");
+   for (const char *dir : {"", "d/"}) {
+      for (int j = 0; j < nHists; ++j) {
+         auto h = out.Get<TH1F>(TString::Format("%sh%d", dir, j));
+         ASSERT_TRUE(h != nullptr) << dir << j;
+         EXPECT_DOUBLE_EQ(nInputs * (nInputs + 1) / 2, h->GetBinContent(j + 1)) << dir << j;
+         EXPECT_DOUBLE_EQ(nInputs, h->GetEntries()) << dir << j;
+      }
+   }
+
+   gSystem->Unlink("tfilemerger_parallel_out.root");
+   for (int i = 0; i < nInputs; ++i)
+      gSystem->Unlink(TString::Format("tfilemerger_parallel_%d.root", i));
+}
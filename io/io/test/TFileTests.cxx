@@ -1,11 +1,19 @@
+#include <atomic>
+#include <memory>
 #include <vector>
 
 #include "gtest/gtest.h"
 
+#include "TAttLine.h"
 #include "TFile.h"
 #include "TKey.h"
+#include "TMemFile.h"
 #include "TNamed.h"
+#include "TObjString.h"
+#include "TROOT.h"
+#include "TStreamerInfo.h"
 #include "TSystem.h"
+#include "RZip.h"
 
 TEST(TFile, WriteObjectTObject)
 {
@@ -85,3 +93,205 @@ TEST(TFile, ReadFromSameFile)
 
    EXPECT_TRUE(o1 != o2) << "Same objects read from two different files have the same pointer!";
 }
+
+// The consecutive Short_t data members of TAttLine are regrouped into a single array.
+TEST(TFile, ReadWriteRegroupedBasicMembers)
+{
+   const char *filename = "tfile_regrouped_basic_members.root";
+   {
+      TAttLine line(2, 3, 4);
+      TFile f(filename, "RECREATE");
+      f.WriteObjectAny(&line, TAttLine::Class(), "line");
+      f.Close();
+   }
+
+   auto info = static_cast<TStreamerInfo *>(TAttLine::Class()->GetStreamerInfo());
+   ASSERT_NE(nullptr, info);
+   ASSERT_EQ(1, info->GetNdata());
+   EXPECT_EQ(3, info->GetLength(0));
+
+   TFile f(filename);
+   std::unique_ptr<TAttLine> line(f.Get<TAttLine>("line"));
+   ASSERT_NE(nullptr, line);
+   EXPECT_EQ(2, line->GetLineColor());
+   EXPECT_EQ(3, line->GetLineStyle());
+   EXPECT_EQ(4, line->GetLineWidth());
+   f.Close();
+
+   gSystem->Unlink(filename);
+}
+
+TEST(TFile, OpenReadMMap)
+{
+   const char *filename = "tfile_open_read_mmap.root";
+   {
+      TFile f(filename, "RECREATE");
+      TNamed named("named", "a title");
+      f.WriteObject(&named, named.GetName());
+      f.Close();
+   }
+
+   std::unique_ptr<TFile> f(TFile::Open(filename, "READ_MMAP"));
+   ASSERT_TRUE(f);
+   ASSERT_FALSE(f->IsZombie());
+   EXPECT_FALSE(f->IsWritable());
+#ifndef _MSC_VER
+   EXPECT_TRUE(f->InheritsFrom(TMemFile::Class()));
+#endif
+   auto named = f->Get<TNamed>("named");
+   ASSERT_NE(nullptr, named);
+   EXPECT_STREQ("a title", named->GetTitle());
+   f.reset();
+
+   EXPECT_EQ(nullptr, TFile::Open("tfile_open_read_mmap_does_not_exist.root", "READ_MMAP"));
+
+   gSystem->Unlink(filename);
+}
+
+TEST(TFile, ZSTDDictionary)
+{
+   const char *filename = "tfile_zstd_dictionary.root";
+   const int nObjects = 2000;
+   auto content = [](int i) {
+      TString s;
+      for (int j = 0; j < 20; ++j)
+         s += TString::Format("calibration constant %d of channel %d: %d; ", j, i, (i * 37 + j * 11) % 1000);
+      return s;
+   };
+   {
+      TFile f(filename, "RECREATE", "", ROOT::RCompressionSetting::EAlgorithm::kZSTDDict * 100 + 5);
+      for (int i = 0; i < nObjects; ++i) {
+         TObjString obj(content(i));
+         f.WriteObject(&obj, TString::Format("obj%d", i));
+      }
+      EXPECT_NE(0u, f.GetZstdDictionaryID());
+      f.Close();
+   }
+
+   TFile f(filename);
+   EXPECT_NE(nullptr, f.GetKey("ZSTDDictionary"));
+   EXPECT_NE(0u, f.GetZstdDictionaryID());
+   for (int i = 0; i < nObjects; i += 97) {
+      std::unique_ptr<TObjString> obj(f.Get<TObjString>(TString::Format("obj%d", i)));
+      ASSERT_NE(nullptr, obj);
+      EXPECT_EQ(content(i), obj->String());
+   }
+   std::unique_ptr<TObjString> last(f.Get<TObjString>(TString::Format("obj%d", nObjects - 1)));
+   ASSERT_NE(nullptr, last);
+   EXPECT_EQ(content(nObjects - 1), last->String());
+   f.Close();
+
+   gSystem->Unlink(filename);
+}
+
+// Objects larger than kMAXZIPBUF are compressed in several blocks, concurrently with implicit multi-threading.
+TEST(TFile, CompressLargeObjectInBlocks)
+{
+   const char *filename = "tfile_compress_large_object.root";
+   std::vector<int> values(10000000);
+   for (std::size_t i = 0; i < values.size(); ++i)
+      values[i] = (i * 7) % 1000;
+
+   auto write = [&]() {
+      TFile f(filename, "RECREATE");
+      f.WriteObject(&values, "values");
+      auto key = f.GetKey("values");
+      return key ? key->GetNbytes() : 0;
+   };
+   const auto nbytesSerial = write();
+#ifdef R__USE_IMT
+   ROOT::EnableImplicitMT(4);
+   EXPECT_EQ(nbytesSerial, write());
+   ROOT::DisableImplicitMT();
+#endif
+   ASSERT_GT(nbytesSerial, 0);
+
+   TFile f(filename);
+   std::unique_ptr<std::vector<int>> read(f.Get<std::vector<int>>("values"));
+   ASSERT_NE(nullptr, read);
+   EXPECT_EQ(values, *read);
+   f.Close();
+
+   gSystem->Unlink(filename);
+}
+
+namespace {
+std::atomic<int> gTestZlibCalls{0};
+int TestZlibCompress(int, const char *, int, char *, int)
+{
+   ++gTestZlibCalls;
+   return 0; // fall back to the builtin zlib
+}
+int TestZlibDecompress(const unsigned char *, int, unsigned char *, int)
+{
+   ++gTestZlibCalls;
+   return 0;
+}
+const R__ZlibBackend gTestZlibBackend{"test", &TestZlibCompress, &TestZlibDecompress};
+} // namespace
+
+TEST(TFile, ZlibBackend)
+{
+   const char *filename = "tfile_zlib_backend.root";
+   EXPECT_EQ(1, R__RegisterZlibBackend(&gTestZlibBackend));
+   EXPECT_EQ(0, R__RegisterZlibBackend(&gTestZlibBackend));
+   EXPECT_EQ(1, R__SetZlibBackend("test"));
+   EXPECT_STREQ("test", R__GetZlibBackend());
+
+   TString title;
+   for (int i = 0; i < 100; ++i)
+      title += "a title that compresses well ";
+   {
+      TFile f(filename, "RECREATE", "", ROOT::RCompressionSetting::EAlgorithm::kZLIB * 100 + 1);
+      TNamed named("named", title.Data());
+      f.WriteObject(&named, named.GetName());
+      f.Close();
+   }
+   const int nCompressCalls = gTestZlibCalls;
+   EXPECT_GT(nCompressCalls, 0);
+   {
+      TFile f(filename);
+      std::unique_ptr<TNamed> named(f.Get<TNamed>("named"));
+      ASSERT_NE(nullptr, named);
+      EXPECT_EQ(title, named->GetTitle());
+   }
+   EXPECT_GT(gTestZlibCalls, nCompressCalls);
+
+   EXPECT_EQ(1, R__SetZlibBackend("zlib"));
+   EXPECT_EQ(0, R__SetZlibBackend("not registered"));
+   EXPECT_STREQ("zlib", R__GetZlibBackend());
+   R__SetZlibBackend("zlib");
+   gSystem->Unlink(filename);
+}
+
+// A file whose StreamerInfo record was already read from another file still lists
+// the record's TStreamerInfo, so that they are rewritten when the file is updated.
+TEST(TFile, SharedStreamerInfoRecord)
+{
+   const char *filenames[] = {"tfile_shared_si_1.root", "tfile_shared_si_2.root"};
+   for (auto filename : filenames) {
+      TFile f(filename, "RECREATE");
+      TAttLine att;
+      f.WriteObject(&att, "att");
+      f.Close();
+   }
+
+   TFile first(filenames[0]);
+   {
+      TFile f(filenames[1], "UPDATE");
+      TNamed named("named", "title");
+      f.WriteObject(&named, named.GetName());
+      f.Close();
+   }
+   first.Close();
+
+   TFile f(filenames[1]);
+   std::unique_ptr<TList> infos(f.GetStreamerInfoList());
+   ASSERT_NE(nullptr, infos);
+   EXPECT_NE(nullptr, infos->FindObject("TAttLine"));
+   EXPECT_NE(nullptr, infos->FindObject("TNamed"));
+   f.Close();
+
+   for (auto filename : filenames)
+      gSystem->Unlink(filename);
+}
@@ -1,7 +1,9 @@
 #include "TMemFile.h"
 
 #include "TError.h"
+#include "TNamed.h"
 #include <cstring>
+#include <memory>
 
 #include "gtest/gtest.h"
 
@@ -84,3 +86,42 @@ TEST(TROMemFile, RealNoMemCopy)
    };
    ASSERT_EQ(expected.c_str(), MemBlockPtrGetter::GetBlockStart(&rosmf));
 }
+
+#ifndef _WIN32
+TEST(TROMemFile, SharedMemory)
+{
+   const char *shmName = "/TROMemFile_SharedMemory";
+   TNamed n("name", "first");
+   TMemFile memFile("shared.root", "RECREATE");
+   memFile.WriteTObject(&n);
+   memFile.Write();
+   ASSERT_EQ(0, memFile.PublishShared(shmName));
+
+   std::unique_ptr<TMemFile> first(TMemFile::OpenShared(shmName));
+   ASSERT_NE(nullptr, first);
+   EXPECT_FALSE(first->IsWritable());
+   std::unique_ptr<TNamed> readN(first->Get<TNamed>("name"));
+   ASSERT_NE(nullptr, readN);
+   EXPECT_STREQ("first", readN->GetTitle());
+
+   // A new publication does not change the files already open
+   n.SetTitle("second");
+   memFile.WriteTObject(&n, nullptr, "Overwrite");
+   memFile.Write();
+   ASSERT_EQ(0, memFile.PublishShared(shmName));
+   std::unique_ptr<TMemFile> second(TMemFile::OpenShared(shmName));
+   ASSERT_NE(nullptr, second);
+   readN.reset(second->Get<TNamed>("name"));
+   ASSERT_NE(nullptr, readN);
+   EXPECT_STREQ("second", readN->GetTitle());
+   readN.reset(first->Get<TNamed>("name"));
+   ASSERT_NE(nullptr, readN);
+   EXPECT_STREQ("first", readN->GetTitle());
+
+   EXPECT_EQ(0, TMemFile::UnlinkShared(shmName));
+   const auto level = gErrorIgnoreLevel;
+   gErrorIgnoreLevel = kFatal;
+   EXPECT_EQ(nullptr, TMemFile::OpenShared(shmName));
+   gErrorIgnoreLevel = level;
+}
+#endif
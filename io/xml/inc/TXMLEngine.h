@@ -18,9 +18,12 @@ typedef void *XMLNodePointer_t;
 typedef void *XMLNsPointer_t;
 typedef void *XMLAttrPointer_t;
 typedef void *XMLDocPointer_t;
+typedef void *XMLReaderPointer_t;
+typedef void *XMLWriterPointer_t;
 
 class TXMLInputStream;
 class TXMLOutputStream;
+class TXMLArena;
 class TString;
 
 class TXMLEngine : public TObject {
@@ -28,20 +31,31 @@ class TXMLEngine : public TObject {
 protected:
    char *Makestr(const char *str);
    char *Makenstr(const char *start, int len);
-   XMLNodePointer_t AllocateNode(int namelen, XMLNodePointer_t parent);
-   XMLAttrPointer_t AllocateAttr(int namelen, int valuelen, XMLNodePointer_t xmlnode);
+   XMLNodePointer_t AllocateNode(int namelen, XMLNodePointer_t parent, TXMLArena *arena = nullptr);
+   XMLAttrPointer_t AllocateAttr(int namelen, int valuelen, XMLNodePointer_t xmlnode, TXMLArena *arena = nullptr);
    XMLNsPointer_t FindNs(XMLNodePointer_t xmlnode, const char *nsname);
    void TruncateNsExtension(XMLNodePointer_t xmlnode);
    void UnpackSpecialCharacters(char *target, const char *source, int srclen);
    void OutputValue(char *value, TXMLOutputStream *out);
    void SaveNode(XMLNodePointer_t xmlnode, TXMLOutputStream *out, Int_t layout, Int_t level);
-   XMLNodePointer_t ReadNode(XMLNodePointer_t xmlparent, TXMLInputStream *inp, Int_t &resvalue);
+   XMLNodePointer_t ReadNode(XMLNodePointer_t xmlparent, TXMLInputStream *inp, Int_t &resvalue, Bool_t withchildren = kTRUE);
    void DisplayError(Int_t error, Int_t linenumber);
    XMLDocPointer_t ParseStream(TXMLInputStream *input);
 
    Bool_t fSkipComments; //! if true, do not create comments nodes in document during parsing
 
 public:
+   /// events returned by ReadNext
+   enum EReaderEvent {
+      kReaderError = -1, ///< error in the document, already reported
+      kReaderEnd = 0,    ///< end of the document
+      kReaderStartNode,  ///< start of a node, its name and attributes are available
+      kReaderEndNode,    ///< end of a node
+      kReaderContent,    ///< content of the enclosing node
+      kReaderComment,    ///< comment
+      kReaderPINode      ///< processing instruction like <?xml version="1.0"?>
+   };
+
    TXMLEngine();
    virtual ~TXMLEngine();
 
@@ -105,6 +119,22 @@ public:
    void SaveSingleNode(XMLNodePointer_t xmlnode, TString *res, Int_t layout = 1);
    XMLNodePointer_t ReadSingleNode(const char *src);
 
+   XMLReaderPointer_t OpenReader(const char *filename, Int_t maxbuf = 100000);
+   XMLReaderPointer_t OpenStringReader(const char *xmlstring);
+   Int_t ReadNext(XMLReaderPointer_t xmlreader);
+   XMLNodePointer_t GetReaderNode(XMLReaderPointer_t xmlreader);
+   Int_t GetReaderDepth(XMLReaderPointer_t xmlreader);
+   XMLNodePointer_t ReadSubtree(XMLReaderPointer_t xmlreader);
+   void CloseReader(XMLReaderPointer_t xmlreader);
+
+   XMLWriterPointer_t OpenWriter(const char *filename, Int_t layout = 1);
+   void WriteStartNode(XMLWriterPointer_t xmlwriter, const char *name);
+   void WriteAttr(XMLWriterPointer_t xmlwriter, const char *name, const char *value);
+   void WriteContent(XMLWriterPointer_t xmlwriter, const char *content);
+   void WriteNode(XMLWriterPointer_t xmlwriter, XMLNodePointer_t xmlnode);
+   void WriteEndNode(XMLWriterPointer_t xmlwriter);
+   void CloseWriter(XMLWriterPointer_t xmlwriter);
+
    ClassDef(TXMLEngine, 1); // ROOT XML I/O parser, user by TXMLFile to read/write xml files
 };
 
@@ -17,6 +17,10 @@
 //  be used. This class was introduced to exclude dependency from
 //  external libraries (like libxml2) and improve speed / memory consumption.
 //
+//  Documents too large to be kept completely in memory can be read
+//  with the streaming reader (see OpenReader) node after node, and
+//  written with the streaming writer (see OpenWriter).
+//
 //________________________________________________________________________
 
 #include "TXMLEngine.h"
@@ -30,11 +34,14 @@
 #include <fstream>
 #include <cstdlib>
 #include <cstring>
+#include <string>
+#include <vector>
 
 ClassImp(TXMLEngine);
 
 struct SXmlAttr_t {
    SXmlAttr_t *fNext;
+   Bool_t fArena; // allocated in TXMLArena, memory is released together with the arena
    // after structure itself memory for attribute name is preserved
    // if first byte is 0, this is special attribute
    static inline char *Name(void *arg) { return (char *)arg + sizeof(SXmlAttr_t); }
@@ -50,6 +57,7 @@ enum EXmlNodeType {
 
 struct SXmlNode_t {
    EXmlNodeType fType;     //  this is node type - node, comment, processing instruction and so on
+   Bool_t fArena;          // allocated in TXMLArena, memory is released together with the arena
    SXmlAttr_t *fAttr;      // first attribute
    SXmlAttr_t *fNs;        // name space definition (if any)
    SXmlNode_t *fNext;      // next node on the same level of hierarchy
@@ -67,6 +75,65 @@ struct SXmlDoc_t {
    char *fDtdRoot;
 };
 
+class TXMLArena {
+protected:
+   struct SBlock_t {
+      SBlock_t *fPrev; // previously filled block
+      size_t fSize;    // number of bytes which can be allocated in the block
+      size_t fUsed;    // number of bytes already allocated
+      // the allocated memory follows the structure
+   };
+
+   static constexpr size_t kBlockSize = 256 * 1024;
+
+   SBlock_t *fLast{nullptr}; // block where the memory is allocated
+
+public:
+   TXMLArena() = default;
+   TXMLArena(const TXMLArena &) = delete;
+   TXMLArena &operator=(const TXMLArena &) = delete;
+
+   ~TXMLArena()
+   {
+      Reset();
+      free(fLast);
+   }
+
+   ////////////////////////////////////////////////////////////////////////////
+   /// Allocate size bytes, aligned for the node and attribute structures
+
+   void *Allocate(size_t size)
+   {
+      size = (size + sizeof(void *) - 1) / sizeof(void *) * sizeof(void *);
+      if (!fLast || (fLast->fUsed + size > fLast->fSize)) {
+         size_t blocksize = size > kBlockSize ? size : kBlockSize;
+         SBlock_t *block = (SBlock_t *)malloc(sizeof(SBlock_t) + blocksize);
+         block->fPrev = fLast;
+         block->fSize = blocksize;
+         block->fUsed = 0;
+         fLast = block;
+      }
+      char *res = (char *)fLast + sizeof(SBlock_t) + fLast->fUsed;
+      fLast->fUsed += size;
+      return res;
+   }
+
+   ////////////////////////////////////////////////////////////////////////////
+   /// Release all allocated memory, the last block is kept for the next allocations
+
+   void Reset()
+   {
+      if (!fLast)
+         return;
+      while (fLast->fPrev) {
+         SBlock_t *prev = fLast->fPrev->fPrev;
+         free(fLast->fPrev);
+         fLast->fPrev = prev;
+      }
+      fLast->fUsed = 0;
+   }
+};
+
 class TXMLOutputStream {
 protected:
    std::ostream *fOut{nullptr};
@@ -186,6 +253,7 @@ protected:
 
 public:
    char *fCurrent;
+   TXMLArena *fArena{nullptr}; //! where the nodes are allocated, when not allocated one by one
 
    ////////////////////////////////////////////////////////////////////////////
    /// constructor
@@ -518,6 +586,68 @@ public:
    }
 };
 
+struct SXmlReader_t {
+   TXMLInputStream fInp;          // input stream
+   SXmlNode_t *fRoot{nullptr};    // dummy parent of the top-level nodes
+   SXmlNode_t *fTop{nullptr};     // innermost open node, which start was returned but not its end
+   SXmlNode_t *fNode{nullptr};    // node of the last event, released with the next event if it is not open
+   Int_t fDepth{0};               // depth of fNode, 0 for the top-level nodes
+   Int_t fEvent{TXMLEngine::kReaderStartNode}; // last event, end or error stop the reading
+   std::vector<Bool_t> fComplete; // for fRoot and each open node, true if the children are already read
+   TXMLArena fArena;              // memory of the subtree read by ReadSubtree
+
+   SXmlReader_t(Bool_t isfilename, const char *src, Int_t bufsize) : fInp(isfilename, src, bufsize) {}
+};
+
+struct SXmlWriter_t {
+   TXMLOutputStream fOut;           // output stream
+   Int_t fLayout{1};                // layout of the output, as for TXMLEngine::SaveDoc
+   std::vector<std::string> fNames; // names of the open nodes
+   Bool_t fStartTag{kFALSE};        // start tag of the innermost open node is not closed, attributes can be added
+   Bool_t fHasChildren{kFALSE};     // innermost open node has child nodes, its end tag goes to a new line
+   Bool_t fNewLine{kTRUE};          // output is at the beginning of a line
+
+   SXmlWriter_t(const char *filename, Int_t layout) : fOut(filename, 100000), fLayout(layout) {}
+
+   void CloseStartTag()
+   {
+      if (fStartTag)
+         fOut.Put('>');
+      fStartTag = kFALSE;
+   }
+
+   void BeginLine()
+   {
+      if (fLayout <= 0)
+         return;
+      if (!fNewLine)
+         fOut.Put('\n');
+      fOut.Put(' ', 2 * fNames.size());
+      fNewLine = kFALSE;
+   }
+
+   void EndLine()
+   {
+      if (fLayout <= 0)
+         return;
+      fOut.Put('\n');
+      fNewLine = kTRUE;
+   }
+
+   void WriteValue(const char *value)
+   {
+      for (; *value != 0; ++value) {
+         switch (*value) {
+         case '<': fOut.Write("&lt;"); break;
+         case '>': fOut.Write("&gt;"); break;
+         case '&': fOut.Write("&amp;"); break;
+         case '"': fOut.Write("&quot;"); break;
+         default: fOut.Put(*value);
+         }
+      }
+   }
+};
+
 ////////////////////////////////////////////////////////////////////////////////
 /// default (normal) constructor of TXMLEngine class
 
@@ -632,7 +762,8 @@ void TXMLEngine::FreeAttr(XMLNodePointer_t xmlnode, const char *name)
          else
             ((SXmlNode_t *)xmlnode)->fAttr = attr->fNext;
          // fNumNodes--;
-         free(attr);
+         if (!attr->fArena)
+            free(attr);
          return;
       }
 
@@ -653,7 +784,8 @@ void TXMLEngine::FreeAllAttr(XMLNodePointer_t xmlnode)
    SXmlAttr_t *attr = node->fAttr;
    while (attr != 0) {
       SXmlAttr_t *next = attr->fNext;
-      free(attr);
+      if (!attr->fArena)
+         free(attr);
       attr = next;
    }
    node->fAttr = 0;
@@ -1051,11 +1183,13 @@ void TXMLEngine::FreeNode(XMLNodePointer_t xmlnode)
    while (attr != 0) {
       SXmlAttr_t *next = attr->fNext;
       // fNumNodes--;
-      free(attr);
+      if (!attr->fArena)
+         free(attr);
       attr = next;
    }
 
-   free(node);
+   if (!node->fArena)
+      free(node);
 
    // fNumNodes--;
 }
@@ -1480,6 +1614,345 @@ XMLNodePointer_t TXMLEngine::ReadSingleNode(const char *src)
    return xmlnode;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Opens file for reading with the streaming reader.
+///
+/// Contrary to ParseFile, the document is not kept in memory: the reader returns the nodes
+/// one after the other with ReadNext, and each node is released with the next call.
+/// The open nodes, i.e. the nodes which start was returned but not their end, stay in memory
+/// with their attributes, such that the parents of the current node can be inspected with GetParent.
+/// The complete subtree of a node can be read on demand with ReadSubtree:
+/// ~~~{.cpp}
+/// TXMLEngine xml;
+/// XMLReaderPointer_t reader = xml.OpenReader("file.xml");
+/// Int_t event;
+/// while ((event = xml.ReadNext(reader)) > 0) {
+///    if ((event == TXMLEngine::kReaderStartNode) && (xml.GetReaderDepth(reader) == 1)) {
+///       XMLNodePointer_t node = xml.ReadSubtree(reader);
+///       // use node and its children as for a parsed document, until the next ReadNext
+///    }
+/// }
+/// xml.CloseReader(reader);
+/// ~~~
+/// The maxbuf argument has the same meaning as for ParseFile.
+
+XMLReaderPointer_t TXMLEngine::OpenReader(const char *filename, Int_t maxbuf)
+{
+   if ((filename == 0) || (strlen(filename) == 0))
+      return 0;
+   if (maxbuf < 100000)
+      maxbuf = 100000;
+   SXmlReader_t *reader = new SXmlReader_t(true, filename, maxbuf);
+   reader->fRoot = reader->fTop = (SXmlNode_t *)NewChild(0, 0, "??DummyTopNode??", 0);
+   reader->fComplete.push_back(kFALSE);
+   return (XMLReaderPointer_t)reader;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Opens streaming reader for the content of the string, see OpenReader.
+/// The string must not be modified or deleted before the reader is closed.
+
+XMLReaderPointer_t TXMLEngine::OpenStringReader(const char *xmlstring)
+{
+   if ((xmlstring == 0) || (strlen(xmlstring) == 0))
+      return 0;
+   SXmlReader_t *reader = new SXmlReader_t(false, xmlstring, 100000);
+   reader->fRoot = reader->fTop = (SXmlNode_t *)NewChild(0, 0, "??DummyTopNode??", 0);
+   reader->fComplete.push_back(kFALSE);
+   return (XMLReaderPointer_t)reader;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Reads next node of the document and returns the kind of event, see EReaderEvent.
+/// The node itself is returned by GetReaderNode, it is valid until the next call.
+/// Node without children like <node/> produces a start and an end events.
+/// Returns kReaderEnd at the end of the document and kReaderError if the document is invalid,
+/// then all following calls return the same value.
+
+Int_t TXMLEngine::ReadNext(XMLReaderPointer_t xmlreader)
+{
+   SXmlReader_t *reader = (SXmlReader_t *)xmlreader;
+   if (reader == 0)
+      return kReaderError;
+   if (reader->fEvent <= 0)
+      return reader->fEvent;
+
+   // release node of the previous event, if it is not open
+   if (reader->fNode && (reader->fNode != reader->fTop))
+      UnlinkFreeNode((XMLNodePointer_t)reader->fNode);
+   reader->fNode = 0;
+   reader->fArena.Reset();
+
+   TXMLInputStream *inp = &reader->fInp;
+
+   while (true) {
+      SXmlNode_t *top = reader->fTop;
+      // the children of the open node, which are already read, are returned first
+      SXmlNode_t *node = top->fChild;
+
+      if (node == 0) {
+         Int_t resvalue = 1;
+
+         if (!reader->fComplete.back()) {
+            if (top == reader->fRoot) {
+               if (!inp->EndOfStream())
+                  inp->SkipSpaces();
+               if (inp->EndOfStream()) {
+                  reader->fEvent = kReaderEnd;
+                  return kReaderEnd;
+               }
+            }
+
+            node = (SXmlNode_t *)ReadNode((XMLNodePointer_t)top, inp, resvalue, kFALSE);
+         }
+
+         if (resvalue == 1) {
+            // end of the open node
+            reader->fTop = top->fParent;
+            reader->fComplete.pop_back();
+            reader->fNode = top;
+            reader->fDepth = reader->fComplete.size() - 1;
+            reader->fEvent = kReaderEndNode;
+            return kReaderEndNode;
+         }
+
+         if (resvalue == 3) {
+            // start of a node, its children are not read yet
+            reader->fNode = reader->fTop = node;
+            reader->fDepth = reader->fComplete.size() - 1;
+            reader->fComplete.push_back(kFALSE);
+            reader->fEvent = kReaderStartNode;
+            return kReaderStartNode;
+         }
+
+         if (resvalue != 2) {
+            DisplayError(resvalue, inp->CurrentLine());
+            reader->fEvent = kReaderError;
+            return kReaderError;
+         }
+
+         // the nodes which were read (if any) are now children of the open node
+         continue;
+      }
+
+      reader->fNode = node;
+      reader->fDepth = reader->fComplete.size() - 1;
+      switch (node->fType) {
+      case kXML_NODE:
+         reader->fTop = node;
+         reader->fComplete.push_back(kTRUE);
+         reader->fEvent = kReaderStartNode;
+         break;
+      case kXML_CONTENT: reader->fEvent = kReaderContent; break;
+      case kXML_COMMENT: reader->fEvent = kReaderComment; break;
+      default: reader->fEvent = kReaderPINode; break;
+      }
+      return reader->fEvent;
+   }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Returns node of the last event of the streaming reader.
+/// For content and comment events the text is returned by GetNodeName of the node.
+
+XMLNodePointer_t TXMLEngine::GetReaderNode(XMLReaderPointer_t xmlreader)
+{
+   SXmlReader_t *reader = (SXmlReader_t *)xmlreader;
+   if ((reader == 0) || (reader->fEvent <= 0))
+      return 0;
+   return (XMLNodePointer_t)reader->fNode;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Returns depth of the node of the last event, 0 for the top-level nodes of the document
+
+Int_t TXMLEngine::GetReaderDepth(XMLReaderPointer_t xmlreader)
+{
+   SXmlReader_t *reader = (SXmlReader_t *)xmlreader;
+   return reader == 0 ? 0 : reader->fDepth;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Reads all children of the node which start was just returned by ReadNext and returns the node.
+/// The node and its children can be used as any node of a parsed document until the next call
+/// to ReadNext, which continues after the end of the node: no end event is returned for it.
+/// The children are allocated in large blocks reused for the next subtrees, which is faster
+/// than allocating them one by one. Returns 0 if the last event is not a start of node or in case of error.
+
+XMLNodePointer_t TXMLEngine::ReadSubtree(XMLReaderPointer_t xmlreader)
+{
+   SXmlReader_t *reader = (SXmlReader_t *)xmlreader;
+   if ((reader == 0) || (reader->fEvent != kReaderStartNode) || (reader->fNode != reader->fTop))
+      return 0;
+
+   SXmlNode_t *node = reader->fTop;
+
+   if (!reader->fComplete.back()) {
+      Int_t resvalue = 0;
+      reader->fInp.fArena = &reader->fArena;
+      do {
+         ReadNode((XMLNodePointer_t)node, &reader->fInp, resvalue);
+      } while (resvalue == 2);
+      reader->fInp.fArena = 0;
+
+      if (resvalue != 1) {
+         DisplayError(resvalue, reader->fInp.CurrentLine());
+         reader->fEvent = kReaderError;
+         return 0;
+      }
+   }
+
+   reader->fTop = node->fParent;
+   reader->fComplete.pop_back();
+   return (XMLNodePointer_t)node;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Closes streaming reader and releases all its nodes
+
+void TXMLEngine::CloseReader(XMLReaderPointer_t xmlreader)
+{
+   SXmlReader_t *reader = (SXmlReader_t *)xmlreader;
+   if (reader == 0)
+      return;
+   FreeNode((XMLNodePointer_t)reader->fRoot);
+   delete reader;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Opens file for writing with the streaming writer.
+///
+/// Contrary to SaveDoc, the document does not need to be created in memory first: the nodes
+/// are written one after the other, and complete subtrees can be written with WriteNode.
+/// The layout argument has the same meaning as for SaveDoc.
+/// ~~~{.cpp}
+/// TXMLEngine xml;
+/// XMLWriterPointer_t writer = xml.OpenWriter("file.xml");
+/// xml.WriteStartNode(writer, "Items");
+/// for (int n = 0; n < 1000000; n++) {
+///    xml.WriteStartNode(writer, "Item");
+///    xml.WriteAttr(writer, "id", TString::Itoa(n, 10));
+///    xml.WriteEndNode(writer);
+/// }
+/// xml.CloseWriter(writer); // closes also the node "Items"
+/// ~~~
+
+XMLWriterPointer_t TXMLEngine::OpenWriter(const char *filename, Int_t layout)
+{
+   if ((filename == 0) || (strlen(filename) == 0))
+      return 0;
+   SXmlWriter_t *writer = new SXmlWriter_t(filename, layout);
+   writer->fOut.Write("<?xml version=\"1.0\"?>");
+   writer->fNewLine = kFALSE;
+   writer->EndLine();
+   return (XMLWriterPointer_t)writer;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Writes start of node, its attributes can be written with WriteAttr directly after
+
+void TXMLEngine::WriteStartNode(XMLWriterPointer_t xmlwriter, const char *name)
+{
+   SXmlWriter_t *writer = (SXmlWriter_t *)xmlwriter;
+   if ((writer == 0) || (name == 0))
+      return;
+   writer->CloseStartTag();
+   writer->BeginLine();
+   writer->fOut.Put('<');
+   writer->fOut.Write(name);
+   writer->fNames.emplace_back(name);
+   writer->fStartTag = kTRUE;
+   writer->fHasChildren = kFALSE;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Writes attribute of the node just started with WriteStartNode
+
+void TXMLEngine::WriteAttr(XMLWriterPointer_t xmlwriter, const char *name, const char *value)
+{
+   SXmlWriter_t *writer = (SXmlWriter_t *)xmlwriter;
+   if ((writer == 0) || (name == 0))
+      return;
+   if (!writer->fStartTag) {
+      Error("WriteAttr", "Attribute %s can only be written directly after the start of node", name);
+      return;
+   }
+   writer->fOut.Put(' ');
+   writer->fOut.Write(name);
+   writer->fOut.Write("=\"");
+   if (value != 0)
+      writer->WriteValue(value);
+   writer->fOut.Put('\"');
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Writes content of the current open node
+
+void TXMLEngine::WriteContent(XMLWriterPointer_t xmlwriter, const char *content)
+{
+   SXmlWriter_t *writer = (SXmlWriter_t *)xmlwriter;
+   if ((writer == 0) || (content == 0) || writer->fNames.empty())
+      return;
+   writer->CloseStartTag();
+   writer->WriteValue(content);
+   writer->fNewLine = kFALSE;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Writes node with all its children as child of the current open node.
+/// The node is not modified and has to be released by the caller.
+
+void TXMLEngine::WriteNode(XMLWriterPointer_t xmlwriter, XMLNodePointer_t xmlnode)
+{
+   SXmlWriter_t *writer = (SXmlWriter_t *)xmlwriter;
+   if ((writer == 0) || (xmlnode == 0))
+      return;
+   writer->CloseStartTag();
+   if ((writer->fLayout > 0) && !writer->fNewLine)
+      writer->fOut.Put('\n');
+   SaveNode(xmlnode, &writer->fOut, writer->fLayout, 2 * writer->fNames.size());
+   writer->fNewLine = kTRUE;
+   writer->fHasChildren = kTRUE;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Writes end of the current open node
+
+void TXMLEngine::WriteEndNode(XMLWriterPointer_t xmlwriter)
+{
+   SXmlWriter_t *writer = (SXmlWriter_t *)xmlwriter;
+   if ((writer == 0) || writer->fNames.empty())
+      return;
+   std::string name = writer->fNames.back();
+   writer->fNames.pop_back();
+   if (writer->fStartTag) {
+      writer->fOut.Write("/>");
+      writer->fStartTag = kFALSE;
+   } else {
+      if (writer->fHasChildren)
+         writer->BeginLine();
+      writer->fOut.Write("</");
+      writer->fOut.Write(name.c_str());
+      writer->fOut.Put('>');
+   }
+   writer->fNewLine = kFALSE;
+   writer->EndLine();
+   writer->fHasChildren = kTRUE;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Writes end of all open nodes and closes the streaming writer
+
+void TXMLEngine::CloseWriter(XMLWriterPointer_t xmlwriter)
+{
+   SXmlWriter_t *writer = (SXmlWriter_t *)xmlwriter;
+   if (writer == 0)
+      return;
+   while (!writer->fNames.empty())
+      WriteEndNode(xmlwriter);
+   delete writer;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// creates char* variable with copy of provided string
 
@@ -1509,15 +1982,18 @@ char *TXMLEngine::Makenstr(const char *str, int len)
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-/// Allocates new xml node with specified name length
+/// Allocates new xml node with specified name length.
+/// If arena is specified, the node memory is taken from it and is only released with the arena.
 
-XMLNodePointer_t TXMLEngine::AllocateNode(int namelen, XMLNodePointer_t parent)
+XMLNodePointer_t TXMLEngine::AllocateNode(int namelen, XMLNodePointer_t parent, TXMLArena *arena)
 {
    // fNumNodes++;
 
-   SXmlNode_t *node = (SXmlNode_t *)malloc(sizeof(SXmlNode_t) + namelen + 1);
+   size_t size = sizeof(SXmlNode_t) + namelen + 1;
+   SXmlNode_t *node = (SXmlNode_t *)(arena ? arena->Allocate(size) : malloc(size));
 
    node->fType = kXML_NODE;
+   node->fArena = (arena != nullptr);
    node->fParent = 0;
    node->fNs = 0;
    node->fAttr = 0;
@@ -1532,17 +2008,20 @@ XMLNodePointer_t TXMLEngine::AllocateNode(int namelen, XMLNodePointer_t parent)
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-/// Allocate new attribute with specified name length and value length
+/// Allocate new attribute with specified name length and value length.
+/// If arena is specified, the attribute memory is taken from it and is only released with the arena.
 
-XMLAttrPointer_t TXMLEngine::AllocateAttr(int namelen, int valuelen, XMLNodePointer_t xmlnode)
+XMLAttrPointer_t TXMLEngine::AllocateAttr(int namelen, int valuelen, XMLNodePointer_t xmlnode, TXMLArena *arena)
 {
    // fNumNodes++;
 
-   SXmlAttr_t *attr = (SXmlAttr_t *)malloc(sizeof(SXmlAttr_t) + namelen + 1 + valuelen + 1);
+   size_t size = sizeof(SXmlAttr_t) + namelen + 1 + valuelen + 1;
+   SXmlAttr_t *attr = (SXmlAttr_t *)(arena ? arena->Allocate(size) : malloc(size));
 
    SXmlNode_t *node = (SXmlNode_t *)xmlnode;
 
    attr->fNext = 0;
+   attr->fArena = (arena != nullptr);
 
    if (node->fAttr == 0)
       node->fAttr = attr;
@@ -1771,8 +2250,10 @@ void TXMLEngine::SaveNode(XMLNodePointer_t xmlnode, TXMLOutputStream *out, Int_t
 /// resvalue <= 0 if error
 /// resvalue == 1 if this is endnode of parent
 /// resvalue == 2 if this is child
+/// resvalue == 3 if this is child which children are not read, only when withchildren is false
 
-XMLNodePointer_t TXMLEngine::ReadNode(XMLNodePointer_t xmlparent, TXMLInputStream *inp, Int_t &resvalue)
+XMLNodePointer_t TXMLEngine::ReadNode(XMLNodePointer_t xmlparent, TXMLInputStream *inp, Int_t &resvalue,
+                                      Bool_t withchildren)
 {
    resvalue = 0;
 
@@ -1795,7 +2276,7 @@ XMLNodePointer_t TXMLEngine::ReadNode(XMLNodePointer_t xmlparent, TXMLInputStrea
       }
 
       if (!fSkipComments) {
-         node = (SXmlNode_t *)AllocateNode(commentlen, xmlparent);
+         node = (SXmlNode_t *)AllocateNode(commentlen, xmlparent, inp->fArena);
          char *nameptr = SXmlNode_t::Name(node);
          node->fType = kXML_COMMENT;
          strncpy(nameptr, inp->fCurrent, commentlen); // here copy only content, there is no padding 0 at the end
@@ -1827,7 +2308,7 @@ XMLNodePointer_t TXMLEngine::ReadNode(XMLNodePointer_t xmlparent, TXMLInputStrea
       if (contlen < 0)
          return 0;
 
-      SXmlNode_t *contnode = (SXmlNode_t *)AllocateNode(contlen, xmlparent);
+      SXmlNode_t *contnode = (SXmlNode_t *)AllocateNode(contlen, xmlparent, inp->fArena);
       contnode->fType = kXML_CONTENT;
       char *contptr = SXmlNode_t::Name(contnode);
       UnpackSpecialCharacters(contptr, inp->fCurrent, contlen);
@@ -2115,7 +2596,7 @@ XMLNodePointer_t TXMLEngine::ReadNode(XMLNodePointer_t xmlparent, TXMLInputStrea
    Int_t len = inp->LocateIdentifier();
    if (len <= 0)
       return 0;
-   node = (SXmlNode_t *)AllocateNode(len, xmlparent);
+   node = (SXmlNode_t *)AllocateNode(len, xmlparent, inp->fArena);
    char *nameptr = SXmlNode_t::Name(node);
    node->fType = nodetype;
 
@@ -2163,6 +2644,12 @@ XMLNodePointer_t TXMLEngine::ReadNode(XMLNodePointer_t xmlparent, TXMLInputStrea
          if (!inp->ShiftCurrent())
             return 0;
 
+         if (!withchildren) {
+            // children will be read by the caller, see ReadNext
+            resvalue = 3;
+            return node;
+         }
+
          do {
             ReadNode(node, inp, resvalue);
          } while (resvalue == 2);
@@ -2185,7 +2672,7 @@ XMLNodePointer_t TXMLEngine::ReadNode(XMLNodePointer_t xmlparent, TXMLInputStrea
             return 0;
          }
 
-         SXmlAttr_t *attr = (SXmlAttr_t *)AllocateAttr(attrlen, valuelen - 3, (XMLNodePointer_t)node);
+         SXmlAttr_t *attr = (SXmlAttr_t *)AllocateAttr(attrlen, valuelen - 3, (XMLNodePointer_t)node, inp->fArena);
 
          char *attrname = SXmlAttr_t::Name(attr);
          strncpy(attrname, inp->fCurrent, attrlen);
@@ -0,0 +1,509 @@
+#include "TXMLEngine.h"
+
+#include "gtest/gtest.h"
+
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace {
+
+// Description of a node as "<name a="1" b="2">", "text" or "<!--text-->"
+std::string Describe(TXMLEngine &xml, XMLNodePointer_t node)
+{
+   if (xml.IsContentNode(node))
+      return xml.GetNodeName(node);
+   if (xml.IsCommentNode(node))
+      return std::string("<!--") + xml.GetNodeName(node) + "-->";
+   std::string res = std::string("<") + xml.GetNodeName(node);
+   for (XMLAttrPointer_t attr = xml.GetFirstAttr(node); attr; attr = xml.GetNextAttr(attr))
+      res += std::string(" ") + xml.GetAttrName(attr) + "=\"" + xml.GetAttrValue(attr) + "\"";
+   return res + ">";
+}
+
+// All events of the streaming reader as "<depth> <description>", the end of nodes as "<depth> </name>".
+// The processing instructions are skipped, they are not part of the tree returned by DocGetRootElement.
+std::vector<std::string> ReadEvents(TXMLEngine &xml, XMLReaderPointer_t reader, Int_t &lastEvent)
+{
+   std::vector<std::string> events;
+   while ((lastEvent = xml.ReadNext(reader)) > 0) {
+      XMLNodePointer_t node = xml.GetReaderNode(reader);
+      std::string depth = std::to_string(xml.GetReaderDepth(reader)) + " ";
+      if (lastEvent == TXMLEngine::kReaderEndNode)
+         events.push_back(depth + "</" + xml.GetNodeName(node) + ">");
+      else if (lastEvent != TXMLEngine::kReaderPINode)
+         events.push_back(depth + Describe(xml, node));
+   }
+   return events;
+}
+
+std::vector<std::string> ReadStringEvents(TXMLEngine &xml, const char *str, Int_t &lastEvent)
+{
+   XMLReaderPointer_t reader = xml.OpenStringReader(str);
+   auto events = ReadEvents(xml, reader, lastEvent);
+   xml.CloseReader(reader);
+   return events;
+}
+
+// Same events as ReadEvents, for a node of a parsed document
+void DomEvents(TXMLEngine &xml, XMLNodePointer_t node, Int_t depth, std::vector<std::string> &events)
+{
+   events.push_back(std::to_string(depth) + " " + Describe(xml, node));
+   if (!xml.IsXmlNode(node))
+      return;
+   for (XMLNodePointer_t child = xml.GetChild(node, kFALSE); child; child = xml.GetNext(child, kFALSE))
+      DomEvents(xml, child, depth + 1, events);
+   events.push_back(std::to_string(depth) + " </" + xml.GetNodeName(node) + ">");
+}
+
+std::vector<std::string> ParseEvents(TXMLEngine &xml, const char *str)
+{
+   std::vector<std::string> events;
+   XMLDocPointer_t doc = xml.ParseString(str);
+   if (!doc)
+      return events;
+   // all top-level nodes, also the comments before the root element, except the processing instructions
+   XMLNodePointer_t top = xml.GetParent(xml.DocGetRootElement(doc));
+   for (XMLNodePointer_t node = xml.GetChild(top, kFALSE); node; node = xml.GetNext(node, kFALSE))
+      if (xml.IsXmlNode(node) || xml.IsContentNode(node) || xml.IsCommentNode(node))
+         DomEvents(xml, node, 0, events);
+   xml.FreeDoc(doc);
+   return events;
+}
+
+std::string ReadFile(const char *filename)
+{
+   std::ifstream f(filename);
+   std::stringstream s;
+   s << f.rdbuf();
+   return s.str();
+}
+
+const char *gNested = "<?xml version=\"1.0\"?>\n"
+                      "<root a=\"1\" b=\"x&amp;y\">\n"
+                      "  <child id=\"1\"><leaf name='l'/>text</child>\n"
+                      "  <child id=\"2\"/>\n"
+                      "</root>\n";
+
+// structure of a TMVA weight file, as written by MethodBase::WriteStateToXML
+const char *gWeightFile =
+   "<?xml version=\"1.0\"?>\n"
+   "<MethodSetup Method=\"Fisher::Fisher\">\n"
+   "  <GeneralInfo>\n"
+   "    <Info name=\"TMVA Release\" value=\"4.2.1 [262657]\"/>\n"
+   "    <Info name=\"AnalysisType\" value=\"Classification\"/>\n"
+   "  </GeneralInfo>\n"
+   "  <Options>\n"
+   "    <Option name=\"V\" modified=\"No\">False</Option>\n"
+   "    <Option name=\"Method\" modified=\"Yes\">Fisher</Option>\n"
+   "  </Options>\n"
+   "  <Variables NVar=\"2\">\n"
+   "    <Variable VarIndex=\"0\" Expression=\"x\" Label=\"x\" Type=\"F\" Min=\"-3.5e+00\" Max=\"4.25e+00\"/>\n"
+   "    <Variable VarIndex=\"1\" Expression=\"y&lt;2\" Label=\"y\" Type=\"F\" Min=\"0\" Max=\"1\"/>\n"
+   "  </Variables>\n"
+   "  <Spectators NSpec=\"0\"/>\n"
+   "  <Classes NClass=\"2\">\n"
+   "    <Class Name=\"Signal\" Index=\"0\"/>\n"
+   "    <Class Name=\"Background\" Index=\"1\"/>\n"
+   "  </Classes>\n"
+   "  <Transformations NTransformations=\"0\"/>\n"
+   "  <MVAPdfs/>\n"
+   "  <Weights NCoeff=\"3\">\n"
+   "    <Coefficient Index=\"0\" Value=\"-1.5e-01\"/>\n"
+   "    <Coefficient Index=\"1\" Value=\"2.5e-01\"/>\n"
+   "    <Coefficient Index=\"2\" Value=\"7.5e-01\"/>\n"
+   "  </Weights>\n"
+   "</MethodSetup>\n";
+
+// structure of a GDML file, as read by TGDMLParse
+const char *gGdmlFile =
+   "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n"
+   "<gdml xmlns:xsi=\"http://www.w3.org/2001/XMLSchema-instance\" xsi:noNamespaceSchemaLocation=\"gdml.xsd\">\n"
+   "  <define>\n"
+   "    <constant name=\"HALFPI\" value=\"pi/2.\"/>\n"
+   "    <position name=\"center\" x=\"0\" y=\"0\" z=\"0\" unit=\"mm\"/>\n"
+   "    <rotation name=\"rot\" x=\"HALFPI\" unit=\"rad\"/>\n"
+   "  </define>\n"
+   "  <!-- materials -->\n"
+   "  <materials>\n"
+   "    <element name=\"Hydrogen\" formula=\"H\" Z=\"1.\"> <atom value=\"1.01\"/> </element>\n"
+   "    <material name=\"Vacuum\" formula=\" \"><D value=\"1e-25\"/><fraction n=\"1.0\" ref=\"Hydrogen\"/></material>\n"
+   "  </materials>\n"
+   "  <solids>\n"
+   "    <box name=\"WorldBox\" x=\"100\" y=\"100\" z=\"100\" lunit=\"cm\"/>\n"
+   "    <tube name=\"Tube\" rmin=\"0\" rmax=\"10\" z=\"20\" deltaphi=\"360\" aunit=\"deg\" lunit=\"cm\"/>\n"
+   "  </solids>\n"
+   "  <structure>\n"
+   "    <volume name=\"TubeVol\"><materialref ref=\"Vacuum\"/><solidref ref=\"Tube\"/></volume>\n"
+   "    <volume name=\"World\">\n"
+   "      <materialref ref=\"Vacuum\"/><solidref ref=\"WorldBox\"/>\n"
+   "      <physvol><volumeref ref=\"TubeVol\"/><positionref ref=\"center\"/><rotationref ref=\"rot\"/></physvol>\n"
+   "    </volume>\n"
+   "  </structure>\n"
+   "  <setup name=\"Default\" version=\"1.0\"><world ref=\"World\"/></setup>\n"
+   "</gdml>\n";
+
+} // namespace
+
+TEST(TXMLEngine, ReaderNestedNodes)
+{
+   TXMLEngine xml;
+   Int_t last;
+   auto events = ReadStringEvents(xml, gNested, last);
+   std::vector<std::string> expected{"0 <root a=\"1\" b=\"x&y\">",
+                                     "1 <child id=\"1\">",
+                                     "2 <leaf name=\"l\">",
+                                     "2 </leaf>",
+                                     "2 text",
+                                     "1 </child>",
+                                     "1 <child id=\"2\">",
+                                     "1 </child>",
+                                     "0 </root>"};
+   EXPECT_EQ(events, expected);
+   EXPECT_EQ(last, TXMLEngine::kReaderEnd);
+   EXPECT_EQ(ParseEvents(xml, gNested), expected);
+}
+
+TEST(TXMLEngine, ReaderEvents)
+{
+   TXMLEngine xml;
+   XMLReaderPointer_t reader = xml.OpenStringReader(gNested);
+   ASSERT_NE(reader, nullptr);
+
+   EXPECT_EQ(xml.ReadNext(reader), TXMLEngine::kReaderPINode);
+   EXPECT_STREQ(xml.GetNodeName(xml.GetReaderNode(reader)), "xml");
+   EXPECT_EQ(xml.ReadNext(reader), TXMLEngine::kReaderStartNode);
+   XMLNodePointer_t root = xml.GetReaderNode(reader);
+   EXPECT_STREQ(xml.GetNodeName(root), "root");
+   EXPECT_STREQ(xml.GetAttr(root, "a"), "1");
+   EXPECT_EQ(xml.ReadNext(reader), TXMLEngine::kReaderStartNode);
+   XMLNodePointer_t child = xml.GetReaderNode(reader);
+   EXPECT_EQ(xml.ReadNext(reader), TXMLEngine::kReaderStartNode);
+   XMLNodePointer_t leaf = xml.GetReaderNode(reader);
+   EXPECT_STREQ(xml.GetAttr(leaf, "name"), "l");
+   EXPECT_EQ(xml.GetReaderDepth(reader), 2);
+
+   // the open nodes stay available with their attributes
+   EXPECT_EQ(xml.GetParent(leaf), child);
+   EXPECT_EQ(xml.GetParent(child), root);
+   EXPECT_EQ(xml.GetIntAttr(child, "id"), 1);
+   EXPECT_STREQ(xml.GetAttr(root, "b"), "x&y");
+
+   EXPECT_EQ(xml.ReadNext(reader), TXMLEngine::kReaderEndNode);
+   EXPECT_EQ(xml.GetReaderNode(reader), leaf);
+   EXPECT_EQ(xml.ReadNext(reader), TXMLEngine::kReaderContent);
+   EXPECT_STREQ(xml.GetNodeName(xml.GetReaderNode(reader)), "text");
+   EXPECT_EQ(xml.ReadNext(reader), TXMLEngine::kReaderEndNode);
+   EXPECT_EQ(xml.GetReaderNode(reader), child);
+   EXPECT_EQ(xml.GetReaderDepth(reader), 1);
+
+   // ReadSubtree is only possible directly after the start of a node
+   EXPECT_EQ(xml.ReadSubtree(reader), nullptr);
+
+   while (xml.ReadNext(reader) > 0)
+      ;
+   EXPECT_EQ(xml.ReadNext(reader), TXMLEngine::kReaderEnd);
+   EXPECT_EQ(xml.GetReaderNode(reader), nullptr);
+   xml.CloseReader(reader);
+
+   EXPECT_EQ(xml.OpenStringReader(""), nullptr);
+   EXPECT_EQ(xml.OpenReader(""), nullptr);
+   EXPECT_EQ(xml.ReadNext(nullptr), TXMLEngine::kReaderError);
+}
+
+TEST(TXMLEngine, ReaderComments)
+{
+   const char *str = "<!-- head -->\n"
+                     "<root><!--first--><a/>\n"
+                     "  <!-- second --><b>x</b></root>";
+   TXMLEngine xml;
+   Int_t last;
+   auto events = ReadStringEvents(xml, str, last);
+   std::vector<std::string> expected{"0 <!-- head -->", "0 <root>",          "1 <!--first-->", "1 <a>", "1 </a>",
+                                     "1 <!-- second -->", "1 <b>", "2 x",           "1 </b>", "0 </root>"};
+   EXPECT_EQ(events, expected);
+   EXPECT_EQ(last, TXMLEngine::kReaderEnd);
+   EXPECT_EQ(ParseEvents(xml, str), expected);
+
+   xml.SetSkipComments(kTRUE);
+   events = ReadStringEvents(xml, str, last);
+   expected = {"0 <root>", "1 <a>", "1 </a>", "1 <b>", "2 x", "1 </b>", "0 </root>"};
+   EXPECT_EQ(events, expected);
+   EXPECT_EQ(last, TXMLEngine::kReaderEnd);
+   EXPECT_EQ(ParseEvents(xml, str), expected);
+}
+
+TEST(TXMLEngine, ReaderCharacters)
+{
+   // TXMLEngine does not support CDATA sections, the reader rejects them as the parser does
+   const char *cdata = "<root><![CDATA[a<b]]></root>";
+   TXMLEngine xml;
+   Int_t last;
+   auto events = ReadStringEvents(xml, cdata, last);
+   EXPECT_EQ(last, TXMLEngine::kReaderError);
+   EXPECT_EQ(events, std::vector<std::string>{"0 <root>"});
+   EXPECT_EQ(xml.ParseString(cdata), nullptr);
+
+   // the special characters are unpacked in the content and in the attributes
+   const char *chars = "<root v=\"&lt;&amp;&gt;&quot;\">a &lt; b &amp;&amp; c &gt; d</root>";
+   events = ReadStringEvents(xml, chars, last);
+   std::vector<std::string> expected{"0 <root v=\"<&>\"\">", "1 a < b && c > d", "0 </root>"};
+   EXPECT_EQ(events, expected);
+   EXPECT_EQ(last, TXMLEngine::kReaderEnd);
+   EXPECT_EQ(ParseEvents(xml, chars), expected);
+}
+
+TEST(TXMLEngine, ReaderMalformed)
+{
+   const char *docs[] = {"<a><b></a>", "<a><b>", "<a attr=\"1></a>", "<a><!-- comment </a>", "<a></b>", "</a>",
+                         "<a>text"};
+   TXMLEngine xml;
+   for (auto doc : docs) {
+      SCOPED_TRACE(doc);
+      EXPECT_EQ(xml.ParseString(doc), nullptr);
+
+      XMLReaderPointer_t reader = xml.OpenStringReader(doc);
+      Int_t last;
+      ReadEvents(xml, reader, last);
+      EXPECT_EQ(last, TXMLEngine::kReaderError);
+      // the error is sticky
+      EXPECT_EQ(xml.ReadNext(reader), TXMLEngine::kReaderError);
+      EXPECT_EQ(xml.GetReaderNode(reader), nullptr);
+      EXPECT_EQ(xml.ReadSubtree(reader), nullptr);
+      xml.CloseReader(reader);
+   }
+
+   // error inside of a subtree
+   XMLReaderPointer_t reader = xml.OpenStringReader("<a><b><c></b></a>");
+   EXPECT_EQ(xml.ReadNext(reader), TXMLEngine::kReaderStartNode);
+   EXPECT_EQ(xml.ReadNext(reader), TXMLEngine::kReaderStartNode);
+   EXPECT_EQ(xml.ReadSubtree(reader), nullptr);
+   EXPECT_EQ(xml.ReadNext(reader), TXMLEngine::kReaderError);
+   xml.CloseReader(reader);
+
+   // missing file
+   const char *missing = "testTXMLEngine_missing.xml";
+   EXPECT_EQ(xml.ParseFile(missing), nullptr);
+   reader = xml.OpenReader(missing);
+   EXPECT_EQ(xml.ReadNext(reader), TXMLEngine::kReaderError);
+   xml.CloseReader(reader);
+}
+
+TEST(TXMLEngine, ReadSubtree)
+{
+   const char *str = "<root>\n"
+                     "  <sec n=\"1\"><a>1</a><!-- c --><b/><e/></sec>\n"
+                     "  <sec n=\"2\"><a>2</a><sub><x v=\"3\"/></sub></sec>\n"
+                     "  <leaf/>\n"
+                     "</root>\n";
+   TXMLEngine xml;
+   XMLReaderPointer_t reader = xml.OpenStringReader(str);
+   EXPECT_EQ(xml.ReadNext(reader), TXMLEngine::kReaderStartNode);
+
+   EXPECT_EQ(xml.ReadNext(reader), TXMLEngine::kReaderStartNode);
+   XMLNodePointer_t sec = xml.ReadSubtree(reader);
+   ASSERT_NE(sec, nullptr);
+   EXPECT_STREQ(xml.GetAttr(sec, "n"), "1");
+   XMLNodePointer_t a = xml.GetChild(sec);
+   EXPECT_STREQ(xml.GetNodeName(a), "a");
+   EXPECT_STREQ(xml.GetNodeContent(a), "1");
+   XMLNodePointer_t next = xml.GetNext(a, kFALSE);
+   EXPECT_TRUE(xml.IsCommentNode(next));
+   EXPECT_STREQ(xml.GetNodeName(next), " c ");
+   EXPECT_STREQ(xml.GetNodeName(xml.GetNext(a)), "b");
+   EXPECT_STREQ(xml.GetNodeName(xml.GetNext(xml.GetNext(a))), "e");
+   EXPECT_EQ(xml.GetNext(xml.GetNext(xml.GetNext(a))), nullptr);
+   EXPECT_STREQ(xml.GetNodeName(xml.GetParent(sec)), "root");
+
+   // no end event for the subtree, the reading continues with the next node
+   EXPECT_EQ(xml.ReadNext(reader), TXMLEngine::kReaderStartNode);
+   EXPECT_EQ(xml.GetReaderDepth(reader), 1);
+   sec = xml.ReadSubtree(reader);
+   ASSERT_NE(sec, nullptr);
+   EXPECT_STREQ(xml.GetAttr(sec, "n"), "2");
+   XMLNodePointer_t sub = xml.GetNext(xml.GetChild(sec));
+   EXPECT_STREQ(xml.GetNodeName(sub), "sub");
+   EXPECT_EQ(xml.GetIntAttr(xml.GetChild(sub), "v"), 3);
+
+   // node without children
+   EXPECT_EQ(xml.ReadNext(reader), TXMLEngine::kReaderStartNode);
+   XMLNodePointer_t leaf = xml.ReadSubtree(reader);
+   ASSERT_NE(leaf, nullptr);
+   EXPECT_STREQ(xml.GetNodeName(leaf), "leaf");
+   EXPECT_EQ(xml.GetChild(leaf, kFALSE), nullptr);
+
+   EXPECT_EQ(xml.ReadNext(reader), TXMLEngine::kReaderEndNode);
+   EXPECT_STREQ(xml.GetNodeName(xml.GetReaderNode(reader)), "root");
+   EXPECT_EQ(xml.ReadNext(reader), TXMLEngine::kReaderEnd);
+   xml.CloseReader(reader);
+
+   // the top node can be read completely as well
+   reader = xml.OpenStringReader(str);
+   EXPECT_EQ(xml.ReadNext(reader), TXMLEngine::kReaderStartNode);
+   XMLNodePointer_t root = xml.ReadSubtree(reader);
+   ASSERT_NE(root, nullptr);
+   std::vector<std::string> events;
+   DomEvents(xml, root, 0, events);
+   EXPECT_EQ(events, ParseEvents(xml, str));
+   EXPECT_EQ(xml.ReadNext(reader), TXMLEngine::kReaderEnd);
+   xml.CloseReader(reader);
+}
+
+TEST(TXMLEngine, ReadFile)
+{
+   const char *filename = "testTXMLEngine_read.xml";
+   {
+      std::ofstream f(filename);
+      f << "<?xml version=\"1.0\"?>\n<Items>\n";
+      for (int n = 0; n < 20000; ++n)
+         f << "  <Item id=\"" << n << "\"><Value>" << 2 * n << "</Value></Item>\n";
+      f << "</Items>\n";
+   }
+
+   // the file is larger than the buffer of the reader
+   TXMLEngine xml;
+   XMLReaderPointer_t reader = xml.OpenReader(filename);
+   ASSERT_NE(reader, nullptr);
+   Int_t event, nitems = 0;
+   bool ok = true;
+   while ((event = xml.ReadNext(reader)) > 0) {
+      if ((event != TXMLEngine::kReaderStartNode) || (xml.GetReaderDepth(reader) != 1))
+         continue;
+      XMLNodePointer_t item = xml.ReadSubtree(reader);
+      ok = ok && (xml.GetIntAttr(item, "id") == nitems) &&
+           (std::stoi(xml.GetNodeContent(xml.GetChild(item))) == 2 * nitems);
+      nitems++;
+   }
+   xml.CloseReader(reader);
+   EXPECT_EQ(event, TXMLEngine::kReaderEnd);
+   EXPECT_EQ(nitems, 20000);
+   EXPECT_TRUE(ok);
+
+   std::remove(filename);
+}
+
+TEST(TXMLEngine, WriterRoundTrip)
+{
+   const char *filename = "testTXMLEngine_writer.xml";
+   const char *docname = "testTXMLEngine_doc.xml";
+
+   TXMLEngine xml;
+   XMLNodePointer_t section = xml.NewChild(nullptr, nullptr, "Section");
+   xml.NewAttr(section, nullptr, "kind", "a<b");
+   xml.NewChild(section, nullptr, "Value", "1.5");
+   xml.NewChild(section, nullptr, "Empty");
+
+   XMLWriterPointer_t writer = xml.OpenWriter(filename);
+   ASSERT_NE(writer, nullptr);
+   xml.WriteStartNode(writer, "Root");
+   xml.WriteAttr(writer, "version", "2");
+   xml.WriteAttr(writer, "text", "\"&\"");
+   xml.WriteStartNode(writer, "Item");
+   xml.WriteAttr(writer, "id", "1");
+   xml.WriteContent(writer, "x < y & z");
+   xml.WriteEndNode(writer);
+   xml.WriteStartNode(writer, "Item");
+   xml.WriteAttr(writer, "id", "2");
+   xml.WriteEndNode(writer);
+   xml.WriteNode(writer, section);
+   xml.WriteStartNode(writer, "Open");
+   xml.WriteStartNode(writer, "Child");
+   xml.CloseWriter(writer); // closes Child, Open and Root
+
+   // the same document written with SaveDoc
+   XMLDocPointer_t doc = xml.NewDoc();
+   XMLNodePointer_t root = xml.NewChild(nullptr, nullptr, "Root");
+   xml.NewAttr(root, nullptr, "version", "2");
+   xml.NewAttr(root, nullptr, "text", "\"&\"");
+   // contrary to WriteContent, SaveDoc writes the content as is
+   XMLNodePointer_t item = xml.NewChild(root, nullptr, "Item", "x &lt; y &amp; z");
+   xml.NewAttr(item, nullptr, "id", "1");
+   item = xml.NewChild(root, nullptr, "Item");
+   xml.NewAttr(item, nullptr, "id", "2");
+   xml.AddChild(root, section);
+   xml.NewChild(xml.NewChild(root, nullptr, "Open"), nullptr, "Child");
+   xml.DocSetRootElement(doc, root);
+   xml.SaveDoc(doc, docname);
+   xml.FreeDoc(doc);
+
+   std::string written = ReadFile(filename);
+   EXPECT_EQ(written, ReadFile(docname));
+
+   XMLReaderPointer_t reader = xml.OpenReader(filename);
+   Int_t last;
+   auto events = ReadEvents(xml, reader, last);
+   xml.CloseReader(reader);
+   std::vector<std::string> expected{"0 <Root version=\"2\" text=\"\"&\"\">",
+                                     "1 <Item id=\"1\">",
+                                     "2 x < y & z",
+                                     "1 </Item>",
+                                     "1 <Item id=\"2\">",
+                                     "1 </Item>",
+                                     "1 <Section kind=\"a<b\">",
+                                     "2 <Value>",
+                                     "3 1.5",
+                                     "2 </Value>",
+                                     "2 <Empty>",
+                                     "2 </Empty>",
+                                     "1 </Section>",
+                                     "1 <Open>",
+                                     "2 <Child>",
+                                     "2 </Child>",
+                                     "1 </Open>",
+                                     "0 </Root>"};
+   EXPECT_EQ(events, expected);
+   EXPECT_EQ(last, TXMLEngine::kReaderEnd);
+   EXPECT_EQ(ParseEvents(xml, written.c_str()), expected);
+
+   // attributes cannot be added once the start tag is closed
+   writer = xml.OpenWriter(filename, 0);
+   xml.WriteStartNode(writer, "Root");
+   xml.WriteContent(writer, "text");
+   xml.WriteAttr(writer, "late", "1");
+   xml.CloseWriter(writer);
+   EXPECT_EQ(ReadFile(filename), "<?xml version=\"1.0\"?><Root>text</Root>");
+
+   std::remove(filename);
+   std::remove(docname);
+}
+
+TEST(TXMLEngine, ReaderSameAsParser)
+{
+   TXMLEngine xml;
+   for (auto doc : {gWeightFile, gGdmlFile}) {
+      Int_t last;
+      auto events = ReadStringEvents(xml, doc, last);
+      EXPECT_EQ(last, TXMLEngine::kReaderEnd);
+      EXPECT_EQ(events, ParseEvents(xml, doc));
+
+      // read section after section, as done by TMVA::MethodBase and TGDMLParse
+      XMLReaderPointer_t reader = xml.OpenStringReader(doc);
+      XMLDocPointer_t parsed = xml.ParseString(doc);
+      XMLNodePointer_t top = xml.DocGetRootElement(parsed);
+      XMLNodePointer_t expected = xml.GetChild(top);
+      Int_t event, nsections = 0;
+      while ((event = xml.ReadNext(reader)) > 0) {
+         if (event != TXMLEngine::kReaderStartNode)
+            continue;
+         if (xml.GetReaderDepth(reader) == 0) {
+            EXPECT_EQ(Describe(xml, xml.GetReaderNode(reader)), Describe(xml, top));
+            continue;
+         }
+         XMLNodePointer_t section = xml.ReadSubtree(reader);
+         ASSERT_NE(expected, nullptr);
+         std::vector<std::string> sectionEvents, expectedEvents;
+         DomEvents(xml, section, 1, sectionEvents);
+         DomEvents(xml, expected, 1, expectedEvents);
+         EXPECT_EQ(sectionEvents, expectedEvents);
+         xml.ShiftToNext(expected);
+         nsections++;
+      }
+      EXPECT_EQ(event, TXMLEngine::kReaderEnd);
+      EXPECT_EQ(expected, nullptr);
+      EXPECT_GT(nsections, 4);
+      xml.CloseReader(reader);
+      xml.FreeDoc(parsed);
+   }
+}
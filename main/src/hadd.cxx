@@ -31,6 +31,9 @@
               inside working directory)
   \param -d   Carry out the partial multiprocess execution in the specified directory
   \param -n   Open at most `n` at once (use 0 to request to use the system maximum)
+  \param -prefetch `n` Open the next `n` input files in the background while merging; unless -n is
+              specified, the inputs are then streamed: at most `n` of them are merged at once
+  \param -threads `n` Merge the histograms of each directory with `n` threads, in this process
   \param -experimental-io-features `<feature>` Enables the corresponding experimental feature for output trees
   \return hadd returns a status code: 0 if OK, -1 otherwise
 
@@ -103,6 +106,7 @@
 #include "THashList.h"
 #include "TKey.h"
 #include "TClass.h"
+#include "TROOT.h"
 #include "TSystem.h"
 #include "TUUID.h"
 #include "ROOT/StringConv.hxx"
@@ -141,6 +145,8 @@ int main( int argc, char **argv )
    Bool_t multiproc = kFALSE;
    Bool_t debug = kFALSE;
    Int_t maxopenedfiles = 0;
+   Int_t prefetchfiles = 0;
+   Int_t nThreads = 0;
    Int_t verbosity = 99;
    TString cacheSize;
    SysInfo_t s;
@@ -287,6 +293,34 @@ int main( int argc, char **argv )
             }
          }
          ++ffirst;
+      } else if ( strcmp(argv[a],"-prefetch") == 0 ) {
+         if (a+1 >= argc) {
+            std::cerr << "Error: no number of files to prefetch was provided after -prefetch.\n";
+         } else {
+            Long_t request = strtol(argv[a+1], 0, 10);
+            if (request < kMaxInt && request >= 0) {
+               prefetchfiles = (Int_t)request;
+               ++a;
+               ++ffirst;
+            } else {
+               std::cerr << "Error: could not parse the number of files to prefetch passed after -prefetch: " << argv[a+1] << ". No file will be prefetched.\n";
+            }
+         }
+         ++ffirst;
+      } else if ( strcmp(argv[a],"-threads") == 0 ) {
+         if (a+1 >= argc) {
+            std::cerr << "Error: no number of threads was provided after -threads.\n";
+         } else {
+            Long_t request = strtol(argv[a+1], 0, 10);
+            if (request < kMaxInt && request >= 0) {
+               nThreads = (Int_t)request;
+               ++a;
+               ++ffirst;
+            } else {
+               std::cerr << "Error: could not parse the number of threads passed after -threads: " << argv[a+1] << ". The histograms will be merged one after the other.\n";
+            }
+         }
+         ++ffirst;
       } else if ( strcmp(argv[a],"-v") == 0 ) {
          if (a+1 == argc || argv[a+1][0] == '-') {
             // Verbosity level was not specified use the default:
@@ -379,7 +413,11 @@ int main( int argc, char **argv )
    fileMerger.SetPrintLevel(verbosity - 1);
    if (maxopenedfiles > 0) {
       fileMerger.SetMaxOpenedFiles(maxopenedfiles);
+   } else if (prefetchfiles > 0) {
+      // Stream the inputs: merge them `prefetchfiles` at a time while the next ones are opened.
+      fileMerger.SetMaxOpenedFiles(prefetchfiles + 1);
    }
+   fileMerger.SetPrefetchFiles(prefetchfiles);
    if (newcomp == -1) {
       if (useFirstInputCompression || keepCompressionAsIs) {
          // grab from the first file.
@@ -507,7 +545,10 @@ int main( int argc, char **argv )
       mergerP.SetPrintLevel(verbosity - 1);
       if (maxopenedfiles > 0) {
          mergerP.SetMaxOpenedFiles(maxopenedfiles / nProcesses);
+      } else if (prefetchfiles > 0) {
+         mergerP.SetMaxOpenedFiles(prefetchfiles + 1);
       }
+      mergerP.SetPrefetchFiles(prefetchfiles);
       if (!mergerP.OutputFile(partialFiles[(start - ffirst) / step].c_str(), newcomp)) {
          std::cerr << "hadd error opening target partial file" << std::endl;
          exit(1);
@@ -515,7 +556,17 @@ int main( int argc, char **argv )
       return sequentialMerge(mergerP, start, step);
    };
 
+   // Only for the merges in this process: the thread pool must not be started before forking
+   auto enableThreads = [&](TFileMerger &merger) {
+      if (nThreads > 1) {
+         ROOT::EnableImplicitMT(nThreads);
+         // A few merges per thread to balance histograms of different sizes
+         merger.SetParallelMerges(4 * nThreads);
+      }
+   };
+
    auto reductionFunc = [&]() {
+      enableThreads(fileMerger);
       for (const auto &pf : partialFiles) {
          fileMerger.AddFile(pf.c_str());
       }
@@ -540,9 +591,11 @@ int main( int argc, char **argv )
          }
       }
    } else {
+      enableThreads(fileMerger);
       status = sequentialMerge(fileMerger, ffirst, filesToProcess);
    }
 #else
+   enableThreads(fileMerger);
    status = sequentialMerge(fileMerger, ffirst, filesToProcess);
 #endif
 
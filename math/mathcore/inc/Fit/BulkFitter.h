@@ -0,0 +1,162 @@
+// @(#)root/mathcore:$Id$
+
+/**********************************************************************
+ *                                                                    *
+ * Copyright (c) 2021  LCG ROOT Math Team, CERN/PH-SFT                *
+ *                                                                    *
+ *                                                                    *
+ **********************************************************************/
+
+// Header file for class BulkFitter
+
+#ifndef ROOT_Fit_BulkFitter
+#define ROOT_Fit_BulkFitter
+
+#include "Fit/BinData.h"
+#include "Fit/FitConfig.h"
+#include "Math/IParamFunction.h"
+#include "ROOT/EExecutionPolicy.hxx"
+
+#include <memory>
+#include <vector>
+
+namespace ROOT {
+
+   namespace Fit {
+
+//___________________________________________________________________________________
+/**
+   Table of the results of the fits performed by ROOT::Fit::BulkFitter, one row per data set.
+   For each fit only the parameter values and errors, the minimum of the objective function,
+   the number of degrees of freedom and the minimizer status are kept.
+
+   @ingroup FitMain
+*/
+class BulkFitResult {
+
+public:
+
+   BulkFitResult() {}
+
+   BulkFitResult(unsigned int nFits, unsigned int nPar) :
+      fNPar(nPar),
+      fParams(nFits * nPar, 0),
+      fErrors(nFits * nPar, 0),
+      fMinFcnValues(nFits, 0),
+      fNdf(nFits, 0),
+      fStatus(nFits, -1),
+      fValid(nFits, false)
+   {}
+
+   /// number of fits
+   unsigned int Size() const { return fMinFcnValues.size(); }
+
+   /// number of parameters of each fit
+   unsigned int NPar() const { return fNPar; }
+
+   /// pointer to the NPar() parameter values of a fit
+   const double *GetParams(unsigned int ifit) const { return fParams.data() + ifit * fNPar; }
+
+   /// pointer to the NPar() parameter errors of a fit
+   const double *GetErrors(unsigned int ifit) const { return fErrors.data() + ifit * fNPar; }
+
+   /// value of a parameter of a fit
+   double Value(unsigned int ifit, unsigned int ipar) const { return fParams[ifit * fNPar + ipar]; }
+
+   /// error of a parameter of a fit
+   double Error(unsigned int ifit, unsigned int ipar) const { return fErrors[ifit * fNPar + ipar]; }
+
+   /// minimum value of the objective function, i.e. the chi2 in case of least square fits
+   double MinFcnValue(unsigned int ifit) const { return fMinFcnValues[ifit]; }
+
+   /// number of degrees of freedom: number of data points minus number of free parameters
+   unsigned int Ndf(unsigned int ifit) const { return fNdf[ifit]; }
+
+   /// minimizer status code of a fit
+   int Status(unsigned int ifit) const { return fStatus[ifit]; }
+
+   /// true if the minimizer converged
+   bool IsValid(unsigned int ifit) const { return fValid[ifit]; }
+
+private:
+
+   friend class BulkFitter;
+
+   unsigned int fNPar = 0;
+   std::vector<double> fParams;       // nFits * nPar parameter values
+   std::vector<double> fErrors;       // nFits * nPar parameter errors
+   std::vector<double> fMinFcnValues;
+   std::vector<unsigned int> fNdf;
+   std::vector<int> fStatus;
+   std::vector<char> fValid;          // not std::vector<bool>, which cannot be written concurrently
+};
+
+//___________________________________________________________________________________
+/**
+   Fits the same model function to many independent binned data sets, for example the
+   histograms of all the channels of a detector. Compared to a loop of Fitter::Fit calls,
+   the ROOT::Math::Minimizer instances and the copies of the model function are created once
+   per task and reused for all the fits of the task, and no FitResult is created: the results
+   are collected in a compact ROOT::Fit::BulkFitResult. With the
+   ROOT::EExecutionPolicy::kMultiThread policy the fits run on the implicit multi-threading pool.
+
+   All the fits start from the parameter settings of the FitConfig, unless initial values
+   are given for each fit. Histograms are converted with ROOT::Fit::FillData:
+
+       std::vector<std::shared_ptr<ROOT::Fit::BinData>> data;
+       for (auto h : histograms) {
+          data.emplace_back(std::make_shared<ROOT::Fit::BinData>());
+          ROOT::Fit::FillData(*data.back(), h);
+       }
+       ROOT::Math::WrappedMultiTF1 model(f1, 1);
+       ROOT::Fit::BulkFitter fitter(model);
+       auto results = fitter.Fit(data);
+
+   @ingroup FitMain
+*/
+class BulkFitter {
+
+public:
+
+   typedef ROOT::Math::IParamMultiFunction IModelFunction;
+
+   /**
+      Constructor from the model function. If the configuration has no parameter settings,
+      they are created from the current parameter values of the function.
+   */
+   BulkFitter(const IModelFunction &func, const FitConfig &config = FitConfig());
+
+   /// access to the configuration, e.g. to set the minimizer or the parameter limits
+   FitConfig &Config() { return fConfig; }
+   const FitConfig &Config() const { return fConfig; }
+
+   /// use a binned Poisson likelihood fit instead of a least square fit
+   void SetLikelihood(bool on = true, bool extended = true)
+   {
+      fLikelihood = on;
+      fExtended = extended;
+   }
+
+   /**
+      Fit all the data sets, returning one row of the result table per data set.
+      If not empty, initialParams gives the NPar() starting values of each fit, one fit after the other.
+      The fits with the kMultiThread policy are split in nChunks tasks (0 to choose automatically).
+   */
+   BulkFitResult Fit(const std::vector<std::shared_ptr<BinData>> &data,
+                     const std::vector<double> &initialParams = std::vector<double>(),
+                     ROOT::EExecutionPolicy executionPolicy = ROOT::EExecutionPolicy::kMultiThread,
+                     unsigned int nChunks = 0);
+
+private:
+
+   std::shared_ptr<IModelFunction> fFunc;  // copy of the model function, cloned again by each task
+   FitConfig fConfig;
+   bool fLikelihood = false;
+   bool fExtended = true;
+};
+
+   } // end namespace Fit
+
+} // end namespace ROOT
+
+#endif /* ROOT_Fit_BulkFitter */
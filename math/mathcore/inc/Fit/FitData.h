@@ -29,6 +29,7 @@ Classes for describing the input data for fitting
 #include <vector>
 #include <cassert>
 #include <iostream>
+#include <memory>
 
 
 namespace ROOT {
@@ -343,6 +344,16 @@ namespace ROOT {
 
 
       protected:
+         /**
+           keep alive the object owning external data wrapped by this FitData
+           (e.g. a column adopted by UnBinData), until the FitData and its copies are deleted
+         */
+         void AdoptExternalData(std::shared_ptr<const void> owner)
+         {
+            assert(fWrapped);
+            fExternalOwners.push_back(std::move(owner));
+         }
+
          void UnWrap()
          {
             assert(fWrapped);
@@ -358,6 +369,7 @@ namespace ROOT {
             }
 
             fWrapped = false;
+            fExternalOwners.clear();
          }
 
 #ifdef R__HAS_VECCORE
@@ -413,6 +425,8 @@ namespace ROOT {
          std::vector< std::vector< double > > fCoords;
          std::vector< const double * > fCoordsPtr;
 
+         std::vector< std::shared_ptr<const void> > fExternalOwners; //! owners of the wrapped external data
+
          double *fpTmpCoordVector; // non threadsafe stuff!
 
       };
@@ -367,8 +367,17 @@ namespace FitUtil {
    */
    double EvaluatePoissonBinPdf(const IModelFunction & func, const BinData & data, const double * x, unsigned int ipoint, double * g = 0);
 
+   /// return the number of chunks of the multi-threaded evaluation over nEvents points (or vectors of points)
    unsigned setAutomaticChunking(unsigned nEvents);
 
+   /**
+       return the execution policy suited to evaluate a fit objective function over nPoints points:
+       kMultiThread when the implicit multi-threading is enabled and the points fill
+       at least two chunks (see setAutomaticChunking), kSequential otherwise.
+       The same policy is used for the evaluation of the gradient.
+   */
+   ::ROOT::EExecutionPolicy GetAutomaticExecutionPolicy(unsigned int nPoints);
+
    template<class T>
    struct Evaluate {
 #ifdef R__HAS_VECCORE
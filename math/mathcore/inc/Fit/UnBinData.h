@@ -16,6 +16,8 @@
 #include "Fit/FitData.h"
 #include "Math/Error.h"
 
+#include <initializer_list>
+#include <memory>
 #include <vector>
 
 namespace ROOT {
@@ -37,6 +39,15 @@ namespace ROOT {
               the data are inserted one by one using the Add method.
               It is mandatory to set the size before using the Add method.
 
+              The data can also adopt columns of values stored contiguously, e.g. the std::vector<double> or
+              ROOT::RVec<double> returned by RDataFrame::Take, without copying them:
+
+              ~~~{.cpp}
+              auto x = std::make_shared<std::vector<double>>(std::move(*df.Take<double>("x")));
+              auto y = std::make_shared<std::vector<double>>(std::move(*df.Take<double>("y")));
+              ROOT::Fit::UnBinData data({x, y});
+              ~~~
+
              @ingroup  FitData
 */
 class UnBinData : public FitData {
@@ -129,6 +140,29 @@ public :
     assert( !fWeighted || dim >= 2 );
   }
 
+  /**
+    constructor adopting columns of data (data are not copied inside but kept alive by the UnBinData and its copies)
+    Each column is a container of double with contiguous storage and a resize method, like std::vector<double> or
+    ROOT::RVec<double>, and holds one coordinate of all the points; in case of weighted data the weights are the
+    last column. All the columns must have the same size.
+    The columns are padded (i.e. resized, which reallocates them only if their capacity is too small) to a multiple
+    of the SIMD vector size, as needed by the vectorized evaluation of the fits.
+  */
+  template<class Column>
+  UnBinData(const std::vector<std::shared_ptr<Column>> & columns, bool isWeighted = false) :
+    UnBinData( PadColumns(columns), isWeighted )
+  {
+    for (auto & column : columns)
+      AdoptExternalData(column);
+  }
+
+  /// constructor adopting a list of columns, see above
+  template<class Column>
+  UnBinData(std::initializer_list<std::shared_ptr<Column>> columns, bool isWeighted = false) :
+    UnBinData( std::vector<std::shared_ptr<Column>>(columns), isWeighted )
+  {
+  }
+
   /**
     constructor for 1D data and a range (data are copied inside according to the given range)
   */
@@ -295,6 +329,29 @@ public:
   }
 
 private:
+  /// number of points and pointers to the data of the columns, after their padding
+  typedef std::pair<unsigned int, std::vector<const double *>> PaddedColumns_t;
+
+  template<class Column>
+  static PaddedColumns_t PadColumns(const std::vector<std::shared_ptr<Column>> & columns)
+  {
+    PaddedColumns_t result(columns.empty() ? 0 : columns.front()->size(), {});
+    for (auto & column : columns) {
+      assert( column->size() == result.first );
+      column->resize(result.first + VectorPadding(result.first));
+      result.second.push_back(column->data());
+    }
+    return result;
+  }
+
+  UnBinData(const PaddedColumns_t & columns, bool isWeighted) :
+    FitData( columns.first, columns.second.size(), columns.second.begin() ),
+    fWeighted( isWeighted )
+  {
+    assert( columns.second.size() >= 1 );
+    assert( !fWeighted || columns.second.size() >= 2 );
+  }
+
   bool fWeighted;
 
 };
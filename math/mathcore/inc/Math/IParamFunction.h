@@ -127,6 +127,16 @@ namespace ROOT {
             return DoEval(x);
          }
 
+         /**
+         Evaluate the function at n points for given parameters p, storing the values in f.
+         The coordinates of point i are x[i * NDim()] to x[(i + 1) * NDim() - 1].
+         Use the virtual function DoEvalParBatch to re-implement it
+         */
+         void EvalParBatch(unsigned int n, const T *x, const double *p, T *f) const
+         {
+            DoEvalParBatch(n, x, p, f);
+         }
+
       private:
          /**
             Implementation of the evaluation function using the x values and the parameters.
@@ -134,6 +144,17 @@ namespace ROOT {
          */
          virtual T DoEvalPar(const T *x, const double *p) const = 0;
 
+         /**
+            Evaluation on an array of points, by default one point at a time with DoEvalPar.
+            Derived classes can re-implement it to avoid the overhead of one call per point
+         */
+         virtual void DoEvalParBatch(unsigned int n, const T *x, const double *p, T *f) const
+         {
+            const unsigned int ndim = this->NDim();
+            for (unsigned int i = 0; i < n; ++i)
+               f[i] = DoEvalPar(x + i * ndim, p);
+         }
+
          /**
             Implement the ROOT::Math::IBaseFunctionMultiDim interface DoEval(x) using the cached parameter values
          */
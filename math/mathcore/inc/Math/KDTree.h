@@ -22,6 +22,8 @@
 
 // ROOT include(s)
 #include "RtypesCore.h"
+#include "RConfigure.h"
+#include "ROOT/EExecutionPolicy.hxx"
 
 namespace ROOT
 {
@@ -266,6 +268,11 @@ namespace ROOT
            // creating new Terminal Node when splitting, copying elements in the given range
            TerminalNode(Double_t iBucketSize,UInt_t iSplitAxis,data_it first,data_it end);
 
+           // bulk insertion
+           void                                    Fill(const std::vector<const point_type*>& vData);
+           Bool_t                                  IsFull() const;
+           void                                    SplitRecursively();
+
            //tree operations
            virtual BinNode*                        Clone() {return ConvertToBinNode();}
            BinNode*                                ConvertToBinNode();
@@ -274,6 +281,7 @@ namespace ROOT
            void                                    Split();
            void                                    SetOwner(Bool_t bIsOwner = true) {fOwnData = bIsOwner;}
            void                                    SetSplitOption(eSplitOption opt) {fSplitOption = opt;}
+           data_it                                 SelectCut(Bool_t bEffective);
            data_it                                 SplitEffectiveEntries();
            data_it                                 SplitBinContent();
            void                                    UpdateBoundaries();
@@ -349,6 +357,8 @@ namespace ROOT
         Double_t        GetTotalSumw() const;
         Double_t        GetTotalSumw2() const;
         Bool_t          Insert(const point_type& rData) {return fHead->Parent()->Insert(rData);}
+        Bool_t          Insert(const std::vector<const point_type*>& vData,
+                               ROOT::EExecutionPolicy executionPolicy = ROOT::EExecutionPolicy::kSequential);
         Bool_t          IsFrozen() const {return fIsFrozen;}
         iterator        Last();
         const iterator  Last() const;
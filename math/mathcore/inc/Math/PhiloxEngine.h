@@ -0,0 +1,113 @@
+// @(#)root/mathcore:$Id$
+
+/*************************************************************************
+ * Copyright (C) 1995-2021, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#ifndef ROOT_Math_PhiloxEngine
+#define ROOT_Math_PhiloxEngine
+
+#include "Math/TRandomEngine.h"
+
+#include <cstdint>
+
+namespace ROOT {
+namespace Math {
+
+/**
+PhiloxEngine is a counter-based random number engine, implementing the
+Philox-4x32-10 generator described in
+
+  J. K. Salmon, M. A. Moraes, R. O. Dror and D. E. Shaw,
+  *Parallel random numbers: as easy as 1, 2, 3*,
+  Proceedings of SC11 (2011), http://dx.doi.org/10.1145/2063384.2063405
+
+Each number is a function of the seed, of a stream ID and of its index in
+the stream (the counter): there is no state to carry from one number to the
+next. The engine is cheap to construct and any number of any stream can be
+generated directly, so that an independent and reproducible stream can be
+given to each unit of work (e.g. each entry of a RDataFrame, or each toy of a
+RooFit study), independently of the number of threads and of the scheduling:
+
+~~~ {.cpp}
+df.Define("x", [](ULong64_t entry) {
+   ROOT::Math::PhiloxEngine rng(seed, entry);
+   return rng();
+}, {"rdfentry_"});
+~~~
+
+Streams with different IDs, or different seeds, do not overlap. Each stream
+has \f$2^{65}\f$ numbers, each built from 64 random bits.
+
+@ingroup Random
+*/
+
+class PhiloxEngine final : public TRandomEngine {
+
+private:
+   uint64_t fSeed;      ///< Seed, the key of the generator
+   uint64_t fStream;    ///< Stream ID, the high 64 bits of the counter
+   uint64_t fBlock;     ///< Index of the current block, the low 64 bits of the counter
+   uint64_t fOutput[2]; ///< Random bits of the current block
+   int fPosition;       ///< Position of the next number in the current block
+
+   void GenerateBlock();
+
+public:
+   typedef TRandomEngine BaseType;
+   typedef uint64_t Result_t;
+
+   /// Create the engine for the given seed and stream, at the first number
+   PhiloxEngine(uint64_t seed = 314159265, uint64_t stream = 0);
+   virtual ~PhiloxEngine() {}
+
+   /// Generate a double-precision random number in ]0,1] with 53 bits of randomness
+   double Rndm() override { return (*this)(); }
+   /// Generate a double-precision random number (non-virtual method)
+   double operator()()
+   {
+      static constexpr double div = 1.0 / (uint64_t(1) << 53);
+      return ((IntRndm() >> 11) + 1) * div;
+   }
+   /// Generate a random integer value with 64 bits
+   uint64_t IntRndm()
+   {
+      if (fPosition == 2) {
+         ++fBlock;
+         GenerateBlock();
+         fPosition = 0;
+      }
+      return fOutput[fPosition++];
+   }
+   /// Generate an array of `n` random numbers, as `n` calls to Rndm()
+   void RndmArray(int n, double *array);
+
+   /// Set the seed, keeping the stream, and go back to the first number of the stream
+   void SetSeed(uint64_t seed);
+   /// Select the stream, and go to its first number
+   void SetStream(uint64_t stream);
+   /// Go to the number of the stream with the given index
+   void SetCounter(uint64_t counter);
+   /// Skip `n` random numbers without generating them
+   void Skip(uint64_t n) { SetCounter(GetCounter() + n); }
+
+   uint64_t GetSeed() const { return fSeed; }
+   uint64_t GetStream() const { return fStream; }
+   /// Index of the next number in the stream
+   uint64_t GetCounter() const { return 2 * fBlock + fPosition; }
+
+   static uint64_t MaxInt() { return UINT64_MAX; }
+   static uint64_t MinInt() { return 0; }
+
+   /// Get name of the generator
+   static const char *Name() { return "Philox4x32-10"; }
+};
+
+} // end namespace Math
+} // end namespace ROOT
+
+#endif
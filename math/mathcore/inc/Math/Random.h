@@ -68,7 +68,7 @@ namespace Math {
          Function to preserve ROOT Trandom compatibility
       */
       void RndmArray(int n, double * array) {
-         fEngine.RandomArray(array, array+n);
+         fFunctions.RndmArray(n, array);
       }
 
       /**
@@ -111,6 +111,16 @@ namespace Math {
          return fFunctions.Gaus(mean,sigma);
       }
 
+      /// Array of exponential numbers, generated in bulk
+      void ExpArray(int n, double * array, double tau) {
+         fFunctions.ExpArray(n, array, tau);
+      }
+
+      /// Array of Gaussian numbers, generated in bulk with the Box-Muller method
+      void GausArray(int n, double * array, double mean = 0, double sigma = 1) {
+         fFunctions.GausArray(n, array, mean, sigma);
+      }
+
       /// Gamma distribution
       double Gamma(double a, double b) {
          return fFunctions.Gamma(a,b);
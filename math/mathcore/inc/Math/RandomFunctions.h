@@ -48,6 +48,41 @@ namespace Math {
    typedef TRandomEngine DefaultEngineType;
    //class DefaultEngineType {};  // for generic types
 
+   namespace Internal {
+
+      /// Fill the array with uniform numbers using the bulk generation of the engine (e.g. MixMaxEngine,
+      /// RanluxppEngine), which gives the same sequence as the single calls but does not pay for the
+      /// state checks at each number
+      template <class Engine>
+      auto FillUniformImpl(Engine &rng, int n, double *array, int) -> decltype(rng.RndmArray(n, array))
+      {
+         return rng.RndmArray(n, array);
+      }
+
+      /// Fill the array with uniform numbers using the bulk generation of the GSL engines
+      template <class Engine>
+      auto FillUniformImpl(Engine &rng, int n, double *array, long) -> decltype(rng.RandomArray(array, array + n))
+      {
+         return rng.RandomArray(array, array + n);
+      }
+
+      /// Fill the array with uniform numbers for the engines without bulk generation
+      template <class Engine>
+      void FillUniformImpl(Engine &rng, int n, double *array, ...)
+      {
+         for (int i = 0; i < n; ++i)
+            array[i] = rng();
+      }
+
+      /// Fill the array with n uniform numbers in ]0,1] using the fastest method of the engine
+      template <class Engine>
+      void FillUniform(Engine &rng, int n, double *array)
+      {
+         FillUniformImpl(rng, n, array, 0);
+      }
+
+   } // namespace Internal
+
 
 
       /**
@@ -223,6 +258,36 @@ namespace Math {
          return a * Rndm_impl() ; 
       }
 
+      /// generate an array of n random numbers uniformly distributed in ]0,1],
+      /// using the bulk generation of the engine when it is available
+      void RndmArray(int n, double * array) {
+         Internal::FillUniform(Rng(), n, array);
+      }
+
+      /// generate an array of n Gaussian numbers using the Box-Muller method.
+      /// The uniform numbers are generated in bulk first, and then transformed
+      /// in pairs in a loop without branches, which can be vectorized.
+      /// The sequence differs from the one of n calls to Gaus()
+      void GausArray(int n, double * array, double mean = 0, double sigma = 1) {
+         const int npairs = n / 2;
+         Internal::FillUniform(Rng(), 2 * npairs, array);
+         for (int i = 0; i < npairs; ++i) {
+            const double radius = sigma * std::sqrt(-2 * std::log(array[2 * i]));
+            const double x = array[2 * i + 1] * 6.28318530717958623;
+            array[2 * i] = mean + radius * std::cos(x);
+            array[2 * i + 1] = mean + radius * std::sin(x);
+         }
+         if (n % 2)
+            array[n - 1] = fImpl.GausBM(mean, sigma);
+      }
+
+      /// generate an array of n exponential numbers, exp( -t/tau )
+      void ExpArray(int n, double * array, double tau) {
+         Internal::FillUniform(Rng(), n, array);
+         for (int i = 0; i < n; ++i)
+            array[i] = -tau * std::log(array[i]);
+      }
+
 
       /// generate Gaussian number using defqault method
       inline double Gaus( double mean, double sigma) {
@@ -38,6 +38,8 @@ public:
    double Rndm() override;
    /// Generate a double-precision random number (non-virtual method)
    double operator()();
+   /// Generate an array of `n` double-precision random numbers, as `n` calls to Rndm()
+   void RndmArray(int n, double *array);
    /// Generate a random integer value with 48 bits
    uint64_t IntRndm();
 
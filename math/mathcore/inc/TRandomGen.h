@@ -36,11 +36,13 @@
 //   * TRandomMixMax256 for the MixMaxEngine<256,2> (MIXMAX with state N=256 )
 //   * TRandomMT64 for the  StdEngine<std::mt19937_64> ( MersenneTwister 64 bits)
 //   * TRandomRanlux48 for the  StdEngine<std::ranlux48> (Ranlux 48 bits)
+//   * TRandomPhilox for the PhiloxEngine (counter-based, with streams)
 //
 //                                                                     //
 //////////////////////////////////////////////////////////////////////////
 
 #include "TRandom.h"
+#include "Math/RandomFunctions.h"
 
 #include <string>
 
@@ -64,11 +66,14 @@ public:
       for (int i = 0; i < n; ++i) array[i] = fEngine(); 
    }
    virtual  void     RndmArray(Int_t n, Double_t *array) {
-            for (int i = 0; i < n; ++i) array[i] = fEngine(); 
+      // use the bulk generation of the engine when it is available
+      ROOT::Math::Internal::FillUniform(fEngine, n, array);
    }
    virtual  void     SetSeed(ULong_t seed=0) {
       fEngine.SetSeed(seed);
    }
+   /// Access to the engine, e.g. to select the stream of a TRandomPhilox
+   Engine & GetEngine() { return fEngine; }
 
    ClassDef(TRandomGen,1)  //Generic Random number generator template on the Engine type
 };
@@ -77,6 +82,7 @@ public:
 #include "Math/StdEngine.h"
 #include "Math/MixMaxEngine.h"
 #include "Math/RanluxppEngine.h"
+#include "Math/PhiloxEngine.h"
 
 // not working wight now for this classes
 //#define  DEFINE_TEMPL_INSTANCE
@@ -131,6 +137,17 @@ typedef TRandomGen<ROOT::Math::MixMaxEngine<256,2>> TRandomMixMax256;
 
 typedef TRandomGen<ROOT::Math::RanluxppEngine2048> TRandomRanluxpp;
 
+/**
+  @ingroup Random
+  Counter-based generator Philox-4x32-10 (see ROOT::Math::PhiloxEngine).
+  Independent and reproducible streams are obtained with different stream IDs:
+
+      TRandomPhilox rng(seed);
+      rng.GetEngine().SetStream(toyIndex);
+
+ */
+typedef TRandomGen<ROOT::Math::PhiloxEngine> TRandomPhilox;
+
 /**
   @ingroup Random
   Generator based on a the Mersenne-Twister generator with 64 bits, 
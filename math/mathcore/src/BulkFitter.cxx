@@ -0,0 +1,171 @@
+// @(#)root/mathcore:$Id$
+
+/**********************************************************************
+ *                                                                    *
+ * Copyright (c) 2021  LCG ROOT Math Team, CERN/PH-SFT                *
+ *                                                                    *
+ *                                                                    *
+ **********************************************************************/
+
+// Implementation file for class BulkFitter
+
+#include "Fit/BulkFitter.h"
+#include "Fit/Chi2FCN.h"
+#include "Fit/PoissonLikelihoodFCN.h"
+#include "Math/Minimizer.h"
+#include "Math/MinimizerOptions.h"
+#include "Math/Error.h"
+#include "TError.h"
+
+#ifdef R__USE_IMT
+#include "ROOT/TThreadExecutor.hxx"
+#endif
+
+#include <algorithm>
+
+namespace ROOT {
+
+   namespace Fit {
+
+namespace {
+
+// the objects reused by all the fits of a task
+struct BulkFitTask {
+   std::unique_ptr<ROOT::Math::Minimizer> fMinimizer;
+   std::shared_ptr<ROOT::Math::IParamMultiFunction> fFunc;
+   std::vector<ParameterSettings> fSettings;
+};
+
+} // anonymous namespace
+
+BulkFitter::BulkFitter(const IModelFunction &func, const FitConfig &config) :
+   fFunc(dynamic_cast<IModelFunction *>(func.Clone())),
+   fConfig(config)
+{
+   if (fConfig.ParamsSettings().size() != fFunc->NPar())
+      fConfig.CreateParamsSettings(*fFunc);
+}
+
+BulkFitResult BulkFitter::Fit(const std::vector<std::shared_ptr<BinData>> &data,
+                              const std::vector<double> &initialParams,
+                              ROOT::EExecutionPolicy executionPolicy, unsigned int nChunks)
+{
+   const unsigned int nFits = data.size();
+   const unsigned int nPar = fConfig.NPar();
+   BulkFitResult result(nFits, nPar);
+   if (nFits == 0)
+      return result;
+
+   if (!initialParams.empty() && initialParams.size() != nFits * nPar) {
+      MATH_ERROR_MSG("BulkFitter::Fit", "wrong size of the initial parameter values, nFits * nPar are needed");
+      return result;
+   }
+
+   unsigned int nFree = 0;
+   for (const auto &settings : fConfig.ParamsSettings()) {
+      if (!settings.IsFixed())
+         ++nFree;
+   }
+
+#ifndef R__USE_IMT
+   // If IMT is disabled, force the execution policy to the serial case
+   if (executionPolicy == ::ROOT::EExecutionPolicy::kMultiThread) {
+      Warning("BulkFitter::Fit", "Multithread execution policy requires IMT, which is disabled. Changing "
+                                 "to ::ROOT::EExecutionPolicy::kSequential.");
+      executionPolicy = ::ROOT::EExecutionPolicy::kSequential;
+   }
+#endif
+
+   if (executionPolicy == ::ROOT::EExecutionPolicy::kSequential) {
+      nChunks = 1;
+#ifdef R__USE_IMT
+   } else if (executionPolicy == ::ROOT::EExecutionPolicy::kMultiThread) {
+      // a few tasks per thread to balance the fits of different cost
+      if (nChunks == 0)
+         nChunks = 4 * ROOT::TThreadExecutor().GetPoolSize();
+#endif
+   } else {
+      Error("BulkFitter::Fit", "Execution policy unknown. Avalaible choices:\n ::ROOT::EExecutionPolicy::kSequential\n ::ROOT::EExecutionPolicy::kMultiThread (default, requires IMT)\n");
+      return result;
+   }
+   nChunks = std::max(1u, std::min(nChunks, nFits));
+   const unsigned int chunkSize = (nFits + nChunks - 1) / nChunks;
+   nChunks = (nFits + chunkSize - 1) / chunkSize;
+
+   // logl fit (error should be 0.5) set if different than default values (of 1)
+   const bool loglErrorDef =
+      fLikelihood && fConfig.MinimizerOptions().ErrorDef() == ROOT::Math::MinimizerOptions::DefaultErrorDef();
+
+   // The minimizers are created up front: their creation can go through the plugin manager
+   std::vector<BulkFitTask> tasks(nChunks);
+   for (auto &task : tasks) {
+      task.fMinimizer.reset(fConfig.CreateMinimizer());
+      if (!task.fMinimizer) {
+         MATH_ERROR_MSG("BulkFitter::Fit", "Minimizer cannot be created");
+         return result;
+      }
+      if (loglErrorDef)
+         task.fMinimizer->SetErrorDef(0.5);
+      // if requested parabolic error do correct error  analysis by the minimizer (call HESSE)
+      if (fConfig.ParabErrors())
+         task.fMinimizer->SetValidError(true);
+      task.fFunc.reset(dynamic_cast<IModelFunction *>(fFunc->Clone()));
+      task.fSettings = fConfig.ParamsSettings();
+   }
+
+   auto fitOne = [&](BulkFitTask &task, unsigned int ifit) {
+      if (!data[ifit] || data[ifit]->Size() == 0)
+         return;
+
+      std::unique_ptr<ROOT::Math::IMultiGenFunction> fcn;
+      if (fLikelihood)
+         fcn.reset(new PoissonLikelihoodFCN<ROOT::Math::IMultiGenFunction>(data[ifit], task.fFunc, 0, fExtended));
+      else
+         fcn.reset(new Chi2FCN<ROOT::Math::IMultiGenFunction>(data[ifit], task.fFunc));
+
+      if (!initialParams.empty()) {
+         for (unsigned int ipar = 0; ipar < nPar; ++ipar)
+            task.fSettings[ipar].SetValue(initialParams[ifit * nPar + ipar]);
+      }
+
+      auto &minimizer = *task.fMinimizer;
+      // forget the state of the previous fit
+      minimizer.Clear();
+      minimizer.SetFunction(*fcn);
+      minimizer.SetVariables(task.fSettings.begin(), task.fSettings.end());
+      const bool isValid = minimizer.Minimize();
+
+      const double *x = minimizer.X();
+      const double *errors = minimizer.Errors();
+      if (x)
+         std::copy(x, x + nPar, result.fParams.begin() + ifit * nPar);
+      if (errors)
+         std::copy(errors, errors + nPar, result.fErrors.begin() + ifit * nPar);
+      result.fMinFcnValues[ifit] = minimizer.MinValue();
+      const unsigned int nPoints = data[ifit]->Size();
+      result.fNdf[ifit] = nPoints > nFree ? nPoints - nFree : 0;
+      result.fStatus[ifit] = minimizer.Status();
+      result.fValid[ifit] = isValid;
+   };
+
+   auto fitChunk = [&](unsigned int ichunk) {
+      const unsigned int end = std::min(nFits, (ichunk + 1) * chunkSize);
+      for (unsigned int ifit = ichunk * chunkSize; ifit < end; ++ifit)
+         fitOne(tasks[ichunk], ifit);
+   };
+
+   if (nChunks == 1) {
+      fitChunk(0);
+#ifdef R__USE_IMT
+   } else {
+      ROOT::TThreadExecutor pool;
+      pool.Foreach(fitChunk, ROOT::TSeq<unsigned int>(0, nChunks));
+#endif
+   }
+
+   return result;
+}
+
+   } // end namespace Fit
+
+} // end namespace ROOT
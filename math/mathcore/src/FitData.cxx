@@ -227,8 +227,10 @@ namespace ROOT {
             fCoords.clear();
 
             fCoordsPtr = rhs.fCoordsPtr;
+            fExternalOwners = rhs.fExternalOwners;
          } else {
             fCoords = rhs.fCoords;
+            fExternalOwners.clear();
 
             fCoordsPtr.resize(fDim);
 
@@ -49,6 +49,14 @@ namespace ROOT {
 
       namespace FitUtil {
 
+         // number of points evaluated with one call of IModelFunction::EvalParBatch
+         constexpr unsigned int kEvalBlockSize = 512;
+
+         // minimum number of points of a chunk of the multi-threaded evaluation and number of chunks per thread,
+         // see setAutomaticChunking
+         constexpr unsigned int kMinChunkSize = 1000;
+         constexpr unsigned int kChunksPerThread = 8;
+
          // derivative with respect of the parameter to be integrated
          template<class GradFunc = IGradModelFunction>
          struct ParamDerivFunc {
@@ -275,7 +283,8 @@ namespace ROOT {
 
    (const_cast<IModelFunction &>(func)).SetParameters(p);
 
-   auto mapFunction = [&](const unsigned i){
+   // fvalBatch, if not null, is the value of the function at the point, evaluated with the others of its block
+   auto pointFunction = [&](const unsigned i, const double *fvalBatch){
 
       double chi2{};
       double fval{};
@@ -313,7 +322,9 @@ namespace ROOT {
       }
 
 
-      if (!useBinIntegral) {
+      if (fvalBatch) {
+         fval = *fvalBatch;
+      } else if (!useBinIntegral) {
 #ifdef USE_PARAMCACHE
          fval = func ( x );
 #else
@@ -376,6 +387,35 @@ namespace ROOT {
       return chi2;
   };
 
+  // without integral or volume of the bins, the function is evaluated at the coordinates of each block of points with
+  // one call of EvalParBatch
+  const bool useBatch = !useBinIntegral && !useBinVolume;
+  const unsigned int ndim = data.NDim();
+  const unsigned int nBlocks = (n + kEvalBlockSize - 1) / kEvalBlockSize;
+  auto mapFunction = [&](const unsigned ib) {
+     const unsigned int first = ib * kEvalBlockSize;
+     const unsigned int npoints = std::min(kEvalBlockSize, n - first);
+     double chi2{};
+     if (!useBatch) {
+        for (unsigned int i = 0; i < npoints; ++i)
+           chi2 += pointFunction(first + i, nullptr);
+        return chi2;
+     }
+     std::vector<double> fval(npoints);
+     if (ndim == 1) {
+        func.EvalParBatch(npoints, data.GetCoordComponent(first, 0), p, fval.data());
+     } else {
+        std::vector<double> x(npoints * ndim);
+        for (unsigned int i = 0; i < npoints; ++i)
+           for (unsigned int j = 0; j < ndim; ++j)
+              x[i * ndim + j] = *data.GetCoordComponent(first + i, j);
+        func.EvalParBatch(npoints, x.data(), p, fval.data());
+     }
+     for (unsigned int i = 0; i < npoints; ++i)
+        chi2 += pointFunction(first + i, &fval[i]);
+     return chi2;
+  };
+
 #ifdef R__USE_IMT
   auto redFunction = [](const std::vector<double> & objs){
                           return std::accumulate(objs.begin(), objs.end(), double{});
@@ -393,14 +433,15 @@ namespace ROOT {
 
   double res{};
   if(executionPolicy == ROOT::EExecutionPolicy::kSequential){
-    for (unsigned int i=0; i<n; ++i) {
-      res += mapFunction(i);
+    for (unsigned int ib=0; ib<nBlocks; ++ib) {
+      res += mapFunction(ib);
     }
 #ifdef R__USE_IMT
   } else if(executionPolicy == ROOT::EExecutionPolicy::kMultiThread) {
     ROOT::TThreadExecutor pool;
     auto chunks = nChunks !=0? nChunks: setAutomaticChunking(data.Size());
-    res = pool.MapReduce(mapFunction, ROOT::TSeq<unsigned>(0, n), redFunction, chunks);
+    chunks = std::max(1u, std::min<unsigned>(chunks, nBlocks));
+    res = pool.MapReduce(mapFunction, ROOT::TSeq<unsigned>(0, nBlocks), redFunction, chunks);
 #endif
 //   } else if(executionPolicy == ROOT::Fit::kMultitProcess){
     // ROOT::TProcessExecutor pool;
@@ -972,30 +1013,9 @@ double FitUtil::EvaluateLogL(const IModelFunctionTempl<double> &func, const UnBi
 
          // needed to compue effective global weight in case of extended likelihood
 
-         auto mapFunction = [&](const unsigned i) {
+         auto pointFunction = [&](const unsigned i, double fval) {
             double W = 0;
             double W2 = 0;
-            double fval = 0;
-
-            if (data.NDim() > 1) {
-               std::vector<double> x(data.NDim());
-               for (unsigned int j = 0; j < data.NDim(); ++j)
-                  x[j] = *data.GetCoordComponent(i, j);
-#ifdef USE_PARAMCACHE
-               fval = func(x.data());
-#else
-               fval = func(x.data(), p);
-#endif
-
-               // one -dim case
-            } else {
-               const auto x = data.GetCoordComponent(i, 0);
-#ifdef USE_PARAMCACHE
-               fval = func(x);
-#else
-               fval = func(x, p);
-#endif
-            }
 
             if (normalizeFunc)
                fval = fval * (1 / norm);
@@ -1017,6 +1037,30 @@ double FitUtil::EvaluateLogL(const IModelFunctionTempl<double> &func, const UnBi
             return LikelihoodAux<double>(logval, W, W2);
          };
 
+         // the function is evaluated on blocks of points with one call of EvalParBatch, which for a TF1 defined by a
+         // formula runs the compiled loop of TFormula::EvalBatch instead of one interpreted call per point
+         const unsigned int ndim = data.NDim();
+         const unsigned int nBlocks = (n + kEvalBlockSize - 1) / kEvalBlockSize;
+         auto mapFunction = [&](const unsigned ib) {
+            const unsigned int first = ib * kEvalBlockSize;
+            const unsigned int npoints = std::min(kEvalBlockSize, n - first);
+            std::vector<double> fval(npoints);
+            if (ndim == 1) {
+               // the coordinates of the points are contiguous
+               func.EvalParBatch(npoints, data.GetCoordComponent(first, 0), p, fval.data());
+            } else {
+               std::vector<double> x(npoints * ndim);
+               for (unsigned int i = 0; i < npoints; ++i)
+                  for (unsigned int j = 0; j < ndim; ++j)
+                     x[i * ndim + j] = *data.GetCoordComponent(first + i, j);
+               func.EvalParBatch(npoints, x.data(), p, fval.data());
+            }
+            auto res = LikelihoodAux<double>(0.0, 0.0, 0.0);
+            for (unsigned int i = 0; i < npoints; ++i)
+               res = res + pointFunction(first + i, fval[i]);
+            return res;
+         };
+
 #ifdef R__USE_IMT
   // auto redFunction = [](const std::vector<LikelihoodAux<double>> & objs){
   //          return std::accumulate(objs.begin(), objs.end(), LikelihoodAux<double>(0.0,0.0,0.0),
@@ -1047,8 +1091,8 @@ double FitUtil::EvaluateLogL(const IModelFunctionTempl<double> &func, const UnBi
   double sumW{};
   double sumW2{};
   if(executionPolicy == ROOT::EExecutionPolicy::kSequential){
-    for (unsigned int i=0; i<n; ++i) {
-      auto resArray = mapFunction(i);
+    for (unsigned int ib=0; ib<nBlocks; ++ib) {
+      auto resArray = mapFunction(ib);
       logl+=resArray.logvalue;
       sumW+=resArray.weight;
       sumW2+=resArray.weight2;
@@ -1057,7 +1101,8 @@ double FitUtil::EvaluateLogL(const IModelFunctionTempl<double> &func, const UnBi
   } else if(executionPolicy == ROOT::EExecutionPolicy::kMultiThread) {
     ROOT::TThreadExecutor pool;
     auto chunks = nChunks !=0? nChunks: setAutomaticChunking(data.Size());
-    auto resArray = pool.MapReduce(mapFunction, ROOT::TSeq<unsigned>(0, n), redFunction, chunks);
+    chunks = std::max(1u, std::min<unsigned>(chunks, nBlocks));
+    auto resArray = pool.MapReduce(mapFunction, ROOT::TSeq<unsigned>(0, nBlocks), redFunction, chunks);
     logl=resArray.logvalue;
     sumW=resArray.weight;
     sumW2=resArray.weight2;
@@ -1777,10 +1822,23 @@ void FitUtil::EvaluatePoissonLogLGradient(const IModelFunction &f, const BinData
 
 
 unsigned FitUtil::setAutomaticChunking(unsigned nEvents){
-      auto ncpu  = ROOT::GetThreadPoolSize();
-      if (nEvents/ncpu < 1000) return ncpu;
-      return nEvents/1000;
-      //return ((nEvents/ncpu + 1) % 1000) *40 ; //arbitrary formula
+      // each chunk is a contiguous range of at least kMinChunkSize points, whose coordinates are read sequentially by
+      // one thread and reduced once; a few chunks per thread balance the load, more only add scheduling and reduction
+      // overhead
+      unsigned ncpu = std::max(ROOT::GetThreadPoolSize(), 1u);
+      unsigned nchunks = nEvents / kMinChunkSize;
+      return std::max(1u, std::min(nchunks, kChunksPerThread * ncpu));
+}
+
+::ROOT::EExecutionPolicy FitUtil::GetAutomaticExecutionPolicy(unsigned int nPoints)
+{
+#ifdef R__USE_IMT
+   if (ROOT::IsImplicitMTEnabled() && ROOT::GetThreadPoolSize() > 1 && nPoints >= 2 * kMinChunkSize)
+      return ::ROOT::EExecutionPolicy::kMultiThread;
+#else
+   (void)nPoints;
+#endif
+   return ::ROOT::EExecutionPolicy::kSequential;
 }
 
 }
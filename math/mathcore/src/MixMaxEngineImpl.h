@@ -62,6 +62,7 @@ namespace ROOT {
       int Counter() { return -1; }
       void SetCounter(int) {}
       void Iterate() {} 
+      int RndmArrayInState(int, double *) { return 0; }
    };
 
 
@@ -121,6 +122,18 @@ public:
    void RndmArray(int n, double * array) {
       fill_array(fRngState, n, array); 
    }
+   // copy at most n of the numbers left in the state vector, starting at the counter,
+   // in a loop which can be vectorized. Return the number of copied values
+   int RndmArrayInState(int n, double * array) {
+      int i = fRngState->counter;
+      int m = (n < ROOT_MM_N - i) ? n : ROOT_MM_N - i;
+      if (m <= 0) return 0;
+      const myuint * V = fRngState->V + i;
+      for (int j = 0; j < m; ++j)
+         array[j] = (int64_t)V[j] * INV_MERSBASE;
+      fRngState->counter = i + m;
+      return m;
+   }
    void ReadState(const char filename[] ) {
       read_state(fRngState, filename);
    }
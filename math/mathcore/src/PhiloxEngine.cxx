@@ -0,0 +1,112 @@
+// @(#)root/mathcore:$Id$
+
+/*************************************************************************
+ * Copyright (C) 1995-2021, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+/** \class ROOT::Math::PhiloxEngine
+Implementation of the Philox-4x32-10 counter-based generator
+
+The 128 bits counter is made of the index of the block (low 64 bits) and of
+the stream ID (high 64 bits), the 64 bits key is the seed. Each block gives
+two numbers. The sequences of the 4x32 bits blocks match the known answers of
+the reference implementation (Random123).
+*/
+
+#include "Math/PhiloxEngine.h"
+
+namespace {
+
+const uint32_t kPhiloxM0 = 0xD2511F53;
+const uint32_t kPhiloxM1 = 0xCD9E8D57;
+const uint32_t kPhiloxW0 = 0x9E3779B9;
+const uint32_t kPhiloxW1 = 0xBB67AE85;
+
+/// Apply the 10 rounds of Philox-4x32 to the counter ctr with the key, in place
+inline void Philox4x32(uint32_t ctr[4], uint32_t k0, uint32_t k1)
+{
+   for (int round = 0; round < 10; round++) {
+      if (round > 0) {
+         k0 += kPhiloxW0;
+         k1 += kPhiloxW1;
+      }
+      const uint64_t p0 = uint64_t(kPhiloxM0) * ctr[0];
+      const uint64_t p1 = uint64_t(kPhiloxM1) * ctr[2];
+      const uint32_t c1 = ctr[1], c3 = ctr[3];
+      ctr[0] = uint32_t(p1 >> 32) ^ c1 ^ k0;
+      ctr[1] = uint32_t(p1);
+      ctr[2] = uint32_t(p0 >> 32) ^ c3 ^ k1;
+      ctr[3] = uint32_t(p0);
+   }
+}
+
+/// Compute the two 64 bits outputs of the given block
+inline void PhiloxBlock(uint64_t seed, uint64_t stream, uint64_t block, uint64_t *out)
+{
+   uint32_t ctr[4] = {uint32_t(block), uint32_t(block >> 32), uint32_t(stream), uint32_t(stream >> 32)};
+   Philox4x32(ctr, uint32_t(seed), uint32_t(seed >> 32));
+   out[0] = ctr[0] | (uint64_t(ctr[1]) << 32);
+   out[1] = ctr[2] | (uint64_t(ctr[3]) << 32);
+}
+
+} // end anonymous namespace
+
+namespace ROOT {
+namespace Math {
+
+PhiloxEngine::PhiloxEngine(uint64_t seed, uint64_t stream) : fSeed(seed), fStream(stream), fBlock(0), fPosition(0)
+{
+   GenerateBlock();
+}
+
+void PhiloxEngine::GenerateBlock()
+{
+   PhiloxBlock(fSeed, fStream, fBlock, fOutput);
+}
+
+void PhiloxEngine::RndmArray(int n, double *array)
+{
+   static constexpr double div = 1.0 / (uint64_t(1) << 53);
+   int i = 0;
+   while (i < n && fPosition < 2)
+      array[i++] = (*this)();
+   // The blocks are independent of each other: the full blocks are computed
+   // from their counter, in a loop without dependencies between iterations
+   const int nblocks = (n - i) / 2;
+   for (int j = 0; j < nblocks; j++) {
+      uint64_t out[2];
+      PhiloxBlock(fSeed, fStream, fBlock + 1 + j, out);
+      array[i + 2 * j] = ((out[0] >> 11) + 1) * div;
+      array[i + 2 * j + 1] = ((out[1] >> 11) + 1) * div;
+   }
+   fBlock += nblocks;
+   i += 2 * nblocks;
+   if (i < n)
+      array[i] = (*this)();
+}
+
+void PhiloxEngine::SetSeed(uint64_t seed)
+{
+   fSeed = seed;
+   SetCounter(0);
+}
+
+void PhiloxEngine::SetStream(uint64_t stream)
+{
+   fStream = stream;
+   SetCounter(0);
+}
+
+void PhiloxEngine::SetCounter(uint64_t counter)
+{
+   fBlock = counter / 2;
+   fPosition = counter % 2;
+   GenerateBlock();
+}
+
+} // end namespace Math
+} // end namespace ROOT
@@ -181,16 +181,11 @@ private:
       Advance(RanluxppData<24>::kA);
    }
 
-public:
-   /// Return the next random bits, generate a new block if necessary
-   uint64_t NextRandomBits()
+   /// Extract the random bits at the given position of the current block
+   uint64_t ExtractBits(int position) const
    {
-      if (fPosition + w > kMaxPos) {
-         Advance();
-      }
-
-      int idx = fPosition / 64;
-      int offset = fPosition % 64;
+      int idx = position / 64;
+      int offset = position % 64;
       int numBits = 64 - offset;
 
       uint64_t bits = fState[idx] >> offset;
@@ -198,6 +193,18 @@ public:
          bits |= fState[idx + 1] << numBits;
       }
       bits &= ((uint64_t(1) << w) - 1);
+      return bits;
+   }
+
+public:
+   /// Return the next random bits, generate a new block if necessary
+   uint64_t NextRandomBits()
+   {
+      if (fPosition + w > kMaxPos) {
+         Advance();
+      }
+
+      uint64_t bits = ExtractBits(fPosition);
 
       fPosition += w;
       assert(fPosition <= kMaxPos && "position out of range!");
@@ -213,6 +220,29 @@ public:
       return bits * div;
    }
 
+   /// Fill the array with the same numbers as `n` calls of NextRandomFloat().
+   /// The numbers left in the current block are converted in a single loop.
+   void NextRandomFloats(int n, double *array)
+   {
+      static constexpr double div = 1.0 / (uint64_t(1) << w);
+      int i = 0;
+      while (i < n) {
+         if (fPosition + w > kMaxPos) {
+            Advance();
+         }
+         int m = (kMaxPos - fPosition) / w;
+         if (m > n - i) {
+            m = n - i;
+         }
+         for (int j = 0; j < m; j++) {
+            array[i + j] = ExtractBits(fPosition + j * w) * div;
+         }
+         fPosition += m * w;
+         assert(fPosition <= kMaxPos && "position out of range!");
+         i += m;
+      }
+   }
+
    /// Initialize and seed the state of the generator as in James' implementation
    void SetSeedJames(uint64_t s)
    {
@@ -419,6 +449,12 @@ double RanluxppEngine<p>::operator()()
    return fImpl->NextRandomFloat();
 }
 
+template <int p>
+void RanluxppEngine<p>::RndmArray(int n, double *array)
+{
+   fImpl->NextRandomFloats(n, array);
+}
+
 template <int p>
 uint64_t RanluxppEngine<p>::IntRndm()
 {
@@ -72,6 +72,91 @@ namespace {
 
 ClassImp(TRandom3);
 
+namespace {
+
+const Int_t  kM = 397;
+const Int_t  kN = 624;
+
+////////////////////////////////////////////////////////////////////////////////
+/// Regenerate the kN words of the state of the generator
+
+void GenerateState(UInt_t *mt)
+{
+   const UInt_t kUpperMask =       0x80000000;
+   const UInt_t kLowerMask =       0x7fffffff;
+   const UInt_t kMatrixA =         0x9908b0df;
+
+   UInt_t y;
+   Int_t i;
+
+   // (0 - (y & 0x1)) & kMatrixA is kMatrixA for odd y, without a branch
+   for (i=0; i < kN-kM; i++) {
+      y = (mt[i] & kUpperMask) | (mt[i+1] & kLowerMask);
+      mt[i] = mt[i+kM] ^ (y >> 1) ^ ((0u - (y & 0x1)) & kMatrixA);
+   }
+
+   for (   ; i < kN-1    ; i++) {
+      y = (mt[i] & kUpperMask) | (mt[i+1] & kLowerMask);
+      mt[i] = mt[i+kM-kN] ^ (y >> 1) ^ ((0u - (y & 0x1)) & kMatrixA);
+   }
+
+   y = (mt[kN-1] & kUpperMask) | (mt[0] & kLowerMask);
+   mt[kN-1] = mt[kM-1] ^ (y >> 1) ^ ((0u - (y & 0x1)) & kMatrixA);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Temper a word of the state
+
+inline UInt_t Temper(UInt_t y)
+{
+   const UInt_t kTemperingMaskB =  0x9d2c5680;
+   const UInt_t kTemperingMaskC =  0xefc60000;
+
+   y ^=  (y >> 11);
+   y ^= ((y << 7 ) & kTemperingMaskB );
+   y ^= ((y << 15) & kTemperingMaskC );
+   y ^=  (y >> 18);
+   return y;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Fill the array with the same numbers as n calls to TRandom3::Rndm().
+/// The words left in the state are tempered and converted in a single loop,
+/// without dependencies between the iterations, so that it can be vectorized.
+/// The (rare) zeros are removed afterwards.
+
+template <typename T>
+void FillArray(UInt_t *mt, Int_t &count, Int_t n, T *array)
+{
+   Int_t k = 0;
+   while (k < n) {
+      if (count >= kN) {
+         GenerateState(mt);
+         count = 0;
+      }
+      const Int_t m = TMath::Min(n - k, kN - count);
+      const UInt_t *words = mt + count;
+      T *out = array + k;
+      Int_t nzero = 0;
+      for (Int_t i = 0; i < m; i++) {
+         UInt_t y = Temper(words[i]);
+         out[i] = T(y * 2.3283064365386963e-10); // * Power(2,-32)
+         nzero += (y == 0);
+      }
+      count += m;
+      if (nzero == 0) {
+         k += m;
+         continue;
+      }
+      for (Int_t i = 0; i < m; i++) {
+         if (Temper(words[i]))
+            array[k++] = out[i];
+      }
+   }
+}
+
+} // anonymous namespace
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Default constructor
 /// If seed is 0, the seed is automatically computed via a TUUID object.
@@ -98,39 +183,12 @@ TRandom3::~TRandom3()
 
 Double_t TRandom3::Rndm()
 {
-   UInt_t y;
-
-   const Int_t  kM = 397;
-   const Int_t  kN = 624;
-   const UInt_t kTemperingMaskB =  0x9d2c5680;
-   const UInt_t kTemperingMaskC =  0xefc60000;
-   const UInt_t kUpperMask =       0x80000000;
-   const UInt_t kLowerMask =       0x7fffffff;
-   const UInt_t kMatrixA =         0x9908b0df;
-
    if (fCount624 >= kN) {
-      Int_t i;
-
-      for (i=0; i < kN-kM; i++) {
-         y = (fMt[i] & kUpperMask) | (fMt[i+1] & kLowerMask);
-         fMt[i] = fMt[i+kM] ^ (y >> 1) ^ ((y & 0x1) ? kMatrixA : 0x0);
-      }
-
-      for (   ; i < kN-1    ; i++) {
-         y = (fMt[i] & kUpperMask) | (fMt[i+1] & kLowerMask);
-         fMt[i] = fMt[i+kM-kN] ^ (y >> 1) ^ ((y & 0x1) ? kMatrixA : 0x0);
-      }
-
-      y = (fMt[kN-1] & kUpperMask) | (fMt[0] & kLowerMask);
-      fMt[kN-1] = fMt[kM-1] ^ (y >> 1) ^ ((y & 0x1) ? kMatrixA : 0x0);
+      GenerateState(fMt);
       fCount624 = 0;
    }
 
-   y = fMt[fCount624++];
-   y ^=  (y >> 11);
-   y ^= ((y << 7 ) & kTemperingMaskB );
-   y ^= ((y << 15) & kTemperingMaskC );
-   y ^=  (y >> 18);
+   UInt_t y = Temper(fMt[fCount624++]);
 
    // 2.3283064365386963e-10 == 1./(max<UINt_t>+1)  -> then returned value cannot be = 1.0
    if (y) return ( (Double_t) y * 2.3283064365386963e-10); // * Power(2,-32)
@@ -142,7 +200,7 @@ Double_t TRandom3::Rndm()
 
 void TRandom3::RndmArray(Int_t n, Float_t *array)
 {
-  for(Int_t i=0; i<n; i++) array[i]=(Float_t)Rndm();
+   FillArray(fMt, fCount624, n, array);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -150,48 +208,7 @@ void TRandom3::RndmArray(Int_t n, Float_t *array)
 
 void TRandom3::RndmArray(Int_t n, Double_t *array)
 {
-   Int_t k = 0;
-
-   UInt_t y;
-
-   const Int_t  kM = 397;
-   const Int_t  kN = 624;
-   const UInt_t kTemperingMaskB =  0x9d2c5680;
-   const UInt_t kTemperingMaskC =  0xefc60000;
-   const UInt_t kUpperMask =       0x80000000;
-   const UInt_t kLowerMask =       0x7fffffff;
-   const UInt_t kMatrixA =         0x9908b0df;
-
-   while (k < n) {
-      if (fCount624 >= kN) {
-         Int_t i;
-
-         for (i=0; i < kN-kM; i++) {
-            y = (fMt[i] & kUpperMask) | (fMt[i+1] & kLowerMask);
-            fMt[i] = fMt[i+kM] ^ (y >> 1) ^ ((y & 0x1) ? kMatrixA : 0x0);
-         }
-
-         for (   ; i < kN-1    ; i++) {
-            y = (fMt[i] & kUpperMask) | (fMt[i+1] & kLowerMask);
-            fMt[i] = fMt[i+kM-kN] ^ (y >> 1) ^ ((y & 0x1) ? kMatrixA : 0x0);
-         }
-
-         y = (fMt[kN-1] & kUpperMask) | (fMt[0] & kLowerMask);
-         fMt[kN-1] = fMt[kM-1] ^ (y >> 1) ^ ((y & 0x1) ? kMatrixA : 0x0);
-         fCount624 = 0;
-      }
-
-      y = fMt[fCount624++];
-      y ^=  (y >> 11);
-      y ^= ((y << 7 ) & kTemperingMaskB );
-      y ^= ((y << 15) & kTemperingMaskC );
-      y ^=  (y >> 18);
-
-      if (y) {
-         array[k] = Double_t( y * 2.3283064365386963e-10); // * Power(2,-32)
-         k++;
-      }
-   }
+   FillArray(fMt, fCount624, n, array);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
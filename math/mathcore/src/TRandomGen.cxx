@@ -4,6 +4,7 @@
 #include "TRandomGen.h"
 #include "Math/MixMaxEngine.h"
 #include "Math/RanluxppEngine.h"
+#include "Math/PhiloxEngine.h"
 #include "Math/StdEngine.h"
 
 // define the instance
@@ -14,6 +15,7 @@ class TRandomGen<ROOT::Math::MixMaxEngine<17,0>>;
 class TRandomGen<ROOT::Math::MixMaxEngine<17,1>>;
 
 class TRandomGen<ROOT::Math::RanluxppEngine2048>;
+class TRandomGen<ROOT::Math::PhiloxEngine>;
 
 class  TRandomGen<ROOT::Math::StdEngine<std::mt19937_64> >;
 class  TRandomGen<ROOT::Math::StdEngine<std::ranlux48> >;
@@ -0,0 +1,78 @@
+// @(#)root/mathcore:$Id$
+
+/*************************************************************************
+ * Copyright (C) 1995-2021, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#include "Math/PhiloxEngine.h"
+#include "TRandomGen.h"
+
+#include <vector>
+
+#include "gtest/gtest.h"
+
+using namespace ROOT::Math;
+
+TEST(PhiloxEngine, KnownAnswers)
+{
+   // Known answers of Philox-4x32-10 from Random123, for a zero counter and key:
+   // 6627e8d5 e169c58d bc57ac4c 9b00dbd8
+   PhiloxEngine rng(0, 0);
+   EXPECT_EQ(rng.IntRndm(), 0xe169c58d6627e8d5);
+   EXPECT_EQ(rng.IntRndm(), 0x9b00dbd8bc57ac4c);
+}
+
+TEST(PhiloxEngine, Counter)
+{
+   PhiloxEngine rng(42, 7);
+   std::vector<double> values(100);
+   for (auto &v : values) {
+      v = rng();
+      EXPECT_GT(v, 0.);
+      EXPECT_LE(v, 1.);
+   }
+   EXPECT_EQ(rng.GetCounter(), 100u);
+
+   // Any number of the stream can be generated directly
+   PhiloxEngine other(42, 7);
+   for (uint64_t counter : {57, 0, 99, 12, 13}) {
+      other.SetCounter(counter);
+      EXPECT_EQ(other(), values[counter]);
+   }
+   other.SetCounter(10);
+   other.Skip(5);
+   EXPECT_EQ(other(), values[15]);
+
+   // Arrays give the same numbers as the single calls
+   double array[50];
+   other.SetCounter(3);
+   other.RndmArray(50, array);
+   for (int i = 0; i < 50; ++i)
+      EXPECT_EQ(array[i], values[3 + i]);
+   EXPECT_EQ(other.GetCounter(), 53u);
+   EXPECT_EQ(other(), values[53]);
+
+   // Other streams and seeds give other numbers
+   PhiloxEngine otherStream(42, 8);
+   PhiloxEngine otherSeed(43, 7);
+   EXPECT_NE(otherStream(), values[0]);
+   EXPECT_NE(otherSeed(), values[0]);
+   otherSeed.SetSeed(42);
+   EXPECT_EQ(otherSeed(), values[0]);
+}
+
+TEST(PhiloxEngine, TRandomPhilox)
+{
+   TRandomPhilox rng(42);
+   rng.GetEngine().SetStream(7);
+   PhiloxEngine ref(42, 7);
+   EXPECT_EQ(rng.Rndm(), ref());
+   double array[5];
+   rng.RndmArray(5, array);
+   for (int i = 0; i < 5; ++i)
+      EXPECT_EQ(array[i], ref());
+}
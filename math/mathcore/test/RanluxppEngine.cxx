@@ -47,6 +47,24 @@ TEST(RanluxppEngine, random2048)
    EXPECT_EQ(rng.Rndm(), 0.74670661284082484599);
 }
 
+TEST(RanluxppEngine, array2048)
+{
+   RanluxppEngine2048 rng(314159265);
+   RanluxppEngine2048 ref(314159265);
+
+   // Arrays within a block, across blocks and after skipping give the same numbers as single calls.
+   double array[100];
+   for (int n : {5, 7, 12, 100}) {
+      rng.RndmArray(n, array);
+      for (int i = 0; i < n; i++) {
+         EXPECT_EQ(array[i], ref.Rndm());
+      }
+      rng.Skip(3);
+      ref.Skip(3);
+   }
+   EXPECT_EQ(rng.IntRndm(), ref.IntRndm());
+}
+
 TEST(RanluxppCompatEngineJames, P3)
 {
    RanluxppCompatEngineJamesP3 rng(314159265);
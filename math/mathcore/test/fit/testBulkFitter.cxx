@@ -0,0 +1,112 @@
+#include "Fit/BinData.h"
+#include "Fit/BulkFitter.h"
+#include "Fit/Fitter.h"
+#include "HFitInterface.h"
+#include "Math/WrappedMultiTF1.h"
+#include "TF1.h"
+#include "TH1D.h"
+#include "TRandom3.h"
+#include "TROOT.h"
+
+#include "gtest/gtest.h"
+
+#include <cmath>
+#include <memory>
+#include <vector>
+
+namespace {
+
+/// Gaussian peaks of different positions and widths, one histogram per channel
+std::vector<std::shared_ptr<ROOT::Fit::BinData>> MakeChannels(unsigned int nChannels)
+{
+   TRandom3 rndm(42);
+   std::vector<std::shared_ptr<ROOT::Fit::BinData>> data;
+   for (unsigned int i = 0; i < nChannels; ++i) {
+      TH1D h("h", "h", 50, -5, 5);
+      h.SetDirectory(nullptr);
+      const double mean = rndm.Uniform(-1, 1);
+      const double sigma = rndm.Uniform(0.5, 1.5);
+      for (int j = 0; j < 1000; ++j)
+         h.Fill(rndm.Gaus(mean, sigma));
+      data.emplace_back(std::make_shared<ROOT::Fit::BinData>());
+      ROOT::Fit::FillData(*data.back(), &h);
+   }
+   return data;
+}
+
+} // anonymous namespace
+
+TEST(BulkFitter, SameAsFitter)
+{
+   const auto data = MakeChannels(20);
+   TF1 f1("f1", "[0]*exp(-0.5*((x-[1])/[2])^2)", -5, 5);
+   f1.SetParameters(100, 0, 1);
+   ROOT::Math::WrappedMultiTF1 model(f1, 1);
+
+   ROOT::Fit::BulkFitter bulkFitter(model);
+   const auto results = bulkFitter.Fit(data, {}, ROOT::EExecutionPolicy::kSequential);
+   ASSERT_EQ(results.Size(), data.size());
+   ASSERT_EQ(results.NPar(), 3u);
+
+   for (unsigned int i = 0; i < data.size(); ++i) {
+      ROOT::Fit::Fitter fitter;
+      fitter.Config().SetUpdateAfterFit(false);
+      ASSERT_TRUE(fitter.Fit(*data[i], model));
+      const auto &result = fitter.Result();
+      EXPECT_TRUE(results.IsValid(i));
+      EXPECT_EQ(results.Ndf(i), result.Ndf());
+      EXPECT_NEAR(results.MinFcnValue(i), result.MinFcnValue(), 1e-6 * result.MinFcnValue());
+      for (unsigned int ipar = 0; ipar < 3; ++ipar) {
+         EXPECT_NEAR(results.Value(i, ipar), result.Value(ipar), 1e-3 * result.Error(ipar));
+         EXPECT_NEAR(results.Error(i, ipar), result.Error(ipar), 1e-2 * result.Error(ipar));
+      }
+   }
+}
+
+TEST(BulkFitter, InitialParams)
+{
+   const auto data = MakeChannels(3);
+   TF1 f1("f1", "[0]*exp(-0.5*((x-[1])/[2])^2)", -5, 5);
+   f1.SetParameters(100, 0, 1);
+   ROOT::Math::WrappedMultiTF1 model(f1, 1);
+
+   ROOT::Fit::BulkFitter fitter(model);
+   fitter.Config().ParSettings(1).Fix();
+   const std::vector<double> initialParams{100, -1, 1, 100, 0, 1, 100, 1, 1};
+   const auto results = fitter.Fit(data, initialParams, ROOT::EExecutionPolicy::kSequential);
+   for (unsigned int i = 0; i < 3; ++i) {
+      EXPECT_EQ(results.Value(i, 1), initialParams[3 * i + 1]);
+      EXPECT_EQ(results.Ndf(i), data[i]->Size() - 2);
+   }
+
+   // wrong number of initial values: nothing is fitted
+   const auto invalid = fitter.Fit(data, {100, 0, 1}, ROOT::EExecutionPolicy::kSequential);
+   for (unsigned int i = 0; i < 3; ++i)
+      EXPECT_FALSE(invalid.IsValid(i));
+}
+
+#ifdef R__USE_IMT
+TEST(BulkFitter, MultiThread)
+{
+   const auto data = MakeChannels(200);
+   TF1 f1("f1", "[0]*exp(-0.5*((x-[1])/[2])^2)", -5, 5);
+   f1.SetParameters(100, 0, 1);
+   ROOT::Math::WrappedMultiTF1 model(f1, 1);
+
+   ROOT::Fit::BulkFitter fitter(model);
+   fitter.SetLikelihood();
+   const auto expected = fitter.Fit(data, {}, ROOT::EExecutionPolicy::kSequential);
+
+   ROOT::EnableImplicitMT(4);
+   const auto results = fitter.Fit(data);
+   ROOT::DisableImplicitMT();
+
+   ASSERT_EQ(results.Size(), expected.Size());
+   for (unsigned int i = 0; i < results.Size(); ++i) {
+      EXPECT_EQ(results.IsValid(i), expected.IsValid(i));
+      EXPECT_NEAR(results.MinFcnValue(i), expected.MinFcnValue(i), 1e-9 * std::abs(expected.MinFcnValue(i)));
+      for (unsigned int ipar = 0; ipar < 3; ++ipar)
+         EXPECT_NEAR(results.Value(i, ipar), expected.Value(i, ipar), 1e-6 * expected.Error(i, ipar));
+   }
+}
+#endif
@@ -13,6 +13,7 @@
 // custom include(s)
 #include "Math/KDTree.h"
 #include "Math/TDataPoint.h"
+#include "TROOT.h"
 
 template<class _DataPoint>
 void CreatePseudoData(const unsigned long int nPoints,std::vector<const _DataPoint*>& vDataPoints)
@@ -62,6 +63,16 @@ ROOT::Math::KDTree<_DataPoint>* BuildTree(const std::vector<const _DataPoint*>&
    return pTree;
 }
 
+template<class _DataPoint>
+ROOT::Math::KDTree<_DataPoint>* BuildTreeAtOnce(const std::vector<const _DataPoint*>& vDataPoints,const unsigned int iBucketSize,
+                                                ROOT::EExecutionPolicy executionPolicy)
+{
+   ROOT::Math::KDTree<_DataPoint>* pTree = new ROOT::Math::KDTree<_DataPoint>(iBucketSize);
+   pTree->Insert(vDataPoints,executionPolicy);
+
+   return pTree;
+}
+
 template<class _DataPoint>
 bool CheckBasicTreeProperties(const ROOT::Math::KDTree<_DataPoint>* pTree,const std::vector<const _DataPoint*>& vDataPoints)
 {
@@ -387,6 +398,37 @@ int main()
    else
    std::cerr << "check KDTree:Clear...FAILED" << std::endl;
 
+   // insert all points at once
+   ROOT::Math::KDTree<DP>* pBulkTree = BuildTreeAtOnce(vDataPoints,BUCKETSIZE,ROOT::EExecutionPolicy::kSequential);
+
+   if(CheckBasicTreeProperties(pBulkTree,vDataPoints) && CheckEffectiveBinEntries(pBulkTree) &&
+      pBulkTree->GetNBins() == pTree->GetNBins())
+   std::cerr << "check insertion of all points at once...DONE" << std::endl;
+   else
+   std::cerr << "check insertion of all points at once...FAILED" << std::endl;
+
+   delete pBulkTree;
+
+#ifdef R__USE_IMT
+   // build the tree in parallel, the result must not depend on the number of threads
+   ROOT::EnableImplicitMT(2);
+   ROOT::Math::KDTree<DP>* pParallelTree = BuildTreeAtOnce(vDataPoints,BUCKETSIZE,ROOT::EExecutionPolicy::kMultiThread);
+   ROOT::DisableImplicitMT();
+   ROOT::EnableImplicitMT(4);
+   ROOT::Math::KDTree<DP>* pParallelTree4 = BuildTreeAtOnce(vDataPoints,BUCKETSIZE,ROOT::EExecutionPolicy::kMultiThread);
+   ROOT::DisableImplicitMT();
+
+   if(CheckBasicTreeProperties(pParallelTree,vDataPoints) && CheckBinBoundaries(pParallelTree) &&
+      CheckEffectiveBinEntries(pParallelTree) && CheckNearestNeighborSearches(pParallelTree,vDataPoints) &&
+      pParallelTree->GetNBins() == pParallelTree4->GetNBins())
+   std::cerr << "check parallel insertion of all points at once...DONE" << std::endl;
+   else
+   std::cerr << "check parallel insertion of all points at once...FAILED" << std::endl;
+
+   delete pParallelTree4;
+   delete pParallelTree;
+#endif
+
    //pTree->Print();
    pTree->Freeze();
    //pTree->Print();
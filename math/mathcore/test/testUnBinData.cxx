@@ -0,0 +1,41 @@
+#include "Fit/UnBinData.h"
+
+#include "gtest/gtest.h"
+
+#include <memory>
+#include <vector>
+
+// The data adopt the columns without copying them and keep them alive
+TEST(UnBinData, AdoptColumns)
+{
+   auto x = std::make_shared<std::vector<double>>();
+   auto y = std::make_shared<std::vector<double>>();
+   for (int i = 0; i < 101; ++i) {
+      x->push_back(i);
+      y->push_back(-i);
+   }
+   std::unique_ptr<ROOT::Fit::UnBinData> data(new ROOT::Fit::UnBinData({x, y}));
+   EXPECT_EQ(101u, data->Size());
+   EXPECT_EQ(2u, data->NDim());
+   EXPECT_FALSE(data->IsWeighted());
+   EXPECT_EQ(x->data(), data->GetCoordComponent(0, 0));
+
+   x.reset();
+   y.reset();
+   for (unsigned int i = 0; i < data->Size(); ++i) {
+      EXPECT_EQ(double(i), *data->GetCoordComponent(i, 0));
+      EXPECT_EQ(-double(i), *data->GetCoordComponent(i, 1));
+   }
+}
+
+TEST(UnBinData, AdoptWeightedColumns)
+{
+   auto x = std::make_shared<std::vector<double>>(10, 1.);
+   auto w = std::make_shared<std::vector<double>>(10, 2.);
+   ROOT::Fit::UnBinData data({x, w}, /*isWeighted*/ true);
+   EXPECT_EQ(10u, data.Size());
+   EXPECT_EQ(1u, data.NDim());
+   EXPECT_TRUE(data.IsWeighted());
+   EXPECT_EQ(2., data.Weight(3));
+   EXPECT_EQ(1., *data.GetCoordComponent(3, 0));
+}
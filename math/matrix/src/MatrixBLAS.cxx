@@ -0,0 +1,205 @@
+// @(#)root/matrix:$Id$
+
+/*************************************************************************
+ * Copyright (C) 1995-2021, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#include "MatrixBLAS.h"
+
+#include <vector>
+
+#ifdef R__HAS_MATRIX_BLAS
+
+// Fortran interfaces of BLAS and LAPACK, with 32 bits integers (LP64)
+extern "C" {
+void dgemm_(const char *transa, const char *transb, const int *m, const int *n, const int *k, const double *alpha,
+            const double *a, const int *lda, const double *b, const int *ldb, const double *beta, double *c,
+            const int *ldc);
+void sgemm_(const char *transa, const char *transb, const int *m, const int *n, const int *k, const float *alpha,
+            const float *a, const int *lda, const float *b, const int *ldb, const float *beta, float *c,
+            const int *ldc);
+void dgetrf_(const int *m, const int *n, double *a, const int *lda, int *ipiv, int *info);
+void dgetri_(const int *n, double *a, const int *lda, const int *ipiv, double *work, const int *lwork, int *info);
+void dpotrf_(const char *uplo, const int *n, double *a, const int *lda, int *info);
+void dsyevd_(const char *jobz, const char *uplo, const int *n, double *a, const int *lda, double *w, double *work,
+             const int *lwork, int *iwork, const int *liwork, int *info);
+void dgesdd_(const char *jobz, const int *m, const int *n, double *a, const int *lda, double *s, double *u,
+             const int *ldu, double *vt, const int *ldvt, double *work, const int *lwork, int *iwork, int *info);
+}
+
+#endif
+
+namespace {
+/// Dimension from which the matrix operations are done by BLAS/LAPACK
+const Int_t kMinSize = 64;
+} // anonymous namespace
+
+////////////////////////////////////////////////////////////////////////////////
+
+Bool_t ROOT::Internal::MatrixBLAS::UseFor(Int_t n)
+{
+#ifdef R__HAS_MATRIX_BLAS
+   return n >= kMinSize;
+#else
+   (void)n;
+   (void)kMinSize;
+   return kFALSE;
+#endif
+}
+
+#ifdef R__HAS_MATRIX_BLAS
+
+////////////////////////////////////////////////////////////////////////////////
+/// The matrices stored by rows are the transposed of the Fortran ones: compute
+/// C' = op(B)' * op(A)' in Fortran order.
+
+void ROOT::Internal::MatrixBLAS::Gemm(Bool_t transA, Bool_t transB, Int_t m, Int_t n, Int_t k, const Double_t *a,
+                                      const Double_t *b, Double_t *c)
+{
+   const char ta = transA ? 'T' : 'N';
+   const char tb = transB ? 'T' : 'N';
+   const int lda = transA ? m : k;
+   const int ldb = transB ? k : n;
+   const double alpha = 1.0;
+   const double beta = 0.0;
+   dgemm_(&tb, &ta, &n, &m, &k, &alpha, b, &ldb, a, &lda, &beta, c, &n);
+}
+
+void ROOT::Internal::MatrixBLAS::Gemm(Bool_t transA, Bool_t transB, Int_t m, Int_t n, Int_t k, const Float_t *a,
+                                      const Float_t *b, Float_t *c)
+{
+   const char ta = transA ? 'T' : 'N';
+   const char tb = transB ? 'T' : 'N';
+   const int lda = transA ? m : k;
+   const int ldb = transB ? k : n;
+   const float alpha = 1.0;
+   const float beta = 0.0;
+   sgemm_(&tb, &ta, &n, &m, &k, &alpha, b, &ldb, a, &lda, &beta, c, &n);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+Int_t ROOT::Internal::MatrixBLAS::Getrf(Int_t n, Double_t *a, Int_t *ipiv)
+{
+   int info = 0;
+   dgetrf_(&n, &n, a, &n, ipiv, &info);
+   return info;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+Int_t ROOT::Internal::MatrixBLAS::Getri(Int_t n, Double_t *a, const Int_t *ipiv)
+{
+   int info = 0;
+   int lwork = -1;
+   double size = 0;
+   dgetri_(&n, a, &n, ipiv, &size, &lwork, &info);
+   if (info != 0)
+      return info;
+   lwork = static_cast<int>(size);
+   std::vector<double> work(lwork);
+   dgetri_(&n, a, &n, ipiv, work.data(), &lwork, &info);
+   return info;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Cholesky decomposition A = L L' of the lower triangle, in Fortran order.
+/// For a symmetric matrix stored by rows, it is the decomposition A = U' U
+/// of the upper triangle.
+
+Int_t ROOT::Internal::MatrixBLAS::Potrf(Int_t n, Double_t *a)
+{
+   const char uplo = 'L';
+   int info = 0;
+   dpotrf_(&uplo, &n, a, &n, &info);
+   return info;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Eigenvalues, in ascending order, and eigenvectors, in the columns of a in
+/// Fortran order, of a symmetric matrix
+
+Int_t ROOT::Internal::MatrixBLAS::Syevd(Int_t n, Double_t *a, Double_t *w)
+{
+   const char jobz = 'V';
+   const char uplo = 'U';
+   int info = 0;
+   int lwork = -1;
+   int liwork = -1;
+   double size = 0;
+   int isize = 0;
+   dsyevd_(&jobz, &uplo, &n, a, &n, w, &size, &lwork, &isize, &liwork, &info);
+   if (info != 0)
+      return info;
+   lwork = static_cast<int>(size);
+   liwork = isize;
+   std::vector<double> work(lwork);
+   std::vector<int> iwork(liwork);
+   dsyevd_(&jobz, &uplo, &n, a, &n, w, work.data(), &lwork, iwork.data(), &liwork, &info);
+   return info;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Full singular value decomposition A = U S V' of the m x n matrix a, in
+/// Fortran order. The singular values are in descending order.
+
+Int_t ROOT::Internal::MatrixBLAS::Gesdd(Int_t m, Int_t n, Double_t *a, Double_t *s, Double_t *u, Double_t *vt)
+{
+   const char jobz = 'A';
+   int info = 0;
+   int lwork = -1;
+   double size = 0;
+   std::vector<int> iwork(8 * (m < n ? m : n));
+   dgesdd_(&jobz, &m, &n, a, &m, s, u, &m, vt, &n, &size, &lwork, iwork.data(), &info);
+   if (info != 0)
+      return info;
+   lwork = static_cast<int>(size);
+   std::vector<double> work(lwork);
+   dgesdd_(&jobz, &m, &n, a, &m, s, u, &m, vt, &n, work.data(), &lwork, iwork.data(), &info);
+   return info;
+}
+
+#else
+
+// Never called, see UseFor()
+
+void ROOT::Internal::MatrixBLAS::Gemm(Bool_t, Bool_t, Int_t, Int_t, Int_t, const Double_t *, const Double_t *,
+                                      Double_t *)
+{
+}
+
+void ROOT::Internal::MatrixBLAS::Gemm(Bool_t, Bool_t, Int_t, Int_t, Int_t, const Float_t *, const Float_t *,
+                                      Float_t *)
+{
+}
+
+Int_t ROOT::Internal::MatrixBLAS::Getrf(Int_t, Double_t *, Int_t *)
+{
+   return -1;
+}
+
+Int_t ROOT::Internal::MatrixBLAS::Getri(Int_t, Double_t *, const Int_t *)
+{
+   return -1;
+}
+
+Int_t ROOT::Internal::MatrixBLAS::Potrf(Int_t, Double_t *)
+{
+   return -1;
+}
+
+Int_t ROOT::Internal::MatrixBLAS::Syevd(Int_t, Double_t *, Double_t *)
+{
+   return -1;
+}
+
+Int_t ROOT::Internal::MatrixBLAS::Gesdd(Int_t, Int_t, Double_t *, Double_t *, Double_t *, Double_t *)
+{
+   return -1;
+}
+
+#endif
@@ -0,0 +1,55 @@
+// @(#)root/matrix:$Id$
+
+/*************************************************************************
+ * Copyright (C) 1995-2021, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#ifndef ROOT_MatrixBLAS
+#define ROOT_MatrixBLAS
+
+//////////////////////////////////////////////////////////////////////////
+//                                                                      //
+// MatrixBLAS                                                           //
+//                                                                      //
+// Thin wrappers of the BLAS and LAPACK routines used by the large      //
+// matrix operations when libMatrix is built with the matrix-blas       //
+// option. The matrices are stored by rows, as in TMatrixT: the wrappers //
+// do not transpose them, the callers take care of it.                  //
+//                                                                      //
+// Without the option, UseFor() is always false and the routines of the //
+// library are used.                                                    //
+//                                                                      //
+//////////////////////////////////////////////////////////////////////////
+
+#include "RtypesCore.h"
+
+namespace ROOT {
+namespace Internal {
+namespace MatrixBLAS {
+
+/// True if an operation on matrices of dimension n should be done by BLAS/LAPACK;
+/// small matrices are faster with the routines of the library.
+Bool_t UseFor(Int_t n);
+
+/// C = op(A) * op(B), with C of size m x n and k the inner dimension, all stored by rows
+void Gemm(Bool_t transA, Bool_t transB, Int_t m, Int_t n, Int_t k, const Double_t *a, const Double_t *b,
+          Double_t *c);
+void Gemm(Bool_t transA, Bool_t transB, Int_t m, Int_t n, Int_t k, const Float_t *a, const Float_t *b, Float_t *c);
+
+/// LAPACK routines on Fortran (column-major) matrices: they return the info code of LAPACK
+/// and allocate the optimal work space themselves.
+Int_t Getrf(Int_t n, Double_t *a, Int_t *ipiv);
+Int_t Getri(Int_t n, Double_t *a, const Int_t *ipiv);
+Int_t Potrf(Int_t n, Double_t *a);
+Int_t Syevd(Int_t n, Double_t *a, Double_t *w);
+Int_t Gesdd(Int_t m, Int_t n, Double_t *a, Double_t *s, Double_t *u, Double_t *vt);
+
+} // namespace MatrixBLAS
+} // namespace Internal
+} // namespace ROOT
+
+#endif
@@ -26,6 +26,7 @@
 
 #include "TDecompChol.h"
 #include "TMath.h"
+#include "MatrixBLAS.h"
 
 ClassImp(TDecompChol);
 
@@ -115,31 +116,40 @@ Bool_t TDecompChol::Decompose()
    Int_t i,j,icol,irow;
    const Int_t     n  = fU.GetNrows();
          Double_t *pU = fU.GetMatrixArray();
-   for (icol = 0; icol < n; icol++) {
-      const Int_t rowOff = icol*n;
-
-      //Compute fU(j,j) and test for non-positive-definiteness.
-      Double_t ujj = pU[rowOff+icol];
-      for (irow = 0; irow < icol; irow++) {
-         const Int_t pos_ij = irow*n+icol;
-         ujj -= pU[pos_ij]*pU[pos_ij];
-      }
-      if (ujj <= 0) {
+
+   if (ROOT::Internal::MatrixBLAS::UseFor(n)) {
+      // The lower triangle by columns of LAPACK is the upper triangle by rows
+      if (ROOT::Internal::MatrixBLAS::Potrf(n,pU) != 0) {
          Error("Decompose()","matrix not positive definite");
          return kFALSE;
       }
-      ujj = TMath::Sqrt(ujj);
-      pU[rowOff+icol] = ujj;
-
-      if (icol < n-1) {
-         for (j = icol+1; j < n; j++) {
-            for (i = 0; i < icol; i++) {
-               const Int_t rowOff2 = i*n;
-               pU[rowOff+j] -= pU[rowOff2+j]*pU[rowOff2+icol];
+   } else {
+      for (icol = 0; icol < n; icol++) {
+         const Int_t rowOff = icol*n;
+
+         //Compute fU(j,j) and test for non-positive-definiteness.
+         Double_t ujj = pU[rowOff+icol];
+         for (irow = 0; irow < icol; irow++) {
+            const Int_t pos_ij = irow*n+icol;
+            ujj -= pU[pos_ij]*pU[pos_ij];
+         }
+         if (ujj <= 0) {
+            Error("Decompose()","matrix not positive definite");
+            return kFALSE;
+         }
+         ujj = TMath::Sqrt(ujj);
+         pU[rowOff+icol] = ujj;
+
+         if (icol < n-1) {
+            for (j = icol+1; j < n; j++) {
+               for (i = 0; i < icol; i++) {
+                  const Int_t rowOff2 = i*n;
+                  pU[rowOff+j] -= pU[rowOff2+j]*pU[rowOff2+icol];
+               }
             }
+            for (j = icol+1; j < n; j++)
+               pU[rowOff+j] /= ujj;
          }
-         for (j = icol+1; j < n; j++)
-            pU[rowOff+j] /= ujj;
       }
    }
 
@@ -11,6 +11,9 @@
 
 #include "TDecompLU.h"
 #include "TMath.h"
+#include "MatrixBLAS.h"
+
+#include <vector>
 
 ClassImp(TDecompLU);
 
@@ -714,6 +717,32 @@ Bool_t TDecompLU::DecomposeLUGauss(TMatrixD &lu,Int_t *index,Double_t &sign,
    sign    = 1.0;
    nrZeros = 0;
 
+   if (ROOT::Internal::MatrixBLAS::UseFor(n)) {
+      // Same algorithm by LAPACK, which stores the matrices by columns
+      std::vector<Double_t> a(n*n);
+      std::vector<Int_t> ipiv(n);
+      for (Int_t i = 0; i < n; i++)
+         for (Int_t j = 0; j < n; j++)
+            a[j*n+i] = pLU[i*n+j];
+      const Int_t info = ROOT::Internal::MatrixBLAS::Getrf(n,a.data(),ipiv.data());
+      for (Int_t i = 0; i < n; i++)
+         for (Int_t j = 0; j < n; j++)
+            pLU[i*n+j] = a[j*n+i];
+      for (Int_t j = 0; j < n; j++) {
+         index[j] = ipiv[j]-1;
+         if (index[j] != j)
+            sign = -sign;
+         const Double_t mLUjj = pLU[j*n+j];
+         if (mLUjj != 0.0 && TMath::Abs(mLUjj) < tol)
+            nrZeros++;
+      }
+      if (info != 0) {
+         ::Error("TDecompLU::DecomposeLUGauss","matrix is singular");
+         return kFALSE;
+      }
+      return kTRUE;
+   }
+
    index[n-1] = n-1;
    for (Int_t j = 0; j < n-1; j++) {
       const Int_t off_j = j*n;
@@ -785,6 +814,41 @@ Bool_t TDecompLU::InvertLU(TMatrixD &lu,Double_t tol,Double_t *det)
    const Int_t     n   = lu.GetNcols();
    Double_t *pLU = lu.GetMatrixArray();
 
+   if (ROOT::Internal::MatrixBLAS::UseFor(n)) {
+      // LAPACK stores the matrices by columns, so that it sees the transposed
+      // matrix, whose inverse is the transposed of the inverse
+      std::vector<Int_t> ipiv(n);
+      Int_t info = ROOT::Internal::MatrixBLAS::Getrf(n,pLU,ipiv.data());
+      Double_t sign = 1.0;
+      Int_t nrZeros = 0;
+      for (Int_t j = 0; j < n; j++) {
+         if (ipiv[j]-1 != j)
+            sign = -sign;
+         if (TMath::Abs(pLU[j*n+j]) < tol)
+            nrZeros++;
+      }
+      if (info != 0 || nrZeros > 0) {
+         ::Error("TDecompLU::InvertLU","matrix is singular, %d diag elements < tolerance of %.4e",nrZeros,tol);
+         return kFALSE;
+      }
+
+      if (det) {
+         Double_t d1;
+         Double_t d2;
+         const TVectorD diagv = TMatrixDDiag_const(lu);
+         DiagProd(diagv,tol,d1,d2);
+         d1 *= sign;
+         *det = d1*TMath::Power(2.0,d2);
+      }
+
+      info = ROOT::Internal::MatrixBLAS::Getri(n,pLU,ipiv.data());
+      if (info != 0) {
+         ::Error("TDecompLU::InvertLU","inversion failed");
+         return kFALSE;
+      }
+      return kTRUE;
+   }
+
    Int_t worki[kWorkMax];
    Bool_t isAllocatedI = kFALSE;
    Int_t *index = worki;
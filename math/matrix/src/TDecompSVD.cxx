@@ -43,6 +43,9 @@
 #include "TDecompSVD.h"
 #include "TMath.h"
 #include "TArrayD.h"
+#include "MatrixBLAS.h"
+
+#include <vector>
 
 ClassImp(TDecompSVD);
 
@@ -133,6 +136,30 @@ Bool_t TDecompSVD::Decompose()
    const Int_t rowLwb = this->GetRowLwb();
    const Int_t colLwb = this->GetColLwb();
 
+   if (ROOT::Internal::MatrixBLAS::UseFor(nCol)) {
+      // The matrix stored by rows in fV is A' for LAPACK, whose decomposition is
+      // V S U': LAPACK returns V by columns and U' by columns, i.e. U by rows.
+      // The singular vectors can differ by their sign from the ones below.
+      const Int_t nRow = fU.GetNrows();
+      std::vector<Double_t> at(fV.GetMatrixArray(),fV.GetMatrixArray()+nRow*nCol);
+      std::vector<Double_t> v(nCol*nCol);
+      if (ROOT::Internal::MatrixBLAS::Gesdd(nCol,nRow,at.data(),fSig.GetMatrixArray(),v.data(),
+                                            fU.GetMatrixArray()) != 0) {
+         Error("Decompose()","singular value decomposition failed");
+         return kFALSE;
+      }
+      fV.ResizeTo(nCol,nCol);
+      Double_t *pV = fV.GetMatrixArray();
+      for (Int_t irow = 0; irow < nCol; irow++)
+         for (Int_t icol = 0; icol < nCol; icol++)
+            pV[irow*nCol+icol] = v[icol*nCol+irow];
+      fV.Shift(colLwb,colLwb);
+      fSig.Shift(colLwb);
+      fU.Shift(rowLwb,colLwb);
+      SetBit(kDecomposed);
+      return kTRUE;
+   }
+
    TVectorD offDiag;
    Double_t work[kWorkMax];
    if (nCol > kWorkMax) offDiag.ResizeTo(nCol);
@@ -25,6 +25,9 @@
 
 #include "TMatrixDSymEigen.h"
 #include "TMath.h"
+#include "MatrixBLAS.h"
+
+#include <vector>
 
 ClassImp(TMatrixDSymEigen);
 
@@ -43,6 +46,25 @@ TMatrixDSymEigen::TMatrixDSymEigen(const TMatrixDSym &a)
 
    fEigenVectors = a;
 
+   if (ROOT::Internal::MatrixBLAS::UseFor(nRows)) {
+      // LAPACK returns the eigenvalues in ascending order and the eigenvectors
+      // in the columns of a matrix stored by columns: reverse and transpose them.
+      // The eigenvectors can differ by their sign from the ones below.
+      std::vector<Double_t> z(a.GetMatrixArray(),a.GetMatrixArray()+nRows*nRows);
+      std::vector<Double_t> w(nRows);
+      if (ROOT::Internal::MatrixBLAS::Syevd(nRows,z.data(),w.data()) == 0) {
+         Double_t *pV = fEigenVectors.GetMatrixArray();
+         Double_t *pD = fEigenValues.GetMatrixArray();
+         for (Int_t icol = 0; icol < nRows; icol++) {
+            const Int_t off_z = (nRows-1-icol)*nRows;
+            pD[icol] = w[nRows-1-icol];
+            for (Int_t irow = 0; irow < nRows; irow++)
+               pV[irow*nRows+icol] = z[off_z+irow];
+         }
+         return;
+      }
+   }
+
    TVectorD offDiag;
    Double_t work[kWorkMax];
    if (nRows > kWorkMax) offDiag.ResizeTo(nRows);
@@ -20,8 +20,6 @@
 
 */
 
-#include <typeinfo>
-
 #include "TMatrixT.h"
 #include "TBuffer.h"
 #include "TMatrixTSym.h"
@@ -30,6 +28,7 @@
 #include "TDecompLU.h"
 #include "TMatrixDEigen.h"
 #include "TMath.h"
+#include "MatrixBLAS.h"
 
 templateClassImp(TMatrixT);
 
@@ -665,19 +664,6 @@ void TMatrixT<Element>::Mult(const TMatrixT<Element> &a,const TMatrixT<Element>
       }
    }
 
-#ifdef CBLAS
-   const Element *ap = a.GetMatrixArray();
-   const Element *bp = b.GetMatrixArray();
-         Element *cp = this->GetMatrixArray();
-   if (typeid(Element) == typeid(Double_t))
-      cblas_dgemm (CblasRowMajor,CblasNoTrans,CblasNoTrans,fNrows,fNcols,a.GetNcols(),
-                   1.0,ap,a.GetNcols(),bp,b.GetNcols(),1.0,cp,fNcols);
-   else if (typeid(Element) != typeid(Float_t))
-      cblas_sgemm (CblasRowMajor,CblasNoTrans,CblasNoTrans,fNrows,fNcols,a.GetNcols(),
-                   1.0,ap,a.GetNcols(),bp,b.GetNcols(),1.0,cp,fNcols);
-   else
-      Error("Mult","type %s not implemented in BLAS library",typeid(Element));
-#else
    const Int_t na     = a.GetNoElements();
    const Int_t nb     = b.GetNoElements();
    const Int_t ncolsa = a.GetNcols();
@@ -687,7 +673,6 @@ void TMatrixT<Element>::Mult(const TMatrixT<Element> &a,const TMatrixT<Element>
          Element *       cp = this->GetMatrixArray();
 
    AMultB(ap,na,ncolsa,bp,nb,ncolsb,cp);
-#endif
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -716,19 +701,6 @@ void TMatrixT<Element>::Mult(const TMatrixTSym<Element> &a,const TMatrixT<Elemen
       }
    }
 
-#ifdef CBLAS
-   const Element *ap = a.GetMatrixArray();
-   const Element *bp = b.GetMatrixArray();
-         Element *cp = this->GetMatrixArray();
-   if (typeid(Element) == typeid(Double_t))
-      cblas_dsymm (CblasRowMajor,CblasLeft,CblasUpper,fNrows,fNcols,1.0,
-                   ap,a.GetNcols(),bp,b.GetNcols(),0.0,cp,fNcols);
-   else if (typeid(Element) != typeid(Float_t))
-      cblas_ssymm (CblasRowMajor,CblasLeft,CblasUpper,fNrows,fNcols,1.0,
-                   ap,a.GetNcols(),bp,b.GetNcols(),0.0,cp,fNcols);
-   else
-      Error("Mult","type %s not implemented in BLAS library",typeid(Element));
-#else
    const Int_t na     = a.GetNoElements();
    const Int_t nb     = b.GetNoElements();
    const Int_t ncolsa = a.GetNcols();
@@ -739,7 +711,6 @@ void TMatrixT<Element>::Mult(const TMatrixTSym<Element> &a,const TMatrixT<Elemen
 
    AMultB(ap,na,ncolsa,bp,nb,ncolsb,cp);
 
-#endif
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -768,19 +739,6 @@ void TMatrixT<Element>::Mult(const TMatrixT<Element> &a,const TMatrixTSym<Elemen
       }
    }
 
-#ifdef CBLAS
-   const Element *ap = a.GetMatrixArray();
-   const Element *bp = b.GetMatrixArray();
-         Element *cp = this->GetMatrixArray();
-   if (typeid(Element) == typeid(Double_t))
-      cblas_dsymm (CblasRowMajor,CblasRight,CblasUpper,fNrows,fNcols,1.0,
-                   bp,b.GetNcols(),ap,a.GetNcols(),0.0,cp,fNcols);
-   else if (typeid(Element) != typeid(Float_t))
-      cblas_ssymm (CblasRowMajor,CblasRight,CblasUpper,fNrows,fNcols,1.0,
-                   bp,b.GetNcols(),ap,a.GetNcols(),0.0,cp,fNcols);
-   else
-      Error("Mult","type %s not implemented in BLAS library",typeid(Element));
-#else
    const Int_t na     = a.GetNoElements();
    const Int_t nb     = b.GetNoElements();
    const Int_t ncolsa = a.GetNcols();
@@ -790,7 +748,6 @@ void TMatrixT<Element>::Mult(const TMatrixT<Element> &a,const TMatrixTSym<Elemen
          Element *       cp = this->GetMatrixArray();
 
    AMultB(ap,na,ncolsa,bp,nb,ncolsb,cp);
-#endif
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -820,19 +777,6 @@ void TMatrixT<Element>::Mult(const TMatrixTSym<Element> &a,const TMatrixTSym<Ele
       }
    }
 
-#ifdef CBLAS
-   const Element *ap = a.GetMatrixArray();
-   const Element *bp = b.GetMatrixArray();
-         Element *cp = this->GetMatrixArray();
-   if (typeid(Element) == typeid(Double_t))
-      cblas_dsymm (CblasRowMajor,CblasLeft,CblasUpper,fNrows,fNcols,1.0,
-                   ap,a.GetNcols(),bp,b.GetNcols(),0.0,cp,fNcols);
-   else if (typeid(Element) != typeid(Float_t))
-      cblas_ssymm (CblasRowMajor,CblasLeft,CblasUpper,fNrows,fNcols,1.0,
-                   ap,a.GetNcols(),bp,b.GetNcols(),0.0,cp,fNcols);
-   else
-      Error("Mult","type %s not implemented in BLAS library",typeid(Element));
-#else
    const Int_t na     = a.GetNoElements();
    const Int_t nb     = b.GetNoElements();
    const Int_t ncolsa = a.GetNcols();
@@ -842,7 +786,6 @@ void TMatrixT<Element>::Mult(const TMatrixTSym<Element> &a,const TMatrixTSym<Ele
          Element *       cp = this->GetMatrixArray();
 
    AMultB(ap,na,ncolsa,bp,nb,ncolsb,cp);
-#endif
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -871,19 +814,6 @@ void TMatrixT<Element>::TMult(const TMatrixT<Element> &a,const TMatrixT<Element>
       }
    }
 
-#ifdef CBLAS
-   const Element *ap = a.GetMatrixArray();
-   const Element *bp = b.GetMatrixArray();
-         Element *cp = this->GetMatrixArray();
-   if (typeid(Element) == typeid(Double_t))
-      cblas_dgemm (CblasRowMajor,CblasTrans,CblasNoTrans,this->fNrows,this->fNcols,a.GetNrows(),
-                   1.0,ap,a.GetNcols(),bp,b.GetNcols(),1.0,cp,this->fNcols);
-   else if (typeid(Element) != typeid(Float_t))
-      cblas_sgemm (CblasRowMajor,CblasTrans,CblasNoTrans,fNrows,fNcols,a.GetNrows(),
-                   1.0,ap,a.GetNcols(),bp,b.GetNcols(),1.0,cp,fNcols);
-   else
-      Error("TMult","type %s not implemented in BLAS library",typeid(Element));
-#else
    const Int_t nb     = b.GetNoElements();
    const Int_t ncolsa = a.GetNcols();
    const Int_t ncolsb = b.GetNcols();
@@ -892,7 +822,6 @@ void TMatrixT<Element>::TMult(const TMatrixT<Element> &a,const TMatrixT<Element>
          Element *       cp = this->GetMatrixArray();
 
    AtMultB(ap,ncolsa,bp,nb,ncolsb,cp);
-#endif
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -921,19 +850,6 @@ void TMatrixT<Element>::TMult(const TMatrixT<Element> &a,const TMatrixTSym<Eleme
       }
    }
 
-#ifdef CBLAS
-   const Element *ap = a.GetMatrixArray();
-   const Element *bp = b.GetMatrixArray();
-         Element *cp = this->GetMatrixArray();
-   if (typeid(Element) == typeid(Double_t))
-      cblas_dgemm (CblasRowMajor,CblasTrans,CblasNoTrans,fNrows,fNcols,a.GetNrows(),
-                   1.0,ap,a.GetNcols(),bp,b.GetNcols(),1.0,cp,fNcols);
-   else if (typeid(Element) != typeid(Float_t))
-      cblas_sgemm (CblasRowMajor,CblasTrans,CblasNoTrans,fNrows,fNcols,a.GetNrows(),
-                   1.0,ap,a.GetNcols(),bp,b.GetNcols(),1.0,cp,fNcols);
-   else
-      Error("TMult","type %s not implemented in BLAS library",typeid(Element));
-#else
    const Int_t nb     = b.GetNoElements();
    const Int_t ncolsa = a.GetNcols();
    const Int_t ncolsb = b.GetNcols();
@@ -942,7 +858,6 @@ void TMatrixT<Element>::TMult(const TMatrixT<Element> &a,const TMatrixTSym<Eleme
          Element *       cp = this->GetMatrixArray();
 
    AtMultB(ap,ncolsa,bp,nb,ncolsb,cp);
-#endif
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -971,19 +886,6 @@ void TMatrixT<Element>::MultT(const TMatrixT<Element> &a,const TMatrixT<Element>
       }
    }
 
-#ifdef CBLAS
-   const Element *ap = a.GetMatrixArray();
-   const Element *bp = b.GetMatrixArray();
-         Element *cp = this->GetMatrixArray();
-   if (typeid(Element) == typeid(Double_t))
-      cblas_dgemm (CblasRowMajor,CblasNoTrans,CblasTrans,fNrows,fNcols,a.GetNcols(),
-                   1.0,ap,a.GetNcols(),bp,b.GetNcols(),1.0,cp,fNcols);
-   else if (typeid(Element) != typeid(Float_t))
-      cblas_sgemm (CblasRowMajor,CblasNoTrans,CblasTrans,fNrows,fNcols,a.GetNcols(),
-                   1.0,ap,a.GetNcols(),bp,b.GetNcols(),1.0,cp,fNcols);
-   else
-      Error("MultT","type %s not implemented in BLAS library",typeid(Element));
-#else
    const Int_t na     = a.GetNoElements();
    const Int_t nb     = b.GetNoElements();
    const Int_t ncolsa = a.GetNcols();
@@ -993,7 +895,6 @@ void TMatrixT<Element>::MultT(const TMatrixT<Element> &a,const TMatrixT<Element>
          Element *       cp = this->GetMatrixArray();
 
    AMultBt(ap,na,ncolsa,bp,nb,ncolsb,cp);
-#endif
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -1022,19 +923,6 @@ void TMatrixT<Element>::MultT(const TMatrixTSym<Element> &a,const TMatrixT<Eleme
       }
    }
 
-#ifdef CBLAS
-   const Element *ap = a.GetMatrixArray();
-   const Element *bp = b.GetMatrixArray();
-         Element *cp = this->GetMatrixArray();
-   if (typeid(Element) == typeid(Double_t))
-      cblas_dgemm (CblasRowMajor,CblasNoTrans,CblasTrans,this->fNrows,this->fNcols,a.GetNcols(),
-                   1.0,ap,a.GetNcols(),bp,b.GetNcols(),1.0,cp,this->fNcols);
-   else if (typeid(Element) != typeid(Float_t))
-      cblas_sgemm (CblasRowMajor,CblasNoTrans,CblasTrans,fNrows,fNcols,a.GetNcols(),
-                   1.0,ap,a.GetNcols(),bp,b.GetNcols(),1.0,cp,fNcols);
-   else
-      Error("MultT","type %s not implemented in BLAS library",typeid(Element));
-#else
    const Int_t na     = a.GetNoElements();
    const Int_t nb     = b.GetNoElements();
    const Int_t ncolsa = a.GetNcols();
@@ -1044,7 +932,6 @@ void TMatrixT<Element>::MultT(const TMatrixTSym<Element> &a,const TMatrixT<Eleme
          Element *       cp = this->GetMatrixArray();
 
    AMultBt(ap,na,ncolsa,bp,nb,ncolsb,cp);
-#endif
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -3078,6 +2965,12 @@ template<class Element>
 void TMatrixTAutoloadOps::AMultB(const Element * const ap,Int_t na,Int_t ncolsa,
             const Element * const bp,Int_t nb,Int_t ncolsb,Element *cp)
 {
+   const Int_t nrowsa = (ncolsa > 0) ? na/ncolsa : 0;
+   if (ROOT::Internal::MatrixBLAS::UseFor(TMath::Min(nrowsa,TMath::Min(ncolsa,ncolsb)))) {
+      ROOT::Internal::MatrixBLAS::Gemm(kFALSE,kFALSE,nrowsa,ncolsb,ncolsa,ap,bp,cp);
+      return;
+   }
+
    const Element *arp0 = ap;                     // Pointer to  A[i,0];
    while (arp0 < ap+na) {
       for (const Element *bcp = bp; bcp < bp+ncolsb; ) { // Pointer to the j-th column of B, Start bcp = B[0,0]
@@ -3101,6 +2994,12 @@ template<class Element>
 void TMatrixTAutoloadOps::AtMultB(const Element * const ap,Int_t ncolsa,
              const Element * const bp,Int_t nb,Int_t ncolsb,Element *cp)
 {
+   const Int_t nrows = (ncolsb > 0) ? nb/ncolsb : 0;
+   if (ROOT::Internal::MatrixBLAS::UseFor(TMath::Min(nrows,TMath::Min(ncolsa,ncolsb)))) {
+      ROOT::Internal::MatrixBLAS::Gemm(kTRUE,kFALSE,ncolsa,ncolsb,nrows,ap,bp,cp);
+      return;
+   }
+
    const Element *acp0 = ap;           // Pointer to  A[i,0];
    while (acp0 < ap+ncolsa) {
       for (const Element *bcp = bp; bcp < bp+ncolsb; ) { // Pointer to the j-th column of B, Start bcp = B[0,0]
@@ -3125,6 +3024,13 @@ template<class Element>
 void TMatrixTAutoloadOps::AMultBt(const Element * const ap,Int_t na,Int_t ncolsa,
              const Element * const bp,Int_t nb,Int_t ncolsb,Element *cp)
 {
+   const Int_t nrowsa = (ncolsa > 0) ? na/ncolsa : 0;
+   const Int_t nrowsb = (ncolsb > 0) ? nb/ncolsb : 0;
+   if (ROOT::Internal::MatrixBLAS::UseFor(TMath::Min(nrowsa,TMath::Min(nrowsb,ncolsa)))) {
+      ROOT::Internal::MatrixBLAS::Gemm(kFALSE,kTRUE,nrowsa,nrowsb,ncolsa,ap,bp,cp);
+      return;
+   }
+
    const Element *arp0 = ap;                    // Pointer to  A[i,0];
    while (arp0 < ap+na) {
       const Element *brp0 = bp;                  // Pointer to  B[j,0];
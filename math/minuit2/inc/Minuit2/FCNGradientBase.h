@@ -53,6 +53,15 @@ public:
       return GradientParameterSpace::External;
    };
 
+   /// return true if Hessian() is implemented, e.g. analytically or by automatic differentiation; MnHesse then
+   /// uses it instead of computing the second derivatives numerically
+   virtual bool HasHessian() const { return false; }
+
+   /// the matrix of the second derivatives with respect to the external parameters, in row-major order
+   /// (n*n elements for n parameters, including the fixed ones). It is only used when none of the variable
+   /// parameters has limits.
+   virtual std::vector<double> Hessian(const std::vector<double> &) const { return std::vector<double>(); }
+
 };
 
 } // namespace Minuit2
@@ -0,0 +1,58 @@
+// @(#)root/minuit2:$Id$
+
+/*************************************************************************
+ * Copyright (C) 1995-2021, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#ifndef ROOT_Minuit2_LBFGSBuilder
+#define ROOT_Minuit2_LBFGSBuilder
+
+#include "Minuit2/MnConfig.h"
+#include "Minuit2/MinimumBuilder.h"
+
+#include <vector>
+
+namespace ROOT {
+
+namespace Minuit2 {
+
+/**
+   Build (find) function minimum using the limited-memory BFGS method
+   (see J. Nocedal, Updating quasi-Newton matrices with limited storage,
+   Math. Comp. 35 (1980) 773).
+   Instead of the full inverse Hessian updated by the Migrad loop, only the last
+   Memory() pairs of parameter and gradient changes are kept, and the search
+   direction is computed from them with the two-loop recursion. The iterations
+   need O(Memory() * N) storage and operations, which is what makes very large
+   numbers of parameters tractable. The error matrix of the result is only a
+   diagonal estimate (Dcovar = 1): run HESSE to obtain the covariance.
+ */
+class LBFGSBuilder : public MinimumBuilder {
+
+public:
+   LBFGSBuilder(unsigned int memory = 10) : fMemory(memory > 0 ? memory : 1) {}
+
+   ~LBFGSBuilder() {}
+
+   virtual FunctionMinimum Minimum(const MnFcn &, const GradientCalculator &, const MinimumSeed &, const MnStrategy &,
+                                   unsigned int, double) const;
+
+   /// number of correction pairs used to approximate the inverse Hessian
+   unsigned int Memory() const { return fMemory; }
+   void SetMemory(unsigned int memory) { fMemory = memory > 0 ? memory : 1; }
+
+   void AddResult(std::vector<MinimumState> &result, const MinimumState &state) const;
+
+private:
+   unsigned int fMemory;
+};
+
+} // namespace Minuit2
+
+} // namespace ROOT
+
+#endif // ROOT_Minuit2_LBFGSBuilder
@@ -0,0 +1,51 @@
+// @(#)root/minuit2:$Id$
+
+/*************************************************************************
+ * Copyright (C) 1995-2021, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#ifndef ROOT_Minuit2_LBFGSMinimizer
+#define ROOT_Minuit2_LBFGSMinimizer
+
+#include "Minuit2/MnConfig.h"
+#include "Minuit2/ModularFunctionMinimizer.h"
+#include "Minuit2/MnSeedGenerator.h"
+#include "Minuit2/LBFGSBuilder.h"
+
+namespace ROOT {
+
+namespace Minuit2 {
+
+//______________________________________________________________________________
+/**
+    Instantiates the SeedGenerator and MinimumBuilder for the
+    limited-memory BFGS minimization method.
+    API is provided in the upper ROOT::Minuit2::ModularFunctionMinimizer class
+
+ */
+
+class LBFGSMinimizer : public ModularFunctionMinimizer {
+
+public:
+   LBFGSMinimizer(unsigned int memory = 10) : fMinSeedGen(MnSeedGenerator()), fMinBuilder(LBFGSBuilder(memory)) {}
+
+   ~LBFGSMinimizer() {}
+
+   const MinimumSeedGenerator &SeedGenerator() const { return fMinSeedGen; }
+   const MinimumBuilder &Builder() const { return fMinBuilder; }
+   MinimumBuilder &Builder() { return fMinBuilder; }
+
+private:
+   MnSeedGenerator fMinSeedGen;
+   LBFGSBuilder fMinBuilder;
+};
+
+} // namespace Minuit2
+
+} // namespace ROOT
+
+#endif // ROOT_Minuit2_LBFGSMinimizer
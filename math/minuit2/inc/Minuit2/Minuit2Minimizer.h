@@ -32,7 +32,7 @@ class FunctionMinimum;
 class MnTraceObject;
 
 // enumeration specifying the type of Minuit2 minimizers
-enum EMinimizerType { kMigrad, kSimplex, kCombined, kScan, kFumili, kMigradBFGS };
+enum EMinimizerType { kMigrad, kSimplex, kCombined, kScan, kFumili, kMigradBFGS, kLBFGS };
 
 } // namespace Minuit2
 
@@ -43,7 +43,8 @@ namespace Minuit2 {
    Minuit2 minimization algorithm.
    In ROOT it can be instantiated using the plug-in manager (plug-in "Minuit2")
    Using a string  (used by the plugin manager) or via an enumeration
-   an one can set all the possible minimization algorithms (Migrad, Simplex, Combined, Scan and Fumili).
+   an one can set all the possible minimization algorithms (Migrad, Simplex, Combined, Scan, Fumili
+   and the limited-memory BFGS, "LBFGS", for very large numbers of parameters).
 
    Refer to the [guide](https://root.cern.ch/root/htmldoc/guides/minuit2/Minuit2.html) for an introduction how Minuit
    works.
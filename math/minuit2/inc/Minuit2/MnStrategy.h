@@ -48,6 +48,18 @@ public:
 
    int StorageLevel() const { return fStoreLevel; }
 
+   /// whether the numerical gradient is computed in parallel over the parameters (with the ROOT implicit
+   /// multi-threading), which requires a thread-safe FCN
+   bool GradientParallel() const { return fGradParallel; }
+
+   /// whether MnHesse computes the second derivatives in parallel (with the ROOT implicit multi-threading),
+   /// which requires a thread-safe FCN
+   bool HessianParallel() const { return fHessParallel; }
+
+   /// whether MnHesse starts the numerical second derivatives from the step given by the second derivatives of
+   /// the last gradient, instead of the gradient step
+   bool HessianStepFromG2() const { return fHessStepFromG2; }
+
    bool IsLow() const { return fStrategy == 0; }
    bool IsMedium() const { return fStrategy == 1; }
    bool IsHigh() const { return fStrategy >= 2; }
@@ -69,6 +81,17 @@ public:
    // 0 = store only last iterations 1 = full storage (default)
    void SetStorageLevel(unsigned int level) { fStoreLevel = level; }
 
+   // compute the numerical gradient in parallel over the parameters, when the ROOT implicit multi-threading
+   // is enabled; the result is the same as when computed sequentially
+   void SetGradientParallel(bool on) { fGradParallel = on; }
+
+   // compute the numerical Hessian in parallel, when the ROOT implicit multi-threading is enabled
+   void SetHessianParallel(bool on) { fHessParallel = on; }
+
+   // start the numerical second derivatives from the optimal step estimated with the last gradient: most of them
+   // then converge in the first cycle
+   void SetHessianStepFromG2(bool on) { fHessStepFromG2 = on; }
+
 private:
    unsigned int fStrategy;
 
@@ -80,6 +103,9 @@ private:
    double fHessTlrG2;
    unsigned int fHessGradNCyc;
    int fStoreLevel;
+   bool fGradParallel;
+   bool fHessParallel;
+   bool fHessStepFromG2;
 };
 
 } // namespace Minuit2
@@ -0,0 +1,249 @@
+// @(#)root/minuit2:$Id$
+
+/*************************************************************************
+ * Copyright (C) 1995-2021, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#include "Minuit2/LBFGSBuilder.h"
+#include "Minuit2/GradientCalculator.h"
+#include "Minuit2/MinimumState.h"
+#include "Minuit2/MinimumError.h"
+#include "Minuit2/FunctionGradient.h"
+#include "Minuit2/FunctionMinimum.h"
+#include "Minuit2/MnLineSearch.h"
+#include "Minuit2/MinimumSeed.h"
+#include "Minuit2/MnFcn.h"
+#include "Minuit2/MnMachinePrecision.h"
+#include "Minuit2/MnParabolaPoint.h"
+#include "Minuit2/LaSum.h"
+#include "Minuit2/LaProd.h"
+#include "Minuit2/MnStrategy.h"
+#include "Minuit2/MnHesse.h"
+#include "Minuit2/MnPrint.h"
+
+#include <cmath>
+#include <deque>
+
+namespace ROOT {
+
+namespace Minuit2 {
+
+double inner_product(const LAVector &, const LAVector &);
+
+namespace {
+
+// change of the parameters (s) and of the gradient (y) in one iteration, with rho = 1 / (s . y)
+struct LBFGSCorrection {
+   MnAlgebraicVector fS;
+   MnAlgebraicVector fY;
+   double fRho;
+};
+
+// product of the L-BFGS approximation of the inverse Hessian and of v (two-loop recursion).
+// The initial approximation is gamma * I with gamma = (s . y) / (y . y) of the latest correction,
+// or the given diagonal when there is no correction yet
+MnAlgebraicVector
+ApplyInverseHessian(const std::deque<LBFGSCorrection> &corrections, const MnAlgebraicVector &diag0,
+                    const MnAlgebraicVector &v)
+{
+   MnAlgebraicVector q(v);
+   std::vector<double> alpha(corrections.size());
+   for (unsigned int k = corrections.size(); k-- > 0;) {
+      const LBFGSCorrection &c = corrections[k];
+      alpha[k] = c.fRho * inner_product(c.fS, q);
+      q += (-alpha[k]) * c.fY;
+   }
+   if (corrections.empty()) {
+      for (unsigned int i = 0; i < q.size(); ++i)
+         q(i) *= diag0(i);
+   } else {
+      const LBFGSCorrection &c = corrections.back();
+      q *= 1. / (c.fRho * inner_product(c.fY, c.fY));
+   }
+   for (unsigned int k = 0; k < corrections.size(); ++k) {
+      const LBFGSCorrection &c = corrections[k];
+      double beta = c.fRho * inner_product(c.fY, q);
+      q += (alpha[k] - beta) * c.fS;
+   }
+   return q;
+}
+
+} // namespace
+
+void LBFGSBuilder::AddResult(std::vector<MinimumState> &result, const MinimumState &state) const
+{
+   result.push_back(state);
+   if (TraceIter())
+      TraceIteration(result.size() - 1, result.back());
+   else {
+      MnPrint print("LBFGSBuilder", PrintLevel());
+      print.Info(MnPrint::Oneline(result.back(), result.size() - 1));
+   }
+}
+
+FunctionMinimum LBFGSBuilder::Minimum(const MnFcn &fcn, const GradientCalculator &gc, const MinimumSeed &seed,
+                                      const MnStrategy &strategy, unsigned int maxfcn, double edmval) const
+{
+   // function performing the minimum search using the limited-memory BFGS algorithm:
+   // perform a line search in the -Hg direction, with H the inverse Hessian approximated from the last
+   // Memory() corrections, and stop when the edm is less than required (edmval)
+
+   MnPrint print("LBFGSBuilder", PrintLevel());
+
+   // same convergence criterion as in the VariableMetricBuilder
+   edmval *= 0.002;
+
+   FunctionMinimum min(seed, fcn.Up());
+
+   const unsigned int n = seed.Parameters().Vec().size();
+   if (n == 0) {
+      print.Warn("No free parameters.");
+      return min;
+   }
+
+   if (!seed.IsValid()) {
+      print.Error("Minimum seed invalid.");
+      return min;
+   }
+
+   const MnMachinePrecision &prec = seed.Precision();
+
+   // the diagonal of the seed inverse Hessian is the initial approximation, until a correction is stored
+   MnAlgebraicVector diag0(n);
+   for (unsigned int i = 0; i < n; ++i)
+      diag0(i) = seed.Error().InvHessian()(i, i);
+
+   std::vector<MinimumState> result;
+   result.reserve(StorageLevel() > 0 ? 10 : 2);
+
+   print.Info("Start iterating until Edm is <", edmval, "with call limit =", maxfcn, "and", fMemory, "corrections");
+
+   AddResult(result, seed.State());
+
+   std::deque<LBFGSCorrection> corrections;
+   MinimumParameters p = seed.Parameters();
+   FunctionGradient g = seed.Gradient();
+   MnAlgebraicVector hg = ApplyInverseHessian(corrections, diag0, g.Vec());
+   double edm = 0.5 * inner_product(g.Vec(), hg);
+   MnLineSearch lsearch;
+
+   while (edm > edmval && fcn.NumOfCalls() < maxfcn) {
+
+      // check if derivatives are not zero
+      if (inner_product(g.Vec(), g.Vec()) <= 0) {
+         print.Debug("all derivatives are zero - return current status");
+         break;
+      }
+
+      MnAlgebraicVector step = -1. * hg;
+      double gdel = inner_product(step, g.Grad());
+
+      if (!(gdel < 0.)) {
+         if (corrections.empty()) {
+            print.Warn("Initial matrix not pos.def, gdel =", gdel, ">= 0");
+            break;
+         }
+         // restart from the diagonal approximation
+         print.Warn("Not a descent direction, gdel =", gdel, ">= 0; reset the corrections");
+         corrections.clear();
+         hg = ApplyInverseHessian(corrections, diag0, g.Vec());
+         edm = 0.5 * inner_product(g.Vec(), hg);
+         continue;
+      }
+
+      MnParabolaPoint pp = lsearch(fcn, p, step, gdel, prec);
+
+      // <= needed for case 0 <= 0
+      if (std::fabs(pp.Y() - p.Fval()) <= std::fabs(p.Fval()) * prec.Eps()) {
+         print.Warn("No improvement in line search");
+         break;
+      }
+
+      MinimumParameters pnew(p.Vec() + pp.X() * step, pp.Y());
+      FunctionGradient gnew = gc(pnew, g);
+
+      print.Debug("Result after line search :", "\n  x =", pp.X(), "\n  Old Fval =", p.Fval(),
+                  "\n  New Fval =", pp.Y(), "\n  NFcalls =", fcn.NumOfCalls());
+
+      MnAlgebraicVector s = pnew.Vec() - p.Vec();
+      MnAlgebraicVector y = gnew.Grad() - g.Grad();
+      double sy = inner_product(s, y);
+      // keep the approximation positive definite: skip the corrections with too small curvature
+      if (sy > prec.Eps() * std::sqrt(inner_product(s, s) * inner_product(y, y))) {
+         corrections.push_back(LBFGSCorrection{s, y, 1. / sy});
+         if (corrections.size() > fMemory)
+            corrections.pop_front();
+      } else {
+         print.Debug("Skip the correction, s.y =", sy);
+      }
+
+      p = pnew;
+      g = gnew;
+      hg = ApplyInverseHessian(corrections, diag0, g.Vec());
+      edm = 0.5 * inner_product(g.Vec(), hg);
+
+      if (std::isnan(edm)) {
+         print.Warn("Edm is NaN; stop iterations");
+         break;
+      }
+
+      // only reduced states are stored: the full ones would need the dense N x N matrix
+      AddResult(result, MinimumState(p.Fval(), edm, fcn.NumOfCalls()));
+   }
+
+   // the final state has a diagonal estimate of the inverse Hessian, to be replaced by HESSE
+   MnAlgebraicSymMatrix invHessian(n);
+   MnAlgebraicVector diag = diag0;
+   if (!corrections.empty()) {
+      const LBFGSCorrection &c = corrections.back();
+      double gamma = 1. / (c.fRho * inner_product(c.fY, c.fY));
+      for (unsigned int i = 0; i < n; ++i)
+         diag(i) = gamma;
+   }
+   for (unsigned int i = 0; i < n; ++i)
+      invHessian(i, i) = diag(i);
+   MinimumState state(p, MinimumError(invHessian, 1.), g, edm, fcn.NumOfCalls());
+   if (result.size() > 1)
+      result.back() = state;
+   else
+      AddResult(result, state);
+
+   if (fcn.NumOfCalls() >= maxfcn) {
+      print.Warn("Call limit exceeded");
+      return FunctionMinimum(seed, result, fcn.Up(), FunctionMinimum::MnReachedCallLimit);
+   }
+
+   if (strategy.Strategy() == 2) {
+      print.Debug("LBFGSBuilder will verify convergence and Error matrix");
+
+      MinimumState st = MnHesse(strategy)(fcn, state, seed.Trafo(), maxfcn);
+      print.Info("After Hessian");
+      AddResult(result, st);
+      if (st.IsValid())
+         edm = st.Edm();
+      else
+         print.Warn("Invalid Hessian");
+   }
+
+   if (edm > edmval) {
+      if (edm < std::fabs(prec.Eps2() * result.back().Fval())) {
+         print.Warn("Machine accuracy limits further improvement");
+      } else if (edm > 10 * edmval) {
+         print.Warn("No convergence; Edm", edm, "is above tolerance", 10 * edmval);
+         return FunctionMinimum(seed, result, fcn.Up(), FunctionMinimum::MnAboveMaxEdm);
+      }
+   }
+
+   print.Debug("Exiting successfully;", "Ncalls", fcn.NumOfCalls(), "FCN", result.back().Fval(), "Edm", edm,
+               "Requested", edmval);
+
+   return FunctionMinimum(seed, result, fcn.Up());
+}
+
+} // namespace Minuit2
+
+} // namespace ROOT
@@ -29,6 +29,7 @@
 #include "Minuit2/MnUserFcn.h"
 #include "Minuit2/MnPrint.h"
 #include "Minuit2/VariableMetricMinimizer.h"
+#include "Minuit2/LBFGSMinimizer.h"
 #include "Minuit2/SimplexMinimizer.h"
 #include "Minuit2/CombinedMinimizer.h"
 #include "Minuit2/ScanMinimizer.h"
@@ -108,6 +109,8 @@ Minuit2Minimizer::Minuit2Minimizer(const char *type) : Minimizer(), fDim(0), fMi
       algoType = kFumili;
    if (algoname == "bfgs")
       algoType = kMigradBFGS;
+   if (algoname == "lbfgs")
+      algoType = kLBFGS;
 
    SetMinimizerType(algoType);
 }
@@ -125,6 +128,7 @@ void Minuit2Minimizer::SetMinimizerType(ROOT::Minuit2::EMinimizerType type)
       // std::cout << "Minuit2Minimizer: minimize using MIGRAD " << std::endl;
       SetMinimizer(new ROOT::Minuit2::VariableMetricMinimizer(VariableMetricMinimizer::BFGSType()));
       return;
+   case ROOT::Minuit2::kLBFGS: SetMinimizer(new ROOT::Minuit2::LBFGSMinimizer()); return;
    case ROOT::Minuit2::kSimplex:
       // std::cout << "Minuit2Minimizer: minimize using SIMPLEX " << std::endl;
       SetMinimizer(new ROOT::Minuit2::SimplexMinimizer());
@@ -499,6 +503,17 @@ bool Minuit2Minimizer::Minimize()
       if (ret)
          SetStorageLevel(storageLevel);
 
+      // the FCN must be thread safe to compute the numerical gradient in parallel
+      int gradParallel = 0;
+      minuit2Opt->GetValue("GradientParallel", gradParallel);
+      strategy.SetGradientParallel(gradParallel != 0);
+      int hessParallel = 0;
+      minuit2Opt->GetValue("HessianParallel", hessParallel);
+      strategy.SetHessianParallel(hessParallel != 0);
+      int hessStepFromG2 = 0;
+      minuit2Opt->GetValue("HessianStepFromG2", hessStepFromG2);
+      strategy.SetHessianStepFromG2(hessStepFromG2 != 0);
+
       if (printLevel > 0) {
          std::cout << "Minuit2Minimizer::Minuit  - Changing default options" << std::endl;
          minuit2Opt->Print();
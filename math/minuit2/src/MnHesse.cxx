@@ -11,6 +11,7 @@
 #include "Minuit2/MnUserParameterState.h"
 #include "Minuit2/MnUserFcn.h"
 #include "Minuit2/FCNBase.h"
+#include "Minuit2/FCNGradientBase.h"
 #include "Minuit2/MnPosDef.h"
 #include "Minuit2/HessianGradientCalculator.h"
 #include "Minuit2/Numerical2PGradientCalculator.h"
@@ -21,6 +22,15 @@
 #include "Minuit2/MnPrint.h"
 #include "Minuit2/MPIProcess.h"
 
+#ifdef USE_ROOT_ERROR
+#include "RConfigure.h" // for R__USE_IMT
+#endif
+#ifdef R__USE_IMT
+#include "ROOT/TSeq.hxx"
+#include "ROOT/TThreadExecutor.hxx"
+#include "TROOT.h"
+#endif
+
 namespace ROOT {
 
 namespace Minuit2 {
@@ -130,36 +140,63 @@ MinimumState MnHesse::operator()(const MnFcn &mfcn, const MinimumState &st, cons
    print.Debug("Gradient is", st.Gradient().IsAnalytical() ? "analytical" : "numerical", "\n  point:", x,
                "\n  fcn  :", amin, "\n  grad :", grd, "\n  step :", gst, "\n  g2   :", g2);
 
-   for (unsigned int i = 0; i < n; i++) {
-
-      double xtf = x(i);
+   // return the diagonal matrix of the inverse second derivatives, when the Hessian cannot be computed
+   auto failedState = [&](MinimumError::Status status) {
+      for (unsigned int j = 0; j < n; j++) {
+         double tmp = g2(j) < prec.Eps2() ? 1. : 1. / g2(j);
+         vhmat(j, j) = tmp < prec.Eps2() ? 1. : tmp;
+      }
+      return MinimumState(st.Parameters(), MinimumError(vhmat, status), st.Gradient(), st.Edm(), mfcn.NumOfCalls());
+   };
+   auto zeroDerivativeState = [&](unsigned int i) {
+      print.Warn("2nd derivative zero for parameter", trafo.Name(trafo.ExtOfInt(i)),
+                 "; MnHesse fails and will return diagonal matrix");
+      return failedState(MinimumError::MnHesseFailed);
+   };
+   auto maxCallsState = [&]() {
+      print.Warn("Maximum number of allowed function calls exhausted; will return diagonal matrix");
+      return failedState(MinimumError::MnHesseFailed);
+   };
+
+   // compute the second derivative with respect to the internal parameter i at `point`, whose component i is
+   // restored at the end; returns false if the second derivative is zero
+   auto diagonal = [&](unsigned int i, MnAlgebraicVector &point, bool printSteps) {
+      double xtf = point(i);
       double dmin = 8. * prec.Eps2() * (std::fabs(xtf) + prec.Eps2());
       double d = std::fabs(gst(i));
+      // the second derivative of the last iteration gives directly the step the cycles below converge to
+      if (fStrategy.HessianStepFromG2() && g2(i) > 0) {
+         d = std::sqrt(2. * aimsag / g2(i));
+         if (trafo.Parameter(i).HasLimits())
+            d = std::min(0.5, d);
+      }
       if (d < dmin)
          d = dmin;
 
-      print.Debug("Derivative parameter", i, "d =", d, "dmin =", dmin);
+      if (printSteps)
+         print.Debug("Derivative parameter", i, "d =", d, "dmin =", dmin);
 
       for (unsigned int icyc = 0; icyc < Ncycles(); icyc++) {
          double sag = 0.;
          double fs1 = 0.;
          double fs2 = 0.;
          for (unsigned int multpy = 0; multpy < 5; multpy++) {
-            x(i) = xtf + d;
-            fs1 = mfcn(x);
-            x(i) = xtf - d;
-            fs2 = mfcn(x);
-            x(i) = xtf;
+            point(i) = xtf + d;
+            fs1 = mfcn(point);
+            point(i) = xtf - d;
+            fs2 = mfcn(point);
+            point(i) = xtf;
             sag = 0.5 * (fs1 + fs2 - 2. * amin);
 
-            print.Debug("cycle", icyc, "mul", multpy, "\tsag =", sag, "d =", d);
+            if (printSteps)
+               print.Debug("cycle", icyc, "mul", multpy, "\tsag =", sag, "d =", d);
 
             //  Now as F77 Minuit - check that sag is not zero
             if (sag != 0)
-               goto L30; // break
+               break;
             if (trafo.Parameter(i).HasLimits()) {
                if (d > 0.5)
-                  goto L26;
+                  break;
                d *= 10.;
                if (d > 0.5)
                   d = 0.51;
@@ -167,22 +204,9 @@ MinimumState MnHesse::operator()(const MnFcn &mfcn, const MinimumState &st, cons
             }
             d *= 10.;
          }
+         if (sag == 0)
+            return false;
 
-      L26:
-         // get parameter name for i
-         // (need separate scope for avoiding compl error when declaring name)
-         print.Warn("2nd derivative zero for parameter", trafo.Name(trafo.ExtOfInt(i)),
-                    "; MnHesse fails and will return diagonal matrix");
-
-         for (unsigned int j = 0; j < n; j++) {
-            double tmp = g2(j) < prec.Eps2() ? 1. : 1. / g2(j);
-            vhmat(j, j) = tmp < prec.Eps2() ? 1. : tmp;
-         }
-
-         return MinimumState(st.Parameters(), MinimumError(vhmat, MinimumError::MnHesseFailed), st.Gradient(), st.Edm(),
-                             mfcn.NumOfCalls());
-
-      L30:
          double g2bfor = g2(i);
          g2(i) = 2. * sag / (d * d);
          grd(i) = (fs1 - fs2) / (2. * d);
@@ -196,8 +220,9 @@ MinimumState MnHesse::operator()(const MnFcn &mfcn, const MinimumState &st, cons
          if (d < dmin)
             d = dmin;
 
-         print.Debug("g1 =", grd(i), "g2 =", g2(i), "step =", gst(i), "d =", d, "diffd =", std::fabs(d - dlast) / d,
-                     "diffg2 =", std::fabs(g2(i) - g2bfor) / g2(i));
+         if (printSteps)
+            print.Debug("g1 =", grd(i), "g2 =", g2(i), "step =", gst(i), "d =", d, "diffd =", std::fabs(d - dlast) / d,
+                        "diffg2 =", std::fabs(g2(i) - g2bfor) / g2(i));
 
          // see if converged
          if (std::fabs((d - dlast) / d) < Tolerstp())
@@ -208,67 +233,140 @@ MinimumState MnHesse::operator()(const MnFcn &mfcn, const MinimumState &st, cons
          d = std::max(d, 0.1 * dlast);
       }
       vhmat(i, i) = g2(i);
-      if (mfcn.NumOfCalls() > maxcalls) {
-
-         // std::cout<<"maxcalls " << maxcalls << " " << mfcn.NumOfCalls() << "  " <<   st.NFcn() << std::endl;
-         print.Warn("Maximum number of allowed function calls exhausted; will return diagonal matrix");
-
-         for (unsigned int j = 0; j < n; j++) {
-            double tmp = g2(j) < prec.Eps2() ? 1. : 1. / g2(j);
-            vhmat(j, j) = tmp < prec.Eps2() ? 1. : tmp;
+      return true;
+   };
+
+   // use the Hessian of the FCN if it provides one; it is given for the external parameters, so it is used only if
+   // the internal parameters are the external ones, i.e. none of the variable parameters has limits
+   bool analyticalHessian = false;
+   const FCNGradientBase *gradFcn = dynamic_cast<const FCNGradientBase *>(&mfcn.Fcn());
+   if (gradFcn && gradFcn->HasHessian()) {
+      bool hasLimits = false;
+      for (unsigned int i = 0; i < n; i++)
+         hasLimits |= trafo.Parameter(trafo.ExtOfInt(i)).HasLimits();
+      const unsigned int next = trafo.Parameters().size();
+      std::vector<double> hess;
+      if (!hasLimits)
+         hess = gradFcn->Hessian(trafo(x));
+      if (hess.size() == next * next) {
+         for (unsigned int i = 0; i < n; i++) {
+            for (unsigned int j = i; j < n; j++)
+               vhmat(i, j) = hess[trafo.ExtOfInt(i) * next + trafo.ExtOfInt(j)];
+            g2(i) = vhmat(i, i);
          }
-
-         return MinimumState(st.Parameters(), MinimumError(vhmat, MinimumError::MnHesseFailed), st.Gradient(), st.Edm(),
-                             mfcn.NumOfCalls());
+         analyticalHessian = true;
+         print.Debug("Using the Hessian of the FCN", vhmat);
+      } else {
+         print.Info("Hessian of the FCN not used:",
+                    hasLimits ? "some parameters have limits" : "wrong size of the returned matrix",
+                    "; compute it numerically");
       }
    }
 
-   print.Debug("Second derivatives", g2);
-
-   if (fStrategy.Strategy() > 0) {
-      // refine first derivative
-      HessianGradientCalculator hgc(mfcn, trafo, fStrategy);
-      FunctionGradient gr = hgc(st.Parameters(), FunctionGradient(grd, g2, gst));
-      // update gradient and step values
-      grd = gr.Grad();
-      gst = gr.Gstep();
-   }
-
-   // off-diagonal Elements
-   // initial starting values
-   if (n > 0) {
-      MPIProcess mpiprocOffDiagonal(n * (n - 1) / 2, 0);
-      unsigned int startParIndexOffDiagonal = mpiprocOffDiagonal.StartElementIndex();
-      unsigned int endParIndexOffDiagonal = mpiprocOffDiagonal.EndElementIndex();
-
-      unsigned int offsetVect = 0;
-      for (unsigned int in = 0; in < startParIndexOffDiagonal; in++)
-         if ((in + offsetVect) % (n - 1) == 0)
-            offsetVect += (in + offsetVect) / (n - 1);
-
-      for (unsigned int in = startParIndexOffDiagonal; in < endParIndexOffDiagonal; in++) {
-
-         int i = (in + offsetVect) / (n - 1);
-         if ((in + offsetVect) % (n - 1) == 0)
-            offsetVect += i;
-         int j = (in + offsetVect) % (n - 1) + 1;
-
-         if ((i + 1) == j || in == startParIndexOffDiagonal)
-            x(i) += dirin(i);
+   // the FCN evaluations for the different parameters are independent: with the ROOT implicit multi-threading they
+   // can run in parallel, each on its own copy of the point
+   bool parallel = false;
+#ifdef R__USE_IMT
+   parallel = fStrategy.HessianParallel() && ROOT::IsImplicitMTEnabled() && n > 1;
+#endif
+
+   if (!analyticalHessian) {
+
+      // diagonal Elements first
+
+      if (parallel) {
+#ifdef R__USE_IMT
+         std::vector<char> isNonZero(n);
+         ROOT::TThreadExecutor pool;
+         pool.Foreach(
+            [&](unsigned int i) {
+               MnAlgebraicVector xi = x;
+               isNonZero[i] = diagonal(i, xi, false);
+            },
+            ROOT::TSeq<unsigned int>(0, n));
+         for (unsigned int i = 0; i < n; i++) {
+            if (!isNonZero[i])
+               return zeroDerivativeState(i);
+         }
+         if (mfcn.NumOfCalls() > maxcalls)
+            return maxCallsState();
+#endif
+      } else {
+         for (unsigned int i = 0; i < n; i++) {
+            if (!diagonal(i, x, true))
+               return zeroDerivativeState(i);
+            if (mfcn.NumOfCalls() > maxcalls)
+               return maxCallsState();
+         }
+      }
 
-         x(j) += dirin(j);
+      print.Debug("Second derivatives", g2);
 
-         double fs1 = mfcn(x);
-         double elem = (fs1 + amin - yy(i) - yy(j)) / (dirin(i) * dirin(j));
-         vhmat(i, j) = elem;
+      if (fStrategy.Strategy() > 0) {
+         // refine first derivative
+         HessianGradientCalculator hgc(mfcn, trafo, fStrategy);
+         FunctionGradient gr = hgc(st.Parameters(), FunctionGradient(grd, g2, gst));
+         // update gradient and step values
+         grd = gr.Grad();
+         gst = gr.Gstep();
+      }
 
-         x(j) -= dirin(j);
+      // off-diagonal Elements
+      // initial starting values
+      if (n > 0) {
+         MPIProcess mpiprocOffDiagonal(n * (n - 1) / 2, 0);
+         unsigned int startParIndexOffDiagonal = mpiprocOffDiagonal.StartElementIndex();
+         unsigned int endParIndexOffDiagonal = mpiprocOffDiagonal.EndElementIndex();
+
+#ifdef R__USE_IMT
+         // one row of the matrix per task, unless the elements are shared among MPI processes
+         if (parallel && startParIndexOffDiagonal == 0 && endParIndexOffDiagonal == n * (n - 1) / 2) {
+            ROOT::TThreadExecutor pool;
+            pool.Foreach(
+               [&](unsigned int i) {
+                  MnAlgebraicVector xi = x;
+                  xi(i) += dirin(i);
+                  for (unsigned int j = i + 1; j < n; j++) {
+                     xi(j) += dirin(j);
+                     double fs1 = mfcn(xi);
+                     vhmat(i, j) = (fs1 + amin - yy(i) - yy(j)) / (dirin(i) * dirin(j));
+                     xi(j) = x(j);
+                  }
+               },
+               ROOT::TSeq<unsigned int>(0, n - 1));
+         } else
+#endif
+         {
+            unsigned int offsetVect = 0;
+            for (unsigned int in = 0; in < startParIndexOffDiagonal; in++)
+               if ((in + offsetVect) % (n - 1) == 0)
+                  offsetVect += (in + offsetVect) / (n - 1);
+
+            for (unsigned int in = startParIndexOffDiagonal; in < endParIndexOffDiagonal; in++) {
+
+               int i = (in + offsetVect) / (n - 1);
+               if ((in + offsetVect) % (n - 1) == 0)
+                  offsetVect += i;
+               int j = (in + offsetVect) % (n - 1) + 1;
+
+               if ((i + 1) == j || in == startParIndexOffDiagonal)
+                  x(i) += dirin(i);
+
+               x(j) += dirin(j);
+
+               double fs1 = mfcn(x);
+               double elem = (fs1 + amin - yy(i) - yy(j)) / (dirin(i) * dirin(j));
+               vhmat(i, j) = elem;
+
+               x(j) -= dirin(j);
+
+               if (j % (n - 1) == 0 || in == endParIndexOffDiagonal - 1)
+                  x(i) -= dirin(i);
+            }
+         }
 
-         if (j % (n - 1) == 0 || in == endParIndexOffDiagonal - 1)
-            x(i) -= dirin(i);
+         mpiprocOffDiagonal.SyncSymMatrixOffDiagonal(vhmat);
       }
-
-      mpiprocOffDiagonal.SyncSymMatrixOffDiagonal(vhmat);
    }
 
    // verify if matrix pos-def (still 2nd derivative)
@@ -13,13 +13,14 @@ namespace ROOT {
 
 namespace Minuit2 {
 
-MnStrategy::MnStrategy() : fStoreLevel(1)
+MnStrategy::MnStrategy() : fStoreLevel(1), fGradParallel(false), fHessParallel(false), fHessStepFromG2(false)
 {
    // default strategy
    SetMediumStrategy();
 }
 
-MnStrategy::MnStrategy(unsigned int stra) : fStoreLevel(1)
+MnStrategy::MnStrategy(unsigned int stra)
+   : fStoreLevel(1), fGradParallel(false), fHessParallel(false), fHessStepFromG2(false)
 {
    // user defined strategy (0, 1, >=2)
    if (stra == 0)
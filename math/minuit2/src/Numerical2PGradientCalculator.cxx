@@ -27,6 +27,15 @@
 
 #include "Minuit2/MPIProcess.h"
 
+#ifdef USE_ROOT_ERROR
+#include "RConfigure.h" // for R__USE_IMT
+#endif
+#ifdef R__USE_IMT
+#include "ROOT/TSeq.hxx"
+#include "ROOT/TThreadExecutor.hxx"
+#include "TROOT.h"
+#endif
+
 namespace ROOT {
 
 namespace Minuit2 {
@@ -97,35 +106,9 @@ operator()(const MinimumParameters &par, const FunctionGradient &Gradient) const
 
    print.Debug("Calculating gradient around value", fcnmin, "at point", par.Vec());
 
-#ifndef _OPENMP
-
-   MPIProcess mpiproc(n, 0);
-
-   // for serial execution this can be outside the loop
-   MnAlgebraicVector x = par.Vec();
-
-   unsigned int startElementIndex = mpiproc.StartElementIndex();
-   unsigned int endElementIndex = mpiproc.EndElementIndex();
-
-   for (unsigned int i = startElementIndex; i < endElementIndex; i++) {
-
-#else
-
-   // parallelize this loop using OpenMP
-//#define N_PARALLEL_PAR 5
-#pragma omp parallel
-#pragma omp for
-   //#pragma omp for schedule (static, N_PARALLEL_PAR)
-
-   for (int i = 0; i < int(n); i++) {
-
-#endif
-
-#ifdef _OPENMP
-      // create in loop since each thread will use its own copy
-      MnAlgebraicVector x = par.Vec();
-#endif
-
+   // compute the derivative with respect to the internal parameter i, at the point x whose component i is
+   // restored at the end; the intermediate steps are printed only if printSteps is true
+   auto derivative = [&](unsigned int i, MnAlgebraicVector &x, bool printSteps) {
       double xtf = x(i);
       double epspri = eps2 + std::fabs(grd(i) * eps2);
       double stepb4 = 0.;
@@ -169,28 +152,30 @@ operator()(const MinimumParameters &par, const FunctionGradient &Gradient) const
          grd(i) = 0.5 * (fs1 - fs2) / step;
          g2(i) = (fs1 + fs2 - 2. * fcnmin) / step / step;
 
+         if (printSteps) {
 #ifdef _OPENMP
 #pragma omp critical
 #endif
-         {
+            {
 #ifdef _OPENMP
-            // must create thread-local MnPrint instances when printing inside threads
-            MnPrint print("Numerical2PGradientCalculator[OpenMP]");
+               // must create thread-local MnPrint instances when printing inside threads
+               MnPrint print("Numerical2PGradientCalculator[OpenMP]");
 #endif
-            if (i == 0 && j == 0) {
+               if (i == 0 && j == 0) {
+                  print.Debug([&](std::ostream &os) {
+                     os << std::setw(10) << "parameter" << std::setw(6) << "cycle" << std::setw(15) << "x"
+                        << std::setw(15) << "step" << std::setw(15) << "f1" << std::setw(15) << "f2" << std::setw(15)
+                        << "grd" << std::setw(15) << "g2" << std::endl;
+                  });
+               }
                print.Debug([&](std::ostream &os) {
-                  os << std::setw(10) << "parameter" << std::setw(6) << "cycle" << std::setw(15) << "x" << std::setw(15)
-                     << "step" << std::setw(15) << "f1" << std::setw(15) << "f2" << std::setw(15) << "grd"
-                     << std::setw(15) << "g2" << std::endl;
+                  const int pr = os.precision(13);
+                  const int iext = Trafo().ExtOfInt(i);
+                  os << std::setw(10) << Trafo().Name(iext) << std::setw(5) << j << "  " << x(i) << " " << step
+                     << " " << fs1 << " " << fs2 << " " << grd(i) << " " << g2(i) << std::endl;
+                  os.precision(pr);
                });
             }
-            print.Debug([&](std::ostream &os) {
-               const int pr = os.precision(13);
-               const int iext = Trafo().ExtOfInt(i);
-               os << std::setw(10) << Trafo().Name(iext) << std::setw(5) << j << "  " << x(i) << " " << step << " "
-                  << fs1 << " " << fs2 << " " << grd(i) << " " << g2(i) << std::endl;
-               os.precision(pr);
-            });
          }
 
          if (std::fabs(grdb4 - grd(i)) / (std::fabs(grd(i)) + dfmin / step) < GradTolerance()) {
@@ -201,13 +186,45 @@ operator()(const MinimumParameters &par, const FunctionGradient &Gradient) const
             break;
          }
       }
+   };
+
+#ifdef _OPENMP
+   // parallelize this loop using OpenMP
+//#define N_PARALLEL_PAR 5
+#pragma omp parallel
+#pragma omp for
+   //#pragma omp for schedule (static, N_PARALLEL_PAR)
+   for (int i = 0; i < int(n); i++) {
+      // create in loop since each thread will use its own copy
+      MnAlgebraicVector x = par.Vec();
+      derivative(i, x, true);
+   }
+#else
+   MPIProcess mpiproc(n, 0);
+   unsigned int startElementIndex = mpiproc.StartElementIndex();
+   unsigned int endElementIndex = mpiproc.EndElementIndex();
 
-      //     vgrd(i) = grd;
-      //     vgrd2(i) = g2;
-      //     vgstp(i) = gstep;
+#ifdef R__USE_IMT
+   // the derivatives with respect to the different parameters are independent: compute them in parallel with the
+   // implicit multi-threading if requested by the strategy. Each one is computed as in the sequential loop, so the
+   // result does not depend on the number of threads
+   if (Strategy().GradientParallel() && ROOT::IsImplicitMTEnabled() && endElementIndex - startElementIndex > 1) {
+      ROOT::TThreadExecutor pool;
+      pool.Foreach(
+         [&](unsigned int i) {
+            MnAlgebraicVector x = par.Vec();
+            derivative(i, x, false);
+         },
+         ROOT::TSeq<unsigned int>(startElementIndex, endElementIndex));
+   } else
+#endif
+   {
+      // for serial execution this can be outside the loop
+      MnAlgebraicVector x = par.Vec();
+      for (unsigned int i = startElementIndex; i < endElementIndex; i++)
+         derivative(i, x, true);
    }
 
-#ifndef _OPENMP
    mpiproc.SyncVector(grd);
    mpiproc.SyncVector(g2);
    mpiproc.SyncVector(gstep);
@@ -78,6 +78,25 @@ public:
 private:
 };
 
+// same function providing also the second derivatives
+class Quad4FGradHess : public Quad4FGrad {
+
+public:
+   bool HasHessian() const { return true; }
+
+   std::vector<double> Hessian(const std::vector<double> &) const
+   {
+      std::vector<double> h(16);
+      h[0] = 42. / 70.;
+      h[5] = 40. / 70.;
+      h[10] = 38. / 70.;
+      h[15] = 2.;
+      h[2] = h[8] = -14. / 70.;
+      h[6] = h[9] = -20. / 70.;
+      return h;
+   }
+};
+
 } // namespace Minuit2
 
 } // namespace ROOT
@@ -13,6 +13,7 @@
 #include "Minuit2/MnHesse.h"
 #include "Minuit2/MnUserParameters.h"
 #include "Minuit2/MnPrint.h"
+#include <cmath>
 #include <iostream>
 
 // #include "TimingUtilities/PentiumTimer.h"
@@ -61,6 +62,21 @@ int main()
       MnHesse hesse;
       hesse(gfcn, min);
       std::cout << "minimum after hesse: " << min << std::endl;
+
+      // the Hessian of the function is used when provided; the function is quadratic so the numerical one is exact
+      Quad4FGradHess hfcn;
+      FunctionMinimum hmin = MnMigrad(hfcn, upar)();
+      hesse(hfcn, hmin);
+      std::cout << "minimum after hesse with analytical Hessian : " << hmin << std::endl;
+      for (unsigned int i = 0; i < 4; i++) {
+         for (unsigned int j = 0; j < 4; j++) {
+            const double expected = min.UserCovariance()(i, j);
+            if (std::fabs(hmin.UserCovariance()(i, j) - expected) > 1.e-6 * (std::fabs(expected) + 1.)) {
+               std::cerr << "Wrong covariance (" << i << "," << j << ") with analytical Hessian" << std::endl;
+               return 1;
+            }
+         }
+      }
    }
 
    //   stop = stopwatch.lap().ticks();
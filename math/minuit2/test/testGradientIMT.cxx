@@ -0,0 +1,129 @@
+// test of the numerical gradient computed in parallel with the implicit multi-threading
+// (MnStrategy::SetGradientParallel): the gradient and the minimum must be the same as without IMT
+
+#include "Minuit2/FCNBase.h"
+#include "Minuit2/FunctionGradient.h"
+#include "Minuit2/FunctionMinimum.h"
+#include "Minuit2/MinimumParameters.h"
+#include "Minuit2/MnFcn.h"
+#include "Minuit2/MnMigrad.h"
+#include "Minuit2/MnStrategy.h"
+#include "Minuit2/MnUserParameterState.h"
+#include "Minuit2/MnUserParameters.h"
+#include "Minuit2/Numerical2PGradientCalculator.h"
+
+#include "RConfigure.h"
+#include "TROOT.h"
+
+#include <cmath>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace ROOT::Minuit2;
+
+// Sum of coupled non linear terms, the function has no state so it can be called from several threads
+class CoupledFcn : public FCNBase {
+public:
+   CoupledFcn(unsigned int n) : fN(n) {}
+   double operator()(const std::vector<double> &x) const
+   {
+      double f = 0;
+      for (unsigned int i = 0; i < fN; ++i) {
+         const double d = x[i] - 0.1 * i;
+         f += (1. + i % 3) * d * d + 0.1 * d * d * d * d;
+         if (i + 1 < fN)
+            f += 0.5 * std::cos(x[i] - x[i + 1]) * d * d;
+      }
+      return f;
+   }
+   double Up() const { return 1.; }
+
+private:
+   unsigned int fN;
+};
+
+struct Result {
+   std::vector<double> fGrad;
+   std::vector<double> fG2;
+   bool fValid = false;
+   double fFval = 0;
+   double fEdm = 0;
+   std::vector<double> fPar;
+};
+
+Result compute(const FCNBase &fcn, const MnUserParameters &upar)
+{
+   MnStrategy strategy(1);
+   strategy.SetGradientParallel(true);
+
+   Result result;
+   // the gradient at the starting point
+   MnUserParameterState state(upar);
+   MnFcn mfcn(fcn);
+   Numerical2PGradientCalculator gc(mfcn, state.Trafo(), strategy);
+   const unsigned int n = state.VariableParameters();
+   MnAlgebraicVector x(n);
+   for (unsigned int i = 0; i < n; i++)
+      x(i) = state.IntParameters()[i];
+   FunctionGradient grad = gc(MinimumParameters(x, mfcn(x)));
+   for (unsigned int i = 0; i < n; i++) {
+      result.fGrad.push_back(grad.Grad()(i));
+      result.fG2.push_back(grad.G2()(i));
+   }
+
+   MnMigrad migrad(fcn, upar, strategy);
+   FunctionMinimum min = migrad();
+   result.fValid = min.IsValid();
+   result.fFval = min.Fval();
+   result.fEdm = min.Edm();
+   result.fPar = min.UserState().Params();
+   return result;
+}
+
+// each derivative is computed as in the sequential loop, so the results are the same to the last bit
+int compare(const std::string &name, const Result &ref, const Result &res)
+{
+   int iret = 0;
+   if (ref.fGrad != res.fGrad || ref.fG2 != res.fG2) {
+      std::cerr << name << ": different gradient" << std::endl;
+      iret |= 1;
+   }
+   if (!ref.fValid || !res.fValid) {
+      std::cerr << name << ": invalid minimum" << std::endl;
+      iret |= 2;
+   }
+   if (ref.fFval != res.fFval || ref.fEdm != res.fEdm || ref.fPar != res.fPar) {
+      std::cerr << name << ": different minimum, Fval " << ref.fFval << " and " << res.fFval << ", Edm " << ref.fEdm
+                << " and " << res.fEdm << std::endl;
+      iret |= 4;
+   }
+   std::cout << name << ":\tFval " << res.fFval << " Edm " << res.fEdm << (iret ? "\tFAILED" : "\tOK") << std::endl;
+   return iret;
+}
+
+int main()
+{
+   const unsigned int n = 30;
+   CoupledFcn fcn(n);
+   MnUserParameters upar;
+   for (unsigned int i = 0; i < n; ++i) {
+      upar.Add("x" + std::to_string(i), 1., 0.1);
+      // the transformation of the limited parameters is used in the derivatives too
+      if (i % 4 == 0)
+         upar.SetLimits(i, -5., 5.);
+   }
+
+   int iret = 0;
+   const Result ref = compute(fcn, upar);
+#ifdef R__USE_IMT
+   ROOT::EnableImplicitMT(4);
+   iret |= compare("IMT", ref, compute(fcn, upar));
+   ROOT::DisableImplicitMT();
+#endif
+   iret |= compare("no IMT", ref, compute(fcn, upar));
+
+   if (iret != 0)
+      std::cerr << "testGradientIMT: FAILED" << std::endl;
+   return iret;
+}
@@ -0,0 +1,130 @@
+// test of the limited-memory BFGS minimizer: it must find the same minimum as Migrad,
+// with an EDM below the same tolerance
+
+#include "Minuit2/FCNBase.h"
+#include "Minuit2/FunctionMinimum.h"
+#include "Minuit2/LBFGSMinimizer.h"
+#include "Minuit2/MnMigrad.h"
+#include "Minuit2/MnStrategy.h"
+#include "Minuit2/MnUserParameterState.h"
+#include "Minuit2/MnUserParameters.h"
+
+#include <cmath>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace ROOT::Minuit2;
+
+// Rosenbrock function, minimum 0 at (1, 1)
+class RosenbrockFcn : public FCNBase {
+public:
+   double operator()(const std::vector<double> &x) const
+   {
+      const double tmp1 = x[1] - x[0] * x[0];
+      const double tmp2 = 1 - x[0];
+      return 100 * tmp1 * tmp1 + tmp2 * tmp2;
+   }
+   double Up() const { return 1.; }
+};
+
+// Positive definite quadratic form in many coupled parameters, minimum 0 at x[i] = 0.1 * i
+class QuadraticFcn : public FCNBase {
+public:
+   QuadraticFcn(unsigned int n) : fN(n) {}
+   double operator()(const std::vector<double> &x) const
+   {
+      double f = 0;
+      for (unsigned int i = 0; i < fN; ++i) {
+         const double d = x[i] - 0.1 * i;
+         f += (1. + i % 5) * d * d;
+         if (i + 1 < fN) {
+            const double c = d - (x[i + 1] - 0.1 * (i + 1));
+            f += 0.5 * c * c;
+         }
+      }
+      return f;
+   }
+   double Up() const { return 1.; }
+
+private:
+   unsigned int fN;
+};
+
+int testMinimum(const std::string &name, const FCNBase &fcn, const MnUserParameters &upar,
+                const std::vector<double> &expected, double parTolerance)
+{
+   const double toler = 0.1;
+   // the EDM under which Migrad and LBFGS stop
+   const double edmval = 0.002 * toler * fcn.Up();
+
+   MnMigrad migrad(fcn, upar);
+   FunctionMinimum migradMin = migrad(0, toler);
+
+   LBFGSMinimizer lbfgs;
+   FunctionMinimum lbfgsMin = lbfgs.Minimize(fcn, upar, MnStrategy(1), 0, toler);
+
+   int iret = 0;
+   if (!migradMin.IsValid() || !lbfgsMin.IsValid()) {
+      std::cerr << name << ": invalid minimum, Migrad " << migradMin.IsValid() << " LBFGS " << lbfgsMin.IsValid()
+                << std::endl;
+      iret |= 1;
+   }
+   if (lbfgsMin.Edm() > edmval || migradMin.Edm() > edmval) {
+      std::cerr << name << ": EDM above " << edmval << ", Migrad " << migradMin.Edm() << " LBFGS " << lbfgsMin.Edm()
+                << std::endl;
+      iret |= 2;
+   }
+   // both minima stop within the EDM of the true one
+   if (std::abs(lbfgsMin.Fval() - migradMin.Fval()) > 2 * edmval) {
+      std::cerr << name << ": different minimum values, Migrad " << migradMin.Fval() << " LBFGS " << lbfgsMin.Fval()
+                << std::endl;
+      iret |= 4;
+   }
+   const std::vector<double> migradPar = migradMin.UserState().Params();
+   const std::vector<double> lbfgsPar = lbfgsMin.UserState().Params();
+   for (unsigned int i = 0; i < expected.size(); ++i) {
+      if (std::abs(lbfgsPar[i] - expected[i]) > parTolerance || std::abs(lbfgsPar[i] - migradPar[i]) > parTolerance) {
+         std::cerr << name << ": parameter " << i << " expected " << expected[i] << ", Migrad " << migradPar[i]
+                   << " LBFGS " << lbfgsPar[i] << std::endl;
+         iret |= 8;
+      }
+   }
+
+   std::cout << name << ":\tMigrad NCalls " << migradMin.NFcn() << " Fval " << migradMin.Fval() << " Edm "
+             << migradMin.Edm() << "\tLBFGS NCalls " << lbfgsMin.NFcn() << " Fval " << lbfgsMin.Fval() << " Edm "
+             << lbfgsMin.Edm() << (iret ? "\tFAILED" : "\tOK") << std::endl;
+   return iret;
+}
+
+int testRosenbrock()
+{
+   RosenbrockFcn fcn;
+   MnUserParameters upar;
+   upar.Add("x", -1.2, 0.1);
+   upar.Add("y", 1., 0.1);
+   return testMinimum("Rosenbrock", fcn, upar, {1., 1.}, 0.02);
+}
+
+int testQuadratic()
+{
+   const unsigned int n = 50;
+   QuadraticFcn fcn(n);
+   MnUserParameters upar;
+   std::vector<double> expected;
+   for (unsigned int i = 0; i < n; ++i) {
+      upar.Add("x" + std::to_string(i), 1., 0.1);
+      expected.push_back(0.1 * i);
+   }
+   return testMinimum("Quadratic", fcn, upar, expected, 0.01);
+}
+
+int main()
+{
+   int iret = 0;
+   iret |= testRosenbrock();
+   iret |= testQuadratic();
+   if (iret != 0)
+      std::cerr << "testLBFGS: FAILED" << std::endl;
+   return iret;
+}
@@ -0,0 +1,398 @@
+// @(#)root/smatrix:$Id$
+
+#ifndef ROOT_Math_Matriplex
+#define ROOT_Math_Matriplex
+
+/** @file
+ * header file containing Matriplex and MatriplexSym, sets of N small fixed
+ * size matrices stored interleaved, and the functions for the batched
+ * operations of track fits on them (products, similarity and inversion of
+ * symmetric positive definite matrices).
+ */
+
+#include "Math/SMatrix.h"
+
+#include <cmath>
+
+namespace ROOT {
+
+namespace Math {
+
+//__________________________________________________________________________
+/**
+    Matriplex: a set of N matrices D1 x D2 of type T, stored interleaved.
+
+    The element (i,j) of the matrix n is at position (i * D2 + j) * N + n of the
+    array: the N values of a given element are contiguous in memory. The
+    operations are done element by element for all the matrices at once, in
+    loops over the N matrices with no dependencies between the iterations, that
+    the compiler turns into SIMD instructions operating on several matrices,
+    e.g. several tracks, at a time. N should be a multiple of the SIMD width
+    (e.g. 8 or 16).
+
+    A Matriplex with D2 = 1 is a set of N vectors of size D1.
+
+    Usage example, for the Kalman filter update of N tracks with a 5x5
+    covariance matrix and a 2 dimensional measurement:
+    @code
+    MatriplexSym<double, 5, 16> cov;
+    Matriplex<double, 2, 5, 16> proj;
+    for (unsigned int n = 0; n < 16; ++n)
+       cov.CopyIn(n, tracks[n].Covariance());
+    ...
+    MatriplexSym<double, 2, 16> res;
+    Similarity(proj, cov, res); // res = proj * cov * proj^T
+    res += measurementErrors;
+    InvertChol(res);
+    @endcode
+
+    @ingroup SMatrixSVector
+*/
+template <class T, unsigned int D1, unsigned int D2, unsigned int N>
+class Matriplex {
+public:
+   typedef T value_type;
+
+   enum {
+      /// number of rows
+      kRows = D1,
+      /// number of columns
+      kCols = D2,
+      /// number of elements of each matrix
+      kSize = D1 * D2,
+      /// number of matrices
+      kN = N
+   };
+
+   /// position of the element (i,j) in the array (multiplied by N)
+   static constexpr unsigned int Offset(unsigned int i, unsigned int j) { return i * D2 + j; }
+
+   /// access to the element (i,j) of the matrix n
+   T &operator()(unsigned int i, unsigned int j, unsigned int n) { return fArray[Offset(i, j) * N + n]; }
+   const T &operator()(unsigned int i, unsigned int j, unsigned int n) const { return fArray[Offset(i, j) * N + n]; }
+
+   /// pointer to the N values of the element (i,j)
+   T *Element(unsigned int i, unsigned int j) { return fArray + Offset(i, j) * N; }
+   const T *Element(unsigned int i, unsigned int j) const { return fArray + Offset(i, j) * N; }
+
+   T *Array() { return fArray; }
+   const T *Array() const { return fArray; }
+
+   /// set all the elements of all the matrices to the value a
+   void SetValue(T a)
+   {
+      for (unsigned int k = 0; k < kSize * N; ++k)
+         fArray[k] = a;
+   }
+
+   /// copy the matrix m into the matrix n
+   template <class R>
+   void CopyIn(unsigned int n, const SMatrix<T, D1, D2, R> &m)
+   {
+      for (unsigned int i = 0; i < D1; ++i)
+         for (unsigned int j = 0; j < D2; ++j)
+            (*this)(i, j, n) = m(i, j);
+   }
+
+   /// copy the matrix n into m
+   template <class R>
+   void CopyOut(unsigned int n, SMatrix<T, D1, D2, R> &m) const
+   {
+      for (unsigned int i = 0; i < D1; ++i)
+         for (unsigned int j = 0; j < D2; ++j)
+            m(i, j) = (*this)(i, j, n);
+   }
+
+   /// copy the vector v into the matrix n (only for D2 = 1)
+   void CopyIn(unsigned int n, const SVector<T, D1> &v)
+   {
+      static_assert(D2 == 1, "Matriplex: a vector can only be copied in a D x 1 Matriplex");
+      for (unsigned int i = 0; i < D1; ++i)
+         (*this)(i, 0, n) = v[i];
+   }
+
+   /// copy the matrix n into the vector v (only for D2 = 1)
+   void CopyOut(unsigned int n, SVector<T, D1> &v) const
+   {
+      static_assert(D2 == 1, "Matriplex: a vector can only be copied from a D x 1 Matriplex");
+      for (unsigned int i = 0; i < D1; ++i)
+         v[i] = (*this)(i, 0, n);
+   }
+
+   Matriplex &operator+=(const Matriplex &rhs)
+   {
+      for (unsigned int k = 0; k < kSize * N; ++k)
+         fArray[k] += rhs.fArray[k];
+      return *this;
+   }
+
+   Matriplex &operator-=(const Matriplex &rhs)
+   {
+      for (unsigned int k = 0; k < kSize * N; ++k)
+         fArray[k] -= rhs.fArray[k];
+      return *this;
+   }
+
+   Matriplex &operator*=(T a)
+   {
+      for (unsigned int k = 0; k < kSize * N; ++k)
+         fArray[k] *= a;
+      return *this;
+   }
+
+private:
+   T fArray[kSize * N];
+};
+
+//__________________________________________________________________________
+/**
+    MatriplexSym: a set of N symmetric matrices D x D of type T, stored
+    interleaved.
+
+    Each matrix is stored in the packed order of MatRepSym: the element (i,j),
+    with i >= j, is at position (i * (i + 1) / 2 + j) * N + n of the array.
+
+    @ingroup SMatrixSVector
+*/
+template <class T, unsigned int D, unsigned int N>
+class MatriplexSym {
+public:
+   typedef T value_type;
+
+   enum {
+      /// number of rows
+      kRows = D,
+      /// number of columns
+      kCols = D,
+      /// number of independent elements of each matrix
+      kSize = D * (D + 1) / 2,
+      /// number of matrices
+      kN = N
+   };
+
+   /// position of the element (i,j) in the array (multiplied by N)
+   static constexpr unsigned int Offset(unsigned int i, unsigned int j)
+   {
+      return i >= j ? i * (i + 1) / 2 + j : j * (j + 1) / 2 + i;
+   }
+
+   /// access to the element (i,j) of the matrix n
+   T &operator()(unsigned int i, unsigned int j, unsigned int n) { return fArray[Offset(i, j) * N + n]; }
+   const T &operator()(unsigned int i, unsigned int j, unsigned int n) const { return fArray[Offset(i, j) * N + n]; }
+
+   /// pointer to the N values of the element (i,j)
+   T *Element(unsigned int i, unsigned int j) { return fArray + Offset(i, j) * N; }
+   const T *Element(unsigned int i, unsigned int j) const { return fArray + Offset(i, j) * N; }
+
+   T *Array() { return fArray; }
+   const T *Array() const { return fArray; }
+
+   /// set all the elements of all the matrices to the value a
+   void SetValue(T a)
+   {
+      for (unsigned int k = 0; k < kSize * N; ++k)
+         fArray[k] = a;
+   }
+
+   /// copy the symmetric matrix m into the matrix n
+   void CopyIn(unsigned int n, const SMatrix<T, D, D, MatRepSym<T, D>> &m)
+   {
+      const T *p = m.Array();
+      for (unsigned int k = 0; k < kSize; ++k)
+         fArray[k * N + n] = p[k];
+   }
+
+   /// copy the matrix n into the symmetric matrix m
+   void CopyOut(unsigned int n, SMatrix<T, D, D, MatRepSym<T, D>> &m) const
+   {
+      T *p = m.Array();
+      for (unsigned int k = 0; k < kSize; ++k)
+         p[k] = fArray[k * N + n];
+   }
+
+   MatriplexSym &operator+=(const MatriplexSym &rhs)
+   {
+      for (unsigned int k = 0; k < kSize * N; ++k)
+         fArray[k] += rhs.fArray[k];
+      return *this;
+   }
+
+   MatriplexSym &operator-=(const MatriplexSym &rhs)
+   {
+      for (unsigned int k = 0; k < kSize * N; ++k)
+         fArray[k] -= rhs.fArray[k];
+      return *this;
+   }
+
+   MatriplexSym &operator*=(T a)
+   {
+      for (unsigned int k = 0; k < kSize * N; ++k)
+         fArray[k] *= a;
+      return *this;
+   }
+
+private:
+   T fArray[kSize * N];
+};
+
+/**
+   \defgroup MatriplexFunctions Batched operations on Matriplex
+   \ingroup SMatrixGroup
+
+   The loops over the dimensions of the matrices have compile time bounds and
+   are unrolled by the compiler; the innermost loops run over the N matrices
+   and accumulate in local arrays, so that they are vectorized without
+   aliasing checks. The result may not alias an operand.
+*/
+
+/// C = A * B for each of the N matrices
+/// @ingroup MatriplexFunctions
+template <class T, unsigned int D1, unsigned int D, unsigned int D2, unsigned int N>
+inline void Multiply(const Matriplex<T, D1, D, N> &a, const Matriplex<T, D, D2, N> &b, Matriplex<T, D1, D2, N> &c)
+{
+   for (unsigned int i = 0; i < D1; ++i) {
+      for (unsigned int j = 0; j < D2; ++j) {
+         T acc[N] = {};
+         for (unsigned int k = 0; k < D; ++k) {
+            const T *aik = a.Element(i, k);
+            const T *bkj = b.Element(k, j);
+            for (unsigned int n = 0; n < N; ++n)
+               acc[n] += aik[n] * bkj[n];
+         }
+         T *cij = c.Element(i, j);
+         for (unsigned int n = 0; n < N; ++n)
+            cij[n] = acc[n];
+      }
+   }
+}
+
+/// C = S * B for each of the N matrices, with S symmetric
+/// @ingroup MatriplexFunctions
+template <class T, unsigned int D, unsigned int D2, unsigned int N>
+inline void Multiply(const MatriplexSym<T, D, N> &s, const Matriplex<T, D, D2, N> &b, Matriplex<T, D, D2, N> &c)
+{
+   for (unsigned int i = 0; i < D; ++i) {
+      for (unsigned int j = 0; j < D2; ++j) {
+         T acc[N] = {};
+         for (unsigned int k = 0; k < D; ++k) {
+            const T *sik = s.Element(i, k);
+            const T *bkj = b.Element(k, j);
+            for (unsigned int n = 0; n < N; ++n)
+               acc[n] += sik[n] * bkj[n];
+         }
+         T *cij = c.Element(i, j);
+         for (unsigned int n = 0; n < N; ++n)
+            cij[n] = acc[n];
+      }
+   }
+}
+
+/// C = A * S * A^T for each of the N matrices, with S symmetric (e.g. the
+/// propagation of a covariance matrix with the Jacobian A)
+/// @ingroup MatriplexFunctions
+template <class T, unsigned int D1, unsigned int D, unsigned int N>
+inline void Similarity(const Matriplex<T, D1, D, N> &a, const MatriplexSym<T, D, N> &s, MatriplexSym<T, D1, N> &c)
+{
+   for (unsigned int i = 0; i < D1; ++i) {
+      // row i of A * S
+      T as[D][N];
+      for (unsigned int j = 0; j < D; ++j) {
+         T acc[N] = {};
+         for (unsigned int k = 0; k < D; ++k) {
+            const T *aik = a.Element(i, k);
+            const T *skj = s.Element(k, j);
+            for (unsigned int n = 0; n < N; ++n)
+               acc[n] += aik[n] * skj[n];
+         }
+         for (unsigned int n = 0; n < N; ++n)
+            as[j][n] = acc[n];
+      }
+      // (A * S * A^T)(i,l) for l <= i
+      for (unsigned int l = 0; l <= i; ++l) {
+         T acc[N] = {};
+         for (unsigned int k = 0; k < D; ++k) {
+            const T *alk = a.Element(l, k);
+            for (unsigned int n = 0; n < N; ++n)
+               acc[n] += as[k][n] * alk[n];
+         }
+         T *cil = c.Element(i, l);
+         for (unsigned int n = 0; n < N; ++n)
+            cil[n] = acc[n];
+      }
+   }
+}
+
+/// Invert in place each of the N symmetric positive definite matrices, with
+/// the Cholesky decomposition (the algorithm of CholeskyDecomp). The matrices
+/// are all processed without branching: the function returns false if any of
+/// them is not positive definite, in which case its inverse is invalid while
+/// the others are correct. The square roots are only vectorized when the
+/// compiler may ignore errno (-fno-math-errno).
+/// @ingroup MatriplexFunctions
+template <class T, unsigned int D, unsigned int N>
+inline bool InvertChol(MatriplexSym<T, D, N> &m)
+{
+   typedef MatriplexSym<T, D, N> M;
+   // L, with the inverse of its diagonal elements, then L^-1, in packed order
+   T l[M::kSize][N];
+   unsigned int nFailed = 0;
+
+   // decomposition M = L L^T
+   for (unsigned int i = 0; i < D; ++i) {
+      T diag[N] = {};
+      for (unsigned int j = 0; j < i; ++j) {
+         const T *mij = m.Element(i, j);
+         T acc[N];
+         for (unsigned int n = 0; n < N; ++n)
+            acc[n] = mij[n];
+         for (unsigned int k = 0; k < j; ++k)
+            for (unsigned int n = 0; n < N; ++n)
+               acc[n] -= l[M::Offset(i, k)][n] * l[M::Offset(j, k)][n];
+         for (unsigned int n = 0; n < N; ++n) {
+            acc[n] *= l[M::Offset(j, j)][n];
+            diag[n] += acc[n] * acc[n];
+            l[M::Offset(i, j)][n] = acc[n];
+         }
+      }
+      const T *mii = m.Element(i, i);
+      for (unsigned int n = 0; n < N; ++n) {
+         diag[n] = mii[n] - diag[n];
+         nFailed += !(diag[n] > T(0.0));
+      }
+      for (unsigned int n = 0; n < N; ++n)
+         l[M::Offset(i, i)][n] = T(1.0) / std::sqrt(diag[n]);
+   }
+
+   // off-diagonal elements of L^-1 (its diagonal is already inverted)
+   for (unsigned int i = 1; i < D; ++i) {
+      for (unsigned int j = 0; j < i; ++j) {
+         T acc[N] = {};
+         for (unsigned int k = j; k < i; ++k)
+            for (unsigned int n = 0; n < N; ++n)
+               acc[n] -= l[M::Offset(i, k)][n] * l[M::Offset(k, j)][n];
+         for (unsigned int n = 0; n < N; ++n)
+            l[M::Offset(i, j)][n] = acc[n] * l[M::Offset(i, i)][n];
+      }
+   }
+
+   // M^-1 = (L^-1)^T L^-1
+   for (unsigned int i = 0; i < D; ++i) {
+      for (unsigned int j = 0; j <= i; ++j) {
+         T acc[N] = {};
+         for (unsigned int k = i; k < D; ++k)
+            for (unsigned int n = 0; n < N; ++n)
+               acc[n] += l[M::Offset(k, i)][n] * l[M::Offset(k, j)][n];
+         T *mij = m.Element(i, j);
+         for (unsigned int n = 0; n < N; ++n)
+            mij[n] = acc[n];
+      }
+   }
+
+   return nFailed == 0;
+}
+
+} // namespace Math
+
+} // namespace ROOT
+
+#endif /* ROOT_Math_Matriplex */
@@ -1,6 +1,7 @@
 #include <cmath>
 #include "Math/SVector.h"
 #include "Math/SMatrix.h"
+#include "Math/Matriplex.h"
 
 #include <iomanip>
 #include <iostream>
@@ -1431,6 +1432,78 @@ int test25()
    return iret;
 }
 
+int test26()
+{
+   // batched operations of Matriplex against the ones of SMatrix
+   typedef SMatrix<double, 5, 5, MatRepSym<double, 5>> SMatrixSym5;
+   const unsigned int N = 8;
+
+   MatriplexSym<double, 5, N> cov;
+   Matriplex<double, 5, 5, N> jac;
+   Matriplex<double, 2, 5, N> proj;
+   std::vector<SMatrixSym5> vcov(N);
+   std::vector<SMatrix<double, 5>> vjac(N);
+   std::vector<SMatrix<double, 2, 5>> vproj(N);
+   for (unsigned int n = 0; n < N; ++n) {
+      for (unsigned int i = 0; i < 5; ++i) {
+         for (unsigned int j = 0; j < 5; ++j) {
+            vjac[n](i, j) = (i == j) + 0.1 * (n + 1) / (i + 2 * j + 1);
+            if (i < 2)
+               vproj[n](i, j) = (i == j) + 0.01 * j;
+            if (j <= i)
+               vcov[n](i, j) = (i == j) * (n + 1) + 0.05 * (i + j);
+         }
+      }
+      cov.CopyIn(n, vcov[n]);
+      jac.CopyIn(n, vjac[n]);
+      proj.CopyIn(n, vproj[n]);
+   }
+
+   MatriplexSym<double, 5, N> prop;
+   MatriplexSym<double, 2, N> res;
+   Matriplex<double, 5, 2, N> gain;
+   Matriplex<double, 5, 2, N> projT;
+   for (unsigned int n = 0; n < N; ++n)
+      projT.CopyIn(n, SMatrix<double, 5, 2>(Transpose(vproj[n])));
+   Similarity(jac, cov, prop);
+   Similarity(proj, prop, res);
+   bool ok = InvertChol(res);
+   Matriplex<double, 5, 2, N> tmp;
+   Multiply(prop, projT, tmp);
+   Matriplex<double, 2, 2, N> resFull;
+   for (unsigned int n = 0; n < N; ++n)
+      for (unsigned int i = 0; i < 2; ++i)
+         for (unsigned int j = 0; j < 2; ++j)
+            resFull(i, j, n) = res(i, j, n);
+   Multiply(tmp, resFull, gain);
+
+   int iret = 0;
+   iret |= compare(ok, true, "InvertChol");
+   for (unsigned int n = 0; n < N; ++n) {
+      SMatrixSym5 vprop = Similarity(vjac[n], vcov[n]);
+      SMatrix<double, 2, 2, MatRepSym<double, 2>> vres = Similarity(vproj[n], vprop);
+      vres.InvertChol();
+      SMatrix<double, 5, 2> vgain = vprop * Transpose(vproj[n]) * vres;
+      for (unsigned int i = 0; i < 5; ++i) {
+         for (unsigned int j = 0; j <= i; ++j)
+            iret |= compare(prop(i, j, n), vprop(i, j), "Similarity", 100);
+         for (unsigned int j = 0; j < 2; ++j)
+            iret |= compare(gain(i, j, n), vgain(i, j), "Multiply", 100);
+      }
+      for (unsigned int i = 0; i < 2; ++i)
+         for (unsigned int j = 0; j < 2; ++j)
+            iret |= compare(res(i, j, n), vres(i, j), "InvertChol", 100);
+   }
+
+   // a matrix which is not positive definite is reported
+   res(1, 1, 3) = -1;
+   res(0, 0, 3) = 1;
+   res(1, 0, 3) = 0;
+   iret |= compare(InvertChol(res), false, "InvertChol not positive definite");
+
+   return iret;
+}
+
 #define TEST(N)                                                   \
    itest = N;                                                     \
    if (test##N() == 0)                                            \
@@ -1470,6 +1543,7 @@ int testSMatrix()
    TEST(23);
    TEST(24);
    TEST(25);
+   TEST(26);
 
    return iret;
 }
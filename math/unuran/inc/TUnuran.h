@@ -55,6 +55,16 @@ class TUnuranEmpDist;
 
    In addition is possible to set the random number generator in the constructor of the class, its seed
    via the TUnuran::SetSeed() method.
+
+   Arrays of numbers are generated with TUnuran::Sample(unsigned int, double *) and the corresponding
+   methods for the discrete and multi-dimensional distributions.
+
+   A TUnuran object must not be used by several threads at the same time. To sample in several threads,
+   initialize it once and create with TUnuran::Clone() one generator per thread, each with its own random
+   engine: the clones copy the tables computed by the initialization (e.g. for the methods PINV, HINV
+   or DGT) instead of computing them again. The clones share the distribution with the original object,
+   which must outlive them; the distribution functions must be thread safe when the method evaluates them
+   while sampling (e.g. TDR, AROU or HITRO, but not PINV, HINV or DGT).
 */
 
 
@@ -92,10 +102,10 @@ public:
    ~TUnuran ();
 
 private:
-   // usually copying is non trivial, so we make this unaccessible
+   // usually copying is non trivial, so we make this unaccessible (see Clone)
 
    /**
-      Copy constructor
+      Copy constructor, used by Clone
    */
    TUnuran(const TUnuran &);
 
@@ -211,6 +221,33 @@ public:
    */
    int SampleDiscr();
 
+   /**
+      Fill x with n numbers of a 1D continuous distribution.
+      Return false if the object is not initialized.
+   */
+   bool Sample(unsigned int n, double * x);
+
+   /**
+      Fill x with n points of a multidimensional distribution, stored one point after the other
+      (x must have size n times the dimension). Return false if the object is not initialized.
+   */
+   bool SampleMulti(unsigned int n, double * x);
+
+   /**
+      Fill x with n numbers of a discrete distribution.
+      Return false if the object is not initialized.
+   */
+   bool SampleDiscr(unsigned int n, int * x);
+
+   /**
+      Return a new generator for the same distribution and method, which copies the tables computed
+      by the initialization of this object instead of computing them again, and which uses the random
+      engine r (the one of this object if r is null). The clone can then sample in another thread than
+      this object. It uses the distribution of this object, which must therefore outlive the clone.
+      Return nullptr if this object is not initialized. The caller owns the returned object.
+   */
+   TUnuran * Clone(TRandom * r = nullptr) const;
+
    /**
       Set the random engine.
       Must be called before init to have effect
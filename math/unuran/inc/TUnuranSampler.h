@@ -42,6 +42,9 @@ namespace ROOT {
    class implementing  the ROOT::Math::DistSampler interface using the UNU.RAN
    package for sampling distributions.
 
+   When the implicit multi-threading is enabled, TUnuranSampler::Generate produces large samples
+   in several threads, using clones of the initialized UNU.RAN generator (see TUnuran::Clone).
+
 */
 
 class TRandom;
@@ -166,6 +169,17 @@ public:
     */
    bool SampleBin(double prob, double & value, double *error = 0);
 
+   using ROOT::Math::DistSampler::Generate;
+
+   /**
+      generate nevt events and fill the array data, as DistSampler::Generate.
+      When the implicit multi-threading is enabled and nevt is large, the events are generated
+      in blocks of a fixed size, each by a clone of the UNU.RAN generator with its own
+      TRandomMixMax engine. The seeds of the engines are drawn from the random engine of this
+      sampler, such that the events do not depend on the number of threads.
+   */
+   bool Generate(unsigned int nevt, double * data, bool eventRow = false);
+
 
 
 protected:
@@ -177,6 +191,9 @@ protected:
    /// Initialization for multi-dim distributions.
    bool DoInitND(const char * algo);
 
+   /// Generate the events [first, first+n) of the nevt events in data using the generator unr.
+   bool DoGenerate(TUnuran & unr, unsigned int first, unsigned int n, unsigned int nevt, double * data, bool eventRow) const;
+
 
 private:
 
@@ -59,10 +59,32 @@ TUnuran::~TUnuran()
    if (fUdistr != 0) unur_distr_free(fUdistr);
 }
 
-//private (no impl.)
-TUnuran::TUnuran(const TUnuran &)
+//private (used by Clone)
+TUnuran::TUnuran(const TUnuran & rhs) :
+   fGen(0),
+   fUdistr(0),
+   fUrng(0),
+   fRng(rhs.fRng),
+   fMethod(rhs.fMethod)
 {
-   // Implementation of copy constructor.
+   // Implementation of copy constructor: the UNU.RAN generator is copied with its tables,
+   // while the distribution objects stay owned by rhs.
+   // The copy uses the random generator of rhs until SetRandomGenerator is called
+   if (rhs.fGen != 0) fGen = unur_gen_clone(rhs.fGen);
+}
+
+TUnuran * TUnuran::Clone(TRandom * r) const
+{
+   // clone the generator with a new random generator
+   if (fGen == 0) return nullptr;
+   TUnuran * clone = new TUnuran(*this);
+   if (r) clone->fRng = r;
+   if (clone->fGen == 0 || !clone->SetRandomGenerator()) {
+      Error("Clone","Cannot clone the generator object");
+      delete clone;
+      return nullptr;
+   }
+   return clone;
 }
 
 TUnuran & TUnuran::operator = (const TUnuran &rhs)
@@ -441,6 +463,34 @@ bool TUnuran::SampleMulti(double * x)
    return true;
 }
 
+bool TUnuran::Sample(unsigned int n, double * x)
+{
+   // sample n values of a one-dimensional distribution
+   if (fGen == 0) return false;
+   for (unsigned int i = 0; i < n; ++i)
+      x[i] = unur_sample_cont(fGen);
+   return true;
+}
+
+bool TUnuran::SampleMulti(unsigned int n, double * x)
+{
+   // sample n points of a multidimensional distribution
+   if (fGen == 0) return false;
+   const int ndim = unur_get_dimension(fGen);
+   for (unsigned int i = 0; i < n; ++i)
+      unur_sample_vec(fGen, x + i * ndim);
+   return true;
+}
+
+bool TUnuran::SampleDiscr(unsigned int n, int * x)
+{
+   // sample n values of a discrete distribution
+   if (fGen == 0) return false;
+   for (unsigned int i = 0; i < n; ++i)
+      x[i] = unur_sample_discr(fGen);
+   return true;
+}
+
 void TUnuran::SetSeed(unsigned int seed) {
    return fRng->SetSeed(seed);
 }
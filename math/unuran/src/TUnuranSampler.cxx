@@ -22,11 +22,21 @@
 //#include "Math/WrappedTF1.h"
 
 #include "TRandom.h"
+#include "TRandomGen.h"
 #include "TError.h"
 
 #include "TF1.h"
+#include <algorithm>
 #include <cassert>
 #include <cmath>
+#include <memory>
+#include <vector>
+
+#ifdef R__USE_IMT
+#include "TROOT.h"
+#include "ROOT/TThreadExecutor.hxx"
+#include <atomic>
+#endif
 
 ClassImp(TUnuranSampler);
 
@@ -282,6 +292,73 @@ bool TUnuranSampler::Sample(double * x) {
 }
 
 
+bool TUnuranSampler::Generate(unsigned int nevt, double * data, bool eventRow) {
+   // generate nevt events, in parallel when the implicit multi-threading is enabled
+   if (!IsInitialized()) {
+      Warning("Generate","sampler has not been initialized correctly");
+      return false;
+   }
+
+#ifdef R__USE_IMT
+   // number of events generated by each task: it does not depend on the
+   // number of threads, such that the generated events do not either
+   const unsigned int kEventsPerTask = 10000;
+   if (nevt > kEventsPerTask && ROOT::IsImplicitMTEnabled()) {
+      const unsigned int ntasks = (nevt + kEventsPerTask - 1) / kEventsPerTask;
+      TRandom * r = fUnuran->GetRandom();
+      std::vector<UInt_t> seeds(ntasks);
+      for (auto & seed : seeds)
+         seed = r->Integer(kMaxUInt);
+
+      std::atomic<bool> ok{true};
+      auto task = [&](unsigned int itask) {
+         const unsigned int first = itask * kEventsPerTask;
+         const unsigned int n = std::min(kEventsPerTask, nevt - first);
+         TRandomMixMax rng(seeds[itask]);
+         std::unique_ptr<TUnuran> unr(fUnuran->Clone(&rng));
+         if (!unr || !DoGenerate(*unr, first, n, nevt, data, eventRow))
+            ok = false;
+      };
+      ROOT::TThreadExecutor pool;
+      pool.Foreach(task, ROOT::TSeq<unsigned int>(ntasks));
+      return ok;
+   }
+#endif
+
+   return DoGenerate(*fUnuran, 0, nevt, nevt, data, eventRow);
+}
+
+bool TUnuranSampler::DoGenerate(TUnuran & unr, unsigned int first, unsigned int n, unsigned int nevt, double * data, bool eventRow) const {
+   // generate the events [first, first+n) using the array methods of TUnuran
+   const unsigned int ndim = NDim();
+   std::vector<double> buffer;
+   double * x = data + first * ndim;
+   if (!eventRow && ndim > 1) {
+      buffer.resize(n * ndim);
+      x = buffer.data();
+   }
+
+   bool ret = true;
+   if (fDiscrete) {
+      std::vector<int> ix(n);
+      ret = unr.SampleDiscr(n, ix.data());
+      std::copy(ix.begin(), ix.end(), x);
+   }
+   else if (fOneDim)
+      ret = unr.Sample(n, x);
+   else
+      ret = unr.SampleMulti(n, x);
+   if (!ret) return false;
+
+   if (!buffer.empty()) {
+      for (unsigned int i = 0; i < n; ++i) {
+         for (unsigned int j = 0; j < ndim; ++j)
+            data[j * nevt + first + i] = buffer[i * ndim + j];
+      }
+   }
+   return true;
+}
+
 bool TUnuranSampler::SampleBin(double prob, double & value, double *error) {
    // sample a bin according to Poisson statistics
    TRandom * r = fUnuran->GetRandom();
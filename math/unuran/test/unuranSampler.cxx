@@ -8,6 +8,10 @@
 #include "Math/Functor.h"
 #include "TH1.h"
 #include "TH2.h"
+#include "TUnuran.h"
+#include "TRandom3.h"
+
+#include <vector>
 
 using namespace ROOT::Math; 
 
@@ -229,4 +233,46 @@ TEST(MultiDim, DistSamplerOptAPI){
     EXPECT_NEAR(h1->GetRMS(2), 2, 10*h1->GetRMSError(2));
     EXPECT_NEAR(h1->GetCorrelationFactor(1,2), 0.7, 0.1);
     
-}
\ No newline at end of file
+}
+
+// test generating an array of events
+TEST(OneDim, GenerateArray)
+{
+    std::unique_ptr<DistSampler> sampler(Factory::CreateDistSampler("Unuran"));
+
+    bool ret = sampler->Init("distr = normal(3.,0.75) & method = pinv");
+    EXPECT_EQ(ret, true);
+    if (!ret) return;
+
+    const int nevt = 50000;
+    std::vector<double> data(nevt);
+    ret = sampler->Generate(nevt, data.data());
+    EXPECT_EQ(ret, true);
+
+    TH1D h1("h1","h1",100, 1, 0);
+    for (auto x : data) h1.Fill(x);
+    EXPECT_NEAR(h1.GetMean(), 3., 5 * h1.GetMeanError());
+    EXPECT_NEAR(h1.GetRMS(), 0.75, 5*h1.GetRMSError());
+}
+
+// clones of a generator with identical random engines give the same numbers
+TEST(TUnuran, Clone)
+{
+    TUnuran unr;
+    bool ret = unr.Init("normal(1.,2.)", "method=pinv");
+    EXPECT_EQ(ret, true);
+    if (!ret) return;
+
+    TRandom3 r1(111);
+    TRandom3 r2(111);
+    std::unique_ptr<TUnuran> c1(unr.Clone(&r1));
+    std::unique_ptr<TUnuran> c2(unr.Clone(&r2));
+    ASSERT_NE(c1, nullptr);
+    ASSERT_NE(c2, nullptr);
+
+    const int n = 1000;
+    std::vector<double> x1(n), x2(n);
+    EXPECT_EQ(c1->Sample(n, x1.data()), true);
+    EXPECT_EQ(c2->Sample(n, x2.data()), true);
+    EXPECT_EQ(x1, x2);
+}
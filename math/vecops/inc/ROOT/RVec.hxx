@@ -31,9 +31,15 @@
 
 #include <algorithm>
 #include <cmath>
+#include <initializer_list>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <new>
 #include <numeric> // for inner_product
 #include <sstream>
 #include <stdexcept>
+#include <string>
 #include <type_traits>
 #include <vector>
 #include <utility>
@@ -115,6 +121,501 @@ void EmplaceBack(std::vector<bool> &v, Args &&... args)
    v.push_back(std::forward<Args>(args)...);
 }
 
+/// The number of elements stored inline by the RVec of type T, i.e. without heap allocations: as many as fit in
+/// a cache line together with the RVec bookkeeping, and at least 8 unless that takes more than 1 kB.
+template <typename T>
+struct RVecInlineStorageSize {
+private:
+   static constexpr std::size_t kCacheLineSize = 64;
+   static constexpr std::size_t kHeaderSize = sizeof(void *) + 2 * sizeof(int);
+   static constexpr std::size_t kElementsPerCacheLine =
+      kCacheLineSize > kHeaderSize ? (kCacheLineSize - kHeaderSize) / sizeof(T) : 0;
+   static constexpr std::size_t kMaxInlineByteSize = 1024;
+
+public:
+   static constexpr unsigned int value =
+      kElementsPerCacheLine >= 8 ? kElementsPerCacheLine : (sizeof(T) * 8 > kMaxInlineByteSize ? 0 : 8);
+};
+
+/// Uninitialized storage for N elements of type T.
+template <typename T, unsigned int N>
+struct RSmallVectorInlineBuffer {
+   alignas(T) char fBuffer[N * sizeof(T)];
+};
+
+template <typename T>
+struct RSmallVectorInlineBuffer<T, 0> {
+};
+
+/**
+\class ROOT::Internal::VecOps::RSmallVector
+\brief The storage of RVec: a contiguous container that stores up to N elements inline, in the spirit of LLVM's
+SmallVector, and that can adopt memory it does not own.
+
+Elements are kept in the inline buffer as long as they fit, so that small collections, e.g. the objects of an event
+that pass a selection, do not require heap allocations. Larger collections are moved to the heap. An RSmallVector can
+also adopt an existing memory region, in which case it neither destroys nor deallocates the elements: any operation
+that requires more memory than the adopted region, e.g. push_back or resize to a larger size, copies the elements
+to memory owned by the RSmallVector.
+*/
+template <typename T, unsigned int N>
+class RSmallVector {
+public:
+   using value_type = T;
+   using size_type = std::size_t;
+   using difference_type = std::ptrdiff_t;
+   using reference = T &;
+   using const_reference = const T &;
+   using pointer = T *;
+   using const_pointer = const T *;
+   using iterator = T *;
+   using const_iterator = const T *;
+   using reverse_iterator = std::reverse_iterator<iterator>;
+   using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+private:
+   T *fBegin;
+   int fSize = 0;
+   /// The number of elements that fit in the memory pointed to by fBegin, -1 if the memory is adopted
+   int fCapacity = static_cast<int>(N);
+   RSmallVectorInlineBuffer<T, N> fInline;
+
+   T *InlineBegin() { return reinterpret_cast<T *>(&fInline); }
+   bool IsSmall() const { return fBegin == reinterpret_cast<const T *>(&fInline); }
+   bool OwnsMemory() const { return fCapacity != -1; }
+
+   static T *Allocate(size_type n) { return std::allocator<T>().allocate(n); }
+   static void Deallocate(T *p, size_type n) { std::allocator<T>().deallocate(p, n); }
+
+   static int CheckedSize(size_type n)
+   {
+      if (n > static_cast<size_type>(std::numeric_limits<int>::max()))
+         throw std::length_error("RVec: the requested size exceeds the maximum size of an RVec.");
+      return static_cast<int>(n);
+   }
+
+   void DestroyRange(T *first, T *last)
+   {
+      if (OwnsMemory()) {
+         for (; first != last; ++first)
+            first->~T();
+      }
+   }
+
+   /// Destroy the elements, free the heap memory if any and go back to an empty inline buffer
+   void Release()
+   {
+      DestroyRange(begin(), end());
+      if (OwnsMemory() && !IsSmall())
+         Deallocate(fBegin, fCapacity);
+      fBegin = InlineBegin();
+      fSize = 0;
+      fCapacity = static_cast<int>(N);
+   }
+
+   /// The capacity to grow to in order to store at least minCapacity elements
+   size_type GetNewCapacity(size_type minCapacity) const
+   {
+      return std::max(minCapacity, std::max(2 * capacity(), size_type(1)));
+   }
+
+   static void CopyAdopted(T *first, T *last, T *dest, std::true_type /*isCopyConstructible*/)
+   {
+      std::uninitialized_copy(first, last, dest);
+   }
+   static void CopyAdopted(T *first, T *last, T *dest, std::false_type /*isCopyConstructible*/)
+   {
+      std::uninitialized_copy(std::make_move_iterator(first), std::make_move_iterator(last), dest);
+   }
+
+   /// Move the elements to a new buffer of the given capacity. Adopted elements are copied rather than moved.
+   void MoveToBuffer(T *newBegin, size_type newCapacity)
+   {
+      if (OwnsMemory()) {
+         std::uninitialized_copy(std::make_move_iterator(begin()), std::make_move_iterator(end()), newBegin);
+         DestroyRange(begin(), end());
+         if (!IsSmall())
+            Deallocate(fBegin, fCapacity);
+      } else {
+         // the adopted memory belongs to someone else and must be left untouched
+         CopyAdopted(begin(), end(), newBegin, std::is_copy_constructible<T>{});
+      }
+      fBegin = newBegin;
+      fCapacity = CheckedSize(newCapacity);
+   }
+
+   void Grow(size_type minCapacity)
+   {
+      const auto newCapacity = GetNewCapacity(minCapacity);
+      CheckedSize(newCapacity);
+      T *newBegin = Allocate(newCapacity);
+      try {
+         MoveToBuffer(newBegin, newCapacity);
+      } catch (...) {
+         Deallocate(newBegin, newCapacity);
+         throw;
+      }
+   }
+
+   /// Make room for n elements. Adopted memory is replaced by owned memory as soon as elements are added.
+   void ReserveForGrowth(size_type n)
+   {
+      if (n > capacity())
+         Grow(n);
+   }
+
+   void Truncate(size_type count)
+   {
+      DestroyRange(begin() + count, end());
+      fSize = static_cast<int>(count);
+   }
+
+   template <typename InputIt>
+   void AppendRange(InputIt first, InputIt last, std::input_iterator_tag)
+   {
+      for (; first != last; ++first)
+         emplace_back(*first);
+   }
+
+   template <typename ForwardIt>
+   void AppendRange(ForwardIt first, ForwardIt last, std::forward_iterator_tag)
+   {
+      const auto n = static_cast<size_type>(std::distance(first, last));
+      ReserveForGrowth(size() + n);
+      std::uninitialized_copy(first, last, end());
+      fSize += static_cast<int>(n);
+   }
+
+   /// Take the elements of other, which is left empty.
+   void StealFrom(RSmallVector &other)
+   {
+      if (!other.IsSmall()) {
+         // heap or adopted memory: take over the pointer
+         fBegin = other.fBegin;
+         fSize = other.fSize;
+         fCapacity = other.fCapacity;
+         other.fBegin = other.InlineBegin();
+         other.fSize = 0;
+         other.fCapacity = static_cast<int>(N);
+      } else {
+         std::uninitialized_copy(std::make_move_iterator(other.begin()), std::make_move_iterator(other.end()),
+                                 fBegin);
+         fSize = other.fSize;
+         other.clear();
+      }
+   }
+
+   template <typename... Args>
+   void GrowAndEmplaceBack(Args &&... args)
+   {
+      // the new element is constructed first, as args may refer to the current elements
+      const auto newCapacity = GetNewCapacity(size() + 1);
+      CheckedSize(newCapacity);
+      T *newBegin = Allocate(newCapacity);
+      try {
+         ::new (static_cast<void *>(newBegin + size())) T(std::forward<Args>(args)...);
+      } catch (...) {
+         Deallocate(newBegin, newCapacity);
+         throw;
+      }
+      try {
+         MoveToBuffer(newBegin, newCapacity);
+      } catch (...) {
+         newBegin[size()].~T();
+         Deallocate(newBegin, newCapacity);
+         throw;
+      }
+      ++fSize;
+   }
+
+public:
+   RSmallVector() : fBegin(InlineBegin()) {}
+
+   explicit RSmallVector(size_type count) : RSmallVector() { resize(count); }
+
+   RSmallVector(size_type count, const T &value) : RSmallVector() { resize(count, value); }
+
+   template <typename InputIt, typename = typename std::iterator_traits<InputIt>::iterator_category>
+   RSmallVector(InputIt first, InputIt last) : RSmallVector()
+   {
+      AppendRange(first, last, typename std::iterator_traits<InputIt>::iterator_category{});
+   }
+
+   RSmallVector(std::initializer_list<T> init) : RSmallVector(init.begin(), init.end()) {}
+
+   /// Adopt the memory region of n elements that starts at p
+   RSmallVector(T *p, size_type n) : fBegin(p), fSize(CheckedSize(n)), fCapacity(-1) {}
+
+   RSmallVector(const RSmallVector &other) : RSmallVector(other.begin(), other.end()) {}
+
+   RSmallVector(RSmallVector &&other) : RSmallVector() { StealFrom(other); }
+
+   ~RSmallVector() { Release(); }
+
+   RSmallVector &operator=(const RSmallVector &other)
+   {
+      if (this != &other)
+         assign(other.begin(), other.end());
+      return *this;
+   }
+
+   RSmallVector &operator=(RSmallVector &&other)
+   {
+      if (this != &other) {
+         Release();
+         StealFrom(other);
+      }
+      return *this;
+   }
+
+   RSmallVector &operator=(std::initializer_list<T> ilist)
+   {
+      assign(ilist.begin(), ilist.end());
+      return *this;
+   }
+
+   /// Replace the elements with the ones in [first, last). Adopted memory is released.
+   template <typename InputIt>
+   void assign(InputIt first, InputIt last)
+   {
+      if (OwnsMemory()) {
+         clear();
+      } else {
+         Release();
+      }
+      AppendRange(first, last, typename std::iterator_traits<InputIt>::iterator_category{});
+   }
+
+   // accessors
+   reference at(size_type pos)
+   {
+      if (pos >= size())
+         throw std::out_of_range("RVec::at: index " + std::to_string(pos) + " is out of range for an RVec of size " +
+                                 std::to_string(size()) + ".");
+      return fBegin[pos];
+   }
+   const_reference at(size_type pos) const { return const_cast<RSmallVector *>(this)->at(pos); }
+   reference operator[](size_type pos) { return fBegin[pos]; }
+   const_reference operator[](size_type pos) const { return fBegin[pos]; }
+   reference front() { return fBegin[0]; }
+   const_reference front() const { return fBegin[0]; }
+   reference back() { return fBegin[fSize - 1]; }
+   const_reference back() const { return fBegin[fSize - 1]; }
+   pointer data() noexcept { return fBegin; }
+   const_pointer data() const noexcept { return fBegin; }
+
+   // iterators
+   iterator begin() noexcept { return fBegin; }
+   const_iterator begin() const noexcept { return fBegin; }
+   const_iterator cbegin() const noexcept { return fBegin; }
+   iterator end() noexcept { return fBegin + fSize; }
+   const_iterator end() const noexcept { return fBegin + fSize; }
+   const_iterator cend() const noexcept { return fBegin + fSize; }
+   reverse_iterator rbegin() noexcept { return reverse_iterator(end()); }
+   const_reverse_iterator rbegin() const noexcept { return const_reverse_iterator(end()); }
+   const_reverse_iterator crbegin() const noexcept { return const_reverse_iterator(end()); }
+   reverse_iterator rend() noexcept { return reverse_iterator(begin()); }
+   const_reverse_iterator rend() const noexcept { return const_reverse_iterator(begin()); }
+   const_reverse_iterator crend() const noexcept { return const_reverse_iterator(begin()); }
+
+   // capacity
+   bool empty() const noexcept { return fSize == 0; }
+   size_type size() const noexcept { return fSize; }
+   size_type max_size() const noexcept { return std::numeric_limits<int>::max(); }
+   /// The number of elements that can be stored without reallocations. For adopted memory, its size.
+   size_type capacity() const noexcept { return OwnsMemory() ? fCapacity : fSize; }
+   void reserve(size_type newCapacity)
+   {
+      if (newCapacity > capacity())
+         Grow(newCapacity);
+   }
+   /// Move the elements to the inline buffer if they fit, or to a heap buffer of the exact size.
+   void shrink_to_fit()
+   {
+      if (!OwnsMemory() || IsSmall() || size() == capacity())
+         return;
+      RSmallVector tmp(std::make_move_iterator(begin()), std::make_move_iterator(end()));
+      *this = std::move(tmp);
+   }
+
+   // modifiers
+   void clear() noexcept
+   {
+      DestroyRange(begin(), end());
+      fSize = 0;
+   }
+   iterator erase(const_iterator pos) { return erase(pos, pos + 1); }
+   iterator erase(const_iterator first, const_iterator last)
+   {
+      auto *f = fBegin + (first - cbegin());
+      auto *l = fBegin + (last - cbegin());
+      auto *newEnd = std::move(l, end(), f);
+      DestroyRange(newEnd, end());
+      fSize = static_cast<int>(newEnd - fBegin);
+      return f;
+   }
+   void push_back(const T &value) { emplace_back(value); }
+   void push_back(T &&value) { emplace_back(std::move(value)); }
+   template <typename... Args>
+   reference emplace_back(Args &&... args)
+   {
+      if (size() < capacity()) {
+         ::new (static_cast<void *>(end())) T(std::forward<Args>(args)...);
+         ++fSize;
+      } else {
+         GrowAndEmplaceBack(std::forward<Args>(args)...);
+      }
+      return back();
+   }
+   iterator emplace(const_iterator pos, T value)
+   {
+      const auto idx = pos - cbegin();
+      emplace_back(std::move(value));
+      std::rotate(begin() + idx, end() - 1, end());
+      return begin() + idx;
+   }
+   void pop_back()
+   {
+      DestroyRange(end() - 1, end());
+      --fSize;
+   }
+   void resize(size_type count)
+   {
+      if (count <= size()) {
+         Truncate(count);
+         return;
+      }
+      ReserveForGrowth(count);
+      for (auto *p = end(); p != fBegin + count; ++p)
+         ::new (static_cast<void *>(p)) T();
+      fSize = CheckedSize(count);
+   }
+   void resize(size_type count, const T &value)
+   {
+      if (count <= size()) {
+         Truncate(count);
+         return;
+      }
+      const T copy(value); // value might be one of our elements
+      ReserveForGrowth(count);
+      std::uninitialized_fill(end(), fBegin + count, copy);
+      fSize = CheckedSize(count);
+   }
+   void swap(RSmallVector &other)
+   {
+      if (this == &other)
+         return;
+      if (!IsSmall() && !other.IsSmall()) {
+         std::swap(fBegin, other.fBegin);
+         std::swap(fSize, other.fSize);
+         std::swap(fCapacity, other.fCapacity);
+         return;
+      }
+      RSmallVector tmp(std::move(other));
+      other = std::move(*this);
+      *this = std::move(tmp);
+   }
+};
+
+/// Explicitly vectorized implementations of the RVec helpers for float and double: the library is built with a
+/// version of them for each instruction set supported by the compiler, and calls the best one the CPU supports.
+/// The comparisons yield 0 and 1 like the RVec comparison operators; the selections of Where are blends and the
+/// ones of the boolean mask indexing are compressions, which store all elements of v and take the selected ones into
+/// account: out must have space for n elements.
+namespace Kernels {
+enum class ECompare : char { kLess, kGreater, kLessEqual, kGreaterEqual, kEqual, kNotEqual };
+
+/// The instruction set the kernels in use were compiled for, e.g. "AVX2" or "GENERIC"
+const char *GetArchitecture();
+
+float Sum(const float *v, std::size_t n);
+double Sum(const double *v, std::size_t n);
+float Dot(const float *v0, const float *v1, std::size_t n);
+double Dot(const double *v0, const double *v1, std::size_t n);
+/// The index of the first occurrence of the greatest element, like std::max_element. 0 if n is 0.
+std::size_t ArgMax(const float *v, std::size_t n);
+std::size_t ArgMax(const double *v, std::size_t n);
+/// The index of the first occurrence of the smallest element, like std::min_element. 0 if n is 0.
+std::size_t ArgMin(const float *v, std::size_t n);
+std::size_t ArgMin(const double *v, std::size_t n);
+void Sqrt(const float *v, float *out, std::size_t n);
+void Sqrt(const double *v, double *out, std::size_t n);
+void Compare(const float *v, ECompare op, float y, int *out, std::size_t n);
+void Compare(const double *v, ECompare op, double y, int *out, std::size_t n);
+void Compare(const float *v0, ECompare op, const float *v1, int *out, std::size_t n);
+void Compare(const double *v0, ECompare op, const double *v1, int *out, std::size_t n);
+void Where(const int *c, const float *v1, const float *v2, float *out, std::size_t n);
+void Where(const int *c, const double *v1, const double *v2, double *out, std::size_t n);
+void Where(const int *c, const float *v1, float v2, float *out, std::size_t n);
+void Where(const int *c, const double *v1, double v2, double *out, std::size_t n);
+void Where(const int *c, float v1, const float *v2, float *out, std::size_t n);
+void Where(const int *c, double v1, const double *v2, double *out, std::size_t n);
+void Where(const int *c, float v1, float v2, float *out, std::size_t n);
+void Where(const int *c, double v1, double v2, double *out, std::size_t n);
+/// Store the elements of v for which c is not zero at the beginning of out and return their number
+std::size_t Compress(const float *v, const int *c, float *out, std::size_t n);
+std::size_t Compress(const double *v, const int *c, double *out, std::size_t n);
+/// The kinematic helpers of the four-vectors given by their (pt, eta, phi, mass) coordinates, computed with fast
+/// branchless approximations of sin, cos and sinh accurate to a few ulps
+void InvariantMasses(const float *pt1, const float *eta1, const float *phi1, const float *mass1, const float *pt2,
+                     const float *eta2, const float *phi2, const float *mass2, float *out, std::size_t n);
+void InvariantMasses(const double *pt1, const double *eta1, const double *phi1, const double *mass1,
+                     const double *pt2, const double *eta2, const double *phi2, const double *mass2, double *out,
+                     std::size_t n);
+float InvariantMass(const float *pt, const float *eta, const float *phi, const float *mass, std::size_t n);
+double InvariantMass(const double *pt, const double *eta, const double *phi, const double *mass, std::size_t n);
+void DeltaR2(const float *eta1, const float *eta2, const float *phi1, const float *phi2, float c, float *out,
+             std::size_t n);
+void DeltaR2(const double *eta1, const double *eta2, const double *phi1, const double *phi2, double c, double *out,
+             std::size_t n);
+
+/// The swapped comparison, i.e. x op y == y Swap(op) x
+constexpr ECompare Swap(ECompare op)
+{
+   return op == ECompare::kLess
+             ? ECompare::kGreater
+             : op == ECompare::kGreater
+                  ? ECompare::kLess
+                  : op == ECompare::kLessEqual ? ECompare::kGreaterEqual
+                                               : op == ECompare::kGreaterEqual ? ECompare::kLessEqual : op;
+}
+} // namespace Kernels
+
+/// Whether the helpers of RVec<T> operating with U go through the vectorized Kernels
+template <typename T, typename U = T>
+using RUseKernels = std::integral_constant<bool, (std::is_same<T, float>::value || std::is_same<T, double>::value) &&
+                                                    std::is_same<T, U>::value>;
+
+/// Whether comparing the elements of RVec<T> with a Y goes through the vectorized Kernels: Y must be converted to T
+/// by the comparison
+template <typename T, typename Y, bool = RUseKernels<T>::value &&std::is_arithmetic<Y>::value>
+struct RUseCompareKernels : std::false_type {
+};
+
+template <typename T, typename Y>
+struct RUseCompareKernels<T, Y, true> : std::is_same<typename std::common_type<T, Y>::type, T> {
+};
+
+template <typename T, typename V>
+ROOT::VecOps::RVec<T> CompressImpl(const ROOT::VecOps::RVec<T> &v, const ROOT::VecOps::RVec<V> &conds, std::false_type)
+{
+   const std::size_t n = conds.size();
+   ROOT::VecOps::RVec<T> ret;
+   ret.reserve(n);
+   for (std::size_t i = 0; i < n; ++i)
+      if (conds[i])
+         ret.emplace_back(v[i]);
+   return ret;
+}
+
+template <typename T, typename V>
+ROOT::VecOps::RVec<T> CompressImpl(const ROOT::VecOps::RVec<T> &v, const ROOT::VecOps::RVec<V> &conds, std::true_type)
+{
+   ROOT::VecOps::RVec<T> ret(v.size());
+   ret.resize(Kernels::Compress(v.data(), conds.data(), ret.data(), v.size()));
+   return ret;
+}
+
 } // End of VecOps NS
 } // End of Internal NS
 
@@ -151,6 +652,9 @@ the manipulation and analysis of the data in the RVec.
 - [Reference for the RVec class](\ref RVecdoxyref)
 
 Also see the [reference for RVec helper functions](https://root.cern/doc/master/namespaceROOT_1_1VecOps.html).
+For RVecs of float and double, Sum, Mean, Dot, Max, Min, ArgMax, ArgMin, sqrt, the comparison operators, Where and
+the indexing with a mask of RVec<int> are explicitly vectorized: the version for the best instruction set supported
+by the CPU (SSE4.1, AVX, AVX2 or AVX512 on x86_64) is chosen at runtime.
 
 \anchor example
 ## Example
@@ -196,6 +700,13 @@ If any method which implies a re-allocation is called, e.g. *emplace_back* or *r
 memory is released and new one is allocated. The previous content is copied in the new memory and
 preserved.
 
+When it owns its memory, a RVec stores a small number of elements inline, within the RVec object itself,
+and only allocates memory on the heap for larger collections. The number of inline elements depends on the
+type: as many as fit, together with the bookkeeping of the RVec, in a cache line (64 bytes), and at least 8
+unless that takes more than 1 kB, e.g. 12 floats or 8 doubles. Small collections such as the selected objects
+of an event therefore never allocate memory. As a consequence, moving a small RVec moves its elements, and
+pointers to the elements of a RVec are invalidated when the RVec is moved or swapped.
+
 \anchor sorting
 ## Sorting and manipulation of indices
 
@@ -283,30 +794,36 @@ hpt->Draw();
 template <typename T>
 class RVec {
    // Here we check if T is a bool. This is done in order to decide what type
-   // to use as a storage. If T is anything but bool, we use a vector<T, RAdoptAllocator<T>>.
-   // If T is a bool, we opt for a plain vector<bool> otherwise we'll not be able
+   // to use as a storage. If T is anything but bool, we use a RSmallVector<T>, which stores small collections
+   // inline. If T is a bool, we opt for a plain vector<bool> otherwise we'll not be able
    // to write the data type given the shortcomings of TCollectionProxy design.
    static constexpr const auto IsVecBool = std::is_same<bool, T>::value;
+   using Storage_t = typename std::conditional<
+      IsVecBool, std::vector<bool>,
+      ::ROOT::Internal::VecOps::RSmallVector<T, ::ROOT::Internal::VecOps::RVecInlineStorageSize<T>::value>>::type;
+
 public:
+   /// The storage RVec used up to ROOT 6.24. It is not used by RVec anymore, but its dictionaries are still provided
+   /// to read data written with it.
    using Impl_t = typename std::conditional<IsVecBool, std::vector<bool>, std::vector<T, ::ROOT::Detail::VecOps::RAdoptAllocator<T>>>::type;
-   using value_type = typename Impl_t::value_type;
-   using size_type = typename Impl_t::size_type;
-   using difference_type = typename Impl_t::difference_type;
-   using reference = typename Impl_t::reference;
-   using const_reference = typename Impl_t::const_reference;
-   using pointer = typename Impl_t::pointer;
-   using const_pointer = typename Impl_t::const_pointer;
+   using value_type = typename Storage_t::value_type;
+   using size_type = typename Storage_t::size_type;
+   using difference_type = typename Storage_t::difference_type;
+   using reference = typename Storage_t::reference;
+   using const_reference = typename Storage_t::const_reference;
+   using pointer = typename Storage_t::pointer;
+   using const_pointer = typename Storage_t::const_pointer;
    // The data_t and const_data_t types are chosen to be void in case T is a bool.
    // This way we can as elegantly as in the STL return void upon calling the data() method.
-   using data_t = typename std::conditional<IsVecBool, void, typename Impl_t::pointer>::type;
-   using const_data_t = typename std::conditional<IsVecBool, void, typename Impl_t::const_pointer>::type;
-   using iterator = typename Impl_t::iterator;
-   using const_iterator = typename Impl_t::const_iterator;
-   using reverse_iterator = typename Impl_t::reverse_iterator;
-   using const_reverse_iterator = typename Impl_t::const_reverse_iterator;
+   using data_t = typename std::conditional<IsVecBool, void, typename Storage_t::pointer>::type;
+   using const_data_t = typename std::conditional<IsVecBool, void, typename Storage_t::const_pointer>::type;
+   using iterator = typename Storage_t::iterator;
+   using const_iterator = typename Storage_t::const_iterator;
+   using reverse_iterator = typename Storage_t::reverse_iterator;
+   using const_reverse_iterator = typename Storage_t::const_reverse_iterator;
 
 private:
-   Impl_t fData;
+   Storage_t fData;
 
 public:
    // constructors
@@ -322,7 +839,7 @@ public:
 
    RVec(const std::vector<T> &v) : fData(v.cbegin(), v.cend()) {}
 
-   RVec(pointer p, size_type n) : fData(n, T(), ROOT::Detail::VecOps::RAdoptAllocator<T>(p)) {}
+   RVec(pointer p, size_type n) : fData(p, n) {}
 
    template <class InputIt>
    RVec(InputIt first, InputIt last) : fData(first, last) {}
@@ -338,7 +855,7 @@ public:
 
    RVec<T> &operator=(RVec<T> &&v)
    {
-      std::swap(fData, v.fData);
+      fData = std::move(v.fData);
       return *this;
    }
 
@@ -375,12 +892,9 @@ public:
       if (n != size())
          throw std::runtime_error("Cannot index RVec with condition vector of different size");
 
-      RVec<T> ret;
-      ret.reserve(n);
-      for (size_type i = 0; i < n; ++i)
-         if (conds[i])
-            ret.emplace_back(fData[i]);
-      return ret;
+      using UseKernels_t = std::integral_constant<bool, Internal::VecOps::RUseKernels<T>::value &&
+                                                           std::is_same<V, int>::value>;
+      return Internal::VecOps::CompressImpl(*this, conds, UseKernels_t{});
    }
 
    reference front() { return fData.front(); }
@@ -431,9 +945,270 @@ public:
    void pop_back() { fData.pop_back(); }
    void resize(size_type count) { fData.resize(count); }
    void resize(size_type count, const value_type &value) { fData.resize(count, value); }
-   void swap(RVec<T> &other) { std::swap(fData, other.fData); }
+   void swap(RVec<T> &other) { fData.swap(other.fData); }
 };
 
+} // End of VecOps NS
+
+namespace Internal {
+namespace VecOps {
+
+template <typename T, typename R>
+R SumImpl(const ROOT::VecOps::RVec<T> &v, const R &zero, std::false_type)
+{
+   return std::accumulate(v.begin(), v.end(), zero);
+}
+
+template <typename T>
+T SumImpl(const ROOT::VecOps::RVec<T> &v, const T &zero, std::true_type)
+{
+   return zero + Kernels::Sum(v.data(), v.size());
+}
+
+template <typename T, typename V>
+auto DotImpl(const ROOT::VecOps::RVec<T> &v0, const ROOT::VecOps::RVec<V> &v1, std::false_type)
+   -> decltype(v0[0] * v1[0])
+{
+   return std::inner_product(v0.begin(), v0.end(), v1.begin(), decltype(v0[0] * v1[0])(0));
+}
+
+template <typename T>
+T DotImpl(const ROOT::VecOps::RVec<T> &v0, const ROOT::VecOps::RVec<T> &v1, std::true_type)
+{
+   return Kernels::Dot(v0.data(), v1.data(), v0.size());
+}
+
+template <typename T>
+ROOT::VecOps::RVec<T> InvariantMassesImpl(const ROOT::VecOps::RVec<T> &pt1, const ROOT::VecOps::RVec<T> &eta1,
+                                          const ROOT::VecOps::RVec<T> &phi1, const ROOT::VecOps::RVec<T> &mass1,
+                                          const ROOT::VecOps::RVec<T> &pt2, const ROOT::VecOps::RVec<T> &eta2,
+                                          const ROOT::VecOps::RVec<T> &phi2, const ROOT::VecOps::RVec<T> &mass2,
+                                          std::false_type)
+{
+   const std::size_t size = pt1.size();
+   ROOT::VecOps::RVec<T> inv_masses(size);
+
+   for (std::size_t i = 0u; i < size; ++i) {
+      // Conversion from (pt, eta, phi, mass) to (x, y, z, e) coordinate system
+      const auto x1 = pt1[i] * std::cos(phi1[i]);
+      const auto y1 = pt1[i] * std::sin(phi1[i]);
+      const auto z1 = pt1[i] * std::sinh(eta1[i]);
+      const auto e1 = std::sqrt(x1 * x1 + y1 * y1 + z1 * z1 + mass1[i] * mass1[i]);
+
+      const auto x2 = pt2[i] * std::cos(phi2[i]);
+      const auto y2 = pt2[i] * std::sin(phi2[i]);
+      const auto z2 = pt2[i] * std::sinh(eta2[i]);
+      const auto e2 = std::sqrt(x2 * x2 + y2 * y2 + z2 * z2 + mass2[i] * mass2[i]);
+
+      // Addition of particle four-vector elements
+      const auto e = e1 + e2;
+      const auto x = x1 + x2;
+      const auto y = y1 + y2;
+      const auto z = z1 + z2;
+
+      inv_masses[i] = std::sqrt(e * e - x * x - y * y - z * z);
+   }
+
+   // Return invariant mass with (+, -, -, -) metric
+   return inv_masses;
+}
+
+template <typename T>
+ROOT::VecOps::RVec<T> InvariantMassesImpl(const ROOT::VecOps::RVec<T> &pt1, const ROOT::VecOps::RVec<T> &eta1,
+                                          const ROOT::VecOps::RVec<T> &phi1, const ROOT::VecOps::RVec<T> &mass1,
+                                          const ROOT::VecOps::RVec<T> &pt2, const ROOT::VecOps::RVec<T> &eta2,
+                                          const ROOT::VecOps::RVec<T> &phi2, const ROOT::VecOps::RVec<T> &mass2,
+                                          std::true_type)
+{
+   ROOT::VecOps::RVec<T> inv_masses(pt1.size());
+   Kernels::InvariantMasses(pt1.data(), eta1.data(), phi1.data(), mass1.data(), pt2.data(), eta2.data(), phi2.data(),
+                            mass2.data(), inv_masses.data(), pt1.size());
+   return inv_masses;
+}
+
+template <typename T>
+T InvariantMassImpl(const ROOT::VecOps::RVec<T> &pt, const ROOT::VecOps::RVec<T> &eta,
+                    const ROOT::VecOps::RVec<T> &phi, const ROOT::VecOps::RVec<T> &mass, std::false_type)
+{
+   const std::size_t size = pt.size();
+
+   T x_sum = 0.;
+   T y_sum = 0.;
+   T z_sum = 0.;
+   T e_sum = 0.;
+
+   for (std::size_t i = 0u; i < size; ++ i) {
+      // Convert to (e, x, y, z) coordinate system and update sums
+      const auto x = pt[i] * std::cos(phi[i]);
+      x_sum += x;
+      const auto y = pt[i] * std::sin(phi[i]);
+      y_sum += y;
+      const auto z = pt[i] * std::sinh(eta[i]);
+      z_sum += z;
+      const auto e = std::sqrt(x * x + y * y + z * z + mass[i] * mass[i]);
+      e_sum += e;
+   }
+
+   // Return invariant mass with (+, -, -, -) metric
+   return std::sqrt(e_sum * e_sum - x_sum * x_sum - y_sum * y_sum - z_sum * z_sum);
+}
+
+template <typename T>
+T InvariantMassImpl(const ROOT::VecOps::RVec<T> &pt, const ROOT::VecOps::RVec<T> &eta,
+                    const ROOT::VecOps::RVec<T> &phi, const ROOT::VecOps::RVec<T> &mass, std::true_type)
+{
+   return Kernels::InvariantMass(pt.data(), eta.data(), phi.data(), mass.data(), pt.size());
+}
+
+/// DeltaPhi and the arithmetic operators of RVec are found by argument dependent lookup
+template <typename T>
+ROOT::VecOps::RVec<T> DeltaR2Impl(const ROOT::VecOps::RVec<T> &eta1, const ROOT::VecOps::RVec<T> &eta2,
+                                  const ROOT::VecOps::RVec<T> &phi1, const ROOT::VecOps::RVec<T> &phi2, const T c,
+                                  std::false_type)
+{
+   const auto dphi = DeltaPhi(phi1, phi2, c);
+   return (eta1 - eta2) * (eta1 - eta2) + dphi * dphi;
+}
+
+template <typename T>
+ROOT::VecOps::RVec<T> DeltaR2Impl(const ROOT::VecOps::RVec<T> &eta1, const ROOT::VecOps::RVec<T> &eta2,
+                                  const ROOT::VecOps::RVec<T> &phi1, const ROOT::VecOps::RVec<T> &phi2, const T c,
+                                  std::true_type)
+{
+   const std::size_t size = eta1.size();
+   R__ASSERT(eta2.size() == size && phi1.size() == size && phi2.size() == size);
+   ROOT::VecOps::RVec<T> dr2(size);
+   Kernels::DeltaR2(eta1.data(), eta2.data(), phi1.data(), phi2.data(), c, dr2.data(), size);
+   return dr2;
+}
+
+template <typename T>
+std::size_t ArgMaxImpl(const ROOT::VecOps::RVec<T> &v, std::false_type)
+{
+   return std::distance(v.begin(), std::max_element(v.begin(), v.end()));
+}
+
+template <typename T>
+std::size_t ArgMaxImpl(const ROOT::VecOps::RVec<T> &v, std::true_type)
+{
+   return Kernels::ArgMax(v.data(), v.size());
+}
+
+template <typename T>
+std::size_t ArgMinImpl(const ROOT::VecOps::RVec<T> &v, std::false_type)
+{
+   return std::distance(v.begin(), std::min_element(v.begin(), v.end()));
+}
+
+template <typename T>
+std::size_t ArgMinImpl(const ROOT::VecOps::RVec<T> &v, std::true_type)
+{
+   return Kernels::ArgMin(v.data(), v.size());
+}
+
+/// f(x, y) is the comparison of the element x of v with y
+template <typename T, typename Y, typename F>
+ROOT::VecOps::RVec<int> CompareImpl(const ROOT::VecOps::RVec<T> &v, Kernels::ECompare, const Y &y, F f, std::false_type)
+{
+   ROOT::VecOps::RVec<int> ret(v.size());
+   std::transform(v.begin(), v.end(), ret.begin(), [&y, &f](const T &x) -> int { return f(x, y); });
+   return ret;
+}
+
+template <typename T, typename Y, typename F>
+ROOT::VecOps::RVec<int> CompareImpl(const ROOT::VecOps::RVec<T> &v, Kernels::ECompare op, const Y &y, F, std::true_type)
+{
+   ROOT::VecOps::RVec<int> ret(v.size());
+   Kernels::Compare(v.data(), op, T(y), ret.data(), v.size());
+   return ret;
+}
+
+template <typename T0, typename T1, typename F>
+ROOT::VecOps::RVec<int> CompareImpl(const ROOT::VecOps::RVec<T0> &v0, Kernels::ECompare,
+                                    const ROOT::VecOps::RVec<T1> &v1, F f, std::false_type)
+{
+   ROOT::VecOps::RVec<int> ret(v0.size());
+   std::transform(v0.begin(), v0.end(), v1.begin(), ret.begin(), f);
+   return ret;
+}
+
+template <typename T, typename F>
+ROOT::VecOps::RVec<int> CompareImpl(const ROOT::VecOps::RVec<T> &v0, Kernels::ECompare op,
+                                    const ROOT::VecOps::RVec<T> &v1, F, std::true_type)
+{
+   ROOT::VecOps::RVec<int> ret(v0.size());
+   Kernels::Compare(v0.data(), op, v1.data(), ret.data(), v0.size());
+   return ret;
+}
+
+/// The i-th element of the arguments of Where for RVecs, the argument itself for scalars
+template <typename T>
+typename ROOT::VecOps::RVec<T>::const_reference ElementOrScalar(const ROOT::VecOps::RVec<T> &v, std::size_t i)
+{
+   return v[i];
+}
+
+template <typename T>
+const T &ElementOrScalar(const T &x, std::size_t)
+{
+   return x;
+}
+
+/// The data of the arguments of Where for RVecs, the argument itself for scalars
+template <typename T>
+const T *DataOrScalar(const ROOT::VecOps::RVec<T> &v)
+{
+   return v.data();
+}
+
+template <typename T>
+T DataOrScalar(const T &x)
+{
+   return x;
+}
+
+template <typename T, typename Y1, typename Y2>
+ROOT::VecOps::RVec<T> WhereImpl(const ROOT::VecOps::RVec<int> &c, const Y1 &v1, const Y2 &v2, std::false_type)
+{
+   const std::size_t size = c.size();
+   ROOT::VecOps::RVec<T> r;
+   r.reserve(size);
+   for (std::size_t i = 0; i < size; i++) {
+      r.emplace_back(c[i] != 0 ? ElementOrScalar<T>(v1, i) : ElementOrScalar<T>(v2, i));
+   }
+   return r;
+}
+
+template <typename T, typename Y1, typename Y2>
+ROOT::VecOps::RVec<T> WhereImpl(const ROOT::VecOps::RVec<int> &c, const Y1 &v1, const Y2 &v2, std::true_type)
+{
+   ROOT::VecOps::RVec<T> r(c.size());
+   Kernels::Where(c.data(), DataOrScalar<T>(v1), DataOrScalar<T>(v2), r.data(), c.size());
+   return r;
+}
+
+/// R is the type of the result, see ROOT::VecOps::PromoteType
+template <typename R, typename T>
+ROOT::VecOps::RVec<R> SqrtImpl(const ROOT::VecOps::RVec<T> &v, std::false_type)
+{
+   ROOT::VecOps::RVec<R> ret(v.size());
+   std::transform(v.begin(), v.end(), ret.begin(), [](const T &x) { return std::sqrt(x); });
+   return ret;
+}
+
+template <typename R, typename T>
+ROOT::VecOps::RVec<T> SqrtImpl(const ROOT::VecOps::RVec<T> &v, std::true_type)
+{
+   ROOT::VecOps::RVec<T> ret(v.size());
+   Kernels::Sqrt(v.data(), ret.data(), v.size());
+   return ret;
+}
+
+} // End of VecOps NS
+} // End of Internal NS
+
+namespace VecOps {
+
 ///@name RVec Unary Arithmetic Operators
 ///@{
 
@@ -544,6 +1319,45 @@ RVEC_ASSIGNMENT_OPERATOR(<<=)
 ///@name RVec Comparison and Logical Operators
 ///@{
 
+#define RVEC_COMPARISON_OPERATOR(OP, KIND)                                                                  \
+template <typename T0, typename T1>                                                                         \
+auto operator OP(const RVec<T0> &v, const T1 &y)                                                            \
+  -> RVec<int> /* avoid std::vector<bool> */                                                                \
+{                                                                                                           \
+   using namespace ROOT::Internal::VecOps;                                                                  \
+   auto op = [](const T0 &x, const T1 &yy) -> int { return x OP yy; };                                      \
+   return CompareImpl(v, Kernels::ECompare::KIND, y, op, RUseCompareKernels<T0, T1>{});                     \
+}                                                                                                           \
+                                                                                                            \
+template <typename T0, typename T1>                                                                         \
+auto operator OP(const T0 &x, const RVec<T1> &v)                                                            \
+  -> RVec<int> /* avoid std::vector<bool> */                                                                \
+{                                                                                                           \
+   using namespace ROOT::Internal::VecOps;                                                                  \
+   auto op = [](const T1 &y, const T0 &xx) -> int { return xx OP y; };                                      \
+   return CompareImpl(v, Kernels::Swap(Kernels::ECompare::KIND), x, op, RUseCompareKernels<T1, T0>{});      \
+}                                                                                                           \
+                                                                                                            \
+template <typename T0, typename T1>                                                                         \
+auto operator OP(const RVec<T0> &v0, const RVec<T1> &v1)                                                    \
+  -> RVec<int> /* avoid std::vector<bool> */                                                                \
+{                                                                                                           \
+   if (v0.size() != v1.size())                                                                              \
+      throw std::runtime_error(ERROR_MESSAGE(OP));                                                          \
+                                                                                                            \
+   using namespace ROOT::Internal::VecOps;                                                                  \
+   auto op = [](const T0 &x, const T1 &y) -> int { return x OP y; };                                        \
+   return CompareImpl(v0, Kernels::ECompare::KIND, v1, op, RUseKernels<T0, T1>{});                          \
+}                                                                                                           \
+
+RVEC_COMPARISON_OPERATOR(<, kLess)
+RVEC_COMPARISON_OPERATOR(>, kGreater)
+RVEC_COMPARISON_OPERATOR(==, kEqual)
+RVEC_COMPARISON_OPERATOR(!=, kNotEqual)
+RVEC_COMPARISON_OPERATOR(<=, kLessEqual)
+RVEC_COMPARISON_OPERATOR(>=, kGreaterEqual)
+#undef RVEC_COMPARISON_OPERATOR
+
 #define RVEC_LOGICAL_OPERATOR(OP)                                              \
 template <typename T0, typename T1>                                            \
 auto operator OP(const RVec<T0> &v, const T1 &y)                               \
@@ -578,12 +1392,6 @@ auto operator OP(const RVec<T0> &v0, const RVec<T1> &v1)                       \
    return ret;                                                                 \
 }                                                                              \
 
-RVEC_LOGICAL_OPERATOR(<)
-RVEC_LOGICAL_OPERATOR(>)
-RVEC_LOGICAL_OPERATOR(==)
-RVEC_LOGICAL_OPERATOR(!=)
-RVEC_LOGICAL_OPERATOR(<=)
-RVEC_LOGICAL_OPERATOR(>=)
 RVEC_LOGICAL_OPERATOR(&&)
 RVEC_LOGICAL_OPERATOR(||)
 #undef RVEC_LOGICAL_OPERATOR
@@ -668,7 +1476,12 @@ RVEC_STD_UNARY_FUNCTION(log2)
 RVEC_STD_UNARY_FUNCTION(log1p)
 
 RVEC_STD_BINARY_FUNCTION(pow)
-RVEC_STD_UNARY_FUNCTION(sqrt)
+// vectorized for float and double
+template <typename T>
+RVec<PromoteType<T>> sqrt(const RVec<T> &v)
+{
+   return ROOT::Internal::VecOps::SqrtImpl<PromoteType<T>>(v, ROOT::Internal::VecOps::RUseKernels<T>{});
+}
 RVEC_STD_UNARY_FUNCTION(cbrt)
 RVEC_STD_BINARY_FUNCTION(hypot)
 
@@ -748,7 +1561,7 @@ auto Dot(const RVec<T> &v0, const RVec<V> &v1) -> decltype(v0[0] * v1[0])
 {
    if (v0.size() != v1.size())
       throw std::runtime_error("Cannot compute inner product of vectors of different sizes");
-   return std::inner_product(v0.begin(), v0.end(), v1.begin(), decltype(v0[0] * v1[0])(0));
+   return ROOT::Internal::VecOps::DotImpl(v0, v1, ROOT::Internal::VecOps::RUseKernels<T, V>{});
 }
 
 /// Sum elements of an RVec
@@ -777,7 +1590,7 @@ auto Dot(const RVec<T> &v0, const RVec<V> &v1) -> decltype(v0[0] * v1[0])
 template <typename T, typename R = T>
 R Sum(const RVec<T> &v, const R zero = R(0))
 {
-   return std::accumulate(v.begin(), v.end(), zero);
+   return ROOT::Internal::VecOps::SumImpl(v, zero, ROOT::Internal::VecOps::RUseKernels<T, R>{});
 }
 
 /// Get the mean of the elements of an RVec
@@ -842,7 +1655,7 @@ R Mean(const RVec<T> &v, const R zero)
 template <typename T>
 T Max(const RVec<T> &v)
 {
-   return *std::max_element(v.begin(), v.end());
+   return v[ROOT::Internal::VecOps::ArgMaxImpl(v, ROOT::Internal::VecOps::RUseKernels<T>{})];
 }
 
 /// Get the smallest element of an RVec
@@ -858,7 +1671,7 @@ T Max(const RVec<T> &v)
 template <typename T>
 T Min(const RVec<T> &v)
 {
-   return *std::min_element(v.begin(), v.end());
+   return v[ROOT::Internal::VecOps::ArgMinImpl(v, ROOT::Internal::VecOps::RUseKernels<T>{})];
 }
 
 /// Get the index of the greatest element of an RVec
@@ -876,7 +1689,7 @@ T Min(const RVec<T> &v)
 template <typename T>
 std::size_t ArgMax(const RVec<T> &v)
 {
-   return std::distance(v.begin(), std::max_element(v.begin(), v.end()));
+   return ROOT::Internal::VecOps::ArgMaxImpl(v, ROOT::Internal::VecOps::RUseKernels<T>{});
 }
 
 /// Get the index of the smallest element of an RVec
@@ -894,7 +1707,7 @@ std::size_t ArgMax(const RVec<T> &v)
 template <typename T>
 std::size_t ArgMin(const RVec<T> &v)
 {
-   return std::distance(v.begin(), std::min_element(v.begin(), v.end()));
+   return ROOT::Internal::VecOps::ArgMinImpl(v, ROOT::Internal::VecOps::RUseKernels<T>{});
 }
 
 /// Get the variance of the elements of an RVec
@@ -1390,14 +2203,7 @@ RVec<T> Intersect(const RVec<T>& v1, const RVec<T>& v2, bool v2_is_sorted = fals
 template <typename T>
 RVec<T> Where(const RVec<int>& c, const RVec<T>& v1, const RVec<T>& v2)
 {
-   using size_type = typename RVec<T>::size_type;
-   const size_type size = c.size();
-   RVec<T> r;
-   r.reserve(size);
-   for (size_type i=0; i<size; i++) {
-      r.emplace_back(c[i] != 0 ? v1[i] : v2[i]);
-   }
-   return r;
+   return ROOT::Internal::VecOps::WhereImpl<T>(c, v1, v2, ROOT::Internal::VecOps::RUseKernels<T>{});
 }
 
 /// Return the elements of v1 if the condition c is true and sets the value v2
@@ -1418,14 +2224,7 @@ RVec<T> Where(const RVec<int>& c, const RVec<T>& v1, const RVec<T>& v2)
 template <typename T>
 RVec<T> Where(const RVec<int>& c, const RVec<T>& v1, T v2)
 {
-   using size_type = typename RVec<T>::size_type;
-   const size_type size = c.size();
-   RVec<T> r;
-   r.reserve(size);
-   for (size_type i=0; i<size; i++) {
-      r.emplace_back(c[i] != 0 ? v1[i] : v2);
-   }
-   return r;
+   return ROOT::Internal::VecOps::WhereImpl<T>(c, v1, v2, ROOT::Internal::VecOps::RUseKernels<T>{});
 }
 
 /// Return the elements of v2 if the condition c is false and sets the value v1
@@ -1446,14 +2245,7 @@ RVec<T> Where(const RVec<int>& c, const RVec<T>& v1, T v2)
 template <typename T>
 RVec<T> Where(const RVec<int>& c, T v1, const RVec<T>& v2)
 {
-   using size_type = typename RVec<T>::size_type;
-   const size_type size = c.size();
-   RVec<T> r;
-   r.reserve(size);
-   for (size_type i=0; i<size; i++) {
-      r.emplace_back(c[i] != 0 ? v1 : v2[i]);
-   }
-   return r;
+   return ROOT::Internal::VecOps::WhereImpl<T>(c, v1, v2, ROOT::Internal::VecOps::RUseKernels<T>{});
 }
 
 /// Return a vector with the value v2 if the condition c is false and sets the
@@ -1472,14 +2264,7 @@ RVec<T> Where(const RVec<int>& c, T v1, const RVec<T>& v2)
 template <typename T>
 RVec<T> Where(const RVec<int>& c, T v1, T v2)
 {
-   using size_type = typename RVec<T>::size_type;
-   const size_type size = c.size();
-   RVec<T> r;
-   r.reserve(size);
-   for (size_type i=0; i<size; i++) {
-      r.emplace_back(c[i] != 0 ? v1 : v2);
-   }
-   return r;
+   return ROOT::Internal::VecOps::WhereImpl<T>(c, v1, v2, ROOT::Internal::VecOps::RUseKernels<T>{});
 }
 
 /// Return the concatenation of two RVecs.
@@ -1584,11 +2369,11 @@ RVec<T> DeltaPhi(T v1, const RVec<T>& v2, const T c = M_PI)
 /// of the given collections eta1, eta2, phi1 and phi2. The angle \f$\phi\f$ can
 /// be set to radian or degrees using the optional argument c, see the documentation
 /// of the DeltaPhi helper.
+/// For float and double, the computation is vectorized.
 template <typename T>
 RVec<T> DeltaR2(const RVec<T>& eta1, const RVec<T>& eta2, const RVec<T>& phi1, const RVec<T>& phi2, const T c = M_PI)
 {
-   const auto dphi = DeltaPhi(phi1, phi2, c);
-   return (eta1 - eta2) * (eta1 - eta2) + dphi * dphi;
+   return ROOT::Internal::VecOps::DeltaR2Impl(eta1, eta2, phi1, phi2, c, ROOT::Internal::VecOps::RUseKernels<T>{});
 }
 
 /// Return the distance on the \f$\eta\f$-\f$\phi\f$ plane (\f$\Delta R\f$) from
@@ -1623,6 +2408,8 @@ T DeltaR(T eta1, T eta2, T phi1, T phi2, const T c = M_PI)
 ///
 /// The function computes the invariant mass of two particles with the four-vectors
 /// (pt1, eta2, phi1, mass1) and (pt2, eta2, phi2, mass2).
+/// For float and double, the computation is vectorized, with fast approximations of the trigonometric and
+/// hyperbolic functions accurate to a few ulps.
 template <typename T>
 RVec<T> InvariantMasses(
         const RVec<T>& pt1, const RVec<T>& eta1, const RVec<T>& phi1, const RVec<T>& mass1,
@@ -1633,31 +2420,8 @@ RVec<T> InvariantMasses(
    R__ASSERT(eta1.size() == size && phi1.size() == size && mass1.size() == size);
    R__ASSERT(pt2.size() == size && phi2.size() == size && mass2.size() == size);
 
-   RVec<T> inv_masses(size);
-
-   for (std::size_t i = 0u; i < size; ++i) {
-      // Conversion from (pt, eta, phi, mass) to (x, y, z, e) coordinate system
-      const auto x1 = pt1[i] * std::cos(phi1[i]);
-      const auto y1 = pt1[i] * std::sin(phi1[i]);
-      const auto z1 = pt1[i] * std::sinh(eta1[i]);
-      const auto e1 = std::sqrt(x1 * x1 + y1 * y1 + z1 * z1 + mass1[i] * mass1[i]);
-
-      const auto x2 = pt2[i] * std::cos(phi2[i]);
-      const auto y2 = pt2[i] * std::sin(phi2[i]);
-      const auto z2 = pt2[i] * std::sinh(eta2[i]);
-      const auto e2 = std::sqrt(x2 * x2 + y2 * y2 + z2 * z2 + mass2[i] * mass2[i]);
-
-      // Addition of particle four-vector elements
-      const auto e = e1 + e2;
-      const auto x = x1 + x2;
-      const auto y = y1 + y2;
-      const auto z = z1 + z2;
-
-      inv_masses[i] = std::sqrt(e * e - x * x - y * y - z * z);
-   }
-
-   // Return invariant mass with (+, -, -, -) metric
-   return inv_masses;
+   return ROOT::Internal::VecOps::InvariantMassesImpl(pt1, eta1, phi1, mass1, pt2, eta2, phi2, mass2,
+                                                      ROOT::Internal::VecOps::RUseKernels<T>{});
 }
 
 /// Return the invariant mass of multiple particles given the collections of the
@@ -1665,6 +2429,8 @@ RVec<T> InvariantMasses(
 ///
 /// The function computes the invariant mass of multiple particles with the
 /// four-vectors (pt, eta, phi, mass).
+/// For float and double, the computation is vectorized, with fast approximations of the trigonometric and
+/// hyperbolic functions accurate to a few ulps.
 template <typename T>
 T InvariantMass(const RVec<T>& pt, const RVec<T>& eta, const RVec<T>& phi, const RVec<T>& mass)
 {
@@ -1672,25 +2438,7 @@ T InvariantMass(const RVec<T>& pt, const RVec<T>& eta, const RVec<T>& phi, const
 
    R__ASSERT(eta.size() == size && phi.size() == size && mass.size() == size);
 
-   T x_sum = 0.;
-   T y_sum = 0.;
-   T z_sum = 0.;
-   T e_sum = 0.;
-
-   for (std::size_t i = 0u; i < size; ++ i) {
-      // Convert to (e, x, y, z) coordinate system and update sums
-      const auto x = pt[i] * std::cos(phi[i]);
-      x_sum += x;
-      const auto y = pt[i] * std::sin(phi[i]);
-      y_sum += y;
-      const auto z = pt[i] * std::sinh(eta[i]);
-      z_sum += z;
-      const auto e = std::sqrt(x * x + y * y + z * z + mass[i] * mass[i]);
-      e_sum += e;
-   }
-
-   // Return invariant mass with (+, -, -, -) metric
-   return std::sqrt(e_sum * e_sum - x_sum * x_sum - y_sum * y_sum - z_sum * z_sum);
+   return ROOT::Internal::VecOps::InvariantMassImpl(pt, eta, phi, mass, ROOT::Internal::VecOps::RUseKernels<T>{});
 }
 
 ////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,639 @@
+/*************************************************************************
+ * Copyright (C) 1995-2021, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+// The vectorized kernels of the RVec helpers for float and double.
+//
+// This file is compiled several times, once per instruction set, with RVEC_ARCH set to the name of the namespace the
+// kernels of that instruction set go in (see math/vecops/CMakeLists.txt). The loops are written such that the
+// compilers vectorize them without -ffast-math: reductions go through as many independent accumulators as fit in
+// 64 bytes, selections are branchless and become blend instructions. The reductions accumulate in the same order for
+// all instruction sets, so that the results do not depend on the CPU.
+//
+// Everything but GetKernels() has internal linkage, and no inline function of a header is used: the linker could
+// otherwise pick code compiled for an instruction set the CPU does not support for the rest of the library.
+
+#include "RVecKernels.hxx"
+
+#if defined(__AVX512F__) && defined(__AVX512VL__)
+#include <immintrin.h>
+#endif
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstring>
+#include <limits>
+
+#ifndef RVEC_ARCH
+#define RVEC_ARCH GENERIC
+#endif
+
+#define RVEC_STRINGIFY_IMPL(X) #X
+#define RVEC_STRINGIFY(X) RVEC_STRINGIFY_IMPL(X)
+
+namespace ROOT {
+namespace Internal {
+namespace VecOps {
+namespace RVEC_ARCH {
+
+namespace {
+
+using ECompare = Kernels::ECompare;
+
+/// The number of independent accumulators of the reductions: 64 bytes worth of values, i.e. one AVX512 register
+template <typename T>
+constexpr std::size_t Lanes()
+{
+   return 64 / sizeof(T);
+}
+
+float SqrtOf(float x)
+{
+#if defined(__GNUC__)
+   return __builtin_sqrtf(x);
+#else
+   return std::sqrt(x);
+#endif
+}
+
+double SqrtOf(double x)
+{
+#if defined(__GNUC__)
+   return __builtin_sqrt(x);
+#else
+   return std::sqrt(x);
+#endif
+}
+
+/// Polynomial and range reduction constants of the fast sin, cos and exp below. The algorithms are the ones of VDT
+/// (and Cephes), written without branches so that the loops calling them are vectorized.
+template <typename T>
+struct RFastMath;
+
+template <>
+struct RFastMath<double> {
+   using Int_t = long long;
+   static constexpr double kFourOverPi = 1.27323954473516268615;
+   static constexpr double kPiOver4[3] = {7.85398125648498535156E-1, 3.77489470793079817668E-8,
+                                          2.69515142907905952645E-15};
+   static constexpr double kSin[6] = {1.58962301576546568060E-10, -2.50507477628578072866E-8,
+                                      2.75573136213857245213E-6,  -1.98412698295895385996E-4,
+                                      8.33333333332211858878E-3,  -1.66666666666666307295E-1};
+   static constexpr double kCos[6] = {-1.13585365213876817300E-11, 2.08757008419747316778E-9,
+                                      -2.75573141792967388112E-7,  2.48015872888517045348E-5,
+                                      -1.38888888888730564116E-3,  4.16666666666665929218E-2};
+   static constexpr double kLog2e = 1.4426950408889634073599;
+   static constexpr double kLn2[2] = {6.93145751953125E-1, 1.42860682030941723212E-6};
+   static constexpr double kMaxExp = 708.;
+   static constexpr double kSinh[7] = {1. / 6227020800., 1. / 39916800., 1. / 362880., 1. / 5040.,
+                                       1. / 120.,        1. / 6.,         1.};
+};
+
+template <>
+struct RFastMath<float> {
+   using Int_t = int;
+   static constexpr float kFourOverPi = 1.27323954473516268615f;
+   static constexpr float kPiOver4[3] = {0.78515625f, 2.4187564849853515625e-4f, 3.77489497744594108e-8f};
+   static constexpr float kSin[3] = {-1.9515295891E-4f, 8.3321608736E-3f, -1.6666654611E-1f};
+   static constexpr float kCos[3] = {2.443315711809948E-005f, -1.388731625493765E-003f, 4.166664568298827E-002f};
+   static constexpr float kLog2e = 1.44269504088896341f;
+   static constexpr float kLn2[2] = {0.693359375f, -2.12194440e-4f};
+   static constexpr float kMaxExp = 88.f;
+   static constexpr float kSinh[4] = {1.f / 5040.f, 1.f / 120.f, 1.f / 6.f, 1.f};
+};
+
+constexpr double RFastMath<double>::kPiOver4[3];
+constexpr double RFastMath<double>::kSin[6];
+constexpr double RFastMath<double>::kCos[6];
+constexpr double RFastMath<double>::kLn2[2];
+constexpr double RFastMath<double>::kSinh[7];
+constexpr float RFastMath<float>::kPiOver4[3];
+constexpr float RFastMath<float>::kSin[3];
+constexpr float RFastMath<float>::kCos[3];
+constexpr float RFastMath<float>::kLn2[2];
+constexpr float RFastMath<float>::kSinh[4];
+
+template <typename T, std::size_t N>
+R__ALWAYS_INLINE T Polynomial(const T (&p)[N], T x)
+{
+   T y = p[0];
+   for (std::size_t i = 1; i < N; ++i)
+      y = y * x + p[i];
+   return y;
+}
+
+/// sin(x) and cos(x), for |x| * 4 / pi < 2^31
+template <typename T>
+R__ALWAYS_INLINE void SinCosOf(T x, T &s, T &c)
+{
+   using M = RFastMath<T>;
+   const T ax = std::abs(x);
+   // the octant, rounded up to an even one: ax - j * pi / 4 is in [-pi / 4, pi / 4]
+   const int j = (static_cast<int>(ax * M::kFourOverPi) + 1) & ~1;
+   const T y = static_cast<T>(j);
+   const T z = ((ax - y * M::kPiOver4[0]) - y * M::kPiOver4[1]) - y * M::kPiOver4[2];
+   const T zz = z * z;
+   const T sinz = z + z * zz * Polynomial(M::kSin, zz);
+   const T cosz = T(1) - T(0.5) * zz + zz * zz * Polynomial(M::kCos, zz);
+   const bool swap = (j & 2) != 0;
+   const T sinx = swap ? cosz : sinz;
+   const T cosx = swap ? sinz : cosz;
+   s = ((j & 4) != 0) != (x < T(0)) ? -sinx : sinx;
+   c = ((j + 2) & 4) != 0 ? -cosx : cosx;
+}
+
+/// 2^n, for n in the range of the exponents of the normal numbers
+template <typename T>
+R__ALWAYS_INLINE T Pow2Of(int n)
+{
+   using Int_t = typename RFastMath<T>::Int_t;
+   constexpr int kMantissa = std::numeric_limits<T>::digits - 1;
+   constexpr int kBias = std::numeric_limits<T>::max_exponent - 1;
+   const Int_t bits = static_cast<Int_t>(n + kBias) << kMantissa;
+   T r;
+   std::memcpy(&r, &bits, sizeof(r));
+   return r;
+}
+
+R__ALWAYS_INLINE double ExpReduced(double x)
+{
+   // Pade approximation of exp(x) on [-ln(2) / 2, ln(2) / 2]
+   static constexpr double kP[3] = {1.26177193074810590878E-4, 3.02994407707441961300E-2, 9.99999999999999999910E-1};
+   static constexpr double kQ[4] = {3.00198505138664455042E-6, 2.52448340349684104192E-3, 2.27265548208155028766E-1,
+                                    2.00000000000000000009E0};
+   const double xx = x * x;
+   const double px = x * Polynomial(kP, xx);
+   return 1. + 2. * px / (Polynomial(kQ, xx) - px);
+}
+
+R__ALWAYS_INLINE float ExpReduced(float x)
+{
+   static constexpr float kP[6] = {1.9875691500E-4f, 1.3981999507E-3f, 8.3334519073E-3f,
+                                   4.1665795894E-2f, 1.6666665459E-1f, 5.0000001201E-1f};
+   return Polynomial(kP, x) * x * x + x + 1.f;
+}
+
+/// exp(x), inf above kMaxExp and 0 below -kMaxExp
+template <typename T>
+R__ALWAYS_INLINE T ExpOf(T x)
+{
+   using M = RFastMath<T>;
+   // round to the nearest integer by adding and subtracting 1.5 * 2^(digits - 1), clamp so that 2^n is a normal number
+   constexpr T kRound = T(1.5) * static_cast<T>(1ULL << (std::numeric_limits<T>::digits - 1));
+   constexpr T kMinN = std::numeric_limits<T>::min_exponent - 1;
+   constexpr T kMaxN = std::numeric_limits<T>::max_exponent - 1;
+   const T n = std::min(std::max((M::kLog2e * x + kRound) - kRound, kMinN), kMaxN);
+   const T r = (x - n * M::kLn2[0]) - n * M::kLn2[1];
+   const T e = ExpReduced(r) * Pow2Of<T>(static_cast<int>(n));
+   return x > M::kMaxExp ? std::numeric_limits<T>::infinity() : (x < -M::kMaxExp ? T(0) : e);
+}
+
+/// sinh(x), from its Taylor series for |x| < 1/2 where the exponentials cancel
+template <typename T>
+R__ALWAYS_INLINE T SinhOf(T x)
+{
+   const T e = ExpOf(x);
+   const T large = T(0.5) * (e - T(1) / e);
+   const T small = x * Polynomial(RFastMath<T>::kSinh, x * x);
+   return std::abs(x) < T(0.5) ? small : large;
+}
+
+/// The Cartesian coordinates (px, py, pz, e) of the four-vector (pt, eta, phi, mass)
+template <typename T>
+R__ALWAYS_INLINE void ToPxPyPzE(T pt, T eta, T phi, T mass, T &px, T &py, T &pz, T &e)
+{
+   T s, c;
+   SinCosOf(phi, s, c);
+   px = pt * c;
+   py = pt * s;
+   pz = pt * SinhOf(eta);
+   e = SqrtOf(px * px + py * py + pz * pz + mass * mass);
+}
+
+template <typename T>
+T SumImpl(const T *v, std::size_t n)
+{
+   constexpr auto kLanes = Lanes<T>();
+   T acc[kLanes] = {};
+   std::size_t i = 0;
+   for (; i + kLanes <= n; i += kLanes)
+      for (std::size_t j = 0; j < kLanes; ++j)
+         acc[j] += v[i + j];
+   T sum = 0;
+   for (std::size_t j = 0; j < kLanes; ++j)
+      sum += acc[j];
+   for (; i < n; ++i)
+      sum += v[i];
+   return sum;
+}
+
+template <typename T>
+T DotImpl(const T *v0, const T *v1, std::size_t n)
+{
+   constexpr auto kLanes = Lanes<T>();
+   T acc[kLanes] = {};
+   std::size_t i = 0;
+   for (; i + kLanes <= n; i += kLanes)
+      for (std::size_t j = 0; j < kLanes; ++j)
+         acc[j] += v0[i + j] * v1[i + j];
+   T dot = 0;
+   for (std::size_t j = 0; j < kLanes; ++j)
+      dot += acc[j];
+   for (; i < n; ++i)
+      dot += v0[i] * v1[i];
+   return dot;
+}
+
+struct RGreater {
+   template <typename T>
+   bool operator()(T x, T y) const
+   {
+      return x > y;
+   }
+};
+
+struct RLess {
+   template <typename T>
+   bool operator()(T x, T y) const
+   {
+      return x < y;
+   }
+};
+
+struct RLessEqual {
+   template <typename T>
+   bool operator()(T x, T y) const
+   {
+      return x <= y;
+   }
+};
+
+struct RGreaterEqual {
+   template <typename T>
+   bool operator()(T x, T y) const
+   {
+      return x >= y;
+   }
+};
+
+struct REqual {
+   template <typename T>
+   bool operator()(T x, T y) const
+   {
+      return x == y;
+   }
+};
+
+struct RNotEqual {
+   template <typename T>
+   bool operator()(T x, T y) const
+   {
+      return x != y;
+   }
+};
+
+/// The index of the first occurrence of the extremum of v, i.e. what std::max_element (Better = RGreater) or
+/// std::min_element (Better = RLess) return.
+/// The extremum is found with a vectorized reduction, then its first occurrence with a vectorized search. NaNs make
+/// the result depend on the order of the comparisons, we then fall back to the sequential algorithm.
+template <typename Better, typename T>
+std::size_t ArgExtremumImpl(const T *v, std::size_t n)
+{
+   constexpr auto kLanes = Lanes<T>();
+   Better better;
+   const auto sequential = [&] {
+      std::size_t best = 0;
+      for (std::size_t i = 1; i < n; ++i)
+         if (better(v[i], v[best]))
+            best = i;
+      return best;
+   };
+   if (n < kLanes)
+      return sequential();
+
+   T acc[kLanes];
+   int nan[kLanes];
+   for (std::size_t j = 0; j < kLanes; ++j) {
+      acc[j] = v[j];
+      nan[j] = v[j] != v[j];
+   }
+   std::size_t i = kLanes;
+   for (; i + kLanes <= n; i += kLanes) {
+      for (std::size_t j = 0; j < kLanes; ++j) {
+         const T x = v[i + j];
+         acc[j] = better(x, acc[j]) ? x : acc[j];
+         nan[j] |= x != x;
+      }
+   }
+   T extremum = acc[0];
+   int anyNan = 0;
+   for (std::size_t j = 0; j < kLanes; ++j) {
+      extremum = better(acc[j], extremum) ? acc[j] : extremum;
+      anyNan |= nan[j];
+   }
+   for (; i < n; ++i) {
+      extremum = better(v[i], extremum) ? v[i] : extremum;
+      anyNan |= v[i] != v[i];
+   }
+   if (anyNan)
+      return sequential();
+
+   for (i = 0; i + kLanes <= n; i += kLanes) {
+      int found = 0;
+      for (std::size_t j = 0; j < kLanes; ++j)
+         found |= v[i + j] == extremum;
+      if (found)
+         break;
+   }
+   for (; i < n; ++i)
+      if (v[i] == extremum)
+         return i;
+   return n; // not reached
+}
+
+template <typename T>
+void SqrtImpl(const T *v, T *out, std::size_t n)
+{
+   for (std::size_t i = 0; i < n; ++i)
+      out[i] = SqrtOf(v[i]);
+}
+
+template <typename T>
+void InvariantMassesImpl(const T *pt1, const T *eta1, const T *phi1, const T *mass1, const T *pt2, const T *eta2,
+                         const T *phi2, const T *mass2, T *out, std::size_t n)
+{
+   for (std::size_t i = 0; i < n; ++i) {
+      T x1, y1, z1, e1, x2, y2, z2, e2;
+      ToPxPyPzE(pt1[i], eta1[i], phi1[i], mass1[i], x1, y1, z1, e1);
+      ToPxPyPzE(pt2[i], eta2[i], phi2[i], mass2[i], x2, y2, z2, e2);
+      const T x = x1 + x2;
+      const T y = y1 + y2;
+      const T z = z1 + z2;
+      const T e = e1 + e2;
+      out[i] = SqrtOf(e * e - x * x - y * y - z * z);
+   }
+}
+
+/// The four-vectors are summed with independent accumulators, like the other reductions
+template <typename T>
+T InvariantMassImpl(const T *pt, const T *eta, const T *phi, const T *mass, std::size_t n)
+{
+   constexpr auto kLanes = Lanes<T>();
+   T accX[kLanes] = {};
+   T accY[kLanes] = {};
+   T accZ[kLanes] = {};
+   T accE[kLanes] = {};
+   std::size_t i = 0;
+   for (; i + kLanes <= n; i += kLanes) {
+      for (std::size_t j = 0; j < kLanes; ++j) {
+         T x, y, z, e;
+         ToPxPyPzE(pt[i + j], eta[i + j], phi[i + j], mass[i + j], x, y, z, e);
+         accX[j] += x;
+         accY[j] += y;
+         accZ[j] += z;
+         accE[j] += e;
+      }
+   }
+   T sumX = 0, sumY = 0, sumZ = 0, sumE = 0;
+   for (std::size_t j = 0; j < kLanes; ++j) {
+      sumX += accX[j];
+      sumY += accY[j];
+      sumZ += accZ[j];
+      sumE += accE[j];
+   }
+   for (; i < n; ++i) {
+      T x, y, z, e;
+      ToPxPyPzE(pt[i], eta[i], phi[i], mass[i], x, y, z, e);
+      sumX += x;
+      sumY += y;
+      sumZ += z;
+      sumE += e;
+   }
+   return SqrtOf(sumE * sumE - sumX * sumX - sumY * sumY - sumZ * sumZ);
+}
+
+/// DeltaPhi is computed as in the RVec helper, with the remainder of the division by 2c taken from the truncated
+/// quotient instead of std::fmod
+template <typename T>
+void DeltaR2Impl(const T *eta1, const T *eta2, const T *phi1, const T *phi2, T c, T *out, std::size_t n)
+{
+   const T twoC = T(2) * c;
+   for (std::size_t i = 0; i < n; ++i) {
+      const T dphi = phi2[i] - phi1[i];
+      T r = dphi - twoC * static_cast<T>(static_cast<int>(dphi / twoC));
+      r = r < -c ? r + twoC : (r > c ? r - twoC : r);
+      const T deta = eta1[i] - eta2[i];
+      out[i] = deta * deta + r * r;
+   }
+}
+
+template <typename T, typename Y>
+struct RElementOrScalar;
+
+template <typename T>
+struct RElementOrScalar<T, const T *> {
+   static T Get(const T *v, std::size_t i) { return v[i]; }
+};
+
+template <typename T>
+struct RElementOrScalar<T, T> {
+   static T Get(T y, std::size_t) { return y; }
+};
+
+template <typename T, typename Op, typename Y>
+void CompareLoop(const T *v, Y y, int *out, std::size_t n)
+{
+   Op op;
+   for (std::size_t i = 0; i < n; ++i)
+      out[i] = op(v[i], RElementOrScalar<T, Y>::Get(y, i));
+}
+
+/// Y is either T, to compare with a scalar, or const T *, to compare elementwise with another vector. The comparison
+/// is selected outside of the loops.
+template <typename T, typename Y>
+void CompareImpl(const T *v, ECompare op, Y y, int *out, std::size_t n)
+{
+   switch (op) {
+   case ECompare::kLess: CompareLoop<T, RLess>(v, y, out, n); break;
+   case ECompare::kGreater: CompareLoop<T, RGreater>(v, y, out, n); break;
+   case ECompare::kLessEqual: CompareLoop<T, RLessEqual>(v, y, out, n); break;
+   case ECompare::kGreaterEqual: CompareLoop<T, RGreaterEqual>(v, y, out, n); break;
+   case ECompare::kEqual: CompareLoop<T, REqual>(v, y, out, n); break;
+   case ECompare::kNotEqual: CompareLoop<T, RNotEqual>(v, y, out, n); break;
+   }
+}
+
+/// Y1 and Y2 are either T or const T *. Both values are loaded unconditionally, so that the selection is a blend.
+template <typename T, typename Y1, typename Y2>
+void WhereImpl(const int *c, Y1 v1, Y2 v2, T *out, std::size_t n)
+{
+   for (std::size_t i = 0; i < n; ++i) {
+      const T x1 = RElementOrScalar<T, Y1>::Get(v1, i);
+      const T x2 = RElementOrScalar<T, Y2>::Get(v2, i);
+      out[i] = c[i] != 0 ? x1 : x2;
+   }
+}
+
+/// Store the elements of v for which c is not zero at the beginning of out and return their number.
+/// The store is unconditional: out must have space for n elements.
+template <typename T>
+std::size_t CompressScalar(const T *v, const int *c, T *out, std::size_t n, std::size_t i, std::size_t nOut)
+{
+   for (; i < n; ++i) {
+      out[nOut] = v[i];
+      nOut += c[i] != 0;
+   }
+   return nOut;
+}
+
+std::size_t CompressImpl(const float *v, const int *c, float *out, std::size_t n)
+{
+   std::size_t i = 0;
+   std::size_t nOut = 0;
+#if defined(__AVX512F__) && defined(__AVX512VL__)
+   // full-width stores past the selected elements stay within out, since nOut <= i
+   for (; i + 16 <= n; i += 16) {
+      const __m512i conds = _mm512_loadu_si512(c + i);
+      const __mmask16 mask = _mm512_test_epi32_mask(conds, conds);
+      _mm512_storeu_ps(out + nOut, _mm512_maskz_compress_ps(mask, _mm512_loadu_ps(v + i)));
+      nOut += __builtin_popcount(mask);
+   }
+#endif
+   return CompressScalar(v, c, out, n, i, nOut);
+}
+
+std::size_t CompressImpl(const double *v, const int *c, double *out, std::size_t n)
+{
+   std::size_t i = 0;
+   std::size_t nOut = 0;
+#if defined(__AVX512F__) && defined(__AVX512VL__)
+   for (; i + 8 <= n; i += 8) {
+      const __m256i conds = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(c + i));
+      const __mmask8 mask = _mm256_test_epi32_mask(conds, conds);
+      _mm512_storeu_pd(out + nOut, _mm512_maskz_compress_pd(mask, _mm512_loadu_pd(v + i)));
+      nOut += __builtin_popcount(mask);
+   }
+#endif
+   return CompressScalar(v, c, out, n, i, nOut);
+}
+
+class RVecKernels final : public RVecKernelsInterface {
+public:
+   const char *GetArchitecture() const final { return RVEC_STRINGIFY(RVEC_ARCH); }
+
+   float Sum(const float *v, std::size_t n) const final { return SumImpl(v, n); }
+   double Sum(const double *v, std::size_t n) const final { return SumImpl(v, n); }
+   float Dot(const float *v0, const float *v1, std::size_t n) const final { return DotImpl(v0, v1, n); }
+   double Dot(const double *v0, const double *v1, std::size_t n) const final { return DotImpl(v0, v1, n); }
+   std::size_t ArgMax(const float *v, std::size_t n) const final { return ArgExtremumImpl<RGreater>(v, n); }
+   std::size_t ArgMax(const double *v, std::size_t n) const final { return ArgExtremumImpl<RGreater>(v, n); }
+   std::size_t ArgMin(const float *v, std::size_t n) const final { return ArgExtremumImpl<RLess>(v, n); }
+   std::size_t ArgMin(const double *v, std::size_t n) const final { return ArgExtremumImpl<RLess>(v, n); }
+   void Sqrt(const float *v, float *out, std::size_t n) const final { SqrtImpl(v, out, n); }
+   void Sqrt(const double *v, double *out, std::size_t n) const final { SqrtImpl(v, out, n); }
+   void Compare(const float *v, ECompare op, float y, int *out, std::size_t n) const final
+   {
+      CompareImpl(v, op, y, out, n);
+   }
+   void Compare(const double *v, ECompare op, double y, int *out, std::size_t n) const final
+   {
+      CompareImpl(v, op, y, out, n);
+   }
+   void Compare(const float *v0, ECompare op, const float *v1, int *out, std::size_t n) const final
+   {
+      CompareImpl(v0, op, v1, out, n);
+   }
+   void Compare(const double *v0, ECompare op, const double *v1, int *out, std::size_t n) const final
+   {
+      CompareImpl(v0, op, v1, out, n);
+   }
+   void Where(const int *c, const float *v1, const float *v2, float *out, std::size_t n) const final
+   {
+      WhereImpl(c, v1, v2, out, n);
+   }
+   void Where(const int *c, const double *v1, const double *v2, double *out, std::size_t n) const final
+   {
+      WhereImpl(c, v1, v2, out, n);
+   }
+   void Where(const int *c, const float *v1, float v2, float *out, std::size_t n) const final
+   {
+      WhereImpl(c, v1, v2, out, n);
+   }
+   void Where(const int *c, const double *v1, double v2, double *out, std::size_t n) const final
+   {
+      WhereImpl(c, v1, v2, out, n);
+   }
+   void Where(const int *c, float v1, const float *v2, float *out, std::size_t n) const final
+   {
+      WhereImpl(c, v1, v2, out, n);
+   }
+   void Where(const int *c, double v1, const double *v2, double *out, std::size_t n) const final
+   {
+      WhereImpl(c, v1, v2, out, n);
+   }
+   void Where(const int *c, float v1, float v2, float *out, std::size_t n) const final
+   {
+      WhereImpl(c, v1, v2, out, n);
+   }
+   void Where(const int *c, double v1, double v2, double *out, std::size_t n) const final
+   {
+      WhereImpl(c, v1, v2, out, n);
+   }
+   std::size_t Compress(const float *v, const int *c, float *out, std::size_t n) const final
+   {
+      return CompressImpl(v, c, out, n);
+   }
+   std::size_t Compress(const double *v, const int *c, double *out, std::size_t n) const final
+   {
+      return CompressImpl(v, c, out, n);
+   }
+   void InvariantMasses(const float *pt1, const float *eta1, const float *phi1, const float *mass1, const float *pt2,
+                        const float *eta2, const float *phi2, const float *mass2, float *out, std::size_t n) const final
+   {
+      InvariantMassesImpl(pt1, eta1, phi1, mass1, pt2, eta2, phi2, mass2, out, n);
+   }
+   void InvariantMasses(const double *pt1, const double *eta1, const double *phi1, const double *mass1,
+                        const double *pt2, const double *eta2, const double *phi2, const double *mass2, double *out,
+                        std::size_t n) const final
+   {
+      InvariantMassesImpl(pt1, eta1, phi1, mass1, pt2, eta2, phi2, mass2, out, n);
+   }
+   float InvariantMass(const float *pt, const float *eta, const float *phi, const float *mass,
+                       std::size_t n) const final
+   {
+      return InvariantMassImpl(pt, eta, phi, mass, n);
+   }
+   double InvariantMass(const double *pt, const double *eta, const double *phi, const double *mass,
+                        std::size_t n) const final
+   {
+      return InvariantMassImpl(pt, eta, phi, mass, n);
+   }
+   void DeltaR2(const float *eta1, const float *eta2, const float *phi1, const float *phi2, float c, float *out,
+                std::size_t n) const final
+   {
+      DeltaR2Impl(eta1, eta2, phi1, phi2, c, out, n);
+   }
+   void DeltaR2(const double *eta1, const double *eta2, const double *phi1, const double *phi2, double c, double *out,
+                std::size_t n) const final
+   {
+      DeltaR2Impl(eta1, eta2, phi1, phi2, c, out, n);
+   }
+};
+
+} // anonymous namespace
+
+const RVecKernelsInterface &GetKernels()
+{
+   static const RVecKernels kernels;
+   return kernels;
+}
+
+} // namespace RVEC_ARCH
+} // namespace VecOps
+} // namespace Internal
+} // namespace ROOT
@@ -0,0 +1,96 @@
+/*************************************************************************
+ * Copyright (C) 1995-2021, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+// The interface of the vectorized kernels of the RVec helpers. RVecKernels.cxx implements it and is compiled once per
+// instruction set, in a different namespace each; RVecKernelsDispatch.cxx picks the best one for the CPU at runtime.
+
+#ifndef ROOT_RVECKERNELS
+#define ROOT_RVECKERNELS
+
+#include <cstddef>
+
+// only the declarations of ROOT::Internal::VecOps::Kernels are used from here
+#include "ROOT/RVec.hxx"
+
+namespace ROOT {
+namespace Internal {
+namespace VecOps {
+
+class RVecKernelsInterface {
+public:
+   using ECompare = Kernels::ECompare;
+
+   virtual ~RVecKernelsInterface() = default;
+   virtual const char *GetArchitecture() const = 0;
+
+   virtual float Sum(const float *v, std::size_t n) const = 0;
+   virtual double Sum(const double *v, std::size_t n) const = 0;
+   virtual float Dot(const float *v0, const float *v1, std::size_t n) const = 0;
+   virtual double Dot(const double *v0, const double *v1, std::size_t n) const = 0;
+   virtual std::size_t ArgMax(const float *v, std::size_t n) const = 0;
+   virtual std::size_t ArgMax(const double *v, std::size_t n) const = 0;
+   virtual std::size_t ArgMin(const float *v, std::size_t n) const = 0;
+   virtual std::size_t ArgMin(const double *v, std::size_t n) const = 0;
+   virtual void Sqrt(const float *v, float *out, std::size_t n) const = 0;
+   virtual void Sqrt(const double *v, double *out, std::size_t n) const = 0;
+   virtual void Compare(const float *v, ECompare op, float y, int *out, std::size_t n) const = 0;
+   virtual void Compare(const double *v, ECompare op, double y, int *out, std::size_t n) const = 0;
+   virtual void Compare(const float *v0, ECompare op, const float *v1, int *out, std::size_t n) const = 0;
+   virtual void Compare(const double *v0, ECompare op, const double *v1, int *out, std::size_t n) const = 0;
+   virtual void Where(const int *c, const float *v1, const float *v2, float *out, std::size_t n) const = 0;
+   virtual void Where(const int *c, const double *v1, const double *v2, double *out, std::size_t n) const = 0;
+   virtual void Where(const int *c, const float *v1, float v2, float *out, std::size_t n) const = 0;
+   virtual void Where(const int *c, const double *v1, double v2, double *out, std::size_t n) const = 0;
+   virtual void Where(const int *c, float v1, const float *v2, float *out, std::size_t n) const = 0;
+   virtual void Where(const int *c, double v1, const double *v2, double *out, std::size_t n) const = 0;
+   virtual void Where(const int *c, float v1, float v2, float *out, std::size_t n) const = 0;
+   virtual void Where(const int *c, double v1, double v2, double *out, std::size_t n) const = 0;
+   virtual std::size_t Compress(const float *v, const int *c, float *out, std::size_t n) const = 0;
+   virtual std::size_t Compress(const double *v, const int *c, double *out, std::size_t n) const = 0;
+   virtual void InvariantMasses(const float *pt1, const float *eta1, const float *phi1, const float *mass1,
+                                const float *pt2, const float *eta2, const float *phi2, const float *mass2, float *out,
+                                std::size_t n) const = 0;
+   virtual void InvariantMasses(const double *pt1, const double *eta1, const double *phi1, const double *mass1,
+                                const double *pt2, const double *eta2, const double *phi2, const double *mass2,
+                                double *out, std::size_t n) const = 0;
+   virtual float InvariantMass(const float *pt, const float *eta, const float *phi, const float *mass,
+                               std::size_t n) const = 0;
+   virtual double InvariantMass(const double *pt, const double *eta, const double *phi, const double *mass,
+                                std::size_t n) const = 0;
+   virtual void DeltaR2(const float *eta1, const float *eta2, const float *phi1, const float *phi2, float c, float *out,
+                        std::size_t n) const = 0;
+   virtual void DeltaR2(const double *eta1, const double *eta2, const double *phi1, const double *phi2, double c,
+                        double *out, std::size_t n) const = 0;
+};
+
+// The kernels compiled for each instruction set, see math/vecops/CMakeLists.txt
+namespace GENERIC {
+const RVecKernelsInterface &GetKernels();
+}
+#ifdef R__RVEC_ARCHITECTURE_SPECIFIC_KERNELS
+namespace SSE4 {
+const RVecKernelsInterface &GetKernels();
+}
+namespace AVX {
+const RVecKernelsInterface &GetKernels();
+}
+namespace AVX2 {
+const RVecKernelsInterface &GetKernels();
+}
+#ifdef R__RVEC_HAS_AVX512_KERNELS
+namespace AVX512 {
+const RVecKernelsInterface &GetKernels();
+}
+#endif
+#endif
+
+} // namespace VecOps
+} // namespace Internal
+} // namespace ROOT
+
+#endif
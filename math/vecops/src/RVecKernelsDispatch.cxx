@@ -0,0 +1,217 @@
+/*************************************************************************
+ * Copyright (C) 1995-2021, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+// Select the kernels of the RVec helpers compiled for the best instruction set supported by the CPU, see
+// RVecKernels.cxx.
+
+#include "RVecKernels.hxx"
+
+#include "ROOT/RVec.hxx"
+
+#include <cstddef>
+
+namespace {
+
+using ROOT::Internal::VecOps::RVecKernelsInterface;
+
+const RVecKernelsInterface &SelectKernels()
+{
+#ifdef R__RVEC_ARCHITECTURE_SPECIFIC_KERNELS
+   __builtin_cpu_init();
+#ifdef R__RVEC_HAS_AVX512_KERNELS
+   // skylake-avx512 support
+   if (__builtin_cpu_supports("avx512cd") && __builtin_cpu_supports("avx512vl") &&
+       __builtin_cpu_supports("avx512bw") && __builtin_cpu_supports("avx512dq"))
+      return ROOT::Internal::VecOps::AVX512::GetKernels();
+#endif
+   if (__builtin_cpu_supports("avx2"))
+      return ROOT::Internal::VecOps::AVX2::GetKernels();
+   if (__builtin_cpu_supports("avx"))
+      return ROOT::Internal::VecOps::AVX::GetKernels();
+   if (__builtin_cpu_supports("sse4.1"))
+      return ROOT::Internal::VecOps::SSE4::GetKernels();
+#endif
+   return ROOT::Internal::VecOps::GENERIC::GetKernels();
+}
+
+const RVecKernelsInterface &GetKernels()
+{
+   static const RVecKernelsInterface &kernels = SelectKernels();
+   return kernels;
+}
+
+} // anonymous namespace
+
+namespace ROOT {
+namespace Internal {
+namespace VecOps {
+namespace Kernels {
+
+float Sum(const float *v, std::size_t n)
+{
+   return ::GetKernels().Sum(v, n);
+}
+
+double Sum(const double *v, std::size_t n)
+{
+   return ::GetKernels().Sum(v, n);
+}
+
+float Dot(const float *v0, const float *v1, std::size_t n)
+{
+   return ::GetKernels().Dot(v0, v1, n);
+}
+
+double Dot(const double *v0, const double *v1, std::size_t n)
+{
+   return ::GetKernels().Dot(v0, v1, n);
+}
+
+std::size_t ArgMax(const float *v, std::size_t n)
+{
+   return ::GetKernels().ArgMax(v, n);
+}
+
+std::size_t ArgMax(const double *v, std::size_t n)
+{
+   return ::GetKernels().ArgMax(v, n);
+}
+
+std::size_t ArgMin(const float *v, std::size_t n)
+{
+   return ::GetKernels().ArgMin(v, n);
+}
+
+std::size_t ArgMin(const double *v, std::size_t n)
+{
+   return ::GetKernels().ArgMin(v, n);
+}
+
+void Sqrt(const float *v, float *out, std::size_t n)
+{
+   ::GetKernels().Sqrt(v, out, n);
+}
+
+void Sqrt(const double *v, double *out, std::size_t n)
+{
+   ::GetKernels().Sqrt(v, out, n);
+}
+
+void Compare(const float *v, ECompare op, float y, int *out, std::size_t n)
+{
+   ::GetKernels().Compare(v, op, y, out, n);
+}
+
+void Compare(const double *v, ECompare op, double y, int *out, std::size_t n)
+{
+   ::GetKernels().Compare(v, op, y, out, n);
+}
+
+void Compare(const float *v0, ECompare op, const float *v1, int *out, std::size_t n)
+{
+   ::GetKernels().Compare(v0, op, v1, out, n);
+}
+
+void Compare(const double *v0, ECompare op, const double *v1, int *out, std::size_t n)
+{
+   ::GetKernels().Compare(v0, op, v1, out, n);
+}
+
+void Where(const int *c, const float *v1, const float *v2, float *out, std::size_t n)
+{
+   ::GetKernels().Where(c, v1, v2, out, n);
+}
+
+void Where(const int *c, const double *v1, const double *v2, double *out, std::size_t n)
+{
+   ::GetKernels().Where(c, v1, v2, out, n);
+}
+
+void Where(const int *c, const float *v1, float v2, float *out, std::size_t n)
+{
+   ::GetKernels().Where(c, v1, v2, out, n);
+}
+
+void Where(const int *c, const double *v1, double v2, double *out, std::size_t n)
+{
+   ::GetKernels().Where(c, v1, v2, out, n);
+}
+
+void Where(const int *c, float v1, const float *v2, float *out, std::size_t n)
+{
+   ::GetKernels().Where(c, v1, v2, out, n);
+}
+
+void Where(const int *c, double v1, const double *v2, double *out, std::size_t n)
+{
+   ::GetKernels().Where(c, v1, v2, out, n);
+}
+
+void Where(const int *c, float v1, float v2, float *out, std::size_t n)
+{
+   ::GetKernels().Where(c, v1, v2, out, n);
+}
+
+void Where(const int *c, double v1, double v2, double *out, std::size_t n)
+{
+   ::GetKernels().Where(c, v1, v2, out, n);
+}
+
+std::size_t Compress(const float *v, const int *c, float *out, std::size_t n)
+{
+   return ::GetKernels().Compress(v, c, out, n);
+}
+
+std::size_t Compress(const double *v, const int *c, double *out, std::size_t n)
+{
+   return ::GetKernels().Compress(v, c, out, n);
+}
+
+void InvariantMasses(const float *pt1, const float *eta1, const float *phi1, const float *mass1, const float *pt2,
+                     const float *eta2, const float *phi2, const float *mass2, float *out, std::size_t n)
+{
+   ::GetKernels().InvariantMasses(pt1, eta1, phi1, mass1, pt2, eta2, phi2, mass2, out, n);
+}
+
+void InvariantMasses(const double *pt1, const double *eta1, const double *phi1, const double *mass1, const double *pt2,
+                     const double *eta2, const double *phi2, const double *mass2, double *out, std::size_t n)
+{
+   ::GetKernels().InvariantMasses(pt1, eta1, phi1, mass1, pt2, eta2, phi2, mass2, out, n);
+}
+
+float InvariantMass(const float *pt, const float *eta, const float *phi, const float *mass, std::size_t n)
+{
+   return ::GetKernels().InvariantMass(pt, eta, phi, mass, n);
+}
+
+double InvariantMass(const double *pt, const double *eta, const double *phi, const double *mass, std::size_t n)
+{
+   return ::GetKernels().InvariantMass(pt, eta, phi, mass, n);
+}
+
+void DeltaR2(const float *eta1, const float *eta2, const float *phi1, const float *phi2, float c, float *out,
+             std::size_t n)
+{
+   ::GetKernels().DeltaR2(eta1, eta2, phi1, phi2, c, out, n);
+}
+
+void DeltaR2(const double *eta1, const double *eta2, const double *phi1, const double *phi2, double c, double *out,
+             std::size_t n)
+{
+   ::GetKernels().DeltaR2(eta1, eta2, phi1, phi2, c, out, n);
+}
+
+const char *GetArchitecture()
+{
+   return ::GetKernels().GetArchitecture();
+}
+
+} // namespace Kernels
+} // namespace VecOps
+} // namespace Internal
+} // namespace ROOT
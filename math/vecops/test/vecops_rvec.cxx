@@ -12,6 +12,8 @@
 #include <vector>
 #include <sstream>
 #include <cmath>
+#include <limits>
+#include <string>
 
 using namespace ROOT::VecOps;
 
@@ -114,6 +116,105 @@ TEST(VecOps, CopyCtorCheckNoLeak)
 
 }
 
+// Whether the elements of v are stored inline, inside the RVec object
+template <typename T>
+static bool IsInline(const RVec<T> &v)
+{
+   const auto *begin = reinterpret_cast<const char *>(&v);
+   const auto *data = reinterpret_cast<const char *>(v.data());
+   return data >= begin && data < begin + sizeof(v);
+}
+
+TEST(VecOps, SmallBuffer)
+{
+   RVec<float> v{1.f, 2.f, 3.f};
+   EXPECT_TRUE(IsInline(v));
+   auto selected = v[v > 1.f];
+   EXPECT_TRUE(IsInline(selected));
+   CheckEqual(selected, RVec<float>{2.f, 3.f});
+
+   for (int i = 0; i < 100; ++i)
+      v.push_back(i);
+   EXPECT_FALSE(IsInline(v));
+   EXPECT_EQ(v.size(), 103u);
+   EXPECT_FLOAT_EQ(v[102], 99.f);
+
+   // moving a large RVec takes over its memory, moving a small one moves its elements
+   const auto *data = v.data();
+   RVec<float> w(std::move(v));
+   EXPECT_EQ(w.data(), data);
+   EXPECT_TRUE(v.empty());
+   RVec<float> small(std::move(selected));
+   EXPECT_TRUE(IsInline(small));
+   CheckEqual(small, RVec<float>{2.f, 3.f});
+
+   // shrink_to_fit goes back to the inline buffer if the elements fit
+   w.resize(2);
+   w.shrink_to_fit();
+   EXPECT_TRUE(IsInline(w));
+   CheckEqual(w, RVec<float>{1.f, 2.f});
+
+   w.swap(v);
+   EXPECT_TRUE(w.empty());
+   CheckEqual(v, RVec<float>{1.f, 2.f});
+}
+
+TEST(VecOps, SmallBufferNoLeak)
+{
+   int nAlive = 0;
+   struct RAliveCounter {
+      int *fN;
+      RAliveCounter(int *n) : fN(n) { ++*fN; }
+      RAliveCounter(const RAliveCounter &o) : fN(o.fN) { ++*fN; }
+      RAliveCounter &operator=(const RAliveCounter &) = default;
+      ~RAliveCounter() { --*fN; }
+   };
+   {
+      RVec<RAliveCounter> v;
+      for (int i = 0; i < 50; ++i)
+         v.emplace_back(&nAlive);
+      EXPECT_EQ(nAlive, 50);
+      v.erase(v.begin(), v.begin() + 45);
+      EXPECT_EQ(nAlive, 5);
+      v.shrink_to_fit();
+      auto w = v;
+      w.resize(20, RAliveCounter(&nAlive));
+      EXPECT_EQ(nAlive, 25);
+      std::swap(v, w);
+   }
+   EXPECT_EQ(nAlive, 0);
+
+   // adopted elements are not destroyed, and are copied when the RVec needs more memory
+   std::vector<RAliveCounter> ref(3, RAliveCounter(&nAlive));
+   {
+      RVec<RAliveCounter> adopting(ref.data(), ref.size());
+      adopting.pop_back();
+      EXPECT_EQ(nAlive, 3);
+      adopting.emplace_back(&nAlive);
+      EXPECT_NE(adopting.data(), ref.data());
+      EXPECT_EQ(nAlive, 6);
+   }
+   EXPECT_EQ(nAlive, 3);
+}
+
+TEST(VecOps, AdoptionSurvivesMove)
+{
+   std::vector<int> ref{1, 2, 3};
+   RVec<int> v(ref.data(), ref.size());
+   RVec<int> w(std::move(v));
+   EXPECT_EQ(w.data(), ref.data());
+   RVec<int> x;
+   std::swap(w, x);
+   EXPECT_EQ(x.data(), ref.data());
+   x[0] = 42;
+   EXPECT_EQ(ref[0], 42);
+
+   // assigning to an adopting RVec does not write to the adopted memory
+   x = RVec<int>{7, 8, 9};
+   EXPECT_NE(x.data(), ref.data());
+   CheckEqual(ref, std::vector<int>{42, 2, 3});
+}
+
 TEST(VecOps, MoveCtor)
 {
    ROOT::VecOps::RVec<int> v1{1, 2, 3};
@@ -1045,6 +1146,87 @@ TEST(VecOps, Where)
    CheckEqual(v6, ref4);
 }
 
+// The float and double helpers go through the vectorized kernels: check them against plain loops, for sizes that
+// exercise both the vectorized loops and their remainders.
+template <typename T>
+void CheckKernels()
+{
+   for (std::size_t n : {0, 1, 7, 8, 15, 16, 17, 31, 33, 64, 100, 1001}) {
+      RVec<T> v(n), w(n);
+      RVec<int> c(n);
+      for (std::size_t i = 0; i < n; ++i) {
+         v[i] = T((i * 37) % 101) / 7 - 5; // with repeated values
+         w[i] = T((i * 53) % 97) / 5 - 3;
+         c[i] = (i * 211) % 3 == 0 ? int(i + 1) : 0;
+      }
+      const auto msg = "n = " + std::to_string(n);
+
+      T sum = 0, dot = 0;
+      for (std::size_t i = 0; i < n; ++i) {
+         sum += v[i];
+         dot += v[i] * w[i];
+      }
+      EXPECT_NEAR(Sum(v), sum, 1e-4 * n) << msg;
+      EXPECT_NEAR(Dot(v, w), dot, 1e-3 * n) << msg;
+      EXPECT_NEAR(Mean(v), n == 0 ? 0. : double(sum) / n, 1e-4) << msg;
+
+      if (n > 0) {
+         EXPECT_EQ(ArgMax(v), std::size_t(std::max_element(v.begin(), v.end()) - v.begin())) << msg;
+         EXPECT_EQ(ArgMin(v), std::size_t(std::min_element(v.begin(), v.end()) - v.begin())) << msg;
+         EXPECT_EQ(Max(v), *std::max_element(v.begin(), v.end())) << msg;
+         EXPECT_EQ(Min(v), *std::min_element(v.begin(), v.end())) << msg;
+      }
+
+      const auto sq = sqrt(abs(v));
+      const auto lt = v < T(0.5);
+      const auto ge = 1 >= v; // the scalar is converted to T
+      const auto ne = v != w;
+      const auto sel = Where(c, v, w);
+      const auto selScalar = Where(c, T(1), w);
+      const auto masked = v[c];
+      std::size_t nMasked = 0;
+      for (std::size_t i = 0; i < n; ++i) {
+         EXPECT_EQ(sq[i], std::sqrt(std::abs(v[i]))) << msg;
+         EXPECT_EQ(lt[i], int(v[i] < T(0.5))) << msg;
+         EXPECT_EQ(ge[i], int(1 >= v[i])) << msg;
+         EXPECT_EQ(ne[i], int(v[i] != w[i])) << msg;
+         EXPECT_EQ(sel[i], c[i] ? v[i] : w[i]) << msg;
+         EXPECT_EQ(selScalar[i], c[i] ? T(1) : w[i]) << msg;
+         if (c[i]) {
+            ASSERT_LT(nMasked, masked.size()) << msg;
+            EXPECT_EQ(masked[nMasked++], v[i]) << msg;
+         }
+      }
+      EXPECT_EQ(masked.size(), nMasked) << msg;
+   }
+
+   // the comparisons with a scalar of a wider type are not done in T
+   RVec<T> third{T(1) / 3};
+   EXPECT_EQ((third == 1. / 3)[0], int(T(1) / 3 == 1. / 3));
+
+   // the first occurrence of the extremum, as std::max_element and std::min_element
+   RVec<T> ramp(40, T(1));
+   ramp[21] = ramp[37] = T(2);
+   ramp[3] = ramp[30] = T(0);
+   EXPECT_EQ(ArgMax(ramp), 21u);
+   EXPECT_EQ(ArgMin(ramp), 3u);
+
+   // with NaNs the result depends on the order of the comparisons, which is the one of std::max_element
+   ramp[10] = std::numeric_limits<T>::quiet_NaN();
+   EXPECT_EQ(ArgMax(ramp), std::size_t(std::max_element(ramp.begin(), ramp.end()) - ramp.begin()));
+   EXPECT_EQ(ArgMin(ramp), std::size_t(std::min_element(ramp.begin(), ramp.end()) - ramp.begin()));
+   ramp[0] = std::numeric_limits<T>::quiet_NaN();
+   EXPECT_EQ(ArgMax(ramp), 0u);
+   EXPECT_TRUE(std::isnan(Max(ramp)));
+}
+
+TEST(VecOps, Kernels)
+{
+   CheckKernels<float>();
+   CheckKernels<double>();
+   EXPECT_NE(std::string(ROOT::Internal::VecOps::Kernels::GetArchitecture()), "");
+}
+
 TEST(VecOps, AtWithFallback)
 {
    ROOT::VecOps::RVec<float> v({1.f, 2.f, 3.f});
@@ -1165,6 +1347,55 @@ TEST(VecOps, InvariantMass)
    EXPECT_NEAR(p5.M(), invMass3, 1e-4);
 }
 
+// The float and double kinematic helpers go through the vectorized kernels: check them against the formulas
+// computed with the functions of the standard library, on collections long enough to use the vectorized loops
+template <typename T>
+void CheckKinematicsKernels(double tolerance)
+{
+   const std::size_t n = 101;
+   RVec<T> pt1(n), eta1(n), phi1(n), mass1(n), pt2(n), eta2(n), phi2(n), mass2(n);
+   for (std::size_t i = 0; i < n; ++i) {
+      pt1[i] = 10 + i % 37;
+      eta1[i] = -2.4 + (i % 97) * 0.05;
+      phi1[i] = -3.1 + 0.061 * i;
+      mass1[i] = 0.5 + 0.1 * (i % 5);
+      pt2[i] = 5 + i % 11;
+      eta2[i] = 2.5 - (i % 89) * 0.055;
+      phi2[i] = 3.1 - 0.093 * i + (i % 7 == 0 ? 13 : 0);
+      mass2[i] = 1 + i % 3;
+   }
+
+   const auto toCartesian = [](double pt, double eta, double phi, double m, double *p) {
+      p[0] = pt * std::cos(phi);
+      p[1] = pt * std::sin(phi);
+      p[2] = pt * std::sinh(eta);
+      p[3] = std::sqrt(p[0] * p[0] + p[1] * p[1] + p[2] * p[2] + m * m);
+   };
+   const auto mass = [](const double *p) { return std::sqrt(p[3] * p[3] - p[0] * p[0] - p[1] * p[1] - p[2] * p[2]); };
+
+   const auto invMasses = InvariantMasses(pt1, eta1, phi1, mass1, pt2, eta2, phi2, mass2);
+   const auto dr = DeltaR(eta1, eta2, phi1, phi2);
+   double sum[4] = {0, 0, 0, 0};
+   for (std::size_t i = 0; i < n; ++i) {
+      double p1[4], p2[4];
+      toCartesian(pt1[i], eta1[i], phi1[i], mass1[i], p1);
+      toCartesian(pt2[i], eta2[i], phi2[i], mass2[i], p2);
+      for (int k = 0; k < 4; ++k) {
+         sum[k] += p1[k];
+         p2[k] += p1[k];
+      }
+      EXPECT_NEAR(invMasses[i], mass(p2), tolerance * mass(p2));
+      EXPECT_NEAR(dr[i], DeltaR<double>(eta1[i], eta2[i], phi1[i], phi2[i]), tolerance * 10);
+   }
+   EXPECT_NEAR(InvariantMass(pt1, eta1, phi1, mass1), mass(sum), tolerance * mass(sum));
+}
+
+TEST(VecOps, KinematicsKernels)
+{
+   CheckKinematicsKernels<float>(1e-5);
+   CheckKinematicsKernels<double>(1e-12);
+}
+
 TEST(VecOps, DeltaR)
 {
    RVec<double> eta1 =  {0.1, -1.0, -1.0, 0.5,  -2.5};
@@ -30,6 +30,9 @@ The RRawFileDavix class provides read-only access to remote non-ROOT files.  It
 the transport layer.  It instructs the RRawFile base class to buffer in larger chunks than the default for
 local files, assuming that remote file access has high(er) latency.
 
+Besides http[s]:// it reads s3[s]:// URLs, with the S3 credentials of the Davix.S3.* settings as for TDavixFile.
+Vector reads are sent as multi-range HTTP requests.
+
 */
 
 class RRawFileDavix : public RRawFile {
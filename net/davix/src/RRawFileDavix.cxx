@@ -11,8 +11,10 @@
 
 #include "ROOT/RRawFileDavix.hxx"
 
+#include <TEnv.h>
 #include <TError.h>
 
+#include <cstdlib>
 #include <memory>
 #include <stdexcept>
 #include <vector>
@@ -22,6 +24,31 @@
 
 namespace {
 constexpr int kDefaultBlockSize = 128 * 1024; // Read in relatively large 128k blocks for better network utilization
+
+// Only newer versions of davix support setting the S3 region and STS tokens, see TDavixFile
+template <typename TRequestParams = Davix::RequestParams>
+auto SetAwsRegion(TRequestParams *params, const char *region) -> decltype(params->setAwsRegion(region), void())
+{
+   params->setAwsRegion(region);
+}
+
+template <typename TRequestParams = Davix::RequestParams>
+void SetAwsRegion(...)
+{
+   Warning("RRawFileDavix", "Unable to set AWS region, not supported by this version of davix");
+}
+
+template <typename TRequestParams = Davix::RequestParams>
+auto SetAwsToken(TRequestParams *params, const char *token) -> decltype(params->setAwsToken(token), void())
+{
+   params->setAwsToken(token);
+}
+
+template <typename TRequestParams = Davix::RequestParams>
+void SetAwsToken(...)
+{
+   Warning("RRawFileDavix", "Unable to set AWS token, not supported by this version of davix");
+}
 } // anonymous namespace
 
 namespace ROOT {
@@ -33,9 +60,28 @@ struct RDavixFileDes {
    RDavixFileDes &operator=(const RDavixFileDes &) = delete;
    ~RDavixFileDes() = default;
 
+   /// Use the S3 credentials of Davix.S3.SecretKey, Davix.S3.AccessKey, Davix.S3.Region and Davix.S3.Token, which
+   /// default to the S3_SECRET_KEY, S3_ACCESS_KEY, S3_REGION and S3_TOKEN environment variables, like TDavixFile
+   void SetupS3()
+   {
+      const char *secretKey = gEnv->GetValue("Davix.S3.SecretKey", getenv("S3_SECRET_KEY"));
+      const char *accessKey = gEnv->GetValue("Davix.S3.AccessKey", getenv("S3_ACCESS_KEY"));
+      params.reset(new Davix::RequestParams());
+      params->setProtocol(Davix::RequestProtocol::AwsS3);
+      if (!secretKey || !accessKey)
+         return;
+      params->setAwsAuthorizationKeys(secretKey, accessKey);
+      if (const char *region = gEnv->GetValue("Davix.S3.Region", getenv("S3_REGION")))
+         SetAwsRegion(params.get(), region);
+      if (const char *token = gEnv->GetValue("Davix.S3.Token", getenv("S3_TOKEN")))
+         SetAwsToken(params.get(), token);
+   }
+
    DAVIX_FD *fd;
    Davix::Context ctx;
    Davix::DavPosix pos;
+   /// Parameters of the S3 requests, null for the default parameters
+   std::unique_ptr<Davix::RequestParams> params;
 };
 
 } // namespace Internal
@@ -45,6 +91,9 @@ struct RDavixFileDes {
 ROOT::Internal::RRawFileDavix::RRawFileDavix(std::string_view url, ROptions options)
    : RRawFile(url, options), fFileDes(new RDavixFileDes())
 {
+   const auto transport = GetTransport(url);
+   if (transport == "s3" || transport == "s3s")
+      fFileDes->SetupS3();
 }
 
 ROOT::Internal::RRawFileDavix::~RRawFileDavix()
@@ -62,7 +111,7 @@ std::uint64_t ROOT::Internal::RRawFileDavix::GetSizeImpl()
 {
    struct stat buf;
    Davix::DavixError *err = nullptr;
-   if (fFileDes->pos.stat(nullptr, fUrl, &buf, &err) == -1) {
+   if (fFileDes->pos.stat(fFileDes->params.get(), fUrl, &buf, &err) == -1) {
       throw std::runtime_error("Cannot determine size of '" + fUrl + "', error: " + err->getErrMsg());
    }
    return buf.st_size;
@@ -71,7 +120,7 @@ std::uint64_t ROOT::Internal::RRawFileDavix::GetSizeImpl()
 void ROOT::Internal::RRawFileDavix::OpenImpl()
 {
    Davix::DavixError *err = nullptr;
-   fFileDes->fd = fFileDes->pos.open(nullptr, fUrl, O_RDONLY, &err);
+   fFileDes->fd = fFileDes->pos.open(fFileDes->params.get(), fUrl, O_RDONLY, &err);
    if (fFileDes->fd == nullptr) {
       throw std::runtime_error("Cannot open '" + fUrl + "', error: " + err->getErrMsg());
    }
@@ -785,8 +785,18 @@ Bool_t TDavixFile::ReadBufferAsync(Long64_t offs, Int_t len)
 }
 
 ////////////////////////////////////////////////////////////////////////////////
+/// Read the nbuf blocks, through the node-wide block cache if it is enabled,
+/// see TFile::ReadBuffersViaBlockCache(). Returns kTRUE in case of failure.
 
 Bool_t TDavixFile::ReadBuffers(char *buf, Long64_t *pos, Int_t *len, Int_t nbuf)
+{
+   return ReadBuffersViaBlockCache(buf, pos, len, nbuf,
+      [this](char *b, Long64_t *p, Int_t *l, Int_t n) { return ReadBuffersRemote(b, p, l, n); });
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+Bool_t TDavixFile::ReadBuffersRemote(char *buf, Long64_t *pos, Int_t *len, Int_t nbuf)
 {
    Davix_fd *fd;
    if ((fd = d_ptr->getDavixFileInstance()) == NULL)
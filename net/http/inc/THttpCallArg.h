@@ -67,9 +67,13 @@ private:
    std::string  fContent;  ///<! content - text or binary
    std::string  fPostData; ///<! data received with post request - text - or binary
 
+   std::shared_ptr<const std::string> fZippedContent; ///<! gzip compressed content, set by THttpServer for cached replies
+
    void AssignWSId();
    std::shared_ptr<THttpWSEngine> TakeWSEngine();
 
+   static std::string MakeGzip(const char *objbuf, Long_t objlen);
+
 public:
    explicit THttpCallArg() {} // NOLINT: not allowed to use = default because of TObject::kIsOnHeap detection, see ROOT-10300
    virtual ~THttpCallArg();
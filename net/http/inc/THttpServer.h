@@ -16,6 +16,9 @@
 #include "TList.h"
 #include "THttpCallArg.h"
 
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
 #include <mutex>
 #include <map>
 #include <string>
@@ -58,6 +61,33 @@ protected:
    std::mutex fWSMutex;                                      ///<! mutex to protect WS handler lists
    std::vector<std::shared_ptr<THttpWSHandler>> fWSHandlers; ///<! list of WS handlers
 
+   /** reply of a read-only request, produced in the main thread and served from the engine threads */
+   struct CachedReply {
+      std::string fContent;                         ///< content of the reply
+      std::shared_ptr<const std::string> fZipped;   ///< gzip compressed content, if the reply can be compressed
+      TString fContentType;                         ///< type of the content
+      TString fHeader;                              ///< header of the reply
+      Int_t fZipping{0};                            ///< zipping mode of the reply
+      std::chrono::steady_clock::time_point fTime;  ///< time when the reply was produced
+      Long64_t fVersion{0};                         ///< version of the objects hierarchy when the reply was produced
+      Bool_t fReady{kFALSE};                        ///< false while the reply is produced
+   };
+
+   std::atomic<Int_t> fReadCacheTime{0};                            ///<! validity of the cached replies in ms, 0 disables the cache
+   std::mutex fReadCacheMutex;                                      ///<! mutex to protect the cache of replies
+   std::condition_variable fReadCacheCond;                          ///<! signals that a cached reply was produced
+   std::map<std::string, std::shared_ptr<CachedReply>> fReadCache;  ///<! cached replies of read-only requests
+   std::atomic<Long64_t> fReadCacheVersion{0};                      ///<! incremented when the objects hierarchy may have changed
+
+   std::string GetReadCacheKey(const THttpCallArg &arg) const;
+
+   Bool_t ExecuteCachedHttp(std::shared_ptr<THttpCallArg> &arg, const std::string &key);
+
+   Bool_t ExecuteHttpInMainThread(std::shared_ptr<THttpCallArg> &arg);
+
+   /** invalidate all cached replies, called when objects hierarchy may be changed */
+   void InvalidateReadCache() { fReadCacheVersion++; }
+
    virtual void MissedRequest(THttpCallArg *arg);
 
    virtual void ProcessRequest(std::shared_ptr<THttpCallArg> arg);
@@ -128,6 +158,11 @@ public:
 
    void SetTimer(Long_t milliSec = 100, Bool_t mode = kTRUE);
 
+   void SetReadCache(Int_t milliSec = 1000);
+
+   /** returns validity of the cached replies of read-only requests in ms, 0 if the cache is disabled */
+   Int_t GetReadCache() const { return fReadCacheTime; }
+
    void CreateServerThread();
 
    /** Check if file is requested, thread safe */
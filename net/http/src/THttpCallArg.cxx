@@ -359,12 +359,28 @@ std::string THttpCallArg::FillHttpHeader(const char *name)
 
 ////////////////////////////////////////////////////////////////////////////////
 /// compress reply data with gzip compression
+/// If compressed content was already provided by the server, e.g. from the cache
+/// of read-only requests, it is used instead
 
 Bool_t THttpCallArg::CompressWithGzip()
 {
-   char *objbuf = (char *)GetContent();
-   Long_t objlen = GetContentLength();
+   if (fZippedContent) {
+      SetContent(std::string(*fZippedContent));
+      fZippedContent.reset();
+   } else {
+      SetContent(MakeGzip((const char *)GetContent(), GetContentLength()));
+   }
+
+   SetEncoding("gzip");
+
+   return kTRUE;
+}
 
+////////////////////////////////////////////////////////////////////////////////
+/// returns data compressed in gzip format
+
+std::string THttpCallArg::MakeGzip(const char *objbuf, Long_t objlen)
+{
    unsigned long objcrc = R__crc32(0, NULL, 0);
    objcrc = R__crc32(objcrc, (const unsigned char *)objbuf, objlen);
 
@@ -395,7 +411,7 @@ Bool_t THttpCallArg::CompressWithGzip()
    memcpy(dummy, bufcur - 6, 6);
 
    // R__memcompress fills first 6 bytes with own header, therefore just overwrite them
-   unsigned long ziplen = R__memcompress(bufcur - 6, objlen + 6, objbuf, objlen);
+   unsigned long ziplen = R__memcompress(bufcur - 6, objlen + 6, (char *)objbuf, objlen);
 
    memcpy(bufcur - 6, dummy, 6);
 
@@ -415,11 +431,7 @@ Bool_t THttpCallArg::CompressWithGzip()
 
    buffer.resize(bufcur - (char *)buffer.data());
 
-   SetContent(std::move(buffer));
-
-   SetEncoding("gzip");
-
-   return kTRUE;
+   return buffer;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -129,6 +129,8 @@ ClassImp(THttpServer);
 ///     cors           - enable CORS header with origin="*"
 ///     cors=domain    - enable CORS header with origin="domain"
 ///     basic_sniffer  - use basic sniffer without support of hist, gpad, graph classes
+///     readcache      - serve read-only requests from engine threads, see SetReadCache()
+///     readcache=ms   - same, with replies valid for specified time in milliseconds
 ///
 /// For example, create http server, which allows cors headers and disable scan of global lists,
 /// one should provide "http:8080;cors;noglobal" as parameter
@@ -201,6 +203,10 @@ THttpServer::THttpServer(const char *engine) : TNamed("http", "ROOT http server"
             SetCors(opt + 5);
          } else if (strcmp(opt, "cors") == 0) {
             SetCors("*");
+         } else if (strncmp(opt, "readcache=", 10) == 0) {
+            SetReadCache(TString(opt + 10).Atoi());
+         } else if (strcmp(opt, "readcache") == 0) {
+            SetReadCache();
          } else
             CreateEngine(opt);
       }
@@ -438,6 +444,141 @@ void THttpServer::SetTimer(Long_t milliSec, Bool_t mode)
    }
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Enable the cache of replies of read-only requests
+///
+/// Requests of h.json and root.json (also as .gz) are then served directly from the
+/// engine threads (see "thrds" option of civetweb engine) when the same request was
+/// replied less than milliSec ago. Otherwise the request is processed as usual in
+/// the main thread, where objects are accessed consistently with application code,
+/// and its reply stored in the cache together with its gzip compressed version.
+/// Concurrent identical requests wait for the single reply produced in main thread.
+/// So the main thread produces each reply at most once per milliSec, independently
+/// of the number of clients. The cache is invalidated when objects or items are
+/// registered or modified via the server, and by any command or POST request.
+/// Requests issued from the main thread, or before it first called ProcessRequests(),
+/// are never served from the cache: main thread cannot wait for its own reply.
+///
+/// If milliSec <= 0, the cache is disabled (default).
+
+void THttpServer::SetReadCache(Int_t milliSec)
+{
+   std::lock_guard<std::mutex> grd(fReadCacheMutex);
+   fReadCacheTime = milliSec > 0 ? milliSec : 0;
+   fReadCache.clear();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Returns key identifying request in the cache of replies,
+/// or empty string if request cannot be served from the cache
+
+std::string THttpServer::GetReadCacheKey(const THttpCallArg &arg) const
+{
+   if ((fReadCacheTime <= 0) || IsWSOnly() || !arg.fPostData.empty())
+      return "";
+
+   if ((arg.fMethod.Length() > 0) && (arg.fMethod != "GET"))
+      return "";
+
+   TString filename = arg.fFileName;
+   if (filename.EndsWith(".gz"))
+      filename.Resize(filename.Length() - 3);
+   if ((filename != "h.json") && (filename != "root.json"))
+      return "";
+
+   std::string key = arg.fUserName.Data();
+   for (auto part : {&arg.fTopName, &arg.fPathName, &arg.fFileName, &arg.fQuery}) {
+      key.append("\n");
+      key.append(part->Data());
+   }
+   return key;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Execute read-only request, using the cache of replies
+/// Called from the engine threads
+
+Bool_t THttpServer::ExecuteCachedHttp(std::shared_ptr<THttpCallArg> &arg, const std::string &key)
+{
+   std::shared_ptr<CachedReply> reply;
+
+   {
+      std::unique_lock<std::mutex> lk(fReadCacheMutex);
+      while (true) {
+         auto iter = fReadCache.find(key);
+         if (iter == fReadCache.end())
+            break;
+         if (!iter->second->fReady) {
+            // same request is processed now in the main thread, wait for its reply
+            fReadCacheCond.wait(lk);
+            continue;
+         }
+         if ((iter->second->fVersion == fReadCacheVersion) &&
+             (std::chrono::steady_clock::now() - iter->second->fTime < std::chrono::milliseconds(fReadCacheTime.load())))
+            reply = iter->second;
+         else
+            fReadCache.erase(iter);
+         break;
+      }
+
+      if (!reply) {
+         // remove outdated replies before the cache grows too much
+         if (fReadCache.size() > 10000) {
+            auto now = std::chrono::steady_clock::now();
+            for (auto iter = fReadCache.begin(); iter != fReadCache.end();) {
+               if (iter->second->fReady && ((iter->second->fVersion != fReadCacheVersion) ||
+                                            (now - iter->second->fTime >= std::chrono::milliseconds(fReadCacheTime.load()))))
+                  iter = fReadCache.erase(iter);
+               else
+                  ++iter;
+            }
+         }
+         fReadCache[key] = std::make_shared<CachedReply>();
+      }
+   }
+
+   if (reply) {
+      arg->fContent = reply->fContent;
+      arg->fZippedContent = reply->fZipped;
+      arg->fContentType = reply->fContentType;
+      arg->fHeader = reply->fHeader;
+      arg->fZipping = reply->fZipping;
+      return kTRUE;
+   }
+
+   auto version = fReadCacheVersion.load();
+   auto tm = std::chrono::steady_clock::now();
+
+   Bool_t res = ExecuteHttpInMainThread(arg);
+
+   std::shared_ptr<CachedReply> produced;
+   if (res && !arg->Is404() && !arg->IsFile() && !arg->IsPostponed()) {
+      produced = std::make_shared<CachedReply>();
+      produced->fContent = arg->fContent;
+      produced->fContentType = arg->fContentType;
+      produced->fHeader = arg->fHeader;
+      produced->fZipping = arg->fZipping;
+      produced->fTime = tm;
+      produced->fVersion = version;
+      produced->fReady = kTRUE;
+      // compress only once, outside of main thread
+      if (arg->fZipping != THttpCallArg::kNoZip)
+         produced->fZipped = std::make_shared<const std::string>(THttpCallArg::MakeGzip(arg->fContent.data(), arg->fContent.length()));
+      arg->fZippedContent = produced->fZipped;
+   }
+
+   {
+      std::lock_guard<std::mutex> grd(fReadCacheMutex);
+      if (produced && (version == fReadCacheVersion))
+         fReadCache[key] = produced;
+      else
+         fReadCache.erase(key);
+   }
+   fReadCacheCond.notify_all();
+
+   return res;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Creates special thread to process all requests, directed to http server
 ///
@@ -569,12 +710,29 @@ Bool_t THttpServer::IsFileRequested(const char *uri, TString &res) const
 /// Executes http request, specified in THttpCallArg structure
 /// Method can be called from any thread
 /// Actual execution will be done in main ROOT thread, where analysis code is running.
+/// Read-only requests may be served from the cache of replies, see SetReadCache()
 
 Bool_t THttpServer::ExecuteHttp(std::shared_ptr<THttpCallArg> arg)
 {
    if (fTerminated)
       return kFALSE;
 
+   // main thread cannot wait for replies produced by itself, so the cache is used only
+   // once main thread is known, see ProcessRequests(), and never from main thread
+   if ((fMainThrdId != 0) && (fMainThrdId != TThread::SelfId())) {
+      std::string key = GetReadCacheKey(*arg);
+      if (!key.empty())
+         return ExecuteCachedHttp(arg, key);
+   }
+
+   return ExecuteHttpInMainThread(arg);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Execute http request in the main thread, blocking the calling thread until done
+
+Bool_t THttpServer::ExecuteHttpInMainThread(std::shared_ptr<THttpCallArg> &arg)
+{
    if ((fMainThrdId != 0) && (fMainThrdId == TThread::SelfId())) {
       // should not happen, but one could process requests directly without any signaling
 
@@ -799,6 +957,10 @@ void THttpServer::ProcessRequest(std::shared_ptr<THttpCallArg> arg)
       return;
    }
 
+   // commands may modify objects, drop replies cached before
+   if (arg->fFileName.BeginsWith("exe.") || arg->fFileName.BeginsWith("cmd.") || !arg->fPostData.empty())
+      InvalidateReadCache();
+
    if (arg->fFileName.IsNull() || (arg->fFileName == "index.htm") || (arg->fFileName == "default.htm")) {
 
       if (arg->fFileName == "default.htm") {
@@ -1043,6 +1205,7 @@ void THttpServer::ProcessRequest(std::shared_ptr<THttpCallArg> arg)
 
 Bool_t THttpServer::Register(const char *subfolder, TObject *obj)
 {
+   InvalidateReadCache();
    return fSniffer->RegisterObject(subfolder, obj);
 }
 
@@ -1053,6 +1216,7 @@ Bool_t THttpServer::Register(const char *subfolder, TObject *obj)
 
 Bool_t THttpServer::Unregister(TObject *obj)
 {
+   InvalidateReadCache();
    return fSniffer->UnregisterObject(obj);
 }
 
@@ -1181,6 +1345,7 @@ Bool_t THttpServer::ExecuteWS(std::shared_ptr<THttpCallArg> &arg, Bool_t externa
 
 void THttpServer::Restrict(const char *path, const char *options)
 {
+   InvalidateReadCache();
    fSniffer->Restrict(path, options);
 }
 
@@ -1214,6 +1379,7 @@ void THttpServer::Restrict(const char *path, const char *options)
 
 Bool_t THttpServer::RegisterCommand(const char *cmdname, const char *method, const char *icon)
 {
+   InvalidateReadCache();
    return fSniffer->RegisterCommand(cmdname, method, icon);
 }
 
@@ -1240,6 +1406,7 @@ Bool_t THttpServer::SetIcon(const char *fullname, const char *iconname)
 
 Bool_t THttpServer::CreateItem(const char *fullname, const char *title)
 {
+   InvalidateReadCache();
    return fSniffer->CreateItem(fullname, title);
 }
 
@@ -1247,6 +1414,7 @@ Bool_t THttpServer::CreateItem(const char *fullname, const char *title)
 
 Bool_t THttpServer::SetItemField(const char *fullname, const char *name, const char *value)
 {
+   InvalidateReadCache();
    return fSniffer->SetItemField(fullname, name, value);
 }
 
@@ -0,0 +1,124 @@
+#include "THttpCallArg.h"
+#include "THttpServer.h"
+#include "TNamed.h"
+
+#include "gtest/gtest.h"
+
+#include <chrono>
+#include <future>
+#include <memory>
+#include <string>
+#include <thread>
+
+namespace {
+
+// server without engine, requests are issued directly with ExecuteHttp()
+class TCacheTestServer : public THttpServer {
+public:
+   TCacheTestServer() : THttpServer("basic_sniffer") {}
+
+   /// Returns true if a cached reply is produced in the main thread for an engine thread
+   bool IsReplyPending()
+   {
+      std::lock_guard<std::mutex> grd(fReadCacheMutex);
+      for (auto &entry : fReadCache)
+         if (!entry.second->fReady)
+            return true;
+      return false;
+   }
+
+   /// Returns true if a request waits to be processed in the main thread
+   bool IsRequestQueued()
+   {
+      std::lock_guard<std::mutex> grd(fMutex);
+      return !fArgs.empty();
+   }
+
+   /// Returns number of replies in the cache
+   int GetNumCachedReplies()
+   {
+      std::lock_guard<std::mutex> grd(fReadCacheMutex);
+      int cnt = 0;
+      for (auto &entry : fReadCache)
+         if (entry.second->fReady)
+            cnt++;
+      return cnt;
+   }
+};
+
+std::string GetHierarchy(THttpServer &serv)
+{
+   auto arg = std::make_shared<THttpCallArg>();
+   arg->SetMethod("GET");
+   arg->SetPathAndFileName("/h.json");
+   if (!serv.ExecuteHttp(arg))
+      return "";
+   return std::string((const char *)arg->GetContent(), arg->GetContentLength());
+}
+
+// request from another thread, as done by the engines
+std::future<std::string> GetHierarchyAsync(THttpServer &serv)
+{
+   return std::async(std::launch::async, [&serv] { return GetHierarchy(serv); });
+}
+
+// wait until the condition is true, at most 10 s
+template <typename Cond>
+bool WaitFor(Cond cond)
+{
+   for (int n = 0; (n < 10000) && !cond(); ++n)
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+   return cond();
+}
+
+// process requests in the main thread until the reply is received
+bool WaitReply(THttpServer &serv, std::future<std::string> &reply)
+{
+   for (int n = 0; n < 10000; ++n) {
+      serv.ProcessRequests();
+      if (reply.wait_for(std::chrono::milliseconds(1)) == std::future_status::ready)
+         return true;
+   }
+   return false;
+}
+
+} // namespace
+
+TEST(THttpServer, ReadCache)
+{
+   TCacheTestServer serv;
+   serv.SetReadCache(60000);
+   TNamed named1("named1", "title"), named2("named2", "title");
+   serv.Register("/objects", &named1);
+
+   // main thread is not known before ProcessRequests(), the cache is not used
+   auto reply0 = GetHierarchyAsync(serv);
+   ASSERT_TRUE(WaitFor([&serv] { return serv.IsRequestQueued(); }));
+   ASSERT_TRUE(WaitReply(serv, reply0));
+   const std::string content = reply0.get();
+   EXPECT_NE(std::string::npos, content.find("named1"));
+   EXPECT_EQ(0, serv.GetNumCachedReplies());
+
+   // main thread does not wait for the reply that it should produce for another thread
+   auto reply1 = GetHierarchyAsync(serv);
+   ASSERT_TRUE(WaitFor([&serv] { return serv.IsReplyPending() && serv.IsRequestQueued(); }));
+   EXPECT_EQ(content, GetHierarchy(serv));
+   ASSERT_TRUE(WaitReply(serv, reply1));
+   EXPECT_EQ(content, reply1.get());
+   EXPECT_EQ(1, serv.GetNumCachedReplies());
+
+   // now served without main thread
+   auto reply2 = GetHierarchyAsync(serv);
+   ASSERT_EQ(std::future_status::ready, reply2.wait_for(std::chrono::seconds(10)));
+   EXPECT_EQ(content, reply2.get());
+
+   // registration invalidates the cache, the reply is produced again in main thread
+   serv.Register("/objects", &named2);
+   auto reply3 = GetHierarchyAsync(serv);
+   EXPECT_NE(std::future_status::ready, reply3.wait_for(std::chrono::milliseconds(100)));
+   ASSERT_TRUE(WaitReply(serv, reply3));
+   EXPECT_NE(std::string::npos, reply3.get().find("named2"));
+
+   serv.Unregister(&named1);
+   serv.Unregister(&named2);
+}
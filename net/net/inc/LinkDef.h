@@ -36,6 +36,7 @@
 #pragma link C++ class TSQLResult;
 #pragma link C++ class TSQLRow;
 #pragma link C++ class TSQLStatement;
+#pragma link C++ class TSQLColumnBuffer+;
 #pragma link C++ class TSQLTableInfo;
 #pragma link C++ class TSQLColumnInfo;
 #pragma link C++ class TSQLMonitoringWriter;
@@ -31,6 +31,8 @@
 #include "TMessage.h"
 #include "TUrl.h"
 
+#include <map>
+#include <string>
 
 class TSocket;
 class TArrayC;
@@ -44,6 +46,8 @@ private:
    Int_t    fServerVersion;  // Protocol version used by the server.
    TArrayC *fClassSent;      // Record which StreamerInfo we already sent.
    TMessage fMessage;
+   std::map<std::string, UInt_t> fUploaded; //! Checksum of the content of the cumulative objects, as last uploaded
+   std::map<std::string, UInt_t> fPending;  //! Checksum of the objects of the ongoing upload
 
 public:
    TParallelMergingFile(const char *filename, Option_t *option = "", const char *ftitle = "", Int_t compress = ROOT::RCompressionSetting::EDefaults::kUseCompiledDefault);
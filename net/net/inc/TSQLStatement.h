@@ -17,6 +17,29 @@
 #include "TDatime.h"
 #include "TTimeStamp.h"
 #include <vector>
+#include <string>
+
+/// Values of one column of a result set, filled by TSQLStatement::FetchRows().
+/// Only the vector matching fType is used; NULL values are stored as 0 or as an empty string.
+struct TSQLColumnBuffer {
+   enum EType { kLong64, kDouble, kString };
+
+   Int_t fField{0};                    ///< index of the column in the result set
+   EType fType{kLong64};               ///< type to which the column values are converted
+   std::vector<Long64_t> fLong64;      ///< values of a kLong64 column
+   std::vector<Double_t> fDouble;      ///< values of a kDouble column
+   std::vector<std::string> fString;   ///< values of a kString column
+
+   TSQLColumnBuffer() = default;
+   TSQLColumnBuffer(Int_t field, EType type) : fField(field), fType(type) {}
+
+   void Clear()
+   {
+      fLong64.clear();
+      fDouble.clear();
+      fString.clear();
+   }
+};
 
 class TSQLStatement : public TObject {
 
@@ -109,6 +132,8 @@ public:
    virtual Bool_t      GetVULong64(Int_t, std::vector<ULong64_t>&) { return kFALSE; }
    virtual Bool_t      GetVDouble(Int_t, std::vector<Double_t>&) { return kFALSE; }
 
+   virtual Int_t       FetchRows(std::vector<TSQLColumnBuffer> &columns, Int_t maxrows);
+
    virtual Bool_t      IsError() const { return GetErrorCode()!=0; }
    virtual Int_t       GetErrorCode() const;
    virtual const char* GetErrorMsg() const;
@@ -69,6 +69,7 @@ protected:
    virtual Int_t       GetFromCache(char *buf, Int_t len, Int_t nseg, Long64_t *seg_pos, Int_t *seg_len);
    virtual Bool_t      ReadBuffer10(char *buf, Int_t len);
    virtual Bool_t      ReadBuffers10(char *buf, Long64_t *pos, Int_t *len, Int_t nbuf);
+           Bool_t      ReadBuffersRemote(char *buf, Long64_t *pos, Int_t *len, Int_t nbuf);
    virtual void        SetMsgReadBuffer10(const char *redirectLocation = 0, Bool_t tempRedirect = kFALSE);
    virtual void        ProcessHttpHeader(const TString& headerLine);
 
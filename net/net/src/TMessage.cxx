@@ -26,9 +26,31 @@
 #include "Bytes.h"
 #include "TProcessID.h"
 #include "RZip.h"
+#include "TROOT.h"
+
+#include <algorithm>
+#include <vector>
 
 Bool_t TMessage::fgEvolution = kFALSE;
 
+namespace {
+/// Smallest zip buffer used to compress big messages concurrently with implicit multi-threading
+constexpr Int_t kMINPARALLELZIPBUF = 1024 * 1024;
+
+////////////////////////////////////////////////////////////////////////////////
+/// Size of the independent zip buffers of a message of length messlen.
+/// With implicit multi-threading, big messages like the ones of TParallelMergingFile
+/// are split in one buffer per thread, which are compressed concurrently.
+
+Int_t GetZipBufferSize(Int_t messlen)
+{
+   if (messlen < 2 * kMINPARALLELZIPBUF || !ROOT::IsImplicitMTEnabled())
+      return kMAXZIPBUF;
+   Int_t nthreads = std::max<Int_t>(ROOT::GetThreadPoolSize(), 1);
+   return std::min<Int_t>(kMAXZIPBUF, std::max(kMINPARALLELZIPBUF, 1 + (messlen - 1) / nthreads));
+}
+} // anonymous namespace
+
 
 ClassImp(TMessage);
 
@@ -343,22 +365,25 @@ Int_t TMessage::Compress()
 
    Int_t hdrlen   = 2*sizeof(UInt_t);
    Int_t messlen  = Length() - hdrlen;
-   Int_t nbuffers = 1 + (messlen - 1) / kMAXZIPBUF;
+   Int_t zipbuf   = GetZipBufferSize(messlen);
+   Int_t nbuffers = 1 + (messlen - 1) / zipbuf;
    Int_t chdrlen  = 3*sizeof(UInt_t);   // compressed buffer header length
    Int_t buflen   = std::max(512, chdrlen + messlen + 9*nbuffers);
    fBufComp       = new char[buflen];
-   char *messbuf  = Buffer() + hdrlen;
-   char *bufcur   = fBufComp + chdrlen;
-   Int_t noutot   = 0;
-   Int_t nzip     = 0;
-   Int_t nout, bufmax;
-   for (Int_t i = 0; i < nbuffers; ++i) {
-      if (i == nbuffers - 1)
-         bufmax = messlen - nzip;
-      else
-         bufmax = kMAXZIPBUF;
-      R__zipMultipleAlgorithm(compressionLevel, &bufmax, messbuf, &bufmax, bufcur, &nout,
+
+   // each zip buffer is compressed into its own slot, then the slots are moved together
+   std::vector<Int_t> nouts(nbuffers, 0);
+   auto zip = [&, this](UInt_t i) {
+      Int_t bufmax = (i == (UInt_t) nbuffers - 1) ? messlen - i * zipbuf : zipbuf;
+      R__zipMultipleAlgorithm(compressionLevel, &bufmax, Buffer() + hdrlen + i * zipbuf, &bufmax,
+                              fBufComp + chdrlen + i * (zipbuf + 9), &nouts[i],
                               static_cast<ROOT::RCompressionSetting::EAlgorithm::EValues>(compressionAlgorithm));
+   };
+   ROOT::Internal::ForEachInImplicitMTPool(nbuffers, zip);
+
+   char *bufcur  = fBufComp + chdrlen;
+   for (Int_t i = 0; i < nbuffers; ++i) {
+      Int_t nout = nouts[i];
       if (nout == 0 || nout >= messlen) {
          //this happens when the buffer cannot be compressed
          delete [] fBufComp;
@@ -367,10 +392,10 @@ Int_t TMessage::Compress()
          fCompPos    = nullptr;
          return -1;
       }
+      char *slot = fBufComp + chdrlen + i * (zipbuf + 9);
+      if (slot != bufcur)
+         memmove(bufcur, slot, nout);
       bufcur  += nout;
-      noutot  += nout;
-      messbuf += kMAXZIPBUF;
-      nzip    += kMAXZIPBUF;
    }
    fBufCompCur = bufcur;
    fCompPos    = fBufCur;
@@ -412,17 +437,47 @@ Int_t TMessage::Uncompress()
    fBufMax  = fBuffer + fBufSize;
    char *messbuf = fBuffer + hdrlen;
 
-   Int_t nout;
+   // locate the zip buffers, which are uncompressed concurrently with implicit multi-threading
+   struct ZipBuffer_t {
+      UChar_t *fSrc;
+      Int_t fNin;
+      char *fTgt;
+      Int_t fNbuf;
+      Int_t fNout;
+   };
+   std::vector<ZipBuffer_t> zipbufs;
+   UChar_t *bufend = (UChar_t *)fBufCompCur;
    Int_t noutot = 0;
-   while (1) {
-      Int_t hc = R__unzip_header(&nin, bufcur, &nbuf);
-      if (hc!=0) break;
-      R__unzip(&nin, bufcur, &nbuf, (unsigned char*) messbuf, &nout);
-      if (!nout) break;
-      noutot += nout;
-      if (noutot >= buflen - hdrlen) break;
+   while (!bufend || (bufcur + 9 <= bufend)) {
+      if (R__unzip_header(&nin, bufcur, &nbuf) != 0)
+         break;
+      if ((bufend && (bufcur + nin > bufend)) || (nbuf > buflen - hdrlen - noutot))
+         break;
+      zipbufs.push_back({bufcur, nin, messbuf, nbuf, 0});
+      noutot  += nbuf;
       bufcur  += nin;
-      messbuf += nout;
+      messbuf += nbuf;
+      if (noutot >= buflen - hdrlen) break;
+   }
+
+   if (noutot != buflen - hdrlen) {
+      Error("Uncompress", "The zip buffers hold %d bytes instead of %d", noutot, buflen - hdrlen);
+      return -1;
+   }
+
+   auto unzip = [&zipbufs](UInt_t i) {
+      R__unzip(&zipbufs[i].fNin, zipbufs[i].fSrc, &zipbufs[i].fNbuf, (unsigned char *)zipbufs[i].fTgt,
+               &zipbufs[i].fNout);
+   };
+   ROOT::Internal::ForEachInImplicitMTPool(zipbufs.size(), unzip);
+
+   // a corrupt or truncated zip buffer is not uncompressed, or only partly
+   for (const auto &zipbuf : zipbufs) {
+      if (zipbuf.fNout != zipbuf.fNbuf) {
+         Error("Uncompress", "Failed to uncompress a buffer (nin=%d, nbuf=%d, nout=%d)", zipbuf.fNin, zipbuf.fNbuf,
+               zipbuf.fNout);
+         return -1;
+      }
    }
 
    fWhat &= ~kMESS_ZIP;
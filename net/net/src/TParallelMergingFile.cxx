@@ -26,6 +26,55 @@
 #include "TParallelMergingFile.h"
 #include "TSocket.h"
 #include "TArrayC.h"
+#include "TBufferFile.h"
+#include "TClass.h"
+#include "TList.h"
+#include "RZip.h"
+
+#include <utility>
+#include <vector>
+
+namespace {
+
+using Detached_t = std::vector<std::pair<TDirectory *, TObject *>>;
+
+////////////////////////////////////////////////////////////////////////////////
+/// Detach from the directories the cumulative objects (e.g. the histograms), which are not reset
+/// after an upload, whose content did not change since the last upload. The server keeps the
+/// objects it received before, so that these objects do not need to be written and uploaded again.
+/// Records in pending the checksums of the content of the other cumulative objects.
+
+void DetachUnchanged(TDirectory *dir, const std::string &path, const std::map<std::string, UInt_t> &uploaded,
+                     std::map<std::string, UInt_t> &pending, Detached_t &detached)
+{
+   TIter next(dir->GetList());
+   while (TObject *obj = next()) {
+      TClass *cl = obj->IsA();
+      if (cl->InheritsFrom(TDirectory::Class())) {
+         DetachUnchanged(static_cast<TDirectory *>(obj), path + obj->GetName() + "/", uploaded, pending, detached);
+         continue;
+      }
+      if (cl->GetResetAfterMerge() || cl->GetMethodWithPrototype("ResetAfterMerge", "TFileMergeInfo*"))
+         continue;
+
+      TBufferFile buffer(TBuffer::kWrite);
+      buffer.WriteObjectAny(obj, cl);
+      UInt_t checksum = R__crc32(0, nullptr, 0);
+      checksum = R__crc32(checksum, (const unsigned char *)buffer.Buffer(), buffer.Length());
+
+      std::string name = path + obj->GetName();
+      auto iter = uploaded.find(name);
+      if ((iter != uploaded.end()) && (iter->second == checksum))
+         detached.emplace_back(dir, obj);
+      else
+         pending[name] = checksum;
+   }
+   for (auto &entry : detached)
+      if (entry.first == dir)
+         dir->GetList()->Remove(entry.second);
+}
+
+} // anonymous namespace
 
 ////////////////////////////////////////////////////////////////////////////////
 /// Constructor.
@@ -126,9 +175,16 @@ Bool_t TParallelMergingFile::UploadAndReset()
       Error("UploadAndReset","Upload to the merging server failed with %d\n",error);
       delete fSocket;
       fSocket = 0;
+      // a new connection starts from scratch on the server
+      fUploaded.clear();
+      fPending.clear();
       return kFALSE;
    }
 
+   for (auto &entry : fPending)
+      fUploaded[entry.first] = entry.second;
+   fPending.clear();
+
    // Record the StreamerInfo we sent over.
    Int_t isize = fClassIndex->GetSize();
    if (!fClassSent) {
@@ -164,7 +220,19 @@ Bool_t TParallelMergingFile::UploadAndReset()
 
 Int_t TParallelMergingFile::Write(const char *, Int_t opt, Int_t bufsiz)
 {
+   // The objects which were not reset by the previous upload and did not change since then
+   // are neither written nor uploaded, the server keeps the version it received before.
+   Detached_t detached;
+   fPending.clear();
+   if (!fSocket)
+      fUploaded.clear();
+   DetachUnchanged(this, "", fUploaded, fPending, detached);
+
    Int_t nbytes = TMemFile::Write(0,opt,bufsiz);
+
+   for (auto &entry : detached)
+      entry.first->GetList()->Add(entry.second);
+
    if (nbytes) {
       UploadAndReset();
    }
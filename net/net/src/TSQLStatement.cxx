@@ -220,6 +220,21 @@
 // given in the column of the statement. For non-PostgreSQL databases,
 // calling GetLargeObject()/SetLargeObject() is redirected to GetBinary()/SetBinary().
 //
+// 6. Bulk fetch of columns
+// ========================
+// Instead of calling the Get...() methods for each value, the values of several
+// columns can be copied into typed vectors, up to a given number of rows at once:
+//
+//    std::vector<TSQLColumnBuffer> cols;
+//    cols.emplace_back(0, TSQLColumnBuffer::kLong64);
+//    cols.emplace_back(2, TSQLColumnBuffer::kString);
+//    while (stmt->FetchRows(cols, 1000) > 0) {
+//       for (auto id : cols[0].fLong64) ...
+//    }
+//
+// Plugins may use a faster implementation which reads the values directly
+// from the data base client library.
+//
 ////////////////////////////////////////////////////////////////////////////////
 
 #include "TSQLStatement.h"
@@ -267,6 +282,35 @@ void TSQLStatement::SetError(Int_t code, const char* msg, const char* method)
       Error(method,"Code: %d  Msg: %s", code, (msg ? msg : "No message"));
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Fetch up to maxrows next rows of the result set into the column buffers.
+/// The buffers are cleared first; for each buffer, the value of field fField is
+/// converted to the type fType and appended to the matching vector.
+/// Returns the number of fetched rows, 0 when the result set is exhausted.
+
+Int_t TSQLStatement::FetchRows(std::vector<TSQLColumnBuffer> &columns, Int_t maxrows)
+{
+   for (auto &col : columns)
+      col.Clear();
+
+   Int_t nrows = 0;
+   while ((nrows < maxrows) && NextResultRow()) {
+      for (auto &col : columns) {
+         switch (col.fType) {
+         case TSQLColumnBuffer::kLong64: col.fLong64.push_back(IsNull(col.fField) ? 0 : GetLong64(col.fField)); break;
+         case TSQLColumnBuffer::kDouble: col.fDouble.push_back(IsNull(col.fField) ? 0. : GetDouble(col.fField)); break;
+         case TSQLColumnBuffer::kString: {
+            const char *str = IsNull(col.fField) ? nullptr : GetString(col.fField);
+            col.fString.emplace_back(str ? str : "");
+            break;
+         }
+         }
+      }
+      nrows++;
+   }
+   return nrows;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// set only date value for specified parameter from TDatime object
 
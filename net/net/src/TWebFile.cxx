@@ -494,9 +494,20 @@ Bool_t TWebFile::ReadBuffer10(char *buf, Int_t len)
 /// where pos[i] is the seek position of block i of length len[i].
 /// Note that for nbuf=1, this call is equivalent to TFile::ReafBuffer
 /// This function is overloaded by TNetFile, TWebFile, etc.
+/// The blocks go through the node-wide block cache if it is enabled, see
+/// TFile::ReadBuffersViaBlockCache().
 /// Returns kTRUE in case of failure.
 
 Bool_t TWebFile::ReadBuffers(char *buf, Long64_t *pos, Int_t *len, Int_t nbuf)
+{
+   return ReadBuffersViaBlockCache(buf, pos, len, nbuf,
+      [this](char *b, Long64_t *p, Int_t *l, Int_t n) { return ReadBuffersRemote(b, p, l, n); });
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Read the blocks from the HTTP daemon, see ReadBuffers().
+
+Bool_t TWebFile::ReadBuffersRemote(char *buf, Long64_t *pos, Int_t *len, Int_t nbuf)
 {
    if (!fHasModRoot)
       return ReadBuffers10(buf, pos, len, nbuf);
@@ -0,0 +1,55 @@
+// @(#)root/netxng:$Id$
+
+/*************************************************************************
+ * Copyright (C) 1995-2021, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#ifndef ROOT_RRawFileNetXNG
+#define ROOT_RRawFileNetXNG
+
+#include <ROOT/RRawFile.hxx>
+#include <ROOT/RStringView.hxx>
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+namespace ROOT {
+namespace Internal {
+
+struct RNetXNGFileDes;
+
+/** \class RRawFileNetXNG RRawFileNetXNG.hxx
+
+The RRawFileNetXNG class provides read-only access to remote files through the XRootD protocol, using the XrdCl
+client library.  Like RRawFileDavix, it instructs the RRawFile base class to buffer in larger chunks than the default
+for local files.  Vector reads are sent as XRootD readv requests, split according to the readv limits of the server
+and to NetXNG.ReadVMaxBytes bytes per request; the requests of one ReadV call are in flight at the same time.
+
+*/
+
+class RRawFileNetXNG : public RRawFile {
+private:
+   std::unique_ptr<Internal::RNetXNGFileDes> fFileDes;
+
+protected:
+   void OpenImpl() final;
+   size_t ReadAtImpl(void *buffer, size_t nbytes, std::uint64_t offset) final;
+   void ReadVImpl(RIOVec *ioVec, unsigned int nReq) final;
+   std::uint64_t GetSizeImpl() final;
+
+public:
+   RRawFileNetXNG(std::string_view url, RRawFile::ROptions options);
+   ~RRawFileNetXNG();
+   std::unique_ptr<RRawFile> Clone() const final;
+   int GetFeatures() const final { return kFeatureHasSize; }
+};
+
+} // namespace Internal
+} // namespace ROOT
+
+#endif
@@ -50,13 +50,14 @@ private:
    // if requested
    Int_t                   fReadvIorMax; // Max size of a single readv chunk
    Int_t                   fReadvIovMax; // Max number of readv chunks
+   Int_t                   fReadvMaxBytes; // Max number of bytes of a readv request, 0 for no limit
    Int_t                   fQueryReadVParams;
    TString                 fNewUrl;
 
 public:
    TNetXNGFile() : TFile(),
       fFile(0), fUrl(0), fMode(XrdCl::OpenFlags::None), fInitCondVar(0),
-      fReadvIorMax(0), fReadvIovMax(0) {}
+      fReadvIorMax(0), fReadvIovMax(0), fReadvMaxBytes(0) {}
    TNetXNGFile(const char *url, const char *lurl, Option_t *mode , const char *title ,
                Int_t compress , Int_t netopt , Bool_t parallelopen );
    TNetXNGFile(const char *url, Option_t *mode = "", const char *title = "",
@@ -81,6 +82,7 @@ public:
 
 private:
    virtual Bool_t IsUseable() const;
+   Bool_t         ReadBuffersRemote(char *buffer, Long64_t *position, Int_t *length, Int_t nbuffs);
    virtual Bool_t GetVectorReadLimits();
    virtual void   SetEnv();
    Int_t ParseOpenMode(Option_t *in, TString &modestr,
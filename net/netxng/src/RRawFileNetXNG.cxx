@@ -0,0 +1,244 @@
+// @(#)root/netxng:$Id$
+
+/*************************************************************************
+ * Copyright (C) 1995-2021, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#include "ROOT/RRawFileNetXNG.hxx"
+
+#include <TEnv.h>
+#include <TString.h>
+
+#include <XrdCl/XrdClFile.hh>
+#include <XrdCl/XrdClFileSystem.hh>
+#include <XrdCl/XrdClURL.hh>
+#include <XrdCl/XrdClXRootDResponses.hh>
+#include <XrdVersion.hh>
+
+#include <algorithm>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace {
+constexpr int kDefaultBlockSize = 128 * 1024; // Read in relatively large 128k blocks for better network utilization
+// Used if the server is not queried for its readv limits, see TNetXNGFile
+constexpr std::uint32_t kDefaultReadvIorMax = 2097136;
+constexpr std::uint32_t kDefaultReadvIovMax = 1024;
+
+/// The readv requests of a ReadV call that did not receive their response yet
+struct RPendingVectorReads {
+   std::mutex fMutex;
+   std::condition_variable fCondition;
+   unsigned int fNPending = 0;
+   std::string fError; ///< The first error, if any
+
+   void Wait()
+   {
+      std::unique_lock<std::mutex> lock(fMutex);
+      fCondition.wait(lock, [this] { return fNPending == 0; });
+   }
+};
+
+/// Handles the response of one readv request; deletes itself, as expected by XrdCl
+class RVectorReadHandler final : public XrdCl::ResponseHandler {
+   RPendingVectorReads &fReads;
+
+public:
+   explicit RVectorReadHandler(RPendingVectorReads &reads) : fReads(reads) {}
+
+   void HandleResponse(XrdCl::XRootDStatus *status, XrdCl::AnyObject *response) final
+   {
+      {
+         // Notify while holding the lock: the waiting ReadV call destructs fReads once fNPending reaches zero
+         std::lock_guard<std::mutex> lock(fReads.fMutex);
+         if (!status->IsOK() && fReads.fError.empty())
+            fReads.fError = status->ToStr();
+         --fReads.fNPending;
+         fReads.fCondition.notify_all();
+      }
+      delete status;
+      delete response;
+      delete this;
+   }
+};
+} // anonymous namespace
+
+namespace ROOT {
+namespace Internal {
+
+struct RNetXNGFileDes {
+   RNetXNGFileDes() = default;
+   RNetXNGFileDes(const RNetXNGFileDes &) = delete;
+   RNetXNGFileDes &operator=(const RNetXNGFileDes &) = delete;
+   ~RNetXNGFileDes() = default;
+
+   /// Query the readv limits of the data server, keeping the defaults if they are not available
+   void QueryReadVLimits();
+
+   XrdCl::File fFile;
+   std::uint32_t fReadvIorMax = kDefaultReadvIorMax; ///< Max size of a single readv chunk
+   std::uint32_t fReadvIovMax = kDefaultReadvIovMax; ///< Max number of chunks of a readv request
+   std::uint64_t fReadvMaxBytes = 0;                 ///< Max number of bytes of a readv request, 0 for no limit
+};
+
+} // namespace Internal
+} // namespace ROOT
+
+void ROOT::Internal::RNetXNGFileDes::QueryReadVLimits()
+{
+#if XrdVNUMBER >= 40000
+   std::string dataServerStr;
+   if (!fFile.GetProperty("DataServer", dataServerStr))
+      return;
+   XrdCl::FileSystem fs{XrdCl::URL(dataServerStr)};
+   XrdCl::Buffer arg;
+   arg.FromString(std::string("readv_ior_max readv_iov_max"));
+   XrdCl::Buffer *response = nullptr;
+   auto status = fs.Query(XrdCl::QueryCode::Config, arg, response);
+   if (!status.IsOK())
+      return;
+   std::unique_ptr<XrdCl::Buffer> responseGuard(response);
+
+   TString token;
+   Ssiz_t from = 0;
+   std::vector<TString> values;
+   TString responseStr(response->ToString());
+   while (responseStr.Tokenize(token, from, "\n"))
+      values.push_back(token);
+   if (values.size() != 2 || !values[0].IsDigit() || !values[1].IsDigit())
+      return;
+   // Same workaround of a dCache bug as in TNetXNGFile, https://sft.its.cern.ch/jira/browse/ROOT-6639
+   if (values[1].Atoi() == 0x7FFFFFFF)
+      return;
+   if (values[0].Atoi() > 0)
+      fReadvIorMax = values[0].Atoi();
+   if (values[1].Atoi() > 0)
+      fReadvIovMax = values[1].Atoi();
+#endif
+}
+
+ROOT::Internal::RRawFileNetXNG::RRawFileNetXNG(std::string_view url, ROptions options)
+   : RRawFile(url, options), fFileDes(new RNetXNGFileDes())
+{
+}
+
+ROOT::Internal::RRawFileNetXNG::~RRawFileNetXNG()
+{
+   if (fFileDes->fFile.IsOpen())
+      fFileDes->fFile.Close();
+}
+
+std::unique_ptr<ROOT::Internal::RRawFile> ROOT::Internal::RRawFileNetXNG::Clone() const
+{
+   return std::make_unique<RRawFileNetXNG>(fUrl, fOptions);
+}
+
+std::uint64_t ROOT::Internal::RRawFileNetXNG::GetSizeImpl()
+{
+   XrdCl::StatInfo *info = nullptr;
+   auto status = fFileDes->fFile.Stat(false, info);
+   if (!status.IsOK()) {
+      throw std::runtime_error("Cannot determine size of '" + fUrl + "', error: " + status.ToStr());
+   }
+   std::unique_ptr<XrdCl::StatInfo> infoGuard(info);
+   return info->GetSize();
+}
+
+void ROOT::Internal::RRawFileNetXNG::OpenImpl()
+{
+   auto status = fFileDes->fFile.Open(fUrl, XrdCl::OpenFlags::Read);
+   if (!status.IsOK()) {
+      throw std::runtime_error("Cannot open '" + fUrl + "', error: " + status.ToStr());
+   }
+   if (gEnv->GetValue("NetXNG.QueryReadVParams", 1))
+      fFileDes->QueryReadVLimits();
+   fFileDes->fReadvMaxBytes = std::max(gEnv->GetValue("NetXNG.ReadVMaxBytes", 8388608), 0);
+   if (fOptions.fBlockSize < 0)
+      fOptions.fBlockSize = kDefaultBlockSize;
+}
+
+size_t ROOT::Internal::RRawFileNetXNG::ReadAtImpl(void *buffer, size_t nbytes, std::uint64_t offset)
+{
+   size_t nread = 0;
+   while (nread < nbytes) {
+      std::uint32_t chunkSize = std::min<size_t>(nbytes - nread, fFileDes->fReadvIorMax);
+      std::uint32_t chunkRead = 0;
+      auto status = fFileDes->fFile.Read(offset + nread, chunkSize, static_cast<unsigned char *>(buffer) + nread,
+                                         chunkRead);
+      if (!status.IsOK()) {
+         throw std::runtime_error("Cannot read from '" + fUrl + "', error: " + status.ToStr());
+      }
+      nread += chunkRead;
+      // Short reads indicate the end of the file
+      if (chunkRead < chunkSize)
+         break;
+   }
+   return nread;
+}
+
+void ROOT::Internal::RRawFileNetXNG::ReadVImpl(RIOVec *ioVec, unsigned int nReq)
+{
+   const auto fileSize = GetSize();
+   const std::uint32_t iorMax = fFileDes->fReadvIorMax;
+   const std::uint32_t iovMax = fFileDes->fReadvIovMax;
+   const std::uint64_t maxBytes = fFileDes->fReadvMaxBytes;
+
+   // Readv requests fail on ranges beyond the end of the file, so the ranges are truncated to the file size
+   std::vector<XrdCl::ChunkList> chunkLists;
+   XrdCl::ChunkList chunks;
+   std::uint64_t chunksBytes = 0;
+   for (unsigned int i = 0; i < nReq; ++i) {
+      const std::uint64_t offset = ioVec[i].fOffset;
+      const std::size_t size = (offset >= fileSize) ? 0 : std::min<std::uint64_t>(ioVec[i].fSize, fileSize - offset);
+      ioVec[i].fOutBytes = size;
+      auto buffer = static_cast<unsigned char *>(ioVec[i].fBuffer);
+      for (std::size_t pos = 0; pos < size; pos += iorMax) {
+         const std::uint32_t length = std::min<std::size_t>(size - pos, iorMax);
+         if (!chunks.empty() && (chunks.size() >= iovMax || (maxBytes > 0 && chunksBytes + length > maxBytes))) {
+            chunkLists.emplace_back(std::move(chunks));
+            chunks = XrdCl::ChunkList();
+            chunksBytes = 0;
+         }
+         chunks.emplace_back(offset + pos, length, buffer + pos);
+         chunksBytes += length;
+      }
+   }
+   if (!chunks.empty())
+      chunkLists.emplace_back(std::move(chunks));
+
+   // Send all the readv requests before waiting for the responses
+   RPendingVectorReads reads;
+   std::string error;
+   for (auto &chunkList : chunkLists) {
+      {
+         std::lock_guard<std::mutex> lock(reads.fMutex);
+         ++reads.fNPending;
+      }
+      auto handler = new RVectorReadHandler(reads);
+      auto status = fFileDes->fFile.VectorRead(chunkList, nullptr, handler);
+      if (!status.IsOK()) {
+         delete handler;
+         {
+            std::lock_guard<std::mutex> lock(reads.fMutex);
+            --reads.fNPending;
+         }
+         error = status.ToStr();
+         break;
+      }
+   }
+   reads.Wait();
+
+   if (error.empty())
+      error = reads.fError;
+   if (!error.empty()) {
+      throw std::runtime_error("Cannot do vector read from '" + fUrl + "', error: " + error);
+   }
+}
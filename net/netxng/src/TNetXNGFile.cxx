@@ -162,6 +162,7 @@ TNetXNGFile::TNetXNGFile(const char *url,
    fQueryReadVParams = 1;
    fReadvIorMax = 2097136;
    fReadvIovMax = 1024;
+   fReadvMaxBytes = 0;
 
    if (ParseOpenMode(mode, fOption, fMode, kTRUE)<0) {
       Error("Open", "could not parse open mode %s", mode);
@@ -466,9 +467,24 @@ Bool_t TNetXNGFile::ReadBuffer(char *buffer, Long64_t position, Int_t length)
 ///                 position[i]
 /// param nbuffs:   number of chunks
 /// returns:        kTRUE in case of failure
+///
+/// The chunks are sent in several readv requests, within the limits of the
+/// server and of NetXNG.ReadVMaxBytes bytes each, which are all in flight at
+/// the same time. The blocks go through the node-wide block cache if it is
+/// enabled, see TFile::ReadBuffersViaBlockCache().
 
 Bool_t TNetXNGFile::ReadBuffers(char *buffer, Long64_t *position, Int_t *length,
       Int_t nbuffs)
+{
+   return ReadBuffersViaBlockCache(buffer, position, length, nbuffs,
+      [this](char *buf, Long64_t *pos, Int_t *len, Int_t nbuf) { return ReadBuffersRemote(buf, pos, len, nbuf); });
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Read the chunks from the server, see ReadBuffers().
+
+Bool_t TNetXNGFile::ReadBuffersRemote(char *buffer, Long64_t *position, Int_t *length,
+      Int_t nbuffs)
 {
    using namespace XrdCl;
 
@@ -478,6 +494,7 @@ Bool_t TNetXNGFile::ReadBuffers(char *buffer, Long64_t *position, Int_t *length,
 
    std::vector<ChunkList>      chunkLists;
    ChunkList                   chunks;
+   Long64_t                    chunksBytes = 0;
    std::vector<XRootDStatus*> *statuses;
    TSemaphore                 *semaphore;
    Int_t                       totalBytes = 0;
@@ -491,6 +508,20 @@ Bool_t TNetXNGFile::ReadBuffers(char *buffer, Long64_t *position, Int_t *length,
       for (Int_t i = 0; i < nbuffs; i++)
          position[i] += fArchiveOffset;
 
+   // Add a chunk to the current chunk list, or start another one if the list
+   // has the max number of chunks or bytes of a readv request
+   auto addChunk = [&](Long64_t chunkOffset, Int_t chunkLength) {
+      if (!chunks.empty() && ((Int_t) chunks.size() >= fReadvIovMax ||
+                              (fReadvMaxBytes > 0 && chunksBytes + chunkLength > fReadvMaxBytes))) {
+         chunkLists.push_back(std::move(chunks));
+         chunks = ChunkList();
+         chunksBytes = 0;
+      }
+      chunks.push_back(ChunkInfo(chunkOffset, chunkLength, cursor));
+      chunksBytes += chunkLength;
+      cursor += chunkLength;
+   };
+
    // Build a list of chunks. Put the buffers in the ChunkInfo's
    for (Int_t i = 0; i < nbuffs; ++i) {
       totalBytes += length[i];
@@ -504,27 +535,16 @@ Bool_t TNetXNGFile::ReadBuffers(char *buffer, Long64_t *position, Int_t *length,
          // Add as many max-size chunks as are divisible
          for (j = 0; j < nsplit; ++j) {
             offset = position[i] + (j * fReadvIorMax);
-            chunks.push_back(ChunkInfo(offset, fReadvIorMax, cursor));
-            cursor += fReadvIorMax;
+            addChunk(offset, fReadvIorMax);
          }
 
          // Add the remainder
-         offset = position[i] + (j * fReadvIorMax);
-         chunks.push_back(ChunkInfo(offset, rem, cursor));
-         cursor += rem;
+         if (rem > 0) {
+            offset = position[i] + (j * fReadvIorMax);
+            addChunk(offset, rem);
+         }
       } else {
-         chunks.push_back(ChunkInfo(position[i], length[i], cursor));
-         cursor += length[i];
-      }
-
-      // If there are more than or equal to max chunks, make another chunk list
-      if ((Int_t) chunks.size() == fReadvIovMax) {
-         chunkLists.push_back(chunks);
-         chunks = ChunkList();
-      } else if ((Int_t) chunks.size() > fReadvIovMax) {
-         chunkLists.push_back(ChunkList(chunks.begin(),
-                                        chunks.begin() + fReadvIovMax));
-         chunks = ChunkList(chunks.begin() + fReadvIovMax, chunks.end());
+         addChunk(position[i], length[i]);
       }
    }
 
@@ -537,7 +557,8 @@ Bool_t TNetXNGFile::ReadBuffers(char *buffer, Long64_t *position, Int_t *length,
    semaphore = new TSemaphore(0);
    statuses  = new std::vector<XRootDStatus*>(chunkLists.size());
 
-   // Read asynchronously but wait for all responses
+   // Send all the readv requests before waiting for the responses, so that
+   // they are all in flight at the same time
    std::vector<ChunkList>::iterator it;
    for (it = chunkLists.begin(); it != chunkLists.end(); ++it)
    {
@@ -878,6 +899,7 @@ void TNetXNGFile::SetEnv()
       env->PutString("ClientMonitorParam", val.Data());
 
    fQueryReadVParams = gEnv->GetValue("NetXNG.QueryReadVParams", 1);
+   fReadvMaxBytes = gEnv->GetValue("NetXNG.ReadVMaxBytes", 8388608);
    env->PutInt( "MultiProtocol", gEnv->GetValue("TFile.CrossProtocolRedirects", 1));
 
    // Old style netrc file
@@ -72,7 +72,7 @@ private:
   std::shared_ptr<DataSet_t> _dataset;
   std::mutex _mutex_dataset;
 
-  std::vector<std::vector<double>> _events; // One vector of values per data-processing slot
+  std::vector<std::vector<std::vector<double>>> _events; // One column of values per variable and data-processing slot
   const std::size_t _eventSize; // Number of variables in dataset
 
 public:
@@ -87,7 +87,7 @@ public:
   _eventSize{ _dataset->get()->size() }
   {
     const auto nSlots = ROOT::IsImplicitMTEnabled() ? ROOT::GetThreadPoolSize() : 1;
-    _events.resize(nSlots);
+    _events.resize(nSlots, std::vector<std::vector<double>>(_eventSize));
   }
 
 
@@ -128,45 +128,65 @@ public:
       + " columns.");
     }
 
-    auto& vector = _events[slot];
-    for (auto&& val : {values...}) {
-      vector.push_back(val);
+    auto& columns = _events[slot];
+    std::size_t j = 0;
+    for (double val : {static_cast<double>(values)...}) {
+      columns[j++].push_back(val);
     }
 
-    if (vector.size() > 1024 && _mutex_dataset.try_lock()) {
+    if (columns.front().size() > 1024 && _mutex_dataset.try_lock()) {
       const std::lock_guard<std::mutex> guard(_mutex_dataset, std::adopt_lock_t());
-      FillDataSet(vector, _eventSize);
-      vector.clear();
+      FillDataSet(*_dataset, columns);
     }
   }
 
   /// Empty all buffers into the dataset/hist to finish processing.
   void Finalize() {
-    for (auto& vector : _events) {
-      FillDataSet(vector, _eventSize);
-      vector.clear();
+    for (auto& columns : _events) {
+      FillDataSet(*_dataset, columns);
     }
   }
 
 
 private:
-  /// Append all `events` to the internal RooDataSet or increment the bins of a RooDataHist at the given locations.
+  /// Append all events to the internal RooDataSet, and empty the buffers.
+  /// The columns are appended in bulk, without loading the events into the variables of the dataset one by one.
   ///
-  /// \param events Events to fill into `data`. The layout is assumed to be `(x, y, z, ...) (x, y, z, ...), (...)`.
-  /// \note The order of the variables inside `events` must be consistent with the order given in the constructor.
+  /// \param columns Events to fill into `data`, one column for each variable of the dataset.
+  /// \note The order of the columns must be consistent with the order of the variables given in the constructor.
   /// No matching by name is performed.
-  /// \param eventSize Size of a single event.
-  void FillDataSet(const std::vector<double>& events, unsigned int eventSize) {
-    if (events.size() == 0)
+  static void FillDataSet(RooDataSet& data, std::vector<std::vector<double>>& columns) {
+    if (columns.empty() || columns.front().empty())
       return;
 
-    const RooArgSet& argSet = *_dataset->get();
+    std::vector<RooSpan<const double>> spans(columns.begin(), columns.end());
+    data.addEvents(RooArgList(*data.get()), spans);
 
-    for (std::size_t i = 0; i < events.size(); i += eventSize) {
-      for (std::size_t j=0; j < eventSize; ++j) {
-        static_cast<RooAbsRealLValue*>(argSet[j])->setVal(events[i+j]);
+    for (auto& column : columns) {
+      column.clear();
+    }
+  }
+
+  /// Increment the bins of the internal RooDataHist at the locations of the events, and empty the buffers.
+  ///
+  /// \param columns Events to fill into `data`, one column for each variable of the histogram.
+  /// \note The order of the columns must be consistent with the order of the variables given in the constructor.
+  /// No matching by name is performed.
+  static void FillDataSet(RooDataHist& data, std::vector<std::vector<double>>& columns) {
+    if (columns.empty() || columns.front().empty())
+      return;
+
+    const RooArgSet& argSet = *data.get();
+
+    for (std::size_t i = 0; i < columns.front().size(); ++i) {
+      for (std::size_t j=0; j < columns.size(); ++j) {
+        static_cast<RooAbsRealLValue*>(argSet[j])->setVal(columns[j][i]);
       }
-      _dataset->add(argSet);
+      data.add(argSet);
+    }
+
+    for (auto& column : columns) {
+      column.clear();
     }
   }
 };
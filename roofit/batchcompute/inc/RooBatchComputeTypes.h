@@ -0,0 +1,28 @@
+/*****************************************************************************
+ * RooFit
+ * Authors:                                                                  *
+ *   WV, Wouter Verkerke, UC Santa Barbara, verkerke@slac.stanford.edu       *
+ *   DK, David Kirkby,    UC Irvine,         dkirkby@uci.edu                 *
+ *                                                                           *
+ * Copyright (c) 2000-2021, Regents of the University of California          *
+ *                          and Stanford University. All rights reserved.    *
+ *                                                                           *
+ * Redistribution and use in source and binary forms,                        *
+ * with or without modification, are permitted according to the terms        *
+ * listed in LICENSE (http://roofit.sourceforge.net/license.txt)             *
+ *****************************************************************************/
+
+#ifndef ROOFIT_BATCHCOMPUTE_ROOBATCHCOMPUTETYPES_H
+#define ROOFIT_BATCHCOMPUTE_ROOBATCHCOMPUTETYPES_H
+
+/*
+ * Functions marked with __roodevice__ can be called both from the CPU and, when the library
+ * is compiled for CUDA (RF_ARCH=CUDA), from the kernels running on the GPU.
+ */
+#ifdef __CUDACC__
+#define __roodevice__ __host__ __device__
+#else
+#define __roodevice__
+#endif
+
+#endif /* ROOFIT_BATCHCOMPUTE_ROOBATCHCOMPUTETYPES_H */
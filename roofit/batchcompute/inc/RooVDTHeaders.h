@@ -23,7 +23,10 @@
  */
 
 
-#if defined(R__HAS_VDT)
+#include "RooBatchComputeTypes.h"
+
+// VDT is not available in CUDA kernels, which use the functions of the CUDA math library
+#if defined(R__HAS_VDT) && !defined(__CUDACC__)
 #include "vdt/exp.h"
 #include "vdt/log.h"
 #include "vdt/sqrt.h"
@@ -49,15 +52,15 @@ inline double fast_isqrt(double x) {
 
 namespace RooBatchCompute{
 
-inline double fast_exp(double x) {
+__roodevice__ inline double fast_exp(double x) {
   return std::exp(x);
 }
 
-inline double fast_log(double x) {
+__roodevice__ inline double fast_log(double x) {
   return std::log(x);
 }
 
-inline double fast_isqrt(double x) {
+__roodevice__ inline double fast_isqrt(double x) {
   return 1/std::sqrt(x);
 }
 
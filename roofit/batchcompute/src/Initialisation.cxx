@@ -61,6 +61,18 @@ void loadComputeLibrary() {
   } else if (gDebug>0) {
     std::cout << "In roofitcore/InitUtils.cxx:loadComputeLibrary(): Library " + libName + " was loaded successfully" << std::endl;
   }
+
+#ifdef R__RF_CUDA
+  // The CUDA library replaces the CPU one in RooBatchCompute::dispatch only if it finds a device.
+  // Without one, or if it cannot be loaded, the computations stay on the CPU.
+  if (gEnv->GetValue("RooFit.BatchCompute.CUDA", 0) != 0) {
+    const auto cudaReturnValue = gSystem->Load("libRooBatchCompute_CUDA");
+    if (gDebug>0) {
+      std::cout << "In roofitcore/InitUtils.cxx:loadComputeLibrary(): Library libRooBatchCompute_CUDA "
+                << (cudaReturnValue < 0 ? "could not be loaded" : "was loaded successfully") << std::endl;
+    }
+  }
+#endif //R__RF_CUDA
 }
 
 } //end anonymous namespace
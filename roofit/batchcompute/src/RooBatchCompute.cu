@@ -0,0 +1,184 @@
+/*****************************************************************************
+ * RooFit
+ * Authors:                                                                  *
+ *   WV, Wouter Verkerke, UC Santa Barbara, verkerke@slac.stanford.edu       *
+ *   DK, David Kirkby,    UC Irvine,         dkirkby@uci.edu                 *
+ *                                                                           *
+ * Copyright (c) 2000-2021, Regents of the University of California          *
+ *                          and Stanford University. All rights reserved.    *
+ *                                                                           *
+ * Redistribution and use in source and binary forms,                        *
+ * with or without modification, are permitted according to the terms        *
+ * listed in LICENSE (http://roofit.sourceforge.net/license.txt)             *
+ *****************************************************************************/
+
+// CUDA implementation of the RooBatchComputeInterface, compiled with RF_ARCH=CUDA.
+// The computers of RooBatchCompute.cxx whose run() is marked __roodevice__ are launched as kernels,
+// all the others run on the CPU as in the GENERIC library.
+#include "RooBatchCompute.cxx"
+
+#include <cuda_runtime.h>
+
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace RooBatchCompute {
+namespace RF_ARCH {
+
+namespace {
+
+void checkCuda(cudaError_t err, const char *what)
+{
+  if (err != cudaSuccess)
+    throw std::runtime_error(std::string("RooBatchCompute_CUDA: ") + what + " failed: " + cudaGetErrorString(err));
+}
+
+/// Argument of a kernel: either a batch of values in device memory or a scalar, passed by value.
+struct DeviceArg {
+  const double *fData;
+  double fScalar;
+  bool fIsBatch;
+
+  __roodevice__ double operator[](std::size_t i) const { return fIsBatch ? fData[i] : fScalar; }
+  __roodevice__ bool isBatch() const { return fIsBatch; }
+};
+
+template <class Computer_t, typename... Args_t>
+__global__ void computeKernel(Computer_t computer, std::size_t batchSize, double *output, Args_t... args)
+{
+  computer.run(batchSize, output, args...);
+}
+
+} // namespace
+
+/**
+ * \brief Implementation of the RooBatchComputeInterface that runs the computations on a GPU.
+ *
+ * The input batches are copied to device buffers, which are allocated once and reused between calls,
+ * the kernel of the PDF is launched on the stream of the library and its results are copied back to
+ * the memory of the RunContext. Batches smaller than kMinDeviceBatchSize, for which the transfers
+ * cost more than the computation, and the PDFs without a kernel are computed on the CPU.
+ *
+ * The instance only registers itself in RooBatchCompute::dispatch if a CUDA device is available.
+ */
+class RooBatchComputeCUDA : public RooBatchComputeClass {
+  static constexpr std::size_t kMinDeviceBatchSize = 4096;
+  static constexpr unsigned int kThreadsPerBlock = 256;
+  static constexpr unsigned int kMaxBlocks = 4096;
+
+  cudaStream_t fStream = nullptr;
+  std::vector<double *> fBuffers;        ///< Device buffers, indexed by the position of the argument (the output is 0)
+  std::vector<std::size_t> fBufferSizes; ///< Capacities of fBuffers
+  std::mutex fMutex;
+
+  /// Return the device buffer number `index`, holding at least `size` values.
+  double *deviceBuffer(std::size_t index, std::size_t size)
+  {
+    if (index >= fBuffers.size()) {
+      fBuffers.resize(index + 1, nullptr);
+      fBufferSizes.resize(index + 1, 0);
+    }
+    if (fBufferSizes[index] < size) {
+      cudaFree(fBuffers[index]);
+      fBuffers[index] = nullptr;
+      fBufferSizes[index] = 0;
+      checkCuda(cudaMalloc(&fBuffers[index], size * sizeof(double)), "cudaMalloc");
+      fBufferSizes[index] = size;
+    }
+    return fBuffers[index];
+  }
+
+  DeviceArg toDevice(RooSpan<const double> span, std::size_t &index)
+  {
+    if (span.size() <= 1)
+      return {nullptr, span[0], false};
+    double *data = deviceBuffer(index++, span.size());
+    checkCuda(cudaMemcpyAsync(data, span.data(), span.size() * sizeof(double), cudaMemcpyHostToDevice, fStream),
+              "copy of the input to the device");
+    return {data, 0., true};
+  }
+
+  /// Run the computer in a kernel, or on the CPU for small batches.
+  template <class Computer_t, typename... Args_t>
+  RooSpan<double> startDeviceComputation(const RooAbsReal *caller, RunContext &evalData, Computer_t computer,
+                                         Args_t... args)
+  {
+    AnalysisInfo info = analyseInputSpans({args...});
+    if (info.batchSize == SIZE_MAX || info.batchSize < kMinDeviceBatchSize)
+      return startComputation(caller, evalData, computer, args...);
+
+    std::lock_guard<std::mutex> lock(fMutex);
+    RooSpan<double> output = evalData.makeBatch(caller, info.batchSize);
+    std::size_t index = 1;
+    double *deviceOutput = deviceBuffer(0, info.batchSize);
+
+    const unsigned int nBlocks =
+      std::min<std::size_t>((info.batchSize + kThreadsPerBlock - 1) / kThreadsPerBlock, kMaxBlocks);
+    computeKernel<<<nBlocks, kThreadsPerBlock, 0, fStream>>>(computer, info.batchSize, deviceOutput,
+                                                             toDevice(args, index)...);
+    checkCuda(cudaGetLastError(), "kernel launch");
+    checkCuda(cudaMemcpyAsync(output.data(), deviceOutput, info.batchSize * sizeof(double), cudaMemcpyDeviceToHost,
+                              fStream),
+              "copy of the output to the host");
+    checkCuda(cudaStreamSynchronize(fStream), "computation");
+    return output;
+  }
+
+public:
+  RooBatchComputeCUDA() : RooBatchComputeClass(false)
+  {
+    int nDevices = 0;
+    if (cudaGetDeviceCount(&nDevices) != cudaSuccess || nDevices == 0)
+      return; // keep the CPU library
+    if (cudaStreamCreate(&fStream) != cudaSuccess)
+      return;
+    RooBatchCompute::dispatch = this;
+  }
+
+  ~RooBatchComputeCUDA()
+  {
+    for (double *buffer : fBuffers)
+      cudaFree(buffer);
+    if (fStream)
+      cudaStreamDestroy(fStream);
+  }
+
+  RooSpan<double> computeArgusBG(const RooAbsReal* caller, RunContext& evalData, RooSpan<const double> m, RooSpan<const double> m0, RooSpan<const double> c, RooSpan<const double> p)  override {
+    return startDeviceComputation(caller, evalData, ArgusBGComputer{}, m, m0, c, p);
+  }
+  RooSpan<double> computeBifurGauss(const RooAbsReal* caller, RunContext& evalData, RooSpan<const double> x, RooSpan<const double> mean, RooSpan<const double> sigmaL, RooSpan<const double> sigmaR)  override {
+    return startDeviceComputation(caller, evalData, BifurGaussComputer{}, x, mean, sigmaL, sigmaR);
+  }
+  RooSpan<double> computeBukin(const RooAbsReal* caller, RunContext& evalData, RooSpan<const double> x, RooSpan<const double> Xp, RooSpan<const double> sigp, RooSpan<const double> xi, RooSpan<const double> rho1, RooSpan<const double> rho2)  override {
+    return startDeviceComputation(caller, evalData, BukinComputer{}, x, Xp, sigp, xi, rho1, rho2);
+  }
+  RooSpan<double> computeBreitWigner(const RooAbsReal* caller, RunContext& evalData, RooSpan<const double> x, RooSpan<const double> mean, RooSpan<const double> width)  override {
+    return startDeviceComputation(caller, evalData, BreitWignerComputer{}, x, mean, width);
+  }
+  RooSpan<double> computeCBShape(const RooAbsReal* caller, RunContext& evalData, RooSpan<const double> m, RooSpan<const double> m0, RooSpan<const double> sigma, RooSpan<const double> alpha, RooSpan<const double> n)  override {
+    return startDeviceComputation(caller, evalData, CBShapeComputer{}, m, m0, sigma, alpha, n);
+  }
+  RooSpan<double> computeDstD0BG(const RooAbsReal* caller, RunContext& evalData, RooSpan<const double> dm, RooSpan<const double> dm0, RooSpan<const double> C, RooSpan<const double> A, RooSpan<const double> B)  override {
+    return startDeviceComputation(caller, evalData, DstD0BGComputer{}, dm, dm0, C, A, B);
+  }
+  RooSpan<double> computeExponential(const RooAbsReal* caller, RunContext& evalData, RooSpan<const double> x, RooSpan<const double> c)  override {
+    return startDeviceComputation(caller, evalData, ExponentialComputer{}, x, c);
+  }
+  RooSpan<double> computeGaussian(const RooAbsReal* caller, RunContext& evalData, RooSpan<const double> x, RooSpan<const double> mean, RooSpan<const double> sigma)  override {
+    return startDeviceComputation(caller, evalData, GaussianComputer{}, x, mean, sigma);
+  }
+  RooSpan<double> computeLognormal(const RooAbsReal* caller, RunContext& evalData, RooSpan<const double> x, RooSpan<const double> m0, RooSpan<const double> k)  override {
+    return startDeviceComputation(caller, evalData, LognormalComputer{}, x, m0, k);
+  }
+  RooSpan<double> computeNovosibirsk(const RooAbsReal* caller, RunContext& evalData, RooSpan<const double> x, RooSpan<const double> peak, RooSpan<const double> width, RooSpan<const double> tail)  override {
+    return startDeviceComputation(caller, evalData, NovosibirskComputer{}, x, peak, width, tail);
+  }
+}; // End class RooBatchComputeCUDA
+
+/// Static object to trigger the constructor which overwrites the dispatch pointer.
+static RooBatchComputeCUDA computeObj;
+
+} // End namespace RF_ARCH
+} // End namespace RooBatchCompute
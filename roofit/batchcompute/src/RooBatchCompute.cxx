@@ -4,6 +4,16 @@
 
 #include <complex>
 
+// The computers whose run() is marked __roodevice__ are also compiled as CUDA kernels, see RooBatchCompute.cu.
+// Each GPU thread then processes the entries BEGIN, BEGIN+STEP, ...; on the CPU, the loops cover all entries.
+#ifdef __CUDA_ARCH__
+#define BEGIN (blockDim.x * blockIdx.x + threadIdx.x)
+#define STEP (blockDim.x * gridDim.x)
+#else
+#define BEGIN 0
+#define STEP 1
+#endif
+
 namespace RooBatchCompute {
   /**
    * \brief Contains the part of the code of the RooBatchCompute Library that needs to be compiled for every different cpu architecture.
@@ -16,14 +26,14 @@ namespace RooBatchCompute {
 
     struct ArgusBGComputer {
       template<class Tm, class Tm0, class Tc, class Tp>
-      void run(size_t batchSize, double * __restrict output, Tm M, Tm0 M0, Tc C, Tp P ) const
+      __roodevice__ void run(size_t batchSize, double * __restrict output, Tm M, Tm0 M0, Tc C, Tp P ) const
       {
-        for (size_t i=0; i<batchSize; i++) {
+        for (size_t i=BEGIN; i<batchSize; i+=STEP) {
           const double t = M[i]/M0[i];
           const double u = 1 - t*t;
           output[i] = C[i]*u + P[i]*fast_log(u);
         }
-        for (size_t i=0; i<batchSize; i++) {
+        for (size_t i=BEGIN; i<batchSize; i+=STEP) {
           if (M[i] >= M0[i]) output[i] = 0.0;
           else output[i] = M[i]*fast_exp(output[i]);
         }
@@ -87,14 +97,14 @@ namespace RooBatchCompute {
 
     struct BifurGaussComputer {
       template<class Tx, class Tm, class Tsl, class Tsr>
-      void run(size_t batchSize, double * __restrict output, Tx X, Tm M, Tsl SL, Tsr SR) const
+      __roodevice__ void run(size_t batchSize, double * __restrict output, Tx X, Tm M, Tsl SL, Tsr SR) const
       {
-        for (size_t i=0; i<batchSize; i++) {
+        for (size_t i=BEGIN; i<batchSize; i+=STEP) {
           const double arg = X[i]-M[i];
           output[i] = arg / ((arg < 0.0)*SL[i] + (arg >= 0.0)*SR[i]);
         }
 
-        for (size_t i=0; i<batchSize; i++) {
+        for (size_t i=BEGIN; i<batchSize; i+=STEP) {
           if (X[i]-M[i]>1e-30 || X[i]-M[i]<-1e-30) {
             output[i] = fast_exp(-0.5*output[i]*output[i]);
           }
@@ -109,13 +119,13 @@ namespace RooBatchCompute {
 
     struct BukinComputer {
       template<class Tx, class TXp, class TSigp, class Txi, class Trho1, class Trho2>
-      void run(size_t batchSize, double * __restrict output, Tx X, TXp XP, TSigp SP, Txi XI, Trho1 R1, Trho2 R2) const
+      __roodevice__ void run(size_t batchSize, double * __restrict output, Tx X, TXp XP, TSigp SP, Txi XI, Trho1 R1, Trho2 R2) const
       {
         const double r3 = log(2.0);
         const double r6 = exp(-6.0);
         const double r7 = 2*sqrt(2*log(2.0));
 
-        for (size_t i=0; i<batchSize; i++) {
+        for (size_t i=BEGIN; i<batchSize; i+=STEP) {
           const double r1 = XI[i]*fast_isqrt(XI[i]*XI[i]+1);
           const double r4 = 1/fast_isqrt(XI[i]*XI[i]+1);
           const double hp = 1 / (SP[i]*r7);
@@ -143,7 +153,7 @@ namespace RooBatchCompute {
             output[i] = -4*r3*(X[i]-XP[i])*(X[i]-XP[i])*hp*hp;
           }
         }
-        for (size_t i=0; i<batchSize; i++) {
+        for (size_t i=BEGIN; i<batchSize; i+=STEP) {
           output[i] = fast_exp(output[i]);
         }
       }
@@ -153,9 +163,9 @@ namespace RooBatchCompute {
 
     struct BreitWignerComputer {
       template<class Tx, class Tmean, class Twidth>
-      void run(size_t batchSize, double * __restrict output, Tx X, Tmean M, Twidth W) const
+      __roodevice__ void run(size_t batchSize, double * __restrict output, Tx X, Tmean M, Twidth W) const
       {
-        for (size_t i=0; i<batchSize; i++) {
+        for (size_t i=BEGIN; i<batchSize; i+=STEP) {
           const double arg = X[i]-M[i];
           output[i] = 1 / (arg*arg + 0.25*W[i]*W[i]);
         }
@@ -166,9 +176,9 @@ namespace RooBatchCompute {
 
     struct CBShapeComputer {
       template<class Tm, class Tm0, class Tsigma, class Talpha, class Tn>
-      void run(	size_t batchSize, double * __restrict output, Tm M, Tm0 M0, Tsigma S, Talpha A, Tn N) const
+      __roodevice__ void run(	size_t batchSize, double * __restrict output, Tm M, Tm0 M0, Tsigma S, Talpha A, Tn N) const
       {
-        for (size_t i=0; i<batchSize; i++) {
+        for (size_t i=BEGIN; i<batchSize; i+=STEP) {
           const double t = (M[i]-M0[i]) / S[i];
           if ( (A[i]>0 && t>=-A[i]) || (A[i]<0 && -t>=A[i]) ) {
             output[i] = -0.5*t*t;
@@ -180,7 +190,7 @@ namespace RooBatchCompute {
           }
         }
 
-        for (size_t i=0; i<batchSize; i++) {
+        for (size_t i=BEGIN; i<batchSize; i+=STEP) {
           output[i] = fast_exp(output[i]);
         }
       }
@@ -255,16 +265,16 @@ namespace RooBatchCompute {
 
     struct DstD0BGComputer {
       template<class Tdm, class Tdm0, class TC, class TA, class TB>
-      void run(size_t batchSize, double * __restrict output, Tdm DM, Tdm0 DM0, TC C, TA A, TB B) const
+      __roodevice__ void run(size_t batchSize, double * __restrict output, Tdm DM, Tdm0 DM0, TC C, TA A, TB B) const
       {
-        for (size_t i=0; i<batchSize; i++) {
+        for (size_t i=BEGIN; i<batchSize; i+=STEP) {
           const double ratio = DM[i] / DM0[i];
           const double arg1 = (DM0[i]-DM[i]) / C[i];
           const double arg2 = A[i]*fast_log(ratio);
           output[i] = (1 -fast_exp(arg1)) * fast_exp(arg2) +B[i]*(ratio-1);
         }
 
-        for (size_t i=0; i<batchSize; i++) {
+        for (size_t i=BEGIN; i<batchSize; i+=STEP) {
           if (output[i]<0) output[i] = 0;
         }
       }
@@ -274,9 +284,9 @@ namespace RooBatchCompute {
 
     struct ExponentialComputer {
       template<class Tx, class Tc>
-      void run(size_t n, double* __restrict output, Tx x, Tc c) const
+      __roodevice__ void run(size_t n, double* __restrict output, Tx x, Tc c) const
       {
-        for (size_t i = 0; i < n; ++i) {
+        for (size_t i=BEGIN; i<n; i+=STEP) {
           output[i] = fast_exp(x[i]*c[i]);
         }
       }
@@ -338,9 +348,9 @@ namespace RooBatchCompute {
   ///overlap, results will likely be garbage.
     struct GaussianComputer {
       template<class Tx, class TMean, class TSig>
-      void run(size_t n, double* __restrict output, Tx x, TMean mean, TSig sigma) const
+      __roodevice__ void run(size_t n, double* __restrict output, Tx x, TMean mean, TSig sigma) const
       {
-        for (std::size_t i=0; i<n; ++i) {
+        for (size_t i=BEGIN; i<n; i+=STEP) {
           const double arg = x[i]-mean[i];
           const double halfBySigmaSq = -0.5 / (sigma[i]*sigma[i]);
           output[i] = fast_exp(arg*arg*halfBySigmaSq);
@@ -479,10 +489,10 @@ namespace RooBatchCompute {
 
     struct LognormalComputer {
       template<class Tx, class Tm0, class Tk>
-      void run(size_t batchSize, double* __restrict output, Tx X, Tm0 M0, Tk K) const
+      __roodevice__ void run(size_t batchSize, double* __restrict output, Tx X, Tm0 M0, Tk K) const
       {
         const double rootOf2pi = 2.506628274631000502415765284811;
-        for (size_t i=0; i<batchSize; i++) {
+        for (size_t i=BEGIN; i<batchSize; i+=STEP) {
           double lnxOverM0 = fast_log(X[i]/M0[i]);
           double lnk = fast_log(K[i]);
           if (lnk<0) lnk = -lnk;
@@ -505,10 +515,10 @@ namespace RooBatchCompute {
        * formula, that is before the asinh replacement
        */
       template<class Tx, class Twidth, class Tpeak, class Ttail>
-      void run(size_t batchSize, double * __restrict output, Tx X, Tpeak P, Twidth W, Ttail T) const
+      __roodevice__ void run(size_t batchSize, double * __restrict output, Tx X, Tpeak P, Twidth W, Ttail T) const
       {
         constexpr double xi = 2.3548200450309494; // 2 Sqrt( Ln(4) )
-        for (size_t i=0; i<batchSize; i++) {
+        for (size_t i=BEGIN; i<batchSize; i+=STEP) {
           double argasinh = 0.5*xi*T[i];
           double argln = argasinh + 1/fast_isqrt(argasinh*argasinh +1);
           double asinh = fast_log(argln);
@@ -521,7 +531,7 @@ namespace RooBatchCompute {
         }
 
         //faster if you exponentiate in a seperate loop (dark magic!)
-        for (size_t i=0; i<batchSize; i++) {
+        for (size_t i=BEGIN; i<batchSize; i+=STEP) {
           output[i] = fast_exp(output[i]);
         }
       }
@@ -658,7 +668,7 @@ namespace RooBatchCompute {
      * last instance that was created.
      */
     class RooBatchComputeClass : public RooBatchComputeInterface {
-      private:
+      protected:
 
         struct AnalysisInfo {
           size_t batchSize=SIZE_MAX;
@@ -696,9 +706,10 @@ namespace RooBatchCompute {
         }
 
       public:
-        RooBatchComputeClass() {
+        RooBatchComputeClass(bool setDispatch = true) {
           // Set the dispatch pointer to this instance of the library upon loading
-          RooBatchCompute::dispatch = this;
+          if (setDispatch)
+            RooBatchCompute::dispatch = this;
         }
         RooSpan<double> computeArgusBG(const RooAbsReal* caller, RunContext& evalData, RooSpan<const double> m, RooSpan<const double> m0, RooSpan<const double> c, RooSpan<const double> p)  override {
           return startComputation(caller, evalData, ArgusBGComputer{}, m, m0, c, p);
@@ -759,8 +770,11 @@ namespace RooBatchCompute {
         }
     }; // End class RooBatchComputeClass
 
+#ifndef __CUDACC__
     /// Static object to trigger the constructor which overwrites the dispatch pointer.
+    /// The CUDA library registers its own implementation, see RooBatchCompute.cu.
     static RooBatchComputeClass computeObj;
+#endif
 
   } //End namespace RF_ARCH
 } //End namespace RooBatchCompute
@@ -60,6 +60,8 @@ namespace HistFactory{
     double nominal() const;        
     const std::vector<double>& low() const;
     const std::vector<double>& high() const;    
+
+    virtual void translate(RooFit::Detail::CodeSquashContext &ctx) const;
     
   private:
 
@@ -95,8 +95,14 @@ protected:
 
   std::vector<int> _interpCode;
 
+  // Batch evaluation of RooHistFunc templates with identical binning, see evaluateSpan()
+  mutable std::vector<const void*> _templateKey; //! Templates and histograms for which _sameBinnedTemplates was determined
+  mutable bool _sameBinnedTemplates = false;     //! If the templates can be looked up with the bin numbers of the nominal
+  mutable std::vector<double> _templateValues;   //! Values of nominal, low and high templates, one row per template
+
   Double_t evaluate() const;
   RooSpan<double> evaluateSpan(RooBatchCompute::RunContext& evalData, const RooArgSet* normSet) const;
+  bool haveSameBinnedTemplates() const;
 
   ClassDef(PiecewiseInterpolation,4) // Sum of RooAbsReal objects
 };
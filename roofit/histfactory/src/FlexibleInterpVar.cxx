@@ -19,6 +19,7 @@
 
 #include "Riostream.h"
 #include <math.h>
+#include <stdexcept>
 #include "TMath.h"
 
 #include "RooAbsReal.h"
@@ -26,6 +27,7 @@
 #include "RooArgList.h"
 #include "RooMsgService.h"
 #include "RooTrace.h"
+#include "RooFit/Detail/CodeSquashContext.h"
 
 #include "RooStats/HistFactory/FlexibleInterpVar.h"
 
@@ -458,6 +460,76 @@ Double_t FlexibleInterpVar::evaluate() const
   return total;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Translate the interpolation into C++ code, for the analytic gradients of
+/// RooFuncWrapper. The code computes the same value as evaluate(), with the
+/// coefficients of the polynomial interpolation as constants.
+
+void FlexibleInterpVar::translate(RooFit::Detail::CodeSquashContext &ctx) const
+{
+  using RooFit::Detail::CodeSquashContext;
+
+  // make sure that the coefficients of the polynomial interpolation are cached
+  if (!_paramList.empty()) PolyInterpValue(0, 0.);
+
+  const std::string total = ctx.getTmpVarName();
+  const std::string nominal = CodeSquashContext::buildArg(_nominal);
+  std::string code = "   double " + total + " = " + nominal + ";\n";
+
+  for (std::size_t i = 0; i < _paramList.size(); ++i) {
+    const std::string p = ctx.getResult(_paramList[i]);
+    const std::string hi = CodeSquashContext::buildArg(_high[i]);
+    const std::string lo = CodeSquashContext::buildArg(_low[i]);
+
+    switch(_interpCode[i]) {
+    case 0: {
+      // piece-wise linear
+      code += "   " + total + " += " + p + " > 0 ? " + p + " * (" + hi + " - " + nominal + ") : " + p + " * (" + nominal
+              + " - " + lo + ");\n";
+      break ;
+    }
+    case 1: {
+      // pice-wise log
+      code += "   " + total + " *= " + p + " >= 0 ? TMath::Power(" + CodeSquashContext::buildArg(_high[i] / _nominal)
+              + ", " + p + ") : TMath::Power(" + CodeSquashContext::buildArg(_low[i] / _nominal) + ", -" + p + ");\n";
+      break ;
+    }
+    case 2:
+    case 3: {
+      // parabolic with linear
+      const double a = 0.5*(_high[i]+_low[i])-_nominal;
+      const double b = 0.5*(_high[i]-_low[i]);
+      code += "   " + total + " += " + p + " > 1 ? " + CodeSquashContext::buildArg(2*a+b) + " * (" + p + " - 1.0) + "
+              + CodeSquashContext::buildArg(_high[i]-_nominal) + " : (" + p + " < -1 ? "
+              + CodeSquashContext::buildArg(-1*(2*a-b)) + " * (" + p + " + 1.0) + "
+              + CodeSquashContext::buildArg(_low[i]-_nominal) + " : " + CodeSquashContext::buildArg(a) + " * " + p
+              + " * " + p + " + " + CodeSquashContext::buildArg(b) + " * " + p + ");\n";
+      break ;
+    }
+    case 4: {
+      const std::string boundary = CodeSquashContext::buildArg(_interpBoundary);
+      // the 6-th degree polynomial with Horner's method, see PolyInterpValue()
+      std::string poly = CodeSquashContext::buildArg(_polCoeff[6 * i + 5]);
+      for (int j = 4; j >= 0; --j) {
+        poly = CodeSquashContext::buildArg(_polCoeff[6 * i + j]) + " + " + p + " * (" + poly + ")";
+      }
+      code += "   " + total + " *= " + p + " >= " + boundary + " ? TMath::Power("
+              + CodeSquashContext::buildArg(_high[i] / _nominal) + ", " + p + ") : (" + p + " <= -" + boundary
+              + " ? TMath::Power(" + CodeSquashContext::buildArg(_low[i] / _nominal) + ", -" + p + ") : 1.0 + " + p
+              + " * (" + poly + "));\n";
+      break ;
+    }
+    default: {
+      throw std::runtime_error(std::string("FlexibleInterpVar::translate(") + GetName() + "): unknown interpolation code for "
+                               + _paramList[i].GetName());
+    }
+    }
+  }
+
+  ctx.addToCodeBody(this, code);
+  ctx.addResult(this, total + " <= 0 ? " + CodeSquashContext::buildArg(TMath::Limits<double>::Min()) + " : " + total);
+}
+
 void FlexibleInterpVar::printMultiline(ostream& os, Int_t contents, 
 				       Bool_t verbose, TString indent) const
 {
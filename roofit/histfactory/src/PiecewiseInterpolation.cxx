@@ -30,6 +30,9 @@
 #include "RooErrorHandler.h"
 #include "RooArgSet.h"
 #include "RooRealVar.h"
+#include "RooHistFunc.h"
+#include "RooDataHist.h"
+#include "RooAbsBinning.h"
 #include "RooMsgService.h"
 #include "RooNumIntConfig.h"
 #include "RooTrace.h"
@@ -38,6 +41,7 @@
 #include <exception>
 #include <math.h>
 #include <algorithm>
+#include <cstring>
 
 using namespace std;
 
@@ -314,118 +318,265 @@ Double_t PiecewiseInterpolation::evaluate() const
 }
 
 
+namespace {
+
+// Kernels of the batch evaluation, which add the variation of one parameter to all bins of `sum`.
+// The branches on the parameter value are taken outside of the loops over the bins, so these
+// can be vectorised.
+
+void interpolateLinear(RooSpan<double> sum, RooSpan<const double> nominal, RooSpan<const double> low,
+                       RooSpan<const double> high, double param)
+{
+  if (param > 0) {
+    for (std::size_t j = 0; j < sum.size(); ++j)
+      sum[j] += param * (high[j] - nominal[j]);
+  } else {
+    for (std::size_t j = 0; j < sum.size(); ++j)
+      sum[j] += param * (nominal[j] - low[j]);
+  }
+}
+
+void interpolateLog(RooSpan<double> sum, RooSpan<const double> nominal, RooSpan<const double> low,
+                    RooSpan<const double> high, double param)
+{
+  if (param >= 0) {
+    for (std::size_t j = 0; j < sum.size(); ++j)
+      sum[j] *= pow(high[j] / nominal[j], +param);
+  } else {
+    for (std::size_t j = 0; j < sum.size(); ++j)
+      sum[j] *= pow(low[j] / nominal[j], -param);
+  }
+}
+
+void interpolateParabolic(RooSpan<double> sum, RooSpan<const double> nominal, RooSpan<const double> low,
+                          RooSpan<const double> high, double param)
+{
+  if (param > 1.) {
+    for (std::size_t j = 0; j < sum.size(); ++j) {
+      const double a = 0.5*(high[j]+low[j])-nominal[j];
+      const double b = 0.5*(high[j]-low[j]);
+      sum[j] += (2*a+b)*(param -1)+high[j]-nominal[j];
+    }
+  } else if (param < -1.) {
+    for (std::size_t j = 0; j < sum.size(); ++j) {
+      const double a = 0.5*(high[j]+low[j])-nominal[j];
+      const double b = 0.5*(high[j]-low[j]);
+      sum[j] += -1*(2*a-b)*(param +1)+low[j]-nominal[j];
+    }
+  } else {
+    const double param2 = param * param;
+    for (std::size_t j = 0; j < sum.size(); ++j) {
+      const double a = 0.5*(high[j]+low[j])-nominal[j];
+      const double b = 0.5*(high[j]-low[j]);
+      sum[j] += a*param2 + b*param;
+    }
+  }
+}
+
+void interpolatePoly6(RooSpan<double> sum, RooSpan<const double> nominal, RooSpan<const double> low,
+                      RooSpan<const double> high, double x)
+{
+  if (x > 1.) {
+    for (std::size_t j = 0; j < sum.size(); ++j)
+      sum[j] += x * (high[j] - nominal[j]);
+  } else if (x < -1.) {
+    for (std::size_t j = 0; j < sum.size(); ++j)
+      sum[j] += x * (nominal[j] - low[j]);
+  } else {
+    const double poly = 15. + x * x * (-10. + x * x * 3.);
+    for (std::size_t j = 0; j < sum.size(); ++j) {
+      const double eps_plus = high[j] - nominal[j];
+      const double eps_minus = nominal[j] - low[j];
+      const double S = 0.5 * (eps_plus + eps_minus);
+      const double A = 0.0625 * (eps_plus - eps_minus);
+
+      const double val = nominal[j] + x * (S + x * A * poly);
+      sum[j] += (val < 0. ? 0. : val) - nominal[j];
+    }
+  }
+}
+
+void interpolatePoly4(RooSpan<double> sum, RooSpan<const double> nominal, RooSpan<const double> low,
+                      RooSpan<const double> high, double param)
+{
+  if (param > 1. || param < -1.) {
+    interpolateLinear(sum, nominal, low, high, param);
+    return;
+  }
+
+  const double param2 = param * param;
+  const double param4 = param2 * param2;
+  for (std::size_t j = 0; j < sum.size(); ++j) {
+    const double eps_plus = high[j] - nominal[j];
+    const double eps_minus = nominal[j] - low[j];
+    const double S = (eps_plus + eps_minus)/2;
+    const double A = (eps_plus - eps_minus)/2;
+
+    //fcns+der are eq at bd
+    const double a = S;
+    const double b = 3*A/(2*1.);
+    const double d = -A/(2*1.*1.*1.);
+
+    const double val = nominal[j] + a * param + b * param2 + d * param4;
+    if (nominal[j] != 0)
+      sum[j] += (val < 0. ? 0. : val) - nominal[j];
+  }
+}
+
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Check if the nominal, low and high functions are all RooHistFunc without interpolation, which
+/// depend on the same observables and represent histograms with identical binning. In this case,
+/// the bin numbers only need to be computed once, and the contents of all templates are read from
+/// the histograms directly. The result is cached until the templates change.
+
+bool PiecewiseInterpolation::haveSameBinnedTemplates() const
+{
+  std::vector<const void*> key;
+  key.reserve(2 * (_lowSet.size() + _highSet.size() + 1));
+  auto addToKey = [&key](const RooAbsArg& arg) {
+    key.push_back(&arg);
+    auto histFunc = dynamic_cast<const RooHistFunc*>(&arg);
+    key.push_back(histFunc ? &histFunc->dataHist() : nullptr);
+  };
+  addToKey(_nominal.arg());
+  for (const auto arg : _lowSet) addToKey(*arg);
+  for (const auto arg : _highSet) addToKey(*arg);
+
+  if (key == _templateKey) {
+    return _sameBinnedTemplates;
+  }
+  _templateKey = std::move(key);
+  _sameBinnedTemplates = false;
+
+  auto nominal = dynamic_cast<const RooHistFunc*>(&_nominal.arg());
+  if (!nominal || nominal->getInterpolationOrder() != 0 || nominal->getHistObsList().empty()) return false;
+  const RooDataHist& nominalHist = nominal->dataHist();
+  nominalHist.checkInit();
+
+  auto sameBinning = [](const RooAbsBinning* b1, const RooAbsBinning* b2) {
+    if (b1 == nullptr || b2 == nullptr) return b1 == b2;
+    if (b1->numBins() != b2->numBins()) return false;
+    for (int i = 0; i < b1->numBins(); ++i) {
+      if (b1->binLow(i) != b2->binLow(i) || b1->binHigh(i) != b2->binHigh(i)) return false;
+    }
+    return true;
+  };
+
+  auto matchesNominal = [&](const RooAbsArg& arg) {
+    auto histFunc = dynamic_cast<const RooHistFunc*>(&arg);
+    if (!histFunc || histFunc->getInterpolationOrder() != 0) return false;
+    if (histFunc == nominal) return true;
+
+    // Same observables, mapped in the same way onto the observables of the histogram
+    if (histFunc->servers().size() != nominal->servers().size()) return false;
+    for (std::size_t i = 0; i < nominal->servers().size(); ++i) {
+      if (histFunc->servers()[i] != nominal->servers()[i]) return false;
+    }
+    const RooArgSet& histObs = histFunc->getHistObsList();
+    const RooArgSet& nominalHistObs = nominal->getHistObsList();
+    if (histObs.size() != nominalHistObs.size()) return false;
+    for (std::size_t i = 0; i < histObs.size(); ++i) {
+      if (strcmp(histObs[i]->GetName(), nominalHistObs[i]->GetName()) != 0) return false;
+    }
+
+    // Same layout of the histograms
+    const RooDataHist& hist = histFunc->dataHist();
+    hist.checkInit();
+    if (hist.numEntries() != nominalHist.numEntries()) return false;
+    const RooArgSet& vars = *hist.get();
+    const RooArgSet& nominalVars = *nominalHist.get();
+    if (vars.size() != nominalVars.size()) return false;
+    for (std::size_t i = 0; i < vars.size(); ++i) {
+      if (strcmp(vars[i]->GetName(), nominalVars[i]->GetName()) != 0) return false;
+      if (!sameBinning(hist.getBinnings()[i].get(), nominalHist.getBinnings()[i].get())) return false;
+    }
+    return true;
+  };
+
+  for (const auto arg : _lowSet) {
+    if (!matchesNominal(*arg)) return false;
+  }
+  for (const auto arg : _highSet) {
+    if (!matchesNominal(*arg)) return false;
+  }
+
+  _sameBinnedTemplates = true;
+  return true;
+}
+
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Interpolate between input distributions for all values of the observable in `evalData`.
 /// \param[in/out] evalData Struct holding spans pointing to input data. The results of this function will be stored here.
 /// \param[in] normSet Arguments to normalise over.
+///
+/// If all templates are RooHistFunc over identically binned histograms, as in HistFactory models,
+/// the bin numbers are computed once for the nominal, and the contents of all templates are collected
+/// into one contiguous matrix. Otherwise, the values of the templates are computed one by one.
+/// The interpolation then runs over all bins for one parameter after the other.
 RooSpan<double> PiecewiseInterpolation::evaluateSpan(RooBatchCompute::RunContext& evalData, const RooArgSet* normSet) const {
-  auto nominal = _nominal->getValues(evalData, normSet);
+  const std::size_t nParams = _paramSet.size();
+  RooSpan<const double> nominal;
+  std::vector<RooSpan<const double>> low(nParams);
+  std::vector<RooSpan<const double>> high(nParams);
+
+  if (haveSameBinnedTemplates()) {
+    const std::vector<Int_t> bins = static_cast<const RooHistFunc&>(_nominal.arg()).getBins(evalData);
+    const std::size_t nBins = bins.size();
+    _templateValues.resize((2 * nParams + 1) * nBins);
+
+    auto fillRow = [&](std::size_t row, const RooAbsArg& arg) {
+      const RooDataHist& hist = static_cast<const RooHistFunc&>(arg).dataHist();
+      double* values = _templateValues.data() + row * nBins;
+      for (std::size_t j = 0; j < nBins; ++j) {
+        values[j] = bins[j] < 0 ? 0. : hist.weight(bins[j]);
+      }
+      return RooSpan<const double>(values, nBins);
+    };
+
+    nominal = fillRow(0, _nominal.arg());
+    for (std::size_t i = 0; i < nParams; ++i) {
+      low[i] = fillRow(1 + i, _lowSet[i]);
+      high[i] = fillRow(1 + nParams + i, _highSet[i]);
+    }
+  } else {
+    nominal = _nominal->getValues(evalData, normSet);
+    for (std::size_t i = 0; i < nParams; ++i) {
+      low[i] = static_cast<RooAbsReal*>(_lowSet.at(i))->getValues(evalData, normSet);
+      high[i] = static_cast<RooAbsReal*>(_highSet.at(i))->getValues(evalData, normSet);
+    }
+  }
+
   auto sum = evalData.makeBatch(this, nominal.size());
   std::copy(nominal.begin(), nominal.end(), sum.begin());
 
-  for (unsigned int i=0; i < _paramSet.size(); ++i) {
+  for (unsigned int i=0; i < nParams; ++i) {
     const double param = static_cast<RooAbsReal*>(_paramSet.at(i))->getVal();
-    auto low   = static_cast<RooAbsReal*>(_lowSet.at(i) )->getValues(evalData, normSet);
-    auto high  = static_cast<RooAbsReal*>(_highSet.at(i))->getValues(evalData, normSet);
     const int icode = _interpCode[i];
 
     switch(icode) {
-    case 0: {
+    case 0:
       // piece-wise linear
-      for (unsigned int j=0; j < nominal.size(); ++j) {
-        if(param >0)
-          sum[j] += param * (high[j]    - nominal[j]);
-        else
-          sum[j] += param * (nominal[j] - low[j]    );
-      }
+      interpolateLinear(sum, nominal, low[i], high[i], param);
       break;
-    }
-    case 1: {
+    case 1:
       // pice-wise log
-      for (unsigned int j=0; j < nominal.size(); ++j) {
-        if(param >=0)
-          sum[j] *= pow(high[j]/ nominal[j], +param);
-        else
-          sum[j] *= pow(low[j] / nominal[j], -param);
-      }
+      interpolateLog(sum, nominal, low[i], high[i], param);
       break;
-    }
     case 2:
       // parabolic with linear
-      for (unsigned int j=0; j < nominal.size(); ++j) {
-        const double a = 0.5*(high[j]+low[j])-nominal[j];
-        const double b = 0.5*(high[j]-low[j]);
-        const double c = 0;
-        if (param > 1.) {
-          sum[j] += (2*a+b)*(param -1)+high[j]-nominal[j];
-        } else if (param < -1.) {
-          sum[j] += -1*(2*a-b)*(param +1)+low[j]-nominal[j];
-        } else {
-          sum[j] +=  a*pow(param ,2) + b*param +c;
-        }
-      }
-      break;
-    case 3: {
+    case 3:
       //parabolic version of log-normal
-      for (unsigned int j=0; j < nominal.size(); ++j) {
-        const double a = 0.5*(high[j]+low[j])-nominal[j];
-        const double b = 0.5*(high[j]-low[j]);
-        const double c = 0;
-        if (param > 1.) {
-          sum[j] += (2*a+b)*(param -1)+high[j]-nominal[j];
-        } else if (param < -1.) {
-          sum[j] += -1*(2*a-b)*(param +1)+low[j]-nominal[j];
-        } else {
-          sum[j] +=  a*pow(param ,2) + b*param +c;
-        }
-      }
+      interpolateParabolic(sum, nominal, low[i], high[i], param);
       break;
-    }
     case 4:
-      for (unsigned int j=0; j < nominal.size(); ++j) {
-        const double x  = param;
-        if (x > 1.) {
-          sum[j] += x * (high[j]    - nominal[j]);
-        } else if (x < -1.) {
-          sum[j] += x * (nominal[j] - low[j]);
-        } else {
-          const double eps_plus = high[j] - nominal[j];
-          const double eps_minus = nominal[j] - low[j];
-          const double S = 0.5 * (eps_plus + eps_minus);
-          const double A = 0.0625 * (eps_plus - eps_minus);
-
-          double val = nominal[j] + x * (S + x * A * ( 15. + x * x * (-10. + x * x * 3.  ) ) );
-
-          if (val < 0.) val = 0.;
-          sum[j] += val - nominal[j];
-        }
-      }
+      interpolatePoly6(sum, nominal, low[i], high[i], param);
       break;
     case 5:
-      for (unsigned int j=0; j < nominal.size(); ++j) {
-        if (param > 1. || param < -1.) {
-          if(param>0)
-            sum[j] += param * (high[j]    - nominal[j]);
-          else
-            sum[j] += param * (nominal[j] - low[j]    );
-        } else if (nominal[j] != 0) {
-          const double eps_plus = high[j] - nominal[j];
-          const double eps_minus = nominal[j] - low[j];
-          const double S = (eps_plus + eps_minus)/2;
-          const double A = (eps_plus - eps_minus)/2;
-
-          //fcns+der are eq at bd
-          const double a = S;
-          const double b = 3*A/(2*1.);
-          //double c = 0;
-          const double d = -A/(2*1.*1.*1.);
-
-          double val = nominal[j] + a * param + b * pow(param, 2) + d * pow(param, 4);
-          if (val < 0.) val = 0.;
-
-          sum[j] += val - nominal[j];
-        }
-      }
+      interpolatePoly4(sum, nominal, low[i], high[i], param);
       break;
     default:
       coutE(InputArguments) << "PiecewiseInterpolation::evaluateSpan(): " << _paramSet[i].GetName()
@@ -4,6 +4,7 @@
 #include "RooStats/HistFactory/Measurement.h"
 #include "RooStats/HistFactory/MakeModelAndMeasurementsFast.h"
 #include "RooStats/HistFactory/Sample.h"
+#include "RooStats/HistFactory/PiecewiseInterpolation.h"
 #include "RooStats/ModelConfig.h"
 
 #include "RooWorkspace.h"
@@ -490,6 +491,51 @@ TEST_P(HFFixture, BatchEvaluation) {
 }
 
 
+/// Compare the batch evaluation of the shape interpolation with the scalar evaluation,
+/// for all interpolation codes and on both sides of the interpolation boundaries.
+TEST_P(HFFixture, BatchInterpolation) {
+  if (GetParam() < kEquidistantBins_histoSyst)
+    return;
+
+  PiecewiseInterpolation* interpolation = nullptr;
+  for (auto arg : ws->allFunctions()) {
+    interpolation = dynamic_cast<PiecewiseInterpolation*>(arg);
+    if (interpolation && interpolation->paramList().find("alpha_SignalShape"))
+      break;
+    interpolation = nullptr;
+  }
+  ASSERT_NE(interpolation, nullptr);
+
+  auto obs = dynamic_cast<RooRealVar*>(ws->var("obs_x_channel1"));
+  auto var = ws->var("alpha_SignalShape");
+  ASSERT_NE(obs, nullptr);
+  ASSERT_NE(var, nullptr);
+
+  RooBatchCompute::RunContext evalDataOrig;
+  auto batch = evalDataOrig.makeBatch(obs, 2);
+  for (unsigned int i=0; i < 2; ++i) {
+    obs->setBin(i);
+    batch[i] = obs->getVal();
+  }
+
+  for (int code = 0; code <= 5; ++code) {
+    interpolation->setAllInterpCodes(code);
+    for (double alpha : {-1.7, -1., -0.4, 0., 0.3, 1., 2.2}) {
+      var->setVal(alpha);
+      RooBatchCompute::RunContext evalData;
+      evalData.spans = evalDataOrig.spans;
+      auto results = interpolation->getValues(evalData, nullptr);
+      ASSERT_EQ(results.size(), 2u);
+      for (unsigned int i=0; i < 2; ++i) {
+        obs->setBin(i);
+        EXPECT_NEAR(results[i], interpolation->getVal(), 1.E-9)
+          << "code=" << code << " alpha=" << alpha << " bin=" << i;
+      }
+    }
+  }
+}
+
+
 /// Fit the model to data, and check parameters.
 TEST_P(HFFixture, Fit) {
   constexpr bool createPlot = false;
@@ -33,6 +33,10 @@ public:
 
   Int_t getAnalyticalIntegral(RooArgSet& allVars, RooArgSet& analVars, const char* rangeName=0) const override;
   Double_t analyticalIntegral(Int_t code, const char* rangeName=0) const override;
+  std::string buildCallToAnalyticIntegral(Int_t code, const char *rangeName,
+                                          RooFit::Detail::CodeSquashContext &ctx) const override;
+
+  void translate(RooFit::Detail::CodeSquashContext &ctx) const override;
 
 protected:
   RooRealProxy x;
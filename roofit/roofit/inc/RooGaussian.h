@@ -34,6 +34,10 @@ public:
 
   Int_t getAnalyticalIntegral(RooArgSet& allVars, RooArgSet& analVars, const char* rangeName=0) const override;
   Double_t analyticalIntegral(Int_t code, const char* rangeName=0) const override;
+  std::string buildCallToAnalyticIntegral(Int_t code, const char *rangeName,
+                                          RooFit::Detail::CodeSquashContext &ctx) const override;
+
+  void translate(RooFit::Detail::CodeSquashContext &ctx) const override;
 
   Int_t getGenerator(const RooArgSet& directVars, RooArgSet &generateVars, Bool_t staticInitOK=kTRUE) const override;
   void generateEvent(Int_t code) override;
@@ -39,6 +39,10 @@ public:
 
   Int_t getAnalyticalIntegral(RooArgSet& allVars, RooArgSet& analVars, const char* rangeName=0) const ;
   Double_t analyticalIntegral(Int_t code, const char* rangeName=0) const ;
+  virtual std::string buildCallToAnalyticIntegral(Int_t code, const char *rangeName,
+                                                  RooFit::Detail::CodeSquashContext &ctx) const;
+
+  virtual void translate(RooFit::Detail::CodeSquashContext &ctx) const;
 
 protected:
 
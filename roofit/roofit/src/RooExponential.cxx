@@ -29,6 +29,7 @@ range and values of the arguments.
 
 #include "RooRealVar.h"
 #include "RooBatchCompute.h"
+#include "RooFit/Detail/CodeSquashContext.h"
 
 
 #include <cmath>
@@ -86,6 +87,33 @@ Double_t RooExponential::analyticalIntegral(Int_t code, const char* rangeName) c
       / constant;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Translate the exponential into C++ code, for the analytic gradients of RooFuncWrapper.
+
+void RooExponential::translate(RooFit::Detail::CodeSquashContext &ctx) const
+{
+  ctx.addResult(this, "TMath::Exp(" + ctx.getResult(c.arg()) + " * " + ctx.getResult(x.arg()) + ")");
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return C++ code for the integrals of analyticalIntegral().
+
+std::string RooExponential::buildCallToAnalyticIntegral(Int_t code, const char *rangeName,
+                                                        RooFit::Detail::CodeSquashContext &ctx) const
+{
+  assert(code == 1 || code ==2);
+
+  auto& constant  = code == 1 ? c : x;
+  auto& integrand = code == 1 ? x : c;
+
+  const std::string cst = ctx.getResult(constant.arg());
+  const std::string max = ctx.buildArg(integrand.max(rangeName));
+  const std::string min = ctx.buildArg(integrand.min(rangeName));
+
+  return "(" + cst + " == 0.0 ? " + max + " - " + min + " : (TMath::Exp(" + cst + " * " + max + ") - TMath::Exp(" +
+         cst + " * " + min + ")) / " + cst + ")";
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Compute multiple values of Exponential distribution.
 RooSpan<double> RooExponential::evaluateSpan(RooBatchCompute::RunContext& evalData, const RooArgSet* normSet) const {
@@ -26,6 +26,7 @@ Plain Gaussian p.d.f
 #include "RooMath.h"
 #include "RooHelpers.h"
 #include "RooBatchCompute.h"
+#include "RooFit/Detail/CodeSquashContext.h"
 
 
 ClassImp(RooGaussian);
@@ -114,6 +115,37 @@ Double_t RooGaussian::analyticalIntegral(Int_t code, const char* rangeName) cons
   );
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Translate the Gaussian into C++ code, for the analytic gradients of RooFuncWrapper.
+
+void RooGaussian::translate(RooFit::Detail::CodeSquashContext &ctx) const
+{
+  const std::string arg = "(" + ctx.getResult(x.arg()) + " - " + ctx.getResult(mean.arg()) + ")";
+  const std::string sig = ctx.getResult(sigma.arg());
+  ctx.addResult(this, "TMath::Exp(-0.5 * " + arg + " * " + arg + " / (" + sig + " * " + sig + "))");
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return C++ code for the integrals of analyticalIntegral(). The difference
+/// of two error functions is less precise than the computation with erfc() in
+/// the far tails, which does not matter for the normalisation in a fit.
+
+std::string RooGaussian::buildCallToAnalyticIntegral(Int_t code, const char *rangeName,
+                                                     RooFit::Detail::CodeSquashContext &ctx) const
+{
+  assert(code==1 || code==2);
+
+  auto& integrand = code == 1 ? x : mean;
+  auto& other = code == 1 ? mean : x;
+  const std::string sig = ctx.getResult(sigma.arg());
+  const std::string xscale = "(" + ctx.buildArg(TMath::Sqrt2()) + " * " + sig + ")";
+  const std::string shift = ctx.getResult(other.arg());
+
+  return ctx.buildArg(std::sqrt(TMath::PiOver2())) + " * " + sig + " * (TMath::Erf((" +
+         ctx.buildArg(integrand.max(rangeName)) + " - " + shift + ") / " + xscale + ") - TMath::Erf((" +
+         ctx.buildArg(integrand.min(rangeName)) + " - " + shift + ") / " + xscale + "))";
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 
 Int_t RooGaussian::getGenerator(const RooArgSet& directVars, RooArgSet &generateVars, Bool_t /*staticInitOK*/) const
@@ -34,6 +34,7 @@ RooPolynomial::RooPolynomial(const char*, const char*, RooAbsReal&, const RooArg
 #include "RooArgList.h"
 #include "RooMsgService.h"
 #include "RooBatchCompute.h"
+#include "RooFit/Detail/CodeSquashContext.h"
 
 #include "TError.h"
 #include <vector>
@@ -144,6 +145,27 @@ Double_t RooPolynomial::evaluate() const
   return retVal * std::pow(x, lowestOrder) + (lowestOrder ? 1.0 : 0.0);
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Translate the polynomial into C++ code, for the analytic gradients of RooFuncWrapper.
+
+void RooPolynomial::translate(RooFit::Detail::CodeSquashContext &ctx) const
+{
+  const unsigned sz = _coefList.getSize();
+  const int lowestOrder = _lowestOrder;
+  if (!sz) {
+    ctx.addResult(this, lowestOrder ? "1.0" : "0.0");
+    return;
+  }
+
+  // Horner scheme, like in evaluate()
+  const std::string x = ctx.getResult(_x.arg());
+  std::string retVal = ctx.getResult(_coefList[sz - 1]);
+  for (unsigned i = sz - 1; i--; ) retVal = ctx.getResult(_coefList[i]) + " + " + x + " * (" + retVal + ")";
+  for (int i = 0; i < lowestOrder; ++i) retVal = x + " * (" + retVal + ")";
+
+  ctx.addResult(this, retVal + (lowestOrder ? " + 1.0" : ""));
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Compute multiple values of Polynomial.  
 RooSpan<double> RooPolynomial::evaluateSpan(RooBatchCompute::RunContext& evalData, const RooArgSet* normSet) const {
@@ -199,3 +221,29 @@ Double_t RooPolynomial::analyticalIntegral(Int_t code, const char* rangeName) co
   return max * std::pow(xmax, 1 + lowestOrder) - min * std::pow(xmin, 1 + lowestOrder) +
       (lowestOrder ? (xmax - xmin) : 0.);
 }
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return C++ code for the integral of analyticalIntegral().
+
+std::string RooPolynomial::buildCallToAnalyticIntegral(Int_t code, const char *rangeName,
+                                                       RooFit::Detail::CodeSquashContext &ctx) const
+{
+  R__ASSERT(code==1) ;
+
+  const Double_t xmin = _x.min(rangeName), xmax = _x.max(rangeName);
+  const int lowestOrder = _lowestOrder;
+  const unsigned sz = _coefList.getSize();
+  if (!sz) return ctx.buildArg(xmax - xmin);
+
+  // the coefficients of the integral, with the Horner scheme at both bounds
+  auto coef = [&](unsigned i) {
+    return ctx.getResult(_coefList[i]) + " / " + ctx.buildArg(Double_t(i + 1 + lowestOrder));
+  };
+  std::string min = coef(sz - 1), max = coef(sz - 1);
+  for (unsigned i = sz - 1; i--; ) {
+    min = coef(i) + " + " + ctx.buildArg(xmin) + " * (" + min + ")";
+    max = coef(i) + " + " + ctx.buildArg(xmax) + " * (" + max + ")";
+  }
+  return "(" + max + ") * " + ctx.buildArg(std::pow(xmax, 1 + lowestOrder)) + " - (" + min + ") * " +
+         ctx.buildArg(std::pow(xmin, 1 + lowestOrder)) + (lowestOrder ? " + " + ctx.buildArg(xmax - xmin) : "");
+}
@@ -308,6 +308,7 @@
 #pragma link C++ class RooBinningCategory+ ;
 #pragma link C++ class RooDerivative+ ;
 #pragma link C++ class RooFunctor+ ;
+#pragma link C++ class RooFuncWrapper+ ;
 #pragma link C++ class RooGenFunction+ ;
 #pragma link C++ class RooMultiGenFunction+ ;
 #pragma link C++ class RooTFoamBinding+ ;
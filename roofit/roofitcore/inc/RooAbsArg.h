@@ -50,6 +50,11 @@ class RooSetProxy ;
 class RooListProxy ;
 class RooExpensiveObjectCache ;
 class RooWorkspace ;
+namespace RooFit {
+namespace Detail {
+class CodeSquashContext;
+}
+}
 
 class RooRefArray : public TObjArray {
  public:
@@ -256,6 +261,8 @@ public:
     return kFALSE;
   }
 
+  virtual void translate(RooFit::Detail::CodeSquashContext &ctx) const;
+
 
   // Server redirection interface
   Bool_t redirectServers(const RooAbsCollection& newServerList, Bool_t mustReplaceAll=kFALSE, Bool_t nameChange=kFALSE, Bool_t isRecursionStep=kFALSE) ;
@@ -494,6 +501,10 @@ public:
   }
   /// Notify that a shape-like property (*e.g.* binning) has changed.
   void setShapeDirty() { setShapeDirty(nullptr); }
+  /// Number of times this object was marked value dirty, directly or through its servers. Unlike the dirty flags,
+  /// it is not reset by the scalar evaluation, and it also increases when the operation mode of the object stops
+  /// the propagation. Used by the batch evaluation to find the changes of the value.
+  std::size_t valueDirtyCount() const { return _valueDirtyCount; }
 
   const char* aggregateCacheUniqueSuffix() const ;
   virtual const char* cacheUniqueSuffix() const { return 0 ; }
@@ -677,6 +688,7 @@ private:
   mutable Bool_t _valueDirty ;  // Flag set if value needs recalculating because input values modified
   mutable Bool_t _shapeDirty ;  // Flag set if value needs recalculating because input shapes modified
   mutable bool _allBatchesDirty{true}; //! Mark batches as dirty (only meaningful for RooAbsReal).
+  std::size_t _valueDirtyCount{0}; //! Number of calls to setValueDirty(const RooAbsArg*)
 
   mutable OperMode _operMode ; // Dirty state propagation mode
   mutable Bool_t _fast ; // Allow fast access mode in getVal() and proxies
@@ -21,6 +21,7 @@
 #include "RooChangeTracker.h"
 
 #include <map>
+#include <string>
 
 class RooAbsCachedPdf : public RooAbsPdf {
 public:
@@ -85,6 +86,8 @@ public:
    
   PdfCacheElem* getCache(const RooArgSet* nset, bool recalculate=true) const ;
   void clearCacheObject(PdfCacheElem& cache) const ;
+  bool fillCacheObjectFromStore(PdfCacheElem& cache) const ;
+  std::string persistentCacheKey(PdfCacheElem& cache) const ;
 
   virtual const char* payloadUniqueSuffix() const { return 0 ; }
   
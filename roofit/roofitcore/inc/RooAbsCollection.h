@@ -170,8 +170,9 @@ public:
     return find(var) != nullptr;
   }
   /// Check if this exact instance is in this collection.
+  /// Large collections first look up the name in their hash map, see useHashMapForFind().
   Bool_t containsInstance(const RooAbsArg& var) const { 
-    return std::find(_list.begin(), _list.end(), &var) != _list.end();
+    return tryFastFind(var.namePtr()) == &var || std::find(_list.begin(), _list.end(), &var) != _list.end();
   }
   RooAbsCollection* selectByAttrib(const char* name, Bool_t value) const ;
   bool selectCommon(const RooAbsCollection& refColl, RooAbsCollection& outColl) const ;
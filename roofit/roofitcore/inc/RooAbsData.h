@@ -310,6 +310,11 @@ public:
   RooArgSet const* getGlobalObservables() const { return _globalObservables.get(); }
   void setGlobalObservables(RooArgSet const& globalObservables);
 
+  /// Number of modifications of the entries or of the columns of this dataset since its creation, e.g. by
+  /// filling, resetting or appending. Lets users of spans of the data, which may stay at the same address,
+  /// find out that their contents changed.
+  std::size_t modificationCount() const { return _modificationCount; }
+
 protected:
 
   static StorageType defaultStorageType ;
@@ -359,6 +364,8 @@ protected:
 
   std::unique_ptr<RooArgSet> _globalObservables; // Snapshot of global observables
 
+  std::size_t _modificationCount = 0; //! See modificationCount()
+
 private:
   void copyGlobalObservables(const RooAbsData& other);
 
@@ -277,6 +277,7 @@ public:
   double expectedEvents(const RooArgSet& nset) const {
     return expectedEvents(&nset) ; 
   }
+  virtual std::string buildCallToExpectedEvents(RooFit::Detail::CodeSquashContext &ctx) const;
 
   // Printing interface (human readable)
   virtual void printValue(std::ostream& os) const ;
@@ -164,6 +164,8 @@ public:
   virtual Double_t analyticalIntegralWN(Int_t code, const RooArgSet* normSet, const char* rangeName=0) const ;
   virtual Int_t getAnalyticalIntegral(RooArgSet& allVars, RooArgSet& analVars, const char* rangeName=0) const ;
   virtual Double_t analyticalIntegral(Int_t code, const char* rangeName=0) const ;
+  virtual std::string buildCallToAnalyticIntegral(Int_t code, const char *rangeName,
+                                                  RooFit::Detail::CodeSquashContext &ctx) const;
   virtual Bool_t forceAnalyticalInt(const RooAbsArg& /*dep*/) const { 
     // Interface to force RooRealIntegral to offer given observable for internal integration
     // even if this is deemed unsafe. This default implementation returns always flase
@@ -63,6 +63,7 @@ public:
   /// Return expected number of events for extended likelihood calculation, which
   /// is the sum of all coefficients.
   Double_t expectedEvents(const RooArgSet* nset) const override;
+  std::string buildCallToExpectedEvents(RooFit::Detail::CodeSquashContext &ctx) const override;
 
   const RooArgList& pdfList() const { 
     // Return list of component p.d.fs
@@ -85,6 +86,8 @@ public:
   std::list<Double_t>* binBoundaries(RooAbsRealLValue& /*obs*/, Double_t /*xlo*/, Double_t /*xhi*/) const override;
   bool isBinnedDistribution(const RooArgSet& obs) const override;
 
+  void translate(RooFit::Detail::CodeSquashContext &ctx) const override;
+
   void printMetaArgs(std::ostream& os) const override;
 
   CacheMode canNodeBeCached() const override { return RooAbsArg::NotAdvised ; };
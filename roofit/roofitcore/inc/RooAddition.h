@@ -39,6 +39,8 @@ public:
 
   void printMetaArgs(std::ostream& os) const ;
 
+  virtual void translate(RooFit::Detail::CodeSquashContext &ctx) const;
+
   const RooArgList& list1() const { return _set ; }
   const RooArgList& list() const { return _set ; }
 
@@ -282,6 +282,12 @@ T* RooCacheManager<T>::getObj(const RooArgSet* nset, const RooArgSet* iset, Int_
     return _object[0] ;
   }
   
+  // Most lookups are for the same sets as the previous one
+  if (_lastIndex>=0 && _lastIndex<_size && _nsetCache[_lastIndex].contains(nset,iset,isetRangeName)) {
+    if(_object[_lastIndex]==0 && sterileIdx) *sterileIdx=_lastIndex ;
+    return _object[_lastIndex] ;
+  }
+
   Int_t i ;
   for (i=0 ; i<_size ; i++) {
     if (_nsetCache[i].contains(nset,iset,isetRangeName)==kTRUE) {      
@@ -291,8 +297,13 @@ T* RooCacheManager<T>::getObj(const RooArgSet* nset, const RooArgSet* iset, Int_
     }
   }
 
+  if (_size==0) return 0 ;
+
+  // The observables of the sets are the same for all slots
+  std::string name1, name2 ;
+  RooNormSetCache::observableNames(_owner,nset,iset,name1,name2) ;
   for (i=0 ; i<_size ; i++) {
-    if (_nsetCache[i].autoCache(_owner,nset,iset,isetRangeName,kFALSE)==kFALSE) {
+    if (_nsetCache[i].autoCache(name1,name2,nset,iset,isetRangeName,kFALSE)==kFALSE) {
       _lastIndex = i ;
       if(_object[i]==0 && sterileIdx) *sterileIdx=i ;
       return _object[i] ;
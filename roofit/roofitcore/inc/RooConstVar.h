@@ -41,6 +41,8 @@ public:
 
   void writeToStream(std::ostream& os, Bool_t compact) const ;
 
+  virtual void translate(RooFit::Detail::CodeSquashContext &ctx) const;
+
   /// Returns false, as the value of the constant doesn't depend on other objects.
   virtual Bool_t isDerived() const { 
     return false;
@@ -116,6 +116,8 @@ public:
   /// Return bin volume of i-th bin. \see getIndex()
   double binVolume(std::size_t i) const { return _binv[i]; }
   double binVolume(const RooArgSet& bin) const; 
+  /// Return the binnings of the observables, in the order of get(). Categories have no binning, their entries are null.
+  std::vector<std::unique_ptr<const RooAbsBinning>> const& getBinnings() const { return _lvbins; }
   /// Return true if bin `i` is considered valid within the current range definitions of all observables. \see getIndex()
   bool valid(std::size_t i) const { return i <= static_cast<std::size_t>(_arrSize) && (_maskedWeights.empty() || _maskedWeights[i] != 0.);}
 
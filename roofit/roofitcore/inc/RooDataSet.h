@@ -27,6 +27,7 @@ class RooDataHist;
 #include "ROOT/RStringView.hxx"
 
 #include <list>
+#include <vector>
 
 
 #define USEMEMPOOLFORDATASET
@@ -121,6 +122,8 @@ public:
   virtual void add(const RooArgSet& row, Double_t weight, Double_t weightErrorLo, Double_t weightErrorHi);
 
   virtual void addFast(const RooArgSet& row, Double_t weight=1.0, Double_t weightError=0);
+  void addEvents(const RooArgList& vars, const std::vector<RooSpan<const double>>& values,
+      RooSpan<const double> weights = {});
 
   void append(RooDataSet& data) ;
   Bool_t merge(RooDataSet* data1, RooDataSet* data2=0, RooDataSet* data3=0,  
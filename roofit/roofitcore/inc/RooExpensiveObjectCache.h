@@ -20,6 +20,8 @@
 #include "RooArgSet.h"
 #include "TString.h"
 #include <map>
+#include <set>
+#include <string>
 
 class RooExpensiveObjectCache : public TObject {
 public:
@@ -38,9 +40,15 @@ public:
   void clearAll() ;
 
   void importCacheObjects(RooExpensiveObjectCache& other, const char* ownerName, Bool_t verbose=kFALSE) ;
+  void importCacheObjects(RooExpensiveObjectCache& other, const std::set<std::string>& ownerNames, Bool_t verbose=kFALSE) ;
 
   static RooExpensiveObjectCache& instance() ;
 
+  static void setPersistentStore(const char* fileName, Int_t maxObjects=1000) ;
+  static const char* persistentStore() ;
+  static TObject* readPersistentObject(const char* key, TClass* tclass) ;
+  static Bool_t writePersistentObject(const char* key, const TObject& object) ;
+
   Int_t size() const { return _map.size() ; }
 
   void print() const ;
@@ -19,6 +19,10 @@
 #include "RooHistPdf.h"
 #include "TVirtualFFT.h"
 
+#include <complex>
+#include <memory>
+#include <vector>
+
 class RooRealVar;
 
 ///PDF for the numerical (FFT) convolution of two PDFs.
@@ -81,15 +85,28 @@ protected:
 
     virtual RooArgList containedArgs(Action) ;
 
-    std::unique_ptr<TVirtualFFT> fftr2c1;
-    std::unique_ptr<TVirtualFFT> fftr2c2;
-    std::unique_ptr<TVirtualFFT> fftc2r;
+    // FFT plans, shared by all caches of the same thread with the same number of sampling points
+    std::shared_ptr<TVirtualFFT> fftr2c;
+    std::shared_ptr<TVirtualFFT> fftc2r;
 
     std::unique_ptr<RooAbsPdf> pdf1Clone;
     std::unique_ptr<RooAbsPdf> pdf2Clone;
 
     std::unique_ptr<RooAbsBinning> histBinning;
     std::unique_ptr<RooAbsBinning> scanBinning;
+
+    // Fourier transform of the sampling of one input p.d.f. in one cache slice, with the
+    // parameter values it was computed for. It is only recomputed if these changed.
+    struct InputTransform {
+      std::vector<double> paramValues;
+      std::vector<std::complex<double>> coefs;
+      Int_t zeroBin = 0;
+    };
+
+    RooArgSet pdf1Params; // Parameters of the first input p.d.f.
+    RooArgSet pdf2Params; // Parameters of the second input p.d.f.
+    std::vector<InputTransform> transforms1; // Transforms of the first input p.d.f., one per cache slice
+    std::vector<InputTransform> transforms2; // Transforms of the second input p.d.f., one per cache slice
   };
 
   friend class FFTCacheElem ;  
@@ -100,7 +117,9 @@ protected:
   virtual RooArgSet* actualParameters(const RooArgSet& nset) const ;
   virtual RooAbsArg& pdfObservable(RooAbsArg& histObservable) const ;
   virtual void fillCacheObject(PdfCacheElem& cache) const ;
-  void fillCacheSlice(FFTCacheElem& cache, const RooArgSet& slicePosition) const ;
+  void fillCacheSlice(FFTCacheElem& cache, const RooArgSet& slicePosition, std::size_t sliceIndex=0) const ;
+  void transformInput(FFTCacheElem& cache, RooAbsPdf& pdf, const RooArgSet& params, FFTCacheElem::InputTransform& transform,
+                      const RooArgSet& slicePos, Int_t N2, Double_t shift) const ;
 
   virtual PdfCacheElem* createCache(const RooArgSet* nset) const ;
   virtual TString histNameSuffix() const ;
@@ -0,0 +1,89 @@
+/*****************************************************************************
+ * Project: RooFit                                                           *
+ * Package: RooFitCore                                                       *
+ * Authors:                                                                  *
+ *   WV, Wouter Verkerke, UC Santa Barbara, verkerke@slac.stanford.edu       *
+ *   DK, David Kirkby,    UC Irvine,         dkirkby@uci.edu                 *
+ *                                                                           *
+ * Copyright (c) 2000-2021, Regents of the University of California          *
+ *                          and Stanford University. All rights reserved.    *
+ *                                                                           *
+ * Redistribution and use in source and binary forms,                        *
+ * with or without modification, are permitted according to the terms        *
+ * listed in LICENSE (http://roofit.sourceforge.net/license.txt)             *
+ *****************************************************************************/
+
+#ifndef RooFit_Detail_CodeSquashContext_h
+#define RooFit_Detail_CodeSquashContext_h
+
+#include <RooArgSet.h>
+
+#include <cstddef>
+#include <map>
+#include <set>
+#include <string>
+#include <vector>
+
+class RooAbsArg;
+class RooAbsPdf;
+class RooArgList;
+class TNamed;
+
+namespace RooFit {
+
+namespace Detail {
+
+/// A class to maintain the context for squashing of RooFit models into code.
+class CodeSquashContext {
+public:
+   CodeSquashContext(RooArgSet const &observables, std::size_t nEvents, RooArgList const &params);
+
+   std::string const &getResult(RooAbsArg const &arg);
+   std::string const &getNormalizedResult(RooAbsPdf const &pdf);
+
+   void addResult(RooAbsArg const *arg, std::string const &valueExpr, bool isNormalized = false);
+   void addToCodeBody(RooAbsArg const *arg, std::string const &code);
+
+   std::size_t addToXlArr(std::vector<double> const &values);
+   std::string getTmpVarName();
+
+   /// The name of the loop index over the events, which the expressions of the observables contain.
+   static constexpr const char *loopIndex() { return "loopIdx0"; }
+   static std::string buildArg(double value);
+
+   /// The observables, which take a different value in each event.
+   RooArgSet const &observables() const { return _observables; }
+   std::size_t nEvents() const { return _nEvents; }
+   /// The offset of the column of the event weights in the array of the observables.
+   std::size_t weightOffset() const { return _observables.size() * _nEvents; }
+
+   std::string const &globalScope() const { return _globalScope; }
+   std::string const &loopScope() const { return _loopScope; }
+   std::vector<double> const &xlArr() const { return _xlArr; }
+
+private:
+   bool isInLoop(RooAbsArg const *arg) const;
+   std::string declare(RooAbsArg const *arg, std::string const &valueExpr, bool inLoop);
+
+   RooArgSet _observables;
+   std::size_t _nEvents = 0;
+   /// The expressions of the values of the nodes, keyed by the name pointers of the nodes.
+   std::map<TNamed const *, std::string> _nodeNames;
+   /// The expressions of the normalized values of the pdfs.
+   std::map<TNamed const *, std::string> _normalizedNames;
+   /// The pdfs whose value expression is already normalized over the observables.
+   std::set<TNamed const *> _isNormalized;
+   /// The code that only depends on the parameters, which is evaluated once before the loop over the events.
+   std::string _globalScope;
+   /// The code inside the loop over the events.
+   std::string _loopScope;
+   /// Constants that are not parameters, e.g. histogram contents.
+   std::vector<double> _xlArr;
+   std::size_t _tmpVarCounter = 0;
+};
+
+} // namespace Detail
+
+} // namespace RooFit
+
+#endif
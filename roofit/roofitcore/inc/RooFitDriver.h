@@ -0,0 +1,77 @@
+/*************************************************************************
+ * Copyright (C) 1995-2021, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#ifndef roofit_roofitcore_RooFitDriver_h
+#define roofit_roofitcore_RooFitDriver_h
+
+#include "RooSpan.h"
+#include "RunContext.h"
+
+#include <cstddef>
+#include <vector>
+
+class RooAbsArg;
+class RooAbsCategory;
+class RooAbsData;
+class RooAbsPdf;
+class RooAbsReal;
+class RooArgSet;
+
+/// Drives the repeated batch evaluation of the log probabilities of a pdf on a dataset, as done by the
+/// likelihoods in BatchMode().
+///
+/// The computation graph of the pdf is flattened once into an array of nodes sorted such that the servers
+/// come before their clients. Before each evaluation, the array is traversed to find the nodes that are
+/// dirty, i.e. that have a leaf (parameter or observable) that changed since the previous evaluation. The
+/// results of the clean nodes are kept in the RunContext, so the evaluation, which is still done by
+/// RooAbsReal::getValues() from the top node, stops at them and only recomputes the dirty part of the graph.
+/// The memory of the results stays allocated between evaluations.
+///
+/// A node is also dirty if RooFit marked it as value dirty since the previous evaluation (see
+/// RooAbsArg::valueDirtyCount()), which catches the changes that do not show in the leaves, like the range of
+/// an observable, or if it is always to be recomputed (operation mode ADirty). All nodes are dirty after a
+/// modification of the dataset (see RooAbsData::modificationCount()), since its spans can keep their address.
+///
+/// The array is compared to the servers of the nodes at each evaluation, and rebuilt if the graph changed.
+class RooFitDriver {
+public:
+  RooFitDriver(const RooAbsPdf& topNode, const RooAbsData& data);
+
+  RooSpan<const double> getLogProbabilities(std::size_t begin, std::size_t len, const RooArgSet* normSet);
+
+  const RooAbsPdf& topNode() const { return *_topNode; }
+  const RooAbsData& data() const { return *_data; }
+  /// The RunContext holding the results of the last evaluation.
+  RooBatchCompute::RunContext& runContext() { return _evalData; }
+
+private:
+  struct NodeInfo {
+    const RooAbsArg* node = nullptr;
+    const RooAbsReal* real = nullptr;    // node, if it is a RooAbsReal
+    const RooAbsCategory* cat = nullptr; // node, if it is a RooAbsCategory
+    std::vector<const RooAbsArg*> servers; // to detect changes of the graph
+    std::vector<std::size_t> serverIndices; // positions of the servers in _nodes
+    RooSpan<const double> lastData; // results of the leaves and of the nodes provided by the dataset
+    double lastValue = 0.;          // value of the scalar leaves
+    std::size_t lastValueDirtyCount = 0; // RooAbsArg::valueDirtyCount() after the previous evaluation
+    bool dirty = true;
+  };
+
+  void buildPlan();
+  bool planIsValid() const;
+
+  const RooAbsPdf* _topNode;
+  const RooAbsData* _data;
+  std::vector<NodeInfo> _nodes; // servers before clients
+  RooBatchCompute::RunContext _evalData;
+  const RooArgSet* _lastNormSet = nullptr;
+  std::size_t _lastDataModificationCount = 0;
+  bool _allDirty = true;
+};
+
+#endif
@@ -0,0 +1,64 @@
+/*****************************************************************************
+ * Project: RooFit                                                           *
+ * Package: RooFitCore                                                       *
+ * Authors:                                                                  *
+ *   WV, Wouter Verkerke, UC Santa Barbara, verkerke@slac.stanford.edu       *
+ *   DK, David Kirkby,    UC Irvine,         dkirkby@uci.edu                 *
+ *                                                                           *
+ * Copyright (c) 2000-2021, Regents of the University of California          *
+ *                          and Stanford University. All rights reserved.    *
+ *                                                                           *
+ * Redistribution and use in source and binary forms,                        *
+ * with or without modification, are permitted according to the terms        *
+ * listed in LICENSE (http://roofit.sourceforge.net/license.txt)             *
+ *****************************************************************************/
+
+#ifndef RooFit_RooFuncWrapper_h
+#define RooFit_RooFuncWrapper_h
+
+#include "RooAbsReal.h"
+#include "RooListProxy.h"
+
+#include <string>
+#include <vector>
+
+class RooAbsData;
+class RooAbsPdf;
+
+class RooFuncWrapper final : public RooAbsReal {
+public:
+  RooFuncWrapper() {}
+  RooFuncWrapper(const char *name, const char *title, RooAbsPdf &pdf, RooAbsData &data, bool extended = false);
+  RooFuncWrapper(const RooFuncWrapper &other, const char *name = nullptr);
+  TObject *clone(const char *newname) const override { return new RooFuncWrapper(*this, newname); }
+
+  void gradient(double *out) const;
+
+  /// The parameters of the likelihood, in the order of the derivatives that gradient() returns.
+  const RooArgList &parameters() const { return _params; }
+  /// The C++ code of the likelihood function that Clad differentiates.
+  const std::string &funcBody() const { return _funcBody; }
+
+protected:
+  Double_t evaluate() const override;
+
+private:
+  void declareFunctions();
+  void updateParamValues() const;
+
+  using Func = double (*)(double *, double const *, double const *);
+  using Grad = void (*)(double *, double const *, double const *, double *);
+
+  RooListProxy _params;
+  std::string _funcName;
+  std::string _funcBody;
+  Func _func = nullptr;             //!
+  Grad _grad = nullptr;             //!
+  std::vector<double> _observables; // the columns of the observables, followed by the event weights
+  std::vector<double> _xlArr;       // further constants of the likelihood, e.g. histogram contents
+  mutable std::vector<double> _paramValues; //!
+
+  ClassDefOverride(RooFuncWrapper, 0) // Likelihood compiled from C++ code, with an analytic gradient from Clad
+};
+
+#endif
@@ -26,6 +26,8 @@
 
 #include <vector>
 
+class RooFuncWrapper;
+
 class RooGradMinimizerFcn : public ROOT::Math::IMultiGradFunction, public RooAbsMinimizerFcn {
 public:
    RooGradMinimizerFcn(RooAbsReal *funct, RooMinimizer *context, bool verbose = false);
@@ -41,7 +43,8 @@ public:
 
    void synchronizeGradientParameterSettings(std::vector<ROOT::Fit::ParameterSettings> &parameter_settings) const;
 
-   inline bool returnsInMinuit2ParameterSpace() const override { return true; }
+   /// With the analytic gradient of a RooFuncWrapper, the gradient is computed in the external parameter space.
+   inline bool returnsInMinuit2ParameterSpace() const override { return _funcWrapper == nullptr; }
    inline unsigned int NDim() const override { return getNDim(); }
    inline void setStepTolerance(double step_tolerance) const { _gradf.SetStepTolerance(step_tolerance); }
    inline void setGradTolerance(double grad_tolerance) const { _gradf.SetGradTolerance(grad_tolerance); }
@@ -51,12 +54,15 @@ public:
    inline std::string getFunctionTitle() const override { return _funct->GetTitle(); }
    inline void setOffsetting(Bool_t flag) override { _funct->enableOffsetting(flag); }
 
+   void Gradient(const double *x, double *grad) const override;
+
 private:
    void runDerivator(unsigned int i_component) const;
 
    void resetHasBeenCalculatedFlags() const;
    bool syncParameter(double x, std::size_t ix) const;
    bool syncParameters(const double *x) const;
+   void updateAnalyticGradientIndices();
 
    inline void setOptimizeConstOnFunction(RooAbsArg::ConstOpCode opcode, Bool_t doAlsoTrackingOpt) override
    {
@@ -84,5 +90,10 @@ private:
    RooAbsReal *_funct;
    mutable std::vector<bool> has_been_calculated;
    mutable bool none_have_been_calculated = false;
+
+   // analytic gradient, if the function is a RooFuncWrapper
+   RooFuncWrapper *_funcWrapper = nullptr;
+   std::vector<std::size_t> _analyticGradIndices; // index of each floating parameter in the RooFuncWrapper parameters
+   mutable std::vector<double> _analyticGrad;
 };
 #endif
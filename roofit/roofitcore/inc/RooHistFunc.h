@@ -84,6 +84,8 @@ public:
   virtual Bool_t isBinnedDistribution(const RooArgSet&) const { return _intOrder==0 ; }
   RooArgSet const& getHistObsList() const { return _histObsList; }
 
+  virtual void translate(RooFit::Detail::CodeSquashContext &ctx) const;
+
 
   Int_t getBin() const;
   std::vector<Int_t> getBins(RooBatchCompute::RunContext& evalData) const;
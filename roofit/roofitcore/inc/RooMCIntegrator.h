@@ -21,6 +21,10 @@
 #include "RooNumIntConfig.h"
 #include "TStopwatch.h"
 
+#include <vector>
+
+class RooRealBinding;
+
 class RooMCIntegrator : public RooAbsIntegrator {
 public:
 
@@ -58,10 +62,13 @@ protected:
   friend class RooNumIntFactory ;
   static void registerIntegrator(RooNumIntFactory& fact) ;	
 
+  void generateAndEvaluatePoints(const RooRealBinding& binding, UInt_t box[], UInt_t bin[], Double_t x[]);
+
   mutable RooGrid _grid;  // Sampling grid definition
 
   // control variables
   Bool_t _verbose;          // Verbosity control
+  Bool_t _batchMode;        // Evaluate the integrand for all points of an iteration at once?
   Double_t _alpha;          // Grid stiffness parameter
   Int_t _mode;              // Sampling mode
   GeneratorType _genType;   // Generator type
@@ -74,6 +81,12 @@ protected:
   Double_t _jac,_wtd_int_sum,_sum_wgts,_chi_sum,_chisq,_result,_sigma; // Scratch variables preserved between calls to vegas1/2/2
   UInt_t _it_start,_it_num,_samples,_calls_per_box;                    // Scratch variables preserved between calls to vegas1/2/2
 
+  // Workspace of the batch evaluation, for all points of one iteration
+  std::vector<std::vector<Double_t>> _batchCoordinates; //! Coordinates of the points, one vector per dimension
+  std::vector<UInt_t> _batchBins;                       //! Grid bins of the points
+  std::vector<Double_t> _batchBinVolumes;               //! Bin volumes of the points
+  std::vector<Double_t> _batchValues;                   //! Integrand values at the points
+
   ClassDef(RooMCIntegrator,0) // VEGAS based multi-dimensional numerical integration engine
 };
 
@@ -54,6 +54,11 @@ public:
   Bool_t fit(Int_t nSamples, TList& dataSetList) ;
   Bool_t addFitResult(const RooFitResult& fr) ;
 
+  /// Generate and fit the samples of generateAndFit() in `nWorkers` processes.
+  /// The default, 1, runs the study in the current process.
+  void setNumWorkers(unsigned int nWorkers) { _nWorkers = nWorkers ; }
+  unsigned int numWorkers() const { return _nWorkers ; }
+
   // Result accessors
   const RooArgSet* fitParams(Int_t sampleNum) const ;
   const RooFitResult* fitResult(Int_t sampleNum) const ;
@@ -103,6 +108,7 @@ protected:
   RooPlot* makeFrameAndPlotCmd(const RooRealVar& param, RooLinkedList& cmdList, Bool_t symRange=kFALSE) const ;
 
   Bool_t run(Bool_t generate, Bool_t fit, Int_t nSamples, Int_t nEvtPerSample, Bool_t keepGenData, const char* asciiFilePat) ;
+  Bool_t runParallel(Int_t nSamples, Int_t nEvtPerSample, Bool_t keepGenData) ;
   Bool_t fitSample(RooAbsData* genSample) ;
   RooFitResult* doFit(RooAbsData* genSample) ;	
 
@@ -142,6 +148,7 @@ protected:
   Bool_t      _verboseGen       ; // Verbose generation?
   Bool_t      _perExptGenParams ; // Do generation parameter change per event?
   Bool_t      _silence          ; // Silent running mode?
+  unsigned int _nWorkers        ; // Number of worker processes of generateAndFit()
 
   std::list<RooAbsMCStudyModule*> _modList ; // List of additional study modules ;
 
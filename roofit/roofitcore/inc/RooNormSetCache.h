@@ -21,26 +21,24 @@
 #include <string>
 
 #include "Rtypes.h"
+#include "RooArgSet.h"
 
 class RooAbsArg;
-class RooArgSet;
 
 typedef RooArgSet* pRooArgSet ;
 
 class RooNormSetCache {
 protected:
-  typedef std::pair<const RooArgSet*, const RooArgSet*> Pair;
-  struct PairCmp {
-      inline bool operator()(const Pair& a, const Pair& b) const
-      {
-	  if (a.first < b.first) return true;
-	  if (b.first < a.first) return false;
-	  return a.second < b.second;
-      }
-  };
+  // The sets are identified by their unique IDs rather than by their addresses,
+  // such that a new set allocated at the address of a deleted one is not mistaken for it.
+  typedef UniqueId<RooArgSet>::Value_t Value_t;
+  typedef std::pair<Value_t, Value_t> Pair;
   typedef std::vector<Pair> PairVectType;
   typedef std::map<Pair, ULong_t> PairIdxMapType;
 
+  static Pair makePair(const RooArgSet* set1, const RooArgSet* set2)
+  { return Pair(getUniqueId(set1).value(), getUniqueId(set2).value()); }
+
 public:
   RooNormSetCache(ULong_t max = 32);
   virtual ~RooNormSetCache();
@@ -52,10 +50,8 @@ public:
   {
     // Match range name first
     if (set2RangeName != _set2RangeName) return -1;
-    const Pair pair(set1, set2);
-    PairIdxMapType::const_iterator it = _pairToIdx.lower_bound(pair);
-    if (_pairToIdx.end() != it &&
-	!PairCmp()(it->first, pair) && !PairCmp()(pair, it->first))
+    PairIdxMapType::const_iterator it = _pairToIdx.find(makePair(set1, set2));
+    if (_pairToIdx.end() != it)
       return it->second;
     return -1;
   }
@@ -66,21 +62,25 @@ public:
 
   inline Bool_t containsSet1(const RooArgSet* set1)
   {
-    const Pair pair(set1, (const RooArgSet*)0);
+    const Pair pair(getUniqueId(set1).value(), UniqueId<RooArgSet>::nullval);
     PairIdxMapType::const_iterator it = _pairToIdx.lower_bound(pair);
-    if (_pairToIdx.end() != it && it->first.first == set1)
+    if (_pairToIdx.end() != it && it->first.first == pair.first)
       return kTRUE;
     return kFALSE;
   }
 
-  const RooArgSet* lastSet1() const { return _pairs.empty()?0:_pairs.back().first; }
-  const RooArgSet* lastSet2() const { return _pairs.empty()?0:_pairs.back().second; }
   const std::string& nameSet1() const { return _name1; }
   const std::string& nameSet2() const { return _name2; }
 
+  static void observableNames(const RooAbsArg* self, const RooArgSet* set1, const RooArgSet* set2,
+      std::string& name1, std::string& name2);
+
   Bool_t autoCache(const RooAbsArg* self, const RooArgSet* set1,
       const RooArgSet* set2 = 0, const TNamed* set2RangeName = 0,
       Bool_t autoRefill = kTRUE);
+  Bool_t autoCache(const std::string& name1, const std::string& name2,
+      const RooArgSet* set1, const RooArgSet* set2, const TNamed* set2RangeName,
+      Bool_t autoRefill);
     
   void clear();
   Int_t entries() const { return _pairs.size(); }
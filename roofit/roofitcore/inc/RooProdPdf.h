@@ -69,6 +69,7 @@ public:
 
   virtual ExtendMode extendMode() const ;
   virtual Double_t expectedEvents(const RooArgSet* nset) const ; 
+  virtual std::string buildCallToExpectedEvents(RooFit::Detail::CodeSquashContext &ctx) const;
 
   const RooArgList& pdfList() const { return _pdfList ; }
 
@@ -86,6 +87,8 @@ public:
 
   void printMetaArgs(std::ostream& os) const ;
 
+  virtual void translate(RooFit::Detail::CodeSquashContext &ctx) const;
+
   virtual void selectNormalizationRange(const char* rangeName=0, Bool_t force=kFALSE) ;
   void fixRefRange(const char* rangeName) ;
 
@@ -52,6 +52,8 @@ public:
 
   void printMetaArgs(std::ostream& os) const ;
 
+  virtual void translate(RooFit::Detail::CodeSquashContext &ctx) const;
+
   virtual std::list<Double_t>* binBoundaries(RooAbsRealLValue& /*obs*/, Double_t /*xlo*/, Double_t /*xhi*/) const ;
   virtual std::list<Double_t>* plotSamplingHint(RooAbsRealLValue& /*obs*/, Double_t /*xlo*/, Double_t /*xhi*/) const ;
   virtual Bool_t isBinnedDistribution(const RooArgSet& obs) const ;
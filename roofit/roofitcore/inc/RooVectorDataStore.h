@@ -107,6 +107,7 @@ public:
 
   // Add rows 
   virtual void append(RooAbsDataStore& other) override;
+  void appendEvents(const RooArgList& vars, const std::vector<RooSpan<const double>>& values);
 
   // General & bookkeeping methods
   virtual Int_t numEntries() const override { return static_cast<int>(size()); }
@@ -245,6 +246,21 @@ public:
       _vec.push_back(*_buf);
     }
 
+    /// Append `n` copies of the value in the buffer.
+    void fill(std::size_t n) {
+      _vec.insert(_vec.end(), n, *_buf);
+    }
+
+    /// Append a batch of values, clipped to the range [lo, hi].
+    void append(RooSpan<const double> values, double lo, double hi) {
+      const std::size_t oldSize = _vec.size();
+      _vec.resize(oldSize + values.size());
+      double* out = _vec.data() + oldSize;
+      for (std::size_t i = 0; i < values.size(); ++i) {
+        out[i] = std::min(std::max(values[i], lo), hi);
+      }
+    }
+
     void write(Int_t i) {
       assert(static_cast<std::size_t>(i) < _vec.size());
       _vec[i] = *_buf ;
@@ -420,6 +436,23 @@ public:
       if (_vecEH) _vecEH->push_back(*_bufEH) ;
     } ;
 
+    void fill(std::size_t n) {
+      RealVector::fill(n) ;
+      fillErrors(n) ;
+    }
+
+    /// Append a batch of values. The errors of the new entries are the ones in the buffers.
+    void append(RooSpan<const double> values, double lo, double hi) {
+      RealVector::append(values, lo, hi) ;
+      fillErrors(values.size()) ;
+    }
+
+    void fillErrors(std::size_t n) {
+      if (_vecE) _vecE->insert(_vecE->end(), n, *_bufE) ;
+      if (_vecEL) _vecEL->insert(_vecEL->end(), n, *_bufEL) ;
+      if (_vecEH) _vecEH->insert(_vecEH->end(), n, *_bufEH) ;
+    }
+
     void write(Int_t i) {
       RealVector::write(i) ;
       if (_vecE) (*_vecE)[i] = *_bufE ;
@@ -546,6 +579,10 @@ public:
       _vec.push_back(*_buf) ; 
     }
 
+    void fill(std::size_t n) {
+      _vec.insert(_vec.end(), n, *_buf) ;
+    }
+
     void write(std::size_t i) {
       _vec[i] = *_buf;
     }
@@ -0,0 +1,55 @@
+/*****************************************************************************
+ * RooFit
+ * Authors:                                                                  *
+ *   WV, Wouter Verkerke, UC Santa Barbara, verkerke@slac.stanford.edu       *
+ *   DK, David Kirkby,    UC Irvine,         dkirkby@uci.edu                 *
+ *                                                                           *
+ * Copyright (c) 2000-2021, Regents of the University of California          *
+ *                          and Stanford University. All rights reserved.    *
+ *                                                                           *
+ * Redistribution and use in source and binary forms,                        *
+ * with or without modification, are permitted according to the terms        *
+ * listed in LICENSE (http://roofit.sourceforge.net/license.txt)             *
+ *****************************************************************************/
+
+#ifndef ROOT_ROOFIT_LikelihoodGradientSerial
+#define ROOT_ROOFIT_LikelihoodGradientSerial
+
+#include <TestStatistics/LikelihoodGradientWrapper.h>
+
+#include "Minuit2/NumericalDerivator.h"
+
+#include <vector>
+
+namespace RooFit {
+namespace TestStatistics {
+
+class LikelihoodGradientSerial : public LikelihoodGradientWrapper {
+public:
+   LikelihoodGradientSerial(std::shared_ptr<RooAbsL> likelihood,
+                            std::shared_ptr<WrapperCalculationCleanFlags> calculation_is_clean, std::size_t N_dim,
+                            RooMinimizer *minimizer);
+   inline LikelihoodGradientSerial *clone() const override { return new LikelihoodGradientSerial(*this); }
+
+   void fillGradient(double *grad) override;
+
+   void synchronizeWithMinimizer(const ROOT::Math::MinimizerOptions &options) override;
+   using LikelihoodGradientWrapper::synchronizeParameterSettings;
+   void synchronizeParameterSettings(ROOT::Math::IMultiGenFunction *function,
+                                     const std::vector<ROOT::Fit::ParameterSettings> &parameter_settings) override;
+   void updateMinuitInternalParameterValues(const std::vector<double> &minuit_internal_x) override;
+
+   inline bool usesMinuitInternalValues() override { return true; }
+
+private:
+   void calculateGradient();
+
+   ROOT::Minuit2::NumericalDerivator gradf_;
+   std::vector<ROOT::Minuit2::DerivatorElement> grad_;
+   std::vector<double> minuit_internal_x_;
+};
+
+} // namespace TestStatistics
+} // namespace RooFit
+
+#endif // ROOT_ROOFIT_LikelihoodGradientSerial
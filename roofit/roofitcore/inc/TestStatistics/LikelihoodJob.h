@@ -0,0 +1,79 @@
+/*****************************************************************************
+ * RooFit
+ * Authors:                                                                  *
+ *   WV, Wouter Verkerke, UC Santa Barbara, verkerke@slac.stanford.edu       *
+ *   DK, David Kirkby,    UC Irvine,         dkirkby@uci.edu                 *
+ *                                                                           *
+ * Copyright (c) 2000-2021, Regents of the University of California          *
+ *                          and Stanford University. All rights reserved.    *
+ *                                                                           *
+ * Redistribution and use in source and binary forms,                        *
+ * with or without modification, are permitted according to the terms        *
+ * listed in LICENSE (http://roofit.sourceforge.net/license.txt)             *
+ *****************************************************************************/
+
+#ifndef ROOT_ROOFIT_LikelihoodJob
+#define ROOT_ROOFIT_LikelihoodJob
+
+#include <TestStatistics/LikelihoodWrapper.h>
+#include <TestStatistics/RooAbsL.h>
+
+#include "Math/Util.h" // KahanSum
+
+#include <cstddef> // std::size_t
+#include <memory>
+#include <vector>
+
+namespace RooFit {
+namespace TestStatistics {
+
+class LikelihoodJob : public LikelihoodWrapper {
+public:
+   LikelihoodJob(std::shared_ptr<RooAbsL> likelihood, std::shared_ptr<WrapperCalculationCleanFlags> calculation_is_clean,
+                 unsigned int n_workers = 0);
+   inline LikelihoodJob *clone() const override { return new LikelihoodJob(*this); }
+
+   void evaluate() override;
+   inline ROOT::Math::KahanSum<double> getResult() const override { return result; }
+
+   void constOptimizeTestStatistic(RooAbsArg::ConstOpCode opcode, bool doAlsoTrackingOpt) override;
+   void setApplyWeightSquared(bool flag) override;
+
+   inline unsigned int getNWorkers() const { return n_workers_; }
+   inline std::size_t getNTasks() const { return tasks_.size(); }
+
+   /// Minimum number of events in each of the sections that the events of an unbinned likelihood are split into.
+   static constexpr std::size_t min_events_per_task = 1000;
+
+private:
+   /// A part of the likelihood that one worker evaluates at a time.
+   struct Task {
+      RooAbsL *likelihood;
+      RooAbsL::Section events;
+      std::size_t components_begin;
+      std::size_t components_end;
+      std::size_t n_entries; // estimate of the cost of the task, used to balance the load
+   };
+
+   void initTasks();
+   ROOT::Math::KahanSum<double> evaluateTask(const Task &task) const;
+
+   ROOT::Math::KahanSum<double> result;
+
+   unsigned int n_workers_;
+   LikelihoodType likelihood_type;
+   /// The tasks, in the order in which their results are summed
+   std::vector<Task> tasks_;
+   /// The indices of the tasks, the most expensive first, in the order in which they are handed to the workers
+   std::vector<std::size_t> task_order_;
+   /// Copies of an unbinned likelihood, one for each section of events but the first, each with its own pdf and
+   /// dataset clone so that the sections can be evaluated concurrently.
+   std::vector<std::shared_ptr<RooAbsL>> section_likelihoods_;
+   /// The first evaluation creates caches (e.g. normalization integrals) shared by the events, so it is done serially.
+   bool first_evaluation_ = true;
+};
+
+} // namespace TestStatistics
+} // namespace RooFit
+
+#endif // ROOT_ROOFIT_LikelihoodJob
@@ -37,7 +37,7 @@ namespace TestStatistics {
 
 // forward declaration
 class LikelihoodSerial;
-//class LikelihoodGradientSerial;
+class LikelihoodGradientSerial;
 
 /// For communication with wrappers, an instance of this struct must be shared between them and MinuitFcnGrad. It keeps
 /// track of what has been evaluated for the current parameter set provided by Minuit.
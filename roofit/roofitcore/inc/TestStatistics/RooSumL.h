@@ -42,6 +42,9 @@ public:
 
    void constOptimizeTestStatistic(RooAbsArg::ConstOpCode opcode, bool doAlsoTrackingOpt) override;
 
+   // necessary in LikelihoodJob to balance the load of the components
+   inline const std::vector<std::unique_ptr<RooAbsL>> &getComponents() const { return components_; }
+
 private:
    std::vector<std::unique_ptr<RooAbsL>> components_;
 };
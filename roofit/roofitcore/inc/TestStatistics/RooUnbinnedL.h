@@ -23,9 +23,7 @@
 class RooAbsPdf;
 class RooAbsData;
 class RooArgSet;
-namespace RooBatchCompute {
-struct RunContext;
-}
+class RooFitDriver;
 
 namespace RooFit {
 namespace TestStatistics {
@@ -35,6 +33,7 @@ public:
    RooUnbinnedL(RooAbsPdf *pdf, RooAbsData *data, RooAbsL::Extended extended = RooAbsL::Extended::Auto,
                 bool useBatchedEvaluations = false);
    RooUnbinnedL(const RooUnbinnedL &other);
+   ~RooUnbinnedL();
    bool setApplyWeightSquared(bool flag);
 
    ROOT::Math::KahanSum<double>
@@ -45,7 +44,7 @@ private:
    bool apply_weight_squared = false;                              // Apply weights squared?
    mutable bool _first = true;                                     //!
    bool useBatchedEvaluations_ = false;
-   mutable std::unique_ptr<RooBatchCompute::RunContext> evalData_; //! Struct to store function evaluation workspaces.
+   mutable std::unique_ptr<RooFitDriver> driver_; //! Evaluation plan and workspaces of the batch evaluations.
 };
 
 } // namespace TestStatistics
@@ -53,6 +53,8 @@ public:
   static constexpr Value_t nullval = 0UL; /// The value of the nullid.
 
 private:
+  UniqueId(Value_t val) : _val{val} {}  /// Create the nullid.
+
   Value_t _val;  /// Numerical value of the ID.
 
   static std::atomic<Value_t> counter;  /// The static object counter to get the next ID value.
@@ -68,7 +70,7 @@ const UniqueId<Class> UniqueId<Class>::nullid{UniqueId<Class>::nullval};
 /// With pointer comparisons, we can also have `nullptr`. In the UniqueId case,
 /// this translates to the `nullid`.
 template <class Class>
-UniqueId<Class> getUniqueId(Class const *ptr) {
+UniqueId<Class> const& getUniqueId(Class const *ptr) {
   return ptr ? ptr->uniqueId() : UniqueId<Class>::nullid;
 }
 
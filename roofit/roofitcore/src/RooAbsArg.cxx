@@ -101,6 +101,7 @@ for single nodes.
 #include <iostream>
 #include <memory>
 #include <sstream>
+#include <stdexcept>
 
 using namespace std;
 
@@ -893,6 +894,7 @@ Bool_t RooAbsArg::observableOverlaps(const RooArgSet* nset, const RooAbsArg& tes
 void RooAbsArg::setValueDirty(const RooAbsArg* source)
 {
   _allBatchesDirty = true;
+  ++_valueDirtyCount;
 
   if (_operMode!=Auto || _inhibitDirty) return ;
 
@@ -2421,6 +2423,24 @@ void RooAbsArg::ioStreamerPass2Finalize()
 }
 
 
+////////////////////////////////////////////////////////////////////////////////
+/// Translate this node into C++ code that computes its value from the values
+/// of its servers, as part of a squashed likelihood function that can be
+/// differentiated with Clad (see RooFuncWrapper). Classes that support the code
+/// generation override this function to register the expression of their value
+/// with the context, e.g.
+/// ~~~{.cpp}
+/// ctx.addResult(this, ctx.getResult(_x) + " * " + ctx.getResult(_c));
+/// ~~~
+/// This default implementation throws, because the class does not support it.
+
+void RooAbsArg::translate(RooFit::Detail::CodeSquashContext & /*ctx*/) const
+{
+  throw std::runtime_error(std::string("RooAbsArg::translate(): the class ") + ClassName() + " of " + GetName()
+                           + " does not support the code generation for analytic gradients.");
+}
+
+
 RooAbsArg::RefCountListLegacyIterator_t *
 RooAbsArg::makeLegacyIterator(const RooAbsArg::RefCountList_t& list) const {
   return new RefCountListLegacyIterator_t(list.containedObjects());
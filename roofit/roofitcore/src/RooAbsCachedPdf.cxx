@@ -26,6 +26,13 @@ actualParameters() must be define which report what the actual
 observables to be cached are for a given set of observables passed
 by the user to getVal() and on which parameters need to be tracked
 for changes to trigger a refilling of the cache histogram.
+
+If the persistent store of RooExpensiveObjectCache is enabled, the cache
+histograms are also looked up in and saved to this store, such that
+other processes using the same p.d.f. do not need to fill them again.
+A histogram in the store is identified by a hash of the expression graph
+of the p.d.f., the binning of the cache observables and the values of the
+parameters, see persistentCacheKey().
 **/
 
 #include "RooAbsCachedPdf.h"
@@ -33,6 +40,14 @@ for changes to trigger a refilling of the cache histogram.
 #include "RooDataHist.h"
 #include "RooHistPdf.h"
 #include "RooExpensiveObjectCache.h"
+#include "RooAbsCategory.h"
+#include "RooAbsBinning.h"
+#include "TClass.h"
+#include "TMD5.h"
+
+#include <algorithm>
+#include <sstream>
+#include <vector>
 
 ClassImp(RooAbsCachedPdf);
 
@@ -127,7 +142,7 @@ RooAbsCachedPdf::PdfCacheElem* RooAbsCachedPdf::getCache(const RooArgSet* nset,
     if (cache->paramTracker()->hasChanged(true) && (recalculate || !cache->pdf()->haveUnitNorm()) ) {
       cxcoutD(Eval) << "RooAbsCachedPdf::getCache(" << GetName() << ") cache " << cache << " pdf "
 		    << cache->pdf()->GetName() << " requires recalculation as parameters changed" << std::endl ;
-      fillCacheObject(*cache) ;
+      fillCacheObjectFromStore(*cache) ;
       cache->pdf()->setValueDirty() ;
     }
     return cache ;
@@ -138,6 +153,7 @@ RooAbsCachedPdf::PdfCacheElem* RooAbsCachedPdf::getCache(const RooArgSet* nset,
 
   // Check if we have contents registered already in global expensive object cache
   auto htmp = static_cast<RooDataHist const*>(expensiveObjectCache().retrieveObject(cache->hist()->GetName(),RooDataHist::Class(),cache->paramTracker()->parameters()));
+  bool preexisting = htmp ;
 
   if (htmp) {
 
@@ -146,7 +162,7 @@ RooAbsCachedPdf::PdfCacheElem* RooAbsCachedPdf::getCache(const RooArgSet* nset,
 
   } else {
 
-    fillCacheObject(*cache) ;
+    preexisting = fillCacheObjectFromStore(*cache) ;
 
     auto eoclone = new RooDataHist(*cache->hist()) ;
     eoclone->removeSelfFromDir() ;
@@ -160,7 +176,7 @@ RooAbsCachedPdf::PdfCacheElem* RooAbsCachedPdf::getCache(const RooArgSet* nset,
 
   coutI(Caching) << "RooAbsCachedPdf::getCache(" << GetName() << ") creating new cache " << cache << " with pdf "
 		 << cache->pdf()->GetName() << " for nset " << (nset?*nset:RooArgSet()) << " with code " << code ;
-  if (htmp) {
+  if (preexisting) {
     ccoutI(Caching) << " from preexisting content." ;
   }
   ccoutI(Caching) << std::endl ;
@@ -171,6 +187,100 @@ RooAbsCachedPdf::PdfCacheElem* RooAbsCachedPdf::getCache(const RooArgSet* nset,
 
 
 
+////////////////////////////////////////////////////////////////////////////////
+/// Fill the cache histogram with fillCacheObject(), unless the persistent store of
+/// RooExpensiveObjectCache holds a histogram for the same key, see persistentCacheKey().
+/// Newly filled histograms are added to the store. Return true if the content of the
+/// cache histogram was read from the store.
+
+bool RooAbsCachedPdf::fillCacheObjectFromStore(PdfCacheElem& cache) const
+{
+  if (!RooExpensiveObjectCache::persistentStore()) {
+    fillCacheObject(cache) ;
+    return false ;
+  }
+
+  const std::string key = persistentCacheKey(cache) ;
+  std::unique_ptr<TObject> stored{RooExpensiveObjectCache::readPersistentObject(key.c_str(),RooDataHist::Class())} ;
+  if (stored) {
+    cxcoutD(Caching) << "RooAbsCachedPdf::fillCacheObjectFromStore(" << GetName() << ") reading "
+                     << cache.hist()->GetName() << " from persistent store" << std::endl ;
+    cache.hist()->reset() ;
+    cache.hist()->add(static_cast<RooDataHist&>(*stored)) ;
+    return true ;
+  }
+
+  fillCacheObject(cache) ;
+  RooExpensiveObjectCache::writePersistentObject(key.c_str(),*cache.hist()) ;
+  return false ;
+}
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return the key of the cache histogram in the persistent store of RooExpensiveObjectCache.
+/// It is the MD5 hash of the name of the cache histogram, of the class, name and servers
+/// of all nodes of the expression graph of this p.d.f, of the binning of the cache observables
+/// and of the values of the parameters and constants. Settings of derived classes that change
+/// the histogram in another way should be part of histNameSuffix().
+
+std::string RooAbsCachedPdf::persistentCacheKey(PdfCacheElem& cache) const
+{
+  const RooArgSet& params = cache.paramTracker()->parameters() ;
+  const RooArgSet& obs = *cache.hist()->get() ;
+
+  // The expression graph, sorted such that the key does not depend on the order of the servers
+  RooArgSet nodes ;
+  treeNodeServerList(&nodes) ;
+  std::vector<std::string> lines ;
+  for (RooAbsArg* node : nodes) {
+    std::ostringstream line ;
+    line.precision(17) ;
+    line << node->IsA()->GetName() << "::" << node->GetName() << " " ;
+    node->printArgs(line) ;
+    if (params.find(*node) || (node->isConstant() && !obs.find(*node))) {
+      if (auto real = dynamic_cast<RooAbsReal*>(node)) {
+        line << " = " << real->getVal() ;
+      } else if (auto cat = dynamic_cast<RooAbsCategory*>(node)) {
+        line << " = " << cat->getCurrentIndex() ;
+      }
+    }
+    lines.push_back(line.str()) ;
+  }
+  std::sort(lines.begin(), lines.end()) ;
+
+  std::ostringstream os ;
+  os.precision(17) ;
+  os << cache.hist()->GetName() << "\n" ;
+  for (auto const& line : lines) {
+    os << line << "\n" ;
+  }
+
+  // The binning of the cache observables
+  auto const& binnings = cache.hist()->getBinnings() ;
+  std::size_t i = 0 ;
+  for (RooAbsArg* var : obs) {
+    os << var->GetName() ;
+    const RooAbsBinning* binning = i < binnings.size() ? binnings[i].get() : nullptr ;
+    if (binning) {
+      for (Int_t ibin = 0 ; ibin < binning->numBins() ; ++ibin) {
+        os << " " << binning->binLow(ibin) ;
+      }
+      os << " " << binning->highBound() ;
+    }
+    os << "\n" ;
+    ++i ;
+  }
+
+  const std::string str = os.str() ;
+  TMD5 md5 ;
+  md5.Update(reinterpret_cast<const UChar_t*>(str.data()), str.size()) ;
+  md5.Final() ;
+  return md5.AsString() ;
+}
+
+
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Constructor of cache object which owns RooDataHist cache histogram,
 /// RooHistPdf pdf that represents is shape and RooChangeTracker meta
@@ -355,6 +355,7 @@ void RooAbsData::convertToVectorStore()
 
 Bool_t RooAbsData::changeObservableName(const char* from, const char* to)
 {
+  ++_modificationCount;
   Bool_t ret =  _dstore->changeObservableName(from,to) ;
 
   RooAbsArg* tmp = _vars.find(from) ;
@@ -368,6 +369,7 @@ Bool_t RooAbsData::changeObservableName(const char* from, const char* to)
 
 void RooAbsData::fill()
 {
+  ++_modificationCount;
   _dstore->fill() ;
 }
 
@@ -382,6 +384,7 @@ Int_t RooAbsData::numEntries() const
 
 void RooAbsData::reset()
 {
+  ++_modificationCount;
   _dstore->reset() ;
 }
 
@@ -398,6 +401,7 @@ const RooArgSet* RooAbsData::get(Int_t index) const
 
 void RooAbsData::cacheArgs(const RooAbsArg* cacheOwner, RooArgSet& varSet, const RooArgSet* nset, Bool_t skipZeroWeights)
 {
+  ++_modificationCount;
   _dstore->cacheArgs(cacheOwner,varSet,nset,skipZeroWeights) ;
 }
 
@@ -406,6 +410,7 @@ void RooAbsData::cacheArgs(const RooAbsArg* cacheOwner, RooArgSet& varSet, const
 
 void RooAbsData::resetCache()
 {
+  ++_modificationCount;
   _dstore->resetCache() ;
   _cachedVars.removeAll() ;
 }
@@ -415,6 +420,7 @@ void RooAbsData::resetCache()
 
 void RooAbsData::attachCache(const RooAbsArg* newOwner, const RooArgSet& cachedVars)
 {
+  ++_modificationCount;
   _dstore->attachCache(newOwner, cachedVars) ;
 }
 
@@ -422,6 +428,7 @@ void RooAbsData::attachCache(const RooAbsArg* newOwner, const RooArgSet& cachedV
 
 void RooAbsData::setArgStatus(const RooArgSet& set, Bool_t active)
 {
+  ++_modificationCount;
   _dstore->setArgStatus(set,active) ;
 }
 
@@ -3241,6 +3241,20 @@ Double_t RooAbsPdf::expectedEvents(const RooArgSet*) const
 
 
 
+////////////////////////////////////////////////////////////////////////////////
+/// Return C++ code that computes the expected number of events, for the code
+/// generation of the extended likelihood in RooFuncWrapper. This is the
+/// counterpart of expectedEvents(), and extendable p.d.f.s that support the
+/// code generation override both. This default implementation throws.
+
+std::string RooAbsPdf::buildCallToExpectedEvents(RooFit::Detail::CodeSquashContext & /*ctx*/) const
+{
+  throw std::runtime_error(std::string("RooAbsPdf::buildCallToExpectedEvents(") + GetName() + "): the class "
+                           + ClassName() + " does not support the code generation for the expected number of events.");
+}
+
+
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Change global level of verbosity for p.d.f. evaluations
 
@@ -110,6 +110,7 @@
 #include <sstream>
 #include <iostream>
 #include <iomanip>
+#include <stdexcept>
 
 using namespace std ;
 
@@ -434,6 +435,24 @@ Double_t RooAbsReal::analyticalIntegral(Int_t code, const char* /*rangeName*/) c
 
 
 
+////////////////////////////////////////////////////////////////////////////////
+/// Return C++ code that computes the analytical integral advertised by
+/// getAnalyticalIntegral with the given code, for the code generation of
+/// RooFuncWrapper. This is the counterpart of analyticalIntegral(), and classes
+/// that support the code generation override both. The bounds of the
+/// integration are the ones of the range, which the code contains as numbers.
+/// This default implementation throws, because the class does not support it.
+
+std::string RooAbsReal::buildCallToAnalyticIntegral(Int_t code, const char * /*rangeName*/,
+                                                    RooFit::Detail::CodeSquashContext & /*ctx*/) const
+{
+  throw std::runtime_error(Form("RooAbsReal::buildCallToAnalyticIntegral(%s): the class %s does not support the code "
+                                "generation for the analytical integral with code %d.",
+                                GetName(), ClassName(), code));
+}
+
+
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Get the label associated with the variable
 
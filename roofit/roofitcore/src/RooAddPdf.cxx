@@ -75,11 +75,13 @@ An (enforced) condition for this assumption is that each \f$ \mathrm{PDF}_i \f$
 #include "RooRealIntegral.h"
 #include "RooNaNPacker.h"
 #include "RooBatchCompute.h"
+#include "RooFit/Detail/CodeSquashContext.h"
 
 #include <algorithm>
 #include <memory>
 #include <sstream>
 #include <set>
+#include <stdexcept>
 
 using namespace std;
 
@@ -732,7 +734,12 @@ std::pair<const RooArgSet*, RooAddPdf::CacheElem*> RooAddPdf::getNormAndCache(co
     if(nset == nullptr) {
       nset = _copyOfLastNormSet.get();
     } else if(nset->uniqueId() != _idOfLastUsedNormSet) {
-      _copyOfLastNormSet = std::make_unique<const RooArgSet>(*nset);
+      // Only copy the set if it holds other observables than the copy, as
+      // temporary sets with the same content are passed very often
+      if (!_copyOfLastNormSet || _copyOfLastNormSet->size() != nset->size()
+          || !std::equal(nset->begin(), nset->end(), _copyOfLastNormSet->begin())) {
+        _copyOfLastNormSet = std::make_unique<const RooArgSet>(*nset);
+      }
       _idOfLastUsedNormSet = nset->uniqueId();
     }
 
@@ -783,6 +790,65 @@ Double_t RooAddPdf::evaluate() const
 }
 
 
+////////////////////////////////////////////////////////////////////////////////
+/// Translate the sum into C++ code, for the analytic gradients of RooFuncWrapper.
+/// The coefficients are interpreted for the normalization over the observables of
+/// the likelihood, so a fixed reference normalization set or range for the
+/// coefficients, and recursive fractions, are not supported.
+
+void RooAddPdf::translate(RooFit::Detail::CodeSquashContext &ctx) const
+{
+  if (_recursive || _projectCoefs || !_refCoefNorm.empty() || _refCoefRangeName) {
+    throw std::runtime_error(std::string("RooAddPdf::translate(") + GetName()
+                             + "): recursive fractions and the projection of the coefficients are not supported.");
+  }
+
+  // the coefficients of extended components are their expected numbers of events
+  std::vector<std::string> coefs;
+  for (unsigned int i = 0; i < _pdfList.size(); ++i) {
+    if (_allExtendable) {
+      coefs.push_back(static_cast<RooAbsPdf &>(_pdfList[i]).buildCallToExpectedEvents(ctx));
+    } else if (i < _coefList.size()) {
+      coefs.push_back(ctx.getResult(_coefList[i]));
+    }
+  }
+
+  std::string sum;
+  std::string sumOfCoefs;
+  for (unsigned int i = 0; i < coefs.size(); ++i) {
+    sum += (i > 0 ? " + " : "") + coefs[i] + " * " + ctx.getNormalizedResult(static_cast<RooAbsPdf &>(_pdfList[i]));
+    sumOfCoefs += (i > 0 ? " + " : "") + coefs[i];
+  }
+
+  if (coefs.size() < _pdfList.size()) {
+    // the coefficients are fractions, and the last one is the remainder
+    const auto &lastPdf = static_cast<RooAbsPdf &>(_pdfList[_pdfList.size() - 1]);
+    sum += " + (1.0 - (" + sumOfCoefs + ")) * " + ctx.getNormalizedResult(lastPdf);
+    ctx.addResult(this, sum, true);
+  } else {
+    ctx.addResult(this, "(" + sum + ") / (" + sumOfCoefs + ")", true);
+  }
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return C++ code for the expected number of events, which is the sum of the
+/// coefficients or of the expected numbers of events of the components.
+
+std::string RooAddPdf::buildCallToExpectedEvents(RooFit::Detail::CodeSquashContext &ctx) const
+{
+  if (extendMode() == CanNotBeExtended) {
+    return RooAbsPdf::buildCallToExpectedEvents(ctx);
+  }
+  std::string expected;
+  for (unsigned int i = 0; i < _pdfList.size(); ++i) {
+    expected += (i > 0 ? " + " : "") + (_allExtendable ? static_cast<RooAbsPdf &>(_pdfList[i]).buildCallToExpectedEvents(ctx)
+                                                    : ctx.getResult(_coefList[i]));
+  }
+  return "(" + expected + ")";
+}
+
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Compute addition of PDFs in batches.
 RooSpan<double> RooAddPdf::evaluateSpan(RooBatchCompute::RunContext& evalData, const RooArgSet* normSet) const {
@@ -37,6 +37,7 @@ in the two sets.
 #include "RooNLLVar.h"
 #include "RooChi2Var.h"
 #include "RooMsgService.h"
+#include "RooFit/Detail/CodeSquashContext.h"
 
 #include <algorithm>
 #include <cmath>
@@ -179,6 +180,19 @@ Double_t RooAddition::evaluate() const
 }
 
 
+////////////////////////////////////////////////////////////////////////////////
+/// Translate the sum into C++ code, for the analytic gradients of RooFuncWrapper.
+
+void RooAddition::translate(RooFit::Detail::CodeSquashContext &ctx) const
+{
+  std::string sum = "0.0";
+  for (const auto arg : _set) {
+    sum += " + " + ctx.getResult(*arg);
+  }
+  ctx.addResult(this, sum);
+}
+
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Return the default error level for MINUIT error analysis
 /// If the addition contains one or more RooNLLVars and 
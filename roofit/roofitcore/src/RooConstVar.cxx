@@ -24,6 +24,7 @@ RooConstVar represent a constant real-valued object
 
 #include "RooConstVar.h"
 #include "RunContext.h"
+#include "RooFit/Detail/CodeSquashContext.h"
 
 using namespace std;
 
@@ -71,3 +72,11 @@ void RooConstVar::writeToStream(ostream& os, Bool_t /*compact*/) const
   os << _value ;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Translate the constant into a C++ literal, for the analytic gradients of RooFuncWrapper.
+
+void RooConstVar::translate(RooFit::Detail::CodeSquashContext &ctx) const
+{
+  ctx.addResult(this, RooFit::Detail::CodeSquashContext::buildArg(_value));
+}
+
@@ -106,6 +106,8 @@ For the inverse conversion, see `RooAbsData::convertToVectorStore()`.
 #include <iostream>
 #include <memory>
 #include <fstream>
+#include <stdexcept>
+#include <string>
 
 
 using namespace std;
@@ -1300,6 +1302,86 @@ void RooDataSet::addFast(const RooArgSet& data, Double_t wgt, Double_t wgtError)
 
 
 
+
+////////////////////////////////////////////////////////////////////////////////
+/// Add a batch of events, given column by column, to the data set. This is much
+/// faster than adding the events one by one, in particular for large numbers of events,
+/// because the values are not loaded into the variables of the dataset event by event.
+/// \param[in] vars Variables of the dataset that the columns are filled into. They are
+/// matched by name to the variables of the dataset.
+/// \param[in] values One column of values for each of the variables in `vars`, e.g.
+/// a `RooSpan<const double>(rvec.data(), rvec.size())` for an `RVec<double>`. All columns
+/// must have the same size.
+/// \param[in] weights Optional column with the event weights. If empty, the events have
+/// a weight of 1.
+/// \note Values outside of the range of a variable are clipped to the range, as
+/// in RooRealVar::setVal(). Variables that are not in `vars` are filled with their
+/// current value.
+
+void RooDataSet::addEvents(const RooArgList& vars, const std::vector<RooSpan<const double>>& values,
+    RooSpan<const double> weights)
+{
+  checkInit() ;
+
+  if (vars.size() != values.size()) {
+    throw std::invalid_argument(std::string("RooDataSet::addEvents(") + GetName() + "): "
+        + std::to_string(vars.size()) + " variables were passed, but " + std::to_string(values.size()) + " columns.");
+  }
+
+  RooArgList storeVars;
+  std::vector<RooSpan<const double>> columns(values);
+  for (const auto arg : vars) {
+    auto storeVar = dynamic_cast<RooAbsRealLValue*>(_varsNoWgt.find(*arg));
+    if (!storeVar) {
+      throw std::invalid_argument(std::string("RooDataSet::addEvents(") + GetName() + "): '" + arg->GetName()
+          + "' is not a real-valued variable of this dataset.");
+    }
+    storeVars.add(*storeVar);
+  }
+  if (!weights.empty()) {
+    if (_wgtVar) {
+      storeVars.add(*_wgtVar);
+      columns.push_back(weights);
+    } else if (_errorMsgCount < 5) {
+      ccoutE(DataHandling) << "Event weights were passed but no weight variable was defined"
+          << " in the dataset '" << GetName() << "'. The weights will be ignored." << std::endl;
+      ++_errorMsgCount;
+    }
+  }
+  if (columns.empty()) return;
+
+  const std::size_t nEvents = columns.front().size();
+  for (std::size_t i = 0; i < columns.size(); ++i) {
+    if (columns[i].size() != nEvents) {
+      throw std::invalid_argument(std::string("RooDataSet::addEvents(") + GetName() + "): the column for '"
+          + storeVars[i].GetName() + "' has " + std::to_string(columns[i].size()) + " entries, but "
+          + std::to_string(nEvents) + " were expected.");
+    }
+  }
+
+  const double oldW = _wgtVar ? _wgtVar->getVal() : 0.;
+  if (_wgtVar && weights.empty()) {
+    _wgtVar->setVal(1.) ;
+  }
+
+  if (auto vectorStore = dynamic_cast<RooVectorDataStore*>(_dstore)) {
+    vectorStore->appendEvents(storeVars, columns);
+  } else {
+    for (std::size_t i = 0; i < nEvents; ++i) {
+      for (std::size_t j = 0; j < columns.size(); ++j) {
+        static_cast<RooAbsRealLValue&>(storeVars[j]).setVal(columns[j][i]);
+      }
+      fill();
+    }
+  }
+
+  if (_wgtVar) {
+    _wgtVar->setVal(oldW);
+  }
+}
+
+
+
 ////////////////////////////////////////////////////////////////////////////////
 
 Bool_t RooDataSet::merge(RooDataSet* data1, RooDataSet* data2, RooDataSet* data3, 
@@ -1365,6 +1447,7 @@ Bool_t RooDataSet::merge(list<RooDataSet*>dsetList)
 void RooDataSet::append(RooDataSet& data) 
 {
   checkInit() ;
+  ++_modificationCount;
   _dstore->append(*data._dstore) ;
 }
 
@@ -1380,6 +1463,7 @@ void RooDataSet::append(RooDataSet& data)
 RooAbsArg* RooDataSet::addColumn(RooAbsArg& var, Bool_t adjustRange) 
 {
   checkInit() ;
+  ++_modificationCount;
   RooAbsArg* ret = _dstore->addColumn(var,adjustRange) ;
   _vars.addOwned(*ret) ;
   initialize(_wgtVar?_wgtVar->GetName():0) ;
@@ -1397,6 +1481,7 @@ RooAbsArg* RooDataSet::addColumn(RooAbsArg& var, Bool_t adjustRange)
 RooArgSet* RooDataSet::addColumns(const RooArgList& varList) 
 {
   checkInit() ;
+  ++_modificationCount;
   RooArgSet* ret = _dstore->addColumns(varList) ;  
   _vars.addOwned(*ret) ;
   initialize(_wgtVar?_wgtVar->GetName():0) ;
@@ -24,6 +24,16 @@ for objects that are expensive to calculate. Owners of such objects
 can registers these here with associated parameter values for which
 the object is valid, so that other instances can, at a later moment
 retrieve these precalculated objects.
+
+In addition, objects can be kept across processes in an opt-in persistent store,
+a ROOT file that is shared e.g. by the jobs of a toy campaign:
+~~~ {.cpp}
+RooExpensiveObjectCache::setPersistentStore("/shared/pdfcache.root", 500);
+~~~
+The objects in the store are identified by a key which the owner computes from
+everything the object depends on, see RooAbsCachedPdf. When the store holds the
+maximum number of objects, the oldest ones are deleted to make room for new ones.
+Access to the file is serialised between processes with a lock file.
 **/
 
 
@@ -33,7 +43,13 @@ retrieve these precalculated objects.
 #include "RooAbsCategory.h"
 #include "RooArgSet.h"
 #include "RooMsgService.h"
+#include "TFile.h"
+#include "TKey.h"
+#include "TLockFile.h"
+#include "TSystem.h"
 #include <iostream>
+#include <memory>
+#include <string>
 using namespace std ;
 
 #include "RooExpensiveObjectCache.h"
@@ -41,6 +57,25 @@ using namespace std ;
 ClassImp(RooExpensiveObjectCache);
 ClassImp(RooExpensiveObjectCache::ExpensiveObject);
 
+namespace {
+
+/// Configuration of the persistent store, shared by all cache instances
+struct PersistentStoreConfig {
+  std::string fileName ;
+  Int_t maxObjects = 1000 ;
+} ;
+
+PersistentStoreConfig& persistentStoreConfig()
+{
+  static PersistentStoreConfig config ;
+  return config ;
+}
+
+/// Seconds after which a lock of the persistent store is considered stale
+constexpr Int_t kPersistentStoreLockTimeLimit = 120 ;
+
+}
+
 
 ////////////////////////////////////////////////////////////////////////////////
 /// Constructor
@@ -84,6 +119,104 @@ RooExpensiveObjectCache& RooExpensiveObjectCache::instance()
 }
 
 
+////////////////////////////////////////////////////////////////////////////////
+/// Enable the persistent store in the ROOT file `fileName`, which is created when the first
+/// object is written. At most `maxObjects` objects are kept in the file, no limit if `maxObjects`
+/// is not positive. A null or empty `fileName` disables the persistent store.
+
+void RooExpensiveObjectCache::setPersistentStore(const char* fileName, Int_t maxObjects)
+{
+  auto& config = persistentStoreConfig() ;
+  config.fileName = fileName ? fileName : "" ;
+  config.maxObjects = maxObjects ;
+}
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return name of the file of the persistent store, or null if it is disabled
+
+const char* RooExpensiveObjectCache::persistentStore()
+{
+  auto& config = persistentStoreConfig() ;
+  return config.fileName.empty() ? nullptr : config.fileName.c_str() ;
+}
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Read the object stored under `key` in the persistent store. Return null if the store
+/// is disabled or holds no object of class `tclass` under this key. The caller takes
+/// ownership of the returned object.
+
+TObject* RooExpensiveObjectCache::readPersistentObject(const char* key, TClass* tclass)
+{
+  auto& config = persistentStoreConfig() ;
+  if (config.fileName.empty() || gSystem->AccessPathName(config.fileName.c_str())) {
+    return nullptr ;
+  }
+
+  TDirectory::TContext ctx ;
+  TLockFile lock((config.fileName + ".lock").c_str(), kPersistentStoreLockTimeLimit) ;
+  std::unique_ptr<TFile> file{TFile::Open(config.fileName.c_str(), "READ")} ;
+  if (!file || file->IsZombie()) {
+    return nullptr ;
+  }
+
+  TKey* tkey = file->GetKey(key) ;
+  if (!tkey || TClass::GetClass(tkey->GetClassName()) != tclass) {
+    return nullptr ;
+  }
+  return tkey->ReadObj() ;
+}
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Write `object` under `key` in the persistent store, unless an object is stored
+/// under this key already. If the store is full, the oldest objects are deleted first.
+/// Return true if the object is in the store.
+
+Bool_t RooExpensiveObjectCache::writePersistentObject(const char* key, const TObject& object)
+{
+  auto& config = persistentStoreConfig() ;
+  if (config.fileName.empty()) {
+    return kFALSE ;
+  }
+
+  TDirectory::TContext ctx ;
+  TLockFile lock((config.fileName + ".lock").c_str(), kPersistentStoreLockTimeLimit) ;
+  std::unique_ptr<TFile> file{TFile::Open(config.fileName.c_str(), "UPDATE")} ;
+  if (!file || file->IsZombie()) {
+    oocoutW(&object,Caching) << "RooExpensiveObjectCache::writePersistentObject() WARNING: cannot open persistent store "
+                             << config.fileName << endl ;
+    return kFALSE ;
+  }
+
+  if (file->GetKey(key)) {
+    return kTRUE ;
+  }
+
+  TList* keys = file->GetListOfKeys() ;
+  while (config.maxObjects > 0 && keys->GetSize() >= config.maxObjects) {
+    TKey* oldest = nullptr ;
+    for (auto tkey : TRangeDynCast<TKey>(keys)) {
+      if (tkey && (!oldest || tkey->GetDatime().Convert() < oldest->GetDatime().Convert())) {
+        oldest = tkey ;
+      }
+    }
+    if (!oldest) break ;
+    oldest->Delete() ;
+    delete oldest ;
+  }
+
+  const Bool_t ok = file->WriteTObject(&object, key) > 0 ;
+  file->Close() ;
+  return ok ;
+}
+
+
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Register object associated with given name and given associated parameters with given values in cache.
 /// The cache will take _ownership_of_object_ and is indexed under the given name (which does not
@@ -343,12 +476,25 @@ void RooExpensiveObjectCache::ExpensiveObject::print() const
 
 
 ////////////////////////////////////////////////////////////////////////////////
+/// Import copies of all objects of cache `other` that are owned by the object named `ownerName`.
 
 void RooExpensiveObjectCache::importCacheObjects(RooExpensiveObjectCache& other, const char* ownerName, Bool_t verbose) 
 {
+  importCacheObjects(other, std::set<std::string>{ownerName}, verbose) ;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Import copies of all objects of cache `other` that are owned by any of the objects named in `ownerNames`.
+/// This scans `other` once, also when importing the cache objects of many owners.
+
+void RooExpensiveObjectCache::importCacheObjects(RooExpensiveObjectCache& other, const std::set<std::string>& ownerNames, Bool_t verbose) 
+{
+  if (ownerNames.empty()) return ;
+
   map<TString,ExpensiveObject*>::const_iterator iter = other._map.begin() ;
   while(iter!=other._map.end()) {
-    if (string(ownerName)==iter->second->ownerName()) {      
+    if (ownerNames.count(iter->second->ownerName())) {
       _map[iter->first.Data()] = new ExpensiveObject(_nextUID++, *iter->second) ;
       if (verbose) {
 	oocoutI(iter->second->payload(),Caching) << "RooExpensiveObjectCache::importCache() importing cache object " 
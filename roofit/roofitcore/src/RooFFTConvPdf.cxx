@@ -73,6 +73,12 @@
 /// by calling `RooMsgService::instance().addStream(RooMsgService::INFO,Topic("Caching"))`
 /// to see these message on stdout.
 ///
+/// The FFT plans are set up once per number of sampling points and thread, and are reused by all
+/// RooFFTConvPdf instances. The Fourier transform of each input p.d.f. is kept in the cache, and is only
+/// recomputed if the parameters of that p.d.f. changed. When for example only the parameters of the
+/// signal p.d.f. change, as in most steps of a numerical gradient, the resolution model is neither
+/// sampled nor transformed again.
+///
 /// Multi-dimensional convolutions are not supported at the moment.
 ///
 /// ---
@@ -123,18 +129,42 @@
 #include "RooGlobalFunc.h"
 #include "RooConstVar.h"
 #include "RooUniformBinning.h"
+#include "RooAbsCategory.h"
 
 #include "TClass.h"
 #include "TComplex.h"
 #include "TVirtualFFT.h"
 
 #include <iostream>
+#include <map>
 #include <stdexcept>
+#include <string>
+#include <utility>
 
 using namespace std;
 
 ClassImp(RooFFTConvPdf);
 
+namespace {
+
+////////////////////////////////////////////////////////////////////////////////
+/// Get the FFT plan of the given type ("R2C" or "C2R") for n sampling points. Setting up a plan can be
+/// much more expensive than the transform itself, so the plans are shared by all caches of a thread.
+/// Each user sets the input points, transforms and reads the output without evaluating other p.d.f.s
+/// in between, so nested convolutions can use the same plans.
+
+std::shared_ptr<TVirtualFFT> getFFTPlan(Int_t n, const std::string& type)
+{
+  thread_local std::map<std::pair<Int_t, std::string>, std::shared_ptr<TVirtualFFT>> plans;
+  std::shared_ptr<TVirtualFFT>& plan = plans[{n, type}];
+  if (!plan) {
+    plan.reset(TVirtualFFT::FFT(1, &n, (type + "K").c_str()));
+  }
+  return plan;
+}
+
+}
+
 
 ////////////////////////////////////////////////////////////////////////////////
 /// Constructor for numerical (FFT) convolution of PDFs.
@@ -348,6 +378,10 @@ RooFFTConvPdf::FFTCacheElem::FFTCacheElem(const RooFFTConvPdf& self, const RooAr
   pdf1Clone->fixAddCoefNormalization(convSet, true);
   pdf2Clone->fixAddCoefNormalization(convSet, true);
 
+  // The transforms of the input p.d.f.s only need to be updated if their parameters change
+  pdf1Clone->getParameters(hist()->get(), pdf1Params) ;
+  pdf2Clone->getParameters(hist()->get(), pdf2Params) ;
+
   // Save copy of original histX binning and make alternate binning
   // for extended range scanning
 
@@ -449,6 +483,7 @@ void RooFFTConvPdf::fillCacheObject(RooAbsCachedPdf::PdfCacheElem& cache) const
     i++ ;
   }
 
+  std::size_t sliceIndex = 0 ;
   Bool_t loop(kTRUE) ;
   while(loop) {
     // Set current slice position
@@ -457,7 +492,7 @@ void RooFFTConvPdf::fillCacheObject(RooAbsCachedPdf::PdfCacheElem& cache) const
 //     cout << "filling slice: bin of obsLV[0] = " << obsLV[0]->getBin() << endl ;
 
     // Fill current slice
-    fillCacheSlice((FFTCacheElem&)cache,otherObs) ;
+    fillCacheSlice((FFTCacheElem&)cache,otherObs,sliceIndex++) ;
 
     // Determine which iterator to increment
     while(binCur[curObs]==binMax[curObs]) {
@@ -485,7 +520,7 @@ void RooFFTConvPdf::fillCacheObject(RooAbsCachedPdf::PdfCacheElem& cache) const
 ////////////////////////////////////////////////////////////////////////////////
 /// Fill a slice of cachePdf with the output of the FFT convolution calculation
 
-void RooFFTConvPdf::fillCacheSlice(FFTCacheElem& aux, const RooArgSet& slicePos) const 
+void RooFFTConvPdf::fillCacheSlice(FFTCacheElem& aux, const RooArgSet& slicePos, std::size_t sliceIndex) const 
 {
   // Extract histogram that is the basis of the RooHistPdf
   RooDataHist& cacheHist = *aux.hist() ;
@@ -501,43 +536,42 @@ void RooFFTConvPdf::fillCacheSlice(FFTCacheElem& aux, const RooArgSet& slicePos)
   //
   // 
 
-  Int_t N,N2,binShift1,binShift2 ;
-  
   RooRealVar* histX = (RooRealVar*) cacheHist.get()->find(_x.arg().GetName()) ;
-  if (_bufStrat==Extend) histX->setBinning(*aux.scanBinning) ;
-  std::vector<double> input1 = scanPdf((RooRealVar&)_x.arg(),*aux.pdf1Clone,cacheHist,slicePos,N,N2,binShift1,_shift1) ;
-  std::vector<double> input2 = scanPdf((RooRealVar&)_x.arg(),*aux.pdf2Clone,cacheHist,slicePos,N,N2,binShift2,_shift2) ;
-  if (_bufStrat==Extend) histX->setBinning(*aux.histBinning) ;
-
-
-
+  const Int_t N = histX->numBins(binningName()) ;
+  const Int_t N2 = N + 2*static_cast<Int_t>((N*bufferFraction())/2 + 0.5) ;
 
   // Retrieve previously defined FFT transformation plans
-  if (!aux.fftr2c1) {
-    aux.fftr2c1.reset(TVirtualFFT::FFT(1, &N2, "R2CK"));
-    aux.fftr2c2.reset(TVirtualFFT::FFT(1, &N2, "R2CK"));
-    aux.fftc2r.reset(TVirtualFFT::FFT(1, &N2, "C2RK"));
+  if (!aux.fftr2c) {
+    aux.fftr2c = getFFTPlan(N2, "R2C");
+    aux.fftc2r = getFFTPlan(N2, "C2R");
 
-    if (aux.fftr2c1 == nullptr || aux.fftr2c2 == nullptr || aux.fftc2r == nullptr) {
+    if (aux.fftr2c == nullptr || aux.fftc2r == nullptr) {
+      aux.fftr2c.reset();
       coutF(Eval) << "RooFFTConvPdf::fillCacheSlice(" << GetName() << "Cannot get a handle to fftw. Maybe ROOT was built without it?" << std::endl;
       throw std::runtime_error("Cannot get a handle to fftw.");
     }
   }
-  
-  // Real->Complex FFT Transform on p.d.f. 1 sampling
-  aux.fftr2c1->SetPoints(input1.data());
-  aux.fftr2c1->Transform();
 
-  // Real->Complex FFT Transform on p.d.f 2 sampling
-  aux.fftr2c2->SetPoints(input2.data());
-  aux.fftr2c2->Transform();
+  // Real->Complex FFT Transform on the samplings of both p.d.f.s, if their parameters changed
+  if (aux.transforms1.size() <= sliceIndex) {
+    aux.transforms1.resize(sliceIndex+1) ;
+    aux.transforms2.resize(sliceIndex+1) ;
+  }
+  FFTCacheElem::InputTransform& transform1 = aux.transforms1[sliceIndex] ;
+  FFTCacheElem::InputTransform& transform2 = aux.transforms2[sliceIndex] ;
+
+  if (_bufStrat==Extend) histX->setBinning(*aux.scanBinning) ;
+  transformInput(aux,*aux.pdf1Clone,aux.pdf1Params,transform1,slicePos,N2,_shift1) ;
+  transformInput(aux,*aux.pdf2Clone,aux.pdf2Params,transform2,slicePos,N2,_shift2) ;
+  if (_bufStrat==Extend) histX->setBinning(*aux.histBinning) ;
 
   // Loop over first half +1 of complex output results, multiply 
   // and set as input of reverse transform
   for (Int_t i=0 ; i<N2/2+1 ; i++) {
-    Double_t re1,re2,im1,im2 ;
-    aux.fftr2c1->GetPointComplex(i,re1,im1) ;
-    aux.fftr2c2->GetPointComplex(i,re2,im2) ;
+    Double_t re1 = transform1.coefs[i].real() ;
+    Double_t im1 = transform1.coefs[i].imag() ;
+    Double_t re2 = transform2.coefs[i].real() ;
+    Double_t im2 = transform2.coefs[i].imag() ;
     Double_t re = re1*re2 - im1*im2 ;
     Double_t im = re1*im2 + re2*im1 ;
     TComplex t(re,im) ;
@@ -547,7 +581,7 @@ void RooFFTConvPdf::fillCacheSlice(FFTCacheElem& aux, const RooArgSet& slicePos)
   // Reverse Complex->Real FFT transform product
   aux.fftc2r->Transform() ;
 
-  Int_t totalShift = binShift1 + (N2-N)/2 ;
+  Int_t totalShift = transform1.zeroBin + (N2-N)/2 ;
 
   // Store FFT result in cache
 
@@ -567,6 +601,45 @@ void RooFFTConvPdf::fillCacheSlice(FFTCacheElem& aux, const RooArgSet& slicePos)
 }
 
 
+////////////////////////////////////////////////////////////////////////////////
+/// Update the Fourier transform of the sampling of input p.d.f. 'pdf' at slice position 'slicePos',
+/// unless it was already computed for the current values of its parameters 'params'.
+/// N2 is the number of sampling points, including the buffer bins.
+
+void RooFFTConvPdf::transformInput(FFTCacheElem& aux, RooAbsPdf& pdf, const RooArgSet& params, FFTCacheElem::InputTransform& transform,
+                                   const RooArgSet& slicePos, Int_t N2, Double_t shift) const
+{
+  std::vector<double> paramValues ;
+  paramValues.reserve(params.size()+1) ;
+  for (const auto arg : params) {
+    if (auto real = dynamic_cast<const RooAbsReal*>(arg)) {
+      paramValues.push_back(real->getVal()) ;
+    } else if (auto cat = dynamic_cast<const RooAbsCategory*>(arg)) {
+      paramValues.push_back(cat->getCurrentIndex()) ;
+    }
+  }
+  paramValues.push_back(shift) ;
+
+  if (static_cast<Int_t>(transform.coefs.size()) == N2/2+1 && paramValues == transform.paramValues) {
+    return ;
+  }
+
+  Int_t N, N2scan ;
+  std::vector<double> input = scanPdf((RooRealVar&)_x.arg(),pdf,*aux.hist(),slicePos,N,N2scan,transform.zeroBin,shift) ;
+
+  aux.fftr2c->SetPoints(input.data()) ;
+  aux.fftr2c->Transform() ;
+
+  transform.coefs.resize(N2/2+1) ;
+  for (Int_t i=0 ; i<N2/2+1 ; i++) {
+    Double_t re,im ;
+    aux.fftr2c->GetPointComplex(i,re,im) ;
+    transform.coefs[i] = {re,im} ;
+  }
+  transform.paramValues = std::move(paramValues) ;
+}
+
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Scan the values of 'pdf' in observable 'obs' using the bin values stored in 'hist' at slice position 'slicePos'
 /// N is filled with the number of bins defined in hist, N2 is filled with N plus the number of buffer bins
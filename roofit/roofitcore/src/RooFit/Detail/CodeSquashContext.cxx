@@ -0,0 +1,177 @@
+/*****************************************************************************
+ * Project: RooFit                                                           *
+ * Package: RooFitCore                                                       *
+ * Authors:                                                                  *
+ *   WV, Wouter Verkerke, UC Santa Barbara, verkerke@slac.stanford.edu       *
+ *   DK, David Kirkby,    UC Irvine,         dkirkby@uci.edu                 *
+ *                                                                           *
+ * Copyright (c) 2000-2021, Regents of the University of California          *
+ *                          and Stanford University. All rights reserved.    *
+ *                                                                           *
+ * Redistribution and use in source and binary forms,                        *
+ * with or without modification, are permitted according to the terms        *
+ * listed in LICENSE (http://roofit.sourceforge.net/license.txt)             *
+ *****************************************************************************/
+
+/**
+\file CodeSquashContext.cxx
+\class RooFit::Detail::CodeSquashContext
+\ingroup Roofitcore
+
+The context for the translation of a RooFit model into C++ code that computes
+the negative log-likelihood, see RooFuncWrapper. The nodes of the model
+translate themselves with RooAbsArg::translate(), where they get the C++
+expressions of the values of their servers with getResult() and register the
+expression of their own value with addResult(). Each value is stored in a
+temporary variable, which is declared before the loop over the events if the
+node does not depend on the observables, and inside the loop otherwise.
+
+The generated code has access to three arrays:
+- `params`: the values of the parameters, in the order of the list given to the constructor;
+- `obs`: the values of the observables, one column of nEvents values per observable, followed by the event weights;
+- `xlArr`: further constants, e.g. the contents of histograms, see addToXlArr().
+**/
+
+#include <RooFit/Detail/CodeSquashContext.h>
+
+#include <RooAbsPdf.h>
+#include <RooArgList.h>
+
+#include <cmath>
+#include <iomanip>
+#include <limits>
+#include <memory>
+#include <sstream>
+#include <stdexcept>
+
+namespace RooFit {
+
+namespace Detail {
+
+/// \param[in] observables The observables, whose values are read from the `obs` array.
+/// \param[in] nEvents The number of events in the `obs` array.
+/// \param[in] params The parameters, whose values are read from the `params` array.
+CodeSquashContext::CodeSquashContext(RooArgSet const &observables, std::size_t nEvents, RooArgList const &params)
+   : _nEvents{nEvents}
+{
+   _observables.add(observables);
+   for (std::size_t iObs = 0; iObs < _observables.size(); ++iObs) {
+      _nodeNames[_observables[iObs]->namePtr()] =
+         "obs[" + std::to_string(iObs * _nEvents) + " + " + loopIndex() + "]";
+   }
+   for (std::size_t iParam = 0; iParam < params.size(); ++iParam) {
+      _nodeNames[params[iParam].namePtr()] = "params[" + std::to_string(iParam) + "]";
+   }
+}
+
+/// Get the C++ expression of the value of a node, translating the node first if that was not done yet.
+std::string const &CodeSquashContext::getResult(RooAbsArg const &arg)
+{
+   auto found = _nodeNames.find(arg.namePtr());
+   if (found != _nodeNames.end())
+      return found->second;
+
+   arg.translate(*this);
+
+   found = _nodeNames.find(arg.namePtr());
+   if (found == _nodeNames.end()) {
+      throw std::runtime_error(std::string("CodeSquashContext::getResult(): the translation of ") + arg.GetName() +
+                               " did not register its result.");
+   }
+   return found->second;
+}
+
+/// Get the C++ expression of the value of a pdf, normalized over the observables it depends on. Unless the
+/// translation of the pdf registered an already normalized value, the normalization integral is the analytical
+/// integral of the pdf, see RooAbsReal::buildCallToAnalyticIntegral().
+std::string const &CodeSquashContext::getNormalizedResult(RooAbsPdf const &pdf)
+{
+   auto found = _normalizedNames.find(pdf.namePtr());
+   if (found != _normalizedNames.end())
+      return found->second;
+
+   std::string const &value = getResult(pdf);
+   std::unique_ptr<RooArgSet> intVars{pdf.getObservables(_observables)};
+   if (pdf.selfNormalized() || _isNormalized.count(pdf.namePtr()) || intVars->empty()) {
+      return _normalizedNames[pdf.namePtr()] = value;
+   }
+
+   RooArgSet analVars;
+   Int_t code = pdf.getAnalyticalIntegral(*intVars, analVars);
+   if (code == 0 || analVars.size() != intVars->size()) {
+      throw std::runtime_error(std::string("CodeSquashContext::getNormalizedResult(): the pdf ") + pdf.GetName() +
+                               " can not be integrated analytically over all its observables.");
+   }
+   // the bounds of the integral are constants, so the integral is computed before the loop over the events
+   std::string norm = declare(&pdf, pdf.buildCallToAnalyticIntegral(code, nullptr, *this), false);
+   return _normalizedNames[pdf.namePtr()] = declare(&pdf, value + " / " + norm, isInLoop(&pdf));
+}
+
+/// Register the C++ expression of the value of a node.
+/// \param[in] arg The node.
+/// \param[in] valueExpr The expression of its value.
+/// \param[in] isNormalized Whether the value of a pdf is already normalized over the observables, e.g. because it
+/// is computed from the normalized values of other pdfs.
+void CodeSquashContext::addResult(RooAbsArg const *arg, std::string const &valueExpr, bool isNormalized)
+{
+   _nodeNames[arg->namePtr()] = declare(arg, valueExpr, isInLoop(arg));
+   if (isNormalized)
+      _isNormalized.insert(arg->namePtr());
+}
+
+/// Add statements to the generated code, in the scope where the value of the given node is computed. This is
+/// needed by nodes whose value can not be written as a single expression.
+void CodeSquashContext::addToCodeBody(RooAbsArg const *arg, std::string const &code)
+{
+   (isInLoop(arg) ? _loopScope : _globalScope) += code;
+}
+
+/// Append constants to the `xlArr` array and return the index of the first one.
+std::size_t CodeSquashContext::addToXlArr(std::vector<double> const &values)
+{
+   std::size_t offset = _xlArr.size();
+   _xlArr.insert(_xlArr.end(), values.begin(), values.end());
+   return offset;
+}
+
+/// Return a new unique name for a temporary variable, for nodes that add statements with addToCodeBody().
+std::string CodeSquashContext::getTmpVarName()
+{
+   return "t" + std::to_string(_tmpVarCounter++);
+}
+
+/// Return a C++ literal that has exactly the given value.
+std::string CodeSquashContext::buildArg(double value)
+{
+   if (std::isnan(value)) {
+      return "std::numeric_limits<double>::quiet_NaN()";
+   }
+   if (std::isinf(value)) {
+      return value > 0 ? "std::numeric_limits<double>::infinity()" : "(-std::numeric_limits<double>::infinity())";
+   }
+   std::stringstream ss;
+   ss << std::setprecision(std::numeric_limits<double>::max_digits10) << value;
+   std::string out = ss.str();
+   if (out.find_first_of(".e") == std::string::npos)
+      out += ".0"; // don't let integer literals trigger integer arithmetic
+   return value < 0 ? "(" + out + ")" : out;
+}
+
+bool CodeSquashContext::isInLoop(RooAbsArg const *arg) const
+{
+   return arg->dependsOn(_observables);
+}
+
+/// Declare a temporary variable that holds the value of the expression, and return its name.
+std::string CodeSquashContext::declare(RooAbsArg const *arg, std::string const &valueExpr, bool inLoop)
+{
+   std::string name = getTmpVarName();
+   std::string indent = inLoop ? "      " : "   ";
+   (inLoop ? _loopScope : _globalScope) += indent + "const double " + name + " = " + valueExpr + "; // " +
+                                           arg->GetName() + "\n";
+   return name;
+}
+
+} // namespace Detail
+
+} // namespace RooFit
@@ -0,0 +1,163 @@
+/*************************************************************************
+ * Copyright (C) 1995-2021, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+/**
+\file RooFitDriver.cxx
+\class RooFitDriver
+\ingroup Roofitcore
+
+Drives the repeated batch evaluation of the log probabilities of a pdf on a dataset, evaluating only the
+part of the computation graph that depends on the parameters that changed, see RooFitDriver.h.
+**/
+
+#include "RooFitDriver.h"
+
+#include "RooAbsCategory.h"
+#include "RooAbsData.h"
+#include "RooAbsPdf.h"
+#include "RooAbsReal.h"
+
+#include <unordered_map>
+#include <utility>
+
+namespace {
+
+bool sameSpan(RooSpan<const double> a, RooSpan<const double> b)
+{
+  return a.data() == b.data() && a.size() == b.size();
+}
+
+} // namespace
+
+RooFitDriver::RooFitDriver(const RooAbsPdf& topNode, const RooAbsData& data) : _topNode{&topNode}, _data{&data}
+{
+  buildPlan();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Flatten the computation graph of the top node, with the servers of each node before the node.
+
+void RooFitDriver::buildPlan()
+{
+  _nodes.clear();
+  std::unordered_map<const RooAbsArg*, std::size_t> positions;
+
+  // depth-first search, adding the nodes when all their servers were added
+  auto visit = [&](const RooAbsArg* arg, auto& visitRef) -> std::size_t {
+    auto found = positions.find(arg);
+    if (found != positions.end())
+      return found->second;
+
+    NodeInfo info;
+    info.node = arg;
+    info.real = dynamic_cast<const RooAbsReal*>(arg);
+    info.cat = dynamic_cast<const RooAbsCategory*>(arg);
+    for (const RooAbsArg* server : arg->servers()) {
+      info.servers.push_back(server);
+      info.serverIndices.push_back(visitRef(server, visitRef));
+    }
+
+    positions[arg] = _nodes.size();
+    _nodes.push_back(std::move(info));
+    return _nodes.size() - 1;
+  };
+  visit(_topNode, visit);
+
+  _allDirty = true;
+  _lastDataModificationCount = _data->modificationCount();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Check that the servers of the nodes are still the ones of the plan.
+
+bool RooFitDriver::planIsValid() const
+{
+  for (const NodeInfo& info : _nodes) {
+    const auto& servers = info.node->servers();
+    if (servers.size() != info.servers.size())
+      return false;
+    std::size_t i = 0;
+    for (const RooAbsArg* server : servers) {
+      if (server != info.servers[i++])
+        return false;
+    }
+  }
+  return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Compute the log probabilities of the top node for the events [begin, begin+len) of the dataset.
+/// Only the nodes that depend on a leaf that changed since the previous call are evaluated again.
+/// \return Span with the results. The memory is owned by runContext().
+
+RooSpan<const double> RooFitDriver::getLogProbabilities(std::size_t begin, std::size_t len, const RooArgSet* normSet)
+{
+  if (!planIsValid())
+    buildPlan();
+  if (normSet != _lastNormSet) {
+    _allDirty = true;
+    _lastNormSet = normSet;
+  }
+  if (_data->modificationCount() != _lastDataModificationCount) {
+    _allDirty = true;
+    _lastDataModificationCount = _data->modificationCount();
+  }
+
+  // The results of the previous evaluation. The clean nodes get them back, all other entries, including
+  // the ones of objects outside of the graph such as the normalisation integrals, are dropped.
+  auto lastSpans = std::move(_evalData.spans);
+  _evalData.clear();
+  _data->getBatches(_evalData, begin, len);
+
+  for (NodeInfo& info : _nodes) {
+    bool dirty = _allDirty;
+    for (std::size_t server : info.serverIndices)
+      dirty = dirty || _nodes[server].dirty;
+    // changes that RooFit propagated, also the ones that do not come from the servers
+    dirty = dirty || info.node->valueDirtyCount() != info.lastValueDirtyCount ||
+            info.node->operMode() == RooAbsArg::ADirty;
+
+    if (info.serverIndices.empty()) {
+      // parameters and observables
+      if (info.real) {
+        auto values = info.real->getValues(_evalData, nullptr);
+        dirty = dirty || !sameSpan(values, info.lastData) || (values.size() == 1 && values[0] != info.lastValue);
+        info.lastData = values;
+        if (values.size() == 1)
+          info.lastValue = values[0];
+      } else if (info.cat) {
+        const double index = info.cat->getCurrentIndex();
+        dirty = dirty || index != info.lastValue;
+        info.lastValue = index;
+      } else {
+        dirty = true;
+      }
+    } else if (info.real) {
+      auto item = _evalData.spans.find(info.real);
+      if (item != _evalData.spans.end()) {
+        // provided by the dataset, e.g. cached by the optimisation of the constant terms
+        dirty = dirty || !sameSpan(item->second, info.lastData);
+        info.lastData = item->second;
+      } else if (!dirty) {
+        auto last = lastSpans.find(info.real);
+        if (last != lastSpans.end())
+          _evalData.spans.insert(*last);
+      }
+    }
+
+    info.dirty = dirty;
+  }
+
+  auto results = _topNode->getLogProbabilities(_evalData, normSet);
+  _allDirty = false;
+  // The evaluation itself marks nodes dirty, e.g. when evaluating event by event the nodes without a batch
+  // implementation, so only the changes after it count.
+  for (NodeInfo& info : _nodes)
+    info.lastValueDirtyCount = info.node->valueDirtyCount();
+  return results;
+}
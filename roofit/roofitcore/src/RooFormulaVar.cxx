@@ -54,6 +54,10 @@
 #include "RooChi2Var.h"
 #include "RooMsgService.h"
 #include "RooTrace.h"
+#include "RooFit/Detail/CodeSquashContext.h"
+
+#include <regex>
+#include <stdexcept>
 
 
 using namespace std;
@@ -152,6 +156,32 @@ Double_t RooFormulaVar::evaluate() const
 }
 
 
+////////////////////////////////////////////////////////////////////////////////
+/// Translate the formula into C++ code, by replacing the `x[i]` references of the
+/// formula by the expressions of the values of the variables. The formula must be
+/// valid C++, so the TFormula syntax `a^b` for powers is not supported.
+void RooFormulaVar::translate(RooFit::Detail::CodeSquashContext &ctx) const
+{
+  const std::string formula = getFormula().formulaString();
+  if (formula.find('^') != std::string::npos) {
+    throw std::runtime_error(std::string("RooFormulaVar::translate(") + GetName()
+                             + "): the power operator '^' is not supported, use pow() instead.");
+  }
+
+  static const std::regex varRegex("x\\[([0-9]+)\\]");
+  std::string code;
+  auto last = formula.cbegin();
+  for (std::sregex_iterator it(formula.cbegin(), formula.cend(), varRegex), end; it != end; ++it) {
+    code.append(last, (*it)[0].first);
+    code += ctx.getResult(_actualVars[std::stoi((*it)[1].str())]);
+    last = (*it)[0].second;
+  }
+  code.append(last, formula.cend());
+
+  ctx.addResult(this, "(" + code + ")");
+}
+
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Evaluate the formula for all entries of our servers found in `inputData`.
 RooSpan<double> RooFormulaVar::evaluateSpan(RooBatchCompute::RunContext& inputData, const RooArgSet* normSet) const {
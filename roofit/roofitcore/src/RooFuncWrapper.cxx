@@ -0,0 +1,203 @@
+/*****************************************************************************
+ * Project: RooFit                                                           *
+ * Package: RooFitCore                                                       *
+ * Authors:                                                                  *
+ *   WV, Wouter Verkerke, UC Santa Barbara, verkerke@slac.stanford.edu       *
+ *   DK, David Kirkby,    UC Irvine,         dkirkby@uci.edu                 *
+ *                                                                           *
+ * Copyright (c) 2000-2021, Regents of the University of California          *
+ *                          and Stanford University. All rights reserved.    *
+ *                                                                           *
+ * Redistribution and use in source and binary forms,                        *
+ * with or without modification, are permitted according to the terms        *
+ * listed in LICENSE (http://roofit.sourceforge.net/license.txt)             *
+ *****************************************************************************/
+
+/**
+\file RooFuncWrapper.cxx
+\class RooFuncWrapper
+\ingroup Roofitcore
+
+The negative log-likelihood of a p.d.f. and a dataset, computed by C++ code
+that is generated from the p.d.f. and compiled with the interpreter. The code
+is differentiated with Clad, so the gradient of the likelihood is analytic: it
+costs about as much as a few evaluations of the likelihood, independent of the
+number of parameters, instead of two evaluations per parameter for the
+numerical gradient. Minimizing the RooFuncWrapper with RooMinimizer in the
+gradient mode uses the analytic gradient:
+~~~{.cpp}
+RooFuncWrapper nll("nll", "nll", pdf, data, true); // extended likelihood
+RooMinimizer m(nll, RooMinimizer::FcnMode::gradient);
+m.migrad();
+~~~
+
+Each node of the model translates itself into code with RooAbsArg::translate(),
+see RooFit::Detail::CodeSquashContext. This is supported by RooGaussian,
+RooExponential, RooPolynomial, RooAddPdf, RooProdPdf, RooHistFunc,
+RooFormulaVar, RooProduct, RooAddition, RooConstVar, and the HistFactory
+FlexibleInterpVar; the constructor throws if the model contains other classes.
+The values of the observables are copied from the dataset when the likelihood
+is constructed, so changes of the dataset afterwards are not seen. Clad needs
+ROOT to be built with `-Dclad=ON`.
+**/
+
+#include "RooFuncWrapper.h"
+
+#include "RooAbsData.h"
+#include "RooAbsPdf.h"
+#include "RooArgSet.h"
+#include "RooRealVar.h"
+#include "RooFit/Detail/CodeSquashContext.h"
+
+#include "TInterpreter.h"
+
+#include <algorithm>
+#include <memory>
+#include <sstream>
+#include <stdexcept>
+
+ClassImp(RooFuncWrapper);
+
+namespace {
+
+bool declareOrThrow(std::string const &code)
+{
+   if (!gInterpreter->Declare(code.c_str())) {
+      throw std::runtime_error("RooFuncWrapper: the interpreter failed to compile the code\n" + code);
+   }
+   return true;
+}
+
+} // namespace
+
+/// Generate and compile the code of the negative log-likelihood and of its gradient.
+/// \param[in] name Name of the likelihood
+/// \param[in] title Title of the likelihood
+/// \param[in] pdf The p.d.f., which must only contain classes that support the code generation
+/// \param[in] data The dataset, which must only have real-valued observables
+/// \param[in] extended Whether to add the extended term, see RooAbsPdf::extendedTerm()
+RooFuncWrapper::RooFuncWrapper(const char *name, const char *title, RooAbsPdf &pdf, RooAbsData &data, bool extended)
+   : RooAbsReal{name, title}, _params{"!params", "List of parameters", this}
+{
+   std::unique_ptr<RooArgSet> observables{pdf.getObservables(data)};
+   std::unique_ptr<RooArgSet> parameters{pdf.getParameters(data)};
+
+   for (RooAbsArg *param : *parameters) {
+      if (dynamic_cast<RooRealVar *>(param)) {
+         _params.add(*param);
+      } else if (!param->isConstant()) {
+         throw std::invalid_argument(std::string("RooFuncWrapper: the parameter ") + param->GetName() +
+                                     " is not a RooRealVar.");
+      }
+   }
+   for (RooAbsArg *obs : *observables) {
+      if (!dynamic_cast<RooAbsReal *>(obs)) {
+         throw std::invalid_argument(std::string("RooFuncWrapper: the observable ") + obs->GetName() +
+                                     " is not real valued.");
+      }
+   }
+
+   // copy the observables and the weights into one array, column by column
+   const std::size_t nEvents = data.numEntries();
+   _observables.resize((observables->size() + 1) * nEvents);
+   for (std::size_t iEvent = 0; iEvent < nEvents; ++iEvent) {
+      const RooArgSet *row = data.get(iEvent);
+      for (std::size_t iObs = 0; iObs < observables->size(); ++iObs) {
+         _observables[iObs * nEvents + iEvent] =
+            static_cast<RooAbsReal *>(row->find(*(*observables)[iObs]))->getVal();
+      }
+      _observables[observables->size() * nEvents + iEvent] = data.weight();
+   }
+
+   RooFit::Detail::CodeSquashContext ctx{*observables, nEvents, _params};
+   std::string const &pdfValue = ctx.getNormalizedResult(pdf);
+   std::string extendedTerm;
+   if (extended) {
+      if (!pdf.canBeExtended()) {
+         throw std::invalid_argument(std::string("RooFuncWrapper: the pdf ") + pdf.GetName() +
+                                     " can not be extended.");
+      }
+      // the negative log of the Poisson probability, without the constant log(observed!) term
+      const std::string expected = pdf.buildCallToExpectedEvents(ctx);
+      extendedTerm = "   nllSum += " + expected + " - " + ctx.buildArg(data.sumEntries()) + " * TMath::Log(" +
+                     expected + ");\n";
+   }
+   _xlArr = ctx.xlArr();
+
+   static std::size_t funcCounter = 0;
+   _funcName = "roo_func_wrapper_" + std::to_string(funcCounter++);
+
+   const std::string loopIdx = RooFit::Detail::CodeSquashContext::loopIndex();
+   std::stringstream code;
+   code << "double " << _funcName << "(double *params, double const *obs, double const *xlArr) {\n"
+        << ctx.globalScope() << "   double nllSum = 0.0;\n"
+        << "   for (int " << loopIdx << " = 0; " << loopIdx << " < " << nEvents << "; ++" << loopIdx << ") {\n"
+        << ctx.loopScope() << "      nllSum -= obs[" << ctx.weightOffset() << " + " << loopIdx
+        << "] * TMath::Log(" << pdfValue << ");\n"
+        << "   }\n"
+        << extendedTerm << "   return nllSum;\n"
+        << "}\n";
+   _funcBody = code.str();
+
+   declareFunctions();
+}
+
+RooFuncWrapper::RooFuncWrapper(const RooFuncWrapper &other, const char *name)
+   : RooAbsReal(other, name), _params("!params", this, other._params), _funcName(other._funcName),
+     _funcBody(other._funcBody), _func(other._func), _grad(other._grad), _observables(other._observables),
+     _xlArr(other._xlArr)
+{
+}
+
+/// Compile the likelihood function, let Clad generate its gradient, and get the pointers to both functions.
+void RooFuncWrapper::declareFunctions()
+{
+   static bool cladRuntimeIncluded = false;
+   if (!cladRuntimeIncluded) {
+      cladRuntimeIncluded = declareOrThrow("#include <Math/CladDerivator.h>\n#pragma clad OFF");
+   }
+
+   declareOrThrow(_funcBody);
+   declareOrThrow("#pragma cling optimize(2)\n"
+                  "#pragma clad ON\n"
+                  "void " + _funcName + "_req() {\n"
+                  "   clad::gradient(" + _funcName + ", \"params\");\n"
+                  "}\n"
+                  "#pragma clad OFF");
+   // a wrapper with a plain pointer for the output, so that clad::array_ref is not needed here
+   declareOrThrow("void " + _funcName + "_grad_wrapper(double *params, double const *obs, double const *xlArr, "
+                  "double *out) {\n"
+                  "   clad::array_ref<double> outRef(out, " + std::to_string(_params.size()) + ");\n"
+                  "   " + _funcName + "_grad_0(params, obs, xlArr, outRef);\n"
+                  "}\n");
+
+   _func = reinterpret_cast<Func>(gInterpreter->ProcessLine(("(void *)&" + _funcName + ";").c_str()));
+   _grad = reinterpret_cast<Grad>(gInterpreter->ProcessLine(("(void *)&" + _funcName + "_grad_wrapper;").c_str()));
+   if (!_func || !_grad) {
+      throw std::runtime_error("RooFuncWrapper: could not get the compiled functions of " + _funcName);
+   }
+}
+
+void RooFuncWrapper::updateParamValues() const
+{
+   _paramValues.resize(_params.size());
+   for (std::size_t i = 0; i < _params.size(); ++i) {
+      _paramValues[i] = static_cast<RooAbsReal &>(_params[i]).getVal();
+   }
+}
+
+Double_t RooFuncWrapper::evaluate() const
+{
+   updateParamValues();
+   return _func(_paramValues.data(), _observables.data(), _xlArr.data());
+}
+
+/// Compute the analytic gradient of the likelihood.
+/// \param[out] out The derivatives with respect to the parameters, in the order of parameters(). The array must hold
+/// parameters().size() values.
+void RooFuncWrapper::gradient(double *out) const
+{
+   updateParamValues();
+   std::fill(out, out + _params.size(), 0.0);
+   _grad(_paramValues.data(), _observables.data(), _xlArr.data(), out);
+}
@@ -27,6 +27,7 @@
 #include "RooRealVar.h"
 #include "RooMsgService.h"
 #include "RooMinimizer.h"
+#include "RooFuncWrapper.h"
 
 #include "Riostream.h"
 #include "TIterator.h"
@@ -40,8 +41,9 @@
 RooGradMinimizerFcn::RooGradMinimizerFcn(RooAbsReal *funct, RooMinimizer *context, bool verbose)
    : RooAbsMinimizerFcn(RooArgList( * std::unique_ptr<RooArgSet>(funct->getParameters(RooArgSet{})) ), context, verbose),
      _grad(getNDim()), _grad_params(getNDim()), _funct(funct),
-     has_been_calculated(getNDim())
+     has_been_calculated(getNDim()), _funcWrapper(dynamic_cast<RooFuncWrapper *>(funct))
 {
+   updateAnalyticGradientIndices();
    // TODO: added "parameters" after rewrite in april 2020, check if correct
    auto parameters = _context->fitter()->Config().ParamsSettings();
    synchronizeParameterSettings(parameters, kTRUE, verbose);
@@ -52,7 +54,8 @@ RooGradMinimizerFcn::RooGradMinimizerFcn(RooAbsReal *funct, RooMinimizer *contex
 
 RooGradMinimizerFcn::RooGradMinimizerFcn(const RooGradMinimizerFcn &other)
    : RooAbsMinimizerFcn(other), _grad(other._grad), _grad_params(other._grad_params), _gradf(other._gradf), _funct(other._funct),
-     has_been_calculated(other.has_been_calculated), none_have_been_calculated(other.none_have_been_calculated)
+     has_been_calculated(other.has_been_calculated), none_have_been_calculated(other.none_have_been_calculated),
+     _funcWrapper(other._funcWrapper), _analyticGradIndices(other._analyticGradIndices)
 {
 }
 
@@ -208,8 +211,45 @@ void RooGradMinimizerFcn::runDerivator(unsigned int i_component) const
    }
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Find the floating parameters in the parameters of the RooFuncWrapper, whose analytic gradient is used.
+
+void RooGradMinimizerFcn::updateAnalyticGradientIndices()
+{
+   if (!_funcWrapper)
+      return;
+   _analyticGradIndices.resize(getNDim());
+   for (std::size_t ix = 0; ix < getNDim(); ++ix) {
+      _analyticGradIndices[ix] = _funcWrapper->parameters().index(_floatParamList->at(ix)->GetName());
+   }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Compute the gradient. The analytic gradient of a RooFuncWrapper is used if
+/// possible, otherwise the numerical derivatives are computed one by one.
+
+void RooGradMinimizerFcn::Gradient(const double *x, double *grad) const
+{
+   if (!_funcWrapper) {
+      ROOT::Math::IMultiGradFunction::Gradient(x, grad);
+      return;
+   }
+
+   syncParameters(x);
+   _analyticGrad.resize(_funcWrapper->parameters().size());
+   _funcWrapper->gradient(_analyticGrad.data());
+   for (std::size_t ix = 0; ix < NDim(); ++ix) {
+      grad[ix] = _analyticGrad[_analyticGradIndices[ix]];
+   }
+}
+
 double RooGradMinimizerFcn::DoDerivative(const double *x, unsigned int i_component) const
 {
+   if (_funcWrapper) {
+      std::vector<double> grad(NDim());
+      Gradient(x, grad.data());
+      return grad[i_component];
+   }
    syncParameters(x);
    runDerivator(i_component);
    return _grad[i_component].derivative;
@@ -244,6 +284,7 @@ Bool_t
 RooGradMinimizerFcn::Synchronize(std::vector<ROOT::Fit::ParameterSettings> &parameters, Bool_t optConst, Bool_t verbose)
 {
    Bool_t returnee = synchronizeParameterSettings(parameters, optConst, verbose);
+   updateAnalyticGradientIndices();
    synchronizeGradientParameterSettings(parameters);
    setStrategy(_context->fitter()->Config().MinimizerOptions().Strategy());
    setErrorLevel(_context->fitter()->Config().MinimizerOptions().ErrorDef());
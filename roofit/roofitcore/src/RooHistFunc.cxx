@@ -33,6 +33,7 @@ discrete dimensions and may have negative values.
 #include "RooHistPdf.h"
 #include "RooHelpers.h"
 #include "RunContext.h"
+#include "RooFit/Detail/CodeSquashContext.h"
 
 #include "TError.h"
 #include "TBuffer.h"
@@ -202,6 +203,56 @@ Double_t RooHistFunc::evaluate() const
 }
 
 
+////////////////////////////////////////////////////////////////////////////////
+/// Translate the histogram lookup into C++ code, for the analytic gradients of
+/// RooFuncWrapper. The bin contents are stored in the array of constants of the
+/// generated code. Only histograms of real-valued observables with uniform
+/// binnings and no interpolation are supported. Values outside of the histogram
+/// are assigned to the first or last bin.
+
+void RooHistFunc::translate(RooFit::Detail::CodeSquashContext &ctx) const
+{
+  if (_intOrder != 0) {
+    throw std::runtime_error(std::string("RooHistFunc::translate(") + GetName() + "): interpolation is not supported.");
+  }
+
+  std::vector<double> weights(_dataHist->numEntries());
+  for (std::size_t i = 0; i < weights.size(); ++i) {
+    weights[i] = _dataHist->weight(i);
+  }
+  const std::size_t offset = ctx.addToXlArr(weights);
+
+  // the bins are stored with the index of the last variable running fastest, see RooDataHist::calcTreeIndex()
+  const RooArgSet &histVars = *_dataHist->get();
+  std::vector<int> idxMult(histVars.size(), 1);
+  for (std::size_t i = 0; i < histVars.size(); ++i) {
+    auto var = dynamic_cast<const RooRealVar *>(histVars[i]);
+    if (!var || !var->getBinning().isUniform()) {
+      throw std::runtime_error(std::string("RooHistFunc::translate(") + GetName()
+                               + "): only real-valued observables with uniform binnings are supported.");
+    }
+    for (std::size_t j = 0; j < i; ++j) {
+      idxMult[j] *= var->getBinning().numBins();
+    }
+  }
+
+  const std::string idx = ctx.getTmpVarName();
+  std::string code = "      int " + idx + " = 0;\n";
+  for (std::size_t i = 0; i < histVars.size(); ++i) {
+    const RooAbsBinning &binning = static_cast<const RooRealVar *>(histVars[i])->getBinning();
+    const RooAbsArg &dep = *_depList[static_cast<std::size_t>(_histObsList.index(histVars[i]->GetName()))];
+    const std::string bin = ctx.getTmpVarName();
+    const std::string lastBin = std::to_string(binning.numBins() - 1);
+    code += "      int " + bin + " = static_cast<int>((" + ctx.getResult(dep) + " - "
+            + ctx.buildArg(binning.lowBound()) + ") / " + ctx.buildArg(binning.averageBinWidth()) + ");\n";
+    code += "      " + bin + " = " + bin + " < 0 ? 0 : (" + bin + " > " + lastBin + " ? " + lastBin + " : " + bin + ");\n";
+    code += "      " + idx + " += " + std::to_string(idxMult[i]) + " * " + bin + ";\n";
+  }
+  ctx.addToCodeBody(this, code);
+  ctx.addResult(this, "xlArr[" + std::to_string(offset) + " + " + idx + "]");
+}
+
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Compute value of the HistFunc for every entry in `evalData`.
 /// \param[in/out] evalData Struct with input data. The computation results will be stored here.
@@ -622,7 +673,10 @@ std::vector<Int_t> RooHistFunc::getBins(RooBatchCompute::RunContext& evalData) c
       [](const RooSpan<const double>& a, const RooSpan<const double>& b){ return a.size() < b.size(); })->size();
   std::vector<Int_t> results;
 
+  results.reserve(batchSize);
+
   for (std::size_t evt = 0; evt < batchSize; ++evt) {
+    bool inRange = true;
     if (!_depList.empty()) {
       for (auto i = 0u; i < _histObsList.size(); ++i) {
         const auto harg = _histObsList[i];
@@ -631,13 +685,13 @@ std::vector<Int_t> RooHistFunc::getBins(RooBatchCompute::RunContext& evalData) c
           harg->setCachedValue(depData[i][evt], false);
 
         if (!harg->inRange(nullptr)) {
-          results.push_back(-1);
-          continue;
+          inRange = false;
+          break;
         }
       }
     }
 
-    results.push_back(_dataHist->getIndex(_histObsList, true));
+    results.push_back(inRange ? _dataHist->getIndex(_histObsList, true) : -1);
   }
 
   return results;
@@ -36,6 +36,7 @@ numerical integration algorithm.
 #include "RooNumIntConfig.h"
 #include "RooNumIntFactory.h"
 #include "RooMsgService.h"
+#include "RooRealBinding.h"
 
 #include <assert.h>
 
@@ -64,9 +65,13 @@ void RooIntegrator1D::registerIntegrator(RooNumIntFactory& fact)
   RooRealVar maxSteps("maxSteps","Maximum number of steps",20) ;
   RooRealVar minSteps("minSteps","Minimum number of steps",999) ;
   RooRealVar fixSteps("fixSteps","Fixed number of steps",0) ;
+  RooCategory batchMode("batchMode","Batch evaluation of the integrand") ;
+  batchMode.defineType("Off",0) ;
+  batchMode.defineType("On",1) ;
+  batchMode.setLabel("Off") ;
 
   RooIntegrator1D* proto = new RooIntegrator1D() ;
-  fact.storeProtoIntegrator(proto,RooArgSet(sumRule,extrap,maxSteps,minSteps,fixSteps)) ;
+  fact.storeProtoIntegrator(proto,RooArgSet(sumRule,extrap,maxSteps,minSteps,fixSteps,batchMode)) ;
   RooNumIntConfig::defaultConfig().method1D().setLabel(proto->IsA()->GetName()) ;
 }
 
@@ -77,7 +82,7 @@ void RooIntegrator1D::registerIntegrator(RooNumIntFactory& fact)
 /// Default constructor
 
 RooIntegrator1D::RooIntegrator1D() :
-  _h(0), _s(0), _c(0), _d(0), _x(0)
+  _batchMode(kFALSE), _h(0), _s(0), _c(0), _d(0), _x(0)
 {
 }
 
@@ -89,7 +94,7 @@ RooIntegrator1D::RooIntegrator1D() :
 
 RooIntegrator1D::RooIntegrator1D(const RooAbsFunc& function, SummationRule rule,
 				 Int_t maxSteps, Double_t eps) : 
-  RooAbsIntegrator(function), _rule(rule), _maxSteps(maxSteps),  _minStepsZero(999), _fixSteps(0), _epsAbs(eps), _epsRel(eps), _doExtrap(kTRUE)
+  RooAbsIntegrator(function), _rule(rule), _maxSteps(maxSteps),  _minStepsZero(999), _fixSteps(0), _epsAbs(eps), _epsRel(eps), _doExtrap(kTRUE), _batchMode(kFALSE)
 {
   _useIntegrandLimits= kTRUE;
   _valid= initialize();
@@ -111,7 +116,8 @@ RooIntegrator1D::RooIntegrator1D(const RooAbsFunc& function, Double_t xmin, Doub
   _fixSteps(0),
   _epsAbs(eps), 
   _epsRel(eps),
-  _doExtrap(kTRUE)
+  _doExtrap(kTRUE),
+  _batchMode(kFALSE)
 {
   _useIntegrandLimits= kFALSE;
   _xmin= xmin;
@@ -137,6 +143,7 @@ RooIntegrator1D::RooIntegrator1D(const RooAbsFunc& function, const RooNumIntConf
   _minStepsZero = (Int_t) configSet.getRealValue("minSteps",999) ;
   _fixSteps = (Int_t) configSet.getRealValue("fixSteps",0) ;
   _doExtrap = (Bool_t) configSet.getCatIndex("extrapolation",1) ;
+  _batchMode = (Bool_t) configSet.getCatIndex("batchMode",0) ;
 
   if (_fixSteps>_maxSteps) {
     oocoutE((TObject*)0,Integration) << "RooIntegrator1D::ctor() ERROR: fixSteps>maxSteps, fixSteps set to maxSteps" << endl ;
@@ -166,6 +173,7 @@ RooIntegrator1D::RooIntegrator1D(const RooAbsFunc& function, Double_t xmin, Doub
   _minStepsZero = (Int_t) configSet.getRealValue("minSteps",999) ;
   _fixSteps = (Int_t) configSet.getRealValue("fixSteps",0) ;  
   _doExtrap = (Bool_t) configSet.getCatIndex("extrapolation",1) ;
+  _batchMode = (Bool_t) configSet.getCatIndex("batchMode",0) ;
 
   _useIntegrandLimits= kFALSE;
   _xmin= xmin;
@@ -368,12 +376,14 @@ Double_t RooIntegrator1D::addMidpoints(Int_t n)
     del= _range/(3.*tnm);
     ddel= del+del;
     x= _xmin + 0.5*del;
-    for(sum= 0, j= 1; j <= it; j++) {
-      sum+= integrand(xvec(x));
+    _abscissae.clear();
+    for(j= 1; j <= it; j++) {
+      _abscissae.push_back(x);
       x+= ddel;
-      sum+= integrand(xvec(x));
+      _abscissae.push_back(x);
       x+= del;
     }      
+    sum= sumIntegrand();
     return (_savedResult= (_savedResult + _range*sum/tnm)/3.);
   }
 }
@@ -398,12 +408,11 @@ Double_t RooIntegrator1D::addTrapezoids(Int_t n)
     const double del = _range/nInt;
     const double xmin = _xmin;
 
-    double sum = 0.;
-    // TODO Replace by batch computation
+    _abscissae.resize(nInt);
     for (int j=0; j<nInt; ++j) {
-      double x = xmin + (0.5+j)*del;
-      sum += integrand(xvec(x));
+      _abscissae[j] = xmin + (0.5+j)*del;
     }
+    const double sum = sumIntegrand();
 
     return (_savedResult= 0.5*(_savedResult + _range*sum/nInt));
   }
@@ -411,6 +420,41 @@ Double_t RooIntegrator1D::addTrapezoids(Int_t n)
 
 
 
+////////////////////////////////////////////////////////////////////////////////
+/// Return the sum of the integrand over all abscissae of the current refinement step.
+/// In batch mode, integrands bound with RooRealBinding are evaluated for all abscissae
+/// at once through the batch interface of RooAbsReal, i.e. with a single pass through
+/// the computation graph. Otherwise, the integrand is evaluated point by point.
+
+Double_t RooIntegrator1D::sumIntegrand()
+{
+  auto realBinding = _batchMode ? dynamic_cast<const RooRealBinding*>(_function) : nullptr;
+  if (realBinding && _abscissae.size() > 1) {
+    // The coordinates of the other dimensions, e.g. when integrating over one dimension of a
+    // two-dimensional integral, are the same for all abscissae.
+    std::vector<RooSpan<const double>> coordinates{RooSpan<const double>(_abscissae)};
+    for (UInt_t i = 1; i < _function->getDimension(); ++i) {
+      coordinates.emplace_back(_x + i, 1);
+    }
+    auto results = realBinding->getValues(coordinates);
+    if (results.size() == _abscissae.size()) {
+      double sum = 0.;
+      for (double result : results) {
+        sum += result;
+      }
+      return sum;
+    }
+  }
+
+  double sum = 0.;
+  for (double x : _abscissae) {
+    sum += integrand(xvec(x));
+  }
+  return sum;
+}
+
+
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Extrapolate result to final value
 
@@ -38,7 +38,9 @@ based on a C version from the 0.9 beta release of the GNU scientific library.
 #include "RooRealVar.h"
 #include "RooCategory.h"
 #include "RooMsgService.h"
+#include "RooRealBinding.h"
 
+#include <algorithm>
 #include <math.h>
 
 
@@ -73,6 +75,11 @@ void RooMCIntegrator::registerIntegrator(RooNumIntFactory& fact)
   verbose.defineType("false",0) ;
   verbose.setIndex(0) ;
 
+  RooCategory batchMode("batchMode","Batch evaluation of the integrand") ;
+  batchMode.defineType("Off",0) ;
+  batchMode.defineType("On",1) ;
+  batchMode.setIndex(0) ;
+
   RooRealVar alpha("alpha","Grid structure constant",1.5) ;
   RooRealVar nRefineIter("nRefineIter","Number of refining iterations",5) ;
   RooRealVar nRefinePerDim("nRefinePerDim","Number of refining samples (per dimension)",1000) ;
@@ -82,7 +89,7 @@ void RooMCIntegrator::registerIntegrator(RooNumIntFactory& fact)
   RooMCIntegrator* proto = new RooMCIntegrator() ;
 
   // Register prototype and default config with factory
-  fact.storeProtoIntegrator(proto,RooArgSet(samplingMode,genType,verbose,alpha,nRefineIter,nRefinePerDim,nIntPerDim)) ;
+  fact.storeProtoIntegrator(proto,RooArgSet(samplingMode,genType,verbose,batchMode,alpha,nRefineIter,nRefinePerDim,nIntPerDim)) ;
 
   // Make this method the default for all N>2-dim integrals
   RooNumIntConfig::defaultConfig().methodND().setLabel(proto->IsA()->GetName()) ;
@@ -110,7 +117,7 @@ void RooMCIntegrator::registerIntegrator(RooNumIntFactory& fact)
 
 RooMCIntegrator::RooMCIntegrator(const RooAbsFunc& function, SamplingMode mode,
 				 GeneratorType genType, Bool_t verbose) :
-  RooAbsIntegrator(function), _grid(function), _verbose(verbose),
+  RooAbsIntegrator(function), _grid(function), _verbose(verbose), _batchMode(kFALSE),
   _alpha(1.5),  _mode(mode), _genType(genType),
   _nRefineIter(5),_nRefinePerDim(1000),_nIntegratePerDim(5000)
 {
@@ -130,6 +137,7 @@ RooMCIntegrator::RooMCIntegrator(const RooAbsFunc& function, const RooNumIntConf
 { 
   const RooArgSet& configSet = config.getConfigSection(IsA()->GetName()) ;
   _verbose = (Bool_t) configSet.getCatIndex("verbose",0) ;
+  _batchMode = (Bool_t) configSet.getCatIndex("batchMode",0) ;
   _alpha = configSet.getRealValue("alpha",1.5) ;
   _mode = (SamplingMode) configSet.getCatIndex("samplingMode",Importance) ;
   _genType = (GeneratorType) configSet.getCatIndex("genType",QuasiRandom) ;
@@ -262,10 +270,15 @@ Double_t RooMCIntegrator::vegas(Stage stage, UInt_t calls, UInt_t iterations, Do
   }
 
   // allocate memory for some book-keeping arrays
+  const UInt_t dim(_grid.getDimension());
   UInt_t *box= _grid.createIndexVector();
   UInt_t *bin= _grid.createIndexVector();
   Double_t *x= _grid.createPoint();
 
+  // In batch mode, the points of all boxes of an iteration are generated first, and the
+  // integrand is evaluated for all of them at once through the batch interface.
+  auto realBinding = _batchMode ? dynamic_cast<const RooRealBinding*>(_function) : nullptr;
+
   // loop over iterations for this step
   Double_t cum_int(0),cum_sig(0);
   _it_start = _it_num;
@@ -278,17 +291,30 @@ Double_t RooMCIntegrator::vegas(Stage stage, UInt_t calls, UInt_t iterations, Do
     // reset the values associated with each grid cell
     _grid.resetValues();
 
+    if (realBinding) {
+      generateAndEvaluatePoints(*realBinding, box, bin, x);
+    }
+
     // loop over grid boxes
+    std::size_t iPoint = 0;
     _grid.firstBox(box);
     do {
       Double_t m(0),q(0);
       // loop over integrand evaluations within this grid box
       for(UInt_t k = 0; k < _calls_per_box; k++) {
-        // generate a random point in this box
-        Double_t bin_vol(0);
-        _grid.generatePoint(box, x, bin, bin_vol, _genType == QuasiRandom ? kTRUE : kFALSE);
-        // evaluate the integrand at the generated point
-        Double_t fval= jacbin*bin_vol*integrand(x);
+        Double_t fval(0);
+        if (realBinding) {
+          // take the point and the value of the integrand from the batch
+          std::copy(_batchBins.begin() + iPoint * dim, _batchBins.begin() + (iPoint + 1) * dim, bin);
+          fval= jacbin*_batchBinVolumes[iPoint]*_batchValues[iPoint];
+          ++iPoint;
+        } else {
+          // generate a random point in this box
+          Double_t bin_vol(0);
+          _grid.generatePoint(box, x, bin, bin_vol, _genType == QuasiRandom ? kTRUE : kFALSE);
+          // evaluate the integrand at the generated point
+          fval= jacbin*bin_vol*integrand(x);
+        }
         // update mean and variance calculations
         Double_t d = fval - m;
         m+= d / (k + 1.0);
@@ -373,3 +399,52 @@ Double_t RooMCIntegrator::vegas(Stage stage, UInt_t calls, UInt_t iterations, Do
   if(absError) *absError = cum_sig;
   return cum_int;
 }
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Generate the points of all boxes of one iteration in the same order as vegas() does
+/// when evaluating the integrand point by point, and evaluate the integrand for all of
+/// them at once. The bins, bin volumes and integrand values of the points are stored
+/// in the batch workspace. `box`, `bin` and `x` are scratch arrays of size of the grid
+/// dimension.
+
+void RooMCIntegrator::generateAndEvaluatePoints(const RooRealBinding& binding, UInt_t box[], UInt_t bin[], Double_t x[])
+{
+  const UInt_t dim = _grid.getDimension();
+  _batchCoordinates.resize(dim);
+  for (auto& coordinates : _batchCoordinates) {
+    coordinates.clear();
+  }
+  _batchBins.clear();
+  _batchBinVolumes.clear();
+
+  _grid.firstBox(box);
+  do {
+    for (UInt_t k = 0; k < _calls_per_box; k++) {
+      Double_t bin_vol(0);
+      _grid.generatePoint(box, x, bin, bin_vol, _genType == QuasiRandom ? kTRUE : kFALSE);
+      for (UInt_t i = 0; i < dim; ++i) {
+        _batchCoordinates[i].push_back(x[i]);
+      }
+      _batchBins.insert(_batchBins.end(), bin, bin + dim);
+      _batchBinVolumes.push_back(bin_vol);
+    }
+  } while (_grid.nextBox(box));
+
+  const std::size_t nPoints = _batchBinVolumes.size();
+  std::vector<RooSpan<const double>> coordinates(_batchCoordinates.begin(), _batchCoordinates.end());
+  auto results = binding.getValues(coordinates);
+  if (results.size() == nPoints) {
+    _batchValues.assign(results.begin(), results.end());
+  } else {
+    // The batch evaluation failed, e.g. because of invalid parameters. Evaluate point by point.
+    _batchValues.resize(nPoints);
+    for (std::size_t iPoint = 0; iPoint < nPoints; ++iPoint) {
+      for (UInt_t i = 0; i < dim; ++i) {
+        x[i] = _batchCoordinates[i][iPoint];
+      }
+      _batchValues[iPoint] = integrand(x);
+    }
+  }
+}
@@ -42,6 +42,11 @@ extra steps in the cycle. Output of these modules can be stored
 alongside the fit results in the aggregate results dataset.
 These study modules should derive from the class RooAbsMCStudyModule.
 
+The samples of generateAndFit() can be generated and fitted by several worker
+processes in parallel, see setNumWorkers(). Each worker works on a copy of the
+models, generates its samples with an own seed of the random generator, and
+the results of the workers are merged into the results of the study.
+
 Check the RooFit tutorials
 - rf801_mcstudy.C
 - rf802_mcstudy_addons.C
@@ -77,6 +82,16 @@ for usage examples.
 #include "RooMsgService.h"
 #include "RooProdPdf.h"
 
+#include "RConfig.h" // for R__WIN32
+#include "TMath.h"
+#ifndef R__WIN32
+#include "ROOT/TProcessExecutor.hxx"
+#endif
+
+#include <algorithm>
+#include <utility>
+#include <vector>
+
 using namespace std ;
 
 ClassImp(RooMCStudy);
@@ -160,6 +175,7 @@ RooMCStudy::RooMCStudy(const RooAbsPdf& model, const RooArgSet& observables,
 
   // Decode command line arguments
   _silence = pc.getInt("silence") ;
+  _nWorkers = 1 ;
   _verboseGen = pc.getInt("verboseGen") ;
   _extendedGen = pc.getInt("extendedGen") ;
   _binGenData = pc.getInt("binGenData") ;
@@ -346,7 +362,8 @@ RooMCStudy::RooMCStudy(const RooAbsPdf& genModel, const RooAbsPdf& fitModel,
   _fitOptions(fitOptions),
   _canAddFitResults(kTRUE),
   _perExptGenParams(0),
-  _silence(kFALSE)
+  _silence(kFALSE),
+  _nWorkers(1)
 {
   // Decode generator options
   TString genOpt(genOptions) ;
@@ -663,12 +680,116 @@ Bool_t RooMCStudy::generateAndFit(Int_t nSamples, Int_t nEvtPerSample, Bool_t ke
   _fitResList.Delete() ; // even though the fit results are owned by gROOT, we still want to scratch them here.
   _genDataList.Delete() ;
   _fitParData->reset() ;
+
+  if (_nWorkers > 1 && nSamples > 1) {
+    if (asciiFilePat && *asciiFilePat) {
+      oocoutW(_fitModel,Generation) << "RooMCStudy::generateAndFit: writing the samples to ASCII files is not supported"
+				    << " by the parallel run, running in a single process" << endl ;
+    } else {
+      return runParallel(nSamples,nEvtPerSample,keepGenData) ;
+    }
+  }
   
   return run(kTRUE,kTRUE,nSamples,nEvtPerSample,keepGenData,asciiFilePat) ;
 }
 
 
 
+////////////////////////////////////////////////////////////////////////////////
+/// Generate and fit 'nSamples' samples of 'nEvtPerSample' events in several
+/// worker processes. The samples are split evenly over the workers, which are
+/// forked from the current process, so that each of them works on its own copy
+/// of the models. Each worker seeds the random generator with a number drawn
+/// from the random generator of this process, so that the study is reproducible.
+///
+/// The fit parameters, fit results and (if keepGenData is set) the generated samples
+/// of the workers are merged in the order of the workers. The study modules run in
+/// the workers, and their results are merged with the fit parameters.
+
+Bool_t RooMCStudy::runParallel(Int_t nSamples, Int_t nEvtPerSample, Bool_t keepGenData)
+{
+#ifdef R__WIN32
+  oocoutW(_fitModel,Generation) << "RooMCStudy::runParallel: parallel runs with several processes are not supported"
+				<< " on Windows, running in a single process" << endl ;
+  return run(kTRUE,kTRUE,nSamples,nEvtPerSample,keepGenData,nullptr) ;
+#else
+  const unsigned int nWorkers = std::min<unsigned int>(_nWorkers, nSamples) ;
+
+  // Split the samples over the workers, and give each of them a seed for the random generator
+  std::vector<std::pair<Int_t,UInt_t>> tasks ;
+  for (unsigned int i = 0 ; i < nWorkers ; ++i) {
+    const Int_t nSamplesWorker = nSamples / nWorkers + (i < nSamples % nWorkers ? 1 : 0) ;
+    tasks.emplace_back(nSamplesWorker, RooRandom::randomGenerator()->Integer(TMath::Limits<UInt_t>::Max())) ;
+  }
+
+  oocoutP(_fitModel,Generation) << "RooMCStudy::runParallel: generating and fitting " << nSamples
+				<< " samples in " << nWorkers << " processes" << endl ;
+
+  // Each worker returns its fit parameters, its generator parameters (if any),
+  // and then its fit results and generated samples.
+  ROOT::TProcessExecutor executor(nWorkers) ;
+  auto workerResults = executor.Map([this,nEvtPerSample,keepGenData](const std::pair<Int_t,UInt_t>& task) {
+    RooRandom::randomGenerator()->SetSeed(task.second) ;
+    run(kTRUE,kTRUE,task.first,nEvtPerSample,keepGenData,nullptr) ;
+
+    auto result = new TList ;
+    result->Add(_fitParData) ;
+    if (_genParData) result->Add(_genParData) ;
+    for (auto fitResult : _fitResList) result->Add(fitResult) ;
+    for (auto genData : _genDataList) result->Add(genData) ;
+    return result ;
+  }, tasks) ;
+
+  // Merge the results of the workers
+  Bool_t first = kTRUE ;
+  for (TList* result : workerResults) {
+    if (!result || result->GetSize() < (_genParData ? 2 : 1)) {
+      oocoutE(_fitModel,Generation) << "RooMCStudy::runParallel: ERROR, a worker didn't return any results" << endl ;
+      delete result ;
+      continue ;
+    }
+
+    auto fitParData = static_cast<RooDataSet*>(result->At(0)) ;
+    auto genParData = _genParData ? static_cast<RooDataSet*>(result->At(1)) : nullptr ;
+    if (first) {
+      delete _fitParData ;
+      _fitParData = fitParData ;
+      if (genParData) {
+        delete _genParData ;
+        _genParData = genParData ;
+      }
+      first = kFALSE ;
+    } else {
+      _fitParData->append(*fitParData) ;
+      delete fitParData ;
+      if (genParData) {
+        _genParData->append(*genParData) ;
+        delete genParData ;
+      }
+    }
+
+    for (Int_t i = _genParData ? 2 : 1 ; i < result->GetSize() ; ++i) {
+      TObject* obj = result->At(i) ;
+      if (dynamic_cast<RooFitResult*>(obj)) {
+        _fitResList.Add(obj) ;
+      } else {
+        _genDataList.Add(obj) ;
+      }
+    }
+
+    // The objects in the list are now owned by this study
+    result->Clear("nodelete") ;
+    delete result ;
+  }
+
+  _canAddFitResults = kFALSE ;
+
+  return kFALSE ;
+#endif
+}
+
+
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Generate 'nSamples' samples of 'nEvtPerSample' events.
 /// If keepGenData is set, all generated data sets will be kept in memory 
@@ -29,7 +29,9 @@ with the same contents and reports to the owner if the present nset/iset
 is truely different from the current reference. Class RooNormSet only
 evaluates each RooArgSet pointer once, it therefore assumes that
 RooArgSets with normalization and/or integration sets are not changes
-during their lifetime. 
+during their lifetime. The sets are identified by their unique IDs, so a
+set that is deleted and replaced by another one at the same address is not
+taken for the deleted one.
 **/
 #include "RooFit.h"
 
@@ -79,10 +81,9 @@ void RooNormSetCache::clear()
 
 void RooNormSetCache::add(const RooArgSet* set1, const RooArgSet* set2)
 {
-  const Pair pair(set1, set2);
+  const Pair pair = makePair(set1, set2);
   PairIdxMapType::iterator it = _pairToIdx.lower_bound(pair);
-  if (_pairToIdx.end() != it && !PairCmp()(it->first, pair) &&
-      !PairCmp()(pair, it->first)) {
+  if (_pairToIdx.end() != it && it->first == pair) {
     // not empty, and keys match - nothing to do
     return;
   }
@@ -105,6 +106,28 @@ void RooNormSetCache::add(const RooArgSet* set1, const RooArgSet* set2)
   }
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Compute the names of the observables of self in set1 and set2 (or of all elements
+/// of the sets if self is null), as compared by autoCache(). A cache manager with several
+/// RooNormSetCache instances can compute them once and pass them to all instances.
+
+void RooNormSetCache::observableNames(const RooAbsArg* self, const RooArgSet* set1,
+	const RooArgSet* set2, std::string& name1, std::string& name2)
+{
+  using RooHelpers::getColonSeparatedNameString;
+
+  RooArgSet set1d, set2d ;
+  if (self) {
+    if (set1) self->getObservables(set1, set1d, kFALSE) ;
+    if (set2) self->getObservables(set2, set2d, kFALSE) ;
+    name1 = getColonSeparatedNameString(set1d) ;
+    name2 = getColonSeparatedNameString(set2d) ;
+  } else {
+    name1 = set1 ? getColonSeparatedNameString(*set1) : std::string() ;
+    name2 = set2 ? getColonSeparatedNameString(*set2) : std::string() ;
+  }
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// If RooArgSets set1 and set2 or sets with similar contents have
 /// been seen by this cache manager before return kFALSE If not,
@@ -114,57 +137,43 @@ void RooNormSetCache::add(const RooArgSet* set1, const RooArgSet* set2)
 Bool_t RooNormSetCache::autoCache(const RooAbsArg* self, const RooArgSet* set1,
 	const RooArgSet* set2, const TNamed* set2RangeName, Bool_t doRefill) 
 {
-
-  // Automated cache management function - Returns kTRUE if cache is invalidated
-  
   // A - Check if set1/2 are in cache and range name is identical
   if (set2RangeName == _set2RangeName && contains(set1,set2)) {
     return kFALSE ;
   }
 
-  // B - Check if dependents(set1/set2) are compatible with current cache
+  std::string name1, name2 ;
+  observableNames(self, set1, set2, name1, name2) ;
+  return autoCache(name1, name2, set1, set2, set2RangeName, doRefill) ;
+}
 
-//   cout << "RooNormSetCache::autoCache set1 = " << (set1?*set1:RooArgSet()) << " set2 = " << (set2?*set2:RooArgSet()) << endl;
-//   if (set1) set1->Print("v");
-//   if (set2) set2->Print("v");
-  //if (self) self->Print("v");
+////////////////////////////////////////////////////////////////////////////////
+/// Same as above, with the names of the observables in set1 and set2 computed
+/// beforehand by observableNames().
 
-  RooArgSet *set1d, *set2d ;
-  if (self) {
-    set1d = set1 ? self->getObservables(*set1,kFALSE) : new RooArgSet;
-    set2d = set2 ? self->getObservables(*set2,kFALSE) : new RooArgSet;
-  } else {
-    set1d = set1 ? (RooArgSet*)set1->snapshot() : new RooArgSet;
-    set2d = set2 ? (RooArgSet*)set2->snapshot() : new RooArgSet;
+Bool_t RooNormSetCache::autoCache(const std::string& name1, const std::string& name2,
+	const RooArgSet* set1, const RooArgSet* set2, const TNamed* set2RangeName, Bool_t doRefill)
+{
+  // A - Check if set1/2 are in cache and range name is identical
+  if (set2RangeName == _set2RangeName && contains(set1,set2)) {
+    return kFALSE ;
   }
 
-//   cout << "RooNormSetCache::autoCache set1d = " << *set1d << " set2 = " << *set2d << endl;
-
-  using RooHelpers::getColonSeparatedNameString;
-
-  if (   getColonSeparatedNameString(*set1d) == _name1
-      && getColonSeparatedNameString(*set2d) == _name2
-      && _set2RangeName == set2RangeName) {
+  // B - Check if dependents(set1/set2) are compatible with current cache
+  if (name1 == _name1 && name2 == _name2 && _set2RangeName == set2RangeName) {
     // Compatible - Add current set1/2 to cache
     add(set1,set2);
-
-    delete set1d;
-    delete set2d;
     return kFALSE;
   }
-  
+
   // C - Reset cache and refill with current state
   if (doRefill) {
     clear();
     add(set1,set2);
-    _name1 = getColonSeparatedNameString(*set1d);
-    _name2 = getColonSeparatedNameString(*set2d);
-//     cout << "RooNormSetCache::autoCache() _name1 refilled from " << *set1d << " to " ; _name1.printValue(cout) ; cout << endl;
-//     cout << "RooNormSetCache::autoCache() _name2 refilled from " << *set2d << " to " ; _name2.printValue(cout) ; cout << endl;
+    _name1 = name1;
+    _name2 = name2;
     _set2RangeName = (TNamed*) set2RangeName;
   }
-  
-  delete set1d;
-  delete set2d;
+
   return kTRUE;
 }
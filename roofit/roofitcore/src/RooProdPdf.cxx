@@ -60,11 +60,14 @@ have to appear in any specific place in the list.
 #include "RooTrace.h"
 #include "RooBatchCompute.h"
 #include "RooHelpers.h"
+#include "RooFit/Detail/CodeSquashContext.h"
 #include "strtok.h"
 
 #include <cstring>
 #include <sstream>
 #include <algorithm>
+#include <memory>
+#include <stdexcept>
 
 #ifndef _WIN32
 #include <strings.h>
@@ -1871,6 +1874,45 @@ Double_t RooProdPdf::expectedEvents(const RooArgSet* nset) const
 
 
 
+////////////////////////////////////////////////////////////////////////////////
+/// Translate the product into C++ code, for the analytic gradients of
+/// RooFuncWrapper. Only products that factorize are supported, i.e. the
+/// components must depend on disjoint sets of observables and must not be
+/// conditional. The normalized product is then the product of the normalized
+/// components.
+
+void RooProdPdf::translate(RooFit::Detail::CodeSquashContext &ctx) const
+{
+  std::string product;
+  RooArgSet allObs;
+  for (Int_t i = 0; i < _pdfList.getSize(); ++i) {
+    auto &pdf = static_cast<RooAbsPdf &>(_pdfList[i]);
+    auto *nset = static_cast<RooArgSet *>(_pdfNSetList.At(i));
+    std::unique_ptr<RooArgSet> obs{pdf.getObservables(ctx.observables())};
+    if ((nset && !nset->empty()) || obs->empty() || allObs.overlaps(*obs)) {
+      throw std::runtime_error(std::string("RooProdPdf::translate(") + GetName()
+                               + "): only products of pdfs of disjoint observables are supported.");
+    }
+    allObs.add(*obs);
+    product += (i > 0 ? " * " : "") + ctx.getNormalizedResult(pdf);
+  }
+  ctx.addResult(this, product, true);
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return C++ code for the expected number of events, which is the one of the extended component.
+
+std::string RooProdPdf::buildCallToExpectedEvents(RooFit::Detail::CodeSquashContext &ctx) const
+{
+  if (_extendedIndex < 0) {
+    return RooAbsPdf::buildCallToExpectedEvents(ctx);
+  }
+  return static_cast<RooAbsPdf &>(_pdfList[_extendedIndex]).buildCallToExpectedEvents(ctx);
+}
+
+
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Return generator context optimized for generating events from product p.d.f.s
 
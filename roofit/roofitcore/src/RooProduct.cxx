@@ -31,9 +31,12 @@ A RooProduct represents the product of a given set of RooAbsReal objects.
 #include "RooMsgService.h"
 #include "RunContext.h"
 #include "RooTrace.h"
+#include "RooFit/Detail/CodeSquashContext.h"
 
 #include <cmath>
 #include <memory>
+#include <stdexcept>
+#include <string>
 
 using namespace std ;
 
@@ -384,6 +387,23 @@ Double_t RooProduct::evaluate() const
 }
 
 
+////////////////////////////////////////////////////////////////////////////////
+/// Translate the product into C++ code, for the analytic gradients of RooFuncWrapper.
+/// Only products of real-valued terms are supported.
+
+void RooProduct::translate(RooFit::Detail::CodeSquashContext &ctx) const
+{
+  if (!_compCSet.empty()) {
+    throw std::runtime_error(std::string("RooProduct::translate(") + GetName() + "): category terms are not supported.");
+  }
+  std::string product = "1.0";
+  for (const auto item : _compRSet) {
+    product += " * " + ctx.getResult(*item);
+  }
+  ctx.addResult(this, product);
+}
+
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Evaluate product of input functions for all points found in `evalData`.
 RooSpan<double> RooProduct::evaluateSpan(RooBatchCompute::RunContext& evalData, const RooArgSet* normSet) const {
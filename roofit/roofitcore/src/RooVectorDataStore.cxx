@@ -49,6 +49,9 @@ which returns spans pointing directly to the data.
 #include "TBuffer.h"
 
 #include <iomanip>
+#include <limits>
+#include <stdexcept>
+#include <string>
 using namespace std;
 
 ClassImp(RooVectorDataStore);
@@ -604,13 +607,36 @@ void RooVectorDataStore::loadValues(const RooAbsDataStore *ads, const RooFormula
    ranges = ROOT::Split(rangeName, ",");
   }
 
+  // If the source stores its values in columns, evaluate the cut for all events at once.
+  // As long as category states cannot be passed in the RunContext, cuts on categories
+  // are evaluated event by event.
+  std::vector<double> cutValues;
+  if (selectClone && VDS && nevent > nStart) {
+    std::unique_ptr<RooArgSet> cutVars(selectClone->getVariables());
+    const bool dependsOnCategory = std::any_of(cutVars->begin(), cutVars->end(), [](const RooAbsArg* arg) {
+      return dynamic_cast<const RooAbsCategory*>(arg) != nullptr; });
+    if (!dependsOnCategory) {
+      auto evalData = VDS->getBatches(nStart, nevent - nStart);
+      auto results = selectClone->getValues(evalData);
+      if (results.size() == nevent - nStart) {
+        cutValues.assign(results.begin(), results.end());
+      }
+    }
+  }
+
   reserve(numEntries() + (nevent - nStart));
   for(auto i=nStart; i < nevent ; ++i) {
-    ads->get(i);
-
     // Does this event pass the cuts?
-    if (selectClone && selectClone->getVal()==0) {
-      continue ; 
+    if (!cutValues.empty()) {
+      if (cutValues[i - nStart] == 0) {
+        continue ;
+      }
+      ads->get(i);
+    } else {
+      ads->get(i);
+      if (selectClone && selectClone->getVal()==0) {
+        continue ; 
+      }
     }
 
     if (TDS) {
@@ -882,6 +908,82 @@ void RooVectorDataStore::append(RooAbsDataStore& other)
 
 
 
+////////////////////////////////////////////////////////////////////////////////
+/// Append a batch of events, given column by column, without loading them
+/// into the variables of the store one by one.
+/// \param[in] vars Variables of this store that the columns are filled into.
+/// These may include the weight variable.
+/// \param[in] values One column of values for each of the variables in `vars`.
+/// All columns must have the same size.
+///
+/// As in RooRealVar::setVal(), values outside of the range of a variable are
+/// clipped to the range. Variables of the store that are not in `vars`, e.g.
+/// categories, are filled with their current value for all new events.
+
+void RooVectorDataStore::appendEvents(const RooArgList& vars, const std::vector<RooSpan<const double>>& values)
+{
+  if (vars.size() != values.size()) {
+    throw std::invalid_argument(std::string("RooVectorDataStore::appendEvents(") + GetName() + "): "
+        + std::to_string(vars.size()) + " variables were passed, but " + std::to_string(values.size()) + " columns.");
+  }
+  if (values.empty()) return;
+
+  const std::size_t nEvents = values.front().size();
+  for (std::size_t i = 0; i < values.size(); ++i) {
+    if (values[i].size() != nEvents) {
+      throw std::invalid_argument(std::string("RooVectorDataStore::appendEvents(") + GetName() + "): the column for '"
+          + vars[i].GetName() + "' has " + std::to_string(values[i].size()) + " entries, but "
+          + std::to_string(nEvents) + " were expected.");
+    }
+    if (!_varsww.find(vars[i])) {
+      throw std::invalid_argument(std::string("RooVectorDataStore::appendEvents(") + GetName() + "): '"
+          + vars[i].GetName() + "' is not a variable of this store.");
+    }
+  }
+
+  // Find the column of a variable, and the range that its values are clipped to
+  auto findColumn = [&](const RooAbsReal* real, double& lo, double& hi) -> const RooSpan<const double>* {
+    const Int_t idx = vars.index(real->GetName());
+    if (idx < 0) return nullptr;
+    auto realVar = dynamic_cast<const RooRealVar*>(real);
+    lo = realVar ? realVar->getMin() : -std::numeric_limits<double>::infinity();
+    hi = realVar ? realVar->getMax() : std::numeric_limits<double>::infinity();
+    return &values[idx];
+  };
+
+  reserve(numEntries() + nEvents);
+  double lo, hi;
+  for (auto realVec : _realStoreList) {
+    if (auto column = findColumn(realVec->_nativeReal, lo, hi)) realVec->append(*column, lo, hi);
+    else realVec->fill(nEvents);
+  }
+  for (auto fullVec : _realfStoreList) {
+    if (auto column = findColumn(fullVec->_nativeReal, lo, hi)) fullVec->append(*column, lo, hi);
+    else fullVec->fill(nEvents);
+  }
+  for (auto catVec : _catStoreList) {
+    catVec->fill(nEvents);
+  }
+
+  // use Kahan's algorithm to sum up weights to avoid loss of precision
+  auto addWeight = [this](double weight) {
+    Double_t y = weight - _sumWeightCarry;
+    Double_t t = _sumWeight + y;
+    _sumWeightCarry = (t - _sumWeight) - y;
+    _sumWeight = t;
+  };
+  const RooSpan<const double>* weights = _wgtVar ? findColumn(_wgtVar, lo, hi) : nullptr;
+  if (weights) {
+    for (std::size_t i = 0; i < nEvents; ++i) {
+      addWeight(std::min(std::max((*weights)[i], lo), hi));
+    }
+  } else {
+    addWeight(nEvents * (_wgtVar ? _wgtVar->getVal() : 1.));
+  }
+}
+
+
+
 ////////////////////////////////////////////////////////////////////////////////
 
 void RooVectorDataStore::reset() 
@@ -77,8 +77,10 @@ and try reading again.
 #include "ROOT/StringUtils.hxx"
 
 #include <map>
+#include <set>
 #include <sstream>
 #include <string>
+#include <unordered_set>
 #include <iostream>
 #include <fstream>
 #include <cstring>
@@ -641,18 +643,20 @@ Bool_t RooWorkspace::import(const RooAbsArg& inArg,
 
   RooArgSet recycledNodes ;
   RooArgSet nodesToBeDeleted ;
+  std::set<TClass*> checkedClasses ;
+  std::map<RooExpensiveObjectCache*, std::set<std::string>> cacheOwners ;
   for (const auto node : *cloneSet2) {
-    if (_autoClass) {
+    if (_autoClass && checkedClasses.insert(node->IsA()).second) {
       if (!_classes.autoImportClass(node->IsA())) {
         coutW(ObjectHandling) << "RooWorkspace::import(" << GetName() << ") WARNING: problems import class code of object "
             << node->IsA()->GetName() << "::" << node->GetName() << ", reading of workspace will require external definition of class" << endl ;
       }
     }
 
-    // Point expensiveObjectCache to copy in this workspace
-    RooExpensiveObjectCache& oldCache = node->expensiveObjectCache() ;
+    // Point expensiveObjectCache to copy in this workspace. The cache objects are imported
+    // below, with one pass over each of the original caches.
+    cacheOwners[&node->expensiveObjectCache()].insert(node->GetName()) ;
     node->setExpensiveObjectCache(_eocache) ;
-    _eocache.importCacheObjects(oldCache,node->GetName(),kTRUE) ;
 
     // Check if node is already in workspace (can only happen for variables or identical instances, unless RecycleConflictNodes is specified)
     RooAbsArg* wsnode = _allOwnedNodes.find(node->GetName()) ;
@@ -691,6 +695,10 @@ Bool_t RooWorkspace::import(const RooAbsArg& inArg,
     }
   }
 
+  for (auto& cacheAndOwners : cacheOwners) {
+    _eocache.importCacheObjects(*cacheAndOwners.first,cacheAndOwners.second,kTRUE) ;
+  }
+
   // Release working copy
   // no need to do a safe list erase since it was generated from a snapshot
   // just take ownership and delte elements by hand
@@ -2623,6 +2631,11 @@ void RooWorkspace::Streamer(TBuffer &R__b)
 
      map<RooAbsArg*,vector<RooAbsArg *> > extClients, extValueClients, extShapeClients ;
 
+     // Look up the nodes of the workspace in a hash set, a linear search in _allOwnedNodes for every
+     // client would make writing large workspaces quadratic in the number of nodes
+     const std::unordered_set<const RooAbsArg*> ownedNodes(_allOwnedNodes.begin(), _allOwnedNodes.end()) ;
+     auto isOwned = [&ownedNodes](const RooAbsArg* arg) { return ownedNodes.count(arg) > 0 ; } ;
+
      TIterator* iter = _allOwnedNodes.createIterator() ;
      RooAbsArg* tmparg ;
      while((tmparg=(RooAbsArg*)iter->Next())) {
@@ -2630,7 +2643,7 @@ void RooWorkspace::Streamer(TBuffer &R__b)
        // Loop over client list of this arg
        std::vector<RooAbsArg *> clientsTmp{tmparg->_clientList.begin(), tmparg->_clientList.end()};
        for (auto client : clientsTmp) {
-         if (!_allOwnedNodes.containsInstance(*client)) {
+         if (!isOwned(client)) {
 
            const auto refCount = tmparg->_clientList.refCount(client);
            auto& bufferVec = extClients[tmparg];
@@ -2643,7 +2656,7 @@ void RooWorkspace::Streamer(TBuffer &R__b)
        // Loop over value client list of this arg
        clientsTmp.assign(tmparg->_clientListValue.begin(), tmparg->_clientListValue.end());
        for (auto vclient : clientsTmp) {
-         if (!_allOwnedNodes.containsInstance(*vclient)) {
+         if (!isOwned(vclient)) {
            cxcoutD(ObjectHandling) << "RooWorkspace::Streamer(" << GetName() << ") element " << tmparg->GetName()
 				       << " has external value client link to " << vclient << " (" << vclient->GetName() << ") with ref count " << tmparg->_clientListValue.refCount(vclient) << endl ;
 
@@ -2658,7 +2671,7 @@ void RooWorkspace::Streamer(TBuffer &R__b)
        // Loop over shape client list of this arg
        clientsTmp.assign(tmparg->_clientListShape.begin(), tmparg->_clientListShape.end());
        for (auto sclient : clientsTmp) {
-         if (!_allOwnedNodes.containsInstance(*sclient)) {
+         if (!isOwned(sclient)) {
            cxcoutD(ObjectHandling) << "RooWorkspace::Streamer(" << GetName() << ") element " << tmparg->GetName()
 				         << " has external shape client link to " << sclient << " (" << sclient->GetName() << ") with ref count " << tmparg->_clientListShape.refCount(sclient) << endl ;
 
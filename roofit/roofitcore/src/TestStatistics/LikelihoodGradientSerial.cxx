@@ -0,0 +1,89 @@
+/*****************************************************************************
+ * RooFit
+ * Authors:                                                                  *
+ *   WV, Wouter Verkerke, UC Santa Barbara, verkerke@slac.stanford.edu       *
+ *   DK, David Kirkby,    UC Irvine,         dkirkby@uci.edu                 *
+ *                                                                           *
+ * Copyright (c) 2000-2021, Regents of the University of California          *
+ *                          and Stanford University. All rights reserved.    *
+ *                                                                           *
+ * Redistribution and use in source and binary forms,                        *
+ * with or without modification, are permitted according to the terms        *
+ * listed in LICENSE (http://roofit.sourceforge.net/license.txt)             *
+ *****************************************************************************/
+
+#include <TestStatistics/LikelihoodGradientSerial.h>
+#include <TestStatistics/MinuitFcnGrad.h> // WrapperCalculationCleanFlags
+#include "RooMinimizer.h"
+
+#include "Fit/Fitter.h"
+#include "Minuit2/MnStrategy.h"
+
+namespace RooFit {
+namespace TestStatistics {
+
+/** \class LikelihoodGradientSerial
+ * \brief Serial likelihood gradient calculation strategy implementation
+ *
+ * This class computes the gradient with the numerical derivatives of ROOT::Minuit2::NumericalDerivator, in the same
+ * way as Minuit2 itself and RooGradMinimizerFcn do, in the Minuit-internal parameter space. The partial derivatives
+ * are computed one after the other, because they shift the values of the parameters, which are shared by the whole
+ * likelihood. The likelihood is evaluated through the minimizer, i.e. with the LikelihoodWrapper it was created with,
+ * so that combined with LikelihoodJob each of these evaluations is distributed over the threads.
+ *
+ * \note The class is not intended for use by end-users. We recommend to either use RooMinimizer with a RooAbsL derived
+ * likelihood object, or to use a higher level entry point like RooAbsPdf::fitTo() or RooAbsPdf::createNLL().
+ */
+
+LikelihoodGradientSerial::LikelihoodGradientSerial(std::shared_ptr<RooAbsL> likelihood,
+                                                   std::shared_ptr<WrapperCalculationCleanFlags> calculation_is_clean,
+                                                   std::size_t N_dim, RooMinimizer *minimizer)
+   : LikelihoodGradientWrapper(std::move(likelihood), std::move(calculation_is_clean), N_dim, minimizer), grad_(N_dim),
+     minuit_internal_x_(N_dim, 0)
+{
+}
+
+void LikelihoodGradientSerial::synchronizeWithMinimizer(const ROOT::Math::MinimizerOptions &options)
+{
+   ROOT::Minuit2::MnStrategy strategy(static_cast<unsigned int>(options.Strategy()));
+   gradf_.SetStepTolerance(strategy.GradientStepTolerance());
+   gradf_.SetGradTolerance(strategy.GradientTolerance());
+   gradf_.SetNCycles(strategy.GradientNCycles());
+   gradf_.SetErrorLevel(options.ErrorDef());
+}
+
+void LikelihoodGradientSerial::synchronizeParameterSettings(
+   ROOT::Math::IMultiGenFunction *function, const std::vector<ROOT::Fit::ParameterSettings> &parameter_settings)
+{
+   gradf_.SetInitialGradient(function, parameter_settings, grad_);
+}
+
+void LikelihoodGradientSerial::updateMinuitInternalParameterValues(const std::vector<double> &minuit_internal_x)
+{
+   minuit_internal_x_ = minuit_internal_x;
+}
+
+void LikelihoodGradientSerial::fillGradient(double *grad)
+{
+   if (!calculation_is_clean_->gradient) {
+      calculateGradient();
+      calculation_is_clean_->gradient = true;
+   }
+   for (std::size_t ix = 0; ix < grad_.size(); ++ix) {
+      grad[ix] = grad_[ix].derivative;
+   }
+}
+
+void LikelihoodGradientSerial::calculateGradient()
+{
+   auto function = minimizer_->getMultiGenFcn();
+   const auto &parameter_settings = minimizer_->fitter()->Config().ParamsSettings();
+
+   gradf_.SetupDifferentiate(function, minuit_internal_x_.data(), parameter_settings);
+   for (std::size_t ix = 0; ix < grad_.size(); ++ix) {
+      grad_[ix] = gradf_.FastPartialDerivative(function, parameter_settings, ix, grad_[ix]);
+   }
+}
+
+} // namespace TestStatistics
+} // namespace RooFit
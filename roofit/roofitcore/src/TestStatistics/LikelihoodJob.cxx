@@ -0,0 +1,214 @@
+/*****************************************************************************
+ * RooFit
+ * Authors:                                                                  *
+ *   WV, Wouter Verkerke, UC Santa Barbara, verkerke@slac.stanford.edu       *
+ *   DK, David Kirkby,    UC Irvine,         dkirkby@uci.edu                 *
+ *                                                                           *
+ * Copyright (c) 2000-2021, Regents of the University of California          *
+ *                          and Stanford University. All rights reserved.    *
+ *                                                                           *
+ * Redistribution and use in source and binary forms,                        *
+ * with or without modification, are permitted according to the terms        *
+ * listed in LICENSE (http://roofit.sourceforge.net/license.txt)             *
+ *****************************************************************************/
+
+#include <TestStatistics/LikelihoodJob.h>
+#include <TestStatistics/RooAbsL.h>
+#include <TestStatistics/RooUnbinnedL.h>
+#include <TestStatistics/RooBinnedL.h>
+#include <TestStatistics/RooSubsidiaryL.h>
+#include <TestStatistics/RooSumL.h>
+#include "RooAbsReal.h"
+
+#include "RConfigure.h" // for R__USE_IMT
+#ifdef R__USE_IMT
+#include "ROOT/TThreadExecutor.hxx"
+#include "TROOT.h"
+#endif
+
+#include <algorithm> // std::min, std::max, std::stable_sort
+#include <numeric>   // std::iota
+#include <stdexcept> // std::logic_error
+
+namespace RooFit {
+namespace TestStatistics {
+
+/** \class LikelihoodJob
+ * \brief Likelihood calculation strategy that evaluates parts of the likelihood concurrently in threads
+ *
+ * The likelihood is split into tasks, which the implicit multi-threading thread pool evaluates concurrently:
+ * - a RooSumL is split into its components, e.g. the channels of a simultaneous fit and the subsidiary (constraint)
+ *   component. Each component has its own clone of the pdf and the dataset, so the components only share the
+ *   parameters, which are not modified during the evaluation.
+ * - a RooUnbinnedL is split into sections of its events, at most one per worker and at least min_events_per_task
+ *   events each. Each section beyond the first is evaluated by a copy of the likelihood, i.e. with its own pdf and
+ *   dataset clone.
+ * - a RooBinnedL is evaluated in one task.
+ *
+ * The most expensive tasks, estimated by their number of data entries, are handed out first, and the workers pick up
+ * the next task as soon as they are done with the previous one, which balances the load when the components differ
+ * in size. The results of the tasks are summed in a fixed order, so the result does not depend on the scheduling.
+ * Without implicit multi-threading (see ROOT::EnableImplicitMT) the tasks are evaluated one after the other.
+ *
+ * The first evaluation, which creates the caches of the pdfs (e.g. normalization integrals), is done serially. When
+ * errors are logged in the evaluation (see RooAbsReal::evalErrorLoggingMode), they are counted in the concurrent
+ * evaluation; if there are any, the likelihood is evaluated again serially to collect them.
+ *
+ * This strategy replaces the process based parallelism of RooRealMPFE for likelihoods in the
+ * RooFit::TestStatistics framework. It can be used in RooMinimizer in combination with any gradient calculation
+ * strategy, e.g. LikelihoodGradientSerial, whose numerical derivatives then use the concurrent evaluation.
+ *
+ * \note The class is not intended for use by end-users. We recommend to either use RooMinimizer with a RooAbsL derived
+ * likelihood object, or to use a higher level entry point like RooAbsPdf::fitTo() or RooAbsPdf::createNLL().
+ */
+
+/// \param[in] likelihood Shared pointer to the likelihood that must be evaluated
+/// \param[in] calculation_is_clean Shared pointer to the object that keeps track of what has been evaluated for the
+/// current parameter set provided by Minuit.
+/// \param[in] n_workers Number of threads that evaluate the likelihood concurrently. The default, 0, uses the size of
+/// the implicit multi-threading thread pool.
+LikelihoodJob::LikelihoodJob(std::shared_ptr<RooAbsL> likelihood,
+                             std::shared_ptr<WrapperCalculationCleanFlags> calculation_is_clean, unsigned int n_workers)
+   : LikelihoodWrapper(std::move(likelihood), std::move(calculation_is_clean)), n_workers_(n_workers)
+{
+   if (n_workers_ == 0) {
+#ifdef R__USE_IMT
+      n_workers_ = ROOT::IsImplicitMTEnabled() ? std::max(ROOT::GetThreadPoolSize(), 1u) : 1;
+#else
+      n_workers_ = 1;
+#endif
+   }
+
+   // determine likelihood type
+   if (dynamic_cast<RooUnbinnedL *>(likelihood_.get()) != nullptr) {
+      likelihood_type = LikelihoodType::unbinned;
+   } else if (dynamic_cast<RooBinnedL *>(likelihood_.get()) != nullptr) {
+      likelihood_type = LikelihoodType::binned;
+   } else if (dynamic_cast<RooSumL *>(likelihood_.get()) != nullptr) {
+      likelihood_type = LikelihoodType::sum;
+   } else if (dynamic_cast<RooSubsidiaryL *>(likelihood_.get()) != nullptr) {
+      likelihood_type = LikelihoodType::subsidiary;
+   } else {
+      throw std::logic_error("in LikelihoodJob constructor: _likelihood is not of a valid subclass!");
+   }
+
+   initTasks();
+}
+
+/// Split the likelihood into tasks and determine the order in which they are handed to the workers.
+void LikelihoodJob::initTasks()
+{
+   tasks_.clear();
+   section_likelihoods_.clear();
+
+   switch (likelihood_type) {
+   case LikelihoodType::unbinned: {
+      std::size_t n_sections = std::min<std::size_t>(n_workers_, likelihood_->getNEvents() / min_events_per_task);
+      n_sections = std::max<std::size_t>(n_sections, 1);
+      for (std::size_t ix = 0; ix < n_sections; ++ix) {
+         RooAbsL *section_likelihood = likelihood_.get();
+         if (ix > 0) {
+            section_likelihoods_.emplace_back(
+               std::make_shared<RooUnbinnedL>(static_cast<const RooUnbinnedL &>(*likelihood_)));
+            section_likelihood = section_likelihoods_.back().get();
+         }
+         RooAbsL::Section events(static_cast<double>(ix) / n_sections,
+                                 ix + 1 == n_sections ? 1. : static_cast<double>(ix + 1) / n_sections);
+         tasks_.push_back({section_likelihood, events, 0, 0, likelihood_->getNEvents() / n_sections});
+      }
+      break;
+   }
+   case LikelihoodType::binned: {
+      tasks_.push_back({likelihood_.get(), {0, 1}, 0, 0, likelihood_->numDataEntries()});
+      break;
+   }
+   case LikelihoodType::sum: {
+      const auto &components = static_cast<RooSumL *>(likelihood_.get())->getComponents();
+      for (std::size_t ix = 0; ix < components.size(); ++ix) {
+         tasks_.push_back({likelihood_.get(), {0, 1}, ix, ix + 1, components[ix]->numDataEntries()});
+      }
+      break;
+   }
+   default: {
+      throw std::logic_error("in LikelihoodJob::initTasks: likelihood types other than binned, unbinned and simultaneous not yet implemented!");
+      break;
+   }
+   }
+
+   task_order_.resize(tasks_.size());
+   std::iota(task_order_.begin(), task_order_.end(), 0);
+   std::stable_sort(task_order_.begin(), task_order_.end(),
+                    [this](std::size_t a, std::size_t b) { return tasks_[a].n_entries > tasks_[b].n_entries; });
+}
+
+/// Forwards the constant term optimization also to the copies of the likelihood that evaluate the sections of events.
+void LikelihoodJob::constOptimizeTestStatistic(RooAbsArg::ConstOpCode opcode, bool doAlsoTrackingOpt)
+{
+   LikelihoodWrapper::constOptimizeTestStatistic(opcode, doAlsoTrackingOpt);
+   for (auto &section_likelihood : section_likelihoods_) {
+      section_likelihood->constOptimizeTestStatistic(opcode, doAlsoTrackingOpt);
+   }
+}
+
+void LikelihoodJob::setApplyWeightSquared(bool flag)
+{
+   LikelihoodWrapper::setApplyWeightSquared(flag);
+   for (auto &section_likelihood : section_likelihoods_) {
+      static_cast<RooUnbinnedL *>(section_likelihood.get())->setApplyWeightSquared(flag);
+   }
+}
+
+ROOT::Math::KahanSum<double> LikelihoodJob::evaluateTask(const Task &task) const
+{
+   return task.likelihood->evaluatePartition(task.events, task.components_begin, task.components_end);
+}
+
+void LikelihoodJob::evaluate()
+{
+   std::vector<ROOT::Math::KahanSum<double>> task_results(tasks_.size());
+
+   auto evaluateSerially = [&]() {
+      for (std::size_t ix = 0; ix < tasks_.size(); ++ix) {
+         task_results[ix] = evaluateTask(tasks_[ix]);
+      }
+   };
+
+#ifdef R__USE_IMT
+   if (!first_evaluation_ && n_workers_ > 1 && tasks_.size() > 1 && ROOT::IsImplicitMTEnabled()) {
+      // Collecting the evaluation errors is not thread safe, so only count them in the concurrent evaluation.
+      const auto logging_mode = RooAbsReal::evalErrorLoggingMode();
+      const bool count_errors = logging_mode == RooAbsReal::CollectErrors || logging_mode == RooAbsReal::PrintErrors;
+      if (count_errors) {
+         RooAbsReal::setEvalErrorLoggingMode(RooAbsReal::CountErrors);
+         RooAbsReal::clearEvalErrorLog();
+      }
+
+      ROOT::TThreadExecutor executor(n_workers_);
+      executor.Foreach([&](std::size_t ix) { task_results[task_order_[ix]] = evaluateTask(tasks_[task_order_[ix]]); },
+                       ROOT::TSeq<std::size_t>(task_order_.size()));
+
+      if (count_errors) {
+         const bool had_errors = RooAbsReal::numEvalErrors() > 0;
+         RooAbsReal::clearEvalErrorLog();
+         RooAbsReal::setEvalErrorLoggingMode(logging_mode);
+         if (had_errors) {
+            evaluateSerially();
+         }
+      }
+   } else
+#endif
+   {
+      evaluateSerially();
+   }
+   first_evaluation_ = false;
+
+   result = ROOT::Math::KahanSum<double>();
+   for (const auto &task_result : task_results) {
+      result += task_result;
+   }
+
+   result = applyOffsetting(result);
+}
+
+} // namespace TestStatistics
+} // namespace RooFit
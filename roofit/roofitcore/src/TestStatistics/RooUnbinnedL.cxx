@@ -34,7 +34,7 @@ In extended mode, a
 #include "RooAbsPdf.h"
 #include "RooAbsDataStore.h"
 #include "RooNLLVar.h"  // RooNLLVar::ComputeScalar
-#include "RunContext.h" // complete type BatchCompute::RunContext
+#include "RooFitDriver.h" // complete type RooFitDriver
 
 #include "Math/Util.h" // KahanSum
 
@@ -54,6 +54,9 @@ RooUnbinnedL::RooUnbinnedL(const RooUnbinnedL &other)
 {
 }
 
+// defined here, where RooFitDriver is a complete type
+RooUnbinnedL::~RooUnbinnedL() = default;
+
 //////////////////////////////////////////////////////////////////////////////////
 
 /// Returns true if value was changed, false otherwise.
@@ -90,15 +93,16 @@ RooUnbinnedL::evaluatePartition(Section events, std::size_t /*components_begin*/
    data_->store()->recalculateCache(nullptr, events.begin(N_events_), events.end(N_events_), 1, kTRUE);
 
    if (useBatchedEvaluations_) {
-      std::tie(result, sumWeight) = RooNLLVar::computeBatchedFunc(pdf_.get(), data_.get(), evalData_, normSet_.get(), apply_weight_squared,
+      std::tie(result, sumWeight) = RooNLLVar::computeBatchedFunc(pdf_.get(), data_.get(), driver_, normSet_.get(), apply_weight_squared,
                                                                   1, events.begin(N_events_), events.end(N_events_));
    } else {
       std::tie(result, sumWeight) = RooNLLVar::computeScalarFunc(pdf_.get(), data_.get(), normSet_.get(), apply_weight_squared,
                                                                  1, events.begin(N_events_), events.end(N_events_));
    }
 
-   // include the extended maximum likelihood term, if requested
-   if (extended_) {
+   // include the extended maximum likelihood term, if requested; it depends on the whole dataset, so when the events
+   // are split into sections, only the first section includes it
+   if (extended_ && events.begin_fraction == 0) {
       if (apply_weight_squared) {
 
          // TODO: the following should also be factored out into free/static functions like RooNLLVar::Compute*
@@ -107,7 +111,7 @@ RooUnbinnedL::evaluatePartition(Section events, std::size_t /*components_begin*/
          if (useBatchedEvaluations_) {
             const RooSpan<const double> eventWeights = data_->getWeightBatch(0, N_events_);
             if (eventWeights.empty()) {
-               sumW2 = (events.end(N_events_) - events.begin(N_events_)) * data_->weightSquared();
+               sumW2 = N_events_ * data_->weightSquared();
             } else {
                ROOT::Math::KahanSum<double, 4u> kahanWeight;
                for (std::size_t i = 0; i < eventWeights.size(); ++i) {
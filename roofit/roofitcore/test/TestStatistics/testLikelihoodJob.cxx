@@ -0,0 +1,182 @@
+/*****************************************************************************
+ * RooFit
+ * Authors:                                                                  *
+ *   WV, Wouter Verkerke, UC Santa Barbara, verkerke@slac.stanford.edu       *
+ *   DK, David Kirkby,    UC Irvine,         dkirkby@uci.edu                 *
+ *                                                                           *
+ * Copyright (c) 2000-2021, Regents of the University of California          *
+ *                          and Stanford University. All rights reserved.    *
+ *                                                                           *
+ * Redistribution and use in source and binary forms,                        *
+ * with or without modification, are permitted according to the terms        *
+ * listed in LICENSE (http://roofit.sourceforge.net/license.txt)             *
+ *****************************************************************************/
+
+#include <TestStatistics/LikelihoodJob.h>
+#include <TestStatistics/LikelihoodSerial.h>
+#include <TestStatistics/LikelihoodGradientSerial.h>
+
+#include <RooRandom.h>
+#include <RooWorkspace.h>
+#include <RooMinimizer.h>
+#include <RooFitResult.h>
+#include "RooDataHist.h" // complete type in BinnedConstrained test
+#include "RooCategory.h" // complete type in SimUnbinned test
+#include <TestStatistics/RooUnbinnedL.h>
+#include <TestStatistics/optional_parameter_types.h>
+#include <TestStatistics/buildLikelihood.h>
+
+#include "RConfigure.h" // R__USE_IMT
+#include "TROOT.h"      // EnableImplicitMT
+
+#include "Math/Util.h" // KahanSum
+
+#include "gtest/gtest.h"
+#include "../test_lib.h" // generate_1D_gaussian_pdf_nll
+
+class Environment : public testing::Environment {
+public:
+   void SetUp() override
+   {
+      RooMsgService::instance().setGlobalKillBelow(RooFit::ERROR);
+#ifdef R__USE_IMT
+      ROOT::EnableImplicitMT(4);
+#endif
+   }
+};
+
+// see testLikelihoodSerial.cxx for why main is defined manually
+int main(int argc, char **argv)
+{
+   testing::InitGoogleTest(&argc, argv);
+   testing::AddGlobalTestEnvironment(new Environment);
+   return RUN_ALL_TESTS();
+}
+
+class LikelihoodJobTest : public ::testing::Test {
+protected:
+   void SetUp() override
+   {
+      RooRandom::randomGenerator()->SetSeed(seed);
+      clean_flags = std::make_shared<RooFit::TestStatistics::WrapperCalculationCleanFlags>();
+   }
+
+   std::size_t seed = 23;
+   RooWorkspace w;
+   std::unique_ptr<RooAbsReal> nll;
+   std::unique_ptr<RooArgSet> values;
+   RooAbsPdf *pdf;
+   RooAbsData *data;
+   std::shared_ptr<RooFit::TestStatistics::RooAbsL> likelihood;
+   std::shared_ptr<RooFit::TestStatistics::WrapperCalculationCleanFlags> clean_flags;
+};
+
+TEST_F(LikelihoodJobTest, UnbinnedGaussian1D)
+{
+   std::tie(nll, pdf, data, values) = generate_1D_gaussian_pdf_nll(w, 10000);
+   likelihood = RooFit::TestStatistics::buildLikelihood(pdf, data);
+   RooFit::TestStatistics::LikelihoodJob nll_job(likelihood, clean_flags);
+#ifdef R__USE_IMT
+   // the events are split into sections, one per worker
+   EXPECT_EQ(nll_job.getNTasks(), 4u);
+#endif
+
+   auto nll0 = nll->getVal();
+
+   // the first evaluation is serial, the next ones are concurrent, also after changing a parameter
+   for (int i = 0; i < 3; ++i) {
+      nll_job.evaluate();
+      EXPECT_NEAR(nll0, nll_job.getResult().Sum(), 1e-10 * std::abs(nll0));
+      w.var("mu")->setVal(w.var("mu")->getVal() + 0.1);
+      nll0 = nll->getVal();
+   }
+}
+
+TEST_F(LikelihoodJobTest, SimUnbinned)
+{
+   w.factory("ExtendPdf::egA(Gaussian::gA(x[-10,10],mA[2,-10,10],s[3,0.1,10]),nA[1000])");
+   w.factory("ExtendPdf::egB(Gaussian::gB(x,mB[-2,-10,10],s),nB[100])");
+   w.factory("SIMUL::model(index[A,B],A=egA,B=egB)");
+
+   pdf = w.pdf("model");
+   data = pdf->generate(RooArgSet(*w.var("x"), *w.cat("index")));
+
+   likelihood = RooFit::TestStatistics::buildLikelihood(pdf, data);
+   RooFit::TestStatistics::LikelihoodSerial nll_serial(likelihood, clean_flags);
+   RooFit::TestStatistics::LikelihoodJob nll_job(likelihood, clean_flags);
+   EXPECT_EQ(nll_job.getNTasks(), 2u);
+
+   for (int i = 0; i < 3; ++i) {
+      nll_serial.evaluate();
+      nll_job.evaluate();
+      // the components are summed in the same order as in the serial evaluation
+      EXPECT_EQ(nll_serial.getResult(), nll_job.getResult());
+      w.var("s")->setVal(w.var("s")->getVal() + 0.1);
+   }
+}
+
+TEST_F(LikelihoodJobTest, BinnedConstrained)
+{
+   w.factory("Gaussian::g(x[-10,10],0,2)");
+   w.factory("Uniform::u(x)");
+
+   std::unique_ptr<RooDataHist> h_sig{w.pdf("g")->generateBinned(*w.var("x"), 1000)};
+   std::unique_ptr<RooDataHist> h_bkg{w.pdf("u")->generateBinned(*w.var("x"), 1000)};
+   w.import(*h_sig, RooFit::Rename("h_sig"));
+   w.import(*h_bkg, RooFit::Rename("h_bkg"));
+
+   w.factory("HistFunc::hf_sig(x,h_sig)");
+   w.factory("HistFunc::hf_bkg(x,h_bkg)");
+   w.factory("ASUM::model_phys(mu_sig[1,-1,10]*hf_sig,expr::mu_bkg('1+0.02*alpha_bkg',alpha_bkg[-5,5])*hf_bkg)");
+   w.factory("Gaussian:model_subs(alpha_bkg_obs[0],alpha_bkg,1)");
+   w.factory("PROD::model(model_phys,model_subs)");
+
+   pdf = w.pdf("model");
+   data = w.pdf("model_phys")->generateBinned(*w.var("x"));
+
+   nll.reset(pdf->createNLL(*data, RooFit::GlobalObservables(*w.var("alpha_bkg_obs"))));
+
+   likelihood = RooFit::TestStatistics::buildLikelihood(
+      pdf, data, RooFit::TestStatistics::GlobalObservables(RooArgSet(*w.var("alpha_bkg_obs"))));
+   RooFit::TestStatistics::LikelihoodJob nll_job(likelihood, clean_flags);
+
+   auto nll0 = nll->getVal();
+
+   nll_job.evaluate();
+   nll_job.evaluate();
+   auto nll1 = nll_job.getResult();
+
+   EXPECT_EQ(nll0, nll1);
+}
+
+TEST_F(LikelihoodJobTest, SimUnbinnedFit)
+{
+   w.factory("ExtendPdf::egA(Gaussian::gA(x[-10,10],mA[2,-10,10],s[3,0.1,10]),nA[1000])");
+   w.factory("ExtendPdf::egB(Gaussian::gB(x,mB[-2,-10,10],s),nB[100])");
+   w.factory("SIMUL::model(index[A,B],A=egA,B=egB)");
+
+   pdf = w.pdf("model");
+   data = pdf->generate(RooArgSet(*w.var("x"), *w.cat("index")));
+   std::unique_ptr<RooArgSet> parameters{pdf->getParameters(*data)};
+   values.reset(parameters->snapshot());
+
+   nll.reset(pdf->createNLL(*data));
+   RooMinimizer m0(*nll);
+   m0.setPrintLevel(-1);
+   m0.minimize("Minuit2", "migrad");
+   std::unique_ptr<RooArgSet> fit0{parameters->snapshot()};
+
+   *parameters = *values;
+
+   likelihood = RooFit::TestStatistics::buildLikelihood(pdf, data);
+   auto m1 = RooMinimizer::create<RooFit::TestStatistics::LikelihoodJob,
+                                  RooFit::TestStatistics::LikelihoodGradientSerial>(likelihood);
+   m1->setPrintLevel(-1);
+   m1->minimize("Minuit2", "migrad");
+
+   for (const char *name : {"mA", "mB", "s"}) {
+      auto var0 = static_cast<RooRealVar *>(fit0->find(name));
+      auto var1 = w.var(name);
+      EXPECT_NEAR(var0->getVal(), var1->getVal(), 1e-2 * var0->getError()) << name;
+   }
+}
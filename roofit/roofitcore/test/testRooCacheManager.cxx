@@ -10,6 +10,7 @@
 
 #include "gtest/gtest.h"
 
+#include <memory>
 #include <string>
 #include <vector>
 
@@ -102,3 +103,41 @@ TEST(RooCacheManager, TestAbsArgCacheListConsistency)
       EXPECT_EQ(pdf->numCaches(), 1);
    }
 }
+
+TEST(RooCacheManager, TestSetsWithSameContent)
+{
+   // Sets with the same content as a set of a cache slot share this slot; sets are told apart
+   // by their unique IDs, also when a new set is allocated where a deleted one was.
+
+   class CacheElem : public RooAbsCacheElement {
+   public:
+      virtual ~CacheElem() {}
+      virtual RooArgList containedArgs(Action) { return {}; }
+   };
+
+   RooRealVar x("x", "x", 0, -10, 10);
+   RooRealVar y("y", "y", 0, -10, 10);
+   RooGenericPdf pdf("pdf", "pdf", "x*y", RooArgList(x, y));
+   RooObjCacheManager mgr{&pdf, 10};
+
+   RooArgSet nsetX{x};
+   auto elemX = new CacheElem;
+   const int idxX = mgr.setObj(&nsetX, elemX);
+   RooArgSet nsetXY{x, y};
+   auto elemXY = new CacheElem;
+   const int idxXY = mgr.setObj(&nsetXY, elemXY);
+   EXPECT_NE(idxX, idxXY);
+
+   for (int i = 0; i < 5; ++i) {
+      auto tmpX = std::make_unique<RooArgSet>(x);
+      EXPECT_EQ(mgr.getObj(tmpX.get()), elemX);
+      EXPECT_EQ(mgr.lastIndex(), idxX);
+      auto tmpXY = std::make_unique<RooArgSet>(x, y);
+      EXPECT_EQ(mgr.getObj(tmpXY.get()), elemXY);
+      EXPECT_EQ(mgr.lastIndex(), idxXY);
+   }
+
+   RooArgSet nsetY{y};
+   EXPECT_EQ(mgr.getObj(&nsetY), nullptr);
+   EXPECT_EQ(mgr.getObj(&nsetX), elemX);
+}
@@ -259,3 +259,47 @@ TEST(RooDataSet, CrashAfterImportFromTree) {
   EXPECT_EQ(static_cast<RooRealVar*>(data_set->get(1)->find("var"))->getVal(), 2.);
 
 }
+
+/// Adding events column by column gives the same dataset as adding them one by one.
+TEST(RooDataSet, AddEvents) {
+  RooRealVar x("x", "x", 0., 10.);
+  RooRealVar y("y", "y", -1., 1.);
+  RooRealVar w("w", "w", 0., 10.);
+  RooCategory cat("cat", "cat", {{"A", 0}, {"B", 1}});
+  cat.setIndex(1);
+
+  std::vector<double> xValues{1., 2., 3., 12., 5.};
+  std::vector<double> yValues{0.5, -0.5, 0.25, -0.25, 0.};
+  std::vector<double> weights{1., 2., 0.5, 1.5, 3.};
+
+  RooDataSet bulk("bulk", "bulk", RooArgSet(x, y, w, cat), RooFit::WeightVar(w));
+  bulk.addEvents(RooArgList(x, y), {xValues, yValues}, weights);
+
+  RooDataSet single("single", "single", RooArgSet(x, y, w, cat), RooFit::WeightVar(w));
+  for (std::size_t i = 0; i < xValues.size(); ++i) {
+    x.setVal(xValues[i]);
+    y.setVal(yValues[i]);
+    single.add(RooArgSet(x, y, cat), weights[i]);
+  }
+
+  ASSERT_EQ(bulk.numEntries(), single.numEntries());
+  EXPECT_DOUBLE_EQ(bulk.sumEntries(), single.sumEntries());
+  for (int i = 0; i < bulk.numEntries(); ++i) {
+    const RooArgSet* bulkRow = bulk.get(i);
+    const double bulkWeight = bulk.weight();
+    const RooArgSet* singleRow = single.get(i);
+    EXPECT_EQ(bulkRow->getRealValue("x"), singleRow->getRealValue("x")) << "entry " << i;
+    EXPECT_EQ(bulkRow->getRealValue("y"), singleRow->getRealValue("y")) << "entry " << i;
+    EXPECT_EQ(bulkRow->getCatIndex("cat"), 1) << "entry " << i;
+    EXPECT_EQ(bulkWeight, single.weight()) << "entry " << i;
+  }
+  // The value outside of the range of x was clipped
+  EXPECT_EQ(bulk.get(3)->getRealValue("x"), 10.);
+
+  std::unique_ptr<RooAbsData> reduced{bulk.reduce("x > 2.5 && y < 0.3")};
+  EXPECT_EQ(reduced->numEntries(), 3);
+  EXPECT_DOUBLE_EQ(reduced->sumEntries(), 5.);
+
+  std::vector<double> tooShort{1.};
+  EXPECT_THROW(bulk.addEvents(RooArgList(x, y), {xValues, tooShort}), std::invalid_argument);
+}
@@ -0,0 +1,110 @@
+// Tests for the RooFFTConvPdf
+
+#include "RooFFTConvPdf.h"
+#include "RooGaussian.h"
+#include "RooRealVar.h"
+#include "RooExpensiveObjectCache.h"
+
+#include "TFile.h"
+#include "TSystem.h"
+
+#include "gtest/gtest.h"
+
+#include <cmath>
+#include <memory>
+
+namespace {
+double gauss(double x, double mean, double sigma)
+{
+  return std::exp(-0.5 * (x - mean) * (x - mean) / (sigma * sigma)) / (std::sqrt(2. * M_PI) * sigma);
+}
+}
+
+// The transforms of the input p.d.f.s are kept between evaluations. Check that the convolution
+// follows when the parameters of either input change.
+TEST(RooFFTConvPdf, UpdateInputTransforms)
+{
+  RooRealVar x("x", "x", -10., 10.);
+  x.setBins(2000, "cache");
+  RooRealVar m1("m1", "m1", 0., -5., 5.);
+  RooRealVar s1("s1", "s1", 1., 0.1, 5.);
+  RooRealVar m2("m2", "m2", 0., -5., 5.);
+  RooRealVar s2("s2", "s2", 0.5, 0.1, 5.);
+  RooGaussian sig("sig", "sig", x, m1, s1);
+  RooGaussian res("res", "res", x, m2, s2);
+  RooFFTConvPdf conv("conv", "conv", x, sig, res);
+
+  RooArgSet normSet(x);
+  auto check = [&]() {
+    const double mean = m1.getVal() + m2.getVal();
+    const double sigma = std::sqrt(s1.getVal() * s1.getVal() + s2.getVal() * s2.getVal());
+    for (double xVal : {-2., -0.5, 0., 1., 2.5}) {
+      x.setVal(xVal);
+      EXPECT_NEAR(conv.getVal(normSet), gauss(xVal, mean, sigma), 2.E-3)
+        << "x=" << xVal << " m1=" << m1.getVal() << " s1=" << s1.getVal() << " m2=" << m2.getVal()
+        << " s2=" << s2.getVal();
+    }
+  };
+
+  check();
+  // only the signal changes
+  m1.setVal(0.5);
+  check();
+  s1.setVal(1.5);
+  check();
+  // only the resolution changes
+  s2.setVal(0.8);
+  check();
+  m2.setVal(-0.3);
+  check();
+  // both change
+  m1.setVal(-0.5);
+  s2.setVal(0.3);
+  check();
+}
+
+// Cache histograms in the persistent store are reused by p.d.f.s with the same expression graph,
+// binning and parameter values, also when they are not in memory any longer.
+TEST(RooFFTConvPdf, PersistentStore)
+{
+  const char *fileName = "testRooFFTConvPdf_store.root";
+  gSystem->Unlink(fileName);
+  RooExpensiveObjectCache::setPersistentStore(fileName, 2);
+
+  auto numKeys = [&]() {
+    std::unique_ptr<TFile> file{TFile::Open(fileName)};
+    return file ? file->GetListOfKeys()->GetSize() : -1;
+  };
+
+  auto eval = [](double mean) {
+    RooRealVar x("x", "x", -10., 10.);
+    x.setBins(1000, "cache");
+    RooRealVar m1("m1", "m1", mean, -5., 5.);
+    RooRealVar s1("s1", "s1", 1., 0.1, 5.);
+    RooRealVar m2("m2", "m2", 0., -5., 5.);
+    RooRealVar s2("s2", "s2", 0.5, 0.1, 5.);
+    RooGaussian sig("sig", "sig", x, m1, s1);
+    RooGaussian res("res", "res", x, m2, s2);
+    RooFFTConvPdf conv("conv", "conv", x, sig, res);
+    x.setVal(0.7);
+    const double val = conv.getVal(RooArgSet(x));
+    RooExpensiveObjectCache::instance().clearAll();
+    return val;
+  };
+
+  const double val = eval(0.);
+  EXPECT_EQ(numKeys(), 1);
+  EXPECT_EQ(eval(0.), val);
+  EXPECT_EQ(numKeys(), 1);
+
+  // other parameter values are stored separately, the oldest histograms are evicted
+  EXPECT_NE(eval(0.5), val);
+  EXPECT_EQ(numKeys(), 2);
+  eval(1.);
+  EXPECT_EQ(numKeys(), 2);
+
+  RooExpensiveObjectCache::setPersistentStore(nullptr);
+  EXPECT_EQ(RooExpensiveObjectCache::persistentStore(), nullptr);
+  gSystem->Unlink(fileName);
+  gSystem->Unlink((std::string(fileName) + ".lock").c_str());
+}
@@ -0,0 +1,129 @@
+/*****************************************************************************
+ * RooFit
+ * Authors:                                                                  *
+ *   WV, Wouter Verkerke, UC Santa Barbara, verkerke@slac.stanford.edu       *
+ *   DK, David Kirkby,    UC Irvine,         dkirkby@uci.edu                 *
+ *                                                                           *
+ * Copyright (c) 2000-2021, Regents of the University of California          *
+ *                          and Stanford University. All rights reserved.    *
+ *                                                                           *
+ * Redistribution and use in source and binary forms,                        *
+ * with or without modification, are permitted according to the terms        *
+ * listed in LICENSE (http://roofit.sourceforge.net/license.txt)             *
+ *****************************************************************************/
+
+#include <RooFuncWrapper.h>
+
+#include <RooAddPdf.h>
+#include <RooDataSet.h>
+#include <RooFitResult.h>
+#include <RooMinimizer.h>
+#include <RooMsgService.h>
+#include <RooRandom.h>
+#include <RooRealVar.h>
+#include <RooWorkspace.h>
+
+#include "gtest/gtest.h"
+
+#include <memory>
+#include <vector>
+
+namespace {
+
+// Compare the value and the gradient of the RooFuncWrapper with the likelihood of createNLL(), where the gradient is
+// computed with central finite differences.
+void compareWithNLL(RooAbsPdf &pdf, RooAbsData &data, bool extended)
+{
+   RooFuncWrapper nllFunc("nllFunc", "nllFunc", pdf, data, extended);
+   std::unique_ptr<RooAbsReal> nllRef{pdf.createNLL(data, RooFit::Extended(extended))};
+
+   EXPECT_NEAR(nllFunc.getVal(), nllRef->getVal(), 1e-8 * std::abs(nllRef->getVal()));
+
+   const RooArgList &params = nllFunc.parameters();
+   std::vector<double> grad(params.size());
+   nllFunc.gradient(grad.data());
+   for (std::size_t i = 0; i < params.size(); ++i) {
+      auto &param = static_cast<RooRealVar &>(params[i]);
+      const double val = param.getVal();
+      const double step = 1e-5 * (param.getMax() - param.getMin());
+      param.setVal(val + step);
+      const double up = nllRef->getVal();
+      param.setVal(val - step);
+      const double down = nllRef->getVal();
+      param.setVal(val);
+      const double numGrad = (up - down) / (2 * step);
+      EXPECT_NEAR(grad[i], numGrad, 1e-4 * std::max(1., std::abs(numGrad))) << param.GetName();
+   }
+}
+
+} // namespace
+
+TEST(RooFuncWrapper, GaussianPlusExponential)
+{
+   RooMsgService::instance().setGlobalKillBelow(RooFit::WARNING);
+   RooRandom::randomGenerator()->SetSeed(1337);
+
+   RooWorkspace ws;
+   ws.factory("Gaussian::sig(x[0, 10], mu[5, 0, 10], sigma[1, 0.1, 5])");
+   ws.factory("Exponential::bkg(x, c[-0.3, -2, 0])");
+   ws.factory("SUM::model(frac[0.3, 0, 1] * sig, bkg)");
+   RooAbsPdf &model = *ws.pdf("model");
+
+   std::unique_ptr<RooDataSet> data{model.generate(*ws.var("x"), 1000)};
+   compareWithNLL(model, *data, false);
+}
+
+TEST(RooFuncWrapper, ProductWithFormulaAndPolynomial)
+{
+   RooMsgService::instance().setGlobalKillBelow(RooFit::WARNING);
+   RooRandom::randomGenerator()->SetSeed(1337);
+
+   RooWorkspace ws;
+   ws.factory("expr::mean('mu + shift', mu[0, -5, 5], shift[1, -5, 5])");
+   ws.factory("Gaussian::gx(x[-10, 10], mean, sigma[2, 0.1, 5])");
+   ws.factory("Polynomial::py(y[0, 1], {a1[0.5, 0, 2], a2[0.2, 0, 2]})");
+   ws.factory("PROD::model(gx, py)");
+   RooAbsPdf &model = *ws.pdf("model");
+
+   std::unique_ptr<RooDataSet> data{model.generate(RooArgSet(*ws.var("x"), *ws.var("y")), 1000)};
+   compareWithNLL(model, *data, false);
+}
+
+// An extended fit with the analytic gradient gives the same result as the fit with the numerical gradient.
+TEST(RooFuncWrapper, ExtendedFit)
+{
+   RooMsgService::instance().setGlobalKillBelow(RooFit::WARNING);
+   RooRandom::randomGenerator()->SetSeed(1337);
+
+   RooWorkspace ws;
+   ws.factory("Gaussian::sig(x[0, 10], mu[5, 0, 10], sigma[1, 0.1, 5])");
+   ws.factory("Exponential::bkg(x, c[-0.3, -2, 0])");
+   ws.factory("SUM::model(nsig[300, 0, 2000] * sig, nbkg[700, 0, 2000] * bkg)");
+   RooAbsPdf &model = *ws.pdf("model");
+
+   std::unique_ptr<RooDataSet> data{model.generate(*ws.var("x"), 1000)};
+   compareWithNLL(model, *data, true);
+
+   std::unique_ptr<RooArgSet> params{model.getParameters(*data)};
+   RooArgSet initialParams;
+   params->snapshot(initialParams);
+
+   std::unique_ptr<RooFitResult> refResult{
+      model.fitTo(*data, RooFit::Extended(), RooFit::Save(), RooFit::PrintLevel(-1), RooFit::Minimizer("Minuit2"))};
+
+   params->assign(initialParams);
+   RooFuncWrapper nllFunc("nllFunc", "nllFunc", model, *data, true);
+   RooMinimizer m(nllFunc, RooMinimizer::FcnMode::gradient);
+   m.setPrintLevel(-1);
+   m.migrad();
+   m.hesse();
+   std::unique_ptr<RooFitResult> result{m.save()};
+
+   EXPECT_EQ(result->status(), 0);
+   for (auto *refParam : static_range_cast<RooRealVar *>(refResult->floatParsFinal())) {
+      auto *param = static_cast<RooRealVar *>(result->floatParsFinal().find(*refParam));
+      ASSERT_NE(param, nullptr);
+      EXPECT_NEAR(param->getVal(), refParam->getVal(), 1e-2 * refParam->getError()) << param->GetName();
+      EXPECT_NEAR(param->getError(), refParam->getError(), 1e-2 * refParam->getError()) << param->GetName();
+   }
+}
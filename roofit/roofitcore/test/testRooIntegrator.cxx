@@ -0,0 +1,71 @@
+// Tests for the numeric integrators
+
+#include "RooRealVar.h"
+#include "RooGenericPdf.h"
+#include "RooNumIntConfig.h"
+#include "RooHelpers.h"
+
+#include "TMath.h"
+
+#include "gtest/gtest.h"
+
+#include <memory>
+
+namespace {
+
+double gaussIntegral(double sigma, double limit)
+{
+  return std::sqrt(TMath::TwoPi()) * sigma * TMath::Erf(limit / (std::sqrt(2.) * sigma));
+}
+
+} // namespace
+
+/// Integrating with batch evaluation of the integrand gives the same result as the point-by-point evaluation.
+TEST(RooIntegrator1D, BatchMode)
+{
+  RooHelpers::LocalChangeMsgLevel changeMsgLvl(RooFit::WARNING);
+
+  RooRealVar x("x", "x", -5., 5.);
+  RooRealVar sigma("sigma", "sigma", 1.5, 0.1, 10.);
+  RooGenericPdf gauss("gauss", "exp(-0.5*x*x/(sigma*sigma))", RooArgSet(x, sigma));
+
+  for (const char *rule : {"Trapezoid", "Midpoint"}) {
+    RooNumIntConfig config(*RooAbsReal::defaultIntegratorConfig());
+    config.method1D().setLabel("RooIntegrator1D");
+    config.getConfigSection("RooIntegrator1D").setCatLabel("sumRule", rule);
+    std::unique_ptr<RooAbsReal> integral{gauss.createIntegral(x, config)};
+
+    config.getConfigSection("RooIntegrator1D").setCatLabel("batchMode", "On");
+    std::unique_ptr<RooAbsReal> batchIntegral{gauss.createIntegral(x, config)};
+
+    for (double sigmaVal : {1.5, 0.5, 3.}) {
+      sigma.setVal(sigmaVal);
+      EXPECT_NEAR(batchIntegral->getVal(), integral->getVal(), 1.E-12 * integral->getVal())
+        << rule << " sigma=" << sigmaVal;
+      EXPECT_NEAR(batchIntegral->getVal(), gaussIntegral(sigmaVal, 5.), 1.E-6 * integral->getVal())
+        << rule << " sigma=" << sigmaVal;
+    }
+  }
+}
+
+/// The VEGAS integration with batch evaluation of the integrand converges to the right result.
+TEST(RooMCIntegrator, BatchMode)
+{
+  RooHelpers::LocalChangeMsgLevel changeMsgLvl(RooFit::WARNING);
+
+  RooRealVar x("x", "x", -5., 5.);
+  RooRealVar y("y", "y", -5., 5.);
+  RooRealVar sigma("sigma", "sigma", 1.5, 0.1, 10.);
+  RooGenericPdf gauss("gauss", "exp(-0.5*(x*x+y*y)/(sigma*sigma))", RooArgSet(x, y, sigma));
+
+  RooNumIntConfig config(*RooAbsReal::defaultIntegratorConfig());
+  config.method2D().setLabel("RooMCIntegrator");
+  config.getConfigSection("RooMCIntegrator").setCatLabel("batchMode", "On");
+  std::unique_ptr<RooAbsReal> batchIntegral{gauss.createIntegral(RooArgSet(x, y), config)};
+
+  for (double sigmaVal : {1.5, 1.}) {
+    sigma.setVal(sigmaVal);
+    const double expected = gaussIntegral(sigmaVal, 5.) * gaussIntegral(sigmaVal, 5.);
+    EXPECT_NEAR(batchIntegral->getVal(), expected, 1.E-3 * expected) << "sigma=" << sigmaVal;
+  }
+}
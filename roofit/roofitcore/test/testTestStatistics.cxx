@@ -7,12 +7,15 @@
 
 #include <RooRealVar.h>
 #include <RooGenericPdf.h>
+#include <RooAddPdf.h>
 #include <RooDataHist.h>
 #include <RooDataSet.h>
 #include <RooFitResult.h>
 #include <RooBinning.h>
 #include <RooPlot.h>
 #include <RooRandom.h>
+#include <RooFitDriver.h>
+#include <RunContext.h>
 
 #include <gtest/gtest.h>
 
@@ -260,6 +263,92 @@ TEST(RooNLLVar, IntegrateBins_RooDataHist) {
 }
 
 
+/// The batch evaluation only recomputes the components of the model whose parameters changed.
+/// Check that it agrees with the scalar evaluation when the parameters change one by one.
+TEST(RooNLLVar, BatchModeParameterChanges) {
+  RooRandom::randomGenerator()->SetSeed(1337ul);
+
+  RooRealVar x("x", "x", 0.1, 5.1);
+  RooRealVar a1("a1", "a1", -0.3, -5., 5.);
+  RooRealVar a2("a2", "a2", -1.5, -5., 5.);
+  RooRealVar f("f", "f", 0.4, 0., 1.);
+  RooGenericPdf pdf1("pow1", "std::pow(x, a1)", RooArgSet(x, a1));
+  RooGenericPdf pdf2("pow2", "std::exp(a2*x)", RooArgSet(x, a2));
+  RooAddPdf pdf("pdf", "pdf", RooArgList(pdf1, pdf2), RooArgList(f));
+  std::unique_ptr<RooDataSet> data(pdf.generate(x, 1000));
+
+  std::unique_ptr<RooAbsReal> nllScalar(pdf.createNLL(*data));
+  std::unique_ptr<RooAbsReal> nllBatch(pdf.createNLL(*data, RooFit::BatchMode(true)));
+
+  auto check = [&]() { EXPECT_NEAR(nllScalar->getVal(), nllBatch->getVal(), 1.E-8 * std::abs(nllScalar->getVal())); };
+  check();
+  a1.setVal(-0.5);
+  check();
+  a2.setVal(-1.);
+  check();
+  f.setVal(0.6);
+  check();
+  check();
+  a1.setVal(-0.3);
+  check();
+}
+
+
+/// The batch evaluation keeps the results of the nodes that did not change. Check that it notices a
+/// dataset modified in place, whose spans keep their address, and a change of the range of the observable,
+/// which does not change any leaf value.
+TEST(RooFitDriver, DataAndShapeChanges) {
+  RooRandom::randomGenerator()->SetSeed(1337ul);
+
+  RooRealVar x("x", "x", 0.1, 5.1);
+  RooRealVar a1("a1", "a1", -0.3, -5., 5.);
+  RooRealVar a2("a2", "a2", -1.5, -5., 5.);
+  RooRealVar f("f", "f", 0.4, 0., 1.);
+  RooGenericPdf pdf1("pow1", "std::pow(x, a1)", RooArgSet(x, a1));
+  RooGenericPdf pdf2("pow2", "std::exp(a2*x)", RooArgSet(x, a2));
+  RooAddPdf pdf("pdf", "pdf", RooArgList(pdf1, pdf2), RooArgList(f));
+  std::unique_ptr<RooDataSet> data(pdf.generate(x, 1000));
+  const std::size_t n = data->numEntries();
+  RooArgSet normSet(x);
+
+  RooFitDriver driver(pdf, *data);
+  // compare with a driver that evaluates everything
+  auto check = [&]() {
+    const std::vector<double> expected = [&]() {
+      RooFitDriver fresh(pdf, *data);
+      auto span = fresh.getLogProbabilities(0, n, &normSet);
+      return std::vector<double>(span.begin(), span.end());
+    }();
+    auto results = driver.getLogProbabilities(0, n, &normSet);
+    ASSERT_EQ(expected.size(), results.size());
+    for (std::size_t i = 0; i < expected.size(); ++i)
+      EXPECT_NEAR(expected[i], results[i], 1.E-12 * std::abs(expected[i])) << "event " << i;
+  };
+  check();
+
+  // refill the dataset with other values and as many entries
+  std::unique_ptr<RooDataSet> other(pdf2.generate(x, n));
+  auto firstValue = [&]() {
+    RooBatchCompute::RunContext evalData;
+    data->getBatches(evalData, 0, n);
+    return evalData.spans.begin()->second.data();
+  };
+  const double *before = firstValue();
+  data->reset();
+  for (std::size_t i = 0; i < n; ++i)
+    data->add(*other->get(i));
+  EXPECT_EQ(before, firstValue()) << "the test wants the values to stay at the same address";
+  check();
+
+  // changes the normalisation of the pdfs only
+  x.setRange(0.5, 5.1);
+  check();
+
+  a2.setVal(-1.);
+  check();
+}
+
+
 TEST(RooChi2Var, IntegrateBins) {
   RooRandom::randomGenerator()->SetSeed(1337ul);
 
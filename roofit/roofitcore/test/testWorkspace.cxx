@@ -7,6 +7,7 @@
 #include "RooArgList.h"
 #include "RooRealVar.h"
 #include "RooAbsReal.h"
+#include "RooFormulaVar.h"
 #include "RooStats/ModelConfig.h"
 
 #include "ROOT/StringUtils.hxx"
@@ -15,6 +16,8 @@
 
 #include "gtest/gtest.h"
 
+#include <memory>
+
 using namespace RooStats;
 
 /// ROOT-9777, cloning a RooWorkspace. The ModelConfig did not get updated
@@ -234,3 +237,53 @@ TEST_F(TestRooWorkspaceWithGaussian, HashLookupInWorkspace) {
   EXPECT_FALSE(model_constrained_orig->dependsOn(*ws->var("mu2")));
   EXPECT_NE(ws->pdf("Gauss_editPdf_orig"), nullptr);
 }
+
+
+/// Write and read back a workspace with many nodes, some of which have clients outside the workspace.
+TEST(RooWorkspace, WriteAndReadManyNodes) {
+  const char* filename = "testWorkspace_manyNodes.root";
+  constexpr int nChannels = 200;
+
+  RooWorkspace ws("ws");
+  RooRealVar mu("mu", "mu", 0., -10., 10.);
+  for (int i = 0; i < nChannels; ++i) {
+    RooRealVar x(Form("x_%d", i), "x", 0., -10., 10.);
+    RooRealVar sigma(Form("sigma_%d", i), "sigma", 1. + 0.01 * i, 0.1, 10.);
+    RooGaussian gauss(Form("gauss_%d", i), "gauss", x, mu, sigma);
+    ASSERT_FALSE(ws.import(gauss, RooFit::RecycleConflictNodes(), RooFit::Silence()));
+  }
+  ASSERT_EQ(ws.allPdfs().size(), static_cast<std::size_t>(nChannels));
+
+  // A client outside of the workspace must not be written, but has to be connected again after writing
+  RooRealVar* wsMu = ws.var("mu");
+  ASSERT_NE(wsMu, nullptr);
+  RooFormulaVar external("external", "2*@0", RooArgList(*wsMu));
+  {
+    TFile file(filename, "RECREATE");
+    ASSERT_GT(file.WriteObject(&ws, "ws"), 0);
+  }
+  EXPECT_TRUE(external.dependsOn(*wsMu));
+  bool isClient = false;
+  for (auto client : wsMu->clients()) {
+    isClient |= client == &external;
+  }
+  EXPECT_TRUE(isClient);
+
+  {
+    TFile file(filename, "READ");
+    std::unique_ptr<RooWorkspace> wsRead(file.Get<RooWorkspace>("ws"));
+    ASSERT_NE(wsRead, nullptr);
+    EXPECT_EQ(wsRead->allPdfs().size(), static_cast<std::size_t>(nChannels));
+    RooRealVar* muRead = wsRead->var("mu");
+    ASSERT_NE(muRead, nullptr);
+    for (auto client : muRead->clients()) {
+      EXPECT_NE(std::string(client->GetName()), "external");
+    }
+    RooAbsPdf* gauss = wsRead->pdf(Form("gauss_%d", nChannels - 1));
+    ASSERT_NE(gauss, nullptr);
+    EXPECT_TRUE(gauss->dependsOn(*muRead));
+    EXPECT_DOUBLE_EQ(gauss->getVal(), ws.pdf(Form("gauss_%d", nChannels - 1))->getVal());
+  }
+
+  gSystem->Unlink(filename);
+}
@@ -22,6 +22,7 @@ class TGraphErrors;
 
 #include <memory>
 #include <string>
+#include <vector>
 
 namespace RooStats {
 
@@ -146,6 +147,12 @@ public:
    // set numerical error in test statistic evaluation (default is zero)
    void SetNumErr(double err) { fNumErr = err; }
 
+   /// Run the points of the fixed scans in `nWorkers` processes forked from the current one.
+   /// The default, 1, runs them one after the other in the current process. The automatic scan
+   /// of RunLimit is always sequential.
+   void SetNWorkers(unsigned int nWorkers) { fNWorkers = nWorkers; }
+   unsigned int GetNWorkers() const { return fNWorkers; }
+
    // set flag to close proof for every new run
    static void SetCloseProof(Bool_t flag);
 
@@ -163,6 +170,15 @@ protected:
    // run the hybrid at a single point
    HypoTestResult * Eval( HypoTestCalculatorGeneric &hc, bool adaptive , double clsTarget) const;
 
+   // run the test at a single point and return its result if valid, without adding it to the results
+   HypoTestResult * EvalPoint( double &rVal, bool adaptive, double clTarget) const;
+
+   // add the result of a point to the results, merging it with the last point if at the same value
+   void AddPointResult( double rVal, HypoTestResult * result) const;
+
+   // run the points of a fixed scan in parallel processes
+   void RunParallelScan( const std::vector<double> & xValues) const;
+
    // helper functions
    static RooRealVar * GetVariableToScan(const HypoTestCalculatorGeneric &hc);
    static void CheckInputModels(const HypoTestCalculatorGeneric &hc, const RooRealVar & scanVar);
@@ -199,6 +215,7 @@ private:
    double fXmin;
    double fXmax;
    double fNumErr;
+   unsigned int fNWorkers = 1; //! number of worker processes for the fixed scans
 
 protected:
 
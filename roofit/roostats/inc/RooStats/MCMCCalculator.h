@@ -99,6 +99,14 @@ namespace RooStats {
       virtual void SetNumBurnInSteps(Int_t numBurnInSteps)
       { fNumBurnInSteps = numBurnInSteps; }
 
+      /// Run `numChains` independent chains of the number of iterations given to SetNumIters
+      /// each, and merge them after discarding their burn-in steps. The Gelman-Rubin
+      /// diagnostic of the parameters is then available from MCMCInterval::GetRHat.
+      virtual void SetNumChains(UInt_t numChains) { fNumChains = numChains; }
+
+      /// Run the chains in `nWorkers` processes forked from the current one; see SetNumChains.
+      virtual void SetNWorkers(UInt_t nWorkers) { fNWorkers = nWorkers; }
+
       /// set the number of bins to create for each axis when constructing the interval
       virtual void SetNumBins(Int_t numBins) { fNumBins = numBins; }
       /// set which variables to put on each axis
@@ -191,6 +199,8 @@ namespace RooStats {
                        // floating-point arithmetic does not always work
                        // perfectly, and the Abs doesn't hurt
       enum MCMCInterval::IntervalType fIntervalType; // type of interval to find
+      UInt_t fNumChains; //! number of independent chains to run
+      UInt_t fNWorkers;  //! number of worker processes for the chains
 
       void SetupBasicUsage();
       void SetBins(const RooAbsCollection& coll, Int_t numBins) const
@@ -20,6 +20,8 @@
 #include "RooMsgService.h"
 #include "RooStats/MarkovChain.h"
 
+#include <map>
+#include <string>
 #include <vector>
 
 class RooNDKeysPdf;
@@ -178,6 +180,18 @@ namespace RooStats {
       /// starting from the first
       virtual Int_t GetNumBurnInSteps() { return fNumBurnInSteps; }
 
+      /// set the Gelman-Rubin convergence diagnostic of a parameter, computed over the
+      /// chains merged into this interval (see MarkovChain::GelmanRubin)
+      virtual void SetRHat(const char* paramName, Double_t rHat) { fRHat[paramName] = rHat; }
+
+      /// get the Gelman-Rubin convergence diagnostic of a parameter, or -1 if it was not
+      /// computed, e.g. because the interval is based on a single chain
+      virtual Double_t GetRHat(const RooAbsArg& param) const
+      {
+         auto it = fRHat.find(param.GetName());
+         return it == fRHat.end() ? -1 : it->second;
+      }
+
       /// set the number of bins to use (same for all axes, for now)
       ///virtual void SetNumBins(Int_t numBins);
 
@@ -324,6 +338,7 @@ namespace RooStats {
                        // floating-point arithmetic does not always work
                        // perfectly, and the Abs doesn't hurt
       enum IntervalType fIntervalType;
+      std::map<std::string, Double_t> fRHat; // Gelman-Rubin diagnostic of the parameters, if several chains were run
 
 
       // functions
@@ -342,7 +357,7 @@ namespace RooStats {
       virtual void CreateVector(RooRealVar* param);
       inline virtual Double_t CalcConfLevel(Double_t cutoff, Double_t full);
 
-      ClassDef(MCMCInterval,1)  // Concrete implementation of a ConfInterval based on MCMC calculation
+      ClassDef(MCMCInterval,2)  // Concrete implementation of a ConfInterval based on MCMC calculation
 
    };
 }
@@ -20,6 +20,8 @@
 #include "RooDataSet.h"
 #include "RooDataHist.h"
 #include "THnSparse.h"
+
+#include <vector>
 //#include "RooArgSet.h"
 //#include "RooMsgService.h"
 //#include "RooRealVar.h"
@@ -104,6 +106,11 @@ namespace RooStats {
       virtual RooRealVar* GetWeightVar() const
       { return (RooRealVar*)fWeight->Clone(); }
 
+      /// Gelman-Rubin potential scale reduction factor (R-hat) of the parameter
+      /// over independent chains, after discarding the first burnIn steps of each
+      static Double_t GelmanRubin(const std::vector<const MarkovChain*>& chains, const char* paramName,
+                                  Int_t burnIn = 0);
+
       virtual ~MarkovChain()
       {
          delete fParameters;
@@ -19,6 +19,8 @@
 #include "RooStats/ProposalFunction.h"
 #include "RooStats/MarkovChain.h"
 
+#include <vector>
+
 namespace RooStats {
 
    class MetropolisHastings :  public TObject {
@@ -41,6 +43,10 @@ namespace RooStats {
       // algorithm to generate Markov Chain of points in the parameter space
       virtual MarkovChain* ConstructChain();
 
+      // run fNumChains independent chains, each from its own random starting point
+      // and with its own seed for the random generator; the caller owns the chains
+      virtual std::vector<MarkovChain*> ConstructChains();
+
       // specify the parameters to store in the chain
       // if not specified all of them will be stored
       virtual void SetChainParameters(const RooArgSet& set)
@@ -64,6 +70,13 @@ namespace RooStats {
       virtual void SetSign(enum FunctionSign sign) { fSign = sign; }
       // set the type of the function
       virtual void SetType(enum FunctionType type) { fType = type; }
+      /// set the number of independent chains run by ConstructChains(), of fNumIters iterations each
+      virtual void SetNumChains(UInt_t numChains) { fNumChains = numChains; }
+      virtual UInt_t GetNumChains() const { return fNumChains; }
+      /// Run the chains of ConstructChains() in `nWorkers` processes forked from the current one.
+      /// The default, 1, runs them one after the other in the current process.
+      virtual void SetNWorkers(UInt_t nWorkers) { fNWorkers = nWorkers; }
+      virtual UInt_t GetNWorkers() const { return fNWorkers; }
 
 
    protected:
@@ -75,6 +88,8 @@ namespace RooStats {
       Int_t fNumBurnInSteps; // number of iterations to discard as burn-in, starting from the first
       enum FunctionSign fSign; // whether the likelihood is negative (like NLL) or positive
       enum FunctionType fType; // whether the likelihood is on a regular, log, (or other) scale
+      UInt_t fNumChains = 1; //! number of chains run by ConstructChains()
+      UInt_t fNWorkers = 1;  //! number of worker processes for the chains
 
       // whether we should take the step, based on the value of d, fSign, fType
       virtual Bool_t ShouldTakeStep(Double_t d);
@@ -80,6 +80,7 @@ class ToyMCSampler: public TestStatSampler {
       virtual SamplingDistribution* GetSamplingDistribution(RooArgSet& paramPoint);
       virtual RooDataSet* GetSamplingDistributions(RooArgSet& paramPoint);
       virtual RooDataSet* GetSamplingDistributionsSingleWorker(RooArgSet& paramPoint);
+      RooDataSet* GetSamplingDistributionsMultiProcess(RooArgSet& paramPoint);
 
       virtual SamplingDistribution* AppendSamplingDistribution(
          RooArgSet& allParameters,
@@ -227,6 +228,11 @@ class ToyMCSampler: public TestStatSampler {
       // calling with argument or NULL deactivates proof
       void SetProofConfig(ProofConfig *pc = NULL) { fProofConfig = pc; }
 
+      /// Generate and evaluate the toys in `nWorkers` processes forked from the current one.
+      /// The default, 1, runs the toys in the current process. A ProofConfig takes precedence.
+      void SetNWorkers(unsigned int nWorkers) { fNWorkers = nWorkers; }
+      unsigned int GetNWorkers() const { return fNWorkers; }
+
       void SetProtoData(const RooDataSet* d) { fProtoData = d; }
 
    protected:
@@ -272,6 +278,7 @@ class ToyMCSampler: public TestStatSampler {
       const RooDataSet *fProtoData; // in dev
 
       ProofConfig *fProofConfig;   //!
+      unsigned int fNWorkers;      //! number of worker processes
 
       mutable NuisanceParametersSampler *fNuisanceParametersSampler; //!
 
@@ -64,6 +64,12 @@ call HypoTestInverter::UseCLs().
 
 #include "RooStats/ProofConfig.h"
 
+#include "RConfig.h" // for R__WIN32
+#ifndef R__WIN32
+#include "ROOT/TProcessExecutor.hxx"
+#endif
+
+#include <algorithm>
 #include <cassert>
 #include <cmath>
 #include <memory>
@@ -406,6 +412,7 @@ HypoTestInverter & HypoTestInverter::operator= (const HypoTestInverter & rhs) {
    fXmin = rhs.fXmin;
    fXmax = rhs.fXmax;
    fNumErr = rhs.fNumErr;
+   fNWorkers = rhs.fNWorkers;
 
    return *this;
 }
@@ -643,6 +650,7 @@ bool HypoTestInverter::RunFixedScan( int nBins, double xMin, double xMax, bool s
      return false;
    }
 
+   std::vector<double> xValues;
    double thisX = xMin;
    for (int i=0; i<nBins; i++) {
 
@@ -652,18 +660,70 @@ bool HypoTestInverter::RunFixedScan( int nBins, double xMin, double xMax, bool s
          else
             thisX = xMin + i*(xMax-xMin)/(nBins-1);          // linear scan in x
       }
+      xValues.push_back(thisX);
+   }
+
+   if (fNWorkers > 1 && xValues.size() > 1) {
+      RunParallelScan(xValues);
+      return true;
+   }
 
-      const bool status = RunOnePoint(thisX);
+   for (double x : xValues) {
+      const bool status = RunOnePoint(x);
 
       // check if failed status
       if ( status==false ) {
-        oocoutW((TObject*)0,Eval) << "HypoTestInverter::RunFixedScan - The hypo test for point " << thisX << " failed. Skipping." << std::endl;
+        oocoutW((TObject*)0,Eval) << "HypoTestInverter::RunFixedScan - The hypo test for point " << x << " failed. Skipping." << std::endl;
       }
    }
 
    return true;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Run the points of a fixed scan in fNWorkers processes forked from the current one.
+/// The workers inherit the model, the data and the configured calculator, so that each of them
+/// only runs the test at its points; each point gets its own seed for the random generator,
+/// drawn here, so that the results do not depend on the number of workers.
+/// The results are added in the order of the points, as in the sequential scan.
+
+void HypoTestInverter::RunParallelScan(const std::vector<double> &xValues) const
+{
+#ifdef R__WIN32
+   oocoutW((TObject*)0,InputArguments) << "HypoTestInverter::RunFixedScan - parallel scans with several processes are not supported on Windows, running in a single process." << std::endl;
+   for (double x : xValues) {
+      if (!RunOnePoint(x))
+         oocoutW((TObject*)0,Eval) << "HypoTestInverter::RunFixedScan - The hypo test for point " << x << " failed. Skipping." << std::endl;
+   }
+#else
+   std::vector<std::pair<double, UInt_t>> tasks;
+   for (double x : xValues)
+      tasks.emplace_back(x, RooRandom::randomGenerator()->Integer(TMath::Limits<unsigned int>::Max()));
+
+   const unsigned int nWorkers = std::min<unsigned int>(fNWorkers, tasks.size());
+   ROOT::TProcessExecutor executor(nWorkers);
+   auto results = executor.Map([this](const std::pair<double, UInt_t> &task) {
+      RooRandom::randomGenerator()->SetSeed(task.second);
+      double rVal = task.first;
+      return EvalPoint(rVal, false, -1);
+   }, tasks);
+
+   for (std::size_t i = 0; i < results.size(); ++i) {
+      HypoTestResult *result = results[i];
+      // the clamping done by the workers is repeated here to get the value they ran at
+      double rVal = std::min(std::max(tasks[i].first, fScannedVariable->getMin()), fScannedVariable->getMax());
+      if (!result) {
+         oocoutW((TObject*)0,Eval) << "HypoTestInverter::RunFixedScan - The hypo test for point " << tasks[i].first << " failed. Skipping." << std::endl;
+         continue;
+      }
+      // the toys were counted by the workers
+      if ((fCalcType == kFrequentist || fCalcType == kHybrid) && result->GetNullDistribution() && result->GetAltDistribution())
+         fTotalToysRun += (result->GetAltDistribution()->GetSize() + result->GetNullDistribution()->GetSize());
+      AddPointResult(rVal, result);
+   }
+#endif
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// run only one point at the given POI value
 
@@ -672,6 +732,20 @@ bool HypoTestInverter::RunOnePoint( double rVal, bool adaptive, double clTarget)
 
    CreateResults();
 
+   HypoTestResult * result = EvalPoint(rVal, adaptive, clTarget);
+   if (!result) return false;
+
+   AddPointResult(rVal, result);
+   return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Run the test at the given POI value, moved within the range of the scanned variable if needed.
+/// Return the result, owned by the caller, or a null pointer if the test failed or its p-values
+/// are invalid. The value of the scanned variable is restored.
+
+HypoTestResult * HypoTestInverter::EvalPoint( double &rVal, bool adaptive, double clTarget) const
+{
    // check if rVal is in the range specified for fScannedVariable
    if ( rVal < fScannedVariable->getMin() ) {
       oocoutE((TObject*)0,InputArguments) << "HypoTestInverter::RunOnePoint - Out of range: using the lower bound "
@@ -709,7 +783,8 @@ bool HypoTestInverter::RunOnePoint( double rVal, bool adaptive, double clTarget)
    if (!result) {
       oocoutE((TObject*)0,Eval) << "HypoTestInverter - Error running point " << fScannedVariable->GetName() << " = " <<
    fScannedVariable->getVal() << endl;
-      return false;
+      fScannedVariable->setVal(oldValue);
+      return nullptr;
    }
    // in case of a dummy result
    const double nullPV = result->NullPValue();
@@ -717,9 +792,23 @@ bool HypoTestInverter::RunOnePoint( double rVal, bool adaptive, double clTarget)
    if (!std::isfinite(nullPV) || nullPV < 0. || nullPV > 1. || !std::isfinite(altPV) || altPV < 0. || altPV > 1.) {
       oocoutW((TObject*)0,Eval) << "HypoTestInverter - Skipping invalid result for  point " << fScannedVariable->GetName() << " = " <<
          fScannedVariable->getVal() << ". null p-value=" << nullPV << ", alternate p-value=" << altPV << endl;
-      return false;
+      fScannedVariable->setVal(oldValue);
+      return nullptr;
    }
 
+   fScannedVariable->setVal(oldValue);
+
+   return result.release();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Add the result of the test at rVal, taking its ownership. It is merged with the result
+/// of the last point if that was run at the same value.
+
+void HypoTestInverter::AddPointResult( double rVal, HypoTestResult * hypoResult) const
+{
+   std::unique_ptr<HypoTestResult> result(hypoResult);
+
    double lastXtested;
    if ( fResults->ArraySize()!=0 ) lastXtested = fResults->GetXValue(fResults->ArraySize()-1);
    else lastXtested = -999;
@@ -749,10 +838,6 @@ bool HypoTestInverter::RunOnePoint( double rVal, bool adaptive, double clTarget)
      fResults->fYObjects.Add(result.release());
 
    }
-
-   fScannedVariable->setVal(oldValue);
-
-   return true;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
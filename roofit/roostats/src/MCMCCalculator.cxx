@@ -48,6 +48,10 @@
 #include "RooStats/PdfProposal.h"
 #include "RooProdPdf.h"
 
+#include <map>
+#include <string>
+#include <vector>
+
 ClassImp(RooStats::MCMCCalculator);
 
 using namespace RooFit;
@@ -74,6 +78,8 @@ MCMCCalculator::MCMCCalculator() :
    fLeftSideTF = -1;
    fEpsilon = -1;
    fDelta = -1;
+   fNumChains = 1;
+   fNWorkers = 1;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -127,6 +133,8 @@ void MCMCCalculator::SetupBasicUsage()
    fLeftSideTF = -1;
    fEpsilon = -1;
    fDelta = -1;
+   fNumChains = 1;
+   fNWorkers = 1;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -196,14 +204,50 @@ MCMCInterval* MCMCCalculator::GetInterval() const
    mh.SetProposalFunction(*fPropFunc);
    mh.SetNumIters(fNumIters);
 
-   MarkovChain* chain = mh.ConstructChain();
+   MarkovChain* chain = nullptr;
+   std::map<std::string, Double_t> rHats;
+   if (fNumChains > 1) {
+      mh.SetNumChains(fNumChains);
+      mh.SetNWorkers(fNWorkers);
+      std::vector<MarkovChain*> chains = mh.ConstructChains();
+      if (!chains.empty()) {
+         // the burn-in steps of every chain are discarded here, the interval gets them all
+         chain = new MarkovChain();
+         for (MarkovChain* c : chains)
+            chain->AddWithBurnIn(*c, fNumBurnInSteps);
+
+         const std::vector<const MarkovChain*> constChains(chains.begin(), chains.end());
+         const RooArgSet& chainParams = (fChainParams.getSize() > 0) ? fChainParams : *params;
+         for (RooAbsArg* arg : chainParams) {
+            if (!constChains[0]->Get(0)->find(arg->GetName())) continue;
+            const Double_t rHat = MarkovChain::GelmanRubin(constChains, arg->GetName(), fNumBurnInSteps);
+            rHats[arg->GetName()] = rHat;
+            if (rHat > 1.1)
+               coutW(Eval) << "MCMCCalculator::GetInterval: the chains did not converge for "
+                           << arg->GetName() << ", R-hat = " << rHat << endl;
+         }
+         for (MarkovChain* c : chains) delete c;
+      }
+   } else {
+      chain = mh.ConstructChain();
+   }
+   if (!chain) {
+      coutE(Eval) << "MCMCCalculator::GetInterval: could not construct the Markov chain" << endl;
+      if (useDefaultPropFunc) delete fPropFunc;
+      if (usePriorPdf) delete prodPdf;
+      delete nll;
+      delete params;
+      return NULL;
+   }
 
    TString name = TString("MCMCInterval_") + TString(GetName() );
    MCMCInterval* interval = new MCMCInterval(name, fPOI, *chain);
    if (fAxes != NULL)
       interval->SetAxes(*fAxes);
-   if (fNumBurnInSteps > 0)
+   if (fNumBurnInSteps > 0 && fNumChains <= 1)
       interval->SetNumBurnInSteps(fNumBurnInSteps);
+   for (const auto& rHat : rHats)
+      interval->SetRHat(rHat.first.c_str(), rHat.second);
    interval->SetUseKeys(fUseKeys);
    interval->SetUseSparseHist(fUseSparseHist);
    interval->SetIntervalType(fIntervalType);
@@ -28,6 +28,11 @@ MarkovChain.
 #include "RooStats/RooStatsUtils.h"
 #include "RooDataHist.h"
 #include "THnSparse.h"
+#include "RooMsgService.h"
+#include "RooNumber.h"
+
+#include <algorithm>
+#include <cmath>
 
 using namespace std;
 
@@ -286,3 +291,61 @@ Double_t MarkovChain::Weight(Int_t i) const
    fChain->get(i);
    return fChain->weight();
 }
+
+////////////////////////////////////////////////////////////////////////////////
+/// Compute the Gelman-Rubin potential scale reduction factor of a parameter, comparing
+/// the variance of the parameter within each chain to its variance between the chains.
+/// The chains must have been run independently, from dispersed starting points; values
+/// close to 1 (typically below 1.1) indicate that they converged to the same distribution.
+/// The weights of the entries count as the number of steps spent at that point, and the
+/// first burnIn entries of each chain are discarded, as in AddWithBurnIn().
+/// Return -1 if there are less than two chains with at least two steps each.
+
+Double_t MarkovChain::GelmanRubin(const std::vector<const MarkovChain*>& chains, const char* paramName, Int_t burnIn)
+{
+   std::vector<Double_t> means;
+   std::vector<Double_t> variances;
+   Double_t totSteps = 0;
+   for (const MarkovChain* chain : chains) {
+      if (!chain || chain->Size() <= burnIn) continue;
+      // the data set loads every entry into the same set of variables
+      const RooAbsReal* var = dynamic_cast<const RooAbsReal*>(chain->Get(0)->find(paramName));
+      if (!var) {
+         oocoutE((TObject*)0, InputArguments) << "MarkovChain::GelmanRubin - chain has no parameter "
+                                              << paramName << std::endl;
+         return -1;
+      }
+      Double_t sumW = 0, sumWX = 0, sumWX2 = 0;
+      for (Int_t i = std::max(burnIn, 0); i < chain->Size(); i++) {
+         chain->Get(i);
+         const Double_t w = chain->Weight();
+         const Double_t x = var->getVal();
+         sumW += w;
+         sumWX += w * x;
+         sumWX2 += w * x * x;
+      }
+      if (sumW < 2) continue;
+      const Double_t mean = sumWX / sumW;
+      means.push_back(mean);
+      variances.push_back((sumWX2 - sumW * mean * mean) / (sumW - 1));
+      totSteps += sumW;
+   }
+
+   const std::size_t nChains = means.size();
+   if (nChains < 2) return -1;
+
+   // the chains have about the same length: use the average one
+   const Double_t n = totSteps / nChains;
+   Double_t grandMean = 0, within = 0;
+   for (std::size_t j = 0; j < nChains; j++) {
+      grandMean += means[j] / nChains;
+      within += variances[j] / nChains;
+   }
+   Double_t betweenOverN = 0;
+   for (std::size_t j = 0; j < nChains; j++)
+      betweenOverN += (means[j] - grandMean) * (means[j] - grandMean) / (nChains - 1);
+
+   if (within <= 0) return (betweenOverN > 0) ? RooNumber::infinity() : 1.;
+   const Double_t varEstimate = (n - 1) / n * within + betweenOverN;
+   return std::sqrt(varEstimate / within);
+}
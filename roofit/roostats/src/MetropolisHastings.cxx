@@ -38,6 +38,11 @@ a MarkovChain.
 Also note that in ConstructChain(), the values of the variables are randomized
 uniformly over their intervals before construction of the MarkovChain begins.
 
+ConstructChains() runs SetNumChains() such independent chains, optionally in
+SetNWorkers() processes forked from the current one: their starting points are
+dispersed over the parameter space, as needed to check their convergence with
+MarkovChain::GelmanRubin().
+
 */
 
 #include "RooStats/MetropolisHastings.h"
@@ -59,6 +64,13 @@ uniformly over their intervals before construction of the MarkovChain begins.
 #include "TMath.h"
 #include "TFile.h"
 
+#include "RConfig.h" // for R__WIN32
+#ifndef R__WIN32
+#include "ROOT/TProcessExecutor.hxx"
+#endif
+
+#include <algorithm>
+
 ClassImp(RooStats::MetropolisHastings);
 
 using namespace RooFit;
@@ -259,6 +271,45 @@ MarkovChain* MetropolisHastings::ConstructChain()
    return chain;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Run fNumChains chains of fNumIters iterations. Each chain gets a seed for the random
+/// generator drawn here, so that the chains are reproducible for a given seed whatever the
+/// number of worker processes. The chains that failed are not returned.
+
+std::vector<MarkovChain*> MetropolisHastings::ConstructChains()
+{
+   std::vector<UInt_t> seeds;
+   for (UInt_t i = 0; i < std::max(fNumChains, 1u); i++)
+      seeds.push_back(RooRandom::randomGenerator()->Integer(TMath::Limits<unsigned int>::Max()));
+
+   std::vector<MarkovChain*> chains;
+#ifndef R__WIN32
+   if (fNWorkers > 1 && seeds.size() > 1) {
+      ROOT::TProcessExecutor executor(std::min<UInt_t>(fNWorkers, seeds.size()));
+      chains = executor.Map([this](UInt_t seed) {
+         RooRandom::randomGenerator()->SetSeed(seed);
+         return ConstructChain();
+      }, seeds);
+   } else
+#else
+   if (fNWorkers > 1)
+      coutW(Eval) << "MetropolisHastings::ConstructChains - parallel runs with several processes are "
+                  << "not supported on Windows, running in a single process." << endl;
+#endif
+   {
+      for (UInt_t seed : seeds) {
+         RooRandom::randomGenerator()->SetSeed(seed);
+         chains.push_back(ConstructChain());
+      }
+   }
+
+   chains.erase(std::remove(chains.begin(), chains.end(), nullptr), chains.end());
+   if (chains.size() < seeds.size())
+      coutE(Eval) << "MetropolisHastings::ConstructChains - " << seeds.size() - chains.size()
+                  << " of the " << seeds.size() << " chains failed" << endl;
+   return chains;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 
 Bool_t MetropolisHastings::ShouldTakeStep(Double_t a)
@@ -27,6 +27,12 @@ TestStatistic.
 For parallel runs, ToyMCSampler can be given an instance of ProofConfig
 and then run in parallel using proof or proof-lite. Internally, it uses
 ToyMCStudy with the RooStudyManager.
+
+Alternatively, the toys can be generated and evaluated by several worker
+processes forked from the current process, see SetNWorkers(). Each worker
+works on its own copy of the models, seeds the random generator with a number
+drawn in the current process, and the sampling distributions of the workers
+are merged.
 */
 
 #include "RooStats/ToyMCSampler.h"
@@ -50,6 +56,14 @@ ToyMCStudy with the RooStudyManager.
 
 #include "TMath.h"
 
+#include "RConfig.h" // for R__WIN32
+#ifndef R__WIN32
+#include "ROOT/TProcessExecutor.hxx"
+#endif
+
+#include <algorithm>
+#include <utility>
+#include <vector>
 
 using namespace RooFit;
 using namespace std;
@@ -172,6 +186,7 @@ ToyMCSampler::ToyMCSampler() : fSamplingDistName("SD"), fNToys(1)
    fProtoData = NULL;
 
    fProofConfig = NULL;
+   fNWorkers = 1;
    fNuisanceParametersSampler = NULL;
 
    //suppress messages for num integration of Roofit
@@ -205,6 +220,7 @@ ToyMCSampler::ToyMCSampler(TestStatistic &ts, Int_t ntoys) : fSamplingDistName(t
    fProtoData = NULL;
 
    fProofConfig = NULL;
+   fNWorkers = 1;
    fNuisanceParametersSampler = NULL;
 
    //suppress messages for num integration of Roofit
@@ -310,9 +326,13 @@ RooDataSet* ToyMCSampler::GetSamplingDistributions(RooArgSet& paramPointIn)
 {
 
    // ======= S I N G L E   R U N ? =======
-   if(!fProofConfig)
+   if(!fProofConfig && fNWorkers <= 1)
       return GetSamplingDistributionsSingleWorker(paramPointIn);
 
+   // ======= M U L T I - P R O C E S S   R U N ? =======
+   if(!fProofConfig)
+      return GetSamplingDistributionsMultiProcess(paramPointIn);
+
    // ======= P A R A L L E L   R U N =======
    if (!CheckConfig()){
       oocoutE((TObject*)NULL, InputArguments)
@@ -353,6 +373,71 @@ RooDataSet* ToyMCSampler::GetSamplingDistributions(RooArgSet& paramPointIn)
    return output;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Split the toys over the worker processes set with SetNWorkers(), and merge
+/// their sampling distributions in the order of the workers. The workers are
+/// forked from the current process, so each of them runs
+/// GetSamplingDistributionsSingleWorker() on its own copy of the models.
+
+RooDataSet* ToyMCSampler::GetSamplingDistributionsMultiProcess(RooArgSet& paramPointIn)
+{
+#ifdef R__WIN32
+   oocoutW((TObject*)NULL, InputArguments)
+      << "ToyMCSampler: parallel runs with several processes are not supported on Windows, running in a single process."
+      << endl;
+   return GetSamplingDistributionsSingleWorker(paramPointIn);
+#else
+   if (!CheckConfig()){
+      oocoutE((TObject*)NULL, InputArguments)
+         << "Bad COnfiguration in ToyMCSampler "
+         << endl;
+      return nullptr;
+   }
+
+   // adaptive sampling needs the toys of all workers to decide when to stop
+   const Double_t toysInTails = fToysInTails;
+   if(fToysInTails) {
+      fToysInTails = 0;
+      oocoutW((TObject*)NULL, InputArguments)
+         << "Adaptive sampling in ToyMCSampler is not supported for parallel runs."
+         << endl;
+   }
+
+   // split the toys over the workers, and give each of them a seed for the random generator
+   const Int_t totToys = fNToys;
+   const unsigned int nWorkers = std::max(1u, std::min<unsigned int>(fNWorkers, std::max(totToys, 1)));
+   std::vector<std::pair<Int_t, UInt_t>> tasks;
+   for (unsigned int i = 0; i < nWorkers; ++i) {
+      const Int_t nToys = totToys / nWorkers + (i < totToys % nWorkers ? 1 : 0);
+      tasks.emplace_back(nToys, RooRandom::randomGenerator()->Integer(TMath::Limits<unsigned int>::Max()));
+   }
+
+   ROOT::TProcessExecutor executor(nWorkers);
+   auto results = executor.Map([this, &paramPointIn](const std::pair<Int_t, UInt_t> &task) {
+      RooRandom::randomGenerator()->SetSeed(task.second);
+      fNToys = task.first;
+      return GetSamplingDistributionsSingleWorker(paramPointIn);
+   }, tasks);
+
+   RooDataSet* output = nullptr;
+   for (RooDataSet* result : results) {
+      if (!result) {
+         oocoutE((TObject*)NULL, Generation) << "ToyMCSampler: a worker didn't return a sampling distribution." << endl;
+         continue;
+      }
+      if (!output) {
+         output = result;
+      } else {
+         output->append(*result);
+         delete result;
+      }
+   }
+
+   fToysInTails = toysInTails;
+   return output;
+#endif
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// This is the main function for serial runs. It is called automatically
 /// from inside GetSamplingDistribution when no ProofConfig is given.
@@ -0,0 +1,70 @@
+#include "RooStats/HypoTestInverter.h"
+#include "RooStats/HypoTestInverterResult.h"
+#include "RooStats/AsymptoticCalculator.h"
+#include "RooStats/ModelConfig.h"
+#include "RooWorkspace.h"
+#include "RooDataSet.h"
+#include "RooRealVar.h"
+
+#include "gtest/gtest.h"
+
+#include <memory>
+
+namespace {
+
+// A counting experiment with a known background, and the asymptotic calculator to scan the signal
+struct CountingModel {
+  RooWorkspace w{"w"};
+  RooStats::ModelConfig sbModel{"sbModel", &w};
+  RooStats::ModelConfig bModel{"bModel", &w};
+  std::unique_ptr<RooDataSet> data;
+
+  CountingModel()
+  {
+    w.factory("Poisson::pdf(n[5,0,100], sum::nexp(s[1,0,20], b[3]))");
+    RooRealVar &s = *w.var("s");
+    data.reset(new RooDataSet("data", "data", RooArgSet(*w.var("n"))));
+    data->add(RooArgSet(*w.var("n")));
+
+    sbModel.SetPdf("pdf");
+    sbModel.SetObservables("n");
+    sbModel.SetParametersOfInterest("s");
+    sbModel.SetSnapshot(RooArgSet(s));
+    bModel.SetPdf("pdf");
+    bModel.SetObservables("n");
+    bModel.SetParametersOfInterest("s");
+    s.setVal(0.);
+    bModel.SetSnapshot(RooArgSet(s));
+  }
+};
+
+std::unique_ptr<RooStats::HypoTestInverterResult> RunScan(unsigned int nWorkers)
+{
+  CountingModel model;
+  RooStats::AsymptoticCalculator calc(*model.data, model.bModel, model.sbModel);
+  calc.SetOneSided(true);
+  RooStats::HypoTestInverter inverter(calc);
+  inverter.SetConfidenceLevel(0.95);
+  inverter.UseCLs(true);
+  inverter.SetFixedScan(4, 1., 10.);
+  inverter.SetNWorkers(nWorkers);
+  EXPECT_EQ(inverter.GetNWorkers(), nWorkers);
+  return std::unique_ptr<RooStats::HypoTestInverterResult>(inverter.GetInterval());
+}
+
+} // anonymous namespace
+
+// The points of a fixed scan run by several processes are those of the sequential scan, in the same order.
+TEST(HypoTestInverter, ParallelFixedScan) {
+  auto sequential = RunScan(1);
+  auto parallel = RunScan(2);
+
+  ASSERT_NE(sequential, nullptr);
+  ASSERT_NE(parallel, nullptr);
+  ASSERT_EQ(sequential->ArraySize(), 4);
+  ASSERT_EQ(parallel->ArraySize(), 4);
+  for (int i = 0; i < sequential->ArraySize(); ++i) {
+    EXPECT_DOUBLE_EQ(parallel->GetXValue(i), sequential->GetXValue(i));
+    EXPECT_NEAR(parallel->CLs(i), sequential->CLs(i), 1.E-10);
+  }
+}
@@ -0,0 +1,43 @@
+#include "RooStats/MarkovChain.h"
+#include "RooRealVar.h"
+#include "RooArgSet.h"
+#include "TRandom3.h"
+
+#include "gtest/gtest.h"
+
+#include <memory>
+#include <vector>
+
+namespace {
+
+RooStats::MarkovChain *MakeChain(RooRealVar &x, double mean, unsigned int seed)
+{
+  TRandom3 rng(seed);
+  RooArgSet params(x);
+  auto chain = new RooStats::MarkovChain(params);
+  for (int i = 0; i < 2000; ++i) {
+    x.setVal(rng.Gaus(mean, 1.));
+    chain->Add(params, 0., 1. + (i % 3));
+  }
+  return chain;
+}
+
+} // anonymous namespace
+
+// Chains sampling the same distribution have an R-hat close to 1, chains stuck in different places do not.
+TEST(MarkovChain, GelmanRubin) {
+  RooRealVar x("x", "x", 0., -20., 20.);
+
+  std::unique_ptr<RooStats::MarkovChain> c1(MakeChain(x, 0., 1));
+  std::unique_ptr<RooStats::MarkovChain> c2(MakeChain(x, 0., 2));
+  std::unique_ptr<RooStats::MarkovChain> c3(MakeChain(x, 5., 3));
+
+  const double same = RooStats::MarkovChain::GelmanRubin({c1.get(), c2.get()}, "x", 100);
+  EXPECT_GT(same, 0.99);
+  EXPECT_LT(same, 1.01);
+
+  const double different = RooStats::MarkovChain::GelmanRubin({c1.get(), c2.get(), c3.get()}, "x");
+  EXPECT_GT(different, 1.5);
+
+  EXPECT_EQ(RooStats::MarkovChain::GelmanRubin({c1.get()}, "x"), -1.);
+}
@@ -0,0 +1,41 @@
+#include "RooStats/ToyMCSampler.h"
+#include "RooStats/ProfileLikelihoodTestStat.h"
+#include "RooStats/SamplingDistribution.h"
+#include "RooRealVar.h"
+#include "RooGaussian.h"
+#include "RooRandom.h"
+
+#include "gtest/gtest.h"
+
+#include <memory>
+
+// The toys split over several processes are as many as requested, and reproducible for a given seed.
+TEST(ToyMCSampler, MultiProcess) {
+  RooRealVar x("x", "observable", 0., -10., 10.);
+  RooRealVar m("m", "mean", 0., -5., 5.);
+  RooRealVar s("s", "sigma", 1.);
+  RooGaussian gaus("gaus", "gaus", x, m, s);
+
+  RooStats::ProfileLikelihoodTestStat testStat(gaus);
+  RooStats::ToyMCSampler sampler(testStat, 20);
+  sampler.SetPdf(gaus);
+  sampler.SetObservables(RooArgSet(x));
+  sampler.SetParametersForTestStat(RooArgSet(m));
+  sampler.SetNEventsPerToy(100);
+  sampler.SetNWorkers(2);
+  EXPECT_EQ(sampler.GetNWorkers(), 2u);
+
+  RooArgSet point(m);
+  RooRandom::randomGenerator()->SetSeed(1234);
+  std::unique_ptr<RooStats::SamplingDistribution> dist1(sampler.GetSamplingDistribution(point));
+  RooRandom::randomGenerator()->SetSeed(1234);
+  std::unique_ptr<RooStats::SamplingDistribution> dist2(sampler.GetSamplingDistribution(point));
+
+  ASSERT_NE(dist1, nullptr);
+  ASSERT_NE(dist2, nullptr);
+  ASSERT_EQ(dist1->GetSize(), 20);
+  ASSERT_EQ(dist2->GetSize(), 20);
+  for (int i = 0; i < dist1->GetSize(); ++i) {
+    EXPECT_DOUBLE_EQ(dist1->GetSamplingDistribution()[i], dist2->GetSamplingDistribution()[i]);
+  }
+}
@@ -89,6 +89,8 @@ public:
    using TSQLStatement::GetTimestamp;
    Bool_t      GetTimestamp(Int_t npar, Int_t& year, Int_t& month, Int_t& day, Int_t& hour, Int_t& min, Int_t& sec, Int_t&) final;
 
+   Int_t       FetchRows(std::vector<TSQLColumnBuffer> &columns, Int_t maxrows) final;
+
    ClassDefOverride(TSQLiteStatement, 0);  // SQL statement class for SQLite DB
 };
 
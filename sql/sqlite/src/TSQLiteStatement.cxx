@@ -367,6 +367,53 @@ const char *TSQLiteStatement::GetString(Int_t npar)
    return reinterpret_cast<const char *>(sqlite3_column_text(fStmt->fRes, npar));
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Fetch up to maxrows next rows of the result set into the column buffers.
+/// The fields are checked once, the values are then read directly from the
+/// SQLite statement without the checks of the single value getters.
+/// Returns the number of fetched rows, 0 when the result set is exhausted or on error.
+
+Int_t TSQLiteStatement::FetchRows(std::vector<TSQLColumnBuffer> &columns, Int_t maxrows)
+{
+   ClearError();
+
+   for (auto &col : columns)
+      col.Clear();
+
+   if (!fStmt || !IsResultSetMode()) {
+      SetError(-1, "Cannot get statement parameters", "FetchRows");
+      return 0;
+   }
+
+   for (auto &col : columns) {
+      if ((col.fField < 0) || (col.fField >= fNumPars)) {
+         SetError(-1, Form("Invalid parameter number %d", col.fField), "FetchRows");
+         return 0;
+      }
+   }
+
+   sqlite3_stmt *res = fStmt->fRes;
+   Int_t nrows = 0;
+   while ((nrows < maxrows) && TSQLiteStatement::NextResultRow()) {
+      for (auto &col : columns) {
+         switch (col.fType) {
+         case TSQLColumnBuffer::kLong64: col.fLong64.push_back(sqlite3_column_int64(res, col.fField)); break;
+         case TSQLColumnBuffer::kDouble: col.fDouble.push_back(sqlite3_column_double(res, col.fField)); break;
+         case TSQLColumnBuffer::kString: {
+            auto str = reinterpret_cast<const char *>(sqlite3_column_text(res, col.fField));
+            if (str)
+               col.fString.emplace_back(str, sqlite3_column_bytes(res, col.fField));
+            else
+               col.fString.emplace_back();
+            break;
+         }
+         }
+      }
+      nrows++;
+   }
+   return nrows;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Return field value as binary array.
 /// Memory at 'mem' will be reallocated and size updated
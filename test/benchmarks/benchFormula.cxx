@@ -0,0 +1,51 @@
+// Microbenchmarks of evaluating TFormula and TF1
+
+#include "TF1.h"
+#include "TFormula.h"
+
+#include "benchmark/benchmark.h"
+
+static void BM_TFormula_Eval(benchmark::State &state)
+{
+   TFormula f("f", "[0] + [1] * x + [2] * x * x + sin(x)");
+   f.SetParameters(1., 2., 3.);
+   double sum = 0;
+   double x = 0;
+   for (auto _ : state) {
+      sum += f.Eval(x);
+      x += 1e-6;
+   }
+   benchmark::DoNotOptimize(sum);
+   state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_TFormula_Eval);
+
+static void BM_TFormula_EvalPar(benchmark::State &state)
+{
+   TFormula f("f", "[0] * exp(-0.5 * ((x - [1]) / [2])^2)");
+   const double params[] = {1., 0., 1.};
+   double sum = 0;
+   double x[] = {0.};
+   for (auto _ : state) {
+      sum += f.EvalPar(x, params);
+      x[0] += 1e-6;
+   }
+   benchmark::DoNotOptimize(sum);
+   state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_TFormula_EvalPar);
+
+static void BM_TF1_Gaus(benchmark::State &state)
+{
+   TF1 f("f", "gaus", -5, 5);
+   f.SetParameters(1., 0., 1.);
+   double sum = 0;
+   double x = -5;
+   for (auto _ : state) {
+      sum += f.Eval(x);
+      x += 1e-6;
+   }
+   benchmark::DoNotOptimize(sum);
+   state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_TF1_Gaus);
@@ -0,0 +1,74 @@
+// Microbenchmarks of filling histograms
+
+#include "TH1D.h"
+#include "TH2D.h"
+#include "TRandom3.h"
+
+#include "benchmark/benchmark.h"
+
+#include <vector>
+
+namespace {
+
+std::vector<double> RandomValues(std::size_t n, unsigned int seed)
+{
+   TRandom3 rnd(seed);
+   std::vector<double> values(n);
+   for (auto &v : values)
+      v = rnd.Gaus();
+   return values;
+}
+
+} // anonymous namespace
+
+static void BM_TH1D_Fill(benchmark::State &state)
+{
+   TH1D h("h", "h", state.range(0), -5, 5);
+   h.SetDirectory(nullptr);
+   const auto values = RandomValues(1 << 16, 1);
+   for (auto _ : state) {
+      for (auto v : values)
+         h.Fill(v);
+   }
+   state.SetItemsProcessed(state.iterations() * values.size());
+}
+BENCHMARK(BM_TH1D_Fill)->Arg(100)->Arg(10000);
+
+static void BM_TH1D_FillN(benchmark::State &state)
+{
+   TH1D h("h", "h", state.range(0), -5, 5);
+   h.SetDirectory(nullptr);
+   const auto values = RandomValues(1 << 16, 1);
+   for (auto _ : state)
+      h.FillN(values.size(), values.data(), nullptr);
+   state.SetItemsProcessed(state.iterations() * values.size());
+}
+BENCHMARK(BM_TH1D_FillN)->Arg(100)->Arg(10000);
+
+static void BM_TH1D_FillWeighted(benchmark::State &state)
+{
+   TH1D h("h", "h", 100, -5, 5);
+   h.SetDirectory(nullptr);
+   h.Sumw2();
+   const auto values = RandomValues(1 << 16, 1);
+   for (auto _ : state) {
+      for (auto v : values)
+         h.Fill(v, 0.5);
+   }
+   state.SetItemsProcessed(state.iterations() * values.size());
+}
+BENCHMARK(BM_TH1D_FillWeighted);
+
+static void BM_TH2D_Fill(benchmark::State &state)
+{
+   TH2D h("h", "h", 100, -5, 5, 100, -5, 5);
+   h.SetDirectory(nullptr);
+   const auto x = RandomValues(1 << 16, 1);
+   const auto y = RandomValues(1 << 16, 2);
+   for (auto _ : state) {
+      for (std::size_t i = 0; i < x.size(); ++i)
+         h.Fill(x[i], y[i]);
+   }
+   state.SetItemsProcessed(state.iterations() * x.size());
+}
+BENCHMARK(BM_TH2D_Fill);
@@ -0,0 +1,46 @@
+// Microbenchmarks of minimizations with Minuit2
+
+#include "Minuit2/FCNBase.h"
+#include "Minuit2/FunctionMinimum.h"
+#include "Minuit2/MnMigrad.h"
+#include "Minuit2/MnUserParameters.h"
+
+#include "benchmark/benchmark.h"
+
+#include <string>
+#include <vector>
+
+namespace {
+
+/// The Rosenbrock function generalized to N dimensions, with its minimum 0 at (1, ..., 1)
+class RosenbrockFCN : public ROOT::Minuit2::FCNBase {
+public:
+   double operator()(const std::vector<double> &x) const override
+   {
+      double result = 0;
+      for (std::size_t i = 0; i + 1 < x.size(); ++i) {
+         const double a = x[i + 1] - x[i] * x[i];
+         const double b = 1. - x[i];
+         result += 100. * a * a + b * b;
+      }
+      return result;
+   }
+   double Up() const override { return 1.; }
+};
+
+} // anonymous namespace
+
+static void BM_Minuit2_Migrad(benchmark::State &state)
+{
+   const int nDim = state.range(0);
+   RosenbrockFCN fcn;
+   for (auto _ : state) {
+      ROOT::Minuit2::MnUserParameters params;
+      for (int i = 0; i < nDim; ++i)
+         params.Add("x" + std::to_string(i), -1., 0.1);
+      ROOT::Minuit2::MnMigrad migrad(fcn, params);
+      auto minimum = migrad();
+      benchmark::DoNotOptimize(minimum.Fval());
+   }
+}
+BENCHMARK(BM_Minuit2_Migrad)->Arg(2)->Arg(10)->Arg(50)->Unit(benchmark::kMillisecond);
@@ -0,0 +1,68 @@
+// Microbenchmarks of the overhead of the RDataFrame computation graph
+
+#include "ROOT/RDataFrame.hxx"
+#include "TROOT.h"
+
+#include "benchmark/benchmark.h"
+
+#include <string>
+
+namespace {
+
+constexpr ULong64_t kNEntries = 1000000;
+
+} // anonymous namespace
+
+static void BM_RDataFrame_EmptyLoop(benchmark::State &state)
+{
+   for (auto _ : state) {
+      ROOT::RDataFrame df(kNEntries);
+      benchmark::DoNotOptimize(*df.Count());
+   }
+   state.SetItemsProcessed(state.iterations() * kNEntries);
+}
+BENCHMARK(BM_RDataFrame_EmptyLoop)->Unit(benchmark::kMillisecond);
+
+static void BM_RDataFrame_DefineChain(benchmark::State &state)
+{
+   const int nDefines = state.range(0);
+   for (auto _ : state) {
+      ROOT::RDataFrame df(kNEntries);
+      ROOT::RDF::RNode node = df.Define("x0", [](ULong64_t e) { return double(e); }, {"rdfentry_"});
+      for (int i = 1; i < nDefines; ++i) {
+         node = node.Define("x" + std::to_string(i), [](double x) { return 0.5 * x + 1.; },
+                            {"x" + std::to_string(i - 1)});
+      }
+      benchmark::DoNotOptimize(*node.Sum<double>("x" + std::to_string(nDefines - 1)));
+   }
+   state.SetItemsProcessed(state.iterations() * kNEntries);
+}
+BENCHMARK(BM_RDataFrame_DefineChain)->Arg(1)->Arg(10)->Arg(50)->Unit(benchmark::kMillisecond);
+
+static void BM_RDataFrame_FilterHisto(benchmark::State &state)
+{
+   for (auto _ : state) {
+      ROOT::RDataFrame df(kNEntries);
+      auto h = df.Define("x", [](ULong64_t e) { return double(e % 100); }, {"rdfentry_"})
+                  .Filter([](double x) { return x > 10.; }, {"x"})
+                  .Histo1D<double>({"h", "h", 100, 0., 100.}, "x");
+      benchmark::DoNotOptimize(h->GetEntries());
+   }
+   state.SetItemsProcessed(state.iterations() * kNEntries);
+}
+BENCHMARK(BM_RDataFrame_FilterHisto)->Unit(benchmark::kMillisecond);
+
+#ifdef R__USE_IMT
+static void BM_RDataFrame_MTScaling(benchmark::State &state)
+{
+   ROOT::EnableImplicitMT(state.range(0));
+   for (auto _ : state) {
+      ROOT::RDataFrame df(10 * kNEntries);
+      auto sum = df.Define("x", [](ULong64_t e) { return double(e % 100); }, {"rdfentry_"}).Sum<double>("x");
+      benchmark::DoNotOptimize(*sum);
+   }
+   ROOT::DisableImplicitMT();
+   state.SetItemsProcessed(state.iterations() * 10 * kNEntries);
+}
+BENCHMARK(BM_RDataFrame_MTScaling)->RangeMultiplier(2)->Range(1, 16)->UseRealTime()->Unit(benchmark::kMillisecond);
+#endif
@@ -0,0 +1,81 @@
+// Microbenchmarks of writing and reading an RNTuple
+
+#include "ROOT/RNTuple.hxx"
+#include "ROOT/RNTupleModel.hxx"
+#include "ROOT/RNTupleOptions.hxx"
+#include "TRandom3.h"
+
+#include "benchmark/benchmark.h"
+
+#include <cstdio>
+#include <string>
+#include <vector>
+
+using ROOT::Experimental::RNTupleModel;
+using ROOT::Experimental::RNTupleReader;
+using ROOT::Experimental::RNTupleWriteOptions;
+using ROOT::Experimental::RNTupleWriter;
+
+namespace {
+
+constexpr int kNEntries = 100000;
+
+std::string FileName(int compression)
+{
+   return "benchRNTupleIO_" + std::to_string(compression) + ".root";
+}
+
+void WriteNTuple(int compression)
+{
+   auto model = RNTupleModel::Create();
+   auto px = model->MakeField<float>("px");
+   auto py = model->MakeField<float>("py");
+   auto n = model->MakeField<int>("n");
+   auto values = model->MakeField<std::vector<double>>("values");
+   RNTupleWriteOptions options;
+   options.SetCompression(compression);
+   auto writer = RNTupleWriter::Recreate(std::move(model), "ntuple", FileName(compression), options);
+   TRandom3 rnd(1);
+   for (int i = 0; i < kNEntries; ++i) {
+      *px = rnd.Gaus();
+      *py = rnd.Gaus();
+      *n = i % 10;
+      values->resize(*n);
+      for (auto &v : *values)
+         v = rnd.Uniform();
+      writer->Fill();
+   }
+}
+
+} // anonymous namespace
+
+// The argument is the compression setting, 100 * algorithm + level
+static void BM_RNTuple_Write(benchmark::State &state)
+{
+   const int compression = state.range(0);
+   for (auto _ : state)
+      WriteNTuple(compression);
+   state.SetItemsProcessed(state.iterations() * kNEntries);
+   std::remove(FileName(compression).c_str());
+}
+BENCHMARK(BM_RNTuple_Write)->Arg(0)->Arg(101)->Arg(404)->Arg(505)->Unit(benchmark::kMillisecond);
+
+static void BM_RNTuple_Read(benchmark::State &state)
+{
+   const int compression = state.range(0);
+   WriteNTuple(compression);
+   for (auto _ : state) {
+      auto reader = RNTupleReader::Open("ntuple", FileName(compression));
+      auto px = reader->GetView<float>("px");
+      auto py = reader->GetView<float>("py");
+      auto n = reader->GetView<int>("n");
+      auto values = reader->GetView<std::vector<double>>("values");
+      double sum = 0;
+      for (auto i : reader->GetEntryRange())
+         sum += px(i) + py(i) + n(i) + values(i).size();
+      benchmark::DoNotOptimize(sum);
+   }
+   state.SetItemsProcessed(state.iterations() * kNEntries);
+   std::remove(FileName(compression).c_str());
+}
+BENCHMARK(BM_RNTuple_Read)->Arg(0)->Arg(101)->Arg(404)->Arg(505)->Unit(benchmark::kMillisecond);
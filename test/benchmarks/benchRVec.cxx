@@ -0,0 +1,75 @@
+// Microbenchmarks of the operations on ROOT::RVec
+
+#include "ROOT/RVec.hxx"
+
+#include "benchmark/benchmark.h"
+
+using ROOT::VecOps::RVec;
+
+namespace {
+
+RVec<double> MakeRVec(std::size_t n)
+{
+   RVec<double> v(n);
+   for (std::size_t i = 0; i < n; ++i)
+      v[i] = 0.5 * i - 10.;
+   return v;
+}
+
+} // anonymous namespace
+
+static void BM_RVec_Arithmetic(benchmark::State &state)
+{
+   const auto a = MakeRVec(state.range(0));
+   const auto b = MakeRVec(state.range(0));
+   for (auto _ : state) {
+      auto c = a * b + 2. * a;
+      benchmark::DoNotOptimize(c.data());
+   }
+   state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_RVec_Arithmetic)->Range(8, 8 << 10);
+
+static void BM_RVec_Mask(benchmark::State &state)
+{
+   const auto a = MakeRVec(state.range(0));
+   for (auto _ : state) {
+      auto c = a[a > 0. && a < 100.];
+      benchmark::DoNotOptimize(c.data());
+   }
+   state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_RVec_Mask)->Range(8, 8 << 10);
+
+static void BM_RVec_Math(benchmark::State &state)
+{
+   const auto a = MakeRVec(state.range(0));
+   for (auto _ : state) {
+      auto c = ROOT::VecOps::sqrt(ROOT::VecOps::abs(a)) + ROOT::VecOps::exp(-a * a);
+      benchmark::DoNotOptimize(c.data());
+   }
+   state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_RVec_Math)->Range(8, 8 << 10);
+
+static void BM_RVec_Reduce(benchmark::State &state)
+{
+   const auto a = MakeRVec(state.range(0));
+   for (auto _ : state) {
+      auto s = ROOT::VecOps::Sum(a) + ROOT::VecOps::Max(a) + ROOT::VecOps::Mean(a);
+      benchmark::DoNotOptimize(s);
+   }
+   state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_RVec_Reduce)->Range(8, 8 << 10);
+
+static void BM_RVec_Sort(benchmark::State &state)
+{
+   const auto a = ROOT::VecOps::Reverse(MakeRVec(state.range(0)));
+   for (auto _ : state) {
+      auto c = ROOT::VecOps::Sort(a);
+      benchmark::DoNotOptimize(c.data());
+   }
+   state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_RVec_Sort)->Range(8, 8 << 10);
@@ -0,0 +1,97 @@
+// Microbenchmarks of writing and reading a TTree with the different compression algorithms
+
+#include "Compression.h"
+#include "TFile.h"
+#include "TRandom3.h"
+#include "TTree.h"
+
+#include "benchmark/benchmark.h"
+
+#include <cstdio>
+#include <string>
+#include <vector>
+
+namespace {
+
+constexpr int kNEntries = 100000;
+
+std::string FileName(int algorithm)
+{
+   return "benchTreeIO_" + std::to_string(algorithm) + ".root";
+}
+
+void WriteTree(int algorithm)
+{
+   TFile file(FileName(algorithm).c_str(), "RECREATE");
+   file.SetCompressionAlgorithm(algorithm);
+   file.SetCompressionLevel(algorithm ? 1 : 0);
+   TTree tree("tree", "tree");
+   float px = 0, py = 0;
+   int n = 0;
+   std::vector<double> values;
+   tree.Branch("px", &px);
+   tree.Branch("py", &py);
+   tree.Branch("n", &n);
+   tree.Branch("values", &values);
+   TRandom3 rnd(1);
+   for (int i = 0; i < kNEntries; ++i) {
+      px = rnd.Gaus();
+      py = rnd.Gaus();
+      n = i % 10;
+      values.resize(n);
+      for (auto &v : values)
+         v = rnd.Uniform();
+      tree.Fill();
+   }
+   tree.Write();
+}
+
+// The algorithm 0 stands for uncompressed files
+void CompressionArgs(benchmark::internal::Benchmark *b)
+{
+   for (int algorithm : {0, (int)ROOT::RCompressionSetting::EAlgorithm::kZLIB,
+                         (int)ROOT::RCompressionSetting::EAlgorithm::kLZMA,
+                         (int)ROOT::RCompressionSetting::EAlgorithm::kLZ4,
+                         (int)ROOT::RCompressionSetting::EAlgorithm::kZSTD})
+      b->Arg(algorithm);
+}
+
+} // anonymous namespace
+
+static void BM_TTree_Write(benchmark::State &state)
+{
+   const int algorithm = state.range(0);
+   for (auto _ : state)
+      WriteTree(algorithm);
+   state.SetItemsProcessed(state.iterations() * kNEntries);
+   std::remove(FileName(algorithm).c_str());
+}
+BENCHMARK(BM_TTree_Write)->Apply(CompressionArgs)->Unit(benchmark::kMillisecond);
+
+static void BM_TTree_Read(benchmark::State &state)
+{
+   const int algorithm = state.range(0);
+   WriteTree(algorithm);
+   for (auto _ : state) {
+      TFile file(FileName(algorithm).c_str());
+      auto tree = file.Get<TTree>("tree");
+      float px = 0, py = 0;
+      int n = 0;
+      std::vector<double> *values = nullptr;
+      tree->SetBranchAddress("px", &px);
+      tree->SetBranchAddress("py", &py);
+      tree->SetBranchAddress("n", &n);
+      tree->SetBranchAddress("values", &values);
+      double sum = 0;
+      for (Long64_t i = 0; i < tree->GetEntries(); ++i) {
+         tree->GetEntry(i);
+         sum += px + py + n + values->size();
+      }
+      benchmark::DoNotOptimize(sum);
+      tree->ResetBranchAddresses();
+      delete values;
+   }
+   state.SetItemsProcessed(state.iterations() * kNEntries);
+   std::remove(FileName(algorithm).c_str());
+}
+BENCHMARK(BM_TTree_Read)->Apply(CompressionArgs)->Unit(benchmark::kMillisecond);
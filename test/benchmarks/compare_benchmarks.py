@@ -0,0 +1,98 @@
+#!/usr/bin/env python
+# Compares two sets of results of the ROOT microbenchmarks.
+
+################################################################################
+# Copyright (C) 1995-2021, Rene Brun and Fons Rademakers.                      #
+# All rights reserved.                                                         #
+#                                                                              #
+# For the licensing terms see $ROOTSYS/LICENSE.                                #
+# For the list of contributors see $ROOTSYS/README/CREDITS.                    #
+################################################################################
+
+"""
+Compare the results of the microbenchmarks of two ROOT builds, as written in
+JSON by `ctest -L benchmark` (i.e. with --benchmark_out_format=json).
+
+    compare_benchmarks.py [--threshold 0.1] [--time cpu_time] baseline current
+
+The arguments are result files or directories of result files, whose files are
+matched by name. The script prints the relative change of the time of every
+benchmark found in both sets, and exits with status 1 if one of them is slower
+than the baseline by more than the threshold. With repetitions, the median of
+the repetitions is compared.
+"""
+
+import argparse
+import json
+import os
+import sys
+
+_time_unit_factors = {"ns": 1., "us": 1e3, "ms": 1e6, "s": 1e9}
+
+
+def load_results(path, time_key):
+    """Returns a dict mapping the benchmark names to their time in nanoseconds."""
+    results = {}
+    with open(path) as f:
+        data = json.load(f)
+    for bench in data.get("benchmarks", []):
+        if bench.get("error_occurred"):
+            continue
+        name = bench.get("run_name", bench["name"])
+        if bench.get("run_type") == "aggregate":
+            if bench.get("aggregate_name") != "median":
+                continue
+        elif name in results:
+            # Repetitions without aggregates: keep the first one
+            continue
+        results[name] = bench[time_key] * _time_unit_factors[bench.get("time_unit", "ns")]
+    return results
+
+
+def collect(path, time_key):
+    if not os.path.isdir(path):
+        return {os.path.basename(path): load_results(path, time_key)}
+    return {f: load_results(os.path.join(path, f), time_key)
+            for f in sorted(os.listdir(path)) if f.endswith(".json")}
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Compare two sets of ROOT microbenchmark results")
+    parser.add_argument("baseline", help="JSON result file or directory of the reference build")
+    parser.add_argument("current", help="JSON result file or directory of the build to check")
+    parser.add_argument("--threshold", type=float, default=0.1,
+                        help="maximum tolerated relative slow down, default 0.1 (10%%)")
+    parser.add_argument("--time", choices=["real_time", "cpu_time"], default="cpu_time",
+                        help="time of the benchmarks to compare, default cpu_time")
+    args = parser.parse_args()
+
+    baseline = collect(args.baseline, args.time)
+    current = collect(args.current, args.time)
+    if os.path.isfile(args.baseline) and os.path.isfile(args.current):
+        # Explicit files are compared even if their names differ
+        baseline = {"": list(baseline.values())[0]}
+        current = {"": list(current.values())[0]}
+
+    regressions = []
+    for fname in sorted(set(baseline) & set(current)):
+        for name in sorted(set(baseline[fname]) & set(current[fname])):
+            ref = baseline[fname][name]
+            new = current[fname][name]
+            if ref <= 0:
+                continue
+            change = (new - ref) / ref
+            flag = ""
+            if change > args.threshold:
+                flag = "  REGRESSION"
+                regressions.append(name)
+            print("{:<60} {:>14.1f} ns {:>14.1f} ns {:>+8.1%}{}".format(name, ref, new, change, flag))
+
+    if regressions:
+        print("\n{} benchmark(s) slower than the baseline by more than {:.0%}".format(
+            len(regressions), args.threshold))
+        return 1
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
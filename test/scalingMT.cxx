@@ -0,0 +1,622 @@
+// @(#)root/test:$Id$
+
+/////////////////////////////////////////////////////////////////
+//
+//___Strong- and weak-scaling of multi-threaded analyses___
+//
+//   Runs an analysis workload with an increasing number of
+//   threads and reports how the processing time is spent.
+//   The input is a set of files with EventMT-style events,
+//   i.e. a variable number of tracks per event, which are
+//   generated on the first run as scalingMT_tree_<i>.root
+//   and scalingMT_ntuple_<i>.root in the working directory.
+//
+//   Can be run as:
+//     scalingMT [-w rdf|tpmt|ntuple] [-t 1,2,4,8] [-e entries] [-f files] [-o prefix]
+//
+//     -w  the workload: RDataFrame (default) or TTreeProcessorMT
+//         reading the TTrees, or RNTupleReaders reading the
+//         RNTuples in a TThreadExecutor
+//     -t  the thread counts of the sweep, by default 1, 2, 4, ...
+//         up to the number of cores
+//     -e  the number of events per file, by default 200000
+//     -f  the number of files, by default the largest thread count
+//     -o  the prefix of the report files, by default scalingMT
+//
+//   Strong scaling processes all the files with each thread
+//   count and weak scaling as many files as threads. The times
+//   of all the threads, i.e. the wall time multiplied by the
+//   number of threads, are broken down into:
+//     io               reading the files (TFile::ReadBuffer(s),
+//                      RNTuple timeWallRead)
+//     unzip            decompressing the baskets or pages
+//     deserialization  the remainder of the reading of the
+//                      entries (TTreeProcessorMT only)
+//     user             the analysis code in the user functions
+//     other            the remainder: framework overhead,
+//                      task scheduling and idle threads
+//   The I/O of the TTrees is measured by a TVirtualPerfStats
+//   per thread, that of the RNTuples by the RNTupleMetrics of
+//   the readers. The report is written in JSON to <prefix>.json,
+//   the speedups and breakdowns are drawn to <prefix>.pdf.
+//
+/////////////////////////////////////////////////////////////////
+
+#include <ROOT/RDataFrame.hxx>
+#include <ROOT/RNTuple.hxx>
+#include <ROOT/RNTupleMetrics.hxx>
+#include <ROOT/RNTupleModel.hxx>
+#include <ROOT/TThreadExecutor.hxx>
+#include <ROOT/TThreadedObject.hxx>
+#include <ROOT/TTreeProcessorMT.hxx>
+#include <TCanvas.h>
+#include <TFile.h>
+#include <TGraph.h>
+#include <TH1D.h>
+#include <THStack.h>
+#include <TLegend.h>
+#include <TMultiGraph.h>
+#include <TROOT.h>
+#include <TRandom3.h>
+#include <TSystem.h>
+#include <TTimeStamp.h>
+#include <TTree.h>
+#include <TTreeReader.h>
+#include <TTreeReaderArray.h>
+#include <TTreeReaderValue.h>
+#include <TVirtualPerfStats.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+using Clock_t = std::chrono::steady_clock;
+
+double SecondsSince(Clock_t::time_point start)
+{
+   return std::chrono::duration<double>(Clock_t::now() - start).count();
+}
+
+/// The times spent by a thread, in seconds
+struct ThreadTimes {
+   double fIO = 0;
+   double fUnzip = 0;
+   double fRead = 0;
+   double fUser = 0;
+
+   ThreadTimes &operator+=(const ThreadTimes &other)
+   {
+      fIO += other.fIO;
+      fUnzip += other.fUnzip;
+      fRead += other.fRead;
+      fUser += other.fUser;
+      return *this;
+   }
+   ThreadTimes operator-(const ThreadTimes &other) const
+   {
+      ThreadTimes result;
+      result.fIO = fIO - other.fIO;
+      result.fUnzip = fUnzip - other.fUnzip;
+      result.fRead = fRead - other.fRead;
+      result.fUser = fUser - other.fUser;
+      return result;
+   }
+};
+
+/// Collects the file read and unzip times of the thread it is installed on as gPerfStats, which is thread-local.
+/// The objects are never deleted: the worker threads may outlive a run and keep pointing to them.
+class ThreadPerfStats : public TVirtualPerfStats {
+public:
+   ThreadTimes fTimes;
+
+   void SetFile(TFile *) override {}
+   void SimpleEvent(EEventType) override {}
+   void PacketEvent(const char *, const char *, const char *, Long64_t, Double_t, Double_t, Double_t,
+                    Long64_t) override
+   {
+   }
+   void FileEvent(const char *, const char *, const char *, const char *, Bool_t) override {}
+   void FileOpenEvent(TFile *, const char *, Double_t) override {}
+   void FileReadEvent(TFile *, Int_t, Double_t start) override { fTimes.fIO += TTimeStamp().AsDouble() - start; }
+   void UnzipEvent(TObject *, Long64_t, Double_t start, Int_t, Int_t) override
+   {
+      fTimes.fUnzip += TTimeStamp().AsDouble() - start;
+   }
+   void RateEvent(Double_t, Double_t, Long64_t, Long64_t) override {}
+   void SetBytesRead(Long64_t) override {}
+   Long64_t GetBytesRead() const override { return 0; }
+   void SetNumEvents(Long64_t) override {}
+   Long64_t GetNumEvents() const override { return 0; }
+   void PrintBasketInfo(Option_t *) const override {}
+   void SetLoaded(TBranch *, size_t) override {}
+   void SetLoaded(size_t, size_t) override {}
+   void SetLoadedMiss(TBranch *, size_t) override {}
+   void SetLoadedMiss(size_t, size_t) override {}
+   void SetMissed(TBranch *, size_t) override {}
+   void SetMissed(size_t, size_t) override {}
+   void SetUsed(TBranch *, size_t) override {}
+   void SetUsed(size_t, size_t) override {}
+   void UpdateBranchIndices(TObjArray *) override {}
+};
+
+std::mutex gStatsLock;
+std::vector<ThreadPerfStats *> gAllStats;
+thread_local ThreadPerfStats *tStats = nullptr;
+
+/// Installs the perf stats of the calling thread if needed and returns them
+ThreadPerfStats &GetThreadStats()
+{
+   if (!tStats) {
+      tStats = new ThreadPerfStats;
+      gPerfStats = tStats;
+      std::lock_guard<std::mutex> guard(gStatsLock);
+      gAllStats.push_back(tStats);
+   }
+   return *tStats;
+}
+
+/// The sum of the times of all the threads; only called when no task is running
+ThreadTimes SumThreadTimes()
+{
+   ThreadTimes sum;
+   std::lock_guard<std::mutex> guard(gStatsLock);
+   for (auto stats : gAllStats)
+      sum += stats->fTimes;
+   return sum;
+}
+
+/// Accumulates the time spent in the analysis code to the thread that runs it
+template <typename F>
+auto TimeUser(F &&f) -> decltype(f())
+{
+   auto &stats = GetThreadStats();
+   const auto start = Clock_t::now();
+   auto result = f();
+   stats.fTimes.fUser += SecondsSince(start);
+   return result;
+}
+
+/// The sum of the RNTuple reader metrics whose names end with the given suffix, in seconds
+double SumNTupleTimes(const std::string &suffix)
+{
+   double sum = 0;
+   for (const auto &aggregate : ROOT::Experimental::Detail::RNTupleMetricsRegistry::Instance().GetAggregates()) {
+      const auto &name = aggregate.fName;
+      if (name.size() >= suffix.size() && name.compare(name.size() - suffix.size(), suffix.size(), suffix) == 0)
+         sum += aggregate.fValue * 1e-9;
+   }
+   return sum;
+}
+
+ThreadTimes GetNTupleTimes()
+{
+   ThreadTimes times;
+   times.fIO = SumNTupleTimes(".timeWallRead");
+   times.fUnzip = SumNTupleTimes(".timeWallUnzip");
+   return times;
+}
+
+std::string TreeFileName(int i)
+{
+   return "scalingMT_tree_" + std::to_string(i) + ".root";
+}
+
+std::string NTupleFileName(int i)
+{
+   return "scalingMT_ntuple_" + std::to_string(i) + ".root";
+}
+
+/// Writes the events of file i, with the same content for the TTree and the RNTuple
+void GenerateFile(int i, Long64_t nEntries)
+{
+   if (!gSystem->AccessPathName(TreeFileName(i).c_str()) && !gSystem->AccessPathName(NTupleFileName(i).c_str()))
+      return;
+
+   TFile file(TreeFileName(i).c_str(), "RECREATE");
+   TTree tree("events", "EventMT-style events");
+   int nTracks = 0;
+   double weight = 0;
+   std::vector<float> px, py, pz;
+   std::vector<int> charge;
+   tree.Branch("nTracks", &nTracks);
+   tree.Branch("weight", &weight);
+   tree.Branch("px", &px);
+   tree.Branch("py", &py);
+   tree.Branch("pz", &pz);
+   tree.Branch("charge", &charge);
+
+   auto model = ROOT::Experimental::RNTupleModel::Create();
+   auto ntNTracks = model->MakeField<int>("nTracks");
+   auto ntWeight = model->MakeField<double>("weight");
+   auto ntPx = model->MakeField<std::vector<float>>("px");
+   auto ntPy = model->MakeField<std::vector<float>>("py");
+   auto ntPz = model->MakeField<std::vector<float>>("pz");
+   auto ntCharge = model->MakeField<std::vector<int>>("charge");
+   auto writer = ROOT::Experimental::RNTupleWriter::Recreate(std::move(model), "events", NTupleFileName(i));
+
+   TRandom3 rnd(i + 1);
+   for (Long64_t e = 0; e < nEntries; ++e) {
+      nTracks = rnd.Poisson(20);
+      weight = rnd.Uniform(0.5, 1.5);
+      px.resize(nTracks);
+      py.resize(nTracks);
+      pz.resize(nTracks);
+      charge.resize(nTracks);
+      for (int t = 0; t < nTracks; ++t) {
+         px[t] = rnd.Gaus(0, 5);
+         py[t] = rnd.Gaus(0, 5);
+         pz[t] = rnd.Gaus(0, 20);
+         charge[t] = rnd.Rndm() < 0.5 ? -1 : 1;
+      }
+      tree.Fill();
+      *ntNTracks = nTracks;
+      *ntWeight = weight;
+      *ntPx = px;
+      *ntPy = py;
+      *ntPz = pz;
+      *ntCharge = charge;
+      writer->Fill();
+   }
+   tree.Write();
+}
+
+/// The per-event analysis: the scalar sum of the transverse momenta of the charged tracks above a threshold
+template <typename V, typename I>
+double SumPt(std::size_t nTracks, const V &px, const V &py, const I &charge)
+{
+   double sum = 0;
+   for (std::size_t t = 0; t < nTracks; ++t) {
+      const double pt = std::sqrt(px[t] * px[t] + py[t] * py[t]);
+      if (charge[t] != 0 && pt > 2.)
+         sum += pt;
+   }
+   return sum;
+}
+
+struct Result {
+   std::string fScaling;
+   unsigned int fNThreads = 0;
+   int fNFiles = 0;
+   Long64_t fNEntries = 0;
+   double fWallTime = 0;
+   ThreadTimes fTimes;
+   bool fHasDeserialization = false;
+};
+
+Long64_t RunRDataFrame(const std::vector<std::string> &files)
+{
+   ROOT::RDataFrame df("events", files);
+   auto sumPt = df.Filter([] {
+                     GetThreadStats();
+                     return true;
+                  })
+                   .Filter([](int n) { return TimeUser([n] { return n > 0; }); }, {"nTracks"})
+                   .Define("sumPt",
+                           [](const ROOT::RVec<float> &px, const ROOT::RVec<float> &py, const ROOT::RVec<int> &q) {
+                              return TimeUser([&] { return SumPt(px.size(), px, py, q); });
+                           },
+                           {"px", "py", "charge"});
+   auto h = sumPt.Histo1D<double, double>({"sumPt", "sumPt", 100, 0, 200}, "sumPt", "weight");
+   auto count = df.Count();
+   h->GetEntries();
+   return *count;
+}
+
+Long64_t RunTreeProcessorMT(const std::vector<std::string> &files)
+{
+   std::vector<std::string_view> fileViews(files.begin(), files.end());
+   ROOT::TTreeProcessorMT processor(fileViews, "events");
+   ROOT::TThreadedObject<TH1D> h("sumPt", "sumPt", 100, 0, 200);
+   std::atomic<Long64_t> nEntries{0};
+   processor.Process([&](TTreeReader &reader) {
+      auto &stats = GetThreadStats();
+      TTreeReaderValue<int> nTracks(reader, "nTracks");
+      TTreeReaderValue<double> weight(reader, "weight");
+      TTreeReaderArray<float> px(reader, "px");
+      TTreeReaderArray<float> py(reader, "py");
+      TTreeReaderArray<int> charge(reader, "charge");
+      auto hist = h.Get();
+      Long64_t n = 0;
+      while (true) {
+         // The values are read as a whole before the analysis code is timed
+         auto start = Clock_t::now();
+         if (!reader.Next())
+            break;
+         const int nt = *nTracks;
+         const double w = *weight;
+         px.GetSize();
+         py.GetSize();
+         charge.GetSize();
+         stats.fTimes.fRead += SecondsSince(start);
+         ++n;
+         start = Clock_t::now();
+         if (nt > 0)
+            hist->Fill(SumPt(px.GetSize(), px, py, charge), w);
+         stats.fTimes.fUser += SecondsSince(start);
+      }
+      nEntries += n;
+   });
+   h.Merge();
+   return nEntries;
+}
+
+Long64_t RunNTuple(const std::vector<std::string> &files, unsigned int nThreads)
+{
+   // Every file is processed in a few entry ranges, for the same granularity as the TTree workloads
+   constexpr int kNRangesPerFile = 4;
+   struct Task {
+      std::string fFile;
+      int fRange;
+   };
+   std::vector<Task> tasks;
+   for (const auto &f : files) {
+      for (int r = 0; r < kNRangesPerFile; ++r)
+         tasks.push_back({f, r});
+   }
+   ROOT::TThreadedObject<TH1D> h("sumPt", "sumPt", 100, 0, 200);
+   std::atomic<Long64_t> nEntries{0};
+   ROOT::TThreadExecutor executor(nThreads);
+   executor.Foreach(
+      [&](const Task &task) {
+         auto &stats = GetThreadStats();
+         auto reader = ROOT::Experimental::RNTupleReader::Open("events", task.fFile);
+         auto nTracks = reader->GetView<int>("nTracks");
+         auto weight = reader->GetView<double>("weight");
+         auto px = reader->GetView<std::vector<float>>("px");
+         auto py = reader->GetView<std::vector<float>>("py");
+         auto charge = reader->GetView<std::vector<int>>("charge");
+         auto hist = h.Get();
+         const auto n = reader->GetNEntries();
+         const auto first = n * task.fRange / kNRangesPerFile;
+         const auto last = n * (task.fRange + 1) / kNRangesPerFile;
+         for (auto i = first; i < last; ++i) {
+            const int nt = nTracks(i);
+            const double w = weight(i);
+            const auto &vpx = px(i);
+            const auto &vpy = py(i);
+            const auto &vq = charge(i);
+            const auto start = Clock_t::now();
+            if (nt > 0)
+               hist->Fill(SumPt(vpx.size(), vpx, vpy, vq), w);
+            stats.fTimes.fUser += SecondsSince(start);
+         }
+         nEntries += last - first;
+      },
+      tasks);
+   h.Merge();
+   return nEntries;
+}
+
+Result Run(const std::string &workload, const std::string &scaling, unsigned int nThreads, int nFiles)
+{
+   std::vector<std::string> files;
+   for (int i = 0; i < nFiles; ++i)
+      files.push_back(workload == "ntuple" ? NTupleFileName(i) : TreeFileName(i));
+
+   // TTreeProcessorMT and RDataFrame use the implicit multi-threading pool
+   if (workload != "ntuple")
+      ROOT::EnableImplicitMT(nThreads);
+
+   Result result;
+   result.fScaling = scaling;
+   result.fNThreads = nThreads;
+   result.fNFiles = nFiles;
+   result.fHasDeserialization = (workload == "tpmt");
+   const auto timesBefore = SumThreadTimes();
+   const auto ntupleBefore = GetNTupleTimes();
+   const auto start = Clock_t::now();
+   if (workload == "rdf")
+      result.fNEntries = RunRDataFrame(files);
+   else if (workload == "tpmt")
+      result.fNEntries = RunTreeProcessorMT(files);
+   else
+      result.fNEntries = RunNTuple(files, nThreads);
+   result.fWallTime = SecondsSince(start);
+   result.fTimes = SumThreadTimes() - timesBefore;
+   if (workload == "ntuple") {
+      const auto ntupleTimes = GetNTupleTimes() - ntupleBefore;
+      result.fTimes.fIO = ntupleTimes.fIO;
+      result.fTimes.fUnzip = ntupleTimes.fUnzip;
+   }
+
+   if (workload != "ntuple")
+      ROOT::DisableImplicitMT();
+   return result;
+}
+
+/// The breakdown of the thread times: io, unzip, deserialization, user, other
+std::vector<double> Breakdown(const Result &r)
+{
+   const auto &t = r.fTimes;
+   const double total = r.fWallTime * r.fNThreads;
+   const double deserialization = r.fHasDeserialization ? std::max(0., t.fRead - t.fIO - t.fUnzip) : 0.;
+   const double accounted = r.fHasDeserialization ? std::max(t.fRead, t.fIO + t.fUnzip) : t.fIO + t.fUnzip;
+   return {t.fIO, t.fUnzip, deserialization, t.fUser, std::max(0., total - accounted - t.fUser)};
+}
+
+const char *gBreakdownNames[] = {"io", "unzip", "deserialization", "user", "other"};
+
+void WriteJSON(const std::string &fileName, const std::string &workload, Long64_t nEntriesPerFile,
+               const std::vector<Result> &results)
+{
+   std::ofstream out(fileName);
+   out << "{\n  \"workload\": \"" << workload << "\",\n  \"entriesPerFile\": " << nEntriesPerFile
+       << ",\n  \"hardwareConcurrency\": " << std::thread::hardware_concurrency() << ",\n  \"runs\": [";
+   for (std::size_t i = 0; i < results.size(); ++i) {
+      const auto &r = results[i];
+      // The reference of the speedup is the first run of the same scaling, normally with one thread
+      const Result *ref = &r;
+      for (const auto &other : results) {
+         if (other.fScaling == r.fScaling) {
+            ref = &other;
+            break;
+         }
+      }
+      const double throughput = r.fNEntries / r.fWallTime;
+      const double refThroughput = ref->fNEntries / ref->fWallTime;
+      const double speedup = throughput / refThroughput;
+      out << (i ? "," : "") << "\n    {\"scaling\": \"" << r.fScaling << "\", \"threads\": " << r.fNThreads
+          << ", \"files\": " << r.fNFiles << ", \"entries\": " << r.fNEntries << ", \"wallTime\": " << r.fWallTime
+          << ", \"throughput\": " << throughput << ", \"speedup\": " << speedup
+          << ", \"efficiency\": " << speedup * ref->fNThreads / r.fNThreads << ",\n     \"threadTime\": {";
+      const auto breakdown = Breakdown(r);
+      bool first = true;
+      for (std::size_t b = 0; b < breakdown.size(); ++b) {
+         if (b == 2 && !r.fHasDeserialization)
+            continue;
+         out << (first ? "" : ", ") << "\"" << gBreakdownNames[b] << "\": " << breakdown[b];
+         first = false;
+      }
+      out << "}}";
+   }
+   out << "\n  ]\n}\n";
+}
+
+void Draw(const std::string &fileName, const std::vector<Result> &results)
+{
+   gROOT->SetBatch(kTRUE);
+   TCanvas canvas("scaling", "scaling", 1200, 900);
+   canvas.Divide(2, 2);
+
+   int pad = 1;
+   for (const std::string scaling : {"strong", "weak"}) {
+      std::vector<const Result *> runs;
+      for (const auto &r : results) {
+         if (r.fScaling == scaling)
+            runs.push_back(&r);
+      }
+      if (runs.empty())
+         continue;
+
+      canvas.cd(pad++);
+      gPad->SetLogx();
+      auto mg = new TMultiGraph("mg_" + TString(scaling), (scaling + " scaling;threads;speedup").c_str());
+      auto measured = new TGraph(runs.size());
+      auto ideal = new TGraph(runs.size());
+      const double refThroughput = runs[0]->fNEntries / runs[0]->fWallTime;
+      for (std::size_t i = 0; i < runs.size(); ++i) {
+         const double relThreads = double(runs[i]->fNThreads) / runs[0]->fNThreads;
+         measured->SetPoint(i, runs[i]->fNThreads, runs[i]->fNEntries / runs[i]->fWallTime / refThroughput);
+         ideal->SetPoint(i, runs[i]->fNThreads, relThreads);
+      }
+      measured->SetMarkerStyle(20);
+      ideal->SetLineStyle(2);
+      mg->Add(ideal, "L");
+      mg->Add(measured, "LP");
+      mg->Draw("A");
+
+      canvas.cd(pad++);
+      auto stack = new THStack("hs_" + TString(scaling), (scaling + " scaling;threads;fraction of thread time").c_str());
+      auto legend = new TLegend(0.75, 0.6, 0.98, 0.95);
+      const int colors[] = {kAzure + 1, kOrange + 1, kGreen + 2, kRed + 1, kGray};
+      for (int b = 0; b < 5; ++b) {
+         auto h = new TH1D(TString::Format("h_%s_%s", scaling.c_str(), gBreakdownNames[b]), gBreakdownNames[b],
+                           runs.size(), 0, runs.size());
+         h->SetDirectory(nullptr);
+         h->SetFillColor(colors[b]);
+         for (std::size_t i = 0; i < runs.size(); ++i) {
+            const auto breakdown = Breakdown(*runs[i]);
+            double total = 0;
+            for (auto v : breakdown)
+               total += v;
+            h->SetBinContent(i + 1, total > 0 ? breakdown[b] / total : 0);
+            h->GetXaxis()->SetBinLabel(i + 1, std::to_string(runs[i]->fNThreads).c_str());
+         }
+         stack->Add(h);
+         legend->AddEntry(h, gBreakdownNames[b], "f");
+      }
+      stack->Draw("hist");
+      legend->Draw();
+   }
+   canvas.SaveAs(fileName.c_str());
+}
+
+} // anonymous namespace
+
+int main(int argc, char **argv)
+{
+   std::string workload = "rdf";
+   std::vector<unsigned int> threadCounts;
+   Long64_t nEntriesPerFile = 200000;
+   int nFiles = 0;
+   std::string prefix = "scalingMT";
+
+   for (int i = 1; i < argc; ++i) {
+      const std::string arg = argv[i];
+      if (i + 1 == argc) {
+         std::cerr << "scalingMT: missing value of option " << arg << std::endl;
+         return 1;
+      }
+      const std::string value = argv[++i];
+      if (arg == "-w") {
+         workload = value;
+      } else if (arg == "-t") {
+         std::istringstream list(value);
+         std::string count;
+         while (std::getline(list, count, ','))
+            threadCounts.push_back(std::stoul(count));
+      } else if (arg == "-e") {
+         nEntriesPerFile = std::stoll(value);
+      } else if (arg == "-f") {
+         nFiles = std::stoi(value);
+      } else if (arg == "-o") {
+         prefix = value;
+      } else {
+         std::cerr << "scalingMT: unknown option " << arg << std::endl;
+         return 1;
+      }
+   }
+   if (workload != "rdf" && workload != "tpmt" && workload != "ntuple") {
+      std::cerr << "scalingMT: unknown workload " << workload << ", use rdf, tpmt or ntuple" << std::endl;
+      return 1;
+   }
+   if (threadCounts.empty()) {
+      const unsigned int nCores = std::max(1u, std::thread::hardware_concurrency());
+      for (unsigned int n = 1; n < nCores; n *= 2)
+         threadCounts.push_back(n);
+      threadCounts.push_back(nCores);
+   }
+   unsigned int maxThreads = 1;
+   for (auto n : threadCounts)
+      maxThreads = std::max(maxThreads, n);
+   if (nFiles <= 0)
+      nFiles = maxThreads;
+
+   ROOT::EnableThreadSafety();
+   ROOT::Experimental::Detail::RNTupleMetricsRegistry::Instance().Enable();
+
+   std::cout << "scalingMT: generating " << nFiles << " files of " << nEntriesPerFile << " events if needed"
+             << std::endl;
+   {
+      ROOT::TThreadExecutor executor(maxThreads);
+      executor.Foreach([nEntriesPerFile](int i) { GenerateFile(i, nEntriesPerFile); }, ROOT::TSeqI(nFiles));
+   }
+
+   std::vector<Result> results;
+   for (const std::string scaling : {"strong", "weak"}) {
+      for (auto nThreads : threadCounts) {
+         const int files = (scaling == "strong") ? nFiles : std::min<int>(nFiles, nThreads);
+         results.push_back(Run(workload, scaling, nThreads, files));
+         const auto &r = results.back();
+         std::cout << "scalingMT: " << workload << ", " << scaling << " scaling, " << nThreads << " threads, "
+                   << files << " files: " << r.fWallTime << " s, " << r.fNEntries / r.fWallTime << " events/s"
+                   << std::endl;
+      }
+   }
+
+   WriteJSON(prefix + ".json", workload, nEntriesPerFile, results);
+   Draw(prefix + ".pdf", results);
+   std::cout << "scalingMT: report written to " << prefix << ".json and " << prefix << ".pdf" << std::endl;
+   return 0;
+}
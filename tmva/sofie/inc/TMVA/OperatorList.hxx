@@ -5,3 +5,12 @@
 #include "TMVA/ROperator_Sigmoid.hxx"
 #include "TMVA/ROperator_Conv.hxx"
 #include "TMVA/ROperator_RNN.hxx"
+#include "TMVA/ROperator_LSTM.hxx"
+#include "TMVA/ROperator_GRU.hxx"
+#include "TMVA/ROperator_LeakyRelu.hxx"
+#include "TMVA/ROperator_Softmax.hxx"
+#include "TMVA/ROperator_BasicBinary.hxx"
+#include "TMVA/ROperator_Reshape.hxx"
+#include "TMVA/ROperator_Concat.hxx"
+#include "TMVA/ROperator_BatchNormalization.hxx"
+#include "TMVA/ROperator_Pool.hxx"
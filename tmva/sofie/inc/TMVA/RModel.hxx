@@ -42,6 +42,9 @@ private:
    const std::unordered_set<std::string> fAllowedStdLib = {"vector", "algorithm", "cmath"};
    std::unordered_set<std::string> fNeededStdLib = {"vector"};
 
+   void FuseOperators();
+   std::vector<std::vector<std::string>> PlanIntermediateMemory(std::vector<size_t>& bufferLengths);
+
 
 
 public:
@@ -62,6 +65,8 @@ public:
    const ETensorType& GetTensorType(std::string name);
 
    bool CheckIfTensorAlreadyExist(std::string tensor_name);
+   bool IsInitializedTensor(const std::string& tensor_name) const;
+   bool IsOutputTensor(const std::string& tensor_name) const;
    void AddInputTensorInfo(std::string input_name, ETensorType type, std::vector<Dim> shape);
    void AddInputTensorInfo(std::string input_name, ETensorType type, std::vector<size_t> shape);
    void AddOperator(std::unique_ptr<ROperator> op, int order_execution = -1);
@@ -82,8 +87,13 @@ public:
    std::shared_ptr<void> GetInitializedTensorData(std::string tensor_name);
 
 
-   void Initialize();
-   void Generate();
+   // batchSize, if positive, is the value of the parametric dimensions of the inputs (e.g. a batch
+   // dimension left open in the ONNX file)
+   void Initialize(int batchSize = -1);
+   // generate the inference code; with optimizeGraph, batch normalizations are folded into the preceding Gemm
+   // or Conv, activations are fused into the preceding Gemm and the intermediate tensors whose lifetimes do
+   // not overlap share their memory
+   void Generate(bool optimizeGraph = true, int batchSize = -1);
 
    void PrintGenerated(){
       std::cout << fGC;
@@ -24,6 +24,9 @@ public:
    virtual void Initialize(RModel&) = 0;
    virtual std::string Generate(std::string OpName) = 0;  //expect unique opname for each operator within the same RModel
    virtual std::string Header() { return "";}
+   // names of the tensors read and written by the generated code, used by the graph optimization of RModel
+   virtual std::vector<std::string> GetInputTensorNames() const { return {}; }
+   virtual std::vector<std::string> GetOutputTensorNames() const { return {}; }
 
 
    //virtual void Forward_reference() = 0;
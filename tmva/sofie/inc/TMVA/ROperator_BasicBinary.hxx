@@ -0,0 +1,151 @@
+#ifndef TMVA_SOFIE_ROPERATOR_BASICBINARY
+#define TMVA_SOFIE_ROPERATOR_BASICBINARY
+
+#include "TMVA/SOFIE_common.hxx"
+#include "TMVA/ROperator.hxx"
+#include "TMVA/RModel.hxx"
+
+#include <sstream>
+
+namespace TMVA{
+namespace Experimental{
+namespace SOFIE{
+
+enum class EBasicBinaryOperator { Add, Sub, Mul, Div };
+
+template <typename T, EBasicBinaryOperator Op>
+struct BinaryOperatorTrait {};
+
+template <typename T>
+struct BinaryOperatorTrait<T, EBasicBinaryOperator::Add> {
+   static const std::string Name() { return "Add"; }
+   static std::string Op(const std::string &t1, const std::string &t2) { return t1 + " + " + t2; }
+};
+
+template <typename T>
+struct BinaryOperatorTrait<T, EBasicBinaryOperator::Sub> {
+   static const std::string Name() { return "Sub"; }
+   static std::string Op(const std::string &t1, const std::string &t2) { return t1 + " - " + t2; }
+};
+
+template <typename T>
+struct BinaryOperatorTrait<T, EBasicBinaryOperator::Mul> {
+   static const std::string Name() { return "Mul"; }
+   static std::string Op(const std::string &t1, const std::string &t2) { return t1 + " * " + t2; }
+};
+
+template <typename T>
+struct BinaryOperatorTrait<T, EBasicBinaryOperator::Div> {
+   static const std::string Name() { return "Div"; }
+   static std::string Op(const std::string &t1, const std::string &t2) { return t1 + " / " + t2; }
+};
+
+// Element-wise binary operator with the multidirectional broadcasting of ONNX. A constant input is broadcast to the
+// shape of the output once in Initialize; the other inputs are read with a stride of zero along the broadcast
+// dimensions.
+template <typename T, EBasicBinaryOperator Op>
+class ROperator_BasicBinary final : public ROperator
+{
+
+private:
+
+   std::string fNA;
+   std::string fNB;
+   std::string fNY;
+   std::vector<size_t> fShapeA;
+   std::vector<size_t> fShapeB;
+   std::vector<size_t> fShapeY;
+
+   // expression reading the element id of the output from input X of the given shape
+   std::string ReadElement(const std::string& nameX, const std::vector<size_t>& shapeX){
+      if (shapeX == fShapeY){
+         return "tensor_" + nameX + "[id]";
+      }
+      std::stringstream index;
+      size_t offset = fShapeY.size() - shapeX.size();
+      size_t strideX = 1;
+      size_t strideY = 1;
+      bool first = true;
+      for (int i = fShapeY.size() - 1; i >= 0; i--){
+         if (i >= (int) offset && shapeX[i - offset] != 1){
+            if (!first) index << " + ";
+            index << "id / " << strideY << " % " << fShapeY[i] << " * " << strideX;
+            first = false;
+            strideX *= shapeX[i - offset];
+         }
+         strideY *= fShapeY[i];
+      }
+      if (first) index << "0";
+      return "tensor_" + nameX + "[" + index.str() + "]";
+   }
+
+public:
+   ROperator_BasicBinary(){}
+   ROperator_BasicBinary(std::string nameA, std::string nameB, std::string nameY):
+      fNA(UTILITY::Clean_name(nameA)), fNB(UTILITY::Clean_name(nameB)), fNY(UTILITY::Clean_name(nameY)){}
+
+   std::vector<ETensorType> TypeInference(std::vector<ETensorType> input){
+      return {input[0]};
+   }
+
+   std::vector<std::vector<size_t>> ShapeInference(std::vector<std::vector<size_t>> input){
+      auto& a = input[0];
+      auto& b = input[1];
+      size_t rank = std::max(a.size(), b.size());
+      std::vector<size_t> y(rank);
+      for (size_t i = 0; i < rank; i++){
+         size_t da = (i + a.size() >= rank) ? a[i + a.size() - rank] : 1;
+         size_t db = (i + b.size() >= rank) ? b[i + b.size() - rank] : 1;
+         if (da != db && da != 1 && db != 1){
+            throw std::runtime_error("TMVA SOFIE " + BinaryOperatorTrait<T, Op>::Name() + " Op input tensors of shapes " +
+                                     ConvertShapeToString(a) + " and " + ConvertShapeToString(b) + " cannot be broadcast");
+         }
+         y[i] = (da == 1) ? db : da;
+      }
+      return {y};
+   }
+
+   std::vector<std::string> GetInputTensorNames() const { return {fNA, fNB}; }
+   std::vector<std::string> GetOutputTensorNames() const { return {fNY}; }
+
+   void Initialize(RModel& model){
+      if (!model.CheckIfTensorAlreadyExist(fNA) || !model.CheckIfTensorAlreadyExist(fNB)){   //input must be a graph input, or already initialized intermediate tensor
+         throw std::runtime_error("TMVA SOFIE " + BinaryOperatorTrait<T, Op>::Name() + " Op Input Tensor " + fNA + " or " + fNB + " is not found in model");
+      }
+      fShapeA = model.GetTensorShape(fNA);
+      fShapeB = model.GetTensorShape(fNB);
+      fShapeY = ShapeInference({fShapeA, fShapeB})[0];
+      for (auto name: {fNA, fNB}){
+         auto& shape = (name == fNA) ? fShapeA : fShapeB;
+         if (shape != fShapeY && model.IsInitializedTensor(name)){
+            auto original_data = model.GetInitializedTensorData(name);
+            std::shared_ptr<void> new_data_ptr(UTILITY::Unidirectional_broadcast<float>(static_cast<float*>(original_data.get()), shape, fShapeY), std::default_delete<float[]>());
+            model.UpdateInitializedTensor(name, model.GetTensorType(name), fShapeY, new_data_ptr);
+            shape = fShapeY;
+         }
+      }
+      model.AddIntermediateTensor(fNY, model.GetTensorType(fNA), fShapeY);
+   }
+
+
+   std::string Generate(std::string OpName){
+      OpName = "op_" + OpName;
+      if (fShapeY.empty()){
+         throw std::runtime_error("TMVA SOFIE " + BinaryOperatorTrait<T, Op>::Name() + " Op called to Generate without being initialized first");
+      }
+      std::stringstream out;
+      size_t length = ConvertShapeToLength(fShapeY);
+      out << "\t" << "for (int id = 0; id < " << length << " ; id++){\n";
+      out << "\t\t" << "tensor_" << fNY << "[id] = " << BinaryOperatorTrait<T, Op>::Op(ReadElement(fNA, fShapeA), ReadElement(fNB, fShapeB)) << ";\n";
+      out << "\t}\n";
+      return out.str();
+   }
+
+};
+
+}//SOFIE
+}//Experimental
+}//TMVA
+
+
+#endif //TMVA_SOFIE_ROPERATOR_BASICBINARY
@@ -0,0 +1,129 @@
+#ifndef TMVA_SOFIE_ROPERATOR_BATCHNORMALIZATION
+#define TMVA_SOFIE_ROPERATOR_BATCHNORMALIZATION
+
+#include "TMVA/SOFIE_common.hxx"
+#include "TMVA/ROperator.hxx"
+#include "TMVA/RModel.hxx"
+
+#include <cmath>
+#include <sstream>
+#include <iomanip>
+#include <limits>
+
+namespace TMVA{
+namespace Experimental{
+namespace SOFIE{
+
+// Batch normalization for inference: the statistics are constants, so that the operator is an affine
+// transformation of each channel, y = scale[c] * x + shift[c], with the coefficients computed in Initialize.
+// The transformation can be folded into the weights of a preceding Gemm or Conv, see RModel::FuseOperators.
+template <typename T>
+class ROperator_BatchNormalization final : public ROperator
+{
+
+private:
+
+   float fAttrEpsilon = 1e-5;
+
+   std::string fNX;
+   std::string fNScale;
+   std::string fNB;
+   std::string fNMean;
+   std::string fNVar;
+   std::string fNY;
+
+   std::vector<size_t> fShapeX;
+   std::vector<T> fScale;   // scale / sqrt(var + epsilon)
+   std::vector<T> fShift;   // B - mean * fScale
+
+public:
+
+   ROperator_BatchNormalization(){}
+   ROperator_BatchNormalization(float epsilon, std::string nameX, std::string nameScale, std::string nameB,
+                                std::string nameMean, std::string nameVar, std::string nameY):
+      fAttrEpsilon(epsilon), fNX(UTILITY::Clean_name(nameX)), fNScale(UTILITY::Clean_name(nameScale)),
+      fNB(UTILITY::Clean_name(nameB)), fNMean(UTILITY::Clean_name(nameMean)), fNVar(UTILITY::Clean_name(nameVar)),
+      fNY(UTILITY::Clean_name(nameY)){
+      if (!std::is_same<T, float>::value){
+         throw std::runtime_error("TMVA SOFIE Encountered unsupported type parsing a BatchNormalization operator");
+      }
+   }
+
+   std::vector<ETensorType> TypeInference(std::vector<ETensorType> input){
+      return {input[0]};
+   }
+
+   std::vector<std::vector<size_t>> ShapeInference(std::vector<std::vector<size_t>> input){
+      return {input[0]};
+   }
+
+   // the coefficients are generated as constants, the statistics themselves are not needed
+   std::vector<std::string> GetInputTensorNames() const { return {fNX}; }
+   std::vector<std::string> GetOutputTensorNames() const { return {fNY}; }
+
+   const std::vector<T>& GetScale() const { return fScale; }
+   const std::vector<T>& GetShift() const { return fShift; }
+
+   void Initialize(RModel& model){
+      if (model.CheckIfTensorAlreadyExist(fNX) == false){   //input must be a graph input, or already initialized intermediate tensor
+         throw std::runtime_error("TMVA SOFIE BatchNormalization Op Input Tensor " + fNX + " is not found in model");
+      }
+      fShapeX = model.GetTensorShape(fNX);
+      if (fShapeX.size() < 2){
+         throw std::runtime_error("TMVA SOFIE BatchNormalization Op Input Tensor " + fNX + " has less than 2 dimensions");
+      }
+      size_t channels = fShapeX[1];
+      std::vector<const T*> coefficients;
+      for (auto& name: {fNScale, fNB, fNMean, fNVar}){
+         if (!model.IsInitializedTensor(name)){
+            throw std::runtime_error("TMVA SOFIE BatchNormalization Op Input Tensor " + name + " is not an initialized tensor");
+         }
+         if (ConvertShapeToLength(model.GetTensorShape(name)) != channels){
+            throw std::runtime_error("TMVA SOFIE BatchNormalization Op Input Tensor " + name + " has not " + std::to_string(channels) + " elements");
+         }
+         coefficients.push_back(static_cast<const T*>(model.GetInitializedTensorData(name).get()));
+      }
+      fScale.resize(channels);
+      fShift.resize(channels);
+      for (size_t c = 0; c < channels; c++){
+         fScale[c] = coefficients[0][c] / std::sqrt(coefficients[3][c] + fAttrEpsilon);
+         fShift[c] = coefficients[1][c] - coefficients[2][c] * fScale[c];
+      }
+      model.AddIntermediateTensor(fNY, model.GetTensorType(fNX), fShapeX);
+   }
+
+   std::string Generate(std::string OpName){
+      OpName = "op_" + OpName;
+      if (fShapeX.empty()){
+         throw std::runtime_error("TMVA SOFIE BatchNormalization Op called to Generate without being initialized first");
+      }
+      size_t channels = fShapeX[1];
+      size_t spatial = 1;
+      for (size_t i = 2; i < fShapeX.size(); i++) spatial *= fShapeX[i];
+      std::stringstream out;
+      out << std::setprecision(std::numeric_limits<float>::max_digits10);
+      out << "\t" << "static const float " << OpName << "_scale[" << channels << "] = {";
+      for (size_t c = 0; c < channels; c++) out << (c ? ", " : "") << fScale[c];
+      out << "};\n";
+      out << "\t" << "static const float " << OpName << "_shift[" << channels << "] = {";
+      for (size_t c = 0; c < channels; c++) out << (c ? ", " : "") << fShift[c];
+      out << "};\n";
+      out << "\t" << "for (size_t n = 0; n < " << fShapeX[0] << "; n++){\n";
+      out << "\t\t" << "for (size_t c = 0; c < " << channels << "; c++){\n";
+      out << "\t\t\t" << "size_t offset = (n * " << channels << " + c) * " << spatial << ";\n";
+      out << "\t\t\t" << "for (size_t i = offset; i < offset + " << spatial << "; i++){\n";
+      out << "\t\t\t\t" << "tensor_" << fNY << "[i] = " << OpName << "_scale[c] * tensor_" << fNX << "[i] + " << OpName << "_shift[c];\n";
+      out << "\t\t\t" << "}\n";
+      out << "\t\t" << "}\n";
+      out << "\t" << "}\n";
+      return out.str();
+   }
+
+};
+
+}//SOFIE
+}//Experimental
+}//TMVA
+
+
+#endif //TMVA_SOFIE_ROPERATOR_BATCHNORMALIZATION
@@ -0,0 +1,110 @@
+#ifndef TMVA_SOFIE_ROPERATOR_CONCAT
+#define TMVA_SOFIE_ROPERATOR_CONCAT
+
+#include "TMVA/SOFIE_common.hxx"
+#include "TMVA/ROperator.hxx"
+#include "TMVA/RModel.hxx"
+
+#include <sstream>
+
+namespace TMVA{
+namespace Experimental{
+namespace SOFIE{
+
+template <typename T>
+class ROperator_Concat final : public ROperator
+{
+
+private:
+
+   int_t fAttrAxis;
+
+   std::vector<std::string> fInputs;
+   std::string fOutput;
+   std::vector<std::vector<size_t>> fInputShapes;
+   std::vector<size_t> fOutputShape;
+
+public:
+
+   ROperator_Concat(){}
+   ROperator_Concat(int_t axis, std::vector<std::string> inputs, std::string output):
+      fAttrAxis(axis), fOutput(UTILITY::Clean_name(output)){
+      for (auto& name: inputs){
+         fInputs.push_back(UTILITY::Clean_name(name));
+      }
+   }
+
+   std::vector<ETensorType> TypeInference(std::vector<ETensorType> input){
+      return {input[0]};
+   }
+
+   std::vector<std::vector<size_t>> ShapeInference(std::vector<std::vector<size_t>> input){
+      std::vector<size_t> output_shape = input[0];
+      int_t axis = (fAttrAxis < 0) ? fAttrAxis + output_shape.size() : fAttrAxis;
+      if (axis < 0 || axis >= (int_t) output_shape.size()){
+         throw std::runtime_error("TMVA SOFIE Concat Op axis " + std::to_string(fAttrAxis) + " is out of range");
+      }
+      for (size_t i = 1; i < input.size(); i++){
+         if (input[i].size() != output_shape.size()){
+            throw std::runtime_error("TMVA SOFIE Concat Op input tensors have different ranks");
+         }
+         for (size_t d = 0; d < output_shape.size(); d++){
+            if ((int_t) d == axis){
+               output_shape[d] += input[i][d];
+            }else if (input[i][d] != output_shape[d]){
+               throw std::runtime_error("TMVA SOFIE Concat Op input shapes " + ConvertShapeToString(input[0]) + " and " +
+                                        ConvertShapeToString(input[i]) + " differ outside of the concatenation axis");
+            }
+         }
+      }
+      return {output_shape};
+   }
+
+   std::vector<std::string> GetInputTensorNames() const { return fInputs; }
+   std::vector<std::string> GetOutputTensorNames() const { return {fOutput}; }
+
+   void Initialize(RModel& model){
+      fInputShapes.clear();
+      for (auto& name: fInputs){
+         if (model.CheckIfTensorAlreadyExist(name) == false){   //input must be a graph input, or already initialized intermediate tensor
+            throw std::runtime_error("TMVA SOFIE Concat Op Input Tensor " + name + " is not found in model");
+         }
+         fInputShapes.push_back(model.GetTensorShape(name));
+      }
+      fOutputShape = ShapeInference(fInputShapes)[0];
+      model.AddIntermediateTensor(fOutput, model.GetTensorType(fInputs[0]), fOutputShape);
+      model.AddNeededStdLib("algorithm");
+   }
+
+   std::string Generate(std::string OpName){
+      OpName = "op_" + OpName;
+      if (fOutputShape.empty()){
+         throw std::runtime_error("TMVA SOFIE Concat Op called to Generate without being initialized first");
+      }
+      // the output is made of outer blocks, each the concatenation of one contiguous block of every input
+      size_t axis = (fAttrAxis < 0) ? fAttrAxis + fOutputShape.size() : fAttrAxis;
+      size_t outer = 1;
+      for (size_t d = 0; d < axis; d++) outer *= fOutputShape[d];
+      size_t outputBlock = ConvertShapeToLength(fOutputShape) / outer;
+      std::stringstream out;
+      size_t offset = 0;
+      for (size_t i = 0; i < fInputs.size(); i++){
+         size_t block = ConvertShapeToLength(fInputShapes[i]) / outer;
+         if (block == 0) continue;
+         out << "\t" << "for (size_t id = 0; id < " << outer << "; id++){\n";
+         out << "\t\t" << "std::copy(tensor_" << fInputs[i] << " + id * " << block << ", tensor_" << fInputs[i]
+             << " + (id + 1) * " << block << ", tensor_" << fOutput << " + id * " << outputBlock << " + " << offset << ");\n";
+         out << "\t" << "}\n";
+         offset += block;
+      }
+      return out.str();
+   }
+
+};
+
+}//SOFIE
+}//Experimental
+}//TMVA
+
+
+#endif //TMVA_SOFIE_ROPERATOR_CONCAT
@@ -107,7 +107,7 @@ public:
 
       if (fAttrAutopad == "NOTSET") {
          if (fAttrPads.empty()) {
-            fAttrPads = {1, 1, 1, 1};
+            fAttrPads = {0, 0, 0, 0};
          }
       } else if (fAttrAutopad == "SAME_UPPER" || fAttrAutopad == "SAME_LOWER") {
          fAttrPads = {fAttrKernelShape[0] / 2, fAttrKernelShape[1] / 2, fAttrKernelShape[0] / 2, fAttrKernelShape[1] / 2};
@@ -133,10 +133,52 @@ public:
           (input[0][3] + fAttrPads[1] + fAttrPads[3] - fAttrKernelShape[1] + fAttrStrides[1]) /
           fAttrStrides[1];
 
-      std::vector<std::vector<size_t>> ret({{input[1][0], input[0][0], outputHeight, outputWidth}});
+      std::vector<std::vector<size_t>> ret({{input[0][0], input[1][0], outputHeight, outputWidth}});
       return ret;
    }
 
+   std::vector<std::string> GetInputTensorNames() const {
+      if (fNB.empty()) return {fNX, fNW};
+      return {fNX, fNW, fNB};
+   }
+   std::vector<std::string> GetOutputTensorNames() const { return {fNY}; }
+
+   // Fold the batch normalization reading Y, y = scale[m] * y + shift[m] for the output channel m, into the weights
+   // and the bias, after Initialize: nameY, the output of the batch normalization, becomes the output of this
+   // operator. Returns false if the weights or the bias are not constant.
+   bool FuseBatchNormalization(RModel& model, const std::vector<float>& scale, const std::vector<float>& shift,
+                               std::string nameY) {
+      if (fType != "float" || fShapeY.empty() || scale.size() != fShapeW[0] || !model.IsInitializedTensor(fNW) ||
+          (fNB != "" && !model.IsInitializedTensor(fNB))) {
+         return false;
+      }
+      size_t kernelSize = fShapeW[1] * fShapeW[2] * fShapeW[3];
+      const float* w = static_cast<const float*>(model.GetInitializedTensorData(fNW).get());
+      std::shared_ptr<void> newW(new float[fShapeW[0] * kernelSize], std::default_delete<float[]>());
+      for (size_t i = 0; i < fShapeW[0] * kernelSize; i++) {
+         static_cast<float*>(newW.get())[i] = scale[i / kernelSize] * w[i];
+      }
+      model.UpdateInitializedTensor(fNW, model.GetTensorType(fNW), fShapeW, newW);
+
+      size_t imageSize = fShapeY[2] * fShapeY[3];
+      size_t length = fShapeY[0] * fShapeY[1] * imageSize;
+      std::shared_ptr<void> newB(new float[length], std::default_delete<float[]>());
+      const float* b = (fNB != "") ? static_cast<const float*>(model.GetInitializedTensorData(fNB).get()) : nullptr;
+      for (size_t i = 0; i < length; i++) {
+         size_t m = (i / imageSize) % fShapeY[1];
+         static_cast<float*>(newB.get())[i] = (b ? scale[m] * b[i] : 0.f) + shift[m];
+      }
+      fNY = UTILITY::Clean_name(nameY);
+      if (fNB != "") {
+         model.UpdateInitializedTensor(fNB, model.GetTensorType(fNB), fShapeY, newB);
+      } else {
+         fNB = fNY + "bias";
+         model.AddInitializedTensor(fNB, model.GetTensorType(fNW), fShapeY, newB);
+      }
+      fShapeB = fShapeY;
+      return true;
+   }
+
    void Initialize(RModel& model) {
       if (!model.CheckIfTensorAlreadyExist(fNX)) {
          throw
@@ -170,12 +212,13 @@ public:
             // make bias shape equal to Y shape by adding 1
             if (fShapeB.size() < 1)
                throw std::runtime_error("TMVA SOFIE Conv op: Bias Tensor has empty shape");
-            // we assume bias tensor dimension is equal to number of filters that is first dimension in 
+            // we assume bias tensor dimension is equal to number of filters that is the second dimension in
             // the output tensor
-            if (fShapeB[0] != fShapeY[0])
+            if (fShapeB[0] != fShapeY[1])
                throw std::runtime_error("TMVA SOFIE Conv op: Bias Tensor has wrong shape: " +
                                            ConvertShapeToString(fShapeB));
-            fShapeB.resize(fShapeY.size(), 1.);
+            fShapeB.resize(fShapeY.size() - 1, 1.);
+            fShapeB.insert(fShapeB.begin(), 1);
 
             if (fType == "float") {
                std::shared_ptr<void> new_data_ptr(UTILITY::Unidirectional_broadcast<float>(
@@ -251,114 +294,71 @@ public:
       out << "\t" << "\t" << "}\n";
       out << "\t" << "}\n";
 
-      if (fAttrGroup == 1) {
+      // the unrolled input has one row of length C * KH * KW per output pixel, and the product with the kernels
+      // of each group is computed directly in the layout [M, N, OH, OW]: with more than one image in the batch it
+      // is computed in a buffer and reordered into the [N, M, OH, OW] of the output
+      std::string nameY = "tensor_" + fNY;
+      if (fShapeX[0] > 1) {
+         nameY = OpName + "_y";
          if (fType == "float") {
-         out << "\t" << "float " << OpName << "_xcol[" << fShapeX[1] * fAttrKernelShape[0] * fAttrKernelShape[1]
-             * fShapeX[0] * fShapeY[2] * fShapeY[3] << "] = {0};\n";
+            out << "\t" << "float " << nameY << "[" << fShapeY[0] * fShapeY[1] * fShapeY[2] * fShapeY[3] << "];\n";
          }
-         // Unroll the input tensor
-         out << "\t" << "size_t " << OpName << "_index = 0;\n";
-         out << "\t" << "for (size_t n = 0; n < " << fShapeX[0] << "; n++) {\n";
-         out << "\t" << "\t" << "for (size_t c = 0; c < " << fShapeW[1] << "; c++) {\n";
-         out << "\t" << "\t" << "\t" << "for (size_t h = 0; h < " << fShapeX[2] + fAttrPads[0] + fAttrPads[2] - fAttrKernelShape[0] + 1
-             << "; h += " << fAttrStrides[0] << ") {\n";
-         out << "\t" << "\t" << "\t" << "\t" << "for (size_t w = 0; w < " << fShapeX[3] + fAttrPads[1] + fAttrPads[3] - fAttrKernelShape[1] + 1
-             << ";w += " << fAttrStrides[1] << ") {\n";
-         out << "\t" << "\t" << "\t" << "\t" << "\t" << "for (size_t x = 0; x < " << fAttrKernelShape[0] << "; x++) {\n";
-         out << "\t" << "\t" << "\t" << "\t" << "\t" << "size_t offset = n * "
-             << fShapeX[1] * (fShapeX[2] + fAttrPads[0] + fAttrPads[2]) * (fShapeX[3] + fAttrPads[1] + fAttrPads[3])
-             << " + c * " << (fShapeX[2] + fAttrPads[0] + fAttrPads[2]) * (fShapeX[3] + fAttrPads[1] + fAttrPads[3])
-             << "+ (h + x) * " << (fShapeX[3] + fAttrPads[1] + fAttrPads[3]) << " + w;\n";
-         out << "\t" << "\t" << "\t" << "\t" << "\t" << "std::copy(" << OpName << "_xpad + offset, " << OpName
-             << "_xpad + offset + " << fAttrKernelShape[1] << ", " << OpName << "_xcol + " << OpName << "_index);\n";
-         out << "\t" << "\t" << "\t" << "\t" << "\t" << OpName << "_index += " << fAttrKernelShape[1] << ";\n";
-         out << "\t" << "\t" << "\t" << "\t" << "\t" << "}\n";
-         out << "\t" << "\t" << "\t" << "\t" << "}\n";
-         out << "\t" << "\t" << "\t" << "}\n";
-         out << "\t" << "\t" << "}\n";
-         out << "\t" << "}\n";
+      }
 
-         out << "\t" << "char " << OpName << "_transA = 'N';\n";
-         out << "\t" << "char " << OpName << "_transB = 'N';\n";
-         out << "\t" << "int " << OpName << "_m = " << fShapeW[0] << ";\n";
-         out << "\t" << "int " << OpName << "_n = " << fShapeX[0] * fShapeY[2] * fShapeY[3] << ";\n";
-         out << "\t" << "int " << OpName << "_k = " << fShapeW[1] * fAttrKernelShape[0] * fAttrKernelShape[1] << ";\n";
-         out << "\t" << "float " << OpName << "_alpha = 1.0;\n";
-         out << "\t" << "float " << OpName << "_beta = 0.0;\n";
-         out << "\t" << "BLAS::sgemm_(&" << OpName << "_transA, &" << OpName << "_transB, &" << OpName << "_m, &"
-             << OpName << "_n, &" << OpName << "_k, &" << OpName << "_alpha, " << OpName << "_f, &" << OpName << "_m,\n";
-         out << "\t" << "\t" << OpName << "_xcol, &" << OpName << "_k, &" << OpName << "_beta, tensor_" << fNY
-             << ", &" << OpName << "_m);\n";
-      } else {
-         if (fType == "float") {
-         out << "\t" << "float " << OpName << "_xcol[" << fShapeX[1] * fAttrKernelShape[0] * fAttrKernelShape[1]
-             * fShapeX[0] * fShapeY[2] * fShapeY[3] << "] = {0};\n";
-         }
-         // Unroll the input tensor
-         out << "\t" << "for (size_t g = 0; g < " << fAttrGroup << "; g++) {\n";
-         out << "\t" << "\t" << "size_t index = g * " << fShapeW[1] * fAttrKernelShape[0] * fAttrKernelShape[1] << ";\n";
-         out << "\t" << "\t" << "for (size_t n = 0; n < " << fShapeX[0] << "; n++) {\n";
-         out << "\t" << "\t" << "\t" << "for (size_t c = g * " << fShapeW[1] << "; c < (g + 1) * " << fShapeW[1] << "; c++) {\n";
-         out << "\t" << "\t" << "\t" << "\t" << "for (size_t h = 0; h < " << fShapeX[2] + fAttrPads[0] + fAttrPads[2] - fAttrKernelShape[0] + 1
-             << "; h += " << fAttrStrides[0] << ") {\n";
-         out << "\t" << "\t" << "\t" << "\t" << "\t" << "for (size_t w = 0; w < "
-             << fShapeX[3] + fAttrPads[1] + fAttrPads[3] - fAttrKernelShape[1] + 1 << ";w += " << fAttrStrides[1] << ") {\n";
-         out << "\t" << "\t" << "\t" << "\t" << "\t" << "\t" << "for (size_t x = 0; x < " << fAttrKernelShape[0] << "; x++) {\n";
-         out << "\t" << "\t" << "\t" << "\t" << "\t" << "\t" << "size_t offset = n * "
-             << fShapeX[1] * (fShapeX[2] + fAttrPads[0] + fAttrPads[2]) * (fShapeX[3] + fAttrPads[1] + fAttrPads[3])
-             << " + c * " << (fShapeX[2] + fAttrPads[0] + fAttrPads[2]) * (fShapeX[3] + fAttrPads[1] + fAttrPads[3])
-             << "+ (h + x) * " << (fShapeX[3] + fAttrPads[1] + fAttrPads[3]) << " + w;\n";
-         out << "\t" << "\t" << "\t" << "\t" << "\t" << "\t" << "std::copy(" << OpName << "_xpad + offset, " << OpName
-             << "_xpad + offset + " << fAttrKernelShape[1] << ", " << OpName << "_xcol + index);\n";
-         out << "\t" << "\t" << "\t" << "\t" << "\t" << "\t" << "index += " << fAttrKernelShape[1] << ";\n";
-         out << "\t" << "\t" << "\t" << "\t" << "\t" << "\t" << "}\n";
-         out << "\t" << "\t" << "\t" << "\t" << "\t" << "}\n";
-         out << "\t" << "\t" << "\t" << "\t" << "}\n";
-         out << "\t" << "\t" << "\t" << "}\n";
-         out << "\t" << "\t" << "}\n";
-         out << "\t" << "}\n";
-         size_t fgHeight = fAttrKernelShape[0] / fAttrGroup;
-         size_t fgWidth  = fAttrKernelShape[1] * fAttrKernelShape[2] * fAttrKernelShape[3];
-         if (fType == "float") {
-            out << "\t" << "float " << OpName << "_fg[" << fgHeight * fgWidth << "];\n";
-         }
-         size_t xgHeight = fShapeX[1] * fAttrKernelShape[2] * fAttrKernelShape[3] / fAttrGroup;
-         size_t xgWidth  = fShapeX[0] * fShapeY[2] * fShapeY[3];
-         if (fType == "float") {
-            out << "\t" << "float " << OpName << "_xg[" << xgHeight * xgWidth << "];\n";
-            out << "\t" << "float " << OpName << "_yg[" << fgHeight * xgWidth << "];\n";
-         }
-         out << "\t" << "char " << OpName << "_transA  = 'N';\n";
-         out << "\t" << "char " << OpName << "_transB = 'N';\n";
-         out << "\t" << "int " << OpName << "_m = " << fgHeight << ";\n";
-         out << "\t" << "int " << OpName << "_n = " << xgWidth << ";\n";
-         out << "\t" << "int " << OpName << "_k = " << fgWidth << ";\n";
+      size_t rowSize = fShapeX[1] * fAttrKernelShape[0] * fAttrKernelShape[1];
+      size_t nPixels = fShapeX[0] * fShapeY[2] * fShapeY[3];
+      if (fType == "float") {
+         out << "\t" << "float " << OpName << "_xcol[" << rowSize * nPixels << "];\n";
+      }
+      // Unroll the input tensor
+      out << "\t" << "size_t " << OpName << "_index = 0;\n";
+      out << "\t" << "for (size_t n = 0; n < " << fShapeX[0] << "; n++) {\n";
+      out << "\t" << "\t" << "for (size_t h = 0; h < " << fShapeX[2] + fAttrPads[0] + fAttrPads[2] - fAttrKernelShape[0] + 1
+          << "; h += " << fAttrStrides[0] << ") {\n";
+      out << "\t" << "\t" << "\t" << "for (size_t w = 0; w < " << fShapeX[3] + fAttrPads[1] + fAttrPads[3] - fAttrKernelShape[1] + 1
+          << ";w += " << fAttrStrides[1] << ") {\n";
+      out << "\t" << "\t" << "\t" << "\t" << "for (size_t c = 0; c < " << fShapeX[1] << "; c++) {\n";
+      out << "\t" << "\t" << "\t" << "\t" << "\t" << "for (size_t x = 0; x < " << fAttrKernelShape[0] << "; x++) {\n";
+      out << "\t" << "\t" << "\t" << "\t" << "\t" << "\t" << "size_t offset = n * "
+          << fShapeX[1] * (fShapeX[2] + fAttrPads[0] + fAttrPads[2]) * (fShapeX[3] + fAttrPads[1] + fAttrPads[3])
+          << " + c * " << (fShapeX[2] + fAttrPads[0] + fAttrPads[2]) * (fShapeX[3] + fAttrPads[1] + fAttrPads[3])
+          << "+ (h + x) * " << (fShapeX[3] + fAttrPads[1] + fAttrPads[3]) << " + w;\n";
+      out << "\t" << "\t" << "\t" << "\t" << "\t" << "\t" << "std::copy(" << OpName << "_xpad + offset, " << OpName
+          << "_xpad + offset + " << fAttrKernelShape[1] << ", " << OpName << "_xcol + " << OpName << "_index);\n";
+      out << "\t" << "\t" << "\t" << "\t" << "\t" << "\t" << OpName << "_index += " << fAttrKernelShape[1] << ";\n";
+      out << "\t" << "\t" << "\t" << "\t" << "\t" << "}\n";
+      out << "\t" << "\t" << "\t" << "\t" << "}\n";
+      out << "\t" << "\t" << "\t" << "}\n";
+      out << "\t" << "\t" << "}\n";
+      out << "\t" << "}\n";
 
-         if (fType == "float") {
-            out << "\t" << "float " << OpName << "_alpha = 1.0;\n";
-            out << "\t" << "float " << OpName << "_beta  = 0.0;\n";
-         }
+      // Y_g^T = Xcol_g^T * F_g^T for each group g of C / group input and M / group output channels
+      size_t nGroupFilters = fShapeW[0] / fAttrGroup;
+      size_t groupRowSize = rowSize / fAttrGroup;
+      out << "\t" << "char " << OpName << "_transA = 'T';\n";
+      out << "\t" << "char " << OpName << "_transB = 'T';\n";
+      out << "\t" << "int " << OpName << "_m = " << nPixels << ";\n";
+      out << "\t" << "int " << OpName << "_n = " << nGroupFilters << ";\n";
+      out << "\t" << "int " << OpName << "_k = " << groupRowSize << ";\n";
+      out << "\t" << "int " << OpName << "_lda = " << rowSize << ";\n";
+      out << "\t" << "int " << OpName << "_ldb = " << fShapeW[0] << ";\n";
+      out << "\t" << "float " << OpName << "_alpha = 1.0;\n";
+      out << "\t" << "float " << OpName << "_beta = 0.0;\n";
+      out << "\t" << "for (size_t g = 0; g < " << fAttrGroup << "; g++) {\n";
+      out << "\t" << "\t" << "BLAS::sgemm_(&" << OpName << "_transA, &" << OpName << "_transB, &" << OpName << "_m, &"
+          << OpName << "_n, &" << OpName << "_k, &" << OpName << "_alpha, " << OpName << "_xcol + g * " << groupRowSize
+          << ", &" << OpName << "_lda,\n";
+      out << "\t" << "\t" << "\t" << OpName << "_f + g * " << nGroupFilters << ", &" << OpName << "_ldb, &" << OpName
+          << "_beta, " << nameY << " + g * " << nGroupFilters * nPixels << ", &" << OpName << "_m);\n";
+      out << "\t" << "}\n";
 
-         out << "\t" << "for (size_t g = 0; g < " << fAttrGroup << "; g++) {\n";
-         out << "\t" << "\t" << "for (size_t h = 0; h < " << fgHeight << "; h++) {\n";
-         out << "\t" << "\t" << "\t" << "for (size_t w = 0; w < " << fgWidth << "; w++) {\n";
-         out << "\t" << "\t" << "\t" << "\t" << OpName << "_fg[h + w * " << fgHeight << "] = " << OpName
-             << "_f[h + g * " << fgHeight << " + w * " << fAttrKernelShape[0] << "];\n";
-         out << "\t" << "\t" << "\t" << "}\n";
-         out << "\t" << "\t" << "}\n";
-         out << "\t" << "\t" << "for (size_t h = 0; h < " << xgHeight << "; h++) {\n";
-         out << "\t" << "\t" << "\t" << "for (size_t w = 0; w < " << xgWidth << "; w++) {\n";
-         out << "\t" << "\t" << "\t" << "\t" << OpName << "_xg[h + w * " << xgHeight << "] = " << OpName
-             << "_xcol[h + g * " << xgHeight << " + w * " << fShapeX[1] * fAttrKernelShape[2] * fAttrKernelShape[3] << "];\n";
-         out << "\t" << "\t" << "\t" << "}\n";
-         out << "\t" << "\t" << "}\n";
-         out << "\t" << "\t" << "BLAS::sgemm_(&" << OpName << "_transA, &" << OpName << "_transB, &" << OpName
-             << "_m, &" << OpName << "_n, &" << OpName << "_k, &" << OpName << "_alpha, " << OpName << "_fg, &"
-             << OpName << "_m, " << OpName << "_xg, &" << OpName << "_k, &" << OpName << "_beta, " << OpName
-             << "_yg, &" << OpName << "_m);\n";
-         out << "\t" << "\t" << "for (size_t i = 0; i < " << fgHeight * xgWidth << "; i++) {\n";
-         out << "\t" << "\t" << "\t" << "tensor_" << fNY << "[i + g * " << fgHeight * xgWidth << "] = "
-             << OpName << "_yg[i];\n";
+      if (fShapeX[0] > 1) {
+         size_t imageSize = fShapeY[2] * fShapeY[3];
+         out << "\t" << "for (size_t m = 0; m < " << fShapeY[1] << "; m++) {\n";
+         out << "\t" << "\t" << "for (size_t n = 0; n < " << fShapeY[0] << "; n++) {\n";
+         out << "\t" << "\t" << "\t" << "std::copy(" << nameY << " + (m * " << fShapeY[0] << " + n) * " << imageSize << ", "
+             << nameY << " + (m * " << fShapeY[0] << " + n + 1) * " << imageSize << ", tensor_" << fNY << " + (n * "
+             << fShapeY[1] << " + m) * " << imageSize << ");\n";
          out << "\t" << "\t" << "}\n";
          out << "\t" << "}\n";
       }
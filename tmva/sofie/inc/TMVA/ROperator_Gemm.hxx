@@ -38,6 +38,12 @@ namespace SOFIE{
 
       std::string fType;
 
+      EActivationType fActivation = EActivationType::UNDEFINED; // activation applied to Y after the product
+
+      // products with at most this number of multiply-adds, e.g. a dense layer of 64 x 64 units for a batch of at
+      // most 16 events, are generated as loops instead of a call to BLAS
+      static constexpr size_t fgMaxLoopSize = 65536;
+
    public:
 
       ROperator_Gemm(){}
@@ -68,6 +74,61 @@ namespace SOFIE{
          return {out};
       }
 
+      std::vector<std::string> GetInputTensorNames() const {
+         if (fNC == "") return {fNA, fNB};
+         return {fNA, fNB, fNC};
+      }
+      std::vector<std::string> GetOutputTensorNames() const { return {fNY}; }
+
+      // Fuse the activation operator that reads Y into this one: the activation is applied in place after the
+      // product, and the output of the activation, nameY, becomes the output of this operator.
+      void FuseActivation(EActivationType activation, std::string nameY){
+         if (fActivation != EActivationType::UNDEFINED){
+            throw std::runtime_error("TMVA SOFIE Gemm Op already has a fused activation");
+         }
+         fActivation = activation;
+         fNY = UTILITY::Clean_name(nameY);
+      }
+
+      // Fold the batch normalization reading Y, y = scale[j] * y + shift[j] for the column j, into B and C, after
+      // Initialize: nameY, the output of the batch normalization, becomes the output of this operator.
+      // Returns false if B or C are not constant, or if an activation was already fused.
+      bool FuseBatchNormalization(RModel& model, const std::vector<float>& scale, const std::vector<float>& shift, std::string nameY){
+         // C has the shape of Y after Initialize; beta multiplies it in the product
+         float beta = (fNC != "") ? fAttrBeta : 1.f;
+         if (fType != "float" || fShapeY.empty() || fActivation != EActivationType::UNDEFINED || scale.size() != fShapeY[1] || beta == 0.f ||
+             !model.IsInitializedTensor(fNB) || (fNC != "" && (!model.IsInitializedTensor(fNC) || fShapeC != fShapeY))){
+            return false;
+         }
+         size_t n = fShapeY[1];
+         size_t length = ConvertShapeToLength(fShapeB);
+         const float* b = static_cast<const float*>(model.GetInitializedTensorData(fNB).get());
+         std::shared_ptr<void> newB(new float[length], std::default_delete<float[]>());
+         for (size_t i = 0; i < length; i++){
+            // B is [k, n], or [n, k] when transposed
+            size_t j = fAttrTransB ? i / fShapeB[1] : i % n;
+            static_cast<float*>(newB.get())[i] = scale[j] * b[i];
+         }
+         model.UpdateInitializedTensor(fNB, model.GetTensorType(fNB), fShapeB, newB);
+
+         length = ConvertShapeToLength(fShapeY);
+         const float* c = (fNC != "") ? static_cast<const float*>(model.GetInitializedTensorData(fNC).get()) : nullptr;
+         std::shared_ptr<void> newC(new float[length], std::default_delete<float[]>());
+         for (size_t i = 0; i < length; i++){
+            static_cast<float*>(newC.get())[i] = (c ? scale[i % n] * c[i] : 0.f) + shift[i % n] / beta;
+         }
+         fNY = UTILITY::Clean_name(nameY);
+         if (fNC != ""){
+            model.UpdateInitializedTensor(fNC, model.GetTensorType(fNC), fShapeY, newC);
+         }else{
+            fNC = fNY + "bias";
+            fAttrBeta = 1.;
+            model.AddInitializedTensor(fNC, model.GetTensorType(fNB), fShapeY, newC);
+         }
+         fShapeC = fShapeY;
+         return true;
+      }
+
       std::vector<std::vector<size_t>> ShapeInference(std::vector<std::vector<size_t>> input){
          if (input.size() > 3) throw std::runtime_error("TMVA SOFIE Gemm Op Shape Inference only need 2 or 3 input tensor");
          for (auto& i: input){
@@ -157,18 +218,9 @@ namespace SOFIE{
             throw std::runtime_error("TMVA SOFIE Gemm Op called to Generate without being initialized first");
          }
          std::stringstream out;
-         out <<"\t" << "char " << OpName << "_transA = " << (fAttrTransA ? "\'t\'" : "\'n\'") << ";\n";
-         out <<"\t" << "char " << OpName << "_transB = " << (fAttrTransB ? "\'t\'" : "\'n\'") << ";\n";
          int m = (fAttrTransA ? fShapeA[1] : fShapeA[0]);
          int n = (fAttrTransB ? fShapeB[0] : fShapeB[1]);
          int k = (fAttrTransA ? fShapeA[0] : fShapeA[1]);
-         out <<"\t" << "int " << OpName << "_m = " << m << ";\n";
-         out <<"\t" << "int " << OpName << "_n = " << n << ";\n";
-         out <<"\t" << "int " << OpName << "_k = " << k << ";\n";
-         out <<"\t" << "float " << OpName << "_alpha = " << std::setprecision(std::numeric_limits<float>::max_digits10) << fAttrAlpha << ";\n";
-         out <<"\t" << "float " << OpName << "_beta = " << std::setprecision(std::numeric_limits<float>::max_digits10) << fAttrBeta << ";\n";
-         out <<"\t" << "int " << OpName << "_lda = " << (fAttrTransA ? m : k) << ";\n";
-         out <<"\t" << "int " << OpName << "_ldb = " << (fAttrTransB ? k : n) << ";\n";
          if (fNC != ""){
             int length = 1;
             for (auto& i: fShapeC){
@@ -176,13 +228,84 @@ namespace SOFIE{
             }
             out << "\t" << "std::copy(" << "tensor_" << fNC << ", " << "tensor_" << fNC << " + " << length << ", " << "tensor_" << fNY << ");\n";
          }
-         if (fType == "float"){
+         if (fType == "float" && static_cast<size_t>(m) * n * k <= fgMaxLoopSize){
+            // small products are computed by loops of compile time extent, which the compiler unrolls and vectorizes:
+            // the call of sgemm would cost more than the arithmetic
+            out << "\t" << "constexpr int " << OpName << "_m = " << m << ";\n";
+            out << "\t" << "constexpr int " << OpName << "_n = " << n << ";\n";
+            out << "\t" << "constexpr int " << OpName << "_k = " << k << ";\n";
+            out << "\t" << "constexpr float " << OpName << "_alpha = " << std::setprecision(std::numeric_limits<float>::max_digits10) << fAttrAlpha << ";\n";
+            if (fNC != ""){
+               out << "\t" << "constexpr float " << OpName << "_beta = " << std::setprecision(std::numeric_limits<float>::max_digits10) << fAttrBeta << ";\n";
+            }
+            std::string a = fAttrTransA ? "[l * " + OpName + "_m + i]" : "[i * " + OpName + "_k + l]";
+            out << "\t" << "for (int i = 0; i < " << OpName << "_m; i++) {\n";
+            out << "\t\t" << "float * " << OpName << "_y = tensor_" << fNY << " + i * " << OpName << "_n;\n";
+            if (fAttrTransB){
+               // each element of Y is the product of a row of A and a row of B
+               out << "\t\t" << "for (int j = 0; j < " << OpName << "_n; j++) {\n";
+               out << "\t\t\t" << "float " << OpName << "_sum = 0;\n";
+               out << "\t\t\t" << "for (int l = 0; l < " << OpName << "_k; l++) {\n";
+               out << "\t\t\t\t" << OpName << "_sum += tensor_" << fNA << a << " * tensor_" << fNB << "[j * " << OpName << "_k + l];\n";
+               out << "\t\t\t" << "}\n";
+               if (fNC != ""){
+                  out << "\t\t\t" << OpName << "_y[j] = " << OpName << "_beta * " << OpName << "_y[j] + " << OpName << "_alpha * " << OpName << "_sum;\n";
+               } else {
+                  out << "\t\t\t" << OpName << "_y[j] = " << OpName << "_alpha * " << OpName << "_sum;\n";
+               }
+               out << "\t\t" << "}\n";
+            } else {
+               // the row of Y accumulates the rows of B, weighted by the row of A: the inner loop is contiguous
+               out << "\t\t" << "for (int j = 0; j < " << OpName << "_n; j++) {\n";
+               if (fNC != ""){
+                  out << "\t\t\t" << OpName << "_y[j] *= " << OpName << "_beta;\n";
+               } else {
+                  out << "\t\t\t" << OpName << "_y[j] = 0;\n";
+               }
+               out << "\t\t" << "}\n";
+               out << "\t\t" << "for (int l = 0; l < " << OpName << "_k; l++) {\n";
+               out << "\t\t\t" << "const float " << OpName << "_a = " << OpName << "_alpha * tensor_" << fNA << a << ";\n";
+               out << "\t\t\t" << "const float * " << OpName << "_b = tensor_" << fNB << " + l * " << OpName << "_n;\n";
+               out << "\t\t\t" << "for (int j = 0; j < " << OpName << "_n; j++) {\n";
+               out << "\t\t\t\t" << OpName << "_y[j] += " << OpName << "_a * " << OpName << "_b[j];\n";
+               out << "\t\t\t" << "}\n";
+               out << "\t\t" << "}\n";
+            }
+            out << "\t" << "}\n";
+         } else if (fType == "float"){
+            out <<"\t" << "char " << OpName << "_transA = " << (fAttrTransA ? "\'t\'" : "\'n\'") << ";\n";
+            out <<"\t" << "char " << OpName << "_transB = " << (fAttrTransB ? "\'t\'" : "\'n\'") << ";\n";
+            out <<"\t" << "int " << OpName << "_m = " << m << ";\n";
+            out <<"\t" << "int " << OpName << "_n = " << n << ";\n";
+            out <<"\t" << "int " << OpName << "_k = " << k << ";\n";
+            out <<"\t" << "float " << OpName << "_alpha = " << std::setprecision(std::numeric_limits<float>::max_digits10) << fAttrAlpha << ";\n";
+            // without C the content of Y must not enter the result, as its memory can be shared with other tensors
+            out <<"\t" << "float " << OpName << "_beta = " << std::setprecision(std::numeric_limits<float>::max_digits10) << (fNC != "" ? fAttrBeta : 0.f) << ";\n";
+            out <<"\t" << "int " << OpName << "_lda = " << (fAttrTransA ? m : k) << ";\n";
+            out <<"\t" << "int " << OpName << "_ldb = " << (fAttrTransB ? k : n) << ";\n";
             out << "\t" << "BLAS::sgemm_(&" << OpName << "_transB, &" << OpName << "_transA, &" << OpName
              << "_n, &" << OpName << "_m, &" << OpName << "_k, &" << OpName << "_alpha, " << "tensor_" << fNB
              << ", &" << OpName << "_ldb, " << "tensor_" << fNA << ", &" << OpName << "_lda, &" << OpName << "_beta, " << "tensor_" << fNY << ", &"
              << OpName << "_n);\n";
           }
 
+          if (fActivation != EActivationType::UNDEFINED){
+             int length = 1;
+             for (auto& i: fShapeY){
+                length *= i;
+             }
+             out << "\t" << "for (int id = 0; id < " << length << " ; id++){\n";
+             if (fActivation == EActivationType::RELU){
+                out << "\t\t" << "tensor_" << fNY << "[id] = ((tensor_" << fNY << "[id] > 0 )? tensor_" << fNY << "[id] : 0);\n";
+             } else if (fActivation == EActivationType::SIGMOID){
+                out << "\t\t" << "tensor_" << fNY << "[id] = 1 / (1 + exp( - tensor_" << fNY << "[id]));\n";
+             } else if (fActivation == EActivationType::SELU){
+                out << "\t\t" << "tensor_" << fNY << "[id] = 1.0507009873554804934193349852946 * (std::max(float(0.0), tensor_" << fNY
+                    << "[id]) + std::min(0.0, 1.6732632423543772848170429916717 * (exp(tensor_" << fNY << "[id])-1)));\n";
+             }
+             out << "\t}\n";
+          }
+
           return out.str();
 
          }
@@ -0,0 +1,75 @@
+#ifndef TMVA_SOFIE_ROPERATOR_LEAKYRELU
+#define TMVA_SOFIE_ROPERATOR_LEAKYRELU
+
+#include "TMVA/SOFIE_common.hxx"
+#include "TMVA/ROperator.hxx"
+#include "TMVA/RModel.hxx"
+
+#include <sstream>
+#include <limits>
+#include <iomanip>
+
+namespace TMVA{
+namespace Experimental{
+namespace SOFIE{
+
+template <typename T>
+class ROperator_LeakyRelu final : public ROperator
+{
+
+private:
+
+   float fAttrAlpha = 0.01;
+
+   std::string fNX;
+   std::string fNY;
+   std::vector<size_t> fShape;
+
+public:
+   ROperator_LeakyRelu(){}
+   ROperator_LeakyRelu(float alpha, std::string nameX, std::string nameY):
+      fAttrAlpha(alpha), fNX(UTILITY::Clean_name(nameX)), fNY(UTILITY::Clean_name(nameY)){}
+
+   std::vector<ETensorType> TypeInference(std::vector<ETensorType> input){
+      return input;
+   }
+
+   std::vector<std::vector<size_t>> ShapeInference(std::vector<std::vector<size_t>> input){
+      auto ret = input; //suggest copy to compiler
+      return ret;
+   }
+
+   std::vector<std::string> GetInputTensorNames() const { return {fNX}; }
+   std::vector<std::string> GetOutputTensorNames() const { return {fNY}; }
+
+   void Initialize(RModel& model){
+      if (model.CheckIfTensorAlreadyExist(fNX) == false){   //input must be a graph input, or already initialized intermediate tensor
+         throw std::runtime_error("TMVA SOFIE LeakyRelu Op Input Tensor is not found in model");
+      }
+      fShape = model.GetTensorShape(fNX);
+      model.AddIntermediateTensor(fNY, model.GetTensorType(fNX), fShape);
+   }
+
+
+   std::string Generate(std::string OpName){
+      OpName = "op_" + OpName;
+      if (fShape.empty()){
+         throw std::runtime_error("TMVA SOFIE LeakyRelu Op called to Generate without being initialized first");
+      }
+      std::stringstream out;
+      size_t length = ConvertShapeToLength(fShape);
+      out << "\t" << "for (int id = 0; id < " << length << " ; id++){\n";
+      out << "\t\t" << "tensor_" << fNY << "[id] = ((tensor_" << fNX << "[id] >= 0 )? tensor_" << fNX << "[id] : "
+          << std::setprecision(std::numeric_limits<float>::max_digits10) << fAttrAlpha << " * tensor_" << fNX << "[id]);\n";
+      out << "\t}\n";
+      return out.str();
+   }
+
+};
+
+}//SOFIE
+}//Experimental
+}//TMVA
+
+
+#endif //TMVA_SOFIE_ROPERATOR_LEAKYRELU
@@ -0,0 +1,225 @@
+#ifndef TMVA_SOFIE_ROPERATOR_POOL
+#define TMVA_SOFIE_ROPERATOR_POOL
+
+#include "TMVA/SOFIE_common.hxx"
+#include "TMVA/ROperator.hxx"
+#include "TMVA/RModel.hxx"
+
+#include <memory>
+#include <sstream>
+#include <algorithm>
+#include <stdexcept>
+#include <vector>
+
+namespace TMVA {
+namespace Experimental {
+namespace SOFIE {
+
+enum class EPoolOpMode { MaxPool, AveragePool, GlobalMaxPool, GlobalAveragePool };
+
+struct RAttributes_Pool {
+   std::string auto_pad = "NOTSET";
+   int ceil_mode = 0;
+   int count_include_pad = 0;    // AveragePool only
+   std::vector<size_t> dilations; // MaxPool only
+   std::vector<size_t> kernel_shape;
+   std::vector<size_t> pads;
+   std::vector<size_t> strides;
+};
+
+/*! \brief Pooling operators: MaxPool, AveragePool and their global versions
+ *
+ * Pooling of the input tensors of 3 ([N, C, W]) or 4 ([N, C, H, W]) dimensions. The windows are bounded by the
+ * image and its padding when the code is generated, so the pooling is done with direct loops over the valid
+ * elements of each window: an im2col unrolling as for Conv would only copy the data without any gain, as there
+ * is no product to hand over to BLAS.
+ */
+template<typename T>
+class ROperator_Pool final : public ROperator
+{
+private:
+   EPoolOpMode fPoolMode;
+   RAttributes_Pool fAttr;
+
+   std::string fNX;
+   std::string fNY;
+
+   std::vector<size_t> fShapeX;
+   std::vector<size_t> fShapeY;
+
+   // the attributes for the 2 spatial dimensions [H, W], after Initialize
+   size_t fKernel[2] = {1, 1};
+   size_t fStrides[2] = {1, 1};
+   size_t fDilations[2] = {1, 1};
+   size_t fPadsBegin[2] = {0, 0};
+   size_t fPadsEnd[2] = {0, 0};
+
+public:
+
+   ROperator_Pool() {}
+
+   ROperator_Pool(EPoolOpMode mode, RAttributes_Pool attr, std::string nameX, std::string nameY):
+      fPoolMode(mode), fAttr(attr), fNX(UTILITY::Clean_name(nameX)), fNY(UTILITY::Clean_name(nameY))
+   {
+      if (!std::is_same<T, float>::value) {
+         throw
+            std::runtime_error("TMVA SOFIE Encountered unsupported type parsing a Pool operator");
+      }
+   }
+
+   std::vector<ETensorType> TypeInference(std::vector<ETensorType> input) {
+      return {input[0]};
+   }
+
+   std::vector<std::vector<size_t>> ShapeInference(std::vector<std::vector<size_t>> input) {
+      auto& shape = input[0];
+      if (shape.size() != 3 && shape.size() != 4) {
+         throw
+            std::runtime_error("TMVA SOFIE Pool Op Shape inference only accept tensor with 3 or 4 dimensions");
+      }
+      size_t dims = shape.size() - 2;
+      // a pooling of 1 dimension is done as a pooling of 2 dimensions of height 1
+      size_t size[2] = {dims == 2 ? shape[2] : 1, shape[dims == 2 ? 3 : 2]};
+      bool global = (fPoolMode == EPoolOpMode::GlobalMaxPool || fPoolMode == EPoolOpMode::GlobalAveragePool);
+      auto attribute = [&](const std::vector<size_t>& values, size_t d, size_t defaultValue) {
+         if (values.empty()) return defaultValue;
+         if (values.size() != dims && values.size() != 2 * dims) {
+            throw
+               std::runtime_error("TMVA SOFIE Pool Op attribute of size " + std::to_string(values.size()) +
+                                  " for " + std::to_string(dims) + " spatial dimensions");
+         }
+         return (dims == 2) ? values[d] : ((d == 0) ? defaultValue : values[0]);
+      };
+      std::vector<size_t> output_shape = {shape[0], shape[1]};
+      for (size_t d = 0; d < 2; d++) {
+         if (global) {
+            fKernel[d] = size[d];
+            fStrides[d] = 1;
+            fDilations[d] = 1;
+            fPadsBegin[d] = fPadsEnd[d] = 0;
+         } else {
+            if (fAttr.kernel_shape.size() != dims) {
+               throw
+                  std::runtime_error("TMVA SOFIE Pool Op needs a kernel_shape of " + std::to_string(dims) + " dimensions");
+            }
+            fKernel[d] = attribute(fAttr.kernel_shape, d, 1);
+            fStrides[d] = attribute(fAttr.strides, d, 1);
+            fDilations[d] = attribute(fAttr.dilations, d, 1);
+            fPadsBegin[d] = (fAttr.pads.empty() || (dims == 1 && d == 0)) ? 0 : fAttr.pads[dims == 2 ? d : 0];
+            fPadsEnd[d] = (fAttr.pads.empty() || (dims == 1 && d == 0)) ? 0 : fAttr.pads[dims == 2 ? d + 2 : 1];
+         }
+         size_t extent = (fKernel[d] - 1) * fDilations[d] + 1;
+         size_t out;
+         if (global) {
+            out = 1;
+         } else if (fAttr.auto_pad == "NOTSET") {
+            if (size[d] + fPadsBegin[d] + fPadsEnd[d] < extent) {
+               throw std::runtime_error("TMVA SOFIE Pool Op kernel larger than the padded input");
+            }
+            size_t span = size[d] + fPadsBegin[d] + fPadsEnd[d] - extent;
+            out = (fAttr.ceil_mode ? (span + fStrides[d] - 1) / fStrides[d] : span / fStrides[d]) + 1;
+            // with ceil_mode, the last window must start in the input or in the padding at its beginning
+            if (fAttr.ceil_mode && (out - 1) * fStrides[d] >= size[d] + fPadsBegin[d]) out--;
+         } else if (fAttr.auto_pad == "VALID") {
+            if (size[d] < extent) {
+               throw std::runtime_error("TMVA SOFIE Pool Op kernel larger than the input");
+            }
+            out = (size[d] - extent) / fStrides[d] + 1;
+            fPadsBegin[d] = fPadsEnd[d] = 0;
+         } else if (fAttr.auto_pad == "SAME_UPPER" || fAttr.auto_pad == "SAME_LOWER") {
+            out = (size[d] + fStrides[d] - 1) / fStrides[d];
+            size_t needed = (out - 1) * fStrides[d] + extent;
+            size_t pad = (needed > size[d]) ? needed - size[d] : 0;
+            fPadsBegin[d] = (fAttr.auto_pad == "SAME_UPPER") ? pad / 2 : pad - pad / 2;
+            fPadsEnd[d] = pad - fPadsBegin[d];
+         } else {
+            throw
+               std::runtime_error("TMVA SOFIE Pool Op invalid auto_pad " + fAttr.auto_pad);
+         }
+         if (dims == 2 || d == 1) output_shape.push_back(out);
+      }
+      return {output_shape};
+   }
+
+   std::vector<std::string> GetInputTensorNames() const { return {fNX}; }
+   std::vector<std::string> GetOutputTensorNames() const { return {fNY}; }
+
+   void Initialize(RModel& model) {
+      if (!model.CheckIfTensorAlreadyExist(fNX)) {
+         throw
+            std::runtime_error("TMVA SOFIE Pool op Input Tensor " + fNX + " is not found in model");
+      }
+      fShapeX = model.GetTensorShape(fNX);
+      fShapeY = ShapeInference({fShapeX})[0];
+      model.AddIntermediateTensor(fNY, model.GetTensorType(fNX), fShapeY);
+      model.AddNeededStdLib("algorithm");
+      model.AddNeededStdLib("cmath");
+   }
+
+   std::string Generate(std::string OpName) {
+      OpName = "op_" + OpName;
+      if (fShapeX.empty() || fShapeY.empty()) {
+         throw
+            std::runtime_error("TMVA SOFIE Pool Op called to Generate without being initialized first");
+      }
+      bool isMax = (fPoolMode == EPoolOpMode::MaxPool || fPoolMode == EPoolOpMode::GlobalMaxPool);
+      bool is2D = (fShapeX.size() == 4);
+      size_t height = is2D ? fShapeX[2] : 1;
+      size_t width = fShapeX.back();
+      size_t outHeight = is2D ? fShapeY[2] : 1;
+      size_t outWidth = fShapeY.back();
+
+      std::stringstream out;
+      out << "\t" << "for (size_t nc = 0; nc < " << fShapeX[0] * fShapeX[1] << "; nc++) {\n";
+      out << "\t" << "\t" << "const float * x = tensor_" << fNX << " + nc * " << height * width << ";\n";
+      out << "\t" << "\t" << "float * y = tensor_" << fNY << " + nc * " << outHeight * outWidth << ";\n";
+      out << "\t" << "\t" << "for (int oh = 0; oh < " << outHeight << "; oh++) {\n";
+      out << "\t" << "\t" << "\t" << "int hstart = oh * " << fStrides[0] << " - " << fPadsBegin[0] << ";\n";
+      out << "\t" << "\t" << "\t" << "for (int ow = 0; ow < " << outWidth << "; ow++) {\n";
+      out << "\t" << "\t" << "\t" << "\t" << "int wstart = ow * " << fStrides[1] << " - " << fPadsBegin[1] << ";\n";
+      if (isMax) {
+         out << "\t" << "\t" << "\t" << "\t" << "float value = -INFINITY;\n";
+      } else {
+         out << "\t" << "\t" << "\t" << "\t" << "float value = 0;\n";
+         out << "\t" << "\t" << "\t" << "\t" << "int count = 0;\n";
+      }
+      out << "\t" << "\t" << "\t" << "\t" << "for (int kh = 0; kh < " << fKernel[0] << "; kh++) {\n";
+      out << "\t" << "\t" << "\t" << "\t" << "\t" << "int h = hstart + kh * " << fDilations[0] << ";\n";
+      out << "\t" << "\t" << "\t" << "\t" << "\t" << "if (h < 0 || h >= " << height << ") continue;\n";
+      out << "\t" << "\t" << "\t" << "\t" << "\t" << "for (int kw = 0; kw < " << fKernel[1] << "; kw++) {\n";
+      out << "\t" << "\t" << "\t" << "\t" << "\t" << "\t" << "int w = wstart + kw * " << fDilations[1] << ";\n";
+      out << "\t" << "\t" << "\t" << "\t" << "\t" << "\t" << "if (w < 0 || w >= " << width << ") continue;\n";
+      if (isMax) {
+         out << "\t" << "\t" << "\t" << "\t" << "\t" << "\t" << "value = std::max(value, x[h * " << width << " + w]);\n";
+      } else {
+         out << "\t" << "\t" << "\t" << "\t" << "\t" << "\t" << "value += x[h * " << width << " + w];\n";
+         out << "\t" << "\t" << "\t" << "\t" << "\t" << "\t" << "count++;\n";
+      }
+      out << "\t" << "\t" << "\t" << "\t" << "\t" << "}\n";
+      out << "\t" << "\t" << "\t" << "\t" << "}\n";
+      if (!isMax && fAttr.count_include_pad) {
+         // the elements of the padding count, but not those beyond it that ceil_mode adds
+         out << "\t" << "\t" << "\t" << "\t" << "int hsize = std::min(hstart + " << fKernel[0] << ", "
+             << height + fPadsEnd[0] << ") - hstart;\n";
+         out << "\t" << "\t" << "\t" << "\t" << "int wsize = std::min(wstart + " << fKernel[1] << ", "
+             << width + fPadsEnd[1] << ") - wstart;\n";
+         out << "\t" << "\t" << "\t" << "\t" << "count = hsize * wsize;\n";
+      }
+      if (isMax) {
+         out << "\t" << "\t" << "\t" << "\t" << "y[oh * " << outWidth << " + ow] = value;\n";
+      } else {
+         out << "\t" << "\t" << "\t" << "\t" << "y[oh * " << outWidth << " + ow] = (count > 0) ? value / count : 0;\n";
+      }
+      out << "\t" << "\t" << "\t" << "}\n";
+      out << "\t" << "\t" << "}\n";
+      out << "\t" << "}\n";
+      return out.str();
+   }
+
+};
+
+} // namespace SOFIE
+} // namespace Experimental
+} // namespace TMVA
+
+#endif
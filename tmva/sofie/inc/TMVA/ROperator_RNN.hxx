@@ -109,6 +109,12 @@ template <typename T> class ROperator_RNN final : public ROperator {
    std::vector<std::vector<size_t>>
    ShapeInference(std::vector<std::vector<size_t>> input);
 
+   /*! \brief Returns the names of the input tensors */
+   std::vector<std::string> GetInputTensorNames() const;
+
+   /*! \brief Returns the names of the output tensors */
+   std::vector<std::string> GetOutputTensorNames() const;
+
    /*! \brief Initialize the model
     *
     * \param model Model
@@ -35,6 +35,9 @@ public:
       return ret;
    }
 
+   std::vector<std::string> GetInputTensorNames() const { return {fNX}; }
+   std::vector<std::string> GetOutputTensorNames() const { return {fNY}; }
+
    void Initialize(RModel& model){
       if (model.CheckIfTensorAlreadyExist(fNX) == false){   //input must be a graph input, or already initialized intermediate tensor
          throw std::runtime_error("TMVA SOFIE Relu Op Input Tensor is not found in model");
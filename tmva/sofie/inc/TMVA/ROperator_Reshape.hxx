@@ -0,0 +1,141 @@
+#ifndef TMVA_SOFIE_ROPERATOR_RESHAPE
+#define TMVA_SOFIE_ROPERATOR_RESHAPE
+
+#include "TMVA/SOFIE_common.hxx"
+#include "TMVA/ROperator.hxx"
+#include "TMVA/RModel.hxx"
+
+#include <sstream>
+
+namespace TMVA{
+namespace Experimental{
+namespace SOFIE{
+
+enum EReshapeOpMode { Reshape, Flatten };
+
+// Reshape and Flatten only change the shape of the tensor, the generated code copies the data
+template <typename T>
+class ROperator_Reshape final : public ROperator
+{
+
+private:
+
+   EReshapeOpMode fOpMode = Reshape;
+   int_t fAttrAxis = 1;      // axis of Flatten
+   int_t fAttrAllowZero = 0; // allowzero of Reshape
+
+   std::string fNData;
+   std::string fNShape;      // input with the requested shape of Reshape
+   std::string fNOutput;
+   std::vector<size_t> fShapeInput;
+   std::vector<size_t> fShapeOutput;
+
+public:
+
+   ROperator_Reshape(){}
+   ROperator_Reshape(int_t allowzero, std::string nameData, std::string nameShape, std::string nameOutput):
+      fOpMode(Reshape), fAttrAllowZero(allowzero), fNData(UTILITY::Clean_name(nameData)),
+      fNShape(UTILITY::Clean_name(nameShape)), fNOutput(UTILITY::Clean_name(nameOutput)){}
+   ROperator_Reshape(int_t axis, std::string nameData, std::string nameOutput):
+      fOpMode(Flatten), fAttrAxis(axis), fNData(UTILITY::Clean_name(nameData)), fNOutput(UTILITY::Clean_name(nameOutput)){}
+
+   std::vector<ETensorType> TypeInference(std::vector<ETensorType> input){
+      return {input[0]};
+   }
+
+   // the second input is the requested shape of Reshape
+   std::vector<std::vector<size_t>> ShapeInference(std::vector<std::vector<size_t>> input){
+      auto& shape = input[0];
+      size_t length = ConvertShapeToLength(shape);
+      std::vector<size_t> output_shape;
+      if (fOpMode == Flatten){
+         int_t axis = (fAttrAxis < 0) ? fAttrAxis + shape.size() : fAttrAxis;
+         if (axis < 0 || axis > (int_t) shape.size()){
+            throw std::runtime_error("TMVA SOFIE Flatten Op axis " + std::to_string(fAttrAxis) + " is out of range");
+         }
+         size_t outer = 1;
+         for (int_t i = 0; i < axis; i++) outer *= shape[i];
+         output_shape = {outer, length / outer};
+      }else{
+         auto& requested = input[1];
+         int inferred = -1;
+         size_t product = 1;
+         for (size_t i = 0; i < requested.size(); i++){
+            // the dimensions are stored as size_t, -1 becomes the largest value
+            if (requested[i] == static_cast<size_t>(-1)){
+               if (inferred >= 0) throw std::runtime_error("TMVA SOFIE Reshape Op more than one dimension is -1");
+               inferred = i;
+               output_shape.push_back(1);
+               continue;
+            }
+            size_t dim = requested[i];
+            if (dim == 0 && fAttrAllowZero == 0){
+               if (i >= shape.size()) throw std::runtime_error("TMVA SOFIE Reshape Op dimension 0 has no input dimension to copy");
+               dim = shape[i];
+            }
+            output_shape.push_back(dim);
+            product *= dim;
+         }
+         if (inferred >= 0){
+            if (product == 0 || length % product != 0){
+               throw std::runtime_error("TMVA SOFIE Reshape Op cannot infer the dimension of shape " + ConvertShapeToString(requested));
+            }
+            output_shape[inferred] = length / product;
+         }
+      }
+      if (ConvertShapeToLength(output_shape) != length){
+         throw std::runtime_error("TMVA SOFIE Reshape Op output shape " + ConvertShapeToString(output_shape) +
+                                  " has not the size of input shape " + ConvertShapeToString(shape));
+      }
+      return {output_shape};
+   }
+
+   // the shape input is only read in Initialize
+   std::vector<std::string> GetInputTensorNames() const { return {fNData}; }
+   std::vector<std::string> GetOutputTensorNames() const { return {fNOutput}; }
+
+   void Initialize(RModel& model){
+      if (model.CheckIfTensorAlreadyExist(fNData) == false){   //input must be a graph input, or already initialized intermediate tensor
+         throw std::runtime_error("TMVA SOFIE Reshape Op Input Tensor " + fNData + " is not found in model");
+      }
+      fShapeInput = model.GetTensorShape(fNData);
+      if (fOpMode == Reshape){
+         if (!model.IsInitializedTensor(fNShape)){
+            throw std::runtime_error("TMVA SOFIE Reshape Op shape tensor " + fNShape + " is not an initialized tensor");
+         }
+         if (model.GetTensorType(fNShape) != ETensorType::INT64){
+            throw std::runtime_error("TMVA SOFIE Reshape Op shape tensor " + fNShape + " is not of type int64");
+         }
+         auto data = static_cast<int64_t*>(model.GetInitializedTensorData(fNShape).get());
+         size_t n = ConvertShapeToLength(model.GetTensorShape(fNShape));
+         std::vector<size_t> requested(n);
+         for (size_t i = 0; i < n; i++){
+            requested[i] = static_cast<size_t>(data[i]);
+         }
+         fShapeOutput = ShapeInference({fShapeInput, requested})[0];
+      }else{
+         fShapeOutput = ShapeInference({fShapeInput})[0];
+      }
+      model.AddIntermediateTensor(fNOutput, model.GetTensorType(fNData), fShapeOutput);
+      model.AddNeededStdLib("algorithm");
+   }
+
+   std::string Generate(std::string OpName){
+      OpName = "op_" + OpName;
+      if (fShapeInput.empty() || fShapeOutput.empty()){
+         throw std::runtime_error("TMVA SOFIE Reshape Op called to Generate without being initialized first");
+      }
+      size_t length = ConvertShapeToLength(fShapeOutput);
+      std::stringstream out;
+      out << "\t" << "std::copy(tensor_" << fNData << ", tensor_" << fNData << " + " << length << ", tensor_" << fNOutput << ");\n";
+      return out.str();
+   }
+
+};
+
+}//SOFIE
+}//Experimental
+}//TMVA
+
+
+#endif //TMVA_SOFIE_ROPERATOR_RESHAPE
@@ -0,0 +1,101 @@
+#ifndef TMVA_SOFIE_ROPERATOR_SOFTMAX
+#define TMVA_SOFIE_ROPERATOR_SOFTMAX
+
+#include "TMVA/SOFIE_common.hxx"
+#include "TMVA/ROperator.hxx"
+#include "TMVA/RModel.hxx"
+
+#include <sstream>
+
+namespace TMVA{
+namespace Experimental{
+namespace SOFIE{
+
+// Softmax along one axis of the input (definition of ONNX opset 13, the default axis is the last one)
+template <typename T>
+class ROperator_Softmax final : public ROperator
+{
+
+private:
+
+   int_t fAttrAxis = -1;
+
+   std::string fNX;
+   std::string fNY;
+   std::vector<size_t> fShape;
+
+public:
+   ROperator_Softmax(){}
+   ROperator_Softmax(int_t axis, std::string nameX, std::string nameY):
+      fAttrAxis(axis), fNX(UTILITY::Clean_name(nameX)), fNY(UTILITY::Clean_name(nameY)){}
+
+   std::vector<ETensorType> TypeInference(std::vector<ETensorType> input){
+      return input;
+   }
+
+   std::vector<std::vector<size_t>> ShapeInference(std::vector<std::vector<size_t>> input){
+      auto ret = input; //suggest copy to compiler
+      return ret;
+   }
+
+   std::vector<std::string> GetInputTensorNames() const { return {fNX}; }
+   std::vector<std::string> GetOutputTensorNames() const { return {fNY}; }
+
+   void Initialize(RModel& model){
+      if (model.CheckIfTensorAlreadyExist(fNX) == false){   //input must be a graph input, or already initialized intermediate tensor
+         throw std::runtime_error("TMVA SOFIE Softmax Op Input Tensor is not found in model");
+      }
+      fShape = model.GetTensorShape(fNX);
+      int_t rank = fShape.size();
+      if (fAttrAxis < -rank || fAttrAxis >= rank){
+         throw std::runtime_error("TMVA SOFIE Softmax Op axis " + std::to_string(fAttrAxis) + " is out of range for input tensor " + fNX);
+      }
+      if (fAttrAxis < 0) fAttrAxis += rank;
+      model.AddIntermediateTensor(fNY, model.GetTensorType(fNX), fShape);
+      model.AddNeededStdLib("cmath");
+   }
+
+
+   std::string Generate(std::string OpName){
+      OpName = "op_" + OpName;
+      if (fShape.empty()){
+         throw std::runtime_error("TMVA SOFIE Softmax Op called to Generate without being initialized first");
+      }
+      // the input is seen as [outer, axis, inner]: the softmax is computed for each (outer, inner) pair
+      size_t outer = 1;
+      for (int_t i = 0; i < fAttrAxis; i++) outer *= fShape[i];
+      size_t axis = fShape[fAttrAxis];
+      size_t inner = 1;
+      for (size_t i = fAttrAxis + 1; i < fShape.size(); i++) inner *= fShape[i];
+
+      std::stringstream out;
+      out << "\t" << "for (int i = 0; i < " << outer << " ; i++){\n";
+      out << "\t\t" << "for (int j = 0; j < " << inner << " ; j++){\n";
+      out << "\t\t\t" << "const float* " << OpName << "_x = tensor_" << fNX << " + i * " << axis * inner << " + j;\n";
+      out << "\t\t\t" << "float* " << OpName << "_y = tensor_" << fNY << " + i * " << axis * inner << " + j;\n";
+      // subtracting the maximum avoids overflows in the exponential
+      out << "\t\t\t" << "float " << OpName << "_max = " << OpName << "_x[0];\n";
+      out << "\t\t\t" << "for (int k = 1; k < " << axis << " ; k++){\n";
+      out << "\t\t\t\t" << "if (" << OpName << "_x[k * " << inner << "] > " << OpName << "_max) " << OpName << "_max = " << OpName << "_x[k * " << inner << "];\n";
+      out << "\t\t\t" << "}\n";
+      out << "\t\t\t" << "float " << OpName << "_sum = 0;\n";
+      out << "\t\t\t" << "for (int k = 0; k < " << axis << " ; k++){\n";
+      out << "\t\t\t\t" << OpName << "_y[k * " << inner << "] = std::exp(" << OpName << "_x[k * " << inner << "] - " << OpName << "_max);\n";
+      out << "\t\t\t\t" << OpName << "_sum += " << OpName << "_y[k * " << inner << "];\n";
+      out << "\t\t\t" << "}\n";
+      out << "\t\t\t" << "for (int k = 0; k < " << axis << " ; k++){\n";
+      out << "\t\t\t\t" << OpName << "_y[k * " << inner << "] /= " << OpName << "_sum;\n";
+      out << "\t\t\t" << "}\n";
+      out << "\t\t" << "}\n";
+      out << "\t" << "}\n";
+      return out.str();
+   }
+
+};
+
+}//SOFIE
+}//Experimental
+}//TMVA
+
+
+#endif //TMVA_SOFIE_ROPERATOR_SOFTMAX
@@ -26,6 +26,28 @@ private:
    std::vector<size_t> fShapeData;
    std::vector<size_t> fShapeOutput;
 
+   bool fIsConstant = false; // the input is an initialized tensor, so the output is computed in Initialize
+
+   // position in the output of the first element of each dimension of the input
+   std::vector<size_t> OutputStrides(){
+      int dim = fShapeData.size();
+      std::vector<size_t> index_goto(dim);
+      for (int i = 0; i < dim; i++){
+         index_goto[fAttrPerm[i]] = i;
+      }
+      std::vector<size_t> new_sizeofindex(dim);
+      size_t t = 1;
+      for (int i = dim - 1; i>=0; i--){
+         new_sizeofindex[i] = t;
+         t *= fShapeOutput[i];
+      }
+      std::vector<size_t> strides(dim);
+      for (int i = 0; i < dim; i++){
+         strides[i] = new_sizeofindex[index_goto[i]];
+      }
+      return strides;
+   }
+
 public:
 
    ROperator_Transpose(){}
@@ -54,6 +76,12 @@ public:
    }
 
 
+   std::vector<std::string> GetInputTensorNames() const {
+      if (fIsConstant) return {};
+      return {fNData};
+   }
+   std::vector<std::string> GetOutputTensorNames() const { return {fNOutput}; }
+
    void Initialize(RModel& model){
       if (model.CheckIfTensorAlreadyExist(fNData) == false){   //input must be a graph input, or already initialized intermediate tensor
          throw std::runtime_error("TMVA SOFIE Tranpose Op Input Tensor is not found in model");
@@ -70,8 +98,30 @@ public:
          output_shape[fAttrPerm[i]] = fShapeData[i];
       }
 
-      model.AddIntermediateTensor(fNOutput, model.GetTensorType(fNData), output_shape);
       fShapeOutput = output_shape;
+
+      // fold the transpose of a constant, e.g. of the weights of a layer, into a new initialized tensor
+      if (std::is_same<T, float>::value && model.IsInitializedTensor(fNData) && !model.IsOutputTensor(fNOutput)){
+         const T* data = static_cast<const T*>(model.GetInitializedTensorData(fNData).get());
+         size_t length = ConvertShapeToLength(fShapeData);
+         std::shared_ptr<void> new_data_ptr(new T[length], std::default_delete<T[]>());
+         T* new_data = static_cast<T*>(new_data_ptr.get());
+         std::vector<size_t> strides = OutputStrides();
+         for (size_t id = 0; id < length; id++){
+            size_t index = 0;
+            size_t rest = id;
+            for (int i = fShapeData.size() - 1; i >= 0; i--){
+               index += rest % fShapeData[i] * strides[i];
+               rest /= fShapeData[i];
+            }
+            new_data[index] = data[id];
+         }
+         model.AddInitializedTensor(fNOutput, model.GetTensorType(fNData), fShapeOutput, new_data_ptr);
+         fIsConstant = true;
+         return;
+      }
+
+      model.AddIntermediateTensor(fNOutput, model.GetTensorType(fNData), output_shape);
    }
 
    std::string Generate(std::string OpName){
@@ -79,6 +129,9 @@ public:
       if (fShapeData.empty() || fShapeOutput.empty()){
          throw std::runtime_error("TMVA SOFIE Transpose Op called to Generate without being initialized first");
       }
+      if (fIsConstant){
+         return "";
+      }
       int dim = fShapeData.size();
       int length=1;
       std::vector<int> sizeofindex(dim);
@@ -86,22 +139,13 @@ public:
          sizeofindex[i] = length;
          length *= fShapeData[i];
       }
-      std::vector<int> index_goto(dim);
-      for (int i = 0; i < dim; i++){
-         index_goto[fAttrPerm[i]] = i;
-      }
-      std::vector<int> new_sizeofindex(dim);
-      int t = 1;
-      for (int i = dim - 1; i>=0; i--){
-         new_sizeofindex[i] = t;
-         t *= fShapeOutput[i];
-      }
+      std::vector<size_t> strides = OutputStrides();
 
       std::stringstream out;
       out << "\t" << "for (int id = 0; id < " << length << " ; id++){\n";
       out << "\t\t " << "tensor_" << fNOutput << "[";
       for (int i =0; i < dim; i++){
-         out << "id / " << sizeofindex[i] << " % " << fShapeData[i] << " * " << new_sizeofindex[index_goto[i]];
+         out << "id / " << sizeofindex[i] << " % " << fShapeData[i] << " * " << strides[i];
          if (i != dim - 1) out << " + ";
       }
       out << "] = " << "tensor_" << fNData << "[id];\n";
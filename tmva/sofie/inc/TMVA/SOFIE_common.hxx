@@ -22,6 +22,11 @@ enum class ETensorType{
     FLOAT16 = 10, DOUBLE = 11, UINT32 = 12, UINT64 = 13, COMPLEX64 = 14, COMPLEX28 = 15, BFLOAT16 = 16
 };
 
+// activation functions that an operator can apply to its output, see ROperator_Gemm::FuseActivation
+enum class EActivationType{
+   UNDEFINED = 0, RELU = 1, SIGMOID = 2, SELU = 3
+};
+
 typedef std::int64_t int_t;
 
 std::string ConvertTypeToString(ETensorType type);
@@ -63,6 +68,7 @@ struct InitializedTensor{
       }
       switch(fType){
          case ETensorType::FLOAT: fSize*=sizeof(float); break;
+         case ETensorType::INT64: fSize*=sizeof(int64_t); break;
          default:
           throw std::runtime_error("TMVA::SOFIE doesn't yet supports serialising data-type " + ConvertTypeToString(fType));
       }
@@ -75,6 +81,12 @@ struct InitializedTensor{
       std::memcpy(tData.get(), fPersistentData,fSize * sizeof(float));
       fData=tData;
       break;
+      }
+       case ETensorType::INT64: {
+      std::shared_ptr<void> tData(malloc(fSize * sizeof(int64_t)), free);
+      std::memcpy(tData.get(), fPersistentData,fSize * sizeof(int64_t));
+      fData=tData;
+      break;
       }
       default: {
           throw std::runtime_error("TMVA::SOFIE doesn't yet supports serialising data-type " + ConvertTypeToString(fType));
@@ -105,6 +117,14 @@ namespace UTILITY{
 template<typename T>
 T* Unidirectional_broadcast(const T* original_data, const std::vector<size_t> original_shape, const std::vector<size_t> target_shape);
 std::string Clean_name(std::string input_tensor_name);
+
+// The alpha and beta of each of the activation functions of a recurrent layer: the values of the ONNX attributes
+// activation_alpha and activation_beta are taken in order by the functions which need them, the others get the
+// default value of the corresponding ONNX operator.
+std::vector<std::pair<float, float>> ActivationParameters(const std::vector<std::string>& activations,
+   const std::vector<float>& alpha, const std::vector<float>& beta);
+// C++ expression of the activation function of a recurrent layer applied to the expression x
+std::string GenerateActivation(const std::string& activation, const std::string& x, std::pair<float, float> parameters);
 }
 
 namespace BLAS{
@@ -1,6 +1,13 @@
 #include <limits>
+#include <algorithm>
 
 #include "TMVA/RModel.hxx"
+#include "TMVA/ROperator_BatchNormalization.hxx"
+#include "TMVA/ROperator_Conv.hxx"
+#include "TMVA/ROperator_Gemm.hxx"
+#include "TMVA/ROperator_Relu.hxx"
+#include "TMVA/ROperator_Selu.hxx"
+#include "TMVA/ROperator_Sigmoid.hxx"
 
 
 
@@ -93,6 +100,14 @@ namespace SOFIE{
       return false;
    }
 
+   bool RModel::IsInitializedTensor(const std::string& tensor_name) const {
+      return fInitializedTensors.find(tensor_name) != fInitializedTensors.end();
+   }
+
+   bool RModel::IsOutputTensor(const std::string& tensor_name) const {
+      return std::find(fOutputTensorNames.begin(), fOutputTensorNames.end(), tensor_name) != fOutputTensorNames.end();
+   }
+
    void RModel::AddInputTensorInfo(std::string input_name, ETensorType type, std::vector<Dim> shape){
       input_name = UTILITY::Clean_name(input_name);
       if (CheckIfTensorAlreadyExist(input_name)){
@@ -164,14 +179,152 @@ namespace SOFIE{
       }
    }
 
-   void RModel::Initialize(){
+   void RModel::Initialize(int batchSize){
+      // inputs with parametric dimensions get their shape now, so that the same model can be generated for
+      // the batch size that suits the application
+      if (batchSize > 0){
+         for (auto& input: fInputTensorInfos){
+            std::vector<size_t> shape;
+            for (auto& dim: input.second.shape){
+               shape.push_back(dim.isParam ? batchSize : dim.dim);
+            }
+            fReadyInputTensorInfos[input.first] = TensorInfo{input.second.type, shape};
+         }
+         fInputTensorInfos.clear();
+      }
       for (auto& i : fOperators){
          i->Initialize(*this);
       }
    }
 
-   void RModel::Generate(){
-      Initialize();
+   void RModel::FuseOperators(){
+      std::unordered_map<std::string, size_t> nUses;
+      for (auto& op: fOperators){
+         for (auto& name: op->GetInputTensorNames()){
+            nUses[name]++;
+         }
+      }
+      // a batch normalization of the output of a Gemm or of a Conv with constant weights, when the output is used
+      // nowhere else, is folded into the weights and the bias of the layer
+      for (size_t j = 0; j < fOperators.size(); j++){
+         auto batchNorm = dynamic_cast<ROperator_BatchNormalization<float>*>(fOperators[j].get());
+         if (batchNorm == nullptr) continue;
+         std::string nameX = batchNorm->GetInputTensorNames()[0];
+         if (nUses[nameX] != 1 || IsOutputTensor(nameX)) continue;
+         for (size_t i = 0; i < j; i++){
+            auto outputs = fOperators[i]->GetOutputTensorNames();
+            if (std::find(outputs.begin(), outputs.end(), nameX) == outputs.end()) continue;
+            bool fused = false;
+            std::string nameY = batchNorm->GetOutputTensorNames()[0];
+            if (auto gemm = dynamic_cast<ROperator_Gemm<float>*>(fOperators[i].get())){
+               fused = gemm->FuseBatchNormalization(*this, batchNorm->GetScale(), batchNorm->GetShift(), nameY);
+            } else if (auto conv = dynamic_cast<ROperator_Conv<float>*>(fOperators[i].get())){
+               fused = conv->FuseBatchNormalization(*this, batchNorm->GetScale(), batchNorm->GetShift(), nameY);
+            }
+            if (fused){
+               fIntermediateTensorInfos.erase(nameX);
+               fOperators.erase(fOperators.begin() + j);
+               j--;
+            }
+            break;
+         }
+      }
+      // a Gemm followed by an activation reading its output, which is used nowhere else, applies the activation
+      // itself: Y of the Gemm is not needed anymore and the activation is done on data that is still in the cache
+      for (size_t i = 0; i < fOperators.size(); i++){
+         auto gemm = dynamic_cast<ROperator_Gemm<float>*>(fOperators[i].get());
+         if (gemm == nullptr) continue;
+         std::string nameY = gemm->GetOutputTensorNames()[0];
+         if (nUses[nameY] != 1 || IsOutputTensor(nameY)) continue;
+         for (size_t j = i + 1; j < fOperators.size(); j++){
+            auto inputs = fOperators[j]->GetInputTensorNames();
+            if (std::find(inputs.begin(), inputs.end(), nameY) == inputs.end()) continue;
+            EActivationType activation = EActivationType::UNDEFINED;
+            if (dynamic_cast<ROperator_Relu<float>*>(fOperators[j].get())){
+               activation = EActivationType::RELU;
+            } else if (dynamic_cast<ROperator_Sigmoid<float>*>(fOperators[j].get())){
+               activation = EActivationType::SIGMOID;
+            } else if (dynamic_cast<ROperator_Selu<float>*>(fOperators[j].get())){
+               activation = EActivationType::SELU;
+            }
+            if (activation != EActivationType::UNDEFINED){
+               gemm->FuseActivation(activation, fOperators[j]->GetOutputTensorNames()[0]);
+               fIntermediateTensorInfos.erase(nameY);
+               fOperators.erase(fOperators.begin() + j);
+            }
+            break;
+         }
+      }
+   }
+
+   std::vector<std::vector<std::string>> RModel::PlanIntermediateMemory(std::vector<size_t>& bufferLengths){
+      // Assign the intermediate tensors to buffers, such that the tensors sharing a buffer are never needed at the
+      // same time: a tensor lives from the operator writing it to the last operator reading it. The output tensors
+      // of the model are returned by the inference function, so they keep their own memory.
+      std::vector<std::vector<std::string>> buffers;
+      bufferLengths.clear();
+      std::unordered_map<std::string, size_t> firstUse;
+      std::unordered_map<std::string, size_t> lastUse;
+      std::vector<std::string> tensors;
+      for (size_t id = 0; id < fOperators.size(); id++){
+         auto outputs = fOperators[id]->GetOutputTensorNames();
+         if (outputs.empty()) return buffers;   // an operator without the information: no sharing at all
+         for (auto& name: outputs){
+            auto f = fIntermediateTensorInfos.find(name);
+            if (f == fIntermediateTensorInfos.end() || f->second.type != ETensorType::FLOAT || IsOutputTensor(name)) continue;
+            if (firstUse.find(name) != firstUse.end()) continue;
+            firstUse[name] = id;
+            lastUse[name] = id;
+            tensors.push_back(name);
+         }
+         for (auto& name: fOperators[id]->GetInputTensorNames()){
+            auto f = lastUse.find(name);
+            if (f != lastUse.end()) f->second = id;
+         }
+      }
+
+      std::vector<size_t> bufferLastUse;
+      for (auto& name: tensors){
+         size_t length = ConvertShapeToLength(fIntermediateTensorInfos[name].shape);
+         // among the free buffers, take the smallest one that is large enough, or else the largest one
+         size_t best = buffers.size();
+         for (size_t b = 0; b < buffers.size(); b++){
+            if (bufferLastUse[b] >= firstUse[name]) continue;
+            if (best == buffers.size()){
+               best = b;
+            } else if (bufferLengths[best] >= length){
+               if (bufferLengths[b] >= length && bufferLengths[b] < bufferLengths[best]) best = b;
+            } else if (bufferLengths[b] > bufferLengths[best]){
+               best = b;
+            }
+         }
+         if (best == buffers.size()){
+            buffers.emplace_back();
+            bufferLengths.push_back(0);
+            bufferLastUse.push_back(0);
+         }
+         buffers[best].push_back(name);
+         bufferLengths[best] = std::max(bufferLengths[best], length);
+         bufferLastUse[best] = lastUse[name];
+      }
+      return buffers;
+   }
+
+   void RModel::Generate(bool optimizeGraph, int batchSize){
+      Initialize(batchSize);
+      std::vector<std::vector<std::string>> buffers;
+      std::vector<size_t> bufferLengths;
+      std::unordered_set<std::string> usedTensors;
+      bool knownUses = true;
+      if (optimizeGraph){
+         FuseOperators();
+         buffers = PlanIntermediateMemory(bufferLengths);
+         for (auto& op: fOperators){
+            auto inputs = op->GetInputTensorNames();
+            if (op->GetOutputTensorNames().empty()) knownUses = false;
+            usedTensors.insert(inputs.begin(), inputs.end());
+         }
+      }
       fGC += ("//Code generated automatically by TMVA for Inference of Model file [" + fFileName + "] at [" + fParseTime.substr(0, fParseTime.length()-1) +"] \n");
       for (auto& i: fNeededStdLib) {
          fGC += "#include<" + i + ">\n";
@@ -195,12 +348,15 @@ namespace SOFIE{
          fGC += ("}//BLAS\n");
       }
       for (auto& i: fInitializedTensors){
+         // constants replaced by their folded values, e.g. transposed weights, are not needed anymore
+         if (optimizeGraph && knownUses && usedTensors.find(i.first) == usedTensors.end()) continue;
          if (i.second.fType == ETensorType::FLOAT){
             size_t length = 1;
             for (auto & dim: i.second.fShape){
                length *= dim;
             }
-            fGC += "float tensor_" + i.first + "[" + std::to_string(length) + "] = {";
+            // aligned to the cache lines, for the vectorized loops of the operators
+            fGC += "alignas(64) float tensor_" + i.first + "[" + std::to_string(length) + "] = {";
             std::shared_ptr<float> data = std::static_pointer_cast<float>(i.second.fData);
             std::stringstream floats;
             for (size_t idx = 0; idx < length-1; idx++){
@@ -210,13 +366,22 @@ namespace SOFIE{
             fGC += floats.str() +"};\n";
          }
       }
+      std::unordered_set<std::string> sharedTensors;
+      for (size_t b = 0; b < buffers.size(); b++){
+         fGC += "alignas(64) float intermediate_buffer_" + std::to_string(b) + "[" + std::to_string(bufferLengths[b]) + "];\n";
+         for (auto& name: buffers[b]){
+            fGC += "float * const tensor_" + name + " = intermediate_buffer_" + std::to_string(b) + ";\n";
+            sharedTensors.insert(name);
+         }
+      }
       for (auto&i: fIntermediateTensorInfos){
+         if (sharedTensors.find(i.first) != sharedTensors.end()) continue;
          if (i.second.type == ETensorType::FLOAT){
             size_t length = 1;
             for (auto & dim: i.second.shape){
                length *= dim;
             }
-            fGC += "float tensor_" + i.first + "[" + std::to_string(length) + "];\n";
+            fGC += "alignas(64) float tensor_" + i.first + "[" + std::to_string(length) + "];\n";
          }
       }
 
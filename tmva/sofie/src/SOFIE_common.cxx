@@ -1,6 +1,8 @@
 #include "TMVA/SOFIE_common.hxx"
 #include<cctype>
 #include <sstream>
+#include <iomanip>
+#include <limits>
 
 namespace TMVA{
 namespace Experimental{
@@ -25,6 +27,9 @@ std::string ConvertTypeToString(ETensorType type){
       case ETensorType::FLOAT : {
          return "float";
       }
+      case ETensorType::INT64 : {
+         return "int64_t";
+      }
       default:{
          return "other";
       }
@@ -141,6 +146,66 @@ std::string UTILITY::Clean_name(std::string input_tensor_name){
    return s;
 }
 
+std::vector<std::pair<float, float>> UTILITY::ActivationParameters(const std::vector<std::string>& activations,
+   const std::vector<float>& alpha, const std::vector<float>& beta){
+   std::vector<std::pair<float, float>> parameters;
+   size_t iAlpha = 0;
+   size_t iBeta = 0;
+   for (auto& activation: activations){
+      std::pair<float, float> p(1., 0.);
+      bool hasAlpha = true;
+      bool hasBeta = false;
+      if (activation == "LeakyRelu"){
+         p.first = 0.01;
+      } else if (activation == "HardSigmoid"){
+         p = {0.2, 0.5};
+         hasBeta = true;
+      } else if (activation == "Affine" || activation == "ScaledTanh"){
+         p.second = (activation == "ScaledTanh") ? 1. : 0.;
+         hasBeta = true;
+      } else if (activation != "Elu" && activation != "ThresholdedRelu"){
+         hasAlpha = false;
+      }
+      if (hasAlpha && iAlpha < alpha.size()) p.first = alpha[iAlpha++];
+      if (hasBeta && iBeta < beta.size()) p.second = beta[iBeta++];
+      parameters.push_back(p);
+   }
+   return parameters;
+}
+
+std::string UTILITY::GenerateActivation(const std::string& activation, const std::string& x, std::pair<float, float> parameters){
+   std::stringstream out;
+   out << std::setprecision(std::numeric_limits<float>::max_digits10);
+   float alpha = parameters.first;
+   float beta = parameters.second;
+   if (activation == "Sigmoid"){
+      out << "1.f / (1.f + std::exp(-" << x << "))";
+   } else if (activation == "Tanh"){
+      out << "std::tanh(" << x << ")";
+   } else if (activation == "Relu"){
+      out << "std::max(" << x << ", 0.f)";
+   } else if (activation == "LeakyRelu"){
+      out << "((" << x << " >= 0) ? " << x << " : " << alpha << " * " << x << ")";
+   } else if (activation == "ThresholdedRelu"){
+      out << "((" << x << " > " << alpha << ") ? " << x << " : 0.f)";
+   } else if (activation == "Elu"){
+      out << "((" << x << " >= 0) ? " << x << " : " << alpha << " * (std::exp(" << x << ") - 1.f))";
+   } else if (activation == "HardSigmoid"){
+      out << "std::max(0.f, std::min(1.f, float(" << alpha << " * " << x << " + " << beta << ")))";
+   } else if (activation == "Affine"){
+      out << "(" << alpha << " * " << x << " + " << beta << ")";
+   } else if (activation == "ScaledTanh"){
+      out << "(" << alpha << " * std::tanh(" << beta << " * " << x << "))";
+   } else if (activation == "Softsign"){
+      out << "(" << x << " / (1.f + std::abs(" << x << ")))";
+   } else if (activation == "Softplus"){
+      out << "std::log(1.f + std::exp(" << x << "))";
+   } else {
+      throw std::runtime_error("TMVA SOFIE - Activation function " + activation + " not implemented");
+   }
+   return out.str();
+}
+
 template float* UTILITY::Unidirectional_broadcast(const float* original_data, const std::vector<size_t> original_shape, const std::vector<size_t> target_shape);
 
 }//SOFIE
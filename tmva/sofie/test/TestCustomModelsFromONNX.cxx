@@ -48,6 +48,18 @@
 #include "RNNSequenceBatchwise_FromONNX.hxx"
 #include "input_models/references/RNNSequenceBatchwise.ref.hxx"
 
+#include "ConvBatchNormMaxPool_FromONNX.hxx"
+#include "input_models/references/ConvBatchNormMaxPool.ref.hxx"
+
+#include "AvgPoolConcatReshape_FromONNX.hxx"
+#include "input_models/references/AvgPoolConcatReshape.ref.hxx"
+
+#include "LSTMSequence_FromONNX.hxx"
+#include "input_models/references/LSTMSequence.ref.hxx"
+
+#include "GRUSequence_FromONNX.hxx"
+#include "input_models/references/GRUSequence.ref.hxx"
+
 #include "gtest/gtest.h"
 
 constexpr float DEFAULT_TOLERANCE = 1e-3f;
@@ -474,3 +486,120 @@ TEST(ONNX, RNNSequenceBatchwise)
       EXPECT_LE(std::abs(output_yh[i] - correct_yh[i]), TOLERANCE);
    }
 }
+
+TEST(ONNX, ConvBatchNormMaxPool)
+{
+   constexpr float TOLERANCE = DEFAULT_TOLERANCE;
+
+   // Conv, BatchNormalization (folded into the Conv), Relu, MaxPool, Flatten, Gemm and Softmax
+   std::vector<float> input(16);
+   for (size_t i = 0; i < input.size(); ++i)
+      input[i] = 0.1f * i;
+   std::vector<float> output = TMVA_SOFIE_ConvBatchNormMaxPool::infer(input.data());
+
+   // Checking output size
+   EXPECT_EQ(output.size(), sizeof(ConvBatchNormMaxPool_ExpectedOutput::all_ones) / sizeof(float));
+
+   float *correct = ConvBatchNormMaxPool_ExpectedOutput::all_ones;
+
+   // Checking every output value, one by one
+   for (size_t i = 0; i < output.size(); ++i) {
+      EXPECT_LE(std::abs(output[i] - correct[i]), TOLERANCE);
+   }
+}
+
+TEST(ONNX, AvgPoolConcatReshape)
+{
+   constexpr float TOLERANCE = DEFAULT_TOLERANCE;
+
+   // LeakyRelu, broadcast Add and Mul, AveragePool, GlobalAveragePool, Reshape and Concat
+   std::vector<float> input(18);
+   for (size_t i = 0; i < input.size(); ++i)
+      input[i] = 0.25f * i - 1.5f;
+   std::vector<float> output = TMVA_SOFIE_AvgPoolConcatReshape::infer(input.data());
+
+   // Checking output size
+   EXPECT_EQ(output.size(), sizeof(AvgPoolConcatReshape_ExpectedOutput::all_ones) / sizeof(float));
+
+   float *correct = AvgPoolConcatReshape_ExpectedOutput::all_ones;
+
+   // Checking every output value, one by one
+   for (size_t i = 0; i < output.size(); ++i) {
+      EXPECT_LE(std::abs(output[i] - correct[i]), TOLERANCE);
+   }
+}
+
+TEST(ONNX, LSTMSequence)
+{
+   constexpr float TOLERANCE = DEFAULT_TOLERANCE;
+
+   std::vector<float> input(12);
+   for (size_t i = 0; i < input.size(); ++i)
+      input[i] = 0.1f * (i + 1);
+   std::vector<std::vector<float>> output = TMVA_SOFIE_LSTMSequence::infer(input.data());
+   std::vector<float> output_y = output[0];
+   std::vector<float> output_yh = output[1];
+   std::vector<float> output_yc = output[2];
+
+   // Checking output size
+   EXPECT_EQ(output_y.size(), sizeof(LSTMSequence_ExpectedOutput::all_ones_y) / sizeof(float));
+
+   float *correct_y = LSTMSequence_ExpectedOutput::all_ones_y;
+
+   // Checking every output value, one by one
+   for (size_t i = 0; i < output_y.size(); ++i) {
+      EXPECT_LE(std::abs(output_y[i] - correct_y[i]), TOLERANCE);
+   }
+
+   // Checking output size
+   EXPECT_EQ(output_yh.size(), sizeof(LSTMSequence_ExpectedOutput::all_ones_yh) / sizeof(float));
+
+   float *correct_yh = LSTMSequence_ExpectedOutput::all_ones_yh;
+
+   // Checking every output value, one by one
+   for (size_t i = 0; i < output_yh.size(); ++i) {
+      EXPECT_LE(std::abs(output_yh[i] - correct_yh[i]), TOLERANCE);
+   }
+
+   // Checking output size
+   EXPECT_EQ(output_yc.size(), sizeof(LSTMSequence_ExpectedOutput::all_ones_yc) / sizeof(float));
+
+   float *correct_yc = LSTMSequence_ExpectedOutput::all_ones_yc;
+
+   // Checking every output value, one by one
+   for (size_t i = 0; i < output_yc.size(); ++i) {
+      EXPECT_LE(std::abs(output_yc[i] - correct_yc[i]), TOLERANCE);
+   }
+}
+
+TEST(ONNX, GRUSequence)
+{
+   constexpr float TOLERANCE = DEFAULT_TOLERANCE;
+
+   std::vector<float> input(12);
+   for (size_t i = 0; i < input.size(); ++i)
+      input[i] = 0.1f * (i + 1);
+   std::vector<std::vector<float>> output = TMVA_SOFIE_GRUSequence::infer(input.data());
+   std::vector<float> output_y = output[0];
+   std::vector<float> output_yh = output[1];
+
+   // Checking output size
+   EXPECT_EQ(output_y.size(), sizeof(GRUSequence_ExpectedOutput::all_ones_y) / sizeof(float));
+
+   float *correct_y = GRUSequence_ExpectedOutput::all_ones_y;
+
+   // Checking every output value, one by one
+   for (size_t i = 0; i < output_y.size(); ++i) {
+      EXPECT_LE(std::abs(output_y[i] - correct_y[i]), TOLERANCE);
+   }
+
+   // Checking output size
+   EXPECT_EQ(output_yh.size(), sizeof(GRUSequence_ExpectedOutput::all_ones_yh) / sizeof(float));
+
+   float *correct_yh = GRUSequence_ExpectedOutput::all_ones_yh;
+
+   // Checking every output value, one by one
+   for (size_t i = 0; i < output_yh.size(); ++i) {
+      EXPECT_LE(std::abs(output_yh[i] - correct_yh[i]), TOLERANCE);
+   }
+}
@@ -0,0 +1,7 @@
+namespace AvgPoolConcatReshape_ExpectedOutput {
+float all_ones[] = {0.490625, 0.321875, 0.4375, 0.6125,
+                    0.51875, 0.7375, 0.6875, 0.6875,
+                    1, 0.57916667, 0.21875, 0.40625,
+                    0.625, 1.15625, 0.96875, 1.375,
+                    1.625, 1.25, 1.75, 0.79166667};
+} // namespace AvgPoolConcatReshape_ExpectedOutput
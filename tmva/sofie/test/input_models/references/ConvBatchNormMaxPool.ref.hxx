@@ -0,0 +1,3 @@
+namespace ConvBatchNormMaxPool_ExpectedOutput {
+float all_ones[] = {0.033767564, 0.82413236, 0.14210007};
+} // namespace ConvBatchNormMaxPool_ExpectedOutput
@@ -0,0 +1,10 @@
+namespace GRUSequence_ExpectedOutput {
+float all_ones_y[] = {0.018366772, 0.039962742, -0.069546224, 0.049014458,
+                      0.045109822, -0.087259863, 0.090802801, 0.067393146,
+                      -0.14330446, 0.13582511, 0.074887365, -0.16938293,
+                      0.18702446, 0.089138472, -0.21692583, 0.2374666,
+                      0.097589969, -0.2466122};
+
+float all_ones_yh[] = {0.18702446, 0.089138472, -0.21692583, 0.2374666,
+                       0.097589969, -0.2466122};
+} // namespace GRUSequence_ExpectedOutput
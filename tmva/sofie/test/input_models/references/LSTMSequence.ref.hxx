@@ -0,0 +1,13 @@
+namespace LSTMSequence_ExpectedOutput {
+float all_ones_y[] = {-0.014634649, -0.0013256821, 0.023539438, -0.0094061978,
+                      -0.0089145041, 0.031129238, -0.010944457, -0.015807028,
+                      0.049555525, -0.0022760093, -0.025408037, 0.060072625,
+                      0.0032188309, -0.033863408, 0.07532888, 0.014372582,
+                      -0.043237594, 0.086720763};
+
+float all_ones_yh[] = {0.0032188309, -0.033863408, 0.07532888, 0.014372582,
+                       -0.043237594, 0.086720763};
+
+float all_ones_yc[] = {0.0064792576, -0.076357498, 0.15988311, 0.029132867,
+                       -0.10098072, 0.18459727};
+} // namespace LSTMSequence_ExpectedOutput
@@ -31,6 +31,16 @@ std::unique_ptr<ROperator> make_ROperator_Sigmoid(const onnx::NodeProto& nodepro
 std::unique_ptr<ROperator> make_ROperator_Gemm(const onnx::NodeProto& nodeproto, const onnx::GraphProto& graphproto, std::unordered_map<std::string, ETensorType>& tensor_type);
 std::unique_ptr<ROperator> make_ROperator_Conv(const onnx::NodeProto& nodeproto, const onnx::GraphProto& graphproto, std::unordered_map<std::string, ETensorType>& tensor_type);
 std::unique_ptr<ROperator> make_ROperator_RNN(const onnx::NodeProto& nodeproto, const onnx::GraphProto& graphproto, std::unordered_map<std::string, ETensorType>& tensor_type);
+std::unique_ptr<ROperator> make_ROperator_LSTM(const onnx::NodeProto& nodeproto, const onnx::GraphProto& graphproto, std::unordered_map<std::string, ETensorType>& tensor_type);
+std::unique_ptr<ROperator> make_ROperator_GRU(const onnx::NodeProto& nodeproto, const onnx::GraphProto& graphproto, std::unordered_map<std::string, ETensorType>& tensor_type);
+std::unique_ptr<ROperator> make_ROperator_LeakyRelu(const onnx::NodeProto& nodeproto, const onnx::GraphProto& graphproto, std::unordered_map<std::string, ETensorType>& tensor_type);
+std::unique_ptr<ROperator> make_ROperator_Softmax(const onnx::NodeProto& nodeproto, const onnx::GraphProto& graphproto, std::unordered_map<std::string, ETensorType>& tensor_type);
+template <EBasicBinaryOperator Op>
+std::unique_ptr<ROperator> make_ROperator_BasicBinary(const onnx::NodeProto& nodeproto, const onnx::GraphProto& graphproto, std::unordered_map<std::string, ETensorType>& tensor_type);
+std::unique_ptr<ROperator> make_ROperator_Reshape(const onnx::NodeProto& nodeproto, const onnx::GraphProto& graphproto, std::unordered_map<std::string, ETensorType>& tensor_type);
+std::unique_ptr<ROperator> make_ROperator_Concat(const onnx::NodeProto& nodeproto, const onnx::GraphProto& graphproto, std::unordered_map<std::string, ETensorType>& tensor_type);
+std::unique_ptr<ROperator> make_ROperator_BatchNormalization(const onnx::NodeProto& nodeproto, const onnx::GraphProto& graphproto, std::unordered_map<std::string, ETensorType>& tensor_type);
+std::unique_ptr<ROperator> make_ROperator_Pool(const onnx::NodeProto& nodeproto, const onnx::GraphProto& graphproto, std::unordered_map<std::string, ETensorType>& tensor_type);
 
 
 using factoryMethodMap = std::unordered_map<std::string, std::unique_ptr<ROperator> (*)(const onnx::NodeProto&, const onnx::GraphProto&, std::unordered_map<std::string, ETensorType>&)>;
@@ -41,7 +51,23 @@ const factoryMethodMap mapOptypeOperator = {
       {"Conv", &make_ROperator_Conv},
       {"RNN", &make_ROperator_RNN},
       {"Selu", &make_ROperator_Selu},
-      {"Sigmoid", &make_ROperator_Sigmoid}
+      {"Sigmoid", &make_ROperator_Sigmoid},
+      {"LSTM", &make_ROperator_LSTM},
+      {"GRU", &make_ROperator_GRU},
+      {"LeakyRelu", &make_ROperator_LeakyRelu},
+      {"Softmax", &make_ROperator_Softmax},
+      {"Add", &make_ROperator_BasicBinary<EBasicBinaryOperator::Add>},
+      {"Sub", &make_ROperator_BasicBinary<EBasicBinaryOperator::Sub>},
+      {"Mul", &make_ROperator_BasicBinary<EBasicBinaryOperator::Mul>},
+      {"Div", &make_ROperator_BasicBinary<EBasicBinaryOperator::Div>},
+      {"Reshape", &make_ROperator_Reshape},
+      {"Flatten", &make_ROperator_Reshape},
+      {"Concat", &make_ROperator_Concat},
+      {"BatchNormalization", &make_ROperator_BatchNormalization},
+      {"MaxPool", &make_ROperator_Pool},
+      {"AveragePool", &make_ROperator_Pool},
+      {"GlobalMaxPool", &make_ROperator_Pool},
+      {"GlobalAveragePool", &make_ROperator_Pool}
    };
 
 
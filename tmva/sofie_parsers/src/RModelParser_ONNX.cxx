@@ -3,6 +3,7 @@
 
 #include <string>
 #include <memory>
+#include <algorithm>
 
 namespace TMVA{
 namespace Experimental{
@@ -365,6 +366,505 @@ std::unique_ptr<ROperator> make_ROperator_RNN(const onnx::NodeProto& nodeproto,
 
    return op;
 }
+
+std::unique_ptr<ROperator> make_ROperator_LSTM(const onnx::NodeProto& nodeproto, const onnx::GraphProto& /* graphproto */, std::unordered_map<std::string, ETensorType>& tensor_type) {
+
+   ETensorType input_type;
+
+   auto input_name = nodeproto.input(0);
+   auto it = tensor_type.find(input_name);
+   if (it != tensor_type.end()) {
+      input_type = it->second;
+   } else {
+      throw
+         std::runtime_error("TMVA::SOFIE ONNX Parser LSTM op has input tensor " + input_name + " but its type is not yet registered");
+   }
+
+   std::unique_ptr<ROperator> op;
+
+   std::vector<float> attr_activation_alpha = {};
+   std::vector<float> attr_activation_beta = {};
+   std::vector<std::string> attr_activations = {};
+   float attr_clip = 0.;
+   std::string attr_direction = "forward";
+   size_t attr_hidden_size = 0;
+   size_t attr_input_forget = 0;
+   size_t attr_layout = 0;
+
+   for (int_t i = 0; i < nodeproto.attribute_size(); i++) {
+      std::string attribute_name = nodeproto.attribute(i).name();
+      if (attribute_name == "activation_alpha") {
+         attr_activation_alpha = {nodeproto.attribute(i).floats().begin(), nodeproto.attribute(i).floats().end()};
+      } else if (attribute_name == "activation_beta") {
+         attr_activation_beta = {nodeproto.attribute(i).floats().begin(), nodeproto.attribute(i).floats().end()};
+      } else if (attribute_name == "activations") {
+         attr_activations = {nodeproto.attribute(i).strings().begin(), nodeproto.attribute(i).strings().end()};
+      } else if (attribute_name == "clip") {
+         attr_clip = nodeproto.attribute(i).f();
+      } else if (attribute_name == "direction") {
+         attr_direction = nodeproto.attribute(i).s();
+      } else if (attribute_name == "hidden_size") {
+         attr_hidden_size = nodeproto.attribute(i).i();
+      } else if (attribute_name == "input_forget") {
+         attr_input_forget = nodeproto.attribute(i).i();
+      } else if (attribute_name == "layout") {
+         attr_layout = nodeproto.attribute(i).i();
+      } else {
+         std::cout << "TMVA SOFIE Warning - Model Loading - Attribute " << attribute_name << " in OperatorNode " << nodeproto.name() << " is not defined in ONNX IR and not applied!\n";
+      }
+   }
+
+   // Optional inputs and outputs, an empty name marks an input or output that is not used
+   std::vector<std::string> inputs(8);
+   for (int_t i = 3; i < nodeproto.input_size() && i < 8; i++) {
+      inputs[i] = nodeproto.input(i);
+   }
+   std::vector<std::string> outputs(3);
+   for (int_t i = 0; i < nodeproto.output_size() && i < 3; i++) {
+      outputs[i] = nodeproto.output(i);
+   }
+
+   switch(input_type) {
+      case ETensorType::FLOAT:
+            op.reset(new ROperator_LSTM<float>(attr_activation_alpha, attr_activation_beta, attr_activations,
+               attr_clip, attr_direction, attr_hidden_size, attr_input_forget, attr_layout,
+               nodeproto.input(0), nodeproto.input(1), nodeproto.input(2),
+               inputs[3], inputs[4], inputs[5], inputs[6], inputs[7], outputs[0], outputs[1], outputs[2]));
+         break;
+      default:
+         throw
+            std::runtime_error("TMVA::SOFIE - Unsupported - Operator LSTM does not yet support input type " + std::to_string(static_cast<int>(input_type)));
+   }
+
+   auto output_type = op->TypeInference({input_type, input_type});
+   for (size_t i = 0; i < 3; i++) {
+      if (!outputs[i].empty() && tensor_type.find(outputs[i]) == tensor_type.end()) {
+         tensor_type[outputs[i]] = output_type[i];
+      }
+   }
+
+   return op;
+}
+
+std::unique_ptr<ROperator> make_ROperator_GRU(const onnx::NodeProto& nodeproto, const onnx::GraphProto& /* graphproto */, std::unordered_map<std::string, ETensorType>& tensor_type) {
+
+   ETensorType input_type;
+
+   auto input_name = nodeproto.input(0);
+   auto it = tensor_type.find(input_name);
+   if (it != tensor_type.end()) {
+      input_type = it->second;
+   } else {
+      throw
+         std::runtime_error("TMVA::SOFIE ONNX Parser GRU op has input tensor " + input_name + " but its type is not yet registered");
+   }
+
+   std::unique_ptr<ROperator> op;
+
+   std::vector<float> attr_activation_alpha = {};
+   std::vector<float> attr_activation_beta = {};
+   std::vector<std::string> attr_activations = {};
+   float attr_clip = 0.;
+   std::string attr_direction = "forward";
+   size_t attr_hidden_size = 0;
+   size_t attr_layout = 0;
+   size_t attr_linear_before_reset = 0;
+
+   for (int_t i = 0; i < nodeproto.attribute_size(); i++) {
+      std::string attribute_name = nodeproto.attribute(i).name();
+      if (attribute_name == "activation_alpha") {
+         attr_activation_alpha = {nodeproto.attribute(i).floats().begin(), nodeproto.attribute(i).floats().end()};
+      } else if (attribute_name == "activation_beta") {
+         attr_activation_beta = {nodeproto.attribute(i).floats().begin(), nodeproto.attribute(i).floats().end()};
+      } else if (attribute_name == "activations") {
+         attr_activations = {nodeproto.attribute(i).strings().begin(), nodeproto.attribute(i).strings().end()};
+      } else if (attribute_name == "clip") {
+         attr_clip = nodeproto.attribute(i).f();
+      } else if (attribute_name == "direction") {
+         attr_direction = nodeproto.attribute(i).s();
+      } else if (attribute_name == "hidden_size") {
+         attr_hidden_size = nodeproto.attribute(i).i();
+      } else if (attribute_name == "layout") {
+         attr_layout = nodeproto.attribute(i).i();
+      } else if (attribute_name == "linear_before_reset") {
+         attr_linear_before_reset = nodeproto.attribute(i).i();
+      } else {
+         std::cout << "TMVA SOFIE Warning - Model Loading - Attribute " << attribute_name << " in OperatorNode " << nodeproto.name() << " is not defined in ONNX IR and not applied!\n";
+      }
+   }
+
+   // Optional inputs and outputs, an empty name marks an input or output that is not used
+   std::vector<std::string> inputs(6);
+   for (int_t i = 3; i < nodeproto.input_size() && i < 6; i++) {
+      inputs[i] = nodeproto.input(i);
+   }
+   std::vector<std::string> outputs(2);
+   for (int_t i = 0; i < nodeproto.output_size() && i < 2; i++) {
+      outputs[i] = nodeproto.output(i);
+   }
+
+   switch(input_type) {
+      case ETensorType::FLOAT:
+            op.reset(new ROperator_GRU<float>(attr_activation_alpha, attr_activation_beta, attr_activations,
+               attr_clip, attr_direction, attr_hidden_size, attr_linear_before_reset, attr_layout,
+               nodeproto.input(0), nodeproto.input(1), nodeproto.input(2),
+               inputs[3], inputs[4], inputs[5], outputs[0], outputs[1]));
+         break;
+      default:
+         throw
+            std::runtime_error("TMVA::SOFIE - Unsupported - Operator GRU does not yet support input type " + std::to_string(static_cast<int>(input_type)));
+   }
+
+   auto output_type = op->TypeInference({input_type, input_type});
+   for (size_t i = 0; i < 2; i++) {
+      if (!outputs[i].empty() && tensor_type.find(outputs[i]) == tensor_type.end()) {
+         tensor_type[outputs[i]] = output_type[i];
+      }
+   }
+
+   return op;
+}
+
+std::unique_ptr<ROperator> make_ROperator_LeakyRelu(const onnx::NodeProto& nodeproto, const onnx::GraphProto& /*graphproto */, std::unordered_map<std::string, ETensorType>& tensor_type){
+
+   ETensorType input_type;
+
+   auto input_name =  nodeproto.input(0);
+   auto it = tensor_type.find(input_name);
+   if (it != tensor_type.end()){
+      input_type = it->second;
+   }else{
+      throw std::runtime_error("TMVA::SOFIE ONNX Parser LeakyRelu op has input tensor" + input_name + " but its type is not yet registered");
+   }
+
+   std::unique_ptr<ROperator> op;
+
+   float attr_alpha = 0.01;
+   for (int i = 0; i < nodeproto.attribute_size(); i++){
+      std::string attribute_name = nodeproto.attribute(i).name();
+      if (attribute_name == "alpha"){
+         attr_alpha = nodeproto.attribute(i).f();
+      }else{
+         std::cout << "TMVA::SOFIE Warning - Model Loading - Attribute " << attribute_name << " in OperatorNode " << nodeproto.name() << " is not defined in ONNX IR and not applied!\n";
+      }
+   }
+
+   switch(input_type){
+   case ETensorType::FLOAT:
+      op.reset(new ROperator_LeakyRelu<float>(attr_alpha, nodeproto.input(0), nodeproto.output(0)));
+      break;
+   default:
+      throw std::runtime_error("TMVA::SOFIE - Unsupported - Operator LeakyRelu does not yet support input type " + std::to_string(static_cast<int>(input_type)));
+   }
+
+   ETensorType output_type = (op->TypeInference({input_type}))[0];
+   auto it2 = tensor_type.find(nodeproto.output(0));
+   if (it2 == tensor_type.end()){
+      tensor_type[nodeproto.output(0)] = output_type;
+   }
+
+   return op;
+}
+
+std::unique_ptr<ROperator> make_ROperator_Softmax(const onnx::NodeProto& nodeproto, const onnx::GraphProto& /*graphproto */, std::unordered_map<std::string, ETensorType>& tensor_type){
+
+   ETensorType input_type;
+
+   auto input_name =  nodeproto.input(0);
+   auto it = tensor_type.find(input_name);
+   if (it != tensor_type.end()){
+      input_type = it->second;
+   }else{
+      throw std::runtime_error("TMVA::SOFIE ONNX Parser Softmax op has input tensor" + input_name + " but its type is not yet registered");
+   }
+
+   std::unique_ptr<ROperator> op;
+
+   int_t attr_axis = -1;
+   for (int i = 0; i < nodeproto.attribute_size(); i++){
+      std::string attribute_name = nodeproto.attribute(i).name();
+      if (attribute_name == "axis"){
+         attr_axis = nodeproto.attribute(i).i();
+      }else{
+         std::cout << "TMVA::SOFIE Warning - Model Loading - Attribute " << attribute_name << " in OperatorNode " << nodeproto.name() << " is not defined in ONNX IR and not applied!\n";
+      }
+   }
+
+   switch(input_type){
+   case ETensorType::FLOAT:
+      op.reset(new ROperator_Softmax<float>(attr_axis, nodeproto.input(0), nodeproto.output(0)));
+      break;
+   default:
+      throw std::runtime_error("TMVA::SOFIE - Unsupported - Operator Softmax does not yet support input type " + std::to_string(static_cast<int>(input_type)));
+   }
+
+   ETensorType output_type = (op->TypeInference({input_type}))[0];
+   auto it2 = tensor_type.find(nodeproto.output(0));
+   if (it2 == tensor_type.end()){
+      tensor_type[nodeproto.output(0)] = output_type;
+   }
+
+   return op;
+}
+
+template <EBasicBinaryOperator Op>
+std::unique_ptr<ROperator> make_ROperator_BasicBinary(const onnx::NodeProto& nodeproto, const onnx::GraphProto& /*graphproto */, std::unordered_map<std::string, ETensorType>& tensor_type){
+
+   ETensorType input_type = ETensorType::UNDEFINED;
+
+   for (int i = 0; i < 2; i++){
+      auto input_name = nodeproto.input(i);
+      auto it = tensor_type.find(input_name);
+      if (it == tensor_type.end()){
+         throw std::runtime_error("TMVA::SOFIE ONNX Parser " + nodeproto.op_type() + " op has input tensor " + input_name + " but its type is not yet registered");
+      }
+      if (i > 0 && it->second != input_type){
+         throw std::runtime_error("TMVA::SOFIE ONNX Parser " + nodeproto.op_type() + " op has input tensors of different types");
+      }
+      input_type = it->second;
+   }
+
+   std::unique_ptr<ROperator> op;
+
+   switch(input_type){
+   case ETensorType::FLOAT:
+      op.reset(new ROperator_BasicBinary<float, Op>(nodeproto.input(0), nodeproto.input(1), nodeproto.output(0)));
+      break;
+   default:
+      throw std::runtime_error("TMVA::SOFIE - Unsupported - Operator " + nodeproto.op_type() + " does not yet support input type " + std::to_string(static_cast<int>(input_type)));
+   }
+
+   ETensorType output_type = (op->TypeInference({input_type, input_type}))[0];
+   auto it2 = tensor_type.find(nodeproto.output(0));
+   if (it2 == tensor_type.end()){
+      tensor_type[nodeproto.output(0)] = output_type;
+   }
+
+   return op;
+}
+
+template std::unique_ptr<ROperator> make_ROperator_BasicBinary<EBasicBinaryOperator::Add>(const onnx::NodeProto&, const onnx::GraphProto&, std::unordered_map<std::string, ETensorType>&);
+template std::unique_ptr<ROperator> make_ROperator_BasicBinary<EBasicBinaryOperator::Sub>(const onnx::NodeProto&, const onnx::GraphProto&, std::unordered_map<std::string, ETensorType>&);
+template std::unique_ptr<ROperator> make_ROperator_BasicBinary<EBasicBinaryOperator::Mul>(const onnx::NodeProto&, const onnx::GraphProto&, std::unordered_map<std::string, ETensorType>&);
+template std::unique_ptr<ROperator> make_ROperator_BasicBinary<EBasicBinaryOperator::Div>(const onnx::NodeProto&, const onnx::GraphProto&, std::unordered_map<std::string, ETensorType>&);
+
+std::unique_ptr<ROperator> make_ROperator_Reshape(const onnx::NodeProto& nodeproto, const onnx::GraphProto& /*graphproto */, std::unordered_map<std::string, ETensorType>& tensor_type){
+
+   ETensorType input_type;
+
+   auto input_name =  nodeproto.input(0);
+   auto it = tensor_type.find(input_name);
+   if (it != tensor_type.end()){
+      input_type = it->second;
+   }else{
+      throw std::runtime_error("TMVA::SOFIE ONNX Parser " + nodeproto.op_type() + " op has input tensor" + input_name + " but its type is not yet registered");
+   }
+
+   std::unique_ptr<ROperator> op;
+
+   // Reshape has the attribute allowzero, Flatten the attribute axis
+   bool isFlatten = (nodeproto.op_type() == "Flatten");
+   int_t attr_value = isFlatten ? 1 : 0;
+   for (int i = 0; i < nodeproto.attribute_size(); i++){
+      std::string attribute_name = nodeproto.attribute(i).name();
+      if ((isFlatten && attribute_name == "axis") || (!isFlatten && attribute_name == "allowzero")){
+         attr_value = nodeproto.attribute(i).i();
+      }else{
+         std::cout << "TMVA::SOFIE Warning - Model Loading - Attribute " << attribute_name << " in OperatorNode " << nodeproto.name() << " is not defined in ONNX IR and not applied!\n";
+      }
+   }
+
+   switch(input_type){
+   case ETensorType::FLOAT:
+      if (isFlatten){
+         op.reset(new ROperator_Reshape<float>(attr_value, nodeproto.input(0), nodeproto.output(0)));
+      }else{
+         if (nodeproto.input_size() < 2){
+            throw std::runtime_error("TMVA::SOFIE ONNX Parser Reshape op has no shape input, the attribute shape of opset 1 is not supported");
+         }
+         op.reset(new ROperator_Reshape<float>(attr_value, nodeproto.input(0), nodeproto.input(1), nodeproto.output(0)));
+      }
+      break;
+   default:
+      throw std::runtime_error("TMVA::SOFIE - Unsupported - Operator " + nodeproto.op_type() + " does not yet support input type " + std::to_string(static_cast<int>(input_type)));
+   }
+
+   ETensorType output_type = (op->TypeInference({input_type}))[0];
+   auto it2 = tensor_type.find(nodeproto.output(0));
+   if (it2 == tensor_type.end()){
+      tensor_type[nodeproto.output(0)] = output_type;
+   }
+
+   return op;
+}
+
+std::unique_ptr<ROperator> make_ROperator_Concat(const onnx::NodeProto& nodeproto, const onnx::GraphProto& /*graphproto */, std::unordered_map<std::string, ETensorType>& tensor_type){
+
+   ETensorType input_type = ETensorType::UNDEFINED;
+
+   std::vector<std::string> inputs;
+   for (int i = 0; i < nodeproto.input_size(); i++){
+      auto input_name = nodeproto.input(i);
+      auto it = tensor_type.find(input_name);
+      if (it == tensor_type.end()){
+         throw std::runtime_error("TMVA::SOFIE ONNX Parser Concat op has input tensor " + input_name + " but its type is not yet registered");
+      }
+      if (i > 0 && it->second != input_type){
+         throw std::runtime_error("TMVA::SOFIE ONNX Parser Concat op has input tensors of different types");
+      }
+      input_type = it->second;
+      inputs.push_back(input_name);
+   }
+
+   std::unique_ptr<ROperator> op;
+
+   bool has_axis = false;
+   int_t attr_axis = 0;
+   for (int i = 0; i < nodeproto.attribute_size(); i++){
+      std::string attribute_name = nodeproto.attribute(i).name();
+      if (attribute_name == "axis"){
+         attr_axis = nodeproto.attribute(i).i();
+         has_axis = true;
+      }else{
+         std::cout << "TMVA::SOFIE Warning - Model Loading - Attribute " << attribute_name << " in OperatorNode " << nodeproto.name() << " is not defined in ONNX IR and not applied!\n";
+      }
+   }
+   if (!has_axis){
+      throw std::runtime_error("TMVA::SOFIE ONNX Parser Concat op " + nodeproto.name() + " has no attribute axis");
+   }
+
+   switch(input_type){
+   case ETensorType::FLOAT:
+      op.reset(new ROperator_Concat<float>(attr_axis, inputs, nodeproto.output(0)));
+      break;
+   default:
+      throw std::runtime_error("TMVA::SOFIE - Unsupported - Operator Concat does not yet support input type " + std::to_string(static_cast<int>(input_type)));
+   }
+
+   ETensorType output_type = (op->TypeInference({input_type}))[0];
+   auto it2 = tensor_type.find(nodeproto.output(0));
+   if (it2 == tensor_type.end()){
+      tensor_type[nodeproto.output(0)] = output_type;
+   }
+
+   return op;
+}
+
+std::unique_ptr<ROperator> make_ROperator_BatchNormalization(const onnx::NodeProto& nodeproto, const onnx::GraphProto& /*graphproto */, std::unordered_map<std::string, ETensorType>& tensor_type){
+
+   ETensorType input_type;
+
+   auto input_name =  nodeproto.input(0);
+   auto it = tensor_type.find(input_name);
+   if (it != tensor_type.end()){
+      input_type = it->second;
+   }else{
+      throw std::runtime_error("TMVA::SOFIE ONNX Parser BatchNormalization op has input tensor" + input_name + " but its type is not yet registered");
+   }
+
+   std::unique_ptr<ROperator> op;
+
+   float attr_epsilon = 1e-5;
+   for (int i = 0; i < nodeproto.attribute_size(); i++){
+      std::string attribute_name = nodeproto.attribute(i).name();
+      if (attribute_name == "epsilon"){
+         attr_epsilon = nodeproto.attribute(i).f();
+      }else if (attribute_name == "training_mode"){
+         if (nodeproto.attribute(i).i() != 0)
+            throw std::runtime_error("TMVA::SOFIE ONNX Parser BatchNormalization op " + nodeproto.name() + " in training mode is not supported");
+      }else if (attribute_name != "momentum" && attribute_name != "spatial"){
+         // the momentum only applies to the training, spatial (opset < 9) is always 1 for the exporters
+         std::cout << "TMVA::SOFIE Warning - Model Loading - Attribute " << attribute_name << " in OperatorNode " << nodeproto.name() << " is not defined in ONNX IR and not applied!\n";
+      }
+   }
+   if (nodeproto.input_size() != 5){
+      throw std::runtime_error("TMVA::SOFIE ONNX Parser BatchNormalization op " + nodeproto.name() + " has not 5 inputs");
+   }
+
+   switch(input_type){
+   case ETensorType::FLOAT:
+      op.reset(new ROperator_BatchNormalization<float>(attr_epsilon, nodeproto.input(0), nodeproto.input(1), nodeproto.input(2),
+                                                       nodeproto.input(3), nodeproto.input(4), nodeproto.output(0)));
+      break;
+   default:
+      throw std::runtime_error("TMVA::SOFIE - Unsupported - Operator BatchNormalization does not yet support input type " + std::to_string(static_cast<int>(input_type)));
+   }
+
+   ETensorType output_type = (op->TypeInference({input_type}))[0];
+   auto it2 = tensor_type.find(nodeproto.output(0));
+   if (it2 == tensor_type.end()){
+      tensor_type[nodeproto.output(0)] = output_type;
+   }
+
+   return op;
+}
+
+std::unique_ptr<ROperator> make_ROperator_Pool(const onnx::NodeProto& nodeproto, const onnx::GraphProto& /*graphproto */, std::unordered_map<std::string, ETensorType>& tensor_type){
+
+   ETensorType input_type;
+
+   auto input_name =  nodeproto.input(0);
+   auto it = tensor_type.find(input_name);
+   if (it != tensor_type.end()){
+      input_type = it->second;
+   }else{
+      throw std::runtime_error("TMVA::SOFIE ONNX Parser " + nodeproto.op_type() + " op has input tensor" + input_name + " but its type is not yet registered");
+   }
+
+   std::unique_ptr<ROperator> op;
+
+   EPoolOpMode mode = EPoolOpMode::MaxPool;
+   if (nodeproto.op_type() == "AveragePool"){
+      mode = EPoolOpMode::AveragePool;
+   }else if (nodeproto.op_type() == "GlobalMaxPool"){
+      mode = EPoolOpMode::GlobalMaxPool;
+   }else if (nodeproto.op_type() == "GlobalAveragePool"){
+      mode = EPoolOpMode::GlobalAveragePool;
+   }
+   if (nodeproto.output_size() > 1 && !nodeproto.output(1).empty()){
+      throw std::runtime_error("TMVA::SOFIE ONNX Parser MaxPool op " + nodeproto.name() + " with the output of the indices is not supported");
+   }
+
+   RAttributes_Pool attr;
+   for (int i = 0; i < nodeproto.attribute_size(); i++){
+      std::string attribute_name = nodeproto.attribute(i).name();
+      const auto& attribute = nodeproto.attribute(i);
+      if (attribute_name == "auto_pad"){
+         attr.auto_pad = attribute.s();
+      }else if (attribute_name == "ceil_mode"){
+         attr.ceil_mode = attribute.i();
+      }else if (attribute_name == "count_include_pad" && mode == EPoolOpMode::AveragePool){
+         attr.count_include_pad = attribute.i();
+      }else if (attribute_name == "dilations" && mode == EPoolOpMode::MaxPool){
+         attr.dilations = std::vector<size_t>({attribute.ints().begin(), attribute.ints().end()});
+      }else if (attribute_name == "kernel_shape"){
+         attr.kernel_shape = std::vector<size_t>({attribute.ints().begin(), attribute.ints().end()});
+      }else if (attribute_name == "pads"){
+         attr.pads = std::vector<size_t>({attribute.ints().begin(), attribute.ints().end()});
+      }else if (attribute_name == "strides"){
+         attr.strides = std::vector<size_t>({attribute.ints().begin(), attribute.ints().end()});
+      }else if (attribute_name != "storage_order"){
+         // storage_order only applies to the output of the indices
+         std::cout << "TMVA::SOFIE Warning - Model Loading - Attribute " << attribute_name << " in OperatorNode " << nodeproto.name() << " is not defined in ONNX IR and not applied!\n";
+      }
+   }
+
+   switch(input_type){
+   case ETensorType::FLOAT:
+      op.reset(new ROperator_Pool<float>(mode, attr, nodeproto.input(0), nodeproto.output(0)));
+      break;
+   default:
+      throw std::runtime_error("TMVA::SOFIE - Unsupported - Operator " + nodeproto.op_type() + " does not yet support input type " + std::to_string(static_cast<int>(input_type)));
+   }
+
+   ETensorType output_type = (op->TypeInference({input_type}))[0];
+   auto it2 = tensor_type.find(nodeproto.output(0));
+   if (it2 == tensor_type.end()){
+      tensor_type[nodeproto.output(0)] = output_type;
+   }
+
+   return op;
+}
 } //INTERNAL
 
 
@@ -469,6 +969,8 @@ RModel RModelParser_ONNX::Parse(std::string filename){
       }
 
       std::string input_name = graph.initializer(i).name();
+      // since IR version 4 the initializers need not be graph inputs
+      tensor_type[input_name] = static_cast<ETensorType>(graph.initializer(i).data_type());
 
       switch(static_cast<ETensorType>(graph.initializer(i).data_type())){
          case ETensorType::FLOAT : {
@@ -485,6 +987,19 @@ RModel RModelParser_ONNX::Parse(std::string filename){
             rmodel.AddInitializedTensor(input_name, ETensorType::FLOAT, fShape, data);
             break;
          }
+         case ETensorType::INT64 : {
+            // e.g. the shape input of Reshape
+            std::shared_ptr<void> data(malloc(fLength * sizeof(int64_t)), free);
+
+            if (tensorproto->raw_data().empty() == false){
+               std::memcpy(data.get(), tensorproto->raw_data().c_str(), fLength * sizeof(int64_t));
+            }else{
+               std::copy(tensorproto->int64_data().begin(), tensorproto->int64_data().end(), static_cast<int64_t*>(data.get()));
+            }
+
+            rmodel.AddInitializedTensor(input_name, ETensorType::INT64, fShape, data);
+            break;
+         }
          default: throw std::runtime_error("Data type in weight tensor " + graph.initializer(i).name() + " not supported!\n");
       }
    }
@@ -500,6 +1015,8 @@ RModel RModelParser_ONNX::Parse(std::string filename){
          rmodel.AddBlasRoutines({"Gemm", "Axpy"});
       } else if (op_type == "RNN") {
          rmodel.AddBlasRoutines({"Gemm", "Axpy"});
+      } else if (op_type == "LSTM" || op_type == "GRU") {
+         rmodel.AddBlasRoutines({"Gemm"});
       }
    }
 
@@ -58,6 +58,7 @@ public:
    {}
 
    UInt_t fFold;
+   UInt_t fMethod = 0; // index of the method among the methods booked for cross-validation
 
    Float_t fROCIntegral;
    TGraph fROC;
@@ -145,6 +146,7 @@ public:
 
 private:
    CrossValidationFoldResult ProcessFold(UInt_t iFold, const OptionMap & methodInfo);
+   std::vector<CrossValidationFoldResult> ProcessFolds();
 
    Types::EAnalysisType fAnalysisType;
    TString fAnalysisTypeStr;
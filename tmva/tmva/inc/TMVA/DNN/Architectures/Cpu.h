@@ -523,6 +523,20 @@ public:
                              size_t zeroPaddingHeight, size_t zeroPaddingWidth);
    static void Im2colFast(Matrix_t &A, const Matrix_t &B, const std::vector<int> &V);
 
+   /** Direct convolution of the image \p B, for the output channels [\p firstChannel, \p lastChannel) of \p A.
+    *  The local views of the image are gathered with the indices \p V of Im2colIndices in blocks, which are
+    *  convolved with all the filters of the channel range, without forming the full im2col matrix. The biases
+    *  are added to the result. */
+   static void ConvolveDirect(Matrix_t &A, const Matrix_t &B, const Matrix_t &weights, const Matrix_t &biases,
+                              const std::vector<int> &V, size_t firstChannel, size_t lastChannel);
+
+   /** Whether ConvLayerForward uses ConvolveDirect, parallelized over images and output channels, instead of
+    *  Im2col and a matrix multiplication per image. */
+   static bool UseDirectConvolution(size_t batchSize, size_t depth, size_t nLocalViewPixels);
+
+   /** Matrix on a scratch buffer of the calling thread, which is reused by the next calls of the thread. */
+   static Matrix_t GetScratchMatrix(size_t nRows, size_t nCols);
+
    /** Rotates the matrix \p B, which is representing a weights,
     *  and stores them in the matrix \p A. */
    static void RotateWeights(Matrix_t &A, const Matrix_t &B, size_t filterDepth, size_t filterHeight,
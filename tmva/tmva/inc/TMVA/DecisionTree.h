@@ -108,6 +108,7 @@ namespace TMVA {
       Double_t TrainNode( const EventConstList & eventSample,  DecisionTreeNode *node ) { return TrainNodeFast( eventSample, node ); }
       Double_t TrainNodeFast( const EventConstList & eventSample,  DecisionTreeNode *node );
       Double_t TrainNodeFull( const EventConstList & eventSample,  DecisionTreeNode *node );
+      UInt_t BuildTreeFromHistograms( const EventConstList & eventSample );
       void    GetRandomisedVariables(Bool_t *useVariable, UInt_t *variableMap, UInt_t & nVars);
       std::vector<Double_t>  GetFisherCoefficients(const EventConstList &eventSample, UInt_t nFisherVars, UInt_t *mapVarInFisher);
     
@@ -191,6 +192,7 @@ namespace TMVA {
       inline void SetUseFisherCuts(Bool_t t=kTRUE)  { fUseFisherCuts = t;}
       inline void SetMinLinCorrForFisher(Double_t min){fMinLinCorrForFisher = min;}
       inline void SetUseExclusiveVars(Bool_t t=kTRUE){fUseExclusiveVars = t;}
+      inline void SetUseHistogramSplits(Bool_t t=kTRUE){fUseHistogramSplits = t;}
       inline void SetNVars(Int_t n){fNvars = n;}
 
    private:
@@ -202,11 +204,22 @@ namespace TMVA {
       // calculates the purity S/(S+B) of a given event sample
       Double_t SamplePurity(EventList eventSample);
 
+      // node splitting from histograms of the pre-binned variables, see BuildTreeFromHistograms
+      struct BinnedSample;
+      struct NodeSums;
+      void     BuildNodeFromHistograms( const BinnedSample & sample, std::vector<UInt_t> & events, const NodeSums & sums,
+                                        std::vector<Double_t> & histogram, DecisionTreeNode *node );
+      void     FillHistograms( const BinnedSample & sample, const std::vector<UInt_t> & events,
+                               std::vector<Double_t> & histogram ) const;
+      Double_t TrainNodeFromHistograms( const BinnedSample & sample, const NodeSums & sums,
+                                        const std::vector<Double_t> & histogram, DecisionTreeNode *node );
+
       UInt_t    fNvars;          // number of variables used to separate S and B
       Int_t     fNCuts;          // number of grid point in variable cut scans
       Bool_t    fUseFisherCuts;  // use multivariate splits using the Fisher criterium
       Double_t  fMinLinCorrForFisher; // the minimum linear correlation between two variables demanded for use in fisher criterium in node splitting
       Bool_t    fUseExclusiveVars; // individual variables already used in fisher criterium are not anymore analysed individually for node splitting
+      Bool_t    fUseHistogramSplits; // find the node splits from histograms of the variables pre-binned once per tree
 
       SeparationBase *fSepType;  // the separation crition
       RegressionVariance *fRegType;  // the separation crition used in Regression
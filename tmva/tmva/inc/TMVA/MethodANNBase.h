@@ -122,6 +122,9 @@ namespace TMVA {
 
       virtual const std::vector<Float_t> &GetMulticlassValues();
 
+      // the network is only read in the concurrent evaluation
+      virtual Bool_t HasConcurrentEvaluation() const { return kTRUE; }
+
       // write method specific histos to target file
       virtual void WriteMonitoringHistosToFile() const;
 
@@ -142,6 +145,10 @@ namespace TMVA {
 
       virtual void MakeClassSpecific( std::ostream&, const TString& ) const;
 
+      virtual Double_t EvaluateMvaConcurrent( const Event* const ev ) const;
+      virtual void     EvaluateMulticlassConcurrent( const Event* const ev, std::vector<Float_t>& values ) const;
+      void             EvaluateNetworkOutputs( const Event* ev, std::vector<Double_t>& outputs ) const;
+
       std::vector<Int_t>* ParseLayoutString( TString layerSpec );
       virtual void        BuildNetwork( std::vector<Int_t>* layout, std::vector<Double_t>* weights=NULL,
                                         Bool_t fromFile = kFALSE );
@@ -110,10 +110,20 @@ namespace TMVA {
 
       // get the actual forest size (might be less than fNTrees, the requested one, if boosting is stopped early
       UInt_t   GetNTrees() const {return fForest.size();}
+
+      // the forest is only read in the evaluation
+      Bool_t HasConcurrentEvaluation() const { return kTRUE; }
+
+   protected:
+      Double_t EvaluateMvaConcurrent( const TMVA::Event* const ev ) const;
+      void     EvaluateMulticlassConcurrent( const TMVA::Event* const ev, std::vector<Float_t>& values ) const;
+
    private:
 
       Double_t GetMvaValue( Double_t* err, Double_t* errUpper, UInt_t useNTrees );
       Double_t PrivateGetMvaValue( const TMVA::Event *ev, Double_t* err=0, Double_t* errUpper=0, UInt_t useNTrees=0 );
+      Double_t GetForestMvaValue( const TMVA::Event *ev, UInt_t nTrees ) const;
+      void     GetMulticlassProbabilities( std::vector<Double_t>& sums, std::vector<Float_t>& values ) const;
       void     BoostMonitor(Int_t iTree);
 
    public:
@@ -200,7 +210,7 @@ namespace TMVA {
       void InitGradBoost( std::vector<const TMVA::Event*>&);
       void UpdateTargets( std::vector<const TMVA::Event*>&, UInt_t cls = 0);
       void UpdateTargetsRegression( std::vector<const TMVA::Event*>&,Bool_t first=kFALSE);
-      Double_t GetGradBoostMVA(const TMVA::Event *e, UInt_t nTrees);
+      Double_t GetGradBoostMVA(const TMVA::Event *e, UInt_t nTrees) const;
       void     GetBaggedSubSample(std::vector<const TMVA::Event*>&);
 
       std::vector<const TMVA::Event*>       fEventSample;     // the training events
@@ -233,6 +243,7 @@ namespace TMVA {
       TString                         fMinNodeSizeS;    // string containing min percentage of training events in node
 
       Int_t                           fNCuts;           // grid used in cut applied in node splitting
+      Bool_t                          fHistogramSplits; // find the node splits from histograms of the variables binned once per tree
       Bool_t                          fUseFisherCuts;   // use multivariate splits using the Fisher criterium
       Double_t                        fMinLinCorrForFisher; // the minimum linear correlation between two variables demanded for use in fisher criterium in node splitting
       Bool_t                          fUseExclusiveVars; // individual variables already used in fisher criterium are not anymore analysed individually for node splitting
@@ -279,7 +290,7 @@ namespace TMVA {
 
 
       void                             DeterminePreselectionCuts(const std::vector<const TMVA::Event*>& eventSample);
-      Double_t                         ApplyPreselectionCuts(const Event* ev);
+      Double_t                         ApplyPreselectionCuts(const Event* ev) const;
       
       std::vector<Double_t> fLowSigCut;
       std::vector<Double_t> fLowBkgCut;
@@ -200,10 +200,20 @@ namespace TMVA {
       // signal/background classification response
       Double_t GetMvaValue( const TMVA::Event* const ev, Double_t* err = 0, Double_t* errUpper = 0 );
 
+      // concurrent evaluation: unlike GetMvaValue and GetMulticlassValues, the methods which support it are left
+      // untouched, so that several threads can evaluate the same method at a time; the event is not transformed yet
+      virtual Bool_t HasConcurrentEvaluation() const { return kFALSE; }
+      Double_t GetMvaValueConcurrent( const TMVA::Event* const ev ) const;
+      void     GetMulticlassValuesConcurrent( const TMVA::Event* const ev, std::vector<Float_t>& values ) const;
+
    protected:
       // helper function to set errors to -1
       void NoErrorCalc(Double_t* const err, Double_t* const errUpper);
 
+      // concurrent classification response for the transformed event, overridden with HasConcurrentEvaluation
+      virtual Double_t EvaluateMvaConcurrent( const TMVA::Event* const ev ) const;
+      virtual void     EvaluateMulticlassConcurrent( const TMVA::Event* const ev, std::vector<Float_t>& values ) const;
+
       // signal/background classification response for all current set of data
       virtual std::vector<Double_t> GetMvaValues(Long64_t firstEvt = 0, Long64_t lastEvt = -1, Bool_t logProgress = false);
       // same as above but using a provided data set (used by MethodCategory)
@@ -270,6 +280,9 @@ namespace TMVA {
       friend class MethodCompositeBase;
       void WriteStateToXML      ( void* parent ) const;
       void ReadStateFromXML     ( void* parent );
+      Bool_t ReadStateFromXMLReader( void* reader );        // weight file read node after node
+      void ReadMethodSetupFromXML( void* methodNode );      // attributes of the node "MethodSetup"
+      void ReadSectionFromXML   ( void* sectionNode );     // one child of the node "MethodSetup"
       void WriteStateToStream   ( std::ostream& tf ) const;   // needed for MakeClass
       void WriteVarsToStream    ( std::ostream& tf, const TString& prefix = "" ) const;  // needed for MakeClass
 
@@ -61,6 +61,7 @@
 
 #include <vector>
 #include <map>
+#include <memory>
 
 #ifdef R__HAS_TMVAGPU
 //#define USE_GPU_INFERENCE
@@ -204,6 +205,21 @@ private:
    std::unique_ptr<MatrixImpl_t> fYHat;   // output prediction matrix of fNet
    std::unique_ptr<DeepNetImpl_t> fNet;
 
+   /*! Network with the weights of fNet, and its input and output, used by one thread in the concurrent
+    *  evaluation. The contexts are kept per thread and refer to the method through fEvaluationToken. */
+   struct EvaluationContext {
+      std::weak_ptr<void> fOwner;
+      std::unique_ptr<DeepNetImpl_t> fNet;
+      TensorImpl_t fXInput;
+      HostBufferImpl_t fXInputBuffer;
+      std::unique_ptr<MatrixImpl_t> fYHat;
+   };
+   std::shared_ptr<void> fEvaluationToken;  //! identifies the evaluation contexts of the method, expires with it
+
+   void ReadLayersFromXML(DeepNetImpl_t &net, void *netXML, size_t netDepth) const;
+   void FillInputTensor(const Event *ev, TensorImpl_t &xInput, HostBufferImpl_t &buffer) const;
+   EvaluationContext &GetEvaluationContext() const;
+
 
    ClassDef(MethodDL, 0);
 
@@ -213,6 +229,9 @@ protected:
 
    virtual std::vector<Double_t> GetMvaValues(Long64_t firstEvt, Long64_t lastEvt, Bool_t logProgress);
 
+   virtual Double_t EvaluateMvaConcurrent(const Event *const ev) const;
+   virtual void EvaluateMulticlassConcurrent(const Event *const ev, std::vector<Float_t> &values) const;
+
 
 public:
    /*! Constructor */
@@ -238,6 +257,9 @@ public:
    virtual const std::vector<Float_t>& GetRegressionValues();
    virtual const std::vector<Float_t>& GetMulticlassValues();
 
+   /*! Each thread evaluates its own network of batch size one, which shares the weights of the stored one */
+   virtual Bool_t HasConcurrentEvaluation() const { return kTRUE; }
+
    /*! Methods for writing and reading weights */
    using MethodBase::ReadWeightsFromStream;
    void AddWeightsXMLTo(void *parent) const;
@@ -115,6 +115,7 @@ public:
 
 extern template class TMVA::Experimental::RBDT<TMVA::Experimental::BranchlessForest<float>>;
 extern template class TMVA::Experimental::RBDT<TMVA::Experimental::BranchlessJittedForest<float>>;
+extern template class TMVA::Experimental::RBDT<TMVA::Experimental::BranchlessQuantizedForest<float>>;
 
 } // namespace Experimental
 } // namespace TMVA
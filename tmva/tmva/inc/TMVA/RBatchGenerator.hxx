@@ -0,0 +1,291 @@
+#ifndef TMVA_RBATCHGENERATOR
+#define TMVA_RBATCHGENERATOR
+
+#include <algorithm>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "TMatrixT.h"
+#include "TROOT.h"
+#include "TMVA/RTensor.hxx"
+#include "ROOT/RDataFrame.hxx"
+#include "ROOT/RDF/RInterface.hxx"
+
+namespace TMVA {
+namespace Experimental {
+
+/// \class TMVA::Experimental::RBatchGenerator
+/// \brief Stream shuffled batches of events from an RDataFrame, without loading the dataset in memory
+///
+/// The event loop of the dataframe runs in a background thread, which reads the columns of the events, converts
+/// them to T and passes them through a shuffle buffer: once the buffer is full, each new event takes the place of a
+/// random event of the buffer, which is appended to the batch being filled. The events left in the buffer at the end
+/// of the event loop are shuffled and passed on as well. The batches are queued until they are consumed with
+/// NextBatch and GetBatch; the queue holds at most as many batches as fit in the shuffle buffer, so the background
+/// thread reads ahead while the previous events are used for training and the memory used is bounded by about twice
+/// the buffer size, independently of the size of the dataset.
+///
+/// Each event loop is one epoch: StartEpoch runs the event loop again with a new shuffling. The events are only
+/// mixed within the range of the shuffle buffer, so the buffer should be large compared to the batch size, and
+/// datasets sorted by class should be read with a buffer larger than the blocks of events of one class. The dataframe
+/// must not be used elsewhere while an epoch is running.
+///
+/// ~~~{.cpp}
+/// ROOT::RDataFrame df("tree", "file.root");
+/// RBatchGenerator<float, float, float, int> gen(df, {"x", "y", "label"}, 64, 100000);
+/// for (unsigned int epoch = 0; epoch < 10; epoch++) {
+///    gen.StartEpoch();
+///    while (gen.NextBatch()) {
+///       const auto &batch = gen.GetBatch(); // shape {64, 3}, the last batch of the epoch can be smaller
+///    }
+/// }
+/// ~~~
+///
+/// \tparam T Type of the values of the batches
+/// \tparam ColumnTypes Types of the columns, which are converted to T
+template <typename T, typename... ColumnTypes>
+class RBatchGenerator {
+private:
+   using Container_t = std::vector<T>;
+
+   ROOT::RDF::RNode fDataFrame;
+   std::vector<std::string> fColumns;
+   std::size_t fBatchSize;
+   std::size_t fBufferSize;
+   std::size_t fMaxQueuedBatches;
+   std::mt19937 fGenerator;
+
+   // Accessed only by the background thread while an epoch is running
+   Container_t fBuffer;                         ///< Shuffle buffer, one row of fColumns.size() values per event
+   std::size_t fNBuffered = 0;                  ///< Number of events in the shuffle buffer
+   std::shared_ptr<Container_t> fFilling;       ///< Batch being filled
+   std::size_t fNFilling = 0;                   ///< Number of events in the batch being filled
+
+   // Shared by the background thread and the consumer, guarded by fMutex
+   std::mutex fMutex;
+   std::condition_variable fCondition;
+   std::deque<std::pair<std::shared_ptr<Container_t>, std::size_t>> fQueue; ///< Batches and their number of events
+   bool fLoopDone = true;
+   bool fStop = false;
+   std::exception_ptr fError;
+
+   std::thread fThread;
+   RTensor<T> fBatch;
+
+   /// Append one event, given as a row of values, to the batch being filled and queue the batch once it is full.
+   void Emit(const T *row)
+   {
+      const auto nColumns = fColumns.size();
+      std::copy(row, row + nColumns, fFilling->begin() + fNFilling * nColumns);
+      if (++fNFilling == fBatchSize)
+         Flush();
+   }
+
+   /// Queue the batch being filled, waiting if the queue is full.
+   void Flush()
+   {
+      if (fNFilling == 0)
+         return;
+      fFilling->resize(fNFilling * fColumns.size());
+      {
+         std::unique_lock<std::mutex> lock(fMutex);
+         fCondition.wait(lock, [this] { return fStop || fQueue.size() < fMaxQueuedBatches; });
+         if (!fStop)
+            fQueue.emplace_back(fFilling, fNFilling);
+      }
+      fCondition.notify_all();
+      fFilling = std::make_shared<Container_t>(fBatchSize * fColumns.size());
+      fNFilling = 0;
+   }
+
+   /// Pass one event through the shuffle buffer.
+   void Push(const T *row)
+   {
+      const auto nColumns = fColumns.size();
+      if (fNBuffered < fBufferSize) {
+         std::copy(row, row + nColumns, fBuffer.begin() + fNBuffered * nColumns);
+         fNBuffered++;
+         return;
+      }
+      const auto j = std::uniform_int_distribution<std::size_t>(0, fBufferSize - 1)(fGenerator);
+      const auto slot = fBuffer.begin() + j * nColumns;
+      Emit(&*slot);
+      std::copy(row, row + nColumns, slot);
+   }
+
+   /// Run the event loop, in the background thread.
+   void Loop()
+   {
+      try {
+         fNBuffered = 0;
+         fNFilling = 0;
+         fFilling = std::make_shared<Container_t>(fBatchSize * fColumns.size());
+         // With implicit multi-threading the callback is executed concurrently by the threads of the event loop
+         std::mutex pushMutex;
+         fDataFrame.Foreach(
+            [this, &pushMutex](ColumnTypes... values) {
+               const T row[] = {static_cast<T>(values)...};
+               std::lock_guard<std::mutex> lock(pushMutex);
+               if (!IsStopped())
+                  Push(row);
+            },
+            fColumns);
+
+         // Shuffle the events left in the buffer and pass them on
+         std::vector<std::size_t> order(fNBuffered);
+         for (std::size_t i = 0; i < fNBuffered; i++)
+            order[i] = i;
+         std::shuffle(order.begin(), order.end(), fGenerator);
+         for (auto i : order) {
+            if (IsStopped())
+               break;
+            Emit(&fBuffer[i * fColumns.size()]);
+         }
+         if (!IsStopped())
+            Flush();
+      } catch (...) {
+         std::lock_guard<std::mutex> lock(fMutex);
+         fError = std::current_exception();
+      }
+      {
+         std::lock_guard<std::mutex> lock(fMutex);
+         fLoopDone = true;
+      }
+      fCondition.notify_all();
+   }
+
+   bool IsStopped()
+   {
+      std::lock_guard<std::mutex> lock(fMutex);
+      return fStop;
+   }
+
+   /// Stop the running epoch, if any, and wait for the background thread.
+   void Stop()
+   {
+      if (!fThread.joinable())
+         return;
+      {
+         std::lock_guard<std::mutex> lock(fMutex);
+         fStop = true;
+      }
+      fCondition.notify_all();
+      fThread.join();
+   }
+
+public:
+   /// \brief Construct a generator of batches of the columns of a dataframe
+   /// \param[in] dataframe RDataFrame node, e.g. with filters or defines
+   /// \param[in] columns Column names, one value per column and event
+   /// \param[in] batchSize Number of events in the batches
+   /// \param[in] bufferSize Number of events in the shuffle buffer, which bounds the memory used
+   /// \param[in] seed Seed of the shuffling
+   template <typename U>
+   RBatchGenerator(U &dataframe, const std::vector<std::string> &columns, std::size_t batchSize,
+                   std::size_t bufferSize, unsigned int seed = 0)
+      : fDataFrame(dataframe), fColumns(columns), fBatchSize(batchSize), fBufferSize(bufferSize),
+        fMaxQueuedBatches(std::max<std::size_t>(bufferSize / std::max<std::size_t>(batchSize, 1), 1)),
+        fGenerator(seed), fBuffer(bufferSize * columns.size()),
+        fBatch(static_cast<T *>(nullptr), {0, columns.size()})
+   {
+      if (columns.size() != sizeof...(ColumnTypes))
+         throw std::runtime_error("Number of columns does not match the number of column types.");
+      if (batchSize == 0 || bufferSize == 0)
+         throw std::runtime_error("Batch size and buffer size must be larger than zero.");
+      // The background thread may just-in-time compile the nodes of the dataframe
+      ROOT::EnableThreadSafety();
+   }
+
+   RBatchGenerator(const RBatchGenerator &) = delete;
+   RBatchGenerator &operator=(const RBatchGenerator &) = delete;
+   ~RBatchGenerator() { Stop(); }
+
+   /// \brief Start an epoch, i.e. an event loop of the dataframe in the background thread
+   ///
+   /// A running epoch is stopped, dropping the events not consumed yet.
+   void StartEpoch()
+   {
+      Stop();
+      fQueue.clear();
+      fError = nullptr;
+      fStop = false;
+      fLoopDone = false;
+      fThread = std::thread([this] { Loop(); });
+   }
+
+   /// \brief Wait for the next batch of the epoch
+   /// \return False once all the events of the epoch were consumed
+   ///
+   /// Rethrows the exceptions thrown by the event loop.
+   bool NextBatch()
+   {
+      {
+         std::unique_lock<std::mutex> lock(fMutex);
+         fCondition.wait(lock, [this] { return fLoopDone || !fQueue.empty(); });
+         if (fError)
+            std::rethrow_exception(fError);
+         if (fQueue.empty())
+            return false;
+         auto batch = std::move(fQueue.front());
+         fQueue.pop_front();
+         fBatch = RTensor<T>(batch.first, {batch.second, fColumns.size()});
+      }
+      fCondition.notify_all();
+      return true;
+   }
+
+   /// \brief Current batch, a row major tensor of shape {number of events, number of columns}
+   const RTensor<T> &GetBatch() const { return fBatch; }
+
+   std::size_t GetBatchSize() const { return fBatchSize; }
+   std::size_t GetBufferSize() const { return fBufferSize; }
+};
+
+/// \brief Copy a batch to the matrices of a TMVA::DNN::TensorInput, as read by TMVA::DNN::TTensorDataLoader
+/// \param[in] batch Batch, e.g. of an RBatchGenerator, with the inputs, the outputs and optionally the weight in
+///            this order of the columns
+/// \param[in] nInputs Number of inputs
+/// \param[in] nOutputs Number of outputs
+/// \param[in] hasWeights Whether the last column is the weight, otherwise the events have weight one
+/// \param[out] inputs Input tensor, a single matrix of shape {number of events, nInputs}, which corresponds to a
+///             batch layout of depth one
+/// \param[out] outputs Output matrix
+/// \param[out] weights Weight matrix
+///
+/// The batch can be a large chunk of events, which a data loader constructed on the matrices splits in the batches
+/// used for training, while the background thread of the generator reads the next chunk.
+template <typename T>
+void FillTensorInput(const RTensor<T> &batch, std::size_t nInputs, std::size_t nOutputs, bool hasWeights,
+                     std::vector<TMatrixT<Double_t>> &inputs, TMatrixT<Double_t> &outputs,
+                     TMatrixT<Double_t> &weights)
+{
+   const auto &shape = batch.GetShape();
+   if (shape.size() != 2 || shape[1] != nInputs + nOutputs + (hasWeights ? 1 : 0))
+      throw std::runtime_error("Shape of the batch does not match the number of inputs, outputs and weights.");
+   const Int_t nEvents = shape[0];
+   inputs.resize(1);
+   inputs[0].ResizeTo(nEvents, nInputs);
+   outputs.ResizeTo(nEvents, nOutputs);
+   weights.ResizeTo(nEvents, 1);
+   for (Int_t i = 0; i < nEvents; i++) {
+      for (std::size_t j = 0; j < nInputs; j++)
+         inputs[0](i, j) = batch(i, j);
+      for (std::size_t j = 0; j < nOutputs; j++)
+         outputs(i, j) = batch(i, nInputs + j);
+      weights(i, 0) = hasWeights ? batch(i, nInputs + nOutputs) : 1.;
+   }
+}
+
+} // namespace TMVA::Experimental
+} // namespace TMVA
+
+#endif
@@ -1,7 +1,19 @@
 #ifndef TMVA_RINFERENCEUTILS
 #define TMVA_RINFERENCEUTILS
 
+#include "ROOT/RDF/ActionHelpers.hxx" // RActionImpl
+#include "ROOT/TSeq.hxx"
+#include "TROOT.h" // IsImplicitMTEnabled, GetThreadPoolSize
+
+#include <algorithm>
+#include <memory>
+#include <mutex>
+#include <numeric>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
 #include <utility> // std::forward, std::index_sequence
+#include <vector>
 
 namespace TMVA {
 namespace Experimental {
@@ -32,6 +44,115 @@ auto Compute(F &&f) -> Internal::ComputeHelper<std::make_index_sequence<N>, T, F
    return Internal::ComputeHelper<std::make_index_sequence<N>, T, F>(std::forward<F>(f));
 }
 
+/// RDataFrame action evaluating a model on batches of events, see BatchedCompute.
+template <std::size_t N, typename T, typename F>
+class BatchedComputeHelper : public ROOT::Detail::RDF::RActionImpl<BatchedComputeHelper<N, T, F>> {
+public:
+   using Result_t = std::vector<T>;
+
+private:
+   F fFunc;
+   std::size_t fBatchSize;
+   /// Number of outputs per event, known after the first evaluation
+   std::size_t fNOutputs = 0;
+   /// The generated inference code works on global buffers, so the evaluations are serialized
+   std::shared_ptr<std::mutex> fFuncMutex = std::make_shared<std::mutex>();
+   std::shared_ptr<Result_t> fResult = std::make_shared<Result_t>();
+   /// Per slot, the inputs of the events that are waiting for the next evaluation, one row of N values per event
+   std::vector<std::vector<T>> fInputs;
+   /// Per slot, the entry numbers of the events whose outputs are in fOutputs
+   std::vector<std::vector<ULong64_t>> fEntries;
+   /// Per slot, the outputs of the evaluated events, fNOutputs values per event
+   std::vector<std::vector<T>> fOutputs;
+
+   /// Evaluate the model on the buffered events of a slot. A partial batch is padded with zeros.
+   void Evaluate(unsigned int slot)
+   {
+      auto &inputs = fInputs[slot];
+      const std::size_t nEvents = inputs.size() / N;
+      if (nEvents == 0)
+         return;
+      inputs.resize(fBatchSize * N, T(0));
+      std::lock_guard<std::mutex> lock(*fFuncMutex);
+      const auto outputs = fFunc(inputs.data());
+      if (outputs.size() % fBatchSize != 0)
+         throw std::runtime_error("BatchedCompute: the model returned " + std::to_string(outputs.size()) +
+                                  " values for a batch of " + std::to_string(fBatchSize) + " events");
+      fNOutputs = outputs.size() / fBatchSize;
+      fOutputs[slot].insert(fOutputs[slot].end(), outputs.begin(), outputs.begin() + nEvents * fNOutputs);
+      inputs.clear();
+   }
+
+public:
+   BatchedComputeHelper(F &&f, std::size_t batchSize)
+      : fFunc(std::forward<F>(f)), fBatchSize(batchSize > 0 ? batchSize : 1)
+   {
+      const auto nSlots = ROOT::IsImplicitMTEnabled() ? ROOT::GetThreadPoolSize() : 1;
+      fInputs.resize(nSlots);
+      fEntries.resize(nSlots);
+      fOutputs.resize(nSlots);
+      for (auto &inputs : fInputs)
+         inputs.reserve(fBatchSize * N);
+   }
+   BatchedComputeHelper(BatchedComputeHelper &&) = default;
+   BatchedComputeHelper(const BatchedComputeHelper &) = delete;
+
+   std::shared_ptr<Result_t> GetResultPtr() const { return fResult; }
+   void Initialize() {}
+   void InitTask(TTreeReader *, unsigned int) {}
+
+   template <typename... Values>
+   void Exec(unsigned int slot, ULong64_t entry, Values... values)
+   {
+      static_assert(sizeof...(Values) == N, "BatchedCompute: the entry number and N input columns are required");
+      const T row[] = {static_cast<T>(values)...};
+      fInputs[slot].insert(fInputs[slot].end(), row, row + N);
+      fEntries[slot].push_back(entry);
+      if (fInputs[slot].size() == fBatchSize * N)
+         Evaluate(slot);
+   }
+
+   /// Evaluate the remaining events and sort the outputs of all slots by entry number.
+   void Finalize()
+   {
+      for (auto slot : ROOT::TSeqU(fInputs.size()))
+         Evaluate(slot);
+
+      std::vector<std::pair<ULong64_t, const T *>> events;
+      for (auto slot : ROOT::TSeqU(fEntries.size())) {
+         for (std::size_t i = 0; i < fEntries[slot].size(); ++i)
+            events.emplace_back(fEntries[slot][i], fOutputs[slot].data() + i * fNOutputs);
+      }
+      std::sort(events.begin(), events.end(),
+                [](const std::pair<ULong64_t, const T *> &a, const std::pair<ULong64_t, const T *> &b) {
+                   return a.first < b.first;
+                });
+      fResult->reserve(events.size() * fNOutputs);
+      for (auto &event : events)
+         fResult->insert(fResult->end(), event.second, event.second + fNOutputs);
+   }
+
+   std::string GetActionName() { return "BatchedCompute"; }
+};
+
+/// Helper to evaluate a model on batches of events in a RDataFrame action, e.g. the infer function generated by SOFIE
+/// for a batch size larger than one (see RModel::Generate). Each processing slot collects the N input values of
+/// batchSize events, then evaluates them with a single call of the model, which lets a Gemm based inference run on
+/// matrices instead of vectors. The model is called with a pointer to the inputs of the batch, one row of N values
+/// per event, and must return the outputs of the batch in the same layout; the last batch of each slot is padded
+/// with zeros. The result holds the outputs of all events, ordered by entry number. The first column must be the entry
+/// number:
+/// ~~~{.cpp}
+/// auto y = df.Book<ULong64_t, float, float>(BatchedCompute<2, float>(TMVA_SOFIE_Model::infer, 64),
+///                                           {"rdfentry_", "x1", "x2"});
+/// ~~~
+/// The calls of the model are serialized, since the generated code is not reentrant.
+template <std::size_t N, typename T, typename F>
+auto BatchedCompute(F &&f, std::size_t batchSize) -> BatchedComputeHelper<N, T, std::decay_t<F>>
+{
+   return BatchedComputeHelper<N, T, std::decay_t<F>>(std::decay_t<F>(std::forward<F>(f)), batchSize);
+}
+
 } // namespace Experimental
 } // namespace TMVA
 
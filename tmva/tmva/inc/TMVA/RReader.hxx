@@ -119,6 +119,15 @@ private:
    unsigned int fNumClasses;
    const char *name = "RReader";
    Internal::AnalysisType fAnalysisType;
+   bool fConcurrent; ///< Whether the model is evaluated without taking the lock, see Reader::HasConcurrentEvaluation
+
+   /// Compute the model prediction of a method with concurrent evaluation, which can be called by several threads
+   std::vector<float> ComputeConcurrent(const std::vector<float> &x) const
+   {
+      if (fAnalysisType == Internal::AnalysisType::Classification)
+         return std::vector<float>({static_cast<float>(fReader->EvaluateMVAConcurrent(x, name))});
+      return fReader->EvaluateMulticlassConcurrent(x, name);
+   }
 
 public:
    /// Create TMVA model from XML file
@@ -139,6 +148,9 @@ public:
          fReader->AddVariable(TString(fExpressions[i]), &fValues[i]);
       }
       fReader->BookMVA(name, path.c_str());
+
+      // The regression needs the inverse transformation of the targets, which modifies the method
+      fConcurrent = fAnalysisType != Internal::AnalysisType::Regression && fReader->HasConcurrentEvaluation(name);
    }
 
    /// Compute model prediction on vector
@@ -147,14 +159,17 @@ public:
       if (x.size() != fVariables.size())
          throw std::runtime_error("Size of input vector is not equal to number of variables.");
 
+      if (fConcurrent)
+         return ComputeConcurrent(x);
+
+      // Take lock to protect model evaluation
+      R__WRITE_LOCKGUARD(ROOT::gCoreMutex);
+
       // Copy over inputs to memory used by TMVA reader
       for (std::size_t i = 0; i < x.size(); i++) {
          fValues[i] = x[i];
       }
 
-      // Take lock to protect model evaluation
-      R__WRITE_LOCKGUARD(ROOT::gCoreMutex);
-
       // Evaluate TMVA model
       // Classification
       if (fAnalysisType == Internal::AnalysisType::Classification) {
@@ -197,11 +212,28 @@ public:
          y = y.Reshape({numEntries, numClasses});
 
       // Fill output tensor
+      if (fConcurrent) {
+         std::vector<float> values(numVars);
+         for (std::size_t i = 0; i < numEntries; i++) {
+            for (std::size_t j = 0; j < numVars; j++) {
+               values[j] = x(i, j);
+            }
+            const auto p = ComputeConcurrent(values);
+            if (fAnalysisType == Internal::AnalysisType::Multiclass) {
+               for (std::size_t k = 0; k < numClasses; k++)
+                  y(i, k) = p[k];
+            } else {
+               y(i) = p[0];
+            }
+         }
+         return y;
+      }
+
       for (std::size_t i = 0; i < numEntries; i++) {
+         R__WRITE_LOCKGUARD(ROOT::gCoreMutex);
          for (std::size_t j = 0; j < numVars; j++) {
             fValues[j] = x(i, j);
          }
-         R__WRITE_LOCKGUARD(ROOT::gCoreMutex);
          // Classification
          if (fAnalysisType == Internal::AnalysisType::Classification) {
             y(i) = fReader->EvaluateMVA(name);
@@ -109,6 +109,12 @@ namespace TMVA {
       const std::vector< Float_t >& EvaluateMulticlass( MethodBase* method, Double_t aux = 0 );
       Float_t  EvaluateMulticlass( UInt_t clsNumber, const TString& methodTag, Double_t aux = 0 );
 
+      // concurrent evaluation: the input values are given by the caller and the methods are not modified, so that
+      // several threads can evaluate the methods booked in one reader at a time (see MethodBase::HasConcurrentEvaluation)
+      Bool_t   HasConcurrentEvaluation( const TString& methodTag ) const;
+      Double_t EvaluateMVAConcurrent( const std::vector<Float_t>& inputVec, const TString& methodTag ) const;
+      std::vector<Float_t> EvaluateMulticlassConcurrent( const std::vector<Float_t>& inputVec, const TString& methodTag ) const;
+
       // probability and rarity accessors (see Users Guide for definition of Rarity)
       Double_t GetProba ( const TString& methodTag, Double_t ap_sig=0.5, Double_t mvaVal=-9999999 );
       Double_t GetRarity( const TString& methodTag, Double_t mvaVal=-9999999 );
@@ -134,6 +140,8 @@ namespace TMVA {
 
       TString GetMethodTypeFromFile( const TString& filename );
 
+      const MethodBase* FindConcurrentMVA( const TString& methodTag ) const;
+
       // this booking method is internal
       IMethod* BookMVA( Types::EMVA method,  const TString& weightfile );
 
@@ -62,6 +62,10 @@ namespace TMVA {
       // calculate the activation value
       void CalculateActivationValue();
 
+      // return the activation value for the activation values of the preceding layer,
+      // without modifying the neuron
+      Double_t EvaluateActivationValue( const Double_t* preActivations ) const;
+
       // calculate the error field of the neuron
       void CalculateDelta();
 
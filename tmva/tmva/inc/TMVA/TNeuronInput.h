@@ -49,6 +49,10 @@ namespace TMVA {
       // calculate input value for neuron
       virtual Double_t GetInput( const TNeuron* neuron ) const = 0;
 
+      // calculate input value for neuron from the activation values of the preceding layer,
+      // given in the order of the pre-links, instead of the ones stored in the neurons
+      virtual Double_t GetInput( const TNeuron* neuron, const Double_t* preActivations ) const = 0;
+
       // name of class
       virtual TString GetName() = 0;
 
@@ -59,6 +59,15 @@ namespace TMVA {
          return result;
       }
 
+      // calculate input value for neuron from the activation values of the preceding layer
+      Double_t GetInput( const TNeuron* neuron, const Double_t* preActivations ) const {
+         if (neuron->IsInputNeuron()) return 0;
+         Double_t result = 0;
+         for (Int_t i=0; i < neuron->NumPreLinks(); i++)
+            result += TMath::Abs(neuron->PreLinkAt(i)->GetWeight() * preActivations[i]);
+         return result;
+      }
+
       // name of the class
       TString GetName() { return "Sum of weighted activations (absolute value)"; }
 
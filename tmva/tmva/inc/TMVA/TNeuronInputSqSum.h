@@ -58,6 +58,17 @@ namespace TMVA {
          return result;
       }
 
+      // calculate input value for neuron from the activation values of the preceding layer
+      Double_t GetInput( const TNeuron* neuron, const Double_t* preActivations ) const {
+         if (neuron->IsInputNeuron()) return 0;
+         Double_t result = 0;
+         for (Int_t i=0; i < neuron->NumPreLinks(); i++) {
+            Double_t val = neuron->PreLinkAt(i)->GetWeight() * preActivations[i];
+            result += val*val;
+         }
+         return result;
+      }
+
       // name of the class
       TString GetName() { return "Sum of weighted activations squared"; }
 
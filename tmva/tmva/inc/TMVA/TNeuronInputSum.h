@@ -56,6 +56,17 @@ namespace TMVA {
          return result;
       }
 
+      // calculate input value for neuron from the activation values of the preceding layer
+      Double_t GetInput( const TNeuron* neuron, const Double_t* preActivations ) const {
+         if (neuron->IsInputNeuron()) return 0;
+         Double_t result = 0;
+         Int_t npl = neuron->NumPreLinks();
+         for (Int_t i=0; i < npl; i++) {
+            result += neuron->PreLinkAt(i)->GetWeight() * preActivations[i];
+         }
+         return result;
+      }
+
       // name of class
       TString GetName() { return "Sum of weighted activations"; }
 
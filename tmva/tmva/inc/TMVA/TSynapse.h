@@ -50,7 +50,7 @@ namespace TMVA {
       void SetWeight(Double_t weight);
 
       // get the weight of the synapse
-      Double_t GetWeight()                 { return fWeight;         }
+      Double_t GetWeight() const           { return fWeight;         }
 
       // set the learning rate
       void SetLearningRate(Double_t rate)  { fLearnRate = rate;      }
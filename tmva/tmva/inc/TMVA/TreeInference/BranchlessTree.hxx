@@ -22,14 +22,21 @@
 
 #include <vector>
 #include <algorithm>
+#include <cstdint>
 #include <string>
 #include <sstream>
+#include <iomanip>
+#include <limits>
+#include <stdexcept>
 
 namespace TMVA {
 namespace Experimental {
 
 namespace Internal {
 
+/// Number of events traversed together through each tree by the batched inference
+constexpr int kInferenceBlockSize = 64;
+
 /// Fill the empty nodes of a sparse tree recursively
 template <typename T>
 void RecursiveFill(int thisIndex, int lastIndex, int treeDepth, int maxTreeDepth, std::vector<T> &thresholds,
@@ -65,8 +72,11 @@ struct BranchlessTree {
    std::vector<int> fInputs;   ///< Cut variables / inputs
 
    inline T Inference(const T *input, const int stride);
+   inline void InferenceBlock(const T *input, const int stride, const int strideBatch, const int rows,
+                              T *predictions) const;
    inline void FillSparse();
    inline std::string GetInferenceCode(const std::string& funcName, const std::string& typeName);
+   inline std::string GetBlockInferenceCode(const std::string &funcName, const std::string &typeName);
 };
 
 /// Perform inference on a single input vector
@@ -83,6 +93,35 @@ inline T BranchlessTree<T>::Inference(const T *input, const int stride)
    return fThresholds[index];
 }
 
+/// Perform inference on a block of events and add the tree scores to the predictions
+///
+/// The events of the block descend the tree together, one level at a time, so that the comparisons of a level
+/// are independent of each other: the compiler can vectorize them, loading the inputs and the thresholds of the
+/// nodes with gathers. The events of a batch are split in blocks by the forest, so that the nodes of each tree
+/// are loaded from memory once per block.
+///
+/// \param[in] input Pointer to data containing the input values of the first event
+/// \param[in] stride Stride to go from one input variable to the next one
+/// \param[in] strideBatch Stride to go from one event to the next one
+/// \param[in] rows Number of events in the block, at most Internal::kInferenceBlockSize
+/// \param[in,out] predictions Pointer to the predictions of the events, incremented by the tree scores
+template <typename T>
+inline void BranchlessTree<T>::InferenceBlock(const T *input, const int stride, const int strideBatch, const int rows,
+                                              T *predictions) const
+{
+   const int *inputs = fInputs.data();
+   const T *thresholds = fThresholds.data();
+   int index[Internal::kInferenceBlockSize] = {0};
+   for (int level = 0; level < fTreeDepth; ++level) {
+      for (int i = 0; i < rows; ++i) {
+         index[i] = 2 * index[i] + 1 + (input[i * strideBatch + inputs[index[i]] * stride] > thresholds[index[i]]);
+      }
+   }
+   for (int i = 0; i < rows; ++i) {
+      predictions[i] += thresholds[index[i]];
+   }
+}
+
 /// Fill nodes of a sparse tree forming a full tree
 ///
 /// Sparse parts of the tree are marked with -1 values in the feature vector. The
@@ -145,6 +184,103 @@ inline std::string BranchlessTree<T>::GetInferenceCode(const std::string& funcNa
    return ss.str();
 }
 
+/// Get code for compiling the inference function of the branchless tree on a block of events, see InferenceBlock,
+/// with the current thresholds and cut variables
+///
+/// \param[in] funcName Name of the function
+/// \param[in] typeName Name of the type used for the computation
+/// \return Code of the inference function as string
+template <typename T>
+inline std::string BranchlessTree<T>::GetBlockInferenceCode(const std::string &funcName, const std::string &typeName)
+{
+   std::stringstream ss;
+   ss << std::setprecision(std::numeric_limits<T>::max_digits10);
+
+   // Build signature
+   ss << "inline void " << funcName << "(const " << typeName
+      << "* input, const int stride, const int strideBatch, const int rows, " << typeName << "* predictions)";
+
+   // Function body
+   ss << "\n{\n";
+
+   // Hard-code thresholds and cut variables
+   if (fTreeDepth > 1) {
+      ss << "   const int inputs[" << fInputs.size() << "] = {";
+      for (std::size_t i = 0; i < fInputs.size(); i++) {
+         ss << fInputs[i];
+         if (i + 1 != fInputs.size()) ss << ", ";
+      }
+      ss << "};\n";
+   }
+
+   ss << "   const " << typeName << " thresholds[" << fThresholds.size() << "] = {";
+   for (std::size_t i = 0; i < fThresholds.size(); i++) {
+      ss << fThresholds[i];
+      if (i + 1 != fThresholds.size()) ss << ", ";
+   }
+   ss << "};\n";
+
+   // Add inference code, the cut of the root node is the same for all events
+   ss << "   int index[" << Internal::kInferenceBlockSize << "];\n";
+   if (fTreeDepth > 0) {
+      ss << "   for (int i = 0; i < rows; i++) index[i] = 1 + (input[i * strideBatch + " << fInputs[0]
+         << " * stride] > thresholds[0]);\n";
+   } else {
+      ss << "   for (int i = 0; i < rows; i++) index[i] = 0;\n";
+   }
+   for (int level = 1; level < fTreeDepth; ++level) {
+      ss << "   for (int i = 0; i < rows; i++) index[i] = 2 * index[i] + 1 + (input[i * strideBatch + inputs[index[i]] * "
+            "stride] > thresholds[index[i]]);\n";
+   }
+   ss << "   for (int i = 0; i < rows; i++) predictions[i] += thresholds[index[i]];\n";
+   ss << "}";
+
+   return ss.str();
+}
+
+/// \class BranchlessQuantizedTree
+/// \brief Branchless decision tree with the cut thresholds replaced by the indices of the bins of the inputs
+///
+/// The thresholds of the inner nodes are the positions of the cuts in the sorted list of the cuts of the forest
+/// on the same input variable, stored as 16 bit integers, and the inputs are replaced by the number of cuts of the
+/// forest below them, see BranchlessQuantizedForest. The comparison `input > threshold` is then the same as
+/// `bin(input) > bin(threshold)`. The inner nodes take half of the memory of those of a BranchlessTree<float> and the
+/// leaves are stored apart, which keeps more trees of large forests in the caches.
+///
+/// \tparam T Value type of the leaf scores (usually floating point type)
+template <typename T>
+struct BranchlessQuantizedTree {
+   int fTreeDepth;                    ///< Depth of the tree
+   std::vector<std::int16_t> fBins;   ///< Index of the cut of each inner node in the cuts on its input variable
+   std::vector<std::int16_t> fInputs; ///< Cut variables / inputs of the inner nodes
+   std::vector<T> fLeaves;            ///< Scores of the leaves
+
+   inline void InferenceBlock(const std::int16_t *bins, const int rows, T *predictions) const;
+};
+
+/// Perform inference on a block of quantized events and add the tree scores to the predictions
+///
+/// \param[in] bins Bins of the input values of the events of the block: the bin of the input variable j of the
+/// event i is bins[j * Internal::kInferenceBlockSize + i]
+/// \param[in] rows Number of events in the block, at most Internal::kInferenceBlockSize
+/// \param[in,out] predictions Pointer to the predictions of the events, incremented by the tree scores
+template <typename T>
+inline void BranchlessQuantizedTree<T>::InferenceBlock(const std::int16_t *bins, const int rows, T *predictions) const
+{
+   const std::int16_t *inputs = fInputs.data();
+   const std::int16_t *cuts = fBins.data();
+   int index[Internal::kInferenceBlockSize] = {0};
+   for (int level = 0; level < fTreeDepth; ++level) {
+      for (int i = 0; i < rows; ++i) {
+         index[i] = 2 * index[i] + 1 + (bins[inputs[index[i]] * Internal::kInferenceBlockSize + i] > cuts[index[i]]);
+      }
+   }
+   const int firstLeaf = static_cast<int>(fBins.size());
+   for (int i = 0; i < rows; ++i) {
+      predictions[i] += fLeaves[index[i] - firstLeaf];
+   }
+}
+
 } // namespace Experimental
 } // namespace TMVA
 
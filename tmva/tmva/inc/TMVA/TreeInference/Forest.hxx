@@ -26,6 +26,8 @@
 #include <stdexcept>
 #include <cmath>
 #include <algorithm>
+#include <cstdint>
+#include <limits>
 
 #include "TFile.h"
 #include "TDirectory.h"
@@ -84,12 +86,17 @@ inline void ForestBase<T, ForestType>::Inference(const T *inputs, const int rows
 {
    const auto strideTree = layout ? 1 : rows;
    const auto strideBatch = layout ? fNumInputs : 1;
-   for (int i = 0; i < rows; i++) {
-      predictions[i] = 0.0;
+   // the events are evaluated in blocks, each tree descended by all events of the block at once
+   for (int begin = 0; begin < rows; begin += Internal::kInferenceBlockSize) {
+      const int n = std::min(Internal::kInferenceBlockSize, rows - begin);
+      T *blockPredictions = predictions + begin;
+      std::fill(blockPredictions, blockPredictions + n, 0.0);
       for (auto &tree : fTrees) {
-         predictions[i] += tree.Inference(inputs + i * strideBatch, strideTree);
+         tree.InferenceBlock(inputs + begin * strideBatch, strideTree, strideBatch, n, blockPredictions);
+      }
+      for (int i = 0; i < n; i++) {
+         blockPredictions[i] = fObjectiveFunc(blockPredictions[i]);
       }
-      predictions[i] = fObjectiveFunc(predictions[i]);
    }
 }
 
@@ -269,7 +276,7 @@ BranchlessJittedForest<T>::Load(const std::string &key, const std::string &filen
       // Save code for jitting
       std::stringstream ss;
       ss << "tree" << c;
-      codes[c] = tree.GetInferenceCode(ss.str(), typeName);
+      codes[c] = tree.GetBlockInferenceCode(ss.str(), typeName);
 
       c++;
    }
@@ -309,13 +316,17 @@ BranchlessJittedForest<T>::Load(const std::string &key, const std::string &filen
              << "\n{\n"
              << "   const auto strideTree = layout ? 1 : rows;\n"
              << "   const auto strideBatch = layout ? " << this->fNumInputs << " : 1;\n"
-             << "   for (int i = 0; i < rows; i++) {\n"
-             << "      predictions[i] = 0.0;\n";
+             << "   for (int begin = 0; begin < rows; begin += " << Internal::kInferenceBlockSize << ") {\n"
+             << "      const int n = rows - begin < " << Internal::kInferenceBlockSize << " ? rows - begin : "
+             << Internal::kInferenceBlockSize << ";\n"
+             << "      const " << typeName << "* block = inputs + begin * strideBatch;\n"
+             << "      " << typeName << "* blockPredictions = predictions + begin;\n"
+             << "      for (int i = 0; i < n; i++) blockPredictions[i] = 0.0;\n";
    for (int i = 0; i < static_cast<int>(codes.size()); i++) {
       std::stringstream ss;
       ss << "tree" << i;
       const std::string funcName = ss.str();
-      jitForest << "      predictions[i] += " << funcName << "(inputs + i * strideBatch, strideTree);\n";
+      jitForest << "      " << funcName << "(block, strideTree, strideBatch, n, blockPredictions);\n";
    }
    jitForest << "   }\n"
              << "}\n"
@@ -362,6 +373,132 @@ void BranchlessJittedForest<T>::Inference(const T *inputs, const int rows, bool
       predictions[i] = this->fObjectiveFunc(predictions[i]);
 }
 
+/// Forest using branchless trees with quantized thresholds
+///
+/// The thresholds of the trees are replaced by their positions in the sorted list of the distinct cuts of the
+/// forest on the same input variable, see BranchlessQuantizedTree. Before the trees are descended by a block of
+/// events, the inputs of the events are replaced by their bins, the number of cuts below them, found by binary
+/// search. The predictions are the same as those of the BranchlessForest, with trees that take less memory, which
+/// pays off for large forests.
+///
+/// \tparam T Value type for the computation (usually floating point type)
+template <typename T>
+struct BranchlessQuantizedForest : public ForestBase<T, std::vector<BranchlessQuantizedTree<T>>> {
+   std::vector<std::vector<T>> fCuts; ///< Sorted distinct cuts of the forest on each input variable
+
+   void Load(const std::string &key, const std::string &filename, const int output = 0, const bool sortTrees = true);
+   void Quantize(const BranchlessForest<T> &forest);
+   void Inference(const T *inputs, const int rows, bool layout, T *predictions);
+};
+
+/// Load parameters from a ROOT file to the branchless trees and quantize their thresholds
+///
+/// \param[in] key Name of folder in the ROOT file containing the model parameters
+/// \param[in] filename Filename of the ROOT file
+/// \param[in] output Load trees corresponding to the given output node of the forest
+/// \param[in] sortTrees Flag to indicate sorting the input trees by the cut value of the first node of each tree
+template <typename T>
+inline void BranchlessQuantizedForest<T>::Load(const std::string &key, const std::string &filename, const int output,
+                                               const bool sortTrees)
+{
+   BranchlessForest<T> forest;
+   forest.Load(key, filename, output, sortTrees);
+   Quantize(forest);
+}
+
+/// Set up the forest from the trees of a branchless forest, replacing their thresholds by the indices of the bins
+///
+/// \param[in] forest Branchless forest with the trees filled, see BranchlessTree::FillSparse
+template <typename T>
+inline void BranchlessQuantizedForest<T>::Quantize(const BranchlessForest<T> &forest)
+{
+   this->fNumInputs = forest.fNumInputs;
+   this->fObjectiveFunc = forest.fObjectiveFunc;
+   if (this->fNumInputs > std::numeric_limits<std::int16_t>::max())
+      throw std::runtime_error("Too many input variables to quantize the thresholds of the forest.");
+
+   // The nodes whose subtree has a single score do not cut, e.g. the nodes added to fill the sparse trees: their
+   // thresholds are not collected
+   std::vector<std::vector<char>> isCut(forest.fTrees.size());
+   fCuts.assign(this->fNumInputs, {});
+   for (std::size_t t = 0; t < forest.fTrees.size(); t++) {
+      const auto &tree = forest.fTrees[t];
+      const int numInner = (1 << tree.fTreeDepth) - 1;
+      std::vector<char> isUniform(tree.fThresholds.size(), 1);
+      std::vector<T> score(tree.fThresholds.begin(), tree.fThresholds.end());
+      isCut[t].assign(numInner, 0);
+      for (int i = numInner - 1; i >= 0; i--) {
+         isUniform[i] = isUniform[2 * i + 1] && isUniform[2 * i + 2] && score[2 * i + 1] == score[2 * i + 2];
+         score[i] = score[2 * i + 1];
+         if (!isUniform[i]) {
+            isCut[t][i] = 1;
+            fCuts[tree.fInputs[i]].push_back(tree.fThresholds[i]);
+         }
+      }
+   }
+   for (auto &cuts : fCuts) {
+      std::sort(cuts.begin(), cuts.end());
+      cuts.erase(std::unique(cuts.begin(), cuts.end()), cuts.end());
+      if (cuts.size() > static_cast<std::size_t>(std::numeric_limits<std::int16_t>::max()))
+         throw std::runtime_error("Too many distinct cuts on an input variable to quantize the thresholds of the forest.");
+   }
+
+   this->fTrees.resize(forest.fTrees.size());
+   for (std::size_t t = 0; t < forest.fTrees.size(); t++) {
+      const auto &tree = forest.fTrees[t];
+      auto &quantizedTree = this->fTrees[t];
+      const int numInner = (1 << tree.fTreeDepth) - 1;
+      quantizedTree.fTreeDepth = tree.fTreeDepth;
+      quantizedTree.fBins.assign(numInner, 0);
+      quantizedTree.fInputs.assign(numInner, 0);
+      for (int i = 0; i < numInner; i++) {
+         if (!isCut[t][i])
+            continue;
+         const auto &cuts = fCuts[tree.fInputs[i]];
+         quantizedTree.fInputs[i] = tree.fInputs[i];
+         quantizedTree.fBins[i] = std::lower_bound(cuts.begin(), cuts.end(), tree.fThresholds[i]) - cuts.begin();
+      }
+      quantizedTree.fLeaves.assign(tree.fThresholds.begin() + numInner, tree.fThresholds.end());
+   }
+}
+
+/// Perform inference of the forest with the quantized thresholds on a batch of inputs
+///
+/// \param[in] inputs Pointer to data containing the inputs
+/// \param[in] rows Number of events in inputs vector
+/// \param[in] layout Row major (true) or column major (false) memory layout
+/// \param[in] predictions Pointer to the buffer to be filled with the predictions
+template <typename T>
+inline void BranchlessQuantizedForest<T>::Inference(const T *inputs, const int rows, bool layout, T *predictions)
+{
+   const auto strideTree = layout ? 1 : rows;
+   const auto strideBatch = layout ? this->fNumInputs : 1;
+   std::vector<std::int16_t> bins(this->fNumInputs * Internal::kInferenceBlockSize);
+   for (int begin = 0; begin < rows; begin += Internal::kInferenceBlockSize) {
+      const int n = std::min(Internal::kInferenceBlockSize, rows - begin);
+      const T *block = inputs + begin * strideBatch;
+      // The bin of an input is the number of cuts of the forest strictly below it: input > cut[j] if and only if
+      // bin > j
+      for (int j = 0; j < this->fNumInputs; j++) {
+         const auto &cuts = fCuts[j];
+         if (cuts.empty())
+            continue;
+         for (int i = 0; i < n; i++) {
+            bins[j * Internal::kInferenceBlockSize + i] =
+               std::lower_bound(cuts.begin(), cuts.end(), block[i * strideBatch + j * strideTree]) - cuts.begin();
+         }
+      }
+      T *blockPredictions = predictions + begin;
+      std::fill(blockPredictions, blockPredictions + n, 0.0);
+      for (auto &tree : this->fTrees) {
+         tree.InferenceBlock(bins.data(), n, blockPredictions);
+      }
+      for (int i = 0; i < n; i++) {
+         blockPredictions[i] = this->fObjectiveFunc(blockPredictions[i]);
+      }
+   }
+}
+
 } // namespace Experimental
 } // namespace TMVA
 
@@ -58,6 +58,7 @@ namespace TMVA {
 
       //      virtual const Event* Transform(const Event* const, Types::ESBType type = Types::kMaxSBType) const;
       virtual const Event* Transform(const Event* const, Int_t cls ) const;
+      virtual const Event* Transform(const Event* const, Int_t cls, Event& transformed ) const;
       virtual const Event* InverseTransform(const Event* const, Int_t cls ) const;
 
       void WriteTransformationToStream ( std::ostream& ) const;
@@ -59,6 +59,7 @@ namespace TMVA {
       virtual void ReadFromXML( void* trfnode );
 
       virtual const Event* Transform(const Event* const, Int_t cls ) const;
+      virtual const Event* Transform(const Event* const, Int_t cls, Event& transformed ) const;
       virtual const Event* InverseTransform(const Event* const ev, Int_t cls ) const { return Transform( ev, cls ); }
 
       // writer of function code
@@ -56,6 +56,7 @@ namespace TMVA {
       Bool_t PrepareTransformation (const std::vector<Event*>&);
 
       virtual const Event* Transform(const Event* const, Int_t cls ) const;
+      virtual const Event* Transform(const Event* const, Int_t cls, Event& transformed ) const;
       virtual const Event* InverseTransform(const Event* const, Int_t cls ) const;
 
       void WriteTransformationToStream ( std::ostream& ) const;
@@ -65,6 +65,9 @@ namespace TMVA {
       virtual void         Initialize() = 0;
       virtual Bool_t       PrepareTransformation (const std::vector<Event*>&  ) = 0;
       virtual const Event* Transform       ( const Event* const, Int_t cls ) const = 0;
+      // transform into an event of the caller, without touching the transformation, so that it can be applied
+      // by several threads at a time; returns either the transformed event or the input event if unchanged
+      virtual const Event* Transform       ( const Event* const, Int_t cls, Event& transformed ) const;
       virtual const Event* InverseTransform( const Event* const, Int_t cls ) const = 0;
 
       // accessors
@@ -32,6 +32,7 @@
 #include "TLegend.h"
 #include "TMath.h"
 
+#include <algorithm>
 #include <iostream>
 #include <memory>
 
@@ -578,6 +579,74 @@ TMVA::CrossValidationFoldResult TMVA::CrossValidation::ProcessFold(UInt_t iFold,
    return result;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Evaluates the folds of all booked methods.
+///
+/// With several worker processes, the folds of all methods are distributed
+/// over a single pool of processes, such that the workers are kept busy even
+/// when there are fewer folds than workers. The workers are forked after the
+/// dataset has been loaded and split into folds: they share its events with
+/// this process (copy-on-write) instead of loading them again, and return the
+/// fold results in memory. The results are returned in the order in which
+/// the folds finished.
+///
+
+std::vector<TMVA::CrossValidationFoldResult> TMVA::CrossValidation::ProcessFolds()
+{
+   auto processFold = [this](UInt_t iJob) {
+      const UInt_t iMethod = iJob / fNumFolds;
+      CrossValidationFoldResult result = ProcessFold(iJob % fNumFolds, fMethods[iMethod]);
+      result.fMethod = iMethod;
+      return result;
+   };
+   const UInt_t nJobs = fMethods.size() * fNumFolds;
+
+   auto nWorkers = fNumWorkerProcs;
+   if (nWorkers == 1) {
+      // Fall back to global config
+      nWorkers = TMVA::gConfig().GetNumWorkers();
+   }
+#ifdef _MSC_VER
+   nWorkers = 1;
+#endif
+
+   std::vector<CrossValidationFoldResult> results;
+   if (nWorkers == 1) {
+      results.reserve(nJobs);
+      for (UInt_t iJob = 0; iJob < nJobs; ++iJob) {
+         if (iJob % fNumFolds == 0) {
+            TMVA::MsgLogger::EnableOutput();
+            Log() << kINFO << Endl;
+            Log() << kINFO << Endl;
+            Log() << kINFO << "========================================" << Endl;
+            Log() << kINFO << "Processing folds for method " << fMethods[iJob / fNumFolds].GetValue<TString>("MethodTitle") << Endl;
+            Log() << kINFO << "========================================" << Endl;
+            Log() << kINFO << Endl;
+         }
+         results.push_back(processFold(iJob));
+      }
+   } else {
+#ifndef _MSC_VER
+      TMVA::MsgLogger::EnableOutput();
+      Log() << kINFO << Endl;
+      Log() << kINFO << Endl;
+      Log() << kINFO << "========================================" << Endl;
+      Log() << kINFO << "Processing " << fNumFolds << " folds for " << fMethods.size() << " method(s) in "
+            << (nWorkers > 0 ? TString::Format("%u", nWorkers) : TString("one per core")) << " worker processes" << Endl;
+      Log() << kINFO << "========================================" << Endl;
+      Log() << kINFO << Endl;
+
+      ROOT::TProcessExecutor workers(nWorkers);
+      results = workers.Map(processFold, ROOT::TSeqU(nJobs));
+      if (results.size() != nJobs) {
+         Log() << kFATAL << "Only " << results.size() << " of the " << nJobs
+               << " folds were processed successfully by the worker processes" << Endl;
+      }
+#endif
+   }
+   return results;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Does training, test set evaluation and performance evaluation of using
 /// cross-evalution.
@@ -591,51 +660,30 @@ void TMVA::CrossValidation::Evaluate()
       fFoldStatus = kTRUE;
    }
 
-   fResults.reserve(fMethods.size());
    for (auto & methodInfo : fMethods) {
-      CrossValidationResult result{fNumFolds};
-
-      TString methodTypeName = methodInfo.GetValue<TString>("MethodName");
-      TString methodTitle = methodInfo.GetValue<TString>("MethodTitle");
-
-      if (methodTypeName == "") {
+      if (methodInfo.GetValue<TString>("MethodName") == "") {
          Log() << kFATAL << "No method booked for cross-validation" << Endl;
       }
+   }
 
-      TMVA::MsgLogger::EnableOutput();
-      Log() << kINFO << Endl;
-      Log() << kINFO << Endl;
-      Log() << kINFO << "========================================" << Endl;
-      Log() << kINFO << "Processing folds for method " << methodTitle << Endl;
-      Log() << kINFO << "========================================" << Endl;
-      Log() << kINFO << Endl;
-
-      // Process K folds
-      auto nWorkers = fNumWorkerProcs;
-      if (nWorkers == 1) {
-         // Fall back to global config
-         nWorkers = TMVA::gConfig().GetNumWorkers();
-      }
-      if (nWorkers == 1) {
-         for (UInt_t iFold = 0; iFold < fNumFolds; ++iFold) {
-            auto fold_result = ProcessFold(iFold, methodInfo);
-            result.Fill(fold_result);
-         }
-      } else {
-#ifndef _MSC_VER
-         ROOT::TProcessExecutor workers(nWorkers);
-         std::vector<CrossValidationFoldResult> result_vector;
+   // Process K folds of all methods, ordered by method and fold
+   std::vector<CrossValidationFoldResult> foldResults = ProcessFolds();
+   std::sort(foldResults.begin(), foldResults.end(),
+             [](const CrossValidationFoldResult &a, const CrossValidationFoldResult &b) {
+                return a.fMethod < b.fMethod || (a.fMethod == b.fMethod && a.fFold < b.fFold);
+             });
 
-         auto workItem = [this, methodInfo](UInt_t iFold) {
-            return ProcessFold(iFold, methodInfo);
-         };
+   fResults.reserve(fMethods.size());
+   auto foldResult = foldResults.begin();
+   for (UInt_t iMethod = 0; iMethod < fMethods.size(); ++iMethod) {
+      const auto & methodInfo = fMethods[iMethod];
+      CrossValidationResult result{fNumFolds};
 
-         result_vector = workers.Map(workItem, ROOT::TSeqI(fNumFolds));
+      TString methodTypeName = methodInfo.GetValue<TString>("MethodName");
+      TString methodTitle = methodInfo.GetValue<TString>("MethodTitle");
 
-         for (auto && fold_result : result_vector) {
-            result.Fill(fold_result);
-         }
-#endif
+      for (; foldResult != foldResults.end() && foldResult->fMethod == iMethod; ++foldResult) {
+         result.Fill(*foldResult);
       }
 
       fResults.push_back(result);
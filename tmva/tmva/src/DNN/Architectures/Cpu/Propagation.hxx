@@ -268,6 +268,87 @@ void TCpu<AFloat>::Im2colFast(TCpuMatrix<AFloat> &A, const TCpuMatrix<AFloat> &B
 
 #endif
 }
+//____________________________________________________________________________
+template <typename AFloat>
+void TCpu<AFloat>::ConvolveDirect(TCpuMatrix<AFloat> &A, const TCpuMatrix<AFloat> &B,
+                                  const TCpuMatrix<AFloat> &weights, const TCpuMatrix<AFloat> &biases,
+                                  const std::vector<int> &V, size_t firstChannel, size_t lastChannel)
+{
+   // The local views are processed in blocks, whose pixels are gathered once in a tile small enough to stay in
+   // the cache while it is convolved with the filters, a few output channels at a time.
+   constexpr size_t viewBlock = 64;
+   constexpr size_t channelBlock = 8;
+
+   const size_t depth = A.GetNrows();
+   const size_t nLocalViews = A.GetNcols();
+   const size_t nLocalViewPixels = weights.GetNcols();
+   R__ASSERT(V.size() == nLocalViews * nLocalViewPixels);
+   R__ASSERT(lastChannel <= depth);
+
+   AFloat *a = A.GetRawDataPointer();
+   const AFloat *b = B.GetRawDataPointer();
+   const AFloat *w = weights.GetRawDataPointer();
+   const AFloat *bias = biases.GetRawDataPointer();
+
+   TCpuMatrix<AFloat> tileMatrix = GetScratchMatrix(1, viewBlock * nLocalViewPixels);
+   AFloat *tile = tileMatrix.GetRawDataPointer();
+   AFloat acc[channelBlock][viewBlock];
+
+   for (size_t v0 = 0; v0 < nLocalViews; v0 += viewBlock) {
+      const size_t nViews = std::min(viewBlock, nLocalViews - v0);
+
+      // im2col of the block of local views
+      for (size_t p = 0; p < nLocalViewPixels; p++) {
+         const int *idx = V.data() + p * nLocalViews + v0;
+         AFloat *t = tile + p * viewBlock;
+         for (size_t v = 0; v < nViews; v++)
+            t[v] = (idx[v] >= 0) ? b[idx[v]] : 0;
+      }
+
+      for (size_t d0 = firstChannel; d0 < lastChannel; d0 += channelBlock) {
+         const size_t nChannels = std::min(channelBlock, lastChannel - d0);
+         for (size_t c = 0; c < nChannels; c++)
+            for (size_t v = 0; v < nViews; v++)
+               acc[c][v] = bias[d0 + c];
+
+         for (size_t p = 0; p < nLocalViewPixels; p++) {
+            const AFloat *t = tile + p * viewBlock;
+            const AFloat *wp = w + p * depth + d0;
+            for (size_t c = 0; c < nChannels; c++) {
+               const AFloat wc = wp[c];
+               for (size_t v = 0; v < nViews; v++)
+                  acc[c][v] += wc * t[v];
+            }
+         }
+
+         for (size_t v = 0; v < nViews; v++)
+            for (size_t c = 0; c < nChannels; c++)
+               a[(v0 + v) * depth + d0 + c] = acc[c][v];
+      }
+   }
+}
+
+//____________________________________________________________________________
+template <typename AFloat>
+bool TCpu<AFloat>::UseDirectConvolution(size_t batchSize, size_t depth, size_t nLocalViewPixels)
+{
+   // The matrix multiplications of small filter banks do not profit from BLAS, and the parallelization over the
+   // images alone leaves threads idle when the batch is small compared to the thread pool.
+   const size_t nThreads = TCpuMatrix<AFloat>::GetThreadExecutor().GetPoolSize();
+   return depth * nLocalViewPixels <= 1024 || batchSize < 2 * nThreads;
+}
+
+//____________________________________________________________________________
+template <typename AFloat>
+TCpuMatrix<AFloat> TCpu<AFloat>::GetScratchMatrix(size_t nRows, size_t nCols)
+{
+   thread_local TCpuBuffer<AFloat> buffer(0);
+   const size_t n = nRows * nCols;
+   if (buffer.GetSize() < n)
+      buffer = TCpuBuffer<AFloat>(n);
+   return TCpuMatrix<AFloat>(buffer, nRows, nCols);
+}
+
 //____________________________________________________________________________
 template <typename AFloat>
 void TCpu<AFloat>::RotateWeights(TCpuMatrix<AFloat> &A, const TCpuMatrix<AFloat> &B, size_t filterDepth,
@@ -347,25 +428,42 @@ void TCpu<AFloat>::ConvLayerForward(TCpuTensor<AFloat> & output,
    TCpuMatrix<AFloat>::InitializeOneVector(output.GetWSize());   // since it is used in AddCOnvBiases
 
 
-   auto f = [&] (UInt_t i)
-   {
-       // dropout not yet implemented for CNN
-       // if (applyDropout && (dropoutProbability != 1.0)) {
-       //    Dropout(input[i], dropoutProbability);
-       // }
-
-       TCpuMatrix<AFloat> inputTr(nLocalViews, nLocalViewPixels);
-       //inputTr.Zero();   // this is not thread safe
-
-       Im2colFast(inputTr, input.At(i).GetMatrix(), forwardIndices);
-
-       Matrix_t output_m = output.At(i).GetMatrix();
-       MultiplyTranspose(output_m, weights, inputTr);
-       AddConvBiases(output_m, biases);
-
-   };
-
-   TCpuMatrix<AFloat>::GetThreadExecutor().Foreach(f, ROOT::TSeqI(input.GetFirstSize()));
+   const size_t batchSize = input.GetFirstSize();
+   const size_t depth = output.At(0).GetMatrix().GetNrows();
+   if (UseDirectConvolution(batchSize, depth, nLocalViewPixels)) {
+      // split the output channels of each image in groups, to have about two work items per thread
+      const size_t nThreads = TCpuMatrix<AFloat>::GetThreadExecutor().GetPoolSize();
+      size_t nGroups = std::min(depth, std::max<size_t>(1, (2 * nThreads + batchSize - 1) / batchSize));
+      const size_t groupSize = (depth + nGroups - 1) / nGroups;
+      nGroups = (depth + groupSize - 1) / groupSize;
+
+      auto f = [&](UInt_t item) {
+         const size_t i = item / nGroups;
+         const size_t firstChannel = (item % nGroups) * groupSize;
+         Matrix_t output_m = output.At(i).GetMatrix();
+         ConvolveDirect(output_m, input.At(i).GetMatrix(), weights, biases, forwardIndices, firstChannel,
+                        std::min(depth, firstChannel + groupSize));
+      };
+
+      TCpuMatrix<AFloat>::GetThreadExecutor().Foreach(f, ROOT::TSeqI(batchSize * nGroups));
+   } else {
+      auto f = [&](UInt_t i) {
+         // dropout not yet implemented for CNN
+         // if (applyDropout && (dropoutProbability != 1.0)) {
+         //    Dropout(input[i], dropoutProbability);
+         // }
+
+         TCpuMatrix<AFloat> inputTr = GetScratchMatrix(nLocalViews, nLocalViewPixels);
+
+         Im2colFast(inputTr, input.At(i).GetMatrix(), forwardIndices);
+
+         Matrix_t output_m = output.At(i).GetMatrix();
+         MultiplyTranspose(output_m, weights, inputTr);
+         AddConvBiases(output_m, biases);
+      };
+
+      TCpuMatrix<AFloat>::GetThreadExecutor().Foreach(f, ROOT::TSeqI(batchSize));
+   }
 
    //evaluateDerivative<TCpu<AFloat>>(derivatives, activFunc, output);
    // need to save output of convolution (input to activation function)
@@ -472,7 +570,7 @@ void TCpu<AFloat>::CalculateConvActivationGradients(TCpuTensor<AFloat> &activati
        // Im2col(dfTr, df[i], height, width, filterHeight, filterWidth, tempStrideRows, tempStrideCols,
        //       tempZeroPaddingHeight, tempZeroPaddingWidth);
 
-      TCpuMatrix<AFloat> dfTr(tempNLocalViews, tempNLocalViewPixels);
+      TCpuMatrix<AFloat> dfTr = GetScratchMatrix(tempNLocalViews, tempNLocalViewPixels);
 
       Im2colFast(dfTr, df.At(i).GetMatrix(), vIndices);
 
@@ -536,8 +634,7 @@ void TCpu<AFloat>::CalculateConvWeightGradients(TCpuMatrix<AFloat> &weightGradie
    auto fmap = [&](int i) {
 
       //TMVA_DNN_PrintTCpuMatrix(df[i],"df-i");
-      TCpuMatrix<AFloat> xTr(nLocalViews, nLocalViewPixels);
-      TCpuMatrix<AFloat> res(depth, nLocalViewPixels);
+      TCpuMatrix<AFloat> xTr = GetScratchMatrix(nLocalViews, nLocalViewPixels);
 
       //computing t he gradient is equivalent of doing a convolution of the input using as conv kernel the delta's (the df[] values)
       //N.B. only stride values=1 are now supported
@@ -562,10 +659,10 @@ void TCpu<AFloat>::CalculateConvWeightGradients(TCpuMatrix<AFloat> &weightGradie
 
 //   auto freduce = [&](const TCpuTensor<AFloat> & vres) {
       R__ASSERT(vres.GetFirstSize() == batchSize);
-      for (size_t i = 0; i < batchSize; i++) {
-         //TMVA_DNN_PrintTCpuMatrix(vres[i],"res");
-         Matrix_t vres_m = vres.At(i).GetMatrix();
-         for (size_t j = 0; j < depth; j++) {
+      // sum over the images, in parallel over the output channels
+      auto freduce = [&](UInt_t j) {
+         for (size_t i = 0; i < batchSize; i++) {
+            Matrix_t vres_m = vres.At(i).GetMatrix();
             for (size_t k = 0; k < filterDepth; k++) {
                size_t kOffset = k * filterSize;
                for (size_t l = 0; l < filterSize; l++) {
@@ -574,8 +671,8 @@ void TCpu<AFloat>::CalculateConvWeightGradients(TCpuMatrix<AFloat> &weightGradie
                }
             }
          }
-         // TMVA_DNN_PrintTCpuMatrix(weightGradients,"weights_i");
-      }
+      };
+      TCpuMatrix<AFloat>::GetThreadExecutor().Foreach(freduce, ROOT::TSeqI(depth));
       //  };
 
    //TCpuMatrix<AFloat>::GetThreadExecutor().MapReduce(fmap, ROOT::TSeqI( batchSize ) , freduce);
@@ -62,6 +62,8 @@ more signal respective background events from the training sample.
 #include <vector>
 #include <limits>
 #include <cassert>
+#include <memory>
+#include <numeric>
 
 #include "TRandom3.h"
 #include "TMath.h"
@@ -119,6 +121,7 @@ TMVA::DecisionTree::DecisionTree():
    fUseFisherCuts  (kFALSE),
    fMinLinCorrForFisher (1),
    fUseExclusiveVars (kTRUE),
+   fUseHistogramSplits (kFALSE),
    fSepType        (NULL),
    fRegType        (NULL),
    fMinSize        (0),
@@ -156,6 +159,7 @@ TMVA::DecisionTree::DecisionTree( TMVA::SeparationBase *sepType, Float_t minSize
    fUseFisherCuts  (kFALSE),
    fMinLinCorrForFisher (1),
    fUseExclusiveVars (kTRUE),
+   fUseHistogramSplits (kFALSE),
    fSepType        (sepType),
    fRegType        (NULL),
    fMinSize        (0),
@@ -204,6 +208,7 @@ TMVA::DecisionTree::DecisionTree( const DecisionTree &d ):
    fUseFisherCuts  (d.fUseFisherCuts),
    fMinLinCorrForFisher (d.fMinLinCorrForFisher),
    fUseExclusiveVars (d.fUseExclusiveVars),
+   fUseHistogramSplits (d.fUseHistogramSplits),
    fSepType    (d.fSepType),
    fRegType    (d.fRegType),
    fMinSize    (d.fMinSize),
@@ -377,6 +382,8 @@ struct BuildNodeInfo{
 UInt_t TMVA::DecisionTree::BuildTree( const std::vector<const TMVA::Event*> & eventSample,
                                       TMVA::DecisionTreeNode *node)
 {
+   if (node==NULL && fUseHistogramSplits && fNCuts > 0 && !fUseFisherCuts) return this->BuildTreeFromHistograms(eventSample);
+
    if (node==NULL) {
       //start with the root node
       node = new TMVA::DecisionTreeNode();
@@ -634,6 +641,8 @@ UInt_t TMVA::DecisionTree::BuildTree( const std::vector<const TMVA::Event*> & ev
 UInt_t TMVA::DecisionTree::BuildTree( const std::vector<const TMVA::Event*> & eventSample,
                                       TMVA::DecisionTreeNode *node)
 {
+   if (node==NULL && fUseHistogramSplits && fNCuts > 0 && !fUseFisherCuts) return this->BuildTreeFromHistograms(eventSample);
+
    if (node==NULL) {
       //start with the root node
       node = new TMVA::DecisionTreeNode();
@@ -873,6 +882,453 @@ UInt_t TMVA::DecisionTree::BuildTree( const std::vector<const TMVA::Event*> & ev
 
 #endif
 
+namespace {
+   // the statistics filled per bin into the histograms of DecisionTree::BuildTreeFromHistograms
+   enum EHistogramStat { kSigWeight, kBkgWeight, kSigCount, kBkgCount, kTargetSum, kTarget2Sum, kNHistogramStats };
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// the training events with their variables binned once per tree. The bin
+/// indices are stored variable after variable (column-major), such that the
+/// histogram of one variable is filled from contiguous memory, and the weights,
+/// classes and targets are copied out of the events for the same reason.
+
+struct TMVA::DecisionTree::BinnedSample {
+   const EventConstList  *events = nullptr;
+   UInt_t                 nEvents = 0;
+   std::vector<UShort_t>  bins;       // bin of event iev in variable ivar, at [ivar*nEvents+iev]
+   std::vector<UInt_t>    nBins;      // number of bins of each variable
+   std::vector<UInt_t>    offset;     // first bin of each variable in the histograms
+   std::vector<Double_t>  xmin;       // lower edge of the grid of each variable
+   std::vector<Double_t>  binWidth;   // bin width of the grid of each variable
+   std::vector<Double_t>  weight;
+   std::vector<Char_t>    isSignal;
+   std::vector<Double_t>  target;
+   UInt_t                 nTotalBins = 0;
+};
+
+////////////////////////////////////////////////////////////////////////////////
+/// sums of the weights of the signal and background events in a node and,
+/// for regression, of the targets
+
+struct TMVA::DecisionTree::NodeSums {
+   Double_t s = 0, b = 0;        // weighted
+   Double_t suw = 0, buw = 0;    // unweighted
+   Double_t sub = 0, bub = 0;    // unboosted
+   Double_t target = 0, target2 = 0;
+
+   void Add( const BinnedSample & sample, UInt_t iev )
+   {
+      const Double_t weight = sample.weight[iev];
+      const Double_t orgWeight = (*sample.events)[iev]->GetOriginalWeight();
+      if (sample.isSignal[iev]) { s += weight; suw += 1; sub += orgWeight; }
+      else                      { b += weight; buw += 1; bub += orgWeight; }
+      if (!sample.target.empty()) {
+         target  += weight*sample.target[iev];
+         target2 += weight*sample.target[iev]*sample.target[iev];
+      }
+   }
+};
+
+////////////////////////////////////////////////////////////////////////////////
+/// building the decision tree from histograms of the variables, binned once
+/// for all the nodes of the tree (returns the number of nodes)
+///
+/// The variables are binned on the grid that TrainNodeFast uses for the root
+/// node, i.e. nCuts+1 bins over the range of the training sample (one bin per
+/// value for integer variables with fewer values than that), and the bin
+/// indices are kept in a column-major
+/// matrix. The histograms of a node are then filled from the bin indices of its
+/// events in parallel, either by variable or by chunks of events that are merged
+/// afterwards, and the best cut of each variable is searched for in parallel.
+/// Of the two daughters of a node, only the smaller one is filled from its
+/// events: the histograms of the other one are the difference of those of the
+/// mother and of the smaller daughter. Unlike in TrainNodeFast, the grid is not
+/// refined in the daughter nodes, so that the cuts are restricted to the grid
+/// of the root node and a larger nCuts is appropriate. Fisher cuts are not
+/// supported.
+
+UInt_t TMVA::DecisionTree::BuildTreeFromHistograms( const EventConstList & eventSample )
+{
+   //start with the root node
+   TMVA::DecisionTreeNode *node = new TMVA::DecisionTreeNode();
+   fNNodes = 1;
+   this->SetRoot(node);
+   // have to use "s" for start as "r" for "root" would be the same as "r" for "right"
+   this->GetRoot()->SetPos('s');
+   this->GetRoot()->SetDepth(0);
+   this->GetRoot()->SetParentTree(this);
+   fMinSize = fMinNodeSize/100. * eventSample.size();
+
+   const UInt_t nevents = eventSample.size();
+   if (nevents == 0) Log() << kFATAL << ":<BuildTreeFromHistograms> eventsample Size == 0 " << Endl;
+   if (fNCuts <= 0 || fNCuts >= std::numeric_limits<UShort_t>::max()) {
+      Log() << kFATAL << "<BuildTreeFromHistograms> the number of cuts has to be between 1 and "
+            << std::numeric_limits<UShort_t>::max()-1 << ", not " << fNCuts << Endl;
+   }
+   if (fNvars==0) fNvars = eventSample[0]->GetNVariables(); // should have been set before, but ... well..
+   fVariableImportance.resize(fNvars);
+
+   BinnedSample sample;
+   sample.events = &eventSample;
+   sample.nEvents = nevents;
+   sample.weight.resize(nevents);
+   sample.isSignal.resize(nevents);
+   if (DoRegression()) sample.target.resize(nevents);
+   for (UInt_t iev=0; iev<nevents; iev++) {
+      sample.weight[iev] = eventSample[iev]->GetWeight();
+      sample.isSignal[iev] = eventSample[iev]->GetClass() == fSigClass;
+      if (DoRegression()) sample.target[iev] = eventSample[iev]->GetTarget(0);
+   }
+
+   // bin the variables in parallel
+   sample.bins.resize(size_t(fNvars)*nevents);
+   sample.nBins.resize(fNvars);
+   sample.xmin.resize(fNvars);
+   sample.binWidth.resize(fNvars);
+   auto fvarBin = [this, &sample, &eventSample, nevents](UInt_t ivar = 0){
+      Float_t xmin = eventSample[0]->GetValueFast(ivar);
+      Float_t xmax = xmin;
+      for (UInt_t iev=1; iev<nevents; iev++) {
+         const Float_t val = eventSample[iev]->GetValueFast(ivar);
+         if (val < xmin) xmin = val;
+         if (val > xmax) xmax = val;
+      }
+      UInt_t nBins = fNCuts+1;
+      Double_t binWidth = (Double_t(xmax) - xmin) / nBins;
+      if (fDataSetInfo->GetVariableInfo(ivar).GetVarType() == 'I' && xmax - xmin < fNCuts) {
+         nBins = xmax - xmin + 1;
+         binWidth = 1;
+      }
+      UShort_t *bins = &sample.bins[size_t(ivar)*nevents];
+      if (almost_equal_float(xmax, xmin)) {
+         // no cut on this variable could split the sample
+         nBins = 1;
+         binWidth = 1;
+         std::fill(bins, bins+nevents, 0);
+      }
+      else {
+         const Double_t invBinWidth = 1./binWidth;
+         for (UInt_t iev=0; iev<nevents; iev++) {
+            // "maximum" is nbins-1 (the "-1" because we start counting from 0 !!
+            bins[iev] = TMath::Min(Int_t(nBins-1),TMath::Max(0,int (invBinWidth*(eventSample[iev]->GetValueFast(ivar)-xmin) ) ));
+         }
+      }
+      sample.nBins[ivar] = nBins;
+      sample.xmin[ivar] = xmin;
+      sample.binWidth[ivar] = binWidth;
+      this->GetRoot()->SetSampleMin(ivar, xmin);
+      this->GetRoot()->SetSampleMax(ivar, xmax);
+      return 0;
+   };
+   // size the per-node training information before the variables are binned concurrently
+   this->GetRoot()->SetSampleMin(fNvars-1, 0);
+   this->GetRoot()->SetSampleMax(fNvars-1, 0);
+   TMVA::Config::Instance().GetThreadExecutor().Map(fvarBin, ROOT::TSeqU(fNvars));
+
+   sample.offset.resize(fNvars);
+   for (UInt_t ivar=0; ivar<fNvars; ivar++) {
+      sample.offset[ivar] = sample.nTotalBins;
+      sample.nTotalBins += sample.nBins[ivar];
+   }
+
+   NodeSums sums;
+   std::vector<UInt_t> events(nevents);
+   for (UInt_t iev=0; iev<nevents; iev++) {
+      events[iev] = iev;
+      sums.Add(sample, iev);
+   }
+   node->SetNEvents(sums.s+sums.b);
+   node->SetNEvents_unweighted(sums.suw+sums.buw);
+   node->SetNEvents_unboosted(sums.sub+sums.bub);
+
+   std::vector<Double_t> histogram;
+   this->BuildNodeFromHistograms(sample, events, sums, histogram, node);
+
+   return fNNodes;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// fill the histograms of all variables with the given events of the binned
+/// sample. The histograms of the different variables are filled in parallel,
+/// unless there are fewer variables than threads and enough events to fill
+/// one set of histograms per chunk of events and merge them.
+
+void TMVA::DecisionTree::FillHistograms( const BinnedSample & sample, const std::vector<UInt_t> & events,
+                                         std::vector<Double_t> & histogram ) const
+{
+   const Bool_t doRegression = DoRegression();
+   const size_t nHist = size_t(sample.nTotalBins)*kNHistogramStats;
+   const UInt_t nevents = events.size();
+
+   // fill the bins of variable ivar with the events [begin, end) of the list
+   auto fillVariable = [&sample, &events, doRegression](Double_t *hist, UInt_t ivar, UInt_t begin, UInt_t end){
+      const UShort_t *bins = &sample.bins[size_t(ivar)*sample.nEvents];
+      Double_t *histVar = hist + size_t(sample.offset[ivar])*kNHistogramStats;
+      for (UInt_t i=begin; i<end; i++) {
+         const UInt_t iev = events[i];
+         const Double_t weight = sample.weight[iev];
+         Double_t *bin = histVar + size_t(bins[iev])*kNHistogramStats;
+         if (sample.isSignal[iev]) {
+            bin[kSigWeight] += weight;
+            bin[kSigCount]++;
+         }
+         else {
+            bin[kBkgWeight] += weight;
+            bin[kBkgCount]++;
+         }
+         if (doRegression) {
+            bin[kTargetSum]  += weight*sample.target[iev];
+            bin[kTarget2Sum] += weight*sample.target[iev]*sample.target[iev];
+         }
+      }
+   };
+
+   UInt_t nPartitions = TMVA::Config::Instance().GetThreadExecutor().GetPoolSize();
+   if (fNvars >= nPartitions || nevents < 2*nPartitions*sample.nTotalBins) {
+      histogram.assign(nHist, 0);
+      auto fvarFill = [&fillVariable, &histogram, nevents](UInt_t ivar = 0){
+         fillVariable(histogram.data(), ivar, 0, nevents);
+         return 0;
+      };
+      TMVA::Config::Instance().GetThreadExecutor().Map(fvarFill, ROOT::TSeqU(fNvars));
+   }
+   else {
+      auto f = [this, &fillVariable, nHist, nevents, nPartitions](UInt_t partition = 0){
+         UInt_t start = 1.0*partition/nPartitions*nevents;
+         UInt_t end   = (partition+1.0)/nPartitions*nevents;
+         std::vector<Double_t> hist(nHist, 0);
+         for (UInt_t ivar=0; ivar<fNvars; ivar++) fillVariable(hist.data(), ivar, start, end);
+         return hist;
+      };
+      auto redfunc = [nHist](const std::vector<std::vector<Double_t>> & v){
+         std::vector<Double_t> hist(nHist, 0);
+         for (const auto & h : v) {
+            for (size_t i=0; i<nHist; i++) hist[i] += h[i];
+         }
+         return hist;
+      };
+      histogram = TMVA::Config::Instance().GetThreadExecutor().MapReduce(f, ROOT::TSeqU(nPartitions), redfunc);
+   }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// decide how to split a node from the histograms of its events: for each
+/// variable the cuts between the bins are scanned (the variables in parallel)
+/// and the cut with the best separation gain is applied to the node, as in
+/// TrainNodeFast (returns the separation gain, 0 if no cut was found)
+
+Double_t TMVA::DecisionTree::TrainNodeFromHistograms( const BinnedSample & sample, const NodeSums & sums,
+                                                      const std::vector<Double_t> & histogram,
+                                                      TMVA::DecisionTreeNode *node )
+{
+   std::vector<UInt_t> mapVariable(fNvars+1);
+   std::unique_ptr<Bool_t[]> useVariable(new Bool_t[fNvars+1]);
+   if (fRandomisedTree) { // choose for each node splitting a random subset of variables to choose from
+      UInt_t tmp=fUseNvars;
+      GetRandomisedVariables(useVariable.get(),mapVariable.data(),tmp);
+   }
+   else {
+      for (UInt_t ivar=0; ivar < fNvars; ivar++) useVariable[ivar] = kTRUE;
+   }
+
+   const Bool_t doRegression = DoRegression();
+   const Double_t nTot = sums.s + sums.b;
+
+   // the events in the bins up to iBin form one daughter node, the remaining ones the other
+   auto fvarMaxSep = [this, &sample, &sums, &histogram, &useVariable, doRegression, nTot](UInt_t ivar = 0){
+      std::pair<Double_t, Int_t> best(-1, -1);
+      if (!useVariable[ivar]) return best;
+      const Double_t *histVar = &histogram[size_t(sample.offset[ivar])*kNHistogramStats];
+      Double_t slW = 0, blW = 0, sl = 0, bl = 0, targetLeft = 0, target2Left = 0;
+      for (UInt_t iBin=0; iBin+1<sample.nBins[ivar]; iBin++) { // the last bin contains "all events" -->skip
+         const Double_t *bin = histVar + size_t(iBin)*kNHistogramStats;
+         slW += bin[kSigWeight];
+         blW += bin[kBkgWeight];
+         sl  += bin[kSigCount];
+         bl  += bin[kBkgCount];
+         if (doRegression) {
+            targetLeft  += bin[kTargetSum];
+            target2Left += bin[kTarget2Sum];
+         }
+         const Double_t sr  = sums.suw - sl;
+         const Double_t br  = sums.buw - bl;
+         const Double_t srW = sums.s - slW;
+         const Double_t brW = sums.b - blW;
+         // only allow splits where both daughter nodes match the specified minimum number,
+         // in terms of actual entries and of weighted events
+         if ( (sl+bl) > 0 && (sr+br) > 0
+              && ((sl+bl)>=fMinSize && (sr+br)>=fMinSize)
+              && ((slW+blW)>=fMinSize && (srW+brW)>=fMinSize) ) {
+            Double_t sepTmp;
+            if (doRegression) {
+               sepTmp = fRegType->GetSeparationGain(slW+blW, targetLeft, target2Left, nTot, sums.target, sums.target2);
+            } else {
+               sepTmp = fSepType->GetSeparationGain(slW, blW, sums.s, sums.b);
+            }
+            if (best.first < sepTmp) {
+               best.first  = sepTmp;
+               best.second = iBin;
+            }
+         }
+      }
+      return best;
+   };
+   auto separationGain = TMVA::Config::Instance().GetThreadExecutor().Map(fvarMaxSep, ROOT::TSeqU(fNvars));
+
+   // you found the best separation cut for each variable, now compare the variables
+   Double_t separationGainTotal = -1;
+   Int_t    mxVar = -1;
+   for (UInt_t ivar=0; ivar < fNvars; ivar++) {
+      if (separationGain[ivar].second >= 0 && separationGainTotal < separationGain[ivar].first) {
+         separationGainTotal = separationGain[ivar].first;
+         mxVar = ivar;
+      }
+   }
+   if (mxVar < 0) return 0;
+
+   const Int_t cutIndex = separationGain[mxVar].second;
+   Bool_t cutType = kTRUE;
+   if (doRegression) {
+      node->SetSeparationIndex(fRegType->GetSeparationIndex(nTot,sums.target,sums.target2));
+      node->SetResponse(sums.target/nTot);
+      if ( almost_equal_double(sums.target2/nTot, sums.target/nTot*sums.target/nTot) ) {
+         node->SetRMS(0);
+      }else{
+         node->SetRMS(TMath::Sqrt(sums.target2/nTot - sums.target/nTot*sums.target/nTot));
+      }
+   }
+   else {
+      node->SetSeparationIndex(fSepType->GetSeparationIndex(sums.s,sums.b));
+      const Double_t *histVar = &histogram[size_t(sample.offset[mxVar])*kNHistogramStats];
+      Double_t nSelS = 0, nSelB = 0;
+      for (Int_t iBin=0; iBin<=cutIndex; iBin++) {
+         nSelS += histVar[size_t(iBin)*kNHistogramStats + kSigWeight];
+         nSelB += histVar[size_t(iBin)*kNHistogramStats + kBkgWeight];
+      }
+      if (nSelS/sums.s > nSelB/sums.b) cutType=kTRUE;
+      else cutType=kFALSE;
+   }
+   node->SetSelector((UInt_t)mxVar);
+   node->SetCutValue(sample.xmin[mxVar]+(Double_t(cutIndex+1))*sample.binWidth[mxVar]);
+   node->SetCutType(cutType);
+   node->SetSeparationGain(separationGainTotal);
+   node->SetNFisherCoeff(0);
+   fVariableImportance[mxVar] += separationGainTotal*separationGainTotal * nTot * nTot;
+
+   return separationGainTotal;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// split a node of the tree built by BuildTreeFromHistograms and recursively
+/// its daughters. The histograms of the node are filled from its events if
+/// they are not given; the events and histograms are released before
+/// descending to the daughters.
+
+void TMVA::DecisionTree::BuildNodeFromHistograms( const BinnedSample & sample, std::vector<UInt_t> & events,
+                                                  const NodeSums & sums, std::vector<Double_t> & histogram,
+                                                  TMVA::DecisionTreeNode *node )
+{
+   node->SetNSigEvents(sums.s);
+   node->SetNBkgEvents(sums.b);
+   node->SetNSigEvents_unweighted(sums.suw);
+   node->SetNBkgEvents_unweighted(sums.buw);
+   node->SetNSigEvents_unboosted(sums.sub);
+   node->SetNBkgEvents_unboosted(sums.bub);
+   node->SetPurity();
+
+   // I demand the minimum number of events for both daughter nodes, see BuildTree
+   auto isSplittable = [this](const NodeSums & n, UInt_t nEvents, UInt_t depth){
+      return (nEvents >= 2*fMinSize && n.s+n.b >= 2*fMinSize) && depth < fMaxDepth
+         && ( ( n.s!=0 && n.b !=0 && !DoRegression()) || ( (n.s+n.b)!=0 && DoRegression()) );
+   };
+
+   Double_t separationGain = 0;
+   if (isSplittable(sums, events.size(), node->GetDepth())) {
+      if (histogram.empty()) FillHistograms(sample, events, histogram);
+      separationGain = this->TrainNodeFromHistograms(sample, sums, histogram, node);
+   }
+
+   if (separationGain < std::numeric_limits<double>::epsilon()) { // it is a leaf node
+      const Double_t nTot = sums.s + sums.b;
+      if (DoRegression()) {
+         node->SetSeparationIndex(fRegType->GetSeparationIndex(nTot,sums.target,sums.target2));
+         node->SetResponse(sums.target/nTot);
+         if ( almost_equal_double(sums.target2/nTot, sums.target/nTot*sums.target/nTot) ) {
+            node->SetRMS(0);
+         }else{
+            node->SetRMS(TMath::Sqrt(sums.target2/nTot - sums.target/nTot*sums.target/nTot));
+         }
+      }
+      else {
+         node->SetSeparationIndex(fSepType->GetSeparationIndex(sums.s,sums.b));
+         if   (node->GetPurity() > fNodePurityLimit) node->SetNodeType(1);
+         else node->SetNodeType(-1);
+      }
+      if (node->GetDepth() > this->GetTotalTreeDepth()) this->SetTotalTreeDepth(node->GetDepth());
+      return;
+   }
+
+   std::vector<UInt_t> leftEvents;  leftEvents.reserve(events.size());
+   std::vector<UInt_t> rightEvents; rightEvents.reserve(events.size());
+   NodeSums leftSums, rightSums;
+   for (UInt_t iev : events) {
+      if (node->GoesRight(*(*sample.events)[iev])) {
+         rightEvents.push_back(iev);
+         rightSums.Add(sample, iev);
+      }
+      else {
+         leftEvents.push_back(iev);
+         leftSums.Add(sample, iev);
+      }
+   }
+   // sanity check
+   if (leftEvents.empty() || rightEvents.empty()) {
+      Log() << kERROR << "<TrainNode> all events went to the same branch" << Endl
+            << "---                       Hence new node == old node ... check" << Endl
+            << "---                         left:" << leftEvents.size()
+            << " right:" << rightEvents.size() << Endl
+            << " while the separation is thought to be " << separationGain
+            << "\n when cutting on variable " << node->GetSelector()
+            << " at value " << node->GetCutValue()
+            << kFATAL << "--- this should never happen, please write a bug report to Helge.Voss@cern.ch" << Endl;
+   }
+   std::vector<UInt_t>().swap(events);
+
+   TMVA::DecisionTreeNode *rightNode = new TMVA::DecisionTreeNode(node,'r');
+   fNNodes++;
+   rightNode->SetNEvents(rightSums.s+rightSums.b);
+   rightNode->SetNEvents_unboosted(rightSums.sub+rightSums.bub);
+   rightNode->SetNEvents_unweighted(rightEvents.size());
+
+   TMVA::DecisionTreeNode *leftNode = new TMVA::DecisionTreeNode(node,'l');
+   fNNodes++;
+   leftNode->SetNEvents(leftSums.s+leftSums.b);
+   leftNode->SetNEvents_unboosted(leftSums.sub+leftSums.bub);
+   leftNode->SetNEvents_unweighted(leftEvents.size());
+
+   node->SetNodeType(0);
+   node->SetLeft(leftNode);
+   node->SetRight(rightNode);
+
+   // if both daughters are split further, only the smaller one is filled from its
+   // events and the histograms of the other one are obtained by subtraction
+   std::vector<Double_t> rightHistogram, leftHistogram;
+   if (isSplittable(rightSums, rightEvents.size(), rightNode->GetDepth()) &&
+       isSplittable(leftSums, leftEvents.size(), leftNode->GetDepth())) {
+      const Bool_t rightIsSmaller = rightEvents.size() < leftEvents.size();
+      std::vector<Double_t> & smaller = rightIsSmaller ? rightHistogram : leftHistogram;
+      std::vector<Double_t> & larger  = rightIsSmaller ? leftHistogram : rightHistogram;
+      FillHistograms(sample, rightIsSmaller ? rightEvents : leftEvents, smaller);
+      larger.swap(histogram);
+      for (size_t i=0; i<larger.size(); i++) larger[i] -= smaller[i];
+   }
+   std::vector<Double_t>().swap(histogram);
+
+   this->BuildNodeFromHistograms(sample, rightEvents, rightSums, rightHistogram, rightNode);
+   this->BuildNodeFromHistograms(sample, leftEvents, leftSums, leftHistogram, leftNode);
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// fill the existing the decision tree structure by filling event
 /// in from the top node and see where they happen to end up
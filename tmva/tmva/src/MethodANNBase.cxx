@@ -700,6 +700,63 @@ const std::vector<Float_t> &TMVA::MethodANNBase::GetMulticlassValues()
 }
 
 
+////////////////////////////////////////////////////////////////////////////////
+/// calculate the activation values of the output layer for the event without
+/// modifying the neurons, so that several threads can evaluate the network at a time
+
+void TMVA::MethodANNBase::EvaluateNetworkOutputs( const Event* ev, std::vector<Double_t>& outputs ) const
+{
+   std::vector<Double_t> preActivations;
+   Int_t numLayers = fNetwork->GetEntriesFast();
+
+   for (Int_t i = 0; i < numLayers; i++) {
+      TObjArray* curLayer = (TObjArray*)fNetwork->At(i);
+      Int_t numNeurons = curLayer->GetEntriesFast();
+      outputs.resize(numNeurons);
+
+      for (Int_t j = 0; j < numNeurons; j++) {
+         // the input neurons take the event values, with the identity activation
+         if (i == 0 && j < (Int_t)GetNvar())
+            outputs[j] = ev->GetValue(j);
+         else
+            outputs[j] = ((TNeuron*)curLayer->At(j))->EvaluateActivationValue( preActivations.data() );
+      }
+      preActivations.swap(outputs);
+   }
+   outputs.swap(preActivations);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// get the mva value generated by the NN for the transformed event, see GetMvaValueConcurrent
+
+Double_t TMVA::MethodANNBase::EvaluateMvaConcurrent( const Event* const ev ) const
+{
+   std::vector<Double_t> outputs;
+   EvaluateNetworkOutputs( ev, outputs );
+   return outputs.at(0);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// get the multiclass classification values generated by the NN for the transformed event,
+/// see GetMulticlassValuesConcurrent
+
+void TMVA::MethodANNBase::EvaluateMulticlassConcurrent( const Event* const ev, std::vector<Float_t>& values ) const
+{
+   std::vector<Double_t> temp;
+   EvaluateNetworkOutputs( ev, temp );
+
+   values.clear();
+   UInt_t nClasses = DataInfo().GetNClasses();
+   for(UInt_t iClass=0; iClass<nClasses; iClass++){
+      Double_t norm = 0.0;
+      for(UInt_t j=0;j<nClasses;j++){
+         if(iClass!=j)
+            norm+=exp(temp[j]-temp[iClass]);
+      }
+      values.push_back(1.0/(1.0+norm));
+   }
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// create XML description of ANN classifier
 
@@ -145,6 +145,7 @@ the selection.
 #include <iomanip>
 #include <algorithm>
 #include <cmath>
+#include <limits>
 #include <numeric>
 #include <unordered_map>
 
@@ -178,6 +179,7 @@ TMVA::MethodBDT::MethodBDT( const TString& jobName,
    , fMinNodeSize(5)
    , fMinNodeSizeS("5%")
    , fNCuts(0)
+   , fHistogramSplits(kFALSE)
    , fUseFisherCuts(0)        // don't use this initialisation, only here to make  Coverity happy. Is set in DeclarOptions()
    , fMinLinCorrForFisher(.8) // don't use this initialisation, only here to make  Coverity happy. Is set in DeclarOptions()
    , fUseExclusiveVars(0)     // don't use this initialisation, only here to make  Coverity happy. Is set in DeclarOptions()
@@ -233,6 +235,7 @@ TMVA::MethodBDT::MethodBDT( DataSetInfo& theData,
    , fMinNodeSize(5)
    , fMinNodeSizeS("5%")
    , fNCuts(0)
+   , fHistogramSplits(kFALSE)
    , fUseFisherCuts(0)        // don't use this initialisation, only here to make  Coverity happy. Is set in DeclarOptions()
    , fMinLinCorrForFisher(.8) // don't use this initialisation, only here to make  Coverity happy. Is set in DeclarOptions()
    , fUseExclusiveVars(0)     // don't use this initialisation, only here to make  Coverity happy. Is set in DeclarOptions()
@@ -343,6 +346,7 @@ void TMVA::MethodBDT::DeclareOptions()
    DeclareOptionRef(fMinNodeSizeS=tmp, "MinNodeSize", "Minimum percentage of training events required in a leaf node (default: Classification: 5%, Regression: 0.2%)");
    // MinNodeSize:     minimum percentage of training events in a leaf node (leaf criteria, stop splitting)
    DeclareOptionRef(fNCuts, "nCuts", "Number of grid points in variable range used in finding optimal cut in node splitting");
+   DeclareOptionRef(fHistogramSplits=kFALSE, "HistogramSplits", "Bin the variables once per tree on the grid of nCuts and find the node splits from histograms, filled in parallel and obtained by subtraction for one of two daughter nodes (the grid is not refined in the daughter nodes, use a larger nCuts)");
 
    DeclareOptionRef(fBoostType, "BoostType", "Boosting type for the trees in the forest (note: AdaCost is still experimental)");
 
@@ -598,6 +602,22 @@ void TMVA::MethodBDT::ProcessOptions()
       //      fBoostType   = "Bagging";
    }
 
+   if (fHistogramSplits) {
+      if (fUseFisherCuts) {
+         Log() << kWARNING << "The option HistogramSplits is not available together with UseFisherCuts, I will ignore it!" << Endl;
+         fHistogramSplits = kFALSE;
+      }
+      else if (fNCuts < 0) {
+         Log() << kWARNING << "The option HistogramSplits needs a grid of cuts (nCuts>0), I will ignore it!" << Endl;
+         fHistogramSplits = kFALSE;
+      }
+      else if (fNCuts >= std::numeric_limits<UShort_t>::max()) {
+         Log() << kWARNING << "With the option HistogramSplits nCuts can be at most " << std::numeric_limits<UShort_t>::max()-1
+               << ", I set it to this value" << Endl;
+         fNCuts = std::numeric_limits<UShort_t>::max()-1;
+      }
+   }
+
    if (fUseFisherCuts) {
       Log() << kWARNING << "When using the option UseFisherCuts, the other option nCuts<0 (i.e. using" << Endl;
       Log() << " a more elaborate node splitting algorithm) is not implemented. " << Endl;
@@ -1302,6 +1322,7 @@ void TMVA::MethodBDT::Train()
                fForest.back()->SetMinLinCorrForFisher(fMinLinCorrForFisher);
                fForest.back()->SetUseExclusiveVars(fUseExclusiveVars);
             }
+            if (fHistogramSplits) fForest.back()->SetUseHistogramSplits();
             // the minimum linear correlation between two variables demanded for use in fisher criterion in node splitting
 
             nNodesBeforePruning = fForest.back()->BuildTree(*fTrainSample);
@@ -1329,6 +1350,7 @@ void TMVA::MethodBDT::Train()
             fForest.back()->SetMinLinCorrForFisher(fMinLinCorrForFisher);
             fForest.back()->SetUseExclusiveVars(fUseExclusiveVars);
          }
+         if (fHistogramSplits) fForest.back()->SetUseHistogramSplits();
 
          nNodesBeforePruning = fForest.back()->BuildTree(*fTrainSample);
 
@@ -1418,7 +1440,7 @@ void TMVA::MethodBDT::Train()
 ////////////////////////////////////////////////////////////////////////////////
 /// Returns MVA value: -1 for background, 1 for signal.
 
-Double_t TMVA::MethodBDT::GetGradBoostMVA(const TMVA::Event* e, UInt_t nTrees)
+Double_t TMVA::MethodBDT::GetGradBoostMVA(const TMVA::Event* e, UInt_t nTrees) const
 {
    Double_t sum=0;
    for (UInt_t itree=0; itree<nTrees; itree++) {
@@ -2476,6 +2498,14 @@ Double_t TMVA::MethodBDT::PrivateGetMvaValue(const TMVA::Event* ev, Double_t* er
 
    if (useNTrees > 0 ) nTrees = useNTrees;
 
+   return GetForestMvaValue(ev, nTrees);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return the MVA value of the first nTrees trees of the forest.
+
+Double_t TMVA::MethodBDT::GetForestMvaValue(const TMVA::Event* ev, UInt_t nTrees ) const
+{
    if (fBoostType=="Grad") return GetGradBoostMVA(ev,nTrees);
 
    Double_t myMVA = 0;
@@ -2488,6 +2518,19 @@ Double_t TMVA::MethodBDT::PrivateGetMvaValue(const TMVA::Event* ev, Double_t* er
    return ( norm > std::numeric_limits<double>::epsilon() ) ? myMVA /= norm : 0 ;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Return the MVA value of the transformed event without modifying the method, as
+/// GetMvaValue with all trees; it can be called by several threads at a time.
+
+Double_t TMVA::MethodBDT::EvaluateMvaConcurrent( const TMVA::Event* const ev ) const
+{
+   if (fDoPreselection) {
+      Double_t val = ApplyPreselectionCuts(ev);
+      if (TMath::Abs(val)>0.05) return val;
+   }
+   return GetForestMvaValue(ev, fForest.size());
+}
+
 
 ////////////////////////////////////////////////////////////////////////////////
 /// Get the multiclass MVA response for the BDT classifier.
@@ -2522,18 +2565,43 @@ const std::vector<Float_t>& TMVA::MethodBDT::GetMulticlassValues()
    }
    #endif
 
+   GetMulticlassProbabilities(temp, *fMulticlassReturnVal);
+
+   return *fMulticlassReturnVal;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Get the multiclass MVA response of the transformed event without modifying the method;
+/// it can be called by several threads at a time, so the classes are summed sequentially.
+
+void TMVA::MethodBDT::EvaluateMulticlassConcurrent( const TMVA::Event* const e, std::vector<Float_t>& values ) const
+{
+   UInt_t nClasses = DataInfo().GetNClasses();
+   std::vector<Double_t> temp(nClasses);
+   UInt_t classOfTree = 0;
+   for (UInt_t itree = 0; itree < fForest.size(); ++itree) {
+      temp[classOfTree] += fForest[itree]->CheckEvent(e, kFALSE);
+      if (++classOfTree == nClasses) classOfTree = 0; // cheap modulo
+   }
+   values.clear();
+   GetMulticlassProbabilities(temp, values);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Convert the sums of the trees of each class into the class probabilities.
+
+void TMVA::MethodBDT::GetMulticlassProbabilities( std::vector<Double_t>& temp, std::vector<Float_t>& values ) const
+{
    // we want to calculate sum of exp(temp[j] - temp[i]) for all i,j (i!=j)
    // first calculate exp(), then replace minus with division.
    std::transform(temp.begin(), temp.end(), temp.begin(), [](Double_t d){return exp(d);});
 
    Double_t exp_sum = std::accumulate(temp.begin(), temp.end(), 0.0);
 
-   for (UInt_t i = 0; i < nClasses; i++) {
+   for (UInt_t i = 0; i < temp.size(); i++) {
       Double_t p_cls = temp[i] / exp_sum;
-      (*fMulticlassReturnVal).push_back(p_cls);
+      values.push_back(p_cls);
    }
-
-   return *fMulticlassReturnVal;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -3133,7 +3201,7 @@ void TMVA::MethodBDT::DeterminePreselectionCuts(const std::vector<const TMVA::Ev
 /// Apply the  preselection cuts before even bothering about any
 /// Decision Trees  in the GetMVA .. --> -1 for background +1 for Signal
 
-Double_t TMVA::MethodBDT::ApplyPreselectionCuts(const Event* ev)
+Double_t TMVA::MethodBDT::ApplyPreselectionCuts(const Event* ev) const
 {
    Double_t result=0;
 
@@ -847,6 +847,45 @@ Double_t TMVA::MethodBase::GetMvaValue( const Event* const ev, Double_t* err, Do
    return val;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// signal/background classification response of a method with HasConcurrentEvaluation:
+/// the transformations are applied into events on the stack and the method is not modified,
+/// so that several threads can call it at a time
+
+Double_t TMVA::MethodBase::GetMvaValueConcurrent( const Event* const ev ) const
+{
+   if (!HasConcurrentEvaluation())
+      Log() << kFATAL << "Method " << GetMethodName() << " does not support the concurrent evaluation" << Endl;
+   std::vector<Event> transformed;
+   return EvaluateMvaConcurrent( GetTransformationHandler().Transform( ev, transformed ) );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// multiclass classification response of a method with HasConcurrentEvaluation, see GetMvaValueConcurrent
+
+void TMVA::MethodBase::GetMulticlassValuesConcurrent( const Event* const ev, std::vector<Float_t>& values ) const
+{
+   if (!HasConcurrentEvaluation())
+      Log() << kFATAL << "Method " << GetMethodName() << " does not support the concurrent evaluation" << Endl;
+   std::vector<Event> transformed;
+   EvaluateMulticlassConcurrent( GetTransformationHandler().Transform( ev, transformed ), values );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+Double_t TMVA::MethodBase::EvaluateMvaConcurrent( const Event* const ) const
+{
+   Log() << kFATAL << "Method " << GetMethodName() << " does not support the concurrent classification" << Endl;
+   return 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void TMVA::MethodBase::EvaluateMulticlassConcurrent( const Event* const, std::vector<Float_t>& ) const
+{
+   Log() << kFATAL << "Method " << GetMethodName() << " does not support the concurrent multiclass classification" << Endl;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// uses a pre-set cut on the MVA output (SetSignalReferenceCut and SetSignalReferenceCutOrientation)
 /// for a quick determination if an event would be selected as signal or background
@@ -1434,13 +1473,10 @@ void TMVA::MethodBase::ReadStateFromFile()
          << gTools().Color("lightblue") << tfname << gTools().Color("reset") << Endl;
 
    if (tfname.EndsWith(".xml") ) {
-      void* doc = gTools().xmlengine().ParseFile(tfname,gTools().xmlenginebuffersize()); // the default buffer size in TXMLEngine::ParseFile is 100k. Starting with ROOT 5.29 one can set the buffer size, see: http://savannah.cern.ch/bugs/?78864. This might be necessary for large XML files
-      if (!doc) {
+      void* reader = gTools().xmlengine().OpenReader(tfname,gTools().xmlenginebuffersize()); // the default buffer size in TXMLEngine::OpenReader is 100k, as for TXMLEngine::ParseFile. This might be necessary for large XML files
+      if (!ReadStateFromXMLReader(reader)) {
          Log() << kFATAL << "Error parsing XML file " << tfname << Endl;
       }
-      void* rootnode = gTools().xmlengine().DocGetRootElement(doc); // node "MethodSetup"
-      ReadStateFromXML(rootnode);
-      gTools().xmlengine().FreeDoc(doc);
    }
    else {
       std::filebuf fb;
@@ -1467,19 +1503,68 @@ void TMVA::MethodBase::ReadStateFromFile()
 /// for reading from memory
 
 void TMVA::MethodBase::ReadStateFromXMLString( const char* xmlstr ) {
-   void* doc = gTools().xmlengine().ParseString(xmlstr);
-   void* rootnode = gTools().xmlengine().DocGetRootElement(doc); // node "MethodSetup"
-   ReadStateFromXML(rootnode);
-   gTools().xmlengine().FreeDoc(doc);
+   void* reader = gTools().xmlengine().OpenStringReader(xmlstr);
+   if (!ReadStateFromXMLReader(reader)) {
+      Log() << kFATAL << "Error parsing XML string" << Endl;
+   }
 
    return;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// read the weight file with the streaming XML reader, one section after the other,
+/// such that the complete document is never kept in memory; the reader is closed.
+/// Returns false if the document is not valid
+
+Bool_t TMVA::MethodBase::ReadStateFromXMLReader( void* reader )
+{
+   if (!reader) return kFALSE;
+
+   TXMLEngine& xml = gTools().xmlengine();
+   Int_t event;
+   Bool_t hasSetup = kFALSE;
+   while ((event = xml.ReadNext(reader)) > 0) {
+      if (event != TXMLEngine::kReaderStartNode) continue;
+      if (xml.GetReaderDepth(reader) == 0) {
+         // node "MethodSetup", only its attributes are read now
+         ReadMethodSetupFromXML(xml.GetReaderNode(reader));
+         hasSetup = kTRUE;
+      }
+      else {
+         // in case of error in the section, the next ReadNext stops the reading
+         void* section = xml.ReadSubtree(reader);
+         if (section) ReadSectionFromXML(section);
+      }
+   }
+   xml.CloseReader(reader);
+   if (event < 0 || !hasSetup) return kFALSE;
+
+   // update transformation handler
+   if (GetTransformationHandler().GetCallerName() == "") GetTransformationHandler().SetCallerName( GetName() );
+   return kTRUE;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 
 void TMVA::MethodBase::ReadStateFromXML( void* methodNode )
 {
+   ReadMethodSetupFromXML( methodNode );
+
+   void* ch = gTools().GetChild(methodNode);
+   while (ch!=0) {
+      ReadSectionFromXML( ch );
+      ch = gTools().GetNextChild(ch);
+   }
+
+   // update transformation handler
+   if (GetTransformationHandler().GetCallerName() == "") GetTransformationHandler().SetCallerName( GetName() );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// read the attributes of the top node "MethodSetup" of the weight file
 
+void TMVA::MethodBase::ReadMethodSetupFromXML( void* methodNode )
+{
    TString fullMethodName;
    gTools().ReadAttr( methodNode, "Method", fullMethodName );
 
@@ -1492,96 +1577,93 @@ void TMVA::MethodBase::ReadStateFromXML( void* methodNode )
 
    // after the method name is read, the testvar can be set
    SetTestvarName();
+}
 
-   TString nodeName("");
-   void* ch = gTools().GetChild(methodNode);
-   while (ch!=0) {
-      nodeName = TString( gTools().GetName(ch) );
-
-      if (nodeName=="GeneralInfo") {
-         // read analysis type
-
-         TString name(""),val("");
-         void* antypeNode = gTools().GetChild(ch);
-         while (antypeNode) {
-            gTools().ReadAttr( antypeNode, "name",   name );
-
-            if (name == "TrainingTime")
-               gTools().ReadAttr( antypeNode, "value",  fTrainTime );
-
-            if (name == "AnalysisType") {
-               gTools().ReadAttr( antypeNode, "value",  val );
-               val.ToLower();
-               if      (val == "regression" )     SetAnalysisType( Types::kRegression );
-               else if (val == "classification" ) SetAnalysisType( Types::kClassification );
-               else if (val == "multiclass" )     SetAnalysisType( Types::kMulticlass );
-               else Log() << kFATAL <<Form("Dataset[%s] : ",DataInfo().GetName())<< "Analysis type " << val << " is not known." << Endl;
-            }
-
-            if (name == "TMVA Release" || name == "TMVA") {
-               TString s;
-               gTools().ReadAttr( antypeNode, "value", s);
-               fTMVATrainingVersion = TString(s(s.Index("[")+1,s.Index("]")-s.Index("[")-1)).Atoi();
-               Log() << kDEBUG <<Form("[%s] : ",DataInfo().GetName()) << "MVA method was trained with TMVA Version: " << GetTrainingTMVAVersionString() << Endl;
-            }
-
-            if (name == "ROOT Release" || name == "ROOT") {
-               TString s;
-               gTools().ReadAttr( antypeNode, "value", s);
-               fROOTTrainingVersion = TString(s(s.Index("[")+1,s.Index("]")-s.Index("[")-1)).Atoi();
-               Log() << kDEBUG //<<Form("Dataset[%s] : ",DataInfo().GetName())
-           << "MVA method was trained with ROOT Version: " << GetTrainingROOTVersionString() << Endl;
-            }
-            antypeNode = gTools().GetNextChild(antypeNode);
+////////////////////////////////////////////////////////////////////////////////
+/// read one section of the weight file, i.e. one child of the node "MethodSetup"
+
+void TMVA::MethodBase::ReadSectionFromXML( void* ch )
+{
+   TString nodeName( gTools().GetName(ch) );
+
+   if (nodeName=="GeneralInfo") {
+      // read analysis type
+
+      TString name(""),val("");
+      void* antypeNode = gTools().GetChild(ch);
+      while (antypeNode) {
+         gTools().ReadAttr( antypeNode, "name",   name );
+
+         if (name == "TrainingTime")
+            gTools().ReadAttr( antypeNode, "value",  fTrainTime );
+
+         if (name == "AnalysisType") {
+            gTools().ReadAttr( antypeNode, "value",  val );
+            val.ToLower();
+            if      (val == "regression" )     SetAnalysisType( Types::kRegression );
+            else if (val == "classification" ) SetAnalysisType( Types::kClassification );
+            else if (val == "multiclass" )     SetAnalysisType( Types::kMulticlass );
+            else Log() << kFATAL <<Form("Dataset[%s] : ",DataInfo().GetName())<< "Analysis type " << val << " is not known." << Endl;
          }
-      }
-      else if (nodeName=="Options") {
-         ReadOptionsFromXML(ch);
-         ParseOptions();
 
-      }
-      else if (nodeName=="Variables") {
-         ReadVariablesFromXML(ch);
-      }
-      else if (nodeName=="Spectators") {
-         ReadSpectatorsFromXML(ch);
-      }
-      else if (nodeName=="Classes") {
-         if (DataInfo().GetNClasses()==0) ReadClassesFromXML(ch);
-      }
-      else if (nodeName=="Targets") {
-         if (DataInfo().GetNTargets()==0 && DoRegression()) ReadTargetsFromXML(ch);
-      }
-      else if (nodeName=="Transformations") {
-         GetTransformationHandler().ReadFromXML(ch);
-      }
-      else if (nodeName=="MVAPdfs") {
-         TString pdfname;
-         if (fMVAPdfS) { delete fMVAPdfS; fMVAPdfS=0; }
-         if (fMVAPdfB) { delete fMVAPdfB; fMVAPdfB=0; }
-         void* pdfnode = gTools().GetChild(ch);
-         if (pdfnode) {
-            gTools().ReadAttr(pdfnode, "Name", pdfname);
-            fMVAPdfS = new PDF(pdfname);
-            fMVAPdfS->ReadXML(pdfnode);
-            pdfnode = gTools().GetNextChild(pdfnode);
-            gTools().ReadAttr(pdfnode, "Name", pdfname);
-            fMVAPdfB = new PDF(pdfname);
-            fMVAPdfB->ReadXML(pdfnode);
+         if (name == "TMVA Release" || name == "TMVA") {
+            TString s;
+            gTools().ReadAttr( antypeNode, "value", s);
+            fTMVATrainingVersion = TString(s(s.Index("[")+1,s.Index("]")-s.Index("[")-1)).Atoi();
+            Log() << kDEBUG <<Form("[%s] : ",DataInfo().GetName()) << "MVA method was trained with TMVA Version: " << GetTrainingTMVAVersionString() << Endl;
          }
-      }
-      else if (nodeName=="Weights") {
-         ReadWeightsFromXML(ch);
-      }
-      else {
-         Log() << kWARNING <<Form("Dataset[%s] : ",DataInfo().GetName())<< "Unparsed XML node: '" << nodeName << "'" << Endl;
-      }
-      ch = gTools().GetNextChild(ch);
 
+         if (name == "ROOT Release" || name == "ROOT") {
+            TString s;
+            gTools().ReadAttr( antypeNode, "value", s);
+            fROOTTrainingVersion = TString(s(s.Index("[")+1,s.Index("]")-s.Index("[")-1)).Atoi();
+            Log() << kDEBUG //<<Form("Dataset[%s] : ",DataInfo().GetName())
+        << "MVA method was trained with ROOT Version: " << GetTrainingROOTVersionString() << Endl;
+         }
+         antypeNode = gTools().GetNextChild(antypeNode);
+      }
    }
+   else if (nodeName=="Options") {
+      ReadOptionsFromXML(ch);
+      ParseOptions();
 
-   // update transformation handler
-   if (GetTransformationHandler().GetCallerName() == "") GetTransformationHandler().SetCallerName( GetName() );
+   }
+   else if (nodeName=="Variables") {
+      ReadVariablesFromXML(ch);
+   }
+   else if (nodeName=="Spectators") {
+      ReadSpectatorsFromXML(ch);
+   }
+   else if (nodeName=="Classes") {
+      if (DataInfo().GetNClasses()==0) ReadClassesFromXML(ch);
+   }
+   else if (nodeName=="Targets") {
+      if (DataInfo().GetNTargets()==0 && DoRegression()) ReadTargetsFromXML(ch);
+   }
+   else if (nodeName=="Transformations") {
+      GetTransformationHandler().ReadFromXML(ch);
+   }
+   else if (nodeName=="MVAPdfs") {
+      TString pdfname;
+      if (fMVAPdfS) { delete fMVAPdfS; fMVAPdfS=0; }
+      if (fMVAPdfB) { delete fMVAPdfB; fMVAPdfB=0; }
+      void* pdfnode = gTools().GetChild(ch);
+      if (pdfnode) {
+         gTools().ReadAttr(pdfnode, "Name", pdfname);
+         fMVAPdfS = new PDF(pdfname);
+         fMVAPdfS->ReadXML(pdfnode);
+         pdfnode = gTools().GetNextChild(pdfnode);
+         gTools().ReadAttr(pdfnode, "Name", pdfname);
+         fMVAPdfB = new PDF(pdfname);
+         fMVAPdfB->ReadXML(pdfnode);
+      }
+   }
+   else if (nodeName=="Weights") {
+      ReadWeightsFromXML(ch);
+   }
+   else {
+      Log() << kWARNING <<Form("Dataset[%s] : ",DataInfo().GetName())<< "Unparsed XML node: '" << nodeName << "'" << Endl;
+   }
 }
 
 ////////////////////////////////////////////////////////////////////////////////
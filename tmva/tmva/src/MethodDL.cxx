@@ -54,6 +54,7 @@
 #endif
 
 #include <chrono>
+#include <mutex>
 
 REGISTER_METHOD(DL)
 ClassImp(TMVA::MethodDL);
@@ -1024,7 +1025,7 @@ MethodDL::MethodDL(const TString &jobName, const TString &methodTitle, DataSetIn
      fOutputFunction(), fLossFunction(), fInputLayoutString(), fBatchLayoutString(),
      fLayoutString(), fErrorStrategy(), fTrainingStrategyString(), fWeightInitializationString(),
      fArchitectureString(), fResume(false), fBuildNet(true), fTrainingSettings(),
-     fXInput()
+     fXInput(), fEvaluationToken(std::make_shared<char>())
 {
    // Nothing to do here
 }
@@ -1037,7 +1038,7 @@ MethodDL::MethodDL(DataSetInfo &theData, const TString &theWeightFile)
      fLossFunction(), fInputLayoutString(), fBatchLayoutString(), fLayoutString(),
      fErrorStrategy(), fTrainingStrategyString(), fWeightInitializationString(),
      fArchitectureString(), fResume(false), fBuildNet(true), fTrainingSettings(),
-     fXInput()
+     fXInput(), fEvaluationToken(std::make_shared<char>())
 {
    // Nothing to do here
 }
@@ -1704,45 +1705,28 @@ void MethodDL::Train()
 
 
 ////////////////////////////////////////////////////////////////////////////////
-Double_t MethodDL::GetMvaValue(Double_t * /*errLower*/, Double_t * /*errUpper*/)
+/// Copy the variables of the event in the input tensor of batch size one, through the host buffer
+void MethodDL::FillInputTensor(const Event *ev, TensorImpl_t &xInput, HostBufferImpl_t &buffer) const
 {
+   const std::vector<Float_t> &inputValues = ev->GetValues();
 
-   // note that fNet  should have been build with a batch size of  1
-
-   if (!fNet || fNet->GetDepth() == 0) {
-       Log() << kFATAL << "The network has not been trained and fNet is not built"
-             << Endl;
-   }
-
-   // input  size must be equal to  1 which is the batch size of fNet
-   R__ASSERT(fNet->GetBatchSize() == 1);
-
-   // int batchWidth = fNet->GetBatchWidth();
-   // int batchDepth = fNet->GetBatchDepth();
-   // int batchHeight = fNet->GetBatchHeight();
-//   int noutput = fNet->GetOutputWidth();
-
-
-   // get current event
-   const std::vector<Float_t> &inputValues = GetEvent()->GetValues();
-
-   size_t nVariables = GetEvent()->GetNVariables();
+   size_t nVariables = ev->GetNVariables();
 
    // for Columnlayout tensor memory layout is   HWC while for rowwise is CHW
-   if (fXInput.GetLayout() == TMVA::Experimental::MemoryLayout::ColumnMajor) {
-      R__ASSERT(fXInput.GetShape().size() < 4);
+   if (xInput.GetLayout() == TMVA::Experimental::MemoryLayout::ColumnMajor) {
+      R__ASSERT(xInput.GetShape().size() < 4);
       size_t nc, nhw = 0;
-      if (fXInput.GetShape().size() == 2) {
-         nc =  fXInput.GetShape()[0];
+      if (xInput.GetShape().size() == 2) {
+         nc =  xInput.GetShape()[0];
          if (nc != 1 ) {
-             ArchitectureImpl_t::PrintTensor(fXInput);
+             ArchitectureImpl_t::PrintTensor(xInput);
              Log() << kFATAL << "First tensor dimension should be equal to batch size, i.e. = 1"
                    << Endl;
          }
-         nhw = fXInput.GetShape()[1];
+         nhw = xInput.GetShape()[1];
       } else {
-         nc = fXInput.GetCSize();
-         nhw = fXInput.GetWSize();
+         nc = xInput.GetCSize();
+         nhw = xInput.GetWSize();
       }
       if ( nVariables != nc * nhw)  {
           Log() << kFATAL << "Input Event variable dimensions are not compatible with the built network architecture"
@@ -1752,15 +1736,15 @@ Double_t MethodDL::GetMvaValue(Double_t * /*errLower*/, Double_t * /*errUpper*/)
       for (size_t j = 0; j < nc; j++) {
          for (size_t k = 0; k < nhw; k++) {
             // note that in TMVA events images are stored as C H W while in the buffer we stored as H W C
-            fXInputBuffer[ k * nc + j] = inputValues[j*nhw + k];  // for column layout !!!
+            buffer[ k * nc + j] = inputValues[j*nhw + k];  // for column layout !!!
          }
       }
    } else {
       // row-wise layout
-      assert(fXInput.GetShape().size() >= 4);
-      size_t nc = fXInput.GetCSize();
-      size_t nh = fXInput.GetHSize();
-      size_t nw = fXInput.GetWSize();
+      assert(xInput.GetShape().size() >= 4);
+      size_t nc = xInput.GetCSize();
+      size_t nh = xInput.GetHSize();
+      size_t nw = xInput.GetWSize();
       size_t n = nc * nh * nw;
       if ( nVariables != n) {
          Log() << kFATAL << "Input Event variable dimensions are not compatible with the built network architecture"
@@ -1769,11 +1753,35 @@ Double_t MethodDL::GetMvaValue(Double_t * /*errLower*/, Double_t * /*errUpper*/)
       }
       for (size_t j = 0; j < n; j++) {
          // in this case TMVA event has same order as input tensor
-         fXInputBuffer[ j ] = inputValues[j];  // for column layout !!!
+         buffer[ j ] = inputValues[j];  // for column layout !!!
       }
    }
    // copy buffer in input
-   fXInput.GetDeviceBuffer().CopyFrom( fXInputBuffer);
+   xInput.GetDeviceBuffer().CopyFrom( buffer);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+Double_t MethodDL::GetMvaValue(Double_t * /*errLower*/, Double_t * /*errUpper*/)
+{
+
+   // note that fNet  should have been build with a batch size of  1
+
+   if (!fNet || fNet->GetDepth() == 0) {
+       Log() << kFATAL << "The network has not been trained and fNet is not built"
+             << Endl;
+   }
+
+   // input  size must be equal to  1 which is the batch size of fNet
+   R__ASSERT(fNet->GetBatchSize() == 1);
+
+   // int batchWidth = fNet->GetBatchWidth();
+   // int batchDepth = fNet->GetBatchDepth();
+   // int batchHeight = fNet->GetBatchHeight();
+//   int noutput = fNet->GetOutputWidth();
+
+
+   // copy the current event in the input tensor
+   FillInputTensor(GetEvent(), fXInput, fXInputBuffer);
 
    // perform the prediction
    fNet->Prediction(*fYHat, fXInput, fOutputFunction);
@@ -2017,6 +2025,96 @@ const std::vector<Float_t> & TMVA::MethodDL::GetMulticlassValues()
 }
 
 
+////////////////////////////////////////////////////////////////////////////////
+/// Return the evaluation context of the calling thread for this method. It is created at the first call
+/// of the thread: the layers of fNet are cloned through their XML description, which is serialized, and
+/// then share the weights of fNet; the following calls only look up the context of the thread.
+MethodDL::EvaluationContext &MethodDL::GetEvaluationContext() const
+{
+   thread_local std::map<const void *, EvaluationContext> contexts;
+
+   // the address of the token of a deleted method can be reused by the token of a new method
+   auto it = contexts.find(fEvaluationToken.get());
+   if (it != contexts.end() && !it->second.fOwner.expired())
+      return it->second;
+
+   // drop the contexts of the deleted methods
+   for (auto jt = contexts.begin(); jt != contexts.end();) {
+      if (jt->second.fOwner.expired())
+         jt = contexts.erase(jt);
+      else
+         ++jt;
+   }
+
+   if (!fNet || fNet->GetDepth() == 0) {
+       Log() << kFATAL << "The network has not been trained and fNet is not built"
+             << Endl;
+   }
+   R__ASSERT(fNet->GetBatchSize() == 1);
+
+   static std::mutex cloneMutex;
+   std::lock_guard<std::mutex> lock(cloneMutex);
+
+   EvaluationContext &context = contexts[fEvaluationToken.get()];
+   context.fOwner = fEvaluationToken;
+   context.fNet = std::unique_ptr<DeepNetImpl_t>(new DeepNetImpl_t(fNet->GetBatchSize(), fNet->GetInputDepth(),
+                                                   fNet->GetInputHeight(), fNet->GetInputWidth(),
+                                                   fNet->GetBatchDepth(), fNet->GetBatchHeight(),
+                                                   fNet->GetBatchWidth(), fNet->GetLossFunction(),
+                                                   fNet->GetInitialization(), fNet->GetRegularization(),
+                                                   fNet->GetWeightDecay()));
+
+   auto & xmlEngine = gTools().xmlengine();
+   void *netXML = xmlEngine.NewChild(0, 0, "Weights");
+   for (size_t i = 0; i < fNet->GetDepth(); i++) {
+      fNet->GetLayerAt(i)->AddWeightsXMLTo(netXML);
+   }
+   ReadLayersFromXML(*context.fNet, netXML, fNet->GetDepth());
+   xmlEngine.FreeNode(netXML);
+
+   // the matrices are shallow copies, so the weights of the clone are the ones of fNet
+   for (size_t i = 0; i < fNet->GetDepth(); i++) {
+      auto layer = fNet->GetLayerAt(i);
+      auto clone = context.fNet->GetLayerAt(i);
+      for (size_t j = 0; j < layer->GetWeights().size(); j++)
+         clone->GetWeightsAt(j) = layer->GetWeightsAt(j);
+      for (size_t j = 0; j < layer->GetBiases().size(); j++)
+         clone->GetBiasesAt(j) = layer->GetBiasesAt(j);
+   }
+
+   context.fXInput = TensorImpl_t(fXInput.GetShape(), fXInput.GetLayout());
+   context.fXInputBuffer = HostBufferImpl_t(context.fXInput.GetSize());
+   context.fYHat = std::unique_ptr<MatrixImpl_t>(new MatrixImpl_t(fNet->GetBatchSize(), fNet->GetOutputWidth()));
+   return context;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Evaluate the transformed event with the network of the calling thread, see GetMvaValueConcurrent
+Double_t MethodDL::EvaluateMvaConcurrent(const Event *const ev) const
+{
+   EvaluationContext &context = GetEvaluationContext();
+   FillInputTensor(ev, context.fXInput, context.fXInputBuffer);
+   context.fNet->Prediction(*context.fYHat, context.fXInput, fOutputFunction);
+
+   double mvaValue = (*context.fYHat)(0, 0);
+   return (TMath::IsNaN(mvaValue)) ? -999. : mvaValue;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Evaluate the class probabilities of the transformed event with the network of the calling thread,
+/// see GetMulticlassValuesConcurrent
+void MethodDL::EvaluateMulticlassConcurrent(const Event *const ev, std::vector<Float_t> &values) const
+{
+   EvaluationContext &context = GetEvaluationContext();
+   FillInputTensor(ev, context.fXInput, context.fXInputBuffer);
+   context.fNet->Prediction(*context.fYHat, context.fXInput, fOutputFunction);
+
+   values.resize(context.fYHat->GetNcols());
+   for (size_t i = 0; i < values.size(); i++) {
+      values[i] = (*context.fYHat)(0, i);
+   }
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Evaluate the DeepNet on a vector of input values stored in the TMVA Event class
 ////////////////////////////////////////////////////////////////////////////////
@@ -2175,7 +2273,32 @@ void MethodDL::ReadWeightsFromXML(void * rootXML)
    fOutputFunction = static_cast<EOutputFunction>(outputFunctionChar);
 
 
-   //size_t previousWidth = inputWidth;
+   ReadLayersFromXML(*fNet, netXML, netDepth);
+
+   fBuildNet = false;
+   // create now the input and output matrices
+   //int n1 = batchHeight;
+   //int n2 = batchWidth;
+   // treat case where batchHeight is the batchSize in case of first Dense layers (then we need to set to fNet batch size)
+   //if (fXInput.size() > 0) fXInput.clear();
+   //fXInput.emplace_back(MatrixImpl_t(n1,n2));
+   fXInput = ArchitectureImpl_t::CreateTensor(fNet->GetBatchSize(), GetInputDepth(), GetInputHeight(), GetInputWidth() );
+   if (batchDepth == 1 && GetInputHeight() == 1 && GetInputDepth() == 1)
+      // make here a ColumnMajor tensor
+      fXInput = TensorImpl_t( fNet->GetBatchSize(), GetInputWidth(),TMVA::Experimental::MemoryLayout::ColumnMajor );
+   fXInputBuffer =  HostBufferImpl_t( fXInput.GetSize());
+
+   // create pointer to output matrix used for the predictions
+   fYHat = std::unique_ptr<MatrixImpl_t>(new MatrixImpl_t(fNet->GetBatchSize(),  fNet->GetOutputWidth() ) );
+
+
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Add to the network the first netDepth layers described by the children of netXML, with their weights
+void MethodDL::ReadLayersFromXML(DeepNetImpl_t &net, void *netXML, size_t netDepth) const
+{
    auto layerXML = gTools().xmlengine().GetChild(netXML);
 
    // loop on the layer and add them to the network
@@ -2196,7 +2319,7 @@ void MethodDL::ReadWeightsFromXML(void * rootXML)
          EActivationFunction func = static_cast<EActivationFunction>(funcString.Atoi());
 
 
-         fNet->AddDenseLayer(width, func, 0.0); // no need to pass dropout probability
+         net.AddDenseLayer(width, func, 0.0); // no need to pass dropout probability
 
       }
       // Convolutional Layer
@@ -2221,7 +2344,7 @@ void MethodDL::ReadWeightsFromXML(void * rootXML)
          EActivationFunction actFunction = static_cast<EActivationFunction>(funcString.Atoi());
 
 
-         fNet->AddConvLayer(depth, fltHeight, fltWidth, strideRows, strideCols,
+         net.AddConvLayer(depth, fltHeight, fltWidth, strideRows, strideCols,
                             padHeight, padWidth, actFunction);
 
       }
@@ -2237,7 +2360,7 @@ void MethodDL::ReadWeightsFromXML(void * rootXML)
          gTools().ReadAttr(layerXML, "StrideRows", strideRows);
          gTools().ReadAttr(layerXML, "StrideCols", strideCols);
 
-         fNet->AddMaxPoolLayer(filterHeight, filterWidth, strideRows, strideCols);
+         net.AddMaxPoolLayer(filterHeight, filterWidth, strideRows, strideCols);
       }
       // Reshape Layer
       else if (layerName == "ReshapeLayer") {
@@ -2250,7 +2373,7 @@ void MethodDL::ReadWeightsFromXML(void * rootXML)
          int flattening = 0;
          gTools().ReadAttr(layerXML, "Flattening",flattening );
 
-         fNet->AddReshapeLayer(depth, height, width, flattening);
+         net.AddReshapeLayer(depth, height, width, flattening);
 
       }
       // RNN Layer
@@ -2266,7 +2389,7 @@ void MethodDL::ReadWeightsFromXML(void * rootXML)
          gTools().ReadAttr(layerXML, "RememberState", rememberState );
          gTools().ReadAttr(layerXML, "ReturnSequence", returnSequence);
 
-         fNet->AddBasicRNNLayer(stateSize, inputSize, timeSteps, rememberState, returnSequence);
+         net.AddBasicRNNLayer(stateSize, inputSize, timeSteps, rememberState, returnSequence);
 
       }
       // LSTM Layer
@@ -2281,7 +2404,7 @@ void MethodDL::ReadWeightsFromXML(void * rootXML)
          gTools().ReadAttr(layerXML, "RememberState", rememberState );
          gTools().ReadAttr(layerXML, "ReturnSequence", returnSequence);
 
-         fNet->AddBasicLSTMLayer(stateSize, inputSize, timeSteps, rememberState, returnSequence);
+         net.AddBasicLSTMLayer(stateSize, inputSize, timeSteps, rememberState, returnSequence);
 
       }
       // GRU Layer
@@ -2301,40 +2424,21 @@ void MethodDL::ReadWeightsFromXML(void * rootXML)
             Warning("ReadWeightsFromXML",
                     "Cannot use a reset gate after to false with CudNN - use implementation with resetgate=true");
 
-         fNet->AddBasicGRULayer(stateSize, inputSize, timeSteps, rememberState, returnSequence, resetGateAfter);
+         net.AddBasicGRULayer(stateSize, inputSize, timeSteps, rememberState, returnSequence, resetGateAfter);
       }
       // BatchNorm Layer
       else if (layerName == "BatchNormLayer") {
          // use some dammy value which will be overwrittem in BatchNormLayer::ReadWeightsFromXML
-         fNet->AddBatchNormLayer(0., 0.0);
+         net.AddBatchNormLayer(0., 0.0);
       }
       // read weights and biases
-      fNet->GetLayers().back()->ReadWeightsFromXML(layerXML);
+      net.GetLayers().back()->ReadWeightsFromXML(layerXML);
 
       // read next layer
       layerXML = gTools().GetNextChild(layerXML);
    }
-
-   fBuildNet = false;
-   // create now the input and output matrices
-   //int n1 = batchHeight;
-   //int n2 = batchWidth;
-   // treat case where batchHeight is the batchSize in case of first Dense layers (then we need to set to fNet batch size)
-   //if (fXInput.size() > 0) fXInput.clear();
-   //fXInput.emplace_back(MatrixImpl_t(n1,n2));
-   fXInput = ArchitectureImpl_t::CreateTensor(fNet->GetBatchSize(), GetInputDepth(), GetInputHeight(), GetInputWidth() );
-   if (batchDepth == 1 && GetInputHeight() == 1 && GetInputDepth() == 1)
-      // make here a ColumnMajor tensor
-      fXInput = TensorImpl_t( fNet->GetBatchSize(), GetInputWidth(),TMVA::Experimental::MemoryLayout::ColumnMajor );
-   fXInputBuffer =  HostBufferImpl_t( fXInput.GetSize());
-
-   // create pointer to output matrix used for the predictions
-   fYHat = std::unique_ptr<MatrixImpl_t>(new MatrixImpl_t(fNet->GetBatchSize(),  fNet->GetOutputWidth() ) );
-
-
 }
 
-
 ////////////////////////////////////////////////////////////////////////////////
 void MethodDL::ReadWeightsFromStream(std::istream & /*istr*/)
 {
@@ -2,3 +2,4 @@
 
 template class TMVA::Experimental::RBDT<TMVA::Experimental::BranchlessForest<float>>;
 template class TMVA::Experimental::RBDT<TMVA::Experimental::BranchlessJittedForest<float>>;
+template class TMVA::Experimental::RBDT<TMVA::Experimental::BranchlessQuantizedForest<float>>;
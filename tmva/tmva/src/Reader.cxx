@@ -345,10 +345,17 @@ TString TMVA::Reader::GetMethodTypeFromFile( const TString& filename )
    TString fullMethodName("");
    if (filename.EndsWith(".xml")) {
       fin.close();
-      void* doc      = gTools().xmlengine().ParseFile(filename,gTools().xmlenginebuffersize());// the default buffer size in TXMLEngine::ParseFile is 100k. Starting with ROOT 5.29 one can set the buffer size, see: http://savannah.cern.ch/bugs/?78864. This might be necessary for large XML files
-      void* rootnode = gTools().xmlengine().DocGetRootElement(doc); // node "MethodSetup"
-      gTools().ReadAttr(rootnode, "Method", fullMethodName);
-      gTools().xmlengine().FreeDoc(doc);
+      // only the attributes of the top node "MethodSetup" are needed: the reading stops there
+      TXMLEngine& xml = gTools().xmlengine();
+      void* reader = xml.OpenReader(filename,gTools().xmlenginebuffersize());
+      Int_t event;
+      while ((event = xml.ReadNext(reader)) > 0) {
+         if (event == TXMLEngine::kReaderStartNode) {
+            gTools().ReadAttr(xml.GetReaderNode(reader), "Method", fullMethodName);
+            break;
+         }
+      }
+      xml.CloseReader(reader);
    }
    else {
       char buf[512];
@@ -700,6 +707,72 @@ TMVA::IMethod* TMVA::Reader::FindMVA( const TString& methodTag )
    return 0;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// returns true if the method can be evaluated concurrently, with EvaluateMVAConcurrent
+/// and EvaluateMulticlassConcurrent
+
+Bool_t TMVA::Reader::HasConcurrentEvaluation( const TString& methodTag ) const
+{
+   std::map<TString, IMethod*>::const_iterator it = fMethodMap.find( methodTag );
+   if (it == fMethodMap.end()) return kFALSE;
+   const MethodBase* meth = dynamic_cast<const TMVA::MethodBase*>(it->second);
+   return meth != 0 && meth->HasConcurrentEvaluation();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// find a method which can be evaluated concurrently
+
+const TMVA::MethodBase* TMVA::Reader::FindConcurrentMVA( const TString& methodTag ) const
+{
+   std::map<TString, IMethod*>::const_iterator it = fMethodMap.find( methodTag );
+   if (it == fMethodMap.end()) {
+      Log() << kFATAL << "Method " << methodTag << " not found!" << Endl;
+      return 0;
+   }
+   const MethodBase* meth = dynamic_cast<const TMVA::MethodBase*>(it->second);
+   if (meth == 0 || !meth->HasConcurrentEvaluation())
+      Log() << kFATAL << "Method " << methodTag << " does not support the concurrent evaluation" << Endl;
+   return meth;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// evaluates the MVA of a method with HasConcurrentEvaluation for the input values: unlike
+/// EvaluateMVA, neither the reader nor the method are modified, so that several threads can
+/// call it at a time with the same reader, which holds one copy of the weights
+
+Double_t TMVA::Reader::EvaluateMVAConcurrent( const std::vector<Float_t>& inputVec, const TString& methodTag ) const
+{
+   const MethodBase* meth = FindConcurrentMVA( methodTag );
+   for (UInt_t i=0; i<inputVec.size(); i++){
+      if (TMath::IsNaN(inputVec[i])) {
+         Log() << kERROR << i << "-th variable of the event is NaN --> return MVA value -999, \n that's all I can do, please fix or remove this event." << Endl;
+         return -999;
+      }
+   }
+
+   Event ev( inputVec, DataInfo().GetNVariables() );
+   return meth->GetMvaValueConcurrent( &ev );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// evaluates the multiclass MVA of a method with HasConcurrentEvaluation for the input values,
+/// see EvaluateMVAConcurrent
+
+std::vector<Float_t> TMVA::Reader::EvaluateMulticlassConcurrent( const std::vector<Float_t>& inputVec, const TString& methodTag ) const
+{
+   const MethodBase* meth = FindConcurrentMVA( methodTag );
+   for (UInt_t i=0; i<inputVec.size(); i++){
+      if (TMath::IsNaN(inputVec[i])) {
+         Log() << kERROR << i << "-th variable of the event is NaN, \n regression values might evaluate to .. what do I know. \n sorry this warning is all I can do, please fix or remove this event." << Endl;
+      }
+   }
+
+   Event ev( inputVec, DataInfo().GetNVariables() );
+   std::vector<Float_t> values;
+   meth->GetMulticlassValuesConcurrent( &ev, values );
+   return values;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// special function for Cuts to avoid dynamic_casts in ROOT macros,
 /// which are not properly handled by CINT
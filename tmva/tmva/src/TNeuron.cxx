@@ -109,6 +109,18 @@ void TMVA::TNeuron::CalculateActivationValue()
    fActivationValue = fActivation->Eval(fValue);
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// return the neuron activation/output for the activation values of the
+/// preceding layer, given in the order of the pre-links; the neuron is not
+/// modified, so that several threads can evaluate the network at a time
+
+Double_t TMVA::TNeuron::EvaluateActivationValue( const Double_t* preActivations ) const
+{
+   if (fActivation == NULL) return UNINITIALIZED;
+   Double_t value = fForcedValue ? fValue : fInputCalculator->GetInput(this, preActivations);
+   return fActivation->Eval(value);
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// calculate error field
 
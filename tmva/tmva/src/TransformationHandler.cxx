@@ -162,6 +162,25 @@ const TMVA::Event* TMVA::TransformationHandler::Transform( const Event* ev ) con
    return trEv;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// the transformation into events of the caller, one per transformation: unlike Transform(ev)
+/// it leaves the transformations untouched, so that they can be applied by several threads at a time
+
+const TMVA::Event* TMVA::TransformationHandler::Transform( const Event* ev, std::vector<Event>& transformed ) const
+{
+   if (transformed.size() < (UInt_t)fTransformations.GetSize()) transformed.resize( fTransformations.GetSize() );
+   TListIter trIt(&fTransformations);
+   std::vector<Int_t>::const_iterator rClsIt = fTransformationsReferenceClasses.begin();
+   const Event* trEv = ev;
+   UInt_t itrf = 0;
+   while (VariableTransformBase *trf = (VariableTransformBase*) trIt()) {
+      if (rClsIt == fTransformationsReferenceClasses.end()) Log() << kFATAL<< "invalid read in TransformationHandler::Transform " <<Endl;
+      trEv = trf->Transform(trEv, (*rClsIt), transformed[itrf++] );
+      ++rClsIt;
+   }
+   return trEv;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 
 const TMVA::Event* TMVA::TransformationHandler::InverseTransform( const Event* ev, Bool_t suppressIfNoTargets ) const
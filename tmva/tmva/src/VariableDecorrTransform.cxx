@@ -165,6 +165,19 @@ std::vector<TString>* TMVA::VariableDecorrTransform::GetTransformationStrings( I
 /// apply the decorrelation transformation
 
 const TMVA::Event* TMVA::VariableDecorrTransform::Transform( const TMVA::Event* const ev, Int_t cls ) const
+{
+   if (fTransformedEvent==0 || fTransformedEvent->GetNVariables()!=ev->GetNVariables()) {
+      if (fTransformedEvent!=0) { delete fTransformedEvent; fTransformedEvent = 0; }
+      fTransformedEvent = new Event();
+   }
+
+   return Transform( ev, cls, *fTransformedEvent );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// apply the decorrelation transformation into the event of the caller
+
+const TMVA::Event* TMVA::VariableDecorrTransform::Transform( const TMVA::Event* const ev, Int_t cls, Event& transformed ) const
 {
    if (!IsCreated())
       Log() << kFATAL << "Transformation matrix not yet created"
@@ -190,11 +203,6 @@ const TMVA::Event* TMVA::VariableDecorrTransform::Transform( const TMVA::Event*
                << Endl;
    }
 
-   if (fTransformedEvent==0 || fTransformedEvent->GetNVariables()!=ev->GetNVariables()) {
-      if (fTransformedEvent!=0) { delete fTransformedEvent; fTransformedEvent = 0; }
-      fTransformedEvent = new Event();
-   }
-
    // transformation to decorrelate the variables
    const Int_t nvar = fGet.size();
 
@@ -208,8 +216,8 @@ const TMVA::Event* TMVA::VariableDecorrTransform::Transform( const TMVA::Event*
       if( numMasked>0 && numOK>0 ){
          Log() << kFATAL << "You mixed variables and targets in the decorrelation transformation. This is not possible." << Endl;
       }
-      SetOutput( fTransformedEvent, input, mask, ev );
-      return fTransformedEvent;
+      SetOutput( &transformed, input, mask, ev );
+      return &transformed;
    }
 
    TVectorD vec( nvar );
@@ -221,9 +229,9 @@ const TMVA::Event* TMVA::VariableDecorrTransform::Transform( const TMVA::Event*
    input.clear();
    for (Int_t ivar=0; ivar<nvar; ivar++) input.push_back( vec(ivar) );
 
-   SetOutput( fTransformedEvent, input, mask, ev );
+   SetOutput( &transformed, input, mask, ev );
 
-   return fTransformedEvent;
+   return &transformed;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
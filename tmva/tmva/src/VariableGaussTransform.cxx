@@ -120,6 +120,19 @@ Bool_t TMVA::VariableGaussTransform::PrepareTransformation (const std::vector<Ev
 /// apply the Gauss transformation
 
 const TMVA::Event* TMVA::VariableGaussTransform::Transform(const Event* const ev, Int_t cls ) const
+{
+   if (fTransformedEvent==0 || fTransformedEvent->GetNVariables()!=ev->GetNVariables()) {
+      if (fTransformedEvent!=0) { delete fTransformedEvent; fTransformedEvent = 0; }
+      fTransformedEvent = new Event();
+   }
+
+   return Transform( ev, cls, *fTransformedEvent );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// apply the Gauss transformation into the event of the caller
+
+const TMVA::Event* TMVA::VariableGaussTransform::Transform(const Event* const ev, Int_t cls, Event& transformed ) const
 {
    if (!IsCreated()) Log() << kFATAL << "Transformation not yet created" << Endl;
    //EVT this is a workaround to address the reader problem with transforma and EvaluateMVA(std::vector<float/double> ,...)
@@ -175,14 +188,9 @@ const TMVA::Event* TMVA::VariableGaussTransform::Transform(const Event* const ev
       }
    }
 
-   if (fTransformedEvent==0 || fTransformedEvent->GetNVariables()!=ev->GetNVariables()) {
-      if (fTransformedEvent!=0) { delete fTransformedEvent; fTransformedEvent = 0; }
-      fTransformedEvent = new Event();
-   }
-
-   SetOutput( fTransformedEvent, output, mask, ev );
+   SetOutput( &transformed, output, mask, ev );
 
-   return fTransformedEvent;
+   return &transformed;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -108,6 +108,14 @@ const TMVA::Event* TMVA::VariableIdentityTransform::Transform (const TMVA::Event
    return ev;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// identity transform returns same event
+
+const TMVA::Event* TMVA::VariableIdentityTransform::Transform (const TMVA::Event* const ev, Int_t, Event& ) const
+{
+   return ev;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// creates C++ code fragment of the identity transform for inclusion in standalone C++ class
 
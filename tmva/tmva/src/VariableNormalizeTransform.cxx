@@ -106,6 +106,16 @@ Bool_t TMVA::VariableNormalizeTransform::PrepareTransformation (const std::vecto
 /// apply the normalization transformation
 
 const TMVA::Event* TMVA::VariableNormalizeTransform::Transform( const TMVA::Event* const ev, Int_t cls ) const
+{
+   if (fTransformedEvent==0) fTransformedEvent = new Event();
+
+   return Transform( ev, cls, *fTransformedEvent );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// apply the normalization transformation into the event of the caller
+
+const TMVA::Event* TMVA::VariableNormalizeTransform::Transform( const TMVA::Event* const ev, Int_t cls, Event& transformed ) const
 {
    if (!IsCreated()) Log() << kFATAL << "Transformation not yet created" << Endl;
 
@@ -124,8 +134,6 @@ const TMVA::Event* TMVA::VariableNormalizeTransform::Transform( const TMVA::Even
    std::vector<Char_t> mask; // entries with kTRUE must not be transformed
    GetInput( ev, input, mask );
 
-   if (fTransformedEvent==0) fTransformedEvent = new Event();
-
    Float_t min,max;
    const FloatVector& minVector = fMin.at(cls);
    const FloatVector& maxVector = fMax.at(cls);
@@ -154,8 +162,8 @@ const TMVA::Event* TMVA::VariableNormalizeTransform::Transform( const TMVA::Even
       ++itMask;
    }
 
-   SetOutput( fTransformedEvent, output, mask, ev );
-   return fTransformedEvent;
+   SetOutput( &transformed, output, mask, ev );
+   return &transformed;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -128,6 +128,20 @@ const TMVA::Event* TMVA::VariablePCATransform::Transform( const Event* const ev,
 {
    if (!IsCreated()) return 0;
 
+   if (fTransformedEvent==0 ) {
+      fTransformedEvent = new Event();
+   }
+
+   return Transform( ev, cls, *fTransformedEvent );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// apply the principal component analysis into the event of the caller
+
+const TMVA::Event* TMVA::VariablePCATransform::Transform( const Event* const ev, Int_t cls, Event& transformed ) const
+{
+   if (!IsCreated()) return 0;
+
    //   const Int_t inputSize = fGet.size();
    //   const UInt_t nCls = GetNClasses();
 
@@ -142,10 +156,6 @@ const TMVA::Event* TMVA::VariablePCATransform::Transform( const Event* const ev,
 
    // Perform PCA and put it into PCAed events tree
 
-   if (fTransformedEvent==0 ) {
-      fTransformedEvent = new Event();
-   }
-
    std::vector<Float_t> input;
    std::vector<Char_t>  mask;
    std::vector<Float_t> principalComponents;
@@ -158,14 +168,14 @@ const TMVA::Event* TMVA::VariablePCATransform::Transform( const Event* const ev,
       if( numMasked>0 && numOK>0 ){
          Log() << kFATAL << "You mixed variables and targets in the decorrelation transformation. This is not possible." << Endl;
       }
-      SetOutput( fTransformedEvent, input, mask, ev );
-      return fTransformedEvent;
+      SetOutput( &transformed, input, mask, ev );
+      return &transformed;
    }
 
    X2P( principalComponents, input, cls );
-   SetOutput( fTransformedEvent, principalComponents, mask, ev );
+   SetOutput( &transformed, principalComponents, mask, ev );
 
-   return fTransformedEvent;
+   return &transformed;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -78,21 +78,31 @@ Bool_t TMVA::VariableRearrangeTransform::PrepareTransformation (const std::vecto
 
 ////////////////////////////////////////////////////////////////////////////////
 
-const TMVA::Event* TMVA::VariableRearrangeTransform::Transform( const TMVA::Event* const ev, Int_t /*cls*/ ) const
+const TMVA::Event* TMVA::VariableRearrangeTransform::Transform( const TMVA::Event* const ev, Int_t cls ) const
+{
+   if (!IsEnabled()) return ev;
+
+   if (fTransformedEvent==0) fTransformedEvent = new Event();
+
+   return Transform( ev, cls, *fTransformedEvent );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// rearrange the variables into the event of the caller
+
+const TMVA::Event* TMVA::VariableRearrangeTransform::Transform( const TMVA::Event* const ev, Int_t /*cls*/, Event& transformed ) const
 {
    if (!IsEnabled()) return ev;
 
    // apply the normalization transformation
    if (!IsCreated()) Log() << kFATAL << "Transformation not yet created" << Endl;
 
-   if (fTransformedEvent==0) fTransformedEvent = new Event();
-
    FloatVector input; // will be filled with the selected variables, (targets)
    std::vector<Char_t> mask; // masked variables
    GetInput( ev, input, mask );
-   SetOutput( fTransformedEvent, input, mask, ev );
+   SetOutput( &transformed, input, mask, ev );
 
-   return fTransformedEvent;
+   return &transformed;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -309,6 +309,15 @@ void TMVA::VariableTransformBase::SelectInput( const TString& _inputVariables, B
 }
 
 
+////////////////////////////////////////////////////////////////////////////////
+/// transform into an event of the caller; the transformations which do not support it abort
+
+const TMVA::Event* TMVA::VariableTransformBase::Transform( const Event* const, Int_t, Event& ) const
+{
+   Log() << kFATAL << "Transformation " << fTransformName << " does not support the transformation into an event of the caller" << Endl;
+   return 0;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// select the values from the event
 
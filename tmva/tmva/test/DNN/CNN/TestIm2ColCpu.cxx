@@ -36,6 +36,61 @@
 using namespace TMVA::DNN;
 using namespace TMVA::DNN::CNN;
 
+/** Compare the direct convolution with Im2col followed by the matrix multiplication, for a number of output
+ *  channels and local views that are not multiples of the blocks of the direct convolution. */
+template <typename Architecture_t>
+bool testConvolveDirect()
+{
+   using Matrix_t = typename Architecture_t::Matrix_t;
+
+   const size_t imgDepth = 3, imgHeight = 13, imgWidth = 11;
+   const size_t fltHeight = 3, fltWidth = 5, strideRows = 1, strideCols = 2, zeroPaddingHeight = 1,
+                zeroPaddingWidth = 2;
+   const size_t depth = 19;
+   const size_t height = calculateDimension(imgHeight, fltHeight, zeroPaddingHeight, strideRows);
+   const size_t width = calculateDimension(imgWidth, fltWidth, zeroPaddingWidth, strideCols);
+   const size_t nLocalViews = height * width;
+   const size_t nLocalViewPixels = imgDepth * fltHeight * fltWidth;
+
+   Matrix_t B(imgDepth, imgHeight * imgWidth);
+   for (size_t i = 0; i < imgDepth; i++)
+      for (size_t j = 0; j < imgHeight * imgWidth; j++)
+         B(i, j) = std::sin(0.1 * (i * imgHeight * imgWidth + j));
+   Matrix_t weights(depth, nLocalViewPixels);
+   for (size_t i = 0; i < depth; i++)
+      for (size_t j = 0; j < nLocalViewPixels; j++)
+         weights(i, j) = std::cos(0.3 * (i * nLocalViewPixels + j));
+   Matrix_t biases(depth, 1);
+   for (size_t i = 0; i < depth; i++)
+      biases(i, 0) = 0.1 * i;
+
+   std::vector<int> V(nLocalViews * nLocalViewPixels);
+   Architecture_t::Im2colIndices(V, B, nLocalViews, imgHeight, imgWidth, fltHeight, fltWidth, strideRows, strideCols,
+                                 zeroPaddingHeight, zeroPaddingWidth);
+
+   Matrix_t::InitializeOneVector(nLocalViews);
+   Matrix_t BTr(nLocalViews, nLocalViewPixels);
+   Architecture_t::Im2colFast(BTr, B, V);
+   Matrix_t expected(depth, nLocalViews);
+   Architecture_t::MultiplyTranspose(expected, weights, BTr);
+   Architecture_t::AddConvBiases(expected, biases);
+
+   Matrix_t A(depth, nLocalViews);
+   Architecture_t::ConvolveDirect(A, B, weights, biases, V, 0, 7);
+   Architecture_t::ConvolveDirect(A, B, weights, biases, V, 7, depth);
+
+   for (size_t i = 0; i < depth; i++) {
+      for (size_t j = 0; j < nLocalViews; j++) {
+         if (std::abs(A(i, j) - expected(i, j)) > 1.E-10) {
+            std::cerr << "ConvolveDirect: A(" << i << "," << j << ") = " << A(i, j) << ", expected "
+                      << expected(i, j) << std::endl;
+            return false;
+         }
+      }
+   }
+   return true;
+}
+
 
 int main()
 {
@@ -64,4 +119,11 @@ int main()
       std::cerr << "ERROR - test3 failed " << std::endl;
       return -1;
    }
+
+   std::cout << "Test direct convolution: " << std::endl;
+   status &= testConvolveDirect<TCpu<Scalar_t>>();
+   if (!status) {
+      std::cerr << "ERROR - direct convolution test failed " << std::endl;
+      return -1;
+   }
 }
@@ -0,0 +1,134 @@
+// ROOT
+#include "TRandom3.h"
+#include "TXMLEngine.h"
+
+// TMVA
+#include "TMVA/Config.h"
+#include "TMVA/DataLoader.h"
+#include "TMVA/Factory.h"
+#include "TMVA/MethodBase.h"
+#include "TMVA/Reader.h"
+#include "TMVA/Types.h"
+
+// Stdlib
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+// External
+#include "gtest/gtest.h"
+
+/*
+ * The weight files are read with the streaming XML reader of TXMLEngine, one section of
+ * "MethodSetup" after the other. These tests check that a method booked from a weight file,
+ * or from the content of a weight file, computes the same response as the coefficients
+ * read from the complete document parsed with TXMLEngine::ParseFile.
+ */
+class TestWeightFileFixture : public ::testing::Test {
+protected:
+   static void SetUpTestCase()
+   {
+      TMVA::gConfig().SetSilent(true);
+      TMVA::MsgLogger::InhibitOutput();
+
+      TRandom3 rng(42);
+      TMVA::DataLoader dl("TestWeightFile");
+      dl.AddVariable("x", 'F');
+      dl.AddVariable("y", 'F');
+      for (Int_t n = 0; n < 200; ++n) {
+         dl.AddSignalTrainingEvent({rng.Gaus(1., 1.), rng.Gaus(0.5, 2.)});
+         dl.AddSignalTestEvent({rng.Gaus(1., 1.), rng.Gaus(0.5, 2.)});
+         dl.AddBackgroundTrainingEvent({rng.Gaus(-1., 1.), rng.Gaus(-0.5, 2.)});
+         dl.AddBackgroundTestEvent({rng.Gaus(-1., 1.), rng.Gaus(-0.5, 2.)});
+      }
+      dl.PrepareTrainingAndTestTree("", "!V");
+
+      TMVA::Factory factory("TestWeightFile", "!V:Silent:!DrawProgressBar:AnalysisType=Classification");
+      factory.BookMethod(&dl, TMVA::Types::kFisher, "Fisher", "!V:!H");
+      factory.TrainAllMethods();
+      auto method = dynamic_cast<TMVA::MethodBase *>(factory.GetMethod(dl.GetName(), "Fisher"));
+      ASSERT_NE(method, nullptr);
+      fWeightFile = method->GetWeightFileName();
+   }
+
+   // Reads the Fisher coefficients from the parsed weight file
+   static std::vector<Double_t> ReadCoefficients()
+   {
+      std::vector<Double_t> coeffs;
+      TXMLEngine xml;
+      XMLDocPointer_t doc = xml.ParseFile(fWeightFile);
+      if (!doc)
+         return coeffs;
+      XMLNodePointer_t section = xml.GetChild(xml.DocGetRootElement(doc));
+      while (section && strcmp(xml.GetNodeName(section), "Weights") != 0)
+         section = xml.GetNext(section);
+      if (section) {
+         coeffs.resize(xml.GetIntAttr(section, "NCoeff"));
+         for (XMLNodePointer_t c = xml.GetChild(section); c; c = xml.GetNext(c))
+            coeffs.at(xml.GetIntAttr(c, "Index")) = std::stod(xml.GetAttr(c, "Value"));
+      }
+      xml.FreeDoc(doc);
+      return coeffs;
+   }
+
+   static TString fWeightFile;
+};
+
+TString TestWeightFileFixture::fWeightFile;
+
+TEST_F(TestWeightFileFixture, ReadWeightFile)
+{
+   auto coeffs = ReadCoefficients();
+   ASSERT_EQ(coeffs.size(), 3u);
+
+   Float_t x, y;
+   TMVA::Reader fileReader("!Color:Silent");
+   fileReader.AddVariable("x", &x);
+   fileReader.AddVariable("y", &y);
+   ASSERT_NE(fileReader.BookMVA("Fisher", fWeightFile), nullptr);
+
+   // same weights, given as a string
+   std::ifstream f(fWeightFile.Data());
+   std::stringstream content;
+   content << f.rdbuf();
+   std::string xmlstr = content.str();
+   TMVA::Reader stringReader("!Color:Silent");
+   stringReader.AddVariable("x", &x);
+   stringReader.AddVariable("y", &y);
+   auto stringMethod = dynamic_cast<TMVA::MethodBase *>(stringReader.BookMVA(TMVA::Types::kFisher, xmlstr.c_str()));
+   ASSERT_NE(stringMethod, nullptr);
+   EXPECT_EQ(stringMethod->GetMethodType(), TMVA::Types::kFisher);
+   EXPECT_EQ(stringMethod->GetAnalysisType(), TMVA::Types::kClassification);
+   EXPECT_EQ(stringMethod->GetNvar(), 2u);
+
+   for (Int_t i = -5; i <= 5; ++i) {
+      for (Int_t j = -5; j <= 5; ++j) {
+         x = 0.5 * i;
+         y = 0.7 * j;
+         Double_t expected = coeffs[0] + coeffs[1] * x + coeffs[2] * y;
+         Double_t fromFile = fileReader.EvaluateMVA("Fisher");
+         EXPECT_NEAR(fromFile, expected, 1e-10 * (1. + std::abs(expected)));
+         EXPECT_EQ(stringReader.EvaluateMVA(stringMethod), fromFile);
+      }
+   }
+}
+
+TEST_F(TestWeightFileFixture, InvalidWeightString)
+{
+   // the document ends in the middle of a section
+   std::ifstream f(fWeightFile.Data());
+   std::stringstream content;
+   content << f.rdbuf();
+   std::string xmlstr = content.str();
+   xmlstr.resize(xmlstr.find("<Weights"));
+
+   Float_t x, y;
+   TMVA::Reader reader("!Color:Silent");
+   reader.AddVariable("x", &x);
+   reader.AddVariable("y", &y);
+   EXPECT_THROW(reader.BookMVA(TMVA::Types::kFisher, xmlstr.c_str()), std::runtime_error);
+}
@@ -81,6 +81,27 @@ TEST(BranchlessTree, InferenceSparseTreeDepth2)
    EXPECT_FLOAT_EQ(tree.Inference(input3, 1), 6.0);
 }
 
+TEST(BranchlessTree, InferenceBlock)
+{
+   BranchlessTree<float> tree;
+   tree.fTreeDepth = 2;
+   tree.fThresholds = {0.0, 1.0, 2.0, 3.0, 4.0, 5.0, 6.0};
+   tree.fInputs = {0, 1, 2};
+   // four events in row major layout
+   float inputs[12] = {-1.0, 0.0, -999.0, -1.0, 2.0, -999.0, 1.0, -999.0, 1.0, 1.0, -999.0, 3.0};
+   float predictions[4] = {0.5, 0.5, 0.5, 0.5};
+   tree.InferenceBlock(inputs, 1, 3, 4, predictions);
+   for (int i = 0; i < 4; i++)
+      EXPECT_FLOAT_EQ(predictions[i], 0.5 + tree.Inference(inputs + 3 * i, 1));
+
+   // the same events in column major layout
+   float inputsColumnMajor[12] = {-1.0, -1.0, 1.0, 1.0, 0.0, 2.0, -999.0, -999.0, -999.0, -999.0, 1.0, 3.0};
+   float predictionsColumnMajor[4] = {0.0, 0.0, 0.0, 0.0};
+   tree.InferenceBlock(inputsColumnMajor, 4, 1, 4, predictionsColumnMajor);
+   for (int i = 0; i < 4; i++)
+      EXPECT_FLOAT_EQ(predictionsColumnMajor[i], predictions[i] - 0.5);
+}
+
 TEST(BranchlessJittedTree, InferenceFullTreeDepth0)
 {
    BranchlessTree<float> tree;
@@ -163,6 +184,11 @@ TEST(BranchlessForest, InferenceSingleTree)
    TestInferenceSingleTree<BranchlessForest<float>>("BranchlessForest");
 }
 
+TEST(BranchlessQuantizedForest, InferenceSingleTree)
+{
+   TestInferenceSingleTree<BranchlessQuantizedForest<float>>("BranchlessQuantizedForest");
+}
+
 template <typename ForestType>
 void TestInferenceSingleTreeObjectiveLogistic(const std::string& tag)
 {
@@ -194,6 +220,11 @@ TEST(BranchlessForest, InferenceSingleTreeObjectiveLogistic)
    TestInferenceSingleTreeObjectiveLogistic<BranchlessForest<float>>("BranchlessForest");
 }
 
+TEST(BranchlessQuantizedForest, InferenceSingleTreeObjectiveLogistic)
+{
+   TestInferenceSingleTreeObjectiveLogistic<BranchlessQuantizedForest<float>>("BranchlessQuantizedForest");
+}
+
 template <typename ForestType>
 void TestInferenceTwoTrees(const std::string& tag)
 {
@@ -225,6 +256,11 @@ TEST(BranchlessForest, InferenceTwoTrees)
    TestInferenceTwoTrees<BranchlessForest<float>>("BranchlessForest");
 }
 
+TEST(BranchlessQuantizedForest, InferenceTwoTrees)
+{
+   TestInferenceTwoTrees<BranchlessQuantizedForest<float>>("BranchlessQuantizedForest");
+}
+
 TEST(BranchlessForest, SortTrees)
 {
    const auto maxDepth = 1;
@@ -277,3 +313,72 @@ TEST(BranchlessJittedForest, SortTrees)
    for (int i = 0; i < rows; i++)
       EXPECT_FLOAT_EQ(predictions1[i], predictions2[i]);
 }
+
+template <typename ForestType>
+void TestInferenceManyEvents(const std::string &tag)
+{
+   // two trees of depth 2 on three inputs, the second one sparse: more events than the events evaluated together
+   const auto maxDepth = 2;
+   const auto numInputs = 3;
+   const auto numTrees = 2;
+   WriteModel("myModel", "Test" + tag + "4.root", "identity", {0, 1, 2, 2, -1, 0}, {0, 0},
+              {0.0, 1.0, 2.0, 3.0, 4.0, 5.0, 6.0, 0.5, 0.0, -0.5, 0.0, 0.0, -1.0, -2.0}, {maxDepth}, {numTrees},
+              {numInputs}, {1});
+
+   ForestType forest;
+   forest.Load("myModel", "Test" + tag + "4.root", 0);
+
+   const int rows = 130;
+   std::vector<float> inputs(numInputs * rows);
+   for (int i = 0; i < numInputs * rows; i++)
+      inputs[i] = 0.25 * (i % 17) - 2.0;
+   auto expected = [&inputs](int i) {
+      const float *x = &inputs[numInputs * i];
+      const float first = x[0] > 0.0 ? (x[2] > 2.0 ? 6.0 : 5.0) : (x[1] > 1.0 ? 4.0 : 3.0);
+      const float second = x[2] > 0.5 ? (x[0] > -0.5 ? -2.0 : -1.0) : 0.0;
+      return first + second;
+   };
+
+   std::vector<float> predictions(rows);
+   forest.Inference(inputs.data(), rows, true, predictions.data());
+   for (int i = 0; i < rows; i++)
+      EXPECT_FLOAT_EQ(predictions[i], expected(i));
+}
+
+TEST(BranchlessForest, InferenceManyEvents)
+{
+   TestInferenceManyEvents<BranchlessForest<float>>("BranchlessForest");
+}
+
+TEST(BranchlessJittedForest, InferenceManyEvents)
+{
+   TestInferenceManyEvents<BranchlessJittedForest<float>>("BranchlessJittedForest");
+}
+
+TEST(BranchlessQuantizedForest, InferenceManyEvents)
+{
+   TestInferenceManyEvents<BranchlessQuantizedForest<float>>("BranchlessQuantizedForest");
+}
+
+TEST(BranchlessQuantizedForest, Cuts)
+{
+   const auto maxDepth = 1;
+   const auto numInputs = 2;
+   const auto numTrees = 3;
+   WriteModel("myModel", "TestBranchlessQuantizedForest5.root", "identity", {1, 0, 0}, {0, 0, 0},
+              {0.0, 0.0, 0.0, 2.0, 2.0, 3.0, 1.0, 1.0, -1.0}, {maxDepth}, {numTrees}, {numInputs}, {1});
+
+   // the first tree has a single score, so its node does not cut
+   BranchlessQuantizedForest<float> forest;
+   forest.Load("myModel", "TestBranchlessQuantizedForest5.root", 0);
+   EXPECT_EQ(forest.fCuts[0], std::vector<float>({1.0, 2.0}));
+   EXPECT_TRUE(forest.fCuts[1].empty());
+
+   const auto rows = 3;
+   float inputs[numInputs * rows] = {0.5, 0.0, 1.5, 0.0, 2.5, 0.0};
+   float predictions[rows];
+   forest.Inference(inputs, rows, true, predictions);
+   EXPECT_FLOAT_EQ(predictions[0], 0.0 + 2.0 + 1.0);
+   EXPECT_FLOAT_EQ(predictions[1], 0.0 + 2.0 - 1.0);
+   EXPECT_FLOAT_EQ(predictions[2], 0.0 + 3.0 - 1.0);
+}
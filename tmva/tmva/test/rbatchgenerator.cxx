@@ -0,0 +1,106 @@
+#include <gtest/gtest.h>
+#include "TMVA/RBatchGenerator.hxx"
+#include "ROOT/RDataFrame.hxx"
+
+#include <numeric>
+
+using namespace ROOT;
+using namespace TMVA::Experimental;
+
+TEST(RBatchGenerator, Batches)
+{
+   RDataFrame df(100);
+   auto df2 = df.Define("a", [](ULong64_t e) { return float(e); }, {"rdfentry_"})
+                 .Define("b", [](ULong64_t e) { return -2 * int(e); }, {"rdfentry_"});
+   RBatchGenerator<float, float, int> gen(df2, {"a", "b"}, 16, 32);
+   for (int epoch = 0; epoch < 2; epoch++) {
+      gen.StartEpoch();
+      std::vector<bool> seen(100, false);
+      std::size_t nEvents = 0;
+      std::size_t nBatches = 0;
+      while (gen.NextBatch()) {
+         const auto &x = gen.GetBatch();
+         EXPECT_EQ(x.GetShape()[1], 2u);
+         const auto n = x.GetShape()[0];
+         EXPECT_EQ(n, nBatches < 6 ? 16u : 4u);
+         for (std::size_t i = 0; i < n; i++) {
+            const auto e = static_cast<std::size_t>(x(i, 0));
+            ASSERT_LT(e, 100u);
+            EXPECT_FALSE(seen[e]);
+            seen[e] = true;
+            EXPECT_EQ(x(i, 1), -2.f * e);
+         }
+         nEvents += n;
+         nBatches++;
+      }
+      EXPECT_EQ(nEvents, 100u);
+      EXPECT_EQ(nBatches, 7u);
+      EXPECT_FALSE(gen.NextBatch());
+   }
+}
+
+TEST(RBatchGenerator, Shuffle)
+{
+   RDataFrame df(1000);
+   auto df2 = df.Define("a", [](ULong64_t e) { return double(e); }, {"rdfentry_"});
+   RBatchGenerator<float, double> gen(df2, {"a"}, 1000, 100, 1);
+   gen.StartEpoch();
+   ASSERT_TRUE(gen.NextBatch());
+   const auto &x = gen.GetBatch();
+   ASSERT_EQ(x.GetShape()[0], 1000u);
+   std::vector<float> values(x.GetData(), x.GetData() + 1000);
+   EXPECT_FALSE(std::is_sorted(values.begin(), values.end()));
+   std::sort(values.begin(), values.end());
+   for (std::size_t i = 0; i < 1000; i++)
+      EXPECT_EQ(values[i], float(i));
+   EXPECT_FALSE(gen.NextBatch());
+}
+
+TEST(RBatchGenerator, StopEpoch)
+{
+   RDataFrame df(10000);
+   auto df2 = df.Define("a", [](ULong64_t e) { return float(e); }, {"rdfentry_"});
+   RBatchGenerator<float, float> gen(df2, {"a"}, 10, 100);
+   gen.StartEpoch();
+   ASSERT_TRUE(gen.NextBatch());
+   // restarting drops the events of the running epoch
+   gen.StartEpoch();
+   std::size_t nEvents = 0;
+   while (gen.NextBatch())
+      nEvents += gen.GetBatch().GetShape()[0];
+   EXPECT_EQ(nEvents, 10000u);
+}
+
+TEST(RBatchGenerator, Errors)
+{
+   RDataFrame df(10);
+   auto df2 = df.Define("a", [](ULong64_t e) { return float(e); }, {"rdfentry_"});
+   EXPECT_THROW((RBatchGenerator<float, float, float>(df2, {"a"}, 2, 4)), std::runtime_error);
+   EXPECT_THROW((RBatchGenerator<float, float>(df2, {"a"}, 0, 4)), std::runtime_error);
+   RBatchGenerator<float, float> gen(df2, {"b"}, 2, 4);
+   gen.StartEpoch();
+   EXPECT_THROW(gen.NextBatch(), std::runtime_error);
+}
+
+TEST(RBatchGenerator, FillTensorInput)
+{
+   RTensor<float> batch({3, 4});
+   for (std::size_t i = 0; i < 3; i++)
+      for (std::size_t j = 0; j < 4; j++)
+         batch(i, j) = 10 * i + j;
+   std::vector<TMatrixT<Double_t>> inputs;
+   TMatrixT<Double_t> outputs, weights;
+   FillTensorInput(batch, 2, 1, true, inputs, outputs, weights);
+   ASSERT_EQ(inputs.size(), 1u);
+   EXPECT_EQ(inputs[0].GetNrows(), 3);
+   EXPECT_EQ(inputs[0].GetNcols(), 2);
+   EXPECT_EQ(outputs.GetNcols(), 1);
+   for (Int_t i = 0; i < 3; i++) {
+      EXPECT_EQ(inputs[0](i, 1), 10 * i + 1);
+      EXPECT_EQ(outputs(i, 0), 10 * i + 2);
+      EXPECT_EQ(weights(i, 0), 10 * i + 3);
+   }
+   FillTensorInput(batch, 3, 1, false, inputs, outputs, weights);
+   EXPECT_EQ(weights(2, 0), 1.);
+   EXPECT_THROW(FillTensorInput(batch, 3, 2, false, inputs, outputs, weights), std::runtime_error);
+}
@@ -0,0 +1,58 @@
+#include <ROOT/RDataFrame.hxx>
+#include <TMVA/RInferenceUtils.hxx>
+#include <TROOT.h>
+
+#include <gtest/gtest.h>
+
+#include <vector>
+
+using namespace TMVA::Experimental;
+
+// A model with two inputs and two outputs per event, evaluated on a fixed batch of events: y = (x1 + x2, x1 * x2)
+struct BatchModel {
+   std::size_t fBatchSize;
+   std::shared_ptr<int> fNCalls = std::make_shared<int>(0);
+   std::vector<float> operator()(const float *x)
+   {
+      ++*fNCalls;
+      std::vector<float> y(2 * fBatchSize);
+      for (std::size_t i = 0; i < fBatchSize; ++i) {
+         y[2 * i] = x[2 * i] + x[2 * i + 1];
+         y[2 * i + 1] = x[2 * i] * x[2 * i + 1];
+      }
+      return y;
+   }
+};
+
+void CheckOutputs(const std::vector<float> &y, std::size_t nEvents)
+{
+   ASSERT_EQ(y.size(), 2 * nEvents);
+   for (std::size_t i = 0; i < nEvents; ++i) {
+      EXPECT_FLOAT_EQ(y[2 * i], 3.f * i);
+      EXPECT_FLOAT_EQ(y[2 * i + 1], 2.f * i * i);
+   }
+}
+
+TEST(RInferenceUtils, BatchedCompute)
+{
+   ROOT::RDataFrame df(100);
+   auto df2 = df.Define("x1", [](ULong64_t e) { return float(e); }, {"rdfentry_"})
+                 .Define("x2", [](ULong64_t e) { return 2.f * e; }, {"rdfentry_"});
+   BatchModel model{16};
+   auto nCalls = model.fNCalls;
+   auto y = df2.Book<ULong64_t, float, float>(BatchedCompute<2, float>(std::move(model), 16), {"rdfentry_", "x1", "x2"});
+   CheckOutputs(*y, 100);
+   // 6 full batches and a partial one
+   EXPECT_EQ(*nCalls, 7);
+}
+
+TEST(RInferenceUtils, BatchedComputeMT)
+{
+   ROOT::EnableImplicitMT(4);
+   ROOT::RDataFrame df(10000);
+   auto df2 = df.Define("x1", [](ULong64_t e) { return float(e); }, {"rdfentry_"})
+                 .Define("x2", [](ULong64_t e) { return 2.f * e; }, {"rdfentry_"});
+   auto y = df2.Book<ULong64_t, float, float>(BatchedCompute<2, float>(BatchModel{64}, 64), {"rdfentry_", "x1", "x2"});
+   CheckOutputs(*y, 10000);
+   ROOT::DisableImplicitMT();
+}
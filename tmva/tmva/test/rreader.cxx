@@ -5,12 +5,15 @@
 #include <TSystem.h>
 #include <TMVA/Factory.h>
 #include <TMVA/DataLoader.h>
+#include <TMVA/Reader.h>
 
 #include <TMVA/RReader.hxx>
 #include <TMVA/RInferenceUtils.hxx>
 #include <TMVA/RTensor.hxx>
 #include <TMVA/RTensorUtils.hxx>
 
+#include <thread>
+
 using namespace TMVA::Experimental;
 
 // Classification
@@ -187,6 +190,66 @@ TEST(RReader, ClassificationComputeDataFrame)
    EXPECT_EQ(y->size(), *c);
 }
 
+// Evaluate the events of the tree with the reader, concurrently in several threads or serially
+std::vector<std::vector<float>> EvaluateReader(const std::string &model, const std::vector<std::string> &variables,
+                                               const std::string &filename, const std::string &treename,
+                                               bool multiclass, bool concurrent)
+{
+   std::vector<float> values(variables.size());
+   TMVA::Reader reader("Silent");
+   for (std::size_t i = 0; i < variables.size(); i++)
+      reader.AddVariable(variables[i], &values[i]);
+   reader.BookMVA("model", model.c_str());
+   EXPECT_TRUE(reader.HasConcurrentEvaluation("model"));
+
+   ROOT::RDataFrame df(treename, filename);
+   auto x = AsTensor<float>(df, variables);
+   const std::size_t numEntries = std::min<std::size_t>(x.GetShape()[0], 1000);
+   std::vector<std::vector<float>> y(numEntries);
+   auto evaluate = [&](std::size_t first, std::size_t step) {
+      std::vector<float> event(variables.size());
+      for (std::size_t i = first; i < numEntries; i += step) {
+         for (std::size_t j = 0; j < variables.size(); j++)
+            event[j] = x(i, j);
+         if (!concurrent) {
+            values = event;
+            if (multiclass)
+               y[i] = reader.EvaluateMulticlass("model");
+            else
+               y[i] = {static_cast<float>(reader.EvaluateMVA("model"))};
+         } else if (multiclass) {
+            y[i] = reader.EvaluateMulticlassConcurrent(event, "model");
+         } else {
+            y[i] = {static_cast<float>(reader.EvaluateMVAConcurrent(event, "model"))};
+         }
+      }
+   };
+
+   if (!concurrent) {
+      evaluate(0, 1);
+      return y;
+   }
+   const std::size_t numThreads = 4;
+   std::vector<std::thread> threads;
+   for (std::size_t t = 0; t < numThreads; t++)
+      threads.emplace_back(evaluate, t, numThreads);
+   for (auto &thread : threads)
+      thread.join();
+   return y;
+}
+
+TEST(RReader, ClassificationConcurrent)
+{
+   TrainClassificationModel();
+   const auto expected =
+      EvaluateReader(modelClassification, variablesClassification, filenameClassification, "TreeS", false, false);
+   const auto y =
+      EvaluateReader(modelClassification, variablesClassification, filenameClassification, "TreeS", false, true);
+   ASSERT_EQ(y.size(), expected.size());
+   for (std::size_t i = 0; i < y.size(); i++)
+      EXPECT_EQ(y[i], expected[i]);
+}
+
 TEST(RReader, RegressionGetVariables)
 {
    TrainRegressionModel();
@@ -281,3 +344,17 @@ TEST(RReader, MulticlassComputeDataFrame)
    auto y = df2.Take<std::vector<float>>("y");
    EXPECT_EQ(y->size(), *c);
 }
+
+TEST(RReader, MulticlassConcurrent)
+{
+   TrainMulticlassModel();
+   const auto expected =
+      EvaluateReader(modelMulticlass, variablesMulticlass, filenameMulticlass, "TreeS", true, false);
+   const auto y = EvaluateReader(modelMulticlass, variablesMulticlass, filenameMulticlass, "TreeS", true, true);
+   ASSERT_EQ(y.size(), expected.size());
+   for (std::size_t i = 0; i < y.size(); i++) {
+      ASSERT_EQ(y[i].size(), 4ul);
+      for (std::size_t k = 0; k < 4; k++)
+         EXPECT_FLOAT_EQ(y[i][k], expected[i][k]);
+   }
+}
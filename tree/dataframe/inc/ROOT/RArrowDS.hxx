@@ -15,6 +15,8 @@
 #include <memory>
 
 namespace arrow {
+class RecordBatchReader;
+class Schema;
 class Table;
 }
 
@@ -30,16 +32,24 @@ namespace RDF {
 class RArrowDS final : public RDataSource {
 private:
    std::shared_ptr<arrow::Table> fTable;
+   /// Alternative to fTable, the record batches are read from it while the event loop runs
+   std::shared_ptr<arrow::RecordBatchReader> fBatchReader;
+   std::shared_ptr<arrow::Schema> fSchema;
    std::vector<std::pair<ULong64_t, ULong64_t>> fEntryRanges;
    std::vector<std::string> fColumnNames;
    size_t fNSlots = 0U;
+   ULong64_t fNStreamedEntries = 0ULL; // the entries of the batches read from fBatchReader so far
+   bool fBatchReaderUsed = false;      // the batches of fBatchReader can only be read in one event loop
 
    std::vector<std::pair<size_t, size_t>> fGetterIndex; // (columnId, visitorId)
    std::vector<std::unique_ptr<ROOT::Internal::RDF::TValueGetter>> fValueGetters; // Visitors to be used to track and get entries. One per column.
    std::vector<void *> GetColumnReadersImpl(std::string_view name, const std::type_info &type) override;
+   void VerifyColumns();
+   std::vector<std::pair<ULong64_t, ULong64_t>> ReadNextBatches();
 
 public:
    RArrowDS(std::shared_ptr<arrow::Table> table, std::vector<std::string> const &columns);
+   RArrowDS(std::shared_ptr<arrow::RecordBatchReader> batchReader, std::vector<std::string> const &columns);
    ~RArrowDS();
    const std::vector<std::string> &GetColumnNames() const override;
    std::vector<std::pair<ULong64_t, ULong64_t>> GetEntryRanges() override;
@@ -49,6 +59,7 @@ public:
    void InitSlot(unsigned int slot, ULong64_t firstEntry) override;
    void SetNSlots(unsigned int nSlots) override;
    void Initialise() override;
+   void Finalise() override;
    std::string GetLabel() override;
 };
 
@@ -57,6 +68,12 @@ public:
 /// \param[in] table an apache::arrow table to use as a source.
 RDataFrame MakeArrowDataFrame(std::shared_ptr<arrow::Table> table, std::vector<std::string> const &columns);
 
+////////////////////////////////////////////////////////////////////////////////////////////////
+/// \brief Factory method to create a Apache Arrow RDataFrame reading a stream of record batches.
+/// \param[in] batchReader the reader of the record batches, e.g. of an IPC file or of a Parquet dataset.
+RDataFrame
+MakeArrowDataFrame(std::shared_ptr<arrow::RecordBatchReader> batchReader, std::vector<std::string> const &columns);
+
 } // namespace RDF
 
 } // namespace ROOT
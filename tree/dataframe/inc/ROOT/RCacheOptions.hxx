@@ -0,0 +1,30 @@
+/*************************************************************************
+ * Copyright (C) 1995-2021, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#ifndef ROOT_RCACHEOPTIONS
+#define ROOT_RCACHEOPTIONS
+
+#include <cstddef> // std::size_t
+#include <string>
+
+namespace ROOT {
+
+namespace RDF {
+/// A collection of options to steer where RInterface::Cache stores the cached dataset
+struct RCacheOptions {
+   /// Maximum size in bytes of the cached values held in memory. Once it is exceeded while the cache is filled, the
+   /// cached columns are written to temporary ROOT files instead. 0 means no limit.
+   std::size_t fMemoryBudget = 0;
+   /// Directory of the temporary files used when the memory budget is exceeded. If empty, the directory returned
+   /// by gSystem->TempDirectory() is used.
+   std::string fSpillDirectory;
+};
+} // ns RDF
+} // ns ROOT
+
+#endif
@@ -14,11 +14,13 @@
 #include "ROOT/RDataFrame.hxx"
 #include "ROOT/RDataSource.hxx"
 
+#include <cstddef>
 #include <cstdint>
 #include <deque>
-#include <list>
 #include <map>
 #include <memory>
+#include <string>
+#include <utility>
 #include <vector>
 
 #include <TRegexp.h>
@@ -41,19 +43,35 @@ private:
    // Regular expressions for type inference
    static const TRegexp fgIntRegex, fgDoubleRegex1, fgDoubleRegex2, fgDoubleRegex3, fgTrueRegex, fgFalseRegex;
 
+   /// The values of the entry range that a slot is processing. They are parsed from the lines of the current chunk
+   /// by the thread of the slot at the first SetEntry of the range, directly into one buffer per column of the type of
+   /// the column; the buffers of the columns of the other types stay empty.
+   struct RSlotValues {
+      ULong64_t fFirstEntry = 0ULL;
+      ULong64_t fNEntries = 0ULL;
+      std::vector<std::vector<double>> fDoubles;      // [column][entry - fFirstEntry]
+      std::vector<std::vector<Long64_t>> fLong64s;    // [column][entry - fFirstEntry]
+      std::vector<std::vector<std::string>> fStrings; // [column][entry - fFirstEntry]
+      std::vector<std::vector<char>> fBools;          // [column][entry - fFirstEntry]
+   };
+
    std::uint64_t fDataPos = 0;
    bool fReadHeaders = false;
    unsigned int fNSlots = 0U;
    std::unique_ptr<ROOT::Internal::RRawFile> fCsvFile;
    const char fDelimiter;
    const Long64_t fLinesChunkSize;
-   ULong64_t fEntryRangesRequested = 0ULL;
    ULong64_t fProcessedLines = 0ULL; // marks the progress of the consumption of the csv lines
+   std::string fChunk;               // the bytes of the file read so far and not consumed by a previous chunk of lines
+   std::uint64_t fChunkPos = 0;      // the offset in the file of the beginning of fChunk
+   std::size_t fChunkEnd = 0;        // the end in fChunk of the lines of the current chunk
+   std::vector<std::pair<std::size_t, std::size_t>> fLines; // begin and end in fChunk of the non-empty lines
+   std::vector<std::pair<ULong64_t, ULong64_t>> fEntryRanges; // the ones returned by the last GetEntryRanges
+   std::vector<RSlotValues> fSlotValues;                    // one per slot
    std::vector<std::string> fHeaders;
    std::map<std::string, ColType_t> fColTypes;
-   std::list<ColType_t> fColTypesList;
+   std::vector<ColType_t> fColTypesList;
    std::vector<std::vector<void *>> fColAddresses;         // fColAddresses[column][slot]
-   std::vector<Record_t> fRecords;                         // fRecords[entry][column]
    std::vector<std::vector<double>> fDoubleEvtValues;      // one per column per slot
    std::vector<std::vector<Long64_t>> fLong64EvtValues;    // one per column per slot
    std::vector<std::vector<std::string>> fStringEvtValues; // one per column per slot
@@ -62,13 +80,15 @@ private:
    std::vector<std::deque<bool>> fBoolEvtValues; // one per column per slot
 
    void FillHeaders(const std::string &);
-   void FillRecord(const std::string &, Record_t &);
    void GenerateHeaders(size_t);
    std::vector<void *> GetColumnReadersImpl(std::string_view, const std::type_info &);
    void InferColTypes(std::vector<std::string> &);
    void InferType(const std::string &, unsigned int);
    std::vector<std::string> ParseColumns(const std::string &);
-   size_t ParseValue(const std::string &, std::vector<std::string> &, size_t);
+   size_t ParseValue(std::string_view, size_t, std::string &, std::string_view &) const;
+   void ParseLine(std::string_view, RSlotValues &, ULong64_t, std::string &) const;
+   void ParseEntryRange(unsigned int, ULong64_t);
+   void ReadChunk();
    ColType_t GetType(std::string_view colName) const;
 
 protected:
@@ -94,6 +114,8 @@ public:
 /// \param[in] readHeaders `true` if the CSV file contains headers as first row, `false` otherwise
 ///                        (default `true`).
 /// \param[in] delimiter Delimiter character (default ',').
+/// \param[in] linesChunkSize Number of lines read and processed at a time, -1 to read chunks of a few megabytes of the
+///                           file per slot (default -1).
 RDataFrame MakeCsvDataFrame(std::string_view fileName, bool readHeaders = true, char delimiter = ',',
                             Long64_t linesChunkSize = -1LL);
 
@@ -22,6 +22,7 @@
 #include "Compression.h"
 #include "ROOT/RStringView.hxx"
 #include "ROOT/RVec.hxx"
+#include "ROOT/TH1ConcurrentFill.hxx"
 #include "ROOT/TBufferMerger.hxx" // for SnapshotHelper
 #include "ROOT/RDF/RCutFlowReport.hxx"
 #include "ROOT/RDF/Utils.hxx"
@@ -44,11 +45,14 @@
 #include "ROOT/RDF/RMergeableValue.hxx"
 
 #include <algorithm>
+#include <atomic>
 #include <functional>
+#include <iterator>
 #include <limits>
 #include <memory>
 #include <stdexcept>
 #include <string>
+#include <tuple>
 #include <type_traits>
 #include <utility> // std::index_sequence
 #include <vector>
@@ -58,6 +62,8 @@
 /// \cond HIDDEN_SYMBOLS
 
 namespace ROOT {
+class RDataFrame;
+
 namespace Detail {
 namespace RDF {
 template <typename Helper>
@@ -81,6 +87,10 @@ public:
    }
 
    virtual std::function<void(unsigned int)> GetDataBlockCallback() { return {}; }
+
+   /// Whether the action can run in batched execution, see RDataFrame::SetBatchSize. Helpers that need the address
+   /// of the input values to stay the same for all entries (e.g. because it is passed to a TTree branch) return false.
+   bool SupportsBatchedExecution() const { return true; }
 };
 
 } // namespace RDF
@@ -187,6 +197,12 @@ public:
    ULong64_t &PartialUpdate(unsigned int slot);
 
    std::string GetActionName() { return "Count"; }
+
+   CountHelper MakeNew(void *newResult)
+   {
+      auto &result = *static_cast<std::shared_ptr<ULong64_t> *>(newResult);
+      return CountHelper(result, fCounts.size());
+   }
 };
 
 template <typename ProxiedVal_t>
@@ -305,6 +321,12 @@ public:
    }
 
    std::string GetActionName() { return "Fill"; }
+
+   FillHelper MakeNew(void *newResult)
+   {
+      auto &result = *static_cast<std::shared_ptr<Hist_t> *>(newResult);
+      return FillHelper(result, fNSlots);
+   }
 };
 
 extern template void FillHelper::Exec(unsigned int, const std::vector<float> &);
@@ -322,6 +344,11 @@ FillHelper::Exec(unsigned int, const std::vector<unsigned int> &, const std::vec
 template <typename HIST = Hist_t>
 class FillParHelper : public RActionImpl<FillParHelper<HIST>> {
    std::vector<HIST *> fObjects;
+   /// Non-null if the slots fill the histogram of the first slot concurrently rather than their own clones of it
+   std::unique_ptr<ROOT::Experimental::TH1ConcurrentFillManager<HIST>> fFillManager;
+   std::vector<ROOT::Experimental::TH1ConcurrentFiller<HIST>> fFillers;
+   /// With concurrent filling, the copies of the shared histogram handed out by PartialUpdate, one per slot
+   std::vector<std::unique_ptr<HIST>> fSnapshots;
 
    void UnsetDirectoryIfPossible(TH1 *h) {
       h->SetDirectory(nullptr);
@@ -329,6 +356,53 @@ class FillParHelper : public RActionImpl<FillParHelper<HIST>> {
 
    void UnsetDirectoryIfPossible(...) {}
 
+   // Large histograms of the TH1 family are filled concurrently, see ROOT::RDF::Experimental::SetConcurrentFillThreshold
+   template <typename H = HIST, std::enable_if_t<std::is_base_of<TH1, H>::value, int> = 0>
+   void SetupConcurrentFill(unsigned int nSlots)
+   {
+      const auto threshold = GetConcurrentFillThreshold();
+      if (nSlots == 1 || threshold == 0 || ULong64_t(fObjects[0]->GetNcells()) < threshold)
+         return;
+      fFillManager.reset(new ROOT::Experimental::TH1ConcurrentFillManager<HIST>(*fObjects[0]));
+      for (unsigned int i = 0; i < nSlots; ++i)
+         fFillers.emplace_back(fFillManager->MakeFiller());
+      fSnapshots.resize(nSlots);
+   }
+
+   template <typename H = HIST, std::enable_if_t<!std::is_base_of<TH1, H>::value, int> = 0>
+   void SetupConcurrentFill(unsigned int)
+   {
+   }
+
+   template <typename H = HIST, std::enable_if_t<std::is_base_of<TH1, H>::value, int> = 0>
+   HIST &PartialSnapshot(unsigned int slot)
+   {
+      fFillers[slot].Flush();
+      fSnapshots[slot] = fFillManager->Snapshot();
+      return *fSnapshots[slot];
+   }
+
+   template <typename H = HIST, std::enable_if_t<!std::is_base_of<TH1, H>::value, int> = 0>
+   HIST &PartialSnapshot(unsigned int slot)
+   {
+      return *fObjects[slot];
+   }
+
+   template <typename... Xs, typename H = HIST, std::enable_if_t<std::is_base_of<TH1, H>::value, int> = 0>
+   void FillSlot(unsigned int slot, const Xs &... xs)
+   {
+      if (fFillers.empty())
+         fObjects[slot]->Fill(xs...);
+      else
+         fFillers[slot].Fill(xs...);
+   }
+
+   template <typename... Xs, typename H = HIST, std::enable_if_t<!std::is_base_of<TH1, H>::value, int> = 0>
+   void FillSlot(unsigned int slot, const Xs &... xs)
+   {
+      fObjects[slot]->Fill(xs...);
+   }
+
    // Merge overload for types with Merge(TCollection*), like TH1s
    template <typename H, typename = std::enable_if_t<std::is_base_of<TObject, H>::value, int>>
    auto Merge(std::vector<H *> &objs, int /*toincreaseoverloadpriority*/)
@@ -363,6 +437,9 @@ public:
    FillParHelper(const std::shared_ptr<HIST> &h, const unsigned int nSlots) : fObjects(nSlots, nullptr)
    {
       fObjects[0] = h.get();
+      SetupConcurrentFill(nSlots);
+      if (fFillManager)
+         return;
       // Initialise all other slots
       for (unsigned int i = 1; i < nSlots; ++i) {
          fObjects[i] = new HIST(*fObjects[0]);
@@ -374,30 +451,29 @@ public:
 
    void Exec(unsigned int slot, double x0) // 1D histos
    {
-      fObjects[slot]->Fill(x0);
+      FillSlot(slot, x0);
    }
 
    void Exec(unsigned int slot, double x0, double x1) // 1D weighted and 2D histos
    {
-      fObjects[slot]->Fill(x0, x1);
+      FillSlot(slot, x0, x1);
    }
 
    void Exec(unsigned int slot, double x0, double x1, double x2) // 2D weighted and 3D histos
    {
-      fObjects[slot]->Fill(x0, x1, x2);
+      FillSlot(slot, x0, x1, x2);
    }
 
    void Exec(unsigned int slot, double x0, double x1, double x2, double x3) // 3D weighted histos
    {
-      fObjects[slot]->Fill(x0, x1, x2, x3);
+      FillSlot(slot, x0, x1, x2, x3);
    }
 
    template <typename X0, std::enable_if_t<IsDataContainer<X0>::value || std::is_same<X0, std::string>::value, int> = 0>
    void Exec(unsigned int slot, const X0 &x0s)
    {
-      auto thisSlotH = fObjects[slot];
       for (auto x0 = x0s.begin(); x0 != x0s.end(); x0++) {
-         thisSlotH->Fill(*x0); // TODO: Can be optimised in case T == vector<double>
+         FillSlot(slot, *x0); // TODO: Can be optimised in case T == vector<double>
       }
    }
 
@@ -414,7 +490,6 @@ public:
              std::enable_if_t<IsDataContainer<X0>::value && IsDataContainer<X1>::value, int> = 0>
    void Exec(unsigned int slot, const X0 &x0s, const X1 &x1s)
    {
-      auto thisSlotH = fObjects[slot];
       if (x0s.size() != x1s.size()) {
          throw std::runtime_error("Cannot fill histogram with values in containers of different sizes.");
       }
@@ -422,7 +497,7 @@ public:
       const auto x0sEnd = std::end(x0s);
       auto x1sIt = std::begin(x1s);
       for (; x0sIt != x0sEnd; x0sIt++, x1sIt++) {
-         thisSlotH->Fill(*x0sIt, *x1sIt); // TODO: Can be optimised in case T == vector<double>
+         FillSlot(slot, *x0sIt, *x1sIt); // TODO: Can be optimised in case T == vector<double>
       }
    }
 
@@ -430,9 +505,8 @@ public:
              std::enable_if_t<IsDataContainer<X0>::value && !IsDataContainer<W>::value, int> = 0>
    void Exec(unsigned int slot, const X0 &x0s, const W w)
    {
-      auto thisSlotH = fObjects[slot];
       for (auto &&x : x0s) {
-         thisSlotH->Fill(x, w);
+         FillSlot(slot, x, w);
       }
    }
 
@@ -441,7 +515,6 @@ public:
       std::enable_if_t<IsDataContainer<X0>::value && IsDataContainer<X1>::value && IsDataContainer<X2>::value, int> = 0>
    void Exec(unsigned int slot, const X0 &x0s, const X1 &x1s, const X2 &x2s)
    {
-      auto thisSlotH = fObjects[slot];
       if (!(x0s.size() == x1s.size() && x1s.size() == x2s.size())) {
          throw std::runtime_error("Cannot fill histogram with values in containers of different sizes.");
       }
@@ -450,7 +523,7 @@ public:
       auto x1sIt = std::begin(x1s);
       auto x2sIt = std::begin(x2s);
       for (; x0sIt != x0sEnd; x0sIt++, x1sIt++, x2sIt++) {
-         thisSlotH->Fill(*x0sIt, *x1sIt, *x2sIt); // TODO: Can be optimised in case T == vector<double>
+         FillSlot(slot, *x0sIt, *x1sIt, *x2sIt); // TODO: Can be optimised in case T == vector<double>
       }
    }
 
@@ -459,7 +532,6 @@ public:
       std::enable_if_t<IsDataContainer<X0>::value && IsDataContainer<X1>::value && !IsDataContainer<W>::value, int> = 0>
    void Exec(unsigned int slot, const X0 &x0s, const X1 &x1s, const W w)
    {
-      auto thisSlotH = fObjects[slot];
       if (x0s.size() != x1s.size()) {
          throw std::runtime_error("Cannot fill histogram with values in containers of different sizes.");
       }
@@ -467,7 +539,7 @@ public:
       const auto x0sEnd = std::end(x0s);
       auto x1sIt = std::begin(x1s);
       for (; x0sIt != x0sEnd; x0sIt++, x1sIt++) {
-         thisSlotH->Fill(*x0sIt, *x1sIt, w); // TODO: Can be optimised in case T == vector<double>
+         FillSlot(slot, *x0sIt, *x1sIt, w); // TODO: Can be optimised in case T == vector<double>
       }
    }
 
@@ -477,7 +549,6 @@ public:
                               int> = 0>
    void Exec(unsigned int slot, const X0 &x0s, const X1 &x1s, const X2 &x2s, const X3 &x3s)
    {
-      auto thisSlotH = fObjects[slot];
       if (!(x0s.size() == x1s.size() && x1s.size() == x2s.size() && x1s.size() == x3s.size())) {
          throw std::runtime_error("Cannot fill histogram with values in containers of different sizes.");
       }
@@ -487,7 +558,7 @@ public:
       auto x2sIt = std::begin(x2s);
       auto x3sIt = std::begin(x3s);
       for (; x0sIt != x0sEnd; x0sIt++, x1sIt++, x2sIt++, x3sIt++) {
-         thisSlotH->Fill(*x0sIt, *x1sIt, *x2sIt, *x3sIt); // TODO: Can be optimised in case T == vector<double>
+         FillSlot(slot, *x0sIt, *x1sIt, *x2sIt, *x3sIt); // TODO: Can be optimised in case T == vector<double>
       }
    }
 
@@ -497,7 +568,6 @@ public:
                               int> = 0>
    void Exec(unsigned int slot, const X0 &x0s, const X1 &x1s, const X2 &x2s, const W w)
    {
-      auto thisSlotH = fObjects[slot];
       if (!(x0s.size() == x1s.size() && x1s.size() == x2s.size())) {
          throw std::runtime_error("Cannot fill histogram with values in containers of different sizes.");
       }
@@ -506,17 +576,29 @@ public:
       auto x1sIt = std::begin(x1s);
       auto x2sIt = std::begin(x2s);
       for (; x0sIt != x0sEnd; x0sIt++, x1sIt++, x2sIt++) {
-         thisSlotH->Fill(*x0sIt, *x1sIt, *x2sIt, w);
+         FillSlot(slot, *x0sIt, *x1sIt, *x2sIt, w);
       }
    }
 
    void Initialize() { /* noop */}
 
+   void FinalizeTask(unsigned int slot)
+   {
+      if (!fFillers.empty())
+         fFillers[slot].Flush();
+   }
+
    void Finalize()
    {
       if (fObjects.size() == 1)
          return;
 
+      if (fFillManager) {
+         for (auto &filler : fFillers)
+            filler.Flush();
+         return;
+      }
+
       Merge(fObjects, /*toselectcorrectoverload=*/0);
 
       // delete the copies we created for the slots other than the first
@@ -524,7 +606,13 @@ public:
          delete *it;
    }
 
-   HIST &PartialUpdate(unsigned int slot) { return *fObjects[slot]; }
+   /// With concurrent filling, the partial result is a copy of the shared histogram made while no slot fills it
+   HIST &PartialUpdate(unsigned int slot)
+   {
+      if (fFillManager)
+         return PartialSnapshot(slot);
+      return *fObjects[slot];
+   }
 
    // Helper functions for RMergeableValue
    std::unique_ptr<RMergeableValueBase> GetMergeableValue() const final
@@ -533,6 +621,12 @@ public:
    }
 
    std::string GetActionName() { return "FillPar"; }
+
+   FillParHelper MakeNew(void *newResult)
+   {
+      auto &result = *static_cast<std::shared_ptr<HIST> *>(newResult);
+      return FillParHelper(result, fObjects.size());
+   }
 };
 
 class FillTGraphHelper : public ROOT::Detail::RDF::RActionImpl<FillTGraphHelper> {
@@ -859,6 +953,12 @@ public:
    ResultType &PartialUpdate(unsigned int slot) { return fMins[slot]; }
 
    std::string GetActionName() { return "Min"; }
+
+   MinHelper MakeNew(void *newResult)
+   {
+      auto &result = *static_cast<std::shared_ptr<ResultType> *>(newResult);
+      return MinHelper(result, fMins.size());
+   }
 };
 
 // TODO
@@ -910,6 +1010,12 @@ public:
    ResultType &PartialUpdate(unsigned int slot) { return fMaxs[slot]; }
 
    std::string GetActionName() { return "Max"; }
+
+   MaxHelper MakeNew(void *newResult)
+   {
+      auto &result = *static_cast<std::shared_ptr<ResultType> *>(newResult);
+      return MaxHelper(result, fMaxs.size());
+   }
 };
 
 // TODO
@@ -974,6 +1080,12 @@ public:
    ResultType &PartialUpdate(unsigned int slot) { return fSums[slot]; }
 
    std::string GetActionName() { return "Sum"; }
+
+   SumHelper MakeNew(void *newResult)
+   {
+      auto &result = *static_cast<std::shared_ptr<ResultType> *>(newResult);
+      return SumHelper(result, fSums.size());
+   }
 };
 
 class MeanHelper : public RActionImpl<MeanHelper> {
@@ -1012,6 +1124,12 @@ public:
    double &PartialUpdate(unsigned int slot);
 
    std::string GetActionName() { return "Mean"; }
+
+   MeanHelper MakeNew(void *newResult)
+   {
+      auto &result = *static_cast<std::shared_ptr<double> *>(newResult);
+      return MeanHelper(result, fSums.size());
+   }
 };
 
 extern template void MeanHelper::Exec(unsigned int, const std::vector<float> &);
@@ -1060,6 +1178,12 @@ public:
    }
 
    std::string GetActionName() { return "StdDev"; }
+
+   StdDevHelper MakeNew(void *newResult)
+   {
+      auto &result = *static_cast<std::shared_ptr<double> *>(newResult);
+      return StdDevHelper(result, fNSlots);
+   }
 };
 
 extern template void StdDevHelper::Exec(unsigned int, const std::vector<float> &);
@@ -1454,6 +1578,9 @@ public:
 
    std::string GetActionName() { return "Snapshot"; }
 
+   /// The addresses of the input values are passed to the output branches: they must not change at every entry.
+   bool SupportsBatchedExecution() const { return false; }
+
    std::function<void(unsigned int)> GetDataBlockCallback() final
    {
       return [this](unsigned int) mutable { fBranchAddressesNeedReset = true; };
@@ -1628,12 +1755,334 @@ public:
 
    std::string GetActionName() { return "Snapshot"; }
 
+   /// The addresses of the input values are passed to the output branches: they must not change at every entry.
+   bool SupportsBatchedExecution() const { return false; }
+
    std::function<void(unsigned int)> GetDataBlockCallback() final
    {
       return [this](unsigned int slot) mutable { fBranchAddressesNeedReset[slot] = 1; };
    }
 };
 
+/// Writes the entries of a Snapshot to an RNTuple or a Parquet file, see SnapshotWriterHelper.
+/// The implementations live in RDFSnapshotRNTuple.cxx and RDFSnapshotParquet.cxx, so that the RDataFrame headers do
+/// not depend on RNTuple or Parquet.
+class RSnapshotWriter {
+public:
+   virtual ~RSnapshotWriter() = default;
+   /// Write an entry. addresses holds the address of the value of each output field, in order.
+   /// Different slots can call this concurrently.
+   virtual void Fill(unsigned int slot, void *const *addresses) = 0;
+   /// Commit the data of all slots and replace the dataframe returned by Snapshot with one that reads the output
+   virtual void Finalize() = 0;
+};
+
+/// Throw if the options or the output directory are not supported by RNTuple outputs, or if ROOT was built without
+/// RNTuple support.
+void ValidateRNTupleSnapshotOutput(const RSnapshotOptions &opts, const std::string &dirName);
+
+/// Create the RNTuple in the output file. With more than one slot, every slot fills its own clusters, which are
+/// compressed in parallel and written to the same file.
+std::unique_ptr<RSnapshotWriter>
+MakeRNTupleSnapshotWriter(unsigned int nSlots, const std::string &fileName, const std::string &ntupleName,
+                          const ColumnNames_t &fieldNames, const std::vector<std::string> &typeNames,
+                          const RSnapshotOptions &opts, const std::shared_ptr<ROOT::RDataFrame> &outputDataFrame);
+
+/// Throw if the options or the output directory are not supported by Parquet outputs, or if ROOT was built without
+/// Parquet support.
+void ValidateParquetSnapshotOutput(const RSnapshotOptions &opts, const std::string &dirName);
+
+/// Create the Parquet output file. Every slot buffers its own row groups, which are encoded in parallel and written
+/// to the file one at a time.
+std::unique_ptr<RSnapshotWriter>
+MakeParquetSnapshotWriter(unsigned int nSlots, const std::string &fileName, const ColumnNames_t &columnNames,
+                          const std::vector<std::string> &typeNames, const RSnapshotOptions &opts,
+                          const std::shared_ptr<ROOT::RDataFrame> &outputDataFrame);
+
+/// Provides the value of a column to an RNTuple field or a Parquet column: by default, the address of the value
+/// itself...
+template <typename T>
+struct SnapshotWriterValue {
+   static std::string GetTypeName(bool /*rvecAsVector*/) { return TypeID2TypeName(typeid(T)); }
+   void *GetAddress(T &value, bool /*rvecAsVector*/) { return &value; }
+};
+
+/// ...while RVecs, which have no RNTuple field yet, are copied into a std::vector for RNTuple outputs
+template <typename T>
+struct SnapshotWriterValue<RVec<T>> {
+   std::vector<T> fBuffer;
+   static std::string GetTypeName(bool rvecAsVector)
+   {
+      return rvecAsVector ? TypeID2TypeName(typeid(std::vector<T>)) : TypeID2TypeName(typeid(RVec<T>));
+   }
+   void *GetAddress(RVec<T> &value, bool rvecAsVector)
+   {
+      if (!rvecAsVector)
+         return &value;
+      fBuffer.assign(value.begin(), value.end());
+      return &fBuffer;
+   }
+};
+
+/// Helper object for a Snapshot action that writes an RNTuple or a Parquet file, in single- and multi-thread runs
+template <typename... ColTypes>
+class SnapshotWriterHelper : public RActionImpl<SnapshotWriterHelper<ColTypes...>> {
+   const unsigned int fNSlots;
+   const std::string fFileName;
+   const std::string fNTupleName;
+   const RSnapshotOptions fOptions;
+   const ColumnNames_t fOutputFieldNames;
+   const bool fRVecAsVector; // RNTuple outputs write RVecs as std::vectors
+   std::shared_ptr<ROOT::RDataFrame> fOutputDataFrame; // replaced by a dataframe reading the output in Finalize
+   std::unique_ptr<RSnapshotWriter> fWriter;
+   std::vector<std::tuple<SnapshotWriterValue<ColTypes>...>> fValues; // per slot
+
+   template <std::size_t... S>
+   void FillImpl(unsigned int slot, ColTypes &...values, std::index_sequence<S...> /*dummy*/)
+   {
+      // the trailing nullptr avoids a zero-sized array
+      void *const addresses[] = {std::get<S>(fValues[slot]).GetAddress(values, fRVecAsVector)..., nullptr};
+      fWriter->Fill(slot, addresses);
+   }
+
+public:
+   using ColumnTypes_t = TypeList<ColTypes...>;
+   SnapshotWriterHelper(unsigned int nSlots, std::string_view filename, std::string_view dirname,
+                        std::string_view ntuplename, const ColumnNames_t & /*vbnames*/, const ColumnNames_t &bnames,
+                        const RSnapshotOptions &options, const std::shared_ptr<ROOT::RDataFrame> &outputDataFrame)
+      : fNSlots(nSlots), fFileName(filename), fNTupleName(ntuplename), fOptions(options),
+        fOutputFieldNames(ReplaceDotWithUnderscore(bnames)),
+        fRVecAsVector(options.fOutputFormat == ESnapshotOutputFormat::kRNTuple), fOutputDataFrame(outputDataFrame),
+        fValues(fNSlots)
+   {
+      if (fOptions.fOutputFormat == ESnapshotOutputFormat::kParquet)
+         ValidateParquetSnapshotOutput(fOptions, std::string(dirname));
+      else
+         ValidateRNTupleSnapshotOutput(fOptions, std::string(dirname));
+   }
+   SnapshotWriterHelper(const SnapshotWriterHelper &) = delete;
+   SnapshotWriterHelper(SnapshotWriterHelper &&) = default;
+
+   void InitTask(TTreeReader *, unsigned int) {}
+
+   void Exec(unsigned int slot, ColTypes &...values)
+   {
+      FillImpl(slot, values..., std::index_sequence_for<ColTypes...>{});
+   }
+
+   void Initialize()
+   {
+      const std::vector<std::string> typeNames{SnapshotWriterValue<ColTypes>::GetTypeName(fRVecAsVector)...};
+      if (fOptions.fOutputFormat == ESnapshotOutputFormat::kParquet) {
+         fWriter = MakeParquetSnapshotWriter(fNSlots, fFileName, fOutputFieldNames, typeNames, fOptions,
+                                             fOutputDataFrame);
+      } else {
+         fWriter = MakeRNTupleSnapshotWriter(fNSlots, fFileName, fNTupleName, fOutputFieldNames, typeNames, fOptions,
+                                             fOutputDataFrame);
+      }
+   }
+
+   void Finalize()
+   {
+      fWriter->Finalize();
+      fWriter.reset();
+   }
+
+   std::string GetActionName() { return "Snapshot"; }
+};
+
+/// Return the name of a new temporary ROOT file in the given directory, or in gSystem->TempDirectory() if empty.
+std::string MakeCacheSpillFileName(const std::string &dirName);
+
+// Estimated memory used by a cached value, including the elements held by collections and strings
+template <typename T>
+std::size_t GetCachedValueSize(const T &)
+{
+   return sizeof(T);
+}
+
+template <typename T>
+std::size_t GetCachedValueSize(const RVec<T> &v)
+{
+   return sizeof(v) + v.size() * sizeof(T);
+}
+
+template <typename T, typename A>
+std::size_t GetCachedValueSize(const std::vector<T, A> &v)
+{
+   return sizeof(v) + v.size() * sizeof(T);
+}
+
+inline std::size_t GetCachedValueSize(const std::string &s)
+{
+   return sizeof(s) + s.size();
+}
+
+/// Helper object for a Cache action with a memory budget.
+/// The values are kept in memory, counting the memory they use, until the budget is exceeded. From then on each slot
+/// writes the values it holds, and all the following ones, to a TTree in a temporary file of its own. The result is
+/// the list of temporary files: if it is empty, the cached columns are in the output vectors.
+template <typename... ColTypes>
+class CacheHelper : public RActionImpl<CacheHelper<ColTypes...>> {
+public:
+   using Result_t = std::vector<std::string>;
+
+private:
+   /// The state of a processing slot
+   struct RSlotCache {
+      std::tuple<std::vector<ColTypes>...> fValues; ///< Values held in memory
+      std::tuple<ColTypes...> fSpilledValues;        ///< Addresses of the branches of fTree
+      std::unique_ptr<TFile> fFile;
+      std::unique_ptr<TTree> fTree; // must be destroyed before fFile
+      std::string fFileName;
+   };
+
+   std::tuple<std::shared_ptr<std::vector<ColTypes>>...> fCachedColumns;
+   std::shared_ptr<Result_t> fSpillFiles;
+   const ColumnNames_t fColumnNames;
+   const std::size_t fMemoryBudget;
+   const std::string fSpillDirectory;
+   std::vector<RSlotCache> fSlots;
+   // atomics are not movable
+   std::unique_ptr<std::atomic<std::size_t>> fMemoryUsed;
+   std::unique_ptr<std::atomic<bool>> fSpill;
+
+   template <std::size_t... S>
+   void Store(RSlotCache &slotCache, ColTypes &...values, std::index_sequence<S...>)
+   {
+      int expander[] = {(std::get<S>(slotCache.fValues).emplace_back(values), 0)..., 0};
+      (void)expander; // avoid unused variable warnings for older compilers such as gcc 4.9
+   }
+
+   template <std::size_t... S>
+   void Write(RSlotCache &slotCache, ColTypes &...values, std::index_sequence<S...>)
+   {
+      int expander[] = {(std::get<S>(slotCache.fSpilledValues) = values, 0)..., 0};
+      (void)expander;
+      slotCache.fTree->Fill();
+   }
+
+   template <std::size_t... S>
+   void OpenSpillFile(RSlotCache &slotCache, std::index_sequence<S...>)
+   {
+      slotCache.fFileName = MakeCacheSpillFileName(fSpillDirectory);
+      TDirectory::TContext ctxt; // TFile::Open changes gDirectory
+      slotCache.fFile.reset(TFile::Open(slotCache.fFileName.c_str(), "RECREATE"));
+      if (!slotCache.fFile || slotCache.fFile->IsZombie())
+         throw std::runtime_error("Cache: could not create temporary file " + slotCache.fFileName);
+      slotCache.fTree = std::make_unique<TTree>("rdf_cache", "rdf_cache", 99, slotCache.fFile.get());
+      int expander[] = {(slotCache.fTree->Branch(fColumnNames[S].c_str(), &std::get<S>(slotCache.fSpilledValues)),
+                         0)...,
+                        0};
+      (void)expander;
+   }
+
+   // Open the spill file of the slot and move the values held in memory there
+   template <std::size_t... S>
+   void Spill(RSlotCache &slotCache, std::index_sequence<S...> seq)
+   {
+      OpenSpillFile(slotCache, seq);
+      const auto nEntries = std::get<0>(slotCache.fValues).size();
+      for (std::size_t i = 0; i < nEntries; ++i) {
+         int expander[] = {
+            (std::get<S>(slotCache.fSpilledValues) = std::move(std::get<S>(slotCache.fValues)[i]), 0)..., 0};
+         (void)expander;
+         slotCache.fTree->Fill();
+      }
+      int expander[] = {(std::vector<ColTypes>().swap(std::get<S>(slotCache.fValues)), 0)..., 0};
+      (void)expander;
+   }
+
+   // Move the values held in memory by the slots to the cached column
+   template <std::size_t S, typename T>
+   void MergeColumn(std::vector<T> &column, std::integral_constant<std::size_t, S>)
+   {
+      std::size_t size = 0u;
+      for (auto &slotCache : fSlots)
+         size += std::get<S>(slotCache.fValues).size();
+      column.reserve(size);
+      for (auto &slotCache : fSlots) {
+         auto &values = std::get<S>(slotCache.fValues);
+         std::move(values.begin(), values.end(), std::back_inserter(column));
+         std::vector<T>().swap(values);
+      }
+   }
+
+   template <std::size_t... S>
+   void MergeColumns(std::index_sequence<S...>)
+   {
+      int expander[] = {(MergeColumn(*std::get<S>(fCachedColumns), std::integral_constant<std::size_t, S>{}), 0)...,
+                        0};
+      (void)expander;
+   }
+
+public:
+   using ColumnTypes_t = TypeList<ColTypes...>;
+   CacheHelper(const std::tuple<std::shared_ptr<std::vector<ColTypes>>...> &cachedColumns,
+               const std::shared_ptr<Result_t> &spillFiles, const ColumnNames_t &columnNames, std::size_t memoryBudget,
+               const std::string &spillDirectory, unsigned int nSlots)
+      : fCachedColumns(cachedColumns), fSpillFiles(spillFiles), fColumnNames(columnNames), fMemoryBudget(memoryBudget),
+        fSpillDirectory(spillDirectory), fSlots(nSlots), fMemoryUsed(new std::atomic<std::size_t>(0u)),
+        fSpill(new std::atomic<bool>(false))
+   {
+   }
+   CacheHelper(const CacheHelper &) = delete;
+   CacheHelper(CacheHelper &&) = default;
+
+   void InitTask(TTreeReader *, unsigned int) {}
+
+   void Exec(unsigned int slot, ColTypes &...values)
+   {
+      using ind_t = std::index_sequence_for<ColTypes...>;
+      auto &slotCache = fSlots[slot];
+      if (!slotCache.fTree && *fSpill)
+         Spill(slotCache, ind_t{});
+
+      if (slotCache.fTree) {
+         Write(slotCache, values..., ind_t{});
+         return;
+      }
+
+      Store(slotCache, values..., ind_t{});
+      const std::size_t valueSizes[] = {0u, GetCachedValueSize(values)...};
+      std::size_t entrySize = 0u;
+      for (auto s : valueSizes)
+         entrySize += s;
+      if ((*fMemoryUsed += entrySize) > fMemoryBudget)
+         *fSpill = true;
+   }
+
+   void Initialize() {}
+
+   void Finalize()
+   {
+      using ind_t = std::index_sequence_for<ColTypes...>;
+      if (!*fSpill) {
+         MergeColumns(ind_t{});
+         return;
+      }
+
+      // the budget was exceeded: the values still held in memory by some slots go to their spill files too
+      for (auto &slotCache : fSlots) {
+         if (!slotCache.fTree && !std::get<0>(slotCache.fValues).empty())
+            Spill(slotCache, ind_t{});
+         if (!slotCache.fTree)
+            continue;
+         // use AutoSave to flush TTree contents because TTree::Write writes in gDirectory, not in fDirectory
+         slotCache.fTree->AutoSave("flushbaskets");
+         // must destroy the TTree first, otherwise TFile will delete it too leading to a double delete
+         slotCache.fTree.reset();
+         slotCache.fFile->Close();
+         slotCache.fFile.reset();
+         fSpillFiles->emplace_back(slotCache.fFileName);
+      }
+   }
+
+   std::shared_ptr<Result_t> GetResultPtr() const { return fSpillFiles; }
+
+   std::string GetActionName() { return "Cache"; }
+};
+
 template <typename Acc, typename Merge, typename R, typename T, typename U,
           bool MustCopyAssign = std::is_same<R, U>::value>
 class AggregateHelper : public RActionImpl<AggregateHelper<Acc, Merge, R, T, U, MustCopyAssign>> {
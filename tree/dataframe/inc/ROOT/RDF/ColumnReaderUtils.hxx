@@ -11,9 +11,11 @@
 #ifndef ROOT_RDF_COLUMNREADERUTILS
 #define ROOT_RDF_COLUMNREADERUTILS
 
+#include "RBatch.hxx"
 #include "RColumnReaderBase.hxx"
 #include "RDefineBase.hxx"
 #include "RDefineReader.hxx"
+#include "RNodeProfile.hxx"
 #include "RDSColumnReader.hxx"
 #include "RTreeColumnReader.hxx"
 
@@ -39,14 +41,23 @@ namespace RDFDetail = ROOT::Detail::RDF;
 template <typename T>
 std::unique_ptr<RDFDetail::RColumnReaderBase>
 MakeColumnReader(unsigned int slot, RDFDetail::RDefineBase *define, TTreeReader *r, ROOT::RDF::RDataSource *ds,
-                 const std::vector<void *> *DSValuePtrsPtr, const std::string &colName)
+                 const std::vector<void *> *DSValuePtrsPtr, const std::string &colName, RBatch *batch = nullptr)
 {
    using Ret_t = std::unique_ptr<RDFDetail::RColumnReaderBase>;
 
    // this check must come first!
    // so that Redefine'd columns have precedence over the original columns
-   if (define != nullptr)
+   if (define != nullptr) {
+      if (batch != nullptr)
+         return Ret_t(new RBatchDefineReader(slot, *define, typeid(T)));
       return Ret_t(new RDefineReader(slot, *define, typeid(T)));
+   }
+
+   if (batch != nullptr) {
+      // in batched execution the values are copied in a buffer of the batch, shared by all readers of the column
+      return batch->MakeColumnReader<T>(
+         colName, [&] { return MakeColumnReader<T>(slot, nullptr, r, ds, DSValuePtrsPtr, colName); });
+   }
 
    if (DSValuePtrsPtr != nullptr) {
       // reading from a RDataSource with the old column reader interface
@@ -67,12 +78,12 @@ template <typename T>
 std::unique_ptr<RDFDetail::RColumnReaderBase>
 MakeColumnReadersHelper(unsigned int slot, RDFDetail::RDefineBase *define,
                         const std::map<std::string, std::vector<void *>> &DSValuePtrsMap, TTreeReader *r,
-                        ROOT::RDF::RDataSource *ds, const std::string &colName)
+                        ROOT::RDF::RDataSource *ds, const std::string &colName, RBatch *batch = nullptr)
 {
    const auto DSValuePtrsIt = DSValuePtrsMap.find(colName);
    const std::vector<void *> *DSValuePtrsPtr = DSValuePtrsIt != DSValuePtrsMap.end() ? &DSValuePtrsIt->second : nullptr;
    R__ASSERT(define != nullptr || r != nullptr || DSValuePtrsPtr != nullptr || ds != nullptr);
-   return MakeColumnReader<T>(slot, define, r, ds, DSValuePtrsPtr, colName);
+   return MakeColumnReader<T>(slot, define, r, ds, DSValuePtrsPtr, colName, batch);
 }
 
 /// This type aggregates some of the arguments passed to InitColumnReaders.
@@ -85,6 +96,9 @@ struct RColumnReadersInfo {
    const bool *fIsDefine;
    const std::map<std::string, std::vector<void *>> &fDSValuePtrsMap;
    ROOT::RDF::RDataSource *fDataSource;
+   RBatch *fBatch; ///< The batch of the processing slot in batched execution, nullptr otherwise
+   /// The profile of the node if profiling is enabled, nullptr otherwise. The values read from the dataset are counted.
+   RNodeProfile *fProfile = nullptr;
 };
 
 /// Create a group of column readers, one per type in the parameter pack.
@@ -100,17 +114,23 @@ MakeColumnReaders(unsigned int slot, TTreeReader *r, TypeList<ColTypes...>, cons
    const bool *isDefine = colInfo.fIsDefine;
    const auto &DSValuePtrsMap = colInfo.fDSValuePtrsMap;
    auto *ds = colInfo.fDataSource;
+   auto *batch = colInfo.fBatch;
+   auto *profile = colInfo.fProfile;
 
    const auto &customColMap = customCols.GetColumns();
 
    int i = -1;
    std::array<std::unique_ptr<RDFDetail::RColumnReaderBase>, sizeof...(ColTypes)> ret{
-      {{(++i, MakeColumnReadersHelper<ColTypes>(slot, isDefine[i] ? customColMap.at(colNames[i]).get() : nullptr,
-                                                DSValuePtrsMap, r, ds, colNames[i]))}...}};
+      {{(++i, MakeProfiledColumnReader<ColTypes>(
+                 MakeColumnReadersHelper<ColTypes>(slot, isDefine[i] ? customColMap.at(colNames[i]).get() : nullptr,
+                                                   DSValuePtrsMap, r, ds, colNames[i], batch),
+                 isDefine[i] ? nullptr : profile, slot, i))}...}};
    return ret;
 
    // avoid bogus "unused variable" warnings
    (void)ds;
+   (void)batch;
+   (void)profile;
    (void)slot;
    (void)r;
 }
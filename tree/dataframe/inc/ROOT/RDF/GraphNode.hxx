@@ -42,6 +42,7 @@ private:
    unsigned int fCounter; ///< Nodes may share the same name (e.g. Filter). To manage this situation in dot, each node
    ///< is represented by an unique id.
    std::string fName, fColor, fShape;
+   std::string fProfileSummary; ///< Time spent and entries processed by the node if profiled, empty otherwise
    std::vector<std::string>
       fDefinedColumns; ///< Columns defined up to this node. By checking the defined columns between two consecutive
                        ///< nodes, it is possible to know if there was some Define in between.
@@ -74,6 +75,14 @@ public:
    /// \brief Appends a node on the head of the current node
    void SetPrevNode(const std::shared_ptr<GraphNode> &node) { fPrevNode = node; }
 
+   ////////////////////////////////////////////////////////////////////////////
+   /// \brief Annotates the node with a summary of its profile, see RLoopManager::EnableProfiling
+   void SetProfileSummary(const std::string &summary) { fProfileSummary = summary; }
+
+   ////////////////////////////////////////////////////////////////////////////
+   /// \brief Returns the label of the node in the dot representation
+   std::string GetLabel() const { return fProfileSummary.empty() ? fName : fName + "\n" + fProfileSummary; }
+
    ////////////////////////////////////////////////////////////////////////////
    /// \brief Adds the column defined up to the node
    void AddDefinedColumns(const std::vector<std::string> &columns) { fDefinedColumns = columns; }
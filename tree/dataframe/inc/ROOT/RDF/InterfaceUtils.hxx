@@ -40,6 +40,7 @@
 class TObjArray;
 class TTree;
 namespace ROOT {
+class RDataFrame;
 namespace Detail {
 namespace RDF {
 class RNodeBase;
@@ -233,8 +234,17 @@ struct SnapshotHelperArgs {
    std::string fTreeName;
    std::vector<std::string> fOutputColNames;
    ROOT::RDF::RSnapshotOptions fOptions;
+   /// The dataframe returned by Snapshot. Replaced by a dataframe that reads the output after the event loop if the
+   /// output is an RNTuple or a Parquet file, see MakeSnapshotOutputDataFrame.
+   std::shared_ptr<ROOT::RDataFrame> fOutputDataFrame;
 };
 
+/// Return the dataframe that reads the output of a Snapshot. For RNTuple and Parquet outputs, which are only readable
+/// once written, this is an empty placeholder until the Snapshot has run.
+std::shared_ptr<ROOT::RDataFrame> MakeSnapshotOutputDataFrame(std::string_view fullTreeName, std::string_view fileName,
+                                                              const ColumnNames_t &columns,
+                                                              const ROOT::RDF::RSnapshotOptions &options);
+
 // Snapshot action
 template <typename... ColTypes, typename PrevNodeType>
 std::unique_ptr<RActionBase>
@@ -249,7 +259,15 @@ BuildAction(const ColumnNames_t &colNames, const std::shared_ptr<SnapshotHelperA
    const auto &options = snapHelperArgs->fOptions;
 
    std::unique_ptr<RActionBase> actionPtr;
-   if (!ROOT::IsImplicitMTEnabled()) {
+   if (options.fOutputFormat == ROOT::RDF::ESnapshotOutputFormat::kRNTuple ||
+       options.fOutputFormat == ROOT::RDF::ESnapshotOutputFormat::kParquet) {
+      // the same helper writes from one or more slots
+      using Helper_t = SnapshotWriterHelper<ColTypes...>;
+      using Action_t = RAction<Helper_t, PrevNodeType>;
+      actionPtr.reset(new Action_t(Helper_t(nSlots, filename, dirname, treename, colNames, outputColNames, options,
+                                            snapHelperArgs->fOutputDataFrame),
+                                   colNames, prevNode, defines));
+   } else if (!ROOT::IsImplicitMTEnabled()) {
       // single-thread snapshot
       using Helper_t = SnapshotHelper<ColTypes...>;
       using Action_t = RAction<Helper_t, PrevNodeType>;
@@ -301,10 +319,14 @@ void CheckForDefinition(const std::string &where, std::string_view definedColVie
 
 std::string PrettyPrintAddr(const void *const addr);
 
-void BookFilterJit(const std::shared_ptr<RJittedFilter> &jittedFilter, std::shared_ptr<RNodeBase> *prevNodeOnHeap,
-                   std::string_view name, std::string_view expression,
-                   const std::map<std::string, std::string> &aliasMap, const ColumnNames_t &branches,
-                   const RBookedDefines &customCols, TTree *tree, RDataSource *ds);
+ColumnNames_t FindUsedColumnNames(std::string_view expression, const ColumnNames_t &branches,
+                                  const RBookedDefines &customCols, RDataSource *ds,
+                                  const std::map<std::string, std::string> &aliasMap);
+
+std::shared_ptr<RJittedFilter>
+BookFilterJit(const std::shared_ptr<RJittedFilter> &jittedFilter, std::shared_ptr<RNodeBase> *prevNodeOnHeap,
+              std::string_view name, std::string_view expression, const std::map<std::string, std::string> &aliasMap,
+              const ColumnNames_t &branches, const RBookedDefines &customCols, TTree *tree, RDataSource *ds);
 
 std::shared_ptr<RJittedDefine> BookDefineJit(std::string_view name, std::string_view expression, RLoopManager &lm,
                                                    RDataSource *ds, const RBookedDefines &customCols,
@@ -455,7 +477,7 @@ void JitDefineHelper(F &&f, const char **colsPtr, std::size_t colsSize, std::str
    const auto dummyType = "jittedCol_t";
    // use unique_ptr<RDefineBase> instead of make_unique<NewCol_t> to reduce jit/compile-times
    jittedDefine->SetDefine(std::unique_ptr<RDefineBase>(
-      new NewCol_t(name, dummyType, std::forward<F>(f), cols, lm->GetNSlots(), *defines, lm->GetDSValuePtrs(), ds)));
+      new NewCol_t(name, dummyType, std::forward<F>(f), cols, *defines, *lm)));
 
    // defines points to the columns structure in the heap, created before the jitted call so that the jitter can
    // share data after it has lazily compiled the code. Here the data has been used and the memory can be freed.
@@ -621,6 +643,10 @@ struct ParsedTreePath {
 
 ParsedTreePath ParseTreePath(std::string_view fullTreeName);
 
+/// Return a RLoopManager that reads the spilled cache from the given files, which are deleted together with it.
+std::shared_ptr<RLoopManager>
+MakeSpilledCacheLoopManager(const std::vector<std::string> &fileNames, const ColumnNames_t &columns);
+
 // Check if a condition is true for all types
 template <bool...>
 struct TBoolPack;
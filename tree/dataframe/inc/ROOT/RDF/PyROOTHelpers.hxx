@@ -12,7 +12,10 @@
 #define ROOT_PyROOTHelpers
 
 #include "ROOT/RDataFrame.hxx"
+#include "ROOT/RDF/ActionHelpers.hxx" // RActionImpl
+#include "ROOT/RVec.hxx"
 
+#include <memory>
 #include <vector>
 #include <string>
 #include <utility>
@@ -69,6 +72,87 @@ ROOT::RDF::RResultPtr<std::vector<T>> RDataFrameTake(ROOT::RDF::RNode df, std::s
    return df.Take<T>(column);
 }
 
+/// The values of a collection column of all the entries, flattened into a single buffer
+template <typename T>
+struct RJaggedColumn {
+   std::vector<T> fContent;
+   /// The values of entry i are fContent[fOffsets[i]] to fContent[fOffsets[i + 1] - 1]
+   std::vector<Long64_t> fOffsets{0};
+};
+
+/// Action helper filling an RJaggedColumn from a collection column, e.g. of ROOT::VecOps::RVec<T> or std::vector<T>.
+/// Every slot appends to its own buffers, which are concatenated once at the end of the event loop. As for Take,
+/// the entries of the slots are concatenated in the slot order, hence the same for all the columns of a dataframe.
+template <typename T, typename COLL>
+class RJaggedTakeHelper : public ROOT::Detail::RDF::RActionImpl<RJaggedTakeHelper<T, COLL>> {
+public:
+   using Result_t = RJaggedColumn<T>;
+
+private:
+   std::shared_ptr<Result_t> fResult;
+   std::vector<std::vector<T>> fContents;
+   std::vector<std::vector<Long64_t>> fSizes;
+
+public:
+   RJaggedTakeHelper(const std::shared_ptr<Result_t> &result, unsigned int nSlots)
+      : fResult(result), fContents(nSlots), fSizes(nSlots)
+   {
+   }
+   RJaggedTakeHelper(RJaggedTakeHelper &&) = default;
+   RJaggedTakeHelper(const RJaggedTakeHelper &) = delete;
+
+   void Initialize() {}
+
+   void InitTask(TTreeReader *, unsigned int) {}
+
+   void Exec(unsigned int slot, const COLL &values)
+   {
+      fContents[slot].insert(fContents[slot].end(), values.begin(), values.end());
+      fSizes[slot].push_back(values.size());
+   }
+
+   void Finalize()
+   {
+      std::size_t nValues = 0;
+      std::size_t nEntries = 0;
+      for (unsigned int i = 0; i < fContents.size(); ++i) {
+         nValues += fContents[i].size();
+         nEntries += fSizes[i].size();
+      }
+      auto &content = fResult->fContent;
+      auto &offsets = fResult->fOffsets;
+      content.reserve(content.size() + nValues);
+      offsets.reserve(offsets.size() + nEntries);
+      for (unsigned int i = 0; i < fContents.size(); ++i) {
+         content.insert(content.end(), fContents[i].begin(), fContents[i].end());
+         for (auto size : fSizes[i])
+            offsets.push_back(offsets.back() + size);
+         std::vector<T>().swap(fContents[i]);
+         std::vector<Long64_t>().swap(fSizes[i]);
+      }
+   }
+
+   std::shared_ptr<Result_t> GetResultPtr() const { return fResult; }
+
+   std::string GetActionName() { return "TakeJagged"; }
+
+   RJaggedTakeHelper MakeNew(void *newResult)
+   {
+      auto &result = *static_cast<std::shared_ptr<Result_t> *>(newResult);
+      result->fContent.clear();
+      result->fOffsets.assign(1, 0);
+      return RJaggedTakeHelper(result, fContents.size());
+   }
+};
+
+/// Books the reading of the collection column of type COLL (ROOT::VecOps::RVec<T> by default) into an RJaggedColumn
+template <typename T, typename COLL = ROOT::VecOps::RVec<T>>
+ROOT::RDF::RResultPtr<RJaggedColumn<T>> RDataFrameTakeJagged(ROOT::RDF::RNode df, std::string_view column)
+{
+   RJaggedTakeHelper<T, COLL> helper(std::make_shared<RJaggedColumn<T>>(), df.GetNSlots());
+   return df.Book<COLL>(std::move(helper), {std::string(column)});
+}
+
 } // namespace RDF
 } // namespace Internal
 } // namespace ROOT
@@ -14,9 +14,11 @@
 #include "ROOT/RDF/ColumnReaderUtils.hxx"
 #include "ROOT/RDF/GraphNode.hxx"
 #include "ROOT/RDF/RActionBase.hxx"
+#include "ROOT/RDF/RBatch.hxx"
 #include "ROOT/RDF/RColumnReaderBase.hxx"
 #include "ROOT/RDF/Utils.hxx" // ColumnNames_t, IsInternalColumn
 #include "ROOT/RDF/RLoopManager.hxx"
+#include "ROOT/RDF/RVariedAction.hxx"
 
 #include <array>
 #include <cstddef> // std::size_t
@@ -60,6 +62,9 @@ class R__CLING_PTRCHECK(off) RAction : public RActionBase {
 
    /// The nth flag signals whether the nth input column is a custom column or not.
    std::array<bool, ColumnTypes_t::list_size> fIsDefine;
+   /// The Defines read by this action, updated with the mask of the previous filters before the action runs on a
+   /// batch or, when profiling, on an entry.
+   std::vector<RDefineBase *> fInputDefines;
 
 public:
    RAction(Helper &&h, const ColumnNames_t &columns, std::shared_ptr<PrevDataFrame> pd, const RBookedDefines &defines)
@@ -68,8 +73,12 @@ public:
    {
       const auto nColumns = columns.size();
       const auto &customCols = GetDefines();
-      for (auto i = 0u; i < nColumns; ++i)
+      for (auto i = 0u; i < nColumns; ++i) {
          fIsDefine[i] = customCols.HasName(columns[i]);
+         if (fIsDefine[i])
+            fInputDefines.emplace_back(customCols.GetColumns().at(columns[i]).get());
+      }
+      fProfile.SetName(fHelper.GetActionName());
    }
 
    RAction(const RAction &) = delete;
@@ -93,8 +102,13 @@ public:
    {
       for (auto &bookedBranch : GetDefines().GetColumns())
          bookedBranch.second->InitSlot(r, slot);
-      RDFInternal::RColumnReadersInfo info{RActionBase::GetColumnNames(), RActionBase::GetDefines(), fIsDefine.data(),
-                                           fLoopManager->GetDSValuePtrs(), fLoopManager->GetDataSource()};
+      RDFInternal::RColumnReadersInfo info{RActionBase::GetColumnNames(),
+                                           RActionBase::GetDefines(),
+                                           fIsDefine.data(),
+                                           fLoopManager->GetDSValuePtrs(),
+                                           fLoopManager->GetDataSource(),
+                                           fLoopManager->GetBatch(slot),
+                                           fLoopManager->IsProfilingEnabled() ? &fProfile : nullptr};
       fValues[slot] = RDFInternal::MakeColumnReaders(slot, r, ColumnTypes_t{}, info);
       fHelper.InitTask(r, slot);
    }
@@ -106,13 +120,47 @@ public:
       (void)entry; // avoid "unused parameter" warnings
    }
 
+   /// Run the action and record the time spent in the profile of this node. The Defines among the input columns are
+   /// evaluated first, so that their time is recorded in their own profile.
+   void CallExecProfiled(unsigned int slot, Long64_t entry)
+   {
+      for (auto *define : fInputDefines)
+         define->Update(slot, entry);
+      RProfileTimer timer(&fProfile, slot);
+      CallExec(slot, entry, ColumnTypes_t{}, TypeInd_t{});
+   }
+
    void Run(unsigned int slot, Long64_t entry) final
    {
       // check if entry passes all filters
-      if (fPrevData.CheckFilters(slot, entry))
-         CallExec(slot, entry, ColumnTypes_t{}, TypeInd_t{});
+      if (fPrevData.CheckFilters(slot, entry)) {
+         if (fLoopManager->IsProfilingEnabled())
+            CallExecProfiled(slot, entry);
+         else
+            CallExec(slot, entry, ColumnTypes_t{}, TypeInd_t{});
+      }
    }
 
+   void RunBatch(unsigned int slot, const RBatch &batch) final
+   {
+      const auto &mask = fPrevData.CheckFiltersBatch(slot, batch);
+      for (auto *define : fInputDefines)
+         define->UpdateBatch(slot, batch, mask);
+      // in batched execution the column readers take the position of the entry in the batch
+      const auto size = batch.GetSize();
+      RProfileTimer timer(fLoopManager->IsProfilingEnabled() ? &fProfile : nullptr, slot);
+      ULong64_t nEntries = 0;
+      for (std::size_t i = 0u; i < size; ++i) {
+         if (mask[i]) {
+            CallExec(slot, i, ColumnTypes_t{}, TypeInd_t{});
+            ++nEntries;
+         }
+      }
+      timer.SetNEntries(nEntries);
+   }
+
+   bool SupportsBatchedExecution() const final { return fHelper.SupportsBatchedExecution(); }
+
    void TriggerChildrenCount() final { fPrevData.IncrChildrenCount(); }
 
    /// Clean-up operations to be performed at the end of a task.
@@ -145,6 +193,7 @@ public:
 
       thisNode->AddDefinedColumns(GetDefines().GetNames());
       thisNode->SetAction(HasRun());
+      thisNode->SetProfileSummary(fProfile.GetSummary());
       upmostNode->SetPrevNode(prevNode);
       return thisNode;
    }
@@ -153,6 +202,11 @@ public:
    /// user-defined callback registered via RResultPtr::RegisterCallback
    void *PartialUpdate(unsigned int slot) final { return PartialUpdateImpl(slot); }
 
+   std::unique_ptr<RActionBase> MakeVariedAction(std::vector<void *> &&results) final
+   {
+      return MakeVariedActionImpl(std::move(results), /*toincreaseoverloadpriority=*/0);
+   }
+
 private:
    // this overload is SFINAE'd out if Helper does not implement `PartialUpdate`
    // the template parameter is required to defer instantiation of the method to SFINAE time
@@ -165,6 +219,26 @@ private:
    // this one is always available but has lower precedence thanks to `...`
    void *PartialUpdateImpl(...) { throw std::runtime_error("This action does not support callbacks!"); }
 
+   // this overload is SFINAE'd out if Helper does not implement `MakeNew`
+   template <typename H = Helper>
+   auto MakeVariedActionImpl(std::vector<void *> &&results, int)
+      -> decltype(std::declval<H>().MakeNew((void *)nullptr), std::unique_ptr<RActionBase>())
+   {
+      std::vector<Helper> helpers;
+      helpers.reserve(results.size());
+      for (void *result : results)
+         helpers.emplace_back(fHelper.MakeNew(result));
+
+      using VariedAction_t = RVariedAction<Helper, PrevDataFrame, ColumnTypes_t>;
+      return std::unique_ptr<RActionBase>(
+         new VariedAction_t(std::move(helpers), GetColumnNames(), fPrevDataPtr, GetDefines()));
+   }
+
+   std::unique_ptr<RActionBase> MakeVariedActionImpl(std::vector<void *> &&, long)
+   {
+      throw std::logic_error("The " + fHelper.GetActionName() + " action does not support systematic variations.");
+   }
+
    std::function<void(unsigned int)> GetDataBlockCallback() final { return fHelper.GetDataBlockCallback(); }
 };
 
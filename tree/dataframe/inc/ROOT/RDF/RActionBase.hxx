@@ -12,11 +12,13 @@
 #define ROOT_RACTIONBASE
 
 #include "ROOT/RDF/RBookedDefines.hxx"
+#include "ROOT/RDF/RNodeProfile.hxx"
 #include "ROOT/RDF/Utils.hxx" // ColumnNames_t
 #include "RtypesCore.h"
 
 #include <memory>
 #include <string>
+#include <vector>
 
 namespace ROOT {
 
@@ -30,6 +32,7 @@ class RMergeableValueBase;
 
 namespace Internal {
 namespace RDF {
+class RBatch;
 namespace GraphDrawing {
 class GraphNode;
 }
@@ -41,6 +44,7 @@ protected:
    /// A raw pointer to the RLoopManager at the root of this functional graph.
    /// Never null: children nodes have shared ownership of parent nodes in the graph.
    RLoopManager *fLoopManager;
+   RNodeProfile fProfile; ///< Time spent and entries processed, filled if profiling is enabled
 
 private:
    const unsigned int fNSlots; ///< Number of thread slots used by this node.
@@ -56,10 +60,15 @@ public:
    virtual ~RActionBase();
 
    const ColumnNames_t &GetColumnNames() const { return fColumnNames; }
-   RBookedDefines &GetDefines() { return fDefines; }
+   // overridden by RJittedAction
+   virtual RBookedDefines &GetDefines() { return fDefines; }
    RLoopManager *GetLoopManager() { return fLoopManager; }
    unsigned int GetNSlots() const { return fNSlots; }
    virtual void Run(unsigned int slot, Long64_t entry) = 0;
+   /// Run the action on the entries of the batch that pass all filters (batched execution only, see RBatch).
+   virtual void RunBatch(unsigned int slot, const RBatch &batch) = 0;
+   /// Whether this action can run in batched execution, see RDataFrame::SetBatchSize.
+   virtual bool SupportsBatchedExecution() const = 0;
    virtual void Initialize() = 0;
    virtual void InitSlot(TTreeReader *r, unsigned int slot) = 0;
    virtual void TriggerChildrenCount() = 0;
@@ -82,6 +91,18 @@ public:
    virtual std::unique_ptr<RMergeableValueBase> GetMergeableValue() const = 0;
 
    virtual std::function<void(unsigned int)> GetDataBlockCallback() = 0;
+
+   /// Return the keys ("variation:tag") of the systematic variations of the result of this action.
+   /// Throws if the result does not depend on systematic variations, or depends on them in an unsupported way.
+   virtual std::vector<std::string> GetVariationKeys() const;
+
+   /// Create an action that produces the results of this action for each systematic variation.
+   /// `results` holds type-erased pointers to a std::shared_ptr to the result of each variation, in the order of
+   /// GetVariationKeys(). The caller is responsible for booking the new action with the RLoopManager.
+   virtual std::unique_ptr<RActionBase> MakeVariedAction(std::vector<void *> &&results) = 0;
+
+   /// Return the profile of this action, see RLoopManager::EnableProfiling
+   virtual const RNodeProfile &GetProfile() const { return fProfile; }
 };
 } // namespace RDF
 } // namespace Internal
@@ -0,0 +1,298 @@
+/*************************************************************************
+ * Copyright (C) 1995-2021, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#ifndef ROOT_RDF_RBATCH
+#define ROOT_RDF_RBATCH
+
+#include "ROOT/RDF/RColumnReaderBase.hxx"
+#include "ROOT/RDF/Utils.hxx" // TypeID2TypeName
+#include <Rtypes.h>           // Long64_t, R__CLING_PTRCHECK
+
+#include <algorithm> // std::fill
+#include <cstddef> // std::size_t
+#include <map>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <typeindex>
+#include <utility> // std::pair
+#include <vector>
+
+namespace ROOT {
+namespace Internal {
+namespace RDF {
+
+namespace RDFDetail = ROOT::Detail::RDF;
+
+class RBatch;
+
+/// The dataset read by a processing slot, as seen by a RBatch. Columns are read lazily, after the Filters have
+/// selected the entries of the batch, so the dataset must be able to go back to the entries of the batch.
+class RBatchSource {
+public:
+   virtual ~RBatchSource() = default;
+   /// The position of the current entry in the dataset
+   virtual Long64_t GetPosition() = 0;
+   /// Move the dataset to a position previously returned by GetPosition
+   virtual void SetPosition(Long64_t position) = 0;
+   /// Whether the current entry is the last of its data block (e.g. the last entry of a TTree in a TChain): the
+   /// values of the entries of a data block cannot be read anymore once the dataset has moved to the next one.
+   virtual bool IsLastOfDataBlock() = 0;
+};
+
+/// Type-erased buffer with the values of a column for the entries of a batch.
+class RBatchedColumnBase {
+public:
+   virtual ~RBatchedColumnBase() = default;
+   /// Called when an entry is added at position idx of the batch, while the dataset is at that entry
+   virtual void AddEntry(std::size_t idx, Long64_t entry) = 0;
+   /// Called when the batch is cleared, before its entries are removed
+   virtual void Clear() = 0;
+};
+
+/// Buffer with the values of a column for the entries of a batch, filled from a column reader.
+///
+/// If the dataset can go back to the entries of the batch (see RBatchSource) a value is only read when it is
+/// requested, i.e. for the entries that pass the Filters upstream of the nodes that read the column, and for a
+/// batch without such entries the column is not read at all. Columns that end up being read for all the entries of a
+/// batch, e.g. the inputs of the first Filter, are read as the entries are added to the next batch instead, which
+/// avoids moving the dataset back and forth. Without a RBatchSource all columns are read as the entries are added.
+template <typename T>
+class R__CLING_PTRCHECK(off) RBatchedColumn final : public RBatchedColumnBase {
+   RBatch &fBatch;
+   std::unique_ptr<RDFDetail::RColumnReaderBase> fReader;
+   std::unique_ptr<T[]> fValues;
+   enum EValueState : char { kNotRead, kRead, kRequested };
+   /// The state of the value at each position of the batch
+   std::vector<char> fStates;
+   /// Number of values requested through Get in the current batch
+   std::size_t fNRequested = 0u;
+   /// Whether the dataset can go back to the entries of the batch
+   const bool fCanBeLazy;
+   bool fIsEager;
+
+public:
+   RBatchedColumn(RBatch &batch, std::unique_ptr<RDFDetail::RColumnReaderBase> reader, std::size_t maxSize,
+                  bool canBeLazy)
+      : fBatch(batch), fReader(std::move(reader)), fValues(new T[maxSize]), fStates(maxSize, kNotRead),
+        fCanBeLazy(canBeLazy), fIsEager(!canBeLazy)
+   {
+   }
+
+   void AddEntry(std::size_t idx, Long64_t entry) final
+   {
+      if (fIsEager) {
+         fValues[idx] = fReader->template Get<T>(entry);
+         fStates[idx] = kRead;
+      }
+   }
+
+   void Clear() final;
+
+   /// The value of the column for the entry at position idx of the batch, read from the dataset if needed
+   T *Get(std::size_t idx);
+};
+
+/// Column reader that reads the values of a column from the buffer of a batch.
+/// The argument of Get is the position of the entry in the batch rather than the entry number.
+template <typename T>
+class R__CLING_PTRCHECK(off) RBatchedColumnReader final : public RDFDetail::RColumnReaderBase {
+   RBatchedColumn<T> &fColumn;
+
+   void *GetImpl(Long64_t idx) final { return fColumn.Get(idx); }
+
+public:
+   RBatchedColumnReader(RBatchedColumn<T> &column) : fColumn(column) {}
+};
+
+/**
+\class ROOT::Internal::RDF::RBatch
+\ingroup dataframe
+\brief The entries that are processed together by the nodes of a computation graph in batched execution.
+
+In batched execution (see RDataFrame::SetBatchSize) the event loop does not run the computation graph for each entry:
+it collects the entries of each processing slot in a RBatch, then each node of the graph processes all the entries of
+the batch at once. The values of the columns read from the dataset are copied into buffers, see RBatchedColumn. Filters produce a selection
+mask per batch, Defines compute their values for all the selected entries of the batch in one go, and actions run over
+the selected entries.
+
+The column readers used in batched execution take the position of the entry in the batch as argument of Get.
+There is one RBatch per processing slot, so no synchronization is required.
+*/
+class RBatch {
+   using ColumnKey_t = std::pair<std::string, std::type_index>;
+
+   const std::size_t fMaxSize;
+   /// Identifies the entries currently held by the batch: it is increased every time the batch is cleared
+   Long64_t fId = 0;
+   std::vector<Long64_t> fEntries;
+   /// The positions of the entries in the dataset, see RBatchSource
+   std::vector<Long64_t> fPositions;
+   /// If null, the columns are read as the entries are added to the batch
+   std::unique_ptr<RBatchSource> fSource;
+   /// The position in the batch of the entry the dataset is at
+   std::size_t fSourceIdx = 0u;
+   /// Whether the dataset must go back to the last entry of the batch before moving to the next entry, see Rewind
+   bool fMustRewind = false;
+   Long64_t fRewindPosition = -1;
+   /// Whether the dataset reached the end of a data block, see RBatchSource::IsLastOfDataBlock
+   bool fIsAtEndOfDataBlock = false;
+   /// A selection mask with all entries selected, returned by the head node of the computation graph
+   std::vector<char> fFullMask;
+   /// Buffers of the columns read from the dataset
+   std::map<ColumnKey_t, std::unique_ptr<RBatchedColumnBase>> fColumns;
+
+   template <typename T, typename MakeReader_t>
+   std::unique_ptr<RDFDetail::RColumnReaderBase>
+   MakeColumnReaderImpl(const std::string &colName, MakeReader_t &makeReader, std::true_type /*isBufferable*/)
+   {
+      auto &column = fColumns[ColumnKey_t(colName, std::type_index(typeid(T)))];
+      if (!column)
+         column.reset(new RBatchedColumn<T>(*this, makeReader(), fMaxSize, fSource != nullptr));
+      return std::unique_ptr<RDFDetail::RColumnReaderBase>(
+         new RBatchedColumnReader<T>(static_cast<RBatchedColumn<T> &>(*column)));
+   }
+
+   template <typename T, typename MakeReader_t>
+   std::unique_ptr<RDFDetail::RColumnReaderBase>
+   MakeColumnReaderImpl(const std::string &colName, MakeReader_t &, std::false_type /*isBufferable*/)
+   {
+      auto typeName = TypeID2TypeName(typeid(T));
+      if (typeName.empty())
+         typeName = typeid(T).name();
+      throw std::runtime_error("RDataFrame: column \"" + colName + "\" of type " + typeName +
+                               " cannot be read in batched execution, its type must be default-constructible and "
+                               "copy-assignable. Use RDataFrame::SetBatchSize(1) to disable batched execution.");
+   }
+
+public:
+   explicit RBatch(std::size_t maxSize) : fMaxSize(maxSize)
+   {
+      fEntries.reserve(fMaxSize);
+      fPositions.reserve(fMaxSize);
+      fFullMask.reserve(fMaxSize);
+   }
+   RBatch(const RBatch &) = delete;
+   RBatch &operator=(const RBatch &) = delete;
+
+   Long64_t GetId() const { return fId; }
+   std::size_t GetSize() const { return fEntries.size(); }
+   std::size_t GetMaxSize() const { return fMaxSize; }
+   bool IsFull() const { return fEntries.size() == fMaxSize; }
+   /// The entry numbers of the entries of the batch
+   const std::vector<Long64_t> &GetEntries() const { return fEntries; }
+   const std::vector<char> &GetFullMask() const { return fFullMask; }
+
+   /// Whether the last entry added is the last of its data block: the batch must then be processed before the
+   /// dataset moves to the next entry.
+   bool IsAtEndOfDataBlock() const { return fIsAtEndOfDataBlock; }
+
+   /// Set the dataset of the processing slot, which enables the lazy reading of the columns (see RBatchedColumn).
+   /// Must be called before the column readers are created and when the batch is empty.
+   void SetSource(std::unique_ptr<RBatchSource> source) { fSource = std::move(source); }
+
+   /// Add an entry to the batch. The dataset must be at that entry. The batch must not be full.
+   void AddEntry(Long64_t entry)
+   {
+      const auto idx = fEntries.size();
+      for (auto &column : fColumns)
+         column.second->AddEntry(idx, entry);
+      fEntries.push_back(entry);
+      fFullMask.push_back(1);
+      if (fSource) {
+         fPositions.push_back(fSource->GetPosition());
+         fSourceIdx = idx;
+         fIsAtEndOfDataBlock = fSource->IsLastOfDataBlock();
+      }
+   }
+
+   /// Move the dataset to the entry at position idx of the batch
+   void MoveSourceTo(std::size_t idx)
+   {
+      if (idx == fSourceIdx)
+         return;
+      fSource->SetPosition(fPositions[idx]);
+      fSourceIdx = idx;
+      fMustRewind = true;
+      fRewindPosition = fPositions.back();
+   }
+
+   /// Remove all entries from the batch.
+   void Clear()
+   {
+      for (auto &column : fColumns)
+         column.second->Clear();
+      fEntries.clear();
+      fPositions.clear();
+      fFullMask.clear();
+      fIsAtEndOfDataBlock = false;
+      ++fId;
+   }
+
+   /// Move the dataset back to the last entry added to the batch, if reading the columns moved it. To be called
+   /// after the batch was processed and before the event loop moves the dataset to the next entry.
+   void Rewind()
+   {
+      if (fMustRewind)
+         fSource->SetPosition(fRewindPosition);
+      fMustRewind = false;
+   }
+
+   /// Remove all entries and drop the column buffers and the dataset. To be called at the end of each task, as the
+   /// column readers that fill the buffers are bound to the TTreeReader or data source of the task.
+   void Reset()
+   {
+      Clear();
+      fMustRewind = false;
+      fColumns.clear();
+      fSource.reset();
+   }
+
+   /// Return a reader for the buffer of the given column, creating the buffer if needed.
+   /// `makeReader` must return the reader that reads the column from the dataset, it is only called if the buffer
+   /// does not exist yet.
+   template <typename T, typename MakeReader_t>
+   std::unique_ptr<RDFDetail::RColumnReaderBase> MakeColumnReader(const std::string &colName, MakeReader_t &&makeReader)
+   {
+      using IsBufferable_t =
+         std::integral_constant<bool, std::is_default_constructible<T>::value && std::is_copy_assignable<T>::value>;
+      return MakeColumnReaderImpl<T>(colName, makeReader, IsBufferable_t{});
+   }
+};
+
+template <typename T>
+void RBatchedColumn<T>::Clear()
+{
+   // the columns requested for all the entries of a batch are read eagerly in the next batch
+   const auto size = fBatch.GetSize();
+   if (fCanBeLazy && size > 0u)
+      fIsEager = fNRequested == size;
+   std::fill(fStates.begin(), fStates.begin() + size, kNotRead);
+   fNRequested = 0u;
+}
+
+template <typename T>
+T *RBatchedColumn<T>::Get(std::size_t idx)
+{
+   if (fStates[idx] != kRequested) {
+      if (fStates[idx] == kNotRead) {
+         fBatch.MoveSourceTo(idx);
+         fValues[idx] = fReader->template Get<T>(fBatch.GetEntries()[idx]);
+      }
+      fStates[idx] = kRequested;
+      ++fNRequested;
+   }
+   return fValues.get() + idx;
+}
+
+} // namespace RDF
+} // namespace Internal
+} // namespace ROOT
+
+#endif // ROOT_RDF_RBATCH
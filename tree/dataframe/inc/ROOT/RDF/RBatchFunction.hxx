@@ -0,0 +1,99 @@
+/*************************************************************************
+ * Copyright (C) 1995-2021, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#ifndef ROOT_RDF_RBATCHFUNCTION
+#define ROOT_RDF_RBATCHFUNCTION
+
+#include <cstddef> // std::size_t
+#include <tuple>
+#include <type_traits>
+#include <utility> // std::index_sequence
+
+namespace ROOT {
+namespace RDF {
+namespace Experimental {
+
+/// The type of the buffers passed to a RBatchFunction for values of type T: bools are passed as chars
+template <typename T>
+using BatchBuffer_t = std::conditional_t<std::is_same<T, bool>::value, char, T>;
+
+/**
+\class ROOT::RDF::Experimental::RBatchFunction
+\ingroup dataframe
+\brief A function that computes the values of a Define for a whole array of entries in a single call.
+
+The wrapped function has the signature `void(long size, const Args *..., Ret *out)`: it reads `size` values from
+each input buffer and writes `size` values to the output buffer (bools are passed as chars, see BatchBuffer_t).
+A RBatchFunction can be passed to Define like any other callable. In batched execution (see RDataFrame::SetBatchSize)
+the Define then calls the function once per batch, on the values of all the entries of the batch that need to be
+computed, instead of once per entry. Otherwise the function is called for each entry with `size == 1`.
+
+~~~{.cpp}
+void Square(long size, const float *x, float *out)
+{
+   for (long i = 0; i < size; ++i)
+      out[i] = x[i] * x[i];
+}
+
+ROOT::RDataFrame df(1000);
+df.SetBatchSize(256);
+auto d = df.Define("x", [](ULong64_t e) { return float(e); }, {"rdfentry_"})
+           .Define("x2", ROOT::RDF::Experimental::RBatchFunction<float, float>(&Square), {"x"});
+~~~
+
+This is the form in which the vectorized callables of ROOT.Numba.Declare are booked by their `<name>_define` wrapper.
+*/
+template <typename Ret, typename... Args>
+class RBatchFunction {
+public:
+   using Function_t = void (*)(long, const BatchBuffer_t<Args> *..., BatchBuffer_t<Ret> *);
+
+private:
+   Function_t fFunction;
+
+   template <std::size_t... S>
+   Ret EvalOne(const std::tuple<BatchBuffer_t<Args>...> &args, std::index_sequence<S...>) const
+   {
+      BatchBuffer_t<Ret> out;
+      fFunction(1, &std::get<S>(args)..., &out);
+      return out;
+   }
+
+public:
+   explicit RBatchFunction(Function_t function) : fFunction(function) {}
+
+   /// Compute the value for a single entry
+   Ret operator()(Args... args) const
+   {
+      return EvalOne(std::tuple<BatchBuffer_t<Args>...>(args...), std::index_sequence_for<Args...>());
+   }
+
+   /// Compute the values for `size` entries
+   void EvalBatch(long size, const BatchBuffer_t<Args> *... args, BatchBuffer_t<Ret> *out) const
+   {
+      fFunction(size, args..., out);
+   }
+};
+
+} // namespace Experimental
+} // namespace RDF
+
+namespace Internal {
+namespace RDF {
+template <typename F>
+struct IsBatchFunction : std::false_type {
+};
+
+template <typename Ret, typename... Args>
+struct IsBatchFunction<ROOT::RDF::Experimental::RBatchFunction<Ret, Args...>> : std::true_type {
+};
+} // namespace RDF
+} // namespace Internal
+} // namespace ROOT
+
+#endif // ROOT_RDF_RBATCHFUNCTION
@@ -30,6 +30,24 @@ namespace RDF {
 
 namespace RDFDetail = ROOT::Detail::RDF;
 
+/// A systematic variation of a column, as booked by RInterface::Vary.
+struct RVariationInfo {
+   std::string fName;               ///< The name of the variation
+   std::vector<std::string> fTags;  ///< The tags of the varied values, e.g. "up" and "down"
+   std::string fColumnName;         ///< The name of the varied column
+   std::string fDefineName;         ///< The name of the internal Define that computes the RVec of varied values
+};
+
+/// One of the varied values of a systematic variation, i.e. a variation and one of its tags.
+struct RVariationKey {
+   std::string fName;    ///< The name of the variation
+   std::size_t fTagIdx;  ///< The index of the tag in the variation
+   std::string fTag;     ///< The tag
+
+   /// The key of the varied results, "variationName:tag"
+   std::string GetName() const { return fName + ":" + fTag; }
+};
+
 /**
  * \class ROOT::Internal::RDF::RBookedDefines
  * \ingroup dataframe
@@ -39,14 +57,22 @@ namespace RDFDetail = ROOT::Detail::RDF;
 class RBookedDefines {
    using RDefineBasePtrMap_t = std::map<std::string, std::shared_ptr<RDFDetail::RDefineBase>>;
    using ColumnNames_t = std::vector<std::string>;
+   using RVariationInfoMap_t = std::map<std::string, RVariationInfo>;
+   using RVariedDefinesMap_t = std::map<std::string, ColumnNames_t>;
 
    // Since RBookedDefines is meant to be an immutable, copy-on-write object, the actual values are set as const
    using RDefineBasePtrMapPtr_t = std::shared_ptr<const RDefineBasePtrMap_t>;
    using ColumnNamesPtr_t = std::shared_ptr<const ColumnNames_t>;
+   using RVariationInfoMapPtr_t = std::shared_ptr<const RVariationInfoMap_t>;
+   using RVariedDefinesMapPtr_t = std::shared_ptr<const RVariedDefinesMap_t>;
 
 private:
    RDefineBasePtrMapPtr_t fDefines;
    ColumnNamesPtr_t fDefinesNames;  // also abused to keep track of aliases for each branch of the computation graph
+   RVariationInfoMapPtr_t fVariations; ///< Systematic variations, by name of the varied column
+   /// Names of the variations used by each defined column that depends on varied columns, by name of the column
+   RVariedDefinesMapPtr_t fVariedDefines;
+   ColumnNamesPtr_t fFilterVariations; ///< Names of the variations used by the Filters upstream
 
 public:
    ////////////////////////////////////////////////////////////////////////////
@@ -64,7 +90,8 @@ public:
    ////////////////////////////////////////////////////////////////////////////
    /// \brief Creates the object starting from the provided maps
    RBookedDefines(RDefineBasePtrMapPtr_t defines, ColumnNamesPtr_t defineNames)
-      : fDefines(defines), fDefinesNames(defineNames)
+      : fDefines(defines), fDefinesNames(defineNames), fVariations(std::make_shared<RVariationInfoMap_t>()),
+        fVariedDefines(std::make_shared<RVariedDefinesMap_t>()), fFilterVariations(std::make_shared<ColumnNames_t>())
    {
    }
 
@@ -72,7 +99,8 @@ public:
    /// \brief Creates a new wrapper with empty maps
    RBookedDefines()
       : fDefines(std::make_shared<RDefineBasePtrMap_t>()),
-        fDefinesNames(std::make_shared<ColumnNames_t>())
+        fDefinesNames(std::make_shared<ColumnNames_t>()), fVariations(std::make_shared<RVariationInfoMap_t>()),
+        fVariedDefines(std::make_shared<RVariedDefinesMap_t>()), fFilterVariations(std::make_shared<ColumnNames_t>())
    {
    }
 
@@ -100,6 +128,48 @@ public:
    /// in each branch of the computation graph.
    /// Internally it recreates the vector with the new name, and swaps it with the old one.
    void AddName(std::string_view name);
+
+   ////////////////////////////////////////////////////////////////////////////
+   /// \brief Add a systematic variation of a column.
+   void AddVariation(const RVariationInfo &variation);
+
+   ////////////////////////////////////////////////////////////////////////////
+   /// \brief Return the systematic variation of the given column, nullptr if the column is not varied.
+   const RVariationInfo *GetVariation(std::string_view colName) const;
+
+   ////////////////////////////////////////////////////////////////////////////
+   /// \brief Check whether any systematic variation was booked in this branch of the computation graph.
+   bool HasVariations() const { return !fVariations->empty(); }
+
+   ////////////////////////////////////////////////////////////////////////////
+   /// \brief Return the names of the variations the given columns depend on, directly or through Defines.
+   ColumnNames_t GetVariationNames(const ColumnNames_t &columns) const;
+
+   ////////////////////////////////////////////////////////////////////////////
+   /// \brief Check whether any of the given columns depends on the given variation, directly or through Defines.
+   bool DependsOnVariation(const ColumnNames_t &columns, const std::string &variationName) const;
+
+   ////////////////////////////////////////////////////////////////////////////
+   /// \brief Record that the given defined column depends on the given variations.
+   void AddDefineVariations(std::string_view name, const ColumnNames_t &variationNames);
+
+   ////////////////////////////////////////////////////////////////////////////
+   /// \brief Record that a Filter upstream depends on the given variations.
+   void AddFilterVariations(const ColumnNames_t &variationNames);
+
+   ////////////////////////////////////////////////////////////////////////////
+   /// \brief Return one key per tag of each variation that the given columns or the Filters upstream depend on.
+   ///
+   /// Variations are listed in order of first appearance, the variations of the columns first.
+   std::vector<RVariationKey> GetVariationKeys(const ColumnNames_t &columns) const;
+
+   ////////////////////////////////////////////////////////////////////////////
+   /// \brief Return the defines as seen by the given varied value of a variation.
+   ///
+   /// The varied columns are read from the varied values, and each defined column that depends on the variation is
+   /// replaced by its varied copy, see RDefineBase::GetVariedDefine. If nothing depends on the variation, the
+   /// returned object is a copy of this one.
+   RBookedDefines GetVaried(const RVariationKey &key) const;
 };
 
 } // Namespace RDF
@@ -12,8 +12,12 @@
 #define ROOT_RDF_RDEFINE
 
 #include "ROOT/RDF/ColumnReaderUtils.hxx"
+#include "ROOT/RDF/RBatch.hxx"
+#include "ROOT/RDF/RBatchFunction.hxx"
 #include "ROOT/RDF/RColumnReaderBase.hxx"
 #include "ROOT/RDF/RDefineBase.hxx"
+#include "ROOT/RDF/RLoopManager.hxx"
+#include "ROOT/RDF/RVariationTagGetter.hxx"
 #include "ROOT/RDF/Utils.hxx"
 #include "ROOT/RStringView.hxx"
 #include "ROOT/TypeTraits.hxx"
@@ -21,6 +25,10 @@
 
 #include <array>
 #include <deque>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <tuple>
 #include <type_traits>
 #include <utility> // std::index_sequence
 #include <vector>
@@ -69,48 +77,157 @@ class R__CLING_PTRCHECK(off) RDefine final : public RDefineBase {
    /// The nth flag signals whether the nth input column is a custom column or not.
    std::array<bool, ColumnTypes_t::list_size> fIsDefine;
 
+   /// The Defines this Define depends on, updated before its own values are computed for a batch or, when
+   /// profiling, for an entry, so that their time is not counted in the profile of this Define.
+   std::vector<RDefineBase *> fInputDefines;
+   /// Values for the entries of the current batch, per slot (batched execution only)
+   std::vector<ValuesPerSlot_t> fBatchValues;
+   /// Per slot, the nth flag signals whether the value for the nth entry of the current batch was computed already
+   std::vector<std::vector<char>> fBatchComputed;
+   /// Per slot, the id of the batch the values in fBatchValues refer to
+   std::vector<Long64_t> fLastBatchId;
+
+   /// Evaluate the expression. readerEntry is passed to the column readers: it is the entry number, or the position
+   /// of the entry in the batch in batched execution.
    template <typename... ColTypes, std::size_t... S>
-   void UpdateHelper(unsigned int slot, Long64_t entry, TypeList<ColTypes...>, std::index_sequence<S...>, NoneTag)
+   ret_type Eval(unsigned int slot, Long64_t readerEntry, Long64_t, TypeList<ColTypes...>, std::index_sequence<S...>,
+                 NoneTag)
    {
-      fLastResults[slot * RDFInternal::CacheLineStep<ret_type>()] =
-         fExpression(fValues[slot][S]->template Get<ColTypes>(entry)...);
+      return fExpression(fValues[slot][S]->template Get<ColTypes>(readerEntry)...);
       // silence "unused parameter" warnings in gcc
       (void)slot;
-      (void)entry;
+      (void)readerEntry;
    }
 
    template <typename... ColTypes, std::size_t... S>
-   void UpdateHelper(unsigned int slot, Long64_t entry, TypeList<ColTypes...>, std::index_sequence<S...>, SlotTag)
+   ret_type Eval(unsigned int slot, Long64_t readerEntry, Long64_t, TypeList<ColTypes...>, std::index_sequence<S...>,
+                 SlotTag)
    {
-      fLastResults[slot * RDFInternal::CacheLineStep<ret_type>()] =
-         fExpression(slot, fValues[slot][S]->template Get<ColTypes>(entry)...);
+      return fExpression(slot, fValues[slot][S]->template Get<ColTypes>(readerEntry)...);
       // silence "unused parameter" warnings in gcc
       (void)slot;
-      (void)entry;
+      (void)readerEntry;
    }
 
    template <typename... ColTypes, std::size_t... S>
-   void
-   UpdateHelper(unsigned int slot, Long64_t entry, TypeList<ColTypes...>, std::index_sequence<S...>, SlotAndEntryTag)
+   ret_type Eval(unsigned int slot, Long64_t readerEntry, Long64_t entry, TypeList<ColTypes...>,
+                 std::index_sequence<S...>, SlotAndEntryTag)
    {
-      fLastResults[slot * RDFInternal::CacheLineStep<ret_type>()] =
-         fExpression(slot, entry, fValues[slot][S]->template Get<ColTypes>(entry)...);
+      return fExpression(slot, entry, fValues[slot][S]->template Get<ColTypes>(readerEntry)...);
       // silence "unused parameter" warnings in gcc
       (void)slot;
-      (void)entry;
+      (void)readerEntry;
+   }
+
+   /// Compute the values for the entries of the batch that are selected by mask, one entry at a time
+   template <typename... ColTypes, std::size_t... S>
+   ULong64_t ComputeBatch(unsigned int slot, const RDFInternal::RBatch &batch, const std::vector<char> &mask,
+                          std::vector<char> &computed, TypeList<ColTypes...>, std::index_sequence<S...>,
+                          std::false_type /*isBatchFunction*/)
+   {
+      auto &values = fBatchValues[slot];
+      const auto &entries = batch.GetEntries();
+      const auto size = batch.GetSize();
+      ULong64_t nComputed = 0;
+      for (std::size_t i = 0u; i < size; ++i) {
+         if (mask[i] && !computed[i]) {
+            values[i] = Eval(slot, i, entries[i], ColumnTypes_t{}, TypeInd_t{}, ExtraArgsTag{});
+            computed[i] = 1;
+            ++nComputed;
+         }
+      }
+      return nComputed;
+   }
+
+   /// Compute the values for the entries of the batch that are selected by mask with a single call of the
+   /// RBatchFunction, on contiguous copies of the input values of those entries
+   template <typename... ColTypes, std::size_t... S>
+   ULong64_t ComputeBatch(unsigned int slot, const RDFInternal::RBatch &batch, const std::vector<char> &mask,
+                          std::vector<char> &computed, TypeList<ColTypes...>, std::index_sequence<S...>,
+                          std::true_type /*isBatchFunction*/)
+   {
+      std::vector<std::size_t> positions;
+      positions.reserve(batch.GetSize());
+      for (std::size_t i = 0u; i < batch.GetSize(); ++i) {
+         if (mask[i] && !computed[i])
+            positions.push_back(i);
+      }
+      if (positions.empty())
+         return 0;
+
+      std::tuple<std::vector<ROOT::RDF::Experimental::BatchBuffer_t<ColTypes>>...> inputs;
+      int expander[] = {(std::get<S>(inputs).reserve(positions.size()), 0)..., 0};
+      for (auto pos : positions) {
+         int expander2[] = {(std::get<S>(inputs).push_back(fValues[slot][S]->template Get<ColTypes>(pos)), 0)..., 0};
+         (void)expander2;
+      }
+      std::vector<ROOT::RDF::Experimental::BatchBuffer_t<ret_type>> out(positions.size());
+      fExpression.EvalBatch(positions.size(), std::get<S>(inputs).data()..., out.data());
+
+      auto &values = fBatchValues[slot];
+      for (std::size_t k = 0u; k < positions.size(); ++k) {
+         values[positions[k]] = out[k];
+         computed[positions[k]] = 1;
+      }
+      (void)expander; // avoid unused variable warnings for older compilers such as gcc 4.9
+      return positions.size();
+   }
+
+   std::shared_ptr<RDefineBase> MakeVariedDefine(const RDFInternal::RBookedDefines &defines) final
+   {
+      return MakeVariedDefineImpl(defines, std::is_copy_constructible<F>{});
+   }
+
+   std::shared_ptr<RDefineBase> MakeVariedDefineImpl(const RDFInternal::RBookedDefines &defines, std::true_type)
+   {
+      return std::make_shared<RDefine>(fName, fType, fExpression, fColumnNames, defines, *fLoopManager);
+   }
+
+   std::shared_ptr<RDefineBase> MakeVariedDefineImpl(const RDFInternal::RBookedDefines &, std::false_type)
+   {
+      throw std::runtime_error("VariationsFor: the expression of the defined column \"" + fName +
+                               "\" depends on varied columns but cannot be copied to compute its varied values.");
+   }
+
+   std::shared_ptr<RDefineBase>
+   MakeTagDefine(std::size_t tagIdx, const std::string &colName, const RDFInternal::RBookedDefines &defines) final
+   {
+      return MakeTagDefineImpl(tagIdx, colName, defines, TypeList<ret_type>{});
+   }
+
+   /// The varied values are the elements of the RVec computed by this Define
+   template <typename T>
+   std::shared_ptr<RDefineBase> MakeTagDefineImpl(std::size_t tagIdx, const std::string &colName,
+                                                  const RDFInternal::RBookedDefines &defines,
+                                                  TypeList<ROOT::VecOps::RVec<T>>)
+   {
+      using TagDefine_t = RDefine<RDFInternal::RVariationTagGetter<T>, CustomColExtraArgs::None>;
+      return std::make_shared<TagDefine_t>(colName, RDFInternal::TypeID2TypeName(typeid(T)),
+                                           RDFInternal::RVariationTagGetter<T>(tagIdx),
+                                           ROOT::RDF::ColumnNames_t{fName}, defines, *fLoopManager);
+   }
+
+   template <typename T>
+   std::shared_ptr<RDefineBase>
+   MakeTagDefineImpl(std::size_t, const std::string &, const RDFInternal::RBookedDefines &, TypeList<T>)
+   {
+      throw std::logic_error("Define \"" + fName + "\" does not compute a RVec of varied values.");
    }
 
 public:
    RDefine(std::string_view name, std::string_view type, F expression, const ROOT::RDF::ColumnNames_t &columns,
-           unsigned int nSlots, const RDFInternal::RBookedDefines &defines,
-           const std::map<std::string, std::vector<void *>> &DSValuePtrs, ROOT::RDF::RDataSource *ds)
-      : RDefineBase(name, type, nSlots, defines, DSValuePtrs, ds), fExpression(std::move(expression)),
-        fColumnNames(columns), fLastResults(fNSlots * RDFInternal::CacheLineStep<ret_type>()), fValues(fNSlots),
-        fIsDefine()
+           const RDFInternal::RBookedDefines &defines, RLoopManager &lm)
+      : RDefineBase(name, type, defines, lm), fExpression(std::move(expression)), fColumnNames(columns),
+        fLastResults(fNSlots * RDFInternal::CacheLineStep<ret_type>()), fValues(fNSlots), fIsDefine(),
+        fBatchValues(fNSlots), fBatchComputed(fNSlots), fLastBatchId(fNSlots * RDFInternal::CacheLineStep<Long64_t>())
    {
       const auto nColumns = fColumnNames.size();
-      for (auto i = 0u; i < nColumns; ++i)
+      for (auto i = 0u; i < nColumns; ++i) {
          fIsDefine[i] = fDefines.HasName(fColumnNames[i]);
+         if (fIsDefine[i])
+            fInputDefines.emplace_back(fDefines.GetColumns().at(fColumnNames[i]).get());
+      }
+      fProfile.SetColumnNames(fColumnNames);
    }
 
    RDefine(const RDefine &) = delete;
@@ -122,9 +239,16 @@ public:
          for (auto &define : fDefines.GetColumns())
             define.second->InitSlot(r, slot);
          fIsInitialized[slot] = true;
-         RDFInternal::RColumnReadersInfo info{fColumnNames, fDefines, fIsDefine.data(), fDSValuePtrs, fDataSource};
+         auto *batch = fLoopManager->GetBatch(slot);
+         RDFInternal::RColumnReadersInfo info{fColumnNames, fDefines,   fIsDefine.data(),
+                                              fDSValuePtrs, fDataSource, batch,
+                                              fLoopManager->IsProfilingEnabled() ? &fProfile : nullptr};
          fValues[slot] = RDFInternal::MakeColumnReaders(slot, r, ColumnTypes_t{}, info);
          fLastCheckedEntry[slot * RDFInternal::CacheLineStep<Long64_t>()] = -1;
+         if (batch != nullptr) {
+            fBatchValues[slot].resize(batch->GetMaxSize());
+            fLastBatchId[slot * RDFInternal::CacheLineStep<Long64_t>()] = -1;
+         }
       }
    }
 
@@ -139,11 +263,46 @@ public:
    {
       if (entry != fLastCheckedEntry[slot * RDFInternal::CacheLineStep<Long64_t>()]) {
          // evaluate this filter, cache the result
-         UpdateHelper(slot, entry, ColumnTypes_t{}, TypeInd_t{}, ExtraArgsTag{});
+         if (fLoopManager->IsProfilingEnabled()) {
+            // evaluate the Defines among the input columns first, so that their time is recorded in their own profile
+            for (auto *define : fInputDefines)
+               define->Update(slot, entry);
+            RDFInternal::RProfileTimer timer(&fProfile, slot);
+            fLastResults[slot * RDFInternal::CacheLineStep<ret_type>()] =
+               Eval(slot, entry, entry, ColumnTypes_t{}, TypeInd_t{}, ExtraArgsTag{});
+         } else {
+            fLastResults[slot * RDFInternal::CacheLineStep<ret_type>()] =
+               Eval(slot, entry, entry, ColumnTypes_t{}, TypeInd_t{}, ExtraArgsTag{});
+         }
          fLastCheckedEntry[slot * RDFInternal::CacheLineStep<Long64_t>()] = entry;
       }
    }
 
+   /// Compute the values for the entries of the batch that are selected by mask, if not computed yet
+   void UpdateBatch(unsigned int slot, const RDFInternal::RBatch &batch, const std::vector<char> &mask) final
+   {
+      auto &computed = fBatchComputed[slot];
+      auto &lastBatchId = fLastBatchId[slot * RDFInternal::CacheLineStep<Long64_t>()];
+      if (batch.GetId() != lastBatchId) {
+         computed.assign(batch.GetSize(), 0);
+         lastBatchId = batch.GetId();
+      }
+
+      for (auto *define : fInputDefines)
+         define->UpdateBatch(slot, batch, mask);
+
+      RDFInternal::RProfileTimer timer(fLoopManager->IsProfilingEnabled() ? &fProfile : nullptr, slot);
+      const auto nComputed = ComputeBatch(slot, batch, mask, computed, ColumnTypes_t{}, TypeInd_t{},
+                                          RDFInternal::IsBatchFunction<F>{});
+      timer.SetNEntries(nComputed);
+   }
+
+   /// Return the (type-erased) address of the Define'd value for the entry at position idx of the current batch.
+   void *GetBatchValuePtr(unsigned int slot, std::size_t idx) final
+   {
+      return static_cast<void *>(&fBatchValues[slot][idx]);
+   }
+
    const std::type_info &GetTypeId() const { return typeid(ret_type); }
 
    /// Clean-up operations to be performed at the end of a task.
@@ -152,6 +311,7 @@ public:
       if (fIsInitialized[slot]) {
          for (auto &v : fValues[slot])
             v.reset();
+         fBatchValues[slot].clear();
          fIsInitialized[slot] = false;
       }
    }
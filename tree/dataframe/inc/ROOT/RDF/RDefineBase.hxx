@@ -13,6 +13,7 @@
 
 #include "ROOT/RDF/GraphNode.hxx"
 #include "ROOT/RDF/RBookedDefines.hxx"
+#include "ROOT/RDF/RNodeProfile.hxx"
 
 #include <deque>
 #include <map>
@@ -26,11 +27,18 @@ namespace ROOT {
 namespace RDF {
 class RDataSource;
 }
+namespace Internal {
+namespace RDF {
+class RBatch;
+}
+}
 namespace Detail {
 namespace RDF {
 
 namespace RDFInternal = ROOT::Internal::RDF;
 
+class RLoopManager;
+
 class RDefineBase {
 protected:
    const std::string fName; ///< The name of the custom column
@@ -46,13 +54,25 @@ protected:
    std::deque<bool> fIsInitialized; // because vector<bool> is not thread-safe
    const std::map<std::string, std::vector<void *>> &fDSValuePtrs; // reference to RLoopManager's data member
    ROOT::RDF::RDataSource *fDataSource; ///< non-owning ptr to the RDataSource, if any. Used to retrieve column readers.
+   RLoopManager *fLoopManager; ///< non-owning ptr to the RLoopManager. Used to retrieve the batches in batched execution.
+   RDFInternal::RNodeProfile fProfile; ///< Time spent and entries processed, filled if profiling is enabled
+   /// Varied copies of this Define, by variation key, see GetVariedDefine
+   std::map<std::string, std::shared_ptr<RDefineBase>> fVariedDefines;
+   /// Defines that read one of the varied values computed by this Define, by "columnName:tagIndex", see GetTagDefine.
+   /// They are owned by the varied nodes that use them: they read this Define, which must not own them in turn.
+   std::map<std::string, std::weak_ptr<RDefineBase>> fTagDefines;
 
    static unsigned int GetNextID();
 
+   /// Return a new copy of this Define that reads its input columns from the given defines.
+   virtual std::shared_ptr<RDefineBase> MakeVariedDefine(const RDFInternal::RBookedDefines &defines);
+   /// Return a new Define, called colName, that returns the element tagIdx of the RVec computed by this Define.
+   virtual std::shared_ptr<RDefineBase>
+   MakeTagDefine(std::size_t tagIdx, const std::string &colName, const RDFInternal::RBookedDefines &defines);
+
 public:
-   RDefineBase(std::string_view name, std::string_view type, unsigned int nSlots,
-               const RDFInternal::RBookedDefines &defines,
-               const std::map<std::string, std::vector<void *>> &DSValuePtrs, ROOT::RDF::RDataSource *ds);
+   RDefineBase(std::string_view name, std::string_view type, const RDFInternal::RBookedDefines &defines,
+               RLoopManager &lm);
 
    RDefineBase &operator=(const RDefineBase &) = delete;
    RDefineBase &operator=(RDefineBase &&) = delete;
@@ -65,10 +85,24 @@ public:
    std::string GetTypeName() const;
    /// Update the value at the address returned by GetValuePtr with the content corresponding to the given entry
    virtual void Update(unsigned int slot, Long64_t entry) = 0;
+   /// Compute the values for the entries of the batch that are selected by mask, if not computed yet (batched
+   /// execution only, see RDFInternal::RBatch).
+   virtual void UpdateBatch(unsigned int slot, const RDFInternal::RBatch &batch, const std::vector<char> &mask) = 0;
+   /// Return the (type-erased) address of the Define'd value for the entry at position idx of the current batch.
+   virtual void *GetBatchValuePtr(unsigned int slot, std::size_t idx) = 0;
    /// Clean-up operations to be performed at the end of a task.
    virtual void FinaliseSlot(unsigned int slot) = 0;
    /// Return the unique identifier of this RDefineBase.
    unsigned int GetID() const { return fID; }
+   /// Return the profile of this Define, see RLoopManager::EnableProfiling
+   virtual const RDFInternal::RNodeProfile &GetProfile() const { return fProfile; }
+   /// Return the copy of this Define that computes its values for the given varied value of a systematic variation.
+   /// The copy is created on first use and shared by all the nodes that use it.
+   virtual std::shared_ptr<RDefineBase> GetVariedDefine(const RDFInternal::RVariationKey &key);
+   /// Return the Define that returns the varied value of column colName with index tagIdx, reading the RVec of
+   /// varied values computed by this Define (see RInterface::Vary). The Define is created on first use.
+   std::shared_ptr<RDefineBase>
+   GetTagDefine(std::size_t tagIdx, const std::string &colName, const RDFInternal::RBookedDefines &defines);
 };
 
 } // ns RDF
@@ -51,6 +51,26 @@ public:
    }
 };
 
+/// Column reader for defined (aka custom) columns in batched execution.
+/// The argument of Get is the position of the entry in the batch: the values of the Define for the selected entries
+/// of the batch are computed upfront via RDefineBase::UpdateBatch.
+class R__CLING_PTRCHECK(off) RBatchDefineReader final : public ROOT::Detail::RDF::RColumnReaderBase {
+   /// Non-owning reference to the node responsible for the custom column.
+   RDFDetail::RDefineBase &fDefine;
+
+   /// The slot this value belongs to.
+   unsigned int fSlot = std::numeric_limits<unsigned int>::max();
+
+   void *GetImpl(Long64_t idx) final { return fDefine.GetBatchValuePtr(fSlot, idx); }
+
+public:
+   RBatchDefineReader(unsigned int slot, RDFDetail::RDefineBase &define, const std::type_info &tid)
+      : fDefine(define), fSlot(slot)
+   {
+      CheckDefineType(define, tid);
+   }
+};
+
 }
 }
 }
@@ -12,6 +12,7 @@
 #define ROOT_RFILTER
 
 #include "ROOT/RDF/ColumnReaderUtils.hxx"
+#include "ROOT/RDF/RBatch.hxx"
 #include "ROOT/RDF/RColumnReaderBase.hxx"
 #include "ROOT/RDF/RCutFlowReport.hxx"
 #include "ROOT/RDF/Utils.hxx"
@@ -22,7 +23,9 @@
 
 #include <algorithm>
 #include <memory>
+#include <stdexcept>
 #include <string>
+#include <type_traits>
 #include <utility> // std::index_sequence
 #include <vector>
 
@@ -62,6 +65,23 @@ class R__CLING_PTRCHECK(off) RFilter final : public RFilterBase {
    std::vector<std::array<std::unique_ptr<RColumnReaderBase>, ColumnTypes_t::list_size>> fValues;
    /// The nth flag signals whether the nth input column is a custom column or not.
    std::array<bool, ColumnTypes_t::list_size> fIsDefine;
+   /// The Defines read by this filter, updated before the filter is checked on a batch (only for the entries that
+   /// passed the previous filters) or, when profiling, on an entry.
+   std::vector<RDefineBase *> fInputDefines;
+
+   std::unique_ptr<RFilterBase> MakeVariedFilterImpl(std::shared_ptr<PrevDataFrame> prev,
+                                                     const RDFInternal::RBookedDefines &defines, std::true_type)
+   {
+      // varied copies are unnamed: they do not appear in the cut-flow report
+      return std::unique_ptr<RFilterBase>(new RFilter(fFilter, fColumnNames, std::move(prev), defines));
+   }
+
+   std::unique_ptr<RFilterBase>
+   MakeVariedFilterImpl(std::shared_ptr<PrevDataFrame>, const RDFInternal::RBookedDefines &, std::false_type)
+   {
+      throw std::runtime_error("VariationsFor: a Filter depends on varied columns but its expression cannot be copied "
+                               "to select the entries of each variation.");
+   }
 
 public:
    RFilter(FilterF f, const ROOT::RDF::ColumnNames_t &columns, std::shared_ptr<PrevDataFrame> pd,
@@ -71,8 +91,12 @@ public:
         fValues(fNSlots), fIsDefine()
    {
       const auto nColumns = fColumnNames.size();
-      for (auto i = 0u; i < nColumns; ++i)
+      for (auto i = 0u; i < nColumns; ++i) {
          fIsDefine[i] = fDefines.HasName(fColumnNames[i]);
+         if (fIsDefine[i])
+            fInputDefines.emplace_back(fDefines.GetColumns().at(fColumnNames[i]).get());
+      }
+      fProfile.SetColumnNames(fColumnNames);
    }
 
    RFilter(const RFilter &) = delete;
@@ -89,7 +113,9 @@ public:
             fLastResult[slot * RDFInternal::CacheLineStep<int>()] = false;
          } else {
             // evaluate this filter, cache the result
-            auto passed = CheckFilterHelper(slot, entry, ColumnTypes_t{}, TypeInd_t{});
+            auto passed = fLoopManager->IsProfilingEnabled()
+                             ? CheckFilterProfiled(slot, entry)
+                             : CheckFilterHelper(slot, entry, ColumnTypes_t{}, TypeInd_t{});
             passed ? ++fAccepted[slot * RDFInternal::CacheLineStep<ULong64_t>()]
                    : ++fRejected[slot * RDFInternal::CacheLineStep<ULong64_t>()];
             fLastResult[slot * RDFInternal::CacheLineStep<int>()] = passed;
@@ -99,6 +125,36 @@ public:
       return fLastResult[slot * RDFInternal::CacheLineStep<int>()];
    }
 
+   const std::vector<char> &CheckFiltersBatch(unsigned int slot, const RDFInternal::RBatch &batch) final
+   {
+      auto &mask = fBatchMasks[slot];
+      if (batch.GetId() != fLastCheckedBatch[slot * RDFInternal::CacheLineStep<Long64_t>()]) {
+         // entries rejected upstream stay rejected, the others are evaluated by this filter
+         mask = fPrevData.CheckFiltersBatch(slot, batch);
+         for (auto *define : fInputDefines)
+            define->UpdateBatch(slot, batch, mask);
+         const auto size = batch.GetSize();
+         ULong64_t nChecked = 0;
+         ULong64_t nPassed = 0;
+         {
+            RDFInternal::RProfileTimer timer(fLoopManager->IsProfilingEnabled() ? &fProfile : nullptr, slot);
+            for (std::size_t i = 0u; i < size; ++i) {
+               if (mask[i]) {
+                  const bool passed = CheckFilterHelper(slot, i, ColumnTypes_t{}, TypeInd_t{});
+                  mask[i] = passed;
+                  ++nChecked;
+                  nPassed += passed;
+               }
+            }
+            timer.SetNEntries(nChecked);
+         }
+         fAccepted[slot * RDFInternal::CacheLineStep<ULong64_t>()] += nPassed;
+         fRejected[slot * RDFInternal::CacheLineStep<ULong64_t>()] += nChecked - nPassed;
+         fLastCheckedBatch[slot * RDFInternal::CacheLineStep<Long64_t>()] = batch.GetId();
+      }
+      return mask;
+   }
+
    template <typename... ColTypes, std::size_t... S>
    bool CheckFilterHelper(unsigned int slot, Long64_t entry, TypeList<ColTypes...>, std::index_sequence<S...>)
    {
@@ -108,12 +164,27 @@ public:
       return fFilter(fValues[slot][S]->template Get<ColTypes>(entry)...);
    }
 
+   /// Evaluate the filter and record the time spent in the profile of this node. The Defines among the input columns
+   /// are evaluated first, so that their time is recorded in their own profile.
+   bool CheckFilterProfiled(unsigned int slot, Long64_t entry)
+   {
+      for (auto *define : fInputDefines)
+         define->Update(slot, entry);
+      RDFInternal::RProfileTimer timer(&fProfile, slot);
+      return CheckFilterHelper(slot, entry, ColumnTypes_t{}, TypeInd_t{});
+   }
+
    void InitSlot(TTreeReader *r, unsigned int slot) final
    {
       for (auto &bookedBranch : fDefines.GetColumns())
          bookedBranch.second->InitSlot(r, slot);
-      RDFInternal::RColumnReadersInfo info{fColumnNames, fDefines, fIsDefine.data(), fLoopManager->GetDSValuePtrs(),
-                                           fLoopManager->GetDataSource()};
+      RDFInternal::RColumnReadersInfo info{fColumnNames,
+                                           fDefines,
+                                           fIsDefine.data(),
+                                           fLoopManager->GetDSValuePtrs(),
+                                           fLoopManager->GetDataSource(),
+                                           fLoopManager->GetBatch(slot),
+                                           fLoopManager->IsProfilingEnabled() ? &fProfile : nullptr};
       fValues[slot] = RDFInternal::MakeColumnReaders(slot, r, ColumnTypes_t{}, info);
    }
 
@@ -164,6 +235,17 @@ public:
          v.reset();
    }
 
+   std::unique_ptr<RFilterBase> MakeVariedFilter(const RDFInternal::RVariationKey &key) final
+   {
+      auto prev = std::static_pointer_cast<PrevDataFrame>(fPrevData.GetVariedFilter(key));
+      if (prev == nullptr) {
+         if (!fDefines.DependsOnVariation(fColumnNames, key.fName))
+            return nullptr;
+         prev = fPrevDataPtr;
+      }
+      return MakeVariedFilterImpl(std::move(prev), fDefines.GetVaried(key), std::is_copy_constructible<FilterF>{});
+   }
+
    std::shared_ptr<RDFGraphDrawing::GraphNode> GetGraph()
    {
       // Recursively call for the previous node.
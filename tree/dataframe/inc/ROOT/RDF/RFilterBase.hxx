@@ -13,9 +13,12 @@
 
 #include "ROOT/RDF/RBookedDefines.hxx"
 #include "ROOT/RDF/RNodeBase.hxx"
+#include "ROOT/RDF/RNodeProfile.hxx"
 #include "RtypesCore.h"
 #include "TError.h" // R_ASSERT
 
+#include <map>
+#include <memory>
 #include <string>
 #include <vector>
 
@@ -39,10 +42,15 @@ protected:
    std::vector<int> fLastResult = {true}; // std::vector<bool> cannot be used in a MT context safely
    std::vector<ULong64_t> fAccepted = {0};
    std::vector<ULong64_t> fRejected = {0};
+   std::vector<std::vector<char>> fBatchMasks; ///< Selection mask of the current batch, per slot (batched execution)
+   std::vector<Long64_t> fLastCheckedBatch;    ///< Id of the batch fBatchMasks refer to, per slot (batched execution)
    const std::string fName;
    const unsigned int fNSlots; ///< Number of thread slots used by this node, inherited from parent node.
 
    RDFInternal::RBookedDefines fDefines;
+   RDFInternal::RNodeProfile fProfile; ///< Time spent and entries processed, filled if profiling is enabled
+   /// Varied copies of this filter by variation key, nullptr for the variations that do not affect it
+   std::map<std::string, std::shared_ptr<RNodeBase>> fVariedFilters;
 
 public:
    RFilterBase(RLoopManager *df, std::string_view name, const unsigned int nSlots,
@@ -67,6 +75,12 @@ public:
    virtual void FinaliseSlot(unsigned int slot) = 0;
    virtual void InitNode();
    virtual void AddFilterName(std::vector<std::string> &filters) = 0;
+   /// Return the profile of this filter, see RLoopManager::EnableProfiling
+   virtual const RDFInternal::RNodeProfile &GetProfile() const { return fProfile; }
+   /// Return a new, not booked, copy of this filter for the given varied value of a systematic variation, or nullptr
+   /// if neither this filter nor the nodes upstream depend on the variation.
+   virtual std::unique_ptr<RFilterBase> MakeVariedFilter(const RDFInternal::RVariationKey &key) = 0;
+   std::shared_ptr<RNodeBase> GetVariedFilter(const RDFInternal::RVariationKey &key) final;
 };
 
 } // ns RDF
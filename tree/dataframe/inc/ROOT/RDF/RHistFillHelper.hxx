@@ -0,0 +1,174 @@
+/**
+ \file ROOT/RDF/RHistFillHelper.hxx
+ \ingroup dataframe
+*/
+
+/*************************************************************************
+ * Copyright (C) 1995-2021, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#ifndef ROOT_RDF_RHISTFILLHELPER
+#define ROOT_RDF_RHISTFILLHELPER
+
+#include "ROOT/RDF/ActionHelpers.hxx" // RActionImpl
+#include "ROOT/RDF/Utils.hxx"         // IsDataContainer
+#include "ROOT/RHistConcurrentFill.hxx"
+
+#include <cstddef>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace ROOT {
+namespace RDF {
+namespace Experimental {
+
+// clang-format off
+/**
+\class ROOT::RDF::Experimental::RHistFillHelper
+\ingroup dataframe
+\brief Action helper filling a v7 histogram (ROOT::Experimental::RHist) from all slots of the event loop.
+
+The slots do not fill clones of the histogram: each of them buffers its Fill calls in a
+ROOT::Experimental::RHistConcurrentFiller, which submits them to the single histogram through a
+ROOT::Experimental::RHistConcurrentFillManager when its buffer of SIZE entries is full. The memory used is
+that of the histogram plus one buffer per slot.
+
+The helper is booked with RInterface::Book, with one column per axis of the histogram and optionally a
+weight column. Either all the columns are scalars, or all of them are collections of the same size:
+
+~~~{.cpp}
+using ROOT::Experimental::RH2D;
+ROOT::EnableImplicitMT();
+ROOT::RDataFrame df("tree", "file.root");
+auto hist = std::make_shared<RH2D>(ROOT::Experimental::RAxisConfig{100, 0., 1.},
+                                   ROOT::Experimental::RAxisConfig{100, 0., 1.});
+ROOT::RDF::Experimental::RHistFillHelper<RH2D> helper(hist, df.GetNSlots());
+auto h = df.Book<double, double, double>(std::move(helper), {"x", "y", "w"});
+~~~
+*/
+// clang-format on
+template <class HIST, int SIZE = 1024>
+class RHistFillHelper : public ROOT::Detail::RDF::RActionImpl<RHistFillHelper<HIST, SIZE>> {
+public:
+   using Result_t = HIST;
+
+private:
+   using CoordArray_t = typename HIST::CoordArray_t;
+   using Weight_t = typename HIST::Weight_t;
+   using FillManager_t = ROOT::Experimental::RHistConcurrentFillManager<HIST, SIZE>;
+   using Filler_t = ROOT::Experimental::RHistConcurrentFiller<HIST, SIZE>;
+
+   static constexpr int kNDim = HIST::GetNDim();
+
+   std::shared_ptr<HIST> fHist;
+   unsigned int fNSlots;
+   std::unique_ptr<FillManager_t> fFillManager;
+   /// One per slot. The fillers flush their buffer when destroyed, they must not be copied.
+   std::vector<std::unique_ptr<Filler_t>> fFillers;
+
+   template <typename... Xs>
+   static constexpr std::size_t NContainers()
+   {
+      std::size_t n = 0;
+      for (bool isContainer : {false, ROOT::Internal::RDF::IsDataContainer<Xs>::value...})
+         n += isContainer;
+      return n;
+   }
+
+   template <typename... Xs>
+   static constexpr void CheckNColumns()
+   {
+      static_assert(sizeof...(Xs) == kNDim || sizeof...(Xs) == kNDim + 1,
+                    "RHistFillHelper needs one column per axis of the histogram, plus optionally a weight column.");
+   }
+
+   void FillSlot(unsigned int slot, const double *values, std::size_t nValues)
+   {
+      CoordArray_t x;
+      for (int i = 0; i < kNDim; ++i)
+         x[i] = values[i];
+      const Weight_t weight = nValues > std::size_t(kNDim) ? (Weight_t)values[kNDim] : (Weight_t)1;
+      fFillers[slot]->Fill(x, weight);
+   }
+
+public:
+   RHistFillHelper(const std::shared_ptr<HIST> &hist, unsigned int nSlots)
+      : fHist(hist), fNSlots(nSlots), fFillManager(new FillManager_t(*fHist))
+   {
+      for (unsigned int i = 0; i < nSlots; ++i)
+         fFillers.emplace_back(new Filler_t(*fFillManager));
+   }
+   RHistFillHelper(RHistFillHelper &&) = default;
+   RHistFillHelper(const RHistFillHelper &) = delete;
+
+   void Initialize() {}
+
+   void InitTask(TTreeReader *, unsigned int) {}
+
+   template <typename... Xs, std::enable_if_t<NContainers<Xs...>() == 0, int> = 0>
+   void Exec(unsigned int slot, const Xs &... xs)
+   {
+      CheckNColumns<Xs...>();
+      const double values[] = {double(xs)...};
+      FillSlot(slot, values, sizeof...(Xs));
+   }
+
+   template <typename... Xs, std::enable_if_t<NContainers<Xs...>() == sizeof...(Xs), int> = 0>
+   void Exec(unsigned int slot, const Xs &... xs)
+   {
+      CheckNColumns<Xs...>();
+      const std::size_t sizes[] = {std::size_t(xs.size())...};
+      for (auto size : sizes) {
+         if (size != sizes[0])
+            throw std::runtime_error("Cannot fill histogram with values in containers of different sizes.");
+      }
+      for (std::size_t i = 0; i < sizes[0]; ++i) {
+         const double values[] = {double(xs[i])...};
+         FillSlot(slot, values, sizeof...(Xs));
+      }
+   }
+
+   template <typename... Xs,
+             std::enable_if_t<NContainers<Xs...>() != 0 && NContainers<Xs...>() != sizeof...(Xs), int> = 0>
+   void Exec(unsigned int, const Xs &...)
+   {
+      throw std::runtime_error("Cannot fill histogram with a mix of scalar and collection columns.");
+   }
+
+   void FinalizeTask(unsigned int slot) { fFillers[slot]->Flush(); }
+
+   void Finalize()
+   {
+      for (auto &filler : fFillers)
+         filler->Flush();
+   }
+
+   /// The partial result is the shared histogram, which other slots can be filling
+   HIST &PartialUpdate(unsigned int slot)
+   {
+      fFillers[slot]->Flush();
+      return *fHist;
+   }
+
+   std::shared_ptr<HIST> GetResultPtr() const { return fHist; }
+
+   std::string GetActionName() { return "FillRHist"; }
+
+   RHistFillHelper MakeNew(void *newResult)
+   {
+      auto &result = *static_cast<std::shared_ptr<HIST> *>(newResult);
+      return RHistFillHelper(result, fNSlots);
+   }
+};
+
+} // namespace Experimental
+} // namespace RDF
+} // namespace ROOT
+
+#endif
@@ -23,6 +23,7 @@
 #include "ROOT/RDF/RRange.hxx"
 #include "ROOT/RDF/Utils.hxx"
 #include "ROOT/RResultPtr.hxx"
+#include "ROOT/RCacheOptions.hxx"
 #include "ROOT/RSnapshotOptions.hxx"
 #include "ROOT/RStringView.hxx"
 #include "ROOT/TypeTraits.hxx"
@@ -202,7 +203,8 @@ public:
 
       auto filterPtr = std::make_shared<F_t>(std::move(f), validColumnNames, fProxiedPtr, fDefines, name);
       fLoopManager->Book(filterPtr.get());
-      return RInterface<F_t, DS_t>(std::move(filterPtr), *fLoopManager, fDefines, fDataSource);
+      return RInterface<F_t, DS_t>(std::move(filterPtr), *fLoopManager, DefinesAfterFilter(validColumnNames),
+                                   fDataSource);
    }
 
    ////////////////////////////////////////////////////////////////////////////
@@ -252,17 +254,19 @@ public:
    /// ~~~
    RInterface<RDFDetail::RJittedFilter, DS_t> Filter(std::string_view expression, std::string_view name = "")
    {
-      // deleted by the jitted call to JitFilterHelper
+      // deleted by the jitted call to JitFilterHelper, or by BookFilterJit if the filter is shared
       auto upcastNodeOnHeap = RDFInternal::MakeSharedOnHeap(RDFInternal::UpcastNode(fProxiedPtr));
       using BaseNodeType_t = typename std::remove_pointer_t<decltype(upcastNodeOnHeap)>::element_type;
       RInterface<BaseNodeType_t> upcastInterface(*upcastNodeOnHeap, *fLoopManager, fDefines, fDataSource);
       const auto jittedFilter = std::make_shared<RDFDetail::RJittedFilter>(fLoopManager, name);
 
-      RDFInternal::BookFilterJit(jittedFilter, upcastNodeOnHeap, name, expression, fLoopManager->GetAliasMap(),
-                                 fLoopManager->GetBranchNames(), fDefines, fLoopManager->GetTree(), fDataSource);
+      // the filter to use is jittedFilter, or an identical one booked before, see EnableJitNodeSharing
+      auto filter =
+         RDFInternal::BookFilterJit(jittedFilter, upcastNodeOnHeap, name, expression, fLoopManager->GetAliasMap(),
+                                    fLoopManager->GetBranchNames(), fDefines, fLoopManager->GetTree(), fDataSource);
 
-      fLoopManager->Book(jittedFilter.get());
-      return RInterface<RDFDetail::RJittedFilter, DS_t>(std::move(jittedFilter), *fLoopManager, fDefines, fDataSource);
+      return RInterface<RDFDetail::RJittedFilter, DS_t>(std::move(filter), *fLoopManager,
+                                                        DefinesAfterFilter(FindUsedColumns(expression)), fDataSource);
    }
 
    // clang-format off
@@ -387,6 +391,7 @@ public:
 
       RDFInternal::RBookedDefines newCols(fDefines);
       newCols.AddColumn(jittedDefine, name);
+      newCols.AddDefineVariations(name, fDefines.GetVariationNames(FindUsedColumns(expression)));
 
       RInterface<Proxied, DS_t> newInterface(fProxiedPtr, *fLoopManager, std::move(newCols), fDataSource);
 
@@ -465,6 +470,7 @@ public:
       RDFInternal::CheckForDefinition(where, name, fDefines.GetNames(), fLoopManager->GetAliasMap(),
                                       fLoopManager->GetBranchNames(),
                                       fDataSource ? fDataSource->GetColumnNames() : ColumnNames_t{});
+      CheckNotVaried(where, name);
 
       auto upcastNodeOnHeap = RDFInternal::MakeSharedOnHeap(RDFInternal::UpcastNode(fProxiedPtr));
       auto jittedDefine = RDFInternal::BookDefineJit(name, expression, *fLoopManager, fDataSource, fDefines,
@@ -472,6 +478,7 @@ public:
 
       RDFInternal::RBookedDefines newCols(fDefines);
       newCols.AddColumn(jittedDefine, name);
+      newCols.AddDefineVariations(name, fDefines.GetVariationNames(FindUsedColumns(expression)));
 
       RInterface<Proxied, DS_t> newInterface(fProxiedPtr, *fLoopManager, std::move(newCols), fDataSource);
 
@@ -517,6 +524,118 @@ public:
       return newInterface;
    }
 
+   // clang-format off
+   ////////////////////////////////////////////////////////////////////////////
+   /// \brief Register systematic variations for an existing column.
+   /// \param[in] colName The name of the column to vary.
+   /// \param[in] expression Function, lambda expression, functor class or any other callable object producing the varied values. It must return a RVec with one varied value per tag.
+   /// \param[in] inputColumns Names of the columns/branches in input to the expression.
+   /// \param[in] variationTags The names of the varied values, e.g. {"down", "up"}.
+   /// \param[in] variationName The name of the variation, by default the name of the column.
+   /// \return the first node of the computation graph for which the variation is available.
+   ///
+   /// The varied values are computed once per entry, together with the nominal values of the column, and
+   /// ROOT::RDF::Experimental::VariationsFor() produces the results of an action for each varied
+   /// value in the same event loop as the nominal result. The results are indexed by "variationName:tag".
+   /// The type of the elements of the RVec returned by `expression` must be the type of the column.
+   ///
+   /// Several columns can be varied together by registering their variations with the same `variationName` and the
+   /// same tags: in that case the ith varied values of all the columns are used together.
+   ///
+   /// The variations are propagated through the computation graph: for each varied value, the Defines that depend
+   /// on the varied column are evaluated again on the varied value, and the Filters that depend on it select
+   /// the entries again. Defines and Filters that do not depend on a variation are evaluated once for all variations.
+   ///
+   /// ### Example usage:
+   /// ~~~{.cpp}
+   /// auto nominal_hx = df.Vary("pt", [](double pt) { return ROOT::RVec<double>{pt * 0.9, pt * 1.1}; }, {"pt"}, {"down", "up"})
+   ///                     .Histo1D<double>("pt");
+   /// auto hx = ROOT::RDF::Experimental::VariationsFor(nominal_hx);
+   /// hx["pt:up"].Draw();
+   /// ~~~
+   // clang-format on
+   template <typename F, std::enable_if_t<!std::is_convertible<F, std::string>::value, int> = 0>
+   RInterface<Proxied, DS_t> Vary(std::string_view colName, F expression, const ColumnNames_t &inputColumns,
+                                  const std::vector<std::string> &variationTags, std::string_view variationName = "")
+   {
+      using RetType = typename TTraits::CallableTraits<F>::ret_type;
+      static_assert(RDFInternal::IsRVec_t<RetType>::value,
+                    "Error in `Vary`: the expression must return a RVec with one varied value per tag.");
+
+      const std::string where = "Vary";
+      std::string varName;
+      const auto validColName = CheckVaryArgs(where, colName, variationTags, variationName, varName);
+
+      using ColTypes_t = typename TTraits::CallableTraits<F>::arg_types;
+      constexpr auto nColumns = ColTypes_t::list_size;
+      const auto validColumnNames = GetValidatedColumnNames(nColumns, inputColumns);
+      CheckAndFillDSColumns(validColumnNames, ColTypes_t());
+      if (!fDefines.GetVariationNames(validColumnNames).empty())
+         throw std::runtime_error(where + ": the varied values of column \"" + validColName +
+                                  "\" cannot be computed from varied columns.");
+
+      auto retTypeName = RDFInternal::TypeID2TypeName(typeid(RetType));
+      if (retTypeName.empty())
+         retTypeName = "CLING_UNKNOWN_TYPE_" + RDFInternal::DemangleTypeIdName(typeid(RetType));
+
+      // the varied values are computed by a Define with an internal name, hidden from the user
+      const auto defineName = GetVariationDefineName(validColName);
+
+      using NewCol_t = RDFDetail::RDefine<F, RDFDetail::CustomColExtraArgs::None>;
+      auto newColumn = std::make_shared<NewCol_t>(defineName, retTypeName, std::move(expression), validColumnNames,
+                                                  fDefines, *fLoopManager);
+
+      RDFInternal::RBookedDefines newCols(fDefines);
+      newCols.AddColumn(newColumn, defineName);
+      newCols.AddVariation({varName, variationTags, validColName, defineName});
+
+      RInterface<Proxied, DS_t> newInterface(fProxiedPtr, *fLoopManager, std::move(newCols), fDataSource);
+
+      return newInterface;
+   }
+
+   ////////////////////////////////////////////////////////////////////////////
+   /// \brief Register systematic variations for an existing column, computed by a jitted expression.
+   /// \param[in] colName The name of the column to vary.
+   /// \param[in] expression An expression in C++ which returns a RVec with one varied value per tag.
+   /// \param[in] variationTags The names of the varied values, e.g. {"down", "up"}.
+   /// \param[in] variationName The name of the variation, by default the name of the column.
+   /// \return the first node of the computation graph for which the variation is available.
+   ///
+   /// The expression is just-in-time compiled, as the expression of a jitted Define. See the first overload of this
+   /// method for the full documentation.
+   ///
+   /// ### Example usage:
+   /// ~~~{.cpp}
+   /// auto nominal_hx = df.Vary("pt", "ROOT::RVecD{pt * 0.9, pt * 1.1}", {"down", "up"}).Histo1D("pt");
+   /// ~~~
+   RInterface<Proxied, DS_t> Vary(std::string_view colName, std::string_view expression,
+                                  const std::vector<std::string> &variationTags, std::string_view variationName = "")
+   {
+      const std::string where = "Vary";
+      std::string varName;
+      const auto validColName = CheckVaryArgs(where, colName, variationTags, variationName, varName);
+      if (!fDefines.GetVariationNames(FindUsedColumns(expression)).empty())
+         throw std::runtime_error(where + ": the varied values of column \"" + validColName +
+                                  "\" cannot be computed from varied columns.");
+
+      const auto defineName = GetVariationDefineName(validColName);
+      auto upcastNodeOnHeap = RDFInternal::MakeSharedOnHeap(RDFInternal::UpcastNode(fProxiedPtr));
+      auto jittedDefine = RDFInternal::BookDefineJit(defineName, expression, *fLoopManager, fDataSource, fDefines,
+                                                     fLoopManager->GetBranchNames(), upcastNodeOnHeap);
+      if (jittedDefine->GetTypeName().find("RVec<") == std::string::npos)
+         throw std::runtime_error(where + ": the expression must return a RVec with one varied value per tag, but it "
+                                          "returns \"" + jittedDefine->GetTypeName() + "\".");
+
+      RDFInternal::RBookedDefines newCols(fDefines);
+      newCols.AddColumn(jittedDefine, defineName);
+      newCols.AddVariation({varName, variationTags, validColName, defineName});
+
+      RInterface<Proxied, DS_t> newInterface(fProxiedPtr, *fLoopManager, std::move(newCols), fDataSource);
+
+      return newInterface;
+   }
+
    ////////////////////////////////////////////////////////////////////////////
    /// \brief Save selected columns to disk, in a new TTree `treename` in file `filename`.
    /// \tparam ColumnTypes variadic list of branch/column types.
@@ -570,6 +689,26 @@ public:
    /// opts.fLazy = true;
    /// df.Snapshot("outputTree", "outputFile.root", {"x"}, opts);
    /// ~~~
+   ///
+   /// To write an RNTuple instead of a TTree (requires ROOT to be built with root7), set the output format in
+   /// `RSnapshotOptions`. The page and cluster sizes of the RNTuple are also set there. In multi-thread runs, every
+   /// slot fills and compresses its own clusters, and all clusters are written to the same file without a merging step.
+   /// The output file must be opened in "RECREATE" mode and the RNTuple cannot be written to a subdirectory.
+   /// RVec columns are written as `std::vector` fields.
+   /// ~~~{.cpp}
+   /// RSnapshotOptions opts;
+   /// opts.fOutputFormat = ROOT::RDF::ESnapshotOutputFormat::kRNTuple;
+   /// auto ntupleDF = df.Snapshot("outputNTuple", "outputFile.root", {"x"}, opts);
+   /// ~~~
+   ///
+   /// Parquet files are written the same way (requires ROOT to be built with arrow and Parquet), `treename` is then
+   /// ignored. Every slot buffers, encodes and writes its own row groups of `fParquetRowGroupSize` entries. Numerical,
+   /// boolean and string columns and RVecs of numerical types are supported; the output is read back with RParquetDS.
+   /// ~~~{.cpp}
+   /// RSnapshotOptions opts;
+   /// opts.fOutputFormat = ROOT::RDF::ESnapshotOutputFormat::kParquet;
+   /// auto parquetDF = df.Snapshot("events", "outputFile.parquet", {"x"}, opts);
+   /// ~~~
    template <typename... ColumnTypes>
    RResultPtr<RInterface<RLoopManager>>
    Snapshot(std::string_view treename, std::string_view filename, const ColumnNames_t &columnList,
@@ -603,11 +742,12 @@ public:
       treename = parsedTreePath.fTreeName;
       const auto &dirname = parsedTreePath.fDirName;
 
-      auto snapHelperArgs = std::make_shared<RDFInternal::SnapshotHelperArgs>(RDFInternal::SnapshotHelperArgs{
-         std::string(filename), std::string(dirname), std::string(treename), columnListWithoutSizeColumns, options});
-
       ::TDirectory::TContext ctxt;
-      auto newRDF = std::make_shared<ROOT::RDataFrame>(fullTreeName, filename, validCols);
+      auto newRDF = RDFInternal::MakeSnapshotOutputDataFrame(fullTreeName, filename, validCols, options);
+
+      auto snapHelperArgs = std::make_shared<RDFInternal::SnapshotHelperArgs>(
+         RDFInternal::SnapshotHelperArgs{std::string(filename), std::string(dirname), std::string(treename),
+                                         columnListWithoutSizeColumns, options, newRDF});
 
       auto resPtr = CreateAction<RDFInternal::ActionTags::Snapshot, RDFDetail::RInferredType>(
          validCols, newRDF, snapHelperArgs, validCols.size());
@@ -678,6 +818,7 @@ public:
    /// \brief Save selected columns in memory.
    /// \tparam ColumnTypes variadic list of branch/column types.
    /// \param[in] columnList columns to be cached in memory.
+   /// \param[in] options RCacheOptions struct with the memory budget of the cache.
    /// \return a `RDataFrame` that wraps the cached dataset.
    ///
    /// This action returns a new `RDataFrame` object, completely detached from
@@ -687,6 +828,13 @@ public:
    /// Use `Cache` if you know you will only need a subset of the (`Filter`ed) data that
    /// fits in memory and that will be accessed many times.
    ///
+   /// If a memory budget is set in the options, the event loop that fills the cache runs right away, and the memory
+   /// used by the cached values is counted while they are added (for RVecs, std::vectors and std::strings this
+   /// includes their elements). As long as it stays within the budget, the cache is held in memory. Once the budget is
+   /// exceeded, the values cached so far and all the following ones are written to temporary ROOT files instead (one
+   /// per processing slot), and the returned dataframe reads them back from there. The temporary files are deleted
+   /// when the returned dataframe is destroyed.
+   ///
    /// \note Cache will refuse to process columns with names of the form `#columnname`. These are special columns
    /// made available by some data sources (e.g. RNTupleDS) that represent the size of column `columnname`, and are
    /// not meant to be written out with that name (which is not a valid C++ variable name). Instead, go through an
@@ -708,20 +856,28 @@ public:
    /// ~~~{.cpp}
    /// auto cache_all_cols_df = df.Cache(myRegexp);
    /// ~~~
+   ///
+   /// **Cache that falls back to a temporary file if it would use more than 1 GB of memory:**
+   /// ~~~{.cpp}
+   /// ROOT::RDF::RCacheOptions opts;
+   /// opts.fMemoryBudget = 1ull << 30;
+   /// auto cache_df = df.Cache<double, int>({"col0", "col2"}, opts);
+   /// ~~~
    template <typename... ColumnTypes>
-   RInterface<RLoopManager> Cache(const ColumnNames_t &columnList)
+   RInterface<RLoopManager> Cache(const ColumnNames_t &columnList, const RCacheOptions &options = RCacheOptions())
    {
       auto staticSeq = std::make_index_sequence<sizeof...(ColumnTypes)>();
-      return CacheImpl<ColumnTypes...>(columnList, staticSeq);
+      return CacheImpl<ColumnTypes...>(columnList, options, staticSeq);
    }
 
    ////////////////////////////////////////////////////////////////////////////
    /// \brief Save selected columns in memory.
    /// \param[in] columnList columns to be cached in memory
+   /// \param[in] options RCacheOptions struct with the memory budget of the cache.
    /// \return a `RDataFrame` that wraps the cached dataset.
    ///
    /// See the previous overloads for more information.
-   RInterface<RLoopManager> Cache(const ColumnNames_t &columnList)
+   RInterface<RLoopManager> Cache(const ColumnNames_t &columnList, const RCacheOptions &options = RCacheOptions())
    {
       // Early return: if the list of columns is empty, just return an empty RDF
       // If we proceed, the jitted call will not compile!
@@ -736,7 +892,7 @@ public:
       RInterface<TTraits::TakeFirstParameter_t<decltype(upcastNode)>> upcastInterface(fProxiedPtr, *fLoopManager,
                                                                                       fDefines, fDataSource);
       // build a string equivalent to
-      // "(RInterface<nodetype*>*)(this)->Cache<Ts...>(*(ColumnNames_t*)(&columnList))"
+      // "(RInterface<nodetype*>*)(this)->Cache<Ts...>(*(ColumnNames_t*)(&columnList), *(RCacheOptions*)(&options))"
       RInterface<RLoopManager> resRDF(std::make_shared<ROOT::Detail::RDF::RLoopManager>(0));
       cacheCall << "*reinterpret_cast<ROOT::RDF::RInterface<ROOT::Detail::RDF::RLoopManager>*>("
                 << RDFInternal::PrettyPrintAddr(&resRDF)
@@ -754,7 +910,8 @@ public:
       if (!columnListWithoutSizeColumns.empty())
          cacheCall.seekp(-2, cacheCall.cur);                         // remove the last ",
       cacheCall << ">(*reinterpret_cast<std::vector<std::string>*>(" // vector<string> should be ColumnNames_t
-                << RDFInternal::PrettyPrintAddr(&columnListWithoutSizeColumns) << "));";
+                << RDFInternal::PrettyPrintAddr(&columnListWithoutSizeColumns)
+                << "), *reinterpret_cast<ROOT::RDF::RCacheOptions*>(" << RDFInternal::PrettyPrintAddr(&options) << "));";
 
       // book the code to jit with the RLoopManager and trigger the event loop
       fLoopManager->ToJitExec(cacheCall.str());
@@ -792,13 +949,15 @@ public:
    ////////////////////////////////////////////////////////////////////////////
    /// \brief Save selected columns in memory.
    /// \param[in] columnList columns to be cached in memory.
+   /// \param[in] options RCacheOptions struct with the memory budget of the cache.
    /// \return a `RDataFrame` that wraps the cached dataset.
    ///
    /// See the previous overloads for more information.
-   RInterface<RLoopManager> Cache(std::initializer_list<std::string> columnList)
+   RInterface<RLoopManager>
+   Cache(std::initializer_list<std::string> columnList, const RCacheOptions &options = RCacheOptions())
    {
       ColumnNames_t selectedColumns(columnList);
-      return Cache(selectedColumns);
+      return Cache(selectedColumns, options);
    }
 
    // clang-format off
@@ -810,7 +969,11 @@ public:
    /// \return the first node of the computation graph for which the event loop is limited to a certain range of entries.
    ///
    /// Note that in case of previous Ranges and Filters the selected range refers to the transformed dataset.
-   /// Ranges are only available if EnableImplicitMT has _not_ been called. Multi-thread ranges are not supported.
+   ///
+   /// If EnableImplicitMT has been called, only ranges of contiguous entries (`stride` 1) booked directly on the
+   /// RDataFrame, i.e. without previous Filters or Ranges, are supported: they select the entries by their entry
+   /// number. If all the results are booked downstream of such ranges, the event loop only processes the clusters and
+   /// files that contain the entries selected, using all threads.
    ///
    /// ### Example usage:
    /// ~~~{.cpp}
@@ -824,7 +987,10 @@ public:
       // check invariants
       if (stride == 0 || (end != 0 && end < begin))
          throw std::runtime_error("Range: stride must be strictly greater than 0 and end must be greater than begin.");
-      CheckIMTDisabled("Range");
+      if (fLoopManager->IsMultiThreaded() &&
+          (static_cast<RDFDetail::RNodeBase *>(fProxiedPtr.get()) != fLoopManager || stride != 1))
+         throw std::runtime_error("Range was called with ImplicitMT enabled, but multi-thread event loops only "
+                                  "support ranges of contiguous entries booked directly on the RDataFrame.");
 
       using Range_t = RDFDetail::RRange<Proxied>;
       auto rangePtr = std::make_shared<Range_t>(begin, end, stride, fProxiedPtr);
@@ -2533,8 +2699,7 @@ private:
       using NewColEntry_t = RDFDetail::RDefine<decltype(entryColGen), RDFDetail::CustomColExtraArgs::SlotAndEntry>;
 
       auto entryColumn = std::make_shared<NewColEntry_t>(entryColName, entryColType, std::move(entryColGen),
-                                                         ColumnNames_t{}, fLoopManager->GetNSlots(), newCols,
-                                                         fLoopManager->GetDSValuePtrs(), fDataSource);
+                                                         ColumnNames_t{}, newCols, *fLoopManager);
       newCols.AddColumn(entryColumn, entryColName);
 
       // Slot number column
@@ -2544,8 +2709,7 @@ private:
       using NewColSlot_t = RDFDetail::RDefine<decltype(slotColGen), RDFDetail::CustomColExtraArgs::Slot>;
 
       auto slotColumn = std::make_shared<NewColSlot_t>(slotColName, slotColType, std::move(slotColGen), ColumnNames_t{},
-                                                       fLoopManager->GetNSlots(), newCols,
-                                                       fLoopManager->GetDSValuePtrs(), fDataSource);
+                                                       newCols, *fLoopManager);
       newCols.AddColumn(slotColumn, slotColName);
 
       fDefines = std::move(newCols);
@@ -2634,6 +2798,60 @@ private:
       return MakeResultPtr(r, *fLoopManager, std::move(jittedAction));
    }
 
+   /// Return the names of the columns used by a jitted expression, only if systematic variations are booked.
+   ColumnNames_t FindUsedColumns(std::string_view expression) const
+   {
+      if (!fDefines.HasVariations())
+         return {};
+      return RDFInternal::FindUsedColumnNames(expression, fLoopManager->GetBranchNames(), fDefines, fDataSource,
+                                              fLoopManager->GetAliasMap());
+   }
+
+   /// Return the defines of the nodes downstream of a Filter with the given input columns.
+   RDFInternal::RBookedDefines DefinesAfterFilter(const ColumnNames_t &filterColumns) const
+   {
+      RDFInternal::RBookedDefines newDefines(fDefines);
+      newDefines.AddFilterVariations(fDefines.GetVariationNames(filterColumns));
+      return newDefines;
+   }
+
+   /// Check the arguments of Vary, return the validated name of the varied column and set the name of the variation.
+   std::string CheckVaryArgs(const std::string &where, std::string_view colName,
+                             const std::vector<std::string> &variationTags, std::string_view variationName,
+                             std::string &varName)
+   {
+      const auto validColName = GetValidatedColumnNames(1, {std::string(colName)})[0];
+      if (variationTags.empty())
+         throw std::runtime_error(where + ": no variation tags were passed for column \"" + validColName + "\".");
+      if (fDefines.GetVariation(validColName) != nullptr)
+         throw std::runtime_error(where + ": column \"" + validColName + "\" already has systematic variations.");
+
+      varName = variationName.empty() ? validColName : std::string(variationName);
+      for (const auto &name : fDefines.GetNames()) {
+         const auto *other = fDefines.GetVariation(name);
+         if (other != nullptr && other->fName == varName && other->fTags != variationTags)
+            throw std::runtime_error(where + ": variation \"" + varName +
+                                     "\" was already registered with different tags for column \"" +
+                                     other->fColumnName + "\".");
+      }
+      return validColName;
+   }
+
+   /// The name of the internal Define that computes the varied values of a column, hidden from the user
+   static std::string GetVariationDefineName(const std::string &colName)
+   {
+      std::string defineName = "rdfvariation_" + colName + "_";
+      std::replace(defineName.begin(), defineName.end(), '.', '_');
+      return defineName;
+   }
+
+   void CheckNotVaried(const std::string &where, std::string_view name) const
+   {
+      if (fDefines.GetVariation(name) != nullptr)
+         throw std::runtime_error(where + ": column \"" + std::string(name) +
+                                  "\" has systematic variations and cannot be redefined.");
+   }
+
    template <typename F, typename DefineType, typename RetType = typename TTraits::CallableTraits<F>::ret_type>
    std::enable_if_t<std::is_default_constructible<RetType>::value, RInterface<Proxied, DS_t>>
    DefineImpl(std::string_view name, F &&expression, const ColumnNames_t &columns, const std::string &where)
@@ -2647,6 +2865,7 @@ private:
          RDFInternal::CheckForDefinition(where, name, fDefines.GetNames(), fLoopManager->GetAliasMap(),
                                          fLoopManager->GetBranchNames(),
                                          fDataSource ? fDataSource->GetColumnNames() : ColumnNames_t{});
+         CheckNotVaried(where, name);
       }
 
       using ArgTypes_t = typename TTraits::CallableTraits<F>::arg_types;
@@ -2670,12 +2889,12 @@ private:
       }
 
       using NewCol_t = RDFDetail::RDefine<F, DefineType>;
-      auto newColumn =
-         std::make_shared<NewCol_t>(name, retTypeName, std::forward<F>(expression), validColumnNames,
-                                    fLoopManager->GetNSlots(), fDefines, fLoopManager->GetDSValuePtrs(), fDataSource);
+      auto newColumn = std::make_shared<NewCol_t>(name, retTypeName, std::forward<F>(expression), validColumnNames,
+                                                  fDefines, *fLoopManager);
 
       RDFInternal::RBookedDefines newCols(fDefines);
       newCols.AddColumn(newColumn, name);
+      newCols.AddDefineVariations(name, fDefines.GetVariationNames(validColumnNames));
 
       RInterface<Proxied> newInterface(fProxiedPtr, *fLoopManager, newCols, fDataSource);
 
@@ -2711,11 +2930,12 @@ private:
       const auto &treename = parsedTreePath.fTreeName;
       const auto &dirname = parsedTreePath.fDirName;
 
-      auto snapHelperArgs = std::make_shared<RDFInternal::SnapshotHelperArgs>(RDFInternal::SnapshotHelperArgs{
-         std::string(filename), std::string(dirname), std::string(treename), columnListWithoutSizeColumns, options});
-
       ::TDirectory::TContext ctxt;
-      auto newRDF = std::make_shared<ROOT::RDataFrame>(fullTreeName, filename, validCols);
+      auto newRDF = RDFInternal::MakeSnapshotOutputDataFrame(fullTreeName, filename, validCols, options);
+
+      auto snapHelperArgs = std::make_shared<RDFInternal::SnapshotHelperArgs>(
+         RDFInternal::SnapshotHelperArgs{std::string(filename), std::string(dirname), std::string(treename),
+                                         columnListWithoutSizeColumns, options, newRDF});
 
       auto resPtr = CreateAction<RDFInternal::ActionTags::Snapshot, ColumnTypes...>(validCols, newRDF, snapHelperArgs);
 
@@ -2727,7 +2947,8 @@ private:
    ////////////////////////////////////////////////////////////////////////////
    /// \brief Implementation of cache.
    template <typename... ColTypes, std::size_t... S>
-   RInterface<RLoopManager> CacheImpl(const ColumnNames_t &columnList, std::index_sequence<S...>)
+   RInterface<RLoopManager>
+   CacheImpl(const ColumnNames_t &columnList, const RCacheOptions &options, std::index_sequence<S...>)
    {
       const auto columnListWithoutSizeColumns = RDFInternal::FilterArraySizeColNames(columnList, "Snapshot");
 
@@ -2738,6 +2959,24 @@ private:
 
       RDFInternal::CheckTypesAndPars(sizeof...(ColTypes), columnListWithoutSizeColumns.size());
 
+      if (options.fMemoryBudget > 0) {
+         // a single event loop caches the columns, checking the memory budget as values are added
+         auto cachedColumns = std::make_tuple(std::make_shared<std::vector<ColTypes>>()...);
+         RDFInternal::CacheHelper<ColTypes...> helper(cachedColumns, std::make_shared<std::vector<std::string>>(),
+                                                     columnListWithoutSizeColumns, options.fMemoryBudget,
+                                                     options.fSpillDirectory, fLoopManager->GetNSlots());
+         const auto spillFiles = *Book<ColTypes...>(std::move(helper), columnListWithoutSizeColumns);
+         if (!spillFiles.empty())
+            return RInterface<RLoopManager>(
+               RDFInternal::MakeSpilledCacheLoopManager(spillFiles, columnListWithoutSizeColumns));
+
+         // the columns are already filled: the result pointers have no action to trigger
+         auto ds = std::make_unique<RLazyDS<ColTypes...>>(std::make_pair(
+            columnListWithoutSizeColumns[S],
+            RDFDetail::MakeResultPtr(std::get<S>(cachedColumns), *fLoopManager, /*actionPtr=*/nullptr))...);
+         return RInterface<RLoopManager>(std::make_shared<RLoopManager>(std::move(ds), columnListWithoutSizeColumns));
+      }
+
       auto colHolders = std::make_tuple(Take<ColTypes>(columnListWithoutSizeColumns[S])...);
       auto ds = std::make_unique<RLazyDS<ColTypes...>>(
          std::make_pair(columnListWithoutSizeColumns[S], std::get<S>(colHolders))...);
@@ -47,6 +47,8 @@ public:
    void SetAction(std::unique_ptr<RActionBase> a) { fConcreteAction = std::move(a); }
 
    void Run(unsigned int slot, Long64_t entry) final;
+   void RunBatch(unsigned int slot, const RBatch &batch) final;
+   bool SupportsBatchedExecution() const final;
    void Initialize() final;
    void InitSlot(TTreeReader *r, unsigned int slot) final;
    void TriggerChildrenCount() final;
@@ -62,6 +64,12 @@ public:
    std::unique_ptr<ROOT::Detail::RDF::RMergeableValueBase> GetMergeableValue() const final;
 
    std::function<void(unsigned int)> GetDataBlockCallback() final;
+
+   std::vector<std::string> GetVariationKeys() const final;
+   std::unique_ptr<RActionBase> MakeVariedAction(std::vector<void *> &&results) final;
+
+   RBookedDefines &GetDefines() final;
+   const RNodeProfile &GetProfile() const final;
 };
 
 } // ns RDF
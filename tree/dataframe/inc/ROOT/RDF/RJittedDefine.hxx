@@ -16,6 +16,7 @@
 #include "RtypesCore.h"
 
 #include <memory>
+#include <string>
 #include <type_traits>
 
 class TTreeReader;
@@ -31,10 +32,12 @@ namespace RDF {
 class RJittedDefine : public RDefineBase {
    std::unique_ptr<RDefineBase> fConcreteDefine = nullptr;
 
+   std::shared_ptr<RDefineBase>
+   MakeTagDefine(std::size_t tagIdx, const std::string &colName, const RDFInternal::RBookedDefines &defines) final;
+
 public:
-   RJittedDefine(std::string_view name, std::string_view type, unsigned int nSlots,
-                       const std::map<std::string, std::vector<void *>> &DSValuePtrs)
-      : RDefineBase(name, type, nSlots, RDFInternal::RBookedDefines(), DSValuePtrs, nullptr)
+   RJittedDefine(std::string_view name, std::string_view type, RLoopManager &lm)
+      : RDefineBase(name, type, RDFInternal::RBookedDefines(), lm)
    {
    }
 
@@ -44,7 +47,11 @@ public:
    void *GetValuePtr(unsigned int slot) final;
    const std::type_info &GetTypeId() const final;
    void Update(unsigned int slot, Long64_t entry) final;
+   void UpdateBatch(unsigned int slot, const RDFInternal::RBatch &batch, const std::vector<char> &mask) final;
+   void *GetBatchValuePtr(unsigned int slot, std::size_t idx) final;
    void FinaliseSlot(unsigned int slot) final;
+   const RDFInternal::RNodeProfile &GetProfile() const final;
+   std::shared_ptr<RDefineBase> GetVariedDefine(const RDFInternal::RVariationKey &key) final;
 };
 
 } // ns RDF
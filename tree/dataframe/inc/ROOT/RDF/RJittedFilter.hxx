@@ -47,6 +47,7 @@ public:
 
    void InitSlot(TTreeReader *r, unsigned int slot) final;
    bool CheckFilters(unsigned int slot, Long64_t entry) final;
+   const std::vector<char> &CheckFiltersBatch(unsigned int slot, const ROOT::Internal::RDF::RBatch &batch) final;
    void Report(ROOT::RDF::RCutFlowReport &) const final;
    void PartialReport(ROOT::RDF::RCutFlowReport &) const final;
    void FillReport(ROOT::RDF::RCutFlowReport &) const final;
@@ -58,6 +59,8 @@ public:
    void InitNode() final;
    void AddFilterName(std::vector<std::string> &filters) final;
    void FinaliseSlot(unsigned int slot) final;
+   const RDFInternal::RNodeProfile &GetProfile() const final;
+   std::unique_ptr<RFilterBase> MakeVariedFilter(const RDFInternal::RVariationKey &key) final;
    std::shared_ptr<RDFGraphDrawing::GraphNode> GetGraph();
 };
 
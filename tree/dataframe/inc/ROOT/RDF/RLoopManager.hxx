@@ -11,16 +11,20 @@
 #ifndef ROOT_RLOOPMANAGER
 #define ROOT_RLOOPMANAGER
 
+#include "ROOT/RDF/RBatch.hxx"
 #include "ROOT/RDF/RNodeBase.hxx"
 #include "ROOT/RDF/RDataBlockNotifier.hxx"
 
 #include <functional>
+#include <limits>
 #include <map>
 #include <memory>
 #include <string>
+#include <utility> // std::pair
 #include <vector>
 
 // forward declarations
+class TEntryList;
 class TTree;
 class TTreeReader;
 class TDirectory;
@@ -29,6 +33,7 @@ namespace ROOT {
 namespace RDF {
 class RCutFlowReport;
 class RDataSource;
+class RProfileReport;
 } // ns RDF
 
 namespace Internal {
@@ -91,6 +96,8 @@ namespace RDFInternal = ROOT::Internal::RDF;
 
 class RFilterBase;
 class RRangeBase;
+class RJittedDefine;
+class RJittedFilter;
 using ROOT::RDF::RDataSource;
 
 /// The head node of a RDF computation graph.
@@ -107,6 +114,8 @@ class RLoopManager : public RNodeBase {
    std::vector<RFilterBase *> fBookedNamedFilters; ///< Contains a subset of fBookedFilters, i.e. only the named filters
    std::vector<RRangeBase *> fBookedRanges;
 
+   /// Owning pointer to the entry list passed to RDataFrame's ctor, see SetEntryList. Null otherwise.
+   std::unique_ptr<TEntryList> fEntryList;
    /// Shared pointer to the input TTree. It does not delete the pointee if the TTree/TChain was passed directly as an
    /// argument to RDataFrame's ctor (in which case we let users retain ownership).
    std::shared_ptr<TTree> fTree{nullptr};
@@ -124,6 +133,12 @@ class RLoopManager : public RNodeBase {
    std::vector<RDFInternal::Callback_t> fDataBlockCallbacks;
    RDFInternal::RDataBlockNotifier fDataBlockNotifier;
    unsigned int fNRuns{0}; ///< Number of event loops run
+   unsigned int fBatchSize{1}; ///< Number of entries processed together by the computation graph, see SetBatchSize
+   bool fProfilingEnabled{false}; ///< Whether the nodes record the time they spend, see EnableProfiling
+   /// One batch per slot in batched execution, empty otherwise
+   std::vector<std::unique_ptr<RDFInternal::RBatch>> fBatches;
+   /// The event loop only processes the entries in [first, second), see SetEntryRange
+   std::pair<ULong64_t, ULong64_t> fEntryRange{0ull, std::numeric_limits<ULong64_t>::max()};
 
    /// Registry of per-slot value pointers for booked data-source columns
    std::map<std::string, std::vector<void *>> fDSValuePtrMap;
@@ -131,6 +146,11 @@ class RLoopManager : public RNodeBase {
    /// Cache of the tree/chain branch names. Never access directy, always use GetBranchNames().
    ColumnNames_t fValidBranchNames;
 
+   /// Jitted Filters and Defines that identical ones booked later can share, by key (see
+   /// ROOT::RDF::Experimental::EnableJitNodeSharing)
+   std::map<std::string, std::weak_ptr<RJittedFilter>> fSharedJittedFilters;
+   std::map<std::string, std::weak_ptr<RJittedDefine>> fSharedJittedDefines;
+
    void CheckIndexedFriends();
    void RunEmptySourceMT();
    void RunEmptySource();
@@ -139,24 +159,36 @@ class RLoopManager : public RNodeBase {
    void RunDataSourceMT();
    void RunDataSource();
    void RunAndCheckFilters(unsigned int slot, Long64_t entry);
+   void ProcessEntry(unsigned int slot, Long64_t entry);
+   void ProcessBatch(unsigned int slot);
+   void SetupBatches();
    void InitNodeSlots(TTreeReader *r, unsigned int slot);
    void InitNodes();
    void CleanUpNodes();
    void CleanUpTask(TTreeReader *r, unsigned int slot);
    void EvalChildrenCounts();
+   bool HasEntryNumberRanges() const;
+   std::pair<ULong64_t, ULong64_t> GetLoopEntryRange() const;
    void SetupDataBlockCallbacks(TTreeReader *r, unsigned int slot);
+   void PrepareRun(bool useBatches);
+   void FinishRun(double cpuTime, double realTime);
+   static void RunSharedTreeReader(const std::vector<RLoopManager *> &loopManagers);
+   static void RunSharedTreeProcessorMT(const std::vector<RLoopManager *> &loopManagers);
 
 public:
    RLoopManager(TTree *tree, const ColumnNames_t &defaultBranches);
    RLoopManager(ULong64_t nEmptyEntries);
    RLoopManager(std::unique_ptr<RDataSource> ds, const ColumnNames_t &defaultBranches);
    RLoopManager(const RLoopManager &) = delete;
+   ~RLoopManager();
    RLoopManager &operator=(const RLoopManager &) = delete;
 
    void JitDeclarations();
    void Jit();
    RLoopManager *GetLoopManagerUnchecked() final { return this; }
    void Run();
+   std::string GetSharedScanKey();
+   static void RunSharedScan(const std::vector<RLoopManager *> &loopManagers);
    const ColumnNames_t &GetDefaultColumnNames() const;
    TTree *GetTree() const;
    ::TDirectory *GetDirectory() const;
@@ -169,11 +201,18 @@ public:
    void Book(RRangeBase *rangePtr);
    void Deregister(RRangeBase *rangePtr);
    bool CheckFilters(unsigned int, Long64_t) final;
+   /// End of recursive chain of calls: all entries of the batch are selected
+   const std::vector<char> &CheckFiltersBatch(unsigned int, const RDFInternal::RBatch &batch) final
+   {
+      return batch.GetFullMask();
+   }
    unsigned int GetNSlots() const { return fNSlots; }
    void Report(ROOT::RDF::RCutFlowReport &rep) const final;
    /// End of recursive chain of calls, does nothing
    void PartialReport(ROOT::RDF::RCutFlowReport &) const final {}
    void SetTree(const std::shared_ptr<TTree> &tree) { fTree = tree; }
+   void SetEntryList(std::unique_ptr<TEntryList> entryList);
+   TEntryList *GetEntryList() const;
    void IncrChildrenCount() final { ++fNChildren; }
    void StopProcessing() final { ++fNStopsReceived; }
    void ToJitExec(const std::string &) const;
@@ -181,6 +220,27 @@ public:
    const std::map<std::string, std::string> &GetAliasMap() const { return fAliasColumnNameMap; }
    void RegisterCallback(ULong64_t everyNEvents, std::function<void(unsigned int)> &&f);
    unsigned int GetNRuns() const { return fNRuns; }
+   void SetBatchSize(unsigned int batchSize) { fBatchSize = batchSize > 0 ? batchSize : 1; }
+   unsigned int GetBatchSize() const { return fBatchSize; }
+   /// Make the Defines, Filters and actions of the computation graph record the time they spend, the entries they
+   /// process and the values they read from the dataset during the following event loops, see GetProfileReport.
+   void EnableProfiling(bool enable) { fProfilingEnabled = enable; }
+   bool IsProfilingEnabled() const { return fProfilingEnabled; }
+   ROOT::RDF::RProfileReport GetProfileReport();
+   /// Return the batch of the given slot in batched execution, nullptr otherwise
+   RDFInternal::RBatch *GetBatch(unsigned int slot) const { return fBatches.empty() ? nullptr : fBatches[slot].get(); }
+   void SetEntryRange(ULong64_t begin, ULong64_t end);
+   const std::pair<ULong64_t, ULong64_t> &GetEntryRange() const { return fEntryRange; }
+   bool HasEntryRange() const
+   {
+      return fEntryRange.first != 0ull || fEntryRange.second != std::numeric_limits<ULong64_t>::max();
+   }
+   /// Whether the event loop runs in parallel, i.e. implicit multi-threading was enabled when the RDataFrame was built
+   bool IsMultiThreaded() const
+   {
+      return fLoopType == ELoopType::kROOTFilesMT || fLoopType == ELoopType::kNoFilesMT ||
+             fLoopType == ELoopType::kDataSourceMT;
+   }
    bool HasDSValuePtrs(const std::string &col) const;
    const std::map<std::string, std::vector<void *>> &GetDSValuePtrs() const { return fDSValuePtrMap; }
    void AddDSValuePtrs(const std::string &col, const std::vector<void *> ptrs);
@@ -203,6 +263,27 @@ public:
    const ColumnNames_t &GetBranchNames();
 
    void AddDataBlockCallback(std::function<void(unsigned int)> &&callback);
+
+   /// Return the jitted Filter shared under the given key, nullptr if there is none (anymore)
+   std::shared_ptr<RJittedFilter> GetSharedJittedFilter(const std::string &key) const
+   {
+      auto it = fSharedJittedFilters.find(key);
+      return it != fSharedJittedFilters.end() ? it->second.lock() : nullptr;
+   }
+   void AddSharedJittedFilter(const std::string &key, const std::shared_ptr<RJittedFilter> &filter)
+   {
+      fSharedJittedFilters[key] = filter;
+   }
+   /// Return the jitted Define shared under the given key, nullptr if there is none (anymore)
+   std::shared_ptr<RJittedDefine> GetSharedJittedDefine(const std::string &key) const
+   {
+      auto it = fSharedJittedDefines.find(key);
+      return it != fSharedJittedDefines.end() ? it->second.lock() : nullptr;
+   }
+   void AddSharedJittedDefine(const std::string &key, const std::shared_ptr<RJittedDefine> &define)
+   {
+      fSharedJittedDefines[key] = define;
+   }
 };
 
 } // ns RDF
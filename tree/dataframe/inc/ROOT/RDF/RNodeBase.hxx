@@ -24,6 +24,8 @@ class RCutFlowReport;
 
 namespace Internal {
 namespace RDF {
+class RBatch;
+struct RVariationKey;
 namespace GraphDrawing {
 class GraphNode;
 }
@@ -48,6 +50,9 @@ public:
    RNodeBase(RLoopManager *lm = nullptr) : fLoopManager(lm) {}
    virtual ~RNodeBase() {}
    virtual bool CheckFilters(unsigned int, Long64_t) = 0;
+   /// Return the selection mask for the entries of the batch (batched execution only, see RDFInternal::RBatch).
+   /// The nth element of the mask signals whether the nth entry of the batch passes all filters up to this node.
+   virtual const std::vector<char> &CheckFiltersBatch(unsigned int, const ROOT::Internal::RDF::RBatch &) = 0;
    virtual void Report(ROOT::RDF::RCutFlowReport &) const = 0;
    virtual void PartialReport(ROOT::RDF::RCutFlowReport &) const = 0;
    virtual void IncrChildrenCount() = 0;
@@ -63,6 +68,11 @@ public:
    }
 
    virtual RLoopManager *GetLoopManagerUnchecked() { return fLoopManager; }
+
+   /// Return the copy of this node that selects the entries for the given varied value of a systematic variation,
+   /// or nullptr if neither this node nor the nodes upstream depend on the variation.
+   /// The copy has the same type as this node. It is created and booked with the RLoopManager on first use.
+   virtual std::shared_ptr<RNodeBase> GetVariedFilter(const ROOT::Internal::RDF::RVariationKey &) { return nullptr; }
 };
 } // ns RDF
 } // ns Detail
@@ -0,0 +1,161 @@
+/*************************************************************************
+ * Copyright (C) 1995-2021, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#ifndef ROOT_RDF_RNODEPROFILE
+#define ROOT_RDF_RNODEPROFILE
+
+#include "ROOT/RDF/RColumnReaderBase.hxx"
+#include "ROOT/RDF/RProfileReport.hxx"
+#include "ROOT/RDF/Utils.hxx" // CacheLineStep
+#include <ROOT/RVec.hxx>
+#include "RtypesCore.h"
+
+#include <chrono>
+#include <cstddef> // std::size_t
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace ROOT {
+namespace Internal {
+namespace RDF {
+
+/// Number of values read and their estimated size in bytes, for one input column of a node and one processing slot
+struct RColumnReadCounters {
+   ULong64_t fNValues = 0ull;
+   ULong64_t fNBytes = 0ull;
+};
+
+/// The time spent and the entries processed by a node of the computation graph, per processing slot.
+/// The counters are only filled when profiling is enabled, see RLoopManager::EnableProfiling, and accumulate over
+/// all event loops run while profiling is enabled.
+class RNodeProfile {
+   const unsigned int fNSlots;
+   const std::string fKind;
+   std::string fName;
+   std::vector<std::string> fColumnNames;
+   std::vector<ULong64_t> fNanoseconds; ///< Per slot, strided by CacheLineStep to avoid false sharing
+   std::vector<ULong64_t> fEntries;     ///< Per slot, strided by CacheLineStep to avoid false sharing
+   /// Per slot and per input column
+   std::vector<std::vector<RColumnReadCounters>> fColumnCounters;
+
+public:
+   RNodeProfile(unsigned int nSlots, const std::string &kind, const std::string &name)
+      : fNSlots(nSlots), fKind(kind), fName(name), fNanoseconds(nSlots * CacheLineStep<ULong64_t>(), 0ull),
+        fEntries(nSlots * CacheLineStep<ULong64_t>(), 0ull), fColumnCounters(nSlots)
+   {
+   }
+
+   void SetName(const std::string &name) { fName = name; }
+   void SetColumnNames(const std::vector<std::string> &columnNames);
+
+   void Add(unsigned int slot, ULong64_t nanoseconds, ULong64_t nEntries)
+   {
+      fNanoseconds[slot * CacheLineStep<ULong64_t>()] += nanoseconds;
+      fEntries[slot * CacheLineStep<ULong64_t>()] += nEntries;
+   }
+
+   RColumnReadCounters &GetColumnCounters(unsigned int slot, std::size_t colIdx)
+   {
+      return fColumnCounters[slot][colIdx];
+   }
+
+   ULong64_t GetEntries() const;
+   ROOT::RDF::RNodeProfileInfo GetInfo() const;
+   /// A short summary of the profile, used to annotate the nodes of the graph drawn by SaveGraph.
+   /// Empty if the node did not process any entry with profiling enabled.
+   std::string GetSummary() const;
+};
+
+/// Add the time elapsed between construction and destruction to the given profile, if not null
+class RProfileTimer {
+   using Clock_t = std::chrono::steady_clock;
+
+   RNodeProfile *fProfile;
+   const unsigned int fSlot;
+   ULong64_t fNEntries;
+   Clock_t::time_point fStart;
+
+public:
+   RProfileTimer(RNodeProfile *profile, unsigned int slot, ULong64_t nEntries = 1ull)
+      : fProfile(profile), fSlot(slot), fNEntries(nEntries)
+   {
+      if (fProfile != nullptr)
+         fStart = Clock_t::now();
+   }
+   /// Set the number of entries processed in the timed scope
+   void SetNEntries(ULong64_t nEntries) { fNEntries = nEntries; }
+   RProfileTimer(const RProfileTimer &) = delete;
+   RProfileTimer &operator=(const RProfileTimer &) = delete;
+   ~RProfileTimer()
+   {
+      if (fProfile != nullptr) {
+         const auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(Clock_t::now() - fStart).count();
+         fProfile->Add(fSlot, ns, fNEntries);
+      }
+   }
+};
+
+/// Estimated size in memory of a column value: sizeof(T)...
+template <typename T>
+std::size_t GetValueSize(const T &)
+{
+   return sizeof(T);
+}
+
+/// ...plus the size of the elements for collections
+template <typename T>
+std::size_t GetValueSize(const ROOT::VecOps::RVec<T> &v)
+{
+   return sizeof(v) + v.size() * sizeof(T);
+}
+
+template <typename T>
+std::size_t GetValueSize(const std::vector<T> &v)
+{
+   return sizeof(v) + v.size() * sizeof(T);
+}
+
+/// Column reader that counts the values read through another column reader, for profiling
+template <typename T>
+class R__CLING_PTRCHECK(off) RProfiledColumnReader final : public ROOT::Detail::RDF::RColumnReaderBase {
+   std::unique_ptr<ROOT::Detail::RDF::RColumnReaderBase> fReader;
+   RColumnReadCounters &fCounters;
+
+   void *GetImpl(Long64_t entry) final
+   {
+      auto &value = fReader->Get<T>(entry);
+      ++fCounters.fNValues;
+      fCounters.fNBytes += GetValueSize(value);
+      return &value;
+   }
+
+public:
+   RProfiledColumnReader(std::unique_ptr<ROOT::Detail::RDF::RColumnReaderBase> reader, RColumnReadCounters &counters)
+      : fReader(std::move(reader)), fCounters(counters)
+   {
+   }
+};
+
+/// Wrap the reader of an input column of a node in a RProfiledColumnReader if profile is not null
+template <typename T>
+std::unique_ptr<ROOT::Detail::RDF::RColumnReaderBase>
+MakeProfiledColumnReader(std::unique_ptr<ROOT::Detail::RDF::RColumnReaderBase> reader, RNodeProfile *profile,
+                         unsigned int slot, std::size_t colIdx)
+{
+   if (profile == nullptr || reader == nullptr)
+      return reader;
+   return std::unique_ptr<ROOT::Detail::RDF::RColumnReaderBase>(
+      new RProfiledColumnReader<T>(std::move(reader), profile->GetColumnCounters(slot, colIdx)));
+}
+
+} // namespace RDF
+} // namespace Internal
+} // namespace ROOT
+
+#endif
@@ -0,0 +1,112 @@
+/*************************************************************************
+ * Copyright (C) 1995-2021, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#ifndef ROOT_RPROFILEREPORT
+#define ROOT_RPROFILEREPORT
+
+#include "RtypesCore.h"
+
+#include <string>
+#include <vector>
+
+namespace ROOT {
+
+namespace Internal {
+namespace RDF {
+class RNodeProfile;
+} // End NS RDF
+} // End NS Internal
+
+namespace Detail {
+namespace RDF {
+class RLoopManager;
+} // End NS RDF
+} // End NS Detail
+
+namespace RDF {
+
+/// Number of values read from the dataset by a node for one of its input columns, see RNodeProfileInfo
+class RColumnProfileInfo {
+   friend class ROOT::Internal::RDF::RNodeProfile;
+
+private:
+   const std::string fName;
+   const ULong64_t fNValues;
+   const ULong64_t fNBytes;
+   RColumnProfileInfo(const std::string &name, ULong64_t nValues, ULong64_t nBytes)
+      : fName(name), fNValues(nValues), fNBytes(nBytes)
+   {
+   }
+
+public:
+   const std::string &GetName() const { return fName; }
+   /// Number of values of the column read by the node
+   ULong64_t GetNValues() const { return fNValues; }
+   /// Estimated size in memory of the values read: the size of the type, plus the size of the elements for RVec and
+   /// std::vector columns
+   ULong64_t GetNBytes() const { return fNBytes; }
+};
+
+/// Time spent and entries processed by a Define, Filter or action of the computation graph, see RProfileReport
+class RNodeProfileInfo {
+   friend class ROOT::Internal::RDF::RNodeProfile;
+
+private:
+   const std::string fKind;
+   const std::string fName;
+   const std::vector<double> fSlotTimes;
+   const std::vector<ULong64_t> fSlotEntries;
+   const std::vector<RColumnProfileInfo> fColumns;
+   RNodeProfileInfo(const std::string &kind, const std::string &name, std::vector<double> &&slotTimes,
+                    std::vector<ULong64_t> &&slotEntries, std::vector<RColumnProfileInfo> &&columns)
+      : fKind(kind), fName(name), fSlotTimes(std::move(slotTimes)), fSlotEntries(std::move(slotEntries)),
+        fColumns(std::move(columns))
+   {
+   }
+
+public:
+   /// "Define", "Filter" or "Action"
+   const std::string &GetKind() const { return fKind; }
+   /// The name of the defined column, the name of the filter or the name of the action (e.g. "Histo1D")
+   const std::string &GetName() const { return fName; }
+   /// Total time spent in the node, in seconds, summed over all processing slots
+   double GetTime() const;
+   /// Time spent in the node by each processing slot, in seconds
+   const std::vector<double> &GetSlotTimes() const { return fSlotTimes; }
+   /// Number of entries processed by the node, i.e. the number of times the expression of the Define or of the
+   /// Filter was evaluated or the number of entries the action ran on
+   ULong64_t GetEntries() const;
+   /// Number of entries processed by each processing slot
+   const std::vector<ULong64_t> &GetSlotEntries() const { return fSlotEntries; }
+   /// Entries processed per second of time spent in the node
+   double GetThroughput() const;
+   /// The input columns the node reads from the dataset. Defined columns are not listed.
+   const std::vector<RColumnProfileInfo> &GetColumns() const { return fColumns; }
+};
+
+/// The profile of the nodes of a computation graph, see RDataFrame::EnableProfiling
+class RProfileReport {
+   friend class ROOT::Detail::RDF::RLoopManager;
+
+private:
+   std::vector<RNodeProfileInfo> fNodes;
+   void AddNode(RNodeProfileInfo &&info) { fNodes.emplace_back(std::move(info)); }
+
+public:
+   using const_iterator = typename std::vector<RNodeProfileInfo>::const_iterator;
+   /// Print the nodes, most time-consuming first
+   void Print() const;
+   const_iterator begin() const { return fNodes.begin(); }
+   const_iterator end() const { return fNodes.end(); }
+   std::size_t size() const { return fNodes.size(); }
+};
+
+} // End NS RDF
+} // End NS ROOT
+
+#endif
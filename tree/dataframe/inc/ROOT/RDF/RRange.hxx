@@ -11,11 +11,13 @@
 #ifndef ROOT_RDFRANGE
 #define ROOT_RDFRANGE
 
+#include "ROOT/RDF/RBatch.hxx"
 #include "ROOT/RDF/RLoopManager.hxx"
 #include "ROOT/RDF/RRangeBase.hxx"
 #include "RtypesCore.h"
 
 #include <memory>
+#include <vector>
 
 namespace ROOT {
 
@@ -37,10 +39,19 @@ class RRange final : public RRangeBase {
    const std::shared_ptr<PrevData> fPrevDataPtr;
    PrevData &fPrevData;
 
+   bool InRange(Long64_t entry) const { return entry >= fStart && (fStop == 0 || entry < fStop); }
+
 public:
    RRange(unsigned int start, unsigned int stop, unsigned int stride, std::shared_ptr<PrevData> pd)
       : RRangeBase(pd->GetLoopManagerUnchecked(), start, stop, stride, pd->GetLoopManagerUnchecked()->GetNSlots()),
-        fPrevDataPtr(std::move(pd)), fPrevData(*fPrevDataPtr) {}
+        fPrevDataPtr(std::move(pd)), fPrevData(*fPrevDataPtr)
+   {
+      // in multi-thread runs the entries are not seen in order, only a range booked on the head node can be honoured
+      if (static_cast<RNodeBase *>(&fPrevData) == fLoopManager && fLoopManager->IsMultiThreaded() && stride == 1) {
+         fSelectsEntryNumbers = true;
+         fSlotBatchMasks.resize(fNSlots);
+      }
+   }
 
    RRange(const RRange &) = delete;
    RRange &operator=(const RRange &) = delete;
@@ -51,6 +62,8 @@ public:
    /// Ranges act as filters when it comes to selecting entries that downstream nodes should process
    bool CheckFilters(unsigned int slot, Long64_t entry) final
    {
+      if (fSelectsEntryNumbers)
+         return InRange(entry) && fPrevData.CheckFilters(slot, entry);
       if (entry != fLastCheckedEntry) {
          if (fHasStopped)
             return false;
@@ -75,6 +88,40 @@ public:
       return fLastResult;
    }
 
+   /// Same logic as CheckFilters, applied in order to the entries of the batch that pass the upstream filters
+   const std::vector<char> &CheckFiltersBatch(unsigned int slot, const ROOT::Internal::RDF::RBatch &batch) final
+   {
+      if (fSelectsEntryNumbers) {
+         auto &mask = fSlotBatchMasks[slot];
+         mask = fPrevData.CheckFiltersBatch(slot, batch);
+         const auto &entries = batch.GetEntries();
+         for (std::size_t i = 0u; i < entries.size(); ++i)
+            mask[i] = mask[i] && InRange(entries[i]);
+         return mask;
+      }
+      if (batch.GetId() != fLastCheckedBatch) {
+         fBatchMask = fPrevData.CheckFiltersBatch(slot, batch);
+         const auto size = batch.GetSize();
+         for (std::size_t i = 0u; i < size; ++i) {
+            if (!fBatchMask[i])
+               continue;
+            if (fHasStopped) {
+               fBatchMask[i] = false;
+               continue;
+            }
+            ++fNProcessedEntries;
+            fBatchMask[i] = !(fNProcessedEntries <= fStart || (fStop > 0 && fNProcessedEntries > fStop) ||
+                              (fStride != 1 && fNProcessedEntries % fStride != 0));
+            if (fNProcessedEntries == fStop) {
+               fHasStopped = true;
+               fPrevData.StopProcessing();
+            }
+         }
+         fLastCheckedBatch = batch.GetId();
+      }
+      return fBatchMask;
+   }
+
    // recursive chain of `Report`s
    // RRange simply forwards these calls to the previous node
    void Report(ROOT::RDF::RCutFlowReport &rep) const final { fPrevData.PartialReport(rep); }
@@ -96,6 +143,15 @@ public:
          fPrevData.IncrChildrenCount();
    }
 
+   std::unique_ptr<RRangeBase> MakeVariedRange(const ROOT::Internal::RDF::RVariationKey &key) final
+   {
+      // a range does not read columns: it is varied only if the nodes upstream are
+      auto prev = std::static_pointer_cast<PrevData>(fPrevData.GetVariedFilter(key));
+      if (prev == nullptr)
+         return nullptr;
+      return std::unique_ptr<RRangeBase>(new RRange(fStart, fStop, fStride, std::move(prev)));
+   }
+
    /// This function must be defined by all nodes, but only the filters will add their name
    void AddFilterName(std::vector<std::string> &filters) { fPrevData.AddFilterName(filters); }
    std::shared_ptr<RDFGraphDrawing::GraphNode> GetGraph()
@@ -14,6 +14,12 @@
 #include "ROOT/RDF/RNodeBase.hxx"
 #include "RtypesCore.h"
 
+#include <map>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
 namespace ROOT {
 
 // fwd decl
@@ -38,7 +44,15 @@ protected:
    bool fLastResult{true};
    ULong64_t fNProcessedEntries{0};
    bool fHasStopped{false};    ///< True if the end of the range has been reached
+   std::vector<char> fBatchMask;   ///< Selection mask of the current batch (batched execution only)
+   Long64_t fLastCheckedBatch{-1}; ///< Id of the batch fBatchMask refers to (batched execution only)
    const unsigned int fNSlots; ///< Number of thread slots used by this node, inherited from parent node.
+   /// True if the range selects the entries by their entry number, see SelectsEntryNumbers
+   bool fSelectsEntryNumbers{false};
+   /// The selection masks of the current batch of each slot, used instead of fBatchMask if fSelectsEntryNumbers
+   std::vector<std::vector<char>> fSlotBatchMasks;
+   /// Varied copies of this range by variation key, nullptr for the variations that do not affect it
+   std::map<std::string, std::shared_ptr<RNodeBase>> fVariedFilters;
 
    void ResetCounters();
 
@@ -50,7 +64,18 @@ public:
    virtual ~RRangeBase();
 
    void InitNode() { ResetCounters(); }
+   /// Whether the range selects the entries with entry number in [start, stop) instead of counting the entries it
+   /// sees, which is the case of the ranges of contiguous entries booked directly on the RLoopManager of a
+   /// multi-thread event loop. Such a range holds no state shared by the processing slots.
+   bool SelectsEntryNumbers() const { return fSelectsEntryNumbers; }
+   /// The entries selected, [first, second), if SelectsEntryNumbers
+   std::pair<ULong64_t, ULong64_t> GetSelectedEntries() const;
+   bool HasChildren() const { return fNChildren > 0; }
    virtual std::shared_ptr<RDFGraphDrawing::GraphNode> GetGraph() = 0;
+   /// Return a new, not booked, copy of this range for the given varied value of a systematic variation, or nullptr
+   /// if the nodes upstream do not depend on the variation.
+   virtual std::unique_ptr<RRangeBase> MakeVariedRange(const ROOT::Internal::RDF::RVariationKey &key) = 0;
+   std::shared_ptr<RNodeBase> GetVariedFilter(const ROOT::Internal::RDF::RVariationKey &key) final;
 };
 
 } // ns RDF
@@ -11,9 +11,9 @@
 #ifndef ROOT_RSLOTSTACK
 #define ROOT_RSLOTSTACK
 
-#include <ROOT/TSpinMutex.hxx>
-
-#include <stack>
+#include <atomic>
+#include <cstdint>
+#include <memory>
 
 namespace ROOT {
 namespace Internal {
@@ -23,11 +23,23 @@ namespace RDF {
 /// indexed by thread ids.
 /// WARNING: this class does not work as a regular stack. The size is
 /// fixed at construction time and no blocking is foreseen.
+///
+/// The free slots are the bits set in an array of atomic words, which are claimed and given back without locks.
+/// Each thread remembers the last slot it gave back and tries to claim it again first: threads tend to get the same
+/// slot over and over, which keeps the per-slot state of the computation graph in the caches of the core they run on.
 class RSlotStack {
 private:
+   using Word_t = std::uint64_t;
+   static constexpr unsigned int kBitsPerWord = 64u;
+
    const unsigned int fSize;
-   std::stack<unsigned int> fStack;
-   ROOT::TSpinMutex fMutex;
+   const unsigned int fNWords;
+   /// Identifies this stack in the slot cached by each thread, which could otherwise be mistaken for a slot of
+   /// another stack allocated at the same address
+   const std::uint64_t fId;
+   std::unique_ptr<std::atomic<Word_t>[]> fFreeSlots; ///< Bit i of word w is set if slot w * 64 + i is free
+
+   bool TryClaim(unsigned int slot);
 
 public:
    RSlotStack() = delete;
@@ -20,21 +20,89 @@
 
 #include <memory>
 #include <string>
+#include <type_traits>
+#include <typeinfo>
+
+class TBranch;
+class TBufferFile;
+class TTree;
 
 namespace ROOT {
 namespace Internal {
 namespace RDF {
 
+/// Reads a branch of a fixed-size basic type (scalar or fixed-size array) one basket at a time, through
+/// TBulkBranchRead (see TBranch::GetBulkEntries()), and hands out the address of the values of the current entry.
+/// When the branch of the current tree does not qualify for bulk reading (e.g. a friend branch, a variable-size array,
+/// a type mismatch or a basket with entry offsets), Get() returns nullptr and the caller falls back to its
+/// TTreeReaderValue or TTreeReaderArray.
+class RTreeBulkReader {
+   TTreeReader &fReader;
+   std::string fBranchName;
+   /// The EDataType of the requested C++ type
+   int fDataType;
+   /// Whether a fixed-size array with more than one element is acceptable
+   bool fIsArray;
+   std::size_t fValueSize;
+   /// The tree for which fBranch was looked up; changes when a TChain switches to the next file
+   TTree *fLocalTree = nullptr;
+   /// nullptr if the branch of fLocalTree cannot be read in bulk
+   TBranch *fBranch = nullptr;
+   /// Number of values per entry
+   Int_t fLen = 1;
+   /// The entry range of the basket currently held in fBuffer
+   Long64_t fFirstEntry = -1;
+   Long64_t fNEntries = 0;
+   std::unique_ptr<TBufferFile> fBuffer;
+
+   void Connect(TTree *localTree);
+   bool LoadBasket(Long64_t entry);
+
+public:
+   RTreeBulkReader(TTreeReader &r, const std::string &colName, const std::type_info &ti, std::size_t valueSize,
+                   bool isArray);
+   ~RTreeBulkReader();
+   /// Returns the address of the (first) value of the current entry of the reader or nullptr if bulk reading is not
+   /// possible for the current tree.
+   void *Get();
+   /// The number of values per entry, valid after a successful call to Get()
+   Int_t GetArrayLength() const { return fLen; }
+};
+
+template <typename T, typename std::enable_if<std::is_arithmetic<T>::value, int>::type = 0>
+std::unique_ptr<RTreeBulkReader> MakeTreeBulkReader(TTreeReader &r, const std::string &colName, bool isArray)
+{
+   return std::make_unique<RTreeBulkReader>(r, colName, typeid(T), sizeof(T), isArray);
+}
+
+template <typename T, typename std::enable_if<!std::is_arithmetic<T>::value, int>::type = 0>
+std::unique_ptr<RTreeBulkReader> MakeTreeBulkReader(TTreeReader &, const std::string &, bool)
+{
+   return nullptr;
+}
+
 /// RTreeColumnReader specialization for TTree values read via TTreeReaderValues
+///
+/// Branches of basic types are read a basket at a time if possible, see RTreeBulkReader.
 template <typename T>
 class R__CLING_PTRCHECK(off) RTreeColumnReader final : public ROOT::Detail::RDF::RColumnReaderBase {
    std::unique_ptr<TTreeReaderValue<T>> fTreeValue;
+   std::unique_ptr<RTreeBulkReader> fBulkReader;
+
+   void *GetImpl(Long64_t) final
+   {
+      if (fBulkReader) {
+         if (auto addr = fBulkReader->Get())
+            return addr;
+      }
+      return fTreeValue->Get();
+   }
 
-   void *GetImpl(Long64_t) final { return fTreeValue->Get(); }
 public:
    /// Construct the RTreeColumnReader. Actual initialization is performed lazily by the Init method.
    RTreeColumnReader(TTreeReader &r, const std::string &colName)
-      : fTreeValue(std::make_unique<TTreeReaderValue<T>>(r, colName.c_str()))
+      : fTreeValue(std::make_unique<TTreeReaderValue<T>>(r, colName.c_str())),
+        fBulkReader(MakeTreeBulkReader<T>(r, colName, /*isArray=*/false))
    {
    }
 
@@ -51,10 +119,12 @@ public:
 
 /// RTreeColumnReader specialization for TTree values read via TTreeReaderArrays.
 ///
-/// TTreeReaderArrays are used whenever the RDF column type is RVec<T>.
+/// TTreeReaderArrays are used whenever the RDF column type is RVec<T>. Fixed-size arrays of basic types are read
+/// a basket at a time if possible, see RTreeBulkReader.
 template <typename T>
 class R__CLING_PTRCHECK(off) RTreeColumnReader<RVec<T>> final : public ROOT::Detail::RDF::RColumnReaderBase {
    std::unique_ptr<TTreeReaderArray<T>> fTreeArray;
+   std::unique_ptr<RTreeBulkReader> fBulkReader;
 
    /// Enumerator for the memory layout of the branch
    enum class EStorageType : char { kContiguous, kUnknown, kSparse };
@@ -71,25 +141,24 @@ class R__CLING_PTRCHECK(off) RTreeColumnReader<RVec<T>> final : public ROOT::Det
 
    void *GetImpl(Long64_t) final
    {
+      if (fBulkReader) {
+         if (auto addr = fBulkReader->Get()) {
+            RVec<T> rvec(static_cast<T *>(addr), fBulkReader->GetArrayLength());
+            std::swap(fRVec, rvec);
+            return &fRVec;
+         }
+      }
+
       auto &readerArray = *fTreeArray;
       // We only use TTreeReaderArrays to read columns that users flagged as type `RVec`, so we need to check
       // that the branch stores the array as contiguous memory that we can actually wrap in an `RVec`.
-      // Currently we need the first entry to have been loaded to perform the check
-      // TODO Move check to constructor once ROOT-10823 is fixed and TTreeReaderArray itself exposes this information
+      // The reader knows it from the layout of the branch, e.g. from the collection proxy of a split std::vector,
+      // once the first entry has been loaded.
       const auto readerArraySize = readerArray.GetSize();
-      if (EStorageType::kUnknown == fStorageType && readerArraySize > 1) {
-         // We can decide since the array is long enough
-         fStorageType = EStorageType::kContiguous;
-         for (auto i = 0u; i < readerArraySize - 1; ++i) {
-            if ((char *)&readerArray[i + 1] - (char *)&readerArray[i] != sizeof(T)) {
-               fStorageType = EStorageType::kSparse;
-               break;
-            }
-         }
-      }
+      if (EStorageType::kUnknown == fStorageType)
+         fStorageType = readerArray.IsContiguous() ? EStorageType::kContiguous : EStorageType::kSparse;
 
-      if (EStorageType::kContiguous == fStorageType ||
-          (EStorageType::kUnknown == fStorageType && readerArray.GetSize() < 2)) {
+      if (EStorageType::kContiguous == fStorageType) {
          if (readerArraySize > 0) {
             // trigger loading of the contents of the TTreeReaderArray
             // the address of the first element in the reader array is not necessarily equal to
@@ -102,7 +171,7 @@ class R__CLING_PTRCHECK(off) RTreeColumnReader<RVec<T>> final : public ROOT::Det
             std::swap(fRVec, emptyVec);
          }
       } else {
-         // The storage is not contiguous or we don't know yet: we cannot but copy into the rvec
+         // The storage is not contiguous: we cannot but copy into the rvec
 #ifndef NDEBUG
          if (!fCopyWarningPrinted) {
             Warning("RTreeColumnReader::Get",
@@ -127,7 +196,8 @@ class R__CLING_PTRCHECK(off) RTreeColumnReader<RVec<T>> final : public ROOT::Det
 
 public:
    RTreeColumnReader(TTreeReader &r, const std::string &colName)
-      : fTreeArray(std::make_unique<TTreeReaderArray<T>>(r, colName.c_str()))
+      : fTreeArray(std::make_unique<TTreeReaderArray<T>>(r, colName.c_str())),
+        fBulkReader(MakeTreeBulkReader<T>(r, colName, /*isArray=*/true))
    {
    }
 
@@ -0,0 +1,45 @@
+/*************************************************************************
+ * Copyright (C) 1995-2021, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#ifndef ROOT_RDF_RVARIATIONTAGGETTER
+#define ROOT_RDF_RVARIATIONTAGGETTER
+
+#include <ROOT/RVec.hxx>
+
+#include <cstddef> // std::size_t
+#include <stdexcept>
+#include <string>
+
+namespace ROOT {
+namespace Internal {
+namespace RDF {
+
+/// Expression of the Define that returns one varied value of a varied column, see RDefineBase::GetTagDefine.
+/// It returns the element of the RVec of varied values that corresponds to the variation's tag.
+template <typename T>
+class RVariationTagGetter {
+   /// The index of the variation's tag.
+   std::size_t fTagIdx;
+
+public:
+   RVariationTagGetter(std::size_t tagIdx) : fTagIdx(tagIdx) {}
+
+   T operator()(const ROOT::VecOps::RVec<T> &values) const
+   {
+      if (values.size() <= fTagIdx)
+         throw std::runtime_error("Vary: the expression returned " + std::to_string(values.size()) +
+                                  " varied values but at least " + std::to_string(fTagIdx + 1) + " were expected.");
+      return values[fTagIdx];
+   }
+};
+
+} // namespace RDF
+} // namespace Internal
+} // namespace ROOT
+
+#endif
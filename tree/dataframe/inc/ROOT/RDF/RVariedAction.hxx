@@ -0,0 +1,268 @@
+/*************************************************************************
+ * Copyright (C) 1995-2021, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#ifndef ROOT_RVARIEDACTION
+#define ROOT_RVARIEDACTION
+
+#include "ROOT/RDF/ColumnReaderUtils.hxx"
+#include "ROOT/RDF/GraphNode.hxx"
+#include "ROOT/RDF/RActionBase.hxx"
+#include "ROOT/RDF/RBatch.hxx"
+#include "ROOT/RDF/RColumnReaderBase.hxx"
+#include "ROOT/RDF/RLoopManager.hxx"
+#include "ROOT/RDF/Utils.hxx" // ColumnNames_t
+#include <ROOT/RVec.hxx>
+
+#include <array>
+#include <cstddef> // std::size_t
+#include <functional>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace ROOT {
+namespace Internal {
+namespace RDF {
+
+namespace RDFDetail = ROOT::Detail::RDF;
+namespace RDFGraphDrawing = ROOT::Internal::RDF::GraphDrawing;
+
+namespace GraphDrawing {
+std::shared_ptr<GraphNode> AddDefinesToGraph(std::shared_ptr<GraphNode> node,
+                                             const RDFInternal::RBookedDefines &defines,
+                                             const std::vector<std::string> &prevNodeDefines);
+} // namespace GraphDrawing
+
+// clang-format off
+/**
+ * \class ROOT::Internal::RDF::RVariedAction
+ * \ingroup dataframe
+ * \brief A RDataFrame node that produces the results of an action for each of its systematic variations
+ * \tparam Helper The action helper type, which implements the concrete action logic (e.g. FillHelper)
+ * \tparam PrevNode The type of the parent node in the computation graph
+ * \tparam ColumnTypes_t A TypeList with the types of the input columns
+ *
+ * There is one helper per varied value of each variation the action depends on. For each of them, the input columns
+ * are read from the defines as seen by that varied value (see RBookedDefines::GetVaried): the columns varied by the
+ * variation return the corresponding varied value and the Defines that depend on them are replaced by varied copies.
+ * Likewise the entries are selected by the varied copy of the upstream Filters that depend on the variation (see
+ * RNodeBase::GetVariedFilter). Defines and Filters that do not depend on a variation are shared with the nominal
+ * action, so they are evaluated once per entry for all variations.
+ */
+// clang-format on
+template <typename Helper, typename PrevNode, typename ColumnTypes_t = typename Helper::ColumnTypes_t>
+class R__CLING_PTRCHECK(off) RVariedAction final : public RActionBase {
+   using TypeInd_t = std::make_index_sequence<ColumnTypes_t::list_size>;
+   using Readers_t = std::array<std::unique_ptr<RColumnReaderBase>, ColumnTypes_t::list_size>;
+
+   /// The inputs of the helper of one varied value
+   struct RVariation {
+      RDFDetail::RNodeBase *fPrevNode; ///< The upstream node that selects the entries, nominal or varied
+      RBookedDefines fDefines;         ///< The defines as seen by this varied value
+      /// The nth flag signals whether the nth input column is a custom column or not.
+      std::array<bool, ColumnTypes_t::list_size> fIsDefine;
+      /// The Defines, as varied for this variation, read by the action
+      std::vector<RDefineBase *> fInputDefines;
+   };
+
+   /// One helper per varied value, in the same order as fVariations
+   std::vector<Helper> fHelpers;
+   const std::shared_ptr<PrevNode> fPrevNodePtr;
+   PrevNode &fPrevNode;
+   /// The varied copies of the upstream filters used by the variations, kept alive by this action
+   std::vector<std::shared_ptr<RDFDetail::RNodeBase>> fVariedPrevNodes;
+   std::vector<RVariation> fVariations;
+   /// Column readers per slot, per variation and per input column
+   std::vector<std::vector<Readers_t>> fValues;
+
+   template <typename... ColTypes, std::size_t... S>
+   void CallExec(unsigned int slot, std::size_t varIdx, Long64_t entry, TypeList<ColTypes...>,
+                 std::index_sequence<S...>)
+   {
+      fHelpers[varIdx].Exec(slot, fValues[slot][varIdx][S]->template Get<ColTypes>(entry)...);
+      (void)entry; // avoid "unused parameter" warnings
+   }
+
+public:
+   RVariedAction(std::vector<Helper> &&helpers, const ColumnNames_t &columns, std::shared_ptr<PrevNode> pd,
+                 const RBookedDefines &defines)
+      : RActionBase(pd->GetLoopManagerUnchecked(), columns, defines), fHelpers(std::move(helpers)),
+        fPrevNodePtr(std::move(pd)), fPrevNode(*fPrevNodePtr), fValues(GetNSlots())
+   {
+      const auto nColumns = columns.size();
+      for (const auto &key : GetDefines().GetVariationKeys(columns)) {
+         RDFDetail::RNodeBase *prevNode = &fPrevNode;
+         if (auto variedPrev = fPrevNode.GetVariedFilter(key)) {
+            prevNode = variedPrev.get();
+            fVariedPrevNodes.emplace_back(std::move(variedPrev));
+         }
+         RVariation variation{prevNode, GetDefines().GetVaried(key), {}, {}};
+         for (auto i = 0u; i < nColumns; ++i) {
+            variation.fIsDefine[i] = variation.fDefines.HasName(columns[i]);
+            if (variation.fIsDefine[i])
+               variation.fInputDefines.emplace_back(variation.fDefines.GetColumns().at(columns[i]).get());
+         }
+         fVariations.emplace_back(std::move(variation));
+      }
+      R__ASSERT(fVariations.size() == fHelpers.size());
+      fProfile.SetName("Varied " + fHelpers.front().GetActionName());
+   }
+
+   RVariedAction(const RVariedAction &) = delete;
+   RVariedAction &operator=(const RVariedAction &) = delete;
+   // must call Deregister here, see RAction
+   ~RVariedAction() { fLoopManager->Deregister(this); }
+
+   std::unique_ptr<RDFDetail::RMergeableValueBase> GetMergeableValue() const final
+   {
+      throw std::logic_error("Mergeable values are not supported for the results of systematic variations.");
+   }
+
+   void Initialize() final
+   {
+      for (auto &h : fHelpers)
+         h.Initialize();
+   }
+
+   void InitSlot(TTreeReader *r, unsigned int slot) final
+   {
+      auto &values = fValues[slot];
+      values.clear();
+      values.reserve(fVariations.size());
+      for (auto &variation : fVariations) {
+         for (auto &bookedBranch : variation.fDefines.GetColumns())
+            bookedBranch.second->InitSlot(r, slot);
+         RColumnReadersInfo info{GetColumnNames(),
+                                 variation.fDefines,
+                                 variation.fIsDefine.data(),
+                                 fLoopManager->GetDSValuePtrs(),
+                                 fLoopManager->GetDataSource(),
+                                 fLoopManager->GetBatch(slot),
+                                 fLoopManager->IsProfilingEnabled() ? &fProfile : nullptr};
+         values.emplace_back(RDFInternal::MakeColumnReaders(slot, r, ColumnTypes_t{}, info));
+      }
+      for (auto &h : fHelpers)
+         h.InitTask(r, slot);
+   }
+
+   void Run(unsigned int slot, Long64_t entry) final
+   {
+      const bool isProfiling = fLoopManager->IsProfilingEnabled();
+      for (std::size_t varIdx = 0; varIdx < fHelpers.size(); ++varIdx) {
+         auto &variation = fVariations[varIdx];
+         // check if entry passes all filters, as seen by this variation
+         if (!variation.fPrevNode->CheckFilters(slot, entry))
+            continue;
+         if (isProfiling) {
+            // evaluate the Defines first, so that their time is recorded in their own profile
+            for (auto *define : variation.fInputDefines)
+               define->Update(slot, entry);
+         }
+         RProfileTimer timer(isProfiling ? &fProfile : nullptr, slot);
+         CallExec(slot, varIdx, entry, ColumnTypes_t{}, TypeInd_t{});
+      }
+   }
+
+   void RunBatch(unsigned int slot, const RBatch &batch) final
+   {
+      const auto size = batch.GetSize();
+      for (std::size_t varIdx = 0; varIdx < fHelpers.size(); ++varIdx) {
+         auto &variation = fVariations[varIdx];
+         const auto &mask = variation.fPrevNode->CheckFiltersBatch(slot, batch);
+         for (auto *define : variation.fInputDefines)
+            define->UpdateBatch(slot, batch, mask);
+         RProfileTimer timer(fLoopManager->IsProfilingEnabled() ? &fProfile : nullptr, slot);
+         ULong64_t nEntries = 0;
+         for (std::size_t i = 0u; i < size; ++i) {
+            if (mask[i]) {
+               CallExec(slot, varIdx, i, ColumnTypes_t{}, TypeInd_t{});
+               ++nEntries;
+            }
+         }
+         timer.SetNEntries(nEntries);
+      }
+   }
+
+   bool SupportsBatchedExecution() const final { return fHelpers.front().SupportsBatchedExecution(); }
+
+   void TriggerChildrenCount() final
+   {
+      fPrevNode.IncrChildrenCount();
+      for (auto &variedPrev : fVariedPrevNodes)
+         variedPrev->IncrChildrenCount();
+   }
+
+   /// Clean-up operations to be performed at the end of a task.
+   void FinalizeSlot(unsigned int slot) final
+   {
+      for (auto &variation : fVariations) {
+         for (auto &column : variation.fDefines.GetColumns())
+            column.second->FinaliseSlot(slot);
+      }
+      fValues[slot].clear();
+      for (auto &h : fHelpers)
+         h.CallFinalizeTask(slot);
+   }
+
+   /// Clean-up and finalize the results of all variations.
+   void Finalize() final
+   {
+      for (auto &h : fHelpers)
+         h.Finalize();
+      SetHasRun();
+   }
+
+   std::shared_ptr<RDFGraphDrawing::GraphNode> GetGraph()
+   {
+      auto prevNode = fPrevNode.GetGraph();
+      auto prevColumns = prevNode->GetDefinedColumns();
+
+      auto thisNode = std::make_shared<RDFGraphDrawing::GraphNode>("Varied " + fHelpers.front().GetActionName());
+
+      auto upmostNode = AddDefinesToGraph(thisNode, GetDefines(), prevColumns);
+
+      thisNode->AddDefinedColumns(GetDefines().GetNames());
+      thisNode->SetAction(HasRun());
+      thisNode->SetProfileSummary(fProfile.GetSummary());
+      upmostNode->SetPrevNode(prevNode);
+      return thisNode;
+   }
+
+   void *PartialUpdate(unsigned int) final
+   {
+      throw std::runtime_error("Callbacks are not supported for the results of systematic variations.");
+   }
+
+   std::function<void(unsigned int)> GetDataBlockCallback() final
+   {
+      std::vector<std::function<void(unsigned int)>> callbacks;
+      for (auto &h : fHelpers) {
+         auto c = h.GetDataBlockCallback();
+         if (c)
+            callbacks.emplace_back(std::move(c));
+      }
+      if (callbacks.empty())
+         return {};
+      return [callbacks](unsigned int slot) {
+         for (auto &c : callbacks)
+            c(slot);
+      };
+   }
+
+   std::unique_ptr<RActionBase> MakeVariedAction(std::vector<void *> &&) final
+   {
+      throw std::logic_error("Cannot produce systematic variations of the results of systematic variations.");
+   }
+};
+
+} // namespace RDF
+} // namespace Internal
+} // namespace ROOT
+
+#endif // ROOT_RVARIEDACTION
@@ -123,6 +123,13 @@ struct IsVector_t : public std::false_type {};
 template <typename T, typename A>
 struct IsVector_t<std::vector<T, A>> : public std::true_type {};
 
+/// Detect whether a type is an instantiation of RVec<T>
+template <typename>
+struct IsRVec_t : public std::false_type {};
+
+template <typename T>
+struct IsRVec_t<ROOT::VecOps::RVec<T>> : public std::true_type {};
+
 const std::type_info &TypeName2TypeID(const std::string &name);
 
 std::string TypeID2TypeName(const std::type_info &id);
@@ -189,6 +196,24 @@ void Erase(const T &that, std::vector<T> &v)
    v.erase(std::remove(v.begin(), v.end(), that), v.end());
 }
 
+/// Set the optimization level of the code jitted by InterpreterDeclare and InterpreterCalc, -1 for cling's default
+void SetJitOptimizationLevel(int level);
+
+/// Return the optimization level of the code jitted by InterpreterDeclare and InterpreterCalc, -1 for cling's default
+int GetJitOptimizationLevel();
+
+/// Set the number of bins from which the histograms are filled concurrently by all slots, 0 to never do so
+void SetConcurrentFillThreshold(ULong64_t nBins);
+
+/// Return the number of bins from which the histograms are filled concurrently by all slots, 0 if never
+ULong64_t GetConcurrentFillThreshold();
+
+/// Set whether identical jitted Filters and Defines booked on the same node share a single node
+void SetJitNodeSharing(bool enable);
+
+/// Return whether identical jitted Filters and Defines booked on the same node share a single node
+bool GetJitNodeSharing();
+
 /// Declare code in the interpreter via the TInterpreter::Declare method, throw in case of errors
 void InterpreterDeclare(const std::string &code);
 
@@ -0,0 +1,257 @@
+/*************************************************************************
+ * Copyright (C) 1995-2021, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+// This header contains the functions to run a RDataFrame computation graph over several processes
+
+#ifndef ROOT_RDF_DISTRIBUTED
+#define ROOT_RDF_DISTRIBUTED
+
+#include <ROOT/RDF/RLoopManager.hxx>
+#include <ROOT/RDF/RMergeableValue.hxx>
+#include <ROOT/RResultPtr.hxx>
+#include <RtypesCore.h> // ULong64_t
+#include <TBufferFile.h>
+#include <TClass.h>
+
+#include <functional>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <utility> // std::pair
+#include <vector>
+
+namespace ROOT {
+namespace RDF {
+namespace Experimental {
+
+/**
+\class ROOT::RDF::Experimental::RDistributedBackend
+\ingroup dataframe
+\brief The interface of the backends that run the tasks of a distributed RDataFrame event loop, see RunDistributed.
+
+A task processes one of the entry ranges the dataset is split into and returns the serialized partial results of the
+computation graph over that range. Each task must be executed in a different process, which must hold the same
+computation graph as the process that calls RunDistributed: RProcessBackend runs each task in a process forked from
+it, while a backend for remote workers would run the same program on each node and call RunDistributedTask there,
+shipping back the bytes it returns.
+*/
+class RDistributedBackend {
+public:
+   /// A task processes the entry range with the given index and returns the serialized partial results
+   using Task_t = std::function<std::vector<char>(unsigned int)>;
+
+   virtual ~RDistributedBackend() = default;
+   /// The maximum number of tasks that can run at the same time: the dataset is split in as many entry ranges
+   virtual unsigned int GetNWorkers() const = 0;
+   /// Run task(i) for each i in [0, nTasks), each in a different process, and return the outputs of the tasks
+   /// in any order.
+   virtual std::vector<std::vector<char>> Run(const Task_t &task, unsigned int nTasks) = 0;
+};
+
+} // namespace Experimental
+} // namespace RDF
+
+namespace Internal {
+namespace RDF {
+
+using EntryRanges_t = std::vector<std::pair<ULong64_t, ULong64_t>>;
+
+/// Split the dataset of the RLoopManager in at most nRanges entry ranges with a similar number of entries.
+/// TTrees are split at cluster boundaries.
+EntryRanges_t GetDistributedEntryRanges(ROOT::Detail::RDF::RLoopManager &lm, unsigned int nRanges);
+
+/// Make the RLoopManager read its TTree through a new TChain, so that this process does not share open files with
+/// the process that booked the computation graph.
+void ReopenTreeInWorker(ROOT::Detail::RDF::RLoopManager &lm);
+
+/// Grants the distributed execution access to the internals of RResultPtr.
+class RDistributedHelper {
+public:
+   template <typename T>
+   static ROOT::Detail::RDF::RLoopManager *GetLoopManager(const ROOT::RDF::RResultPtr<T> &r)
+   {
+      if (r == nullptr)
+         throw std::runtime_error("RunDistributed: called on a null RResultPtr.");
+      if (r.fActionPtr->HasRun())
+         throw std::runtime_error("RunDistributed: the event loop of one of the results already ran.");
+      return r.fLoopManager;
+   }
+
+   /// Throw if the result of the action does not support RMergeableValue.
+   template <typename T>
+   static void CheckMergeable(const ROOT::RDF::RResultPtr<T> &r)
+   {
+      r.fActionPtr->GetMergeableValue();
+   }
+
+   /// Write the partial result of the action to the buffer, as a RMergeableValue.
+   template <typename T>
+   static void WriteMergeable(TBufferFile &buf, ROOT::RDF::RResultPtr<T> &r)
+   {
+      auto mergeable = ROOT::Detail::RDF::GetMergeableValue(r);
+      const auto &mergeableRef = *mergeable;
+      auto *cl = TClass::GetClass(typeid(mergeableRef));
+      if (cl == nullptr)
+         throw std::runtime_error(std::string("RunDistributed: no dictionary for ") + typeid(mergeableRef).name() +
+                                  ", the partial results of this action cannot be sent to the main process.");
+      buf.WriteObjectAny(mergeable.get(), cl);
+   }
+
+   /// Read the partial results of the action from the buffers, merge them and store the merged value in the result.
+   /// The action is then marked as run and deregistered from its RLoopManager.
+   template <typename T>
+   static void ReadAndMerge(std::vector<std::unique_ptr<TBufferFile>> &buffers, ROOT::RDF::RResultPtr<T> &r)
+   {
+      auto *cl = TClass::GetClass(typeid(ROOT::Detail::RDF::RMergeableValue<T>));
+      if (cl == nullptr)
+         throw std::runtime_error(std::string("RunDistributed: no dictionary for RMergeableValue<") +
+                                  typeid(T).name() + ">, the partial results of this action cannot be merged.");
+      std::unique_ptr<ROOT::Detail::RDF::RMergeableValue<T>> merged;
+      for (auto &buf : buffers) {
+         std::unique_ptr<ROOT::Detail::RDF::RMergeableValue<T>> partial(
+            static_cast<ROOT::Detail::RDF::RMergeableValue<T> *>(buf->ReadObjectAny(cl)));
+         if (partial == nullptr)
+            throw std::runtime_error("RunDistributed: could not read the partial results of a worker.");
+         if (merged == nullptr)
+            merged = std::move(partial);
+         else
+            ROOT::Detail::RDF::MergeValues(*merged, *partial);
+      }
+      *r.fObjPtr = merged->GetValue();
+      r.fActionPtr->SetHasRun();
+      r.fLoopManager->Deregister(r.fActionPtr.get());
+   }
+};
+
+/// Run the computation graph over the given entry range and return the serialized partial results, in order.
+template <typename... Ts>
+std::vector<char>
+RunDistributedTask(const std::pair<ULong64_t, ULong64_t> &range, ROOT::RDF::RResultPtr<Ts> &... results)
+{
+   ROOT::Detail::RDF::RLoopManager *loopManagers[] = {RDistributedHelper::GetLoopManager(results)...};
+   auto &lm = *loopManagers[0];
+   ReopenTreeInWorker(lm);
+   lm.SetEntryRange(range.first, range.second);
+   lm.Run();
+
+   TBufferFile buf(TBuffer::kWrite);
+   using expander = int[];
+   (void)expander{0, (RDistributedHelper::WriteMergeable(buf, results), 0)...};
+   return std::vector<char>(buf.Buffer(), buf.Buffer() + buf.Length());
+}
+
+} // namespace RDF
+} // namespace Internal
+
+namespace RDF {
+namespace Experimental {
+
+// clang-format off
+////////////////////////////////////////////////////////////////////////////
+/// \brief Run the task of a distributed event loop that processes the given entry range.
+/// \param[in] taskIdx The index of the task: the dataset is split in nTasks entry ranges, this task processes the
+///            range with index taskIdx.
+/// \param[in] nTasks The number of tasks the event loop is split into, as passed to RDistributedBackend::Run.
+/// \param[in] results The results of the computation graph, in the same order as passed to RunDistributed.
+/// \return The serialized partial results, to be returned by the task of RDistributedBackend::Run.
+///
+/// This is the entry point of the worker processes of backends that do not fork the main process, e.g. to run the
+/// computation graph on remote nodes: each worker builds the same computation graph as the main process and calls
+/// this function, with the same dataset and the same number of tasks.
+// clang-format on
+template <typename... Ts>
+std::vector<char> RunDistributedTask(unsigned int taskIdx, unsigned int nTasks, RResultPtr<Ts> &... results)
+{
+   ROOT::Detail::RDF::RLoopManager *loopManagers[] = {
+      ROOT::Internal::RDF::RDistributedHelper::GetLoopManager(results)...};
+   const auto ranges = ROOT::Internal::RDF::GetDistributedEntryRanges(*loopManagers[0], nTasks);
+   if (taskIdx >= ranges.size())
+      throw std::runtime_error("RunDistributedTask: task " + std::to_string(taskIdx) +
+                               " requested, but the dataset is split in " + std::to_string(ranges.size()) +
+                               " entry ranges only.");
+   return ROOT::Internal::RDF::RunDistributedTask(ranges[taskIdx], results...);
+}
+
+// clang-format off
+////////////////////////////////////////////////////////////////////////////
+/// \brief Run the event loop of the given results over several processes.
+/// \param[in] backend The backend that runs the tasks, e.g. RProcessBackend.
+/// \param[in] results The results to produce. They must belong to the same computation graph and must not have
+///            been produced yet.
+///
+/// The dataset is split in as many entry ranges as the backend has workers, at cluster boundaries for TTrees.
+/// Each worker runs the computation graph over one entry range and sends back the partial results as
+/// RMergeableValue objects, which are then merged in this process. After this call the results are available
+/// as if the event loop ran locally.
+///
+/// Only the given results are produced: other actions booked on the same computation graph are also run by the
+/// workers, but their results are discarded. The actions must support RMergeableValue, e.g. Count, Sum, Mean, Min,
+/// Max, StdDev and the histograms. Running the computation graph with implicit multi-threading is not supported, and
+/// RDataFrames with a data source or with a TEntryList cannot be distributed yet.
+///
+/// ### Example usage:
+/// ~~~{.cpp}
+/// ROOT::RDataFrame df("events", "data_*.root");
+/// auto h = df.Filter("nMuon == 2").Histo1D<float>("Muon_pt");
+/// auto n = df.Count();
+/// ROOT::RDF::Experimental::RProcessBackend backend(8);
+/// ROOT::RDF::Experimental::RunDistributed(backend, h, n);
+/// h->Draw();
+/// ~~~
+// clang-format on
+template <typename T, typename... Ts>
+void RunDistributed(RDistributedBackend &backend, RResultPtr<T> &result, RResultPtr<Ts> &... otherResults)
+{
+   ROOT::Detail::RDF::RLoopManager *loopManagers[] = {
+      ROOT::Internal::RDF::RDistributedHelper::GetLoopManager(result),
+      ROOT::Internal::RDF::RDistributedHelper::GetLoopManager(otherResults)...};
+   auto &lm = *loopManagers[0];
+   for (auto *otherLm : loopManagers) {
+      if (otherLm != &lm)
+         throw std::runtime_error("RunDistributed: all results must belong to the same computation graph.");
+   }
+   if (lm.GetNSlots() > 1)
+      throw std::runtime_error("RunDistributed: the computation graph was built with implicit multi-threading "
+                               "enabled, which is not supported by distributed execution.");
+
+   // jit the computation graph once here rather than once per worker
+   lm.Jit();
+   // fail early rather than in the workers if a result cannot be merged
+   ROOT::Internal::RDF::RDistributedHelper::CheckMergeable(result);
+   using expander = int[];
+   (void)expander{0, (ROOT::Internal::RDF::RDistributedHelper::CheckMergeable(otherResults), 0)...};
+
+   const auto ranges = ROOT::Internal::RDF::GetDistributedEntryRanges(lm, backend.GetNWorkers());
+   if (ranges.empty()) {
+      // nothing to distribute, run the (empty) event loop locally
+      lm.Run();
+      return;
+   }
+
+   auto task = [&](unsigned int rangeIdx) {
+      return ROOT::Internal::RDF::RunDistributedTask(ranges[rangeIdx], result, otherResults...);
+   };
+   const auto outputs = backend.Run(task, ranges.size());
+   if (outputs.size() != ranges.size())
+      throw std::runtime_error("RunDistributed: " + std::to_string(ranges.size()) + " tasks were run but only " +
+                               std::to_string(outputs.size()) + " returned their results.");
+
+   std::vector<std::unique_ptr<TBufferFile>> buffers;
+   buffers.reserve(outputs.size());
+   for (const auto &output : outputs)
+      buffers.emplace_back(new TBufferFile(TBuffer::kRead, output.size(), const_cast<char *>(output.data()),
+                                           /*adopt=*/false));
+   ROOT::Internal::RDF::RDistributedHelper::ReadAndMerge(buffers, result);
+   (void)expander{0, (ROOT::Internal::RDF::RDistributedHelper::ReadAndMerge(buffers, otherResults), 0)...};
+}
+
+} // namespace Experimental
+} // namespace RDF
+} // namespace ROOT
+
+#endif // ROOT_RDF_DISTRIBUTED
@@ -15,6 +15,7 @@
 
 #include <ROOT/RDataFrame.hxx>
 #include <ROOT/RResultHandle.hxx>
+#include <ROOT/RResultMap.hxx>
 #include <ROOT/RDF/GraphUtils.hxx>
 #include <ROOT/TypeTraits.hxx>
 
@@ -161,6 +162,7 @@ RNode AsRNode(NodeType node)
 // clang-format off
 /// Trigger the event loop of multiple RDataFrames concurrently
 /// \param[in] handles A vector of RResultHandles
+/// \param[in] sharedScan Whether the computation graphs reading the same dataset share one reading pass
 ///
 /// This function triggers the event loop of all computation graphs which relate to the
 /// given RResultHandles. The advantage compared to running the event loop implicitly by accessing the
@@ -178,8 +180,111 @@ RNode AsRNode(NodeType node)
 /// // RResultPtr -> RResultHandle conversion is automatic
 /// ROOT::RDF::RunGraphs({r1, r2});
 /// ~~~
+///
+/// With sharedScan, the computation graphs of RDataFrames that read the same TTree or TChain (same tree name and list
+/// of files, no friend trees nor entry list) run in a single event loop: each entry is read once, and the columns
+/// used by several graphs are read only once per entry. The graphs over different datasets, or over other kinds of
+/// sources, still run their own event loops concurrently. Batched execution (see RInterface::SetBatchSize) is not
+/// used in shared event loops.
+///
+/// ~~~{.cpp}
+/// // e.g. the jobs of several analysts over the same skim
+/// ROOT::RDataFrame dfA("events", {"skim_1.root", "skim_2.root"});
+/// auto hA = dfA.Filter("nMuon == 2").Histo1D("Muon_pt");
+///
+/// ROOT::RDataFrame dfB("events", {"skim_1.root", "skim_2.root"});
+/// auto hB = dfB.Filter("nElectron > 0").Histo1D("Muon_pt");
+///
+/// // one pass over the files, Muon_pt is read once per entry
+/// ROOT::RDF::RunGraphs({hA, hB}, /*sharedScan=*/true);
+/// ~~~
 // clang-format on
-void RunGraphs(std::vector<RResultHandle> handles);
+void RunGraphs(std::vector<RResultHandle> handles, bool sharedScan = false);
+
+namespace Experimental {
+
+// clang-format off
+/// Set the optimization level used by cling for the code that RDataFrame compiles just in time
+/// \param[in] level The optimization level, from 0 to 3, or -1 to use the default of the interpreter
+///
+/// RDataFrame hands two kinds of code to cling: the functions of the string expressions, declared when the
+/// transformations and actions that use them are booked, and the code that instantiates the nodes of all pending
+/// computation graphs, compiled in one go right before the next event loop, see [the relevant section](\ref jitting)
+/// of the RDataFrame documentation. The optimization level applies to both, for all code jitted after the call: a
+/// higher level makes the string-based transformations and actions faster, at the price of a longer compilation.
+/// The expressions of a chain of Defines and Filters stay separate functions, called by the nodes of the graph.
+///
+/// ~~~{.cpp}
+/// ROOT::RDF::Experimental::SetJitOptimizationLevel(2);
+/// ROOT::RDataFrame df("tree", "file.root");
+/// auto h = df.Define("pt", "sqrt(px * px + py * py)").Filter("pt > 10").Histo1D("pt");
+/// ~~~
+// clang-format on
+void SetJitOptimizationLevel(int level);
+
+/// Return the optimization level used by cling for the code that RDataFrame compiles just in time, -1 for the default.
+int GetJitOptimizationLevel();
+
+// clang-format off
+/// Set the number of bins from which the histograms are filled concurrently by all slots of the event loop
+/// \param[in] nBins The minimum number of bins, including under- and overflows, or 0 to never fill concurrently
+///
+/// In multi-thread event loops, the Histo2D, Histo3D, Profile1D, Profile2D and Fill actions (and Histo1D with axis
+/// limits) fill one clone of the histogram per slot, which are merged at the end of the event loop. With many slots
+/// and large histograms (e.g. TH3s or TH2Polys), these clones can take gigabytes. The histograms of the TH1 family
+/// with at least nBins bins are instead filled by all slots concurrently, through the buffers of a
+/// ROOT::Experimental::TH1ConcurrentFillManager: the memory used is that of the histogram plus a small buffer per slot.
+/// The callbacks registered with OnPartialResultSlot then receive a copy of the shared histogram, taken while no slot
+/// fills it and valid until the next callback of the same slot: a copy per callback is made, so callbacks should be
+/// registered with a large enough number of entries. The setting applies to the actions booked after the call.
+/// The default is 0.
+///
+/// ~~~{.cpp}
+/// ROOT::RDF::Experimental::SetConcurrentFillThreshold(1000000);
+/// ROOT::EnableImplicitMT();
+/// ROOT::RDataFrame df("tree", "file.root");
+/// // 8 million bins, filled concurrently rather than cloned per slot
+/// auto h = df.Histo3D({"h", "h", 200, 0., 1., 200, 0., 1., 200, 0., 1.}, "x", "y", "z");
+/// ~~~
+// clang-format on
+void SetConcurrentFillThreshold(ULong64_t nBins);
+
+/// Return the number of bins from which the histograms are filled concurrently, 0 if never. See SetConcurrentFillThreshold.
+ULong64_t GetConcurrentFillThreshold();
+
+// clang-format off
+/// Let identical string-based Filters and Defines of a computation graph share a single node
+/// \param[in] enable Whether the nodes are shared
+///
+/// Computation graphs built programmatically, e.g. in a loop over the categories of an analysis, often book the same
+/// jitted Define or Filter on the same node several times, each branch of the graph recomputing the same value for
+/// every entry. With node sharing enabled, a jitted Define with the same name and expression as one booked earlier in
+/// the same graph, on columns that refer to the same definitions, is the same node: its value is computed once per
+/// entry, whichever branches use it. The same holds for unnamed jitted Filters booked on the same node with the same
+/// expression. Named Filters stay distinct as they appear in the cut-flow reports, and so do the nodes of branches of
+/// the graph with systematic variations.
+///
+/// The expressions must not have side effects nor depend on any state other than the columns they read, e.g.
+/// distinct `Define("r", "gRandom->Uniform()")` get the same values when they are shared. The setting applies to the
+/// transformations booked after the call. It is disabled by default.
+///
+/// ~~~{.cpp}
+/// ROOT::RDF::Experimental::EnableJitNodeSharing();
+/// ROOT::RDataFrame df("tree", "file.root");
+/// std::vector<ROOT::RDF::RResultPtr<TH1D>> histos;
+/// for (auto cut : {"pt > 10", "pt > 20", "pt > 30"}) {
+///    // "pt" and the Filter on nMuon are computed once per entry for the three histograms
+///    auto d = df.Define("pt", "sqrt(px * px + py * py)").Filter("nMuon > 0");
+///    histos.emplace_back(d.Filter(cut).Histo1D("pt"));
+/// }
+/// ~~~
+// clang-format on
+void EnableJitNodeSharing(bool enable = true);
+
+/// Return whether identical string-based Filters and Defines share a single node. See EnableJitNodeSharing.
+bool IsJitNodeSharingEnabled();
+
+} // namespace Experimental
 
 } // namespace RDF
 } // namespace ROOT
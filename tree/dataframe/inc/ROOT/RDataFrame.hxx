@@ -18,6 +18,7 @@ ROOT's RDataFrame allows to analyse data stored in TTrees with a high level inte
 
 #include "TROOT.h" // To allow ROOT::EnableImplicitMT without including ROOT.h
 #include "ROOT/RDF/RInterface.hxx"
+#include "ROOT/RDF/RProfileReport.hxx"
 #include "ROOT/RDF/Utils.hxx"
 #include "ROOT/RStringView.hxx"
 #include "RtypesCore.h"
@@ -28,6 +29,7 @@ ROOT's RDataFrame allows to analyse data stored in TTrees with a high level inte
 #include <vector>
 
 class TDirectory;
+class TEntryList;
 class TTree;
 
 namespace ROOT {
@@ -43,10 +45,16 @@ public:
    RDataFrame(std::string_view treeName, std::string_view filenameglob, const ColumnNames_t &defaultBranches = {});
    RDataFrame(std::string_view treename, const std::vector<std::string> &filenames,
               const ColumnNames_t &defaultBranches = {});
+   RDataFrame(std::string_view treeName, const std::vector<std::string> &fileglobs, TEntryList *entryList,
+              const ColumnNames_t &defaultBranches = {});
    RDataFrame(std::string_view treeName, ::TDirectory *dirPtr, const ColumnNames_t &defaultBranches = {});
    RDataFrame(TTree &tree, const ColumnNames_t &defaultBranches = {});
    RDataFrame(ULong64_t numEntries);
    RDataFrame(std::unique_ptr<ROOT::RDF::RDataSource>, const ColumnNames_t &defaultBranches = {});
+
+   void SetBatchSize(unsigned int batchSize);
+   void EnableProfiling(bool enable = true);
+   ROOT::RDF::RProfileReport GetProfileReport();
 };
 
 } // ns ROOT
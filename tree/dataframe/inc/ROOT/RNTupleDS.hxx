@@ -54,6 +54,14 @@ class RNTupleDS final : public ROOT::RDF::RDataSource {
    std::vector<std::string> fColumnTypes;
    std::vector<size_t> fActiveColumns;
 
+   /// Restricts the values of a column to [fMin, fMax], see AddValueRangeHint()
+   struct RValueRangeHint {
+      DescriptorId_t fColumnId;
+      double fMin;
+      double fMax;
+   };
+   std::vector<RValueRangeHint> fValueRangeHints;
+
    unsigned fNSlots = 0;
    bool fHasSeenAllRanges = false;
 
@@ -70,6 +78,9 @@ class RNTupleDS final : public ROOT::RDF::RDataSource {
                  DescriptorId_t fieldId,
                  std::vector<DescriptorId_t> skeinIDs);
 
+   /// Builds the entry ranges from the pages whose recorded value ranges are compatible with all the hints
+   std::vector<std::pair<ULong64_t, ULong64_t>> GetHintedEntryRanges() const;
+
 public:
    explicit RNTupleDS(std::unique_ptr<ROOT::Experimental::Detail::RPageSource> pageSource);
    ~RNTupleDS();
@@ -82,6 +93,13 @@ public:
 
    bool SetEntry(unsigned int slot, ULong64_t entry) final;
 
+   /// Declares that only entries with values of the column colName within [min, max] are of interest.  Using the
+   /// value ranges stored with the clusters and pages, GetEntryRanges() then skips all clusters and pages that
+   /// certainly contain no such value.  Surviving pages still contain entries outside the range, so the hint does
+   /// not replace the corresponding Filter.  Only columns of leaf fields that are not part of a collection and that
+   /// are stored as a numerical column can be used.  Multiple hints are combined with a logical AND.
+   void AddValueRangeHint(std::string_view colName, double min, double max);
+
    void Initialise() final;
    void Finalise() final;
 
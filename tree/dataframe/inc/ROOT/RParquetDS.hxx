@@ -0,0 +1,101 @@
+/*************************************************************************
+ * Copyright (C) 1995-2021, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#ifndef ROOT_RPARQUETDS
+#define ROOT_RPARQUETDS
+
+#include "ROOT/RDataFrame.hxx"
+#include "ROOT/RDataSource.hxx"
+
+#include <limits>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace arrow {
+class Schema;
+class Table;
+}
+
+namespace parquet {
+class FileMetaData;
+namespace arrow {
+class FileReader;
+}
+} // namespace parquet
+
+namespace ROOT {
+namespace Internal {
+namespace RDF {
+class TValueGetter;
+} // namespace RDF
+} // namespace Internal
+
+namespace RDF {
+
+class RParquetDS final : public RDataSource {
+public:
+   /// A range of the values of a numerical column. The row groups whose statistics show that none of their values of
+   /// the column are in [fMin, fMax] are skipped.
+   struct RColumnRange {
+      std::string fColumnName;
+      double fMin = -std::numeric_limits<double>::infinity();
+      double fMax = std::numeric_limits<double>::infinity();
+   };
+
+private:
+   std::string fFileName;
+   std::shared_ptr<parquet::FileMetaData> fMetaData; // read once, shared by the readers of the slots
+   std::shared_ptr<arrow::Schema> fSchema;           // of the whole file
+   std::vector<std::string> fColumnNames;
+   std::vector<int> fLeafIndices; // the Parquet (leaf) columns of the selected columns
+   /// The row groups that are read, i.e. not skipped because of the column ranges, and their entry ranges
+   std::vector<int> fRowGroups;
+   std::vector<std::pair<ULong64_t, ULong64_t>> fRowGroupRanges;
+   bool fEntryRangesRequested = false;
+   unsigned int fNSlots = 0U;
+
+   /// Per slot: the reader of the file, opened at the first row group read by the slot, and the row group it read
+   std::vector<std::unique_ptr<parquet::arrow::FileReader>> fSlotReaders;
+   std::vector<std::shared_ptr<arrow::Table>> fSlotTables;
+   std::vector<int> fSlotRowGroups; // index in fRowGroups, -1 if none
+   /// fValueGetters[column][slot], each serving one slot
+   std::vector<std::vector<std::unique_ptr<ROOT::Internal::RDF::TValueGetter>>> fValueGetters;
+
+   std::vector<void *> GetColumnReadersImpl(std::string_view name, const std::type_info &type) final;
+   void ReadRowGroup(unsigned int slot, std::size_t rowGroupIdx);
+
+public:
+   RParquetDS(std::string_view fileName, const std::vector<std::string> &columns = {},
+              const std::vector<RColumnRange> &columnRanges = {});
+   ~RParquetDS();
+   const std::vector<std::string> &GetColumnNames() const final;
+   std::vector<std::pair<ULong64_t, ULong64_t>> GetEntryRanges() final;
+   std::string GetTypeName(std::string_view colName) const final;
+   bool HasColumn(std::string_view colName) const final;
+   bool SetEntry(unsigned int slot, ULong64_t entry) final;
+   void SetNSlots(unsigned int nSlots) final;
+   void Initialise() final;
+   void Finalise() final;
+   std::string GetLabel() final;
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+/// \brief Factory method to create a RDataFrame reading a Parquet file.
+/// \param[in] fileName the path of the Parquet file.
+/// \param[in] columns the columns to read, all of them if empty.
+/// \param[in] columnRanges the ranges of values used to skip row groups, see RParquetDS.
+RDataFrame MakeParquetDataFrame(std::string_view fileName, const std::vector<std::string> &columns = {},
+                                const std::vector<RParquetDS::RColumnRange> &columnRanges = {});
+
+} // namespace RDF
+
+} // namespace ROOT
+
+#endif
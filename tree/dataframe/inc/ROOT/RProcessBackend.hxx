@@ -0,0 +1,41 @@
+/*************************************************************************
+ * Copyright (C) 1995-2021, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#ifndef ROOT_RDF_RPROCESSBACKEND
+#define ROOT_RDF_RPROCESSBACKEND
+
+#include <ROOT/RDFDistributed.hxx>
+
+#include <vector>
+
+namespace ROOT {
+namespace RDF {
+namespace Experimental {
+
+/**
+\class ROOT::RDF::Experimental::RProcessBackend
+\ingroup dataframe
+\brief A RDistributedBackend that runs each task in a worker process forked through ROOT::TProcessExecutor.
+
+The worker processes inherit the computation graph from the main process, so no code needs to be shipped to them.
+*/
+class RProcessBackend final : public RDistributedBackend {
+   unsigned int fNWorkers;
+
+public:
+   /// \param[in] nWorkers The number of worker processes. The default is the number of cores of the machine.
+   explicit RProcessBackend(unsigned int nWorkers = 0u);
+   unsigned int GetNWorkers() const final { return fNWorkers; }
+   std::vector<std::vector<char>> Run(const Task_t &task, unsigned int nTasks) final;
+};
+
+} // namespace Experimental
+} // namespace RDF
+} // namespace ROOT
+
+#endif // ROOT_RDF_RPROCESSBACKEND
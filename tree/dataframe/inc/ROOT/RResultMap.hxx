@@ -0,0 +1,140 @@
+/*************************************************************************
+ * Copyright (C) 1995-2021, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#ifndef ROOT_RDF_RRESULTMAP
+#define ROOT_RDF_RRESULTMAP
+
+#include "ROOT/RDF/RActionBase.hxx"
+#include "ROOT/RDF/RLoopManager.hxx"
+#include "ROOT/RResultPtr.hxx"
+
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace ROOT {
+namespace RDF {
+namespace Experimental {
+
+/**
+\class ROOT::RDF::Experimental::RResultMap
+\ingroup dataframe
+\brief The results of an action for the nominal case and for each of its systematic variations.
+\tparam T Type of the action result
+
+The results are indexed by "nominal" for the nominal result and by "variation:tag" for the
+systematic variations, see VariationsFor(). Accessing one of the results triggers the event loop
+if it did not run yet: all results are produced in the same event loop.
+*/
+template <typename T>
+class RResultMap {
+   friend RResultMap VariationsFor<T>(RResultPtr<T> resPtr);
+
+   std::vector<std::string> fKeys; ///< The keys of the results, "nominal" first
+   std::unordered_map<std::string, std::shared_ptr<T>> fMap;
+   /// Non-owning pointer to the RLoopManager at the root of this computation graph.
+   ROOT::Detail::RDF::RLoopManager *fLoopManager;
+   /// Owning pointers to the actions that produce the nominal and the varied results.
+   std::shared_ptr<ROOT::Internal::RDF::RActionBase> fNominalAction;
+   std::shared_ptr<ROOT::Internal::RDF::RActionBase> fVariedAction;
+
+   RResultMap(std::shared_ptr<T> nominalResult, std::vector<std::string> &&variationKeys,
+              std::vector<std::shared_ptr<T>> &&variedResults, ROOT::Detail::RDF::RLoopManager &lm,
+              std::shared_ptr<ROOT::Internal::RDF::RActionBase> nominalAction,
+              std::shared_ptr<ROOT::Internal::RDF::RActionBase> variedAction)
+      : fLoopManager(&lm), fNominalAction(std::move(nominalAction)), fVariedAction(std::move(variedAction))
+   {
+      fKeys.reserve(variationKeys.size() + 1);
+      fKeys.emplace_back("nominal");
+      fMap.emplace("nominal", std::move(nominalResult));
+      for (std::size_t i = 0; i < variationKeys.size(); ++i) {
+         fKeys.emplace_back(variationKeys[i]);
+         fMap.emplace(std::move(variationKeys[i]), std::move(variedResults[i]));
+      }
+   }
+
+public:
+   /// Return the result for the given key, triggering the event loop if needed.
+   T &operator[](const std::string &key)
+   {
+      auto it = fMap.find(key);
+      if (it == fMap.end())
+         throw std::runtime_error("RResultMap: no result with key \"" + key + "\".");
+      if (!fNominalAction->HasRun() || !fVariedAction->HasRun())
+         fLoopManager->Run();
+      return *it->second;
+   }
+
+   /// Return the keys of the results: "nominal" followed by the "variation:tag" keys.
+   const std::vector<std::string> &GetKeys() const { return fKeys; }
+};
+
+// clang-format off
+////////////////////////////////////////////////////////////////////////////
+/// \brief Produce all required systematic variations for the given result.
+/// \param[in] resPtr The nominal result.
+/// \return A RResultMap holding the nominal result and the result of each systematic variation.
+///
+/// The results of the variations are produced in the same event loop as the nominal result, see RInterface::Vary.
+/// This function must be called before the event loop of the nominal result runs.
+///
+/// The result is varied for each variation that its input columns, directly or through Defines, or the Filters
+/// upstream depend on. The expressions of such Defines and Filters must be copyable. The Count, Fill (e.g. Histo1D),
+/// Min, Max, Sum, Mean and StdDev actions support variations.
+///
+/// ### Example usage:
+/// ~~~{.cpp}
+/// auto nominal_hx = df.Vary("pt", [](double pt) { return ROOT::RVec<double>{pt * 0.9, pt * 1.1}; }, {"pt"}, {"down", "up"})
+///                     .Histo1D<double>({"hx", "", 100, 0, 100}, "pt");
+/// auto hx = ROOT::RDF::Experimental::VariationsFor(nominal_hx);
+/// hx["nominal"].Draw();
+/// hx["pt:down"].Draw("SAME");
+/// hx["pt:up"].Draw("SAME");
+/// ~~~
+// clang-format on
+template <typename T>
+RResultMap<T> VariationsFor(RResultPtr<T> resPtr)
+{
+   if (resPtr == nullptr)
+      throw std::runtime_error("VariationsFor: called on a null RResultPtr.");
+   auto &nominalAction = resPtr.fActionPtr;
+   if (nominalAction->HasRun())
+      throw std::runtime_error("VariationsFor: the event loop of this result already ran. VariationsFor must be "
+                               "called before the event loop is triggered.");
+
+   auto &lm = *resPtr.fLoopManager;
+   // make sure that jitted actions are built, they are needed to know which columns are varied
+   lm.Jit();
+
+   auto variationKeys = nominalAction->GetVariationKeys();
+   std::vector<std::shared_ptr<T>> variedResults;
+   variedResults.reserve(variationKeys.size());
+   std::vector<void *> typeErasedResults;
+   typeErasedResults.reserve(variationKeys.size());
+   for (std::size_t i = 0; i < variationKeys.size(); ++i) {
+      // we copy the nominal result as the event loop did not run: it is in its initial state
+      variedResults.emplace_back(std::make_shared<T>(*resPtr.fObjPtr));
+      typeErasedResults.emplace_back(&variedResults.back());
+   }
+
+   std::shared_ptr<ROOT::Internal::RDF::RActionBase> variedAction =
+      nominalAction->MakeVariedAction(std::move(typeErasedResults));
+   lm.Book(variedAction.get());
+   lm.AddDataBlockCallback(variedAction->GetDataBlockCallback());
+
+   return RResultMap<T>(resPtr.fObjPtr, std::move(variationKeys), std::move(variedResults), lm, nominalAction,
+                        std::move(variedAction));
+}
+
+} // namespace Experimental
+} // namespace RDF
+} // namespace ROOT
+
+#endif // ROOT_RDF_RRESULTMAP
@@ -28,11 +28,20 @@ class RResultPtr;
 
 template <typename Proxied, typename DataSource>
 class RInterface;
+
+namespace Experimental {
+template <typename T>
+class RResultMap;
+
+template <typename T>
+RResultMap<T> VariationsFor(RResultPtr<T> resPtr);
+} // namespace Experimental
 } // namespace RDF
 
 namespace Internal {
 namespace RDF {
 class GraphCreatorHelper;
+class RDistributedHelper;
 
 // no-op overload
 template <typename T>
@@ -119,8 +128,13 @@ class RResultPtr {
 
    friend class ROOT::Internal::RDF::GraphDrawing::GraphCreatorHelper;
 
+   friend class ROOT::Internal::RDF::RDistributedHelper;
+
    friend class RResultHandle;
 
+   template <typename T1>
+   friend ROOT::RDF::Experimental::RResultMap<T1> ROOT::RDF::Experimental::VariationsFor(RResultPtr<T1> resPtr);
+
    /// \cond HIDDEN_SYMBOLS
    template <typename V, bool hasBeginEnd = TTraits::HasBeginAndEnd<V>::value>
    struct RIterationHelper {
@@ -13,11 +13,20 @@
 
 #include <Compression.h>
 #include <ROOT/RStringView.hxx>
+#include <cstddef> // std::size_t
 #include <string>
 
 namespace ROOT {
 
 namespace RDF {
+/// The format of the dataset written by Snapshot
+enum class ESnapshotOutputFormat {
+   kDefault, ///< Currently a TTree
+   kTTree,
+   kRNTuple, ///< An RNTuple, requires ROOT to be built with root7
+   kParquet  ///< A Parquet file, requires ROOT to be built with arrow and Parquet
+};
+
 /// A collection of options to steer the creation of the dataset on file
 struct RSnapshotOptions {
    using ECAlgo = ROOT::ECompressionAlgorithm;
@@ -37,6 +46,15 @@ struct RSnapshotOptions {
    int fSplitLevel = 99;                       ///< Split level of output tree
    bool fLazy = false;                         ///< Do not start the event loop when Snapshot is called
    bool fOverwriteIfExists = false; ///< If fMode is "UPDATE", overwrite object in output file if it already exists
+   ESnapshotOutputFormat fOutputFormat = ESnapshotOutputFormat::kDefault; ///< Format of the output dataset
+   /// RNTuple output: approximate compressed size of the clusters, in bytes
+   std::size_t fApproxZippedClusterSize = 50 * 1000 * 1000;
+   /// RNTuple output: a cluster is committed when its uncompressed size reaches this limit, in bytes
+   std::size_t fMaxUnzippedClusterSize = 512 * 1024 * 1024;
+   /// RNTuple output: approximate uncompressed size of the pages, in bytes
+   std::size_t fApproxUnzippedPageSize = 64 * 1024;
+   /// Parquet output: number of entries of the row groups
+   std::size_t fParquetRowGroupSize = 1024 * 1024;
 };
 } // ns RDF
 } // ns ROOT
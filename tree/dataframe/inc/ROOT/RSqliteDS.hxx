@@ -48,6 +48,10 @@ is used:
   - For expressions ("SELECT 1+1 FROM table"), the type of the first row of the result set determines the column type.
     That can result in a column to be of thought of type NULL where subsequent rows actually have meaningful values.
     The provided SELECT query can be used to avoid such ambiguities.
+
+The result set is read with a single cursor in chunks of rows. The values of the used columns are stored in typed
+column buffers, and each chunk is split in one entry range per slot. While reading is serialized, the rows are
+processed by all the slots in parallel when implicit multi-threading is enabled.
 */
 class RSqliteDS final : public ROOT::RDF::RDataSource {
 private:
@@ -62,29 +66,36 @@ private:
    };
    // clang-format on
 
-   /// Used to hold a single "cell" of the SELECT query's result table. Can be changed to std::variant once available.
-   struct Value_t {
-      explicit Value_t(ETypes type);
+   /// Holds the values of one column of the SELECT query's result table for the rows of the current chunk.
+   struct Column_t {
+      explicit Column_t(ETypes type) : fType(type) {}
 
       ETypes fType;
-      bool fIsActive; ///< Not all columns of the query are necessarily used by the RDF. Allows for skipping them.
-      Long64_t fInteger;
-      double fReal;
-      std::string fText;
-      std::vector<unsigned char> fBlob;
-      void *fNull;
-      void *fPtr; ///< Points to one of the values; an address to this pointer is returned by GetColumnReadersImpl.
+      bool fIsActive = false; ///< Not all columns of the query are necessarily used by the RDF. Allows for skipping them.
+      std::vector<Long64_t> fInteger;
+      std::vector<double> fReal;
+      std::vector<std::string> fText;
+      std::vector<std::vector<unsigned char>> fBlob;
    };
 
+   /// Number of rows per slot read from the result set by one call to GetEntryRanges()
+   static constexpr ULong64_t fgChunkRowsPerSlot = 1024;
+
    void SqliteError(int errcode);
 
    std::unique_ptr<Internal::RSqliteDSDataSet> fDataSet;
    unsigned int fNSlots;
-   ULong64_t fNRow;
+   ULong64_t fNRow;        ///< Number of rows read from the result set in the current event loop
+   ULong64_t fChunkBegin;  ///< Entry number of the first row in the column buffers
+   bool fIsDone;           ///< Set when the end of the result set has been reached
    std::vector<std::string> fColumnNames;
    std::vector<ETypes> fColumnTypes;
-   /// The data source is inherently single-threaded and returns only one row at a time. This vector holds the results.
-   std::vector<Value_t> fValues;
+   /// The values of the current chunk of rows
+   std::vector<Column_t> fColumns;
+   /// For each slot and column, points to the value of the slot's current entry in fColumns; an address to this
+   /// pointer is returned by GetColumnReadersImpl.
+   std::vector<std::vector<void *>> fValuePtrs;
+   void *fNull = nullptr;
 
    // clang-format off
    /// Corresponds to the types defined in ETypes.
@@ -11,10 +11,26 @@
 #include "ROOT/RDF/RActionBase.hxx"
 #include "ROOT/RDF/RLoopManager.hxx"
 
+#include <stdexcept>
+
 using namespace ROOT::Internal::RDF;
 
 RActionBase::RActionBase(RLoopManager *lm, const ColumnNames_t &colNames, const RBookedDefines &defines)
-   : fLoopManager(lm), fNSlots(lm->GetNSlots()), fColumnNames(colNames), fDefines(defines) { }
+   : fLoopManager(lm), fProfile(lm->GetNSlots(), "Action", ""), fNSlots(lm->GetNSlots()), fColumnNames(colNames),
+     fDefines(defines)
+{
+   fProfile.SetColumnNames(fColumnNames);
+}
 
 // outlined to pin virtual table
 RActionBase::~RActionBase() {}
+
+std::vector<std::string> RActionBase::GetVariationKeys() const
+{
+   std::vector<std::string> keys;
+   for (const auto &key : fDefines.GetVariationKeys(fColumnNames))
+      keys.emplace_back(key.GetName());
+   if (keys.empty())
+      throw std::runtime_error("VariationsFor: the result does not depend on any systematic variation.");
+   return keys;
+}
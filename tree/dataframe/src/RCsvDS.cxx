@@ -65,9 +65,10 @@ double-quote characters must be represented by a pair of double-quote characters
     2000,Mercury,Cougar
 ~~~
 
-The current implementation of RCsvDS reads the entire CSV file content into memory before
-RDataFrame starts processing it. Therefore, before creating a CSV RDataFrame, it is
-important to check both how much memory is available and the size of the CSV file.
+RCsvDS reads the CSV file in chunks of lines, which are split in as many entry ranges as there are slots. The
+threads of the event loop parse the lines of their entry range in parallel, so only the lines of the current chunk
+and their values are held in memory. The optional fourth parameter of ROOT::RDF::MakeCsvDataFrame sets the number of
+lines of a chunk; by default, a chunk is made of the lines contained in a few megabytes of the file per slot.
 */
 // clang-format on
 
@@ -78,11 +79,105 @@ important to check both how much memory is available and the size of the CSV fil
 #include <TError.h>
 
 #include <algorithm>
-#include <iostream>
+#include <cctype>
+#include <cerrno>
+#include <cstdlib>
+#include <limits>
 #include <memory>
-#include <sstream>
+#include <stdexcept>
 #include <string>
 
+#if __cplusplus >= 201703L && defined(__has_include)
+#if __has_include(<charconv>)
+#include <charconv>
+#endif
+#endif
+
+namespace {
+
+/// The size of the blocks in which the file is read; the chunks of lines span at least one block per slot unless
+/// the user sets the number of lines of a chunk.
+constexpr std::size_t kBlockSize = 4 * 1024 * 1024;
+
+std::size_t SkipSpaces(std::string_view s)
+{
+   std::size_t i = 0;
+   while (i < s.size() && std::isspace(static_cast<unsigned char>(s[i])))
+      ++i;
+   return i;
+}
+
+[[noreturn]] void ThrowParseError(std::string_view value, const std::string &colName, const char *typeName)
+{
+   std::string msg = "Could not parse the value \"";
+   msg += value;
+   msg += "\" of column \"" + colName + "\" of the CSV file as " + typeName;
+   throw std::runtime_error(msg);
+}
+
+[[noreturn]] void ThrowNValuesError(ULong64_t entry, const char *moreOrLess, std::size_t nColumns)
+{
+   throw std::runtime_error("The record of entry " + std::to_string(entry) + " of the CSV file has " + moreOrLess +
+                            " values than the " + std::to_string(nColumns) + " columns");
+}
+
+// Like std::stoll, parses the longest prefix of the value (after leading white spaces) that is an integer
+Long64_t ParseLong64(std::string_view value, const std::string &colName)
+{
+   auto i = SkipSpaces(value);
+   bool negative = false;
+   if (i < value.size() && (value[i] == '+' || value[i] == '-'))
+      negative = value[i++] == '-';
+   if (i == value.size() || value[i] < '0' || value[i] > '9')
+      ThrowParseError(value, colName, "Long64_t");
+
+   const std::uint64_t limit = negative ? std::uint64_t(std::numeric_limits<Long64_t>::max()) + 1u
+                                        : std::uint64_t(std::numeric_limits<Long64_t>::max());
+   std::uint64_t result = 0u;
+   for (; i < value.size() && value[i] >= '0' && value[i] <= '9'; ++i) {
+      const unsigned digit = value[i] - '0';
+      if (result > (limit - digit) / 10u)
+         ThrowParseError(value, colName, "Long64_t");
+      result = result * 10u + digit;
+   }
+   if (!negative)
+      return static_cast<Long64_t>(result);
+   return result == 0u ? 0 : -static_cast<Long64_t>(result - 1u) - 1;
+}
+
+// Like std::stod, parses the longest prefix of the value (after leading white spaces) that is a floating point number
+double ParseDouble(std::string_view value, const std::string &colName)
+{
+   auto i = SkipSpaces(value);
+#if defined(__cpp_lib_to_chars) && __cpp_lib_to_chars >= 201611L
+   // from_chars does not accept a leading plus, and does not depend on the locale
+   if (i + 1 < value.size() && value[i] == '+' && value[i + 1] != '-' && value[i + 1] != '+')
+      ++i;
+   double result = 0.;
+   const auto res = std::from_chars(value.data() + i, value.data() + value.size(), result);
+   if (res.ec != std::errc())
+      ThrowParseError(value, colName, "double");
+   return result;
+#else
+   // the value is not null-terminated
+   const std::string str(value.substr(i));
+   char *end = nullptr;
+   errno = 0;
+   const double result = std::strtod(str.c_str(), &end);
+   if (end == str.c_str() || errno == ERANGE)
+      ThrowParseError(value, colName, "double");
+   return result;
+#endif
+}
+
+// Like reading with std::boolalpha, a value is true if it starts with "true" after leading white spaces
+bool ParseBool(std::string_view value)
+{
+   return value.substr(SkipSpaces(value)).substr(0, 4) == "true";
+}
+
+} // anonymous namespace
+
 namespace ROOT {
 
 namespace RDF {
@@ -111,41 +206,6 @@ void RCsvDS::FillHeaders(const std::string &line)
    }
 }
 
-void RCsvDS::FillRecord(const std::string &line, Record_t &record)
-{
-   std::istringstream lineStream(line);
-   auto i = 0U;
-
-   auto columns = ParseColumns(line);
-
-   for (auto &col : columns) {
-      auto colType = fColTypes[fHeaders[i]];
-
-      switch (colType) {
-      case 'd': {
-         record.emplace_back(new double(std::stod(col)));
-         break;
-      }
-      case 'l': {
-         record.emplace_back(new Long64_t(std::stoll(col)));
-         break;
-      }
-      case 'b': {
-         auto b = new bool();
-         record.emplace_back(b);
-         std::istringstream is(col);
-         is >> std::boolalpha >> *b;
-         break;
-      }
-      case 's': {
-         record.emplace_back(new std::string(col));
-         break;
-      }
-      }
-      ++i;
-   }
-}
-
 void RCsvDS::GenerateHeaders(size_t size)
 {
    for (size_t i = 0; i < size; ++i) {
@@ -219,39 +279,75 @@ void RCsvDS::InferType(const std::string &col, unsigned int idxCol)
 std::vector<std::string> RCsvDS::ParseColumns(const std::string &line)
 {
    std::vector<std::string> columns;
+   std::string buffer;
+   std::string_view value;
 
    for (size_t i = 0; i < line.size(); ++i) {
-      i = ParseValue(line, columns, i);
+      i = ParseValue(line, i, buffer, value);
+      columns.emplace_back(value);
    }
 
    return columns;
 }
 
-size_t RCsvDS::ParseValue(const std::string &line, std::vector<std::string> &columns, size_t i)
+////////////////////////////////////////////////////////////////////////
+/// Parse the value of the line that starts at position i and return the position of the delimiter that ends it (or
+/// the size of the line). The value is a view of the line if it has no quotes, otherwise a view of the buffer in which
+/// the value is unquoted.
+size_t RCsvDS::ParseValue(std::string_view line, size_t i, std::string &buffer, std::string_view &value) const
 {
-   std::stringstream val;
-   bool quoted = false;
+   const auto begin = i;
+   for (; i < line.size() && line[i] != fDelimiter && line[i] != '"'; ++i)
+      ;
+   if (i == line.size() || line[i] == fDelimiter) {
+      value = line.substr(begin, i - begin);
+      return i;
+   }
 
+   buffer.assign(line.data() + begin, i - begin);
+   bool quoted = false;
    for (; i < line.size(); ++i) {
       if (line[i] == fDelimiter && !quoted) {
          break;
       } else if (line[i] == '"') {
          // Keep just one quote for escaped quotes, none for the normal quotes
-         if (line[i + 1] != '"') {
+         if (i + 1 == line.size() || line[i + 1] != '"') {
             quoted = !quoted;
          } else {
-            val << line[++i];
+            buffer += line[++i];
          }
       } else {
-         val << line[i];
+         buffer += line[i];
       }
    }
-
-   columns.emplace_back(val.str());
+   value = buffer;
 
    return i;
 }
 
+////////////////////////////////////////////////////////////////////////
+/// Parse the values of the line of an entry into the buffers of the columns of the slot.
+void RCsvDS::ParseLine(std::string_view line, RSlotValues &values, ULong64_t entry, std::string &buffer) const
+{
+   const auto nColumns = fHeaders.size();
+   const auto idx = entry - values.fFirstEntry;
+   std::string_view value;
+   size_t col = 0;
+   for (size_t i = 0; i < line.size(); ++i, ++col) {
+      if (col == nColumns)
+         ThrowNValuesError(entry, "more", nColumns);
+      i = ParseValue(line, i, buffer, value);
+      switch (fColTypesList[col]) {
+      case 'd': values.fDoubles[col][idx] = ParseDouble(value, fHeaders[col]); break;
+      case 'l': values.fLong64s[col][idx] = ParseLong64(value, fHeaders[col]); break;
+      case 'b': values.fBools[col][idx] = ParseBool(value); break;
+      case 's': values.fStrings[col][idx].assign(value.data(), value.size()); break;
+      }
+   }
+   if (col != nColumns)
+      ThrowNValuesError(entry, "less", nColumns);
+}
+
 ////////////////////////////////////////////////////////////////////////
 /// Constructor to create a CSV RDataSource for RDataFrame.
 /// \param[in] fileName Path or URL of the CSV file.
@@ -295,6 +391,7 @@ RCsvDS::RCsvDS(std::string_view fileName, bool readHeaders, char delimiter, Long
 
       // rewind
       fCsvFile->Seek(fDataPos);
+      fChunkPos = fDataPos;
    } else {
       std::string msg = "Could not infer column types of CSV file ";
       msg += fileName;
@@ -302,48 +399,37 @@ RCsvDS::RCsvDS(std::string_view fileName, bool readHeaders, char delimiter, Long
    }
 }
 
+////////////////////////////////////////////////////////////////////////
+/// Release the lines of the current chunk and the values parsed from them.
 void RCsvDS::FreeRecords()
 {
-   for (auto &record : fRecords) {
-      for (size_t i = 0; i < record.size(); ++i) {
-         void *p = record[i];
-         const auto colType = fColTypes[fHeaders[i]];
-         switch (colType) {
-         case 'd': {
-            delete static_cast<double *>(p);
-            break;
-         }
-         case 'l': {
-            delete static_cast<Long64_t *>(p);
-            break;
-         }
-         case 'b': {
-            delete static_cast<bool *>(p);
-            break;
-         }
-         case 's': {
-            delete static_cast<std::string *>(p);
-            break;
-         }
-         }
-      }
+   fLines.clear();
+   fEntryRanges.clear();
+   for (auto &values : fSlotValues) {
+      values.fFirstEntry = values.fNEntries = 0ULL;
+      for (auto &v : values.fDoubles)
+         v.clear();
+      for (auto &v : values.fLong64s)
+         v.clear();
+      for (auto &v : values.fStrings)
+         v.clear();
+      for (auto &v : values.fBools)
+         v.clear();
    }
-   fRecords.clear();
 }
 
 ////////////////////////////////////////////////////////////////////////
 /// Destructor.
-RCsvDS::~RCsvDS()
-{
-   FreeRecords();
-}
+RCsvDS::~RCsvDS() = default;
 
 void RCsvDS::Finalise()
 {
    fCsvFile->Seek(fDataPos);
    fProcessedLines = 0ULL;
-   fEntryRangesRequested = 0ULL;
    FreeRecords();
+   fChunk.clear();
+   fChunkPos = fDataPos;
+   fChunkEnd = 0;
 }
 
 const std::vector<std::string> &RCsvDS::GetColumnNames() const
@@ -351,51 +437,116 @@ const std::vector<std::string> &RCsvDS::GetColumnNames() const
    return fHeaders;
 }
 
-std::vector<std::pair<ULong64_t, ULong64_t>> RCsvDS::GetEntryRanges()
+////////////////////////////////////////////////////////////////////////
+/// Find the next chunk of non-empty lines in the file, reading blocks of it until the chunk has fLinesChunkSize
+/// lines, or lines spanning at least one block per slot if fLinesChunkSize is -1. The lines are only located here
+/// (which is little more than a memchr of the bytes read), the threads of the event loop parse them.
+void RCsvDS::ReadChunk()
 {
+   // the bytes after the lines of the previous chunk were already read
+   fChunk.erase(0, fChunkEnd);
+   fChunkPos += fChunkEnd;
+   fChunkEnd = 0;
+
+   const std::size_t maxLines =
+      -1LL == fLinesChunkSize ? std::numeric_limits<std::size_t>::max() : static_cast<std::size_t>(fLinesChunkSize);
+   const std::size_t minBytes = kBlockSize * std::max(fNSlots, 1u);
+   auto addLine = [this](std::size_t begin, std::size_t end) {
+      if (end > begin && fChunk[end - 1] == '\r') // Windows line breaks
+         --end;
+      if (end > begin) // skip empty lines
+         fLines.emplace_back(begin, end);
+   };
+
+   std::size_t scanPos = 0;
+   bool eof = false;
+   while (fLines.size() < maxLines) {
+      const auto lineEnd = fChunk.find('\n', scanPos);
+      if (lineEnd != std::string::npos) {
+         addLine(fChunkEnd, lineEnd);
+         fChunkEnd = scanPos = lineEnd + 1;
+         continue;
+      }
+      if (eof) {
+         // the last line has no line break
+         addLine(fChunkEnd, fChunk.size());
+         fChunkEnd = fChunk.size();
+         break;
+      }
+      if (fChunkEnd >= minBytes)
+         break;
+      scanPos = fChunk.size();
+      fChunk.resize(scanPos + kBlockSize);
+      const auto nRead = fCsvFile->ReadAt(&fChunk[scanPos], kBlockSize, fChunkPos + scanPos);
+      fChunk.resize(scanPos + nRead);
+      eof = nRead < kBlockSize;
+   }
+}
 
-   // Read records and store them in memory
-   auto linesToRead = fLinesChunkSize;
+std::vector<std::pair<ULong64_t, ULong64_t>> RCsvDS::GetEntryRanges()
+{
    FreeRecords();
-
-   std::string line;
-   while ((-1LL == fLinesChunkSize || 0 != linesToRead) && fCsvFile->Readln(line)) {
-      if (line.empty()) continue; // skip empty lines
-      fRecords.emplace_back();
-      FillRecord(line, fRecords.back());
-      --linesToRead;
-   }
+   ReadChunk();
 
    if (gDebug > 0) {
       if (fLinesChunkSize == -1LL) {
-         Info("GetEntryRanges", "Attempted to read entire CSV file into memory, %zu lines read", fRecords.size());
+         Info("GetEntryRanges", "Read chunk of %zu bytes of CSV file, %zu lines found", fChunkEnd, fLines.size());
       } else {
-         Info("GetEntryRanges", "Attempted to read chunk of %lld lines of CSV file into memory, %zu lines read", fLinesChunkSize, fRecords.size());
+         Info("GetEntryRanges", "Attempted to read chunk of %lld lines of CSV file, %zu lines found", fLinesChunkSize,
+              fLines.size());
       }
    }
 
-   std::vector<std::pair<ULong64_t, ULong64_t>> entryRanges;
-   const auto nRecords = fRecords.size();
+   const auto nRecords = fLines.size();
    if (0 == nRecords)
-      return entryRanges;
+      return fEntryRanges;
 
    const auto chunkSize = nRecords / fNSlots;
    const auto remainder = 1U == fNSlots ? 0 : nRecords % fNSlots;
-   auto start = 0ULL == fEntryRangesRequested ? 0ULL : fProcessedLines;
+   auto start = fProcessedLines;
    auto end = start;
 
    for (auto i : ROOT::TSeqU(fNSlots)) {
       start = end;
       end += chunkSize;
-      entryRanges.emplace_back(start, end);
+      fEntryRanges.emplace_back(start, end);
       (void)i;
    }
-   entryRanges.back().second += remainder;
+   fEntryRanges.back().second += remainder;
 
    fProcessedLines += nRecords;
-   fEntryRangesRequested++;
 
-   return entryRanges;
+   return fEntryRanges;
+}
+
+////////////////////////////////////////////////////////////////////////
+/// Parse the lines of the entry range of the current chunk that contains the entry into the buffers of the slot.
+/// Called by the thread of the slot, the entry ranges of a chunk are parsed in parallel.
+void RCsvDS::ParseEntryRange(unsigned int slot, ULong64_t entry)
+{
+   const auto range = std::find_if(fEntryRanges.begin(), fEntryRanges.end(),
+                                   [entry](const std::pair<ULong64_t, ULong64_t> &r) { return entry < r.second; });
+   if (range == fEntryRanges.end() || entry < range->first)
+      throw std::runtime_error("Entry " + std::to_string(entry) + " is not in the current chunk of the CSV file");
+
+   auto &values = fSlotValues[slot];
+   values.fFirstEntry = range->first;
+   values.fNEntries = range->second - range->first;
+   for (size_t col = 0; col < fHeaders.size(); ++col) {
+      switch (fColTypesList[col]) {
+      case 'd': values.fDoubles[col].resize(values.fNEntries); break;
+      case 'l': values.fLong64s[col].resize(values.fNEntries); break;
+      case 'b': values.fBools[col].resize(values.fNEntries); break;
+      case 's': values.fStrings[col].resize(values.fNEntries); break;
+      }
+   }
+
+   const auto firstLine = fProcessedLines - fLines.size();
+   std::string buffer;
+   for (auto e = range->first; e < range->second; ++e) {
+      const auto &line = fLines[e - firstLine];
+      ParseLine(std::string_view(fChunk.data() + line.first, line.second - line.first), values, e, buffer);
+   }
 }
 
 RCsvDS::ColType_t RCsvDS::GetType(std::string_view colName) const
@@ -421,31 +572,31 @@ bool RCsvDS::HasColumn(std::string_view colName) const
 
 bool RCsvDS::SetEntry(unsigned int slot, ULong64_t entry)
 {
-   // Here we need to normalise the entry to the number of lines we already processed.
-   const auto offset = (fEntryRangesRequested - 1) * fLinesChunkSize;
-   const auto recordPos = entry - offset;
-   int colIndex = 0;
-   for (auto &colType : fColTypesList) {
-      auto dataPtr = fRecords[recordPos][colIndex];
-      switch (colType) {
+   auto &values = fSlotValues[slot];
+   if (entry < values.fFirstEntry || entry >= values.fFirstEntry + values.fNEntries)
+      ParseEntryRange(slot, entry);
+
+   const auto idx = entry - values.fFirstEntry;
+   for (size_t colIndex = 0; colIndex < fHeaders.size(); ++colIndex) {
+      switch (fColTypesList[colIndex]) {
       case 'd': {
-         fDoubleEvtValues[colIndex][slot] = *static_cast<double *>(dataPtr);
+         fDoubleEvtValues[colIndex][slot] = values.fDoubles[colIndex][idx];
          break;
       }
       case 'l': {
-         fLong64EvtValues[colIndex][slot] = *static_cast<Long64_t *>(dataPtr);
+         fLong64EvtValues[colIndex][slot] = values.fLong64s[colIndex][idx];
          break;
       }
       case 'b': {
-         fBoolEvtValues[colIndex][slot] = *static_cast<bool *>(dataPtr);
+         fBoolEvtValues[colIndex][slot] = values.fBools[colIndex][idx];
          break;
       }
       case 's': {
-         fStringEvtValues[colIndex][slot] = *static_cast<std::string *>(dataPtr);
+         // every entry is read once, the parsed value can be given away
+         std::swap(fStringEvtValues[colIndex][slot], values.fStrings[colIndex][idx]);
          break;
       }
       }
-      colIndex++;
    }
    return true;
 }
@@ -465,6 +616,15 @@ void RCsvDS::SetNSlots(unsigned int nSlots)
    fLong64EvtValues.resize(nColumns, std::vector<Long64_t>(fNSlots));
    fStringEvtValues.resize(nColumns, std::vector<std::string>(fNSlots));
    fBoolEvtValues.resize(nColumns, std::deque<bool>(fNSlots));
+
+   // Initialize the buffers of the parsed values
+   fSlotValues.resize(fNSlots);
+   for (auto &values : fSlotValues) {
+      values.fDoubles.resize(nColumns);
+      values.fLong64s.resize(nColumns);
+      values.fStrings.resize(nColumns);
+      values.fBools.resize(nColumns);
+   }
 }
 
 std::string RCsvDS::GetLabel()
@@ -9,6 +9,41 @@
  *************************************************************************/
 
 #include "ROOT/RDF/ActionHelpers.hxx"
+#include "RConfigure.h" // R__USE_IMT
+#ifdef R__USE_IMT
+#include "ROOT/TSeq.hxx"
+#include "ROOT/TThreadExecutor.hxx"
+#include "TROOT.h" // IsImplicitMTEnabled
+#endif // R__USE_IMT
+#include "TSystem.h"
+
+#include <queue>
+
+namespace {
+
+/// Call fill(value, weight) on the entries of all slots in ascending order, entries being (value, weight) pairs or
+/// plain values. The entries of each slot must be sorted.
+template <typename Entry_t, typename Fill_t>
+void MergeSortedEntries(const std::vector<std::vector<Entry_t>> &entriesPerSlot, Fill_t &&fill)
+{
+   using Iter_t = typename std::vector<Entry_t>::const_iterator;
+   using Cursor_t = std::pair<Iter_t, Iter_t>; // current and end entries of a slot
+   auto greater = [](const Cursor_t &a, const Cursor_t &b) { return *b.first < *a.first; };
+   std::priority_queue<Cursor_t, std::vector<Cursor_t>, decltype(greater)> cursors(greater);
+   for (const auto &entries : entriesPerSlot) {
+      if (!entries.empty())
+         cursors.emplace(entries.begin(), entries.end());
+   }
+   while (!cursors.empty()) {
+      auto cursor = cursors.top();
+      cursors.pop();
+      fill(*cursor.first);
+      if (++cursor.first != cursor.second)
+         cursors.push(cursor);
+   }
+}
+
+} // anonymous namespace
 
 namespace ROOT {
 namespace Internal {
@@ -99,10 +134,66 @@ void FillHelper::Finalize()
       fResultHist->SetBins(fResultHist->GetNbinsX(), globalMin, globalMax);
    }
 
-   for (unsigned int i = 0; i < fNSlots; ++i) {
-      auto weights = fWBuffers[i].empty() ? nullptr : fWBuffers[i].data();
-      fResultHist->FillN(fBuffers[i].size(), fBuffers[i].data(), weights);
+   // The entries are filled in ascending order of value, then weight, whatever the slots that buffered them: the
+   // bin contents and statistics of the histogram, which depend on the order of the floating point additions, are
+   // then the same in sequential and multi-thread runs, whatever the number of threads and the scheduling of tasks.
+   const bool hasWeights = std::any_of(fWBuffers.begin(), fWBuffers.end(), [](const Buf_t &b) { return !b.empty(); });
+   std::vector<std::vector<std::pair<BufEl_t, BufEl_t>>> weightedEntries(hasWeights ? fNSlots : 0u);
+   auto sortSlot = [&](unsigned int slot) {
+      if (hasWeights) {
+         auto &entries = weightedEntries[slot];
+         entries.reserve(fBuffers[slot].size());
+         for (std::size_t i = 0u; i < fBuffers[slot].size(); ++i)
+            entries.emplace_back(fBuffers[slot][i], fWBuffers[slot][i]);
+         // the buffers are released as soon as possible, each slot is then held once in memory
+         Buf_t().swap(fBuffers[slot]);
+         Buf_t().swap(fWBuffers[slot]);
+         std::sort(entries.begin(), entries.end());
+      } else {
+         std::sort(fBuffers[slot].begin(), fBuffers[slot].end());
+      }
+   };
+#ifdef R__USE_IMT
+   if (ROOT::IsImplicitMTEnabled() && fNSlots > 1) {
+      ROOT::TThreadExecutor pool;
+      pool.Foreach(sortSlot, ROOT::TSeqU(fNSlots));
+   } else
+#endif // R__USE_IMT
+   {
+      for (unsigned int i = 0; i < fNSlots; ++i)
+         sortSlot(i);
    }
+
+   // The result is filled in chunks, the entries of the slots being merged on the fly
+   constexpr std::size_t chunkSize = 1024u;
+   Buf_t values, weights;
+   values.reserve(chunkSize);
+   weights.reserve(chunkSize);
+   auto flush = [&]() {
+      fResultHist->FillN(values.size(), values.data(), hasWeights ? weights.data() : nullptr);
+      values.clear();
+      weights.clear();
+   };
+   if (hasWeights) {
+      MergeSortedEntries(weightedEntries, [&](const std::pair<BufEl_t, BufEl_t> &entry) {
+         values.emplace_back(entry.first);
+         weights.emplace_back(entry.second);
+         if (values.size() == chunkSize)
+            flush();
+      });
+   } else {
+      MergeSortedEntries(fBuffers, [&](BufEl_t value) {
+         values.emplace_back(value);
+         if (values.size() == chunkSize)
+            flush();
+      });
+   }
+   flush();
+
+   for (auto &buffer : fBuffers)
+      Buf_t().swap(buffer);
+   for (auto &buffer : fWBuffers)
+      Buf_t().swap(buffer);
 }
 
 template void FillHelper::Exec(unsigned int, const std::vector<float> &);
@@ -233,6 +324,19 @@ template class TakeHelper<float, float, std::vector<float>>;
 template class TakeHelper<double, double, std::vector<double>>;
 #endif
 
+std::string MakeCacheSpillFileName(const std::string &dirName)
+{
+   TString fileName("rdf_cache_");
+   FILE *f = gSystem->TempFileName(fileName, dirName.empty() ? nullptr : dirName.c_str());
+   if (f == nullptr)
+      throw std::runtime_error("Cache: could not create a temporary file in directory \"" +
+                               (dirName.empty() ? std::string(gSystem->TempDirectory()) : dirName) + "\".");
+   fclose(f);
+   // TChain needs the .root extension to tell the file name from the tree name
+   gSystem->Unlink(fileName);
+   return std::string(fileName.Data()) + ".root";
+}
+
 void ValidateSnapshotOutput(const RSnapshotOptions &opts, const std::string &treeName, const std::string &fileName)
 {
    TString fileMode = opts.fMode;
@@ -7,6 +7,16 @@
  *************************************************************************/
 
 #include "ROOT/RDF/RBookedDefines.hxx"
+#include "ROOT/RDF/RDefineBase.hxx"
+#include "TError.h" // R__ASSERT
+
+namespace {
+void AddUnique(std::vector<std::string> &names, const std::string &name)
+{
+   if (std::find(names.begin(), names.end(), name) == names.end())
+      names.emplace_back(name);
+}
+} // anonymous namespace
 
 namespace ROOT {
 namespace Internal {
@@ -38,6 +48,112 @@ void RBookedDefines::AddName(std::string_view name)
    fDefinesNames = newColsNames;
 }
 
+void RBookedDefines::AddVariation(const RVariationInfo &variation)
+{
+   auto newVariations = std::make_shared<RVariationInfoMap_t>(*fVariations);
+   (*newVariations)[variation.fColumnName] = variation;
+   fVariations = newVariations;
+}
+
+const RVariationInfo *RBookedDefines::GetVariation(std::string_view colName) const
+{
+   const auto it = fVariations->find(std::string(colName));
+   return it == fVariations->end() ? nullptr : &it->second;
+}
+
+std::vector<std::string> RBookedDefines::GetVariationNames(const ColumnNames_t &columns) const
+{
+   std::vector<std::string> names;
+   for (const auto &col : columns) {
+      if (const auto *variation = GetVariation(col))
+         AddUnique(names, variation->fName);
+      const auto it = fVariedDefines->find(col);
+      if (it != fVariedDefines->end()) {
+         for (const auto &name : it->second)
+            AddUnique(names, name);
+      }
+   }
+   return names;
+}
+
+bool RBookedDefines::DependsOnVariation(const ColumnNames_t &columns, const std::string &variationName) const
+{
+   const auto names = GetVariationNames(columns);
+   return std::find(names.begin(), names.end(), variationName) != names.end();
+}
+
+void RBookedDefines::AddDefineVariations(std::string_view name, const ColumnNames_t &variationNames)
+{
+   const std::string colName(name);
+   if (variationNames.empty() && fVariedDefines->find(colName) == fVariedDefines->end())
+      return;
+   auto newVariedDefines = std::make_shared<RVariedDefinesMap_t>(*fVariedDefines);
+   if (variationNames.empty())
+      newVariedDefines->erase(colName); // a Redefine that does not use varied columns
+   else
+      (*newVariedDefines)[colName] = variationNames;
+   fVariedDefines = newVariedDefines;
+}
+
+void RBookedDefines::AddFilterVariations(const ColumnNames_t &variationNames)
+{
+   if (variationNames.empty())
+      return;
+   auto newFilterVariations = std::make_shared<ColumnNames_t>(*fFilterVariations);
+   for (const auto &name : variationNames)
+      AddUnique(*newFilterVariations, name);
+   fFilterVariations = newFilterVariations;
+}
+
+std::vector<RVariationKey> RBookedDefines::GetVariationKeys(const ColumnNames_t &columns) const
+{
+   auto names = GetVariationNames(columns);
+   for (const auto &name : *fFilterVariations)
+      AddUnique(names, name);
+
+   std::vector<RVariationKey> keys;
+   for (const auto &name : names) {
+      // all columns varied by the same variation have the same tags
+      const auto sameName = [&name](const RVariationInfoMap_t::value_type &v) { return v.second.fName == name; };
+      const auto it = std::find_if(fVariations->begin(), fVariations->end(), sameName);
+      R__ASSERT(it != fVariations->end() && "unknown variation");
+      const auto &tags = it->second.fTags;
+      for (std::size_t tagIdx = 0; tagIdx < tags.size(); ++tagIdx)
+         keys.push_back({name, tagIdx, tags[tagIdx]});
+   }
+   return keys;
+}
+
+RBookedDefines RBookedDefines::GetVaried(const RVariationKey &key) const
+{
+   const auto usesVariation = [&key](const RVariedDefinesMap_t::value_type &d) {
+      return std::find(d.second.begin(), d.second.end(), key.fName) != d.second.end();
+   };
+   const auto variesColumn = [&key](const RVariationInfoMap_t::value_type &v) { return v.second.fName == key.fName; };
+   if (std::none_of(fVariations->begin(), fVariations->end(), variesColumn))
+      return *this;
+
+   RBookedDefines varied(*this);
+   auto newDefines = std::make_shared<RDefineBasePtrMap_t>(*fDefines);
+   for (const auto &variation : *fVariations) {
+      if (!variesColumn(variation))
+         continue;
+      // the varied values are read from the internal Define that computes the RVec of all varied values
+      const auto &info = variation.second;
+      const auto &valuesDefine = fDefines->at(info.fDefineName);
+      RBookedDefines valuesDefines;
+      valuesDefines.AddColumn(valuesDefine, info.fDefineName);
+      (*newDefines)[info.fColumnName] = valuesDefine->GetTagDefine(key.fTagIdx, info.fColumnName, valuesDefines);
+      varied.AddName(info.fColumnName);
+   }
+   for (const auto &define : *fVariedDefines) {
+      if (usesVariation(define))
+         (*newDefines)[define.first] = fDefines->at(define.first)->GetVariedDefine(key);
+   }
+   varied.fDefines = newDefines;
+   return varied;
+}
+
 } // namespace RDF
 } // namespace Internal
 } // namespace ROOT
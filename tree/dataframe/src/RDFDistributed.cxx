@@ -0,0 +1,135 @@
+/*************************************************************************
+ * Copyright (C) 1995-2021, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#include "ROOT/InternalTreeUtils.hxx" // GetFileNamesFromTree, GetTreeFullPaths, GetFriendInfo
+#include "ROOT/RDFDistributed.hxx"
+#include "ROOT/RDF/RLoopManager.hxx"
+#include "TChain.h"
+#include "TFile.h"
+#include "TTree.h"
+
+#include <algorithm> // std::min
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace ROOT {
+namespace Internal {
+namespace RDF {
+
+namespace {
+/// Return the entry ranges of the clusters of the tree, reading the cluster boundaries from freshly opened files.
+EntryRanges_t GetClusterRanges(const TTree &tree)
+{
+   const auto fileNames = ROOT::Internal::TreeUtils::GetFileNamesFromTree(tree);
+   const auto treeNames = ROOT::Internal::TreeUtils::GetTreeFullPaths(tree);
+   EntryRanges_t clusters;
+   ULong64_t offset = 0ull;
+   for (std::size_t i = 0u; i < fileNames.size(); ++i) {
+      std::unique_ptr<TFile> f(TFile::Open(fileNames[i].c_str(), "READ"));
+      if (f == nullptr || f->IsZombie())
+         throw std::runtime_error("RunDistributed: could not open file \"" + fileNames[i] + "\".");
+      auto *t = f->Get<TTree>(treeNames[i].c_str());
+      if (t == nullptr)
+         throw std::runtime_error("RunDistributed: could not find tree \"" + treeNames[i] + "\" in file \"" +
+                                  fileNames[i] + "\".");
+      const auto nEntries = t->GetEntries();
+      auto clusterIt = t->GetClusterIterator(0);
+      Long64_t start = 0;
+      while ((start = clusterIt()) < nEntries) {
+         const auto end = std::min(clusterIt.GetNextEntry(), nEntries);
+         clusters.emplace_back(offset + start, offset + end);
+      }
+      offset += nEntries;
+   }
+   return clusters;
+}
+} // anonymous namespace
+
+EntryRanges_t GetDistributedEntryRanges(ROOT::Detail::RDF::RLoopManager &lm, unsigned int nRanges)
+{
+   if (nRanges == 0u)
+      throw std::logic_error("RunDistributed: the dataset cannot be split in 0 entry ranges.");
+   if (lm.GetDataSource() != nullptr)
+      throw std::runtime_error("RunDistributed: RDataFrames with a data source cannot be distributed yet.");
+
+   EntryRanges_t ranges;
+   auto *tree = lm.GetTree();
+   if (tree == nullptr) {
+      // empty source: split the entries evenly
+      const auto nEntries = lm.GetNEmptyEntries();
+      if (nEntries < nRanges)
+         nRanges = nEntries;
+      ULong64_t start = 0ull;
+      for (unsigned int i = 0u; i < nRanges; ++i) {
+         const ULong64_t end = start + nEntries / nRanges + (i < nEntries % nRanges ? 1 : 0);
+         ranges.emplace_back(start, end);
+         start = end;
+      }
+      return ranges;
+   }
+
+   if (lm.GetEntryList() != nullptr)
+      throw std::runtime_error("RunDistributed: RDataFrames with a TEntryList cannot be distributed yet.");
+
+   // group contiguous clusters so that the ranges have a similar number of entries
+   const auto clusters = GetClusterRanges(*tree);
+   if (clusters.empty())
+      return ranges;
+   const auto nEntries = clusters.back().second;
+   if (clusters.size() < nRanges)
+      nRanges = clusters.size();
+   for (const auto &cluster : clusters) {
+      if (ranges.empty() || ranges.back().second >= ranges.size() * nEntries / nRanges)
+         ranges.emplace_back(cluster);
+      else
+         ranges.back().second = cluster.second;
+   }
+   return ranges;
+}
+
+void ReopenTreeInWorker(ROOT::Detail::RDF::RLoopManager &lm)
+{
+   auto *tree = lm.GetTree();
+   if (tree == nullptr)
+      return;
+
+   const auto fileNames = ROOT::Internal::TreeUtils::GetFileNamesFromTree(*tree);
+   const auto treeNames = ROOT::Internal::TreeUtils::GetTreeFullPaths(*tree);
+   const auto friendInfo = ROOT::Internal::TreeUtils::GetFriendInfo(*tree);
+
+   auto chain = new TChain();
+   for (std::size_t i = 0u; i < fileNames.size(); ++i)
+      chain->Add((fileNames[i] + "?#" + treeNames[i]).c_str());
+   chain->ResetBit(TObject::kMustCleanup);
+
+   // the friend chains are owned by the deleter of the main chain
+   auto friends = std::make_shared<std::vector<std::unique_ptr<TChain>>>();
+   for (std::size_t i = 0u; i < friendInfo.fFriendNames.size(); ++i) {
+      const auto &friendFiles = friendInfo.fFriendFileNames[i];
+      const auto &friendSubNames = friendInfo.fFriendChainSubNames[i];
+      auto frChain = std::make_unique<TChain>(friendInfo.fFriendNames[i].first.c_str());
+      for (std::size_t j = 0u; j < friendFiles.size(); ++j) {
+         // if there are no chain subnames, the friend was a TTree
+         const auto fileName = friendSubNames.empty() ? friendFiles[j] : friendFiles[j] + "?#" + friendSubNames[j];
+         frChain->Add(fileName.c_str());
+      }
+      chain->AddFriend(frChain.get(), friendInfo.fFriendNames[i].second.c_str());
+      friends->emplace_back(std::move(frChain));
+   }
+
+   lm.SetTree(std::shared_ptr<TTree>(chain, [friends](TTree *t) {
+      delete t;
+      friends->clear();
+   }));
+}
+
+} // namespace RDF
+} // namespace Internal
+} // namespace ROOT
@@ -27,7 +27,7 @@ std::string GraphCreatorHelper::FromGraphLeafToDot(std::shared_ptr<GraphNode> le
 
    // Explore the graph bottom-up and store its dot representation.
    while (leaf) {
-      dotStringLabels << "\t" << leaf->fCounter << " [label=\"" << leaf->fName << "\", style=\"filled\", fillcolor=\""
+      dotStringLabels << "\t" << leaf->fCounter << " [label=\"" << leaf->GetLabel() << "\", style=\"filled\", fillcolor=\""
                       << leaf->fColor << "\", shape=\"" << leaf->fShape << "\"];\n";
       if (leaf->fPrevNode) {
          dotStringGraph << "\t" << leaf->fPrevNode->fCounter << " -> " << leaf->fCounter << ";\n";
@@ -47,7 +47,7 @@ std::string GraphCreatorHelper::FromGraphActionsToDot(std::vector<std::shared_pt
 
    for (auto leaf : leaves) {
       while (leaf && !leaf->fIsExplored) {
-         dotStringLabels << "\t" << leaf->fCounter << " [label=\"" << leaf->fName
+         dotStringLabels << "\t" << leaf->fCounter << " [label=\"" << leaf->GetLabel()
                          << "\", style=\"filled\", fillcolor=\"" << leaf->fColor << "\", shape=\"" << leaf->fShape
                          << "\"];\n";
          if (leaf->fPrevNode) {
@@ -100,6 +100,7 @@ CreateDefineNode(const std::string &columnName, const ROOT::Detail::RDF::RDefine
 
    auto node = std::make_shared<GraphNode>("Define\n" + columnName);
    node->SetDefine();
+   node->SetProfileSummary(columnPtr->GetProfile().GetSummary());
 
    sColumnsMap[columnPtr] = node;
    return node;
@@ -120,6 +121,7 @@ std::shared_ptr<GraphNode> CreateFilterNode(const ROOT::Detail::RDF::RFilterBase
 
    sFiltersMap[filterPtr] = node;
    node->SetFilter();
+   node->SetProfileSummary(filterPtr->GetProfile().GetSummary());
    return node;
 }
 
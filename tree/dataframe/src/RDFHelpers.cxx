@@ -9,6 +9,8 @@
  *************************************************************************/
 
 #include "ROOT/RDFHelpers.hxx"
+#include "ROOT/RDF/RLoopManager.hxx"
+#include "ROOT/RDF/Utils.hxx" // SetJitOptimizationLevel, SetConcurrentFillThreshold...
 #include "TROOT.h"      // IsImplicitMTEnabled
 #include "TError.h"     // Warning
 #include "RConfigure.h" // R__USE_IMT
@@ -16,11 +18,14 @@
 #include "ROOT/TThreadExecutor.hxx"
 #endif // R__USE_IMT
 
+#include <map>
 #include <set>
+#include <string>
+#include <vector>
 
 using ROOT::RDF::RResultHandle;
 
-void ROOT::RDF::RunGraphs(std::vector<RResultHandle> handles)
+void ROOT::RDF::RunGraphs(std::vector<RResultHandle> handles, bool sharedScan)
 {
    if (handles.empty()) {
       Warning("RunGraphs", "Got an empty list of handles");
@@ -46,14 +51,64 @@ void ROOT::RDF::RunGraphs(std::vector<RResultHandle> handles)
    std::set<RResultHandle, decltype(sameGraph)> s(handles.begin(), handles.end(), sameGraph);
    std::vector<RResultHandle> uniqueLoops(s.begin(), s.end());
 
+   // Group the event loops that can share their reading pass: the others are groups of one
+   std::vector<std::vector<ROOT::Detail::RDF::RLoopManager *>> groups;
+   std::map<std::string, std::size_t> groupIndices;
+   for (auto &h : uniqueLoops) {
+      const auto key = sharedScan ? h.fLoopManager->GetSharedScanKey() : std::string();
+      if (key.empty()) {
+         groups.push_back({h.fLoopManager});
+         continue;
+      }
+      auto it = groupIndices.find(key);
+      if (it == groupIndices.end()) {
+         groupIndices[key] = groups.size();
+         groups.push_back({h.fLoopManager});
+      } else {
+         groups[it->second].push_back(h.fLoopManager);
+      }
+   }
+
    // Trigger the unique event loops
-   auto run = [](RResultHandle &h) { h.fLoopManager->Run(); };
+   auto run = [](const std::vector<ROOT::Detail::RDF::RLoopManager *> &group) {
+      ROOT::Detail::RDF::RLoopManager::RunSharedScan(group);
+   };
 #ifdef R__USE_IMT
    if (ROOT::IsImplicitMTEnabled()) {
-      ROOT::TThreadExecutor{}.Foreach(run, uniqueLoops);
+      ROOT::TThreadExecutor{}.Foreach(run, groups);
       return;
    }
 #endif // R__USE_IMT
-   for (auto &h : uniqueLoops)
-      run(h);
+   for (auto &group : groups)
+      run(group);
+}
+
+void ROOT::RDF::Experimental::SetJitOptimizationLevel(int level)
+{
+   ROOT::Internal::RDF::SetJitOptimizationLevel(level);
+}
+
+int ROOT::RDF::Experimental::GetJitOptimizationLevel()
+{
+   return ROOT::Internal::RDF::GetJitOptimizationLevel();
+}
+
+void ROOT::RDF::Experimental::SetConcurrentFillThreshold(ULong64_t nBins)
+{
+   ROOT::Internal::RDF::SetConcurrentFillThreshold(nBins);
+}
+
+ULong64_t ROOT::RDF::Experimental::GetConcurrentFillThreshold()
+{
+   return ROOT::Internal::RDF::GetConcurrentFillThreshold();
+}
+
+void ROOT::RDF::Experimental::EnableJitNodeSharing(bool enable)
+{
+   ROOT::Internal::RDF::SetJitNodeSharing(enable);
+}
+
+bool ROOT::RDF::Experimental::IsJitNodeSharingEnabled()
+{
+   return ROOT::Internal::RDF::GetJitNodeSharing();
 }
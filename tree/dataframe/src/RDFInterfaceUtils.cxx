@@ -22,6 +22,7 @@
 #include <TObject.h>
 #include <TPRegexp.h>
 #include <TString.h>
+#include <TSystem.h>
 #include <TTree.h>
 
 // pragma to disable warnings on Rcpp which have
@@ -612,6 +613,21 @@ ParsedTreePath ParseTreePath(std::string_view fullTreeName)
    return {std::string(treeName), std::string(dirName)};
 }
 
+std::shared_ptr<RLoopManager>
+MakeSpilledCacheLoopManager(const std::vector<std::string> &fileNames, const ColumnNames_t &columns)
+{
+   auto lm = std::make_shared<RLoopManager>(nullptr, columns);
+   auto chain = new TChain("rdf_cache"); // the name of the trees written by CacheHelper
+   for (const auto &fileName : fileNames)
+      chain->Add(fileName.c_str());
+   lm->SetTree(std::shared_ptr<TTree>(chain, [fileNames](TTree *t) {
+      delete t;
+      for (const auto &fileName : fileNames)
+         gSystem->Unlink(fileName.c_str());
+   }));
+   return lm;
+}
+
 std::string PrettyPrintAddr(const void *const addr)
 {
    std::stringstream s;
@@ -620,10 +636,46 @@ std::string PrettyPrintAddr(const void *const addr)
    return s.str();
 }
 
-void BookFilterJit(const std::shared_ptr<RJittedFilter> &jittedFilter,
-                   std::shared_ptr<RDFDetail::RNodeBase> *prevNodeOnHeap, std::string_view name,
-                   std::string_view expression, const std::map<std::string, std::string> &aliasMap,
-                   const ColumnNames_t &branches, const RBookedDefines &customCols, TTree *tree, RDataSource *ds)
+/// Return the names of the columns used in the given expression, with aliases resolved.
+ColumnNames_t FindUsedColumnNames(std::string_view expression, const ColumnNames_t &branches,
+                                  const RBookedDefines &customCols, RDataSource *ds,
+                                  const std::map<std::string, std::string> &aliasMap)
+{
+   const auto &dsColumns = ds ? ds->GetColumnNames() : ColumnNames_t{};
+   return ParseRDFExpression(expression, branches, customCols.GetNames(), dsColumns, aliasMap).fUsedCols;
+}
+
+/// Return the key under which a jitted Filter or Define can share the node of an identical one, see
+/// ROOT::RDF::Experimental::EnableJitNodeSharing, or an empty string if it cannot. The key is made of the function of
+/// the expression (one per expression and column types), of what each column refers to in `customCols`, and of the
+/// previous node, if any.
+static std::string SharedJittedNodeKey(const std::string &lambdaName, const ColumnNames_t &usedCols,
+                                       const RBookedDefines &customCols, const RNodeBase *prevNode)
+{
+   // the varied nodes depend on the variations booked in each branch of the graph
+   if (!GetJitNodeSharing() || customCols.HasVariations())
+      return "";
+
+   std::stringstream key;
+   key << lambdaName << '(';
+   const auto &defines = customCols.GetColumns();
+   for (const auto &col : usedCols) {
+      const auto define = defines.find(col);
+      key << col << '=' << (define != defines.end() ? PrettyPrintAddr(define->second.get()) : "input") << ',';
+   }
+   key << ')';
+   if (prevNode)
+      key << " after " << PrettyPrintAddr(prevNode);
+   return key.str();
+}
+
+/// Book the jitted Filter `jittedFilter` with its loop manager and return it, or return an identical Filter booked
+/// before on the same node (see ROOT::RDF::Experimental::EnableJitNodeSharing), in which case `jittedFilter` is
+/// not used.
+std::shared_ptr<RJittedFilter>
+BookFilterJit(const std::shared_ptr<RJittedFilter> &jittedFilter, std::shared_ptr<RDFDetail::RNodeBase> *prevNodeOnHeap,
+              std::string_view name, std::string_view expression, const std::map<std::string, std::string> &aliasMap,
+              const ColumnNames_t &branches, const RBookedDefines &customCols, TTree *tree, RDataSource *ds)
 {
    const auto &dsColumns = ds ? ds->GetColumnNames() : ColumnNames_t{};
 
@@ -636,6 +688,18 @@ void BookFilterJit(const std::shared_ptr<RJittedFilter> &jittedFilter,
    if (type != "bool")
       std::runtime_error("Filter: the following expression does not evaluate to bool:\n" + std::string(expression));
 
+   auto lm = jittedFilter->GetLoopManagerUnchecked();
+   // named filters stay distinct, they are listed in the cut-flow reports
+   const auto sharedKey =
+      name.empty() ? SharedJittedNodeKey(lambdaName, parsedExpr.fUsedCols, customCols, prevNodeOnHeap->get()) : "";
+   if (!sharedKey.empty()) {
+      if (auto sharedFilter = lm->GetSharedJittedFilter(sharedKey)) {
+         delete prevNodeOnHeap;
+         return sharedFilter;
+      }
+      lm->AddSharedJittedFilter(sharedKey, jittedFilter);
+   }
+
    // definesOnHeap is deleted by the jitted call to JitFilterHelper
    ROOT::Internal::RDF::RBookedDefines *definesOnHeap = new ROOT::Internal::RDF::RBookedDefines(customCols);
    const auto definesOnHeapAddr = PrettyPrintAddr(definesOnHeap);
@@ -661,8 +725,9 @@ void BookFilterJit(const std::shared_ptr<RJittedFilter> &jittedFilter,
                     << "reinterpret_cast<ROOT::Internal::RDF::RBookedDefines*>(" << definesOnHeapAddr << ")"
                     << ");\n";
 
-   auto lm = jittedFilter->GetLoopManagerUnchecked();
    lm->ToJitExec(filterInvocation.str());
+   lm->Book(jittedFilter.get());
+   return jittedFilter;
 }
 
 // Jit a Define call
@@ -682,9 +747,21 @@ std::shared_ptr<RJittedDefine> BookDefineJit(std::string_view name, std::string_
    const auto lambdaName = DeclareLambda(parsedExpr.fExpr, parsedExpr.fVarNames, exprVarTypes);
    const auto type = RetTypeOfLambda(lambdaName);
 
+   // the value of a Define does not depend on the node it is booked on, but its name is part of the node
+   auto sharedKey = SharedJittedNodeKey(lambdaName, parsedExpr.fUsedCols, customCols, nullptr);
+   if (!sharedKey.empty()) {
+      sharedKey += " -> " + std::string(name);
+      if (auto sharedDefine = lm.GetSharedJittedDefine(sharedKey)) {
+         delete upcastNodeOnHeap;
+         return sharedDefine;
+      }
+   }
+
    auto definesCopy = new RBookedDefines(customCols);
    auto definesAddr = PrettyPrintAddr(definesCopy);
-   auto jittedDefine = std::make_shared<RDFDetail::RJittedDefine>(name, type, lm.GetNSlots(), lm.GetDSValuePtrs());
+   auto jittedDefine = std::make_shared<RDFDetail::RJittedDefine>(name, type, lm);
+   if (!sharedKey.empty())
+      lm.AddSharedJittedDefine(sharedKey, jittedDefine);
 
    std::stringstream defineInvocation;
    defineInvocation << "ROOT::Internal::RDF::JitDefineHelper(" << lambdaName << ", new const char*["
@@ -843,6 +920,16 @@ std::vector<bool> FindUndefinedDSColumns(const ColumnNames_t &requestedCols, con
    return mustBeDefined;
 }
 
+std::shared_ptr<ROOT::RDataFrame> MakeSnapshotOutputDataFrame(std::string_view fullTreeName, std::string_view fileName,
+                                                              const ColumnNames_t &columns,
+                                                              const ROOT::RDF::RSnapshotOptions &options)
+{
+   if (options.fOutputFormat == ROOT::RDF::ESnapshotOutputFormat::kRNTuple ||
+       options.fOutputFormat == ROOT::RDF::ESnapshotOutputFormat::kParquet)
+      return std::make_shared<ROOT::RDataFrame>(ULong64_t(0)); // replaced by SnapshotWriterHelper::Finalize
+   return std::make_shared<ROOT::RDataFrame>(fullTreeName, fileName, columns);
+}
+
 void CheckForDuplicateSnapshotColumns(const ColumnNames_t &cols)
 {
    std::unordered_set<std::string> uniqueCols;
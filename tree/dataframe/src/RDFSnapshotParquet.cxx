@@ -0,0 +1,309 @@
+/*************************************************************************
+ * Copyright (C) 1995-2021, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+// The Parquet output of Snapshot, see SnapshotWriterHelper. R__RDF_HAS_PARQUET is defined if ROOT is built with arrow
+// and Parquet is found.
+
+#include "ROOT/RDF/ActionHelpers.hxx"
+#include "ROOT/RDataFrame.hxx"
+#include "TString.h"
+
+#ifdef R__RDF_HAS_PARQUET
+#include "ROOT/RParquetDS.hxx"
+#include "ROOT/RVec.hxx"
+
+#if defined(__GNUC__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wshadow"
+#pragma GCC diagnostic ignored "-Wunused-parameter"
+#endif
+#include <arrow/builder.h>
+#include <arrow/io/file.h>
+#include <arrow/memory_pool.h>
+#include <arrow/table.h>
+#include <arrow/type.h>
+#include <parquet/arrow/writer.h>
+#include <parquet/properties.h>
+#if defined(__GNUC__)
+#pragma GCC diagnostic pop
+#endif
+
+#include <algorithm> // std::max
+#include <mutex>
+#endif
+
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace ROOT {
+namespace Internal {
+namespace RDF {
+
+#ifdef R__RDF_HAS_PARQUET
+
+namespace {
+
+void ThrowIfError(const arrow::Status &status, const std::string &what)
+{
+   if (!status.ok())
+      throw std::runtime_error("Snapshot: " + what + ": " + status.ToString());
+}
+
+/// Appends the values of a column to the Arrow array of the row group that a slot is buffering
+class RColumnAppender {
+public:
+   virtual ~RColumnAppender() = default;
+   virtual std::shared_ptr<arrow::DataType> GetType() const = 0;
+   virtual void Append(const void *value) = 0;
+   /// Return the array of the values appended so far, the appender is empty afterwards
+   virtual std::shared_ptr<arrow::Array> Finish() = 0;
+};
+
+/// T is the type of the column, Builder the one of the Arrow array
+template <typename T, typename Builder>
+class RValueAppender final : public RColumnAppender {
+   std::shared_ptr<arrow::DataType> fType;
+   Builder fBuilder;
+
+public:
+   explicit RValueAppender(const std::shared_ptr<arrow::DataType> &type) : fType(type) {}
+   std::shared_ptr<arrow::DataType> GetType() const final { return fType; }
+   void Append(const void *value) final
+   {
+      ThrowIfError(fBuilder.Append(static_cast<typename Builder::value_type>(*static_cast<const T *>(value))),
+                   "could not append a value");
+   }
+   std::shared_ptr<arrow::Array> Finish() final
+   {
+      std::shared_ptr<arrow::Array> array;
+      ThrowIfError(fBuilder.Finish(&array), "could not create an array");
+      return array;
+   }
+};
+
+class RStringAppender final : public RColumnAppender {
+   arrow::StringBuilder fBuilder;
+
+public:
+   std::shared_ptr<arrow::DataType> GetType() const final { return arrow::utf8(); }
+   void Append(const void *value) final
+   {
+      ThrowIfError(fBuilder.Append(*static_cast<const std::string *>(value)), "could not append a value");
+   }
+   std::shared_ptr<arrow::Array> Finish() final
+   {
+      std::shared_ptr<arrow::Array> array;
+      ThrowIfError(fBuilder.Finish(&array), "could not create an array");
+      return array;
+   }
+};
+
+/// RVecs are written as lists, their elements are copied in bulk
+template <typename T, typename ValueBuilder>
+class RListAppender final : public RColumnAppender {
+   std::shared_ptr<arrow::DataType> fValueType;
+   arrow::ListBuilder fBuilder;
+   ValueBuilder *fValueBuilder;
+
+public:
+   explicit RListAppender(const std::shared_ptr<arrow::DataType> &valueType)
+      : fValueType(valueType), fBuilder(arrow::default_memory_pool(), std::make_shared<ValueBuilder>()),
+        fValueBuilder(static_cast<ValueBuilder *>(fBuilder.value_builder()))
+   {
+   }
+   std::shared_ptr<arrow::DataType> GetType() const final { return arrow::list(fValueType); }
+   void Append(const void *value) final
+   {
+      const auto &v = *static_cast<const ROOT::RVec<T> *>(value);
+      ThrowIfError(fBuilder.Append(), "could not append a value");
+      // Long64_t and int64_t are different types with the same representation
+      ThrowIfError(
+         fValueBuilder->AppendValues(reinterpret_cast<const typename ValueBuilder::value_type *>(v.data()), v.size()),
+         "could not append a value");
+   }
+   std::shared_ptr<arrow::Array> Finish() final
+   {
+      std::shared_ptr<arrow::Array> array;
+      ThrowIfError(fBuilder.Finish(&array), "could not create an array");
+      return array;
+   }
+};
+
+template <typename T>
+bool IsType(const std::string &typeName)
+{
+   return typeName == TypeID2TypeName(typeid(T));
+}
+
+/// The types supported are the ones that RParquetDS reads
+std::unique_ptr<RColumnAppender> MakeAppender(const std::string &columnName, const std::string &typeName)
+{
+   if (IsType<bool>(typeName))
+      return std::make_unique<RValueAppender<bool, arrow::BooleanBuilder>>(arrow::boolean());
+   if (IsType<Int_t>(typeName))
+      return std::make_unique<RValueAppender<Int_t, arrow::Int32Builder>>(arrow::int32());
+   if (IsType<UInt_t>(typeName))
+      return std::make_unique<RValueAppender<UInt_t, arrow::UInt32Builder>>(arrow::uint32());
+   if (IsType<Long64_t>(typeName))
+      return std::make_unique<RValueAppender<Long64_t, arrow::Int64Builder>>(arrow::int64());
+   if (IsType<ULong64_t>(typeName))
+      return std::make_unique<RValueAppender<ULong64_t, arrow::UInt64Builder>>(arrow::uint64());
+   if (IsType<float>(typeName))
+      return std::make_unique<RValueAppender<float, arrow::FloatBuilder>>(arrow::float32());
+   if (IsType<double>(typeName))
+      return std::make_unique<RValueAppender<double, arrow::DoubleBuilder>>(arrow::float64());
+   if (IsType<std::string>(typeName))
+      return std::make_unique<RStringAppender>();
+   if (IsType<ROOT::RVec<Int_t>>(typeName))
+      return std::make_unique<RListAppender<Int_t, arrow::Int32Builder>>(arrow::int32());
+   if (IsType<ROOT::RVec<UInt_t>>(typeName))
+      return std::make_unique<RListAppender<UInt_t, arrow::UInt32Builder>>(arrow::uint32());
+   if (IsType<ROOT::RVec<Long64_t>>(typeName))
+      return std::make_unique<RListAppender<Long64_t, arrow::Int64Builder>>(arrow::int64());
+   if (IsType<ROOT::RVec<ULong64_t>>(typeName))
+      return std::make_unique<RListAppender<ULong64_t, arrow::UInt64Builder>>(arrow::uint64());
+   if (IsType<ROOT::RVec<float>>(typeName))
+      return std::make_unique<RListAppender<float, arrow::FloatBuilder>>(arrow::float32());
+   if (IsType<ROOT::RVec<double>>(typeName))
+      return std::make_unique<RListAppender<double, arrow::DoubleBuilder>>(arrow::float64());
+   throw std::runtime_error("Snapshot: column \"" + columnName + "\" of type \"" + typeName +
+                            "\" cannot be written to a Parquet file.");
+}
+
+parquet::Compression::type GetCompression(const RSnapshotOptions &opts)
+{
+   if (opts.fCompressionLevel == 0)
+      return parquet::Compression::UNCOMPRESSED;
+   switch (opts.fCompressionAlgorithm) {
+   case ROOT::kZLIB: return parquet::Compression::GZIP;
+   case ROOT::kLZ4: return parquet::Compression::LZ4;
+   case ROOT::kZSTD: return parquet::Compression::ZSTD;
+   // Parquet has no LZMA codec
+   default: return parquet::Compression::SNAPPY;
+   }
+}
+
+class RParquetSnapshotWriterImpl final : public RSnapshotWriter {
+   const std::string fFileName;
+   const std::size_t fRowGroupSize;
+   std::shared_ptr<ROOT::RDataFrame> fOutputDataFrame;
+   std::shared_ptr<arrow::Schema> fSchema;
+   std::shared_ptr<arrow::io::FileOutputStream> fFile;
+   std::unique_ptr<parquet::arrow::FileWriter> fWriter;
+   std::mutex fWriterMutex;                                             // the row groups are written one at a time
+   std::vector<std::vector<std::unique_ptr<RColumnAppender>>> fAppenders; // [slot][column]
+   std::vector<std::size_t> fNBufferedEntries;                          // per slot
+
+   /// Write the entries buffered by the slot as a row group
+   void WriteRowGroup(unsigned int slot)
+   {
+      std::vector<std::shared_ptr<arrow::Array>> arrays;
+      for (auto &appender : fAppenders[slot])
+         arrays.emplace_back(appender->Finish());
+      const auto nEntries = fNBufferedEntries[slot];
+      fNBufferedEntries[slot] = 0;
+      auto table = arrow::Table::Make(fSchema, arrays, nEntries);
+
+      std::lock_guard<std::mutex> lock(fWriterMutex);
+      ThrowIfError(fWriter->WriteTable(*table, nEntries), "could not write a row group to " + fFileName);
+   }
+
+public:
+   RParquetSnapshotWriterImpl(unsigned int nSlots, const std::string &fileName, const ColumnNames_t &columnNames,
+                              const std::vector<std::string> &typeNames, const RSnapshotOptions &opts,
+                              const std::shared_ptr<ROOT::RDataFrame> &outputDataFrame)
+      : fFileName(fileName), fRowGroupSize(std::max<std::size_t>(opts.fParquetRowGroupSize, 1u)),
+        fOutputDataFrame(outputDataFrame), fAppenders(nSlots), fNBufferedEntries(nSlots, 0u)
+   {
+      for (auto &appenders : fAppenders) {
+         for (std::size_t i = 0u; i < columnNames.size(); ++i)
+            appenders.emplace_back(MakeAppender(columnNames[i], typeNames[i]));
+      }
+      std::vector<std::shared_ptr<arrow::Field>> fields;
+      for (std::size_t i = 0u; i < columnNames.size(); ++i)
+         fields.emplace_back(arrow::field(columnNames[i], fAppenders[0][i]->GetType()));
+      fSchema = arrow::schema(fields);
+
+      auto file = arrow::io::FileOutputStream::Open(fFileName);
+      ThrowIfError(file.status(), "could not create " + fFileName);
+      fFile = *file;
+      parquet::WriterProperties::Builder properties;
+      properties.compression(GetCompression(opts));
+      if (opts.fCompressionLevel > 0 && GetCompression(opts) != parquet::Compression::SNAPPY)
+         properties.compression_level(opts.fCompressionLevel);
+      ThrowIfError(parquet::arrow::FileWriter::Open(*fSchema, arrow::default_memory_pool(), fFile, properties.build(),
+                                                    parquet::default_arrow_writer_properties(), &fWriter),
+                   "could not create " + fFileName);
+   }
+
+   void Fill(unsigned int slot, void *const *addresses) final
+   {
+      auto &appenders = fAppenders[slot];
+      for (std::size_t i = 0u; i < appenders.size(); ++i)
+         appenders[i]->Append(addresses[i]);
+      if (++fNBufferedEntries[slot] == fRowGroupSize)
+         WriteRowGroup(slot);
+   }
+
+   void Finalize() final
+   {
+      for (unsigned int slot = 0u; slot < fAppenders.size(); ++slot) {
+         if (fNBufferedEntries[slot] > 0u)
+            WriteRowGroup(slot);
+      }
+      ThrowIfError(fWriter->Close(), "could not write the footer of " + fFileName);
+      ThrowIfError(fFile->Close(), "could not close " + fFileName);
+      fWriter.reset();
+      fFile.reset();
+      *fOutputDataFrame = ROOT::RDF::MakeParquetDataFrame(fFileName);
+   }
+};
+
+} // anonymous namespace
+
+void ValidateParquetSnapshotOutput(const RSnapshotOptions &opts, const std::string &dirName)
+{
+   TString fileMode = opts.fMode;
+   fileMode.ToLower();
+   if (fileMode != "recreate")
+      throw std::invalid_argument("Snapshot: Parquet outputs can only be written with mode \"RECREATE\", not \"" +
+                                  opts.fMode + "\".");
+   if (!dirName.empty())
+      throw std::invalid_argument("Snapshot: Parquet outputs have no directories (\"" + dirName + "\").");
+}
+
+std::unique_ptr<RSnapshotWriter>
+MakeParquetSnapshotWriter(unsigned int nSlots, const std::string &fileName, const ColumnNames_t &columnNames,
+                          const std::vector<std::string> &typeNames, const RSnapshotOptions &opts,
+                          const std::shared_ptr<ROOT::RDataFrame> &outputDataFrame)
+{
+   return std::make_unique<RParquetSnapshotWriterImpl>(nSlots, fileName, columnNames, typeNames, opts,
+                                                       outputDataFrame);
+}
+
+#else
+
+void ValidateParquetSnapshotOutput(const RSnapshotOptions &, const std::string &)
+{
+   throw std::runtime_error("Snapshot: Parquet outputs require ROOT to be built with arrow=ON and Parquet.");
+}
+
+std::unique_ptr<RSnapshotWriter> MakeParquetSnapshotWriter(unsigned int, const std::string &, const ColumnNames_t &,
+                                                           const std::vector<std::string> &, const RSnapshotOptions &,
+                                                           const std::shared_ptr<ROOT::RDataFrame> &)
+{
+   throw std::runtime_error("Snapshot: Parquet outputs require ROOT to be built with arrow=ON and Parquet.");
+}
+
+#endif // R__RDF_HAS_PARQUET
+
+} // namespace RDF
+} // namespace Internal
+} // namespace ROOT
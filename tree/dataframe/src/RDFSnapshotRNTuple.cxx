@@ -0,0 +1,178 @@
+/*************************************************************************
+ * Copyright (C) 1995-2021, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+// The RNTuple output of Snapshot, see SnapshotWriterHelper. R__RDF_HAS_RNTUPLE is defined if ROOT is built with root7.
+
+#include "ROOT/RDF/ActionHelpers.hxx"
+#include "ROOT/RDataFrame.hxx"
+#include "TString.h"
+
+#ifdef R__RDF_HAS_RNTUPLE
+#include "ROOT/REntry.hxx"
+#include "ROOT/RField.hxx"
+#include "ROOT/RNTuple.hxx"
+#include "ROOT/RNTupleDS.hxx"
+#include "ROOT/RNTupleModel.hxx"
+#include "ROOT/RNTupleOptions.hxx"
+#endif
+
+#include <algorithm> // std::equal
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace ROOT {
+namespace Internal {
+namespace RDF {
+
+#ifdef R__RDF_HAS_RNTUPLE
+
+namespace {
+
+namespace RNT = ROOT::Experimental;
+
+/// The entry of a slot binds the addresses of the current values of the slot to the fields. It is rebuilt when the
+/// addresses change, e.g. when a TTree reader moves to a new tree.
+class RSlotEntry {
+   std::vector<RNT::Detail::RFieldBase *> fFields;
+   std::vector<void *> fAddresses;
+   std::unique_ptr<RNT::REntry> fEntry;
+
+   void Rebuild(void *const *addresses)
+   {
+      fAddresses.assign(addresses, addresses + fFields.size());
+      fEntry = std::make_unique<RNT::REntry>();
+      for (std::size_t i = 0u; i < fFields.size(); ++i)
+         fEntry->CaptureValue(fFields[i]->CaptureValue(fAddresses[i]));
+   }
+
+public:
+   /// prototype is an entry created by the model that the values are written to
+   explicit RSlotEntry(RNT::REntry &prototype)
+   {
+      for (auto &value : prototype)
+         fFields.emplace_back(value.GetField());
+   }
+
+   RNT::REntry &Get(void *const *addresses)
+   {
+      if (!fEntry || !std::equal(fAddresses.begin(), fAddresses.end(), addresses))
+         Rebuild(addresses);
+      return *fEntry;
+   }
+};
+
+class RNTupleSnapshotWriterImpl final : public RSnapshotWriter {
+   const std::string fFileName;
+   const std::string fNTupleName;
+   std::shared_ptr<ROOT::RDataFrame> fOutputDataFrame;
+   /// Used in single-thread runs
+   std::unique_ptr<RNT::RNTupleWriter> fWriter;
+   /// Used in multi-thread runs, the slots fill their own clusters through the fill contexts
+   std::unique_ptr<RNT::RNTupleParallelWriter> fParallelWriter;
+   std::vector<std::shared_ptr<RNT::RNTupleFillContext>> fFillContexts; // per slot, created at the first Fill
+   std::vector<std::unique_ptr<RSlotEntry>> fEntries;                   // per slot
+
+public:
+   RNTupleSnapshotWriterImpl(unsigned int nSlots, const std::string &fileName, const std::string &ntupleName,
+                             std::unique_ptr<RNT::RNTupleModel> model, const RNT::RNTupleWriteOptions &writeOptions,
+                             const std::shared_ptr<ROOT::RDataFrame> &outputDataFrame)
+      : fFileName(fileName), fNTupleName(ntupleName), fOutputDataFrame(outputDataFrame), fFillContexts(nSlots),
+        fEntries(nSlots)
+   {
+      if (nSlots == 1u) {
+         fWriter = RNT::RNTupleWriter::Recreate(std::move(model), ntupleName, fileName, writeOptions);
+         fEntries[0].reset(new RSlotEntry(*fWriter->CreateEntry()));
+      } else {
+         fParallelWriter = RNT::RNTupleParallelWriter::Recreate(std::move(model), ntupleName, fileName, writeOptions);
+      }
+   }
+
+   void Fill(unsigned int slot, void *const *addresses) final
+   {
+      if (fWriter) {
+         fWriter->Fill(fEntries[0]->Get(addresses));
+         return;
+      }
+      if (!fFillContexts[slot]) {
+         fFillContexts[slot] = fParallelWriter->CreateFillContext();
+         fEntries[slot].reset(new RSlotEntry(*fFillContexts[slot]->CreateEntry()));
+      }
+      fFillContexts[slot]->Fill(fEntries[slot]->Get(addresses));
+   }
+
+   void Finalize() final
+   {
+      // the fill contexts commit their last cluster when destructed, and must go before their writer
+      fEntries.clear();
+      fFillContexts.clear();
+      fParallelWriter.reset();
+      fWriter.reset();
+      *fOutputDataFrame = ROOT::Experimental::MakeNTupleDataFrame(fNTupleName, fFileName);
+   }
+};
+
+} // anonymous namespace
+
+void ValidateRNTupleSnapshotOutput(const RSnapshotOptions &opts, const std::string &dirName)
+{
+   TString fileMode = opts.fMode;
+   fileMode.ToLower();
+   if (fileMode != "recreate")
+      throw std::invalid_argument("Snapshot: RNTuple outputs can only be written with mode \"RECREATE\", not \"" +
+                                  opts.fMode + "\".");
+   if (!dirName.empty())
+      throw std::invalid_argument("Snapshot: RNTuple outputs cannot be written to a subdirectory (\"" + dirName +
+                                  "\") yet.");
+}
+
+std::unique_ptr<RSnapshotWriter>
+MakeRNTupleSnapshotWriter(unsigned int nSlots, const std::string &fileName, const std::string &ntupleName,
+                          const ColumnNames_t &fieldNames, const std::vector<std::string> &typeNames,
+                          const RSnapshotOptions &opts, const std::shared_ptr<ROOT::RDataFrame> &outputDataFrame)
+{
+   auto model = RNT::RNTupleModel::Create();
+   for (std::size_t i = 0u; i < fieldNames.size(); ++i) {
+      auto field = RNT::Detail::RFieldBase::Create(fieldNames[i], typeNames[i]);
+      if (typeNames[i].empty() || !field)
+         throw std::runtime_error("Snapshot: column \"" + fieldNames[i] + "\" of type \"" + typeNames[i] +
+                                  "\" cannot be written to an RNTuple.");
+      model->AddField(field.Unwrap());
+   }
+
+   RNT::RNTupleWriteOptions writeOptions;
+   writeOptions.SetCompression(ROOT::CompressionSettings(opts.fCompressionAlgorithm, opts.fCompressionLevel));
+   writeOptions.SetApproxZippedClusterSize(opts.fApproxZippedClusterSize);
+   writeOptions.SetMaxUnzippedClusterSize(opts.fMaxUnzippedClusterSize);
+   writeOptions.SetApproxUnzippedPageSize(opts.fApproxUnzippedPageSize);
+
+   return std::make_unique<RNTupleSnapshotWriterImpl>(nSlots, fileName, ntupleName, std::move(model), writeOptions,
+                                                      outputDataFrame);
+}
+
+#else
+
+void ValidateRNTupleSnapshotOutput(const RSnapshotOptions &, const std::string &)
+{
+   throw std::runtime_error("Snapshot: RNTuple outputs require ROOT to be built with root7=ON.");
+}
+
+std::unique_ptr<RSnapshotWriter>
+MakeRNTupleSnapshotWriter(unsigned int, const std::string &, const std::string &, const ColumnNames_t &,
+                          const std::vector<std::string> &, const RSnapshotOptions &,
+                          const std::shared_ptr<ROOT::RDataFrame> &)
+{
+   throw std::runtime_error("Snapshot: RNTuple outputs require ROOT to be built with root7=ON.");
+}
+
+#endif // R__RDF_HAS_RNTUPLE
+
+} // namespace RDF
+} // namespace Internal
+} // namespace ROOT
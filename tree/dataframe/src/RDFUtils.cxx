@@ -26,6 +26,7 @@
 #include "TROOT.h" // IsImplicitMTEnabled, GetThreadPoolSize
 #include "TTree.h"
 
+#include <atomic>
 #include <stdexcept>
 #include <string>
 #include <cstring>
@@ -317,8 +318,71 @@ std::vector<std::string> ReplaceDotWithUnderscore(const std::vector<std::string>
    return newColNames;
 }
 
-void InterpreterDeclare(const std::string &code)
+static std::atomic<int> &JitOptimizationLevel()
 {
+   static std::atomic<int> level{-1};
+   return level;
+}
+
+void SetJitOptimizationLevel(int level)
+{
+   if (level < -1 || level > 3)
+      throw std::runtime_error("RDataFrame: invalid optimization level " + std::to_string(level) +
+                               " for just-in-time compilation. Valid values are 0 to 3, or -1 for the default.");
+   JitOptimizationLevel() = level;
+}
+
+int GetJitOptimizationLevel()
+{
+   return JitOptimizationLevel();
+}
+
+static std::atomic<ULong64_t> &ConcurrentFillThreshold()
+{
+   static std::atomic<ULong64_t> threshold{0ull};
+   return threshold;
+}
+
+void SetConcurrentFillThreshold(ULong64_t nBins)
+{
+   ConcurrentFillThreshold() = nBins;
+}
+
+ULong64_t GetConcurrentFillThreshold()
+{
+   return ConcurrentFillThreshold();
+}
+
+static std::atomic<bool> &JitNodeSharing()
+{
+   static std::atomic<bool> enabled{false};
+   return enabled;
+}
+
+void SetJitNodeSharing(bool enable)
+{
+   JitNodeSharing() = enable;
+}
+
+bool GetJitNodeSharing()
+{
+   return JitNodeSharing();
+}
+
+/// Prepend the `#pragma cling optimize` directive that applies the requested optimization level to the code, if any.
+/// The pragma applies to the whole cling transaction, so e.g. to all the code of the nodes jitted by one
+/// RLoopManager::Jit call. As in TFormula, the pragma must come first.
+static std::string WithJitOptimizationLevel(const std::string &code)
+{
+   const int level = JitOptimizationLevel();
+   if (level < 0)
+      return code;
+   return "#pragma cling optimize(" + std::to_string(level) + ")\n" + code;
+}
+
+void InterpreterDeclare(const std::string &codeToDeclare)
+{
+   const auto code = WithJitOptimizationLevel(codeToDeclare);
    R__LOG_DEBUG(10, RDFLogChannel()) << "Declaring the following code to cling:\n\n" << code << '\n';
 
    if (!gInterpreter->Declare(code.c_str())) {
@@ -329,8 +393,9 @@ void InterpreterDeclare(const std::string &code)
    }
 }
 
-Long64_t InterpreterCalc(const std::string &code, const std::string &context)
+Long64_t InterpreterCalc(const std::string &codeToCalc, const std::string &context)
 {
+   const auto code = WithJitOptimizationLevel(codeToCalc);
    R__LOG_DEBUG(10, RDFLogChannel()) << "Jitting and executing the following code:\n\n" << code << '\n';
 
    TInterpreter::EErrorCode errorCode(TInterpreter::kNoError);
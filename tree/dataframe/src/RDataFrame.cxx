@@ -14,7 +14,9 @@
 #include "ROOT/RDataFrame.hxx"
 #include "ROOT/RDataSource.hxx"
 #include "TChain.h"
+#include "TChainElement.h"
 #include "TDirectory.h"
+#include "TEntryList.h"
 
 // clang-format off
 /**
@@ -84,7 +86,8 @@ Transformations are a way to manipulate the data.
 | DefineSlot() | Same as Define(), but the user-defined function must take an extra `unsigned int slot` as its first parameter. `slot` will take a different value, `0` to `nThreads - 1`, for each thread of execution. This is meant as a helper in writing thread-safe Define() transformation when using RDataFrame after ROOT::EnableImplicitMT(). DefineSlot() works just as well with single-thread execution: in that case `slot` will always be `0`.  |
 | DefineSlotEntry() | Same as DefineSlot(), but the entry number is passed in addition to the slot number. This is meant as a helper in case some dependency on the entry number needs to be honoured. |
 | Filter() | Filter rows based on user-defined conditions. |
-| Range() | Filter rows based on entry number (single-thread only). |
+| Range() | Filter rows based on entry number (in multi-thread runs, only contiguous ranges booked on the RDataFrame itself). |
+| Vary() | Register systematic variations of a column. ROOT::RDF::Experimental::VariationsFor() then produces the varied results of an action in the same event loop as the nominal result. |
 
 ### Actions
 Actions aggregate data into a result. Each one is described in more detail in the reference guide.
@@ -136,6 +139,7 @@ These operations do not modify the dataframe or book computations but simply ret
 | GetFilterNames() | Return the names of all filters in the computation graph. If called on a root node, all filters will be returned. For any other node, only the filters upstream of that node. |
 | SaveGraph() | Store the computation graph of an RDataFrame in graphviz format for easy inspection. |
 | GetNRuns() | Return the number of event loops run by this RDataFrame instance so far. |
+| GetProfileReport() | Return the time spent and the entries processed by each node of the computation graph, see [Profiling the computation graph](\ref rdf-profiling). |
 | GetNSlots() | Return the number of processing slots that RDataFrame will use during the event loop (i.e. the concurrency level). |
 | Describe() | Get useful information describing the dataframe, e.g. columns and their types. |
 | DescribeDataset() | Get useful information describing the dataset (subset of the output of Describe()). |
@@ -273,6 +277,11 @@ RDataFrame d5("myTree", files);
 RDataFrame d6("myTree", "file*.root"); // the glob is passed as-is to TChain's constructor
 RDataFrame d7(chain);
 ~~~
+The processing can be restricted to the entries of a TEntryList, with a sub-list per file or with the global entry
+numbers of the chain: the files and the clusters without entries in the list are then not read at all.
+~~~{.cpp}
+RDataFrame d8("myTree", files, &entryList);
+~~~
 Additionally, users can construct a RDataFrame with no data source by passing an integer number. This is the number of rows that
 will be generated by this RDataFrame.
 ~~~{.cpp}
@@ -407,8 +416,9 @@ auto d15on = d.Range(15, 0);
 // We can specify a stride too, in this case we pick an event every 3
 auto d15each3 = d.Range(0, 15, 3);
 ~~~
-Note that ranges are not available when multi-threading is enabled. More information on ranges is available
-[here](#ranges).
+When multi-threading is enabled, only ranges of contiguous entries booked directly on the RDataFrame, like `d30` and
+`d15on`, are available: the event loop then only processes the clusters of the dataset that contain the selected
+entries, using all threads. More information on ranges is available [here](#ranges).
 
 ### Executing multiple actions in the same event loop
 As a final example let us apply two different cuts on branch "MET" and fill two different histograms with the "pt\_v" of
@@ -640,6 +650,22 @@ where `n` is the number of dataset partitions. As with local RDataFrame, the res
 RDataFrame is another distributed RDataFrame on which we can define a new computation graph and run more distributed
 computations.
 
+### Distributed execution in C++
+
+The experimental ROOT::RDF::Experimental::RunDistributed function runs the event loop of a C++ computation graph
+over several worker processes. The dataset is split in entry ranges, at cluster boundaries for TTrees, each worker
+runs the computation graph over one range and the partial results are merged in the calling process through
+RMergeableValue:
+~~~{.cpp}
+ROOT::RDataFrame df("events", "data_*.root");
+auto h = df.Filter("nMuon == 2").Histo1D<float>("Muon_pt");
+ROOT::RDF::Experimental::RProcessBackend backend(8); // 8 worker processes forked through ROOT::TProcessExecutor
+ROOT::RDF::Experimental::RunDistributed(backend, h);
+~~~
+Backends for other transports, e.g. remote workers, can be plugged in by implementing
+ROOT::RDF::Experimental::RDistributedBackend: each remote worker builds the same computation graph and calls
+ROOT::RDF::Experimental::RunDistributedTask.
+
 \anchor transformations
 ## Transformations
 \anchor Filters
@@ -807,6 +833,19 @@ See [Efficient analysis in Python](#python) for possible ways to speed up hot pa
 
 Just-in-time compilation happens once, right before starting an event loop. To reduce the runtime cost of this step, make sure to book all operations *for all RDataFrame computation graphs*
 before the first event loop is triggered: just-in-time compilation will happen once for all code required to be generated up to that point, also across different computation graphs.
+The generated code is compiled with the default optimization level of the interpreter: ROOT::RDF::Experimental::SetJitOptimizationLevel can be used to
+trade a longer compilation for faster string-based transformations and actions, e.g. for long-running Python applications.
+Graphs built programmatically often book the same string-based Define or Filter several times on the same node, once per
+branch: ROOT::RDF::Experimental::EnableJitNodeSharing lets such identical nodes be a single one, evaluated once per entry.
+
+Within a process, the code is only compiled once for computation graphs that are built in the same way, e.g. for
+several datasets: building the nodes of the second graph then requires no compilation at all, and the string expressions
+are compiled once per distinct expression in any case. The just-in-time compiled code is not cached across processes: it
+can use any code declared to the interpreter, so it is compiled anew by every application. Many short jobs that run the same analysis (e.g. on a batch system or on the grid) can avoid paying this cost
+at startup by moving the expressions into C++ functions compiled in a shared library (for instance with ACLiC,
+`gSystem->CompileMacro("myFunctions.C", "k")`, which only recompiles the library if the source changed) and by passing
+these functions to the templated versions of Filter, Define and of the actions, which do not require just-in-time
+compilation.
 
 Also make sure not to count the just-in-time compilation time (which happens once before the event loop and does not depend on the size of the dataset) as part of the event loop runtime (which scales with the size of the dataset). RDataFrame has an experimental logging feature that simplifies measuring the time spent in just-in-time compilation and in the event loop (as well as providing some more interesting information). It is activated like follows:
 ~~~{.cpp}
@@ -815,6 +854,52 @@ Also make sure not to count the just-in-time compilation time (which happens onc
 auto verbosity = ROOT::Experimental::RLogScopedVerbosity(ROOT::Detail::RDF::RDFLogChannel(), ROOT::Experimental::ELogLevel::kInfo);
 ~~~
 
+\anchor rdf-profiling
+### Profiling the computation graph
+
+To find out which Defines, Filters and actions are expensive, profiling of the computation graph can be enabled with
+RDataFrame::EnableProfiling. During the following event loops, each node then records the time spent in it and the number
+of entries it processes, per processing slot, and counts the values it reads from the dataset for each input column,
+together with their estimated size in memory. The time of a node does not include the time spent in the Defines it
+depends on, nor the time spent in the Filters upstream, which are accounted for separately. RDataFrame::GetProfileReport
+returns the results, and ROOT::RDF::SaveGraph annotates the nodes with the time spent and the entries processed:
+~~~{.cpp}
+ROOT::RDataFrame df("tree", "file.root");
+df.EnableProfiling();
+auto h = df.Define("pt", [](float px, float py) { return std::sqrt(px * px + py * py); }, {"px", "py"})
+           .Filter([](float pt) { return pt > 10.f; }, {"pt"}, "ptCut")
+           .Histo1D<float>("pt");
+h->Draw();
+df.GetProfileReport().Print(); // the most time-consuming nodes are printed first
+ROOT::RDF::SaveGraph(df, "profiled_graph.dot");
+~~~
+Profiling adds the cost of reading a clock twice per node and per entry, so it should be disabled when not needed.
+In multi-thread runs, the time of a node is summed over all processing slots.
+
+\anchor rdf-batched-execution
+### Batched execution
+
+By default, each entry goes through the whole computation graph before the next entry is read. With the experimental
+RDataFrame::SetBatchSize, the event loop instead collects a number of entries in a batch and each node of the graph
+processes all entries of the batch at once: filters compute a selection mask for the batch, Defines compute their values
+for all the selected entries in a tight loop and actions run over the selected entries. This improves data locality for
+graphs with long chains of cheap Defines and Filters:
+~~~{.cpp}
+ROOT::RDataFrame df("tree", "file.root");
+df.SetBatchSize(256);
+auto h = df.Define("pt", [](float px, float py) { return std::sqrt(px * px + py * py); }, {"px", "py"})
+           .Filter([](float pt) { return pt > 10.f; }, {"pt"})
+           .Histo1D<float>("pt");
+~~~
+A Define whose callable is a ROOT::RDF::Experimental::RBatchFunction computes the values of all the selected entries
+of a batch with a single call, on contiguous arrays of its input values. This is how vectorized functions, e.g. the ones
+created with `ROOT.Numba.Declare(..., vectorize=True)` in Python, are fed a whole batch at a time.
+The values of the columns read from the dataset are copied into the batch, so their types must be default-constructible
+and copy-assignable. Event loops that include actions which require the entries to be processed one by one, such as
+Snapshot, fall back to the default execution. Note that in batched execution actions run one after the other over each
+batch rather than interleaved entry by entry, and that after a Range has reached its end the filters upstream of it may
+still be evaluated (and counted in cutflow reports) for the remaining entries of the last batch.
+
 ### Memory usage
 
 There are two reasons why RDataFrame may consume more memory than expected. Firstly, each result is duplicated for each worker thread, which e.g. in case of many (possibly multi-dimensional) histograms with fine binning can result in visible memory consumption during the event loop. The thread-local copies of the results are destroyed when the final result is produced.
@@ -1038,6 +1123,11 @@ auto filteredEvents =
 auto h = filteredEvents.Histo1D("m");
 h->Draw();
 ~~~
+Parquet files are read by ROOT::RDF::RParquetDS (requires ROOT to be built with arrow and Parquet), one row group per
+task. Row groups whose column statistics exclude a range of values can be skipped before they are read:
+~~~{.cpp}
+auto df = ROOT::RDF::MakeParquetDataFrame("events.parquet", {"pt", "eta"}, {{"pt", 20., 1000.}});
+~~~
 
 \anchor callgraphs
 ### Call graphs (storing and reusing sets of transformations)
@@ -1185,6 +1275,57 @@ RDataFrame::RDataFrame(std::string_view treeName, const std::vector<std::string>
    GetProxiedPtr()->SetTree(chain);
 }
 
+////////////////////////////////////////////////////////////////////////////
+/// \brief Build the dataframe, processing only the entries of an entry list.
+/// \param[in] treeName Name of the tree contained in the directory
+/// \param[in] fileglobs Collection of file names of filename globs
+/// \param[in] entryList The entries to process, copied by the dataframe. If null, all entries are processed.
+/// \param[in] defaultBranches Collection of default branches.
+///
+/// The entry list either holds the global entry numbers of the chain of the files, or it has a sub-list per file (see
+/// TEntryList::AddSubList). In the latter case the files without entries in the list are left out of the chain: they
+/// are never opened. In both cases the event loop only reads the clusters of the files that contain selected entries,
+/// in multi-thread runs only these clusters are processed by tasks.
+///
+/// The filename globs support the same type of expressions as TChain::Add(), and each glob is passed as-is
+/// to TChain's constructor.
+///
+/// The default branches are looked at in case no branch is specified in the booking of actions or transformations.
+/// See ROOT::RDF::RInterface for the documentation of the methods available.
+RDataFrame::RDataFrame(std::string_view treeName, const std::vector<std::string> &fileglobs,
+                       TEntryList *entryList, const ColumnNames_t &defaultBranches)
+   : RInterface(std::make_shared<RDFDetail::RLoopManager>(nullptr, defaultBranches))
+{
+   std::string treeNameInt(treeName);
+   auto chain = std::make_shared<TChain>(treeNameInt.c_str());
+   for (auto &f : fileglobs)
+      chain->Add(f.c_str());
+   if (entryList == nullptr) {
+      GetProxiedPtr()->SetTree(chain);
+      return;
+   }
+
+   std::unique_ptr<TEntryList> entries;
+   if (entryList->GetLists() == nullptr) {
+      entries = std::make_unique<TEntryList>(*entryList);
+   } else {
+      // keep the files with entries in the list, and their sub-lists, which are matched as TChain::SetEntryList does
+      auto selectedChain = std::make_shared<TChain>(treeNameInt.c_str());
+      entries = std::make_unique<TEntryList>();
+      for (auto *obj : *chain->GetListOfFiles()) {
+         auto *element = static_cast<TChainElement *>(obj);
+         auto *subList = entryList->GetEntryList(element->GetName(), element->GetTitle());
+         if (subList == nullptr || subList->GetN() == 0)
+            continue;
+         selectedChain->AddFile(element->GetTitle(), element->GetEntries(), element->GetName());
+         entries->AddSubList(subList);
+      }
+      chain = selectedChain;
+   }
+   GetProxiedPtr()->SetTree(chain);
+   GetProxiedPtr()->SetEntryList(std::move(entries));
+}
+
 ////////////////////////////////////////////////////////////////////////////
 /// \brief Build the dataframe.
 /// \param[in] tree The tree or chain to be studied.
@@ -1224,6 +1365,38 @@ RDataFrame::RDataFrame(std::unique_ptr<ROOT::RDF::RDataSource> ds, const ColumnN
 {
 }
 
+//////////////////////////////////////////////////////////////////////////
+/// \brief Process the entries of the dataset in batches (experimental).
+/// \param[in] batchSize The number of entries processed together by the computation graph. 0 and 1 disable batching.
+///
+/// In batched execution each node of the computation graph processes a batch of entries at once, see
+/// [Batched execution](\ref rdf-batched-execution). The setting applies to all following event loops of this dataframe.
+void RDataFrame::SetBatchSize(unsigned int batchSize)
+{
+   GetLoopManager()->SetBatchSize(batchSize);
+}
+
+//////////////////////////////////////////////////////////////////////////
+/// \brief Record the time spent by each node of the computation graph in the following event loops.
+/// \param[in] enable Whether the following event loops are profiled.
+///
+/// Each Define, Filter and action records the time it spends and the number of entries it processes, per processing
+/// slot, as well as the number of values it reads from the dataset for each input column. The counters accumulate over
+/// all event loops run with profiling enabled. See [Profiling the computation graph](\ref rdf-profiling).
+void RDataFrame::EnableProfiling(bool enable)
+{
+   GetLoopManager()->EnableProfiling(enable);
+}
+
+//////////////////////////////////////////////////////////////////////////
+/// \brief Return the time spent and the entries processed by each node of the computation graph.
+///
+/// Only the event loops run with profiling enabled are accounted for, see EnableProfiling.
+ROOT::RDF::RProfileReport RDataFrame::GetProfileReport()
+{
+   return GetLoopManager()->GetProfileReport();
+}
+
 } // namespace ROOT
 
 namespace cling {
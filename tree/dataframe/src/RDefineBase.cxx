@@ -9,13 +9,15 @@
  *************************************************************************/
 
 #include "ROOT/RDF/RDefineBase.hxx"
+#include "ROOT/RDF/RLoopManager.hxx"
 #include "ROOT/RDF/Utils.hxx"
 #include "ROOT/RStringView.hxx"
 #include "RtypesCore.h" // Long64_t
 
+#include <atomic>
+#include <stdexcept>
 #include <string>
 #include <vector>
-#include <atomic>
 
 using ROOT::Detail::RDF::RDefineBase;
 namespace RDFInternal = ROOT::Internal::RDF;
@@ -26,12 +28,12 @@ unsigned int RDefineBase::GetNextID()
    return ++id;
 }
 
-RDefineBase::RDefineBase(std::string_view name, std::string_view type, unsigned int nSlots,
-                         const RDFInternal::RBookedDefines &defines,
-                         const std::map<std::string, std::vector<void *>> &DSValuePtrs, ROOT::RDF::RDataSource *ds)
-   : fName(name), fType(type), fNSlots(nSlots),
+RDefineBase::RDefineBase(std::string_view name, std::string_view type, const RDFInternal::RBookedDefines &defines,
+                         RLoopManager &lm)
+   : fName(name), fType(type), fNSlots(lm.GetNSlots()),
      fLastCheckedEntry(fNSlots * RDFInternal::CacheLineStep<Long64_t>(), -1), fDefines(defines),
-     fIsInitialized(nSlots, false), fDSValuePtrs(DSValuePtrs), fDataSource(ds)
+     fIsInitialized(fNSlots, false), fDSValuePtrs(lm.GetDSValuePtrs()), fDataSource(lm.GetDataSource()),
+     fLoopManager(&lm), fProfile(fNSlots, "Define", std::string(name))
 {
 }
 
@@ -47,3 +49,34 @@ std::string RDefineBase::GetTypeName() const
 {
    return fType;
 }
+
+std::shared_ptr<RDefineBase> RDefineBase::GetVariedDefine(const RDFInternal::RVariationKey &key)
+{
+   auto &varied = fVariedDefines[key.GetName()];
+   if (varied == nullptr)
+      varied = MakeVariedDefine(fDefines.GetVaried(key));
+   return varied;
+}
+
+std::shared_ptr<RDefineBase>
+RDefineBase::GetTagDefine(std::size_t tagIdx, const std::string &colName, const RDFInternal::RBookedDefines &defines)
+{
+   auto &cached = fTagDefines[colName + ":" + std::to_string(tagIdx)];
+   auto tagDefine = cached.lock();
+   if (tagDefine == nullptr) {
+      tagDefine = MakeTagDefine(tagIdx, colName, defines);
+      cached = tagDefine;
+   }
+   return tagDefine;
+}
+
+std::shared_ptr<RDefineBase> RDefineBase::MakeVariedDefine(const RDFInternal::RBookedDefines &)
+{
+   throw std::logic_error("Define \"" + fName + "\" does not support systematic variations.");
+}
+
+std::shared_ptr<RDefineBase>
+RDefineBase::MakeTagDefine(std::size_t, const std::string &, const RDFInternal::RBookedDefines &)
+{
+   throw std::logic_error("Define \"" + fName + "\" does not compute varied values.");
+}
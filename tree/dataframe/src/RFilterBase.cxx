@@ -10,6 +10,7 @@
 
 #include "ROOT/RDF/RCutFlowReport.hxx"
 #include "ROOT/RDF/RFilterBase.hxx"
+#include "ROOT/RDF/RLoopManager.hxx"
 #include "ROOT/RDF/Utils.hxx"
 #include <numeric> // std::accumulate
 
@@ -19,7 +20,8 @@ RFilterBase::RFilterBase(RLoopManager *implPtr, std::string_view name, const uns
                          const RDFInternal::RBookedDefines &defines)
    : RNodeBase(implPtr), fLastResult(nSlots * RDFInternal::CacheLineStep<int>()),
      fAccepted(nSlots * RDFInternal::CacheLineStep<ULong64_t>()),
-     fRejected(nSlots * RDFInternal::CacheLineStep<ULong64_t>()), fName(name), fNSlots(nSlots), fDefines(defines)
+     fRejected(nSlots * RDFInternal::CacheLineStep<ULong64_t>()), fName(name), fNSlots(nSlots), fDefines(defines),
+     fProfile(nSlots, "Filter", name.empty() ? "Filter" : std::string(name))
 {
 }
 
@@ -48,6 +50,23 @@ void RFilterBase::FillReport(ROOT::RDF::RCutFlowReport &rep) const
 void RFilterBase::InitNode()
 {
    fLastCheckedEntry = std::vector<Long64_t>(fNSlots * RDFInternal::CacheLineStep<Long64_t>(), -1);
+   fBatchMasks = std::vector<std::vector<char>>(fNSlots);
+   fLastCheckedBatch = std::vector<Long64_t>(fNSlots * RDFInternal::CacheLineStep<Long64_t>(), -1);
    if (!fName.empty()) // if this is a named filter we care about its report count
       ResetReportCount();
 }
+
+std::shared_ptr<RNodeBase> RFilterBase::GetVariedFilter(const RDFInternal::RVariationKey &key)
+{
+   const auto name = key.GetName();
+   const auto it = fVariedFilters.find(name);
+   if (it != fVariedFilters.end())
+      return it->second;
+
+   auto varied = MakeVariedFilter(key);
+   if (varied != nullptr)
+      fLoopManager->Book(varied.get());
+   std::shared_ptr<RNodeBase> variedNode = std::move(varied);
+   fVariedFilters[name] = variedNode;
+   return variedNode;
+}
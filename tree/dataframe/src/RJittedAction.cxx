@@ -26,6 +26,18 @@ void RJittedAction::Run(unsigned int slot, Long64_t entry)
    fConcreteAction->Run(slot, entry);
 }
 
+void RJittedAction::RunBatch(unsigned int slot, const ROOT::Internal::RDF::RBatch &batch)
+{
+   R__ASSERT(fConcreteAction != nullptr);
+   fConcreteAction->RunBatch(slot, batch);
+}
+
+bool RJittedAction::SupportsBatchedExecution() const
+{
+   R__ASSERT(fConcreteAction != nullptr);
+   return fConcreteAction->SupportsBatchedExecution();
+}
+
 void RJittedAction::Initialize()
 {
    R__ASSERT(fConcreteAction != nullptr);
@@ -78,6 +90,17 @@ void RJittedAction::SetHasRun()
    return fConcreteAction->SetHasRun();
 }
 
+ROOT::Internal::RDF::RBookedDefines &RJittedAction::GetDefines()
+{
+   return fConcreteAction != nullptr ? fConcreteAction->GetDefines() : RActionBase::GetDefines();
+}
+
+const ROOT::Internal::RDF::RNodeProfile &RJittedAction::GetProfile() const
+{
+   // if the action has not been jitted, it has not run
+   return fConcreteAction != nullptr ? fConcreteAction->GetProfile() : fProfile;
+}
+
 std::shared_ptr<ROOT::Internal::RDF::GraphDrawing::GraphNode> RJittedAction::GetGraph()
 {
    R__ASSERT(fConcreteAction != nullptr);
@@ -99,3 +122,15 @@ std::function<void(unsigned int)> RJittedAction::GetDataBlockCallback()
    R__ASSERT(fConcreteAction != nullptr);
    return fConcreteAction->GetDataBlockCallback();
 }
+
+std::vector<std::string> RJittedAction::GetVariationKeys() const
+{
+   R__ASSERT(fConcreteAction != nullptr);
+   return fConcreteAction->GetVariationKeys();
+}
+
+std::unique_ptr<ROOT::Internal::RDF::RActionBase> RJittedAction::MakeVariedAction(std::vector<void *> &&results)
+{
+   R__ASSERT(fConcreteAction != nullptr);
+   return fConcreteAction->MakeVariedAction(std::move(results));
+}
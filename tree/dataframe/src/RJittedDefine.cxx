@@ -37,8 +37,40 @@ void RJittedDefine::Update(unsigned int slot, Long64_t entry)
    fConcreteDefine->Update(slot, entry);
 }
 
+void RJittedDefine::UpdateBatch(unsigned int slot, const ROOT::Internal::RDF::RBatch &batch,
+                                const std::vector<char> &mask)
+{
+   R__ASSERT(fConcreteDefine != nullptr);
+   fConcreteDefine->UpdateBatch(slot, batch, mask);
+}
+
+void *RJittedDefine::GetBatchValuePtr(unsigned int slot, std::size_t idx)
+{
+   R__ASSERT(fConcreteDefine != nullptr);
+   return fConcreteDefine->GetBatchValuePtr(slot, idx);
+}
+
 void RJittedDefine::FinaliseSlot(unsigned int slot)
 {
    R__ASSERT(fConcreteDefine != nullptr);
    fConcreteDefine->FinaliseSlot(slot);
 }
+
+const RDFInternal::RNodeProfile &RJittedDefine::GetProfile() const
+{
+   // if the Define has not been jitted, it has not run
+   return fConcreteDefine != nullptr ? fConcreteDefine->GetProfile() : fProfile;
+}
+
+std::shared_ptr<RDefineBase> RJittedDefine::GetVariedDefine(const RDFInternal::RVariationKey &key)
+{
+   R__ASSERT(fConcreteDefine != nullptr);
+   return fConcreteDefine->GetVariedDefine(key);
+}
+
+std::shared_ptr<RDefineBase>
+RJittedDefine::MakeTagDefine(std::size_t tagIdx, const std::string &colName, const RDFInternal::RBookedDefines &defines)
+{
+   R__ASSERT(fConcreteDefine != nullptr);
+   return fConcreteDefine->GetTagDefine(tagIdx, colName, defines);
+}
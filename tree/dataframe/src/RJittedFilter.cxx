@@ -35,6 +35,12 @@ bool RJittedFilter::CheckFilters(unsigned int slot, Long64_t entry)
    return fConcreteFilter->CheckFilters(slot, entry);
 }
 
+const std::vector<char> &RJittedFilter::CheckFiltersBatch(unsigned int slot, const ROOT::Internal::RDF::RBatch &batch)
+{
+   R__ASSERT(fConcreteFilter != nullptr);
+   return fConcreteFilter->CheckFiltersBatch(slot, batch);
+}
+
 void RJittedFilter::Report(ROOT::RDF::RCutFlowReport &cr) const
 {
    R__ASSERT(fConcreteFilter != nullptr);
@@ -89,6 +95,12 @@ void RJittedFilter::FinaliseSlot(unsigned int slot)
    fConcreteFilter->FinaliseSlot(slot);
 }
 
+const RDFInternal::RNodeProfile &RJittedFilter::GetProfile() const
+{
+   // if the filter has not been jitted, it has not run
+   return fConcreteFilter != nullptr ? fConcreteFilter->GetProfile() : fProfile;
+}
+
 void RJittedFilter::InitNode()
 {
    R__ASSERT(fConcreteFilter != nullptr);
@@ -112,3 +124,15 @@ std::shared_ptr<RDFGraphDrawing::GraphNode> RJittedFilter::GetGraph()
    }
    throw std::runtime_error("The Jitting should have been invoked before this method.");
 }
+
+std::unique_ptr<RFilterBase> RJittedFilter::MakeVariedFilter(const RDFInternal::RVariationKey &key)
+{
+   R__ASSERT(fConcreteFilter != nullptr);
+   auto concreteVaried = fConcreteFilter->MakeVariedFilter(key);
+   if (concreteVaried == nullptr)
+      return nullptr;
+   // the varied copy of a jitted filter is a jitted filter too, as expected by the nodes downstream
+   std::unique_ptr<RJittedFilter> varied(new RJittedFilter(fLoopManager, ""));
+   varied->SetFilter(std::move(concreteVaried));
+   return varied;
+}
@@ -10,11 +10,14 @@
 #include "ROOT/RDataSource.hxx"
 #include "ROOT/RDF/GraphNode.hxx"
 #include "ROOT/RDF/RActionBase.hxx"
+#include "ROOT/RDF/RDefineBase.hxx"
 #include "ROOT/RDF/RFilterBase.hxx"
+#include "ROOT/RDF/RProfileReport.hxx"
 #include "ROOT/RDF/RLoopManager.hxx"
 #include "ROOT/RDF/RRangeBase.hxx"
 #include "ROOT/RDF/RSlotStack.hxx"
 #include "ROOT/RLogger.hxx"
+#include "ROOT/RTrace.hxx"
 #include "RtypesCore.h" // Long64_t
 #include "TStopwatch.h"
 #include "TBranchElement.h"
@@ -36,6 +39,7 @@
 #include <algorithm>
 #include <atomic>
 #include <cassert>
+#include <cctype>
 #include <exception>
 #include <functional>
 #include <iostream>
@@ -58,12 +62,55 @@ namespace {
 /// We want RLoopManagers to be able to add their code to a global "code to execute via cling",
 /// so that, lazily, we can jit everything that's needed by all RDFs in one go, which is potentially
 /// much faster than jitting each RLoopManager's code separately.
-static std::string &GetCodeToJit()
+static std::vector<std::string> &GetCodeToJit()
 {
-   static std::string code;
+   static std::vector<std::string> code;
    return code;
 }
 
+using JittedCall_t = void (*)(void **);
+
+/// The functions compiled for the code jitted by RLoopManager::Jit, see FactorOutAddresses.
+/// The code of many computation graphs only differs by the addresses of their nodes, e.g. when the same graph is built
+/// for several datasets: for such graphs, the functions compiled for the first one are called with other arguments.
+static std::unordered_map<std::string, JittedCall_t> &GetJittedCalls()
+{
+   static std::unordered_map<std::string, JittedCall_t> calls;
+   return calls;
+}
+
+/// Replace the addresses in code passed to RLoopManager::ToJitExec, which always appear as the argument of a
+/// reinterpret_cast, with the elements of `args`. The addresses are appended to `addresses`.
+static std::string FactorOutAddresses(const std::string &code, std::vector<void *> &addresses)
+{
+   std::string generic;
+   generic.reserve(code.size());
+   bool inString = false;
+   for (std::size_t i = 0u; i < code.size(); ++i) {
+      const char c = code[i];
+      if (inString) {
+         if (c == '\\' && i + 1 < code.size())
+            generic += code[i++];
+         else if (c == '"')
+            inString = false;
+      } else if (c == '"') {
+         inString = true;
+      } else if (c == '>' && code.compare(i, 4, ">(0x") == 0) {
+         auto end = i + 4;
+         while (end < code.size() && std::isxdigit(static_cast<unsigned char>(code[end])))
+            ++end;
+         if (end < code.size() && code[end] == ')' && end > i + 4) {
+            addresses.emplace_back(reinterpret_cast<void *>(std::stoull(code.substr(i + 2, end - i - 2), nullptr, 16)));
+            generic += ">(args[" + std::to_string(addresses.size() - 1) + "])";
+            i = end;
+            continue;
+         }
+      }
+      generic += code[i];
+   }
+   return generic;
+}
+
 static bool ContainsLeaf(const std::set<TLeaf *> &leaves, TLeaf *leaf)
 {
    return (leaves.find(leaf) != leaves.end());
@@ -298,6 +345,38 @@ DatasetLogInfo TreeDatasetLogInfo(const TTreeReader &r, unsigned int slot)
    return {std::move(what), static_cast<ULong64_t>(entryRange.first), end, slot};
 }
 
+/// The batches of a TTreeReader task move the reader back to the entries of the batch to read their columns.
+/// The last entry of the entry range of the reader also ends a data block: the TTreeReader loads the entry after the
+/// end of the range, possibly from the next file, before reporting that the range is over.
+class RTreeReaderBatchSource final : public RBatchSource {
+   TTreeReader &fReader;
+
+public:
+   explicit RTreeReaderBatchSource(TTreeReader &r) : fReader(r) {}
+   Long64_t GetPosition() final { return fReader.GetCurrentEntry(); }
+   void SetPosition(Long64_t position) final { fReader.SetEntry(position); }
+   bool IsLastOfDataBlock() final
+   {
+      const auto end = fReader.GetEntriesRange().second;
+      if (end >= 0 && fReader.GetCurrentEntry() == end - 1)
+         return true;
+      auto *localTree = fReader.GetTree()->GetTree();
+      return localTree != nullptr && localTree->GetReadEntry() == localTree->GetEntriesFast() - 1;
+   }
+};
+
+/// Whether the entries of a batch can be read again after the reader moved past them: this is not the case if the
+/// reader loads friend trees, which switch files independently of the main tree, or iterates over an entry list,
+/// whose entries do not tell when the end of a tree is reached.
+bool CanReadBatchLazily(TTreeReader &r)
+{
+   auto *tree = r.GetTree();
+   auto hasFriends = [](TTree *t) {
+      return t != nullptr && t->GetListOfFriends() != nullptr && t->GetListOfFriends()->GetEntries() > 0;
+   };
+   return r.GetEntryList() == nullptr && !hasFriends(tree) && !hasFriends(tree->GetTree());
+}
+
 } // anonymous namespace
 
 namespace ROOT {
@@ -355,6 +434,33 @@ RLoopManager::RLoopManager(std::unique_ptr<RDataSource> ds, const ColumnNames_t
    fDataSource->SetNSlots(fNSlots);
 }
 
+RLoopManager::~RLoopManager()
+{
+   // the tree could outlive this loop manager, e.g. if it was retrieved with GetTree
+   if (fEntryList && fTree && fTree->GetEntryList() == fEntryList.get())
+      fTree->SetEntryList(nullptr);
+}
+
+/// Restrict the event loops to the entries of the list, which the loop manager takes ownership of.
+/// A list with sub-lists is associated to the tree, which sets the tree numbers of the sub-lists; otherwise the list
+/// holds the global entry numbers of the tree or chain, and it is just passed to TTreeReader or TTreeProcessorMT.
+void RLoopManager::SetEntryList(std::unique_ptr<TEntryList> entryList)
+{
+   fEntryList = std::move(entryList);
+   if (fEntryList && fEntryList->GetLists() != nullptr && fTree->GetEntriesFast() > 0) {
+      fTree->SetEntryList(fEntryList.get());
+      fEntryList->ResetBit(TObject::kCanDelete); // we retain ownership
+   }
+}
+
+/// Return the entry list the event loops are restricted to, i.e. the one of SetEntryList or else the one of the tree
+TEntryList *RLoopManager::GetEntryList() const
+{
+   if (fEntryList)
+      return fEntryList.get();
+   return fTree ? fTree->GetEntryList() : nullptr;
+}
+
 struct RSlotRAII {
    RSlotStack &fSlotStack;
    unsigned int fSlot;
@@ -369,11 +475,14 @@ void RLoopManager::RunEmptySourceMT()
    RSlotStack slotStack(fNSlots);
    // Working with an empty tree.
    // Evenly partition the entries according to fNSlots. Produce around 2 tasks per slot.
-   const auto nEntriesPerSlot = fNEmptyEntries / (fNSlots * 2);
-   auto remainder = fNEmptyEntries % (fNSlots * 2);
+   const auto loopRange = GetLoopEntryRange();
+   const auto loopEnd = std::min(fNEmptyEntries, loopRange.second);
+   const auto nEntries = loopEnd > loopRange.first ? loopEnd - loopRange.first : 0ull;
+   const auto nEntriesPerSlot = nEntries / (fNSlots * 2);
+   auto remainder = nEntries % (fNSlots * 2);
    std::vector<std::pair<ULong64_t, ULong64_t>> entryRanges;
-   ULong64_t start = 0;
-   while (start < fNEmptyEntries) {
+   ULong64_t start = loopRange.first;
+   while (start < loopEnd) {
       ULong64_t end = start + nEntriesPerSlot;
       if (remainder > 0) {
          ++end;
@@ -387,13 +496,15 @@ void RLoopManager::RunEmptySourceMT()
    auto genFunction = [this, &slotStack](const std::pair<ULong64_t, ULong64_t> &range) {
       RSlotRAII slotRAII(slotStack);
       auto slot = slotRAII.fSlot;
+      R__TRACE_SPAN("rdf", "RDataFrame task", slot);
       RCallCleanUpTask cleanup(*this, slot);
       InitNodeSlots(nullptr, slot);
       R__LOG_INFO(RDFLogChannel()) << LogRangeProcessing({"an empty source", range.first, range.second, slot});
       try {
          for (auto currEntry = range.first; currEntry < range.second; ++currEntry) {
-            RunAndCheckFilters(slot, currEntry);
+            ProcessEntry(slot, currEntry);
          }
+         ProcessBatch(slot);
       } catch (...) {
          // Error might throw in experiment frameworks like CMSSW
          std::cerr << "RDataFrame::Run: event loop was interrupted\n";
@@ -411,12 +522,14 @@ void RLoopManager::RunEmptySourceMT()
 void RLoopManager::RunEmptySource()
 {
    InitNodeSlots(nullptr, 0);
-   R__LOG_INFO(RDFLogChannel()) << LogRangeProcessing({"an empty source", 0, fNEmptyEntries, 0u});
+   const auto end = std::min(fNEmptyEntries, fEntryRange.second);
+   R__LOG_INFO(RDFLogChannel()) << LogRangeProcessing({"an empty source", fEntryRange.first, end, 0u});
    RCallCleanUpTask cleanup(*this);
    try {
-      for (ULong64_t currEntry = 0; currEntry < fNEmptyEntries && fNStopsReceived < fNChildren; ++currEntry) {
-         RunAndCheckFilters(0, currEntry);
+      for (ULong64_t currEntry = fEntryRange.first; currEntry < end && fNStopsReceived < fNChildren; ++currEntry) {
+         ProcessEntry(0, currEntry);
       }
+      ProcessBatch(0);
    } catch (...) {
       std::cerr << "RDataFrame::Run: event loop was interrupted\n";
       throw;
@@ -427,15 +540,28 @@ void RLoopManager::RunEmptySource()
 void RLoopManager::RunTreeProcessorMT()
 {
 #ifdef R__USE_IMT
+   if (0 == fTree->GetEntriesFast())
+      return; // e.g. none of the files of the chain has entries in the list passed to RDataFrame's ctor
    RSlotStack slotStack(fNSlots);
-   const auto &entryList = fTree->GetEntryList() ? *fTree->GetEntryList() : TEntryList();
+   const auto &entryList = GetEntryList() ? *GetEntryList() : TEntryList();
    auto tp = std::make_unique<ROOT::TTreeProcessorMT>(*fTree, entryList, fNSlots);
+   // The ranges of the computation graph need the actual entry numbers, which TTreeProcessorMT only provides when it
+   // processes an entry range. Otherwise the entries are just counted.
+   const bool useEntryNumbers = HasEntryRange() || HasEntryNumberRanges();
+   if (useEntryNumbers) {
+      const auto loopRange = GetLoopEntryRange();
+      const auto end = loopRange.second == std::numeric_limits<ULong64_t>::max()
+                          ? std::numeric_limits<Long64_t>::max()
+                          : Long64_t(loopRange.second);
+      tp->SetEntryRange(loopRange.first, end);
+   }
 
    std::atomic<ULong64_t> entryCount(0ull);
 
-   tp->Process([this, &slotStack, &entryCount](TTreeReader &r) -> void {
+   tp->Process([this, &slotStack, &entryCount, useEntryNumbers](TTreeReader &r) -> void {
       RSlotRAII slotRAII(slotStack);
       auto slot = slotRAII.fSlot;
+      R__TRACE_SPAN("rdf", "RDataFrame task", slot);
       RCallCleanUpTask cleanup(*this, slot, &r);
       InitNodeSlots(&r, slot);
       R__LOG_INFO(RDFLogChannel()) << LogRangeProcessing(TreeDatasetLogInfo(r, slot));
@@ -445,8 +571,9 @@ void RLoopManager::RunTreeProcessorMT()
       try {
          // recursive call to check filters and conditionally execute actions
          while (r.Next()) {
-            RunAndCheckFilters(slot, count++);
+            ProcessEntry(slot, useEntryNumbers ? r.GetCurrentEntry() : count++);
          }
+         ProcessBatch(slot);
       } catch (...) {
          std::cerr << "RDataFrame::Run: event loop was interrupted\n";
          throw;
@@ -465,9 +592,13 @@ void RLoopManager::RunTreeProcessorMT()
 /// Run event loop over one or multiple ROOT files, in sequence.
 void RLoopManager::RunTreeReader()
 {
-   TTreeReader r(fTree.get(), fTree->GetEntryList());
+   TTreeReader r(fTree.get(), GetEntryList());
    if (0 == fTree->GetEntriesFast())
       return;
+   if (HasEntryRange()) {
+      const auto end = fEntryRange.second == std::numeric_limits<ULong64_t>::max() ? -1ll : Long64_t(fEntryRange.second);
+      r.SetEntriesRange(fEntryRange.first, end);
+   }
    RCallCleanUpTask cleanup(*this, 0u, &r);
    InitNodeSlots(&r, 0);
    R__LOG_INFO(RDFLogChannel()) << LogRangeProcessing(TreeDatasetLogInfo(r, 0u));
@@ -476,8 +607,9 @@ void RLoopManager::RunTreeReader()
    // in the non-MT case processing can be stopped early by ranges, hence the check on fNStopsReceived
    try {
       while (r.Next() && fNStopsReceived < fNChildren) {
-         RunAndCheckFilters(0, r.GetCurrentEntry());
+         ProcessEntry(0, r.GetCurrentEntry());
       }
+      ProcessBatch(0);
    } catch (...) {
       std::cerr << "RDataFrame::Run: event loop was interrupted\n";
       throw;
@@ -501,15 +633,18 @@ void RLoopManager::RunDataSource()
       RCallCleanUpTask cleanup(*this);
       try {
          for (const auto &range : ranges) {
-            const auto start = range.first;
-            const auto end = range.second;
+            const auto start = std::max(range.first, fEntryRange.first);
+            const auto end = std::min(range.second, fEntryRange.second);
+            if (start >= end)
+               continue;
             R__LOG_INFO(RDFLogChannel()) << LogRangeProcessing({fDataSource->GetLabel(), start, end, 0u});
             for (auto entry = start; entry < end && fNStopsReceived < fNChildren; ++entry) {
                if (fDataSource->SetEntry(0u, entry)) {
-                  RunAndCheckFilters(0u, entry);
+                  ProcessEntry(0u, entry);
                }
             }
          }
+         ProcessBatch(0u);
       } catch (...) {
          std::cerr << "RDataFrame::Run: event loop was interrupted\n";
          throw;
@@ -529,21 +664,24 @@ void RLoopManager::RunDataSourceMT()
    ROOT::TThreadExecutor pool;
 
    // Each task works on a subrange of entries
-   auto runOnRange = [this, &slotStack](const std::pair<ULong64_t, ULong64_t> &range) {
+   const auto loopRange = GetLoopEntryRange();
+   auto runOnRange = [this, &slotStack, &loopRange](const std::pair<ULong64_t, ULong64_t> &range) {
       RSlotRAII slotRAII(slotStack);
       const auto slot = slotRAII.fSlot;
+      R__TRACE_SPAN("rdf", "RDataFrame task", slot);
       InitNodeSlots(nullptr, slot);
       RCallCleanUpTask cleanup(*this, slot);
       fDataSource->InitSlot(slot, range.first);
-      const auto start = range.first;
-      const auto end = range.second;
+      const auto start = std::max(range.first, loopRange.first);
+      const auto end = std::min(range.second, loopRange.second);
       R__LOG_INFO(RDFLogChannel()) << LogRangeProcessing({fDataSource->GetLabel(), start, end, slot});
       try {
          for (auto entry = start; entry < end; ++entry) {
             if (fDataSource->SetEntry(slot, entry)) {
-               RunAndCheckFilters(slot, entry);
+               ProcessEntry(slot, entry);
             }
          }
+         ProcessBatch(slot);
       } catch (...) {
          std::cerr << "RDataFrame::Run: event loop was interrupted\n";
          throw;
@@ -581,12 +719,84 @@ void RLoopManager::RunAndCheckFilters(unsigned int slot, Long64_t entry)
       callback(slot);
 }
 
+/// Process an entry of the dataset. In batched execution the entry is added to the batch of the slot, and the
+/// computation graph runs on the batch when it is full or at the end of each TTree.
+void RLoopManager::ProcessEntry(unsigned int slot, Long64_t entry)
+{
+   if (fBatches.empty()) {
+      RunAndCheckFilters(slot, entry);
+      return;
+   }
+
+   // data-block callbacks run before the rest of the graph processes the entries of the new data block
+   if (fDataBlockNotifier.CheckFlag(slot)) {
+      ProcessBatch(slot);
+      for (auto &callback : fDataBlockCallbacks) {
+         callback(slot);
+      }
+      fDataBlockNotifier.UnsetFlag(slot);
+   }
+
+   auto &batch = *fBatches[slot];
+   batch.AddEntry(entry);
+   // the entries of a TTree cannot be read anymore once a TChain switched to the next one
+   if (batch.IsFull() || batch.IsAtEndOfDataBlock()) {
+      ProcessBatch(slot);
+      batch.Rewind();
+   }
+}
+
+/// Run the computation graph on the entries of the batch of the slot, then clear the batch.
+/// No-op if batched execution is not active or the batch is empty.
+/// As in RunAndCheckFilters, named filters are called for all entries even if the analysis logic does not require it.
+void RLoopManager::ProcessBatch(unsigned int slot)
+{
+   if (fBatches.empty() || fBatches[slot]->GetSize() == 0)
+      return;
+
+   auto &batch = *fBatches[slot];
+   for (auto &actionPtr : fBookedActions)
+      actionPtr->RunBatch(slot, batch);
+   for (auto &namedFilterPtr : fBookedNamedFilters)
+      namedFilterPtr->CheckFiltersBatch(slot, batch);
+   for (std::size_t i = 0u; i < batch.GetSize(); ++i) {
+      for (auto &callback : fCallbacks)
+         callback(slot);
+   }
+   batch.Clear();
+}
+
+/// Create one batch per slot if batched execution was requested and all booked actions support it.
+void RLoopManager::SetupBatches()
+{
+   fBatches.clear();
+   if (fBatchSize <= 1)
+      return;
+
+   for (auto *actionPtr : fBookedActions) {
+      if (!actionPtr->SupportsBatchedExecution()) {
+         R__LOG_INFO(RDFLogChannel()) << "Batched execution is not supported by some of the booked actions (e.g. "
+                                         "Snapshot): entries will be processed one by one in this event loop.";
+         return;
+      }
+   }
+
+   fBatches.reserve(fNSlots);
+   for (auto slot = 0u; slot < fNSlots; ++slot)
+      fBatches.emplace_back(new RDFInternal::RBatch(fBatchSize));
+   R__LOG_INFO(RDFLogChannel()) << "Entries will be processed in batches of " << fBatchSize << " entries.";
+}
+
 /// Build TTreeReaderValues for all nodes
 /// This method loops over all filters, actions and other booked objects and
 /// calls their `InitSlot` method, to get them ready for running a task.
 void RLoopManager::InitNodeSlots(TTreeReader *r, unsigned int slot)
 {
+   R__TRACE_SPAN("rdf", "RDataFrame InitNodeSlots", slot);
    SetupDataBlockCallbacks(r, slot);
+   // columns are read lazily in batched execution, if the batch can move the reader back to its entries
+   if (!fBatches.empty() && r != nullptr && CanReadBatchLazily(*r))
+      fBatches[slot]->SetSource(std::unique_ptr<RBatchSource>(new RTreeReaderBatchSource(*r)));
    for (auto &ptr : fBookedActions)
       ptr->InitSlot(r, slot);
    for (auto &ptr : fBookedFilters)
@@ -627,6 +837,7 @@ void RLoopManager::InitNodes()
 /// Perform clean-up operations. To be called at the end of each event loop.
 void RLoopManager::CleanUpNodes()
 {
+   R__TRACE_SPAN("rdf", "RDataFrame CleanUpNodes");
    fMustRunNamedFilters = false;
 
    // forget RActions and detach TResultProxies
@@ -647,38 +858,90 @@ void RLoopManager::CleanUpNodes()
    fCallbacks.clear();
    fCallbacksOnce.clear();
    fDataBlockCallbacks.clear();
+   fBatches.clear();
 }
 
 /// Perform clean-up operations. To be called at the end of each task execution.
 void RLoopManager::CleanUpTask(TTreeReader *r, unsigned int slot)
 {
+   R__TRACE_SPAN("rdf", "RDataFrame CleanUpTask", slot);
    if (r != nullptr)
       fDataBlockNotifier.GetChainNotifyLink(slot).RemoveLink(*r->GetTree());
    for (auto &ptr : fBookedActions)
       ptr->FinalizeSlot(slot);
    for (auto &ptr : fBookedFilters)
       ptr->FinaliseSlot(slot);
+   // the column buffers of the batch read from the TTreeReader or data source of this task
+   if (!fBatches.empty())
+      fBatches[slot]->Reset();
 }
 
 /// Add RDF nodes that require just-in-time compilation to the computation graph.
 /// This method also clears the contents of GetCodeToJit().
+///
+/// Each piece of code passed to ToJitExec becomes a function that takes the addresses in the code as arguments, see
+/// FactorOutAddresses. The functions that are not in GetJittedCalls yet are compiled in one go, then all of them are
+/// called in the order of the ToJitExec calls.
 void RLoopManager::Jit()
 {
    // TODO this should be a read lock unless we find GetCodeToJit non-empty
    R__LOCKGUARD(gROOTMutex);
 
-   const std::string code = std::move(GetCodeToJit());
+   const std::vector<std::string> code = std::move(GetCodeToJit());
+   GetCodeToJit().clear();
    if (code.empty()) {
       R__LOG_INFO(RDFLogChannel()) << "Nothing to jit and execute.";
       return;
    }
 
+   R__TRACE_SPAN("rdf", "RDataFrame jit");
    TStopwatch s;
    s.Start();
-   RDFInternal::InterpreterCalc(code, "RLoopManager::Run");
+   auto &jittedCalls = GetJittedCalls();
+   // Number of the next function to declare. It is not the size of jittedCalls: the names of functions of a failed
+   // declaration, which may still be partially known to the interpreter, must not be reused.
+   static unsigned int nextCallId = 0u;
+   const auto firstCallId = nextCallId;
+   std::vector<std::pair<std::string, std::vector<void *>>> calls(code.size());
+   std::unordered_map<std::string, unsigned int> newCalls; // code of the functions to compile, and their index
+   std::string toDeclare;
+   for (auto i = 0u; i < code.size(); ++i) {
+      calls[i].first = FactorOutAddresses(code[i], calls[i].second);
+      const auto &genericCode = calls[i].first;
+      if (jittedCalls.find(genericCode) != jittedCalls.end() || newCalls.find(genericCode) != newCalls.end())
+         continue;
+      const auto index = static_cast<unsigned int>(newCalls.size());
+      toDeclare += "void jittedcall" + std::to_string(firstCallId + index) + "(void **args)\n{\n" +
+                   genericCode + "\n;\n}\n"; // in case the code misses the final semicolon
+      newCalls.emplace(genericCode, index);
+   }
+
+   if (!newCalls.empty()) {
+      nextCallId += newCalls.size();
+      RDFInternal::InterpreterDeclare("namespace R_rdf {\n" + toDeclare + "}");
+      // retrieve the addresses of the new functions
+      std::vector<JittedCall_t> functions(newCalls.size(), nullptr);
+      std::stringstream getAddresses;
+      for (auto i = 0u; i < newCalls.size(); ++i) {
+         // Windows requires std::hex << std::showbase << (size_t)pointer to produce notation "0x1234"
+         getAddresses << "*reinterpret_cast<void (**)(void **)>(" << std::hex << std::showbase
+                      << reinterpret_cast<size_t>(&functions[i]) << std::dec << ") = &R_rdf::jittedcall"
+                      << firstCallId + i << ";\n";
+      }
+      RDFInternal::InterpreterCalc(getAddresses.str(), "RLoopManager::Run");
+      for (const auto &newCall : newCalls) {
+         R__ASSERT(functions[newCall.second] != nullptr);
+         jittedCalls[newCall.first] = functions[newCall.second];
+      }
+   }
    s.Stop();
    R__LOG_INFO(RDFLogChannel()) << "Just-in-time compilation phase completed"
-                                << (s.RealTime() > 1e-3 ? " in " + std::to_string(s.RealTime()) + " seconds." : ".");
+                                << (s.RealTime() > 1e-3 ? " in " + std::to_string(s.RealTime()) + " seconds" : "")
+                                << ", " << code.size() - newCalls.size() << " of the " << code.size()
+                                << " pieces of code were already compiled.";
+
+   for (auto &call : calls)
+      jittedCalls[call.first](call.second.data());
 }
 
 /// Trigger counting of number of children nodes for each node of the functional graph.
@@ -695,39 +958,240 @@ void RLoopManager::EvalChildrenCounts()
       namedFilterPtr->TriggerChildrenCount();
 }
 
-/// Start the event loop with a different mechanism depending on IMT/no IMT, data source/no data source.
-/// Also perform a few setup and clean-up operations (jit actions if necessary, clear booked actions after the loop...).
-void RLoopManager::Run()
+/// Return whether Ranges selecting the entries by their entry number are booked, see RRangeBase::SelectsEntryNumbers.
+bool RLoopManager::HasEntryNumberRanges() const
 {
-   // Change value of TTree::GetMaxTreeSize only for this scope. Revert when #6640 will be solved.
-   MaxTreeSizeRAII ctxtmts;
+   return std::any_of(fBookedRanges.begin(), fBookedRanges.end(),
+                      [](const RRangeBase *range) { return range->SelectsEntryNumbers(); });
+}
 
+/// Return the entries the event loop processes, [first, second): those of the entry range set by SetEntryRange,
+/// further restricted to the entries selected by the Ranges booked on this node in multi-thread event loops if all
+/// the children of this node are such Ranges. Must be called after the children counts were evaluated.
+std::pair<ULong64_t, ULong64_t> RLoopManager::GetLoopEntryRange() const
+{
+   auto loopRange = fEntryRange;
+   unsigned int nRangeChildren = 0u;
+   auto selected = std::make_pair(std::numeric_limits<ULong64_t>::max(), 0ull);
+   for (const auto *range : fBookedRanges) {
+      if (!range->SelectsEntryNumbers() || !range->HasChildren())
+         continue;
+      ++nRangeChildren;
+      const auto entries = range->GetSelectedEntries();
+      selected.first = std::min(selected.first, entries.first);
+      selected.second = std::max(selected.second, entries.second);
+   }
+   if (nRangeChildren > 0u && nRangeChildren == fNChildren) {
+      loopRange.first = std::max(loopRange.first, selected.first);
+      loopRange.second = std::max(loopRange.first, std::min(loopRange.second, selected.second));
+   }
+   return loopRange;
+}
+
+/// Perform the operations that precede the event loop: jit the graph if needed, set up the batches and initialize
+/// the nodes. Batched execution is only set up if useBatches is true.
+void RLoopManager::PrepareRun(bool useBatches)
+{
    R__LOG_INFO(RDFLogChannel()) << "Starting event loop number " << fNRuns << '.';
 
    ThrowIfNSlotsChanged(GetNSlots());
 
    Jit();
 
+   if (useBatches)
+      SetupBatches();
+   else
+      fBatches.clear();
+
    InitNodes();
+}
+
+/// Perform the operations that follow the event loop: clean up the nodes and count the run.
+void RLoopManager::FinishRun(double cpuTime, double realTime)
+{
+   CleanUpNodes();
+
+   fNRuns++;
+
+   R__LOG_INFO(RDFLogChannel()) << "Finished event loop number " << fNRuns - 1 << " (" << cpuTime << "s CPU, "
+                                << realTime << "s elapsed).";
+}
+
+/// Start the event loop with a different mechanism depending on IMT/no IMT, data source/no data source.
+/// Also perform a few setup and clean-up operations (jit actions if necessary, clear booked actions after the loop...).
+void RLoopManager::Run()
+{
+   // Change value of TTree::GetMaxTreeSize only for this scope. Revert when #6640 will be solved.
+   MaxTreeSizeRAII ctxtmts;
+
+   PrepareRun(true);
 
    TStopwatch s;
    s.Start();
-   switch (fLoopType) {
-   case ELoopType::kNoFilesMT: RunEmptySourceMT(); break;
-   case ELoopType::kROOTFilesMT: RunTreeProcessorMT(); break;
-   case ELoopType::kDataSourceMT: RunDataSourceMT(); break;
-   case ELoopType::kNoFiles: RunEmptySource(); break;
-   case ELoopType::kROOTFiles: RunTreeReader(); break;
-   case ELoopType::kDataSource: RunDataSource(); break;
+   {
+      R__TRACE_SPAN("rdf", "RDataFrame event loop", fNRuns);
+      switch (fLoopType) {
+      case ELoopType::kNoFilesMT: RunEmptySourceMT(); break;
+      case ELoopType::kROOTFilesMT: RunTreeProcessorMT(); break;
+      case ELoopType::kDataSourceMT: RunDataSourceMT(); break;
+      case ELoopType::kNoFiles: RunEmptySource(); break;
+      case ELoopType::kROOTFiles: RunTreeReader(); break;
+      case ELoopType::kDataSource: RunDataSource(); break;
+      }
    }
    s.Stop();
 
-   CleanUpNodes();
+   FinishRun(s.CpuTime(), s.RealTime());
+}
 
-   fNRuns++;
+/// Return a key that identifies the dataset read by the event loop, such that the loop managers with the same key
+/// can share one reading pass, see RunSharedScan. The key is empty if the event loop cannot be shared: it must read
+/// a TTree or TChain without friends nor entry list, over all of its entries.
+std::string RLoopManager::GetSharedScanKey()
+{
+   if ((fLoopType != ELoopType::kROOTFiles && fLoopType != ELoopType::kROOTFilesMT) || HasEntryRange() ||
+       HasEntryNumberRanges())
+      return "";
+   auto hasFriends = [](TTree *t) {
+      return t != nullptr && t->GetListOfFriends() != nullptr && t->GetListOfFriends()->GetEntries() > 0;
+   };
+   if (GetEntryList() != nullptr || hasFriends(fTree.get()) || hasFriends(fTree->GetTree()))
+      return "";
+
+   std::ostringstream key;
+   // the loops also need the same kind of event loop and number of slots to be run together
+   key << (fLoopType == ELoopType::kROOTFilesMT ? "MT " : "") << fNSlots << ' ' << fTree->GetName();
+   if (auto *chain = dynamic_cast<TChain *>(fTree.get())) {
+      for (auto *element : *chain->GetListOfFiles())
+         key << '\n' << element->GetTitle(); // the title of the elements of a TChain is the name of their file
+   } else if (fTree->GetDirectory() != nullptr) {
+      key << '\n' << fTree->GetDirectory()->GetPath();
+   } else {
+      key << '\n' << fTree.get(); // a TTree in memory is only shared with the loop managers reading it
+   }
+   return key.str();
+}
+
+/// Run the event loops of several loop managers in one pass over their dataset: each entry is read once and processed
+/// by the computation graphs of all of them, which share the TTreeReader and thus the readers of the columns they all
+/// use. The loop managers must have the same non-empty GetSharedScanKey(). Batched execution is not used, and a
+/// computation graph that stops early (e.g. because of Range) merely stops processing the entries.
+void RLoopManager::RunSharedScan(const std::vector<RLoopManager *> &loopManagers)
+{
+   if (loopManagers.size() == 1u) {
+      loopManagers[0]->Run();
+      return;
+   }
+
+   MaxTreeSizeRAII ctxtmts;
+
+   // the batches of a graph could move the shared reader away from the entry the other graphs process
+   for (auto *lm : loopManagers)
+      lm->PrepareRun(false);
+
+   TStopwatch s;
+   s.Start();
+   if (loopManagers[0]->fLoopType == ELoopType::kROOTFilesMT)
+      RunSharedTreeProcessorMT(loopManagers);
+   else
+      RunSharedTreeReader(loopManagers);
+   s.Stop();
 
-   R__LOG_INFO(RDFLogChannel()) << "Finished event loop number " << fNRuns - 1 << " (" << s.CpuTime() << "s CPU, "
-                                << s.RealTime() << "s elapsed).";
+   for (auto *lm : loopManagers)
+      lm->FinishRun(s.CpuTime(), s.RealTime());
+}
+
+/// Run the shared event loop of several loop managers, see RunSharedScan, in sequence.
+void RLoopManager::RunSharedTreeReader(const std::vector<RLoopManager *> &loopManagers)
+{
+   auto &tree = *loopManagers[0]->fTree;
+   TTreeReader r(&tree, loopManagers[0]->GetEntryList());
+   if (0 == tree.GetEntriesFast())
+      return;
+   std::vector<std::unique_ptr<RCallCleanUpTask>> cleanups;
+   for (auto *lm : loopManagers) {
+      cleanups.emplace_back(new RCallCleanUpTask(*lm, 0u, &r));
+      lm->InitNodeSlots(&r, 0);
+   }
+   R__LOG_INFO(RDFLogChannel()) << LogRangeProcessing(TreeDatasetLogInfo(r, 0u)) << " for "
+                                << loopManagers.size() << " computation graphs";
+
+   auto isProcessing = [](RLoopManager *lm) { return lm->fNStopsReceived < lm->fNChildren; };
+   try {
+      while (std::any_of(loopManagers.begin(), loopManagers.end(), isProcessing) && r.Next()) {
+         for (auto *lm : loopManagers)
+            if (isProcessing(lm))
+               lm->ProcessEntry(0, r.GetCurrentEntry());
+      }
+   } catch (...) {
+      std::cerr << "RDataFrame::Run: event loop was interrupted\n";
+      throw;
+   }
+   if (r.GetEntryStatus() != TTreeReader::kEntryBeyondEnd &&
+       std::any_of(loopManagers.begin(), loopManagers.end(), isProcessing)) {
+      // something went wrong in the TTreeReader event loop
+      throw std::runtime_error("An error was encountered while processing the data. TTreeReader status code is: " +
+                               std::to_string(r.GetEntryStatus()));
+   }
+}
+
+/// Run the shared event loop of several loop managers, see RunSharedScan, in parallel.
+void RLoopManager::RunSharedTreeProcessorMT(const std::vector<RLoopManager *> &loopManagers)
+{
+#ifdef R__USE_IMT
+   auto &tree = *loopManagers[0]->fTree;
+   const auto nSlots = loopManagers[0]->fNSlots;
+   RSlotStack slotStack(nSlots);
+   auto *elist = loopManagers[0]->GetEntryList();
+   const auto &entryList = elist ? *elist : TEntryList();
+   auto tp = std::make_unique<ROOT::TTreeProcessorMT>(tree, entryList, nSlots);
+
+   std::atomic<ULong64_t> entryCount(0ull);
+
+   tp->Process([&loopManagers, &slotStack, &entryCount](TTreeReader &r) -> void {
+      RSlotRAII slotRAII(slotStack);
+      auto slot = slotRAII.fSlot;
+      R__TRACE_SPAN("rdf", "RDataFrame task", slot);
+      std::vector<std::unique_ptr<RCallCleanUpTask>> cleanups;
+      for (auto *lm : loopManagers) {
+         cleanups.emplace_back(new RCallCleanUpTask(*lm, slot, &r));
+         lm->InitNodeSlots(&r, slot);
+      }
+      R__LOG_INFO(RDFLogChannel()) << LogRangeProcessing(TreeDatasetLogInfo(r, slot)) << " for "
+                                   << loopManagers.size() << " computation graphs";
+      const auto entryRange = r.GetEntriesRange(); // we trust TTreeProcessorMT to call SetEntriesRange
+      const auto nEntries = entryRange.second - entryRange.first;
+      auto count = entryCount.fetch_add(nEntries);
+      try {
+         while (r.Next()) {
+            for (auto *lm : loopManagers)
+               lm->ProcessEntry(slot, count);
+            ++count;
+         }
+      } catch (...) {
+         std::cerr << "RDataFrame::Run: event loop was interrupted\n";
+         throw;
+      }
+      if (r.GetEntryStatus() != TTreeReader::kEntryBeyondEnd) {
+         // something went wrong in the TTreeReader event loop
+         throw std::runtime_error("An error was encountered while processing the data. TTreeReader status code is: " +
+                                  std::to_string(r.GetEntryStatus()));
+      }
+   });
+#else
+   (void)loopManagers;
+#endif // no-op otherwise (will not be called)
+}
+
+/// Restrict the following event loops to the entries with entry number in [begin, end).
+/// Used by the distributed execution of the computation graph, where each worker process runs the graph over a
+/// different entry range (see ROOT::RDF::Experimental::RunDistributed). Multi-thread event loops only process the
+/// clusters of the TTrees overlapping the range, and do not open the files after it.
+void RLoopManager::SetEntryRange(ULong64_t begin, ULong64_t end)
+{
+   if (begin > end)
+      throw std::logic_error("RDataFrame: the first entry of an entry range cannot be larger than its end.");
+   fEntryRange = {begin, end};
 }
 
 /// Return the list of default columns -- empty if none was provided when constructing the RDataFrame
@@ -793,7 +1257,7 @@ void RLoopManager::Report(ROOT::RDF::RCutFlowReport &rep) const
 void RLoopManager::ToJitExec(const std::string &code) const
 {
    R__LOCKGUARD(gROOTMutex);
-   GetCodeToJit().append(code);
+   GetCodeToJit().emplace_back(code);
 }
 
 void RLoopManager::RegisterCallback(ULong64_t everyNEvents, std::function<void(unsigned int)> &&f)
@@ -830,6 +1294,35 @@ std::vector<RDFInternal::RActionBase *> RLoopManager::GetAllActions() const
    return actions;
 }
 
+////////////////////////////////////////////////////////////////////////////
+/// Return the time spent, the entries processed and the values read from the dataset by each Define, Filter and
+/// action of the computation graph during the event loops run with profiling enabled, see EnableProfiling.
+/// Defines are listed if they are used by a booked action or by an action that already ran.
+ROOT::RDF::RProfileReport RLoopManager::GetProfileReport()
+{
+   ROOT::RDF::RProfileReport report;
+   // jitted nodes return the profile of their concrete node: make sure that each profile is listed once
+   std::set<const RNodeProfile *> listed;
+   auto addNode = [&](const RNodeProfile &profile) {
+      if (listed.insert(&profile).second)
+         report.AddNode(profile.GetInfo());
+   };
+
+   const auto actions = GetAllActions();
+   for (auto *action : actions) {
+      for (const auto &define : action->GetDefines().GetColumns()) {
+         if (!IsInternalColumn(define.first))
+            addNode(define.second->GetProfile());
+      }
+   }
+   for (auto *filter : fBookedFilters)
+      addNode(filter->GetProfile());
+   for (auto *action : actions)
+      addNode(action->GetProfile());
+
+   return report;
+}
+
 std::shared_ptr<ROOT::Internal::RDF::GraphDrawing::GraphNode> RLoopManager::GetGraph()
 {
    std::string name;
@@ -25,6 +25,8 @@
 
 #include <TError.h>
 
+#include <algorithm>
+#include <stdexcept>
 #include <string>
 #include <vector>
 #include <typeinfo>
@@ -107,10 +109,17 @@ class RNTupleColumnReader : public ROOT::Detail::RDF::RColumnReaderBase {
    std::unique_ptr<RFieldBase> fField; ///< The field backing the RDF column
    RFieldValue fValue;                 ///< The memory location used to read from fField
    Long64_t fLastEntry;                ///< Last entry number that was read
+   /// Simple leaf fields are read zero-copy from the currently mapped page
+   bool fIsMappable;
+   std::size_t fValueSize;                ///< In-memory size of a single element of a mappable field
+   unsigned char *fMappedItems = nullptr; ///< The memory of the element fFirstMapped in the mapped page
+   Long64_t fFirstMapped = 0;             ///< First entry number contained in fMappedItems
+   Long64_t fNMapped = 0;                 ///< Number of entries available in fMappedItems
 
 public:
    RNTupleColumnReader(std::unique_ptr<RFieldBase> f)
-      : fField(std::move(f)), fValue(fField->GenerateValue()), fLastEntry(-1)
+      : fField(std::move(f)), fValue(fField->GenerateValue()), fLastEntry(-1),
+        fIsMappable(fField->IsSimple() && fField->GetSubFields().empty()), fValueSize(fField->GetValueSize())
    {
    }
    virtual ~RNTupleColumnReader() { fField->DestroyValue(fValue); }
@@ -131,6 +140,16 @@ public:
 
    void *GetImpl(Long64_t entry) final
    {
+      if (fIsMappable) {
+         if ((entry < fFirstMapped) || (entry >= fFirstMapped + fNMapped)) {
+            ROOT::Experimental::NTupleSize_t nItems;
+            fMappedItems = static_cast<unsigned char *>(fField->MapRawV(entry, nItems));
+            fFirstMapped = entry;
+            fNMapped = nItems;
+         }
+         return fMappedItems + (entry - fFirstMapped) * fValueSize;
+      }
+
       if (entry != fLastEntry) {
          fField->Read(entry, &fValue);
          fLastEntry = entry;
@@ -272,6 +291,87 @@ bool RNTupleDS::SetEntry(unsigned int, ULong64_t)
    return true;
 }
 
+void RNTupleDS::AddValueRangeHint(std::string_view colName, double min, double max)
+{
+   const auto &desc = fSources[0]->GetDescriptor();
+   const std::string name(colName);
+   // Walk down the field hierarchy; all the parent fields must be records
+   const auto fieldZeroId = desc.GetFieldZeroId();
+   auto fieldId = fieldZeroId;
+   std::string::size_type pos = 0;
+   while (true) {
+      if (fieldId != fieldZeroId && desc.GetFieldDescriptor(fieldId).GetStructure() != ENTupleStructure::kRecord)
+         throw std::runtime_error("RNTupleDS: value range hints are not supported for column " + name);
+      auto nextDot = name.find('.', pos);
+      fieldId = desc.FindFieldId(name.substr(pos, nextDot - pos), fieldId);
+      if (fieldId == kInvalidDescriptorId)
+         throw std::runtime_error("RNTupleDS: unknown column " + name);
+      if (nextDot == std::string::npos)
+         break;
+      pos = nextDot + 1;
+   }
+   if (desc.GetFieldDescriptor(fieldId).GetStructure() != ENTupleStructure::kLeaf)
+      throw std::runtime_error("RNTupleDS: value range hints are not supported for column " + name);
+   auto columnId = desc.FindColumnId(fieldId, 0);
+   if (columnId == kInvalidDescriptorId)
+      throw std::runtime_error("RNTupleDS: value range hints are not supported for column " + name);
+
+   fValueRangeHints.push_back({columnId, min, max});
+}
+
+std::vector<std::pair<ULong64_t, ULong64_t>> RNTupleDS::GetHintedEntryRanges() const
+{
+   using Range_t = std::pair<ULong64_t, ULong64_t>;
+   // Both input lists are sorted and consist of disjoint ranges
+   auto fnIntersect = [](const std::vector<Range_t> &a, const std::vector<Range_t> &b) {
+      std::vector<Range_t> result;
+      auto itrA = a.begin();
+      auto itrB = b.begin();
+      while (itrA != a.end() && itrB != b.end()) {
+         auto first = std::max(itrA->first, itrB->first);
+         auto last = std::min(itrA->second, itrB->second);
+         if (first < last)
+            result.emplace_back(first, last);
+         if (itrA->second < itrB->second)
+            ++itrA;
+         else
+            ++itrB;
+      }
+      return result;
+   };
+
+   // For the supported columns, the element index equals the entry number
+   const auto &desc = fSources[0]->GetDescriptor();
+   std::vector<Range_t> ranges;
+   for (const auto &cluster : desc.GetClusterIterable()) {
+      std::vector<Range_t> clusterRanges{{cluster.GetFirstEntryIndex(),
+                                          cluster.GetFirstEntryIndex() + cluster.GetNEntries()}};
+      for (const auto &hint : fValueRangeHints) {
+         const auto &columnRange = cluster.GetColumnRange(hint.fColumnId);
+         if (!columnRange.fValueRange.Overlaps(hint.fMin, hint.fMax)) {
+            clusterRanges.clear();
+            break;
+         }
+         std::vector<Range_t> pageRanges;
+         auto firstInPage = columnRange.fFirstElementIndex;
+         for (const auto &pageInfo : cluster.GetPageRange(hint.fColumnId).fPageInfos) {
+            if (pageInfo.fValueRange.Overlaps(hint.fMin, hint.fMax)) {
+               if (!pageRanges.empty() && pageRanges.back().second == firstInPage)
+                  pageRanges.back().second += pageInfo.fNElements;
+               else
+                  pageRanges.emplace_back(firstInPage, firstInPage + pageInfo.fNElements);
+            }
+            firstInPage += pageInfo.fNElements;
+         }
+         clusterRanges = fnIntersect(clusterRanges, pageRanges);
+      }
+      ranges.insert(ranges.end(), clusterRanges.begin(), clusterRanges.end());
+   }
+   // The cluster iterable does not necessarily traverse the clusters in entry order
+   std::sort(ranges.begin(), ranges.end());
+   return ranges;
+}
+
 std::vector<std::pair<ULong64_t, ULong64_t>> RNTupleDS::GetEntryRanges()
 {
    // TODO(jblomer): use cluster boundaries for the entry ranges
@@ -279,6 +379,11 @@ std::vector<std::pair<ULong64_t, ULong64_t>> RNTupleDS::GetEntryRanges()
    if (fHasSeenAllRanges)
       return ranges;
 
+   if (!fValueRangeHints.empty()) {
+      fHasSeenAllRanges = true;
+      return GetHintedEntryRanges();
+   }
+
    auto nEntries = fSources[0]->GetNEntries();
    const auto chunkSize = nEntries / fNSlots;
    const auto reminder = 1U == fNSlots ? 0 : nEntries % fNSlots;
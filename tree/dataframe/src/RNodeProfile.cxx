@@ -0,0 +1,74 @@
+/*************************************************************************
+ * Copyright (C) 1995-2021, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#include "ROOT/RDF/RNodeProfile.hxx"
+
+#include <iomanip>
+#include <sstream>
+
+namespace ROOT {
+namespace Internal {
+namespace RDF {
+
+void RNodeProfile::SetColumnNames(const std::vector<std::string> &columnNames)
+{
+   fColumnNames = columnNames;
+   for (auto &counters : fColumnCounters)
+      counters.resize(fColumnNames.size());
+}
+
+ULong64_t RNodeProfile::GetEntries() const
+{
+   ULong64_t entries = 0ull;
+   for (auto slot = 0u; slot < fNSlots; ++slot)
+      entries += fEntries[slot * CacheLineStep<ULong64_t>()];
+   return entries;
+}
+
+ROOT::RDF::RNodeProfileInfo RNodeProfile::GetInfo() const
+{
+   std::vector<double> slotTimes(fNSlots);
+   std::vector<ULong64_t> slotEntries(fNSlots);
+   for (auto slot = 0u; slot < fNSlots; ++slot) {
+      slotTimes[slot] = fNanoseconds[slot * CacheLineStep<ULong64_t>()] * 1e-9;
+      slotEntries[slot] = fEntries[slot * CacheLineStep<ULong64_t>()];
+   }
+
+   std::vector<ROOT::RDF::RColumnProfileInfo> columns;
+   for (std::size_t colIdx = 0u; colIdx < fColumnNames.size(); ++colIdx) {
+      ULong64_t nValues = 0ull, nBytes = 0ull;
+      for (const auto &counters : fColumnCounters) {
+         nValues += counters[colIdx].fNValues;
+         nBytes += counters[colIdx].fNBytes;
+      }
+      // only columns read from the dataset are counted
+      if (nValues > 0ull)
+         columns.emplace_back(ROOT::RDF::RColumnProfileInfo(fColumnNames[colIdx], nValues, nBytes));
+   }
+
+   return ROOT::RDF::RNodeProfileInfo(fKind, fName, std::move(slotTimes), std::move(slotEntries), std::move(columns));
+}
+
+std::string RNodeProfile::GetSummary() const
+{
+   const auto info = GetInfo();
+   if (info.GetEntries() == 0ull)
+      return "";
+   std::stringstream summary;
+   summary << std::setprecision(3) << info.GetTime() << " s, " << info.GetEntries() << " entries";
+   ULong64_t nBytes = 0ull;
+   for (const auto &c : info.GetColumns())
+      nBytes += c.GetNBytes();
+   if (nBytes > 0ull)
+      summary << ", " << nBytes << " bytes read";
+   return summary.str();
+}
+
+} // namespace RDF
+} // namespace Internal
+} // namespace ROOT
@@ -0,0 +1,354 @@
+/*************************************************************************
+ * Copyright (C) 1995-2021, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+// clang-format off
+/** \class ROOT::RDF::RParquetDS
+    \ingroup dataframe
+    \brief RDataFrame data source class for reading Apache Parquet files.
+
+A RDataFrame that reads a Parquet file can be constructed using the factory method
+ROOT::RDF::MakeParquetDataFrame, which accepts three parameters:
+1. The path of the Parquet file.
+2. The names of the columns to read (optional, by default all of them). Only the Parquet columns of these are read
+and decoded.
+3. Ranges of values of columns used to skip whole row groups (optional, see below).
+
+The types of the columns are derived from the Arrow schema of the file, in the same way as in RArrowDS: numbers,
+booleans, strings and lists of numbers, which are read as RVecs.
+
+Every row group of the file is the entry range of one task: in multi-thread event loops, the row groups are read and
+decoded in parallel, each slot with its own reader of the file. Only the row group that each slot is processing is
+held in memory, so files larger than the memory can be processed.
+
+The statistics stored in the file, i.e. the minimum and maximum values of the columns in each row group, can be used
+to skip the row groups that cannot contain interesting entries. The ranges do not select entries: the row groups
+that are read may contain entries outside the ranges, so the corresponding Filter must still be applied.
+~~~{.cpp}
+// Only the row groups with values of pt larger than 100 are read
+auto df = ROOT::RDF::MakeParquetDataFrame("data.parquet", {"pt", "eta"}, {{"pt", 100.}});
+auto h = df.Filter("pt > 100").Histo1D("eta");
+~~~
+*/
+// clang-format on
+
+#include <ROOT/RDF/Utils.hxx>
+#include <ROOT/RParquetDS.hxx>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+
+#include "RArrowDSUtils.hxx"
+
+#if defined(__GNUC__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wshadow"
+#pragma GCC diagnostic ignored "-Wunused-parameter"
+#endif
+#include <arrow/memory_pool.h>
+#include <parquet/arrow/reader.h>
+#include <parquet/exception.h>
+#include <parquet/file_reader.h>
+#include <parquet/metadata.h>
+#include <parquet/schema.h>
+#include <parquet/statistics.h>
+#if defined(__GNUC__)
+#pragma GCC diagnostic pop
+#endif
+
+namespace {
+
+void ThrowIfError(const arrow::Status &status, const std::string &what)
+{
+   if (!status.ok())
+      throw std::runtime_error(what + ": " + status.ToString());
+}
+
+std::unique_ptr<parquet::arrow::FileReader>
+OpenFile(const std::string &fileName, const std::shared_ptr<parquet::FileMetaData> &metaData = nullptr)
+{
+   std::unique_ptr<parquet::arrow::FileReader> reader;
+   try {
+      // memory mapped: the pages of the columns that are read are the only parts of the file that are accessed
+      auto parquetReader =
+         parquet::ParquetFileReader::OpenFile(fileName, /*memory_map=*/true, parquet::default_reader_properties(),
+                                              metaData);
+      ThrowIfError(parquet::arrow::FileReader::Make(arrow::default_memory_pool(), std::move(parquetReader), &reader),
+                   "Could not open Parquet file " + fileName);
+   } catch (const parquet::ParquetException &e) {
+      throw std::runtime_error("Could not open Parquet file " + fileName + ": " + e.what());
+   }
+   return reader;
+}
+
+/// Return false if the statistics of the column chunk show that none of its values are in [min, max]
+bool MayHaveValuesInRange(const parquet::ColumnChunkMetaData &chunk, bool isUnsigned, double min, double max)
+{
+   if (!chunk.is_stats_set())
+      return true;
+   const auto stats = chunk.statistics();
+   if (!stats || !stats->HasMinMax())
+      return true;
+
+   double statsMin = 0.;
+   double statsMax = 0.;
+   switch (stats->physical_type()) {
+   case parquet::Type::INT32: {
+      const auto &s = static_cast<const parquet::Int32Statistics &>(*stats);
+      statsMin = isUnsigned ? double(static_cast<std::uint32_t>(s.min())) : double(s.min());
+      statsMax = isUnsigned ? double(static_cast<std::uint32_t>(s.max())) : double(s.max());
+      break;
+   }
+   case parquet::Type::INT64: {
+      const auto &s = static_cast<const parquet::Int64Statistics &>(*stats);
+      statsMin = isUnsigned ? double(static_cast<std::uint64_t>(s.min())) : double(s.min());
+      statsMax = isUnsigned ? double(static_cast<std::uint64_t>(s.max())) : double(s.max());
+      break;
+   }
+   case parquet::Type::FLOAT: {
+      const auto &s = static_cast<const parquet::FloatStatistics &>(*stats);
+      statsMin = s.min();
+      statsMax = s.max();
+      break;
+   }
+   case parquet::Type::DOUBLE: {
+      const auto &s = static_cast<const parquet::DoubleStatistics &>(*stats);
+      statsMin = s.min();
+      statsMax = s.max();
+      break;
+   }
+   default: return true;
+   }
+   if (std::isnan(statsMin) || std::isnan(statsMax))
+      return true;
+   return statsMax >= min && statsMin <= max;
+}
+
+} // anonymous namespace
+
+namespace ROOT {
+namespace RDF {
+
+////////////////////////////////////////////////////////////////////////
+/// Constructor to create a Parquet RDataSource for RDataFrame.
+/// \param[in] fileName the path of the Parquet file.
+/// \param[in] columns the columns to read, all of them if empty.
+/// \param[in] columnRanges the ranges of values used to skip row groups: a row group is read only if its statistics
+///                         show that it may contain values in the ranges of all the columns.
+RParquetDS::RParquetDS(std::string_view fileName, const std::vector<std::string> &columns,
+                       const std::vector<RColumnRange> &columnRanges)
+   : fFileName(fileName), fColumnNames(columns)
+{
+   auto reader = OpenFile(fFileName);
+   fMetaData = reader->parquet_reader()->metadata();
+   ThrowIfError(reader->GetSchema(&fSchema), "Could not read the schema of Parquet file " + fFileName);
+
+   if (fColumnNames.empty()) {
+      for (auto &field : fSchema->fields())
+         fColumnNames.push_back(field->name());
+   }
+   for (auto &columnName : fColumnNames) {
+      const auto field = fSchema->GetFieldByName(columnName);
+      if (!field)
+         throw std::runtime_error("The dataset does not have column " + columnName);
+      ROOT::RDF::VerifyValidColumnType verifyType;
+      if (!field->type()->Accept(&verifyType).ok())
+         throw std::runtime_error("Column " + columnName + " contains an unsupported type.");
+   }
+
+   // The leaves of the Parquet schema that belong to the selected columns, e.g. the values of a list
+   const auto *parquetSchema = fMetaData->schema();
+   auto findLeaves = [parquetSchema](const std::string &columnName) {
+      std::vector<int> leaves;
+      for (int i = 0; i < parquetSchema->num_columns(); ++i) {
+         if (parquetSchema->GetColumnRoot(i)->name() == columnName)
+            leaves.push_back(i);
+      }
+      return leaves;
+   };
+   for (auto &columnName : fColumnNames) {
+      const auto leaves = findLeaves(columnName);
+      fLeafIndices.insert(fLeafIndices.end(), leaves.begin(), leaves.end());
+   }
+   std::sort(fLeafIndices.begin(), fLeafIndices.end());
+
+   // The ranges can only be checked against the statistics of columns of numbers, which have a single leaf
+   std::vector<std::pair<int, bool>> rangeLeaves; // (leaf, isUnsigned) of each range
+   for (auto &range : columnRanges) {
+      const auto field = fSchema->GetFieldByName(range.fColumnName);
+      const auto typeId = field ? field->type()->id() : arrow::Type::NA;
+      const bool isUnsigned = typeId == arrow::Type::UINT32 || typeId == arrow::Type::UINT64;
+      if (!isUnsigned && typeId != arrow::Type::INT32 && typeId != arrow::Type::INT64 &&
+          typeId != arrow::Type::FLOAT && typeId != arrow::Type::DOUBLE) {
+         throw std::invalid_argument("The range of column " + range.fColumnName +
+                                     " cannot be used: ranges can only be set on columns of numbers");
+      }
+      rangeLeaves.emplace_back(findLeaves(range.fColumnName).front(), isUnsigned);
+   }
+
+   ULong64_t nEntries = 0ULL;
+   for (int rg = 0; rg < fMetaData->num_row_groups(); ++rg) {
+      const auto rowGroup = fMetaData->RowGroup(rg);
+      if (rowGroup->num_rows() == 0)
+         continue;
+      bool skip = false;
+      for (std::size_t i = 0; i < columnRanges.size() && !skip; ++i) {
+         skip = !MayHaveValuesInRange(*rowGroup->ColumnChunk(rangeLeaves[i].first), rangeLeaves[i].second,
+                                      columnRanges[i].fMin, columnRanges[i].fMax);
+      }
+      if (skip)
+         continue;
+      fRowGroups.push_back(rg);
+      fRowGroupRanges.emplace_back(nEntries, nEntries + rowGroup->num_rows());
+      nEntries += rowGroup->num_rows();
+   }
+}
+
+////////////////////////////////////////////////////////////////////////
+/// Destructor.
+RParquetDS::~RParquetDS() {}
+
+const std::vector<std::string> &RParquetDS::GetColumnNames() const
+{
+   return fColumnNames;
+}
+
+std::vector<std::pair<ULong64_t, ULong64_t>> RParquetDS::GetEntryRanges()
+{
+   // one entry range per row group
+   if (fEntryRangesRequested)
+      return {};
+   fEntryRangesRequested = true;
+   return fRowGroupRanges;
+}
+
+std::string RParquetDS::GetTypeName(std::string_view colName) const
+{
+   if (!HasColumn(colName)) {
+      std::string msg = "The dataset does not have column ";
+      msg += colName;
+      throw std::runtime_error(msg);
+   }
+   RDFTypeNameGetter typeGetter;
+   const auto field = fSchema->GetFieldByName(std::string(colName));
+   ThrowIfError(field->type()->Accept(&typeGetter),
+                "RParquetDS does not support a column of type " + field->type()->ToString());
+   return typeGetter.result();
+}
+
+bool RParquetDS::HasColumn(std::string_view colName) const
+{
+   return std::find(fColumnNames.begin(), fColumnNames.end(), colName) != fColumnNames.end();
+}
+
+////////////////////////////////////////////////////////////////////////
+/// Read and decode the selected columns of a row group, with the reader of the slot, and point the value getters of
+/// the slot to them. Called by the thread of the slot.
+void RParquetDS::ReadRowGroup(unsigned int slot, std::size_t rowGroupIdx)
+{
+   auto &reader = fSlotReaders[slot];
+   if (!reader)
+      reader = OpenFile(fFileName, fMetaData);
+
+   // release the previous row group first
+   for (auto &getters : fValueGetters)
+      getters[slot]->SetChunks({}, 0);
+   fSlotTables[slot].reset();
+
+   std::shared_ptr<arrow::Table> table;
+   try {
+      ThrowIfError(reader->ReadRowGroup(fRowGroups[rowGroupIdx], fLeafIndices, &table),
+                   "Could not read row group " + std::to_string(fRowGroups[rowGroupIdx]) + " of Parquet file " +
+                      fFileName);
+   } catch (const parquet::ParquetException &e) {
+      throw std::runtime_error("Could not read row group " + std::to_string(fRowGroups[rowGroupIdx]) +
+                               " of Parquet file " + fFileName + ": " + e.what());
+   }
+
+   const auto firstEntry = fRowGroupRanges[rowGroupIdx].first;
+   for (std::size_t col = 0; col < fColumnNames.size(); ++col)
+      fValueGetters[col][slot]->SetChunks(table->GetColumnByName(fColumnNames[col])->chunks(), firstEntry);
+   fSlotTables[slot] = std::move(table);
+   fSlotRowGroups[slot] = rowGroupIdx;
+}
+
+bool RParquetDS::SetEntry(unsigned int slot, ULong64_t entry)
+{
+   const auto current = fSlotRowGroups[slot];
+   if (current < 0 || entry < fRowGroupRanges[current].first || entry >= fRowGroupRanges[current].second) {
+      // the single-thread event loop processes all the row groups with the same slot
+      const auto next = std::upper_bound(
+         fRowGroupRanges.begin(), fRowGroupRanges.end(), entry,
+         [](ULong64_t e, const std::pair<ULong64_t, ULong64_t> &range) { return e < range.second; });
+      if (next == fRowGroupRanges.end())
+         throw std::runtime_error("Entry " + std::to_string(entry) + " is not in Parquet file " + fFileName);
+      ReadRowGroup(slot, std::distance(fRowGroupRanges.begin(), next));
+   }
+
+   for (auto &getters : fValueGetters)
+      getters[slot]->SetEntry(0, entry);
+   return true;
+}
+
+void RParquetDS::SetNSlots(unsigned int nSlots)
+{
+   assert(0U == fNSlots && "Setting the number of slots even if the number of slots is different from zero.");
+   fNSlots = nSlots;
+
+   fSlotReaders.resize(fNSlots);
+   fSlotTables.resize(fNSlots);
+   fSlotRowGroups.assign(fNSlots, -1);
+   fValueGetters.resize(fColumnNames.size());
+   for (auto &getters : fValueGetters) {
+      for (unsigned int slot = 0; slot < fNSlots; ++slot)
+         getters.emplace_back(std::make_unique<ROOT::Internal::RDF::TValueGetter>(1, arrow::ArrayVector{}));
+   }
+}
+
+/// This needs to return a pointer to the pointer each value getter will point to.
+std::vector<void *> RParquetDS::GetColumnReadersImpl(std::string_view colName, const std::type_info &)
+{
+   const auto col = std::distance(fColumnNames.begin(), std::find(fColumnNames.begin(), fColumnNames.end(), colName));
+   std::vector<void *> ret;
+   for (auto &getter : fValueGetters[col])
+      ret.push_back(getter->SlotPtrs()[0]);
+   return ret;
+}
+
+void RParquetDS::Initialise()
+{
+   fEntryRangesRequested = false;
+}
+
+void RParquetDS::Finalise()
+{
+   // release the last row groups, the readers can be reused by the next event loop
+   for (auto &getters : fValueGetters) {
+      for (auto &getter : getters)
+         getter->SetChunks({}, 0);
+   }
+   std::fill(fSlotTables.begin(), fSlotTables.end(), nullptr);
+   std::fill(fSlotRowGroups.begin(), fSlotRowGroups.end(), -1);
+}
+
+std::string RParquetDS::GetLabel()
+{
+   return "ParquetDS";
+}
+
+RDataFrame MakeParquetDataFrame(std::string_view fileName, const std::vector<std::string> &columns,
+                                const std::vector<RParquetDS::RColumnRange> &columnRanges)
+{
+   ROOT::RDataFrame rdf(std::make_unique<RParquetDS>(fileName, columns, columnRanges));
+   return rdf;
+}
+
+} // namespace RDF
+} // namespace ROOT
@@ -0,0 +1,39 @@
+/*************************************************************************
+ * Copyright (C) 1995-2021, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#include "ROOT/RProcessBackend.hxx"
+#include "ROOT/TProcessExecutor.hxx"
+#include "TSystem.h"
+
+#include <numeric> // std::iota
+#include <vector>
+
+namespace ROOT {
+namespace RDF {
+namespace Experimental {
+
+RProcessBackend::RProcessBackend(unsigned int nWorkers) : fNWorkers(nWorkers)
+{
+   if (fNWorkers == 0u) {
+      SysInfo_t info;
+      gSystem->GetSysInfo(&info);
+      fNWorkers = info.fCpus > 0 ? info.fCpus : 1u;
+   }
+}
+
+std::vector<std::vector<char>> RProcessBackend::Run(const Task_t &task, unsigned int nTasks)
+{
+   std::vector<unsigned int> taskIndices(nTasks);
+   std::iota(taskIndices.begin(), taskIndices.end(), 0u);
+   ROOT::TProcessExecutor pool(nTasks < fNWorkers ? nTasks : fNWorkers);
+   return pool.Map([&task](unsigned int taskIdx) { return task(taskIdx); }, taskIndices);
+}
+
+} // namespace Experimental
+} // namespace RDF
+} // namespace ROOT
@@ -0,0 +1,55 @@
+/*************************************************************************
+ * Copyright (C) 1995-2021, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#include "ROOT/RDF/RProfileReport.hxx"
+#include "TString.h" // Printf
+
+#include <algorithm>
+#include <numeric>
+
+namespace ROOT {
+
+namespace RDF {
+
+double RNodeProfileInfo::GetTime() const
+{
+   return std::accumulate(fSlotTimes.begin(), fSlotTimes.end(), 0.);
+}
+
+ULong64_t RNodeProfileInfo::GetEntries() const
+{
+   return std::accumulate(fSlotEntries.begin(), fSlotEntries.end(), 0ull);
+}
+
+double RNodeProfileInfo::GetThroughput() const
+{
+   const auto time = GetTime();
+   return time > 0. ? GetEntries() / time : 0.;
+}
+
+void RProfileReport::Print() const
+{
+   std::vector<const RNodeProfileInfo *> nodes;
+   for (const auto &n : fNodes)
+      nodes.emplace_back(&n);
+   auto isSlower = [](const RNodeProfileInfo *n1, const RNodeProfileInfo *n2) { return n1->GetTime() > n2->GetTime(); };
+   std::stable_sort(nodes.begin(), nodes.end(), isSlower);
+
+   Printf("%-8s %-24s %12s %14s %14s %14s", "Kind", "Name", "Time [s]", "Entries", "Entries/s", "Bytes read");
+   for (const auto *n : nodes) {
+      ULong64_t nBytes = 0ull;
+      for (const auto &c : n->GetColumns())
+         nBytes += c.GetNBytes();
+      Printf("%-8s %-24s %12.6f %14llu %14.4g %14llu", n->GetKind().c_str(), n->GetName().c_str(), n->GetTime(),
+             n->GetEntries(), n->GetThroughput(), nBytes);
+   }
+}
+
+} // End NS RDF
+
+} // End NS ROOT
@@ -8,8 +8,12 @@
  * For the list of contributors see $ROOTSYS/README/CREDITS.             *
  *************************************************************************/
 
+#include "ROOT/RDF/RBookedDefines.hxx" // RVariationKey
+#include "ROOT/RDF/RLoopManager.hxx"
 #include "ROOT/RDF/RRangeBase.hxx"
 
+#include <limits>
+
 using ROOT::Detail::RDF::RRangeBase;
 using ROOT::Detail::RDF::RLoopManager;
 
@@ -17,12 +21,34 @@ RRangeBase::RRangeBase(RLoopManager *implPtr, unsigned int start, unsigned int s
                        const unsigned int nSlots)
    : RNodeBase(implPtr), fStart(start), fStop(stop), fStride(stride), fNSlots(nSlots) { }
 
+std::pair<ULong64_t, ULong64_t> RRangeBase::GetSelectedEntries() const
+{
+   return {fStart, fStop > 0 ? ULong64_t(fStop) : std::numeric_limits<ULong64_t>::max()};
+}
+
 void RRangeBase::ResetCounters()
 {
    fLastCheckedEntry = -1;
    fNProcessedEntries = 0;
    fHasStopped = false;
+   fLastCheckedBatch = -1;
 }
 
 // outlined to pin virtual table
 RRangeBase::~RRangeBase() { }
+
+std::shared_ptr<ROOT::Detail::RDF::RNodeBase>
+RRangeBase::GetVariedFilter(const ROOT::Internal::RDF::RVariationKey &key)
+{
+   const auto name = key.GetName();
+   const auto it = fVariedFilters.find(name);
+   if (it != fVariedFilters.end())
+      return it->second;
+
+   auto varied = MakeVariedRange(key);
+   if (varied != nullptr)
+      fLoopManager->Book(varied.get());
+   std::shared_ptr<RNodeBase> variedNode = std::move(varied);
+   fVariedFilters[name] = variedNode;
+   return variedNode;
+}
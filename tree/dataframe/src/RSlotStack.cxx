@@ -8,30 +8,90 @@
  * For the list of contributors see $ROOTSYS/README/CREDITS.             *
  *************************************************************************/
 
-#include <ROOT/TSeq.hxx>
 #include <ROOT/RDF/RSlotStack.hxx>
+#include <RConfigure.h> // R__USE_IMT
 #include <TError.h> // R__ASSERT
+#ifdef R__USE_IMT
+#include <ROOT/RTaskArena.hxx>
+#endif
 
-#include <mutex> // std::lock_guard
+#include <algorithm> // std::min
 
-ROOT::Internal::RDF::RSlotStack::RSlotStack(unsigned int size) : fSize(size)
+namespace {
+
+std::atomic<std::uint64_t> gNextSlotStackId{0};
+
+/// The last slot given back by this thread, and the stack it belongs to
+struct RCachedSlot {
+   std::uint64_t fStackId = std::uint64_t(-1);
+   unsigned int fSlot = 0;
+};
+
+thread_local RCachedSlot gCachedSlot;
+
+} // anonymous namespace
+
+ROOT::Internal::RDF::RSlotStack::RSlotStack(unsigned int size)
+   : fSize(size), fNWords((size + kBitsPerWord - 1) / kBitsPerWord), fId(gNextSlotStackId++),
+     fFreeSlots(new std::atomic<Word_t>[fNWords])
 {
-   for (auto i : ROOT::TSeqU(size))
-      fStack.push(i);
+   for (unsigned int w = 0; w < fNWords; ++w) {
+      const auto nInWord = std::min(kBitsPerWord, size - w * kBitsPerWord);
+      fFreeSlots[w].store(nInWord == kBitsPerWord ? ~Word_t(0) : (Word_t(1) << nInWord) - 1,
+                          std::memory_order_relaxed);
+   }
+}
+
+bool ROOT::Internal::RDF::RSlotStack::TryClaim(unsigned int slot)
+{
+   const auto bit = Word_t(1) << (slot % kBitsPerWord);
+   return fFreeSlots[slot / kBitsPerWord].fetch_and(~bit, std::memory_order_acquire) & bit;
 }
 
 void ROOT::Internal::RDF::RSlotStack::ReturnSlot(unsigned int slot)
 {
-   std::lock_guard<ROOT::TSpinMutex> guard(fMutex);
-   R__ASSERT(fStack.size() < fSize && "Trying to put back a slot to a full stack!");
-   fStack.push(slot);
+   R__ASSERT(slot < fSize && "Trying to put back a slot to a full stack!");
+   const auto bit = Word_t(1) << (slot % kBitsPerWord);
+   const auto previous = fFreeSlots[slot / kBitsPerWord].fetch_or(bit, std::memory_order_release);
+   R__ASSERT(!(previous & bit) && "Trying to put back a slot to a full stack!");
+   gCachedSlot.fStackId = fId;
+   gCachedSlot.fSlot = slot;
 }
 
 unsigned int ROOT::Internal::RDF::RSlotStack::GetSlot()
 {
-   std::lock_guard<ROOT::TSpinMutex> guard(fMutex);
-   R__ASSERT(!fStack.empty() && "Trying to pop a slot from an empty stack!");
-   const auto slot = fStack.top();
-   fStack.pop();
-   return slot;
+   // fast path: the slot this thread used last
+   if (gCachedSlot.fStackId == fId && TryClaim(gCachedSlot.fSlot))
+      return gCachedSlot.fSlot;
+
+   // then the slot matching the arena slot of this thread: a thread processes the same slot in every event loop, and
+   // with threads pinned to NUMA nodes, the per-slot data stays on the node that allocated it
+   unsigned int preferredSlot = gCachedSlot.fStackId == fId ? gCachedSlot.fSlot : 0u;
+#ifdef R__USE_IMT
+   const int threadIndex = ROOT::Internal::RTaskArenaWrapper::GetCurrentThreadIndex();
+   if (gCachedSlot.fStackId != fId && threadIndex >= 0) {
+      preferredSlot = threadIndex % fSize;
+      if (TryClaim(preferredSlot))
+         return preferredSlot;
+   }
+#endif
+
+   // otherwise the first free one, starting from the word of the preferred slot
+   const unsigned int firstWord = preferredSlot / kBitsPerWord;
+   for (unsigned int i = 0; i < fNWords; ++i) {
+      const auto w = (firstWord + i) % fNWords;
+      auto &word = fFreeSlots[w];
+      auto free = word.load(std::memory_order_relaxed);
+      while (free != 0) {
+         const auto lowest = free & (~free + 1);
+         if (word.compare_exchange_weak(free, free & ~lowest, std::memory_order_acquire, std::memory_order_relaxed)) {
+            unsigned int bitIdx = 0;
+            while (!((lowest >> bitIdx) & 1))
+               ++bitIdx;
+            return w * kBitsPerWord + bitIdx;
+         }
+      }
+   }
+   R__ASSERT(false && "Trying to pop a slot from an empty stack!");
+   return 0;
 }
@@ -336,20 +336,8 @@ struct RSqliteDSDataSet {
 };
 }
 
-RSqliteDS::Value_t::Value_t(RSqliteDS::ETypes type)
-   : fType(type), fIsActive(false), fInteger(0), fReal(0.0), fText(), fBlob(), fNull(nullptr)
-{
-   switch (type) {
-   case ETypes::kInteger: fPtr = &fInteger; break;
-   case ETypes::kReal: fPtr = &fReal; break;
-   case ETypes::kText: fPtr = &fText; break;
-   case ETypes::kBlob: fPtr = &fBlob; break;
-   case ETypes::kNull: fPtr = &fNull; break;
-   default: throw std::runtime_error("Internal error");
-   }
-}
-
 constexpr char const *RSqliteDS::fgTypeNames[];
+constexpr ULong64_t RSqliteDS::fgChunkRowsPerSlot;
 
 ////////////////////////////////////////////////////////////////////////////
 /// \brief Build the dataframe
@@ -358,7 +346,7 @@ constexpr char const *RSqliteDS::fgTypeNames[];
 ///
 /// The constructor opens the sqlite file, prepares the query engine and determines the column names and types.
 RSqliteDS::RSqliteDS(const std::string &fileName, const std::string &query)
-   : fDataSet(std::make_unique<Internal::RSqliteDSDataSet>()), fNSlots(0), fNRow(0)
+   : fDataSet(std::make_unique<Internal::RSqliteDSDataSet>()), fNSlots(0), fNRow(0), fChunkBegin(0), fIsDone(false)
 {
    static bool hasSqliteVfs = RegisterSqliteVfs();
    if (!hasSqliteVfs)
@@ -380,7 +368,7 @@ RSqliteDS::RSqliteDS(const std::string &fileName, const std::string &query)
    if ((retval != SQLITE_ROW) && (retval != SQLITE_DONE))
       SqliteError(retval);
 
-   fValues.reserve(colCount);
+   fColumns.reserve(colCount);
    for (int i = 0; i < colCount; ++i) {
       fColumnNames.emplace_back(sqlite3_column_name(fDataSet->fQuery, i));
       int type = SQLITE_NULL;
@@ -408,24 +396,24 @@ RSqliteDS::RSqliteDS(const std::string &fileName, const std::string &query)
       switch (type) {
       case SQLITE_INTEGER:
          fColumnTypes.push_back(ETypes::kInteger);
-         fValues.emplace_back(ETypes::kInteger);
+         fColumns.emplace_back(ETypes::kInteger);
          break;
       case SQLITE_FLOAT:
          fColumnTypes.push_back(ETypes::kReal);
-         fValues.emplace_back(ETypes::kReal);
+         fColumns.emplace_back(ETypes::kReal);
          break;
       case SQLITE_TEXT:
          fColumnTypes.push_back(ETypes::kText);
-         fValues.emplace_back(ETypes::kText);
+         fColumns.emplace_back(ETypes::kText);
          break;
       case SQLITE_BLOB:
          fColumnTypes.push_back(ETypes::kBlob);
-         fValues.emplace_back(ETypes::kBlob);
+         fColumns.emplace_back(ETypes::kBlob);
          break;
       case SQLITE_NULL:
          // TODO: Null values in first rows are not well handled
          fColumnTypes.push_back(ETypes::kNull);
-         fValues.emplace_back(ETypes::kNull);
+         fColumns.emplace_back(ETypes::kNull);
          break;
       default: throw std::runtime_error("Unhandled data type");
       }
@@ -470,28 +458,82 @@ RDataSource::Record_t RSqliteDS::GetColumnReadersImpl(std::string_view name, con
       throw std::runtime_error(errmsg);
    }
 
-   fValues[index].fIsActive = true;
-   return std::vector<void *>{fNSlots, &fValues[index].fPtr};
+   fColumns[index].fIsActive = true;
+   std::vector<void *> ptrs;
+   for (auto &slotPtrs : fValuePtrs)
+      ptrs.push_back(&slotPtrs[index]);
+   return ptrs;
 }
 
 ////////////////////////////////////////////////////////////////////////////
-/// Returns a range of size 1 as long as more rows are available in the SQL result set.
-/// This inherently serialized the RDF independent of the number of slots.
+/// Reads the next chunk of rows from the SQL result set into the column buffers and returns one entry range per slot
+/// covering these rows. The rows are read with a single cursor, only the values of the active columns are stored.
 std::vector<std::pair<ULong64_t, ULong64_t>> RSqliteDS::GetEntryRanges()
 {
    std::vector<std::pair<ULong64_t, ULong64_t>> entryRanges;
-   int retval = sqlite3_step(fDataSet->fQuery);
-   switch (retval) {
-   case SQLITE_DONE: return entryRanges;
-   case SQLITE_ROW:
-      entryRanges.emplace_back(fNRow, fNRow + 1);
-      fNRow++;
-      return entryRanges;
-   default:
-      SqliteError(retval);
-      // Never here
-      abort();
+
+   for (auto &col : fColumns) {
+      col.fInteger.clear();
+      col.fReal.clear();
+      col.fText.clear();
+      col.fBlob.clear();
+   }
+   fChunkBegin = fNRow;
+
+   const ULong64_t nSlots = std::max(fNSlots, 1U);
+   const ULong64_t maxRows = nSlots * fgChunkRowsPerSlot;
+   sqlite3_stmt *query = fDataSet->fQuery;
+   const int nColumns = fColumns.size();
+   ULong64_t nRows = 0;
+   while (!fIsDone && nRows < maxRows) {
+      int retval = sqlite3_step(query);
+      if (retval == SQLITE_DONE) {
+         // Stepping again would restart the query
+         fIsDone = true;
+         break;
+      }
+      if (retval != SQLITE_ROW)
+         SqliteError(retval);
+
+      for (int i = 0; i < nColumns; ++i) {
+         auto &col = fColumns[i];
+         if (!col.fIsActive)
+            continue;
+
+         switch (col.fType) {
+         case ETypes::kInteger: col.fInteger.push_back(sqlite3_column_int64(query, i)); break;
+         case ETypes::kReal: col.fReal.push_back(sqlite3_column_double(query, i)); break;
+         case ETypes::kText: {
+            // The text has to be retrieved before its size, see https://sqlite.org/c3ref/column_blob.html
+            auto text = reinterpret_cast<const char *>(sqlite3_column_text(query, i));
+            int nbytes = sqlite3_column_bytes(query, i);
+            if (text)
+               col.fText.emplace_back(text, nbytes);
+            else
+               col.fText.emplace_back();
+            break;
+         }
+         case ETypes::kBlob: {
+            auto blob = static_cast<const unsigned char *>(sqlite3_column_blob(query, i));
+            int nbytes = sqlite3_column_bytes(query, i);
+            if (blob)
+               col.fBlob.emplace_back(blob, blob + nbytes);
+            else
+               col.fBlob.emplace_back();
+            break;
+         }
+         case ETypes::kNull: break;
+         default: throw std::runtime_error("Unhandled column type");
+         }
+      }
+      ++nRows;
    }
+   fNRow += nRows;
+
+   const ULong64_t nRanges = std::min(nSlots, nRows);
+   for (ULong64_t i = 0; i < nRanges; ++i)
+      entryRanges.emplace_back(fChunkBegin + i * nRows / nRanges, fChunkBegin + (i + 1) * nRows / nRanges);
+   return entryRanges;
 }
 
 ////////////////////////////////////////////////////////////////////////////
@@ -520,6 +562,8 @@ bool RSqliteDS::HasColumn(std::string_view colName) const
 void RSqliteDS::Initialise()
 {
    fNRow = 0;
+   fChunkBegin = 0;
+   fIsDone = false;
    int retval = sqlite3_reset(fDataSet->fQuery);
    if (retval != SQLITE_OK)
       throw std::runtime_error("SQlite error, reset");
@@ -541,35 +585,25 @@ RDataFrame MakeSqliteDataFrame(std::string_view fileName, std::string_view query
 }
 
 ////////////////////////////////////////////////////////////////////////////
-/// Stores the result of the current active sqlite query row as a C++ value.
-bool RSqliteDS::SetEntry(unsigned int /* slot */, ULong64_t entry)
+/// Points the slot's column values to the given entry of the current chunk of rows. Different slots can be set
+/// concurrently as the column buffers are not modified until the next call to GetEntryRanges().
+bool RSqliteDS::SetEntry(unsigned int slot, ULong64_t entry)
 {
-   R__ASSERT(entry + 1 == fNRow);
-   unsigned N = fValues.size();
+   R__ASSERT(entry >= fChunkBegin && entry < fNRow);
+   const auto row = entry - fChunkBegin;
+   auto &ptrs = fValuePtrs[slot];
+   unsigned N = fColumns.size();
    for (unsigned i = 0; i < N; ++i) {
-      if (!fValues[i].fIsActive)
+      auto &col = fColumns[i];
+      if (!col.fIsActive)
          continue;
 
-      int nbytes;
-      switch (fValues[i].fType) {
-      case ETypes::kInteger: fValues[i].fInteger = sqlite3_column_int64(fDataSet->fQuery, i); break;
-      case ETypes::kReal: fValues[i].fReal = sqlite3_column_double(fDataSet->fQuery, i); break;
-      case ETypes::kText:
-         nbytes = sqlite3_column_bytes(fDataSet->fQuery, i);
-         if (nbytes == 0) {
-            fValues[i].fText = "";
-         } else {
-            fValues[i].fText = reinterpret_cast<const char *>(sqlite3_column_text(fDataSet->fQuery, i));
-         }
-         break;
-      case ETypes::kBlob:
-         nbytes = sqlite3_column_bytes(fDataSet->fQuery, i);
-         fValues[i].fBlob.resize(nbytes);
-         if (nbytes > 0) {
-            std::memcpy(fValues[i].fBlob.data(), sqlite3_column_blob(fDataSet->fQuery, i), nbytes);
-         }
-         break;
-      case ETypes::kNull: break;
+      switch (col.fType) {
+      case ETypes::kInteger: ptrs[i] = &col.fInteger[row]; break;
+      case ETypes::kReal: ptrs[i] = &col.fReal[row]; break;
+      case ETypes::kText: ptrs[i] = &col.fText[row]; break;
+      case ETypes::kBlob: ptrs[i] = &col.fBlob[row]; break;
+      case ETypes::kNull: ptrs[i] = &fNull; break;
       default: throw std::runtime_error("Unhandled column type");
       }
    }
@@ -577,14 +611,11 @@ bool RSqliteDS::SetEntry(unsigned int /* slot */, ULong64_t entry)
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////////////
-/// Almost a no-op, many slots can in fact reduce the performance due to thread synchronization.
+/// Prepares the per-slot column value pointers. It has to be called before GetColumnReaders().
 void RSqliteDS::SetNSlots(unsigned int nSlots)
 {
-   if (nSlots > 1) {
-      ::Warning("SetNSlots", "Currently the SQlite data source faces performance degradation in multi-threaded mode. "
-                             "Consider turning off IMT.");
-   }
    fNSlots = nSlots;
+   fValuePtrs.assign(nSlots, std::vector<void *>(fColumns.size(), nullptr));
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,93 @@
+// Author: Enrico Guiraud CERN 09/2020
+
+/*************************************************************************
+ * Copyright (C) 1995-2020, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#include <ROOT/RDF/RTreeColumnReader.hxx>
+#include <TBranch.h>
+#include <TBufferFile.h>
+#include <TDataType.h>
+#include <TLeaf.h>
+#include <TMath.h>
+#include <TObjArray.h>
+#include <TROOT.h>
+#include <TTree.h>
+
+ROOT::Internal::RDF::RTreeBulkReader::RTreeBulkReader(TTreeReader &r, const std::string &colName,
+                                                      const std::type_info &ti, std::size_t valueSize, bool isArray)
+   : fReader(r), fBranchName(colName), fDataType(TDataType::GetType(ti)), fIsArray(isArray), fValueSize(valueSize),
+     fBuffer(std::make_unique<TBufferFile>(TBuffer::kWrite, 10000))
+{
+}
+
+ROOT::Internal::RDF::RTreeBulkReader::~RTreeBulkReader() = default;
+
+void ROOT::Internal::RDF::RTreeBulkReader::Connect(TTree *localTree)
+{
+   fLocalTree = localTree;
+   fBranch = nullptr;
+   fFirstEntry = -1;
+   fNEntries = 0;
+
+   auto branch = localTree->GetBranch(fBranchName.c_str());
+   // Branches of friend trees are found, too, but their entry numbers differ from the ones of the local tree
+   if (!branch || branch->IsA() != TBranch::Class() || branch->GetTree() != localTree)
+      return;
+   if (!branch->GetBulkRead().SupportsBulkRead())
+      return;
+   auto leaf = static_cast<TLeaf *>(branch->GetListOfLeaves()->UncheckedAt(0));
+   if (leaf->GetLeafCount())
+      return;
+   const auto len = leaf->GetLenStatic();
+   if (len < 1 || (!fIsArray && len != 1))
+      return;
+   auto dataType = gROOT->GetType(leaf->GetTypeName());
+   if (!dataType || dataType->GetType() != fDataType || static_cast<std::size_t>(dataType->Size()) != fValueSize)
+      return;
+
+   fLen = len;
+   fBranch = branch;
+}
+
+bool ROOT::Internal::RDF::RTreeBulkReader::LoadBasket(Long64_t entry)
+{
+   // TBranch::GetBulkEntries() only reads complete baskets, starting at their first entry
+   const auto basketEntry = fBranch->GetBasketEntry();
+   const auto basket = TMath::BinarySearch(static_cast<Long64_t>(fBranch->GetWriteBasket() + 1), basketEntry, entry);
+   if (basket < 0)
+      return false;
+   const auto first = basketEntry[basket];
+   const auto nEntries = fBranch->GetBulkRead().GetBulkEntries(first, *fBuffer);
+   if (nEntries <= 0 || entry >= first + nEntries)
+      return false;
+   fFirstEntry = first;
+   fNEntries = nEntries;
+   return true;
+}
+
+void *ROOT::Internal::RDF::RTreeBulkReader::Get()
+{
+   TTree *tree = fReader.GetTree();
+   TTree *localTree = tree ? tree->GetTree() : nullptr;
+   if (!localTree)
+      return nullptr;
+   if (localTree != fLocalTree)
+      Connect(localTree);
+   if (!fBranch)
+      return nullptr;
+
+   const auto entry = localTree->GetReadEntry();
+   if (entry < fFirstEntry || entry >= fFirstEntry + fNEntries) {
+      if (!LoadBasket(entry)) {
+         // Use the TTreeReader for the rest of this tree
+         fBranch = nullptr;
+         return nullptr;
+      }
+   }
+   return static_cast<char *>(fBuffer->GetCurrent()) + (entry - fFirstEntry) * fLen * fValueSize;
+}
@@ -0,0 +1,218 @@
+#include <ROOT/RDataFrame.hxx>
+#include <ROOT/RVec.hxx>
+#include <TFile.h>
+#include <TSystem.h>
+#include <TTree.h>
+
+#include <gtest/gtest.h>
+
+#include <tuple>
+#include <utility>
+#include <vector>
+
+// Run the same computation graph with and without batching: results must be identical
+static void CheckGraph(ROOT::RDataFrame &df, unsigned int batchSize)
+{
+   df.SetBatchSize(batchSize);
+   auto defs = df.Define("x", [](ULong64_t e) { return double(e); }, {"rdfentry_"})
+                  .Define("y", [](double x) { return x * x; }, {"x"})
+                  .Define("v", [](double x, double y) { return ROOT::RVec<double>{x, y}; }, {"x", "y"});
+   auto filtered = defs.Filter([](double x) { return int(x) % 3 != 0; }, {"x"}, "notMultipleOf3")
+                      .Define("z", [](double y) { return y + 1.; }, {"y"})
+                      .Filter([](double z) { return z > 10.; }, {"z"}, "zGreaterThan10");
+   auto count = filtered.Count();
+   auto sumZ = filtered.Sum<double>("z");
+   auto takeX = filtered.Take<double>("x");
+   auto sumV = defs.Define("s", [](const ROOT::RVec<double> &v) { return ROOT::VecOps::Sum(v); }, {"v"})
+                  .Sum<double>("s");
+   auto jitted = defs.Filter("x > 50").Define("w", "y * 2").Sum<double>("w");
+   auto report = filtered.Report();
+
+   ULong64_t expCount = 0;
+   double expSumZ = 0., expSumV = 0., expJitted = 0.;
+   std::vector<double> expX;
+   for (ULong64_t e = 0; e < 1000; ++e) {
+      const double x = e, y = x * x;
+      expSumV += x + y;
+      if (x > 50)
+         expJitted += y * 2;
+      if (e % 3 != 0 && y + 1. > 10.) {
+         ++expCount;
+         expSumZ += y + 1.;
+         expX.push_back(x);
+      }
+   }
+
+   EXPECT_EQ(*count, expCount);
+   EXPECT_DOUBLE_EQ(*sumZ, expSumZ);
+   EXPECT_EQ(*takeX, expX);
+   EXPECT_DOUBLE_EQ(*sumV, expSumV);
+   EXPECT_DOUBLE_EQ(*jitted, expJitted);
+   EXPECT_EQ(report->At("notMultipleOf3").GetAll(), 1000ull);
+   EXPECT_EQ(report->At("notMultipleOf3").GetPass(), 666ull);
+   EXPECT_EQ(report->At("zGreaterThan10").GetPass(), expCount);
+   EXPECT_EQ(df.GetNRuns(), 1u);
+}
+
+TEST(RDFBatch, EmptySource)
+{
+   for (auto batchSize : {1u, 7u, 256u, 2000u}) {
+      ROOT::RDataFrame df(1000);
+      CheckGraph(df, batchSize);
+   }
+}
+
+TEST(RDFBatch, Range)
+{
+   ROOT::RDataFrame df(1000);
+   df.SetBatchSize(64);
+   auto x = df.Define("x", [](ULong64_t e) { return int(e); }, {"rdfentry_"});
+   auto taken = x.Filter([](int v) { return v % 2 == 0; }, {"x"}).Range(10, 100, 3).Take<int>("x");
+
+   // the nth even entry passes the Range if n is in (10, 100] and is a multiple of the stride
+   std::vector<int> expected;
+   for (int n = 12; n <= 100; n += 3)
+      expected.push_back(2 * (n - 1));
+   EXPECT_EQ(*taken, expected);
+}
+
+TEST(RDFBatch, TTree)
+{
+   const auto fname = "dataframe_batch_ttree.root";
+   {
+      TFile f(fname, "RECREATE");
+      TTree t("t", "t");
+      float px, py;
+      std::vector<int> idx;
+      t.Branch("px", &px);
+      t.Branch("py", &py);
+      t.Branch("idx", &idx);
+      for (int i = 0; i < 333; ++i) {
+         px = i;
+         py = -i;
+         idx.assign(i % 4, i);
+         t.Fill();
+      }
+      t.Write();
+   }
+
+   auto runGraph = [&](unsigned int batchSize) {
+      ROOT::RDataFrame df("t", {fname, fname});
+      df.SetBatchSize(batchSize);
+      auto pt = df.Define("pt", [](float x, float y) { return x * x + y * y; }, {"px", "py"});
+      auto sumPt = pt.Filter([](const ROOT::RVec<int> &v) { return !v.empty(); }, {"idx"}).Sum<float>("pt");
+      auto sizes = df.Define("n", [](const ROOT::RVec<int> &v) { return int(v.size()); }, {"idx"}).Take<int>("n");
+      return std::make_pair(*sumPt, *sizes);
+   };
+
+   const auto nominal = runGraph(1);
+   const auto batched = runGraph(50);
+   EXPECT_FLOAT_EQ(nominal.first, batched.first);
+   EXPECT_EQ(nominal.second, batched.second);
+   EXPECT_EQ(batched.second.size(), 666u);
+
+   gSystem->Unlink(fname);
+}
+
+TEST(RDFBatch, LazyColumns)
+{
+   const auto fname = "dataframe_batch_lazycolumns.root";
+   {
+      TFile f(fname, "RECREATE", "", /*compress=*/0);
+      TTree t("t", "t");
+      int i = 0;
+      std::vector<float> v;
+      t.Branch("i", &i);
+      t.Branch("v", &v);
+      for (i = 0; i < 1000; ++i) {
+         v.assign(1000, i);
+         t.Fill();
+      }
+      t.Write();
+   }
+
+   auto runGraph = [&](unsigned int batchSize) {
+      ROOT::RDataFrame df("t", {fname, fname});
+      df.SetBatchSize(batchSize);
+      // the filters select few entries, in few batches, so that most values of v are never read
+      auto selected = df.Filter([](int i) { return i % 300 == 7; }, {"i"}).Filter([](int i) { return i > 10; }, {"i"});
+      auto sums = selected.Define("s", [](const ROOT::RVec<float> &v) { return ROOT::VecOps::Sum(v); }, {"v"})
+                     .Take<float>("s");
+      auto indices = selected.Take<int>("i");
+      // v is read for every other entry of each batch
+      auto count = df.Filter([](int i) { return i % 2 == 0; }, {"i"})
+                      .Filter([](const ROOT::RVec<float> &v) { return v[0] < 500.f; }, {"v"})
+                      .Count();
+      return std::make_tuple(*sums, *indices, *count);
+   };
+
+   const auto nominal = runGraph(1);
+   // the batches do not end at the end of the TTrees
+   const auto batched = runGraph(64);
+   EXPECT_EQ(std::get<0>(nominal), std::get<0>(batched));
+   EXPECT_EQ(std::get<1>(nominal), std::get<1>(batched));
+   EXPECT_EQ(std::get<2>(nominal), std::get<2>(batched));
+   EXPECT_EQ(std::get<1>(batched), std::vector<int>({307, 607, 907, 307, 607, 907}));
+   EXPECT_EQ(std::get<2>(batched), 500ull);
+
+   // a batch without selected entries does not read v at all
+   {
+      ROOT::RDataFrame df("t", fname);
+      df.SetBatchSize(100);
+      auto sum = df.Filter([](int i) { return i < 0; }, {"i"})
+                    .Define("n", [](const ROOT::RVec<float> &v) { return v.size(); }, {"v"})
+                    .Sum<std::size_t>("n");
+      const auto bytesBefore = TFile::GetFileBytesRead();
+      EXPECT_EQ(*sum, 0u);
+      const auto vBytes = 1000ll * 1000ll * static_cast<Long64_t>(sizeof(float));
+      EXPECT_LT(TFile::GetFileBytesRead() - bytesBefore, vBytes / 10);
+   }
+
+   gSystem->Unlink(fname);
+}
+
+TEST(RDFBatch, SnapshotFallsBack)
+{
+   const auto fname = "dataframe_batch_snapshot.root";
+   ROOT::RDataFrame df(100);
+   df.SetBatchSize(32);
+   auto out = df.Define("x", [](ULong64_t e) { return int(e); }, {"rdfentry_"}).Snapshot<int>("t", fname, {"x"});
+   EXPECT_EQ(*out->Sum<int>("x"), 4950);
+   gSystem->Unlink(fname);
+}
+
+static std::vector<long> gBatchFunctionSizes;
+
+static void SquareIfEven(long size, const int *x, const char *even, float *out)
+{
+   gBatchFunctionSizes.push_back(size);
+   for (long i = 0; i < size; ++i)
+      out[i] = even[i] ? float(x[i]) * x[i] : 0.f;
+}
+
+TEST(RDFBatch, BatchFunction)
+{
+   using ROOT::RDF::Experimental::RBatchFunction;
+   for (auto batchSize : {1u, 32u}) {
+      gBatchFunctionSizes.clear();
+      ROOT::RDataFrame df(100);
+      df.SetBatchSize(batchSize);
+      auto sum = df.Define("x", [](ULong64_t e) { return int(e); }, {"rdfentry_"})
+                    .Define("even", [](int x) { return x % 2 == 0; }, {"x"})
+                    .Filter([](int x) { return x >= 10; }, {"x"})
+                    .Define("y", RBatchFunction<float, int, bool>(&SquareIfEven), {"x", "even"})
+                    .Sum<float>("y");
+
+      float expected = 0.f;
+      for (int x = 10; x < 100; x += 2)
+         expected += float(x) * x;
+      EXPECT_FLOAT_EQ(*sum, expected);
+      if (batchSize == 1u) {
+         // called for each entry
+         EXPECT_EQ(gBatchFunctionSizes, std::vector<long>(90, 1));
+      } else {
+         // called once per batch, on the entries that pass the filter
+         EXPECT_EQ(gBatchFunctionSizes, std::vector<long>({22, 32, 32, 4}));
+      }
+   }
+}
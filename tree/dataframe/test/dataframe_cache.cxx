@@ -346,3 +346,69 @@ TEST(Cache, Alias)
    auto df4 = df3.Cache({"y"});
    EXPECT_EQ(df4.Sum("y").GetValue(), 3u);
 }
+
+// Return the number of files in the given directory
+static int CountFiles(const char *dirName)
+{
+   int n = 0;
+   void *dir = gSystem->OpenDirectory(dirName);
+   while (const char *f = gSystem->GetDirEntry(dir)) {
+      if (std::string(f) != "." && std::string(f) != "..")
+         ++n;
+   }
+   gSystem->FreeDirectory(dir);
+   return n;
+}
+
+TEST(Cache, MemoryBudget)
+{
+   const auto spillDir = "dataframe_cache_spill";
+   gSystem->mkdir(spillDir);
+
+   ROOT::RDataFrame df(100);
+   auto df2 = df.Define("x", [](ULong64_t e) { return int(e); }, {"rdfentry_"})
+                 .Define("y", [](int x) { return x * 0.5; }, {"x"})
+                 .Filter([](int x) { return x % 2 == 0; }, {"x"});
+
+   // 50 entries of an int and a double fit in the budget: the cache is held in memory
+   RCacheOptions opts;
+   opts.fMemoryBudget = 50 * (sizeof(int) + sizeof(double));
+   opts.fSpillDirectory = spillDir;
+   auto inMemory = df2.Cache<int, double>({"x", "y"}, opts);
+   EXPECT_EQ(CountFiles(spillDir), 0);
+   // the budget is checked while caching, in the same event loop
+   EXPECT_EQ(df.GetNRuns(), 1u);
+   EXPECT_EQ(*inMemory.Count(), 50ull);
+
+   // with a smaller budget the cache spills to a temporary file once the budget is exceeded
+   opts.fMemoryBudget = 10 * (sizeof(int) + sizeof(double));
+   {
+      auto spilled = df2.Cache<int, double>({"x", "y"}, opts);
+      EXPECT_EQ(df.GetNRuns(), 2u);
+      EXPECT_EQ(CountFiles(spillDir), 1);
+      // the values cached before the budget was exceeded are in the file too
+      EXPECT_EQ(*spilled.Count(), 50ull);
+      EXPECT_EQ(*spilled.Sum<int>("x"), *inMemory.Sum<int>("x"));
+      EXPECT_DOUBLE_EQ(*spilled.Sum<double>("y"), *inMemory.Sum<double>("y"));
+      EXPECT_EQ(spilled.Take<int>("x")->front(), 0);
+
+      // jitted types
+      auto jitted = df2.Cache({"x", "y"}, opts);
+      EXPECT_EQ(df.GetNRuns(), 3u);
+      EXPECT_EQ(CountFiles(spillDir), 2);
+      EXPECT_DOUBLE_EQ(jitted.Mean("y").GetValue(), 24.5);
+   }
+   // the temporary files are removed together with the cached dataframes
+   EXPECT_EQ(CountFiles(spillDir), 0);
+
+   // the elements of the collections count towards the budget
+   auto df3 = ROOT::RDataFrame(10).Define("v", [] { return ROOT::RVec<int>(100, 1); });
+   opts.fMemoryBudget = 20 * sizeof(ROOT::RVec<int>);
+   {
+      auto spilledVecs = df3.Cache<ROOT::RVec<int>>({"v"}, opts);
+      EXPECT_EQ(CountFiles(spillDir), 1);
+      EXPECT_EQ(spilledVecs.Sum<ROOT::RVec<int>>("v").GetValue(), 1000);
+   }
+   EXPECT_EQ(CountFiles(spillDir), 0);
+   gSystem->Unlink(spillDir);
+}
@@ -0,0 +1,144 @@
+#include <ROOT/RDataFrame.hxx>
+#include <ROOT/RDFDistributed.hxx>
+#include <ROOT/RProcessBackend.hxx>
+#include <TFile.h>
+#include <TH1D.h>
+#include <TSystem.h>
+#include <TTree.h>
+
+#include <gtest/gtest.h>
+
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using ROOT::RDF::Experimental::RProcessBackend;
+using ROOT::RDF::Experimental::RunDistributed;
+
+static ROOT::RDF::RResultPtr<double> BookSum(ROOT::RDataFrame &df)
+{
+   return df.Define("x", [](ULong64_t e) { return double(e); }, {"rdfentry_"}).Sum<double>("x");
+}
+
+// Emulates a backend with remote workers: each task rebuilds the computation graph and runs it in this process
+class RSequentialBackend final : public ROOT::RDF::Experimental::RDistributedBackend {
+   unsigned int fNWorkers;
+   ULong64_t fNEntries;
+
+public:
+   unsigned int fNTasks = 0u;
+
+   RSequentialBackend(unsigned int nWorkers, ULong64_t nEntries) : fNWorkers(nWorkers), fNEntries(nEntries) {}
+   unsigned int GetNWorkers() const final { return fNWorkers; }
+   std::vector<std::vector<char>> Run(const Task_t &, unsigned int nTasks) final
+   {
+      fNTasks = nTasks;
+      std::vector<std::vector<char>> outputs;
+      for (auto i = 0u; i < nTasks; ++i) {
+         ROOT::RDataFrame df(fNEntries);
+         auto sum = BookSum(df);
+         outputs.emplace_back(ROOT::RDF::Experimental::RunDistributedTask(i, nTasks, sum));
+      }
+      return outputs;
+   }
+};
+
+TEST(RDFDistributed, EmptySource)
+{
+   ROOT::RDataFrame df(1000);
+   auto x = df.Define("x", [](ULong64_t e) { return double(e); }, {"rdfentry_"});
+   auto filtered = x.Filter([](double v) { return v < 500.; }, {"x"});
+   auto count = filtered.Count();
+   auto sum = filtered.Sum<double>("x");
+   auto mean = x.Mean<double>("x");
+   auto h = x.Histo1D<double>({"h", "h", 10, 0., 1000.}, "x");
+   auto jittedMax = x.Define("y", "x * 2").Max("y");
+
+   RProcessBackend backend(4);
+   RunDistributed(backend, count, sum, mean, h, jittedMax);
+
+   EXPECT_EQ(*count, 500ull);
+   EXPECT_DOUBLE_EQ(*sum, 124750.);
+   EXPECT_DOUBLE_EQ(*mean, 499.5);
+   EXPECT_DOUBLE_EQ(h->GetEntries(), 1000.);
+   EXPECT_DOUBLE_EQ(h->GetBinContent(3), 100.);
+   EXPECT_DOUBLE_EQ(*jittedMax, 1998.);
+   // the event loop did not run in this process
+   EXPECT_EQ(df.GetNRuns(), 0u);
+}
+
+TEST(RDFDistributed, TTree)
+{
+   const std::vector<std::string> fileNames{"dataframe_distributed_0.root", "dataframe_distributed_1.root"};
+   for (auto i = 0u; i < fileNames.size(); ++i) {
+      TFile f(fileNames[i].c_str(), "RECREATE");
+      TTree t("t", "t");
+      t.SetAutoFlush(100); // several clusters per file
+      int v = 0;
+      t.Branch("v", &v);
+      for (v = 0; v < 1000; ++v)
+         t.Fill();
+      t.Write();
+   }
+
+   ROOT::RDataFrame df("t", fileNames);
+   auto sum = df.Sum<int>("v");
+   auto count = df.Filter([](int v) { return v % 2 == 0; }, {"v"}).Count();
+   // not distributed: its result is discarded by the workers and it runs locally when accessed
+   auto localMax = df.Max<int>("v");
+
+   RProcessBackend backend(3);
+   RunDistributed(backend, sum, count);
+
+   EXPECT_DOUBLE_EQ(*sum, 2 * 499500.);
+   EXPECT_EQ(*count, 1000ull);
+   EXPECT_EQ(df.GetNRuns(), 0u);
+   EXPECT_EQ(*localMax, 999);
+   EXPECT_EQ(df.GetNRuns(), 1u);
+   // the distributed results are not recomputed by the local event loop
+   EXPECT_EQ(*count, 1000ull);
+
+   for (const auto &fileName : fileNames)
+      gSystem->Unlink(fileName.c_str());
+}
+
+TEST(RDFDistributed, CustomBackend)
+{
+   ROOT::RDataFrame df(100);
+   auto sum = BookSum(df);
+   RSequentialBackend backend(7, 100);
+   RunDistributed(backend, sum);
+   EXPECT_EQ(backend.fNTasks, 7u);
+   EXPECT_DOUBLE_EQ(*sum, 4950.);
+
+   // there cannot be more tasks than entries
+   ROOT::RDataFrame small(3);
+   auto smallSum = BookSum(small);
+   RSequentialBackend smallBackend(5, 3);
+   RunDistributed(smallBackend, smallSum);
+   EXPECT_EQ(smallBackend.fNTasks, 3u);
+   EXPECT_DOUBLE_EQ(*smallSum, 3.);
+
+   ROOT::RDataFrame other(3);
+   auto otherSum = BookSum(other);
+   EXPECT_THROW(ROOT::RDF::Experimental::RunDistributedTask(3, 5, otherSum), std::runtime_error);
+}
+
+TEST(RDFDistributed, Errors)
+{
+   ROOT::RDataFrame df(10);
+   RProcessBackend backend(2);
+
+   auto count = df.Count();
+   *count;
+   EXPECT_THROW(RunDistributed(backend, count), std::runtime_error);
+
+   ROOT::RDataFrame other(10);
+   auto count1 = df.Count();
+   auto count2 = other.Count();
+   EXPECT_THROW(RunDistributed(backend, count1, count2), std::runtime_error);
+
+   // Take results cannot be merged
+   auto taken = df.Take<ULong64_t>("rdfentry_");
+   EXPECT_THROW(RunDistributed(backend, taken), std::logic_error);
+}
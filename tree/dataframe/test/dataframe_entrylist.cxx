@@ -8,6 +8,7 @@
 #include "gtest/gtest.h"
 
 #include <algorithm> // std::sort
+#include <string>
 #include <vector>
 
 // Write to disk one file for each filename, with TTree "t" with nEntries of branch "e" with increasing values
@@ -104,6 +105,62 @@ void TestChainWithEntryList(bool isMT = false)
    gSystem->Unlink(file2);
 }
 
+void TestCtorWithEntryList(bool isMT = false)
+{
+   const auto nEntries = 10;
+   const auto treename = "t";
+   const std::vector<std::string> files = {"rdfentrylistctor1.root", "rdfentrylistctor2.root", "rdfentrylistctor3.root"};
+   for (auto i = 0u; i < files.size(); ++i)
+      MakeInputFile(files[i], nEntries, /*valueStart=*/i * nEntries);
+
+   RMTRAII gomt(isMT);
+
+   // global entry numbers of the chain
+   TEntryList globalList;
+   globalList.Enter(1);
+   globalList.Enter(nEntries + 2);
+   globalList.Enter(2 * nEntries + 5);
+   auto globalEntries = ROOT::RDataFrame(treename, files, &globalList).Take<int>("e").GetValue();
+   std::sort(globalEntries.begin(), globalEntries.end()); // could be out of order in MT runs
+   EXPECT_EQ(globalEntries, std::vector<int>({1, nEntries + 2, 2 * nEntries + 5}));
+
+   EXPECT_EQ(*ROOT::RDataFrame(treename, files, nullptr).Count(), 3ull * nEntries);
+
+   // one sub-list per file, none of the entries of the second file are selected
+   TEntryList elist1("e", "e", treename, files[0].c_str());
+   elist1.Enter(2);
+   elist1.Enter(5);
+   TEntryList elist3("e", "e", treename, files[2].c_str());
+   elist3.Enter(0);
+   elist3.Enter(nEntries - 1);
+   TEntryList elists;
+   elists.Add(&elist1);
+   elists.Add(&elist3);
+   ROOT::RDataFrame df(treename, files, &elists);
+   auto count = df.Count();
+   auto take = df.Take<int>("e");
+
+   // the files without selected entries are not even opened
+   gSystem->Unlink(files[1].c_str());
+   auto entries = take.GetValue();
+   std::sort(entries.begin(), entries.end());
+   EXPECT_EQ(entries, std::vector<int>({2, 5, 2 * nEntries, 3 * nEntries - 1}));
+   EXPECT_EQ(*count, 4ull);
+
+   // the sub-lists are for other files: nothing is selected
+   TEntryList otherList1("e", "e", treename, "rdfentrylistctor4.root");
+   otherList1.Enter(0);
+   TEntryList otherList2("e", "e", treename, "rdfentrylistctor5.root");
+   otherList2.Enter(0);
+   TEntryList otherLists;
+   otherLists.Add(&otherList1);
+   otherLists.Add(&otherList2);
+   EXPECT_EQ(*ROOT::RDataFrame(treename, files, &otherLists).Count(), 0ull);
+
+   for (const auto &f : files)
+      gSystem->Unlink(f.c_str());
+}
+
 TEST(RDFEntryList, Chain)
 {
    TestChainWithEntryList();
@@ -114,6 +171,11 @@ TEST(RDFEntryList, Tree)
    TestTreeWithEntryList();
 }
 
+TEST(RDFEntryList, Ctor)
+{
+   TestCtorWithEntryList();
+}
+
 #ifdef R__USE_IMT
 TEST(RDFEntryList, ChainMT)
 {
@@ -124,4 +186,9 @@ TEST(RDFEntryList, TreeMT)
 {
    TestTreeWithEntryList(true);
 }
+
+TEST(RDFEntryList, CtorMT)
+{
+   TestCtorWithEntryList(true);
+}
 #endif
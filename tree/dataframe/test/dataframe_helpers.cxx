@@ -4,6 +4,7 @@
 #include <ROOT/RVec.hxx>
 #include <ROOT/RDFHelpers.hxx>
 #include <ROOT/RResultHandle.hxx>
+#include <TInterpreter.h>
 #include <TSystem.h>
 #include <RConfigure.h>
 
@@ -324,6 +325,70 @@ TEST(RDFHelpers, SaveGraphSharedDefines)
    EXPECT_EQ(graph, expected);
 }
 
+TEST(RDFHelpers, JitOptimizationLevel)
+{
+   using ROOT::RDF::Experimental::GetJitOptimizationLevel;
+   using ROOT::RDF::Experimental::SetJitOptimizationLevel;
+
+   EXPECT_EQ(GetJitOptimizationLevel(), -1);
+   EXPECT_THROW(SetJitOptimizationLevel(4), std::runtime_error);
+   EXPECT_THROW(SetJitOptimizationLevel(-2), std::runtime_error);
+
+   SetJitOptimizationLevel(2);
+   EXPECT_EQ(GetJitOptimizationLevel(), 2);
+   ROOT::RDataFrame df(10);
+   auto sum = df.Define("x", "double(rdfentry_) * 2").Filter("x > 5").Sum<double>("x");
+   EXPECT_DOUBLE_EQ(*sum, 84.);
+   SetJitOptimizationLevel(-1);
+}
+
+TEST(RDFHelpers, JitNodeSharing)
+{
+   using ROOT::RDF::Experimental::EnableJitNodeSharing;
+   using ROOT::RDF::Experimental::IsJitNodeSharingEnabled;
+
+   // count how many times the jitted expressions are evaluated
+   gInterpreter->Declare("namespace JitNodeSharing { int nCalls = 0; "
+                         "double Value(ULong64_t e) { ++nCalls; return e; } "
+                         "bool Cut(ULong64_t e) { ++nCalls; return e % 2 == 0; } }");
+   auto nCalls = [] { return static_cast<int>(gInterpreter->Calc("JitNodeSharing::nCalls")); };
+   auto resetCalls = [] { gInterpreter->ProcessLine("JitNodeSharing::nCalls = 0;"); };
+
+   EXPECT_FALSE(IsJitNodeSharingEnabled());
+   for (bool share : {false, true}) {
+      EnableJitNodeSharing(share);
+      EXPECT_EQ(IsJitNodeSharingEnabled(), share);
+      ROOT::RDataFrame df(10);
+
+      // the same Define in two branches of the graph
+      auto s1 = df.Define("x", "JitNodeSharing::Value(rdfentry_)").Sum<double>("x");
+      auto s2 = df.Define("x", "JitNodeSharing::Value(rdfentry_)").Sum<double>("x");
+      resetCalls();
+      EXPECT_DOUBLE_EQ(*s1, 45.);
+      EXPECT_DOUBLE_EQ(*s2, 45.);
+      EXPECT_EQ(nCalls(), share ? 10 : 20);
+
+      // the same unnamed Filter on the same node; named Filters are never shared
+      auto c1 = df.Filter("JitNodeSharing::Cut(rdfentry_)").Count();
+      auto c2 = df.Filter("JitNodeSharing::Cut(rdfentry_)").Count();
+      auto c3 = df.Filter("JitNodeSharing::Cut(rdfentry_)", "named").Count();
+      resetCalls();
+      EXPECT_EQ(*c1, 5ull);
+      EXPECT_EQ(*c2, 5ull);
+      EXPECT_EQ(*c3, 5ull);
+      EXPECT_EQ(nCalls(), share ? 20 : 30);
+
+      // same expression on columns with different definitions: not shared
+      auto d1 = df.Define("y", "2. * rdfentry_");
+      auto d2 = df.Define("y", "3. * rdfentry_");
+      auto z1 = d1.Define("z", "y + 1").Max<double>("z");
+      auto z2 = d2.Define("z", "y + 1").Max<double>("z");
+      EXPECT_DOUBLE_EQ(*z1, 19.);
+      EXPECT_DOUBLE_EQ(*z2, 28.);
+   }
+   EnableJitNodeSharing(false);
+}
+
 TEST(RunGraphs, RunGraphs)
 {
 #ifdef R__USE_IMT
@@ -432,3 +497,146 @@ TEST(RunGraphs, AlreadyRun)
    ROOT_EXPECT_WARNING(ROOT::RDF::RunGraphs({r1, r2, r3, r4}), "RunGraphs",
                        "Got 4 handles from which 2 link to results which are already ready.");
 }
+
+void RunGraphsSharedScan()
+{
+   const auto fileName = "dataframe_helpers_sharedscan.root";
+   ROOT::RDataFrame(100).Define("x", [](ULong64_t e) { return int(e); }, {"rdfentry_"}).Snapshot<int>("t", fileName, {"x"});
+
+   ROOT::RDataFrame df1("t", fileName);
+   auto r1 = df1.Sum<int>("x");
+   auto r2 = df1.Filter([](int x) { return x % 2 == 0; }, {"x"}).Count();
+
+   ROOT::RDataFrame df2("t", fileName);
+   auto r3 = df2.Define("y", [](int x) { return 2 * x; }, {"x"}).Max<int>("y");
+
+   ROOT::RDataFrame df3(10);
+   auto r4 = df3.Count();
+
+   ROOT::RDF::RunGraphs({r1, r2, r3, r4}, /*sharedScan=*/true);
+
+   EXPECT_EQ(df1.GetNRuns(), 1u);
+   EXPECT_EQ(df2.GetNRuns(), 1u);
+   EXPECT_EQ(df3.GetNRuns(), 1u);
+   EXPECT_EQ(*r1, 4950);
+   EXPECT_EQ(*r2, 50u);
+   EXPECT_EQ(*r3, 198);
+   EXPECT_EQ(*r4, 10u);
+
+   // the graphs can be run again with other results, in separate or shared event loops
+   auto r5 = df1.Count();
+   auto r6 = df2.Min<int>("x");
+   ROOT::RDF::RunGraphs({r5, r6}, /*sharedScan=*/true);
+   EXPECT_EQ(*r5, 100u);
+   EXPECT_EQ(*r6, 0);
+   EXPECT_EQ(df1.GetNRuns(), 2u);
+   EXPECT_EQ(df2.GetNRuns(), 2u);
+
+   gSystem->Unlink(fileName);
+}
+
+TEST(RunGraphs, SharedScan)
+{
+#ifdef R__USE_IMT
+   ROOT::DisableImplicitMT();
+#endif // R__USE_IMT
+   RunGraphsSharedScan();
+}
+
+TEST(RunGraphs, SharedScanWithRange)
+{
+#ifdef R__USE_IMT
+   ROOT::DisableImplicitMT();
+#endif // R__USE_IMT
+   const auto fileName = "dataframe_helpers_sharedscan_range.root";
+   ROOT::RDataFrame(100).Define("x", [](ULong64_t e) { return int(e); }, {"rdfentry_"}).Snapshot<int>("t", fileName, {"x"});
+
+   // the graph of df1 stops after 10 entries, the one of df2 processes all of them
+   ROOT::RDataFrame df1("t", fileName);
+   auto r1 = df1.Range(10).Sum<int>("x");
+   ROOT::RDataFrame df2("t", fileName);
+   auto r2 = df2.Sum<int>("x");
+
+   ROOT::RDF::RunGraphs({r1, r2}, /*sharedScan=*/true);
+   EXPECT_EQ(*r1, 45);
+   EXPECT_EQ(*r2, 4950);
+
+   gSystem->Unlink(fileName);
+}
+
+#ifdef R__USE_IMT
+TEST(RunGraphs, SharedScanMT)
+{
+   ROOT::EnableImplicitMT();
+   RunGraphsSharedScan();
+}
+#endif // R__USE_IMT
+
+TEST(RDFHelpers, ConcurrentFill)
+{
+#ifdef R__USE_IMT
+   ROOT::EnableImplicitMT(4);
+#endif // R__USE_IMT
+   auto df = ROOT::RDataFrame(10000)
+                .Define("x", [](ULong64_t e) { return (e % 100) / 10.; }, {"rdfentry_"})
+                .Define("y", [](ULong64_t e) { return (e % 7) * 1.; }, {"rdfentry_"});
+   const ROOT::RDF::TH2DModel model("h", "h", 10, 0., 10., 7, 0., 7.);
+
+   auto hClones = df.Histo2D<double, double>(model, "x", "y");
+   // all the histograms of the TH1 family with at least one bin are filled concurrently
+   ROOT::RDF::Experimental::SetConcurrentFillThreshold(1);
+   EXPECT_EQ(1ull, ROOT::RDF::Experimental::GetConcurrentFillThreshold());
+   auto hShared = df.Histo2D<double, double>(model, "x", "y");
+   auto hSharedW = df.Histo2D<double, double, double>(model, "x", "y", "x");
+   auto h1Shared = df.Histo1D<double>({"h1", "h1", 10, 0., 10.}, "x");
+   ROOT::RDF::Experimental::SetConcurrentFillThreshold(0);
+
+   EXPECT_EQ(hClones->GetEntries(), hShared->GetEntries());
+   EXPECT_EQ(hClones->GetEntries(), hSharedW->GetEntries());
+   EXPECT_EQ(10000., h1Shared->GetEntries());
+   for (int binx = 0; binx <= 11; ++binx) {
+      EXPECT_EQ(binx == 0 || binx == 11 ? 0. : 1000., h1Shared->GetBinContent(binx));
+      for (int biny = 0; biny <= 8; ++biny)
+         EXPECT_EQ(hClones->GetBinContent(binx, biny), hShared->GetBinContent(binx, biny));
+   }
+   EXPECT_DOUBLE_EQ(hClones->GetMean(1), hShared->GetMean(1));
+   const auto sumX = df.Sum<double>("x").GetValue();
+   EXPECT_NEAR(sumX, hSharedW->Integral(), 1e-9 * sumX);
+
+#ifdef R__USE_IMT
+   ROOT::DisableImplicitMT();
+#endif // R__USE_IMT
+}
+
+// With concurrent filling the partial results are copies of the shared histogram
+TEST(RDFHelpers, ConcurrentFillPartialResult)
+{
+#ifdef R__USE_IMT
+   ROOT::EnableImplicitMT(4);
+#endif // R__USE_IMT
+   ROOT::RDataFrame df(100000);
+   auto dfx = df.Define("x", [](ULong64_t e) { return (e % 100) / 10.; }, {"rdfentry_"});
+   ROOT::RDF::Experimental::SetConcurrentFillThreshold(1);
+   auto h = dfx.Histo2D<double, double>({"h", "h", 10, 0., 10., 10, 0., 10.}, "x", "x");
+   ROOT::RDF::Experimental::SetConcurrentFillThreshold(0);
+
+   std::vector<double> lastEntries(df.GetNSlots(), 0.);
+   std::vector<const TH2D *> partials(df.GetNSlots(), nullptr);
+   bool ok = true;
+   h.OnPartialResultSlot(1000, [&](unsigned int slot, TH2D &partial) {
+      // the entries of the shared histogram only grow, and the copy is not the final result
+      ok = ok && partial.GetEntries() >= lastEntries[slot] && partial.GetEntries() <= 100000. &&
+           partial.GetDirectory() == nullptr;
+      lastEntries[slot] = partial.GetEntries();
+      partials[slot] = &partial;
+   });
+
+   EXPECT_EQ(100000., h->GetEntries());
+   EXPECT_TRUE(ok);
+   for (auto p : partials)
+      EXPECT_NE(p, h.GetPtr());
+
+#ifdef R__USE_IMT
+   ROOT::DisableImplicitMT();
+#endif // R__USE_IMT
+}
@@ -1,5 +1,6 @@
 #include "ROOT/RDataFrame.hxx"
 #include "ROOT/TSeq.hxx"
+#include "TROOT.h"
 
 #include "gtest/gtest.h"
 
@@ -285,3 +286,32 @@ TEST(RDataFrameHisto, FillVecBool)
     EXPECT_EQ(h->GetBinContent(2), n);
     EXPECT_EQ(h->GetBinContent(3), 0u);
 }
+
+#ifdef R__USE_IMT
+// histograms without a model are binned and filled in the same way whatever the number of threads
+TEST(RDataFrameHisto, AutoBinningMT)
+{
+   auto fill = [] {
+      ROOT::RDataFrame df(10000);
+      auto h = df.Define("x", [](ULong64_t e) { return std::sin(e * 0.7) * 3. + e * 1e-4; }, {"rdfentry_"})
+                  .Define("w", [](ULong64_t e) { return 1. + (e % 7) * 0.1; }, {"rdfentry_"})
+                  .Histo1D<double, double>("x", "w");
+      return TH1D(*h);
+   };
+   const auto seq = fill();
+   ROOT::EnableImplicitMT(4);
+   const auto mt = fill();
+   ROOT::DisableImplicitMT();
+
+   ASSERT_EQ(seq.GetNbinsX(), mt.GetNbinsX());
+   EXPECT_EQ(seq.GetXaxis()->GetXmin(), mt.GetXaxis()->GetXmin());
+   EXPECT_EQ(seq.GetXaxis()->GetXmax(), mt.GetXaxis()->GetXmax());
+   for (int i = 0; i <= seq.GetNbinsX() + 1; ++i) {
+      EXPECT_EQ(seq.GetBinContent(i), mt.GetBinContent(i));
+      EXPECT_EQ(seq.GetBinError(i), mt.GetBinError(i));
+   }
+   EXPECT_EQ(seq.GetEntries(), mt.GetEntries());
+   EXPECT_EQ(seq.GetMean(), mt.GetMean());
+   EXPECT_EQ(seq.GetStdDev(), mt.GetStdDev());
+}
+#endif
@@ -3,6 +3,7 @@
 
 #include "ROOT/RCsvDS.hxx"
 #include "ROOT/RDataFrame.hxx"
+#include "ROOT/RLogger.hxx"
 #include "ROOT/RStringView.hxx"
 #include "ROOT/RTrivialDS.hxx"
 #include "TMemFile.h"
@@ -11,6 +12,8 @@
 
 #include "gtest/gtest.h"
 
+#include <cstdio>
+#include <memory>
 #include <thread>
 
 using namespace ROOT;
@@ -385,6 +388,63 @@ TEST(RDataFrameInterface, UnusedJittedNodes)
    df.Foreach([]{}); // crashes if ROOT-10619 not fixed
 }
 
+namespace {
+/// Collect the number of pieces of code already compiled, and the total number of pieces of code, reported by each
+/// jitting phase of RDataFrame
+class JitCountHandler : public ROOT::Experimental::RLogHandler {
+   std::vector<std::pair<unsigned int, unsigned int>> &fCounts;
+
+public:
+   JitCountHandler(std::vector<std::pair<unsigned int, unsigned int>> &counts) : fCounts(counts) {}
+   bool Emit(const ROOT::Experimental::RLogEntry &entry) override
+   {
+      const auto pos = entry.fMessage.find(" pieces of code were already compiled");
+      if (entry.fChannel != &ROOT::Detail::RDF::RDFLogChannel() || pos == std::string::npos)
+         return true;
+      const auto start = entry.fMessage.rfind(", ", pos) + 2;
+      unsigned int nCompiled = 0, nCode = 0;
+      EXPECT_EQ(2, std::sscanf(entry.fMessage.c_str() + start, "%u of the %u", &nCompiled, &nCode));
+      fCounts.emplace_back(nCompiled, nCode);
+      return false;
+   }
+};
+} // namespace
+
+// the code jitted for the second graph only differs by the addresses of its nodes, it is not compiled again
+TEST(RDataFrameInterface, JittedGraphBuiltTwice)
+{
+   std::vector<std::pair<unsigned int, unsigned int>> counts;
+   auto handler = std::make_unique<JitCountHandler>(counts);
+   auto handlerPtr = handler.get();
+   ROOT::Experimental::RLogManager::Get().PushFront(std::move(handler));
+   ROOT::Experimental::RLogScopedVerbosity verbosity(ROOT::Detail::RDF::RDFLogChannel(),
+                                                     ROOT::Experimental::ELogLevel::kInfo);
+
+   for (auto nEntries : {10ull, 20ull}) {
+      ROOT::RDataFrame df(nEntries);
+      auto d = df.Define("x", "double(rdfentry_)").Filter("x > 4", "xcut");
+      auto sum = d.Sum("x");
+      auto max = d.Max("x");
+      auto count = d.Count();
+      EXPECT_DOUBLE_EQ(*sum, (4. + nEntries) * (nEntries - 5) / 2.);
+      EXPECT_DOUBLE_EQ(*max, nEntries - 1.);
+      EXPECT_EQ(*count, nEntries - 5);
+   }
+   // same code, other expression
+   ROOT::RDataFrame df(10);
+   EXPECT_EQ(*df.Define("x", "double(rdfentry_)").Filter("x > 6", "xcut").Count(), 3ull);
+
+   ROOT::Experimental::RLogManager::Get().Remove(handlerPtr);
+
+   // the second graph was jitted without declaring any new code, the third one only needed its new Filter
+   ASSERT_EQ(counts.size(), 3u);
+   EXPECT_GT(counts[0].second, 0u);
+   EXPECT_EQ(counts[1].first, counts[1].second);
+   EXPECT_EQ(counts[1].second, counts[0].second);
+   EXPECT_GT(counts[2].first, 0u);
+   EXPECT_LT(counts[2].first, counts[2].second);
+}
+
 #define EXPECT_RUNTIME_ERROR_WITH_MSG(expr, msg) \
    try { expr; } catch (const std::runtime_error &e) {\
       EXPECT_STREQ(e.what(), msg);\
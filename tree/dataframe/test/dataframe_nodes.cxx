@@ -5,8 +5,11 @@
 #include <TStatistic.h> // To check reading of columns with types which are mothers of the column type
 #include <TSystem.h>
 
+#include <algorithm>
+#include <atomic>
 #include <mutex>
 #include <thread>
+#include <vector>
 #include <stdexcept> // std::runtime_error
 
 #include "gtest/gtest.h"
@@ -44,6 +47,55 @@ TEST(RDataFrameNodes, RSlotStackPutBackTooMany)
 
 #endif
 
+TEST(RDataFrameNodes, RSlotStackSameSlotForSameThread)
+{
+   ROOT::Internal::RDF::RSlotStack s(100);
+   const auto slot0 = s.GetSlot();
+   const auto slot1 = s.GetSlot();
+   EXPECT_NE(slot0, slot1);
+   s.ReturnSlot(slot1);
+   s.ReturnSlot(slot0);
+   // the slot given back last by this thread comes first
+   EXPECT_EQ(s.GetSlot(), slot0);
+   EXPECT_EQ(s.GetSlot(), slot1);
+}
+
+TEST(RDataFrameNodes, RSlotStackConcurrentUse)
+{
+   // more slots than bits in a word of the bitmap
+   const unsigned int nSlots = 70;
+   ROOT::Internal::RDF::RSlotStack s(nSlots);
+   std::vector<std::atomic<int>> users(nSlots);
+   std::atomic<int> nErrors{0};
+   std::vector<std::thread> ts;
+   for (unsigned int t = 0; t < nSlots; ++t) {
+      ts.emplace_back([&]() {
+         for (int i = 0; i < 1000; ++i) {
+            const auto slot = s.GetSlot();
+            if (slot >= nSlots) {
+               ++nErrors;
+               continue;
+            }
+            if (users[slot]++ != 0)
+               ++nErrors;
+            --users[slot];
+            s.ReturnSlot(slot);
+         }
+      });
+   }
+   for (auto &&t : ts)
+      t.join();
+   EXPECT_EQ(nErrors, 0);
+
+   // all slots are free again
+   std::vector<unsigned int> slots;
+   for (unsigned int i = 0; i < nSlots; ++i)
+      slots.emplace_back(s.GetSlot());
+   std::sort(slots.begin(), slots.end());
+   for (unsigned int i = 0; i < nSlots; ++i)
+      EXPECT_EQ(slots[i], i);
+}
+
 TEST(RDataFrameNodes, RLoopManagerGetLoopManagerUnchecked)
 {
    ROOT::Detail::RDF::RLoopManager lm(nullptr, {});
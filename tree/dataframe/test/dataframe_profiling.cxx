@@ -0,0 +1,173 @@
+#include <ROOT/RDataFrame.hxx>
+#include <ROOT/RDFHelpers.hxx>
+#include <ROOT/RVec.hxx>
+#include <TFile.h>
+#include <TROOT.h>
+#include <TSystem.h>
+#include <TTree.h>
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+static const ROOT::RDF::RNodeProfileInfo &
+GetNode(const ROOT::RDF::RProfileReport &report, const std::string &kind, const std::string &name)
+{
+   auto it = std::find_if(report.begin(), report.end(), [&](const ROOT::RDF::RNodeProfileInfo &n) {
+      return n.GetKind() == kind && n.GetName() == name;
+   });
+   if (it == report.end())
+      throw std::runtime_error("no " + kind + " called " + name + " in the profile report");
+   return *it;
+}
+
+TEST(RDFProfiling, Disabled)
+{
+   ROOT::RDataFrame df(10);
+   auto c = df.Define("x", [] { return 1; }).Filter([](int x) { return x > 0; }, {"x"}, "f").Count();
+   EXPECT_EQ(*c, 10ull);
+
+   const auto report = df.GetProfileReport();
+   EXPECT_EQ(report.size(), 3u);
+   for (const auto &n : report) {
+      EXPECT_EQ(n.GetEntries(), 0ull);
+      EXPECT_EQ(n.GetTime(), 0.);
+   }
+}
+
+TEST(RDFProfiling, EmptySource)
+{
+   ROOT::RDataFrame df(100);
+   df.EnableProfiling();
+   auto x = df.Define("x", [](ULong64_t e) { return int(e); }, {"rdfentry_"});
+   auto y = x.Define("y", [](int v) { return v * 2; }, {"x"});
+   auto f = y.Filter([](int v) { return v % 2 == 0; }, {"x"}, "even");
+   auto count = f.Count();
+   auto sum = f.Sum<int>("y");
+   auto jitted = x.Filter("x > 89", "jitted").Count();
+
+   EXPECT_EQ(*count, 50ull);
+   EXPECT_EQ(*sum, 4900);
+   EXPECT_EQ(*jitted, 10ull);
+
+   const auto report = df.GetProfileReport();
+   EXPECT_EQ(GetNode(report, "Define", "x").GetEntries(), 100ull);
+   // y is only evaluated for the entries that pass the filter
+   EXPECT_EQ(GetNode(report, "Define", "y").GetEntries(), 50ull);
+   EXPECT_EQ(GetNode(report, "Filter", "even").GetEntries(), 100ull);
+   EXPECT_EQ(GetNode(report, "Filter", "jitted").GetEntries(), 100ull);
+   EXPECT_EQ(GetNode(report, "Action", "Sum").GetEntries(), 50ull);
+   for (const auto &n : report) {
+      EXPECT_GE(n.GetTime(), 0.);
+      EXPECT_EQ(n.GetSlotEntries().size(), df.GetNSlots());
+      // there are no columns read from the dataset
+      EXPECT_TRUE(n.GetColumns().empty());
+   }
+
+   // the counters accumulate over the event loops run with profiling enabled
+   auto count2 = f.Count();
+   EXPECT_EQ(*count2, 50ull);
+   EXPECT_EQ(GetNode(df.GetProfileReport(), "Filter", "even").GetEntries(), 200ull);
+
+   df.EnableProfiling(false);
+   auto count3 = f.Count();
+   EXPECT_EQ(*count3, 50ull);
+   EXPECT_EQ(GetNode(df.GetProfileReport(), "Filter", "even").GetEntries(), 200ull);
+}
+
+TEST(RDFProfiling, ColumnsRead)
+{
+   const auto fname = "dataframe_profiling_columnsread.root";
+   {
+      TFile f(fname, "RECREATE");
+      TTree t("t", "t");
+      int i = 0;
+      std::vector<float> v;
+      t.Branch("i", &i);
+      t.Branch("v", &v);
+      for (i = 0; i < 20; ++i) {
+         v.assign(i % 3, 1.f);
+         t.Fill();
+      }
+      t.Write();
+   }
+
+   ROOT::RDataFrame df("t", fname);
+   df.EnableProfiling();
+   auto sumI = df.Filter([](int i) { return i >= 10; }, {"i"}, "cut").Sum<int>("i");
+   auto sizes = df.Define("n", [](const ROOT::RVec<float> &v) { return int(v.size()); }, {"v"}).Sum<int>("n");
+   EXPECT_EQ(*sumI, 145);
+   EXPECT_EQ(*sizes, 19);
+
+   const auto report = df.GetProfileReport();
+   const auto &cutColumns = GetNode(report, "Filter", "cut").GetColumns();
+   ASSERT_EQ(cutColumns.size(), 1u);
+   EXPECT_EQ(cutColumns[0].GetName(), "i");
+   EXPECT_EQ(cutColumns[0].GetNValues(), 20ull);
+   EXPECT_EQ(cutColumns[0].GetNBytes(), 20ull * sizeof(int));
+
+   const auto &nColumns = GetNode(report, "Define", "n").GetColumns();
+   ASSERT_EQ(nColumns.size(), 1u);
+   EXPECT_EQ(nColumns[0].GetNValues(), 20ull);
+   EXPECT_EQ(nColumns[0].GetNBytes(), 20ull * sizeof(ROOT::RVec<float>) + 19ull * sizeof(float));
+
+   // the Sum over the defined column "n" does not read from the dataset
+   for (const auto &n : report) {
+      if (n.GetKind() == "Action" && n.GetColumns().empty()) {
+         EXPECT_EQ(n.GetEntries(), 20ull);
+      }
+   }
+
+   gSystem->Unlink(fname);
+}
+
+TEST(RDFProfiling, Batched)
+{
+   ROOT::RDataFrame df(100);
+   df.SetBatchSize(16);
+   df.EnableProfiling();
+   auto f = df.Define("x", [](ULong64_t e) { return int(e); }, {"rdfentry_"})
+               .Filter([](int x) { return x < 30; }, {"x"}, "lt30");
+   auto sum = f.Sum<int>("x");
+   EXPECT_EQ(*sum, 435);
+
+   const auto report = df.GetProfileReport();
+   EXPECT_EQ(GetNode(report, "Define", "x").GetEntries(), 100ull);
+   EXPECT_EQ(GetNode(report, "Filter", "lt30").GetEntries(), 100ull);
+   EXPECT_EQ(GetNode(report, "Action", "Sum").GetEntries(), 30ull);
+}
+
+TEST(RDFProfiling, SaveGraph)
+{
+   ROOT::RDataFrame df(10);
+   df.EnableProfiling();
+   auto c = df.Define("x", [] { return 1; }).Filter([](int x) { return x > 0; }, {"x"}, "f").Count();
+   EXPECT_EQ(ROOT::RDF::SaveGraph(df).find("entries"), std::string::npos);
+   *c;
+   const auto graph = ROOT::RDF::SaveGraph(df);
+   EXPECT_NE(graph.find("f\n"), std::string::npos);
+   EXPECT_NE(graph.find("10 entries"), std::string::npos);
+}
+
+#ifdef R__USE_IMT
+TEST(RDFProfiling, MultiThread)
+{
+   ROOT::EnableImplicitMT(4);
+   {
+      ROOT::RDataFrame df(1000);
+      df.EnableProfiling();
+      auto c = df.Define("x", [](ULong64_t e) { return int(e); }, {"rdfentry_"})
+                  .Filter([](int x) { return x % 10 == 0; }, {"x"}, "mod10")
+                  .Count();
+      EXPECT_EQ(*c, 100ull);
+
+      const auto &filter = GetNode(df.GetProfileReport(), "Filter", "mod10");
+      EXPECT_EQ(filter.GetEntries(), 1000ull);
+      EXPECT_EQ(filter.GetSlotEntries().size(), df.GetNSlots());
+   }
+   ROOT::DisableImplicitMT();
+}
+#endif
@@ -1,5 +1,6 @@
 #include "ROOT/RDataFrame.hxx"
 #include <TROOT.h>
+#include <TSystem.h>
 
 #include "gtest/gtest.h"
 
@@ -97,12 +98,64 @@ TEST(RDFRangesMT, ThrowIfIMT)
    ROOT::EnableImplicitMT();
    RDataFrame d(0);
    try {
-      d.Range(0);
+      d.Range(0, 10, 2);
    } catch (const std::exception &e) {
       hasThrown = true;
-      EXPECT_STREQ(e.what(), "Range was called with ImplicitMT enabled, but multi-thread is not supported.");
+      EXPECT_STREQ(e.what(), "Range was called with ImplicitMT enabled, but multi-thread event loops only support "
+                             "ranges of contiguous entries booked directly on the RDataFrame.");
    }
    EXPECT_TRUE(hasThrown);
+   EXPECT_THROW(d.Range(10).Range(5), std::runtime_error);
+   EXPECT_THROW(d.Filter([] { return true; }).Range(5), std::runtime_error);
+   ROOT::DisableImplicitMT();
+}
+
+TEST(RDFRangesMT, EmptySource)
+{
+   ROOT::EnableImplicitMT(4);
+   RDataFrame d(100);
+   auto df = d.Define("x", [](ULong64_t e) { return e; }, {"rdfentry_"});
+   auto c = df.Range(10, 50).Count();
+   auto s = df.Range(10, 50).Sum<ULong64_t>("x");
+   auto m = df.Range(90, 0).Min<ULong64_t>("x");
+   EXPECT_EQ(*c, 40u);
+   EXPECT_EQ(*s, (10u + 49u) * 40u / 2u);
+   EXPECT_EQ(*m, 90u);
+   EXPECT_EQ(d.GetNRuns(), 1u);
+
+   // a result not downstream of the range: all entries are processed
+   auto c10 = df.Range(10).Count();
+   auto all = df.Count();
+   EXPECT_EQ(*c10, 10u);
+   EXPECT_EQ(*all, 100u);
+   ROOT::DisableImplicitMT();
+}
+
+TEST(RDFRangesMT, Tree)
+{
+   const std::vector<std::string> fileNames{"dataframe_ranges_mt_0.root", "dataframe_ranges_mt_1.root",
+                                            "dataframe_ranges_mt_2.root"};
+   for (auto i = 0u; i < fileNames.size(); ++i) {
+      RDataFrame(100)
+         .Define("x", [i](ULong64_t e) { return int(100 * i + e); }, {"rdfentry_"})
+         .Snapshot<int>("t", fileNames[i], {"x"});
+   }
+
+   ROOT::EnableImplicitMT(4);
+   {
+      RDataFrame d("t", fileNames);
+      auto r = d.Range(150, 220);
+      auto c = r.Count();
+      auto min = r.Min<int>("x");
+      auto max = r.Max<int>("x");
+      EXPECT_EQ(*c, 70u);
+      EXPECT_EQ(*min, 150);
+      EXPECT_EQ(*max, 219);
+   }
+   ROOT::DisableImplicitMT();
+
+   for (const auto &f : fileNames)
+      gSystem->Unlink(f.c_str());
 }
 #endif
 
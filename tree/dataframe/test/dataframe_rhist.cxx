@@ -0,0 +1,71 @@
+#include <ROOT/RDataFrame.hxx>
+#include <ROOT/RDF/RHistFillHelper.hxx>
+#include <ROOT/RHist.hxx>
+#include <ROOT/RVec.hxx>
+#include <TROOT.h>
+
+#include <gtest/gtest.h>
+
+#include <memory>
+
+using ROOT::Experimental::RAxisConfig;
+using ROOT::Experimental::RH1D;
+using ROOT::Experimental::RH2D;
+using ROOT::RDF::Experimental::RHistFillHelper;
+
+// Fill the same histogram with RHistFillHelper and with one Fill call per entry
+static void CheckFill(ROOT::RDataFrame &df)
+{
+   auto defs = df.Define("x", [](ULong64_t e) { return 0.001 * (e % 1200); }, {"rdfentry_"})
+                  .Define("y", [](double x) { return 2. * x - 0.5; }, {"x"})
+                  .Define("w", [](ULong64_t e) { return 1. + (e % 3); }, {"rdfentry_"})
+                  .Define("v", [](double x) { return ROOT::RVec<double>{x, x + 0.1}; }, {"x"});
+
+   const RAxisConfig xaxis(50, 0., 1.);
+   const RAxisConfig yaxis(std::vector<double>{-0.5, 0., 0.5, 1., 2.});
+   auto h2 = defs.Book<double, double, double>(RHistFillHelper<RH2D>(std::make_shared<RH2D>(xaxis, yaxis),
+                                                                     df.GetNSlots()),
+                                              {"x", "y", "w"});
+   auto h1 = defs.Book<ROOT::RVec<double>>(RHistFillHelper<RH1D>(std::make_shared<RH1D>(xaxis), df.GetNSlots()),
+                                           {"v"});
+
+   RH2D expected2(xaxis, yaxis);
+   RH1D expected1(xaxis);
+   for (ULong64_t e = 0; e < 10000; ++e) {
+      const double x = 0.001 * (e % 1200);
+      expected2.Fill({x, 2. * x - 0.5}, 1. + (e % 3));
+      expected1.Fill({x});
+      expected1.Fill({x + 0.1});
+   }
+
+   EXPECT_EQ(expected2.GetEntries(), h2->GetEntries());
+   EXPECT_EQ(expected1.GetEntries(), h1->GetEntries());
+   const auto &impl2 = *h2->GetImpl();
+   for (int bin = -impl2.GetNOverflowBins(); bin <= impl2.GetNBinsNoOver(); ++bin) {
+      if (bin != 0) {
+         EXPECT_DOUBLE_EQ(expected2.GetImpl()->GetBinContent(bin), impl2.GetBinContent(bin)) << "bin " << bin;
+      }
+   }
+   const auto &impl1 = *h1->GetImpl();
+   for (int bin = -impl1.GetNOverflowBins(); bin <= impl1.GetNBinsNoOver(); ++bin) {
+      if (bin != 0) {
+         EXPECT_DOUBLE_EQ(expected1.GetImpl()->GetBinContent(bin), impl1.GetBinContent(bin)) << "bin " << bin;
+      }
+   }
+}
+
+TEST(RDFRHist, Fill)
+{
+   ROOT::RDataFrame df(10000);
+   CheckFill(df);
+}
+
+#ifdef R__USE_IMT
+TEST(RDFRHist, FillMT)
+{
+   ROOT::EnableImplicitMT(4);
+   ROOT::RDataFrame df(10000);
+   CheckFill(df);
+   ROOT::DisableImplicitMT();
+}
+#endif
@@ -977,6 +977,58 @@ TEST_P(RDFSimpleTests, FillWithCustomClassJitted)
    EXPECT_EQ(h.GetEntries(), 10);
 }
 
+// Scalars and fixed-size arrays of basic types are read basket by basket, see RTreeBulkReader
+TEST_P(RDFSimpleTests, BulkReadFixedSizeBranches)
+{
+   const std::vector<std::string> fileNames{"dataframe_simple_bulkread_0.root", "dataframe_simple_bulkread_1.root"};
+   const int nEntriesPerFile = 5000;
+   for (std::size_t f = 0; f < fileNames.size(); ++f) {
+      TFile file(fileNames[f].c_str(), "RECREATE");
+      TTree t("t", "t");
+      t.SetAutoFlush(1000);
+      float x;
+      Long64_t idx;
+      float arr[3];
+      int n;
+      float var[2];
+      t.Branch("x", &x);
+      t.Branch("idx", &idx);
+      t.Branch("arr", arr, "arr[3]/F");
+      t.Branch("n", &n);
+      t.Branch("var", var, "var[n]/F");
+      for (int i = 0; i < nEntriesPerFile; ++i) {
+         idx = f * nEntriesPerFile + i;
+         x = idx * 0.5f;
+         arr[0] = idx;
+         arr[1] = -idx;
+         arr[2] = 2 * idx;
+         n = i % 2 + 1;
+         var[0] = var[1] = idx;
+         t.Fill();
+      }
+      t.Write();
+   }
+
+   TChain c("t");
+   for (const auto &fileName : fileNames)
+      c.Add(fileName.c_str());
+   RDataFrame df(c);
+   auto nGood = df.Filter([](Long64_t idx, float x, const RVec<float> &arr, const RVec<float> &var) {
+                       return x == idx * 0.5f && arr.size() == 3 && arr[0] == idx && arr[1] == -idx &&
+                              arr[2] == 2 * idx && var.size() == std::size_t(idx % 2 + 1) && var[0] == idx;
+                    },
+                    {"idx", "x", "arr", "var"})
+                   .Count();
+   auto maxX = df.Max<float>("x");
+   auto maxIdx = df.Max<Long64_t>("idx");
+   EXPECT_EQ(2u * nEntriesPerFile, *nGood);
+   EXPECT_FLOAT_EQ(0.5f * (2 * nEntriesPerFile - 1), *maxX);
+   EXPECT_EQ(2 * nEntriesPerFile - 1, *maxIdx);
+
+   for (const auto &fileName : fileNames)
+      gSystem->Unlink(fileName.c_str());
+}
+
 // run single-thread tests
 INSTANTIATE_TEST_SUITE_P(Seq, RDFSimpleTests, ::testing::Values(false));
 
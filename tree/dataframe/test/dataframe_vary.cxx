@@ -0,0 +1,191 @@
+#include <ROOT/RDataFrame.hxx>
+#include <ROOT/RDFHelpers.hxx>
+#include <ROOT/RVec.hxx>
+#include <TH1D.h>
+
+#include <gtest/gtest.h>
+
+#include <iterator> // std::distance
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using RVecD = ROOT::RVec<double>;
+using ROOT::RDF::Experimental::VariationsFor;
+
+static ROOT::RDF::RNode MakeVariedDF()
+{
+   return ROOT::RDataFrame(10)
+      .Define("x", [](ULong64_t e) { return double(e); }, {"rdfentry_"})
+      .Define("y", [] { return 1.; })
+      .Vary("x", [](double x) { return RVecD{x * 2., x * 3.}; }, {"x"}, {"down", "up"});
+}
+
+TEST(Vary, SimpleSum)
+{
+   auto df = MakeVariedDF();
+   auto nominal = df.Sum<double>("x");
+   auto sums = VariationsFor(nominal);
+
+   const std::vector<std::string> expectedKeys{"nominal", "x:down", "x:up"};
+   EXPECT_EQ(sums.GetKeys(), expectedKeys);
+   EXPECT_DOUBLE_EQ(sums["nominal"], 45.);
+   EXPECT_DOUBLE_EQ(sums["x:down"], 90.);
+   EXPECT_DOUBLE_EQ(sums["x:up"], 135.);
+   EXPECT_DOUBLE_EQ(*nominal, 45.);
+   EXPECT_EQ(df.GetNRuns(), 1u);
+}
+
+TEST(Vary, SeveralActionsOneLoop)
+{
+   auto df = MakeVariedDF();
+   auto maxs = VariationsFor(df.Max<double>("x"));
+   auto means = VariationsFor(df.Mean<double>("x"));
+   // the weights are not varied: they are read as for the nominal result
+   auto histos = VariationsFor(df.Histo1D<double, double>({"h", "h", 40, 0., 40.}, "x", "y"));
+
+   EXPECT_DOUBLE_EQ(maxs["x:up"], 27.);
+   EXPECT_DOUBLE_EQ(maxs["x:down"], 18.);
+   EXPECT_DOUBLE_EQ(means["x:up"], 13.5);
+   EXPECT_DOUBLE_EQ(histos["nominal"].GetMean(), 4.5);
+   EXPECT_DOUBLE_EQ(histos["x:up"].GetMean(), 13.5);
+   EXPECT_DOUBLE_EQ(histos["x:down"].GetSumOfWeights(), 10.);
+   EXPECT_EQ(df.GetNRuns(), 1u);
+}
+
+TEST(Vary, Jitted)
+{
+   auto df = MakeVariedDF();
+   auto histos = VariationsFor(df.Histo1D({"h", "h", 40, 0., 40.}, "x"));
+   EXPECT_DOUBLE_EQ(histos["nominal"].GetMean(), 4.5);
+   EXPECT_DOUBLE_EQ(histos["x:down"].GetMean(), 9.);
+}
+
+TEST(Vary, SameVariationForTwoColumns)
+{
+   auto df = ROOT::RDataFrame(4)
+                .Define("x", [] { return 1.; })
+                .Define("w", [] { return 1.; })
+                .Vary("x", [](double x) { return RVecD{x - 1., x + 1.}; }, {"x"}, {"down", "up"}, "syst")
+                .Vary("w", [](double w) { return RVecD{w * 0.5, w * 2.}; }, {"w"}, {"down", "up"}, "syst");
+   auto histos = VariationsFor(df.Histo1D<double, double>({"h", "h", 10, 0., 10.}, "x", "w"));
+
+   const std::vector<std::string> expectedKeys{"nominal", "syst:down", "syst:up"};
+   EXPECT_EQ(histos.GetKeys(), expectedKeys);
+   EXPECT_DOUBLE_EQ(histos["nominal"].GetSumOfWeights(), 4.);
+   EXPECT_DOUBLE_EQ(histos["syst:down"].GetSumOfWeights(), 2.);
+   EXPECT_DOUBLE_EQ(histos["syst:up"].GetSumOfWeights(), 8.);
+   EXPECT_DOUBLE_EQ(histos["syst:up"].GetMean(), 2.);
+
+   EXPECT_THROW(df.Define("z", [] { return 1.; })
+                   .Vary("z", [](double z) { return RVecD{z}; }, {"z"}, {"other"}, "syst"),
+                std::runtime_error);
+}
+
+TEST(Vary, DefineFilterHisto)
+{
+   auto df = MakeVariedDF()
+                .Define("z", [](double x) { return x + 1.; }, {"x"})
+                .Filter([](double z) { return z > 5.; }, {"z"});
+   auto histos = VariationsFor(df.Histo1D<double>({"h", "h", 40, 0., 40.}, "z"));
+   auto counts = VariationsFor(df.Count());
+
+   const std::vector<std::string> expectedKeys{"nominal", "x:down", "x:up"};
+   EXPECT_EQ(histos.GetKeys(), expectedKeys);
+   EXPECT_EQ(counts.GetKeys(), expectedKeys);
+   // nominal: z = 1..10, down: z = 1, 3, .., 19, up: z = 1, 4, .., 28
+   EXPECT_DOUBLE_EQ(histos["nominal"].GetEntries(), 5.);
+   EXPECT_DOUBLE_EQ(histos["nominal"].GetMean(), 8.);
+   EXPECT_DOUBLE_EQ(histos["x:down"].GetEntries(), 7.);
+   EXPECT_DOUBLE_EQ(histos["x:down"].GetMean(), 13.);
+   EXPECT_DOUBLE_EQ(histos["x:up"].GetEntries(), 8.);
+   EXPECT_DOUBLE_EQ(histos["x:up"].GetMean(), 17.5);
+   EXPECT_EQ(counts["nominal"], 5ull);
+   EXPECT_EQ(counts["x:down"], 7ull);
+   EXPECT_EQ(counts["x:up"], 8ull);
+   EXPECT_EQ(df.GetNRuns(), 1u);
+}
+
+TEST(Vary, JittedVaryDefineFilter)
+{
+   auto df = ROOT::RDataFrame(10)
+                .Define("x", "double(rdfentry_)")
+                .Vary("x", "ROOT::RVecD{x * 2., x * 3.}", {"down", "up"})
+                .Define("z", "x + 1.")
+                .Filter("z > 5.");
+   auto histos = VariationsFor(df.Histo1D({"h", "h", 40, 0., 40.}, "z"));
+
+   const std::vector<std::string> expectedKeys{"nominal", "x:down", "x:up"};
+   EXPECT_EQ(histos.GetKeys(), expectedKeys);
+   EXPECT_DOUBLE_EQ(histos["nominal"].GetMean(), 8.);
+   EXPECT_DOUBLE_EQ(histos["x:down"].GetEntries(), 7.);
+   EXPECT_DOUBLE_EQ(histos["x:down"].GetMean(), 13.);
+   EXPECT_DOUBLE_EQ(histos["x:up"].GetEntries(), 8.);
+   EXPECT_DOUBLE_EQ(histos["x:up"].GetMean(), 17.5);
+}
+
+TEST(Vary, VariedFilterOnly)
+{
+   // the action does not read varied columns, but the entries it processes depend on the variation
+   auto df = MakeVariedDF().Filter([](double x) { return x < 6.; }, {"x"}, "xcut");
+   auto sums = VariationsFor(df.Sum<double>("y"));
+   EXPECT_DOUBLE_EQ(sums["nominal"], 6.);
+   EXPECT_DOUBLE_EQ(sums["x:down"], 3.);
+   EXPECT_DOUBLE_EQ(sums["x:up"], 2.);
+
+   // varied copies of the filters do not appear in the cut-flow report
+   auto report = df.Report();
+   EXPECT_EQ(report->At("xcut").GetPass(), 6ull);
+   EXPECT_EQ(std::distance(report->begin(), report->end()), 1);
+}
+
+TEST(Vary, VariedRange)
+{
+   auto df = MakeVariedDF().Filter([](double x) { return x > 2.; }, {"x"}).Range(3);
+   auto sums = VariationsFor(df.Sum<double>("x"));
+   EXPECT_DOUBLE_EQ(sums["nominal"], 12.); // 3 + 4 + 5
+   EXPECT_DOUBLE_EQ(sums["x:down"], 18.);  // 4 + 6 + 8
+   EXPECT_DOUBLE_EQ(sums["x:up"], 18.);    // 3 + 6 + 9
+}
+
+TEST(Vary, TwoVariations)
+{
+   auto df = ROOT::RDataFrame(4)
+                .Define("x", [] { return 1.; })
+                .Define("y", [] { return 10.; })
+                .Vary("x", [](double x) { return RVecD{x - 1., x + 1.}; }, {"x"}, {"down", "up"})
+                .Vary("y", [](double y) { return RVecD{y * 0.5}; }, {"y"}, {"half"})
+                .Define("s", [](double x, double y) { return x + y; }, {"x", "y"});
+   auto sums = VariationsFor(df.Sum<double>("s"));
+
+   const std::vector<std::string> expectedKeys{"nominal", "x:down", "x:up", "y:half"};
+   EXPECT_EQ(sums.GetKeys(), expectedKeys);
+   EXPECT_DOUBLE_EQ(sums["nominal"], 44.);
+   EXPECT_DOUBLE_EQ(sums["x:down"], 40.);
+   EXPECT_DOUBLE_EQ(sums["x:up"], 48.);
+   EXPECT_DOUBLE_EQ(sums["y:half"], 24.);
+}
+
+TEST(Vary, Errors)
+{
+   auto df = MakeVariedDF();
+   EXPECT_THROW(df.Vary("x", [](double x) { return RVecD{x}; }, {"x"}, {"again"}), std::runtime_error);
+   EXPECT_THROW(df.Vary("y", [](double y) { return RVecD{y}; }, {"y"}, {}), std::runtime_error);
+   EXPECT_THROW(df.Redefine("x", [] { return 0.; }), std::runtime_error);
+
+   // the varied values cannot depend on other variations
+   EXPECT_THROW(df.Vary("y", [](double x) { return RVecD{x}; }, {"x"}, {"t"}), std::runtime_error);
+   EXPECT_THROW(df.Vary("y", "ROOT::RVecD{x}", {"t"}), std::runtime_error);
+   // a jitted expression must return a RVec
+   EXPECT_THROW(df.Vary("y", "y * 2.", {"t"}), std::runtime_error);
+
+   // no variations
+   EXPECT_THROW(VariationsFor(df.Sum<double>("y")), std::runtime_error);
+
+   auto sum = df.Sum<double>("x");
+   *sum;
+   EXPECT_THROW(VariationsFor(sum), std::runtime_error);
+
+   auto sums = VariationsFor(df.Sum<double>("x"));
+   EXPECT_THROW(sums["x:sideways"], std::runtime_error);
+}
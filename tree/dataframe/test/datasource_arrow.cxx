@@ -203,6 +203,27 @@ TEST(RArrowDS, FromARDFWithJitting)
    EXPECT_EQ(40, *min);
 }
 
+TEST(RArrowDS, RecordBatchStream)
+{
+   auto table = createTestTable();
+   auto batchReader = std::make_shared<TableBatchReader>(*table);
+   batchReader->set_chunksize(2);
+   auto rdf = MakeArrowDataFrame(batchReader, {});
+   auto c = rdf.Count();
+   auto sumAges = rdf.Sum<Long64_t>("Age");
+   auto names = rdf.Take<std::string>("Name");
+   auto nMarried = rdf.Filter([](bool m) { return m; }, {"Married"}).Count();
+
+   EXPECT_EQ(6U, *c);
+   EXPECT_EQ(186, *sumAges);
+   const std::vector<std::string> expectedNames = {"Harry", "Bob,Bob", "\"Joe\"", "Tom", " John  ", " Mary Ann "};
+   EXPECT_EQ(expectedNames, *names);
+   EXPECT_EQ(3U, *nMarried);
+
+   // the stream cannot be rewound
+   EXPECT_THROW(*rdf.Count(), std::runtime_error);
+}
+
 // NOW MT!-------------
 #ifdef R__USE_IMT
 
@@ -249,6 +270,21 @@ TEST(RArrowDS, FromARDFWithJittingMT)
    EXPECT_EQ(40, *min);
 }
 
+TEST(RArrowDS, RecordBatchStreamMT)
+{
+   auto table = createTestTable();
+   auto batchReader = std::make_shared<TableBatchReader>(*table);
+   batchReader->set_chunksize(1);
+   auto rdf = MakeArrowDataFrame(batchReader, {"Age", "Height"});
+   auto c = rdf.Count();
+   auto sumAges = rdf.Sum<Long64_t>("Age");
+   auto max = rdf.Max<double>("Height");
+
+   EXPECT_EQ(6U, *c);
+   EXPECT_EQ(186, *sumAges);
+   EXPECT_DOUBLE_EQ(200.5, *max);
+}
+
 #endif // R__USE_IMT
 
 #endif // R__B64
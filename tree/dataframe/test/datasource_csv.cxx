@@ -5,7 +5,10 @@
 
 #include <gtest/gtest.h>
 
+#include <cstdio>
+#include <fstream>
 #include <iostream>
+#include <string>
 
 using namespace ROOT::RDF;
 
@@ -259,6 +262,70 @@ TEST(RCsvDS, Remote)
 #endif
 }
 
+// Write a CSV file of nLines records spanning several blocks of the file read by RCsvDS
+static void WriteLargeCsv(const char *fname, int nLines)
+{
+   std::ofstream f(fname);
+   f << "i,x,s,b\n";
+   for (int i = 0; i < nLines; ++i) {
+      f << i << ',' << (i % 100) * 0.25 << ",\"a, \"\"" << i % 10 << "\"\"\"," << (i % 2 == 0 ? "true" : "false");
+      f << (i % 3 == 0 ? "\r\n" : "\n");
+      if (i % 1000 == 0)
+         f << '\n'; // empty lines are skipped
+   }
+}
+
+static void CheckLargeCsv(ROOT::RDataFrame &df, int nLines)
+{
+   auto c = df.Count();
+   auto sumI = df.Sum<Long64_t>("i");
+   auto sumX = df.Sum<double>("x");
+   auto nTrue = df.Filter([](bool b) { return b; }, {"b"}).Count();
+   auto nSevens = df.Filter([](const std::string &s) { return s == "a, \"7\""; }, {"s"}).Count();
+
+   Long64_t expectedSumI = 0;
+   double expectedSumX = 0.;
+   for (int i = 0; i < nLines; ++i) {
+      expectedSumI += i;
+      expectedSumX += (i % 100) * 0.25;
+   }
+   EXPECT_EQ(static_cast<ULong64_t>(nLines), *c);
+   EXPECT_EQ(expectedSumI, *sumI);
+   EXPECT_DOUBLE_EQ(expectedSumX, *sumX);
+   EXPECT_EQ(static_cast<ULong64_t>((nLines + 1) / 2), *nTrue);
+   EXPECT_EQ(static_cast<ULong64_t>(nLines / 10), *nSevens);
+}
+
+TEST(RCsvDS, LargeFile)
+{
+   const auto fname = "RCsvDS_test_large.csv";
+   const auto nLines = 300000;
+   WriteLargeCsv(fname, nLines);
+   {
+      auto df = ROOT::RDF::MakeCsvDataFrame(fname);
+      CheckLargeCsv(df, nLines);
+      auto dfChunks = ROOT::RDF::MakeCsvDataFrame(fname, true, ',', 7777LL);
+      CheckLargeCsv(dfChunks, nLines);
+   }
+   std::remove(fname);
+}
+
+TEST(RCsvDS, ParseErrors)
+{
+   const auto fname = "RCsvDS_test_parseerrors.csv";
+   {
+      std::ofstream f(fname);
+      f << "a,b\n1,2\n3,x\n";
+   }
+   EXPECT_THROW(*ROOT::RDF::MakeCsvDataFrame(fname).Sum<Long64_t>("b"), std::runtime_error);
+   {
+      std::ofstream f(fname);
+      f << "a,b\n1,2\n3\n";
+   }
+   EXPECT_THROW(*ROOT::RDF::MakeCsvDataFrame(fname).Count(), std::runtime_error);
+   std::remove(fname);
+}
+
 // NOW MT!-------------
 #ifdef R__USE_IMT
 
@@ -320,6 +387,20 @@ TEST(RCsvDS, ProgressiveReadingRDFMT)
    EXPECT_EQ(6U, *c2);
 }
 
+TEST(RCsvDS, LargeFileMT)
+{
+   const auto fname = "RCsvDS_test_large_mt.csv";
+   const auto nLines = 300000;
+   WriteLargeCsv(fname, nLines);
+   {
+      auto df = ROOT::RDF::MakeCsvDataFrame(fname);
+      CheckLargeCsv(df, nLines);
+      auto dfChunks = ROOT::RDF::MakeCsvDataFrame(fname, true, ',', 7777LL);
+      CheckLargeCsv(dfChunks, nLines);
+   }
+   std::remove(fname);
+}
+
 #endif // R__USE_IMT
 
 #endif // R__B64
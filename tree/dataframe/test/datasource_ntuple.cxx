@@ -125,3 +125,110 @@ TEST_F(RNTupleDSTest, ReadMT)
 
    ReadTest(fNtplName, fFileName);
 }
+
+TEST(RNTupleDS, ValueRangeHint)
+{
+   const std::string fileName = "RNTupleDS_value_range_hint.root";
+   {
+      auto model = RNTupleModel::Create();
+      auto wrX = model->MakeField<std::int32_t>("x");
+      auto wrJets = model->MakeField<std::vector<float>>("jets");
+      ROOT::Experimental::RNTupleWriteOptions options;
+      // Pages of 4 elements
+      options.SetApproxUnzippedPageSize(16);
+      auto ntuple = RNTupleWriter::Recreate(std::move(model), "ntuple", fileName, options);
+      for (std::int32_t i = 0; i < 100; ++i) {
+         *wrX = i;
+         ntuple->Fill();
+         if (i % 20 == 19)
+            ntuple->CommitCluster();
+      }
+   }
+
+   RNTupleDS ds(RPageSource::Create("ntuple", fileName));
+   EXPECT_THROW(ds.AddValueRangeHint("jets", 0., 1.), std::runtime_error);
+   EXPECT_THROW(ds.AddValueRangeHint("y", 0., 1.), std::runtime_error);
+   ds.AddValueRangeHint("x", 41., 50.);
+   ds.SetNSlots(1);
+   ds.Initialise();
+   auto ranges = ds.GetEntryRanges();
+   ASSERT_FALSE(ranges.empty());
+   EXPECT_TRUE(ds.GetEntryRanges().empty());
+   ULong64_t nEntries = 0;
+   for (const auto &r : ranges) {
+      // Only the pages that contain values in [41, 50] remain
+      EXPECT_LE(40u, r.first);
+      EXPECT_GE(52u, r.second);
+      nEntries += r.second - r.first;
+   }
+   EXPECT_GE(nEntries, 10u);
+   EXPECT_LT(nEntries, 20u);
+
+   auto dsFilter = std::make_unique<RNTupleDS>(RPageSource::Create("ntuple", fileName));
+   dsFilter->AddValueRangeHint("x", 41., 50.);
+   ROOT::RDataFrame df(std::move(dsFilter));
+   auto count = df.Filter([](std::int32_t x) { return x > 40 && x <= 50; }, {"x"}).Count();
+   EXPECT_EQ(10u, *count);
+
+   std::remove(fileName.c_str());
+}
+
+TEST(RNTupleDS, Snapshot)
+{
+   const std::string fileName = "RNTupleDS_snapshot.root";
+   ROOT::RDF::RSnapshotOptions opts;
+   opts.fOutputFormat = ROOT::RDF::ESnapshotOutputFormat::kRNTuple;
+
+   ROOT::RDataFrame df(10);
+   auto d = df.Define("x", [](ULong64_t e) { return int(e); }, {"rdfentry_"})
+               .Define("v", [](int x) { return ROOT::RVec<float>(x % 3, 1.f); }, {"x"})
+               .Define("s", [](int x) { return std::to_string(x); }, {"x"});
+   auto out = d.Snapshot<int, ROOT::RVec<float>, std::string>("ntuple", fileName, {"x", "v", "s"}, opts);
+
+   EXPECT_EQ(10u, *out->Count());
+   EXPECT_EQ(45, *out->Sum<int>("x"));
+   EXPECT_EQ(9.f, *out->Sum<std::vector<float>>("v"));
+   EXPECT_EQ(std::string("7"), out->Take<std::string>("s")->at(7));
+
+   // jitted Snapshot, reading back the output of the first one
+   auto out2 = out->Filter("x > 4").Snapshot("ntuple2", "RNTupleDS_snapshot2.root", {"x", "v"}, opts);
+   auto df2 = ROOT::Experimental::MakeNTupleDataFrame("ntuple2", "RNTupleDS_snapshot2.root");
+   EXPECT_EQ(5u, *df2.Count());
+   EXPECT_EQ(35, *out2->Sum<int>("x"));
+
+   std::remove(fileName.c_str());
+   std::remove("RNTupleDS_snapshot2.root");
+}
+
+TEST(RNTupleDS, SnapshotMT)
+{
+   IMTRAII _;
+   const std::string fileName = "RNTupleDS_snapshot_mt.root";
+   ROOT::RDF::RSnapshotOptions opts;
+   opts.fOutputFormat = ROOT::RDF::ESnapshotOutputFormat::kRNTuple;
+   // many small clusters, committed concurrently by the slots
+   opts.fApproxZippedClusterSize = 1000;
+   opts.fMaxUnzippedClusterSize = 4000;
+   opts.fApproxUnzippedPageSize = 256;
+
+   ROOT::RDataFrame df(100000);
+   auto out = df.Define("x", [](ULong64_t e) { return e; }, {"rdfentry_"})
+                 .Filter([](ULong64_t x) { return x % 2 == 0; }, {"x"})
+                 .Snapshot<ULong64_t>("ntuple", fileName, {"x"}, opts);
+
+   EXPECT_EQ(50000u, *out->Count());
+   EXPECT_EQ(2499950000ull, *out->Sum<ULong64_t>("x"));
+
+   std::remove(fileName.c_str());
+}
+
+TEST(RNTupleDS, SnapshotUnsupportedOptions)
+{
+   ROOT::RDF::RSnapshotOptions opts;
+   opts.fOutputFormat = ROOT::RDF::ESnapshotOutputFormat::kRNTuple;
+   ROOT::RDataFrame df(1);
+   auto d = df.Define("x", [] { return 1; });
+   EXPECT_THROW(d.Snapshot<int>("dir/ntuple", "RNTupleDS_snapshot_dir.root", {"x"}, opts), std::invalid_argument);
+   opts.fMode = "UPDATE";
+   EXPECT_THROW(d.Snapshot<int>("ntuple", "RNTupleDS_snapshot_update.root", {"x"}, opts), std::invalid_argument);
+}
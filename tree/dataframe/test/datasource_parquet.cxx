@@ -0,0 +1,131 @@
+#include <ROOT/RDataFrame.hxx>
+#include <ROOT/RParquetDS.hxx>
+#include <ROOT/RSnapshotOptions.hxx>
+#include <ROOT/RVec.hxx>
+#include <TROOT.h>
+
+#include <gtest/gtest.h>
+
+#include <cstdio>
+#include <string>
+
+using namespace ROOT::RDF;
+
+struct IMTRAII {
+   IMTRAII() { ROOT::EnableImplicitMT(); }
+   ~IMTRAII() { ROOT::DisableImplicitMT(); }
+};
+
+// Write a file of 100 entries, in row groups of 10 entries: the values of x are the entry numbers.
+class RParquetDSTest : public ::testing::Test {
+protected:
+   const std::string fFileName = "RParquetDS_test.parquet";
+
+   void SetUp() override
+   {
+      RSnapshotOptions opts;
+      opts.fOutputFormat = ESnapshotOutputFormat::kParquet;
+      opts.fParquetRowGroupSize = 10;
+      ROOT::RDataFrame df(100);
+      df.Define("x", [](ULong64_t e) { return Long64_t(e); }, {"rdfentry_"})
+         .Define("y", [](Long64_t x) { return 0.5 * x; }, {"x"})
+         .Define("b", [](Long64_t x) { return x % 2 == 0; }, {"x"})
+         .Define("s", [](Long64_t x) { return std::to_string(x); }, {"x"})
+         .Define("v", [](Long64_t x) { return ROOT::RVec<float>(x % 3, 1.f); }, {"x"})
+         .Snapshot<Long64_t, double, bool, std::string, ROOT::RVec<float>>("events", fFileName,
+                                                                           {"x", "y", "b", "s", "v"}, opts);
+   }
+
+   void TearDown() override { std::remove(fFileName.c_str()); }
+};
+
+TEST_F(RParquetDSTest, ColumnNamesAndTypes)
+{
+   RParquetDS ds(fFileName);
+   EXPECT_EQ((std::vector<std::string>{"x", "y", "b", "s", "v"}), ds.GetColumnNames());
+   EXPECT_EQ("Long64_t", ds.GetTypeName("x"));
+   EXPECT_EQ("double", ds.GetTypeName("y"));
+   EXPECT_EQ("bool", ds.GetTypeName("b"));
+   EXPECT_EQ("std::string", ds.GetTypeName("s"));
+   EXPECT_EQ("ROOT::VecOps::RVec<float>", ds.GetTypeName("v"));
+   EXPECT_THROW(ds.GetTypeName("z"), std::runtime_error);
+   EXPECT_THROW(RParquetDS(fFileName, {"z"}), std::runtime_error);
+}
+
+TEST_F(RParquetDSTest, Read)
+{
+   auto df = MakeParquetDataFrame(fFileName);
+   auto c = df.Count();
+   auto sx = df.Sum<Long64_t>("x");
+   auto sy = df.Sum<double>("y");
+   auto nb = df.Filter([](bool b) { return b; }, {"b"}).Count();
+   auto ss = df.Take<std::string>("s");
+   auto sv = df.Sum<ROOT::RVec<float>>("v");
+
+   EXPECT_EQ(100u, *c);
+   EXPECT_EQ(4950, *sx);
+   EXPECT_DOUBLE_EQ(2475., *sy);
+   EXPECT_EQ(50u, *nb);
+   EXPECT_EQ("42", ss->at(42));
+   EXPECT_FLOAT_EQ(99.f, *sv);
+}
+
+TEST_F(RParquetDSTest, ColumnSelection)
+{
+   auto df = MakeParquetDataFrame(fFileName, {"y", "s"});
+   EXPECT_EQ((std::vector<std::string>{"y", "s"}), df.GetColumnNames());
+   EXPECT_DOUBLE_EQ(2475., *df.Sum<double>("y"));
+}
+
+TEST_F(RParquetDSTest, ColumnRanges)
+{
+   // only the row groups [20, 30), [30, 40) and [40, 50) can have values of x in [25, 45]
+   auto df = MakeParquetDataFrame(fFileName, {}, {{"x", 25, 45}});
+   EXPECT_EQ(30u, *df.Count());
+   EXPECT_EQ(1035, *df.Sum<Long64_t>("x"));
+   EXPECT_EQ(21u, *df.Filter("x >= 25 && x <= 45").Count());
+
+   EXPECT_EQ(0u, *MakeParquetDataFrame(fFileName, {}, {{"x", 1000, 2000}}).Count());
+   EXPECT_THROW(MakeParquetDataFrame(fFileName, {}, {{"s", 0, 1}}), std::invalid_argument);
+}
+
+TEST_F(RParquetDSTest, ReadMT)
+{
+   IMTRAII _;
+   auto df = MakeParquetDataFrame(fFileName);
+   EXPECT_EQ(100u, *df.Count());
+   EXPECT_EQ(4950, *df.Sum<Long64_t>("x"));
+   EXPECT_FLOAT_EQ(99.f, *df.Sum<ROOT::RVec<float>>("v"));
+}
+
+TEST(RParquetDS, SnapshotMT)
+{
+   IMTRAII _;
+   const std::string fileName = "RParquetDS_snapshot_mt.parquet";
+   RSnapshotOptions opts;
+   opts.fOutputFormat = ESnapshotOutputFormat::kParquet;
+   opts.fParquetRowGroupSize = 1000;
+
+   ROOT::RDataFrame df(100000);
+   auto out = df.Define("x", [](ULong64_t e) { return e; }, {"rdfentry_"})
+                 .Filter([](ULong64_t x) { return x % 2 == 0; }, {"x"})
+                 .Snapshot<ULong64_t>("events", fileName, {"x"}, opts);
+
+   EXPECT_EQ(50000u, *out->Count());
+   EXPECT_EQ(2499950000ull, *out->Sum<ULong64_t>("x"));
+
+   std::remove(fileName.c_str());
+}
+
+TEST(RParquetDS, SnapshotUnsupported)
+{
+   RSnapshotOptions opts;
+   opts.fOutputFormat = ESnapshotOutputFormat::kParquet;
+   ROOT::RDataFrame df(1);
+   auto d = df.Define("x", [] { return 1; }).Define("c", [] { return 'c'; });
+   EXPECT_THROW(d.Snapshot<int>("dir/events", "RParquetDS_snapshot_dir.parquet", {"x"}, opts), std::invalid_argument);
+   EXPECT_THROW(d.Snapshot<char>("events", "RParquetDS_snapshot_char.parquet", {"c"}, opts), std::runtime_error);
+   opts.fMode = "UPDATE";
+   EXPECT_THROW(d.Snapshot<int>("events", "RParquetDS_snapshot_update.parquet", {"x"}, opts), std::invalid_argument);
+   std::remove("RParquetDS_snapshot_char.parquet");
+}
@@ -20,6 +20,8 @@ constexpr auto query0 = "SELECT * FROM test";
 constexpr auto query1 = "SELECT fint + 1, freal/1.0 as fmyreal, NULL, 'X', fblob FROM test";
 constexpr auto query2 = "SELECT fint, freal, fint FROM test";
 constexpr auto query3 = "SELECT fint, freal, ftext, fblob FROM test";
+constexpr auto query4 = "WITH RECURSIVE cnt(x) AS (SELECT 1 UNION ALL SELECT x + 1 FROM cnt LIMIT 5000) "
+                        "SELECT x, 'row' || x AS name FROM cnt";
 constexpr auto epsilon = 0.001;
 
 TEST(RSqliteDS, Basics)
@@ -124,17 +126,15 @@ TEST(RSqliteDS, ColumnReaders)
 {
    RSqliteDS rds(fileName0, query0);
    const auto nSlots = 2U;
-   ROOT_EXPECT_WARNING(rds.SetNSlots(nSlots), "SetNSlots",
-                       "Currently the SQlite data source faces performance degradation in multi-threaded mode. "
-                       "Consider turning off IMT.");
+   rds.SetNSlots(nSlots);
    auto vals = rds.GetColumnReaders<Long64_t>("fint");
    rds.Initialise();
    auto ranges = rds.GetEntryRanges();
-   EXPECT_EQ(1U, ranges.size());
+   ASSERT_EQ(2U, ranges.size());
    for (auto i : ROOT::TSeq<unsigned>(0, nSlots)) {
-      EXPECT_TRUE(rds.SetEntry(i, ranges[0].first));
+      EXPECT_TRUE(rds.SetEntry(i, ranges[i].first));
       auto val = **vals[i];
-      EXPECT_EQ(1, val);
+      EXPECT_EQ(Long64_t(i + 1), val);
    }
 
    EXPECT_THROW(rds.GetColumnReaders<double>("fint"), std::runtime_error);
@@ -143,24 +143,52 @@ TEST(RSqliteDS, ColumnReaders)
 TEST(RSqliteDS, GetEntryRanges)
 {
    RSqliteDS rds(fileName0, query0);
+   rds.SetNSlots(1);
    rds.Initialise();
+   // The whole result set fits in one chunk
    auto ranges = rds.GetEntryRanges();
    ASSERT_EQ(1U, ranges.size());
    EXPECT_EQ(0U, ranges[0].first);
-   EXPECT_EQ(1U, ranges[0].second);
-   ranges = rds.GetEntryRanges();
-   ASSERT_EQ(1U, ranges.size());
-   EXPECT_EQ(1U, ranges[0].first);
    EXPECT_EQ(2U, ranges[0].second);
    ranges = rds.GetEntryRanges();
    EXPECT_EQ(0U, ranges.size());
+   ranges = rds.GetEntryRanges();
+   EXPECT_EQ(0U, ranges.size());
 
    // New event loop
    rds.Initialise();
    ranges = rds.GetEntryRanges();
    EXPECT_EQ(1U, ranges.size());
    EXPECT_EQ(0U, ranges[0].first);
-   EXPECT_EQ(1U, ranges[0].second);
+   EXPECT_EQ(2U, ranges[0].second);
+}
+
+TEST(RSqliteDS, Chunks)
+{
+   RSqliteDS rds(fileName0, query4);
+   const auto nSlots = 3U;
+   rds.SetNSlots(nSlots);
+   auto vx = rds.GetColumnReaders<Long64_t>("x");
+   auto vname = rds.GetColumnReaders<std::string>("name");
+   rds.Initialise();
+
+   ULong64_t nEntries = 0;
+   while (true) {
+      auto ranges = rds.GetEntryRanges();
+      if (ranges.empty())
+         break;
+      EXPECT_LE(ranges.size(), nSlots);
+      for (auto i : ROOT::TSeq<unsigned>(0, ranges.size())) {
+         EXPECT_EQ(nEntries, ranges[i].first);
+         for (auto entry = ranges[i].first; entry < ranges[i].second; ++entry) {
+            EXPECT_TRUE(rds.SetEntry(i, entry));
+            EXPECT_EQ(Long64_t(entry + 1), **vx[i]);
+            EXPECT_EQ("row" + std::to_string(entry + 1), **vname[i]);
+         }
+         nEntries = ranges[i].second;
+      }
+   }
+   EXPECT_EQ(5000U, nEntries);
 }
 
 TEST(RSqliteDS, SetEntry)
@@ -184,7 +212,6 @@ TEST(RSqliteDS, SetEntry)
    EXPECT_EQ('1', (**vblob[0])[0]);
    EXPECT_EQ(nullptr, **vnull[0]);
 
-   rds.GetEntryRanges();
    EXPECT_TRUE(rds.SetEntry(0, 1));
    EXPECT_EQ(2, **vint[0]);
    EXPECT_NEAR(2.0, **vreal[0], epsilon);
@@ -216,6 +243,10 @@ TEST(RSqliteDS, IMT)
       "fblob");
    std::sort(sum_blob.begin(), sum_blob.end());
 
+   auto rdf4 = MakeSqliteDataFrame(fileName0, query4);
+   EXPECT_EQ(5000 * 5001 / 2, *rdf4.Sum<Long64_t>("x"));
+   EXPECT_EQ(5000U, *rdf4.Count());
+
    ROOT::DisableImplicitMT();
 
    ASSERT_EQ(2U, sum_blob.size());
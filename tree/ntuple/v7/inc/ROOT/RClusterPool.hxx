@@ -17,10 +17,14 @@
 #define ROOT7_RClusterPool
 
 #include <ROOT/RCluster.hxx>
+#include <ROOT/RNTupleMetrics.hxx>
 #include <ROOT/RNTupleUtil.hxx>
 #include <ROOT/RPageStorage.hxx> // for ColumnSet_t
 
+#include <atomic>
+#include <chrono>
 #include <condition_variable>
+#include <cstdint>
 #include <memory>
 #include <mutex>
 #include <future>
@@ -51,9 +55,21 @@ the unzip thread is supposed to submit multi-threaded, CPU heavy work to the app
 The unzipping step of the pipeline therefore behaves differently depending on whether or not implicit multi-threadin
 is turned on. If it is turned off, i.e. in a single-threaded environment, the cluster pool will only read the
 compressed pages and the page source has to uncompresses pages at a later point when data from the page is requested.
+
+By default, the size of the look-ahead window is fixed by the pool size. In adaptive mode
+(RNTupleReadOptions::EClusterCache::kAdaptive), the pool size is an upper bound and the look-ahead window
+grows or shrinks such that the I/O latency of a cluster is covered by the time the consumer needs to process the
+clusters in the window. I/O latency and consumption time are tracked as exponential moving averages and are
+exposed through the pool's metrics.
 */
 // clang-format on
 class RClusterPool {
+public:
+   enum class EWindowPolicy {
+      kFixed,
+      kAdaptive,
+   };
+
 private:
    /// Maximum number of queued cluster requests for the I/O thread. A single request can span mutliple clusters.
    static constexpr unsigned int kWorkQueueLimit = 4;
@@ -94,8 +110,13 @@ private:
    RPageSource &fPageSource;
    /// The number of clusters before the currently active cluster that should stay in the pool if present
    unsigned int fWindowPre;
-   /// The number of desired clusters in the pool, including the currently active cluster
+   /// The number of desired clusters in the pool, including the currently active cluster.
+   /// Only changes over time in adaptive mode, in which case it is bound by fMaxWindowPost.
    unsigned int fWindowPost;
+   /// The largest look-ahead window that fits in the pool
+   unsigned int fMaxWindowPost;
+   /// Whether or not the look-ahead window follows the observed I/O latency and consumption rate
+   EWindowPolicy fWindowPolicy;
    /// The cache of clusters around the currently active cluster
    std::vector<std::unique_ptr<RCluster>> fPool;
 
@@ -115,6 +136,22 @@ private:
    /// The communication channel between the I/O thread and the unzip thread
    std::queue<RUnzipItem> fUnzipQueue;
 
+   /// Exponential moving average of the wall time of RPageSource::LoadCluster(), updated by the I/O thread
+   std::atomic<std::int64_t> fIoLatencyNs{0};
+   /// Exponential moving average of the time the consumer spends on a cluster outside GetCluster()
+   std::int64_t fConsumeTimeNs = 0;
+   /// Time spent by the consumer on the currently active cluster so far
+   std::int64_t fConsumeTimeCurrentNs = 0;
+   /// The cluster id of the last GetCluster() call
+   DescriptorId_t fLastClusterId = kInvalidDescriptorId;
+   /// Time when the last GetCluster() call returned
+   std::chrono::steady_clock::time_point fTimeLastReturn;
+
+   RNTupleMetrics fMetrics;
+   RNTupleAtomicCounter *fCtrWindowPost = nullptr;
+   RNTupleAtomicCounter *fCtrIoLatency = nullptr;
+   RNTupleAtomicCounter *fCtrConsumeTime = nullptr;
+
    /// The I/O thread calls RPageSource::LoadCluster() asynchronously.  The thread is mostly waiting for the
    /// data to arrive (blocked by the kernel) and therefore can safely run in addition to the application
    /// main threads.
@@ -138,17 +175,35 @@ private:
    /// Executed at the end of GetCluster when all missing data pieces have been sent to the load queue.
    /// Ideally, the function returns without blocking if the cluster is already in the pool.
    RCluster *WaitFor(DescriptorId_t clusterId, const RPageSource::ColumnSet_t &columns);
+   /// In adaptive mode, accounts the time the consumer spent outside GetCluster() and updates fWindowPost
+   void AdaptWindow(DescriptorId_t clusterId);
 
 public:
    static constexpr unsigned int kDefaultPoolSize = 4;
-   RClusterPool(RPageSource &pageSource, unsigned int size);
-   explicit RClusterPool(RPageSource &pageSource) : RClusterPool(pageSource, kDefaultPoolSize) {}
+   /// The upper bound of the pool size for page sources that use an adaptive look-ahead window
+   static constexpr unsigned int kMaxAdaptivePoolSize = 16;
+   /// Weight of the newest sample in the exponential moving averages of I/O latency and consumption time
+   static constexpr double kSmoothingFactor = 0.25;
+
+   RClusterPool(RPageSource &pageSource, unsigned int size, EWindowPolicy windowPolicy = EWindowPolicy::kFixed);
+   /// Uses the window policy and pool size derived from the read options of the page source
+   explicit RClusterPool(RPageSource &pageSource);
    RClusterPool(const RClusterPool &other) = delete;
    RClusterPool &operator =(const RClusterPool &other) = delete;
    ~RClusterPool();
 
    unsigned int GetWindowPre() const { return fWindowPre; }
    unsigned int GetWindowPost() const { return fWindowPost; }
+   unsigned int GetMaxWindowPost() const { return fMaxWindowPost; }
+   EWindowPolicy GetWindowPolicy() const { return fWindowPolicy; }
+   RNTupleMetrics &GetMetrics() { return fMetrics; }
+
+   /// Returns the look-ahead window such that, given the average I/O latency and the average consumption time of a
+   /// cluster, the next cluster arrives before the consumer needs it. The window changes by at most a factor of
+   /// two per call in order to smooth out spikes; it shrinks by at most one cluster per call in order to avoid
+   /// dropping clusters that are still being read.
+   static unsigned int ComputeWindowPost(std::int64_t ioLatencyNs, std::int64_t consumeTimeNs,
+                                         unsigned int currentWindowPost, unsigned int maxWindowPost);
 
    /// Returns the requested cluster either from the pool or, in case of a cache miss, lets the I/O thread load
    /// the cluster in the pool, blocks until done, and then returns it.  Triggers along the way the background loading
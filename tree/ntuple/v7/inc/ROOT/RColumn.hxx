@@ -62,6 +62,7 @@ private:
    /// Index of the current write page
    int fWritePageIdx = 0;
    /// For writing, the targeted number of elements, given by `fApproxNElementsPerPage` (in the write options) and the element size.
+   /// If the write options set a target compressed page size, the value is adapted in AdaptPageSize().
    /// We ensure this value to be >= 2 in Connect() so that we have meaningful
    /// "page full" and "page half full" events when writing the page.
    std::uint32_t fApproxNElementsPerPage = 0;
@@ -76,6 +77,10 @@ private:
 
    RColumn(const RColumnModel &model, std::uint32_t index);
 
+   /// Called after the tail page of a cluster has been committed.  If the write options ask for a target compressed
+   /// page size, recomputes fApproxNElementsPerPage from the compression ratio measured by the page sink.
+   void AdaptPageSize();
+
    /// Used in Append() and AppendV() to switch pages when the main page reached the target size
    /// The other page has been flushed when the main page reached 50%.
    void SwapWritePagesIfFull() {
@@ -245,6 +250,18 @@ public:
          (clusterIndex.GetIndex() - fReadPage.GetClusterRangeFirst()) * RColumnElement<CppT>::kSize);
    }
 
+   /// Untyped version of MapV(): the returned address points to the in-memory representation of the element.
+   /// The element size is given by the column element type.
+   void *MapRawV(const NTupleSize_t globalIndex, NTupleSize_t &nItems) {
+      if (!fReadPage.Contains(globalIndex)) {
+         MapPage(globalIndex);
+      }
+      // +1 to go from 0-based indexing to 1-based number of items
+      nItems = fReadPage.GetGlobalRangeLast() - globalIndex + 1;
+      return static_cast<unsigned char *>(fReadPage.GetBuffer()) +
+             (globalIndex - fReadPage.GetGlobalRangeFirst()) * fReadPage.GetElementSize();
+   }
+
    NTupleSize_t GetGlobalIndex(const RClusterIndex &clusterIndex) {
       if (!fReadPage.Contains(clusterIndex)) {
          MapPage(clusterIndex);
@@ -21,8 +21,10 @@
 
 #include <TError.h>
 
+#include <cmath>
 #include <cstring> // for memcpy
 #include <cstdint>
+#include <limits>
 #include <memory>
 #include <string>
 #include <type_traits>
@@ -100,9 +102,45 @@ public:
       std::memcpy(destination, source, count);
    }
 
+   /// Numerical column elements compute the smallest and the largest value of an in-memory array of elements.
+   /// Returns false if there is no value range, e.g. for non-numerical columns or if all values are NaN.
+   virtual bool GetValueRange(const void * /* source */, std::size_t /* count */, double & /* min */,
+                              double & /* max */) const
+   {
+      return false;
+   }
+
    void *GetRawContent() const { return fRawContent; }
    std::size_t GetSize() const { return fSize; }
    std::size_t GetPackedSize(std::size_t nElements) const { return (nElements * GetBitsOnStorage() + 7) / 8; }
+
+protected:
+   /// Implementation of GetValueRange() for the in-memory type CppT; NaNs are ignored
+   template <typename CppT>
+   static bool ComputeValueRange(const void *source, std::size_t count, double &min, double &max)
+   {
+      auto values = reinterpret_cast<const CppT *>(source);
+      std::size_t i = 0;
+      while ((i < count) && !(values[i] == values[i]))
+         ++i;
+      if (i == count)
+         return false;
+      CppT lo = values[i];
+      CppT hi = values[i];
+      for (++i; i < count; ++i) {
+         // NaNs fail both comparisons
+         lo = (values[i] < lo) ? values[i] : lo;
+         hi = (values[i] > hi) ? values[i] : hi;
+      }
+      min = static_cast<double>(lo);
+      max = static_cast<double>(hi);
+      if (std::is_integral<CppT>::value && (sizeof(CppT) > 4)) {
+         // Large 64bit integers are rounded when converted to double; widen the range to keep it conservative
+         min = std::nextafter(min, -std::numeric_limits<double>::infinity());
+         max = std::nextafter(max, std::numeric_limits<double>::infinity());
+      }
+      return true;
+   }
 };
 
 /**
@@ -227,6 +265,10 @@ public:
    explicit RColumnElement(float *value) : RColumnElementBase(value, kSize) {}
    bool IsMappable() const final { return kIsMappable; }
    std::size_t GetBitsOnStorage() const final { return kBitsOnStorage; }
+   bool GetValueRange(const void *src, std::size_t count, double &min, double &max) const final
+   {
+      return ComputeValueRange<float>(src, count, min, max);
+   }
 };
 
 template <>
@@ -238,6 +280,10 @@ public:
    explicit RColumnElement(double *value) : RColumnElementBase(value, kSize) {}
    bool IsMappable() const final { return kIsMappable; }
    std::size_t GetBitsOnStorage() const final { return kBitsOnStorage; }
+   bool GetValueRange(const void *src, std::size_t count, double &min, double &max) const final
+   {
+      return ComputeValueRange<double>(src, count, min, max);
+   }
 };
 
 template <>
@@ -249,6 +295,10 @@ public:
    explicit RColumnElement(std::int8_t *value) : RColumnElementBase(value, kSize) {}
    bool IsMappable() const final { return kIsMappable; }
    std::size_t GetBitsOnStorage() const final { return kBitsOnStorage; }
+   bool GetValueRange(const void *src, std::size_t count, double &min, double &max) const final
+   {
+      return ComputeValueRange<std::int8_t>(src, count, min, max);
+   }
 };
 
 template <>
@@ -260,6 +310,10 @@ public:
    explicit RColumnElement(std::uint8_t *value) : RColumnElementBase(value, kSize) {}
    bool IsMappable() const final { return kIsMappable; }
    std::size_t GetBitsOnStorage() const final { return kBitsOnStorage; }
+   bool GetValueRange(const void *src, std::size_t count, double &min, double &max) const final
+   {
+      return ComputeValueRange<std::uint8_t>(src, count, min, max);
+   }
 };
 
 template<>
@@ -271,6 +325,10 @@ public:
    explicit RColumnElement(std::int16_t *value) : RColumnElementBase(value, kSize) {}
    bool IsMappable() const final { return kIsMappable; }
    std::size_t GetBitsOnStorage() const final { return kBitsOnStorage; }
+   bool GetValueRange(const void *src, std::size_t count, double &min, double &max) const final
+   {
+      return ComputeValueRange<std::int16_t>(src, count, min, max);
+   }
 };
 
 template<>
@@ -282,6 +340,10 @@ public:
    explicit RColumnElement(std::uint16_t *value) : RColumnElementBase(value, kSize) {}
    bool IsMappable() const final { return kIsMappable; }
    std::size_t GetBitsOnStorage() const final { return kBitsOnStorage; }
+   bool GetValueRange(const void *src, std::size_t count, double &min, double &max) const final
+   {
+      return ComputeValueRange<std::uint16_t>(src, count, min, max);
+   }
 };
 
 template <>
@@ -293,6 +355,10 @@ public:
    explicit RColumnElement(std::int32_t *value) : RColumnElementBase(value, kSize) {}
    bool IsMappable() const final { return kIsMappable; }
    std::size_t GetBitsOnStorage() const final { return kBitsOnStorage; }
+   bool GetValueRange(const void *src, std::size_t count, double &min, double &max) const final
+   {
+      return ComputeValueRange<std::int32_t>(src, count, min, max);
+   }
 };
 
 template <>
@@ -304,6 +370,10 @@ public:
    explicit RColumnElement(std::uint32_t *value) : RColumnElementBase(value, kSize) {}
    bool IsMappable() const final { return kIsMappable; }
    std::size_t GetBitsOnStorage() const final { return kBitsOnStorage; }
+   bool GetValueRange(const void *src, std::size_t count, double &min, double &max) const final
+   {
+      return ComputeValueRange<std::uint32_t>(src, count, min, max);
+   }
 };
 
 template <>
@@ -315,6 +385,10 @@ public:
    explicit RColumnElement(std::int64_t *value) : RColumnElementBase(value, kSize) {}
    bool IsMappable() const final { return kIsMappable; }
    std::size_t GetBitsOnStorage() const final { return kBitsOnStorage; }
+   bool GetValueRange(const void *src, std::size_t count, double &min, double &max) const final
+   {
+      return ComputeValueRange<std::int64_t>(src, count, min, max);
+   }
 };
 
 template <>
@@ -326,6 +400,10 @@ public:
    explicit RColumnElement(std::uint64_t *value) : RColumnElementBase(value, kSize) {}
    bool IsMappable() const final { return kIsMappable; }
    std::size_t GetBitsOnStorage() const final { return kBitsOnStorage; }
+   bool GetValueRange(const void *src, std::size_t count, double &min, double &max) const final
+   {
+      return ComputeValueRange<std::uint64_t>(src, count, min, max);
+   }
 };
 
 template <>
@@ -384,6 +462,10 @@ public:
    explicit RColumnElement(std::int64_t *value) : RColumnElementBase(value, kSize) {}
    bool IsMappable() const final { return kIsMappable; }
    std::size_t GetBitsOnStorage() const final { return kBitsOnStorage; }
+   bool GetValueRange(const void *src, std::size_t count, double &min, double &max) const final
+   {
+      return ComputeValueRange<std::int64_t>(src, count, min, max);
+   }
 
    void Pack(void *dst, void *src, std::size_t count) const final;
    void Unpack(void *dst, void *src, std::size_t count) const final;
@@ -224,6 +224,14 @@ public:
       fPrincipalColumn->Read(clusterIndex, &value->fMappedElement);
    }
 
+   /// Bulk, zero-copy access for simple fields. Returns the address of the element `globalIndex` in the page that
+   /// contains it and sets `nItems` to the number of consecutive elements available in that page, starting at
+   /// `globalIndex`. The memory is owned by the page source and it is valid until the field maps another page.
+   void *MapRawV(NTupleSize_t globalIndex, NTupleSize_t &nItems) {
+      R__ASSERT(fIsSimple);
+      return fPrincipalColumn->MapRawV(globalIndex, nItems);
+   }
+
    /// Ensure that all received items are written from page buffers to the storage.
    void Flush() const;
    /// Perform housekeeping tasks for global to cluster-local index translation
@@ -26,10 +26,14 @@
 #include <ROOT/RSpan.hxx>
 #include <ROOT/RStringView.hxx>
 
+#include <condition_variable>
+#include <cstdint>
 #include <iterator>
 #include <memory>
+#include <mutex>
 #include <sstream>
 #include <utility>
+#include <vector>
 
 class TFile;
 
@@ -409,6 +413,130 @@ public:
    const Detail::RNTupleMetrics &GetMetrics() const { return fMetrics; }
 };
 
+class RNTupleParallelWriter;
+
+// clang-format off
+/**
+\class ROOT::Experimental::RNTupleFillContext
+\ingroup NTuple
+\brief A fill buffer of an RNTupleParallelWriter, used by one thread at a time
+
+The fill context owns a clone of the writer's model.  The entries filled into a context make up clusters that are
+sealed independently of the other contexts, on the IMT pool if IMT is enabled and otherwise by the filling thread.
+Only committing a cluster synchronizes with the other fill contexts of the writer.  Fill contexts must be destructed
+before their writer; on destruction, the open cluster is committed.
+*/
+// clang-format on
+class RNTupleFillContext {
+   friend class RNTupleParallelWriter;
+
+private:
+   RNTupleParallelWriter &fWriter;
+   /// Seals the pages of this fill context only.  Needs to be destructed after the page sink and so declared before.
+   std::unique_ptr<Detail::RPageStorage::RTaskScheduler> fZipTasks;
+   /// Buffers the sealed pages of the open cluster until they are committed to the writer's sink
+   std::unique_ptr<Detail::RPageSink> fSink;
+   /// Needs to be destructed before fSink
+   std::unique_ptr<RNTupleModel> fModel;
+   NTupleSize_t fLastCommitted = 0;
+   NTupleSize_t fNEntries = 0;
+   /// Keeps track of the number of bytes written into the current cluster
+   std::size_t fUnzippedClusterSize = 0;
+   /// The total number of bytes written to storage by this context (i.e., after compression)
+   std::uint64_t fNBytesCommitted = 0;
+   /// The total number of bytes filled into the so far committed clusters of this context
+   std::uint64_t fNBytesFilled = 0;
+   /// Limit for committing cluster no matter the other tunables
+   std::size_t fMaxUnzippedClusterSize;
+   /// Estimator of uncompressed cluster size, taking into account the estimated compression ratio
+   NTupleSize_t fUnzippedClusterSizeEst;
+   /// If false, Fill() does not commit clusters
+   bool fAutoCommit = true;
+
+   RNTupleFillContext(RNTupleParallelWriter &writer, std::unique_ptr<RNTupleModel> model);
+   /// Flushes the fields and waits for the page sealing tasks; to be called before committing the open cluster
+   void FlushCluster();
+   /// Updates the cluster size estimator after nbytes have been written for the last cluster
+   void UpdateClusterSizeEstimate(std::uint64_t nbytes);
+
+public:
+   RNTupleFillContext(const RNTupleFillContext &) = delete;
+   RNTupleFillContext &operator=(const RNTupleFillContext &) = delete;
+   ~RNTupleFillContext();
+
+   void Fill() { Fill(*fModel->GetDefaultEntry()); }
+   /// The entry must have been created by CreateEntry() of this fill context
+   void Fill(REntry &entry) {
+      for (auto &value : entry) {
+         fUnzippedClusterSize += value.GetField()->Append(value);
+      }
+      fNEntries++;
+      if (fAutoCommit &&
+          ((fUnzippedClusterSize >= fMaxUnzippedClusterSize) || (fUnzippedClusterSize >= fUnzippedClusterSizeEst)))
+         CommitCluster();
+   }
+   /// Commits the open cluster.  Clusters of different fill contexts are written in the order of the calls.
+   void CommitCluster();
+   /// Commits the open cluster, which may be empty, at position sequenceNumber of the sequenced commits.  Blocks until
+   /// the sequenced commits with all the smaller sequence numbers happened.  Sequence numbers count from zero for the
+   /// writer and every number must be used exactly once.  Together with SetAutoCommit(false), the order of the
+   /// clusters on storage does not depend on the scheduling of the filling threads.
+   void CommitCluster(std::uint64_t sequenceNumber);
+   void SetAutoCommit(bool value) { fAutoCommit = value; }
+
+   std::unique_ptr<REntry> CreateEntry() { return fModel->CreateEntry(); }
+};
+
+// clang-format off
+/**
+\class ROOT::Experimental::RNTupleParallelWriter
+\ingroup NTuple
+\brief An RNTuple that is filled concurrently by multiple threads
+
+Every filling thread obtains its own RNTupleFillContext.  The fill contexts compress their clusters in parallel and
+commit them one at a time into the writer's page sink.  Unlike merging the output of independent writers, the pages
+are written only once.
+*/
+// clang-format on
+class RNTupleParallelWriter {
+   friend class RNTupleFillContext;
+
+private:
+   /// Serializes the access to fSink and the entry and sequence counters
+   std::mutex fMutex;
+   /// Wakes up fill contexts that wait for their turn in CommitCluster(sequenceNumber)
+   std::condition_variable fSequenceCv;
+   std::unique_ptr<Detail::RPageSink> fSink;
+   /// Used to create the fill contexts; its fields are connected to fSink but never filled
+   std::unique_ptr<RNTupleModel> fModel;
+   Detail::RNTupleMetrics fMetrics;
+   /// The number of entries in all the committed clusters
+   NTupleSize_t fNEntries = 0;
+   std::uint64_t fNextSequenceNumber = 0;
+   std::vector<std::weak_ptr<RNTupleFillContext>> fFillContexts;
+
+   /// Commits the open cluster of the context's sink that contains nEntriesCluster entries; the caller holds fMutex
+   std::uint64_t CommitClusterUnlocked(RNTupleFillContext &context, NTupleSize_t nEntriesCluster);
+
+public:
+   /// Throws an exception if the model is null.
+   static std::unique_ptr<RNTupleParallelWriter> Recreate(std::unique_ptr<RNTupleModel> model,
+                                                          std::string_view ntupleName,
+                                                          std::string_view storage,
+                                                          const RNTupleWriteOptions &options = RNTupleWriteOptions());
+   /// Throws an exception if the model or the sink is null.
+   RNTupleParallelWriter(std::unique_ptr<RNTupleModel> model, std::unique_ptr<Detail::RPageSink> sink);
+   RNTupleParallelWriter(const RNTupleParallelWriter &) = delete;
+   RNTupleParallelWriter &operator=(const RNTupleParallelWriter &) = delete;
+   ~RNTupleParallelWriter();
+
+   /// Thread-safe
+   std::shared_ptr<RNTupleFillContext> CreateFillContext();
+
+   void EnableMetrics() { fMetrics.Enable(); }
+   const Detail::RNTupleMetrics &GetMetrics() const { return fMetrics; }
+};
+
 // clang-format off
 /**
 \class ROOT::Experimental::RCollectionNTuple
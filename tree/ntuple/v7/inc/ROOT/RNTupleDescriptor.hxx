@@ -178,6 +178,24 @@ public:
       }
    };
 
+   /// The smallest and largest value of the elements of a page or of a column range. Value ranges are only
+   /// recorded for numerical columns; for other columns, or if the values are unknown, fIsValid is false.
+   /// The range is conservative: every element (apart from NaNs) is guaranteed to lie within [fMin, fMax].
+   struct RValueRange {
+      double fMin = 0.0;
+      double fMax = 0.0;
+      bool fIsValid = false;
+
+      /// Extends the range such that it also covers other; merging with an invalid range invalidates the result
+      void Merge(const RValueRange &other);
+      /// Returns false only if it is certain that no element is within [min, max]
+      bool Overlaps(double min, double max) const { return !fIsValid || (fMin <= max && fMax >= min); }
+
+      bool operator==(const RValueRange &other) const {
+         return fIsValid == other.fIsValid && (!fIsValid || (fMin == other.fMin && fMax == other.fMax));
+      }
+   };
+
    /// The window of element indexes of a particular column in a particular cluster
    struct RColumnRange {
       DescriptorId_t fColumnId = kInvalidDescriptorId;
@@ -188,13 +206,13 @@ public:
       /// The usual format for ROOT compression settings (see Compression.h).
       /// The pages of a particular column in a particular cluster are all compressed with the same settings.
       std::int64_t fCompressionSettings = 0;
-
-      // TODO(jblomer): we perhaps want to store summary information, such as average, min/max, etc.
-      // Should this be done on the field level?
+      /// The union of the value ranges of the column's pages in the cluster
+      RValueRange fValueRange;
 
       bool operator==(const RColumnRange &other) const {
          return fColumnId == other.fColumnId && fFirstElementIndex == other.fFirstElementIndex &&
-                fNElements == other.fNElements && fCompressionSettings == other.fCompressionSettings;
+                fNElements == other.fNElements && fCompressionSettings == other.fCompressionSettings &&
+                fValueRange == other.fValueRange;
       }
 
       bool Contains(NTupleSize_t index) const {
@@ -211,9 +229,11 @@ public:
          ClusterSize_t fNElements = kInvalidClusterIndex;
          /// The meaning of fLocator depends on the storage backend.
          RLocator fLocator;
+         /// Minimum and maximum of the page's elements, if the sink could compute them
+         RValueRange fValueRange;
 
          bool operator==(const RPageInfo &other) const {
-            return fNElements == other.fNElements && fLocator == other.fLocator;
+            return fNElements == other.fNElements && fLocator == other.fLocator && fValueRange == other.fValueRange;
          }
       };
       struct RPageInfoExtended : RPageInfo {
@@ -501,6 +521,9 @@ public:
    static constexpr unsigned int kNBytesPreamble = 8;
    /// The last few bytes after the footer store the length of footer and header
    static constexpr unsigned int kNBytesPostscript = 16;
+   /// Marks the optional section of value ranges after the cluster summaries in the footer. Readers that do not
+   /// know about value ranges stop parsing after the cluster summaries and thus ignore the section.
+   static constexpr std::uint32_t kValueRangeSectionTag = 0x52564E52; // "RNVR"
 
    RNTupleDescriptor() = default;
    RNTupleDescriptor(const RNTupleDescriptor &other) = delete;
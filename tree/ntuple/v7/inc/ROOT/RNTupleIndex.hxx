@@ -0,0 +1,99 @@
+/// \file ROOT/RNTupleIndex.hxx
+/// \ingroup NTuple ROOT7
+/// \date 2021-07-05
+/// \warning This is part of the ROOT 7 prototype! It will change without notice. It might trigger earthquakes. Feedback
+/// is welcome!
+
+/*************************************************************************
+ * Copyright (C) 1995-2021, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#ifndef ROOT7_RNTupleIndex
+#define ROOT7_RNTupleIndex
+
+#include <ROOT/RNTupleUtil.hxx>
+#include <ROOT/RStringView.hxx>
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+class TFile;
+
+namespace ROOT {
+namespace Experimental {
+
+class RNTupleReader;
+
+// clang-format off
+/**
+\class ROOT::Experimental::RNTupleIndex
+\ingroup NTuple
+\brief Maps the values of one or several integer key fields, e.g. (run, event), to entry numbers
+
+The index is built from an existing ntuple, one cluster range per task if implicit multi-threading is enabled.
+It can be stored next to the ntuple, as an ntuple of its own called `<ntuple name>.index`, and reopened later:
+~~~ {.cpp}
+auto ntuple = RNTupleReader::Open("events", "data.root");
+auto index = RNTupleIndex::Build(*ntuple, {"run", "event"});
+auto file = std::unique_ptr<TFile>(TFile::Open("data.root", "UPDATE"));
+index->Write("events", *file);
+// ... later ...
+auto index = RNTupleIndex::Open("events", "data.root");
+auto entry = index->GetEntryIndex({runNumber, eventNumber}); // kInvalidNTupleIndex if not found
+~~~
+
+The key fields must be of integral type; their values are compared as 64bit unsigned integers. GetEntryIndices()
+looks up many keys at once and returns the entry numbers in ascending order, such that the events to pick are
+read cluster after cluster.
+*/
+// clang-format on
+class RNTupleIndex {
+private:
+   std::vector<std::string> fKeyFieldNames;
+   /// The keys of the indexed entries, fKeyFieldNames.size() values per entry, in ascending order of the keys
+   std::vector<std::uint64_t> fKeys;
+   /// The entry numbers corresponding to fKeys; entries with the same key are in ascending order
+   std::vector<NTupleSize_t> fEntries;
+
+   explicit RNTupleIndex(const std::vector<std::string> &keyFieldNames) : fKeyFieldNames(keyFieldNames) {}
+   /// Orders the entries read in by their keys
+   void Sort();
+   /// Returns the range of positions in fEntries with the given key
+   std::pair<std::size_t, std::size_t> FindRange(const std::vector<std::uint64_t> &key) const;
+
+public:
+   /// Reads the key fields of all the entries of the ntuple.  Throws an RException if a field does not exist
+   /// or is not of integral type.
+   static std::unique_ptr<RNTupleIndex> Build(RNTupleReader &reader, const std::vector<std::string> &keyFieldNames);
+   /// Reads the index stored by Write() next to the ntuple of the given name
+   static std::unique_ptr<RNTupleIndex> Open(std::string_view ntupleName, std::string_view storage);
+   /// The name of the ntuple the index of the given ntuple is stored in
+   static std::string GetIndexNTupleName(std::string_view ntupleName) { return std::string(ntupleName) + ".index"; }
+
+   /// Stores the index of the given ntuple in the file, which usually is the one of the ntuple
+   void Write(std::string_view ntupleName, TFile &file) const;
+
+   const std::vector<std::string> &GetKeyFieldNames() const { return fKeyFieldNames; }
+   /// The number of indexed entries
+   std::size_t GetSize() const { return fEntries.size(); }
+
+   /// Returns the first entry with the given key, or kInvalidNTupleIndex
+   NTupleSize_t GetEntryIndex(const std::vector<std::uint64_t> &key) const;
+   /// Returns all the entries with the given key, in ascending order
+   std::vector<NTupleSize_t> GetAllEntryIndices(const std::vector<std::uint64_t> &key) const;
+   /// Returns the entries with any of the given keys, in ascending order and without duplicates; keys not found are
+   /// skipped.  Reading the entries in this order loads every cluster at most once.
+   std::vector<NTupleSize_t> GetEntryIndices(const std::vector<std::vector<std::uint64_t>> &keys) const;
+};
+
+} // namespace Experimental
+} // namespace ROOT
+
+#endif
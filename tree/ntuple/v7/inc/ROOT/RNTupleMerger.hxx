@@ -20,9 +20,16 @@
 #include <ROOT/RNTupleDescriptor.hxx>
 #include <ROOT/RNTupleUtil.hxx>
 
+#include <vector>
+
 namespace ROOT {
 namespace Experimental {
 
+namespace Detail {
+class RPageSink;
+class RPageSource;
+} // namespace Detail
+
 // clang-format off
 /**
 \class ROOT::Experimental::RFieldMerger
@@ -38,6 +45,27 @@ public:
    static RResult<RFieldMerger> Merge(const RFieldDescriptor &lhs, const RFieldDescriptor &rhs);
 };
 
+// clang-format off
+/**
+\class ROOT::Experimental::RNTupleMerger
+\ingroup NTuple
+\brief Concatenates ntuples of the same schema by copying their sealed pages
+
+The clusters of the sources are appended, in order, to the destination without decompressing and recompressing
+the pages. Therefore, all the sources must have the same fields and columns, and their pages must be compressed
+with the compression settings of the destination.
+
+With implicit multi-threading enabled, the pages of as many clusters as there are threads in the pool are read
+concurrently, each through its own clone of the page source, while the previously read clusters are committed.
+*/
+// clang-format on
+class RNTupleMerger {
+public:
+   /// Creates the destination from the schema of the first source and fills it with the clusters of all the sources.
+   /// Throws an RException if the sources are incompatible with each other or with the destination's write options.
+   void Merge(const std::vector<Detail::RPageSource *> &sources, Detail::RPageSink &destination);
+};
+
 } // namespace Experimental
 } // namespace ROOT
 
@@ -28,6 +28,7 @@
 #include <functional>
 #include <limits>
 #include <memory>
+#include <mutex>
 #include <ostream>
 #include <string>
 #include <vector>
@@ -106,6 +107,9 @@ public:
 \class ROOT::Experimental::Detail::RNTupleAtomicCounter
 \ingroup NTuple
 \brief A thread-safe integral performance counter
+
+The counter only provides atomicity of its own updates, which are relaxed memory operations; it does not order
+other memory accesses.  That keeps it cheap enough to be updated concurrently from many threads.
 */
 // clang-format on
 class RNTupleAtomicCounter : public RNTuplePerfCounter {
@@ -119,39 +123,39 @@ public:
    R__ALWAYS_INLINE
    void Inc() {
       if (R__unlikely(IsEnabled()))
-         ++fCounter;
+         fCounter.fetch_add(1, std::memory_order_relaxed);
    }
 
    R__ALWAYS_INLINE
    void Dec() {
       if (R__unlikely(IsEnabled()))
-         --fCounter;
+         fCounter.fetch_sub(1, std::memory_order_relaxed);
    }
 
    R__ALWAYS_INLINE
    void Add(int64_t delta) {
       if (R__unlikely(IsEnabled()))
-         fCounter += delta;
+         fCounter.fetch_add(delta, std::memory_order_relaxed);
    }
 
    R__ALWAYS_INLINE
    int64_t XAdd(int64_t delta) {
       if (R__unlikely(IsEnabled()))
-         return fCounter.fetch_add(delta);
+         return fCounter.fetch_add(delta, std::memory_order_relaxed);
       return 0;
    }
 
    R__ALWAYS_INLINE
    int64_t GetValue() const {
       if (R__unlikely(IsEnabled()))
-         return fCounter.load();
+         return fCounter.load(std::memory_order_relaxed);
       return 0;
    }
 
    R__ALWAYS_INLINE
    void SetValue(int64_t val) {
       if (R__unlikely(IsEnabled()))
-         fCounter.store(val);
+         fCounter.store(val, std::memory_order_relaxed);
    }
 
    std::int64_t GetValueAsInt() const override { return GetValue(); }
@@ -320,12 +324,86 @@ public:
    const RNTuplePerfCounter *GetCounter(std::string_view name) const;
 
    void ObserveMetrics(RNTupleMetrics &observee);
+   /// Calls `fn` with the full dotted name of every counter of this object and, recursively, of the observed
+   /// sub metrics
+   void ForEachCounter(const std::function<void(const std::string &, const RNTuplePerfCounter &)> &fn,
+                       const std::string &prefix = "") const;
 
    void Print(std::ostream &output, const std::string &prefix = "") const;
    void Enable();
    bool IsEnabled() const { return fIsEnabled; }
 };
 
+
+// clang-format off
+/**
+\class ROOT::Experimental::Detail::RNTupleMetricsRegistry
+\ingroup NTuple
+\brief Process-wide aggregation of the metrics of all the ntuple readers and writers
+
+The readers and writers register their metrics on construction and unregister them on destruction, at which
+point the values of their counters are added to the totals of the process.  Counters with the same dotted name,
+e.g. `RNTupleReader.RPageSourceFile.szReadPayload`, are summed over all the live and past readers and writers.
+Computed metrics (RNTupleCalcPerf), such as rates and ratios, are not aggregated.  The totals also comprise the
+process-wide TFile I/O counters (`TFile.bytesRead`, `TFile.bytesWritten`, `TFile.readCalls`).
+
+When the registry is enabled, the metrics of the readers and writers constructed afterwards are enabled as well.
+The aggregated values can be exported as JSON, e.g. to be served by a THttpServer command, or in the
+Prometheus text exposition format.
+
+~~~ {.cpp}
+ROOT::Experimental::Detail::RNTupleMetricsRegistry::Instance().Enable();
+// ... read and write ntuples ...
+std::cout << ROOT::Experimental::Detail::RNTupleMetricsRegistry::Instance().GetPrometheusText();
+~~~
+*/
+// clang-format on
+class RNTupleMetricsRegistry {
+public:
+   /// The aggregated value of all the counters with a given dotted name
+   struct RAggregate {
+      std::string fName;
+      std::string fUnit;
+      std::string fDescription;
+      std::int64_t fValue = 0;
+   };
+
+private:
+   mutable std::mutex fLock;
+   std::vector<const RNTupleMetrics *> fLiveMetrics;
+   /// The totals of the counters of the metrics unregistered so far
+   std::vector<RAggregate> fRetired;
+   std::atomic<bool> fIsEnabled{false};
+
+   static void Accumulate(std::vector<RAggregate> &aggregates, const RNTupleMetrics &metrics);
+
+   RNTupleMetricsRegistry() = default;
+
+public:
+   RNTupleMetricsRegistry(const RNTupleMetricsRegistry &other) = delete;
+   RNTupleMetricsRegistry &operator=(const RNTupleMetricsRegistry &other) = delete;
+
+   static RNTupleMetricsRegistry &Instance();
+
+   /// Enables the metrics of the readers and writers constructed from now on
+   void Enable() { fIsEnabled = true; }
+   void Disable() { fIsEnabled = false; }
+   bool IsEnabled() const { return fIsEnabled; }
+
+   /// The metrics must stay valid until they are unregistered.  If the registry is enabled, they get enabled.
+   void Register(RNTupleMetrics &metrics);
+   /// Adds the current values of the counters to the totals of the process
+   void Unregister(const RNTupleMetrics &metrics);
+
+   /// The totals of the live and unregistered metrics, sorted by name
+   std::vector<RAggregate> GetAggregates() const;
+   /// A JSON object of the form `{"name": {"unit": "...", "description": "...", "value": 42}, ...}`
+   std::string GetJSON() const;
+   /// Prometheus text exposition format; the dots in the names become underscores and the names get the
+   /// `root_` prefix
+   std::string GetPrometheusText() const;
+};
+
 } // namespace Detail
 } // namespace Experimental
 } // namespace ROOT
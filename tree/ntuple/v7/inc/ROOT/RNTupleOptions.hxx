@@ -18,8 +18,11 @@
 
 #include <Compression.h>
 #include <ROOT/RNTupleUtil.hxx>
+#include <ROOT/RStringView.hxx>
 
+#include <map>
 #include <memory>
+#include <string>
 
 namespace ROOT {
 namespace Experimental {
@@ -48,6 +51,8 @@ All page sink classes need to support the common options.
 // clang-format on
 class RNTupleWriteOptions {
    int fCompression{RCompressionSetting::EDefaults::kUseAnalysis};
+   /// Compression settings of individual fields by qualified field name, see SetFieldCompression()
+   std::map<std::string, int> fFieldCompression;
    ENTupleContainerFormat fContainerFormat{ENTupleContainerFormat::kTFile};
    /// Approximation of the target compressed cluster size
    std::size_t fApproxZippedClusterSize = 50 * 1000 * 1000;
@@ -59,6 +64,10 @@ class RNTupleWriteOptions {
    /// fApproxUnzippedPageSize in size and tail pages (the last page in a cluster) is between
    /// fApproxUnzippedPageSize/2 and fApproxUnzippedPageSize * 1.5 in size.
    std::size_t fApproxUnzippedPageSize = 64 * 1024;
+   /// If non-zero, the page size is adapted per column such that the compressed pages are approximately
+   /// fApproxZippedPageSize in size.  The adaption uses the compression ratio measured on the already written
+   /// clusters; until the first cluster is committed, pages are sized according to fApproxUnzippedPageSize.
+   std::size_t fApproxZippedPageSize = 0;
    bool fUseBufferedWrite = true;
 
 public:
@@ -71,6 +80,13 @@ public:
       fCompression = CompressionSettings(algorithm, compressionLevel);
    }
 
+   /// Overrides the compression for the columns of a field, given by its qualified name such as "jets.pt".  The
+   /// setting also applies to the sub-fields with no setting of their own.  For instance, the offsets of a rarely
+   /// read collection can use LZMA while its frequently read members use LZ4.
+   void SetFieldCompression(std::string_view fieldName, int val) { fFieldCompression[std::string(fieldName)] = val; }
+   /// Returns the compression of the field, inherited from its closest parent field with a setting or GetCompression()
+   int GetFieldCompression(std::string_view fieldName) const;
+
    ENTupleContainerFormat GetContainerFormat() const { return fContainerFormat; }
    void SetContainerFormat(ENTupleContainerFormat val) { fContainerFormat = val; }
 
@@ -83,6 +99,10 @@ public:
    std::size_t GetApproxUnzippedPageSize() const { return fApproxUnzippedPageSize; }
    void SetApproxUnzippedPageSize(std::size_t val);
 
+   std::size_t GetApproxZippedPageSize() const { return fApproxZippedPageSize; }
+   /// A value of 0 switches off the adaptive page size
+   void SetApproxZippedPageSize(std::size_t val) { fApproxZippedPageSize = val; }
+
    bool GetUseBufferedWrite() const { return fUseBufferedWrite; }
    void SetUseBufferedWrite(bool val) { fUseBufferedWrite = val; }
 };
@@ -123,15 +143,28 @@ public:
    enum EClusterCache {
       kOff,
       kOn,
+      /// Like kOn but the cluster pool's look-ahead window follows the observed I/O latency and consumption rate
+      kAdaptive,
       kDefault = kOn,
    };
 
 private:
    EClusterCache fClusterCache = EClusterCache::kDefault;
+   /// Upper limit for the memory taken by the unzipped pages of a page source and its clones; if zero, pages are
+   /// freed as soon as they are not used anymore.  Otherwise, unused pages are kept and the least recently used ones
+   /// are freed when the limit is reached.
+   std::size_t fPagePoolMemoryBudget = 0;
+   /// If set and the file is local, the page source maps the file into memory instead of reading clusters into
+   /// buffers.  Uncompressed pages are then used in place, compressed pages are unzipped directly from the mapping.
+   bool fUseMemoryMap = false;
 
 public:
    EClusterCache GetClusterCache() const { return fClusterCache; }
    void SetClusterCache(EClusterCache val) { fClusterCache = val; }
+   std::size_t GetPagePoolMemoryBudget() const { return fPagePoolMemoryBudget; }
+   void SetPagePoolMemoryBudget(std::size_t val) { fPagePoolMemoryBudget = val; }
+   bool GetUseMemoryMap() const { return fUseMemoryMap; }
+   void SetUseMemoryMap(bool val) { fUseMemoryMap = val; }
 };
 
 } // namespace Experimental
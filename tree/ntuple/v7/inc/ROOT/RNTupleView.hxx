@@ -18,6 +18,7 @@
 
 #include <ROOT/RField.hxx>
 #include <ROOT/RNTupleUtil.hxx>
+#include <ROOT/RSpan.hxx>
 #include <ROOT/RStringView.hxx>
 
 #include <iterator>
@@ -145,7 +146,9 @@ The view owns a field and its underlying columns in order to fill an ntuple valu
 accessed by index. For top-level fields, the index refers to the entry number. Fields that are part of
 nested collections have global index numbers that are derived from their parent indexes.
 
-Fields of simple types with a Map() method will use that and thus expose zero-copy access.
+Fields of simple types with a Map() method will use that and thus expose zero-copy access. For such fields,
+MapSpan() provides bulk access to all the consecutive elements of a page, so that data can be processed
+page-by-page without a call per element.
 */
 // clang-format on
 template <typename T>
@@ -215,6 +218,24 @@ public:
    MapV(const RClusterIndex &clusterIndex, NTupleSize_t &nItems) {
       return fField.MapV(clusterIndex, nItems);
    }
+
+   /// Returns the elements from globalIndex up to the end of the page that contains globalIndex. The next page
+   /// starts at globalIndex + size() of the returned span. The span is valid until the view maps another page.
+   template <typename C = T>
+   typename std::enable_if_t<Internal::IsMappable<FieldT>::value, std::span<const C>>
+   MapSpan(NTupleSize_t globalIndex) {
+      NTupleSize_t nItems;
+      const C *items = fField.MapV(globalIndex, nItems);
+      return std::span<const C>(items, nItems);
+   }
+
+   template <typename C = T>
+   typename std::enable_if_t<Internal::IsMappable<FieldT>::value, std::span<const C>>
+   MapSpan(const RClusterIndex &clusterIndex) {
+      NTupleSize_t nItems;
+      const C *items = fField.MapV(clusterIndex, nItems);
+      return std::span<const C>(items, nItems);
+   }
 };
 
 
@@ -18,9 +18,11 @@
 
 #include <ROOT/RPage.hxx>
 #include <ROOT/RPageAllocator.hxx>
+#include <ROOT/RNTupleMetrics.hxx>
 #include <ROOT/RNTupleUtil.hxx>
 
 #include <cstddef>
+#include <cstdint>
 #include <mutex>
 #include <vector>
 
@@ -38,32 +40,61 @@ namespace Detail {
 The page pool provides memory tracking for data written into an ntuple or read from an ntuple. Adding and removing
 pages is thread-safe. The page pool does not allocate the memory -- allocation and deallocation is performed by the
 page storage, which might do it in a way optimized to the backing store (e.g., mmap()).
-Multiple page caches can coexist.
+Multiple page caches can coexist, and a page cache can be shared by several page sources reading the same ntuple
+(see RPageSource::Clone()).
 
-TODO(jblomer): it should be possible to register pages and to find them by column and index; this would
-facilitate pre-filling a cache, e.g. by read-ahead.
+Without a memory budget, pages are freed as soon as their reference counter drops to zero; preloaded pages are kept
+until they have been used once.  With a memory budget, unreferenced pages remain in the pool so that they can be
+found again.  Whenever the pages in the pool take more than the budget, the least recently used unreferenced pages
+are freed.  Pages in use are never freed, so the budget can be exceeded temporarily.
 */
 // clang-format on
 class RPagePool {
 private:
+   struct REntry {
+      RPage fPage;
+      std::int32_t fReferences = 0;
+      RPageDeleter fDeleter;
+      /// Value of fClock when the page was last added, found or returned
+      std::uint64_t fLastUse = 0;
+   };
+
    /// TODO(jblomer): should be an efficient index structure that allows
    ///   - random insert
    ///   - random delete
    ///   - searching by page
    ///   - searching by tree index
-   std::vector<RPage> fPages;
-   std::vector<std::int32_t> fReferences;
-   std::vector<RPageDeleter> fDeleters;
+   std::vector<REntry> fEntries;
+   /// Maximum number of bytes of the pages in the pool; zero means no caching of returned pages
+   std::size_t fMemoryBudget = 0;
+   /// Sum of the page sizes in the pool
+   std::size_t fNBytes = 0;
+   /// Logical time for the LRU eviction
+   std::uint64_t fClock = 0;
    std::mutex fLock;
 
+   RNTupleMetrics fMetrics;
+   RNTupleAtomicCounter *fCtrNHit = nullptr;
+   RNTupleAtomicCounter *fCtrNMiss = nullptr;
+   RNTupleAtomicCounter *fCtrNEvicted = nullptr;
+   RNTupleAtomicCounter *fCtrSzPages = nullptr;
+
+   /// The following methods must be called with fLock held
+   void AddPage(const RPage &page, const RPageDeleter &deleter, std::int32_t nReferences);
+   void RemovePage(std::size_t idx);
+   /// Frees the least recently used unreferenced pages until the pool fits into the memory budget
+   void EvictPages();
+
 public:
-   RPagePool() = default;
+   explicit RPagePool(std::size_t memoryBudget = 0);
    RPagePool(const RPagePool&) = delete;
    RPagePool& operator =(const RPagePool&) = delete;
-   ~RPagePool() = default;
+   /// Frees the pages that are still in the pool
+   ~RPagePool();
 
    /// Adds a new page to the pool together with the function to free its space. Upon registration,
    /// the page pool takes ownership of the page's memory. The new page has its reference counter set to 1.
+   /// A registered page is accounted as a cache miss.
    void RegisterPage(const RPage &page, const RPageDeleter &deleter);
    /// Like RegisterPage() but the reference counter is initialized to 0
    void PreloadPage(const RPage &page, const RPageDeleter &deleter);
@@ -75,6 +106,14 @@ public:
    /// this page. If the reference counter drops to zero, the page pool might decide to call the deleter given in
    /// during registration.
    void ReturnPage(const RPage &page);
+
+   std::size_t GetMemoryBudget() const { return fMemoryBudget; }
+   /// Returns the number of pages currently in the pool, including the ones in use
+   std::size_t GetNPages();
+   /// Returns the number of bytes of the pages currently in the pool, including the ones in use
+   std::size_t GetNBytes();
+
+   RNTupleMetrics &GetMetrics() { return fMetrics; }
 };
 
 } // namespace Detail
@@ -125,6 +125,11 @@ public:
    RPage ReservePage(ColumnHandle_t columnHandle, std::size_t nElements) final;
    void ReleasePage(RPage &page) final;
 
+   double GetNBytesPerElementOnStorage(DescriptorId_t columnId) const final
+   {
+      return fInnerSink->GetNBytesPerElementOnStorage(columnId);
+   }
+
    RNTupleMetrics &GetMetrics() final { return fMetrics; }
 };
 
@@ -29,6 +29,7 @@
 #include <functional>
 #include <memory>
 #include <unordered_set>
+#include <vector>
 
 namespace ROOT {
 namespace Experimental {
@@ -83,6 +84,9 @@ public:
       const void *fBuffer = nullptr;
       std::uint32_t fSize = 0;
       std::uint32_t fNElements = 0;
+      /// The value range of the page's elements; sealing a page does not set it because the sealed page
+      /// is not necessarily written by the sink that sealed it (see RPageSink::GetValueRange())
+      RClusterDescriptor::RValueRange fValueRange;
 
       RSealedPage() = default;
       RSealedPage(const void *b, std::uint32_t s, std::uint32_t n) : fBuffer(b), fSize(s), fNElements(n) {}
@@ -181,6 +185,16 @@ protected:
    std::vector<RClusterDescriptor::RColumnRange> fOpenColumnRanges;
    /// Keeps track of the written pages in the currently open cluster. Indexed by column id.
    std::vector<RClusterDescriptor::RPageRange> fOpenPageRanges;
+   /// Whether CommitPage() records the value ranges of the pages.  Sinks that forward to an inner sink, whose
+   /// meta-data is the one that gets written, switch it off to avoid computing the value ranges twice.
+   bool fComputeValueRanges = true;
+   /// Number of elements and bytes on storage of the committed pages of a column
+   struct RColumnStorageStats {
+      std::uint64_t fNElements = 0;
+      std::uint64_t fNBytesOnStorage = 0;
+   };
+   /// Accumulated over all clusters, for the pages whose size on storage is known.  Indexed by column id.
+   std::vector<RColumnStorageStats> fColumnStorageStats;
    RNTupleDescriptorBuilder fDescriptorBuilder;
 
    virtual void CreateImpl(const RNTupleModel &model) = 0;
@@ -202,6 +216,9 @@ protected:
    static RSealedPage SealPage(const RPage &page, const RColumnElementBase &element,
       int compressionSetting, void *buf);
 
+   /// Computes the minimum and maximum of the elements of an unsealed page, if the column type supports it.
+   static RClusterDescriptor::RValueRange GetValueRange(const RPage &page, const RColumnElementBase &element);
+
    /// Enables the default set of metrics provided by RPageSink. `prefix` will be used as the prefix for
    /// the counters registered in the internal RNTupleMetrics object.
    /// This set of counters can be extended by a subclass by calling `fMetrics.MakeCounter<...>()`.
@@ -228,9 +245,17 @@ public:
    EPageStorageType GetType() final { return EPageStorageType::kSink; }
    /// Returns the sink's write options.
    const RNTupleWriteOptions &GetWriteOptions() const { return *fOptions; }
+   /// Returns the descriptor of the ntuple being written, complete with the fields and columns after Create()
+   const RNTupleDescriptor &GetDescriptor() const { return fDescriptorBuilder.GetDescriptor(); }
 
    ColumnHandle_t AddColumn(DescriptorId_t fieldId, const RColumn &column) final;
    void DropColumn(ColumnHandle_t /*columnHandle*/) final {}
+   /// Returns the compression setting used for the pages of the column, known after Create().  It follows
+   /// RNTupleWriteOptions::GetFieldCompression() for the field of the column.
+   int GetColumnCompression(DescriptorId_t columnId) const
+   {
+      return static_cast<int>(fOpenColumnRanges.at(columnId).fCompressionSettings);
+   }
 
    /// Physically creates the storage container to hold the ntuple (e.g., a keys a TFile or an S3 bucket)
    /// To do so, Create() calls CreateImpl() after updating the descriptor.
@@ -251,6 +276,11 @@ public:
    /// the page sink picks an appropriate size.
    virtual RPage ReservePage(ColumnHandle_t columnHandle, std::size_t nElements) = 0;
 
+   /// Returns the average number of bytes on storage per element of the pages committed so far for the given column,
+   /// or 0 if the storage size is not yet known.  Used by the columns to adapt their page size to the compression
+   /// ratio (see RNTupleWriteOptions::SetApproxZippedPageSize()).
+   virtual double GetNBytesPerElementOnStorage(DescriptorId_t columnId) const;
+
    /// Returns the default metrics object.  Subclasses might alternatively provide their own metrics object by overriding this.
    virtual RNTupleMetrics &GetMetrics() override { return fMetrics; };
 };
@@ -269,6 +299,11 @@ class RPageSource : public RPageStorage {
 public:
    /// Derived from the model (fields) that are actually being requested at a given point in time
    using ColumnSet_t = std::unordered_set<DescriptorId_t>;
+   /// The cluster id and the subset of its columns to load in a call to LoadClusters()
+   struct RClusterKey {
+      DescriptorId_t fClusterId = kInvalidDescriptorId;
+      ColumnSet_t fColumns;
+   };
 
 protected:
    /// Default I/O performance counters that get registered in fMetrics
@@ -369,6 +404,10 @@ public:
    /// LoadCluster() is typically called from the I/O thread of a cluster pool, i.e. the method runs
    /// concurrently to other methods of the page source.
    virtual std::unique_ptr<RCluster> LoadCluster(DescriptorId_t clusterId, const ColumnSet_t &columns) = 0;
+   /// Populates the pages of several clusters at once, see LoadCluster().  The clusters are returned in the order
+   /// of the keys.  Storage backends that can have many requests in flight override the default implementation,
+   /// which loads the clusters one after the other.
+   virtual std::vector<std::unique_ptr<RCluster>> LoadClusters(const std::vector<RClusterKey> &clusterKeys);
 
    /// Parallel decompression and unpacking of the pages in the given cluster. The unzipped pages are supposed
    /// to be preloaded in a page pool attached to the source. The method is triggered by the cluster pool's
@@ -25,6 +25,7 @@
 #include <cstdio>
 #include <memory>
 #include <string>
+#include <vector>
 
 namespace ROOT {
 
@@ -85,6 +86,7 @@ struct RDaosNTupleAnchor {
 \brief Storage provider that writes ntuple pages to into a DAOS container
 
 Currently, an object is allocated for each page + 3 additional objects (anchor/header/footer).
+The pages of a cluster are buffered and written when the cluster is committed.
 */
 // clang-format on
 class RPageSinkDaos : public RPageSink {
@@ -102,6 +104,14 @@ private:
    std::string fURI;
    /// Tracks the number of bytes committed to the current cluster
    std::uint64_t fNBytesCurrentCluster{0};
+   /// The sealed pages of the current cluster are copied here by `CommitSealedPageImpl()` and written
+   /// together, as asynchronous updates completing in a single event queue, by `CommitClusterImpl()`
+   std::vector<std::unique_ptr<unsigned char[]>> fPendingPageBuffers;
+   std::vector<std::size_t> fPendingPageSizes;
+   std::vector<std::uint64_t> fPendingPageOids;
+
+   /// Writes the pending pages of the current cluster
+   void FlushPendingPages();
 
    RDaosNTupleAnchor fNTupleAnchor;
 
@@ -151,7 +161,7 @@ private:
    /// Populated pages might be shared; the memory buffer is managed by the RPageAllocatorDaos
    std::unique_ptr<RPageAllocatorDaos> fPageAllocator;
    // TODO: the page pool should probably be handled by the base class.
-   /// The page pool might, at some point, be used by multiple page sources
+   /// The page pool is shared with the clones of this page source
    std::shared_ptr<RPagePool> fPagePool;
    /// The last cluster from which a page got populated.  Points into fClusterPool->fPool
    RCluster *fCurrentCluster = nullptr;
@@ -162,6 +172,8 @@ private:
    /// The cluster pool asynchronously preloads the next few clusters
    std::unique_ptr<RClusterPool> fClusterPool;
 
+   RPageSourceDaos(std::string_view ntupleName, std::string_view uri, const RNTupleReadOptions &options,
+                   std::shared_ptr<RPagePool> pagePool);
    RPage PopulatePageFromCluster(ColumnHandle_t columnHandle, const RClusterDescriptor &clusterDescriptor,
                                  ClusterSize_t::ValueType idxInCluster);
 
@@ -172,7 +184,7 @@ protected:
 public:
    RPageSourceDaos(std::string_view ntupleName, std::string_view uri, const RNTupleReadOptions &options);
    /// The cloned page source creates a new connection to the pool/container.
-   /// The meta-data (header and footer) is reread and parsed by the clone.
+   /// The meta-data (header and footer) is reread and parsed by the clone.  The clone shares the page pool.
    std::unique_ptr<RPageSource> Clone() const final;
    virtual ~RPageSourceDaos();
 
@@ -184,6 +196,8 @@ public:
                        RSealedPage &sealedPage) final;
 
    std::unique_ptr<RCluster> LoadCluster(DescriptorId_t clusterId, const ColumnSet_t &columns) final;
+   /// Issues the fetches of the pages of all the clusters at once, see RDaosContainer::ReadV()
+   std::vector<std::unique_ptr<RCluster>> LoadClusters(const std::vector<RClusterKey> &clusterKeys) final;
 
    /// Return the object class used for user data OIDs in this ntuple.
    std::string GetObjectClass() const;
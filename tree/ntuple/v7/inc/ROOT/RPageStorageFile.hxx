@@ -117,11 +117,16 @@ class RPageSourceFile : public RPageSource {
 public:
    /// Cannot process pages larger than 1MB
    static constexpr std::size_t kMaxPageSize = 1024 * 1024;
+   /// When unzipping a cluster in parallel, pages are grouped into tasks of at least this many unzipped bytes
+   static constexpr std::size_t kMinUnzipTaskSize = 64 * 1024;
 
 private:
+   /// Read-only mapping of the entire file, see RNTupleReadOptions::SetUseMemoryMap()
+   class RMappedFile;
+
    /// Populated pages might be shared; there memory buffer is managed by the RPageAllocatorFile
    std::unique_ptr<RPageAllocatorFile> fPageAllocator;
-   /// The page pool might, at some point, be used by multiple page sources
+   /// The page pool is shared with the clones of this page source
    std::shared_ptr<RPagePool> fPagePool;
    /// The last cluster from which a page got populated.  Points into fClusterPool->fPool
    RCluster *fCurrentCluster = nullptr;
@@ -131,10 +136,18 @@ private:
    Internal::RMiniFileReader fReader;
    /// The cluster pool asynchronously preloads the next few clusters
    std::unique_ptr<RClusterPool> fClusterPool;
+   /// If set, clusters are views into the mapping and the pages that are neither compressed nor packed point into
+   /// it directly.  Clusters and pages hold a reference, so that the mapping outlives them.  Shared with the clones.
+   std::shared_ptr<RMappedFile> fMappedFile;
 
-   RPageSourceFile(std::string_view ntupleName, const RNTupleReadOptions &options);
+   RPageSourceFile(std::string_view ntupleName, const RNTupleReadOptions &options,
+                   std::shared_ptr<RPagePool> pagePool);
    RPage PopulatePageFromCluster(ColumnHandle_t columnHandle, const RClusterDescriptor &clusterDescriptor,
                                  ClusterSize_t::ValueType idxInCluster);
+   /// Creates the page from its sealed version, in place in the memory mapping if possible, with the matching deleter
+   RPage CreatePage(DescriptorId_t columnId, const RSealedPage &sealedPage, const RColumnElementBase &element,
+                    RPageDeleter &deleter);
+   std::unique_ptr<RCluster> LoadMappedCluster(DescriptorId_t clusterId, const ColumnSet_t &columns);
 
 protected:
    RNTupleDescriptor AttachImpl() final;
@@ -143,7 +156,8 @@ protected:
 public:
    RPageSourceFile(std::string_view ntupleName, std::string_view path, const RNTupleReadOptions &options);
    /// The cloned page source creates a new raw file and reader and opens its own file descriptor to the data.
-   /// The meta-data (header and footer) is reread and parsed by the clone.
+   /// The meta-data (header and footer) is reread and parsed by the clone.  The clone shares the page pool,
+   /// so that pages unzipped by one of the page sources can be used by all of them.
    std::unique_ptr<RPageSource> Clone() const final;
 
    RPageSourceFile(const RPageSourceFile&) = delete;
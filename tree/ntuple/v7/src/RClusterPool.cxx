@@ -15,12 +15,15 @@
 
 #include <ROOT/RClusterPool.hxx>
 #include <ROOT/RNTupleDescriptor.hxx>
+#include <ROOT/RNTupleOptions.hxx>
 #include <ROOT/RPageStorage.hxx>
+#include <ROOT/RTrace.hxx>
 
 #include <TError.h>
 
 #include <algorithm>
 #include <chrono>
+#include <cstdint>
 #include <future>
 #include <iostream>
 #include <iterator>
@@ -47,9 +50,32 @@ bool ROOT::Experimental::Detail::RClusterPool::RInFlightCluster::operator <(cons
    return fClusterId < other.fClusterId;
 }
 
-ROOT::Experimental::Detail::RClusterPool::RClusterPool(RPageSource &pageSource, unsigned int size)
+namespace {
+
+/// Folds a new sample into an exponential moving average; the first sample initializes the average
+std::int64_t UpdateMovingAverage(std::int64_t average, std::int64_t sample)
+{
+   if (average == 0)
+      return sample;
+   using RClusterPool = ROOT::Experimental::Detail::RClusterPool;
+   return static_cast<std::int64_t>(RClusterPool::kSmoothingFactor * sample +
+                                    (1. - RClusterPool::kSmoothingFactor) * average);
+}
+
+bool IsAdaptive(const ROOT::Experimental::Detail::RPageSource &pageSource)
+{
+   return pageSource.GetReadOptions().GetClusterCache() ==
+          ROOT::Experimental::RNTupleReadOptions::EClusterCache::kAdaptive;
+}
+
+} // anonymous namespace
+
+ROOT::Experimental::Detail::RClusterPool::RClusterPool(RPageSource &pageSource, unsigned int size,
+                                                       EWindowPolicy windowPolicy)
    : fPageSource(pageSource)
+   , fWindowPolicy(windowPolicy)
    , fPool(size)
+   , fMetrics("RClusterPool")
    , fThreadIo(&RClusterPool::ExecReadClusters, this)
    , fThreadUnzip(&RClusterPool::ExecUnzipClusters, this)
 {
@@ -61,6 +87,23 @@ ROOT::Experimental::Detail::RClusterPool::RClusterPool(RPageSource &pageSource,
       fWindowPre++;
       fWindowPost--;
    }
+   fMaxWindowPost = fWindowPost;
+   // An adaptive window starts with the look-ahead of the default pool and then follows the observed rates
+   if (fWindowPolicy == EWindowPolicy::kAdaptive)
+      fWindowPost = std::min(fMaxWindowPost, kDefaultPoolSize - 1);
+
+   fCtrWindowPost = fMetrics.MakeCounter<RNTupleAtomicCounter *>("windowPost", "",
+                                                                 "current size of the look-ahead window");
+   fCtrIoLatency = fMetrics.MakeCounter<RNTupleAtomicCounter *>("ioLatency", "ns",
+                                                                "moving average of the time to load a cluster");
+   fCtrConsumeTime = fMetrics.MakeCounter<RNTupleAtomicCounter *>("consumeTime", "ns",
+                                                                  "moving average of the time to process a cluster");
+}
+
+ROOT::Experimental::Detail::RClusterPool::RClusterPool(RPageSource &pageSource)
+   : RClusterPool(pageSource, IsAdaptive(pageSource) ? kMaxAdaptivePoolSize : kDefaultPoolSize,
+                  IsAdaptive(pageSource) ? EWindowPolicy::kAdaptive : EWindowPolicy::kFixed)
+{
 }
 
 ROOT::Experimental::Detail::RClusterPool::~RClusterPool()
@@ -99,7 +142,10 @@ void ROOT::Experimental::Detail::RClusterPool::ExecUnzipClusters()
          if (!item.fCluster)
             return;
 
-         fPageSource.UnzipCluster(item.fCluster.get());
+         {
+            R__TRACE_SPAN("io", "RClusterPool unzip", item.fCluster->GetId());
+            fPageSource.UnzipCluster(item.fCluster.get());
+         }
 
          // Afterwards the GetCluster() method in the main thread can pick-up the cluster
          item.fPromise.set_value(std::move(item.fCluster));
@@ -120,35 +166,60 @@ void ROOT::Experimental::Detail::RClusterPool::ExecReadClusters()
          }
       }
 
-      for (auto &item : readItems) {
-         if (item.fClusterId == kInvalidDescriptorId)
-            return;
-
-         // TODO(jblomer): the page source needs to be capable of loading multiple clusters in one go
-         auto cluster = fPageSource.LoadCluster(item.fClusterId, item.fColumns);
+      // The items up to the termination request are loaded in one go, so that the page source can have the
+      // requests for all the clusters in flight at the same time
+      bool isTerminated = false;
+      std::vector<RPageSource::RClusterKey> clusterKeys;
+      for (std::size_t i = 0; i < readItems.size(); ++i) {
+         if (readItems[i].fClusterId == kInvalidDescriptorId) {
+            readItems.resize(i);
+            isTerminated = true;
+            break;
+         }
+         clusterKeys.emplace_back(RPageSource::RClusterKey{readItems[i].fClusterId, readItems[i].fColumns});
+      }
 
-         // Meanwhile, the user might have requested clusters outside the look-ahead window, so that we don't
-         // need the cluster anymore, in which case we simply discard it right away, before moving it to the pool
-         bool discard = false;
-         {
-            std::unique_lock<std::mutex> lock(fLockWorkQueue);
-            for (auto &inFlight : fInFlightClusters) {
-               if (inFlight.fClusterId != item.fClusterId)
-                  continue;
-               discard = inFlight.fIsExpired;
-               break;
+      if (!clusterKeys.empty()) {
+         auto timeStart = std::chrono::steady_clock::now();
+         auto clusters = [&] {
+            R__TRACE_SPAN("io", "RClusterPool read", clusterKeys.size());
+            return fPageSource.LoadClusters(clusterKeys);
+         }();
+         R__ASSERT(clusters.size() == readItems.size());
+         auto latencyNs = std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now() - timeStart).count();
+         // Only the I/O thread writes the latency, so there is no need for a compare-and-swap loop
+         fIoLatencyNs.store(UpdateMovingAverage(fIoLatencyNs.load(), latencyNs));
+         fCtrIoLatency->SetValue(fIoLatencyNs.load());
+
+         for (std::size_t i = 0; i < readItems.size(); ++i) {
+            auto &item = readItems[i];
+            auto &cluster = clusters[i];
+            // Meanwhile, the user might have requested clusters outside the look-ahead window, so that we don't
+            // need the cluster anymore, in which case we simply discard it right away, before moving it to the pool
+            bool discard = false;
+            {
+               std::unique_lock<std::mutex> lock(fLockWorkQueue);
+               for (auto &inFlight : fInFlightClusters) {
+                  if (inFlight.fClusterId != item.fClusterId)
+                     continue;
+                  discard = inFlight.fIsExpired;
+                  break;
+               }
+            }
+            if (discard) {
+               cluster.reset();
+               item.fPromise.set_value(std::move(cluster));
+            } else {
+               // Hand-over the loaded cluster pages to the unzip thread
+               std::unique_lock<std::mutex> lock(fLockUnzipQueue);
+               fUnzipQueue.emplace(RUnzipItem{std::move(cluster), std::move(item.fPromise)});
+               fCvHasUnzipWork.notify_one();
             }
-         }
-         if (discard) {
-            cluster.reset();
-            item.fPromise.set_value(std::move(cluster));
-         } else {
-            // Hand-over the loaded cluster pages to the unzip thread
-            std::unique_lock<std::mutex> lock(fLockUnzipQueue);
-            fUnzipQueue.emplace(RUnzipItem{std::move(cluster), std::move(item.fPromise)});
-            fCvHasUnzipWork.notify_one();
          }
       }
+      if (isTerminated)
+         return;
    } // while (true)
 }
 
@@ -174,6 +245,47 @@ size_t ROOT::Experimental::Detail::RClusterPool::FindFreeSlot() const
    return N;
 }
 
+unsigned int ROOT::Experimental::Detail::RClusterPool::ComputeWindowPost(
+   std::int64_t ioLatencyNs, std::int64_t consumeTimeNs, unsigned int currentWindowPost, unsigned int maxWindowPost)
+{
+   // Without samples for both sides of the pipeline, there is nothing to adapt to
+   if ((ioLatencyNs <= 0) || (consumeTimeNs <= 0))
+      return std::min(currentWindowPost, maxWindowPost);
+
+   // The active cluster plus the number of clusters the consumer processes while a single cluster is being read
+   auto target = 1 + (ioLatencyNs + consumeTimeNs - 1) / consumeTimeNs;
+   target = std::min<std::int64_t>(target, maxWindowPost);
+   if (target > currentWindowPost)
+      return std::min<std::int64_t>(target, 2 * currentWindowPost);
+   if (target < currentWindowPost)
+      return currentWindowPost - 1;
+   return currentWindowPost;
+}
+
+void ROOT::Experimental::Detail::RClusterPool::AdaptWindow(DescriptorId_t clusterId)
+{
+   if (fWindowPolicy != EWindowPolicy::kAdaptive)
+      return;
+
+   if (fLastClusterId != kInvalidDescriptorId) {
+      fConsumeTimeCurrentNs += std::chrono::duration_cast<std::chrono::nanoseconds>(
+         std::chrono::steady_clock::now() - fTimeLastReturn).count();
+   }
+   // Only a change of the active cluster completes a consumption time sample
+   if (clusterId == fLastClusterId)
+      return;
+
+   if (fLastClusterId != kInvalidDescriptorId) {
+      fConsumeTimeNs = UpdateMovingAverage(fConsumeTimeNs, std::max<std::int64_t>(fConsumeTimeCurrentNs, 1));
+      fCtrConsumeTime->SetValue(fConsumeTimeNs);
+   }
+   fConsumeTimeCurrentNs = 0;
+   fLastClusterId = clusterId;
+
+   fWindowPost = ComputeWindowPost(fIoLatencyNs.load(), fConsumeTimeNs, fWindowPost, fMaxWindowPost);
+   fCtrWindowPost->SetValue(fWindowPost);
+}
+
 
 namespace {
 
@@ -222,6 +334,8 @@ ROOT::Experimental::Detail::RClusterPool::GetCluster(
 {
    const auto &desc = fPageSource.GetDescriptor();
 
+   AdaptWindow(clusterId);
+
    // Determine previous cluster ids that we keep if they happen to be in the pool
    std::set<DescriptorId_t> keep;
    auto prev = clusterId;
@@ -326,7 +440,10 @@ ROOT::Experimental::Detail::RClusterPool::GetCluster(
          fCvHasReadWork.notify_one();
    } // work queue lock guard
 
-   return WaitFor(clusterId, columns);
+   auto result = WaitFor(clusterId, columns);
+   if (fWindowPolicy == EWindowPolicy::kAdaptive)
+      fTimeLastReturn = std::chrono::steady_clock::now();
+   return result;
 }
 
 
@@ -366,7 +483,11 @@ ROOT::Experimental::Detail::RClusterPool::WaitFor(
          // is released.  We need to release the lock before potentially blocking on the cluster future.
       }
 
-      auto cptr = itr->fFuture.get();
+      // The time blocked here is the time the I/O and unzip threads were behind the reader
+      auto cptr = [&] {
+         R__TRACE_SPAN("io", "RClusterPool wait", clusterId);
+         return itr->fFuture.get();
+      }();
       if (result) {
          result->Adopt(std::move(*cptr));
       } else {
@@ -19,7 +19,10 @@
 
 #include <TError.h>
 
+#include <algorithm>
+#include <cstdint>
 #include <iostream>
+#include <limits>
 
 ROOT::Experimental::Detail::RColumn::RColumn(const RColumnModel& model, std::uint32_t index)
    : fModel(model), fIndex(index)
@@ -82,6 +85,43 @@ void ROOT::Experimental::Detail::RColumn::Flush()
    R__ASSERT(fWritePage[otherIdx].IsEmpty());
    fPageSink->CommitPage(fHandleSink, fWritePage[fWritePageIdx]);
    fWritePage[fWritePageIdx].Reset(fNElements);
+
+   AdaptPageSize();
+}
+
+void ROOT::Experimental::Detail::RColumn::AdaptPageSize()
+{
+   const std::size_t zippedPageSize = fPageSink->GetWriteOptions().GetApproxZippedPageSize();
+   if (zippedPageSize == 0)
+      return;
+   // With buffered writing, the compression of the current cluster may still be in flight; in this case,
+   // the ratio of the previous clusters is used
+   const double nBytesPerElement = fPageSink->GetNBytesPerElementOnStorage(fHandleSink.fId);
+   if (nBytesPerElement <= 0.)
+      return;
+
+   // Limit the memory footprint of the write pages for very well compressible columns
+   constexpr std::size_t kMaxUnzippedToZippedRatio = 16;
+   const std::size_t elementSize = fElement->GetSize();
+   const std::size_t maxNElements = std::min<std::size_t>(
+      std::max<std::size_t>(2, kMaxUnzippedToZippedRatio * zippedPageSize / elementSize),
+      std::numeric_limits<std::uint32_t>::max() / 2);
+   auto nElements = static_cast<std::size_t>(static_cast<double>(zippedPageSize) / nBytesPerElement);
+   nElements = std::min(std::max<std::size_t>(nElements, 2), maxNElements);
+
+   // Don't reallocate the write pages for small fluctuations of the compression ratio
+   const auto current = static_cast<std::size_t>(fApproxNElementsPerPage);
+   if ((10 * nElements > 9 * current) && (10 * nElements < 11 * current))
+      return;
+
+   // Flush() has committed all elements
+   R__ASSERT(fWritePage[0].IsEmpty() && fWritePage[1].IsEmpty());
+   fApproxNElementsPerPage = static_cast<std::uint32_t>(nElements);
+   for (auto &page : fWritePage) {
+      fPageSink->ReleasePage(page);
+      page = fPageSink->ReservePage(fHandleSink, fApproxNElementsPerPage + fApproxNElementsPerPage / 2);
+      page.Reset(fNElements);
+   }
 }
 
 void ROOT::Experimental::Detail::RColumn::MapPage(const NTupleSize_t index)
@@ -18,8 +18,8 @@
 #include <TError.h>
 
 #include <algorithm>
-#include <bitset>
 #include <cstdint>
+#include <cstring>
 #include <memory>
 #include <utility>
 
@@ -103,23 +103,50 @@ std::string ROOT::Experimental::Detail::RColumnElementBase::GetTypeName(EColumnT
    }
 }
 
+namespace {
+
+// The bit column kernels process eight booleans at a time as a single 64bit word: one bool per byte on the memory
+// side, one bit per bool on the storage side. Word-wise processing requires the bytes of the word to be in memory
+// order, i.e. a little-endian host.
+#ifdef R__BYTESWAP
+/// Multiplying a word of eight booleans with this constant collects the booleans in the most significant byte,
+/// such that the boolean at memory position i becomes bit i
+constexpr std::uint64_t kBitGatherMul = 0x0102040810204080ULL;
+/// Broadcasts a byte into all eight bytes of a word
+constexpr std::uint64_t kBitBroadcastMul = 0x0101010101010101ULL;
+/// Selects bit i in byte i
+constexpr std::uint64_t kBitSelectMask = 0x8040201008040201ULL;
+/// Added to a selected bit in order to move it into the most significant bit of its byte
+constexpr std::uint64_t kBitNormalizeAdd = 0x7F7F7F7F7F7F7F7FULL;
+#endif
+
+} // anonymous namespace
+
 void ROOT::Experimental::Detail::RColumnElement<bool, ROOT::Experimental::EColumnType::kBit>::Pack(
   void *dst, void *src, std::size_t count) const
 {
-   bool *boolArray = reinterpret_cast<bool *>(src);
-   char *charArray = reinterpret_cast<char *>(dst);
-   std::bitset<8> bitSet;
+   const unsigned char *boolArray = reinterpret_cast<const unsigned char *>(src);
+   unsigned char *charArray = reinterpret_cast<unsigned char *>(dst);
+   const std::size_t nFullBytes = count / 8;
    std::size_t i = 0;
-   for (; i < count; ++i) {
-      bitSet.set(i % 8, boolArray[i]);
-      if (i % 8 == 7) {
-         char packed = bitSet.to_ulong();
-         charArray[i / 8] = packed;
-      }
+#ifdef R__BYTESWAP
+   for (; i < nFullBytes; ++i) {
+      std::uint64_t word;
+      memcpy(&word, boolArray + 8 * i, sizeof(word));
+      charArray[i] = (word * kBitGatherMul) >> 56;
+   }
+#endif
+   for (; i < nFullBytes; ++i) {
+      unsigned char packed = 0;
+      for (unsigned j = 0; j < 8; ++j)
+         packed |= (boolArray[8 * i + j] & 1) << j;
+      charArray[i] = packed;
    }
-   if (i % 8 != 0) {
-      char packed = bitSet.to_ulong();
-      charArray[i / 8] = packed;
+   if (count % 8 != 0) {
+      unsigned char packed = 0;
+      for (std::size_t j = 8 * nFullBytes; j < count; ++j)
+         packed |= (boolArray[j] & 1) << (j % 8);
+      charArray[nFullBytes] = packed;
    }
 }
 
@@ -127,13 +154,22 @@ void ROOT::Experimental::Detail::RColumnElement<bool, ROOT::Experimental::EColum
   void *dst, void *src, std::size_t count) const
 {
    bool *boolArray = reinterpret_cast<bool *>(dst);
-   char *charArray = reinterpret_cast<char *>(src);
-   std::bitset<8> bitSet;
-   for (std::size_t i = 0; i < count; i += 8) {
-      bitSet = charArray[i / 8];
-      for (std::size_t j = i; j < std::min(count, i + 8); ++j) {
-         boolArray[j] = bitSet[j % 8];
-      }
+   const unsigned char *charArray = reinterpret_cast<const unsigned char *>(src);
+   const std::size_t nFullBytes = count / 8;
+   std::size_t i = 0;
+#ifdef R__BYTESWAP
+   for (; i < nFullBytes; ++i) {
+      std::uint64_t word = ((charArray[i] * kBitBroadcastMul) & kBitSelectMask) + kBitNormalizeAdd;
+      word = (word >> 7) & 0x0101010101010101ULL;
+      memcpy(boolArray + 8 * i, &word, sizeof(word));
+   }
+#endif
+   for (; i < nFullBytes; ++i) {
+      for (unsigned j = 0; j < 8; ++j)
+         boolArray[8 * i + j] = (charArray[i] >> j) & 1;
+   }
+   for (std::size_t j = 8 * nFullBytes; j < count; ++j) {
+      boolArray[j] = (charArray[nFullBytes] >> (j % 8)) & 1;
    }
 }
 
@@ -16,7 +16,9 @@
 #include <ROOT/RNTuple.hxx>
 
 #include <ROOT/RFieldVisitor.hxx>
+#include <ROOT/RLogger.hxx>
 #include <ROOT/RNTupleModel.hxx>
+#include <ROOT/RPageAllocator.hxx>
 #include <ROOT/RPageSourceFriends.hxx>
 #include <ROOT/RPageStorage.hxx>
 #include <ROOT/RPageSinkBuf.hxx>
@@ -63,6 +65,68 @@ void ROOT::Experimental::RNTupleImtTaskScheduler::Wait()
 }
 #endif
 
+namespace {
+
+/// Runs the tasks immediately in the calling thread.  Used by the fill contexts of an RNTupleParallelWriter without
+/// IMT such that the pages are sealed by the filling thread and not later by the thread that writes the cluster.
+class RInlineTaskScheduler : public ROOT::Experimental::Detail::RPageStorage::RTaskScheduler {
+public:
+   void Reset() final {}
+   void AddTask(const std::function<void(void)> &taskFunc) final { taskFunc(); }
+   void Wait() final {}
+};
+
+/// The inner sink of the RPageSinkBuf of a fill context.  It forwards the pages of a cluster to the shared sink
+/// of the parallel writer.  The calls happen from RPageSinkBuf::CommitCluster(), with the writer's lock held.
+/// The forwarding sink has its own column bookkeeping; the shared sink is not touched before the cluster is committed.
+class RPageSinkForward : public ROOT::Experimental::Detail::RPageSink {
+   using RLocator = ROOT::Experimental::RClusterDescriptor::RLocator;
+   using RPage = ROOT::Experimental::Detail::RPage;
+   using RPageAllocatorHeap = ROOT::Experimental::Detail::RPageAllocatorHeap;
+
+   /// The sink of the parallel writer
+   RPageSink &fTarget;
+   /// The number of entries committed to fTarget so far, including the cluster currently being committed
+   const ROOT::Experimental::NTupleSize_t &fTargetNEntries;
+
+protected:
+   void CreateImpl(const ROOT::Experimental::RNTupleModel & /* model */) final {}
+   RLocator CommitPageImpl(ColumnHandle_t columnHandle, const RPage &page) final
+   {
+      fTarget.CommitPage(columnHandle, page);
+      return RLocator();
+   }
+   RLocator CommitSealedPageImpl(ROOT::Experimental::DescriptorId_t columnId, const RSealedPage &sealedPage) final
+   {
+      fTarget.CommitSealedPage(columnId, sealedPage);
+      return RLocator();
+   }
+   std::uint64_t CommitClusterImpl(ROOT::Experimental::NTupleSize_t /* nEntries */) final
+   {
+      return fTarget.CommitCluster(fTargetNEntries);
+   }
+   void CommitDatasetImpl() final {}
+
+public:
+   RPageSinkForward(RPageSink &target, const ROOT::Experimental::NTupleSize_t &targetNEntries)
+      : RPageSink(target.GetNTupleName(), target.GetWriteOptions()), fTarget(target), fTargetNEntries(targetNEntries)
+   {
+      // The value ranges are recorded by the target
+      fComputeValueRanges = false;
+   }
+
+   RPage ReservePage(ColumnHandle_t columnHandle, std::size_t nElements) final
+   {
+      if (nElements == 0)
+         throw ROOT::Experimental::RException(R__FAIL("invalid call: request empty page"));
+      auto elementSize = columnHandle.fColumn->GetElement()->GetSize();
+      return RPageAllocatorHeap::NewPage(columnHandle.fId, elementSize, nElements);
+   }
+   void ReleasePage(RPage &page) final { RPageAllocatorHeap::DeletePage(page); }
+};
+
+} // anonymous namespace
+
 
 //------------------------------------------------------------------------------
 
@@ -107,6 +171,7 @@ ROOT::Experimental::RNTupleReader::RNTupleReader(
    }
    InitPageSource();
    ConnectModel(*fModel);
+   Detail::RNTupleMetricsRegistry::Instance().Register(fMetrics);
 }
 
 ROOT::Experimental::RNTupleReader::RNTupleReader(std::unique_ptr<ROOT::Experimental::Detail::RPageSource> source)
@@ -118,9 +183,13 @@ ROOT::Experimental::RNTupleReader::RNTupleReader(std::unique_ptr<ROOT::Experimen
       throw RException(R__FAIL("null source"));
    }
    InitPageSource();
+   Detail::RNTupleMetricsRegistry::Instance().Register(fMetrics);
 }
 
-ROOT::Experimental::RNTupleReader::~RNTupleReader() = default;
+ROOT::Experimental::RNTupleReader::~RNTupleReader()
+{
+   Detail::RNTupleMetricsRegistry::Instance().Unregister(fMetrics);
+}
 
 std::unique_ptr<ROOT::Experimental::RNTupleReader> ROOT::Experimental::RNTupleReader::Open(
    std::unique_ptr<RNTupleModel> model,
@@ -298,12 +367,14 @@ ROOT::Experimental::RNTupleWriter::RNTupleWriter(
    // First estimate is a factor 2 compression if compression is used at all
    const int scale = writeOpts.GetCompression() ? 2 : 1;
    fUnzippedClusterSizeEst = scale * writeOpts.GetApproxZippedClusterSize();
+   Detail::RNTupleMetricsRegistry::Instance().Register(fMetrics);
 }
 
 ROOT::Experimental::RNTupleWriter::~RNTupleWriter()
 {
    CommitCluster();
    fSink->CommitDataset();
+   Detail::RNTupleMetricsRegistry::Instance().Unregister(fMetrics);
 }
 
 std::unique_ptr<ROOT::Experimental::RNTupleWriter> ROOT::Experimental::RNTupleWriter::Recreate(
@@ -354,6 +425,158 @@ void ROOT::Experimental::RNTupleWriter::CommitCluster()
 //------------------------------------------------------------------------------
 
 
+ROOT::Experimental::RNTupleFillContext::RNTupleFillContext(RNTupleParallelWriter &writer,
+                                                           std::unique_ptr<RNTupleModel> model)
+   : fWriter(writer), fModel(std::move(model))
+{
+#ifdef R__USE_IMT
+   if (IsImplicitMTEnabled())
+      fZipTasks = std::make_unique<RNTupleImtTaskScheduler>();
+#endif
+   if (!fZipTasks)
+      fZipTasks = std::make_unique<RInlineTaskScheduler>();
+
+   auto forwardSink = std::make_unique<RPageSinkForward>(*fWriter.fSink, fWriter.fNEntries);
+   fSink = std::make_unique<Detail::RPageSinkBuf>(std::move(forwardSink));
+   fSink->SetTaskScheduler(fZipTasks.get());
+   fSink->Create(*fModel.get());
+
+   const auto &writeOpts = fSink->GetWriteOptions();
+   fMaxUnzippedClusterSize = writeOpts.GetMaxUnzippedClusterSize();
+   // First estimate is a factor 2 compression if compression is used at all
+   const int scale = writeOpts.GetCompression() ? 2 : 1;
+   fUnzippedClusterSizeEst = scale * writeOpts.GetApproxZippedClusterSize();
+}
+
+ROOT::Experimental::RNTupleFillContext::~RNTupleFillContext()
+{
+   CommitCluster();
+}
+
+void ROOT::Experimental::RNTupleFillContext::FlushCluster()
+{
+   for (auto &field : *fModel->GetFieldZero()) {
+      field.Flush();
+      field.CommitCluster();
+   }
+   // Seal the pages before taking the writer's lock
+   fZipTasks->Wait();
+}
+
+void ROOT::Experimental::RNTupleFillContext::UpdateClusterSizeEstimate(std::uint64_t nbytes)
+{
+   fNBytesCommitted += nbytes;
+   fNBytesFilled += fUnzippedClusterSize;
+
+   // Cap the compression factor at 1000 to prevent overflow of fUnzippedClusterSizeEst
+   const float compressionFactor = std::min(1000.f,
+      static_cast<float>(fNBytesFilled) / static_cast<float>(fNBytesCommitted));
+   fUnzippedClusterSizeEst =
+      compressionFactor * static_cast<float>(fSink->GetWriteOptions().GetApproxZippedClusterSize());
+
+   fLastCommitted = fNEntries;
+   fUnzippedClusterSize = 0;
+}
+
+void ROOT::Experimental::RNTupleFillContext::CommitCluster()
+{
+   if (fNEntries == fLastCommitted) return;
+   FlushCluster();
+   std::uint64_t nbytes;
+   {
+      std::lock_guard<std::mutex> guard(fWriter.fMutex);
+      nbytes = fWriter.CommitClusterUnlocked(*this, fNEntries - fLastCommitted);
+   }
+   UpdateClusterSizeEstimate(nbytes);
+}
+
+void ROOT::Experimental::RNTupleFillContext::CommitCluster(std::uint64_t sequenceNumber)
+{
+   const bool isEmpty = (fNEntries == fLastCommitted);
+   if (!isEmpty)
+      FlushCluster();
+   std::uint64_t nbytes = 0;
+   {
+      std::unique_lock<std::mutex> lock(fWriter.fMutex);
+      fWriter.fSequenceCv.wait(lock, [&] { return fWriter.fNextSequenceNumber == sequenceNumber; });
+      if (!isEmpty)
+         nbytes = fWriter.CommitClusterUnlocked(*this, fNEntries - fLastCommitted);
+      fWriter.fNextSequenceNumber++;
+   }
+   fWriter.fSequenceCv.notify_all();
+   if (!isEmpty)
+      UpdateClusterSizeEstimate(nbytes);
+}
+
+
+//------------------------------------------------------------------------------
+
+
+ROOT::Experimental::RNTupleParallelWriter::RNTupleParallelWriter(std::unique_ptr<RNTupleModel> model,
+                                                                 std::unique_ptr<Detail::RPageSink> sink)
+   : fSink(std::move(sink)), fModel(std::move(model)), fMetrics("RNTupleParallelWriter")
+{
+   if (!fModel) {
+      throw RException(R__FAIL("null model"));
+   }
+   if (!fSink) {
+      throw RException(R__FAIL("null sink"));
+   }
+   fSink->Create(*fModel.get());
+   fMetrics.ObserveMetrics(fSink->GetMetrics());
+   Detail::RNTupleMetricsRegistry::Instance().Register(fMetrics);
+}
+
+ROOT::Experimental::RNTupleParallelWriter::~RNTupleParallelWriter()
+{
+   for (const auto &context : fFillContexts) {
+      if (!context.expired()) {
+         R__LOG_ERROR(NTupleLog()) << "RNTupleFillContext has not been destructed, not committing the data set";
+         Detail::RNTupleMetricsRegistry::Instance().Unregister(fMetrics);
+         return;
+      }
+   }
+   fSink->CommitDataset();
+   Detail::RNTupleMetricsRegistry::Instance().Unregister(fMetrics);
+}
+
+std::unique_ptr<ROOT::Experimental::RNTupleParallelWriter> ROOT::Experimental::RNTupleParallelWriter::Recreate(
+   std::unique_ptr<RNTupleModel> model,
+   std::string_view ntupleName,
+   std::string_view storage,
+   const RNTupleWriteOptions &options)
+{
+   // The fill contexts do the buffering
+   auto sinkOptions = options.Clone();
+   sinkOptions->SetUseBufferedWrite(false);
+   return std::make_unique<RNTupleParallelWriter>(std::move(model),
+                                                  Detail::RPageSink::Create(ntupleName, storage, *sinkOptions));
+}
+
+std::shared_ptr<ROOT::Experimental::RNTupleFillContext> ROOT::Experimental::RNTupleParallelWriter::CreateFillContext()
+{
+   std::lock_guard<std::mutex> guard(fMutex);
+   // The constructor of RNTupleFillContext is private
+   std::shared_ptr<RNTupleFillContext> context(new RNTupleFillContext(*this, fModel->Clone()));
+   fFillContexts.erase(std::remove_if(fFillContexts.begin(), fFillContexts.end(),
+                                      [](const std::weak_ptr<RNTupleFillContext> &c) { return c.expired(); }),
+                       fFillContexts.end());
+   fFillContexts.emplace_back(context);
+   return context;
+}
+
+std::uint64_t ROOT::Experimental::RNTupleParallelWriter::CommitClusterUnlocked(RNTupleFillContext &context,
+                                                                               NTupleSize_t nEntriesCluster)
+{
+   // The forwarding sink of the context commits the cluster to fSink with the updated number of entries
+   fNEntries += nEntriesCluster;
+   return context.fSink->CommitCluster(context.fNEntries);
+}
+
+
+//------------------------------------------------------------------------------
+
+
 ROOT::Experimental::RCollectionNTupleWriter::RCollectionNTupleWriter(std::unique_ptr<REntry> defaultEntry)
    : fOffset(0), fDefaultEntry(std::move(defaultEntry))
 {
@@ -25,6 +25,7 @@
 
 #include <algorithm>
 #include <cstdint>
+#include <cstring>
 #include <iostream>
 #include <utility>
 
@@ -268,6 +269,40 @@ std::uint32_t DeserializePageInfo(const void *buffer,
    return bytes - base;
 }
 
+std::uint32_t SerializeValueRange(const ROOT::Experimental::RClusterDescriptor::RValueRange &val, void *buffer)
+{
+   // Like page infos, value ranges are not framed. Doubles are stored as their IEEE 754 bit pattern.
+   if (buffer != nullptr) {
+      auto pos = reinterpret_cast<unsigned char *>(buffer);
+      pos += SerializeUInt16(val.fIsValid ? 1 : 0, pos);
+      if (val.fIsValid) {
+         std::uint64_t bits;
+         std::memcpy(&bits, &val.fMin, sizeof(bits));
+         pos += SerializeUInt64(bits, pos);
+         std::memcpy(&bits, &val.fMax, sizeof(bits));
+         pos += SerializeUInt64(bits, pos);
+      }
+   }
+   return val.fIsValid ? 18 : 2;
+}
+
+std::uint32_t DeserializeValueRange(const void *buffer, ROOT::Experimental::RClusterDescriptor::RValueRange *valueRange)
+{
+   auto base = reinterpret_cast<const unsigned char *>(buffer);
+   auto bytes = base;
+   std::uint16_t isValid;
+   bytes += DeserializeUInt16(bytes, &isValid);
+   valueRange->fIsValid = (isValid != 0);
+   if (valueRange->fIsValid) {
+      std::uint64_t bits;
+      bytes += DeserializeUInt64(bytes, &bits);
+      std::memcpy(&valueRange->fMin, &bits, sizeof(bits));
+      bytes += DeserializeUInt64(bytes, &bits);
+      std::memcpy(&valueRange->fMax, &bits, sizeof(bits));
+   }
+   return bytes - base;
+}
+
 std::uint32_t SerializeCrc32(const unsigned char *data, std::uint32_t length, void *buffer)
 {
    auto checksum = R__crc32(0, nullptr, 0);
@@ -456,6 +491,17 @@ ROOT::Experimental::RClusterDescriptor::RPageRange::Find(ROOT::Experimental::RCl
 }
 
 
+void ROOT::Experimental::RClusterDescriptor::RValueRange::Merge(const RValueRange &other)
+{
+   if (!fIsValid || !other.fIsValid) {
+      fIsValid = false;
+      return;
+   }
+   fMin = std::min(fMin, other.fMin);
+   fMax = std::max(fMax, other.fMax);
+}
+
+
 bool ROOT::Experimental::RClusterDescriptor::operator==(const RClusterDescriptor &other) const
 {
    return fClusterId == other.fClusterId &&
@@ -586,6 +632,31 @@ std::uint32_t ROOT::Experimental::RNTupleDescriptor::SerializeFooter(void* buffe
       }
    }
 
+   // The value ranges of the clusters and pages follow the cluster summaries; only columns with a valid value range
+   // are listed.  The non-zero tag distinguishes the section from the postscript of footers without value ranges.
+   pos += SerializeUInt32(kValueRangeSectionTag, *where);
+   pos += SerializeUInt64(fClusterDescriptors.size(), *where);
+   for (const auto &cluster : fClusterDescriptors) {
+      pos += SerializeUInt64(cluster.first, *where);
+      std::uint32_t nColumns = 0;
+      for (const auto &column : fColumnDescriptors) {
+         if (cluster.second.GetColumnRange(column.first).fValueRange.fIsValid)
+            ++nColumns;
+      }
+      pos += SerializeUInt32(nColumns, *where);
+      for (const auto &column : fColumnDescriptors) {
+         const auto &columnRange = cluster.second.GetColumnRange(column.first);
+         if (!columnRange.fValueRange.fIsValid)
+            continue;
+         pos += SerializeUInt64(column.first, *where);
+         pos += SerializeValueRange(columnRange.fValueRange, *where);
+         const auto &pageRange = cluster.second.GetPageRange(column.first);
+         pos += SerializeUInt32(pageRange.fPageInfos.size(), *where);
+         for (const auto &pageInfo : pageRange.fPageInfos)
+            pos += SerializeValueRange(pageInfo.fValueRange, *where);
+      }
+   }
+
    // The next 16 bytes make the ntuple's postscript
    pos += SerializeUInt16(kFrameVersionCurrent, *where);
    pos += SerializeUInt16(kFrameVersionMin, *where);
@@ -898,6 +969,35 @@ void ROOT::Experimental::RNTupleDescriptorBuilder::AddClustersFromFooter(void* f
          AddClusterPageRange(clusterId, std::move(pageRange));
       }
    }
+
+   // Footers written before the introduction of value ranges continue with the postscript, which starts with
+   // two zero version numbers
+   std::uint32_t tag;
+   DeserializeUInt32(pos, &tag);
+   if (tag != RNTupleDescriptor::kValueRangeSectionTag)
+      return;
+   pos += 4;
+
+   std::uint64_t nClustersWithRanges;
+   pos += DeserializeUInt64(pos, &nClustersWithRanges);
+   for (std::uint64_t i = 0; i < nClustersWithRanges; ++i) {
+      std::uint64_t clusterId;
+      pos += DeserializeUInt64(pos, &clusterId);
+      auto &clusterDesc = fDescriptor.fClusterDescriptors.at(clusterId);
+      std::uint32_t nColumns;
+      pos += DeserializeUInt32(pos, &nColumns);
+      for (std::uint32_t j = 0; j < nColumns; ++j) {
+         std::uint64_t columnId;
+         pos += DeserializeUInt64(pos, &columnId);
+         pos += DeserializeValueRange(pos, &clusterDesc.fColumnRanges.at(columnId).fValueRange);
+         auto &pageInfos = clusterDesc.fPageRanges.at(columnId).fPageInfos;
+         std::uint32_t nPages;
+         pos += DeserializeUInt32(pos, &nPages);
+         R__ASSERT(nPages == pageInfos.size());
+         for (auto &pageInfo : pageInfos)
+            pos += DeserializeValueRange(pos, &pageInfo.fValueRange);
+      }
+   }
 }
 
 void ROOT::Experimental::RNTupleDescriptorBuilder::SetNTuple(
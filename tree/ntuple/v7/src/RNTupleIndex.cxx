@@ -0,0 +1,294 @@
+/// \file RNTupleIndex.cxx
+/// \ingroup NTuple ROOT7
+/// \date 2021-07-05
+/// \warning This is part of the ROOT 7 prototype! It will change without notice. It might trigger earthquakes. Feedback
+/// is welcome!
+
+/*************************************************************************
+ * Copyright (C) 1995-2021, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#include <ROOT/RError.hxx>
+#include <ROOT/RNTuple.hxx>
+#include <ROOT/RNTupleDescriptor.hxx>
+#include <ROOT/RNTupleIndex.hxx>
+#include <ROOT/RNTupleModel.hxx>
+#include <ROOT/RNTupleView.hxx>
+#include <ROOT/TTaskGroup.hxx>
+#include <TROOT.h> // for IsImplicitMTEnabled()
+
+#include <algorithm>
+#include <functional>
+#include <numeric>
+
+namespace {
+
+using ROOT::Experimental::NTupleSize_t;
+using ROOT::Experimental::RException;
+using ROOT::Experimental::RNTupleReader;
+
+/// Returns the value of a key field at the given entry, converted to a 64bit unsigned integer
+using KeyReader_t = std::function<std::uint64_t(NTupleSize_t)>;
+
+template <typename T>
+KeyReader_t MakeKeyReader(RNTupleReader &reader, const std::string &fieldName)
+{
+   auto view = std::make_shared<ROOT::Experimental::RNTupleView<T>>(reader.GetView<T>(fieldName));
+   return [view](NTupleSize_t entry) { return static_cast<std::uint64_t>((*view)(entry)); };
+}
+
+KeyReader_t MakeKeyReader(RNTupleReader &reader, const std::string &fieldName)
+{
+   const auto &desc = reader.GetDescriptor();
+   const auto fieldId = desc.FindFieldId(fieldName);
+   if (fieldId == ROOT::Experimental::kInvalidDescriptorId)
+      throw RException(R__FAIL("no field named '" + fieldName + "' in RNTuple '" + desc.GetName() + "'"));
+
+   const auto typeName = desc.GetFieldDescriptor(fieldId).GetTypeName();
+   if (typeName == "std::int8_t")
+      return MakeKeyReader<std::int8_t>(reader, fieldName);
+   if (typeName == "std::uint8_t")
+      return MakeKeyReader<std::uint8_t>(reader, fieldName);
+   if (typeName == "std::int16_t")
+      return MakeKeyReader<std::int16_t>(reader, fieldName);
+   if (typeName == "std::uint16_t")
+      return MakeKeyReader<std::uint16_t>(reader, fieldName);
+   if (typeName == "std::int32_t")
+      return MakeKeyReader<std::int32_t>(reader, fieldName);
+   if (typeName == "std::uint32_t")
+      return MakeKeyReader<std::uint32_t>(reader, fieldName);
+   if (typeName == "std::int64_t")
+      return MakeKeyReader<std::int64_t>(reader, fieldName);
+   if (typeName == "std::uint64_t")
+      return MakeKeyReader<std::uint64_t>(reader, fieldName);
+   throw RException(R__FAIL("field '" + fieldName + "' of type " + typeName + " cannot be an index key"));
+}
+
+/// Appends the keys of the entries [first, last) to keys
+void ReadKeys(RNTupleReader &reader, const std::vector<std::string> &keyFieldNames, NTupleSize_t first,
+              NTupleSize_t last, std::vector<std::uint64_t> &keys)
+{
+   std::vector<KeyReader_t> keyReaders;
+   for (const auto &name : keyFieldNames)
+      keyReaders.emplace_back(MakeKeyReader(reader, name));
+   keys.reserve(keys.size() + (last - first) * keyReaders.size());
+   for (auto entry = first; entry < last; ++entry) {
+      for (const auto &keyReader : keyReaders)
+         keys.emplace_back(keyReader(entry));
+   }
+}
+
+} // anonymous namespace
+
+
+std::unique_ptr<ROOT::Experimental::RNTupleIndex>
+ROOT::Experimental::RNTupleIndex::Build(RNTupleReader &reader, const std::vector<std::string> &keyFieldNames)
+{
+   if (keyFieldNames.empty())
+      throw RException(R__FAIL("an RNTuple index needs at least one key field"));
+   // Checks the key fields before any task starts
+   for (const auto &name : keyFieldNames)
+      MakeKeyReader(reader, name);
+
+   std::unique_ptr<RNTupleIndex> index(new RNTupleIndex(keyFieldNames));
+   const auto nEntries = reader.GetNEntries();
+
+   // The first entries of the clusters, in ascending order
+   std::vector<NTupleSize_t> clusterBoundaries;
+   for (const auto &clusterDesc : reader.GetDescriptor().GetClusterIterable())
+      clusterBoundaries.emplace_back(clusterDesc.GetFirstEntryIndex());
+   std::sort(clusterBoundaries.begin(), clusterBoundaries.end());
+
+   std::size_t nTasks = 1;
+#ifdef R__USE_IMT
+   if (IsImplicitMTEnabled())
+      nTasks = std::min<std::size_t>(std::max(1U, GetThreadPoolSize()), clusterBoundaries.size());
+#endif
+
+   if (nTasks <= 1) {
+      ReadKeys(reader, keyFieldNames, 0, nEntries, index->fKeys);
+   } else {
+#ifdef R__USE_IMT
+      // Every task reads a range of whole clusters through its own clone of the reader
+      std::vector<NTupleSize_t> taskBoundaries;
+      for (std::size_t i = 0; i < nTasks; ++i)
+         taskBoundaries.emplace_back(clusterBoundaries[i * clusterBoundaries.size() / nTasks]);
+      taskBoundaries.emplace_back(nEntries);
+
+      std::vector<std::unique_ptr<RNTupleReader>> clones;
+      for (std::size_t i = 0; i < nTasks; ++i)
+         clones.emplace_back(reader.Clone());
+      std::vector<std::vector<std::uint64_t>> taskKeys(nTasks);
+      TTaskGroup taskGroup;
+      for (std::size_t i = 0; i < nTasks; ++i) {
+         taskGroup.Run([&, i]() {
+            ReadKeys(*clones[i], keyFieldNames, taskBoundaries[i], taskBoundaries[i + 1], taskKeys[i]);
+         });
+      }
+      taskGroup.Wait();
+
+      index->fKeys.reserve(nEntries * keyFieldNames.size());
+      for (const auto &keys : taskKeys)
+         index->fKeys.insert(index->fKeys.end(), keys.begin(), keys.end());
+#endif
+   }
+
+   index->fEntries.resize(nEntries);
+   std::iota(index->fEntries.begin(), index->fEntries.end(), 0);
+   index->Sort();
+   return index;
+}
+
+
+void ROOT::Experimental::RNTupleIndex::Sort()
+{
+   const auto nKeys = fKeyFieldNames.size();
+   std::vector<std::size_t> order(fEntries.size());
+   std::iota(order.begin(), order.end(), 0);
+   // Stable, so that the entries with the same key stay in ascending order
+   std::stable_sort(order.begin(), order.end(), [this, nKeys](std::size_t a, std::size_t b) {
+      return std::lexicographical_compare(fKeys.begin() + a * nKeys, fKeys.begin() + (a + 1) * nKeys,
+                                          fKeys.begin() + b * nKeys, fKeys.begin() + (b + 1) * nKeys);
+   });
+
+   std::vector<std::uint64_t> keys;
+   keys.reserve(fKeys.size());
+   std::vector<NTupleSize_t> entries;
+   entries.reserve(fEntries.size());
+   for (auto pos : order) {
+      keys.insert(keys.end(), fKeys.begin() + pos * nKeys, fKeys.begin() + (pos + 1) * nKeys);
+      entries.emplace_back(fEntries[pos]);
+   }
+   std::swap(fKeys, keys);
+   std::swap(fEntries, entries);
+}
+
+
+std::unique_ptr<ROOT::Experimental::RNTupleIndex>
+ROOT::Experimental::RNTupleIndex::Open(std::string_view ntupleName, std::string_view storage)
+{
+   auto reader = RNTupleReader::Open(GetIndexNTupleName(ntupleName), storage);
+   const auto &desc = reader->GetDescriptor();
+
+   // The key fields are stored as key0, key1, ... with the name of the indexed field as their description
+   std::vector<std::string> keyFieldNames;
+   std::vector<RNTupleView<std::uint64_t>> keyViews;
+   for (std::size_t i = 0;; ++i) {
+      const auto fieldName = "key" + std::to_string(i);
+      const auto fieldId = desc.FindFieldId(fieldName);
+      if (fieldId == kInvalidDescriptorId)
+         break;
+      keyFieldNames.emplace_back(desc.GetFieldDescriptor(fieldId).GetFieldDescription());
+      keyViews.emplace_back(reader->GetView<std::uint64_t>(fieldName));
+   }
+   if (keyFieldNames.empty() || desc.FindFieldId("entry") == kInvalidDescriptorId)
+      throw RException(R__FAIL("'" + desc.GetName() + "' is not an RNTuple index"));
+   auto entryView = reader->GetView<NTupleSize_t>("entry");
+
+   std::unique_ptr<RNTupleIndex> index(new RNTupleIndex(keyFieldNames));
+   const auto nEntries = reader->GetNEntries();
+   index->fKeys.reserve(nEntries * keyFieldNames.size());
+   index->fEntries.reserve(nEntries);
+   for (auto i : reader->GetEntryRange()) {
+      for (auto &view : keyViews)
+         index->fKeys.emplace_back(view(i));
+      index->fEntries.emplace_back(entryView(i));
+   }
+   return index;
+}
+
+
+void ROOT::Experimental::RNTupleIndex::Write(std::string_view ntupleName, TFile &file) const
+{
+   auto model = RNTupleModel::Create();
+   auto entry = model->MakeField<NTupleSize_t>({"entry", "entry number in the indexed ntuple"});
+   std::vector<std::shared_ptr<std::uint64_t>> keys;
+   for (std::size_t i = 0; i < fKeyFieldNames.size(); ++i) {
+      const auto fieldName = "key" + std::to_string(i);
+      keys.emplace_back(model->MakeField<std::uint64_t>({fieldName, fKeyFieldNames[i]}));
+   }
+   model->SetDescription("index of " + std::string(ntupleName));
+
+   auto writer = RNTupleWriter::Append(std::move(model), GetIndexNTupleName(ntupleName), file);
+   const auto nKeys = keys.size();
+   for (std::size_t pos = 0; pos < fEntries.size(); ++pos) {
+      for (std::size_t i = 0; i < nKeys; ++i)
+         *keys[i] = fKeys[pos * nKeys + i];
+      *entry = fEntries[pos];
+      writer->Fill();
+   }
+}
+
+
+std::pair<std::size_t, std::size_t>
+ROOT::Experimental::RNTupleIndex::FindRange(const std::vector<std::uint64_t> &key) const
+{
+   const auto nKeys = fKeyFieldNames.size();
+   if (key.size() != nKeys) {
+      throw RException(R__FAIL("the key has " + std::to_string(key.size()) + " values but the index has " +
+                               std::to_string(nKeys) + " key fields"));
+   }
+
+   // Binary search over the positions of the entries, comparing their keys with the given one
+   auto fnLess = [&](std::size_t pos, const std::vector<std::uint64_t> &k) {
+      return std::lexicographical_compare(fKeys.begin() + pos * nKeys, fKeys.begin() + (pos + 1) * nKeys, k.begin(),
+                                          k.end());
+   };
+   auto fnGreater = [&](const std::vector<std::uint64_t> &k, std::size_t pos) {
+      return std::lexicographical_compare(k.begin(), k.end(), fKeys.begin() + pos * nKeys,
+                                          fKeys.begin() + (pos + 1) * nKeys);
+   };
+   std::size_t lo = 0;
+   std::size_t hi = fEntries.size();
+   while (lo < hi) {
+      const auto mid = lo + (hi - lo) / 2;
+      if (fnLess(mid, key))
+         lo = mid + 1;
+      else
+         hi = mid;
+   }
+   const auto first = lo;
+   hi = fEntries.size();
+   while (lo < hi) {
+      const auto mid = lo + (hi - lo) / 2;
+      if (fnGreater(key, mid))
+         hi = mid;
+      else
+         lo = mid + 1;
+   }
+   return {first, lo};
+}
+
+
+ROOT::Experimental::NTupleSize_t
+ROOT::Experimental::RNTupleIndex::GetEntryIndex(const std::vector<std::uint64_t> &key) const
+{
+   const auto range = FindRange(key);
+   return (range.first == range.second) ? kInvalidNTupleIndex : fEntries[range.first];
+}
+
+
+std::vector<ROOT::Experimental::NTupleSize_t>
+ROOT::Experimental::RNTupleIndex::GetAllEntryIndices(const std::vector<std::uint64_t> &key) const
+{
+   const auto range = FindRange(key);
+   return std::vector<NTupleSize_t>(fEntries.begin() + range.first, fEntries.begin() + range.second);
+}
+
+
+std::vector<ROOT::Experimental::NTupleSize_t>
+ROOT::Experimental::RNTupleIndex::GetEntryIndices(const std::vector<std::vector<std::uint64_t>> &keys) const
+{
+   std::vector<NTupleSize_t> result;
+   for (const auto &key : keys) {
+      const auto range = FindRange(key);
+      result.insert(result.end(), fEntries.begin() + range.first, fEntries.begin() + range.second);
+   }
+   std::sort(result.begin(), result.end());
+   result.erase(std::unique(result.begin(), result.end()), result.end());
+   return result;
+}
@@ -14,16 +14,188 @@
  *************************************************************************/
 
 #include <ROOT/RError.hxx>
+#include <ROOT/RLogger.hxx>
 #include <ROOT/RMiniFile.hxx>
 #include <ROOT/RNTupleDescriptor.hxx>
 #include <ROOT/RNTupleMerger.hxx>
+#include <ROOT/RNTupleModel.hxx>
+#include <ROOT/RNTupleOptions.hxx>
 #include <ROOT/RNTupleUtil.hxx>
+#include <ROOT/RPageStorage.hxx>
+#include <ROOT/RPageStorageFile.hxx>
+#ifdef R__USE_IMT
+#include <ROOT/TTaskGroup.hxx>
+#endif
+
+#include <TCollection.h>
+#include <TFile.h>
+#include <TFileMergeInfo.h>
+#include <TKey.h>
+#include <TROOT.h> // for IsImplicitMTEnabled()
+
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <utility>
+
+namespace {
+
+using ROOT::Experimental::DescriptorId_t;
+using ROOT::Experimental::RException;
+using ROOT::Experimental::RNTupleDescriptor;
+using ROOT::Experimental::Detail::RPageSource;
+using ROOT::Experimental::Detail::RPageStorage;
+
+/// The sealed pages of a column in a cluster, read into a single buffer
+struct RSealedColumn {
+   std::vector<RPageStorage::RSealedPage> fPages;
+   std::unique_ptr<unsigned char[]> fBuffer;
+};
+
+/// The sealed pages of all the columns of a cluster, indexed by the column id in the destination
+struct RSealedCluster {
+   ROOT::Experimental::ClusterSize_t::ValueType fNEntries = 0;
+   std::vector<RSealedColumn> fColumns;
+};
+
+/// Returns the ids of the source columns corresponding to the columns of the destination, found through the
+/// names and the types of the fields up to the field zero.  Throws if the schemas differ.
+std::vector<DescriptorId_t> MapColumns(const RNTupleDescriptor &destination, const RNTupleDescriptor &source)
+{
+   using ROOT::Experimental::kInvalidDescriptorId;
+
+   if (destination.GetNColumns() != source.GetNColumns() || destination.GetNFields() != source.GetNFields()) {
+      throw RException(R__FAIL("cannot merge ntuple '" + source.GetName() + "': the number of fields or columns differ"));
+   }
+
+   std::unordered_map<DescriptorId_t, DescriptorId_t> fieldMap{{destination.GetFieldZeroId(), source.GetFieldZeroId()}};
+   std::function<DescriptorId_t(DescriptorId_t)> fnMapField = [&](DescriptorId_t fieldId) {
+      auto itr = fieldMap.find(fieldId);
+      if (itr != fieldMap.end())
+         return itr->second;
+      const auto &fieldDesc = destination.GetFieldDescriptor(fieldId);
+      auto sourceFieldId = fnMapField(fieldDesc.GetParentId());
+      if (sourceFieldId != kInvalidDescriptorId)
+         sourceFieldId = source.FindFieldId(fieldDesc.GetFieldName(), sourceFieldId);
+      if (sourceFieldId != kInvalidDescriptorId &&
+          source.GetFieldDescriptor(sourceFieldId).GetTypeName() != fieldDesc.GetTypeName()) {
+         sourceFieldId = kInvalidDescriptorId;
+      }
+      fieldMap[fieldId] = sourceFieldId;
+      return sourceFieldId;
+   };
+
+   std::vector<DescriptorId_t> columnMap;
+   for (DescriptorId_t columnId = 0; columnId < destination.GetNColumns(); ++columnId) {
+      const auto &columnDesc = destination.GetColumnDescriptor(columnId);
+      auto sourceColumnId = fnMapField(columnDesc.GetFieldId());
+      if (sourceColumnId != kInvalidDescriptorId)
+         sourceColumnId = source.FindColumnId(sourceColumnId, columnDesc.GetIndex());
+      if (sourceColumnId == kInvalidDescriptorId ||
+          !(source.GetColumnDescriptor(sourceColumnId).GetModel() == columnDesc.GetModel())) {
+         throw RException(R__FAIL("cannot merge ntuple '" + source.GetName() + "': no matching column for field '" +
+                                  destination.GetQualifiedFieldName(columnDesc.GetFieldId()) + "'"));
+      }
+      columnMap.emplace_back(sourceColumnId);
+   }
+   return columnMap;
+}
+
+/// Reads the sealed pages of the given cluster as they are stored
+RSealedCluster LoadSealedCluster(RPageSource &source, DescriptorId_t clusterId,
+                                 const std::vector<DescriptorId_t> &columnMap)
+{
+   const auto &clusterDesc = source.GetDescriptor().GetClusterDescriptor(clusterId);
+
+   RSealedCluster cluster;
+   cluster.fNEntries = clusterDesc.GetNEntries();
+   cluster.fColumns.resize(columnMap.size());
+   for (std::size_t i = 0; i < columnMap.size(); ++i) {
+      const auto columnId = columnMap[i];
+      if (!clusterDesc.ContainsColumn(columnId))
+         continue;
+      const auto &pageInfos = clusterDesc.GetPageRange(columnId).fPageInfos;
+      std::size_t nBytes = 0;
+      for (const auto &pageInfo : pageInfos)
+         nBytes += pageInfo.fLocator.fBytesOnStorage;
+
+      auto &column = cluster.fColumns[i];
+      column.fBuffer = std::make_unique<unsigned char[]>(nBytes);
+      auto buffer = column.fBuffer.get();
+      ROOT::Experimental::ClusterSize_t::ValueType firstInPage = 0;
+      for (const auto &pageInfo : pageInfos) {
+         RPageStorage::RSealedPage sealedPage;
+         sealedPage.fBuffer = buffer;
+         source.LoadSealedPage(columnId, ROOT::Experimental::RClusterIndex(clusterId, firstInPage), sealedPage);
+         sealedPage.fValueRange = pageInfo.fValueRange;
+         buffer += sealedPage.fSize;
+         firstInPage += pageInfo.fNElements;
+         column.fPages.emplace_back(std::move(sealedPage));
+      }
+   }
+   return cluster;
+}
+
+} // anonymous namespace
 
 Long64_t ROOT::Experimental::RNTuple::Merge(TCollection* inputs, TFileMergeInfo* mergeInfo) {
    if (inputs == nullptr || mergeInfo == nullptr) {
       return -1;
    }
-   return -1;
+   // The anchors are written in the top directory, which is also where the merged ntuple goes
+   auto outputFile = dynamic_cast<TFile *>(mergeInfo->fOutputDirectory);
+   if (!outputFile) {
+      R__LOG_ERROR(NTupleLog()) << "RNTuple can only be merged into the top directory of a file";
+      return -1;
+   }
+
+   // The inputs are the keys of the ntuple anchor in every source file
+   std::string ntupleName;
+   std::vector<std::unique_ptr<Detail::RPageSource>> sources;
+   std::vector<Detail::RPageSource *> sourcePtrs;
+   TIter next(inputs);
+   while (auto obj = next()) {
+      auto key = dynamic_cast<TKey *>(obj);
+      if (!key || key->GetMotherDir() != key->GetFile()) {
+         R__LOG_ERROR(NTupleLog()) << "RNTuple merge inputs must be the anchor keys in the top directory of a file";
+         return -1;
+      }
+      ntupleName = key->GetName();
+      sources.emplace_back(
+         std::make_unique<Detail::RPageSourceFile>(ntupleName, key->GetFile()->GetName(), RNTupleReadOptions()));
+      sourcePtrs.emplace_back(sources.back().get());
+   }
+   if (sources.empty())
+      return 0;
+
+   try {
+      for (auto &source : sources)
+         source->Attach();
+      // The pages are copied as they are, so they keep the compression of the first source, column by column
+      RNTupleWriteOptions options;
+      const auto &descriptor = sources[0]->GetDescriptor();
+      if (descriptor.GetNClusters() > 0 && descriptor.GetNColumns() > 0) {
+         const auto &clusterDesc = descriptor.GetClusterDescriptor(descriptor.FindClusterId(0, 0));
+         options.SetCompression(clusterDesc.GetColumnRange(0).fCompressionSettings);
+         for (DescriptorId_t columnId = 0; columnId < descriptor.GetNColumns(); ++columnId) {
+            if (!clusterDesc.ContainsColumn(columnId))
+               continue;
+            const auto fieldId = descriptor.GetColumnDescriptor(columnId).GetFieldId();
+            options.SetFieldCompression(descriptor.GetQualifiedFieldName(fieldId),
+                                        clusterDesc.GetColumnRange(columnId).fCompressionSettings);
+         }
+      }
+      Detail::RPageSinkFile sink(ntupleName, *outputFile, options);
+      RNTupleMerger merger;
+      merger.Merge(sourcePtrs, sink);
+   } catch (const RException &e) {
+      R__LOG_ERROR(NTupleLog()) << e.GetError().GetReport();
+      return -1;
+   }
+   return 0;
 }
 
 
@@ -37,3 +209,97 @@ ROOT::Experimental::RFieldMerger::Merge(const ROOT::Experimental::RFieldDescript
    return R__FAIL("couldn't merge field " + lhs.GetFieldName() + " with field "
       + rhs.GetFieldName() + " (unimplemented!)");
 }
+
+
+////////////////////////////////////////////////////////////////////////////////
+
+
+void ROOT::Experimental::RNTupleMerger::Merge(const std::vector<Detail::RPageSource *> &sources,
+                                              Detail::RPageSink &destination)
+{
+   if (sources.empty())
+      throw RException(R__FAIL("no ntuple to merge"));
+
+   auto model = sources[0]->GetDescriptor().GenerateModel();
+   destination.Create(*model);
+   const auto &destinationDesc = destination.GetDescriptor();
+
+   std::size_t nConcurrent = 1;
+#ifdef R__USE_IMT
+   std::unique_ptr<TTaskGroup> taskGroup;
+   if (IsImplicitMTEnabled()) {
+      nConcurrent = std::max(1U, GetThreadPoolSize());
+      taskGroup = std::make_unique<TTaskGroup>();
+   }
+#endif
+
+   NTupleSize_t nEntries = 0;
+   auto fnCommitBatch = [&](std::vector<RSealedCluster> &batch) {
+      for (auto &cluster : batch) {
+         for (DescriptorId_t columnId = 0; columnId < cluster.fColumns.size(); ++columnId) {
+            for (const auto &sealedPage : cluster.fColumns[columnId].fPages)
+               destination.CommitSealedPage(columnId, sealedPage);
+         }
+         nEntries += cluster.fNEntries;
+         destination.CommitCluster(nEntries);
+      }
+      batch.clear();
+   };
+
+   for (auto source : sources) {
+      const auto &sourceDesc = source->GetDescriptor();
+      const auto columnMap = MapColumns(destinationDesc, sourceDesc);
+
+      std::vector<DescriptorId_t> clusterIds;
+      for (const auto &clusterDesc : sourceDesc.GetClusterIterable()) {
+         for (DescriptorId_t i = 0; i < columnMap.size(); ++i) {
+            const auto columnId = columnMap[i];
+            if (clusterDesc.ContainsColumn(columnId) &&
+                clusterDesc.GetColumnRange(columnId).fCompressionSettings != destination.GetColumnCompression(i)) {
+               throw RException(R__FAIL("cannot merge ntuple '" + sourceDesc.GetName() +
+                                        "': its pages are compressed with other settings than the destination"));
+            }
+         }
+         clusterIds.emplace_back(clusterDesc.GetId());
+      }
+      std::sort(clusterIds.begin(), clusterIds.end(), [&sourceDesc](DescriptorId_t lhs, DescriptorId_t rhs) {
+         return sourceDesc.GetClusterDescriptor(lhs).GetFirstEntryIndex() <
+                sourceDesc.GetClusterDescriptor(rhs).GetFirstEntryIndex();
+      });
+
+      if (nConcurrent == 1) {
+         for (auto clusterId : clusterIds) {
+            std::vector<RSealedCluster> batch;
+            batch.emplace_back(LoadSealedCluster(*source, clusterId, columnMap));
+            fnCommitBatch(batch);
+         }
+         continue;
+      }
+
+#ifdef R__USE_IMT
+      // Every task reads through its own page source.  The clusters of a batch are read while the clusters of the
+      // previous batch are written.
+      std::vector<std::unique_ptr<Detail::RPageSource>> clones;
+      std::vector<RSealedCluster> committing;
+      for (std::size_t first = 0; first < clusterIds.size(); first += nConcurrent) {
+         const auto nBatch = std::min(nConcurrent, clusterIds.size() - first);
+         while (clones.size() < nBatch) {
+            clones.emplace_back(source->Clone());
+            clones.back()->Attach();
+         }
+         std::vector<RSealedCluster> loading(nBatch);
+         for (std::size_t i = 0; i < nBatch; ++i) {
+            taskGroup->Run([&, i, first]() {
+               loading[i] = LoadSealedCluster(*clones[i], clusterIds[first + i], columnMap);
+            });
+         }
+         fnCommitBatch(committing);
+         taskGroup->Wait();
+         std::swap(committing, loading);
+      }
+      fnCommitBatch(committing);
+#endif
+   }
+
+   destination.CommitDataset();
+}
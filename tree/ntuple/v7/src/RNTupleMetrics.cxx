@@ -15,10 +15,30 @@
 
 #include <ROOT/RNTupleMetrics.hxx>
 
+#include <TFile.h>
+
+#include <algorithm>
+#include <cctype>
 #include <ostream>
+#include <sstream>
 
 #include <iostream>
 
+namespace {
+
+std::string EscapeJSON(const std::string &str)
+{
+   std::string result;
+   for (auto c : str) {
+      if (c == '"' || c == '\\')
+         result += '\\';
+      result += c;
+   }
+   return result;
+}
+
+} // anonymous namespace
+
 ROOT::Experimental::Detail::RNTuplePerfCounter::~RNTuplePerfCounter()
 {
 }
@@ -91,3 +111,109 @@ void ROOT::Experimental::Detail::RNTupleMetrics::ObserveMetrics(RNTupleMetrics &
 {
    fObservedMetrics.push_back(&observee);
 }
+
+void ROOT::Experimental::Detail::RNTupleMetrics::ForEachCounter(
+   const std::function<void(const std::string &, const RNTuplePerfCounter &)> &fn, const std::string &prefix) const
+{
+   for (const auto &c : fCounters)
+      fn(prefix + fName + kNamespaceSeperator + c->GetName(), *c);
+   for (const auto m : fObservedMetrics)
+      m->ForEachCounter(fn, prefix + fName + kNamespaceSeperator);
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+
+
+ROOT::Experimental::Detail::RNTupleMetricsRegistry &ROOT::Experimental::Detail::RNTupleMetricsRegistry::Instance()
+{
+   static RNTupleMetricsRegistry gRegistry;
+   return gRegistry;
+}
+
+void ROOT::Experimental::Detail::RNTupleMetricsRegistry::Accumulate(std::vector<RAggregate> &aggregates,
+                                                                     const RNTupleMetrics &metrics)
+{
+   if (!metrics.IsEnabled())
+      return;
+   metrics.ForEachCounter([&aggregates](const std::string &name, const RNTuplePerfCounter &counter) {
+      if (dynamic_cast<const RNTupleCalcPerf *>(&counter))
+         return;
+      auto itr = std::find_if(aggregates.begin(), aggregates.end(),
+                              [&name](const RAggregate &a) { return a.fName == name; });
+      if (itr == aggregates.end()) {
+         aggregates.emplace_back(RAggregate{name, counter.GetUnit(), counter.GetDescription(), 0});
+         itr = aggregates.end() - 1;
+      }
+      itr->fValue += counter.GetValueAsInt();
+   });
+}
+
+void ROOT::Experimental::Detail::RNTupleMetricsRegistry::Register(RNTupleMetrics &metrics)
+{
+   if (fIsEnabled)
+      metrics.Enable();
+   std::lock_guard<std::mutex> guard(fLock);
+   fLiveMetrics.emplace_back(&metrics);
+}
+
+void ROOT::Experimental::Detail::RNTupleMetricsRegistry::Unregister(const RNTupleMetrics &metrics)
+{
+   std::lock_guard<std::mutex> guard(fLock);
+   auto itr = std::find(fLiveMetrics.begin(), fLiveMetrics.end(), &metrics);
+   if (itr == fLiveMetrics.end())
+      return;
+   fLiveMetrics.erase(itr);
+   Accumulate(fRetired, metrics);
+}
+
+std::vector<ROOT::Experimental::Detail::RNTupleMetricsRegistry::RAggregate>
+ROOT::Experimental::Detail::RNTupleMetricsRegistry::GetAggregates() const
+{
+   std::vector<RAggregate> aggregates;
+   {
+      std::lock_guard<std::mutex> guard(fLock);
+      aggregates = fRetired;
+      for (auto m : fLiveMetrics)
+         Accumulate(aggregates, *m);
+   }
+   aggregates.emplace_back(RAggregate{"TFile.bytesRead", "B", "bytes read by all TFiles",
+                                      TFile::GetFileBytesRead()});
+   aggregates.emplace_back(RAggregate{"TFile.bytesWritten", "B", "bytes written by all TFiles",
+                                      TFile::GetFileBytesWritten()});
+   aggregates.emplace_back(RAggregate{"TFile.readCalls", "", "number of read calls of all TFiles",
+                                      TFile::GetFileReadCalls()});
+   std::sort(aggregates.begin(), aggregates.end(),
+             [](const RAggregate &lhs, const RAggregate &rhs) { return lhs.fName < rhs.fName; });
+   return aggregates;
+}
+
+std::string ROOT::Experimental::Detail::RNTupleMetricsRegistry::GetJSON() const
+{
+   std::ostringstream json;
+   json << "{";
+   bool isFirst = true;
+   for (const auto &a : GetAggregates()) {
+      if (!isFirst)
+         json << ",";
+      isFirst = false;
+      json << "\n  \"" << EscapeJSON(a.fName) << "\": {\"unit\": \"" << EscapeJSON(a.fUnit)
+           << "\", \"description\": \"" << EscapeJSON(a.fDescription) << "\", \"value\": " << a.fValue << "}";
+   }
+   json << "\n}\n";
+   return json.str();
+}
+
+std::string ROOT::Experimental::Detail::RNTupleMetricsRegistry::GetPrometheusText() const
+{
+   std::ostringstream text;
+   for (const auto &a : GetAggregates()) {
+      std::string name = "root_" + a.fName;
+      std::replace_if(name.begin(), name.end(), [](char c) { return !(isalnum(c) || c == '_' || c == ':'); }, '_');
+      text << "# HELP " << name << " " << a.fDescription;
+      if (!a.fUnit.empty())
+         text << " [" << a.fUnit << "]";
+      text << "\n# TYPE " << name << " untyped\n" << name << " " << a.fValue << "\n";
+   }
+   return text.str();
+}
@@ -47,6 +47,18 @@ ROOT::Experimental::RNTupleWriteOptions::Clone() const
    return std::make_unique<RNTupleWriteOptions>(*this);
 }
 
+int ROOT::Experimental::RNTupleWriteOptions::GetFieldCompression(std::string_view fieldName) const
+{
+   while (!fieldName.empty()) {
+      auto itr = fFieldCompression.find(std::string(fieldName));
+      if (itr != fFieldCompression.end())
+         return itr->second;
+      const auto posLastDot = fieldName.rfind('.');
+      fieldName = (posLastDot == std::string_view::npos) ? std::string_view() : fieldName.substr(0, posLastDot);
+   }
+   return fCompression;
+}
+
 void ROOT::Experimental::RNTupleWriteOptions::SetApproxZippedClusterSize(std::size_t val)
 {
    EnsureValidTunables(val, fMaxUnzippedClusterSize, fApproxUnzippedPageSize);
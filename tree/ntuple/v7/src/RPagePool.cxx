@@ -19,21 +19,82 @@
 #include <TError.h>
 
 #include <cstdlib>
+#include <limits>
+
+ROOT::Experimental::Detail::RPagePool::RPagePool(std::size_t memoryBudget)
+   : fMemoryBudget(memoryBudget), fMetrics("RPagePool")
+{
+   fCtrNHit = fMetrics.MakeCounter<RNTupleAtomicCounter *>("nHit", "", "number of pages found in the pool");
+   fCtrNMiss = fMetrics.MakeCounter<RNTupleAtomicCounter *>("nMiss", "", "number of pages registered after a miss");
+   fCtrNEvicted = fMetrics.MakeCounter<RNTupleAtomicCounter *>("nEvicted", "",
+                                                               "number of unused pages freed to meet the budget");
+   fCtrSzPages = fMetrics.MakeCounter<RNTupleAtomicCounter *>("szPages", "B", "size of the pages in the pool");
+}
+
+ROOT::Experimental::Detail::RPagePool::~RPagePool()
+{
+   for (auto &entry : fEntries)
+      entry.fDeleter(entry.fPage);
+}
+
+void ROOT::Experimental::Detail::RPagePool::AddPage(const RPage &page, const RPageDeleter &deleter,
+                                                   std::int32_t nReferences)
+{
+   REntry entry;
+   entry.fPage = page;
+   entry.fReferences = nReferences;
+   entry.fDeleter = deleter;
+   entry.fLastUse = ++fClock;
+   fEntries.emplace_back(std::move(entry));
+   fNBytes += page.GetNBytes();
+   EvictPages();
+   fCtrSzPages->SetValue(fNBytes);
+}
+
+void ROOT::Experimental::Detail::RPagePool::RemovePage(std::size_t idx)
+{
+   auto &entry = fEntries[idx];
+   fNBytes -= entry.fPage.GetNBytes();
+   entry.fDeleter(entry.fPage);
+   if (idx != fEntries.size() - 1)
+      entry = std::move(fEntries.back());
+   fEntries.pop_back();
+}
+
+void ROOT::Experimental::Detail::RPagePool::EvictPages()
+{
+   if (fMemoryBudget == 0)
+      return;
+
+   while (fNBytes > fMemoryBudget) {
+      std::size_t idxVictim = fEntries.size();
+      auto oldestUse = std::numeric_limits<std::uint64_t>::max();
+      for (std::size_t i = 0; i < fEntries.size(); ++i) {
+         if (fEntries[i].fReferences > 0)
+            continue;
+         if (fEntries[i].fLastUse < oldestUse) {
+            oldestUse = fEntries[i].fLastUse;
+            idxVictim = i;
+         }
+      }
+      if (idxVictim == fEntries.size())
+         return; // all remaining pages are in use
+      RemovePage(idxVictim);
+      fCtrNEvicted->Inc();
+   }
+}
 
 void ROOT::Experimental::Detail::RPagePool::RegisterPage(const RPage &page, const RPageDeleter &deleter)
 {
    std::lock_guard<std::mutex> lockGuard(fLock);
-   fPages.emplace_back(page);
-   fReferences.emplace_back(1);
-   fDeleters.emplace_back(deleter);
+   fCtrNMiss->Inc();
+   AddPage(page, deleter, 1);
 }
 
 void ROOT::Experimental::Detail::RPagePool::PreloadPage(const RPage &page, const RPageDeleter &deleter)
 {
    std::lock_guard<std::mutex> lockGuard(fLock);
-   fPages.emplace_back(page);
-   fReferences.emplace_back(0);
-   fDeleters.emplace_back(deleter);
+   AddPage(page, deleter, 0);
 }
 
 void ROOT::Experimental::Detail::RPagePool::ReturnPage(const RPage& page)
@@ -41,18 +102,19 @@ void ROOT::Experimental::Detail::RPagePool::ReturnPage(const RPage& page)
    if (page.IsNull()) return;
    std::lock_guard<std::mutex> lockGuard(fLock);
 
-   unsigned int N = fPages.size();
-   for (unsigned i = 0; i < N; ++i) {
-      if (fPages[i] != page) continue;
-
-      if (--fReferences[i] == 0) {
-         fDeleters[i](fPages[i]);
-         fPages[i] = fPages[N-1];
-         fReferences[i] = fReferences[N-1];
-         fDeleters[i] = fDeleters[N-1];
-         fPages.resize(N-1);
-         fReferences.resize(N-1);
-         fDeleters.resize(N-1);
+   for (std::size_t i = 0; i < fEntries.size(); ++i) {
+      auto &entry = fEntries[i];
+      if (entry.fPage != page) continue;
+
+      R__ASSERT(entry.fReferences > 0);
+      if (--entry.fReferences == 0) {
+         if (fMemoryBudget == 0) {
+            RemovePage(i);
+         } else {
+            entry.fLastUse = ++fClock;
+            EvictPages();
+         }
+         fCtrSzPages->SetValue(fNBytes);
       }
       return;
    }
@@ -63,13 +125,13 @@ ROOT::Experimental::Detail::RPage ROOT::Experimental::Detail::RPagePool::GetPage
    ColumnId_t columnId, NTupleSize_t globalIndex)
 {
    std::lock_guard<std::mutex> lockGuard(fLock);
-   unsigned int N = fPages.size();
-   for (unsigned int i = 0; i < N; ++i) {
-      if (fReferences[i] < 0) continue;
-      if (fPages[i].GetColumnId() != columnId) continue;
-      if (!fPages[i].Contains(globalIndex)) continue;
-      fReferences[i]++;
-      return fPages[i];
+   for (auto &entry : fEntries) {
+      if (entry.fPage.GetColumnId() != columnId) continue;
+      if (!entry.fPage.Contains(globalIndex)) continue;
+      entry.fReferences++;
+      entry.fLastUse = ++fClock;
+      fCtrNHit->Inc();
+      return entry.fPage;
    }
    return RPage();
 }
@@ -78,13 +140,25 @@ ROOT::Experimental::Detail::RPage ROOT::Experimental::Detail::RPagePool::GetPage
    ColumnId_t columnId, const RClusterIndex &clusterIndex)
 {
    std::lock_guard<std::mutex> lockGuard(fLock);
-   unsigned int N = fPages.size();
-   for (unsigned int i = 0; i < N; ++i) {
-      if (fReferences[i] < 0) continue;
-      if (fPages[i].GetColumnId() != columnId) continue;
-      if (!fPages[i].Contains(clusterIndex)) continue;
-      fReferences[i]++;
-      return fPages[i];
+   for (auto &entry : fEntries) {
+      if (entry.fPage.GetColumnId() != columnId) continue;
+      if (!entry.fPage.Contains(clusterIndex)) continue;
+      entry.fReferences++;
+      entry.fLastUse = ++fClock;
+      fCtrNHit->Inc();
+      return entry.fPage;
    }
    return RPage();
 }
+
+std::size_t ROOT::Experimental::Detail::RPagePool::GetNPages()
+{
+   std::lock_guard<std::mutex> lockGuard(fLock);
+   return fEntries.size();
+}
+
+std::size_t ROOT::Experimental::Detail::RPagePool::GetNBytes()
+{
+   std::lock_guard<std::mutex> lockGuard(fLock);
+   return fNBytes;
+}
@@ -29,6 +29,8 @@ ROOT::Experimental::Detail::RPageSinkBuf::RPageSinkBuf(std::unique_ptr<RPageSink
          "compressing pages in parallel")
    });
    fMetrics.ObserveMetrics(fInnerSink->GetMetrics());
+   // The inner sink records the value ranges
+   fComputeValueRanges = false;
 }
 
 void ROOT::Experimental::Detail::RPageSinkBuf::CreateImpl(const RNTupleModel &model)
@@ -61,10 +63,10 @@ ROOT::Experimental::Detail::RPageSinkBuf::CommitPageImpl(ColumnHandle_t columnHa
    zipItem->AllocateSealedPageBuf();
    R__ASSERT(zipItem->fBuf);
    fTaskScheduler->AddTask([this, zipItem, colId = columnHandle.fId] {
-      zipItem->fSealedPage = SealPage(zipItem->fPage,
-         *fBufferedColumns.at(colId).GetHandle().fColumn->GetElement(),
-         GetWriteOptions().GetCompression(), zipItem->fBuf.get()
-      );
+      const auto &element = *fBufferedColumns.at(colId).GetHandle().fColumn->GetElement();
+      zipItem->fSealedPage = SealPage(zipItem->fPage, element, GetColumnCompression(colId), zipItem->fBuf.get());
+      // The inner sink cannot inspect the sealed page
+      zipItem->fSealedPage.fValueRange = GetValueRange(zipItem->fPage, element);
    });
 
    // we're feeding bad locators to fOpenPageRanges but it should not matter
@@ -15,6 +15,7 @@
 
 #include <ROOT/RPageStorage.hxx>
 #include <ROOT/RPageStorageFile.hxx>
+#include <ROOT/RCluster.hxx>
 #include <ROOT/RColumn.hxx>
 #include <ROOT/RField.hxx>
 #include <ROOT/RNTupleDescriptor.hxx>
@@ -105,6 +106,15 @@ ROOT::Experimental::ColumnId_t ROOT::Experimental::Detail::RPageSource::GetColum
    return columnHandle.fId;
 }
 
+std::vector<std::unique_ptr<ROOT::Experimental::Detail::RCluster>>
+ROOT::Experimental::Detail::RPageSource::LoadClusters(const std::vector<RClusterKey> &clusterKeys)
+{
+   std::vector<std::unique_ptr<RCluster>> clusters;
+   for (const auto &key : clusterKeys)
+      clusters.emplace_back(LoadCluster(key.fClusterId, key.fColumns));
+   return clusters;
+}
+
 void ROOT::Experimental::Detail::RPageSource::UnzipCluster(RCluster *cluster)
 {
    if (fTaskScheduler)
@@ -282,6 +292,9 @@ void ROOT::Experimental::Detail::RPageSink::Create(RNTupleModel &model)
    fDescriptorBuilder.SetNTuple(fNTupleName, model.GetDescription(), "undefined author",
                                 model.GetVersion(), model.GetUuid());
 
+   // The compression settings of the columns, following those of the fields they belong to
+   std::vector<int> columnCompression;
+
    auto &fieldZero = *model.GetFieldZero();
    fDescriptorBuilder.AddField(
       RDanglingFieldDescriptor::FromField(fieldZero)
@@ -301,6 +314,9 @@ void ROOT::Experimental::Detail::RPageSink::Create(RNTupleModel &model)
       fDescriptorBuilder.AddFieldLink(f.GetParent()->GetOnDiskId(), fLastFieldId);
       f.SetOnDiskId(fLastFieldId);
       f.ConnectPageSink(*this); // issues in turn one or several calls to AddColumn()
+      const auto compression =
+         GetWriteOptions().GetFieldCompression(fDescriptorBuilder.GetDescriptor().GetQualifiedFieldName(fLastFieldId));
+      columnCompression.resize(fLastColumnId, compression);
    }
 
    auto nColumns = fLastColumnId;
@@ -309,12 +325,13 @@ void ROOT::Experimental::Detail::RPageSink::Create(RNTupleModel &model)
       columnRange.fColumnId = i;
       columnRange.fFirstElementIndex = 0;
       columnRange.fNElements = 0;
-      columnRange.fCompressionSettings = GetWriteOptions().GetCompression();
+      columnRange.fCompressionSettings = columnCompression[i];
       fOpenColumnRanges.emplace_back(columnRange);
       RClusterDescriptor::RPageRange pageRange;
       pageRange.fColumnId = i;
       fOpenPageRanges.emplace_back(std::move(pageRange));
    }
+   fColumnStorageStats.resize(nColumns);
 
    CreateImpl(model);
 }
@@ -322,11 +339,25 @@ void ROOT::Experimental::Detail::RPageSink::Create(RNTupleModel &model)
 
 void ROOT::Experimental::Detail::RPageSink::CommitPage(ColumnHandle_t columnHandle, const RPage &page)
 {
-   fOpenColumnRanges.at(columnHandle.fId).fNElements += page.GetNElements();
-
    RClusterDescriptor::RPageRange::RPageInfo pageInfo;
    pageInfo.fNElements = page.GetNElements();
+   if (fComputeValueRanges && columnHandle.fColumn)
+      pageInfo.fValueRange = GetValueRange(page, *columnHandle.fColumn->GetElement());
+
+   auto &columnRange = fOpenColumnRanges.at(columnHandle.fId);
+   if (columnRange.fNElements == 0)
+      columnRange.fValueRange = pageInfo.fValueRange;
+   else
+      columnRange.fValueRange.Merge(pageInfo.fValueRange);
+   columnRange.fNElements += page.GetNElements();
+
    pageInfo.fLocator = CommitPageImpl(columnHandle, page);
+   // Buffering sinks return an empty locator; the storage size is then known only to the inner sink
+   if (pageInfo.fLocator.fBytesOnStorage > 0) {
+      auto &stats = fColumnStorageStats.at(columnHandle.fId);
+      stats.fNElements += page.GetNElements();
+      stats.fNBytesOnStorage += pageInfo.fLocator.fBytesOnStorage;
+   }
    fOpenPageRanges.at(columnHandle.fId).fPageInfos.emplace_back(pageInfo);
 }
 
@@ -335,15 +366,36 @@ void ROOT::Experimental::Detail::RPageSink::CommitSealedPage(
    ROOT::Experimental::DescriptorId_t columnId,
    const ROOT::Experimental::Detail::RPageStorage::RSealedPage &sealedPage)
 {
-   fOpenColumnRanges.at(columnId).fNElements += sealedPage.fNElements;
-
    RClusterDescriptor::RPageRange::RPageInfo pageInfo;
    pageInfo.fNElements = sealedPage.fNElements;
+   pageInfo.fValueRange = sealedPage.fValueRange;
+
+   auto &columnRange = fOpenColumnRanges.at(columnId);
+   if (columnRange.fNElements == 0)
+      columnRange.fValueRange = pageInfo.fValueRange;
+   else
+      columnRange.fValueRange.Merge(pageInfo.fValueRange);
+   columnRange.fNElements += sealedPage.fNElements;
+
    pageInfo.fLocator = CommitSealedPageImpl(columnId, sealedPage);
+   auto &stats = fColumnStorageStats.at(columnId);
+   stats.fNElements += sealedPage.fNElements;
+   stats.fNBytesOnStorage += sealedPage.fSize;
    fOpenPageRanges.at(columnId).fPageInfos.emplace_back(pageInfo);
 }
 
 
+double ROOT::Experimental::Detail::RPageSink::GetNBytesPerElementOnStorage(DescriptorId_t columnId) const
+{
+   if (columnId >= fColumnStorageStats.size())
+      return 0.;
+   const auto &stats = fColumnStorageStats[columnId];
+   if (stats.fNElements == 0)
+      return 0.;
+   return static_cast<double>(stats.fNBytesOnStorage) / static_cast<double>(stats.fNElements);
+}
+
+
 std::uint64_t ROOT::Experimental::Detail::RPageSink::CommitCluster(ROOT::Experimental::NTupleSize_t nEntries)
 {
    auto nbytes = CommitClusterImpl(nEntries);
@@ -371,6 +423,15 @@ std::uint64_t ROOT::Experimental::Detail::RPageSink::CommitCluster(ROOT::Experim
    return nbytes;
 }
 
+ROOT::Experimental::RClusterDescriptor::RValueRange
+ROOT::Experimental::Detail::RPageSink::GetValueRange(const RPage &page, const RColumnElementBase &element)
+{
+   RClusterDescriptor::RValueRange valueRange;
+   valueRange.fIsValid =
+      element.GetValueRange(page.GetBuffer(), page.GetNElements(), valueRange.fMin, valueRange.fMax);
+   return valueRange;
+}
+
 ROOT::Experimental::Detail::RPageStorage::RSealedPage
 ROOT::Experimental::Detail::RPageSink::SealPage(const RPage &page,
    const RColumnElementBase &element, int compressionSetting, void *buf)
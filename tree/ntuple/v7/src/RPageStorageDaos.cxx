@@ -164,7 +164,7 @@ ROOT::Experimental::Detail::RPageSinkDaos::CommitPageImpl(ColumnHandle_t columnH
    RPageStorage::RSealedPage sealedPage;
    {
       RNTupleAtomicTimer timer(fCounters->fTimeWallZip, fCounters->fTimeCpuZip);
-      sealedPage = SealPage(page, *element, GetWriteOptions().GetCompression());
+      sealedPage = SealPage(page, *element, GetColumnCompression(columnHandle.fId));
    }
 
    fCounters->fSzZip.Add(page.GetNBytes());
@@ -177,11 +177,12 @@ ROOT::Experimental::Detail::RPageSinkDaos::CommitSealedPageImpl(
    DescriptorId_t /*columnId*/, const RPageStorage::RSealedPage &sealedPage)
 {
    auto offsetData = fOid.fetch_add(1);
-   {
-      RNTupleAtomicTimer timer(fCounters->fTimeWallWrite, fCounters->fTimeCpuWrite);
-      fDaosContainer->WriteSingleAkey(sealedPage.fBuffer, sealedPage.fSize,
-                                      {offsetData, 0}, kDistributionKey, kAttributeKey);
-   }
+   // The caller may reuse the page buffer right away, the page is written with the others of the cluster
+   auto buffer = std::make_unique<unsigned char[]>(sealedPage.fSize);
+   memcpy(buffer.get(), sealedPage.fBuffer, sealedPage.fSize);
+   fPendingPageBuffers.emplace_back(std::move(buffer));
+   fPendingPageSizes.emplace_back(sealedPage.fSize);
+   fPendingPageOids.emplace_back(offsetData);
 
    RClusterDescriptor::RLocator result;
    result.fPosition = offsetData;
@@ -193,15 +194,41 @@ ROOT::Experimental::Detail::RPageSinkDaos::CommitSealedPageImpl(
 }
 
 
+void ROOT::Experimental::Detail::RPageSinkDaos::FlushPendingPages()
+{
+   if (fPendingPageOids.empty())
+      return;
+
+   std::vector<RDaosContainer::RWOperation> writeRequests;
+   writeRequests.reserve(fPendingPageOids.size());
+   for (std::size_t i = 0; i < fPendingPageOids.size(); ++i) {
+      std::vector<d_iov_t> iovs(1);
+      d_iov_set(&iovs[0], fPendingPageBuffers[i].get(), fPendingPageSizes[i]);
+      writeRequests.emplace_back(daos_obj_id_t{fPendingPageOids[i], 0}, kDistributionKey, kAttributeKey, iovs);
+   }
+   {
+      RNTupleAtomicTimer timer(fCounters->fTimeWallWrite, fCounters->fTimeCpuWrite);
+      if (fDaosContainer->WriteV(writeRequests) != 0)
+         throw RException(R__FAIL("RPageSinkDaos: not all the page updates completed"));
+   }
+   fPendingPageBuffers.clear();
+   fPendingPageSizes.clear();
+   fPendingPageOids.clear();
+}
+
+
 std::uint64_t
 ROOT::Experimental::Detail::RPageSinkDaos::CommitClusterImpl(ROOT::Experimental::NTupleSize_t /* nEntries */)
 {
+   FlushPendingPages();
    return std::exchange(fNBytesCurrentCluster, 0);
 }
 
 
 void ROOT::Experimental::Detail::RPageSinkDaos::CommitDatasetImpl()
 {
+   FlushPendingPages();
+
    const auto &descriptor = fDescriptorBuilder.GetDescriptor();
    auto szFooter = descriptor.GetFooterSize();
    auto buffer = std::make_unique<unsigned char []>(szFooter);
@@ -280,14 +307,23 @@ void ROOT::Experimental::Detail::RPageAllocatorDaos::DeletePage(const RPage& pag
 
 ROOT::Experimental::Detail::RPageSourceDaos::RPageSourceDaos(std::string_view ntupleName, std::string_view uri,
    const RNTupleReadOptions &options)
+   : RPageSourceDaos(ntupleName, uri, options, std::make_shared<RPagePool>(options.GetPagePoolMemoryBudget()))
+{
+}
+
+
+ROOT::Experimental::Detail::RPageSourceDaos::RPageSourceDaos(std::string_view ntupleName, std::string_view uri,
+   const RNTupleReadOptions &options, std::shared_ptr<RPagePool> pagePool)
    : RPageSource(ntupleName, options)
    , fPageAllocator(std::make_unique<RPageAllocatorDaos>())
-   , fPagePool(std::make_shared<RPagePool>())
+   , fPagePool(std::move(pagePool))
    , fURI(uri)
    , fClusterPool(std::make_unique<RClusterPool>(*this))
 {
    fDecompressor = std::make_unique<RNTupleDecompressor>();
    EnableDefaultMetrics("RPageSourceDaos");
+   fMetrics.ObserveMetrics(fClusterPool->GetMetrics());
+   fMetrics.ObserveMetrics(fPagePool->GetMetrics());
 
    auto args = ParseDaosURI(uri);
    auto pool = std::make_shared<RDaosPool>(args.fPoolUuid, args.fSvcReplicas);
@@ -453,18 +489,20 @@ void ROOT::Experimental::Detail::RPageSourceDaos::ReleasePage(RPage &page)
 
 std::unique_ptr<ROOT::Experimental::Detail::RPageSource> ROOT::Experimental::Detail::RPageSourceDaos::Clone() const
 {
-   auto clone = new RPageSourceDaos(fNTupleName, fURI, fOptions);
+   auto clone = new RPageSourceDaos(fNTupleName, fURI, fOptions, fPagePool);
    return std::unique_ptr<RPageSourceDaos>(clone);
 }
 
 std::unique_ptr<ROOT::Experimental::Detail::RCluster>
 ROOT::Experimental::Detail::RPageSourceDaos::LoadCluster(DescriptorId_t clusterId, const ColumnSet_t &columns)
 {
-   fCounters->fNClusterLoaded.Inc();
-
-   const auto &clusterDesc = GetDescriptor().GetClusterDescriptor(clusterId);
-   auto clusterLocator = clusterDesc.GetLocator();
+   auto clusters = LoadClusters({RClusterKey{clusterId, columns}});
+   return std::move(clusters[0]);
+}
 
+std::vector<std::unique_ptr<ROOT::Experimental::Detail::RCluster>>
+ROOT::Experimental::Detail::RPageSourceDaos::LoadClusters(const std::vector<RClusterKey> &clusterKeys)
+{
    struct RDaosSealedPageLocator {
       RDaosSealedPageLocator() = default;
       RDaosSealedPageLocator(DescriptorId_t c, NTupleSize_t p, std::uint64_t o, std::uint64_t s, std::size_t b)
@@ -476,52 +514,66 @@ ROOT::Experimental::Detail::RPageSourceDaos::LoadCluster(DescriptorId_t clusterI
       std::size_t fBufPos = 0;
    };
 
-   // Collect the page necessary page meta-data and sum up the total size of the compressed and packed pages
-   std::vector<RDaosSealedPageLocator> onDiskPages;
-   std::size_t szPayload = 0;
-   for (auto columnId : columns) {
-      const auto &pageRange = clusterDesc.GetPageRange(columnId);
-      NTupleSize_t pageNo = 0;
-      for (const auto &pageInfo : pageRange.fPageInfos) {
-         const auto &pageLocator = pageInfo.fLocator;
-         onDiskPages.emplace_back(RDaosSealedPageLocator(
-            columnId, pageNo, pageLocator.fPosition, pageLocator.fBytesOnStorage, szPayload));
-         szPayload += pageLocator.fBytesOnStorage;
-         ++pageNo;
+   // The fetch requests of the pages of all the clusters are issued together and complete in a single event queue
+   std::vector<RDaosContainer::RWOperation> readRequests;
+   std::vector<std::unique_ptr<RCluster>> clusters;
+   std::size_t nPages = 0;
+   std::size_t szPayloadTotal = 0;
+   for (const auto &key : clusterKeys) {
+      fCounters->fNClusterLoaded.Inc();
+      const auto &clusterDesc = GetDescriptor().GetClusterDescriptor(key.fClusterId);
+
+      // Collect the page necessary page meta-data and sum up the total size of the compressed and packed pages
+      std::vector<RDaosSealedPageLocator> onDiskPages;
+      std::size_t szPayload = 0;
+      for (auto columnId : key.fColumns) {
+         const auto &pageRange = clusterDesc.GetPageRange(columnId);
+         NTupleSize_t pageNo = 0;
+         for (const auto &pageInfo : pageRange.fPageInfos) {
+            const auto &pageLocator = pageInfo.fLocator;
+            onDiskPages.emplace_back(RDaosSealedPageLocator(
+               columnId, pageNo, pageLocator.fPosition, pageLocator.fBytesOnStorage, szPayload));
+            szPayload += pageLocator.fBytesOnStorage;
+            ++pageNo;
+         }
       }
-   }
 
-   // Prepare the input vector for the RDaosContainer::ReadV() call
-   std::vector<RDaosContainer::RWOperation> readRequests;
-   auto buffer = new unsigned char[szPayload];
-   for (auto &s : onDiskPages) {
-      std::vector<d_iov_t> iovs(1);
-      d_iov_set(&iovs[0], buffer + s.fBufPos, s.fSize);
-      readRequests.emplace_back(daos_obj_id_t{s.fObjectId, 0},
-                                kDistributionKey, kAttributeKey, iovs);
-   }
-   fCounters->fSzReadPayload.Add(szPayload);
+      // Prepare the input vector for the RDaosContainer::ReadV() call
+      auto buffer = new unsigned char[szPayload];
+      for (auto &s : onDiskPages) {
+         std::vector<d_iov_t> iovs(1);
+         d_iov_set(&iovs[0], buffer + s.fBufPos, s.fSize);
+         readRequests.emplace_back(daos_obj_id_t{s.fObjectId, 0},
+                                   kDistributionKey, kAttributeKey, iovs);
+      }
+      szPayloadTotal += szPayload;
+      nPages += onDiskPages.size();
+
+      // Register the on disk pages in a page map
+      auto pageMap = std::make_unique<ROnDiskPageMapHeap>(std::unique_ptr<unsigned char []>(buffer));
+      for (const auto &s : onDiskPages) {
+         ROnDiskPage::Key pageKey(s.fColumnId, s.fPageNo);
+         pageMap->Register(pageKey, ROnDiskPage(buffer + s.fBufPos, s.fSize));
+      }
 
-   // Register the on disk pages in a page map
-   auto pageMap = std::make_unique<ROnDiskPageMapHeap>(std::unique_ptr<unsigned char []>(buffer));
-   for (const auto &s : onDiskPages) {
-      ROnDiskPage::Key key(s.fColumnId, s.fPageNo);
-      pageMap->Register(key, ROnDiskPage(buffer + s.fBufPos, s.fSize));
+      auto cluster = std::make_unique<RCluster>(key.fClusterId);
+      cluster->Adopt(std::move(pageMap));
+      for (auto colId : key.fColumns)
+         cluster->SetColumnAvailable(colId);
+      clusters.emplace_back(std::move(cluster));
    }
-   fCounters->fNPageLoaded.Add(onDiskPages.size());
+   fCounters->fSzReadPayload.Add(szPayloadTotal);
+   fCounters->fNPageLoaded.Add(nPages);
 
    {
       RNTupleAtomicTimer timer(fCounters->fTimeWallRead, fCounters->fTimeCpuRead);
-      fDaosContainer->ReadV(readRequests);
+      if (fDaosContainer->ReadV(readRequests) != 0)
+         throw RException(R__FAIL("RPageSourceDaos: not all the page fetches completed"));
    }
    fCounters->fNReadV.Inc();
    fCounters->fNRead.Add(readRequests.size());
 
-   auto cluster = std::make_unique<RCluster>(clusterId);
-   cluster->Adopt(std::move(pageMap));
-   for (auto colId : columns)
-      cluster->SetColumnAvailable(colId);
-   return cluster;
+   return clusters;
 }
 
 
@@ -30,9 +30,11 @@
 #include <TError.h>
 
 #include <algorithm>
+#include <cstdint>
 #include <cstdio>
 #include <cstdlib>
 #include <iostream>
+#include <stdexcept>
 #include <utility>
 
 #include <atomic>
@@ -128,7 +130,7 @@ ROOT::Experimental::Detail::RPageSinkFile::CommitPageImpl(ColumnHandle_t columnH
    RPageStorage::RSealedPage sealedPage;
    {
       RNTupleAtomicTimer timer(fCounters->fTimeWallZip, fCounters->fTimeCpuZip);
-      sealedPage = SealPage(page, *element, GetWriteOptions().GetCompression());
+      sealedPage = SealPage(page, *element, GetColumnCompression(columnHandle.fId));
    }
 
    fCounters->fSzZip.Add(page.GetNBytes());
@@ -209,21 +211,70 @@ void ROOT::Experimental::Detail::RPageAllocatorFile::DeletePage(const RPage& pag
 ////////////////////////////////////////////////////////////////////////////////
 
 
+/// The mapping uses its own raw file, so that it can outlive the page source and its clones
+class ROOT::Experimental::Detail::RPageSourceFile::RMappedFile {
+private:
+   std::unique_ptr<ROOT::Internal::RRawFile> fFile;
+   unsigned char *fAddress = nullptr;
+   std::size_t fSize = 0;
+
+public:
+   explicit RMappedFile(std::unique_ptr<ROOT::Internal::RRawFile> file) : fFile(std::move(file))
+   {
+      fSize = fFile->GetSize();
+      std::uint64_t mapdOffset;
+      fAddress = static_cast<unsigned char *>(fFile->Map(fSize, 0, mapdOffset));
+      R__ASSERT(mapdOffset == 0);
+   }
+   RMappedFile(const RMappedFile &) = delete;
+   RMappedFile &operator=(const RMappedFile &) = delete;
+   ~RMappedFile() { fFile->Unmap(fAddress, fSize); }
+
+   const unsigned char *GetAddress(std::uint64_t offset) const { return fAddress + offset; }
+   std::size_t GetSize() const { return fSize; }
+};
+
+namespace {
+
+/// The on-disk pages of a cluster loaded from a memory mapped file point into the mapping
+class ROnDiskPageMapMmap : public ROOT::Experimental::Detail::ROnDiskPageMap {
+private:
+   std::shared_ptr<const void> fMappedFile;
+
+public:
+   explicit ROnDiskPageMapMmap(std::shared_ptr<const void> mappedFile) : fMappedFile(std::move(mappedFile)) {}
+};
+
+/// Pages that are neither compressed nor packed can be used in place if their address suits the element type
+bool CanUseInPlace(const ROOT::Experimental::Detail::RPageStorage::RSealedPage &sealedPage,
+                   const ROOT::Experimental::Detail::RColumnElementBase &element)
+{
+   if (!element.IsMappable() || sealedPage.fSize != element.GetPackedSize(sealedPage.fNElements))
+      return false;
+   const std::size_t alignment = std::min(element.GetSize(), alignof(std::max_align_t));
+   return reinterpret_cast<std::uintptr_t>(sealedPage.fBuffer) % alignment == 0;
+}
+
+} // anonymous namespace
+
+
 ROOT::Experimental::Detail::RPageSourceFile::RPageSourceFile(std::string_view ntupleName,
-   const RNTupleReadOptions &options)
+   const RNTupleReadOptions &options, std::shared_ptr<RPagePool> pagePool)
    : RPageSource(ntupleName, options)
    , fPageAllocator(std::make_unique<RPageAllocatorFile>())
-   , fPagePool(std::make_shared<RPagePool>())
+   , fPagePool(std::move(pagePool))
    , fClusterPool(std::make_unique<RClusterPool>(*this))
 {
    fDecompressor = std::make_unique<RNTupleDecompressor>();
    EnableDefaultMetrics("RPageSourceFile");
+   fMetrics.ObserveMetrics(fClusterPool->GetMetrics());
+   fMetrics.ObserveMetrics(fPagePool->GetMetrics());
 }
 
 
 ROOT::Experimental::Detail::RPageSourceFile::RPageSourceFile(std::string_view ntupleName, std::string_view path,
    const RNTupleReadOptions &options)
-   : RPageSourceFile(ntupleName, options)
+   : RPageSourceFile(ntupleName, options, std::make_shared<RPagePool>(options.GetPagePoolMemoryBudget()))
 {
    fFile = ROOT::Internal::RRawFile::Create(path);
    R__ASSERT(fFile);
@@ -251,6 +302,18 @@ ROOT::Experimental::RNTupleDescriptor ROOT::Experimental::Detail::RPageSourceFil
    fDecompressor->Unzip(zipBuffer.get(), ntpl.fNBytesFooter, ntpl.fLenFooter, buffer.get());
    descBuilder.AddClustersFromFooter(buffer.get());
 
+   if (fOptions.GetUseMemoryMap() && !fMappedFile) {
+      if (fFile->GetFeatures() & ROOT::Internal::RRawFile::kFeatureHasMmap) {
+         try {
+            fMappedFile = std::make_shared<RMappedFile>(fFile->Clone());
+         } catch (const std::runtime_error &e) {
+            R__LOG_WARNING(NTupleLog()) << "cannot map the file into memory, reading it instead: " << e.what();
+         }
+      } else {
+         R__LOG_WARNING(NTupleLog()) << "memory mapping is not supported for this file, reading it instead";
+      }
+   }
+
    return descBuilder.MoveDescriptor();
 }
 
@@ -279,13 +342,18 @@ ROOT::Experimental::Detail::RPage ROOT::Experimental::Detail::RPageSourceFile::P
    auto pageInfo = clusterDescriptor.GetPageRange(columnId).Find(idxInCluster);
 
    const auto element = columnHandle.fColumn->GetElement();
-   const auto elementSize = element->GetSize();
    const auto bytesOnStorage = pageInfo.fLocator.fBytesOnStorage;
 
-   const void *sealedPageBuffer = nullptr; // points either to directReadBuffer or to a read-only page in the cluster
+   // points either to directReadBuffer, to a read-only page in the cluster or into the memory mapping
+   const void *sealedPageBuffer = nullptr;
    std::unique_ptr<unsigned char []> directReadBuffer; // only used if cluster pool is turned off
 
-   if (fOptions.GetClusterCache() == RNTupleReadOptions::EClusterCache::kOff) {
+   if (fMappedFile && fOptions.GetClusterCache() == RNTupleReadOptions::EClusterCache::kOff) {
+      R__ASSERT(std::uint64_t(pageInfo.fLocator.fPosition) + bytesOnStorage <= fMappedFile->GetSize());
+      sealedPageBuffer = fMappedFile->GetAddress(pageInfo.fLocator.fPosition);
+      fCounters->fNPageLoaded.Inc();
+      fCounters->fSzReadPayload.Add(bytesOnStorage);
+   } else if (fOptions.GetClusterCache() == RNTupleReadOptions::EClusterCache::kOff) {
       directReadBuffer = std::make_unique<unsigned char[]>(bytesOnStorage);
       fReader.ReadBuffer(directReadBuffer.get(), bytesOnStorage, pageInfo.fLocator.fPosition);
       fCounters->fNPageLoaded.Inc();
@@ -307,23 +375,41 @@ ROOT::Experimental::Detail::RPage ROOT::Experimental::Detail::RPageSourceFile::P
       sealedPageBuffer = onDiskPage->GetAddress();
    }
 
+   RPageDeleter deleter;
+   auto newPage = CreatePage(columnId, {sealedPageBuffer, bytesOnStorage, pageInfo.fNElements}, *element, deleter);
+   const auto indexOffset = clusterDescriptor.GetColumnRange(columnId).fFirstElementIndex;
+   newPage.SetWindow(indexOffset + pageInfo.fFirstInPage, RPage::RClusterInfo(clusterId, indexOffset));
+   fPagePool->RegisterPage(newPage, deleter);
+   fCounters->fNPagePopulated.Inc();
+   return newPage;
+}
+
+
+ROOT::Experimental::Detail::RPage ROOT::Experimental::Detail::RPageSourceFile::CreatePage(
+   DescriptorId_t columnId, const RSealedPage &sealedPage, const RColumnElementBase &element, RPageDeleter &deleter)
+{
+   const auto elementSize = element.GetSize();
+   // With a memory mapping, all the sealed pages point into it
+   if (fMappedFile && CanUseInPlace(sealedPage, element)) {
+      deleter = RPageDeleter([mappedFile = fMappedFile](const RPage & /*page*/, void * /*userData*/) {
+         // Only releases the reference to the mapping
+         (void)mappedFile;
+      });
+      return fPageAllocator->NewPage(columnId, const_cast<void *>(sealedPage.fBuffer), elementSize,
+                                     sealedPage.fNElements);
+   }
+
    std::unique_ptr<unsigned char []> pageBuffer;
    {
       RNTupleAtomicTimer timer(fCounters->fTimeWallUnzip, fCounters->fTimeCpuUnzip);
-      pageBuffer = UnsealPage({sealedPageBuffer, bytesOnStorage, pageInfo.fNElements}, *element);
-      fCounters->fSzUnzip.Add(elementSize * pageInfo.fNElements);
+      pageBuffer = UnsealPage(sealedPage, element);
+      fCounters->fSzUnzip.Add(elementSize * sealedPage.fNElements);
    }
-
-   const auto indexOffset = clusterDescriptor.GetColumnRange(columnId).fFirstElementIndex;
-   auto newPage = fPageAllocator->NewPage(columnId, pageBuffer.release(), elementSize, pageInfo.fNElements);
-   newPage.SetWindow(indexOffset + pageInfo.fFirstInPage, RPage::RClusterInfo(clusterId, indexOffset));
-   fPagePool->RegisterPage(newPage,
-      RPageDeleter([](const RPage &page, void * /*userData*/)
+   deleter = RPageDeleter([](const RPage &page, void * /*userData*/)
       {
          RPageAllocatorFile::DeletePage(page);
-      }, nullptr));
-   fCounters->fNPagePopulated.Inc();
-   return newPage;
+      }, nullptr);
+   return fPageAllocator->NewPage(columnId, pageBuffer.release(), elementSize, sealedPage.fNElements);
 }
 
 
@@ -366,9 +452,10 @@ void ROOT::Experimental::Detail::RPageSourceFile::ReleasePage(RPage &page)
 
 std::unique_ptr<ROOT::Experimental::Detail::RPageSource> ROOT::Experimental::Detail::RPageSourceFile::Clone() const
 {
-   auto clone = new RPageSourceFile(fNTupleName, fOptions);
+   auto clone = new RPageSourceFile(fNTupleName, fOptions, fPagePool);
    clone->fFile = fFile->Clone();
    clone->fReader = Internal::RMiniFileReader(clone->fFile.get());
+   clone->fMappedFile = fMappedFile;
    return std::unique_ptr<RPageSourceFile>(clone);
 }
 
@@ -376,6 +463,8 @@ std::unique_ptr<ROOT::Experimental::Detail::RCluster>
 ROOT::Experimental::Detail::RPageSourceFile::LoadCluster(DescriptorId_t clusterId, const ColumnSet_t &columns)
 {
    fCounters->fNClusterLoaded.Inc();
+   if (fMappedFile)
+      return LoadMappedCluster(clusterId, columns);
 
    const auto &clusterDesc = GetDescriptor().GetClusterDescriptor(clusterId);
 
@@ -499,6 +588,40 @@ ROOT::Experimental::Detail::RPageSourceFile::LoadCluster(DescriptorId_t clusterI
 }
 
 
+std::unique_ptr<ROOT::Experimental::Detail::RCluster>
+ROOT::Experimental::Detail::RPageSourceFile::LoadMappedCluster(DescriptorId_t clusterId, const ColumnSet_t &columns)
+{
+   const auto &clusterDesc = GetDescriptor().GetClusterDescriptor(clusterId);
+
+   // No data is read: the pages are faulted in by the operating system when they are unzipped or used in place
+   auto pageMap = std::make_unique<ROnDiskPageMapMmap>(fMappedFile);
+   std::size_t nPages = 0;
+   std::size_t szPayload = 0;
+   for (auto columnId : columns) {
+      const auto &pageRange = clusterDesc.GetPageRange(columnId);
+      NTupleSize_t pageNo = 0;
+      for (const auto &pageInfo : pageRange.fPageInfos) {
+         const auto &pageLocator = pageInfo.fLocator;
+         R__ASSERT(std::uint64_t(pageLocator.fPosition) + pageLocator.fBytesOnStorage <= fMappedFile->GetSize());
+         pageMap->Register(ROnDiskPage::Key(columnId, pageNo),
+                           ROnDiskPage(const_cast<unsigned char *>(fMappedFile->GetAddress(pageLocator.fPosition)),
+                                       pageLocator.fBytesOnStorage));
+         szPayload += pageLocator.fBytesOnStorage;
+         ++pageNo;
+      }
+      nPages += pageNo;
+   }
+   fCounters->fNPageLoaded.Add(nPages);
+   fCounters->fSzReadPayload.Add(szPayload);
+
+   auto cluster = std::make_unique<RCluster>(clusterId);
+   cluster->Adopt(std::move(pageMap));
+   for (auto colId : columns)
+      cluster->SetColumnAvailable(colId);
+   return cluster;
+}
+
+
 void ROOT::Experimental::Detail::RPageSourceFile::UnzipClusterImpl(RCluster *cluster)
 {
    RNTupleAtomicTimer timer(fCounters->fTimeWallUnzip, fCounters->fTimeCpuUnzip);
@@ -509,6 +632,20 @@ void ROOT::Experimental::Detail::RPageSourceFile::UnzipClusterImpl(RCluster *clu
 
    std::vector<std::unique_ptr<RColumnElementBase>> allElements;
 
+   // Small pages are unzipped in batches in order to amortize the task scheduling overhead
+   std::vector<std::function<void(void)>> batch;
+   std::size_t szBatch = 0;
+   auto fnScheduleBatch = [this, &batch, &szBatch]() {
+      if (batch.empty())
+         return;
+      fTaskScheduler->AddTask([pageTasks = std::move(batch)]() {
+         for (const auto &t : pageTasks)
+            t();
+      });
+      batch.clear();
+      szBatch = 0;
+   };
+
    const auto &columnsInCluster = cluster->GetAvailColumns();
    for (const auto columnId : columnsInCluster) {
       const auto &columnDesc = fDescriptor.GetColumnDescriptor(columnId);
@@ -529,24 +666,23 @@ void ROOT::Experimental::Detail::RPageSourceFile::UnzipClusterImpl(RCluster *clu
              nElements = pi.fNElements,
              indexOffset = clusterDescriptor.GetColumnRange(columnId).fFirstElementIndex
             ] () {
-               auto pageBuffer = UnsealPage({onDiskPage->GetAddress(), onDiskPage->GetSize(), nElements}, *element);
-               fCounters->fSzUnzip.Add(element->GetSize() * nElements);
-
-               auto newPage = fPageAllocator->NewPage(columnId, pageBuffer.release(), element->GetSize(), nElements);
+               RPageDeleter deleter;
+               auto newPage = CreatePage(columnId, {onDiskPage->GetAddress(), onDiskPage->GetSize(), nElements},
+                                         *element, deleter);
                newPage.SetWindow(indexOffset + firstInPage, RPage::RClusterInfo(clusterId, indexOffset));
-               fPagePool->PreloadPage(newPage,
-                  RPageDeleter([](const RPage &page, void * /*userData*/)
-                  {
-                     RPageAllocatorFile::DeletePage(page);
-                  }, nullptr));
+               fPagePool->PreloadPage(newPage, deleter);
             };
 
-         fTaskScheduler->AddTask(taskFunc);
+         batch.emplace_back(taskFunc);
+         szBatch += allElements.back()->GetSize() * pi.fNElements;
+         if (szBatch >= kMinUnzipTaskSize)
+            fnScheduleBatch();
 
          firstInPage += pi.fNElements;
          pageNo++;
       } // for all pages in column
    } // for all columns in cluster
+   fnScheduleBatch();
 
    fCounters->fNPagePopulated.Add(cluster->GetNOnDiskPages());
 
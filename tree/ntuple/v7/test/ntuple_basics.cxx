@@ -233,6 +233,95 @@ TEST(RNTuple, ClusterEntries)
    EXPECT_EQ(20, ntuple->GetDescriptor().GetNClusters());
 }
 
+TEST(RNTuple, ParallelWriter)
+{
+   FileRaii fileGuard("test_ntuple_parallel_writer.root");
+   auto model = RNTupleModel::Create();
+   model->MakeField<std::int32_t>("id");
+   model->MakeField<std::vector<float>>("jets");
+
+   constexpr int kNThreads = 4;
+   constexpr int kNEntriesPerThread = 1000;
+   {
+      auto writer = RNTupleParallelWriter::Recreate(std::move(model), "ntuple", fileGuard.GetPath());
+      std::vector<std::thread> threads;
+      for (int t = 0; t < kNThreads; ++t) {
+         threads.emplace_back([&writer, t]() {
+            auto context = writer->CreateFillContext();
+            auto entry = context->CreateEntry();
+            auto id = entry->Get<std::int32_t>("id");
+            auto jets = entry->Get<std::vector<float>>("jets");
+            for (int i = 0; i < kNEntriesPerThread; ++i) {
+               *id = t * kNEntriesPerThread + i;
+               jets->assign(i % 3, static_cast<float>(*id));
+               context->Fill(*entry);
+               if (i % 100 == 99)
+                  context->CommitCluster();
+            }
+         });
+      }
+      for (auto &t : threads)
+         t.join();
+   }
+
+   auto ntuple = RNTupleReader::Open("ntuple", fileGuard.GetPath());
+   EXPECT_EQ(NTupleSize_t(kNThreads * kNEntriesPerThread), ntuple->GetNEntries());
+   EXPECT_EQ(std::size_t(kNThreads * kNEntriesPerThread / 100), ntuple->GetDescriptor().GetNClusters());
+   auto viewId = ntuple->GetView<std::int32_t>("id");
+   auto viewJets = ntuple->GetView<std::vector<float>>("jets");
+   std::vector<bool> seen(kNThreads * kNEntriesPerThread, false);
+   for (auto i : ntuple->GetEntryRange()) {
+      auto id = viewId(i);
+      ASSERT_LT(id, kNThreads * kNEntriesPerThread);
+      EXPECT_FALSE(seen[id]);
+      seen[id] = true;
+      const auto &jets = viewJets(i);
+      EXPECT_EQ(std::size_t((id % kNEntriesPerThread) % 3), jets.size());
+      for (auto j : jets)
+         EXPECT_FLOAT_EQ(static_cast<float>(id), j);
+   }
+}
+
+TEST(RNTuple, ParallelWriterSequenced)
+{
+   FileRaii fileGuard("test_ntuple_parallel_writer_sequenced.root");
+   auto model = RNTupleModel::Create();
+   model->MakeField<std::int32_t>("id");
+
+   constexpr int kNThreads = 4;
+   constexpr int kNChunks = 20;
+   constexpr int kNEntriesPerChunk = 10;
+   {
+      auto writer = RNTupleParallelWriter::Recreate(std::move(model), "ntuple", fileGuard.GetPath());
+      std::vector<std::thread> threads;
+      for (int t = 0; t < kNThreads; ++t) {
+         threads.emplace_back([&writer, t]() {
+            auto context = writer->CreateFillContext();
+            context->SetAutoCommit(false);
+            auto entry = context->CreateEntry();
+            auto id = entry->Get<std::int32_t>("id");
+            // Chunks are distributed round-robin but committed in chunk order
+            for (int c = kNThreads - 1 - t; c < kNChunks; c += kNThreads) {
+               for (int i = 0; i < kNEntriesPerChunk; ++i) {
+                  *id = c * kNEntriesPerChunk + i;
+                  context->Fill(*entry);
+               }
+               context->CommitCluster(c);
+            }
+         });
+      }
+      for (auto &t : threads)
+         t.join();
+   }
+
+   auto ntuple = RNTupleReader::Open("ntuple", fileGuard.GetPath());
+   ASSERT_EQ(NTupleSize_t(kNChunks * kNEntriesPerChunk), ntuple->GetNEntries());
+   EXPECT_EQ(std::size_t(kNChunks), ntuple->GetDescriptor().GetNClusters());
+   auto viewId = ntuple->GetView<std::int32_t>("id");
+   for (auto i : ntuple->GetEntryRange())
+      EXPECT_EQ(static_cast<std::int32_t>(i), viewId(i));
+}
+
 TEST(RNTuple, PageSize)
 {
    FileRaii fileGuard("test_ntuple_elements_per_page.root");
@@ -57,7 +57,10 @@ public:
    std::vector<ROOT::Experimental::DescriptorId_t> fReqsClusterIds;
    std::vector<ROOT::Experimental::Detail::RPageSource::ColumnSet_t> fReqsColumns;
 
-   RPageSourceMock() : RPageSource("test", ROOT::Experimental::RNTupleReadOptions()) {
+   explicit RPageSourceMock(const ROOT::Experimental::RNTupleReadOptions &options =
+                               ROOT::Experimental::RNTupleReadOptions())
+      : RPageSource("test", options)
+   {
       ROOT::Experimental::RNTupleDescriptorBuilder descBuilder;
       descBuilder.AddCluster(0, RNTupleVersion(), 0, ClusterSize_t(1));
       descBuilder.AddCluster(1, RNTupleVersion(), 1, ClusterSize_t(1));
@@ -238,6 +241,43 @@ TEST(ClusterPool, Windows)
    EXPECT_EQ(12U, c16.GetWindowPost());
 }
 
+TEST(ClusterPool, AdaptiveWindow)
+{
+   RPageSourceMock psFixed;
+   RClusterPool cFixed(psFixed);
+   EXPECT_EQ(RClusterPool::EWindowPolicy::kFixed, cFixed.GetWindowPolicy());
+   EXPECT_EQ(3U, cFixed.GetWindowPost());
+   EXPECT_EQ(3U, cFixed.GetMaxWindowPost());
+
+   ROOT::Experimental::RNTupleReadOptions options;
+   options.SetClusterCache(ROOT::Experimental::RNTupleReadOptions::EClusterCache::kAdaptive);
+   RPageSourceMock psAdaptive(options);
+   RClusterPool cAdaptive(psAdaptive);
+   EXPECT_EQ(RClusterPool::EWindowPolicy::kAdaptive, cAdaptive.GetWindowPolicy());
+   EXPECT_EQ(4U, cAdaptive.GetWindowPre());
+   EXPECT_EQ(3U, cAdaptive.GetWindowPost());
+   EXPECT_EQ(12U, cAdaptive.GetMaxWindowPost());
+
+   cAdaptive.GetCluster(0, {0});
+   cAdaptive.GetCluster(1, {0});
+   EXPECT_GE(cAdaptive.GetWindowPost(), 1U);
+   EXPECT_LE(cAdaptive.GetWindowPost(), 12U);
+
+   // No samples yet
+   EXPECT_EQ(3U, RClusterPool::ComputeWindowPost(0, 0, 3, 12));
+   EXPECT_EQ(3U, RClusterPool::ComputeWindowPost(100, 0, 3, 12));
+   // Slow I/O grows the window by at most a factor of two
+   EXPECT_EQ(6U, RClusterPool::ComputeWindowPost(1000, 10, 3, 12));
+   EXPECT_EQ(12U, RClusterPool::ComputeWindowPost(1000, 10, 6, 12));
+   EXPECT_EQ(12U, RClusterPool::ComputeWindowPost(1000, 10, 12, 12));
+   EXPECT_EQ(5U, RClusterPool::ComputeWindowPost(40, 10, 3, 12));
+   // Fast I/O shrinks the window, one cluster at a time
+   EXPECT_EQ(11U, RClusterPool::ComputeWindowPost(10, 1000, 12, 12));
+   EXPECT_EQ(2U, RClusterPool::ComputeWindowPost(10, 1000, 3, 12));
+   EXPECT_EQ(2U, RClusterPool::ComputeWindowPost(10, 1000, 2, 12));
+   EXPECT_EQ(1U, RClusterPool::ComputeWindowPost(10, 1000, 1, 1));
+}
+
 TEST(ClusterPool, GetClusterBasics)
 {
    RPageSourceMock p1;
@@ -89,11 +89,15 @@ TEST(RNTuple, Descriptor)
    columnRange.fColumnId = 4;
    columnRange.fFirstElementIndex = 300;
    columnRange.fNElements = 3000;
+   columnRange.fValueRange.fMin = -1.5;
+   columnRange.fValueRange.fMax = 42.0;
+   columnRange.fValueRange.fIsValid = true;
    descBuilder.AddClusterColumnRange(1, columnRange);
    ROOT::Experimental::RClusterDescriptor::RPageRange pageRange3;
    pageRange3.fColumnId = 4;
    pageInfo.fNElements = 3000;
    pageInfo.fLocator.fPosition = 16384;
+   pageInfo.fValueRange = columnRange.fValueRange;
    pageRange3.fPageInfos.emplace_back(pageInfo);
    descBuilder.AddClusterPageRange(1, std::move(pageRange3));
 
@@ -127,6 +131,13 @@ TEST(RNTuple, Descriptor)
    reco.SetFromHeader(headerBuffer);
    reco.AddClustersFromFooter(footerBuffer);
    EXPECT_EQ(reference, reco.GetDescriptor());
+   EXPECT_FALSE(reco.GetDescriptor().GetClusterDescriptor(0).GetColumnRange(4).fValueRange.fIsValid);
+   const auto &valueRange = reco.GetDescriptor().GetClusterDescriptor(1).GetColumnRange(4).fValueRange;
+   EXPECT_TRUE(valueRange.fIsValid);
+   EXPECT_DOUBLE_EQ(-1.5, valueRange.fMin);
+   EXPECT_DOUBLE_EQ(42.0, valueRange.fMax);
+   EXPECT_TRUE(valueRange.Overlaps(42.0, 100.0));
+   EXPECT_FALSE(valueRange.Overlaps(-10.0, -2.0));
 
    EXPECT_EQ(NTupleSize_t(1100), reference.GetNEntries());
    EXPECT_EQ(NTupleSize_t(1100), reference.GetNElements(3));
@@ -0,0 +1,101 @@
+#include "ntuple_test.hxx"
+
+#include <ROOT/RNTupleIndex.hxx>
+#include <TROOT.h>
+
+using ROOT::Experimental::RNTupleIndex;
+
+namespace {
+
+void WriteEvents(const std::string &path)
+{
+   auto model = RNTupleModel::Create();
+   auto run = model->MakeField<std::uint32_t>("run");
+   auto event = model->MakeField<std::int64_t>("event");
+   auto pt = model->MakeField<float>("pt");
+   RNTupleWriteOptions options;
+   options.SetCompression(0);
+   auto ntuple = RNTupleWriter::Recreate(std::move(model), "events", path, options);
+   // Events in reverse order per run, in clusters of 100 entries; event 7 of run 2 appears twice
+   for (int i = 0; i < 1000; ++i) {
+      *run = 1 + i / 500;
+      *event = 499 - (i % 500);
+      *pt = i;
+      ntuple->Fill();
+      if (i % 100 == 99)
+         ntuple->CommitCluster();
+   }
+   *run = 2;
+   *event = 7;
+   *pt = 1000;
+   ntuple->Fill();
+}
+
+void CheckIndex(const RNTupleIndex &index)
+{
+   EXPECT_EQ(1001u, index.GetSize());
+   EXPECT_EQ(std::vector<std::string>({"run", "event"}), index.GetKeyFieldNames());
+
+   EXPECT_EQ(499u, index.GetEntryIndex({1, 0}));
+   EXPECT_EQ(0u, index.GetEntryIndex({1, 499}));
+   EXPECT_EQ(500u, index.GetEntryIndex({2, 499}));
+   EXPECT_EQ(ROOT::Experimental::kInvalidNTupleIndex, index.GetEntryIndex({3, 0}));
+   EXPECT_EQ(ROOT::Experimental::kInvalidNTupleIndex, index.GetEntryIndex({1, 500}));
+   EXPECT_EQ(std::vector<NTupleSize_t>({992, 1000}), index.GetAllEntryIndices({2, 7}));
+   EXPECT_TRUE(index.GetAllEntryIndices({2, 500}).empty());
+
+   EXPECT_EQ(std::vector<NTupleSize_t>({10, 489, 992, 1000}),
+             index.GetEntryIndices({{2, 7}, {1, 10}, {5, 5}, {1, 489}, {2, 7}}));
+
+   EXPECT_THROW(index.GetEntryIndex({1}), ROOT::Experimental::RException);
+}
+
+} // anonymous namespace
+
+TEST(RNTupleIndex, Build)
+{
+   FileRaii fileGuard("test_ntuple_index_build.root");
+   WriteEvents(fileGuard.GetPath());
+
+   auto ntuple = RNTupleReader::Open("events", fileGuard.GetPath());
+   auto index = RNTupleIndex::Build(*ntuple, {"run", "event"});
+   CheckIndex(*index);
+
+   auto viewPt = ntuple->GetView<float>("pt");
+   EXPECT_FLOAT_EQ(1000.f, viewPt(index->GetAllEntryIndices({2, 7}).back()));
+
+   EXPECT_THROW(RNTupleIndex::Build(*ntuple, {"run", "pt"}), ROOT::Experimental::RException);
+   EXPECT_THROW(RNTupleIndex::Build(*ntuple, {"lumi"}), ROOT::Experimental::RException);
+   EXPECT_THROW(RNTupleIndex::Build(*ntuple, {}), ROOT::Experimental::RException);
+}
+
+TEST(RNTupleIndex, WriteOpen)
+{
+   FileRaii fileGuard("test_ntuple_index_write.root");
+   WriteEvents(fileGuard.GetPath());
+
+   {
+      auto ntuple = RNTupleReader::Open("events", fileGuard.GetPath());
+      auto index = RNTupleIndex::Build(*ntuple, {"run", "event"});
+      auto file = std::unique_ptr<TFile>(TFile::Open(fileGuard.GetPath().c_str(), "UPDATE"));
+      index->Write("events", *file);
+   }
+
+   auto index = RNTupleIndex::Open("events", fileGuard.GetPath());
+   CheckIndex(*index);
+   EXPECT_THROW(RNTupleIndex::Open("tracks", fileGuard.GetPath()), ROOT::Experimental::RException);
+}
+
+#ifdef R__USE_IMT
+TEST(RNTupleIndex, BuildMT)
+{
+   FileRaii fileGuard("test_ntuple_index_build_mt.root");
+   WriteEvents(fileGuard.GetPath());
+
+   ROOT::EnableImplicitMT(4);
+   auto ntuple = RNTupleReader::Open("events", fileGuard.GetPath());
+   auto index = RNTupleIndex::Build(*ntuple, {"run", "event"});
+   ROOT::DisableImplicitMT();
+   CheckIndex(*index);
+}
+#endif
@@ -1,5 +1,7 @@
 #include "ntuple_test.hxx"
 
+#include <TFileMerger.h>
+
 namespace {
 
 // Reads an integer from a little-endian 4 byte buffer
@@ -15,6 +17,39 @@ std::int32_t ReadRawInt(const void *ptr)
 #endif
 }
 
+// Writes an ntuple of nClusters clusters of 100 entries, whose values start at firstValue
+void WriteNTuple(const std::string &path, int nClusters, float firstValue)
+{
+   auto model = RNTupleModel::Create();
+   auto wrPt = model->MakeField<float>("pt");
+   auto wrJets = model->MakeField<std::vector<float>>("jets");
+   auto ntuple = RNTupleWriter::Recreate(std::move(model), "myNTuple", path);
+   for (int i = 0; i < nClusters * 100; ++i) {
+      *wrPt = firstValue + i;
+      wrJets->assign(i % 4, firstValue - i);
+      ntuple->Fill();
+      if (i % 100 == 99)
+         ntuple->CommitCluster();
+   }
+}
+
+// Checks the content of the ntuple merged from the ntuple written by WriteNTuple(path, 2, 0) and
+// WriteNTuple(path, 3, 1000)
+void CheckMergedNTuple(const std::string &path)
+{
+   auto ntuple = RNTupleReader::Open("myNTuple", path);
+   ASSERT_EQ(500U, ntuple->GetNEntries());
+   EXPECT_EQ(5U, ntuple->GetDescriptor().GetNClusters());
+   auto viewPt = ntuple->GetView<float>("pt");
+   auto viewJets = ntuple->GetView<std::vector<float>>("jets");
+   for (auto i : ntuple->GetEntryRange()) {
+      const int n = (i < 200) ? i : i - 200;
+      const float firstValue = (i < 200) ? 0 : 1000;
+      EXPECT_FLOAT_EQ(firstValue + n, viewPt(i));
+      EXPECT_EQ(std::vector<float>(n % 4, firstValue - n), viewJets(i));
+   }
+}
+
 } // anonymous namespace
 
 TEST(RPageStorage, ReadSealedPages)
@@ -80,3 +115,82 @@ TEST(RFieldMerger, Merge)
    auto mergeResult = RFieldMerger::Merge(RFieldDescriptor(), RFieldDescriptor());
    EXPECT_FALSE(mergeResult);
 }
+
+
+TEST(RNTupleMerger, MergeSealedPages)
+{
+   FileRaii fileGuard1("test_ntuple_merge_in_1.root");
+   FileRaii fileGuard2("test_ntuple_merge_in_2.root");
+   FileRaii fileGuardOut("test_ntuple_merge_out.root");
+   WriteNTuple(fileGuard1.GetPath(), 2, 0);
+   WriteNTuple(fileGuard2.GetPath(), 3, 1000);
+
+   RPageSourceFile source1("myNTuple", fileGuard1.GetPath(), RNTupleReadOptions());
+   RPageSourceFile source2("myNTuple", fileGuard2.GetPath(), RNTupleReadOptions());
+   source1.Attach();
+   source2.Attach();
+   {
+      RPageSinkFile sink("myNTuple", fileGuardOut.GetPath(), RNTupleWriteOptions());
+      RNTupleMerger merger;
+      merger.Merge({&source1, &source2}, sink);
+   }
+   CheckMergedNTuple(fileGuardOut.GetPath());
+
+   // The pages are copied as they are
+   RPageSourceFile sourceOut("myNTuple", fileGuardOut.GetPath(), RNTupleReadOptions());
+   sourceOut.Attach();
+   const auto &descIn = source2.GetDescriptor();
+   const auto &descOut = sourceOut.GetDescriptor();
+   ASSERT_EQ(descIn.GetNColumns(), descOut.GetNColumns());
+   for (DescriptorId_t columnId = 0; columnId < descOut.GetNColumns(); ++columnId) {
+      const auto &pagesIn = descIn.GetClusterDescriptor(descIn.FindClusterId(0, 0)).GetPageRange(columnId);
+      const auto &pagesOut = descOut.GetClusterDescriptor(descOut.FindClusterId(0, 200)).GetPageRange(columnId);
+      ASSERT_EQ(pagesIn.fPageInfos.size(), pagesOut.fPageInfos.size());
+      for (std::size_t i = 0; i < pagesIn.fPageInfos.size(); ++i) {
+         EXPECT_EQ(pagesIn.fPageInfos[i].fNElements, pagesOut.fPageInfos[i].fNElements);
+         EXPECT_EQ(pagesIn.fPageInfos[i].fLocator.fBytesOnStorage, pagesOut.fPageInfos[i].fLocator.fBytesOnStorage);
+      }
+   }
+}
+
+TEST(RNTupleMerger, IncompatibleSources)
+{
+   FileRaii fileGuard1("test_ntuple_merge_incompatible_1.root");
+   FileRaii fileGuard2("test_ntuple_merge_incompatible_2.root");
+   FileRaii fileGuardOut("test_ntuple_merge_incompatible_out.root");
+   WriteNTuple(fileGuard1.GetPath(), 1, 0);
+   {
+      auto model = RNTupleModel::Create();
+      model->MakeField<double>("pt");
+      model->MakeField<std::vector<float>>("jets");
+      auto ntuple = RNTupleWriter::Recreate(std::move(model), "myNTuple", fileGuard2.GetPath());
+      ntuple->Fill();
+   }
+
+   RPageSourceFile source1("myNTuple", fileGuard1.GetPath(), RNTupleReadOptions());
+   RPageSourceFile source2("myNTuple", fileGuard2.GetPath(), RNTupleReadOptions());
+   source1.Attach();
+   source2.Attach();
+   RPageSinkFile sink("myNTuple", fileGuardOut.GetPath(), RNTupleWriteOptions());
+   RNTupleMerger merger;
+   EXPECT_THROW(merger.Merge({&source1, &source2}, sink), RException);
+}
+
+TEST(RNTupleMerger, FileMerger)
+{
+   FileRaii fileGuard1("test_ntuple_hadd_in_1.root");
+   FileRaii fileGuard2("test_ntuple_hadd_in_2.root");
+   FileRaii fileGuardOut("test_ntuple_hadd_out.root");
+   WriteNTuple(fileGuard1.GetPath(), 2, 0);
+   WriteNTuple(fileGuard2.GetPath(), 3, 1000);
+
+   {
+      TFileMerger merger(kFALSE, kFALSE);
+      merger.SetNotrees(kFALSE);
+      ASSERT_TRUE(merger.OutputFile(fileGuardOut.GetPath().c_str(), "RECREATE"));
+      ASSERT_TRUE(merger.AddFile(fileGuard1.GetPath().c_str()));
+      ASSERT_TRUE(merger.AddFile(fileGuard2.GetPath().c_str()));
+      EXPECT_TRUE(merger.Merge());
+   }
+   CheckMergedNTuple(fileGuardOut.GetPath());
+}
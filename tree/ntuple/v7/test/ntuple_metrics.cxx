@@ -112,3 +112,49 @@ TEST(Metrics, RNTupleWriter)
    // one page for the int field, one for the float field
    EXPECT_EQ(2, page_counter->GetValueAsInt());
 }
+
+TEST(Metrics, Registry)
+{
+   FileRaii fileGuard("test_ntuple_metrics_registry.root");
+   auto &registry = RNTupleMetricsRegistry::Instance();
+
+   auto fnGetValue = [&registry](const std::string &name) -> std::int64_t {
+      for (const auto &a : registry.GetAggregates()) {
+         if (a.fName == name)
+            return a.fValue;
+      }
+      return -1;
+   };
+   const std::string pagesCommitted = "RNTupleWriter.RPageSinkBuf.RPageSinkFile.nPageCommitted";
+   const auto nPagesBefore = std::max(std::int64_t(0), fnGetValue(pagesCommitted));
+
+   registry.Enable();
+   for (int i = 0; i < 2; ++i) {
+      auto model = RNTupleModel::Create();
+      auto wrInt = model->MakeField<int>("ints");
+      auto writer = RNTupleWriter::Recreate(std::move(model), "ntuple", fileGuard.GetPath());
+      EXPECT_TRUE(writer->GetMetrics().IsEnabled());
+      *wrInt = i;
+      writer->Fill();
+   }
+   // One page per writer, both writers are folded into the totals
+   EXPECT_EQ(nPagesBefore + 2, fnGetValue(pagesCommitted));
+
+   auto reader = RNTupleReader::Open("ntuple", fileGuard.GetPath());
+   EXPECT_TRUE(reader->GetMetrics().IsEnabled());
+   reader->LoadEntry(0);
+   EXPECT_GT(fnGetValue("RNTupleReader.RPageSourceFile.szReadPayload"), 0);
+   registry.Disable();
+
+   // Computed metrics are not aggregated, TFile counters are
+   EXPECT_EQ(-1, fnGetValue("RNTupleReader.RPageSourceFile.bwRead"));
+   EXPECT_GE(fnGetValue("TFile.bytesRead"), 0);
+
+   const auto json = registry.GetJSON();
+   EXPECT_NE(std::string::npos, json.find("\"" + pagesCommitted + "\": {\"unit\": \"\""));
+   const auto prometheus = registry.GetPrometheusText();
+   EXPECT_NE(std::string::npos,
+             prometheus.find("\nroot_RNTupleWriter_RPageSinkBuf_RPageSinkFile_nPageCommitted " +
+                             std::to_string(nPagesBefore + 2) + "\n"));
+   EXPECT_NE(std::string::npos, prometheus.find("# TYPE root_TFile_bytesRead untyped\n"));
+}
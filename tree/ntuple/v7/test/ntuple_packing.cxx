@@ -32,3 +32,30 @@ TEST(Packing, Bitfield)
       EXPECT_EQ(b9[i], e9[i]);
    }
 }
+
+TEST(Packing, BitfieldLarge)
+{
+   ROOT::Experimental::Detail::RColumnElement<bool, ROOT::Experimental::EColumnType::kBit> element(nullptr);
+
+   // Covers the word-wise kernels as well as the remainder handling
+   for (unsigned count = 0; count < 70; ++count) {
+      std::vector<unsigned char> packed((count + 7) / 8 + 1, 0);
+      std::unique_ptr<bool[]> b(new bool[count]);
+      std::unique_ptr<bool[]> e(new bool[count]);
+      for (unsigned i = 0; i < count; ++i) {
+         b[i] = (i % 3 == 0) || (i % 7 == 0);
+         e[i] = !b[i];
+      }
+      element.Pack(packed.data(), b.get(), count);
+      for (unsigned i = 0; i < count; ++i) {
+         EXPECT_EQ(b[i], bool((packed[i / 8] >> (i % 8)) & 1));
+      }
+      // Bytes beyond the packed size are untouched
+      EXPECT_EQ(0, packed[packed.size() - 1]);
+
+      element.Unpack(e.get(), packed.data(), count);
+      for (unsigned i = 0; i < count; ++i) {
+         EXPECT_EQ(b[i], e[i]);
+      }
+   }
+}
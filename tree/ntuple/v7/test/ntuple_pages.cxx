@@ -56,3 +56,142 @@ TEST(Pages, Pool)
    page = pool.GetPage(1, 55);
    EXPECT_TRUE(page.IsNull());
 }
+
+TEST(Pages, PoolMemoryBudget)
+{
+   std::vector<unsigned int> deleted;
+   std::array<std::int32_t, 10> buffer;
+   // Each page takes 40 bytes, the pool can keep two of them
+   RPagePool pool(80);
+   pool.GetMetrics().Enable();
+
+   auto fnRegister = [&](int columnId, bool preload) {
+      RPage page(columnId, buffer.data(), sizeof(std::int32_t), buffer.size());
+      page.GrowUnchecked(buffer.size());
+      page.SetWindow(0, RPage::RClusterInfo(0, 0));
+      RPageDeleter deleter([&deleted](const RPage &p, void * /*userData*/) { deleted.push_back(p.GetColumnId()); });
+      if (preload)
+         pool.PreloadPage(page, deleter);
+      else
+         pool.RegisterPage(page, deleter);
+      return page;
+   };
+
+   auto page0 = fnRegister(0, false);
+   auto page1 = fnRegister(1, false);
+   // Returned pages are kept
+   pool.ReturnPage(page0);
+   pool.ReturnPage(page1);
+   EXPECT_EQ(2u, pool.GetNPages());
+   EXPECT_TRUE(deleted.empty());
+
+   // Using page 0 makes page 1 the least recently used one
+   page0 = pool.GetPage(0, 0);
+   ASSERT_FALSE(page0.IsNull());
+   pool.ReturnPage(page0);
+   fnRegister(2, true);
+   ASSERT_EQ(1u, deleted.size());
+   EXPECT_EQ(1u, deleted[0]);
+   EXPECT_TRUE(pool.GetPage(1, 0).IsNull());
+
+   // Pages in use are not evicted, even if the budget is exceeded
+   page0 = pool.GetPage(0, 0);
+   auto page2 = pool.GetPage(2, 0);
+   auto page3 = fnRegister(3, false);
+   EXPECT_EQ(1u, deleted.size());
+   EXPECT_EQ(120u, pool.GetNBytes());
+   pool.ReturnPage(page2);
+   ASSERT_EQ(2u, deleted.size());
+   EXPECT_EQ(2u, deleted[1]);
+   EXPECT_EQ(80u, pool.GetNBytes());
+
+   const auto &metrics = pool.GetMetrics();
+   EXPECT_EQ(3, metrics.GetCounter("RPagePool.nHit")->GetValueAsInt());
+   EXPECT_EQ(3, metrics.GetCounter("RPagePool.nMiss")->GetValueAsInt());
+   EXPECT_EQ(2, metrics.GetCounter("RPagePool.nEvicted")->GetValueAsInt());
+   EXPECT_EQ(80, metrics.GetCounter("RPagePool.szPages")->GetValueAsInt());
+
+   pool.ReturnPage(page0);
+   pool.ReturnPage(page3);
+}
+
+TEST(Pages, PoolSharedByClones)
+{
+   FileRaii fileGuard("test_ntuple_page_pool_shared.root");
+   {
+      auto model = RNTupleModel::Create();
+      auto fldPt = model->MakeField<float>("pt");
+      auto ntuple = RNTupleWriter::Recreate(std::move(model), "ntpl", fileGuard.GetPath());
+      for (int i = 0; i < 100; ++i) {
+         *fldPt = i;
+         ntuple->Fill();
+      }
+   }
+
+   RNTupleReadOptions options;
+   options.SetClusterCache(RNTupleReadOptions::EClusterCache::kOff);
+   options.SetPagePoolMemoryBudget(1024 * 1024);
+   auto reader = RNTupleReader::Open("ntpl", fileGuard.GetPath(), options);
+   reader->EnableMetrics();
+   auto clone = reader->Clone();
+
+   auto viewPt = reader->GetView<float>("pt");
+   auto viewPtClone = clone->GetView<float>("pt");
+   for (auto i : reader->GetEntryRange()) {
+      EXPECT_FLOAT_EQ(i, viewPt(i));
+      EXPECT_FLOAT_EQ(i, viewPtClone(i));
+   }
+
+   // The page unzipped by the first reader is found by the clone
+   const auto &metrics = reader->GetMetrics();
+   EXPECT_EQ(1, metrics.GetCounter("RNTupleReader.RPageSourceFile.RPagePool.nMiss")->GetValueAsInt());
+   EXPECT_EQ(1, metrics.GetCounter("RNTupleReader.RPageSourceFile.RPagePool.nHit")->GetValueAsInt());
+}
+
+TEST(Pages, MemoryMap)
+{
+   for (int compression : {0, 505}) {
+      FileRaii fileGuard("test_ntuple_page_mmap.root");
+      {
+         auto model = RNTupleModel::Create();
+         auto fldByte = model->MakeField<std::uint8_t>("byte");
+         auto fldTag = model->MakeField<bool>("tag");
+         RNTupleWriteOptions writeOptions;
+         writeOptions.SetCompression(compression);
+         auto ntuple = RNTupleWriter::Recreate(std::move(model), "ntpl", fileGuard.GetPath(), writeOptions);
+         for (int i = 0; i < 1000; ++i) {
+            *fldByte = i % 256;
+            *fldTag = (i % 3 == 0);
+            ntuple->Fill();
+            if (i == 499)
+               ntuple->CommitCluster();
+         }
+      }
+
+      for (auto clusterCache : {RNTupleReadOptions::EClusterCache::kOff, RNTupleReadOptions::EClusterCache::kOn}) {
+         RNTupleReadOptions options;
+         options.SetClusterCache(clusterCache);
+         options.SetUseMemoryMap(true);
+         auto reader = RNTupleReader::Open("ntpl", fileGuard.GetPath(), options);
+         reader->EnableMetrics();
+         auto clone = reader->Clone();
+
+         auto viewByte = reader->GetView<std::uint8_t>("byte");
+         auto viewTag = reader->GetView<bool>("tag");
+         auto viewByteClone = clone->GetView<std::uint8_t>("byte");
+         for (auto i : reader->GetEntryRange()) {
+            EXPECT_EQ(i % 256, viewByte(i));
+            EXPECT_EQ(i % 3 == 0, viewTag(i));
+            EXPECT_EQ(i % 256, viewByteClone(i));
+         }
+
+         // Without compression, only the bit-packed booleans need to be unpacked; the bytes are used in place
+         const auto &metrics = reader->GetMetrics();
+         const auto szUnzip = metrics.GetCounter("RNTupleReader.RPageSourceFile.szUnzip")->GetValueAsInt();
+         if (compression == 0)
+            EXPECT_EQ(1000, szUnzip);
+         else
+            EXPECT_LT(1000, szUnzip);
+      }
+   }
+}
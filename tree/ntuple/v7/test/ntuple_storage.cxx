@@ -114,6 +114,49 @@ TEST(RNTuple, InvalidWriteOptions) {
    }
 }
 
+TEST(RNTuple, FieldCompression)
+{
+   RNTupleWriteOptions options;
+   options.SetCompression(404);
+   options.SetFieldCompression("jets", 0);
+   options.SetFieldCompression("jets._0", 207);
+   EXPECT_EQ(404, options.GetFieldCompression("pt"));
+   EXPECT_EQ(0, options.GetFieldCompression("jets"));
+   EXPECT_EQ(207, options.GetFieldCompression("jets._0"));
+   EXPECT_EQ(207, options.GetFieldCompression("jets._0.x"));
+
+   FileRaii fileGuard("test_ntuple_field_compression.root");
+   {
+      auto model = RNTupleModel::Create();
+      auto wrPt = model->MakeField<float>("pt");
+      auto wrJets = model->MakeField<std::vector<float>>("jets");
+      auto ntuple = RNTupleWriter::Recreate(std::move(model), "ntpl", fileGuard.GetPath(), options);
+      for (int i = 0; i < 100; ++i) {
+         *wrPt = i;
+         wrJets->assign(i % 5, float(i));
+         ntuple->Fill();
+      }
+   }
+
+   auto ntuple = RNTupleReader::Open("ntpl", fileGuard.GetPath());
+   const auto &desc = ntuple->GetDescriptor();
+   const auto &clusterDesc = desc.GetClusterDescriptor(desc.FindClusterId(0, 0));
+   auto fnCompression = [&](const std::string &fieldName) {
+      return clusterDesc.GetColumnRange(desc.FindColumnId(desc.FindFieldId(fieldName), 0)).fCompressionSettings;
+   };
+   EXPECT_EQ(404, fnCompression("pt"));
+   EXPECT_EQ(0, fnCompression("jets"));
+   EXPECT_EQ(207, clusterDesc.GetColumnRange(
+                     desc.FindColumnId(desc.FindFieldId("_0", desc.FindFieldId("jets")), 0)).fCompressionSettings);
+
+   auto viewPt = ntuple->GetView<float>("pt");
+   auto viewJets = ntuple->GetView<std::vector<float>>("jets");
+   for (auto i : ntuple->GetEntryRange()) {
+      EXPECT_FLOAT_EQ(i, viewPt(i));
+      EXPECT_EQ(std::vector<float>(i % 5, float(i)), viewJets(i));
+   }
+}
+
 TEST(RNTuple, PageFilling) {
    FileRaii fileGuard("test_ntuple_page_filling.root");
 
@@ -162,6 +205,112 @@ TEST(RNTuple, PageFilling) {
    EXPECT_EQ(1u, pr3.fPageInfos[1].fNElements);
 }
 
+TEST(RNTuple, PageValueRanges) {
+   FileRaii fileGuard("test_ntuple_page_value_ranges.root");
+
+   auto model = RNTupleModel::Create();
+   auto fldX = model->MakeField<std::int32_t>("x");
+   auto fldY = model->MakeField<float>("y");
+   auto fldTag = model->MakeField<std::string>("tag");
+
+   RNTupleWriteOptions options;
+   // Pages with 2 elements of x and y, i.e. 2 pages per cluster
+   options.SetApproxUnzippedPageSize(8);
+
+   {
+      auto ntuple = RNTupleWriter::Recreate(std::move(model), "ntpl", fileGuard.GetPath(), options);
+      for (std::int32_t i = 0; i < 8; ++i) {
+         *fldX = 10 - i;
+         *fldY = (i < 2) ? std::numeric_limits<float>::quiet_NaN() : i / 2.f;
+         *fldTag = std::to_string(i);
+         ntuple->Fill();
+         if (i == 3)
+            ntuple->CommitCluster();
+      }
+   }
+
+   auto ntuple = RNTupleReader::Open("ntpl", fileGuard.GetPath());
+   const auto &desc = ntuple->GetDescriptor();
+   ASSERT_EQ(2u, desc.GetNClusters());
+   const auto colX = desc.FindColumnId(desc.FindFieldId("x"), 0);
+   const auto colY = desc.FindColumnId(desc.FindFieldId("y"), 0);
+   const auto colTag = desc.FindColumnId(desc.FindFieldId("tag"), 0);
+
+   const auto &cd1 = desc.GetClusterDescriptor(desc.FindClusterId(colX, 0));
+   const auto &cd2 = desc.GetClusterDescriptor(desc.FindNextClusterId(cd1.GetId()));
+   EXPECT_TRUE(cd1.GetColumnRange(colX).fValueRange.fIsValid);
+   EXPECT_DOUBLE_EQ(7.0, cd1.GetColumnRange(colX).fValueRange.fMin);
+   EXPECT_DOUBLE_EQ(10.0, cd1.GetColumnRange(colX).fValueRange.fMax);
+   EXPECT_DOUBLE_EQ(3.0, cd2.GetColumnRange(colX).fValueRange.fMin);
+   EXPECT_DOUBLE_EQ(6.0, cd2.GetColumnRange(colX).fValueRange.fMax);
+
+   const auto &pr = cd2.GetPageRange(colX);
+   ASSERT_EQ(2u, pr.fPageInfos.size());
+   EXPECT_DOUBLE_EQ(5.0, pr.fPageInfos[0].fValueRange.fMin);
+   EXPECT_DOUBLE_EQ(6.0, pr.fPageInfos[0].fValueRange.fMax);
+   EXPECT_DOUBLE_EQ(3.0, pr.fPageInfos[1].fValueRange.fMin);
+   EXPECT_DOUBLE_EQ(4.0, pr.fPageInfos[1].fValueRange.fMax);
+
+   // The first page of y only has NaNs; the cluster's value range is unknown
+   const auto &prY = cd1.GetPageRange(colY);
+   ASSERT_EQ(2u, prY.fPageInfos.size());
+   EXPECT_FALSE(prY.fPageInfos[0].fValueRange.fIsValid);
+   EXPECT_TRUE(prY.fPageInfos[1].fValueRange.fIsValid);
+   EXPECT_DOUBLE_EQ(1.0, prY.fPageInfos[1].fValueRange.fMin);
+   EXPECT_DOUBLE_EQ(1.5, prY.fPageInfos[1].fValueRange.fMax);
+   EXPECT_FALSE(cd1.GetColumnRange(colY).fValueRange.fIsValid);
+   EXPECT_TRUE(cd2.GetColumnRange(colY).fValueRange.fIsValid);
+
+   // Index columns have no value ranges
+   EXPECT_FALSE(cd1.GetColumnRange(colTag).fValueRange.fIsValid);
+}
+
+TEST(RNTuple, AdaptivePageSize) {
+   FileRaii fileGuard("test_ntuple_adaptive_page_size.root");
+
+   auto model = RNTupleModel::Create();
+   auto fldConst = model->MakeField<std::int32_t>("const");
+   auto fldRandom = model->MakeField<std::uint32_t>("random");
+
+   RNTupleWriteOptions options;
+   options.SetApproxUnzippedPageSize(4096);
+   options.SetApproxZippedPageSize(4096);
+
+   const unsigned int nClusters = 5;
+   const unsigned int nEntriesPerCluster = 100000;
+   {
+      auto ntuple = RNTupleWriter::Recreate(std::move(model), "ntpl", fileGuard.GetPath(), options);
+      std::uint32_t seed = 42;
+      for (unsigned int i = 0; i < nClusters * nEntriesPerCluster; ++i) {
+         *fldConst = 1;
+         seed = seed * 1664525u + 1013904223u;
+         *fldRandom = seed;
+         ntuple->Fill();
+         if ((i + 1) % nEntriesPerCluster == 0)
+            ntuple->CommitCluster();
+      }
+   }
+
+   auto ntuple = RNTupleReader::Open("ntpl", fileGuard.GetPath());
+   const auto &desc = ntuple->GetDescriptor();
+   ASSERT_EQ(nClusters, desc.GetNClusters());
+   const auto colConst = desc.FindColumnId(desc.FindFieldId("const"), 0);
+   const auto colRandom = desc.FindColumnId(desc.FindFieldId("random"), 0);
+
+   // The first cluster is written with the unzipped page size
+   const auto &cdFirst = desc.GetClusterDescriptor(0);
+   EXPECT_EQ(1024u, cdFirst.GetPageRange(colConst).fPageInfos[0].fNElements);
+   EXPECT_EQ(1024u, cdFirst.GetPageRange(colRandom).fPageInfos[0].fNElements);
+
+   // In the last cluster, the well compressible column uses the largest allowed pages whereas the compressed pages
+   // of the incompressible column are close to the target size
+   const auto &cdLast = desc.GetClusterDescriptor(nClusters - 1);
+   EXPECT_EQ(16u * 1024u, cdLast.GetPageRange(colConst).fPageInfos[0].fNElements);
+   const auto &pageRandom = cdLast.GetPageRange(colRandom).fPageInfos[0];
+   EXPECT_GT(pageRandom.fLocator.fBytesOnStorage, 4096u * 9 / 10);
+   EXPECT_LT(pageRandom.fLocator.fBytesOnStorage, 4096u * 11 / 10);
+}
+
 TEST(RNTuple, PageFillingString) {
    FileRaii fileGuard("test_ntuple_page_filling_string.root");
 
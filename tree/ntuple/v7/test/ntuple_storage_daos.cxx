@@ -1,4 +1,5 @@
 #include "ntuple_test.hxx"
+#include <ROOT/RCluster.hxx>
 #include <ROOT/RPageStorageDaos.hxx>
 
 TEST(RPageStorageDaos, Basics)
@@ -103,3 +104,43 @@ TEST(RPageStorageDaos, Options)
    EXPECT_STREQ("RP_XSF", source.GetObjectClass().c_str());
    EXPECT_EQ(1U, source.GetNEntries());
 }
+
+TEST(RPageStorageDaos, LoadClusters)
+{
+   std::string daosUri("daos://" R__DAOS_TEST_POOL ":1/a947484e-e3bc-48cb-8f71-3292c19b59a4");
+
+   auto model = RNTupleModel::Create();
+   auto wrPt = model->MakeField<float>("pt");
+   {
+      auto ntuple = RNTupleWriter::Recreate(std::move(model), "ntuple", daosUri, RNTupleWriteOptions());
+      for (int i = 0; i < 30; ++i) {
+         *wrPt = i;
+         ntuple->Fill();
+         if (i % 10 == 9)
+            ntuple->CommitCluster();
+      }
+   }
+
+   ROOT::Experimental::Detail::RPageSourceDaos source("ntuple", daosUri, RNTupleReadOptions());
+   source.Attach();
+   const auto &desc = source.GetDescriptor();
+   ASSERT_EQ(3U, desc.GetNClusters());
+   auto columnId = desc.FindColumnId(desc.FindFieldId("pt"), 0);
+
+   std::vector<RPageSource::RClusterKey> keys;
+   for (NTupleSize_t entry : {20, 0})
+      keys.emplace_back(RPageSource::RClusterKey{desc.FindClusterId(columnId, entry), {columnId}});
+   auto clusters = source.LoadClusters(keys);
+   ASSERT_EQ(2U, clusters.size());
+   for (std::size_t i = 0; i < keys.size(); ++i) {
+      EXPECT_EQ(keys[i].fClusterId, clusters[i]->GetId());
+      EXPECT_TRUE(clusters[i]->ContainsColumn(columnId));
+      const auto &pageRange = desc.GetClusterDescriptor(keys[i].fClusterId).GetPageRange(columnId);
+      EXPECT_EQ(pageRange.fPageInfos.size(), clusters[i]->GetNOnDiskPages());
+   }
+
+   auto ntuple = RNTupleReader::Open("ntuple", daosUri);
+   auto viewPt = ntuple->GetView<float>("pt");
+   for (auto i : ntuple->GetEntryRange())
+      EXPECT_FLOAT_EQ(static_cast<float>(i), viewPt(i));
+}
@@ -40,6 +40,7 @@
 #include <cstdio>
 #include <exception>
 #include <iterator>
+#include <limits>
 #include <memory>
 #include <sstream>
 #include <string>
@@ -81,8 +82,11 @@ using RNTupleReadOptions = ROOT::Experimental::RNTupleReadOptions;
 using RNTupleWriter = ROOT::Experimental::RNTupleWriter;
 using RNTupleWriteOptions = ROOT::Experimental::RNTupleWriteOptions;
 using RNTupleWriteOptionsDaos = ROOT::Experimental::RNTupleWriteOptionsDaos;
+using RNTupleMerger = ROOT::Experimental::RNTupleMerger;
 using RNTupleMetrics = ROOT::Experimental::Detail::RNTupleMetrics;
+using RNTupleMetricsRegistry = ROOT::Experimental::Detail::RNTupleMetricsRegistry;
 using RNTupleModel = ROOT::Experimental::RNTupleModel;
+using RNTupleParallelWriter = ROOT::Experimental::RNTupleParallelWriter;
 using RNTuplePlainCounter = ROOT::Experimental::Detail::RNTuplePlainCounter;
 using RNTuplePlainTimer = ROOT::Experimental::Detail::RNTuplePlainTimer;
 using RNTupleVersion = ROOT::Experimental::RNTupleVersion;
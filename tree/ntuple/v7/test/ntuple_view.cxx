@@ -93,6 +93,45 @@ TEST(RNTuple, BulkView)
    }
 }
 
+TEST(RNTuple, BulkViewSpan)
+{
+   FileRaii fileGuard("test_ntuple_bulk_view_span.root");
+
+   auto model = RNTupleModel::Create();
+   auto fieldPt = model->MakeField<float>("pt");
+   auto eltsPerPage = 10'000;
+   {
+      RNTupleWriteOptions opt;
+      opt.SetApproxUnzippedPageSize(eltsPerPage * sizeof(float));
+      auto ntuple = RNTupleWriter::Recreate(std::move(model), "myNTuple", fileGuard.GetPath(), opt);
+      for (int i = 0; i < 100'000; i++) {
+         *fieldPt = i;
+         ntuple->Fill();
+      }
+   }
+   auto ntuple = RNTupleReader::Open("myNTuple", fileGuard.GetPath());
+   auto viewPt = ntuple->GetView<float>("pt");
+
+   // Iterate page by page over the entire field
+   NTupleSize_t nEntries = 0;
+   unsigned int nPages = 0;
+   while (nEntries < ntuple->GetNEntries()) {
+      auto span = viewPt.MapSpan(nEntries);
+      ASSERT_EQ(static_cast<std::size_t>(eltsPerPage), span.size());
+      for (std::size_t i = 0; i < span.size(); ++i) {
+         ASSERT_EQ(static_cast<float>(nEntries + i), span[i]);
+      }
+      nEntries += span.size();
+      nPages++;
+   }
+   EXPECT_EQ(100'000U, nEntries);
+   EXPECT_EQ(10U, nPages);
+
+   auto span = viewPt.MapSpan(eltsPerPage + 3);
+   EXPECT_EQ(static_cast<std::size_t>(eltsPerPage - 3), span.size());
+   EXPECT_EQ(static_cast<float>(eltsPerPage + 3), span[0]);
+}
+
 TEST(RNTuple, BulkViewCollection)
 {
    FileRaii fileGuard("test_ntuple_bulk_view_collection.root");
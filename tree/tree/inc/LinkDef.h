@@ -56,6 +56,8 @@
 #pragma link C++ class TTreeCloner+;
 #pragma link C++ class TTreeCache+;
 #pragma link C++ class TTreeCacheUnzip+;
+#pragma link C++ class TTreeBranchPerfStats+;
+#pragma link C++ struct TTreeBranchPerfStats::BranchInfo+;
 #pragma link C++ class TVirtualTreePlayer;
 #pragma link C++ class TVirtualIndex+;
 #pragma link C++ class TTreeResult+;
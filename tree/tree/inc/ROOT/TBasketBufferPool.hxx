@@ -0,0 +1,76 @@
+// @(#)root/tree:$Id$
+
+/*************************************************************************
+ * Copyright (C) 1995-2021, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#ifndef ROOT_TBasketBufferPool
+#define ROOT_TBasketBufferPool
+
+#include "RtypesCore.h"
+
+#include <mutex>
+#include <utility>
+#include <vector>
+
+namespace ROOT {
+namespace Internal {
+
+/** \class ROOT::Internal::TBasketBufferPool
+ A pool of the memory buffers of the baskets read from the trees, see TTree::SetBasketBufferPoolSize.
+
+ The buffers returned to the pool are kept, up to a maximum total size, and handed out again instead
+ of allocating new ones. They are sorted in size classes, powers of two, by the number of bytes they
+ are known to hold. A request is served by a buffer of its class known to be large enough, or by any
+ buffer of the next class. The buffers are allocated with `new char[]`: a buffer taken from the pool
+ can be given to a TBuffer that owns it, and a buffer owned by a TBuffer can be returned to the pool.
+ The pool can be used from several threads.
+*/
+
+class TBasketBufferPool {
+public:
+   struct Stats {
+      ULong64_t fNAcquired{0}; ///< Number of buffers requested
+      ULong64_t fNReused{0};   ///< Number of requests served by a buffer of the pool
+      ULong64_t fNReleased{0}; ///< Number of buffers returned to the pool
+      ULong64_t fNDeleted{0};  ///< Number of buffers returned and deleted, being too small or over the maximum size
+      Long64_t fBytes{0};      ///< Number of bytes held by the pool
+      Long64_t fPeakBytes{0};  ///< Maximum number of bytes held by the pool
+   };
+
+private:
+   static constexpr Int_t kMinClass = 10; ///< Buffers smaller than 1 kB are not kept
+   static constexpr Int_t kNClasses = 22; ///< Up to 2 GB
+
+   using Buffer_t = std::pair<char *, Int_t>; ///< Buffer and the number of bytes it can hold
+
+   Long64_t fMaxBytes;
+   std::vector<Buffer_t> fFree[kNClasses];
+   Stats fStats;
+   mutable std::mutex fMutex;
+
+   static Int_t FloorClass(Int_t size);
+
+public:
+   explicit TBasketBufferPool(Long64_t maxBytes) : fMaxBytes(maxBytes) {}
+   ~TBasketBufferPool() { Clear(); }
+   TBasketBufferPool(const TBasketBufferPool &) = delete;
+   TBasketBufferPool &operator=(const TBasketBufferPool &) = delete;
+
+   char *Acquire(Int_t size, Int_t &capacity);
+   void Release(char *buffer, Int_t capacity);
+   void Clear();
+
+   Long64_t GetMaxBytes() const { return fMaxBytes; }
+   void SetMaxBytes(Long64_t maxBytes);
+   Stats GetStats() const;
+};
+
+} // namespace Internal
+} // namespace ROOT
+
+#endif
@@ -54,6 +54,13 @@ private:
    // Returns true if the underlying TLeaf can regenerate the entry offsets for us.
    Bool_t CanGenerateOffsetArray();
 
+   // Returns the element size used to byte-split the payload, or 0 if it is not byte-split.
+   Int_t GetByteSplitElementSize() const;
+
+   // The two halves of WriteBuffer(): compress the payload, then create and write the key in the file.
+   Int_t CompressWriteBuffer(TFile *file);
+   Int_t CommitWriteBuffer(TFile *file, Int_t nout);
+
    // Manage buffer ownership.
    void   DisownBuffer();
    void   AdoptBuffer(TBuffer *user_buffer);
@@ -75,6 +82,7 @@ protected:
    Int_t       fLastWriteBufferSize[3] = {0,0,0}; ///<! Size of the buffer last three buffers we wrote it to disk
    Bool_t      fResetAllocation{false};           ///<! True if last reset re-allocated the memory
    UChar_t     fNextBufferSizeRecord{0};          ///<! Index into fLastWriteBufferSize of the last buffer written to disk
+   Int_t       fWriteCycle{-1};                   ///<! Cycle used by WriteBuffer() if >= 0, set when the basket is written in the background
 #ifdef R__TRACK_BASKET_ALLOC_TIME
    ULong64_t   fResetAllocationTime{0};           ///<! Time spent reallocating baskets in microseconds during last Reset operation.
 #endif
@@ -95,11 +103,12 @@ public:
    // in the fIOBits -- then the zombie flag will be set for this object.
    //
    enum class EIOBits : Char_t {
-      // The following to bits are reserved for now; when supported, set
-      // kSupported = kGenerateOffsetMap | kBasketClassMap
+      // The following bit is reserved for now; when supported, set
+      // kSupported = kGenerateOffsetMap | kByteSplit | kBasketClassMap
       kGenerateOffsetMap = BIT(0),
-      // kBasketClassMap = BIT(1),
-      kSupported = kGenerateOffsetMap
+      kByteSplit = BIT(1),
+      // kBasketClassMap = BIT(2),
+      kSupported = kGenerateOffsetMap | kByteSplit
    };
    // This enum covers IOBits that are known to this ROOT release but
    // not supported; provides a mechanism for us to have experimental
@@ -108,7 +117,7 @@ public:
    // (kUnsupported | kSupported) should result in the '|' of all IOBits.
    enum class EUnsupportedIOBits : Char_t { kUnsupported = 0 };
    // The number of known, defined IOBits.
-   static constexpr int kIOBitCount = 1;
+   static constexpr int kIOBitCount = 2;
 
    TBasket();
    TBasket(TDirectory *motherDir);
@@ -50,6 +50,8 @@ class TBulkBranchRead;
 }
 namespace Internal {
 class TBranchIMTHelper; ///< A helper class for managing IMT work during TTree:Fill operations.
+class TBasketWriteQueue; ///< A queue of baskets written in the background during TTree:Fill operations.
+class TBasketBufferPool; ///< A pool of the memory buffers of the baskets read from a TTree.
 }
 }
 
@@ -182,6 +184,8 @@ private:
    Int_t    GetEntriesSerialized(Long64_t, TBuffer&, TBuffer*);
    Int_t    FillEntryBuffer(TBasket* basket,TBuffer* buf, Int_t& lnew);
    Int_t    WriteBasketImpl(TBasket* basket, Int_t where, ROOT::Internal::TBranchIMTHelper *);
+   Int_t    WriteBasketAsync(TBasket* basket, Int_t where, ROOT::Internal::TBasketWriteQueue &);
+   void     UpdateEntryOffsetLen(Int_t nevbuf);
    TBranch(const TBranch&) = delete;             // not implemented
    TBranch& operator=(const TBranch&) = delete;  // not implemented
 
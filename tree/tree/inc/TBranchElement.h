@@ -36,6 +36,9 @@ class TVirtualArray;
 
 #include "TStreamerInfoActions.h"
 
+#include <string>
+#include <vector>
+
 class TBranchElement : public TBranch {
 
 // Friends
@@ -98,6 +101,7 @@ protected:
    TStreamerInfoActions::TIDs fNewIDs; ///<! Nested List of the serial number of all the StreamerInfo to be used.
    TStreamerInfoActions::TActionSequence *fReadActionSequence;  ///<! Set of actions to be executed to extract the data from the basket.
    TStreamerInfoActions::TActionSequence *fFillActionSequence;  ///<! Set of actions to be executed to write the data to the basket.
+   std::vector<std::string>               fReadMembers;     ///<! Data members read by an unsplit object branch (all of them if empty), see SetReadMembers.
    TVirtualCollectionIterators           *fIterators;      ///<! holds the iterators when the branch is of fType==4.
    TVirtualCollectionIterators           *fWriteIterators; ///<! holds the read (non-staging) iterators when the branch is of fType==4 and associative containers.
    TVirtualCollectionPtrIterators        *fPtrIterators;   ///<! holds the iterators when the branch is of fType==4 and it is a split collection of pointers.
@@ -229,6 +233,7 @@ public:
    virtual void             SetMissing();
    inline  void             SetParentClass(TClass* clparent);
    virtual void             SetParentName(const char* name) { fParentName = name; }
+           void             SetReadMembers(const std::vector<std::string> &members);
    virtual void             SetTargetClass(const char *name);
    virtual void             SetupAddresses();
    virtual void             SetType(Int_t btype) { fType = btype; }
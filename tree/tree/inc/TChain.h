@@ -23,6 +23,8 @@
 
 #include "TTree.h"
 
+#include <memory>
+
 class TFile;
 class TBrowser;
 class TCut;
@@ -30,6 +32,12 @@ class TEntryList;
 class TEventList;
 class TCollection;
 
+namespace ROOT {
+namespace Internal {
+class TChainPrefetch;
+}
+}
+
 class TChain : public TTree {
 
 protected:
@@ -43,6 +51,8 @@ protected:
    TObjArray   *fFiles;            ///< -> List of file names containing the trees (TChainElement, owned)
    TList       *fStatus;           ///< -> List of active/inactive branches (TChainElement, owned)
    TChain      *fProofChain;       ///<! chain proxy when going to be processed by PROOF
+   Int_t        fPrefetchFiles{0}; ///<! Number of files opened in the background ahead of the current one
+   std::unique_ptr<ROOT::Internal::TChainPrefetch> fPrefetch; ///<! Files being opened in the background
 
 private:
    TChain(const TChain&);            // not implemented
@@ -93,6 +103,7 @@ public:
    virtual Long64_t  GetChainEntryNumber(Long64_t entry) const;
    virtual TClusterIterator GetClusterIterator(Long64_t firstentry);
            Int_t     GetNtrees() const { return fNtrees; }
+           Int_t     GetPrefetchFiles() const { return fPrefetchFiles; }
    virtual Long64_t  GetEntries() const;
    virtual Long64_t  GetEntries(const char *sel) { return TTree::GetEntries(sel); }
    virtual Int_t     GetEntry(Long64_t entry=0, Int_t getall=0);
@@ -153,6 +164,7 @@ public:
    }
 #endif
 
+   virtual void      SetBasketBufferPoolSize(Long64_t maxBytes = 64000000);
    virtual void      SetBranchStatus(const char *bname, Bool_t status=1, UInt_t *found=0);
    virtual Int_t     SetCacheSize(Long64_t cacheSize = -1);
    virtual void      SetDirectory(TDirectory *dir);
@@ -162,6 +174,7 @@ public:
    virtual void      SetMakeClass(Int_t make) { TTree::SetMakeClass(make); if (fTree) fTree->SetMakeClass(make);}
    virtual void      SetName(const char *name);
    virtual void      SetPacketSize(Int_t size = 100);
+           void      SetPrefetchFiles(Int_t nfiles);
    virtual void      SetProof(Bool_t on = kTRUE, Bool_t refresh = kFALSE, Bool_t gettreeheader = kFALSE);
    virtual void      SetWeight(Double_t w=1, Option_t *option="");
    virtual void      UseCache(Int_t maxCacheSize = 10, Int_t pageSize = 0);
@@ -50,6 +50,7 @@ class TList;
 
 #include <array>
 #include <atomic>
+#include <memory>
 #include <vector>
 #include <utility>
 
@@ -147,6 +148,7 @@ protected:
    mutable std::atomic<ULong64_t> fAllocationTime{0}; ///<! Time spent reallocating basket memory buffers, in microseconds.
 #endif
    mutable std::atomic<UInt_t> fAllocationCount{0};   ///<! Number of reallocations basket memory buffers.
+   std::shared_ptr<ROOT::Internal::TBasketBufferPool> fBasketBufferPool; ///<! Pool of the buffers of the baskets read, see SetBasketBufferPoolSize()
 
    static Int_t     fgBranchStyle;        ///<  Old/New branch style
    static Long64_t  fgMaxTreeSize;        ///<  Maximum size of a file containing a Tree
@@ -156,10 +158,12 @@ private:
    mutable Bool_t fIMTFlush{false};               ///<! True if we are doing a multithreaded flush.
    mutable std::atomic<Long64_t> fIMTTotBytes;    ///<! Total bytes for the IMT flush baskets
    mutable std::atomic<Long64_t> fIMTZipBytes;    ///<! Zip bytes for the IMT flush baskets.
+   ROOT::Internal::TBasketWriteQueue *fBasketWriteQueue{nullptr}; ///<! Baskets written in the background, see SetMaxPendingBaskets()
 
    void             InitializeBranchLists(bool checkLeafCount);
    void             SortBranchesByTime();
    Int_t            FlushBasketsImpl() const;
+   Int_t            WaitPendingBaskets() const;
    void             MarkEventCluster();
    Long64_t         GetMedianClusterSize();
 
@@ -203,6 +207,7 @@ protected:
    friend class TChainIndex;
    // So that the TTreeCloner can access the protected interfaces
    friend class TTreeCloner;
+   friend class TBranch;
 
    // use to update fFriendLockStatus
    enum ELockStatusBits {
@@ -443,6 +448,7 @@ public:
    virtual Long64_t        GetAutoFlush() const {return fAutoFlush;}
    virtual Long64_t        GetAutoSave()  const {return fAutoSave;}
    virtual TBranch        *GetBranch(const char* name);
+           ROOT::Internal::TBasketBufferPool *GetBasketBufferPool() const { return fBasketBufferPool.get(); }
    virtual TBranchRef     *GetBranchRef() const { return fBranchRef; };
    virtual Bool_t          GetBranchStatus(const char* branchname) const;
    static  Int_t           GetBranchStyle();
@@ -492,6 +498,7 @@ public:
 
    virtual Long64_t        GetMaxEntryLoop() const { return fMaxEntryLoop; }
    virtual Double_t        GetMaximum(const char* columname);
+           Int_t           GetMaxPendingBaskets() const;
    static  Long64_t        GetMaxTreeSize();
    virtual Long64_t        GetMaxVirtualSize() const { return fMaxVirtualSize; }
    virtual Double_t        GetMinimum(const char* columname);
@@ -577,6 +584,8 @@ public:
    virtual Bool_t          SetAlias(const char* aliasName, const char* aliasFormula);
    virtual void            SetAutoSave(Long64_t autos = -300000000);
    virtual void            SetAutoFlush(Long64_t autof = -30000000);
+           void            SetBasketBufferPool(const std::shared_ptr<ROOT::Internal::TBasketBufferPool> &pool) { fBasketBufferPool = pool; }
+   virtual void            SetBasketBufferPoolSize(Long64_t maxBytes = 64000000);
    virtual void            SetBasketSize(const char* bname, Int_t buffsize = 16000);
    virtual Int_t           SetBranchAddress(const char *bname,void *add, TBranch **ptr = 0);
    virtual Int_t           SetBranchAddress(const char *bname,void *add, TClass *realClass, EDataType datatype, Bool_t isptr);
@@ -617,6 +626,7 @@ public:
    virtual void            SetImplicitMT(Bool_t enabled) { fIMTEnabled = enabled; }
    virtual void            SetMakeClass(Int_t make);
    virtual void            SetMaxEntryLoop(Long64_t maxev = kMaxEntries) { fMaxEntryLoop = maxev; } // *MENU*
+           void            SetMaxPendingBaskets(Int_t maxPending = 16);
    static  void            SetMaxTreeSize(Long64_t maxsize = 100000000000LL);
    virtual void            SetMaxVirtualSize(Long64_t size = 0) { fMaxVirtualSize = size; } // *MENU*
    virtual void            SetName(const char* name); // *MENU*
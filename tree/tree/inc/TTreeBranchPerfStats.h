@@ -0,0 +1,96 @@
+// @(#)root/tree:$Id$
+
+/*************************************************************************
+ * Copyright (C) 1995-2021, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#ifndef ROOT_TTreeBranchPerfStats
+#define ROOT_TTreeBranchPerfStats
+
+//////////////////////////////////////////////////////////////////////////
+//                                                                      //
+// TTreeBranchPerfStats                                                 //
+//                                                                      //
+// Per-branch decompression and deserialization times, basket sizes     //
+// and TTreeCache efficiency of all the TTrees read while started.      //
+//                                                                      //
+//////////////////////////////////////////////////////////////////////////
+
+#include "TNamed.h"
+
+#include <atomic>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+class TBranch;
+
+class TTreeBranchPerfStats : public TNamed {
+public:
+   /// What the branches cost, summed over all the threads and the trees with a branch of that name
+   struct BranchInfo {
+      Long64_t fBaskets = 0;           ///< Number of baskets read
+      Long64_t fBytesCompressed = 0;   ///< Bytes of the baskets on file
+      Long64_t fBytesUncompressed = 0; ///< Bytes of the baskets in memory
+      Long64_t fEntries = 0;           ///< Number of entries deserialized
+      Double_t fReadTime = 0;          ///< Seconds spent getting the baskets from the TTreeCache or the file
+      Double_t fUnzipTime = 0;         ///< Seconds spent decompressing the baskets in the reading thread
+      Double_t fStreamerTime = 0;      ///< Seconds spent deserializing the entries
+      Long64_t fCacheHits = 0;         ///< Number of baskets found in the TTreeCache
+      Long64_t fCacheMisses = 0;       ///< Number of baskets read from the file although a TTreeCache was set
+      Double_t fCacheMissTime = 0;     ///< Seconds spent reading the baskets missed by the TTreeCache
+
+      BranchInfo &operator+=(const BranchInfo &other);
+      Double_t GetTotalTime() const { return fReadTime + fUnzipTime + fStreamerTime; }
+   };
+
+   enum ECacheStatus { kNoCache, kCacheHit, kCacheMiss };
+
+private:
+   using NamedInfo_t = std::pair<const std::string, BranchInfo>;
+
+   struct Slot {
+      std::unordered_map<std::string, BranchInfo> fInfos;
+      /// The infos of the branches seen, to skip the lookup by name
+      std::unordered_map<TBranch *, NamedInfo_t *> fBranchInfos;
+   };
+
+   static std::atomic<TTreeBranchPerfStats *> fgActive;
+
+   std::uint64_t fId;                         ///<! Identifies the object for the thread-local slot lookup
+   mutable std::mutex fLock;                  ///<! Protects fSlots
+   std::vector<std::unique_ptr<Slot>> fSlots; ///<! One per thread that recorded events
+
+   Slot &GetSlot();
+   BranchInfo &GetInfo(TBranch *branch);
+
+public:
+   TTreeBranchPerfStats(const char *name = "TTreeBranchPerfStats");
+   virtual ~TTreeBranchPerfStats();
+
+   void Start();
+   void Stop();
+   /// The object collecting the events, if any. Tested in the hot paths of TBranch and TBasket.
+   static TTreeBranchPerfStats *GetActive() { return fgActive.load(std::memory_order_relaxed); }
+
+   void BasketEvent(TBranch *branch, Int_t compressedBytes, Int_t uncompressedBytes, Double_t readTime,
+                    Double_t unzipTime, ECacheStatus status);
+   void StreamerEvent(TBranch *branch, Double_t streamerTime);
+
+   std::map<std::string, BranchInfo> GetBranchInfos() const;
+   BranchInfo GetBranchInfo(const char *branchName) const;
+   virtual void Print(Option_t *option = "") const;
+   void Reset();
+
+   ClassDef(TTreeBranchPerfStats, 0) // Per-branch TTree I/O performance measurement
+};
+
+#endif
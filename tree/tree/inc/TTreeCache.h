@@ -154,6 +154,7 @@ public:
    virtual Bool_t       FillBuffer();
    virtual Int_t        LearnBranch(TBranch *b, Bool_t subgbranches = kFALSE);
    virtual void         LearnPrefill();
+   virtual Int_t        LoadAccessProfile(const char *filename);
 
    virtual void         Print(Option_t *option="") const;
    virtual Int_t        ReadBuffer(char *buf, Long64_t pos, Int_t len);
@@ -161,6 +162,7 @@ public:
    virtual Int_t        ReadBufferPrefetch(char *buf, Long64_t pos, Int_t len);
    virtual void         ResetCache();
    void                 ResetMissCache(); // Reset the miss cache.
+   virtual Bool_t       SaveAccessProfile(const char *filename) const;
    void                 SetAutoCreated(Bool_t val) {fAutoCreated = val;}
    virtual Int_t        SetBufferSize(Int_t buffersize);
    virtual void         SetEntryRange(Long64_t emin,   Long64_t emax);
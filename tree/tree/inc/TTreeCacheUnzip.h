@@ -51,10 +51,12 @@ protected:
       std::unique_ptr<char[]> *fUnzipChunks;     ///<! [fNseek] Individual unzipped chunks. Their summed size is kept under control.
       std::vector<Int_t>       fUnzipLen;        ///<! [fNseek] Length of the unzipped buffers
       std::atomic<Byte_t>     *fUnzipStatus;     ///<! [fNSeek] 
+      std::atomic<Long64_t>    fUnzippedBytes;   ///<! Summed size of the unzipped chunks not yet handed out
 
       UnzipState() {
          fUnzipChunks = nullptr;
          fUnzipStatus = nullptr;
+         fUnzippedBytes.store(0);
       }
       ~UnzipState() {
          if (fUnzipChunks) delete [] fUnzipChunks;
@@ -72,6 +74,8 @@ protected:
       void   SetMissed(Int_t index);
       void   SetUnzipped(Int_t index, char* buf, Int_t len);
       Bool_t TryUnzipping(Int_t index);
+      Bool_t TryReserve(Int_t len, Long64_t limit);
+      void   Release(Int_t len);
    };
 
    typedef struct UnzipState UnzipState_t;
@@ -95,7 +99,7 @@ protected:
    // Unzipping related members
    Int_t       fNseekMax;         ///<!  fNseek can change so we need to know its max size
    Int_t       fUnzipGroupSize;   ///<!  Min accumulated size of a group of baskets ready to be unzipped by a IMT task
-   Long64_t    fUnzipBufferSize;  ///<!  Max Size for the ready unzipped blocks (default is 2*fBufferSize)
+   Long64_t    fUnzipBufferSize;  ///<!  Max Size for the ready unzipped blocks (default is fgRelBuffSize*fBufferSize)
 
    static Double_t fgRelBuffSize; ///< This is the percentage of the TTreeCacheUnzip that will be used
 
@@ -104,6 +108,7 @@ protected:
    Int_t       fNMissed;          ///<! number of blocks that were not found in the cache and were unzipped
    Int_t       fNStalls;          ///<! number of hits which caused a stall
    Int_t       fNUnzip;           ///<! number of blocks that were unzipped
+   std::atomic<Int_t> fNOverBudget; ///<! number of blocks left to the main thread because fUnzipBufferSize was reached
 
 private:
    TTreeCacheUnzip(const TTreeCacheUnzip &);            //this class cannot be copied
@@ -139,6 +144,7 @@ public:
 #endif
    Int_t          GetRecordHeader(char *buf, Int_t maxbytes, Int_t &nbytes, Int_t &objlen, Int_t &keylen);
    virtual Int_t  GetUnzipBuffer(char **buf, Long64_t pos, Int_t len, Bool_t *free);
+   Long64_t       GetUnzipBufferSize() const { return fUnzipBufferSize; }
    Int_t          GetUnzipGroupSize() { return fUnzipGroupSize; }
    virtual void   ResetCache();
    virtual Int_t  SetBufferSize(Int_t buffersize);
@@ -152,6 +158,8 @@ public:
    Int_t  GetNUnzip() { return fNUnzip; }
    Int_t  GetNMissed(){ return fNMissed; }
    Int_t  GetNFound() { return fNFound; }
+   Int_t  GetNOverBudget() const { return fNOverBudget.load(); }
+   Long64_t GetNUnzippedBytes() const { return fUnzipState.fUnzippedBytes.load(); }
 
    void Print(Option_t* option = "") const;
 
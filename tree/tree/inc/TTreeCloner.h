@@ -43,6 +43,7 @@ class TTreeCloner {
    TObjArray  fToBranches;
 
    UInt_t     fMaxBaskets;
+   UInt_t     fNBaskets;         ///< Number of baskets collected for the copy (fMaxBaskets unless ExecRange is used).
    UInt_t    *fBasketBranchNum;  ///<[fMaxBaskets] Index of the branch(es) of the basket.
    UInt_t    *fBasketNum;        ///<[fMaxBaskets] index of the basket within the branch.
 
@@ -58,6 +59,7 @@ class TTreeCloner {
    Int_t           fCacheSize;   ///< Requested size of the file cache
    TFileCacheRead *fFileCache;   ///< File Cache used to reduce the number of individual reads
    TFileCacheRead *fPrevCache;   ///< Cache that set before the TTreeCloner ctor for the 'from' TTree if any.
+   Bool_t     fRangeStarted;     ///< True once ExecRange copied the TStreamerInfo and TProcessID of the input.
 
    enum ECloneMethod {
       kDefault             = 0,
@@ -111,12 +113,15 @@ public:
    UInt_t CollectBranches(TObjArray *from, TObjArray *to);
    UInt_t CollectBranches();
    void   CollectBaskets();
+   void   CollectBaskets(Long64_t first, Long64_t last);
    void   CopyMemoryBaskets();
    void   CopyStreamerInfos();
    void   CopyProcessIds();
    const char *GetWarning() const { return fWarningMsg; }
    Bool_t IsInPlace() const { return fFromTree == fToTree; }
    Bool_t Exec();
+   Bool_t ExecRange(Long64_t first, Long64_t last);
+   Bool_t IsCopyableRange(Long64_t first, Long64_t last);
    Bool_t IsValid() { return fIsValid; }
    Bool_t NeedConversion() { return fNeedConversion; }
    void   SetCacheSize(Int_t size);
@@ -17,22 +17,63 @@
 #include "TBranch.h"
 #include "TFile.h"
 #include "TLeaf.h"
+#include "TLeafD.h"
+#include "TLeafF.h"
+#include "TLeafG.h"
+#include "TLeafI.h"
+#include "TLeafL.h"
+#include "TLeafS.h"
 #include "TMath.h"
 #include "TROOT.h"
+#include "TTreeBranchPerfStats.h"
 #include "TTreeCache.h"
 #include "TVirtualMutex.h"
 #include "TVirtualPerfStats.h"
 #include "TTimeStamp.h"
+#include "ROOT/TBasketBufferPool.hxx"
 #include "ROOT/TIOFeatures.hxx"
+#include "ROOT/RTrace.hxx"
 #include "RZip.h"
 
 #include <bitset>
+#include <vector>
 
 const UInt_t kDisplacementMask = 0xFF000000;  // In the streamer the two highest bytes of
                                               // the fEntryOffset are used to stored displacement.
 
 ClassImp(TBasket);
 
+namespace {
+
+////////////////////////////////////////////////////////////////////////////////
+/// Transpose `nbytes` bytes of `size`-byte elements so that byte `k` of every
+/// element ends up in the k-th of `size` consecutive streams.
+
+void ByteSplit(char *buf, Int_t nbytes, Int_t size)
+{
+   const Int_t n = nbytes / size;
+   std::vector<char> scratch(buf, buf + nbytes);
+   for (Int_t i = 0; i < n; ++i) {
+      for (Int_t b = 0; b < size; ++b)
+         buf[b * n + i] = scratch[i * size + b];
+   }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Inverse of ByteSplit().
+
+void ByteUnsplit(char *buf, Int_t nbytes, Int_t size)
+{
+   const Int_t n = nbytes / size;
+   std::vector<char> scratch(buf, buf + nbytes);
+   for (Int_t i = 0; i < n; ++i) {
+      for (Int_t b = 0; b < size; ++b)
+         buf[i * size + b] = scratch[b * n + i];
+   }
+}
+
+} // anonymous namespace
+
 /** \class TBasket
 \ingroup tree
 
@@ -98,6 +139,34 @@ TBasket::TBasket(const char *name, const char *title, TBranch *branch)
    branch->GetTree()->IncrementTotalBuffers(fBufferSize);
 }
 
+namespace {
+
+/// Bytes allocated by TBuffer beyond its size, which it copies when expanding in write mode.
+constexpr Int_t kBufferExtraSpace = 8;
+
+////////////////////////////////////////////////////////////////////////////////
+/// The pool of buffers of the tree of the branch, if any (see TTree::SetBasketBufferPoolSize).
+
+ROOT::Internal::TBasketBufferPool *R__GetBasketBufferPool(TBranch *branch)
+{
+   TTree *tree = branch ? branch->GetTree() : nullptr;
+   return tree ? tree->GetBasketBufferPool() : nullptr;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return the memory owned by the buffer to the pool; the buffer does not own
+/// it anymore.
+
+void R__ReleaseBasketBuffer(TBuffer *buffer, ROOT::Internal::TBasketBufferPool *pool)
+{
+   if (pool && buffer && buffer->Buffer() && buffer->TestBit(TBuffer::kIsOwner)) {
+      pool->Release(buffer->Buffer(), buffer->BufferSize());
+      buffer->ResetBit(TBuffer::kIsOwner);
+   }
+}
+
+} // anonymous namespace
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Basket destructor.
 
@@ -105,12 +174,15 @@ TBasket::~TBasket()
 {
    if (fDisplacement) delete [] fDisplacement;
    ResetEntryOffset();
+   auto pool = R__GetBasketBufferPool(fBranch);
+   R__ReleaseBasketBuffer(fBufferRef, pool);
    if (fBufferRef) delete fBufferRef;
    fBufferRef = 0;
    fBuffer = 0;
    fDisplacement= 0;
    // Note we only delete the compressed buffer if we own it
    if (fCompressedBufferRef && fOwnsCompressedBuffer) {
+      R__ReleaseBasketBuffer(fCompressedBufferRef, pool);
       delete fCompressedBufferRef;
       fCompressedBufferRef = 0;
    }
@@ -176,8 +248,13 @@ Int_t TBasket::DropBuffers()
 
    if (fDisplacement) delete [] fDisplacement;
    ResetEntryOffset();
+   auto pool = R__GetBasketBufferPool(fBranch);
+   R__ReleaseBasketBuffer(fBufferRef, pool);
    if (fBufferRef)    delete fBufferRef;
-   if (fCompressedBufferRef && fOwnsCompressedBuffer) delete fCompressedBufferRef;
+   if (fCompressedBufferRef && fOwnsCompressedBuffer) {
+      R__ReleaseBasketBuffer(fCompressedBufferRef, pool);
+      delete fCompressedBufferRef;
+   }
    fBufferRef   = 0;
    fCompressedBufferRef = 0;
    fBuffer      = 0;
@@ -224,6 +301,35 @@ Bool_t TBasket::CanGenerateOffsetArray()
    return leaf->CanGenerateOffsetArray();
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Return the size of the elements the payload of this basket is byte-split by,
+/// or 0 if the payload is stored as is.
+///
+/// With the kByteSplit IO feature, the payload of a branch made of a single
+/// leaf of basic type (short, int, long, float, double; also as variable-size
+/// array) is an array of big-endian elements of the leaf's size.  Before
+/// compression, the bytes are regrouped such that all first bytes come first,
+/// then all second bytes etc., which compresses considerably better.
+/// The decision only depends on persistent information (branch layout, fKeylen,
+/// fLast and fIOBits) so that reading takes the same decision as writing.
+
+Int_t TBasket::GetByteSplitElementSize() const
+{
+   if (!(fIOBits & static_cast<UChar_t>(TBasket::EIOBits::kByteSplit)))
+      return 0;
+   if (!fBranch || fBranch->IsA() != TBranch::Class() || fBranch->GetNleaves() != 1)
+      return 0;
+   TLeaf *leaf = static_cast<TLeaf *>(fBranch->GetListOfLeaves()->UncheckedAt(0));
+   TClass *cl = leaf->IsA();
+   if (cl != TLeafS::Class() && cl != TLeafI::Class() && cl != TLeafL::Class() && cl != TLeafG::Class() &&
+       cl != TLeafF::Class() && cl != TLeafD::Class())
+      return 0;
+   Int_t size = leaf->GetLenType();
+   if (size < 2 || (fLast - fKeylen) % size != 0)
+      return 0;
+   return size;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Get pointer to buffer for internal entry.
 
@@ -359,6 +465,12 @@ Int_t TBasket::ReadBasketBuffersUncompressedCase()
 {
    fBuffer = fBufferRef->Buffer();
 
+   // The payload is left as stored: it is still compressed and, if byte-split, it stays
+   // byte-split. TBasket::WriteBuffer copies it verbatim along with the header, fIOBits
+   // included, so that the copy is unsplit once it is read back and decompressed.
+   // Baskets that were written uncompressed do not come here, they are unsplit in
+   // ReadBasketBuffers.
+
    // Make sure that the buffer is set at the END of the data
    fBufferRef->SetBufferOffset(fNbytes);
 
@@ -380,6 +492,7 @@ Int_t TBasket::ReadBasketBuffersUncompressedCase()
 Int_t TBasket::ReadBasketBuffersUnzip(char* buffer, Int_t size, Bool_t mustFree, TFile* file)
 {
    if (fBufferRef) {
+      R__ReleaseBasketBuffer(fBufferRef, R__GetBasketBufferPool(fBranch));
       fBufferRef->SetBuffer(buffer, size, mustFree);
       fBufferRef->SetReadMode();
       fBufferRef->Reset();
@@ -405,9 +518,11 @@ Int_t TBasket::ReadBasketBuffersUnzip(char* buffer, Int_t size, Bool_t mustFree,
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-/// Initialize a buffer for reading if it is not already initialized
+/// Initialize a buffer for reading if it is not already initialized, taking
+/// its memory from the pool if any.
 
-static inline TBuffer* R__InitializeReadBasketBuffer(TBuffer* bufferRef, Int_t len, TFile* file)
+static inline TBuffer* R__InitializeReadBasketBuffer(TBuffer* bufferRef, Int_t len, TFile* file,
+                                                     ROOT::Internal::TBasketBufferPool *pool)
 {
    TBuffer* result;
    if (R__likely(bufferRef)) {
@@ -419,6 +534,10 @@ static inline TBuffer* R__InitializeReadBasketBuffer(TBuffer* bufferRef, Int_t l
       }
       bufferRef->Reset();
       result = bufferRef;
+   } else if (pool) {
+      Int_t capacity = 0;
+      char *buffer = pool->Acquire(len + kBufferExtraSpace, capacity);
+      result = new TBufferFile(TBuffer::kRead, capacity - kBufferExtraSpace, buffer, kTRUE);
    } else {
       result = new TBufferFile(TBuffer::kRead, len);
    }
@@ -432,7 +551,7 @@ static inline TBuffer* R__InitializeReadBasketBuffer(TBuffer* bufferRef, Int_t l
 void inline TBasket::InitializeCompressedBuffer(Int_t len, TFile* file)
 {
    Bool_t compressedBufferExists = fCompressedBufferRef != NULL;
-   fCompressedBufferRef = R__InitializeReadBasketBuffer(fCompressedBufferRef, len, file);
+   fCompressedBufferRef = R__InitializeReadBasketBuffer(fCompressedBufferRef, len, file, R__GetBasketBufferPool(fBranch));
    if (R__unlikely(!compressedBufferExists)) {
       fOwnsCompressedBuffer = kTRUE;
    }
@@ -471,6 +590,15 @@ Int_t TBasket::ReadBasketBuffers(Long64_t pos, Int_t len, TFile *file)
    char *rawUncompressedBuffer, *rawCompressedBuffer;
    Int_t uncompressedBufferLen;
 
+   // Optional per-branch measurement, see TTreeBranchPerfStats.
+   TTreeBranchPerfStats *branchStats = TTreeBranchPerfStats::GetActive();
+   const Int_t compressedLen = len;
+   TTreeBranchPerfStats::ECacheStatus cacheStatus = TTreeBranchPerfStats::kNoCache;
+   std::chrono::steady_clock::time_point readStart;
+   Double_t readTime = 0, unzipTime = 0;
+   if (R__unlikely(branchStats))
+      readStart = std::chrono::steady_clock::now();
+
    // See if the cache has already unzipped the buffer for us.
    TFileCacheRead *pf = nullptr;
    {
@@ -487,6 +615,7 @@ Int_t TBasket::ReadBasketBuffers(Long64_t pos, Int_t len, TFile *file)
          // Note that in the kNotDecompressed case, the above function will return 0;
          // In such a case, we should stop processing
          if (len <= 0) return -len;
+         cacheStatus = TTreeBranchPerfStats::kCacheHit;
          goto AfterBuffer;
       }
    }
@@ -496,11 +625,12 @@ Int_t TBasket::ReadBasketBuffers(Long64_t pos, Int_t len, TFile *file)
    TBuffer* readBufferRef;
    if (R__unlikely(fBranch->GetCompressionLevel()==0)) {
       // Initialize the buffer to hold the uncompressed data.
-      fBufferRef = R__InitializeReadBasketBuffer(fBufferRef, len, file);
+      fBufferRef = R__InitializeReadBasketBuffer(fBufferRef, len, file, R__GetBasketBufferPool(fBranch));
       readBufferRef = fBufferRef;
    } else {
       // Initialize the buffer to hold the compressed data.
-      fCompressedBufferRef = R__InitializeReadBasketBuffer(fCompressedBufferRef, len, file);
+      fCompressedBufferRef =
+         R__InitializeReadBasketBuffer(fCompressedBufferRef, len, file, R__GetBasketBufferPool(fBranch));
       readBufferRef = fCompressedBufferRef;
    }
 
@@ -523,7 +653,10 @@ Int_t TBasket::ReadBasketBuffers(Long64_t pos, Int_t len, TFile *file)
       }
       if (st < 0) {
          return 1;
-      } else if (st == 0) {
+      } else if (st > 0) {
+         cacheStatus = TTreeBranchPerfStats::kCacheHit;
+      } else {
+         cacheStatus = TTreeBranchPerfStats::kCacheMiss;
          // Read directly from file, not from the cache
          // If we are using a TTreeCache, disable reading from the default cache
          // temporarily, to force reading directly from file
@@ -554,6 +687,8 @@ Int_t TBasket::ReadBasketBuffers(Long64_t pos, Int_t len, TFile *file)
    if (IsZombie()) {
       return 1;
    }
+   if (R__unlikely(branchStats))
+      readTime = std::chrono::duration<Double_t>(std::chrono::steady_clock::now() - readStart).count();
 
    rawCompressedBuffer = readBufferRef->Buffer();
 
@@ -582,7 +717,8 @@ Int_t TBasket::ReadBasketBuffers(Long64_t pos, Int_t len, TFile *file)
    // the zip headers; this is no longer beforehand as the buffer lifetime is scoped
    // to the TBranch.
    uncompressedBufferLen = len > fObjlen+fKeylen ? len : fObjlen+fKeylen;
-   fBufferRef = R__InitializeReadBasketBuffer(fBufferRef, uncompressedBufferLen, file);
+   fBufferRef = R__InitializeReadBasketBuffer(fBufferRef, uncompressedBufferLen, file,
+                                              R__GetBasketBufferPool(fBranch));
    rawUncompressedBuffer = fBufferRef->Buffer();
    fBuffer = rawUncompressedBuffer;
 
@@ -598,6 +734,7 @@ Int_t TBasket::ReadBasketBuffers(Long64_t pos, Int_t len, TFile *file)
       if (R__unlikely(gPerfStats)) {
          start = TTimeStamp();
       }
+      R__TRACE_SPAN("io", "TBasket unzip", fObjlen);
 
       memcpy(rawUncompressedBuffer, rawCompressedBuffer, fKeylen);
       char *rawUncompressedObjectBuffer = rawUncompressedBuffer+fKeylen;
@@ -634,6 +771,9 @@ Int_t TBasket::ReadBasketBuffers(Long64_t pos, Int_t len, TFile *file)
          return 1;
       }
       len = fObjlen+fKeylen;
+      if (R__unlikely(branchStats))
+         unzipTime =
+            std::chrono::duration<Double_t>(std::chrono::steady_clock::now() - readStart).count() - readTime;
       TVirtualPerfStats* temp = gPerfStats;
       if (fBranch->GetTree()->GetPerfStats() != 0) gPerfStats = fBranch->GetTree()->GetPerfStats();
       if (R__unlikely(gPerfStats)) {
@@ -649,6 +789,18 @@ AfterBuffer:
 
    fBranch->GetTree()->IncrementTotalBuffers(fBufferSize);
 
+   if (R__unlikely(branchStats)) {
+      // The baskets that were not compressed, or were decompressed by the cache, only took time to be read
+      if (readTime == 0)
+         readTime = std::chrono::duration<Double_t>(std::chrono::steady_clock::now() - readStart).count();
+      branchStats->BasketEvent(fBranch, compressedLen, fObjlen + fKeylen, readTime, unzipTime, cacheStatus);
+   }
+
+   const Int_t splitSize = GetByteSplitElementSize();
+   if (splitSize) {
+      ByteUnsplit(fBufferRef->Buffer() + fKeylen, fLast - fKeylen, splitSize);
+   }
+
    // Read offsets table if needed.
    // If there's no EntryOffsetLen in the branch -- or the fEntryOffset is marked to be calculated-on-demand --
    // then we skip reading out.
@@ -658,6 +810,12 @@ AfterBuffer:
    // At this point, we're required to read out an offset array.
    ResetEntryOffset(); // TODO: every basket, we reset the offset array.  Is this necessary?
                        // Could we instead switch to std::vector?
+   if (splitSize) {
+      // The offsets (or sizes) following the array length were byte-split as well.
+      Int_t nbytes = (fNevBuf + 1) * sizeof(Int_t);
+      if (fLast + (Int_t)sizeof(Int_t) + nbytes <= fBufferRef->BufferSize())
+         ByteUnsplit(fBufferRef->Buffer() + fLast + sizeof(Int_t), nbytes, sizeof(Int_t));
+   }
    fBufferRef->SetBufferOffset(fLast);
    fBufferRef->ReadArray(fEntryOffset);
    if (R__unlikely(!fEntryOffset)) {
@@ -985,6 +1143,9 @@ void TBasket::Streamer(TBuffer &b)
             fNevBufSize = 0;
             MakeZombie();
          }
+      } else {
+         // No IO feature was used when writing this basket, regardless of the branch settings.
+         fIOBits = 0;
       }
       b >> fNevBuf;
       b >> fLast;
@@ -1139,16 +1300,13 @@ Int_t TBasket::WriteBuffer()
    }
    fMotherDir = file; // fBranch->GetDirectory();
 
-   // This mutex prevents multiple TBasket::WriteBuffer invocations from interacting
-   // with the underlying TFile at once - TFile is assumed to *not* be thread-safe.
-   //
-   // The only parallelism we'd like to exploit (right now!) is the compression
-   // step - everything else should be serialized at the TFile level.
+   if (R__unlikely(fBufferRef->TestBit(TBufferFile::kNotDecompressed))) {
+      // This mutex prevents multiple TBasket::WriteBuffer invocations from interacting
+      // with the underlying TFile at once - TFile is assumed to *not* be thread-safe.
 #ifdef R__USE_IMT
-   std::unique_lock<std::mutex> sentry(file->fWriteMutex);
+      std::lock_guard<std::mutex> sentry(file->fWriteMutex);
 #endif  // R__USE_IMT
 
-   if (R__unlikely(fBufferRef->TestBit(TBufferFile::kNotDecompressed))) {
       // Read the basket information that was saved inside the buffer.
       Bool_t writing = fBufferRef->IsWriting();
       fBufferRef->SetReadMode();
@@ -1170,8 +1328,29 @@ Int_t TBasket::WriteBuffer()
       return nBytes>0 ? fKeylen+nout : -1;
    }
 
+   Int_t nout = CompressWriteBuffer(file);
+   if (nout < 0) return -1;
+   return CommitWriteBuffer(file, nout);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// First half of WriteBuffer(): append the entry offsets to the buffer and
+/// compress it into fBuffer, without touching the state of `file`. This can
+/// run concurrently with any other operation on the file.
+///
+/// Returns the size of the (possibly compressed) payload, or -1 on error.
+
+Int_t TBasket::CompressWriteBuffer(TFile *file)
+{
    // Transfer fEntryOffset table at the end of fBuffer.
    fLast = fBufferRef->Length();
+
+   // Byte-split the payload if requested; it is restored once written.
+   const Int_t splitSize = GetByteSplitElementSize();
+   if (splitSize) {
+      ByteSplit(fBufferRef->Buffer() + fKeylen, fLast - fKeylen, splitSize);
+   }
+
    Int_t *entryOffset = GetEntryOffset();
    if (entryOffset) {
       Bool_t hasOffsetBit = fIOBits & static_cast<UChar_t>(TBasket::EIOBits::kGenerateOffsetMap);
@@ -1197,6 +1376,10 @@ Int_t TBasket::WriteBuffer()
       } else if (!hasOffsetBit) { // In this case, write out as normal
          fBufferRef->WriteArray(entryOffset, fNevBuf + 1);
       }
+      if (splitSize && fBufferRef->Length() > fLast) {
+         // Offsets of consecutive entries (or sizes) share their upper bytes: byte-split them too.
+         ByteSplit(fBufferRef->Buffer() + fLast + sizeof(Int_t), (fNevBuf + 1) * sizeof(Int_t), sizeof(Int_t));
+      }
       if (fDisplacement) {
          fBufferRef->WriteArray(fDisplacement, fNevBuf + 1);
          delete[] fDisplacement;
@@ -1209,7 +1392,7 @@ Int_t TBasket::WriteBuffer()
    fObjlen = fBufferRef->Length() - fKeylen;
 
    fHeaderOnly = kTRUE;
-   fCycle = fBranch->GetWriteBasket();
+   fCycle = (fWriteCycle >= 0) ? fWriteCycle : fBranch->GetWriteBasket();
    Int_t cxlevel = fBranch->GetCompressionLevel();
    if (cxlevel == ROOT::RCompressionSetting::ELevel::kInherit)
       cxlevel = file->GetCompressionLevel();
@@ -1222,6 +1405,8 @@ Int_t TBasket::WriteBuffer()
       InitializeCompressedBuffer(buflen, file);
       if (!fCompressedBufferRef) {
          Warning("WriteBuffer", "Unable to allocate the compressed buffer");
+         if (splitSize)
+            ByteUnsplit(fBufferRef->Buffer() + fKeylen, fLast - fKeylen, splitSize);
          return -1;
       }
       fCompressedBufferRef->SetWriteMode();
@@ -1236,16 +1421,10 @@ Int_t TBasket::WriteBuffer()
          // Compress the buffer.  Note that we allow multiple TBasket compressions to occur at once
          // for a given TFile: that's because the compression buffer when we use IMT is no longer
          // shared amongst several threads.
-#ifdef R__USE_IMT
-         sentry.unlock();
-#endif  // R__USE_IMT
-         // NOTE this is declared with C linkage, so it shouldn't except.  Also, when
-         // USE_IMT is defined, we are guaranteed that the compression buffer is unique per-branch.
-         // (see fCompressedBufferRef in constructor).
-         R__zipMultipleAlgorithm(cxlevel, &bufmax, objbuf, &bufmax, bufcur, &nout, cxAlgorithm);
-#ifdef R__USE_IMT
-         sentry.lock();
-#endif  // R__USE_IMT
+         // NOTE this calls the compression functions declared with C linkage, so it shouldn't except.
+         // Also, when USE_IMT is defined, we are guaranteed that the compression buffer is unique per-branch.
+         // (see fCompressedBufferRef in constructor).  TFile::CompressBuffer can be called concurrently.
+         file->CompressBuffer(cxlevel, &bufmax, objbuf, &bufmax, bufcur, &nout, cxAlgorithm);
 
          // test if buffer has really been compressed. In case of small buffers
          // when the buffer contains random data, it may happen that the compressed
@@ -1255,38 +1434,51 @@ Int_t TBasket::WriteBuffer()
             // We used to delete fBuffer here, we no longer want to since
             // the buffer (held by fCompressedBufferRef) might be re-used later.
             fBuffer = fBufferRef->Buffer();
-            Create(fObjlen,file);
-            fBufferRef->SetBufferOffset(0);
-
-            Streamer(*fBufferRef);         //write key itself again
             if ((nout+fKeylen)>buflen) {
-               Warning("WriteBuffer","Possible memory corruption due to compression algorithm, wrote %d bytes past the end of a block of %d bytes. fNbytes=%d, fObjLen=%d, fKeylen=%d",
-                  (nout+fKeylen-buflen),buflen,fNbytes,fObjlen,fKeylen);
+               Warning("WriteBuffer","Possible memory corruption due to compression algorithm, wrote %d bytes past the end of a block of %d bytes. fObjLen=%d, fKeylen=%d",
+                  (nout+fKeylen-buflen),buflen,fObjlen,fKeylen);
             }
-            goto WriteFile;
+            return nout;
          }
          bufcur += nout;
          noutot += nout;
          objbuf += kMAXZIPBUF;
          nzip   += kMAXZIPBUF;
       }
-      nout = noutot;
-      Create(noutot,file);
-      fBufferRef->SetBufferOffset(0);
+      return noutot;
+   }
+   fBuffer = fBufferRef->Buffer();
+   return fObjlen;
+}
 
-      Streamer(*fBufferRef);         //write key itself again
-      memcpy(fBuffer,fBufferRef->Buffer(),fKeylen);
-   } else {
-      fBuffer = fBufferRef->Buffer();
-      Create(fObjlen,file);
-      fBufferRef->SetBufferOffset(0);
+////////////////////////////////////////////////////////////////////////////////
+/// Second half of WriteBuffer(): create the key of the basket in `file`, for a
+/// payload of `nout` bytes prepared by CompressWriteBuffer(), and write it.
+///
+/// Returns the number of bytes committed to the memory, or -1 on error.
 
-      Streamer(*fBufferRef);         //write key itself again
-      nout = fObjlen;
-   }
+Int_t TBasket::CommitWriteBuffer(TFile *file, Int_t nout)
+{
+   // This mutex prevents multiple TBasket::WriteBuffer invocations from interacting
+   // with the underlying TFile at once - TFile is assumed to *not* be thread-safe.
+   //
+   // The only parallelism we'd like to exploit (right now!) is the compression
+   // step - everything else should be serialized at the TFile level.
+#ifdef R__USE_IMT
+   std::lock_guard<std::mutex> sentry(file->fWriteMutex);
+#endif  // R__USE_IMT
+
+   Create(nout,file);
+   fBufferRef->SetBufferOffset(0);
+
+   Streamer(*fBufferRef);         //write key itself again
+   if (fBuffer != fBufferRef->Buffer())
+      memcpy(fBuffer,fBufferRef->Buffer(),fKeylen);
 
-WriteFile:
    Int_t nBytes = WriteFileKeepBuffer();
    fHeaderOnly = kFALSE;
+   const Int_t splitSize = GetByteSplitElementSize();
+   if (splitSize)
+      ByteUnsplit(fBufferRef->Buffer() + fKeylen, fLast - fKeylen, splitSize);
    return nBytes>0 ? fKeylen+nout : -1;
 }
@@ -0,0 +1,121 @@
+// @(#)root/tree:$Id$
+
+/*************************************************************************
+ * Copyright (C) 1995-2021, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#include "ROOT/TBasketBufferPool.hxx"
+
+////////////////////////////////////////////////////////////////////////////////
+/// Index of the class of the buffers known to hold `size` bytes: size is in
+/// [2^(kMinClass+i), 2^(kMinClass+i+1)). Returns -1 if size is too small.
+
+Int_t ROOT::Internal::TBasketBufferPool::FloorClass(Int_t size)
+{
+   if (size < (1 << kMinClass))
+      return -1;
+   Int_t index = -1;
+   for (UInt_t s = UInt_t(size) >> kMinClass; s; s >>= 1)
+      ++index;
+   return index < kNClasses ? index : kNClasses - 1;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Returns a buffer of at least `size` bytes, and in `capacity` the number of
+/// bytes it can hold. The buffer is either taken from the pool or allocated
+/// with `new char[]`.
+
+char *ROOT::Internal::TBasketBufferPool::Acquire(Int_t size, Int_t &capacity)
+{
+   const Int_t index = FloorClass(size);
+   {
+      std::lock_guard<std::mutex> lock(fMutex);
+      ++fStats.fNAcquired;
+      if (index >= 0) {
+         // Any buffer of the next class is large enough
+         for (Int_t i : {index + 1, index}) {
+            if (i >= kNClasses)
+               continue;
+            auto &list = fFree[i];
+            for (auto it = list.rbegin(); it != list.rend(); ++it) {
+               if (it->second < size)
+                  continue;
+               char *buffer = it->first;
+               capacity = it->second;
+               list.erase(std::next(it).base());
+               fStats.fBytes -= capacity;
+               ++fStats.fNReused;
+               return buffer;
+            }
+         }
+      }
+   }
+
+   // Round up to the next class so that the buffer can serve the requests of its class
+   capacity = size;
+   if (index >= 0 && index + 1 < kNClasses)
+      capacity = Int_t(1) << (kMinClass + index + 1);
+   return new char[capacity];
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Returns to the pool a buffer allocated with `new char[]` that can hold
+/// `capacity` bytes. The buffer is deleted if the pool is full.
+
+void ROOT::Internal::TBasketBufferPool::Release(char *buffer, Int_t capacity)
+{
+   if (!buffer)
+      return;
+   const Int_t index = FloorClass(capacity);
+   {
+      std::lock_guard<std::mutex> lock(fMutex);
+      ++fStats.fNReleased;
+      if (index >= 0 && fStats.fBytes + capacity <= fMaxBytes) {
+         fFree[index].emplace_back(buffer, capacity);
+         fStats.fBytes += capacity;
+         if (fStats.fBytes > fStats.fPeakBytes)
+            fStats.fPeakBytes = fStats.fBytes;
+         return;
+      }
+      ++fStats.fNDeleted;
+   }
+   delete[] buffer;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Delete the buffers held by the pool.
+
+void ROOT::Internal::TBasketBufferPool::Clear()
+{
+   std::lock_guard<std::mutex> lock(fMutex);
+   for (auto &list : fFree) {
+      for (auto &buffer : list)
+         delete[] buffer.first;
+      list.clear();
+   }
+   fStats.fBytes = 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Set the maximum number of bytes held by the pool. The buffers held are
+/// deleted if the pool is smaller than before.
+
+void ROOT::Internal::TBasketBufferPool::SetMaxBytes(Long64_t maxBytes)
+{
+   if (maxBytes < fMaxBytes)
+      Clear();
+   std::lock_guard<std::mutex> lock(fMutex);
+   fMaxBytes = maxBytes;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+ROOT::Internal::TBasketBufferPool::Stats ROOT::Internal::TBasketBufferPool::GetStats() const
+{
+   std::lock_guard<std::mutex> lock(fMutex);
+   return fStats;
+}
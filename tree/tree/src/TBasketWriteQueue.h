@@ -0,0 +1,130 @@
+// @(#)root/tree:$Id$
+
+/*************************************************************************
+ * Copyright (C) 1995-2021, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#ifndef ROOT_TBasketWriteQueue
+#define ROOT_TBasketWriteQueue
+
+#include "RtypesCore.h"
+
+#ifdef R__USE_IMT
+#include "ROOT/TTaskGroup.hxx"
+#endif
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+
+/** \class ROOT::Internal::TBasketWriteQueue
+ A bounded queue of full baskets that are compressed and written in the background
+ while TTree::Fill continues (see TTree::SetMaxPendingBaskets).
+
+ The expensive part of the work (the compression) runs as an IMT task. The write to the file
+ and the bookkeeping of the basket, which touch the state of the file and of its branch, are
+ done by the thread that calls Harvest() (or Push()), in the order of submission.
+*/
+
+namespace ROOT {
+namespace Internal {
+
+class TBasketWriteQueue {
+
+#ifdef R__USE_IMT
+using TaskGroup_t = ROOT::Experimental::TTaskGroup;
+#endif
+
+   struct REntry {
+      std::function<Int_t(Int_t)> fFinish; ///< Bookkeeping, called with the result of the background work
+      Int_t fResult{0};                    ///< Result of the background work
+      bool fDone{false};                   ///< Set (under fMutex) once the background work is done
+   };
+
+   Int_t fMaxPending;                           ///< Maximum number of baskets in flight
+   std::deque<std::unique_ptr<REntry>> fEntries; ///< Submitted baskets in order, only modified by the filling thread
+   std::mutex fMutex;
+   std::condition_variable fCondition;
+#ifdef R__USE_IMT
+   std::unique_ptr<TaskGroup_t> fGroup;
+#endif
+
+   /// Finish the oldest entry, waiting for it if needed. Returns 1 on error, 0 otherwise.
+   Int_t FinishFront()
+   {
+      auto entry = std::move(fEntries.front());
+      fEntries.pop_front();
+      {
+         std::unique_lock<std::mutex> lock(fMutex);
+         fCondition.wait(lock, [&entry] { return entry->fDone; });
+      }
+      return entry->fFinish(entry->fResult) < 0 ? 1 : 0;
+   }
+
+public:
+   explicit TBasketWriteQueue(Int_t maxPending) : fMaxPending(maxPending > 0 ? maxPending : 1) {}
+   TBasketWriteQueue(const TBasketWriteQueue &) = delete;
+   TBasketWriteQueue &operator=(const TBasketWriteQueue &) = delete;
+   ~TBasketWriteQueue() { Harvest(true); }
+
+   Int_t GetMaxPending() const { return fMaxPending; }
+   Int_t GetNPending() const { return fEntries.size(); }
+
+   /// Run `work` in the background and `finish` with its result on a later Harvest().
+   /// Blocks while the queue is full. Returns the number of errors reported by the
+   /// bookkeeping of the baskets finished meanwhile.
+   template <typename WORK, typename FINISH>
+   Int_t Push(const WORK &work, const FINISH &finish)
+   {
+      Int_t nerrors = 0;
+      while (GetNPending() >= fMaxPending)
+         nerrors += FinishFront();
+
+      fEntries.emplace_back(new REntry);
+      auto entry = fEntries.back().get();
+      entry->fFinish = finish;
+#ifdef R__USE_IMT
+      if (!fGroup) { fGroup.reset(new TaskGroup_t()); }
+      fGroup->Run([this, entry, work]() {
+         auto result = work();
+         {
+            std::lock_guard<std::mutex> lock(fMutex);
+            entry->fResult = result;
+            entry->fDone = true;
+         }
+         fCondition.notify_all();
+      });
+#else
+      entry->fResult = work();
+      entry->fDone = true;
+#endif
+      return nerrors;
+   }
+
+   /// Run the bookkeeping of the baskets written so far, in order of submission.
+   /// If `wait` is true, wait for all pending baskets. Returns the number of errors.
+   Int_t Harvest(bool wait)
+   {
+      Int_t nerrors = 0;
+      while (!fEntries.empty()) {
+         if (!wait) {
+            std::lock_guard<std::mutex> lock(fMutex);
+            if (!fEntries.front()->fDone)
+               break;
+         }
+         nerrors += FinishFront();
+      }
+      return nerrors;
+   }
+};
+
+} // Internal
+} // ROOT
+
+#endif
@@ -43,17 +43,20 @@
 #include "TTree.h"
 #include "TTreeCache.h"
 #include "TTreeCacheUnzip.h"
+#include "TTreeBranchPerfStats.h"
 #include "TVirtualMutex.h"
 #include "TVirtualPad.h"
 #include "TVirtualPerfStats.h"
 #include "strlcpy.h"
 #include "snprintf.h"
 
+#include "TBasketWriteQueue.h"
 #include "TBranchIMTHelper.h"
 
 #include "ROOT/TIOFeatures.hxx"
 
 #include <atomic>
+#include <chrono>
 #include <cstddef>
 #include <cstring>
 #include <cstdio>
@@ -920,7 +923,10 @@ Int_t TBranch::FillImpl(ROOT::Internal::TBranchIMTHelper *imtHelper)
    if (noFlushAtCluster && !fTree->TestBit(TTree::kCircular) &&
        ((fSkipZip && (lnew >= TBuffer::kMinimalSize)) || (buf->TestBit(TBufferFile::kNotDecompressed)) ||
         ((lnew + (2 * nsize) + nbytes) >= fBasketSize))) {
-      Int_t nout = WriteBasketImpl(basket, fWriteBasket, imtHelper);
+      ROOT::Internal::TBasketWriteQueue *queue = fTree->fBasketWriteQueue;
+      Int_t nout = (queue && fDirectory && fDirectory->IsWritable() && !buf->TestBit(TBufferFile::kNotDecompressed))
+                      ? WriteBasketAsync(basket, fWriteBasket, *queue)
+                      : WriteBasketImpl(basket, fWriteBasket, imtHelper);
       if (nout < 0) Error("TBranch::Fill", "Failed to write out basket.\n");
       return (nout >= 0) ? nbytes : -1;
    }
@@ -1235,6 +1241,9 @@ TBasket* TBranch::GetBasketImpl(Int_t basketnumber, TBuffer *user_buffer)
    if (basket) return basket;
    if (basketnumber == fWriteBasket) return 0;
 
+   // The basket might still be on its way to the file.
+   if (!fBasketSeek[basketnumber]) fTree->WaitPendingBaskets();
+
    // create/decode basket parameters from buffer
    TFile *file = GetFile(0);
    if (file == 0) {
@@ -1688,7 +1697,14 @@ Int_t TBranch::GetEntry(Long64_t entry, Int_t getall)
    }
 
    // Int_t bufbegin = buf->Length();
-   (this->*fReadLeaves)(*buf);
+   if (auto branchStats = TTreeBranchPerfStats::GetActive()) {
+      const auto start = std::chrono::steady_clock::now();
+      (this->*fReadLeaves)(*buf);
+      branchStats->StreamerEvent(this,
+                                 std::chrono::duration<Double_t>(std::chrono::steady_clock::now() - start).count());
+   } else {
+      (this->*fReadLeaves)(*buf);
+   }
    return buf->Length() - bufbegin;
 }
 
@@ -3116,9 +3132,8 @@ void TBranch::Streamer(TBuffer& b)
 /// Write the current basket to disk and return the number of bytes
 /// written to the file.
 
-Int_t TBranch::WriteBasketImpl(TBasket* basket, Int_t where, ROOT::Internal::TBranchIMTHelper *imtHelper)
+void TBranch::UpdateEntryOffsetLen(Int_t nevbuf)
 {
-   Int_t nevbuf = basket->GetNevBuf();
    if (fEntryOffsetLen > 10 &&  (4*nevbuf) < fEntryOffsetLen ) {
       // Make sure that the fEntryOffset array does not stay large unnecessarily.
       fEntryOffsetLen = nevbuf < 3 ? 10 : 4*nevbuf; // assume some fluctuations.
@@ -3126,6 +3141,17 @@ Int_t TBranch::WriteBasketImpl(TBasket* basket, Int_t where, ROOT::Internal::TBr
       // Increase the array ...
       fEntryOffsetLen = 2*nevbuf; // assume some fluctuations.
    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Write the write basket `basket` at index `where`.
+///
+/// With `imtHelper`, the write is done by an IMT task that is waited for
+/// at the end of TTree::Fill.
+
+Int_t TBranch::WriteBasketImpl(TBasket* basket, Int_t where, ROOT::Internal::TBranchIMTHelper *imtHelper)
+{
+   UpdateEntryOffsetLen(basket->GetNevBuf());
 
    // Note: captures `basket`, `where`, and `this` by value; modifies the TBranch and basket,
    // as we make a copy of the pointer.  We cannot capture `basket` by reference as the pointer
@@ -3190,6 +3216,69 @@ Int_t TBranch::WriteBasketImpl(TBasket* basket, Int_t where, ROOT::Internal::TBr
    }
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Hand the full write basket `basket` at index `where` to `queue`, to be
+/// compressed in the background (see TTree::SetMaxPendingBaskets).
+///
+/// The branch immediately continues with a new write basket. The compressed
+/// basket is written to the file, and its bookkeeping done (its seek and size,
+/// the byte counters), when the queue is harvested by the filling thread: the
+/// keys and free segments of the file are thus never modified concurrently
+/// with the other writes to the file (objects, directories, file header).
+/// Reading a basket that is not yet written waits for the queue.
+/// Returns 0, or -1 if a basket harvested meanwhile failed to be written.
+
+Int_t TBranch::WriteBasketAsync(TBasket* basket, Int_t where, ROOT::Internal::TBasketWriteQueue &queue)
+{
+   UpdateEntryOffsetLen(basket->GetNevBuf());
+
+   // Detach the basket from the branch: the background task only touches the basket.
+   // Several baskets of this branch can be in flight, so they cannot share the
+   // branch's transient compression buffer; WriteBuffer() allocates a private one.
+   basket->fWriteCycle = where;
+   if (!basket->fOwnsCompressedBuffer) {
+      basket->fCompressedBufferRef = nullptr;
+   }
+   fBaskets[where] = 0;
+   --fNBaskets;
+   if (basket == fCurrentBasket) {
+      fCurrentBasket    = 0;
+      fFirstBasketEntry = -1;
+      fNextBasketEntry  = -1;
+   }
+   if (where == fWriteBasket) {
+      ++fWriteBasket;
+      if (fWriteBasket >= fMaxBaskets) {
+         ExpandBasketArrays();
+      }
+      fBaskets.AddAtAndExpand(0, fWriteBasket);
+      fBasketEntry[fWriteBasket] = fEntryNumber;
+   }
+
+   TFile *file = fDirectory->GetFile();
+   basket->SetMotherDir(file);
+   auto work = [basket, file]() { return basket->CompressWriteBuffer(file); };
+   auto finish = [this, basket, file, where](Int_t nout) {
+      if (nout >= 0)
+         nout = basket->CommitWriteBuffer(file, nout);
+      if (nout < 0)
+         Error("WriteBasketAsync", "basket's WriteBuffer failed.");
+      fBasketBytes[where] = basket->GetNbytes();
+      fBasketSeek[where]  = basket->GetSeekKey();
+      if (nout > 0) {
+         Int_t addbytes = basket->GetObjlen() + basket->GetKeylen();
+         fZipBytes += nout;
+         fTotBytes += addbytes;
+         fTree->AddTotBytes(addbytes);
+         fTree->AddZipBytes(nout);
+      }
+      basket->DropBuffers();
+      delete basket;
+      return nout;
+   };
+   return queue.Push(work, finish) ? -1 : 0;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 ///set the first entry number (case of TBranchSTL)
 
@@ -5635,9 +5635,40 @@ void TBranchElement::SetReadActionSequence()
 
    if (create) {
       SetActionSequence(originalClass, localInfo, create, fReadActionSequence);
+      if (!fReadMembers.empty() && fType == 0 && fID == -1) {
+         auto projection = fReadActionSequence->CreateProjection(fReadMembers);
+         delete fReadActionSequence;
+         fReadActionSequence = projection;
+      }
    }
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Read only the listed data members of the object of an unsplit top-level
+/// branch (split level 0), all of them if the list is empty.
+///
+/// The data members not listed keep the value they have in the object, the
+/// objects and collections are skipped in the basket using their byte count
+/// and the TString using their length. The base classes and the data members
+/// of basic types are always read. This is useful to read a few data members
+/// of large objects written without splitting. The branches of collections
+/// are not supported.
+
+void TBranchElement::SetReadMembers(const std::vector<std::string> &members)
+{
+   if (fType != 0 || fID != -1) {
+      Warning("SetReadMembers", "The data members of %s are read by its sub-branches, the projection is ignored.",
+              GetName());
+      return;
+   }
+   if (fBranchClass.GetClass() && fBranchClass.GetClass()->GetCollectionProxy()) {
+      Warning("SetReadMembers", "%s is a collection, the projection is ignored.", GetName());
+      return;
+   }
+   fReadMembers = members;
+   SetReadActionSequence();
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Set the ReadLeaves pointer to execute the expected operations.
 
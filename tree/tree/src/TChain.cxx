@@ -26,8 +26,11 @@ the trees in the chain.
 
 #include "TChain.h"
 
+#include <algorithm>
 #include <iostream>
 #include <cfloat>
+#include <deque>
+#include <future>
 #include <string>
 
 #include "TBranch.h"
@@ -65,6 +68,77 @@ the trees in the chain.
 
 ClassImp(TChain);
 
+namespace ROOT {
+namespace Internal {
+
+/// The files of the next trees of a TChain, opened in the background together
+/// with the header of their tree (see TChain::SetPrefetchFiles).
+class TChainPrefetch {
+   struct RPending {
+      Int_t fTreeNumber;           ///< Number of the tree in the chain
+      std::future<TFile *> fFile;  ///< The opened file, nullptr if it could not be opened
+   };
+   std::deque<RPending> fPending;
+
+public:
+   ~TChainPrefetch() { Clear(); }
+
+   /// Wait for and close all the files being opened.
+   void Clear()
+   {
+      for (auto &pending : fPending)
+         delete pending.fFile.get();
+      fPending.clear();
+   }
+
+   /// Start opening the files of the trees `first` to `last` (included) of `files`,
+   /// unless they are already being opened.
+   void Fill(const TObjArray &files, Int_t first, Int_t last)
+   {
+      for (Int_t treenum = first; treenum <= last; ++treenum) {
+         auto isPending = [treenum](const RPending &pending) { return pending.fTreeNumber == treenum; };
+         if (std::any_of(fPending.begin(), fPending.end(), isPending))
+            continue;
+         auto element = static_cast<TChainElement *>(files.At(treenum));
+         if (!element)
+            continue;
+         std::string url(element->GetTitle());
+         std::string treename(element->GetName());
+         fPending.push_back({treenum, std::async(std::launch::async, [url, treename]() {
+            TDirectory::TContext ctxt;
+            TFile *file = TFile::Open(url.c_str());
+            // Read the tree header, the tree stays attached to the file.
+            if (file && !file->IsZombie())
+               file->Get(treename.c_str());
+            return file;
+         })});
+      }
+   }
+
+   /// If the file of tree `treenum` is being opened, wait for it, set `file` and return true.
+   /// The files opened for the trees outside of [treenum, treenum + window] are closed.
+   Bool_t Take(Int_t treenum, Int_t window, TFile *&file)
+   {
+      Bool_t found = kFALSE;
+      for (auto iter = fPending.begin(); iter != fPending.end();) {
+         if (iter->fTreeNumber == treenum) {
+            file = iter->fFile.get();
+            found = kTRUE;
+         } else if (iter->fTreeNumber < treenum || iter->fTreeNumber > treenum + window) {
+            delete iter->fFile.get();
+         } else {
+            ++iter;
+            continue;
+         }
+         iter = fPending.erase(iter);
+      }
+      return found;
+   }
+};
+
+} // namespace Internal
+} // namespace ROOT
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Default constructor.
 
@@ -190,6 +264,7 @@ TChain::~TChain()
       gROOT->GetListOfCleanups()->Remove(this);
    }
 
+   fPrefetch.reset();
    SafeDelete(fProofChain);
    fStatus->Delete();
    delete fStatus;
@@ -1507,9 +1582,13 @@ Long64_t TChain::LoadTree(Long64_t entry)
    //        if we did not delete it above.
    {
       TDirectory::TContext ctxt;
-      fFile = TFile::Open(element->GetTitle());
+      if (!fPrefetch || !fPrefetch->Take(treenum, fPrefetchFiles, fFile))
+         fFile = TFile::Open(element->GetTitle());
       if (fFile) fFile->SetBit(kMustCleanup);
    }
+   // Start opening the next files while this one is processed.
+   if (fPrefetch)
+      fPrefetch->Fill(*fFiles, treenum + 1, std::min(treenum + fPrefetchFiles, fNtrees - 1));
 
    // ----- Begin of modifications by MvL
    Int_t returnCode = 0;
@@ -1669,6 +1748,7 @@ Long64_t TChain::LoadTree(Long64_t entry)
 
    fTree->SetMakeClass(fMakeClass);
    fTree->SetMaxVirtualSize(fMaxVirtualSize);
+   fTree->SetBasketBufferPool(fBasketBufferPool);
 
    SetChainOffset(fTreeOffset[fTreeNumber]);
 
@@ -2322,6 +2402,8 @@ void TChain::RemoveFriend(TTree* oldFriend)
 
 void TChain::Reset(Option_t*)
 {
+   if (fPrefetch)
+      fPrefetch->Clear();
    delete fFile;
    fFile = 0;
    fNtrees         = 0;
@@ -2344,6 +2426,8 @@ void TChain::Reset(Option_t*)
 
 void TChain::ResetAfterMerge(TFileMergeInfo *info)
 {
+   if (fPrefetch)
+      fPrefetch->Clear();
    fNtrees         = 0;
    fTreeNumber     = -1;
    fTree           = 0;
@@ -2452,6 +2536,19 @@ void TChain::SetAutoDelete(Bool_t autodelete)
    }
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Set the size of the pool of basket buffers shared by the trees of the chain.
+/// See TTree::SetBasketBufferPoolSize.
+
+void TChain::SetBasketBufferPoolSize(Long64_t maxBytes)
+{
+   TTree::SetBasketBufferPoolSize(maxBytes);
+   if (fTree)
+      fTree->SetBasketBufferPool(fBasketBufferPool);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
 Int_t TChain::SetCacheSize(Long64_t cacheSize)
 {
    // Set the cache size of the underlying TTree,
@@ -2987,6 +3084,28 @@ void TChain::SetPacketSize(Int_t size)
    }
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Set the number of files of the chain that are opened in the background ahead of
+/// the current one.
+///
+/// When LoadTree switches to a new tree, the files of the next `nfiles` trees are opened,
+/// and the header of their tree is read, while the current tree is processed. The switch
+/// to one of these files then does not wait for it to be opened, which hides the latency
+/// of remote files. A value of 0 (the default) disables the prefetching.
+/// Enables ROOT's thread safety if `nfiles` > 0.
+
+void TChain::SetPrefetchFiles(Int_t nfiles)
+{
+   fPrefetchFiles = nfiles > 0 ? nfiles : 0;
+   if (fPrefetchFiles) {
+      ROOT::EnableThreadSafety();
+      if (!fPrefetch)
+         fPrefetch.reset(new ROOT::Internal::TChainPrefetch);
+   } else {
+      fPrefetch.reset();
+   }
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Enable/Disable PROOF processing on the current default Proof (gProof).
 ///
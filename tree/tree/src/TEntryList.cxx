@@ -1322,13 +1322,21 @@ void TEntryList::Subtract(const TEntryList *elist)
          //second list is also only for 1 tree
          if (!strcmp(elist->fTreeName.Data(),fTreeName.Data()) &&
              !strcmp(elist->fFileName.Data(),fFileName.Data())){
-            //same tree
-            Long64_t n2 = elist->GetN();
-            Long64_t entry;
-            for (Int_t i=0; i<n2; i++){
-               entry = (const_cast<TEntryList*>(elist))->GetEntry(i);
-               Remove(entry);
+            //same tree, subtract block by block
+            if (!elist->fBlocks) return;
+            TEntryListBlock *block1=0;
+            TEntryListBlock *block2=0;
+            Int_t nmin = TMath::Min(fNBlocks, elist->fNBlocks);
+            Long64_t nnew, nold;
+            for (Int_t i=0; i<nmin; i++){
+               block1 = (TEntryListBlock*)fBlocks->UncheckedAt(i);
+               block2 = (TEntryListBlock*)elist->fBlocks->UncheckedAt(i);
+               nold = block1->GetNPassed();
+               nnew = block1->Subtract(block2);
+               fN = fN - nold + nnew;
             }
+            fLastIndexQueried = -1;
+            fLastIndexReturned = 0;
          } else {
             //different trees
             return;
@@ -38,6 +38,7 @@ End_Macro
  - __Merge__() - adds all entries from one block to the other. If the first block
              uses array representation, it's changed to bits representation only
              if the total number of passing entries is still less than kBlockSize
+ - __Subtract__() - removes all entries of the other block from this one.
  - __GetEntry(n)__ - returns n-th non-zero entry.
  - __Next__()      - return next non-zero entry. In case of representation 1), Next()
                  is faster than GetEntry()
@@ -46,8 +47,32 @@ End_Macro
 #include "TEntryListBlock.h"
 #include "TString.h"
 
+#include <algorithm>
+
 ClassImp(TEntryListBlock);
 
+namespace {
+
+/// Number of bits set in a word of the bits representation
+inline Int_t CountBits(UInt_t word)
+{
+   word = word - ((word >> 1) & 0x5555);
+   word = (word & 0x3333) + ((word >> 2) & 0x3333);
+   word = (word + (word >> 4)) & 0x0F0F;
+   return (word + (word >> 8)) & 0x1F;
+}
+
+/// Position of the lowest bit set in a non-zero word
+inline Int_t FirstBit(UInt_t word)
+{
+   Int_t j = 0;
+   while ((word & (1 << j)) == 0)
+      j++;
+   return j;
+}
+
+} // anonymous namespace
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Default c-tor
 
@@ -206,34 +231,15 @@ Int_t TEntryListBlock::Contains(Int_t entry)
       Bool_t result = (fIndices[i] & (1<<j))!=0;
       return result;
    }
-   //list
-   if (entry < fCurrent) fCurrent = 0;
-   if (fPassing && fIndices){
-      for (Int_t i = fCurrent; i<fNPassed; i++){
-         if (fIndices[i]==entry){
-            fCurrent = i;
-            return kTRUE;
-         }
-      }
-   } else {
-      if (!fIndices || fNPassed==0){
-         //all entries pass
-         return kTRUE;
-      }
-      if (entry > fIndices[fNPassed-1])
-         return kTRUE;
-      for (Int_t i= fCurrent; i<fNPassed; i++){
-         if (fIndices[i]==entry){
-            fCurrent = i;
-            return kFALSE;
-         }
-         if (fIndices[i]>entry){
-            fCurrent = i;
-            return kTRUE;
-         }
-      }
+   //list, sorted: binary search
+   if (!fPassing && (!fIndices || fNPassed==0)){
+      //all entries pass
+      return kTRUE;
    }
-   return 0;
+   UShort_t *found = std::lower_bound(fIndices, fIndices + fNPassed, entry);
+   fCurrent = found - fIndices;
+   Bool_t inlist = found != fIndices + fNPassed && *found == entry;
+   return fPassing ? inlist : !inlist;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -242,10 +248,12 @@ Int_t TEntryListBlock::Contains(Int_t entry)
 
 Int_t TEntryListBlock::Merge(TEntryListBlock *block)
 {
-   Int_t i, j;
+   Int_t i;
    if (block->GetNPassed() == 0) return GetNPassed();
    if (GetNPassed() == 0){
       //this block is empty
+      if (fIndices)
+         delete [] fIndices;
       fN = block->fN;
       fIndices = new UShort_t[fN];
       for (i=0; i<fN; i++)
@@ -260,101 +268,62 @@ Int_t TEntryListBlock::Merge(TEntryListBlock *block)
    }
    if (fType==0){
       //stored as bits
-      if (block->fType == 0){
-         for (i=0; i<kBlockSize*16; i++){
-            if (block->Contains(i))
-               Enter(i);
+      if (block->fType == 1 && block->fPassing){
+         //the other block stores entries that pass
+         for (i=0; i<block->fNPassed; i++){
+            Enter(block->fIndices[i]);
          }
       } else {
-         if (block->fPassing){
-            //the other block stores entries that pass
-            for (i=0; i<block->fNPassed; i++){
-               Enter(block->fIndices[i]);
-            }
-         } else {
-            //the other block stores entries that don't pass
-            if (block->fNPassed==0){
-               for (i=0; i<kBlockSize*16; i++){
-                  Enter(i);
-               }
-            }
-            for (j=0; j<block->fIndices[0]; j++)
-               Enter(j);
-            for (i=0; i<block->fNPassed-1; i++){
-               for (j=block->fIndices[i]+1; j<block->fIndices[i+1]; j++){
-                  Enter(j);
-               }
-            }
-            for (j=block->fIndices[block->fNPassed-1]+1; j<kBlockSize*16; j++)
-               Enter(j);
+         //or the words of both bits representations
+         TEntryListBlock *bitsblock = block;
+         if (block->fType != 0){
+            bitsblock = new TEntryListBlock(*block);
+            bitsblock->Transform(1, new UShort_t[kBlockSize]);
          }
+         fNPassed = 0;
+         for (i=0; i<kBlockSize; i++){
+            fIndices[i] |= bitsblock->fIndices[i];
+            fNPassed += CountBits(fIndices[i]);
+         }
+         if (bitsblock != block)
+            delete bitsblock;
       }
    } else {
       //stored as a list
-      if (GetNPassed() + block->GetNPassed() > kBlockSize){
+      if (block->fType == 0 || GetNPassed() + block->GetNPassed() > kBlockSize){
          //change to bits
          UShort_t *bits = new UShort_t[kBlockSize];
          Transform(1, bits);
          Merge(block);
       } else {
          //this is only possible if fPassing=1 in both blocks
-         if (block->fType==1){
-            //second block stored as a list
-            //make a bigger list
-            Int_t en = block->fNPassed;
-            Int_t newsize = fNPassed + en;
-            UShort_t *newlist = new UShort_t[newsize];
-            UShort_t *elst = block->fIndices;
-            Int_t newpos, elpos;
-            newpos = elpos = 0;
-            for (i=0; i<fNPassed; i++) {
-               while (elpos < en && fIndices[i] > elst[elpos]) {
-                  newlist[newpos] = elst[elpos];
-                  newpos++;
-                  elpos++;
-               }
-               if (fIndices[i] == elst[elpos]) elpos++;
-               newlist[newpos] = fIndices[i];
-               newpos++;
-            }
-            while (elpos < en) {
+         //second block stored as a list
+         //make a bigger list
+         Int_t en = block->fNPassed;
+         Int_t newsize = fNPassed + en;
+         UShort_t *newlist = new UShort_t[newsize];
+         UShort_t *elst = block->fIndices;
+         Int_t newpos, elpos;
+         newpos = elpos = 0;
+         for (i=0; i<fNPassed; i++) {
+            while (elpos < en && fIndices[i] > elst[elpos]) {
                newlist[newpos] = elst[elpos];
                newpos++;
                elpos++;
             }
-            delete [] fIndices;
-            fIndices = newlist;
-            fNPassed = newpos;
-            fN = fNPassed;
-         } else {
-            //second block is stored as bits
-
-            Int_t en = block->fNPassed;
-            Int_t newsize = fNPassed + en;
-            UShort_t *newlist = new UShort_t[newsize];
-            Int_t newpos, current;
-            newpos = current = 0;
-            for (i=0; i<kBlockSize*16; i++){
-               if (!block->Contains(i)) continue;
-               while(current < fNPassed && fIndices[current]<i){
-                  newlist[newpos] = fIndices[current];
-                  current++;
-                  newpos++;
-               }
-               if (fIndices[current]==i) current++;
-               newlist[newpos] = i;
-               newpos++;
-            }
-            while(current<fNPassed){
-               newlist[newpos] = fIndices[current];
-               newpos++;
-               current++;
-            }
-            delete [] fIndices;
-            fIndices = newlist;
-            fNPassed = newpos;
-            fN = fNPassed;
+            if (elpos < en && fIndices[i] == elst[elpos]) elpos++;
+            newlist[newpos] = fIndices[i];
+            newpos++;
+         }
+         while (elpos < en) {
+            newlist[newpos] = elst[elpos];
+            newpos++;
+            elpos++;
          }
+         delete [] fIndices;
+         fIndices = newlist;
+         fNPassed = newpos;
+         fN = fNPassed;
       }
    }
    fLastIndexQueried = -1;
@@ -363,6 +332,44 @@ Int_t TEntryListBlock::Merge(TEntryListBlock *block)
    return GetNPassed();
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Remove the entries of the other block from this one
+/// Returns the resulting number of entries in the block
+
+Int_t TEntryListBlock::Subtract(TEntryListBlock *block)
+{
+   Int_t i;
+   if (GetNPassed() == 0 || block->GetNPassed() == 0) return GetNPassed();
+   if (fType != 0){
+      //change to bits
+      UShort_t *bits = new UShort_t[kBlockSize];
+      Transform(1, bits);
+   }
+   if (block->fType == 1 && block->fPassing){
+      //the other block stores entries that pass
+      for (i=0; i<block->fNPassed; i++)
+         Remove(block->fIndices[i]);
+   } else {
+      //clear the bits set in the other block
+      TEntryListBlock *bitsblock = block;
+      if (block->fType != 0){
+         bitsblock = new TEntryListBlock(*block);
+         bitsblock->Transform(1, new UShort_t[kBlockSize]);
+      }
+      fNPassed = 0;
+      for (i=0; i<kBlockSize; i++){
+         fIndices[i] &= bitsblock->fIndices[i] ^ 0xFFFF;
+         fNPassed += CountBits(fIndices[i]);
+      }
+      if (bitsblock != block)
+         delete bitsblock;
+   }
+   fLastIndexQueried = -1;
+   fLastIndexReturned = -1;
+   OptimizeStorage();
+   return GetNPassed();
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Returns the number of entries, passing the selection.
 /// In case, when the block stores entries that pass (fPassing=1) returns fNPassed
@@ -382,19 +389,23 @@ Int_t TEntryListBlock::GetNPassed()
 Int_t TEntryListBlock::GetEntry(Int_t entry)
 {
    if (entry > kBlockSize*16) return -1;
-   if (entry > GetNPassed()) return -1;
+   if (entry >= GetNPassed()) return -1;
    if (entry == fLastIndexQueried+1) return Next();
    else {
-      Int_t i=0; Int_t j=0; Int_t entries_found=0;
+      Int_t i=0; Int_t j=0;
       if (fType==0){
-         if ((fIndices[i] & (1<<j))!=0)
-            entries_found++;
-         while (entries_found<entry+1){
-            if (j==15){i++; j=0;}
-            else j++;
-            if ((fIndices[i] & (1<<j))!=0)
-               entries_found++;
+         //skip the words with less bits set than the entries left
+         Int_t left = entry;
+         Int_t nbits = CountBits(fIndices[0]);
+         while (left >= nbits){
+            left -= nbits;
+            i++;
+            nbits = CountBits(fIndices[i]);
          }
+         UInt_t word = fIndices[i];
+         for (; left>0; left--)
+            word &= word-1;
+         j = FirstBit(word);
          fLastIndexQueried = entry;
          fLastIndexReturned = i*16+j;
          return fLastIndexReturned;
@@ -411,29 +422,11 @@ Int_t TEntryListBlock::GetEntry(Int_t entry)
                fLastIndexReturned = entry;
                return fLastIndexReturned;
             }
-            for (i=0; i<fIndices[0]; i++){
-               entries_found++;
-               if (entries_found==entry+1){
-                  fLastIndexReturned = i;
-                  return fLastIndexReturned;
-               }
-            }
-            for (i=0; i<fNPassed-1; i++){
-               for (j=fIndices[i]+1; j<fIndices[i+1]; j++){
-                  entries_found++;
-                  if (entries_found==entry+1){
-                     fLastIndexReturned = j;
-                     return fLastIndexReturned;
-                  }
-               }
-            }
-            for (j=fIndices[fNPassed-1]+1; j<kBlockSize*16; j++){
-               entries_found++;
-               if (entries_found==entry+1){
-                  fLastIndexReturned = j;
-                  return fLastIndexReturned;
-               }
-            }
+            //shift by the sorted entries that don't pass, up to the result
+            fLastIndexReturned = entry;
+            for (i=0; i<fNPassed && fIndices[i]<=fLastIndexReturned; i++)
+               fLastIndexReturned++;
+            return fLastIndexReturned;
          }
       }
       return -1;
@@ -453,19 +446,13 @@ Int_t TEntryListBlock::Next()
    }
 
    if (fType==0) {
-      //bits
-      Int_t i=0;
-      Int_t j=0;
+      //bits, skipping the empty words
       fLastIndexReturned++;
-      i = fLastIndexReturned>>4;
-      j = fLastIndexReturned & 15;
-      Bool_t result=(fIndices[i] & (1<<j))!=0;
-      while (!result) {
-         if (j==15) {j=0; i++;}
-         else j++;
-         result = (fIndices[i] & (1<<j)) != 0;
-      }
-      fLastIndexReturned = i*16+j;
+      Int_t i = fLastIndexReturned>>4;
+      UInt_t word = fIndices[i] & (0xFFFF << (fLastIndexReturned & 15));
+      while (!word)
+         word = fIndices[++i];
+      fLastIndexReturned = i*16+FirstBit(word);
       fLastIndexQueried++;
       return fLastIndexReturned;
 
@@ -567,21 +554,16 @@ void TEntryListBlock::Transform(Bool_t dir, UShort_t *indexnew)
    Int_t ilist = 0;
    Int_t ibite, ibit;
    if (!dir) {
-         for (i=0; i<kBlockSize*16; i++){
-            ibite = i >> 4;
-            ibit = i & 15;
-            Bool_t result = (fIndices[ibite] & (1<<ibit))!=0;
-            if (result && fPassing){
-               //fill with the entries that pass
-               indexnew[ilist] = i;
-               ilist++;
-            }
-            else if (!result && !fPassing){
-               //fill with the entries that don't pass
-               indexnew[ilist] = i;
-               ilist++;
-            }
+      //fill with the entries that pass, or with the ones that don't pass
+      for (ibite=0; ibite<kBlockSize; ibite++){
+         UInt_t word = fPassing ? fIndices[ibite] : fIndices[ibite] ^ 0xFFFF;
+         while (word){
+            ibit = FirstBit(word);
+            indexnew[ilist] = (ibite << 4) + ibit;
+            ilist++;
+            word &= word-1;
          }
+      }
       if (fIndices)
          delete [] fIndices;
       fIndices = indexnew;
@@ -46,6 +46,14 @@ using namespace ROOT;
  *
  * The method `TTree::SetIOFeatures` creates a copy of the feature set; subsequent changes
  * to the `TIOFeatures` object do not propagate to the `TTree`.
+ *
+ * The experimental features are:
+ *  - `kGenerateOffsetMap`: do not store the entry offsets if they can be regenerated on read;
+ *    otherwise store the entry sizes (i.e. delta-encoded offsets), which compress better.
+ *  - `kByteSplit`: for branches with a single leaf of basic numeric type (also variable-size
+ *    arrays), regroup the bytes of the values -- and of the stored offsets -- by significance
+ *    before compression, as RNTuple's split encodings do.  Smooth data then compresses better
+ *    and faster.
  */
 
 
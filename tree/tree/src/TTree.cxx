@@ -424,10 +424,12 @@ End_Macro
 #include "TSchemaRuleSet.h"
 #include "TFileMergeInfo.h"
 #include "ROOT/StringConv.hxx"
+#include "ROOT/TBasketBufferPool.hxx"
 #include "TVirtualMutex.h"
 #include "strlcpy.h"
 #include "snprintf.h"
 
+#include "TBasketWriteQueue.h"
 #include "TBranchIMTHelper.h"
 #include "TNotifyLink.h"
 
@@ -919,6 +921,11 @@ TTree::TTree(const char* name, const char* title, Int_t splitlevel /* = 99 */,
 
 TTree::~TTree()
 {
+   if (fBasketWriteQueue) {
+      WaitPendingBaskets();
+      delete fBasketWriteQueue;
+      fBasketWriteQueue = nullptr;
+   }
    if (auto link = dynamic_cast<TNotifyLinkBase*>(fNotify)) {
       link->Clear();
    }
@@ -3566,10 +3573,11 @@ Long64_t TTree::CopyEntries(TTree* tree, Long64_t nentries /* = -1 */, Option_t*
             if (cacheSize != -1) cloner.SetCacheSize(cacheSize);
             cloner.Exec();
          } else {
-            if (i == 0) {
+            if (i == 0 && !cloner.NeedConversion()) {
                Warning("CopyEntries","%s",cloner.GetWarning());
                // If the first cloning does not work, something is really wrong
                // (since apriori the source and target are exactly the same structure!)
+               // unless the baskets are compressed with the dictionary of their file, see TTreeCloner.
                return -1;
             } else {
                if (cloner.NeedConversion()) {
@@ -3679,6 +3687,10 @@ Long64_t TTree::CopyEntries(TTree* tree, Long64_t nentries /* = -1 */, Option_t*
 /// Example macro to copy a subset of a tree to a new tree.
 /// Only selected entries are copied to the new tree.
 /// NOTE that only the active branches are copied.
+///
+/// If option contains "fast", the clusters in which all the entries are
+/// selected are copied without decompressing their baskets, see
+/// TTreePlayer::CopyTree.
 
 TTree* TTree::CopyTree(const char* selection, Option_t* option /* = 0 */, Long64_t nentries /* = TTree::kMaxEntries */, Long64_t firstentry /* = 0 */)
 {
@@ -4094,6 +4106,16 @@ Long64_t TTree::Draw(const char* varexp, const TCut& selection, Option_t* option
 /// will not reset `hsqrt`, but will continue filling. This works for 1-D, 2-D
 /// and 3-D histograms.
 ///
+/// ### Filling histograms in parallel
+///
+/// If the implicit multi-threading is enabled (see ROOT::EnableImplicitMT),
+/// 1-D and 2-D histograms and profiles with fixed axes, e.g. given by `>>hnew(...)`
+/// or by an existing histogram, are filled in parallel by clusters of entries
+/// when all the entries of a tree or chain read from files are drawn, and when
+/// there are more entries than the estimate of the tree (see TTree::SetEstimate).
+/// In that case, GetV1(), GetV2(), ... do not return the values of the variables.
+/// This applies to TTree::Project as well.
+///
 /// ### Accessing collection objects
 ///
 /// TTree::Draw default's handling of collections is to assume that any
@@ -4577,8 +4599,13 @@ Int_t TTree::Fill()
    if (fBranchRef)
       fBranchRef->Clear();
 
+   // Do the bookkeeping of the baskets written in the background meanwhile.
+   if (fBasketWriteQueue)
+      nerror += fBasketWriteQueue->Harvest(false);
+
 #ifdef R__USE_IMT
-   const auto useIMT = ROOT::IsImplicitMTEnabled() && fIMTEnabled;
+   // Baskets written in the background do not need to be waited for at the end of Fill().
+   const auto useIMT = ROOT::IsImplicitMTEnabled() && fIMTEnabled && !fBasketWriteQueue;
    ROOT::Internal::TBranchIMTHelper imtHelper;
    if (useIMT) {
       fIMTFlush = true;
@@ -5103,7 +5130,7 @@ Int_t TTree::FlushBasketsImpl() const
 {
    if (!fDirectory) return 0;
    Int_t nbytes = 0;
-   Int_t nerror = 0;
+   Int_t nerror = WaitPendingBaskets();
    TObjArray *lb = const_cast<TTree*>(this)->GetListOfBranches();
    Int_t nb = lb->GetEntriesFast();
 
@@ -5155,7 +5182,7 @@ Int_t TTree::FlushBasketsImpl() const
       const_cast<TTree*>(this)->AddTotBytes(fIMTTotBytes);
       const_cast<TTree*>(this)->AddZipBytes(fIMTZipBytes);
 
-      return nerrpar ? -1 : nbpar.load();
+      return (nerrpar || nerror) ? -1 : nbpar.load();
    }
 #endif
    for (Int_t j = 0; j < nb; j++) {
@@ -7954,6 +7981,7 @@ void TTree::RemoveFriend(TTree* oldFriend)
 
 void TTree::Reset(Option_t* option)
 {
+   WaitPendingBaskets();
    fNotify        = 0;
    fEntries       = 0;
    fNClusterRange = 0;
@@ -7985,6 +8013,7 @@ void TTree::Reset(Option_t* option)
 
 void TTree::ResetAfterMerge(TFileMergeInfo *info)
 {
+   WaitPendingBaskets();
    fEntries       = 0;
    fNClusterRange = 0;
    fTotBytes      = 0;
@@ -8288,6 +8317,32 @@ void TTree::SetAutoSave(Long64_t autos)
    fAutoSave = autos;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Keep the memory buffers of the baskets read from this tree, up to `maxBytes`
+/// bytes, to reuse them instead of allocating new ones.
+///
+/// The buffers of the baskets that are dropped (when reading past the baskets
+/// kept in memory, see SetMaxVirtualSize, or when the branches are deleted) are
+/// returned to the pool, and the baskets read next take their buffers from it.
+/// With a TTreeCache unzipping the baskets in parallel (TTreeCacheUnzip), the
+/// unzipped buffers are taken from the pool too. The pool can be shared between
+/// trees with SetBasketBufferPool, for example by the trees of a TChain whose
+/// buffers are then reused from one file to the next.
+///
+/// A value of 0 (or less) releases the pool and its buffers. Statistics on the
+/// reuse of the buffers are given by GetBasketBufferPool()->GetStats().
+
+void TTree::SetBasketBufferPoolSize(Long64_t maxBytes)
+{
+   if (maxBytes <= 0) {
+      fBasketBufferPool.reset();
+   } else if (fBasketBufferPool) {
+      fBasketBufferPool->SetMaxBytes(maxBytes);
+   } else {
+      fBasketBufferPool = std::make_shared<ROOT::Internal::TBasketBufferPool>(maxBytes);
+   }
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Set a branch's basket size.
 ///
@@ -9124,6 +9179,65 @@ void TTree::SetMakeClass(Int_t make)
    }
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Let TTree::Fill hand full baskets to background tasks for compression,
+/// with at most `maxPending` baskets in flight.
+///
+/// Fill() then returns without waiting for the compression of the baskets it
+/// filled up; it only blocks when `maxPending` baskets are still pending.
+/// The tasks run in ROOT's implicit multi-threading thread pool, which must be
+/// enabled (ROOT::EnableImplicitMT()). The compressed baskets are written to
+/// the file by the filling thread, in the order they filled up, when the tree
+/// collects them (at the start of Fill() and in the cases below). The file is
+/// therefore only ever written by the filling thread, and objects can be
+/// written to it while baskets are pending.
+///
+/// The pending baskets are waited for whenever the tree flushes its baskets
+/// (TTree::FlushBaskets, auto-flush, TTree::Write, TTree::AutoSave with option
+/// "flushbaskets"), when a basket not yet written is read back, on TTree::Reset
+/// and on destruction. Until then, the byte counters (TTree::GetZipBytes etc.)
+/// do not include the pending baskets, which can delay a size-based auto-flush.
+///
+/// A value of 0 (or less) restores the default synchronous writing.
+
+void TTree::SetMaxPendingBaskets(Int_t maxPending)
+{
+   if (fBasketWriteQueue) {
+      WaitPendingBaskets();
+      delete fBasketWriteQueue;
+      fBasketWriteQueue = nullptr;
+   }
+   if (maxPending <= 0)
+      return;
+#ifdef R__USE_IMT
+   if (!ROOT::IsImplicitMTEnabled()) {
+      Warning("SetMaxPendingBaskets", "Implicit multi-threading is not enabled; baskets are written synchronously.");
+      return;
+   }
+   fBasketWriteQueue = new ROOT::Internal::TBasketWriteQueue(maxPending);
+#else
+   Warning("SetMaxPendingBaskets", "ROOT was built without implicit multi-threading; baskets are written synchronously.");
+#endif
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return the maximum number of baskets written in the background by TTree::Fill,
+/// 0 if baskets are written synchronously. See SetMaxPendingBaskets.
+
+Int_t TTree::GetMaxPendingBaskets() const
+{
+   return fBasketWriteQueue ? fBasketWriteQueue->GetMaxPending() : 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Wait for the baskets written in the background and do their bookkeeping.
+/// Returns the number of baskets that failed to be written.
+
+Int_t TTree::WaitPendingBaskets() const
+{
+   return fBasketWriteQueue ? fBasketWriteQueue->Harvest(true) : 0;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Set the maximum size in bytes of a Tree file (static function).
 /// The default size is 100000000000LL, ie 100 Gigabytes.
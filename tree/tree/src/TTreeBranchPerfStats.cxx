@@ -0,0 +1,252 @@
+// @(#)root/tree:$Id$
+
+/*************************************************************************
+ * Copyright (C) 1995-2021, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+/** \class TTreeBranchPerfStats
+\ingroup tree
+
+Per-branch I/O performance measurement.
+
+While started, the object collects for every branch read, in any thread and any TTree:
+  - the number of baskets read, with their compressed and uncompressed sizes;
+  - the time spent getting the baskets from the TTreeCache or the file, and decompressing them;
+  - the time spent deserializing the entries, i.e. in the streamers of the branch;
+  - how many of the baskets were found in the TTreeCache, and the time spent reading the ones it missed.
+
+The branches are identified by their name, so that the measurements of the trees of a TChain, and of the trees
+that TTreeProcessorMT and RDataFrame open in each of their tasks, add up:
+~~~{.cpp}
+TTreeBranchPerfStats stats;
+stats.Start();
+ROOT::RDataFrame df("events", {"f1.root", "f2.root"});
+df.Histo1D("px")->Draw();
+stats.Stop();
+stats.Print();
+~~~
+
+The branches with a large streamer time and little compression are the candidates for a different split level or
+to be dropped; those with a large unzip time compared to their streamer time for a faster compression algorithm.
+
+The time of the baskets decompressed in advance by TTreeCacheUnzip is not attributed to the branches: their
+baskets count as TTreeCache hits, with no unzip time.
+
+Only one TTreeBranchPerfStats object collects the events at a time. Each thread records into its own slot; the
+object must only be stopped, printed, reset or destroyed when no tree is being read.
+*/
+
+#include "TTreeBranchPerfStats.h"
+
+#include "TBranch.h"
+#include "TString.h"
+
+#include <algorithm>
+#include <iostream>
+
+ClassImp(TTreeBranchPerfStats);
+
+std::atomic<TTreeBranchPerfStats *> TTreeBranchPerfStats::fgActive{nullptr};
+
+namespace {
+
+std::atomic<std::uint64_t> gLastId{0};
+
+/// The slot of the calling thread in the object it was last used with
+struct ThreadSlot {
+   std::uint64_t fOwnerId = 0;
+   void *fSlot = nullptr;
+};
+
+thread_local ThreadSlot tThreadSlot;
+
+} // anonymous namespace
+
+TTreeBranchPerfStats::BranchInfo &TTreeBranchPerfStats::BranchInfo::operator+=(const BranchInfo &other)
+{
+   fBaskets += other.fBaskets;
+   fBytesCompressed += other.fBytesCompressed;
+   fBytesUncompressed += other.fBytesUncompressed;
+   fEntries += other.fEntries;
+   fReadTime += other.fReadTime;
+   fUnzipTime += other.fUnzipTime;
+   fStreamerTime += other.fStreamerTime;
+   fCacheHits += other.fCacheHits;
+   fCacheMisses += other.fCacheMisses;
+   fCacheMissTime += other.fCacheMissTime;
+   return *this;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Create a stopped object.
+
+TTreeBranchPerfStats::TTreeBranchPerfStats(const char *name)
+   : TNamed(name, "Per-branch TTree I/O performance"), fId(++gLastId)
+{
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Stop collecting the events if needed.
+
+TTreeBranchPerfStats::~TTreeBranchPerfStats()
+{
+   Stop();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Start collecting the events of all the threads. Another object that was collecting them stops.
+
+void TTreeBranchPerfStats::Start()
+{
+   fgActive = this;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Stop collecting the events; the measurements are kept.
+
+void TTreeBranchPerfStats::Stop()
+{
+   TTreeBranchPerfStats *expected = this;
+   fgActive.compare_exchange_strong(expected, nullptr);
+}
+
+TTreeBranchPerfStats::Slot &TTreeBranchPerfStats::GetSlot()
+{
+   if (tThreadSlot.fOwnerId != fId) {
+      std::lock_guard<std::mutex> guard(fLock);
+      fSlots.emplace_back(new Slot);
+      tThreadSlot.fOwnerId = fId;
+      tThreadSlot.fSlot = fSlots.back().get();
+   }
+   return *static_cast<Slot *>(tThreadSlot.fSlot);
+}
+
+TTreeBranchPerfStats::BranchInfo &TTreeBranchPerfStats::GetInfo(TBranch *branch)
+{
+   auto &slot = GetSlot();
+   auto &namedInfo = slot.fBranchInfos[branch];
+   // The name is compared too: a branch of the next tree of a chain can reuse the address of a deleted one
+   if (!namedInfo || namedInfo->first != branch->GetName())
+      namedInfo = &*slot.fInfos.emplace(branch->GetName(), BranchInfo()).first;
+   return namedInfo->second;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Record the reading of a basket of the branch, called by TBasket::ReadBasketBuffers.
+/// \param[in] branch The branch of the basket.
+/// \param[in] compressedBytes The size of the basket on file.
+/// \param[in] uncompressedBytes The size of the basket in memory.
+/// \param[in] readTime The seconds spent getting the basket from the TTreeCache or the file.
+/// \param[in] unzipTime The seconds spent decompressing the basket.
+/// \param[in] status Whether the basket was found in the TTreeCache, if any.
+
+void TTreeBranchPerfStats::BasketEvent(TBranch *branch, Int_t compressedBytes, Int_t uncompressedBytes,
+                                       Double_t readTime, Double_t unzipTime, ECacheStatus status)
+{
+   auto &info = GetInfo(branch);
+   ++info.fBaskets;
+   info.fBytesCompressed += compressedBytes;
+   info.fBytesUncompressed += uncompressedBytes;
+   info.fReadTime += readTime;
+   info.fUnzipTime += unzipTime;
+   if (status == kCacheHit) {
+      ++info.fCacheHits;
+   } else if (status == kCacheMiss) {
+      ++info.fCacheMisses;
+      info.fCacheMissTime += readTime;
+   }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Record the deserialization of an entry of the branch, called by TBranch::GetEntry.
+
+void TTreeBranchPerfStats::StreamerEvent(TBranch *branch, Double_t streamerTime)
+{
+   auto &info = GetInfo(branch);
+   ++info.fEntries;
+   info.fStreamerTime += streamerTime;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// The measurements of all the threads, by branch name.
+
+std::map<std::string, TTreeBranchPerfStats::BranchInfo> TTreeBranchPerfStats::GetBranchInfos() const
+{
+   std::map<std::string, BranchInfo> result;
+   std::lock_guard<std::mutex> guard(fLock);
+   for (const auto &slot : fSlots) {
+      for (const auto &info : slot->fInfos)
+         result[info.first] += info.second;
+   }
+   return result;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// The measurements of the branches of that name; all zeros if it was not read.
+
+TTreeBranchPerfStats::BranchInfo TTreeBranchPerfStats::GetBranchInfo(const char *branchName) const
+{
+   BranchInfo result;
+   std::lock_guard<std::mutex> guard(fLock);
+   for (const auto &slot : fSlots) {
+      auto itr = slot->fInfos.find(branchName);
+      if (itr != slot->fInfos.end())
+         result += itr->second;
+   }
+   return result;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Print a table of the branches, the most expensive first.
+
+void TTreeBranchPerfStats::Print(Option_t *) const
+{
+   const auto infos = GetBranchInfos();
+   std::vector<std::pair<std::string, BranchInfo>> sorted(infos.begin(), infos.end());
+   std::sort(sorted.begin(), sorted.end(),
+             [](const std::pair<std::string, BranchInfo> &a, const std::pair<std::string, BranchInfo> &b) {
+                return a.second.GetTotalTime() > b.second.GetTotalTime();
+             });
+
+   std::size_t nameWidth = 6;
+   for (const auto &entry : sorted)
+      nameWidth = std::max(nameWidth, entry.first.size());
+
+   BranchInfo total;
+   std::cout << TString::Format("%-*s %8s %12s %8s %10s %10s %10s %10s %8s %8s %10s\n", int(nameWidth), "Branch",
+                                "Baskets", "Compressed", "Ratio", "Entries", "Read[s]", "Unzip[s]", "Stream[s]",
+                                "Hits", "Misses", "Miss[s]");
+   for (const auto &entry : sorted) {
+      const auto &info = entry.second;
+      total += info;
+      std::cout << TString::Format(
+         "%-*s %8lld %12lld %8.2f %10lld %10.4f %10.4f %10.4f %8lld %8lld %10.4f\n", int(nameWidth),
+         entry.first.c_str(), info.fBaskets, info.fBytesCompressed,
+         info.fBytesCompressed ? double(info.fBytesUncompressed) / info.fBytesCompressed : 0., info.fEntries,
+         info.fReadTime, info.fUnzipTime, info.fStreamerTime, info.fCacheHits, info.fCacheMisses,
+         info.fCacheMissTime);
+   }
+   const Long64_t nCached = total.fCacheHits + total.fCacheMisses;
+   std::cout << TString::Format("Total: %lld baskets, %lld bytes read, %.4f s read, %.4f s unzip, %.4f s streamers",
+                                total.fBaskets, total.fBytesCompressed, total.fReadTime, total.fUnzipTime,
+                                total.fStreamerTime);
+   if (nCached)
+      std::cout << TString::Format(", TTreeCache hit rate %.1f%%", 100. * total.fCacheHits / nCached);
+   std::cout << std::endl;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Discard the measurements.
+
+void TTreeBranchPerfStats::Reset()
+{
+   std::lock_guard<std::mutex> guard(fLock);
+   for (auto &slot : fSlots) {
+      slot->fInfos.clear();
+      slot->fBranchInfos.clear();
+   }
+}
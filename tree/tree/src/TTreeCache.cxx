@@ -20,6 +20,7 @@
 - [General Description](\ref description)
 - [Changes in behaviour](\ref changesbehaviour)
 - [Self-optimization](\ref cachemisses)
+- [Access profiles](\ref accessprofile)
 - [Examples of usage](\ref examples)
 - [Check performance and stats](\ref checkPerf)
 
@@ -129,6 +130,25 @@ Additionally, on the first miss of an event, we must iterate through all the
 This can be potentially a CPU-expensive operation compared to, e.g., the
 latency of a SSD.  This is why the miss cache is currently disabled by default.
 
+\anchor accessprofile
+## Skipping the learning phase with an access profile
+
+The branches learned by a cache, in the order in which they were first read,
+can be saved with SaveAccessProfile() into a text file, one branch name per
+line. A later job can load the file with LoadAccessProfile(): the listed
+branches are added to the cache and the learning phase is stopped, so that
+the cache prefetches the right baskets from the very first entry.
+If the resource TTreeCache.AccessProfile or the environment variable
+ROOT_TTREECACHE_PROFILE point to an existing profile, every newly created
+TTreeCache loads it automatically. This is useful, for instance, for jobs
+that open many small files one by one.
+~~~ {.cpp}
+    // first job, at the end of the event loop
+    tree->GetReadCache(file)->SaveAccessProfile("profile.txt");
+    // later jobs
+    tree->GetReadCache(file, kTRUE)->LoadAccessProfile("profile.txt");
+~~~
+
 \anchor examples
 ## Example usages of TTreeCache
 
@@ -300,6 +320,8 @@ myTreeOrChain.GetTree()->PrintCacheStats();
 #include "TBranchCacheInfo.h"
 #include "TVirtualPerfStats.h"
 #include <limits.h>
+#include <fstream>
+#include <string>
 
 Int_t TTreeCache::fgLearnEntries = 100;
 
@@ -322,6 +344,12 @@ TTreeCache::TTreeCache(TTree *tree, Int_t buffersize)
    fEntryNext = fEntryMin + fgLearnEntries;
    Int_t nleaves = tree->GetListOfLeaves()->GetEntriesFast();
    fBranches = new TObjArray(nleaves);
+
+   const char *profile = gSystem->Getenv("ROOT_TTREECACHE_PROFILE");
+   if (!profile || !*profile)
+      profile = gEnv->GetValue("TTreeCache.AccessProfile", "");
+   if (*profile && !gSystem->AccessPathName(profile))
+      LoadAccessProfile(profile);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -1863,6 +1891,75 @@ Int_t TTreeCache::GetLearnEntries()
    return fgLearnEntries;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Add the branches listed in an access profile written by SaveAccessProfile()
+/// to the cache and stop the learning phase, so that the cache is filled with
+/// these branches starting from the first entry.
+/// Branches of the profile that do not exist in the current tree are skipped.
+/// Returns the number of branch names read from the profile or -1 if the
+/// profile cannot be read.
+
+Int_t TTreeCache::LoadAccessProfile(const char *filename)
+{
+   if (!fTree) {
+      Error("LoadAccessProfile", "the cache is not attached to a tree");
+      return -1;
+   }
+   std::ifstream profile(filename);
+   if (!profile) {
+      Error("LoadAccessProfile", "cannot open access profile %s", filename);
+      return -1;
+   }
+
+   TTree *tree = fTree->GetTree();
+   Int_t nnames = 0;
+   std::string line;
+   while (std::getline(profile, line)) {
+      if (line.empty() || line[0] == '#')
+         continue;
+      ++nnames;
+      if (fBrNames->FindObject(line.c_str()))
+         continue;
+      fBrNames->Add(new TObjString(line.c_str()));
+      // For a TChain without a loaded tree, the branches are resolved by UpdateBranches()
+      TBranch *b = tree ? tree->GetBranch(line.c_str()) : nullptr;
+      if (!b)
+         continue;
+      fBranches->AddAtAndExpand(b, fNbranches);
+      fNbranches++;
+   }
+
+   if (fBrNames->GetEntries() > 0)
+      StopLearningPhase();
+   return nnames;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Write the names of the branches in the cache, in the order in which they
+/// were added, to a text file that can be read back by LoadAccessProfile().
+/// Typically called at the end of the event loop, after the learning phase.
+/// Returns kFALSE if the file cannot be written.
+
+Bool_t TTreeCache::SaveAccessProfile(const char *filename) const
+{
+   std::ofstream profile(filename);
+   if (!profile) {
+      Error("SaveAccessProfile", "cannot create access profile %s", filename);
+      return kFALSE;
+   }
+
+   profile << "# TTreeCache access profile";
+   if (fTree)
+      profile << " for tree " << fTree->GetName();
+   profile << "\n";
+   TIter next(fBrNames);
+   TObjString *os;
+   while ((os = (TObjString *)next()))
+      profile << os->GetName() << "\n";
+   profile.close();
+   return !profile.fail();
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Print cache statistics. Like:
 ///
@@ -27,13 +27,15 @@ A TTreeCache which exploits parallelized decompression of its own content.
 #include "TMath.h"
 #include "TROOT.h"
 #include "TMutex.h"
+#include "ROOT/TBasketBufferPool.hxx"
+#include "ROOT/RTrace.hxx"
 
 #ifdef R__USE_IMT
-#include "ROOT/TThreadExecutor.hxx"
 #include "ROOT/TTaskGroup.hxx"
 #endif
 
 #include <memory>
+#include <thread>
 
 extern "C" void R__unzip(Int_t *nin, UChar_t *bufin, Int_t *lout, char *bufout, Int_t *nout);
 extern "C" int R__unzip_header(Int_t *nin, UChar_t *bufin, Int_t *lout);
@@ -47,15 +49,45 @@ Double_t TTreeCacheUnzip::fgRelBuffSize = .5;
 
 ClassImp(TTreeCacheUnzip);
 
+namespace {
+
+////////////////////////////////////////////////////////////////////////////////
+/// Allocate a buffer of at least size bytes, from the pool of basket buffers
+/// of the tree if any (see TTree::SetBasketBufferPoolSize).
+
+char *R__AllocateUnzipBuffer(ROOT::Internal::TBasketBufferPool *pool, Int_t size, Int_t &capacity)
+{
+   if (pool)
+      return pool->Acquire(size, capacity);
+   capacity = size;
+   return new char[size];
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Free a buffer allocated by R__AllocateUnzipBuffer.
+
+void R__FreeUnzipBuffer(ROOT::Internal::TBasketBufferPool *pool, char *buffer, Int_t capacity)
+{
+   if (pool)
+      pool->Release(buffer, capacity);
+   else
+      delete[] buffer;
+}
+
+} // anonymous namespace
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Clear all baskets' state arrays.
 
 void TTreeCacheUnzip::UnzipState::Clear(Int_t size) {
    for (Int_t i = 0; i < size; i++) {
-      if (!fUnzipLen.empty()) fUnzipLen[i] = 0;
       if (fUnzipChunks) {
-         if (fUnzipChunks[i]) fUnzipChunks[i].reset();
+         if (fUnzipChunks[i]) {
+            Release(fUnzipLen[i]);
+            fUnzipChunks[i].reset();
+         }
       }
+      if (!fUnzipLen.empty()) fUnzipLen[i] = 0;
       if (fUnzipStatus) fUnzipStatus[i].store(0);
    }
 }
@@ -154,6 +186,27 @@ Bool_t TTreeCacheUnzip::UnzipState::TryUnzipping(Int_t index) {
    return fUnzipStatus[index].compare_exchange_weak(oldValue, newValue, std::memory_order_release, std::memory_order_relaxed);
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Account for an unzipped chunk of `len` bytes before it is created.
+/// Returns kFALSE, and leaves the accounting untouched, if the chunk would
+/// bring the summed size of the unzipped chunks above `limit`.
+
+Bool_t TTreeCacheUnzip::UnzipState::TryReserve(Int_t len, Long64_t limit) {
+   if (fUnzippedBytes.fetch_add(len) + len <= limit)
+      return kTRUE;
+   fUnzippedBytes.fetch_sub(len);
+   return kFALSE;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Give back the `len` bytes reserved for an unzipped chunk, either because
+/// the chunk was handed out to the reader or because it was discarded.
+
+void TTreeCacheUnzip::UnzipState::Release(Int_t len) {
+   if (len > 0)
+      fUnzippedBytes.fetch_sub(len);
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 
 TTreeCacheUnzip::TTreeCacheUnzip() : TTreeCache(),
@@ -166,7 +219,8 @@ TTreeCacheUnzip::TTreeCacheUnzip() : TTreeCache(),
    fNFound(0),
    fNMissed(0),
    fNStalls(0),
-   fNUnzip(0)
+   fNUnzip(0),
+   fNOverBudget(0)
 {
    // Default Constructor.
    Init();
@@ -185,7 +239,8 @@ TTreeCacheUnzip::TTreeCacheUnzip(TTree *tree, Int_t buffersize) : TTreeCache(tre
    fNFound(0),
    fNMissed(0),
    fNStalls(0),
-   fNUnzip(0)
+   fNUnzip(0),
+   fNOverBudget(0)
 {
    Init();
 }
@@ -234,6 +289,12 @@ void TTreeCacheUnzip::Init()
 
 TTreeCacheUnzip::~TTreeCacheUnzip()
 {
+#ifdef R__USE_IMT
+   if (fUnzipTaskGroup) {
+      fUnzipTaskGroup->Cancel();
+      fUnzipTaskGroup.reset();
+   }
+#endif
    ResetCache();
    fUnzipState.Clear(fNseekMax);
 }
@@ -538,6 +599,7 @@ Int_t TTreeCacheUnzip::UnzipCache(Int_t index)
    myCycle = fCycle;
    rdoffs = fSeek[index];
    rdlen = fSeekLen[index];
+   R__TRACE_SPAN("io", "TTreeCacheUnzip::UnzipCache", rdlen);
 
    Int_t loc = -1;
    if (!fNseek || fIsLearning) {
@@ -550,37 +612,39 @@ Int_t TTreeCacheUnzip::UnzipCache(Int_t index)
    }
 
    // Prepare a memory buffer of adequate size
-   char* locbuff = 0;
+   ROOT::Internal::TBasketBufferPool *pool = fTree ? fTree->GetBasketBufferPool() : nullptr;
+   Int_t locbuffSize = 16384;
    if (rdlen > 16384) {
-      locbuff = new char[rdlen];
+      locbuffSize = rdlen;
    } else if (rdlen * 3 < 16384) {
-      locbuff = new char[rdlen * 2];
-   } else {
-      locbuff = new char[16384];
+      locbuffSize = rdlen * 2;
    }
+   char *locbuff = R__AllocateUnzipBuffer(pool, locbuffSize, locbuffSize);
 
    readbuf = ReadBufferExt(locbuff, rdoffs, rdlen, loc);
 
    if (readbuf <= 0) {
       fUnzipState.SetFinished(index); // Set it as not done, main thread will take charge
-      if (locbuff) delete [] locbuff;
+      R__FreeUnzipBuffer(pool, locbuff, locbuffSize);
       return -1;
    }
 
    GetRecordHeader(locbuff, hlen, nbytes, objlen, keylen);
 
    Int_t len = (objlen > nbytes - keylen) ? keylen + objlen : nbytes;
-   // If the single unzipped chunk is really too big, reset it to not processable
-   // I.e. mark it as done but set the pointer to 0
+   // The unzipped chunks waiting for the reader must not exceed fUnzipBufferSize in total.
+   // If this one does not fit (in particular if the single chunk is really too big),
+   // reset it to not processable, i.e. mark it as done but set the pointer to 0.
    // This block will be unzipped synchronously in the main thread
    // TODO: ROOT internally breaks zipped buffers into 16MB blocks, we can probably still unzip in parallel.
-   if (len > 4 * fUnzipBufferSize) {
-           if (gDebug > 0)
-                   Info("UnzipCache", "Block %d is too big, skipping.", index);
+   if (!fUnzipState.TryReserve(len, fUnzipBufferSize)) {
+      if (gDebug > 0)
+         Info("UnzipCache", "Block %d does not fit into the unzip buffer, skipping.", index);
 
-           fUnzipState.SetFinished(index); // Set it as not done, main thread will take charge
-           if (locbuff) delete [] locbuff;
-           return 0;
+      fNOverBudget++;
+      fUnzipState.SetFinished(index); // Set it as not done, main thread will take charge
+      R__FreeUnzipBuffer(pool, locbuff, locbuffSize);
+      return 0;
    }
 
    // Unzip it into a new blk
@@ -588,68 +652,64 @@ Int_t TTreeCacheUnzip::UnzipCache(Int_t index)
    Int_t loclen = UnzipBuffer(&ptr, locbuff);
    if ((loclen > 0) && (loclen == objlen + keylen)) {
       if ((myCycle != fCycle) || !fIsTransferred) {
+         fUnzipState.Release(len);
          fUnzipState.SetFinished(index); // Set it as not done, main thread will take charge
-         if (locbuff) delete [] locbuff;
-         delete [] ptr;
+         R__FreeUnzipBuffer(pool, locbuff, locbuffSize);
+         R__FreeUnzipBuffer(pool, ptr, objlen + keylen);
          return 1;
       }
+      // The reservation is kept until the chunk is handed out or cleared
+      fUnzipState.Release(len - loclen);
       fUnzipState.SetUnzipped(index, ptr, loclen); // Set it as done
       fNUnzip++;
    } else {
+      fUnzipState.Release(len);
       fUnzipState.SetFinished(index); // Set it as not done, main thread will take charge
-      delete [] ptr;
+      R__FreeUnzipBuffer(pool, ptr, objlen + keylen);
    }
 
-   if (locbuff) delete [] locbuff;
+   R__FreeUnzipBuffer(pool, locbuff, locbuffSize);
    return 0;
 }
 
 #ifdef R__USE_IMT
 ////////////////////////////////////////////////////////////////////////////////
-/// We create a TTaskGroup and asynchronously maps each group of baskets(> 100 kB in total)
-/// to a task. In TTaskGroup, we use TThreadExecutor to do the actually work of unzipping
-/// a group of basket. The purpose of creating TTaskGroup is to avoid competing with main thread.
+/// We create a TTaskGroup and asynchronously map each group of baskets (> 100 kB in total)
+/// to a task. The tasks run in ROOT's global task arena, next to the other IMT work, and
+/// do not compete with the main thread. The main thread picks up the unzipped baskets
+/// through the atomic status array, so no locking is needed to hand them over.
 
 Int_t TTreeCacheUnzip::CreateTasks()
 {
-   auto mapFunction = [&]() {
-      auto unzipFunction = [&](const std::vector<Int_t> &indices) {
+   auto unzipFunction = [this](const std::vector<Int_t> &indices) {
+      R__TRACE_SPAN("imt", "TTreeCacheUnzip task", indices.size());
+      for (auto ii : indices) {
          // If cache is invalidated and we should return immediately.
-         if (!fIsTransferred) return nullptr;
+         if (!fIsTransferred) return;
 
-         for (auto ii : indices) {
-            if(fUnzipState.TryUnzipping(ii)) {
-               Int_t res = UnzipCache(ii);
-               if(res)
-                  if (gDebug > 0)
-                     Info("UnzipCache", "Unzipping failed or cache is in learning state");
-            }
-         }
-         return nullptr;
-      };
-
-      Int_t accusz = 0;
-      std::vector<std::vector<Int_t>> basketIndices;
-      std::vector<Int_t> indices;
-      if (fUnzipGroupSize <= 0) fUnzipGroupSize = 102400;
-      for (Int_t i = 0; i < fNseek; i++) {
-         while (accusz < fUnzipGroupSize) {
-            accusz += fSeekLen[i];
-            indices.push_back(i);
-            i++;
-            if (i >= fNseek) break;
+         if(fUnzipState.TryUnzipping(ii)) {
+            Int_t res = UnzipCache(ii);
+            if(res)
+               if (gDebug > 0)
+                  Info("UnzipCache", "Unzipping failed or cache is in learning state");
          }
-         if (i < fNseek) i--;
-         basketIndices.push_back(indices);
-         indices.clear();
-         accusz = 0;
       }
-      ROOT::TThreadExecutor pool;
-      pool.Foreach(unzipFunction, basketIndices);
    };
 
    fUnzipTaskGroup.reset(new ROOT::Experimental::TTaskGroup());
-   fUnzipTaskGroup->Run(mapFunction);
+
+   Int_t accusz = 0;
+   std::vector<Int_t> indices;
+   if (fUnzipGroupSize <= 0) fUnzipGroupSize = 102400;
+   for (Int_t i = 0; i < fNseek; i++) {
+      accusz += fSeekLen[i];
+      indices.push_back(i);
+      if (accusz >= fUnzipGroupSize || i == fNseek - 1) {
+         fUnzipTaskGroup->Run([unzipFunction, indices]() { unzipFunction(indices); });
+         indices.clear();
+         accusz = 0;
+      }
+   }
 
    return 0;
 }
@@ -714,6 +774,7 @@ Int_t TTreeCacheUnzip::GetUnzipBuffer(char **buf, Long64_t pos, Int_t len, Bool_
                   *free = kFALSE;
                }
 
+               fUnzipState.Release(fUnzipState.fUnzipLen[seekidx]);
                fNFound++;
                return fUnzipState.fUnzipLen[seekidx];
             }
@@ -738,6 +799,8 @@ Int_t TTreeCacheUnzip::GetUnzipBuffer(char **buf, Long64_t pos, Int_t len, Bool_
                      UnzipCache(reqi);
                   }
                }
+               if (reqi < 0)
+                  std::this_thread::yield();
 
                if ( myCycle != fCycle ) {
                   if (gDebug > 0)
@@ -763,6 +826,7 @@ Int_t TTreeCacheUnzip::GetUnzipBuffer(char **buf, Long64_t pos, Int_t len, Bool_
                *free = kFALSE;
             }
 
+            fUnzipState.Release(fUnzipState.fUnzipLen[seekidx]);
             fNStalls++;
             return fUnzipState.fUnzipLen[seekidx];
          } else {
@@ -833,8 +897,10 @@ void TTreeCacheUnzip::SetUnzipRelBufferSize(Float_t relbufferSize)
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-/// Sets the size for the unzipping cache... by default it should be
-/// two times the size of the prefetching cache
+/// Sets the size for the unzipping cache, i.e. the hard limit on the summed
+/// size of the unzipped blocks waiting to be read. Blocks that do not fit are
+/// unzipped by the main thread when they are requested. By default it is
+/// fgRelBuffSize times the size of the prefetching cache.
 
 void TTreeCacheUnzip::SetUnzipBufferSize(Long64_t bufferSize)
 {
@@ -854,6 +920,8 @@ Int_t TTreeCacheUnzip::UnzipBuffer(char **dest, char *src)
 {
    Int_t  uzlen = 0;
    Bool_t alloc = kFALSE;
+   ROOT::Internal::TBasketBufferPool *pool = fTree ? fTree->GetBasketBufferPool() : nullptr;
+   Int_t capacity = 0;
 
    // Here we read the header of the buffer
    const Int_t hlen = 128;
@@ -870,7 +938,7 @@ Int_t TTreeCacheUnzip::UnzipBuffer(char **dest, char *src)
          return uzlen;
       }
       Int_t l = keylen + objlen;
-      *dest = new char[l];
+      *dest = R__AllocateUnzipBuffer(pool, l, capacity);
       alloc = kTRUE;
    }
    // Must unzip the buffer
@@ -928,7 +996,7 @@ Int_t TTreeCacheUnzip::UnzipBuffer(char **dest, char *src)
          Error("UnzipBuffer", "nbytes = %d, keylen = %d, objlen = %d, noutot = %d, nout=%d, nin=%d, nbuf=%d",
                nbytes,keylen,objlen, noutot,nout,nin,nbuf);
          uzlen = -1;
-         if(alloc) delete [] *dest;
+         if(alloc) R__FreeUnzipBuffer(pool, *dest, capacity);
          *dest = 0;
          return uzlen;
       }
@@ -948,10 +1016,12 @@ void  TTreeCacheUnzip::Print(Option_t* option) const {
 
    printf("******TreeCacheUnzip statistics for file: %s ******\n",fFile->GetName());
    printf("Max allowed mem for pending buffers: %lld\n", fUnzipBufferSize);
+   printf("Mem currently held by pending buffers: %lld\n", fUnzipState.fUnzippedBytes.load());
    printf("Number of blocks unzipped by threads: %d\n", fNUnzip);
    printf("Number of hits: %d\n", fNFound);
    printf("Number of stalls: %d\n", fNStalls);
    printf("Number of misses: %d\n", fNMissed);
+   printf("Number of blocks over the memory limit: %d\n", fNOverBudget.load());
 
    TTreeCache::Print(option);
 }
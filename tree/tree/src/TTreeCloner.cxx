@@ -26,12 +26,14 @@ Class implementing or helping  the various TTree cloning method
 #include "TTree.h"
 #include "TTreeCloner.h"
 #include "TFile.h"
+#include "TMemFile.h"
 #include "TLeafB.h"
 #include "TLeafI.h"
 #include "TLeafL.h"
 #include "TLeafS.h"
 #include "TLeafO.h"
 #include "TLeafC.h"
+#include "TMathBase.h"
 #include "TFileCacheRead.h"
 #include "TTreeCache.h"
 #include "snprintf.h"
@@ -137,6 +139,7 @@ TTreeCloner::TTreeCloner(TTree *from, TTree *to, TDirectory *newdirectory, Optio
    fFromBranches( from ? from->GetListOfLeaves()->GetEntriesFast()+1 : 0),
    fToBranches( to ? to->GetListOfLeaves()->GetEntriesFast()+1 : 0),
    fMaxBaskets(CollectBranches()),
+   fNBaskets(fMaxBaskets),
    fBasketBranchNum(new UInt_t[fMaxBaskets]),
    fBasketNum(new UInt_t[fMaxBaskets]),
    fBasketSeek(new Long64_t[fMaxBaskets]),
@@ -147,7 +150,8 @@ TTreeCloner::TTreeCloner(TTree *from, TTree *to, TDirectory *newdirectory, Optio
    fToStartEntries(0),
    fCacheSize(0LL),
    fFileCache(nullptr),
-   fPrevCache(nullptr)
+   fPrevCache(nullptr),
+   fRangeStarted(kFALSE)
 {
    TString opt(method);
    opt.ToLower();
@@ -207,10 +211,25 @@ TTreeCloner::TTreeCloner(TTree *from, TTree *to, TDirectory *newdirectory, Optio
          Warning("TTreeCloner::TTreeCloner", "%s", fWarningMsg.Data());
       }
       fIsValid = kFALSE;
+   } else if (fFromTree && fFromTree->GetCurrentFile() && fFromTree->GetCurrentFile()->GetZstdDictionaryID() &&
+              fFromTree->GetCurrentFile()->GetZstdDictionaryID() != fToFile->GetZstdDictionaryID()) {
+      // The baskets compressed with the ZSTD dictionary of the input file cannot be read from the output file:
+      // the entries must be copied one by one.
+      fWarningMsg.Form("The input TTree (%s) is compressed with the ZSTD dictionary of its file (%s), its baskets cannot be copied to %s.",
+                       fFromTree->GetName(), fFromTree->GetCurrentFile()->GetName(), fToFile->GetName());
+      if (!(fOptions & kNoWarnings)) {
+         Warning("TTreeCloner::TTreeCloner", "%s", fWarningMsg.Data());
+      }
+      fIsValid = kFALSE;
+      fNeedConversion = kTRUE;
    }
 
    if (fIsValid && (!(fOptions & kNoFileCache))) {
-      fCacheSize = fFromTree->GetCacheAutoSize();
+      // The baskets of an in-memory input (for example the TMemFile of a TBufferMerger
+      // worker) are already in memory, going through a read cache would only add a copy.
+      TFile *fromfile = fFromTree->GetCurrentFile();
+      if (!fromfile || !fromfile->InheritsFrom(TMemFile::Class()))
+         fCacheSize = fFromTree->GetCacheAutoSize();
    }
 }
 
@@ -240,6 +259,94 @@ Bool_t TTreeCloner::Exec()
    return kTRUE;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Return true if the entries [first, last) of the input TTree can be copied
+/// by ExecRange: every branch must have a basket starting at 'first' and
+/// at 'last' (or end at 'last'), and the baskets in between must be on file.
+/// This is the case for the clusters of a TTree written with auto-flush.
+
+Bool_t TTreeCloner::IsCopyableRange(Long64_t first, Long64_t last)
+{
+   if (!IsValid() || IsInPlace() || first >= last)
+      return kFALSE;
+
+   for(Int_t i=0; i<fFromBranches.GetEntriesFast(); ++i) {
+      TBranch *from = (TBranch*)fFromBranches.UncheckedAt(i);
+      const Int_t writeBasket = from->GetWriteBasket();
+      if (writeBasket == 0) {
+         // A branch without data on file (for example a non-terminal branch of a split
+         // object) is fine as long as it does not hold the entries in its write basket.
+         TBasket *basket = (TBasket*)from->GetListOfBaskets()->At(0);
+         if (basket && basket->GetNevBuf())
+            return kFALSE;
+         continue;
+      }
+      const Long64_t *entries = from->GetBasketEntry();
+      Int_t b = (Int_t)TMath::BinarySearch((Long64_t)writeBasket, entries, first);
+      if (b < 0 || entries[b] != first)
+         return kFALSE;
+      for (; b < writeBasket && entries[b] < last; ++b) {
+         if (from->GetBasketSeek(b) == 0)
+            return kFALSE;
+      }
+      // entries[writeBasket] is the first entry of the write basket.
+      if (entries[b] != last)
+         return kFALSE;
+   }
+   return kTRUE;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Append the entries [first, last) of the input TTree to the output TTree by
+/// copying their baskets without decompression, see IsCopyableRange.
+/// The output TTree can be filled, or receive other ranges, before and after.
+/// The copied entries become a cluster of the output TTree.
+/// Returns false, without copying anything, if the range cannot be copied.
+
+Bool_t TTreeCloner::ExecRange(Long64_t first, Long64_t last)
+{
+   if (!IsCopyableRange(first, last)) {
+      return kFALSE;
+   }
+   if (!fRangeStarted) {
+      CopyStreamerInfos();
+      CopyProcessIds();
+      fRangeStarted = kTRUE;
+   }
+   CreateCache();
+
+   const Long64_t toEntries = fToTree->GetEntries();
+   // The entries filled since the last cluster boundary form a cluster of their own.
+   if (toEntries && (fToTree->fNClusterRange == 0 ||
+                     fToTree->fClusterRangeEnd[fToTree->fNClusterRange - 1] != toEntries - 1)) {
+      fToTree->MarkEventCluster();
+   }
+
+   fToStartEntries = toEntries - first;
+   const Long64_t zipBytes = fToTree->GetZipBytes();
+   CloseOutWriteBaskets();
+   CollectBaskets(first, last);
+   SortBaskets();
+   WriteBaskets();
+   RestoreCache();
+
+   for(Int_t i=0; i<fToBranches.GetEntriesFast(); ++i) {
+      TBranch *from = (TBranch*)fFromBranches.UncheckedAt( i );
+      TBranch *to   = (TBranch*)fToBranches.UncheckedAt( i );
+      to->AddLastBasket(toEntries + last - first);
+      if (from->GetWriteBasket() == 0 && from->GetEntries() != 0) {
+         to->SetEntries(to->GetEntries() + last - first);
+      }
+   }
+
+   fToTree->SetEntries(toEntries + last - first);
+   fToTree->MarkEventCluster();
+   fToTree->fClusterSize[fToTree->fNClusterRange - 1] = last - first;
+   fToTree->fFlushedBytes += fToTree->GetZipBytes() - zipBytes;
+
+   return kTRUE;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// TTreeCloner destructor
 
@@ -463,6 +570,33 @@ void TTreeCloner::CollectBaskets()
          fBasketIndex[bi] = bi;
       }
    }
+   fNBaskets = fMaxBaskets;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Collect the information about the on-file baskets holding the
+/// entries [first, last), see IsCopyableRange.
+
+void TTreeCloner::CollectBaskets(Long64_t first, Long64_t last)
+{
+   UInt_t len = fFromBranches.GetEntriesFast();
+
+   UInt_t bi = 0;
+   for(UInt_t i=0; i<len; ++i) {
+      TBranch *from = (TBranch*)fFromBranches.UncheckedAt(i);
+      const Long64_t *entries = from->GetBasketEntry();
+      for(Int_t b=0; b<from->GetWriteBasket(); ++b) {
+         if (entries[b] < first || entries[b] >= last)
+            continue;
+         fBasketBranchNum[bi] = i;
+         fBasketNum[bi] = b;
+         fBasketSeek[bi] = from->GetBasketSeek(b);
+         fBasketEntry[bi] = entries[b];
+         fBasketIndex[bi] = bi;
+         ++bi;
+      }
+   }
+   fNBaskets = bi;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -677,14 +811,14 @@ void TTreeCloner::SortBaskets()
          // nothing to do, it is already sorted.
          break;
       case kSortBasketsByEntry: {
-         for(UInt_t i = 0; i < fMaxBaskets; ++i) { fBasketIndex[i] = i; }
-         std::sort(fBasketIndex, fBasketIndex+fMaxBaskets, CompareEntry( this) );
+         for(UInt_t i = 0; i < fNBaskets; ++i) { fBasketIndex[i] = i; }
+         std::sort(fBasketIndex, fBasketIndex+fNBaskets, CompareEntry( this) );
          break;
       }
       case kSortBasketsByOffset:
       default: {
-         for(UInt_t i = 0; i < fMaxBaskets; ++i) { fBasketIndex[i] = i; }
-         std::sort(fBasketIndex, fBasketIndex+fMaxBaskets, CompareSeek( this) );
+         for(UInt_t i = 0; i < fNBaskets; ++i) { fBasketIndex[i] = i; }
+         std::sort(fBasketIndex, fBasketIndex+fNBaskets, CompareSeek( this) );
          break;
       }
    }
@@ -701,7 +835,7 @@ UInt_t TTreeCloner::FillCache(UInt_t from)
    // Reset the cache
    fFileCache->Prefetch(0, 0);
    Long64_t size = 0;
-   for (UInt_t j = from; j < fMaxBaskets; ++j) {
+   for (UInt_t j = from; j < fNBaskets; ++j) {
       TBranch *frombr = (TBranch *) fFromBranches.UncheckedAt(fBasketBranchNum[fBasketIndex[j]]);
 
 
@@ -716,7 +850,7 @@ UInt_t TTreeCloner::FillCache(UInt_t from)
          fFileCache->Prefetch(pos,len);
       }
    }
-   return fMaxBaskets;
+   return fNBaskets;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -725,7 +859,7 @@ UInt_t TTreeCloner::FillCache(UInt_t from)
 void TTreeCloner::WriteBaskets()
 {
    TBasket *basket = new TBasket();
-   for(UInt_t j = 0, notCached = 0; j<fMaxBaskets; ++j) {
+   for(UInt_t j = 0, notCached = 0; j<fNBaskets; ++j) {
       TBranch *from = (TBranch*)fFromBranches.UncheckedAt( fBasketBranchNum[ fBasketIndex[j] ] );
       TBranch *to   = (TBranch*)fToBranches.UncheckedAt( fBasketBranchNum[ fBasketIndex[j] ] );
 
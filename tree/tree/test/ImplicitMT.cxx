@@ -1,7 +1,9 @@
 #include "TFile.h"
+#include "TH1F.h"
 #include "TROOT.h"
 #include "TSystem.h"
 #include "TTree.h"
+#include "TTreeCacheUnzip.h"
 
 #include "gtest/gtest.h"
 
@@ -28,4 +30,156 @@ TEST(TTreeImplicitMT, flushBaskets)
    gSystem->Unlink(ofileName);
 }
 
+TEST(TTreeImplicitMT, asyncBasketWrite)
+{
+   ROOT::EnableImplicitMT();
+   const auto ofileName = "asyncBasketWriteMT.root";
+   {
+      TFile f(ofileName, "RECREATE");
+      TTree t("t", "t");
+      t.SetMaxPendingBaskets(4);
+      EXPECT_EQ(4, t.GetMaxPendingBaskets());
+      double b1 = 0.;
+      int b2 = 0;
+      int n = 0;
+      float arr[10];
+      t.Branch("branch1", &b1, 4000);
+      t.Branch("branch2", &b2, 4000);
+      t.Branch("n", &n, "n/I", 4000);
+      t.Branch("arr", arr, "arr[n]/F", 4000);
+      for (int i = 0; i < 50000; ++i) {
+         b1 = 0.5 * i;
+         b2 = i;
+         n = i % 10;
+         for (int j = 0; j < n; ++j)
+            arr[j] = i + j;
+         EXPECT_GT(t.Fill(), 0);
+      }
+      // Reading back a basket that may still be in flight waits for it
+      EXPECT_NE(nullptr, t.GetBranch("branch2")->GetBasket(0));
+      t.Write();
+      EXPECT_GT(t.GetZipBytes(), 0);
+   }
+
+   {
+      TFile f(ofileName);
+      auto t = f.Get<TTree>("t");
+      ASSERT_NE(nullptr, t);
+      EXPECT_EQ(50000, t->GetEntries());
+      double b1 = 0.;
+      int b2 = 0;
+      int n = 0;
+      float arr[10];
+      t->SetBranchAddress("branch1", &b1);
+      t->SetBranchAddress("branch2", &b2);
+      t->SetBranchAddress("n", &n);
+      t->SetBranchAddress("arr", arr);
+      for (Long64_t i = 0; i < t->GetEntries(); ++i) {
+         t->GetEntry(i);
+         EXPECT_DOUBLE_EQ(0.5 * i, b1);
+         EXPECT_EQ(i, b2);
+         ASSERT_EQ(i % 10, n);
+         for (int j = 0; j < n; ++j)
+            EXPECT_FLOAT_EQ(i + j, arr[j]);
+      }
+      t->ResetBranchAddresses();
+   }
+   gSystem->Unlink(ofileName);
+}
+
+// Objects written to the file while baskets are pending must not clash with them
+TEST(TTreeImplicitMT, asyncBasketWriteWithObjects)
+{
+   ROOT::EnableImplicitMT();
+   const auto ofileName = "asyncBasketWriteWithObjectsMT.root";
+   {
+      TFile f(ofileName, "RECREATE");
+      TTree t("t", "t");
+      t.SetMaxPendingBaskets(8);
+      int b = 0;
+      t.Branch("b", &b, 4000);
+      TH1F h("h", "h", 100, 0, 50000);
+      for (int i = 0; i < 50000; ++i) {
+         b = i;
+         h.Fill(i);
+         EXPECT_GT(t.Fill(), 0);
+         if (i % 5000 == 4999) {
+            EXPECT_GT(f.WriteTObject(&h, TString::Format("h%d", i / 5000)), 0);
+            EXPECT_GT(h.Write(), 0);
+         }
+      }
+      t.Write();
+   }
+
+   {
+      TFile f(ofileName);
+      auto t = f.Get<TTree>("t");
+      ASSERT_NE(nullptr, t);
+      EXPECT_EQ(50000, t->GetEntries());
+      int b = 0;
+      t->SetBranchAddress("b", &b);
+      for (Long64_t i = 0; i < t->GetEntries(); ++i) {
+         ASSERT_GT(t->GetEntry(i), 0);
+         EXPECT_EQ(i, b);
+      }
+      t->ResetBranchAddresses();
+      for (int i = 0; i < 10; ++i) {
+         auto h = f.Get<TH1F>(TString::Format("h%d", i));
+         ASSERT_NE(nullptr, h);
+         EXPECT_EQ(5000 * (i + 1), h->GetEntries());
+      }
+      auto h = f.Get<TH1F>("h");
+      ASSERT_NE(nullptr, h);
+      EXPECT_EQ(50000, h->GetEntries());
+   }
+   gSystem->Unlink(ofileName);
+}
+
+TEST(TTreeImplicitMT, parallelUnzipMemoryLimit)
+{
+   ROOT::EnableImplicitMT();
+   const auto ofileName = "parallelUnzipMemoryLimitMT.root";
+   {
+      TFile f(ofileName, "RECREATE");
+      TTree t("t", "t");
+      double b1 = 0.;
+      int b2 = 0;
+      t.Branch("branch1", &b1, 4000);
+      t.Branch("branch2", &b2, 4000);
+      for (int i = 0; i < 50000; ++i) {
+         b1 = 0.5 * i;
+         b2 = i;
+         t.Fill();
+      }
+      t.Write();
+   }
+
+   TTreeCacheUnzip::SetParallelUnzip(TTreeCacheUnzip::kEnable);
+   {
+      TFile f(ofileName);
+      auto t = f.Get<TTree>("t");
+      ASSERT_NE(nullptr, t);
+      t->SetCacheSize(1000000);
+      auto cache = dynamic_cast<TTreeCacheUnzip *>(f.GetCacheRead(t));
+      ASSERT_NE(nullptr, cache);
+      const Long64_t limit = 20000;
+      cache->SetUnzipBufferSize(limit);
+      EXPECT_EQ(limit, cache->GetUnzipBufferSize());
+
+      double b1 = 0.;
+      int b2 = 0;
+      t->SetBranchAddress("branch1", &b1);
+      t->SetBranchAddress("branch2", &b2);
+      for (Long64_t i = 0; i < t->GetEntries(); ++i) {
+         t->GetEntry(i);
+         EXPECT_DOUBLE_EQ(0.5 * i, b1);
+         EXPECT_EQ(i, b2);
+         EXPECT_LE(cache->GetNUnzippedBytes(), limit);
+      }
+      t->ResetBranchAddresses();
+   }
+   TTreeCacheUnzip::SetParallelUnzip(TTreeCacheUnzip::kDisable);
+   gSystem->Unlink(ofileName);
+}
+
 #endif // R__USE_IMT
@@ -0,0 +1,91 @@
+#include "TBranchElement.h"
+#include "TMemFile.h"
+#include "TTree.h"
+
+#include "gtest/gtest.h"
+
+#include "ReadMembersStruct.h"
+
+#include <memory>
+
+class TBranchElementReadMembers : public ::testing::Test {
+protected:
+   static constexpr int fEventCount = 100;
+   std::unique_ptr<TMemFile> fFile;
+
+   void SetUp() override
+   {
+      fFile.reset(new TMemFile("ReadMembers.root", "RECREATE"));
+      TTree tree("tree", "A test tree");
+      ReadMembersStruct data;
+      tree.Branch("data", &data, 32000, 0);
+      for (int i = 0; i < fEventCount; ++i) {
+         data.fId = i;
+         data.fLabel = TString::Format("label%d", i);
+         data.fValues.assign(i % 7, 0.5 * i);
+         data.fNamed.SetNameTitle(TString::Format("name%d", i), "title");
+         data.fWeight = 2. * i;
+         tree.Fill();
+      }
+      tree.Write();
+   }
+
+   TTree *GetTree()
+   {
+      TTree *tree = nullptr;
+      fFile->GetObject("tree", tree);
+      return tree;
+   }
+};
+
+TEST_F(TBranchElementReadMembers, AllMembers)
+{
+   TTree *tree = GetTree();
+   ASSERT_NE(tree, nullptr);
+   auto data = new ReadMembersStruct;
+   tree->SetBranchAddress("data", &data);
+   for (int i = 0; i < fEventCount; ++i) {
+      tree->GetEntry(i);
+      EXPECT_EQ(data->fId, i);
+      EXPECT_EQ(data->fLabel, TString::Format("label%d", i));
+      EXPECT_EQ(data->fValues.size(), std::size_t(i % 7));
+      EXPECT_EQ(TString(data->fNamed.GetName()), TString::Format("name%d", i));
+      EXPECT_EQ(data->fWeight, 2. * i);
+   }
+   tree->ResetBranchAddresses();
+   delete data;
+}
+
+TEST_F(TBranchElementReadMembers, Projection)
+{
+   TTree *tree = GetTree();
+   ASSERT_NE(tree, nullptr);
+   auto branch = dynamic_cast<TBranchElement *>(tree->GetBranch("data"));
+   ASSERT_NE(branch, nullptr);
+   branch->SetReadMembers({"fValues"});
+   auto data = new ReadMembersStruct;
+   tree->SetBranchAddress("data", &data);
+   for (int i = 0; i < fEventCount; ++i) {
+      tree->GetEntry(i);
+      // The data members of basic types are always read
+      EXPECT_EQ(data->fId, i);
+      EXPECT_EQ(data->fWeight, 2. * i);
+      ASSERT_EQ(data->fValues.size(), std::size_t(i % 7));
+      for (auto value : data->fValues)
+         EXPECT_EQ(value, 0.5 * i);
+      // The others are skipped
+      EXPECT_EQ(data->fLabel, "");
+      EXPECT_STREQ(data->fNamed.GetName(), "");
+   }
+
+   branch->SetReadMembers({"fLabel", "fNamed"});
+   data->fValues.clear();
+   tree->GetEntry(fEventCount - 1);
+   EXPECT_EQ(data->fLabel, TString::Format("label%d", fEventCount - 1));
+   EXPECT_EQ(TString(data->fNamed.GetName()), TString::Format("name%d", fEventCount - 1));
+   EXPECT_TRUE(data->fValues.empty());
+   EXPECT_EQ(data->fWeight, 2. * (fEventCount - 1));
+
+   tree->ResetBranchAddresses();
+   delete data;
+}
@@ -0,0 +1,18 @@
+/**
+ * The ReadMembersStruct has no purpose except to provide
+ * inputs to the TBranchElement::SetReadMembers test cases.
+ */
+
+#include "TNamed.h"
+#include "TString.h"
+
+#include <vector>
+
+class ReadMembersStruct {
+public:
+   int                 fId = -1;
+   TString             fLabel;
+   std::vector<double> fValues;
+   TNamed              fNamed;
+   double              fWeight = -1;
+};
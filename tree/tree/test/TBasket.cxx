@@ -1,4 +1,5 @@
 
+#include "ROOT/TBasketBufferPool.hxx"
 #include "ROOT/TIOFeatures.hxx"
 #include "TBasket.h"
 #include "TBranch.h"
@@ -9,6 +10,7 @@
 
 #include "gtest/gtest.h"
 
+#include <memory>
 #include <vector>
 
 static const Int_t gSampleEvents = 100;
@@ -403,3 +405,204 @@ TEST(TBasket, TestSettingIOBits)
    readEntryOffset = reinterpret_cast<Bool_t *>(reinterpret_cast<char *>(basket2) + offset);
    EXPECT_EQ(*readEntryOffset, kTRUE);
 }
+
+// Round-trip of byte-split scalar and variable-length array branches.
+TEST(TBasket, TestByteSplit)
+{
+   TMemFile f("tbasket_bytesplit.root", "CREATE");
+   ASSERT_FALSE(f.IsZombie());
+
+   TTree t1("t1", "Byte-split baskets.");
+   TTree t2("t2", "Baskets as is.");
+   ROOT::TIOFeatures settings;
+   EXPECT_TRUE(settings.Set(ROOT::Experimental::EIOFeatures::kByteSplit));
+   EXPECT_TRUE(settings.Test(ROOT::Experimental::EIOFeatures::kByteSplit));
+   t1.SetIOFeatures(settings);
+
+   Int_t idx;
+   Float_t flt;
+   Int_t elem;
+   Double_t sample[10];
+   for (auto t : {&t1, &t2}) {
+      t->Branch("idx", &idx, "idx/I");
+      t->Branch("flt", &flt, "flt/F");
+      t->Branch("elem", &elem, "elem/I");
+      t->Branch("sample", &sample, "sample[elem]/D");
+   }
+   for (idx = 0; idx < 10000; idx++) {
+      flt = 0.5f * idx;
+      elem = idx % 9;
+      for (Int_t i = 0; i < elem; i++)
+         sample[i] = idx + 0.25 * i;
+      t1.Fill();
+      t2.Fill();
+   }
+   t1.Write();
+   t2.Write();
+
+   // Slowly varying integers compress much better once their bytes are regrouped.
+   EXPECT_LT(t1.GetBranch("idx")->GetZipBytes(), t2.GetBranch("idx")->GetZipBytes());
+   f.Close();
+
+   std::vector<char> memBuffer;
+   Long64_t maxsize = f.GetSize();
+   memBuffer.resize(maxsize);
+   f.CopyTo(&memBuffer[0], maxsize);
+
+   TMemFile f2("tbasket_bytesplit.root", &memBuffer[0], maxsize, "READ");
+   TTree *saved = nullptr;
+   f2.GetObject("t1", saved);
+   ASSERT_NE(saved, nullptr);
+   Int_t savedIdx = -1;
+   Float_t savedFlt = -1;
+   Int_t savedElem = -1;
+   Double_t savedSample[10];
+   saved->SetBranchAddress("idx", &savedIdx);
+   saved->SetBranchAddress("flt", &savedFlt);
+   saved->SetBranchAddress("elem", &savedElem);
+   saved->SetBranchAddress("sample", &savedSample);
+   ASSERT_EQ(saved->GetEntries(), 10000);
+   for (Long64_t i = 0; i < saved->GetEntries(); i++) {
+      saved->GetEntry(i);
+      EXPECT_EQ(i, savedIdx);
+      EXPECT_FLOAT_EQ(0.5f * i, savedFlt);
+      ASSERT_EQ(i % 9, savedElem);
+      for (Int_t j = 0; j < savedElem; j++)
+         EXPECT_DOUBLE_EQ(i + 0.25 * j, savedSample[j]);
+   }
+   saved->ResetBranchAddresses();
+}
+
+// Round-trip of byte-split branches whose baskets are stored uncompressed.
+TEST(TBasket, TestByteSplitUncompressed)
+{
+   TMemFile f("tbasket_bytesplit0.root", "CREATE", "", 0);
+   ASSERT_FALSE(f.IsZombie());
+
+   TTree t("t", "Uncompressed byte-split baskets.");
+   ROOT::TIOFeatures settings;
+   settings.Set(ROOT::Experimental::EIOFeatures::kByteSplit);
+   t.SetIOFeatures(settings);
+
+   Int_t idx;
+   Int_t elem;
+   Double_t sample[10];
+   t.Branch("idx", &idx, "idx/I");
+   t.Branch("elem", &elem, "elem/I");
+   t.Branch("sample", &sample, "sample[elem]/D");
+   for (idx = 0; idx < 10000; idx++) {
+      elem = idx % 9;
+      for (Int_t i = 0; i < elem; i++)
+         sample[i] = idx + 0.25 * i;
+      t.Fill();
+   }
+   t.Write();
+   EXPECT_EQ(0, t.GetBranch("idx")->GetCompressionLevel());
+   f.Close();
+
+   std::vector<char> memBuffer;
+   Long64_t maxsize = f.GetSize();
+   memBuffer.resize(maxsize);
+   f.CopyTo(&memBuffer[0], maxsize);
+
+   TMemFile f2("tbasket_bytesplit0.root", &memBuffer[0], maxsize, "READ");
+   TTree *saved = nullptr;
+   f2.GetObject("t", saved);
+   ASSERT_NE(saved, nullptr);
+
+   TBasket *basket = saved->GetBranch("sample")->GetBasket(0);
+   ASSERT_NE(basket, nullptr);
+   TClass *cl = basket->IsA();
+   Long_t offset = cl->GetDataMemberOffset("fIOBits");
+   ASSERT_GT(offset, 0);
+   UChar_t *ioBits = reinterpret_cast<UChar_t *>(reinterpret_cast<char *>(basket) + offset);
+   EXPECT_EQ(*ioBits & static_cast<UChar_t>(TBasket::EIOBits::kByteSplit),
+             static_cast<UChar_t>(TBasket::EIOBits::kByteSplit));
+   EXPECT_EQ(basket->GetNbytes(), basket->GetKeylen() + basket->GetObjlen());
+
+   Int_t savedIdx = -1;
+   Int_t savedElem = -1;
+   Double_t savedSample[10];
+   saved->SetBranchAddress("idx", &savedIdx);
+   saved->SetBranchAddress("elem", &savedElem);
+   saved->SetBranchAddress("sample", &savedSample);
+   ASSERT_EQ(saved->GetEntries(), 10000);
+   // once through the TTreeCache and once reading the baskets from the file
+   for (Long64_t cacheSize : {-1LL, 0LL}) {
+      saved->DropBaskets();
+      saved->SetCacheSize(cacheSize);
+      for (Long64_t i = 0; i < saved->GetEntries(); i++) {
+         saved->GetEntry(i);
+         EXPECT_EQ(i, savedIdx);
+         ASSERT_EQ(i % 9, savedElem);
+         for (Int_t j = 0; j < savedElem; j++)
+            EXPECT_DOUBLE_EQ(i + 0.25 * j, savedSample[j]);
+      }
+   }
+   saved->ResetBranchAddresses();
+}
+
+TEST(TBasket, BufferPoolReuse)
+{
+   ROOT::Internal::TBasketBufferPool pool(1 << 20);
+   Int_t capacity = 0;
+   char *buffer = pool.Acquire(3000, capacity);
+   EXPECT_GE(capacity, 3000);
+   pool.Release(buffer, capacity);
+   Int_t capacity2 = 0;
+   EXPECT_EQ(buffer, pool.Acquire(2000, capacity2));
+   EXPECT_EQ(capacity, capacity2);
+   pool.Release(buffer, capacity2);
+
+   // Over the maximum size, the buffers are deleted
+   pool.SetMaxBytes(100);
+   buffer = pool.Acquire(3000, capacity);
+   pool.Release(buffer, capacity);
+   const auto stats = pool.GetStats();
+   EXPECT_EQ(stats.fNAcquired, 3u);
+   EXPECT_EQ(stats.fNReused, 1u);
+   EXPECT_EQ(stats.fNReleased, 3u);
+   EXPECT_EQ(stats.fNDeleted, 1u);
+   EXPECT_EQ(stats.fBytes, 0);
+}
+
+TEST(TBasket, BufferPoolTree)
+{
+   TMemFile f("tbasket_bufferpool.root", "CREATE");
+   {
+      TTree t1("t1", "Tree with many baskets.");
+      Int_t idx;
+      Double_t x[20];
+      t1.Branch("idx", &idx, "idx/I");
+      t1.Branch("x", x, "x[20]/D");
+      t1.SetBasketSize("*", 4000);
+      for (idx = 0; idx < 5000; idx++) {
+         for (Int_t j = 0; j < 20; j++)
+            x[j] = idx + 0.5 * j;
+         t1.Fill();
+      }
+      t1.Write();
+   }
+
+   auto pool = std::make_shared<ROOT::Internal::TBasketBufferPool>(16 * 1024 * 1024);
+   for (int pass = 0; pass < 2; ++pass) {
+      TTree *tree = nullptr;
+      f.GetObject("t1", tree);
+      ASSERT_NE(tree, nullptr);
+      tree->SetBasketBufferPool(pool);
+      Int_t idx = -1;
+      Double_t x[20];
+      tree->SetBranchAddress("idx", &idx);
+      tree->SetBranchAddress("x", x);
+      for (Long64_t i = 0; i < tree->GetEntries(); i++) {
+         tree->GetEntry(i);
+         ASSERT_EQ(i, idx);
+         ASSERT_DOUBLE_EQ(i + 0.5 * 19, x[19]);
+      }
+      // The buffers of the baskets go back to the pool
+      delete tree;
+   }
+   const auto stats = pool->GetStats();
+   EXPECT_GT(stats.fNReused, 0u);
+   EXPECT_GT(stats.fBytes, 0);
+}
@@ -30,3 +30,43 @@ TEST(TChain, GetReadCacheBug)
 
    gSystem->Unlink(filename);
 }
+
+TEST(TChain, PrefetchFiles)
+{
+   const auto treename = "tree";
+   const int nfiles = 4;
+   auto filename = [](int i) { return TString::Format("tchain_prefetchfiles_%d.root", i); };
+   for (int i = 0; i < nfiles; ++i) {
+      TFile f(filename(i), "recreate");
+      ASSERT_FALSE(f.IsZombie());
+      TTree t(treename, treename);
+      int value = 0;
+      t.Branch("value", &value);
+      for (value = 10 * i; value < 10 * i + 3; ++value)
+         t.Fill();
+      t.Write();
+      f.Close();
+   }
+
+   TChain chain(treename);
+   for (int i = 0; i < nfiles; ++i)
+      chain.Add(filename(i));
+   chain.SetPrefetchFiles(2);
+   EXPECT_EQ(2, chain.GetPrefetchFiles());
+
+   int value = -1;
+   chain.SetBranchAddress("value", &value);
+   EXPECT_EQ(3 * nfiles, chain.GetEntries());
+   for (Long64_t entry = 0; entry < chain.GetEntries(); ++entry) {
+      chain.GetEntry(entry);
+      EXPECT_EQ(10 * (entry / 3) + entry % 3, value);
+      EXPECT_EQ(entry / 3, chain.GetTreeNumber());
+   }
+   // Going back to the first file still works.
+   chain.GetEntry(1);
+   EXPECT_EQ(1, value);
+   chain.ResetBranchAddresses();
+
+   for (int i = 0; i < nfiles; ++i)
+      gSystem->Unlink(filename(i));
+}
@@ -0,0 +1,121 @@
+#include "RConfigure.h"
+#include "TEnv.h"
+#include "TFile.h"
+#include "TFileCacheRead.h"
+#include "TROOT.h"
+#include "TSystem.h"
+#include "TTree.h"
+#include "TTreeCache.h"
+
+#include "gtest/gtest.h"
+
+#include <memory>
+#include <vector>
+
+namespace {
+
+struct Entry_t {
+   Int_t fI;
+   Double_t fX;
+   std::vector<Int_t> fV;
+
+   bool operator==(const Entry_t &other) const { return fI == other.fI && fX == other.fX && fV == other.fV; }
+};
+
+class TTreeAsyncPrefetch : public ::testing::Test {
+protected:
+   static constexpr const char *kFileName = "ttreeasyncprefetch.root";
+   static constexpr Long64_t kNEntries = 50000;
+
+   static void SetUpTestCase()
+   {
+      TFile f(kFileName, "RECREATE");
+      TTree t("t", "t");
+      // many clusters, which the cache prefetches one after the other
+      t.SetAutoFlush(2000);
+      Int_t i = 0;
+      Double_t x = 0;
+      std::vector<Int_t> v;
+      t.Branch("i", &i);
+      t.Branch("x", &x);
+      t.Branch("v", &v);
+      for (Long64_t e = 0; e < kNEntries; ++e) {
+         i = e;
+         x = 0.5 * e * e;
+         v.assign(e % 7, -e);
+         t.Fill();
+      }
+      f.Write();
+   }
+
+   static void TearDownTestCase() { gSystem->Unlink(kFileName); }
+
+   // Read all entries, through a TTreeCache with asynchronous prefetching or without any cache
+   static std::vector<Entry_t> ReadEntries(bool prefetch)
+   {
+      std::vector<Entry_t> entries;
+      std::unique_ptr<TFile> f(TFile::Open(kFileName));
+      if (!f || f->IsZombie())
+         return entries;
+      auto t = f->Get<TTree>("t");
+      Int_t i = 0;
+      Double_t x = 0;
+      std::vector<Int_t> *v = nullptr;
+      t->SetBranchAddress("i", &i);
+      t->SetBranchAddress("x", &x);
+      t->SetBranchAddress("v", &v);
+      TFileCacheRead *cache = nullptr;
+      if (prefetch) {
+         t->SetCacheSize(256 * 1024);
+         cache = t->GetReadCache(f.get());
+         EXPECT_NE(nullptr, cache);
+         // the prefetching is only enabled by default for remote files
+         if (cache && !cache->IsEnablePrefetching())
+            cache->SetEnablePrefetching(kTRUE);
+         EXPECT_TRUE(cache && cache->IsEnablePrefetching());
+      } else {
+         t->SetCacheSize(0);
+      }
+      for (Long64_t e = 0; e < t->GetEntries(); ++e) {
+         t->GetEntry(e);
+         entries.push_back({i, x, *v});
+      }
+      if (cache) {
+         EXPECT_LT(0, cache->GetPrefetchedBlocks());
+      }
+      t->ResetBranchAddresses();
+      delete v;
+      return entries;
+   }
+
+   static void CompareWithPlainRead()
+   {
+      const auto expected = ReadEntries(false);
+      ASSERT_EQ(kNEntries, (Long64_t)expected.size());
+      const auto prefetched = ReadEntries(true);
+      ASSERT_EQ(expected.size(), prefetched.size());
+      for (std::size_t e = 0; e < expected.size(); ++e)
+         EXPECT_TRUE(expected[e] == prefetched[e]) << "entry " << e;
+   }
+};
+
+} // namespace
+
+TEST_F(TTreeAsyncPrefetch, SameEntriesAsPlainRead)
+{
+   gEnv->SetValue("TFile.AsyncPrefetching", 1);
+   CompareWithPlainRead();
+   gEnv->SetValue("TFile.AsyncPrefetching", 0);
+}
+
+#ifdef R__USE_IMT
+// The prefetched blocks are read by tasks of the implicit MT pool
+TEST_F(TTreeAsyncPrefetch, SameEntriesAsPlainReadWithIMT)
+{
+   gEnv->SetValue("TFile.AsyncPrefetching", 1);
+   ROOT::EnableImplicitMT(4);
+   CompareWithPlainRead();
+   ROOT::DisableImplicitMT();
+   gEnv->SetValue("TFile.AsyncPrefetching", 0);
+}
+#endif
@@ -0,0 +1,99 @@
+#include "TChain.h"
+#include "TFile.h"
+#include "TSystem.h"
+#include "TTree.h"
+#include "TTreeBranchPerfStats.h"
+
+#include "gtest/gtest.h"
+
+#include <string>
+#include <vector>
+
+class TTreeBranchPerfStatsTest : public ::testing::Test {
+protected:
+   static constexpr int fEntriesPerFile = 2000;
+   std::vector<std::string> fFileNames{"ttreebranchperfstats_0.root", "ttreebranchperfstats_1.root"};
+
+   void SetUp() override
+   {
+      for (const auto &fileName : fFileNames) {
+         TFile f(fileName.c_str(), "RECREATE");
+         TTree t("t", "t");
+         int i = 0;
+         std::vector<float> v;
+         t.Branch("i", &i);
+         t.Branch("v", &v);
+         t.SetAutoFlush(500);
+         for (i = 0; i < fEntriesPerFile; ++i) {
+            v.assign(i % 5, 0.5f * i);
+            t.Fill();
+         }
+         t.Write();
+      }
+   }
+
+   void TearDown() override
+   {
+      for (const auto &fileName : fFileNames)
+         gSystem->Unlink(fileName.c_str());
+   }
+};
+
+TEST_F(TTreeBranchPerfStatsTest, Chain)
+{
+   TChain chain("t");
+   for (const auto &fileName : fFileNames)
+      chain.Add(fileName.c_str());
+
+   TTreeBranchPerfStats stats;
+   stats.Start();
+   EXPECT_EQ(&stats, TTreeBranchPerfStats::GetActive());
+   for (Long64_t e = 0; e < chain.GetEntries(); ++e)
+      chain.GetEntry(e);
+   stats.Stop();
+   EXPECT_EQ(nullptr, TTreeBranchPerfStats::GetActive());
+
+   // The branches of both files add up
+   const auto infos = stats.GetBranchInfos();
+   ASSERT_EQ(2u, infos.size());
+   for (const char *name : {"i", "v"}) {
+      const auto info = stats.GetBranchInfo(name);
+      EXPECT_EQ(2 * fEntriesPerFile, info.fEntries) << name;
+      EXPECT_EQ(8, info.fBaskets) << name;
+      EXPECT_GT(info.fBytesCompressed, 0) << name;
+      EXPECT_GE(info.fBytesUncompressed, info.fBytesCompressed) << name;
+      EXPECT_GE(info.fStreamerTime, 0.) << name;
+      // The TTreeCache is set by default
+      EXPECT_EQ(info.fBaskets, info.fCacheHits + info.fCacheMisses) << name;
+      EXPECT_GT(info.fCacheHits, 0) << name;
+   }
+   EXPECT_EQ(0, stats.GetBranchInfo("w").fBaskets);
+
+   // Nothing is recorded once stopped
+   chain.GetEntry(0);
+   EXPECT_EQ(2 * fEntriesPerFile, stats.GetBranchInfo("i").fEntries);
+
+   stats.Reset();
+   EXPECT_TRUE(stats.GetBranchInfos().empty());
+}
+
+TEST_F(TTreeBranchPerfStatsTest, NoCache)
+{
+   TFile f(fFileNames[0].c_str());
+   auto t = f.Get<TTree>("t");
+   ASSERT_NE(nullptr, t);
+   t->SetCacheSize(0);
+
+   TTreeBranchPerfStats stats;
+   stats.Start();
+   for (Long64_t e = 0; e < t->GetEntries(); ++e)
+      t->GetEntry(e);
+   stats.Stop();
+
+   const auto info = stats.GetBranchInfo("v");
+   EXPECT_EQ(fEntriesPerFile, info.fEntries);
+   EXPECT_EQ(4, info.fBaskets);
+   EXPECT_EQ(0, info.fCacheHits);
+   EXPECT_EQ(0, info.fCacheMisses);
+   EXPECT_GT(info.fReadTime, 0.);
+}
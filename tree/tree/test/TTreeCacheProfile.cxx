@@ -0,0 +1,83 @@
+#include "TBranch.h"
+#include "TFile.h"
+#include "TObjArray.h"
+#include "TSystem.h"
+#include "TTree.h"
+#include "TTreeCache.h"
+
+#include "gtest/gtest.h"
+
+#include <fstream>
+#include <memory>
+#include <string>
+#include <vector>
+
+TEST(TTreeCache, AccessProfile)
+{
+   const auto fileName = "ttreecache_accessprofile.root";
+   const auto profileName = "ttreecache_accessprofile.txt";
+   {
+      TFile f(fileName, "RECREATE");
+      TTree t("t", "t");
+      int a = 0, b = 0, c = 0;
+      t.Branch("a", &a);
+      t.Branch("b", &b);
+      t.Branch("c", &c);
+      for (int i = 0; i < 1000; ++i) {
+         a = i;
+         b = 2 * i;
+         c = 3 * i;
+         t.Fill();
+      }
+      t.Write();
+   }
+
+   // Learn the branches by reading b before a, then save the profile
+   {
+      std::unique_ptr<TFile> f(TFile::Open(fileName));
+      auto t = f->Get<TTree>("t");
+      t->SetCacheSize(1024 * 1024);
+      auto cache = dynamic_cast<TTreeCache *>(t->GetReadCache(f.get()));
+      ASSERT_NE(nullptr, cache);
+      for (Long64_t i = 0; i < t->GetEntries(); ++i) {
+         t->LoadTree(i);
+         t->GetBranch("b")->GetEntry(i);
+         t->GetBranch("a")->GetEntry(i);
+      }
+      EXPECT_FALSE(cache->IsLearning());
+      EXPECT_TRUE(cache->SaveAccessProfile(profileName));
+   }
+
+   std::vector<std::string> lines;
+   {
+      std::ifstream profile(profileName);
+      std::string line;
+      while (std::getline(profile, line))
+         lines.emplace_back(line);
+   }
+   ASSERT_EQ(3u, lines.size());
+   EXPECT_EQ('#', lines[0][0]);
+   EXPECT_EQ("b", lines[1]);
+   EXPECT_EQ("a", lines[2]);
+
+   // A new cache starts with the profiled branches and without learning phase
+   {
+      std::unique_ptr<TFile> f(TFile::Open(fileName));
+      auto t = f->Get<TTree>("t");
+      t->SetCacheSize(1024 * 1024);
+      auto cache = dynamic_cast<TTreeCache *>(t->GetReadCache(f.get()));
+      ASSERT_NE(nullptr, cache);
+      EXPECT_TRUE(cache->IsLearning());
+      EXPECT_EQ(2, cache->LoadAccessProfile(profileName));
+      EXPECT_FALSE(cache->IsLearning());
+      const auto branches = cache->GetCachedBranches();
+      ASSERT_EQ(2, branches->GetEntriesFast());
+      EXPECT_STREQ("b", branches->At(0)->GetName());
+      EXPECT_STREQ("a", branches->At(1)->GetName());
+
+      EXPECT_EQ(-1, cache->LoadAccessProfile("ttreecache_nonexistent_profile.txt"));
+   }
+
+   gSystem->Unlink(fileName);
+   gSystem->Unlink(profileName);
+}
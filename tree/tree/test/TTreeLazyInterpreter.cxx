@@ -0,0 +1,77 @@
+// Run with ROOT_LAZY_INTERPRETER=1, see Root.LazyInterpreter: the interpreter starts only when it is first needed.
+
+#include "TClass.h"
+#include "TFile.h"
+#include "TInterpreter.h"
+#include "TMethodCall.h"
+#include "TNamed.h"
+#include "TROOT.h"
+#include "TSystem.h"
+#include "TTree.h"
+
+#include "gtest/gtest.h"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+TEST(TTreeLazyInterpreter, TClassAndTTreeIO)
+{
+   ASSERT_STREQ("1", gSystem->Getenv("ROOT_LAZY_INTERPRETER"));
+
+   // Using gROOT and the interpreter lock does not start the interpreter, nor does an unused TMethodCall
+   ASSERT_NE(nullptr, gROOT);
+   {
+      R__LOCKGUARD_CLING(gInterpreterMutex);
+      TMethodCall call;
+   }
+   EXPECT_EQ(nullptr, gCling);
+
+   // The first TClass lookup does
+   auto cl = TClass::GetClass("TNamed");
+   ASSERT_NE(nullptr, cl);
+   EXPECT_NE(nullptr, gCling);
+   EXPECT_EQ(TNamed::Class(), cl);
+   EXPECT_NE(nullptr, TClass::GetClass(typeid(std::vector<float>)));
+
+   const std::string fileName = "ttreelazyinterpreter.root";
+   {
+      TFile f(fileName.c_str(), "RECREATE");
+      TTree t("t", "t");
+      TNamed named;
+      std::vector<float> v;
+      int i = 0;
+      t.Branch("named", &named);
+      t.Branch("v", &v);
+      t.Branch("i", &i);
+      for (i = 0; i < 10; ++i) {
+         named.SetName(("name" + std::to_string(i)).c_str());
+         v.assign(i, 1.f * i);
+         t.Fill();
+      }
+      f.Write();
+   }
+   {
+      std::unique_ptr<TFile> f(TFile::Open(fileName.c_str()));
+      ASSERT_TRUE(f && !f->IsZombie());
+      auto t = f->Get<TTree>("t");
+      ASSERT_NE(nullptr, t);
+      TNamed *named = nullptr;
+      std::vector<float> *v = nullptr;
+      int i = -1;
+      t->SetBranchAddress("named", &named);
+      t->SetBranchAddress("v", &v);
+      t->SetBranchAddress("i", &i);
+      ASSERT_EQ(10, t->GetEntries());
+      for (Long64_t e = 0; e < t->GetEntries(); ++e) {
+         t->GetEntry(e);
+         EXPECT_EQ(e, i);
+         EXPECT_EQ("name" + std::to_string(e), named->GetName());
+         EXPECT_EQ(std::vector<float>(e, 1.f * e), *v);
+      }
+      t->ResetBranchAddresses();
+      delete named;
+      delete v;
+   }
+   gSystem->Unlink(fileName.c_str());
+}
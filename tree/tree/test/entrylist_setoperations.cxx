@@ -0,0 +1,63 @@
+#include <set>
+
+#include "TEntryList.h"
+
+#include "gtest/gtest.h"
+
+// Fill an entry list over several blocks with a density depending on the block,
+// so that both the bits and the list representations of the blocks are used
+void FillEntryList(TEntryList &elist, std::set<Long64_t> &entries, int modulo)
+{
+   const Long64_t densities[] = {1, 2, 100, 1000};
+   for (Long64_t entry = 0; entry < 4 * 64000; ++entry) {
+      const auto density = densities[entry / 64000];
+      if ((entry * modulo) % density == 0 || entry % (7 * modulo) == 0) {
+         elist.Enter(entry);
+         entries.insert(entry);
+      }
+   }
+   elist.OptimizeStorage();
+}
+
+void ExpectEntries(TEntryList &elist, const std::set<Long64_t> &entries)
+{
+   ASSERT_EQ(elist.GetN(), (Long64_t)entries.size());
+   Int_t index = 0;
+   for (auto entry : entries) {
+      EXPECT_EQ(elist.GetEntry(index), entry);
+      EXPECT_TRUE(elist.Contains(entry));
+      ++index;
+   }
+   for (Long64_t entry = 1; entry < 4 * 64000; entry += 101)
+      EXPECT_EQ(elist.Contains(entry), (Int_t)entries.count(entry));
+}
+
+TEST(TEntryList, AddAndSubtract)
+{
+   TEntryList elist1("l1", "l1");
+   TEntryList elist2("l2", "l2");
+   std::set<Long64_t> entries1, entries2;
+   FillEntryList(elist1, entries1, 3);
+   FillEntryList(elist2, entries2, 5);
+
+   TEntryList sum(elist1);
+   sum.Add(&elist2);
+   std::set<Long64_t> sumEntries(entries1);
+   sumEntries.insert(entries2.begin(), entries2.end());
+   ExpectEntries(sum, sumEntries);
+
+   TEntryList difference(elist1);
+   difference.Subtract(&elist2);
+   std::set<Long64_t> differenceEntries;
+   for (auto entry : entries1)
+      if (!entries2.count(entry))
+         differenceEntries.insert(entry);
+   ExpectEntries(difference, differenceEntries);
+
+   sum.Subtract(&elist1);
+   std::set<Long64_t> onlySecond;
+   for (auto entry : entries2)
+      if (!entries1.count(entry))
+         onlySecond.insert(entry);
+   ExpectEntries(sum, onlySecond);
+}
@@ -179,6 +179,7 @@ private:
    enum class ETask : unsigned char {
       kNoTask,        ///< no task is being executed
       kProcByRange,   ///< a Process method is being executed and each worker will process a certain range of each file
+      kProcByTree,    ///< a Process method is being executed on a tree and each worker will process a certain range of it
       kProcByFile     ///< a Process method is being executed and each worker will process a different file
    };
 
@@ -216,26 +217,16 @@ auto TTreeProcessorMP::Process(const std::vector<std::string>& fileNames, F proc
    }
 
 
-   if(fileNames.size() < nWorkers) {
-      //TTree entry granularity. For each file, we divide entries equally between workers
-      fTaskType = ETask::kProcByRange;
-      //Tell workers to start processing entries
-      fNToProcess = nWorkers*fileNames.size(); //this is the total number of ranges that will be processed by all workers cumulatively
-      std::vector<unsigned> args(nWorkers);
-      std::iota(args.begin(), args.end(), 0);
-      fNProcessed = Broadcast(MPCode::kProcRange, args);
-      if(fNProcessed < nWorkers)
-         Error("TTreeProcessorMP::Process", "[E][C] There was an error while sending tasks to workers. Some entries might not be processed.");
-   } else {
-      //file granularity. each worker processes one whole file as a single task
-      fTaskType = ETask::kProcByFile;
-      fNToProcess = fileNames.size();
-      std::vector<unsigned> args(nWorkers);
-      std::iota(args.begin(), args.end(), 0);
-      fNProcessed = Broadcast(MPCode::kProcFile, args);
-      if(fNProcessed < nWorkers)
-         Error("TTreeProcessorMP::Process", "[E][C] There was an error while sending tasks to workers. Some entries might not be processed.");
-   }
+   //cluster granularity. Each file is divided in ranges of clusters, which are requested by the
+   //workers when idle, so that workers reading slow files get less ranges
+   fTaskType = ETask::kProcByRange;
+   //Tell workers to start processing entries
+   fNToProcess = TMPWorkerTree::GetNRanges(nWorkers, fileNames.size()) * fileNames.size(); //this is the total number of ranges that will be processed by all workers cumulatively
+   std::vector<unsigned> args(nWorkers);
+   std::iota(args.begin(), args.end(), 0);
+   fNProcessed = Broadcast(MPCode::kProcRange, args);
+   if(fNProcessed < nWorkers)
+      Error("TTreeProcessorMP::Process", "[E][C] There was an error while sending tasks to workers. Some entries might not be processed.");
 
    //collect results, distribute new tasks
    std::vector<TObject*> reslist;
@@ -319,11 +310,11 @@ auto TTreeProcessorMP::Process(TTree& tree, F procFunc, TEntryList &entries,
       return nullptr;
    }
 
-   //divide entries equally between workers
-   fTaskType = ETask::kProcByRange;
+   //divide entries in cluster ranges, which are requested by the workers when idle
+   fTaskType = ETask::kProcByTree;
 
    //tell workers to start processing entries
-   fNToProcess = nWorkers; //this is the total number of ranges that will be processed by all workers cumulatively
+   fNToProcess = TMPWorkerTree::GetNRanges(nWorkers, 1); //this is the total number of ranges that will be processed by all workers cumulatively
    std::vector<unsigned> args(nWorkers);
    std::iota(args.begin(), args.end(), 0);
    fNProcessed = Broadcast(MPCode::kProcTree, args);
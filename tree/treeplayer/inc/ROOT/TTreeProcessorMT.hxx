@@ -25,7 +25,9 @@
 #include "ROOT/InternalTreeUtils.hxx" // RFriendInfo
 
 #include <functional>
+#include <limits>
 #include <memory>
+#include <utility>
 #include <vector>
 
 /** \class TTreeView
@@ -78,6 +80,9 @@ private:
    /// User-defined selection of entry numbers to be processed, empty if none was provided
    TEntryList fEntryList;
    const Internal::TreeUtils::RFriendInfo fFriendInfo;
+   /// Global entry numbers [first, second) to be processed, or the positions in fEntryList if there is one
+   std::pair<Long64_t, Long64_t> fEntryRange{0ll, std::numeric_limits<Long64_t>::max()};
+   bool fHasEntryRange = false;
    ROOT::TThreadExecutor fPool; ///<! Thread pool for processing.
 
    /// Thread-local TreeViews
@@ -94,6 +99,7 @@ public:
    TTreeProcessorMT(TTree &tree, const TEntryList &entries, UInt_t nThreads = 0u);
    TTreeProcessorMT(TTree &tree, UInt_t nThreads = 0u);
 
+   void SetEntryRange(Long64_t begin, Long64_t end);
    void Process(std::function<void(TTreeReader &)> func);
 
    static void SetTasksPerWorkerHint(unsigned int m);
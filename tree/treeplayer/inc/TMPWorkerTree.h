@@ -43,6 +43,8 @@ public:
    TMPWorkerTree(const TMPWorkerTree &) = delete;
    TMPWorkerTree &operator=(const TMPWorkerTree &) = delete;
 
+   static UInt_t GetNRanges(UInt_t nWorkers, std::size_t nFiles);
+
 protected:
 
    void         CloseFile();
@@ -53,6 +55,7 @@ protected:
                   std::string &errmsg);
    TFile       *OpenFile(const std::string& fileName);
    virtual void Process(UInt_t, MPCodeBufPair &) {}
+   static void  GetClusterRange(TTree *tree, UInt_t rangeN, UInt_t nRanges, Long64_t &start, Long64_t &finish);
    TTree       *RetrieveTree(TFile *fp);
    virtual void SendResult() { }
    void         Setup();
@@ -198,6 +201,12 @@ void TMPWorkerTreeFunc<F>::Process(UInt_t code, MPCodeBufPair &msg)
       return;
    }
 
+   // there are less clusters than ranges, nothing to do
+   if (start >= finish) {
+      MPSend(GetSocket(), MPCode::kIdling);
+      return;
+   }
+
    // create a TTreeReader that reads this range of entries
    TTreeReader reader(fTree, enl);
 
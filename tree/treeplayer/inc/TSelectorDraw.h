@@ -62,11 +62,14 @@ protected:
    Bool_t         fCleanElist;       ///<  True if original Tree elist must be saved
    Bool_t         fObjEval;          ///<  True if fVar1 returns an object (or pointer to).
    Long64_t       fCurrentSubEntry;  ///<  Current subentry when fSelectMultiple is true. Used to fill TEntryListArray
+   Long64_t       fBufferSize;       ///<! Number of values that fit in fVal and fW
 
 protected:
    virtual void      ClearFormula();
    virtual Bool_t    CompileVariables(const char *varexp="", const char *selection="");
    virtual void      InitArrays(Int_t newsize);
+   virtual Bool_t    InitWorker(const TSelectorDraw &master, TTree *tree, TObject *object, const char *varexp,
+                                const char *selection);
 
 private:
    TSelectorDraw(const TSelectorDraw&);             // not implemented
@@ -112,6 +115,7 @@ public:
    virtual void      ProcessFill(Long64_t entry);
    virtual void      ProcessFillMultiple(Long64_t entry);
    virtual void      ProcessFillObject(Long64_t entry);
+   virtual Bool_t    ProcessMT(Long64_t nentries, Long64_t firstentry);
    virtual void      SetEstimate(Long64_t n);
    virtual UInt_t    SplitNames(const TString &varexp, std::vector<TString> &names);
    virtual void      TakeAction();
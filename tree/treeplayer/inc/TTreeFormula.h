@@ -131,6 +131,8 @@ protected:
 
    RealInstanceCache fRealInstanceCache;              ///<! Cache accelerating the GetRealInstance function
 
+   void                     *fJitFunction = nullptr;  ///<! Function compiled from the operators, see SetCompiledMode()
+
    TTreeFormula(const char *name, const char *formula, TTree *tree, const std::vector<std::string>& aliases);
    void Init(const char *name, const char *formula);
    Bool_t      BranchHasMethod(TLeaf* leaf, TBranch* branch, const char* method,const char* params, Long64_t readentry) const;
@@ -168,6 +170,11 @@ private:
    TTreeFormula& operator=(const TTreeFormula&) = delete;
 
    template<typename T> T GetConstant(Int_t k);
+   template<typename T> Bool_t EvalDefinedVariable(Int_t oper, Int_t code, Int_t instance, Bool_t willLoad, T &value);
+
+   void          JitCompile();
+   static Bool_t JitEvalVariable(void *formula, Int_t oper, Int_t code, Int_t instance, Bool_t willLoad, Double_t *value);
+   static void   JitBooleanOptimization(void *formula);
 
 public:
    TTreeFormula();
@@ -191,6 +198,9 @@ public:
    virtual Int_t       GetMultiplicity() const {return fMultiplicity;}
    virtual TLeaf      *GetLeaf(Int_t n) const;
    virtual Int_t       GetNcodes() const {return fNcodes;}
+           Bool_t      IsCompiled() const { return fJitFunction != nullptr; }
+   static  Bool_t      IsCompiledMode();
+   static  void        SetCompiledMode(Bool_t on = kTRUE);
    virtual Int_t       GetNdata();
    //GetNdata should probably be const.  However it need to cache some information about the actual dimension
    //of arrays, so if GetNdata is const, the variables fUsedSizes and fCumulUsedSizes need to be declared
@@ -24,8 +24,17 @@
 
 #include "TVirtualIndex.h"
 
+#include <atomic>
+#include <mutex>
+
 class TTreeFormula;
 
+namespace ROOT {
+namespace Internal {
+class TTreeIndexHash;
+}
+}
+
 class TTreeIndex : public TVirtualIndex {
 
 protected:
@@ -39,9 +48,14 @@ protected:
    TTreeFormula  *fMinorFormula;        ///<! Pointer to minor TreeFormula
    TTreeFormula  *fMajorFormulaParent;  ///<! Pointer to major TreeFormula in Parent tree (if any)
    TTreeFormula  *fMinorFormulaParent;  ///<! Pointer to minor TreeFormula in Parent tree (if any)
+   Bool_t         fHashLookup{kFALSE};  ///<! Whether GetEntryNumberWithIndex uses a hash table of the index values
+   mutable std::atomic<ROOT::Internal::TTreeIndexHash *> fHash{nullptr}; ///<! Hash table of the index values, built on the first lookup
+   mutable std::mutex fHashMutex;       ///<! Protects the construction of fHash
 
    TTreeFormula  *GetMajorFormulaParent(const TTree *parent);
    TTreeFormula  *GetMinorFormulaParent(const TTree *parent);
+   const ROOT::Internal::TTreeIndexHash *GetHash() const;
+   void           ResetHash();
 
 private:
    TTreeIndex(const TTreeIndex&) = delete;            // Not implemented.
@@ -63,10 +77,12 @@ public:
    const char            *GetMajorName()    const {return fMajorName.Data();}
    const char            *GetMinorName()    const {return fMinorName.Data();}
    virtual Long64_t       GetN()            const {return fN;}
+   Bool_t                 GetHashLookup()   const {return fHashLookup;}
    virtual TTreeFormula  *GetMajorFormula();
    virtual TTreeFormula  *GetMinorFormula();
    virtual Bool_t         IsValidFor(const TTree *parent);
    virtual void           Print(Option_t *option="") const;
+   void                   SetHashLookup(Bool_t on = kTRUE);
    virtual void           UpdateFormulaLeaves(const TTree *parent);
    virtual void           SetTree(const TTree *T);
 
@@ -88,6 +88,7 @@ public:
    TTreePerfStats(const char *name, TTree *T);
    virtual ~TTreePerfStats();
    virtual void     Browse(TBrowser *b);
+   TTree           *CloneOptimized(Option_t *option = "");
    virtual Int_t    DistancetoPrimitive(Int_t px, Int_t py);
    virtual void     Draw(Option_t *option="");
    virtual void     ExecuteEvent(Int_t event, Int_t px, Int_t py);
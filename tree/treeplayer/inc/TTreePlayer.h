@@ -55,6 +55,7 @@ protected:
    TSelector     *fSelectorUpdate;  ///<! Set to the selector address when it's entry list needs to be updated by the UpdateFormulaLeaves function
 
 protected:
+   void           CopyClusters(TTree *tree, TTreeFormula *select, Long64_t firstentry, Long64_t nentries);
    const   char  *GetNameByIndex(TString &varexp, Int_t *index,Int_t colindex);
    void           DeleteSelectorFromFile();
 
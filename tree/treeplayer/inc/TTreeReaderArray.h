@@ -17,6 +17,7 @@
 
 #include "TTreeReaderValue.h"
 #include "TTreeReaderUtils.h"
+#include <ROOT/RSpan.hxx>
 #include <type_traits>
 
 namespace ROOT {
@@ -34,6 +35,9 @@ Base class of TTreeReaderArray.
 
       std::size_t GetSize() const { return fImpl->GetSize(GetProxy()); }
       Bool_t IsEmpty() const { return !GetSize(); }
+      /// Whether the elements of the entry are stored contiguously in the memory of the branch, e.g. for a split
+      /// `std::vector` of fundamental types, a C-style array or a leaf list. Only known once an entry was loaded.
+      bool IsContiguous() const { return fImpl && fImpl->IsContiguous(GetProxy()); }
 
       virtual EReadStatus GetReadStatus() const { return fImpl ? fImpl->fReadStatus : kReadError; }
 
@@ -207,6 +211,16 @@ public:
    T &operator[](std::size_t idx) { return At(idx); }
    const T &operator[](std::size_t idx) const { return At(idx); }
 
+   /// The elements of the current entry, without copies: the span points to the memory of the branch.
+   /// Empty if the elements are not contiguous, see IsContiguous().
+   std::span<T> GetSpan()
+   {
+      const auto size = GetSize();
+      if (size == 0 || !IsContiguous())
+         return std::span<T>();
+      return std::span<T>(&At(0), size);
+   }
+
    iterator begin() { return iterator(0u, this); }
    iterator end() { return iterator(GetSize(), this); }
    const_iterator begin() const { return cbegin(); }
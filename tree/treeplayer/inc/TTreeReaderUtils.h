@@ -76,6 +76,8 @@ namespace Internal {
       virtual ~TVirtualCollectionReader();
       virtual size_t GetSize(Detail::TBranchProxy*) = 0;
       virtual void* At(Detail::TBranchProxy*, size_t /*idx*/) = 0;
+      /// Whether the elements are stored one after the other, i.e. At(i) is At(0) plus i times the element size.
+      virtual bool IsContiguous(Detail::TBranchProxy*) { return false; }
    };
 
 }
@@ -15,6 +15,8 @@
 #include "TError.h"
 #include "TMPWorkerTree.h"
 #include "TEnv.h"
+#include "TChain.h"
+#include <algorithm>
 #include <string>
 
 //////////////////////////////////////////////////////////////////////////
@@ -270,6 +272,45 @@ void TMPWorkerTreeSel::Process(UInt_t code, MPCodeBufPair &msg)
    return;
 }
 
+//////////////////////////////////////////////////////////////////////////
+/// Number of entry ranges in which each of the nFiles files is split.
+/// Workers ask for a new range each time they are done with one, so that the
+/// ranges are dynamically balanced between the workers: there are
+/// MultiProc.NRangesPerWorker ranges per worker in total, 4 by default, which
+/// limits the time lost waiting for the last range, e.g. of a slow file, to a
+/// fraction of the processing time of a worker. Large datasets are processed a
+/// file at a time.
+
+UInt_t TMPWorkerTree::GetNRanges(UInt_t nWorkers, std::size_t nFiles)
+{
+   static const UInt_t nRangesPerWorker = std::max(gEnv->GetValue("MultiProc.NRangesPerWorker", 4), 1);
+   if (nFiles == 0)
+      return 1;
+   return std::max<UInt_t>((nWorkers * nRangesPerWorker + nFiles - 1) / nFiles, 1);
+}
+
+//////////////////////////////////////////////////////////////////////////
+/// Evaluate the rangeN-th of the nRanges ranges of the entries of tree.
+/// The ranges start at the beginning of a cluster, so that no basket is read
+/// by two workers. Some ranges are empty when there are less clusters than ranges.
+
+void TMPWorkerTree::GetClusterRange(TTree *tree, UInt_t rangeN, UInt_t nRanges, Long64_t &start, Long64_t &finish)
+{
+   Long64_t nEntries = tree->GetEntries();
+   auto rangeStart = [&](UInt_t n) -> Long64_t {
+      if (n == 0)
+         return 0;
+      if (n >= nRanges)
+         return nEntries;
+      Long64_t entry = nEntries / nRanges * n + nEntries % nRanges * n / nRanges;
+      if (tree->InheritsFrom(TChain::Class()))
+         return entry;
+      return tree->GetClusterIterator(entry).GetStartEntry();
+   };
+   start = rangeStart(rangeN);
+   finish = rangeStart(rangeN + 1);
+}
+
 //////////////////////////////////////////////////////////////////////////
 /// Load the required tree and evaluate the processing range
 
@@ -303,19 +344,6 @@ Int_t TMPWorkerTree::LoadTree(UInt_t code, MPCodeBufPair &msg, Long64_t &start,
       //retrieve the total number of entries ranges processed so far by TPool
       nProcessed = ReadBuffer<UInt_t>(msg.second.get());
 
-      //create entries range
-      //example: for 21 entries, 4 workers we want ranges 0-5, 5-10, 10-15, 15-21
-      //and this worker must take the rangeN-th range
-      Long64_t nEntries = fTree->GetEntries();
-      UInt_t nBunch = nEntries / fNWorkers;
-      UInt_t rangeN = nProcessed % fNWorkers;
-      start = rangeN * nBunch;
-      if (rangeN < (fNWorkers - 1)) {
-         finish = (rangeN+1)*nBunch;
-      } else {
-         finish = nEntries;
-      }
-
       //process tree
       tree = fTree;
       CloseFile(); // May not be needed
@@ -337,6 +365,9 @@ Int_t TMPWorkerTree::LoadTree(UInt_t code, MPCodeBufPair &msg, Long64_t &start,
          }
       }
 
+      //create entries range, this worker must take the rangeN-th range
+      GetClusterRange(fTree, nProcessed % GetNRanges(fNWorkers, 1), GetNRanges(fNWorkers, 1), start, finish);
+
    } else {
 
       if (code == MPCode::kProcRange) {
@@ -344,7 +375,7 @@ Int_t TMPWorkerTree::LoadTree(UInt_t code, MPCodeBufPair &msg, Long64_t &start,
          //retrieve the total number of entries ranges processed so far by TPool
          nProcessed = ReadBuffer<UInt_t>(msg.second.get());
          //evaluate the file and the entries range to process
-         fileN = nProcessed / fNWorkers;
+         fileN = nProcessed / GetNRanges(fNWorkers, fFileNames.size());
       } else if (code == MPCode::kProcFile) {
          mgroot += "MPCode::kProcFile: ";
          //evaluate the file and the entries range to process
@@ -382,17 +413,9 @@ Int_t TMPWorkerTree::LoadTree(UInt_t code, MPCodeBufPair &msg, Long64_t &start,
 
       //create entries range
       if (code == MPCode::kProcRange) {
-         //example: for 21 entries, 4 workers we want ranges 0-5, 5-10, 10-15, 15-21
-         //and this worker must take the rangeN-th range
-         Long64_t nEntries = tree->GetEntries();
-         UInt_t nBunch = nEntries / fNWorkers;
-         if(nEntries % fNWorkers) nBunch++;
-         UInt_t rangeN = nProcessed % fNWorkers;
-         start = rangeN * nBunch;
-         if(rangeN < (fNWorkers-1))
-            finish = (rangeN+1)*nBunch;
-         else
-            finish = nEntries;
+         //this worker must take the rangeN-th range
+         UInt_t nRanges = GetNRanges(fNWorkers, fFileNames.size());
+         GetClusterRange(tree, nProcessed % nRanges, nRanges, start, finish);
       } else {
          start = 0;
          finish = tree->GetEntries();
@@ -406,18 +429,14 @@ Int_t TMPWorkerTree::LoadTree(UInt_t code, MPCodeBufPair &msg, Long64_t &start,
    if (fEntryList && enl) {
       if ((*enl = fEntryList->GetEntryList(fTree->GetName(), TUrl(fFile->GetName()).GetFile()))) {
          // create entries range
-         if (code == MPCode::kProcRange) {
-            // example: for 21 entries, 4 workers we want ranges 0-5, 5-10, 10-15, 15-21
+         if (code == MPCode::kProcRange || code == MPCode::kProcTree) {
+            // example: for 21 entries and 4 ranges, we want ranges 0-5, 5-10, 10-15, 15-21
             // and this worker must take the rangeN-th range
             ULong64_t nEntries = (*enl)->GetN();
-            UInt_t nBunch = nEntries / fNWorkers;
-            if (nEntries % fNWorkers) nBunch++;
-            UInt_t rangeN = nProcessed % fNWorkers;
-            start = rangeN * nBunch;
-            if (rangeN < (fNWorkers - 1))
-               finish = (rangeN + 1) * nBunch;
-            else
-               finish = nEntries;
+            UInt_t nRanges = GetNRanges(fNWorkers, (code == MPCode::kProcRange) ? fFileNames.size() : 1);
+            UInt_t rangeN = nProcessed % nRanges;
+            start = nEntries * rangeN / nRanges;
+            finish = nEntries * (rangeN + 1) / nRanges;
          } else {
             start = 0;
             finish = (*enl)->GetN();
@@ -35,8 +35,20 @@ A specialized TSelector for TTree::Draw.
 #include "TStyle.h"
 #include "TClass.h"
 #include "TColor.h"
+#include "TMath.h"
 #include "strlcpy.h"
 
+#include "RConfigure.h"
+#ifdef R__USE_IMT
+#include "ROOT/TTreeProcessorMT.hxx"
+#include "TChain.h"
+#include "TFile.h"
+#include "TTreeReader.h"
+#include <memory>
+#include <mutex>
+#include <vector>
+#endif
+
 ClassImp(TSelectorDraw);
 
 const Int_t kCustomHistogram = BIT(17);
@@ -78,6 +90,7 @@ TSelectorDraw::TSelectorDraw()
    fWeight         = 1;
    fCurrentSubEntry = -1;
    fTreeElistArray  = 0;
+   fBufferSize      = 0;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -921,13 +934,14 @@ void TSelectorDraw::Begin(TTree *tree)
    fWeight  = fTree->GetWeight();
    fNfill   = 0;
 
+   fBufferSize = fTree->GetEstimate();
    for (i = 0; i < fDimension; ++i) {
       if (!fVal[i] && fVar[i]) {
-         fVal[i] = new Double_t[(Int_t)fTree->GetEstimate()];
+         fVal[i] = new Double_t[(Int_t)fBufferSize];
       }
    }
 
-   if (!fW)             fW  = new Double_t[(Int_t)fTree->GetEstimate()];
+   if (!fW)             fW  = new Double_t[(Int_t)fBufferSize];
 
    for (i = 0; i < fValSize; ++i) {
       fVmin[i] = DBL_MAX;
@@ -1191,7 +1205,7 @@ void TSelectorDraw::ProcessFill(Long64_t entry)
       }
    }
    fNfill++;
-   if (fNfill >= fTree->GetEstimate()) {
+   if (fNfill >= fBufferSize) {
       TakeAction();
       fNfill = 0;
    }
@@ -1232,7 +1246,7 @@ void TSelectorDraw::ProcessFillMultiple(Long64_t entry)
          if (fVar[i]) fVal[i][fNfill] = fVar[i]->EvalInstance(0);
       }
       fNfill++;
-      if (fNfill >= fTree->GetEstimate()) {
+      if (fNfill >= fBufferSize) {
          TakeAction();
          fNfill = 0;
       }
@@ -1263,7 +1277,7 @@ void TSelectorDraw::ProcessFillMultiple(Long64_t entry)
       fW[fNfill] = ww;
 
       fNfill++;
-      if (fNfill >= fTree->GetEstimate()) {
+      if (fNfill >= fBufferSize) {
          TakeAction();
          fNfill = 0;
       }
@@ -1329,7 +1343,7 @@ void TSelectorDraw::ProcessFillObject(Long64_t /*entry*/)
 
          }
       }
-      if (fNfill >= fTree->GetEstimate()) {
+      if (fNfill >= fBufferSize) {
          TakeAction();
          fNfill = 0;
       }
@@ -1337,6 +1351,166 @@ void TSelectorDraw::ProcessFillObject(Long64_t /*entry*/)
 
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Prepare this selector to fill `object` for a task of ProcessMT() on `tree`,
+/// with the action of `master`. Return kFALSE if the variables cannot be
+/// compiled for this tree.
+
+Bool_t TSelectorDraw::InitWorker(const TSelectorDraw &master, TTree *tree, TObject *object, const char *varexp,
+                                 const char *selection)
+{
+   // Size of the buffers of the tasks, there is no need for more to fill histograms
+   const Long64_t kWorkerBufferSize = 10000;
+
+   fTree = tree;
+   fOption = master.fOption;
+   if (!CompileVariables(varexp, selection) || fDimension != master.fDimension || fObjEval)
+      return kFALSE;
+   for (Int_t i = 0; i < fValSize; ++i)
+      fVarMultiple[i] = kFALSE;
+   for (Int_t i = 0; i < fDimension; ++i) {
+      if (fVar[i]->GetMultiplicity()) fVarMultiple[i] = kTRUE;
+   }
+   fSelectMultiple = fSelect && fSelect->GetMultiplicity();
+
+   fAction = TMath::Abs(master.fAction);
+   fObject = object;
+   fForceRead = fTree->TestBit(TTree::kForceRead);
+   fWeight = fTree->GetWeight();
+   fNfill = 0;
+   fBufferSize = TMath::Min(master.fBufferSize, kWorkerBufferSize);
+   for (Int_t i = 0; i < fDimension; ++i)
+      fVal[i] = new Double_t[(Int_t)fBufferSize];
+   fW = new Double_t[(Int_t)fBufferSize];
+   return kTRUE;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Fill the histogram in parallel if the implicit multi-threading is enabled
+/// (see ROOT::EnableImplicitMT). Return kFALSE, without processing any entry,
+/// if it cannot be done: the entries must then be processed sequentially.
+///
+/// The clusters of entries are processed by a ROOT::TTreeProcessorMT, on its
+/// own copies of the tree. Each task compiles its formulas and fills a
+/// private copy of the histogram, which are all added to the histogram at the
+/// end. This is done for 1-D and 2-D histograms and for profiles with fixed
+/// axes, when all the entries of a tree or chain read from files (without
+/// entry list) are processed. Since the values of the variables are not kept
+/// in the buffers of GetVal(), it is done only when there are more entries
+/// than the estimate of the tree (see TTree::SetEstimate), i.e. when the
+/// buffers would not have kept them all anyway.
+
+Bool_t TSelectorDraw::ProcessMT(Long64_t nentries, Long64_t firstentry)
+{
+#ifdef R__USE_IMT
+   if (!ROOT::IsImplicitMTEnabled() || !fTree || !fObject)
+      return kFALSE;
+   // The limits are not estimated for the histograms with fixed axes (negative action)
+   const Int_t action = TMath::Abs(fAction);
+   if ((action != 1 && action != 2 && action != 4) || fObjEval || !fObject->InheritsFrom(TH1::Class()))
+      return kFALSE;
+   TH1 *hist = (TH1 *)fObject;
+   if (hist->GetXaxis()->CanExtend() || hist->GetYaxis()->CanExtend() || hist->GetZaxis()->CanExtend())
+      return kFALSE;
+   for (Int_t i = 0; i < fDimension; ++i) {
+      if (fVar[i]->IsString()) return kFALSE;
+   }
+   // The pad is updated during the loop from the main thread only
+   if (fTree->GetUpdate())
+      return kFALSE;
+   if (firstentry != 0 || nentries != fTree->GetEntries() || nentries <= fTree->GetEstimate())
+      return kFALSE;
+   if (fTree->GetEntryList() || fTree->GetEventList())
+      return kFALSE;
+   // The entries not yet written are not seen by the copies of the tree
+   TFile *file = fTree->GetCurrentFile();
+   if (!file || file->IsWritable())
+      return kFALSE;
+
+   TString varexp;
+   for (Int_t i = 0; i < fDimension; ++i) {
+      if (i) varexp += ":";
+      varexp += fVar[i]->GetTitle();
+   }
+   const TString selection = fSelect ? fSelect->GetTitle() : "";
+   // The weights of the trees of a chain are read from the files
+   const Bool_t globalWeight = !fTree->InheritsFrom(TChain::Class()) || fTree->TestBit(TChain::kGlobalWeight);
+   const Double_t weight = fTree->GetWeight();
+   TList *aliases = fTree->GetListOfAliases();
+
+   std::unique_ptr<TH1> model;
+   {
+      TDirectory::TContext ctxt(nullptr);
+      model.reset((TH1 *)hist->Clone());
+   }
+   model->Reset();
+
+   // The formulas are compiled and the histograms are cloned one task at a time
+   std::mutex mutex;
+   std::vector<std::unique_ptr<TH1>> results;
+   Long64_t selectedRows = 0;
+   Bool_t failed = kFALSE;
+   auto processTask = [&](TTreeReader &reader) {
+      if (!reader.Next())
+         return;
+      TTree *tree = reader.GetTree();
+      TSelectorDraw worker;
+      std::unique_ptr<TH1> object;
+      {
+         std::lock_guard<std::mutex> lock(mutex);
+         if (failed)
+            return;
+         TDirectory::TContext ctxt(nullptr);
+         object.reset((TH1 *)model->Clone());
+         if (globalWeight)
+            tree->SetWeight(weight, "global");
+         if (aliases) {
+            for (TObject *alias : *aliases)
+               tree->SetAlias(alias->GetName(), alias->GetTitle());
+         }
+         if (!worker.InitWorker(*this, tree, object.get(), varexp, selection)) {
+            failed = kTRUE;
+            return;
+         }
+      }
+      Int_t treeNumber = tree->GetTreeNumber();
+      do {
+         if (tree->GetTreeNumber() != treeNumber) {
+            treeNumber = tree->GetTreeNumber();
+            worker.Notify();
+         }
+         worker.ProcessFill(tree->GetTree()->GetReadEntry());
+      } while (reader.Next());
+      if (worker.fNfill)
+         worker.TakeAction();
+
+      std::lock_guard<std::mutex> lock(mutex);
+      selectedRows += worker.fSelectedRows;
+      results.emplace_back(std::move(object));
+   };
+
+   try {
+      ROOT::TTreeProcessorMT processor(*fTree);
+      processor.Process(processTask);
+   } catch (const std::exception &) {
+      return kFALSE;
+   }
+   if (failed)
+      return kFALSE;
+
+   for (auto &result : results)
+      hist->Add(result.get());
+   fAction = action;
+   fSelectedRows += selectedRows;
+   fNfill = 0;
+   return kTRUE;
+#else
+   (void)nentries;
+   (void)firstentry;
+   return kFALSE;
+#endif
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Set number of entries to estimate variable limits.
 
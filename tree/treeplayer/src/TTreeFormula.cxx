@@ -51,9 +51,18 @@
 #include <cstdlib>
 #include <typeinfo>
 #include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <string>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
 
 const Int_t kMaxLen     = 1024;
 
+// See TTreeFormula::SetCompiledMode
+static std::atomic<Bool_t> gCompiledMode{kFALSE};
+
 /** \class TTreeFormula
 Used to pass a selection expression to the Tree drawing routine. See TTree::Draw
 
@@ -315,6 +324,8 @@ void TTreeFormula::Init(const char*name, const char* expression)
 
    }
 
+   if (gCompiledMode) JitCompile();
+
    if(savedir) savedir->cd();
 }
 
@@ -3905,6 +3916,12 @@ template<typename T> T FindMax(TTreeFormula *arr, TTreeFormula *condition) {
 namespace {
 
 template <typename T> T fmod_local(T x, T y) { return fmod(x,y); }
+
+// Signature of the functions compiled by TTreeFormula::JitCompile
+using JitVariable_t = Bool_t (*)(void *, Int_t, Int_t, Int_t, Bool_t, Double_t *);
+using JitBooleanOptimization_t = void (*)(void *);
+using JitFunction_t = Double_t (*)(void *, Int_t, Bool_t, JitVariable_t, JitBooleanOptimization_t);
+
 template <> Long64_t fmod_local(Long64_t x, Long64_t y) { return fmod((LongDouble_t)x,(LongDouble_t)y); }
 
 template<typename T> inline void SetMethodParam(TMethodCall *method, T p) { method->SetParam(p); }
@@ -3935,6 +3952,69 @@ template<> inline LongDouble_t TTreeFormula::GetConstant(Int_t k) {
 }
 template<> inline Long64_t TTreeFormula::GetConstant(Int_t k) { return (Long64_t)GetConstant<LongDouble_t>(k); }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Evaluate the tree variable `code` of the operator `oper` in `value`.
+/// Return kFALSE if the instance is out of range, in which case the formula
+/// evaluates to 0.
+
+template<typename T>
+inline Bool_t TTreeFormula::EvalDefinedVariable(Int_t oper, Int_t code, Int_t instance, Bool_t willLoad, T &value)
+{
+   const Int_t lookupType = fLookupType[code];
+   switch (lookupType) {
+      case kIndexOfEntry: value = (T)fTree->GetReadEntry(); return kTRUE;
+      case kIndexOfLocalEntry: value = (T)fTree->GetTree()->GetReadEntry(); return kTRUE;
+      case kEntries:      value = (T)fTree->GetEntries(); return kTRUE;
+      case kLocalEntries: value = (T)fTree->GetTree()->GetEntries(); return kTRUE;
+      case kLength:       value = fManager->fNdata; return kTRUE;
+      case kLengthFunc:   value = ((TTreeFormula*)fAliases.UncheckedAt(oper))->GetNdata(); return kTRUE;
+      case kIteration:    value = instance; return kTRUE;
+      case kSum:          value = Summing<T>((TTreeFormula*)fAliases.UncheckedAt(oper)); return kTRUE;
+      case kMin:          value = FindMin<T>((TTreeFormula*)fAliases.UncheckedAt(oper)); return kTRUE;
+      case kMax:          value = FindMax<T>((TTreeFormula*)fAliases.UncheckedAt(oper)); return kTRUE;
+
+      case kDirect:     { TT_EVAL_INIT_LOOP; value = leaf->GetTypedValue<T>(real_instance); return kTRUE; }
+      case kMethod:     { TT_EVAL_INIT_LOOP; value = GetValueFromMethod(code,leaf); return kTRUE; }
+      case kDataMember: { TT_EVAL_INIT_LOOP; value = ((TFormLeafInfo*)fDataMembers.UncheckedAt(code))->
+                                 GetTypedValue<T>(leaf,real_instance); return kTRUE; }
+      case kTreeMember: { TREE_EVAL_INIT_LOOP; value = ((TFormLeafInfo*)fDataMembers.UncheckedAt(code))->
+                                 GetTypedValue<T>((TLeaf*)0x0,real_instance); return kTRUE; }
+      case kEntryList: { TEntryList *elist = (TEntryList*)fExternalCuts.At(code);
+         value = elist->Contains(fTree->GetReadEntry());
+         return kTRUE;}
+      case -1: break;
+      default: value = 0; return kTRUE;
+   }
+   switch (fCodes[code]) {
+      case -2: {
+         TCutG *gcut = (TCutG*)fExternalCuts.At(code);
+         TTreeFormula *fx = (TTreeFormula *)gcut->GetObjectX();
+         TTreeFormula *fy = (TTreeFormula *)gcut->GetObjectY();
+         if (fDidBooleanOptimization) {
+            fx->ResetLoading();
+            fy->ResetLoading();
+         }
+         T xcut = fx->EvalInstance<T>(instance);
+         T ycut = fy->EvalInstance<T>(instance);
+         value = gcut->IsInside(xcut,ycut);
+         return kTRUE;
+      }
+      case -1: {
+         TCutG *gcut = (TCutG*)fExternalCuts.At(code);
+         TTreeFormula *fx = (TTreeFormula *)gcut->GetObjectX();
+         if (fDidBooleanOptimization) {
+            fx->ResetLoading();
+         }
+         value = fx->EvalInstance<T>(instance);
+         return kTRUE;
+      }
+      default: {
+         value = 0;
+         return kTRUE;
+      }
+   }
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Evaluate this treeformula.
 
@@ -4006,6 +4086,13 @@ T TTreeFormula::EvalInstance(Int_t instance, const char *stringStackArg[])
       }
    }
 
+   if (std::is_same<T, Double_t>::value && fJitFunction) {
+      const Bool_t willLoad = (instance==0 || fNeedLoading); fNeedLoading = kFALSE;
+      if (willLoad) fDidBooleanOptimization = kFALSE;
+      return ((JitFunction_t)fJitFunction)(this, instance, willLoad, &TTreeFormula::JitEvalVariable,
+                                           &TTreeFormula::JitBooleanOptimization);
+   }
+
    T tab[kMAXFOUND];
    const Int_t kMAXSTRINGFOUND = 10;
    const char *stringStackLocal[kMAXSTRINGFOUND];
@@ -4224,59 +4311,8 @@ T TTreeFormula::EvalInstance(Int_t instance, const char *stringStackArg[])
          if (newaction == kDefinedVariable) {
 
             const Int_t code = (oper & kTFOperMask);
-            const Int_t lookupType = fLookupType[code];
-            switch (lookupType) {
-               case kIndexOfEntry: tab[pos++] = (T)fTree->GetReadEntry(); continue;
-               case kIndexOfLocalEntry: tab[pos++] = (T)fTree->GetTree()->GetReadEntry(); continue;
-               case kEntries:      tab[pos++] = (T)fTree->GetEntries(); continue;
-               case kLocalEntries: tab[pos++] = (T)fTree->GetTree()->GetEntries(); continue;
-               case kLength:       tab[pos++] = fManager->fNdata; continue;
-               case kLengthFunc:   tab[pos++] = ((TTreeFormula*)fAliases.UncheckedAt(i))->GetNdata(); continue;
-               case kIteration:    tab[pos++] = instance; continue;
-               case kSum:          tab[pos++] = Summing<T>((TTreeFormula*)fAliases.UncheckedAt(i)); continue;
-               case kMin:          tab[pos++] = FindMin<T>((TTreeFormula*)fAliases.UncheckedAt(i)); continue;
-               case kMax:          tab[pos++] = FindMax<T>((TTreeFormula*)fAliases.UncheckedAt(i)); continue;
-
-               case kDirect:     { TT_EVAL_INIT_LOOP; tab[pos++] = leaf->GetTypedValue<T>(real_instance); continue; }
-               case kMethod:     { TT_EVAL_INIT_LOOP; tab[pos++] = GetValueFromMethod(code,leaf); continue; }
-               case kDataMember: { TT_EVAL_INIT_LOOP; tab[pos++] = ((TFormLeafInfo*)fDataMembers.UncheckedAt(code))->
-                                          GetTypedValue<T>(leaf,real_instance); continue; }
-               case kTreeMember: { TREE_EVAL_INIT_LOOP; tab[pos++] = ((TFormLeafInfo*)fDataMembers.UncheckedAt(code))->
-                                          GetTypedValue<T>((TLeaf*)0x0,real_instance); continue; }
-               case kEntryList: { TEntryList *elist = (TEntryList*)fExternalCuts.At(code);
-                  tab[pos++] = elist->Contains(fTree->GetReadEntry());
-                  continue;}
-               case -1: break;
-               default: tab[pos++] = 0; continue;
-            }
-            switch (fCodes[code]) {
-               case -2: {
-                  TCutG *gcut = (TCutG*)fExternalCuts.At(code);
-                  TTreeFormula *fx = (TTreeFormula *)gcut->GetObjectX();
-                  TTreeFormula *fy = (TTreeFormula *)gcut->GetObjectY();
-                  if (fDidBooleanOptimization) {
-                     fx->ResetLoading();
-                     fy->ResetLoading();
-                  }
-                  T xcut = fx->EvalInstance<T>(instance);
-                  T ycut = fy->EvalInstance<T>(instance);
-                  tab[pos++] = gcut->IsInside(xcut,ycut);
-                  continue;
-               }
-               case -1: {
-                  TCutG *gcut = (TCutG*)fExternalCuts.At(code);
-                  TTreeFormula *fx = (TTreeFormula *)gcut->GetObjectX();
-                  if (fDidBooleanOptimization) {
-                     fx->ResetLoading();
-                  }
-                  tab[pos++] = fx->EvalInstance<T>(instance);
-                  continue;
-               }
-               default: {
-                  tab[pos++] = 0;
-                  continue;
-               }
-            }
+            if (!EvalDefinedVariable<T>(i, code, instance, willLoad, tab[pos++])) return 0;
+            continue;
          }
          switch(newaction) {
 
@@ -4412,6 +4448,259 @@ template double TTreeFormula::EvalInstance<double> (int, char const**);
 template long double TTreeFormula::EvalInstance<long double> (int, char const**);
 template long long TTreeFormula::EvalInstance<long long> (int, char const**);
 
+////////////////////////////////////////////////////////////////////////////////
+/// Compile the operators of the formula in a C++ function, called instead of
+/// interpreting them in EvalInstance(), see SetCompiledMode().
+///
+/// The stack of the operators is translated in local variables and the jumps
+/// of the conditional operators in gotos. The tree variables, including
+/// `Length$`, `Sum$`, `Iteration$` and the other special variables, are still
+/// read by the formula. The formulas with a single operator, with strings,
+/// with function calls, aliases, `Alt$`, `MinIf$` or `MaxIf$` are not compiled.
+/// The functions are cached by code, shared by the many formulas with the
+/// same structure (e.g. the same expression on the trees of a chain).
+
+void TTreeFormula::JitCompile()
+{
+   fJitFunction = nullptr;
+   if (fNoper <= 1 || TestBit(kIsCharacter))
+      return;
+
+   // Depth of the stack before each operator, -1 if the operator is not reached yet
+   std::vector<Int_t> depth(fNoper + 1, -1);
+   std::vector<Bool_t> isTarget(fNoper + 1, kFALSE);
+   std::vector<std::string> code(fNoper);
+   depth[0] = 0;
+   Int_t maxDepth = 0;
+   auto reach = [&](Int_t next, Int_t d) {
+      if (next > fNoper || (depth[next] >= 0 && depth[next] != d))
+         return kFALSE;
+      depth[next] = d;
+      return kTRUE;
+   };
+   auto jumpTo = [&](Int_t next, Int_t d) {
+      if (next > fNoper)
+         return kFALSE;
+      isTarget[next] = kTRUE;
+      return reach(next, d);
+   };
+   auto t = [](Int_t k) { return "t" + std::to_string(k); };
+
+   for (Int_t i = 0; i < fNoper; ++i) {
+      const Int_t pos = depth[i];
+      if (pos < 0)
+         return;
+      const Int_t action = GetAction(i);
+      const Int_t param = GetActionParam(i);
+      // Number of values taken from and pushed to the stack
+      Int_t nin = 0;
+      Int_t nout = 0;
+      Bool_t next = kTRUE;
+      std::string x = pos >= 2 ? t(pos - 2) : "";
+      std::string y = pos >= 1 ? t(pos - 1) : "";
+      std::string &c = code[i];
+
+      switch (action) {
+         case kConstant: {
+            const Double_t value = fConst[param];
+            if (!std::isfinite(value))
+               return;
+            c = t(pos) + " = " + TString::Format("%.17g", value).Data() + ";";
+            nout = 1;
+            break;
+         }
+         case kDefinedVariable:
+            c = "if (!variable(formula, " + std::to_string(i) + ", " + std::to_string(param) + ", instance, willLoad, &" +
+                t(pos) + ")) return 0;";
+            nout = 1;
+            break;
+         case kpi: c = t(pos) + " = TMath::ACos(-1);"; nout = 1; break;
+
+         case kAdd:        c = x + " += " + y + ";"; nin = 2; break;
+         case kSubstract:  c = x + " -= " + y + ";"; nin = 2; break;
+         case kMultiply:   c = x + " *= " + y + ";"; nin = 2; break;
+         case kDivide:     c = x + " = (" + y + " == 0) ? 0 : " + x + " / " + y + ";"; nin = 2; break;
+         case kModulo:     c = x + " = (double)((long long)" + x + " % (long long)" + y + ");"; nin = 2; break;
+         case katan2:      c = x + " = TMath::ATan2(" + x + ", " + y + ");"; nin = 2; break;
+         case kfmod:       c = x + " = std::fmod(" + x + ", " + y + ");"; nin = 2; break;
+         case kpow:        c = x + " = TMath::Power(" + x + ", " + y + ");"; nin = 2; break;
+         case kmin:        c = x + " = std::min(" + x + ", " + y + ");"; nin = 2; break;
+         case kmax:        c = x + " = std::max(" + x + ", " + y + ");"; nin = 2; break;
+         case kAnd:        c = x + " = (" + x + " != 0 && " + y + " != 0) ? 1 : 0;"; nin = 2; break;
+         case kOr:         c = x + " = (" + x + " != 0 || " + y + " != 0) ? 1 : 0;"; nin = 2; break;
+         case kEqual:      c = x + " = (" + x + " == " + y + ") ? 1 : 0;"; nin = 2; break;
+         case kNotEqual:   c = x + " = (" + x + " != " + y + ") ? 1 : 0;"; nin = 2; break;
+         case kLess:       c = x + " = (" + x + " < " + y + ") ? 1 : 0;"; nin = 2; break;
+         case kGreater:    c = x + " = (" + x + " > " + y + ") ? 1 : 0;"; nin = 2; break;
+         case kLessThan:   c = x + " = (" + x + " <= " + y + ") ? 1 : 0;"; nin = 2; break;
+         case kGreaterThan: c = x + " = (" + x + " >= " + y + ") ? 1 : 0;"; nin = 2; break;
+         case kBitAnd:
+            c = x + " = (double)((unsigned long long)" + x + " & (unsigned long long)" + y + ");"; nin = 2; break;
+         case kBitOr:
+            c = x + " = (double)((unsigned long long)" + x + " | (unsigned long long)" + y + ");"; nin = 2; break;
+         case kLeftShift:
+            c = x + " = (double)((unsigned long long)" + x + " << (unsigned long long)" + y + ");"; nin = 2; break;
+         case kRightShift:
+            c = x + " = (double)((unsigned long long)" + x + " >> (unsigned long long)" + y + ");"; nin = 2; break;
+
+         case kcos:    c = y + " = TMath::Cos(" + y + ");"; nin = 1; break;
+         case ksin:    c = y + " = TMath::Sin(" + y + ");"; nin = 1; break;
+         case ktan:    c = y + " = (TMath::Cos(" + y + ") == 0) ? 0 : TMath::Tan(" + y + ");"; nin = 1; break;
+         case kacos:   c = y + " = (TMath::Abs(" + y + ") > 1) ? 0 : TMath::ACos(" + y + ");"; nin = 1; break;
+         case kasin:   c = y + " = (TMath::Abs(" + y + ") > 1) ? 0 : TMath::ASin(" + y + ");"; nin = 1; break;
+         case katan:   c = y + " = TMath::ATan(" + y + ");"; nin = 1; break;
+         case kcosh:   c = y + " = TMath::CosH(" + y + ");"; nin = 1; break;
+         case ksinh:   c = y + " = TMath::SinH(" + y + ");"; nin = 1; break;
+         case ktanh:   c = y + " = (TMath::CosH(" + y + ") == 0) ? 0 : TMath::TanH(" + y + ");"; nin = 1; break;
+         case kacosh:  c = y + " = (" + y + " < 1) ? 0 : TMath::ACosH(" + y + ");"; nin = 1; break;
+         case kasinh:  c = y + " = TMath::ASinH(" + y + ");"; nin = 1; break;
+         case katanh:  c = y + " = (TMath::Abs(" + y + ") > 1) ? 0 : TMath::ATanH(" + y + ");"; nin = 1; break;
+         case ksq:     c = y + " = " + y + " * " + y + ";"; nin = 1; break;
+         case ksqrt:   c = y + " = TMath::Sqrt(TMath::Abs(" + y + "));"; nin = 1; break;
+         case klog:    c = y + " = (" + y + " > 0) ? TMath::Log(" + y + ") : 0;"; nin = 1; break;
+         case klog10:  c = y + " = (" + y + " > 0) ? TMath::Log10(" + y + ") : 0;"; nin = 1; break;
+         case kexp:
+            c = y + " = (" + y + " < -700) ? 0 : TMath::Exp((" + y + " > 700) ? 700 : " + y + ");"; nin = 1; break;
+         case kabs:    c = y + " = TMath::Abs(" + y + ");"; nin = 1; break;
+         case ksign:   c = y + " = (" + y + " < 0) ? -1 : 1;"; nin = 1; break;
+         case kint:    c = y + " = (double)(long long)" + y + ";"; nin = 1; break;
+         case kSignInv: c = y + " = -1 * " + y + ";"; nin = 1; break;
+         case kNot:    c = y + " = (" + y + " != 0) ? 0 : 1;"; nin = 1; break;
+
+         case kEnd:
+            c = "return t0;";
+            next = kFALSE;
+            break;
+         case kJump:
+            c = "goto L" + std::to_string(param + 1) + ";";
+            if (!jumpTo(param + 1, pos))
+               return;
+            next = kFALSE;
+            break;
+         case kJumpIf:
+            if (pos < 1 || !jumpTo(param + 1, pos - 1))
+               return;
+            c = "if (!" + y + ") { if (willLoad) optimized(formula); goto L" + std::to_string(param + 1) + "; }";
+            nin = 1;
+            nout = -1;
+            break;
+         case kBoolOptimize: {
+            // Skip the right side of && (1) or || (2) if the left side decides
+            const Int_t op = param % 10;
+            const Int_t target = i + param / 10 + 1;
+            if (op != 1 && op != 2) {
+               c = ";";
+               break;
+            }
+            if (pos < 1 || !jumpTo(target, pos))
+               return;
+            c = std::string(op == 1 ? "if (!" : "if (") + y + ") { " + y + " = " + (op == 1 ? "0" : "1") +
+                "; if (willLoad) optimized(formula); goto L" + std::to_string(target) + "; }";
+            nin = 1;
+            nout = 1;
+            break;
+         }
+         default:
+            return;
+      }
+
+      // By default, the operators replace their operands by the result
+      if (nin > 0 && nout == 0)
+         nout = 1;
+      if (nout < 0)
+         nout = 0;
+      if (pos < nin)
+         return;
+      const Int_t after = pos - nin + nout;
+      if (after > maxDepth)
+         maxDepth = after;
+      if (next && !reach(i + 1, after))
+         return;
+   }
+   if (maxDepth == 0)
+      return;
+
+   std::string body = "{\n   double t0 = 0";
+   for (Int_t k = 1; k < maxDepth; ++k)
+      body += ", " + t(k) + " = 0";
+   body += ";\n";
+   for (Int_t i = 0; i <= fNoper; ++i) {
+      if (isTarget[i])
+         body += "L" + std::to_string(i) + ":\n";
+      body += "   " + (i < fNoper ? code[i] : std::string("return t0;")) + "\n";
+   }
+   body += "}\n";
+
+   static std::mutex mutex;
+   static std::unordered_map<std::string, void *> functions;
+   std::lock_guard<std::mutex> lock(mutex);
+   auto found = functions.find(body);
+   if (found != functions.end()) {
+      fJitFunction = found->second;
+      return;
+   }
+   const std::string name = "f" + std::to_string(functions.size());
+   const std::string declaration =
+      "#include \"TMath.h\"\n#include <algorithm>\n#include <cmath>\n#pragma cling optimize(2)\n"
+      "namespace ROOT { namespace Internal { namespace TTreeFormulaJit {\n"
+      "double " + name + "(void *formula, int instance, bool willLoad, "
+      "bool (*variable)(void *, int, int, int, bool, double *), void (*optimized)(void *))\n" +
+      body + "} } }\n";
+   void *function = nullptr;
+   if (gInterpreter->Declare(declaration.c_str())) {
+      TInterpreter::EErrorCode error = TInterpreter::kNoError;
+      const std::string address = "(long)&ROOT::Internal::TTreeFormulaJit::" + name;
+      function = (void *)gInterpreter->Calc(address.c_str(), &error);
+      if (error != TInterpreter::kNoError)
+         function = nullptr;
+   }
+   // The failures are cached as well, they are interpreted
+   functions[body] = function;
+   fJitFunction = function;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Evaluate a tree variable for the compiled functions, see JitCompile().
+
+Bool_t TTreeFormula::JitEvalVariable(void *formula, Int_t oper, Int_t code, Int_t instance, Bool_t willLoad,
+                                     Double_t *value)
+{
+   return static_cast<TTreeFormula *>(formula)->EvalDefinedVariable<Double_t>(oper, code, instance, willLoad, *value);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Record a boolean optimization for the compiled functions, see JitCompile().
+
+void TTreeFormula::JitBooleanOptimization(void *formula)
+{
+   static_cast<TTreeFormula *>(formula)->fDidBooleanOptimization = kTRUE;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return kTRUE if the new formulas are compiled, see SetCompiledMode().
+
+Bool_t TTreeFormula::IsCompiledMode()
+{
+   return gCompiledMode;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Compile the formulas created from now on (e.g. by TTree::Draw, TTree::Scan
+/// or TTree::CopyTree), instead of interpreting their operators at each
+/// evaluation.
+///
+/// The operators are translated in a C++ function, just-in-time compiled by
+/// cling, while the tree variables are still read by the formulas. The first
+/// compilation of an expression takes some time: this pays off for large
+/// trees, or for expressions with many operators. The functions are cached
+/// and the expressions that cannot be compiled (e.g. with strings or aliases)
+/// are interpreted, as before. IsCompiled() tells whether a formula is compiled.
+
+void TTreeFormula::SetCompiledMode(Bool_t on)
+{
+   gCompiledMode = on;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Return DataMember corresponding to code.
 ///
@@ -19,6 +19,15 @@ A Tree Index with majorname and minorname.
 #include "TTree.h"
 #include "TBuffer.h"
 #include "TMath.h"
+#include "TROOT.h"
+
+#ifdef R__USE_IMT
+#include "ROOT/TSeq.hxx"
+#include "ROOT/TThreadExecutor.hxx"
+#endif
+
+#include <algorithm>
+#include <vector>
 
 ClassImp(TTreeIndex);
 
@@ -42,6 +51,98 @@ struct IndexSortComparator {
   Long64_t *fValMajor, *fValMinor;
 };
 
+namespace ROOT {
+namespace Internal {
+
+/// Open addressing hash table mapping the (major, minor) pairs of a TTreeIndex
+/// to their position in the sorted index value tables.
+class TTreeIndexHash {
+   std::vector<Long64_t> fSlots; ///< Position + 1 in the index value tables, 0 for an empty slot
+   ULong64_t fMask{0};           ///< Number of slots - 1 (the number of slots is a power of 2)
+
+   static ULong64_t Hash(Long64_t major, Long64_t minor)
+   {
+      ULong64_t h = ((ULong64_t)major * 0x9E3779B97F4A7C15ULL) ^ (ULong64_t)minor;
+      h ^= h >> 33;
+      h *= 0xFF51AFD7ED558CCDULL;
+      h ^= h >> 33;
+      h *= 0xC4CEB9FE1A85EC53ULL;
+      h ^= h >> 33;
+      return h;
+   }
+
+public:
+   TTreeIndexHash(const Long64_t *major, const Long64_t *minor, Long64_t n)
+   {
+      ULong64_t size = 2;
+      while (size < 2 * (ULong64_t)n)
+         size <<= 1;
+      fSlots.assign(size, 0);
+      fMask = size - 1;
+      for (Long64_t pos = 0; pos < n; ++pos) {
+         // Only the first of a run of equal pairs is reachable, like with FindValues.
+         if (pos > 0 && major[pos] == major[pos - 1] && minor[pos] == minor[pos - 1])
+            continue;
+         ULong64_t slot = Hash(major[pos], minor[pos]) & fMask;
+         while (fSlots[slot])
+            slot = (slot + 1) & fMask;
+         fSlots[slot] = pos + 1;
+      }
+   }
+
+   /// Return the position of the pair in the index value tables, -1 if it is not there.
+   Long64_t Find(const Long64_t *major, const Long64_t *minor, Long64_t majorv, Long64_t minorv) const
+   {
+      ULong64_t slot = Hash(majorv, minorv) & fMask;
+      while (Long64_t pos = fSlots[slot]) {
+         --pos;
+         if (major[pos] == majorv && minor[pos] == minorv)
+            return pos;
+         slot = (slot + 1) & fMask;
+      }
+      return -1;
+   }
+};
+
+} // namespace Internal
+} // namespace ROOT
+
+////////////////////////////////////////////////////////////////////////////////
+/// Sort the n entry numbers in index according to cmp.
+/// With implicit multi-threading enabled, large indices are sorted in chunks
+/// in parallel, which are then merged.
+
+static void R__SortIndex(Long64_t *index, Long64_t n, const IndexSortComparator &cmp)
+{
+#ifdef R__USE_IMT
+   const Long64_t kMinChunkSize = 100000;
+   if (ROOT::IsImplicitMTEnabled() && n >= 2 * kMinChunkSize) {
+      const unsigned nchunks = std::min<Long64_t>(ROOT::GetThreadPoolSize(), n / kMinChunkSize);
+      if (nchunks > 1) {
+         std::vector<Long64_t> bounds(nchunks + 1);
+         for (unsigned i = 0; i <= nchunks; ++i)
+            bounds[i] = n * i / nchunks;
+         ROOT::TThreadExecutor pool;
+         pool.Foreach([&](unsigned i) { std::sort(index + bounds[i], index + bounds[i + 1], cmp); },
+                      ROOT::TSeq<unsigned>(nchunks));
+         for (unsigned width = 1; width < nchunks; width *= 2) {
+            std::vector<unsigned> starts;
+            for (unsigned i = 0; i + width < nchunks; i += 2 * width)
+               starts.push_back(i);
+            pool.Foreach(
+               [&](unsigned i) {
+                  const unsigned end = std::min(i + 2 * width, nchunks);
+                  std::inplace_merge(index + bounds[i], index + bounds[i + width], index + bounds[end], cmp);
+               },
+               starts);
+         }
+         return;
+      }
+   }
+#endif
+   std::sort(index, index + n, cmp);
+}
+
 
 ////////////////////////////////////////////////////////////////////////////////
 /// Default constructor for TTreeIndex
@@ -73,6 +174,8 @@ TTreeIndex::TTreeIndex(): TVirtualIndex()
 ///
 /// This array is sorted. The sorted fIndex[i] contains the serial number
 /// in the Tree corresponding to the pair "major,minor" in fIndexvalues[i].
+/// If implicit multi-threading is enabled (see ROOT::EnableImplicitMT), large
+/// indices are sorted in parallel.
 ///
 ///  Once the index is computed, one can retrieve one entry via
 /// ~~~{.cpp}
@@ -182,7 +285,7 @@ TTreeIndex::TTreeIndex(const TTree *T, const char *majorname, const char *minorn
    }
    fIndex = new Long64_t[fN];
    for(i = 0; i < fN; i++) { fIndex[i] = i; }
-   std::sort(fIndex, fIndex + fN, IndexSortComparator(tmp_major, tmp_minor) );
+   R__SortIndex(fIndex, fN, IndexSortComparator(tmp_major, tmp_minor));
    //TMath::Sort(fN,w,fIndex,0);
    fIndexValues = new Long64_t[fN];
    fIndexValuesMinor = new Long64_t[fN];
@@ -209,6 +312,7 @@ TTreeIndex::~TTreeIndex()
    delete fMinorFormula;        fMinorFormula  = 0;
    delete fMajorFormulaParent;  fMajorFormulaParent = 0;
    delete fMinorFormulaParent;  fMinorFormulaParent = 0;
+   ResetHash();
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -218,6 +322,7 @@ TTreeIndex::~TTreeIndex()
 
 void TTreeIndex::Append(const TVirtualIndex *add, Bool_t delaySort )
 {
+   ResetHash();
 
    if (add && add->GetN()) {
       // Create new buffer (if needed)
@@ -271,7 +376,7 @@ void TTreeIndex::Append(const TVirtualIndex *add, Bool_t delaySort )
       Long64_t *conv = new Long64_t[fN];
 
       for(Long64_t i = 0; i < fN; i++) { conv[i] = i; }
-      std::sort(conv, conv+fN, IndexSortComparator(addValues, addValues2) );
+      R__SortIndex(conv, fN, IndexSortComparator(addValues, addValues2));
       //Long64_t *w = fIndexValues;
       //TMath::Sort(fN,w,conv,0);
 
@@ -300,6 +405,7 @@ void TTreeIndex::Append(const TVirtualIndex *add, Bool_t delaySort )
 bool TTreeIndex::ConvertOldToNew()
 {
    if( !fIndexValuesMinor && fN ) {
+      ResetHash();
       fIndexValuesMinor = new Long64_t[fN];
       for(int i=0; i<fN; i++) {
          fIndexValuesMinor[i] = (fIndexValues[i] & 0x7fffffff);
@@ -411,7 +517,9 @@ Long64_t TTreeIndex::GetEntryNumberWithBestIndex(Long64_t major, Long64_t minor)
 /// To read the data corresponding to an entry number, use TTree::GetEntryWithIndex
 /// the BuildIndex function has created a table of Double_t* of sorted values
 /// corresponding to val = major<<31 + minor;
-/// The function performs binary search in this sorted table.
+/// With SetHashLookup the pairs are looked up in a hash table of this sorted table,
+/// built on the first call, so that the lookup takes constant time; otherwise the
+/// sorted table is bisected.
 /// If it finds a pair that maches val, it returns directly the
 /// index in the table, otherwise it returns -1.
 ///
@@ -421,12 +529,58 @@ Long64_t TTreeIndex::GetEntryNumberWithIndex(Long64_t major, Long64_t minor) con
 {
    if (fN == 0) return -1;
 
+   if (fHashLookup) {
+      Long64_t pos = GetHash()->Find(fIndexValues, fIndexValuesMinor, major, minor);
+      if (pos < 0)
+         return -1;
+      return fIndex[pos];
+   }
+
    Long64_t pos = FindValues(major, minor);
    if( pos < fN && fIndexValues[pos] == major && fIndexValuesMinor[pos] == minor )
       return fIndex[pos];
    return -1;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Return the hash table of the index values, building it if needed.
+/// Several threads may look up the same index at the same time: only one builds the table.
+
+const ROOT::Internal::TTreeIndexHash *TTreeIndex::GetHash() const
+{
+   ROOT::Internal::TTreeIndexHash *hash = fHash.load(std::memory_order_acquire);
+   if (hash)
+      return hash;
+   std::lock_guard<std::mutex> lock(fHashMutex);
+   hash = fHash.load(std::memory_order_relaxed);
+   if (!hash) {
+      hash = new ROOT::Internal::TTreeIndexHash(fIndexValues, fIndexValuesMinor, fN);
+      fHash.store(hash, std::memory_order_release);
+   }
+   return hash;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Delete the hash table of the index values, after the values changed.
+
+void TTreeIndex::ResetHash()
+{
+   delete fHash.exchange(nullptr);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Look up the pairs of GetEntryNumberWithIndex in a hash table (on = kTRUE)
+/// instead of bisecting the sorted index values.
+/// The table takes constant time per lookup, but 16 bytes per entry of memory;
+/// it is built on the first lookup and is not written to the file.
+
+void TTreeIndex::SetHashLookup(Bool_t on)
+{
+   fHashLookup = on;
+   if (!on)
+      ResetHash();
+}
+
 
 ////////////////////////////////////////////////////////////////////////////////
 
@@ -564,6 +718,7 @@ void TTreeIndex::Streamer(TBuffer &R__b)
    UInt_t R__s, R__c;
    if (R__b.IsReading()) {
       Version_t R__v = R__b.ReadVersion(&R__s, &R__c); if (R__v) { }
+      ResetHash();
       TVirtualIndex::Streamer(R__b);
       fMajorName.Streamer(R__b);
       fMinorName.Streamer(R__b);
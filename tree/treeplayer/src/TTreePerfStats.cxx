@@ -96,8 +96,13 @@ The Physical disk speed is DiskIO + DiskIO*ReadExtra/100.
 #include "TTimeStamp.h"
 #include "TDatime.h"
 #include "TMath.h"
+#include "TLeaf.h"
 
+#include <algorithm>
+#include <cmath>
 #include <iostream>
+#include <set>
+#include <string>
 
 ClassImp(TTreePerfStats);
 
@@ -452,6 +457,106 @@ TTreePerfStats::BasketList_t TTreePerfStats::GetDuplicateBasketCache() const
    return result;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Copy the monitored tree, in the current directory, with the cluster and
+/// basket sizes tuned for the reads recorded so far.
+///
+/// The recorded reads are those of the TTreeCache of the monitored tree, which
+/// must still be attached to it: a branch is read if the cache read any of its
+/// baskets. The clusters are sized so that the baskets of a cluster of the
+/// branches read fit in the cache (or in 30 MB without cache), and the copy has
+/// one basket per branch and cluster (TTree::kOnlyFlushAtCluster): reading a
+/// cluster of the copy takes one cache fill and one decompression per branch.
+/// If the recorded reads skipped baskets, the clusters are made smaller by the
+/// fraction of baskets read, to decompress less of the entries not read.
+/// Without recorded reads, all the branches are considered read.
+///
+/// As for TTree::CloneTree, the copy is not written: call Write() on it.
+/// If option contains "d", the choices made are printed.
+
+TTree *TTreePerfStats::CloneOptimized(Option_t *option)
+{
+   if (!fTree)
+      return nullptr;
+   TString opt(option);
+   opt.ToLower();
+   const Bool_t debug = opt.Contains("d");
+
+   // The branches read and the fraction of their baskets read
+   std::set<std::string> branchesRead;
+   Long64_t nBasketsRead = 0;
+   Long64_t nBaskets = 0;
+   TFile *file = fTree->GetCurrentFile();
+   TTreeCache *cache = file ? dynamic_cast<TTreeCache *>(file->GetCacheRead(fTree)) : nullptr;
+   if (cache) {
+      auto branches = cache->GetCachedBranches();
+      for (size_t i = 0; i < fBasketsInfo.size() && i < (size_t)branches->GetEntries(); ++i) {
+         auto branch = (TBranch *)branches->UncheckedAt(i);
+         Long64_t nRead = 0;
+         for (auto &info : fBasketsInfo[i])
+            nRead += (info.fUsed || info.fLoaded || info.fLoadedMiss || info.fMissed);
+         if (nRead == 0)
+            continue;
+         branchesRead.insert(branch->GetName());
+         nBasketsRead += nRead;
+         nBaskets += std::max(branch->GetWriteBasket(), (Int_t)nRead);
+      }
+   }
+   if (branchesRead.empty())
+      Warning("CloneOptimized", "No reads recorded by the TTreeCache of %s, considering all branches read.",
+              fTree->GetName());
+
+   // Cluster size
+   Double_t zipBytesPerEntry = 0;
+   const Long64_t nentries = fTree->GetEntries();
+   std::set<TBranch *> seen;
+   TObjArray *leaves = fTree->GetListOfLeaves();
+   for (Int_t i = 0; i < leaves->GetEntriesFast(); ++i) {
+      TBranch *branch = ((TLeaf *)leaves->UncheckedAt(i))->GetBranch();
+      if (!seen.insert(branch).second || branch->GetEntries() == 0)
+         continue;
+      if (branchesRead.empty() || branchesRead.count(branch->GetName()))
+         zipBytesPerEntry += Double_t(branch->GetZipBytes()) / branch->GetEntries();
+   }
+   const Double_t clusterBytes = 0.9 * (fTreeCacheSize > 0 ? fTreeCacheSize : 30000000);
+   Double_t clusterEntries = zipBytesPerEntry > 0 ? clusterBytes / zipBytesPerEntry : (Double_t)nentries;
+   if (nBaskets > 0 && nBasketsRead < nBaskets)
+      clusterEntries *= std::max(0.1, Double_t(nBasketsRead) / nBaskets);
+   const Long64_t autoFlush = std::max<Long64_t>(1, std::min<Long64_t>(nentries, (Long64_t)clusterEntries));
+   if (debug)
+      Info("CloneOptimized", "%zu branches read, %lld of %lld baskets, %g zipped bytes per entry: %lld entries per "
+           "cluster", branchesRead.size(), nBasketsRead, nBaskets, zipBytesPerEntry, autoFlush);
+
+   TTree *newtree = fTree->CloneTree(0);
+   if (!newtree)
+      return nullptr;
+   newtree->SetAutoFlush(autoFlush);
+   newtree->SetBit(TTree::kOnlyFlushAtCluster);
+
+   // Start with baskets holding a cluster, rather than growing them
+   seen.clear();
+   leaves = newtree->GetListOfLeaves();
+   for (Int_t i = 0; i < leaves->GetEntriesFast(); ++i) {
+      TBranch *branch = ((TLeaf *)leaves->UncheckedAt(i))->GetBranch();
+      if (!seen.insert(branch).second)
+         continue;
+      TBranch *source = fTree->GetBranch(branch->GetName());
+      if (!source || source->GetEntries() == 0 || branch->GetListOfBranches()->GetEntriesFast() > 0)
+         continue;
+      Double_t bsize = autoFlush * Double_t(source->GetTotBytes()) / source->GetEntries();
+      if (branch->GetEntryOffsetLen())
+         bsize += autoFlush * sizeof(Int_t) * 2;
+      const Int_t newBsize = (Int_t)std::min(bsize + 512 - std::fmod(bsize, 512.), 256. * 1024 * 1024);
+      if (debug)
+         Info("CloneOptimized", "Changing buffer size from %6d to %6d bytes for %s", branch->GetBasketSize(),
+              newBsize, branch->GetName());
+      branch->SetBasketSize(newBsize);
+   }
+
+   newtree->CopyEntries(fTree);
+   return newtree;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Draw the TTree I/O perf graph.
 
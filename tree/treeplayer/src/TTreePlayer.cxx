@@ -22,6 +22,8 @@ extra libraries (Histogram, display, etc).
 #include <cstdlib>
 #include <iostream>
 #include <fstream>
+#include <memory>
+#include <vector>
 
 #include "TROOT.h"
 #include "TApplication.h"
@@ -75,6 +77,7 @@ extra libraries (Histogram, display, etc).
 #include "TRefArrayProxy.h"
 #include "TVirtualMonitoring.h"
 #include "TTreeCache.h"
+#include "TTreeCloner.h"
 #include "TVirtualMutex.h"
 #include "ThreadLocalStorage.h"
 #include "strlcpy.h"
@@ -158,10 +161,18 @@ TVirtualIndex *TTreePlayer::BuildIndex(const TTree *T, const char *majorname, co
 /// selected entries.
 ///
 /// -  selection is a standard selection expression (see TTreePlayer::Draw)
-/// -  option is reserved for possible future use
+/// -  option can contain "fast", see below
 /// -  nentries is the number of entries to process (default is all)
 /// -  first is the first entry to process (default is 0)
 ///
+/// If option contains "fast" and the copy is attached to a file, the
+/// selection is evaluated one cluster of the input at a time: the clusters
+/// in which all the entries pass the selection are appended to the copy by
+/// copying their baskets without decompression (see TTreeCloner::ExecRange),
+/// only the entries of the other clusters are read and filled. This is much
+/// faster for the selections keeping contiguous ranges of entries. The "fast"
+/// option is ignored if an event or entry list is set on this tree.
+///
 /// IMPORTANT: The copied tree stays connected with this tree until this tree
 /// is deleted.  In particular, any changes in branch addresses
 /// in this tree are forwarded to the clone trees.  Any changes
@@ -183,9 +194,11 @@ TVirtualIndex *TTreePlayer::BuildIndex(const TTree *T, const char *majorname, co
 ///   T2->Write();
 /// ~~~
 
-TTree *TTreePlayer::CopyTree(const char *selection, Option_t *, Long64_t nentries,
+TTree *TTreePlayer::CopyTree(const char *selection, Option_t *option, Long64_t nentries,
                              Long64_t firstentry)
 {
+   TString opt = option;
+   opt.ToLower();
 
    // we make a copy of the tree header
    TTree *tree = fTree->CloneTree(0);
@@ -218,6 +231,13 @@ TTree *TTreePlayer::CopyTree(const char *selection, Option_t *, Long64_t nentrie
       fFormulaList->Add(select);
    }
 
+   if (opt.Contains("fast") && !fTree->GetEventList() && !fTree->GetEntryList() && tree->GetDirectory() &&
+       tree->GetDirectory()->GetFile()) {
+      CopyClusters(tree, select, firstentry, nentries);
+      fFormulaList->Clear();
+      return tree;
+   }
+
    //loop on the specified entries
    Int_t tnumber = -1;
    for (entry=firstentry;entry<firstentry+nentries;entry++) {
@@ -244,6 +264,62 @@ TTree *TTreePlayer::CopyTree(const char *selection, Option_t *, Long64_t nentrie
    return tree;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Copy the entries [firstentry, firstentry+nentries) passing the selection
+/// into 'tree', one cluster of the input at a time: the clusters entirely
+/// selected are copied basket by basket, see CopyTree.
+
+void TTreePlayer::CopyClusters(TTree *tree, TTreeFormula *select, Long64_t firstentry, Long64_t nentries)
+{
+   std::unique_ptr<TTreeCloner> cloner;
+   std::vector<Long64_t> selected;
+   Int_t tnumber = -1;
+   const Long64_t end = firstentry + nentries;
+   Long64_t entry = firstentry;
+   while (entry < end) {
+      Long64_t localEntry = fTree->LoadTree(entry);
+      if (localEntry < 0) break;
+      if (tnumber != fTree->GetTreeNumber()) {
+         tnumber = fTree->GetTreeNumber();
+         if (select) select->UpdateFormulaLeaves();
+         cloner.reset(new TTreeCloner(fTree->GetTree(), tree, "",
+                                      TTreeCloner::kNoWarnings | TTreeCloner::kNoFileCache));
+      }
+      // Entry number of the chain for the first entry of the current tree.
+      const Long64_t offset = entry - localEntry;
+      auto clusterIter = fTree->GetTree()->GetClusterIterator(localEntry);
+      const Long64_t clusterStart = clusterIter();
+      const Long64_t clusterEnd = clusterIter.GetNextEntry();
+      const Long64_t last = TMath::Min(clusterEnd, end - offset);
+
+      selected.clear();
+      Long64_t local = localEntry;
+      for (; local < last; ++local) {
+         if (fTree->LoadTree(local + offset) < 0) break;
+         if (select) {
+            Int_t ndata = select->GetNdata();
+            Bool_t keep = kFALSE;
+            for(Int_t current = 0; current<ndata && !keep; current++) {
+               keep |= (select->EvalInstance(current) != 0);
+            }
+            if (!keep) continue;
+         }
+         selected.push_back(local);
+      }
+
+      const Bool_t wholeCluster = localEntry == clusterStart && local == clusterEnd &&
+                                  (Long64_t)selected.size() == clusterEnd - clusterStart;
+      if (!wholeCluster || !cloner->ExecRange(clusterStart, clusterEnd)) {
+         for (auto e : selected) {
+            fTree->GetEntry(e + offset);
+            tree->Fill();
+         }
+      }
+      if (local < last) break;
+      entry = last + offset;
+   }
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Delete any selector created by this object.
 /// The selector has been created using TSelector::GetSelector(file)
@@ -2244,7 +2320,9 @@ Long64_t TTreePlayer::Process(TSelector *selector,Option_t *option, Long64_t nen
 
    Bool_t process = (selector->GetAbort() != TSelector::kAbortProcess &&
                     (selector->Version() != 0 || selector->GetStatus() != -1)) ? kTRUE : kFALSE;
-   if (process) {
+   // TTree::Draw may fill its histogram in parallel
+   Bool_t processedMT = process && selector == fSelector && fSelector->ProcessMT(nentries, firstentry);
+   if (process && !processedMT) {
 
       Long64_t readbytesatstart = 0;
       readbytesatstart = TFile::GetFileBytesRead();
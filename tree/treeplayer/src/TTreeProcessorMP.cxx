@@ -118,11 +118,11 @@ TList *TTreeProcessorMP::Process(TTree &tree, TSelector &selector, TEntryList &e
       return nullptr;
    }
 
-   //divide entries equally between workers
-   fTaskType = ETask::kProcByRange;
+   //divide entries in cluster ranges, which are requested by the workers when idle
+   fTaskType = ETask::kProcByTree;
 
    //tell workers to start processing entries
-   fNToProcess = nWorkers; //this is the total number of ranges that will be processed by all workers cumulatively
+   fNToProcess = TMPWorkerTree::GetNRanges(nWorkers, 1); //this is the total number of ranges that will be processed by all workers cumulatively
    std::vector<UInt_t> args(nWorkers);
    std::iota(args.begin(), args.end(), 0);
    fNProcessed = Broadcast(MPCode::kProcTree, args);
@@ -188,7 +188,7 @@ TList *TTreeProcessorMP::Process(const std::vector<std::string> &fileNames, TSel
          // TTree entry granularity: for each file, we divide entries equally between workers
          fTaskType = ETask::kProcByRange;
          // Tell workers to start processing entries
-         fNToProcess = nWorkers*fileNames.size(); //this is the total number of ranges that will be processed by all workers cumulatively
+         fNToProcess = TMPWorkerTree::GetNRanges(nWorkers, fileNames.size()) * fileNames.size(); //this is the total number of ranges that will be processed by all workers cumulatively
          std::vector<UInt_t> args(nWorkers);
          std::iota(args.begin(), args.end(), 0);
          fNProcessed = Broadcast(MPCode::kProcRange, args);
@@ -207,10 +207,10 @@ TList *TTreeProcessorMP::Process(const std::vector<std::string> &fileNames, TSel
                                          " Some entries might not be processed.");
       }
    } else {
-      // TTree entry granularity: for each file, we divide entries equally between workers
+      // Cluster granularity: each file is divided in ranges of clusters, which are requested by the workers when idle
       fTaskType = ETask::kProcByRange;
       // Tell workers to start processing entries
-      fNToProcess = nWorkers*fileNames.size(); //this is the total number of ranges that will be processed by all workers cumulatively
+      fNToProcess = TMPWorkerTree::GetNRanges(nWorkers, fileNames.size()) * fileNames.size(); //this is the total number of ranges that will be processed by all workers cumulatively
       std::vector<UInt_t> args(nWorkers);
       std::iota(args.begin(), args.end(), 0);
       fNProcessed = Broadcast(MPCode::kProcRange, args);
@@ -353,6 +353,8 @@ void TTreeProcessorMP::ReplyToIdle(TSocket *s)
       //we are executing a "greedy worker" task
       if (fTaskType == ETask::kProcByRange)
          MPSend(s, MPCode::kProcRange, fNProcessed);
+      else if (fTaskType == ETask::kProcByTree)
+         MPSend(s, MPCode::kProcTree, fNProcessed);
       else if (fTaskType == ETask::kProcByFile)
          MPSend(s, MPCode::kProcFile, fNProcessed);
       ++fNProcessed;
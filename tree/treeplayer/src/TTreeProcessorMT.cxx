@@ -26,6 +26,10 @@ objects.
 
 #include "TROOT.h"
 #include "ROOT/TTreeProcessorMT.hxx"
+#include "ROOT/RTrace.hxx"
+
+#include <algorithm> // std::max, std::binary_search
+#include <numeric>   // std::accumulate, std::iota
 
 using namespace ROOT;
 
@@ -128,8 +132,10 @@ using ClustersAndEntries = std::pair<std::vector<std::vector<EntryCluster>>, std
 
 ////////////////////////////////////////////////////////////////////////
 /// Return a vector of cluster boundaries for the given tree and files.
+/// The files after the one containing entry maxEntries - 1 of the chain are not opened, nor returned.
 static ClustersAndEntries MakeClusters(const std::vector<std::string> &treeNames,
-                                       const std::vector<std::string> &fileNames, const unsigned int maxTasksPerFile)
+                                       const std::vector<std::string> &fileNames,
+                                       Long64_t maxEntries = std::numeric_limits<Long64_t>::max())
 {
    // Note that as a side-effect of opening all files that are going to be used in the
    // analysis once, all necessary streamers will be loaded into memory.
@@ -139,7 +145,7 @@ static ClustersAndEntries MakeClusters(const std::vector<std::string> &treeNames
    std::vector<Long64_t> entriesPerFile;
    entriesPerFile.reserve(nFileNames);
    Long64_t offset = 0ll;
-   for (auto i = 0u; i < nFileNames; ++i) {
+   for (auto i = 0u; i < nFileNames && offset < maxEntries; ++i) {
       const auto &fileName = fileNames[i];
       const auto &treeName = treeNames[i];
 
@@ -171,6 +177,33 @@ static ClustersAndEntries MakeClusters(const std::vector<std::string> &treeNames
       entriesPerFile.emplace_back(entries);
    }
 
+   return std::make_pair(std::move(clustersPerFile), std::move(entriesPerFile));
+}
+
+////////////////////////////////////////////////////////////////////////
+/// Restrict the clusters of each file to the entries in [begin, end), dropping the clusters left empty.
+static std::vector<std::vector<EntryCluster>>
+ClipClusters(std::vector<std::vector<EntryCluster>> &&clustersPerFile, Long64_t begin, Long64_t end)
+{
+   for (auto &clusters : clustersPerFile) {
+      std::vector<EntryCluster> clipped;
+      for (const auto &c : clusters) {
+         const auto start = std::max(c.start, begin);
+         const auto stop = std::min(c.end, end);
+         if (start < stop)
+            clipped.emplace_back(EntryCluster{start, stop});
+      }
+      clusters = std::move(clipped);
+   }
+   return std::move(clustersPerFile);
+}
+
+////////////////////////////////////////////////////////////////////////
+/// Fuse contiguous clusters of each file so that about maxTasks tasks are generated overall.
+static std::vector<std::vector<EntryCluster>>
+FuseClusters(std::vector<std::vector<EntryCluster>> &&clustersPerFile, const std::vector<Long64_t> &entriesPerFile,
+             const unsigned int maxTasks)
+{
    // Here we "fuse" clusters together if the number of clusters is too big with respect to
    // the number of slots, otherwise we can incur in an overhead which is big enough
    // to make parallelisation detrimental to performance.
@@ -183,25 +216,29 @@ static ClustersAndEntries MakeClusters(const std::vector<std::string> &treeNames
    // Cluster-merging can help reduce the number of tasks down to a minumum of one task per file.
    //
    // The criterion according to which we fuse clusters together is to have around
-   // TTreeProcessorMT::GetTasksPerWorkerHint() clusters per slot.
-   // Concretely, for each file we will cap the number of tasks to ceil(GetTasksPerWorkerHint() * nWorkers / nFiles).
+   // TTreeProcessorMT::GetTasksPerWorkerHint() clusters per slot over the whole dataset.
+   // The tasks are shared among the files proportionally to their number of entries, so that a large file is not
+   // processed in few large tasks just because it comes together with many small ones.
+   // Concretely, file i is processed in at most ceil(maxTasks * entries_i / totalEntries) tasks, and at least one.
+   const Long64_t totalEntries = std::accumulate(entriesPerFile.begin(), entriesPerFile.end(), 0ll);
 
    std::vector<std::vector<EntryCluster>> eventRangesPerFile(clustersPerFile.size());
-   auto clustersPerFileIt = clustersPerFile.begin();
-   auto eventRangesPerFileIt = eventRangesPerFile.begin();
-   for (; clustersPerFileIt != clustersPerFile.end(); clustersPerFileIt++, eventRangesPerFileIt++) {
-      const auto clustersInThisFileSize = clustersPerFileIt->size();
+   for (auto fileIdx = 0u; fileIdx < clustersPerFile.size(); ++fileIdx) {
+      const Long64_t maxTasksInThisFile =
+         totalEntries > 0 ? (maxTasks * entriesPerFile[fileIdx] + totalEntries - 1) / totalEntries : 1ll;
+      const auto maxTasksPerFile = static_cast<std::size_t>(std::max(maxTasksInThisFile, 1ll));
+      const auto clustersInThisFileSize = clustersPerFile[fileIdx].size();
       const auto nFolds = clustersInThisFileSize / maxTasksPerFile;
       // If the number of clusters is less than maxTasksPerFile
       // we take the clusters as they are
       if (nFolds == 0) {
-         *eventRangesPerFileIt = std::move(*clustersPerFileIt);
+         eventRangesPerFile[fileIdx] = std::move(clustersPerFile[fileIdx]);
          continue;
       }
       // Otherwise, we have to merge clusters, distributing the reminder evenly
       // onto the first clusters
       auto nReminderClusters = clustersInThisFileSize % maxTasksPerFile;
-      const auto &clustersInThisFile = *clustersPerFileIt;
+      const auto &clustersInThisFile = clustersPerFile[fileIdx];
       for (auto i = 0ULL; i < clustersInThisFileSize; ++i) {
          const auto start = clustersInThisFile[i].start;
          // We lump together at least nFolds clusters, therefore
@@ -213,16 +250,31 @@ static ClustersAndEntries MakeClusters(const std::vector<std::string> &treeNames
             nReminderClusters--;
          }
          const auto end = clustersInThisFile[i].end;
-         eventRangesPerFileIt->emplace_back(EntryCluster({start, end}));
+         eventRangesPerFile[fileIdx].emplace_back(EntryCluster({start, end}));
       }
    }
 
-   return std::make_pair(std::move(eventRangesPerFile), std::move(entriesPerFile));
+   return eventRangesPerFile;
+}
+
+////////////////////////////////////////////////////////////////////////
+/// Append to boundaries the entry numbers, shifted by offset, at which the clusters of the tree start.
+static void AppendClusterStarts(TTree &t, Long64_t offset, std::vector<Long64_t> &boundaries)
+{
+   auto clusterIter = t.GetClusterIterator(0);
+   const Long64_t entries = t.GetEntries();
+   Long64_t start = 0ll;
+   while ((start = clusterIter()) < entries)
+      boundaries.emplace_back(start + offset);
 }
 
 ////////////////////////////////////////////////////////////////////////
-/// Return a vector containing the number of entries of each file of each friend TChain
-static std::vector<std::vector<Long64_t>> GetFriendEntries(const Internal::TreeUtils::RFriendInfo &friendInfo)
+/// Return a vector containing the number of entries of each file of each friend TChain.
+/// If friendClusterBoundaries is not null, it is filled with the (chain) global entry numbers at which the clusters
+/// of each friend start, followed by its total number of entries.
+static std::vector<std::vector<Long64_t>>
+GetFriendEntries(const Internal::TreeUtils::RFriendInfo &friendInfo,
+                 std::vector<std::vector<Long64_t>> *friendClusterBoundaries = nullptr)
 {
 
    const auto &friendNames = friendInfo.fFriendNames;
@@ -233,6 +285,8 @@ static std::vector<std::vector<Long64_t>> GetFriendEntries(const Internal::TreeU
    const auto nFriends = friendNames.size();
    for (auto i = 0u; i < nFriends; ++i) {
       std::vector<Long64_t> nEntries;
+      std::vector<Long64_t> boundaries;
+      Long64_t offset = 0ll;
       const auto &thisFriendName = friendNames[i].first;
       const auto &thisFriendFiles = friendFileNames[i];
       const auto &thisFriendChainSubNames = friendChainSubNames[i];
@@ -248,7 +302,10 @@ static std::vector<std::vector<Long64_t>> GetFriendEntries(const Internal::TreeU
             // thisFriendChainSubNames[fileidx] stores the name of the current
             // subtree in the TChain stored in the current file.
             curfile->GetObject(thisFriendChainSubNames[fileidx].c_str(), curtree);
+            if (friendClusterBoundaries)
+               AppendClusterStarts(*curtree, offset, boundaries);
             nEntries.emplace_back(curtree->GetEntries());
+            offset += nEntries.back();
          }
          // Otherwise, if there are no sub names for the current friend, it means
          // it's a TTree. We can safely use `thisFriendName` as the name of the tree
@@ -258,16 +315,57 @@ static std::vector<std::vector<Long64_t>> GetFriendEntries(const Internal::TreeU
             std::unique_ptr<TFile> f(TFile::Open(fname.c_str()));
             TTree *t = nullptr; // owned by TFile
             f->GetObject(thisFriendName.c_str(), t);
+            if (friendClusterBoundaries)
+               AppendClusterStarts(*t, offset, boundaries);
             nEntries.emplace_back(t->GetEntries());
+            offset += nEntries.back();
          }
       }
       // Store the vector with entries for each file in the current tree/chain.
       friendEntries.emplace_back(std::move(nEntries));
+      if (friendClusterBoundaries) {
+         boundaries.emplace_back(offset);
+         friendClusterBoundaries->emplace_back(std::move(boundaries));
+      }
    }
 
    return friendEntries;
 }
 
+////////////////////////////////////////////////////////////////////////
+/// Merge the consecutive clusters of each file that are not separated by a cluster boundary of all the friends, so
+/// that the tasks read whole clusters of the friends too instead of scattered parts of them. The clusters are kept as
+/// they are if that leaves fewer than minClusters of them.
+static std::vector<std::vector<EntryCluster>>
+AlignClustersWithFriends(std::vector<std::vector<EntryCluster>> &&clustersPerFile,
+                         const std::vector<std::vector<Long64_t>> &friendClusterBoundaries, std::size_t minClusters)
+{
+   auto isFriendBoundary = [&friendClusterBoundaries](Long64_t entry) {
+      for (const auto &boundaries : friendClusterBoundaries) {
+         if (!std::binary_search(boundaries.begin(), boundaries.end(), entry))
+            return false;
+      }
+      return true;
+   };
+
+   std::vector<std::vector<EntryCluster>> alignedClustersPerFile(clustersPerFile.size());
+   std::size_t nAlignedClusters = 0u;
+   for (auto fileIdx = 0u; fileIdx < clustersPerFile.size(); ++fileIdx) {
+      auto &alignedClusters = alignedClustersPerFile[fileIdx];
+      for (const auto &cluster : clustersPerFile[fileIdx]) {
+         if (alignedClusters.empty() || isFriendBoundary(cluster.start))
+            alignedClusters.emplace_back(cluster);
+         else
+            alignedClusters.back().end = cluster.end;
+      }
+      nAlignedClusters += alignedClusters.size();
+   }
+
+   if (nAlignedClusters < minClusters)
+      return std::move(clustersPerFile);
+   return alignedClustersPerFile;
+}
+
 } // anonymous namespace
 
 namespace ROOT {
@@ -463,6 +561,21 @@ TTreeProcessorMT::TTreeProcessorMT(TTree &tree, const TEntryList &entries, UInt_
 ///                     the same as for TThreadExecutor.
 TTreeProcessorMT::TTreeProcessorMT(TTree &tree, UInt_t nThreads) : TTreeProcessorMT(tree, TEntryList(), nThreads) {}
 
+//////////////////////////////////////////////////////////////////////////////
+/// Only process the entries with global entry number, i.e. entry number in the chain, in [begin, end): the subranges
+/// are the clusters of the trees clipped to the range. If an entry list was provided, the range refers to the
+/// positions in the entry list instead.
+/// The files after the end of the range are not opened; those before its beginning only to get their number of
+/// entries. The TTreeReaders passed to the function of Process then use global entry numbers.
+void TTreeProcessorMT::SetEntryRange(Long64_t begin, Long64_t end)
+{
+   if (begin < 0 || end < begin)
+      throw std::logic_error("TTreeProcessorMT::SetEntryRange: invalid entry range [" + std::to_string(begin) + ", " +
+                             std::to_string(end) + ")");
+   fEntryRange = {begin, end};
+   fHasEntryRange = true;
+}
+
 //////////////////////////////////////////////////////////////////////////////
 /// Process the entries of a TTree in parallel. The user-provided function
 /// receives a TTreeReader which can be used to iterate on a subrange of
@@ -482,63 +595,121 @@ TTreeProcessorMT::TTreeProcessorMT(TTree &tree, UInt_t nThreads) : TTreeProcesso
 /// \param[in] func User-defined function that processes a subrange of entries
 void TTreeProcessorMT::Process(std::function<void(TTreeReader &)> func)
 {
-   // compute number of tasks per file
-   const unsigned int maxTasksPerFile =
-      std::ceil(float(GetTasksPerWorkerHint() * fPool.GetPoolSize()) / float(fFileNames.size()));
+   // The files and trees to process: with an entry range, the files after its end are skipped
+   std::vector<std::string> fileNames(fFileNames), treeNames(fTreeNames);
+
+   // compute the total number of tasks
+   const unsigned int maxTasks = GetTasksPerWorkerHint() * fPool.GetPoolSize();
 
    // If an entry list or friend trees are present, we need to generate clusters with global entry numbers,
    // so we do it here for all files.
-   // Otherwise we can do it later, concurrently for each file, and clusters will contain local entry numbers.
+   // Otherwise we do it concurrently for each file, and clusters will contain local entry numbers.
    // TODO: in practice we could also find clusters per-file in the case of no friends and a TEntryList with
    // sub-entrylists.
    const bool hasFriends = !fFriendInfo.fFriendNames.empty();
    const bool hasEntryList = fEntryList.GetN() > 0;
-   const bool shouldRetrieveAllClusters = hasFriends || hasEntryList;
+   // An entry range is expressed in global entry numbers too
+   const bool shouldRetrieveAllClusters = hasFriends || hasEntryList || fHasEntryRange;
    ClustersAndEntries clusterAndEntries{};
+   // Number of entries for each file for each friend tree
+   std::vector<std::vector<Long64_t>> friendEntries;
    if (shouldRetrieveAllClusters) {
-      clusterAndEntries = MakeClusters(fTreeNames, fFileNames, maxTasksPerFile);
-      if (hasEntryList)
+      // The range refers to the positions in the entry list, if any, rather than to the entries of the files
+      const auto maxEntries =
+         fHasEntryRange && !hasEntryList ? fEntryRange.second : std::numeric_limits<Long64_t>::max();
+      clusterAndEntries = MakeClusters(fTreeNames, fFileNames, maxEntries);
+      fileNames.resize(clusterAndEntries.second.size());
+      treeNames.resize(clusterAndEntries.second.size());
+      // With an entry list, the clusters are clipped once converted to positions in the entry list
+      auto entriesToFuse = clusterAndEntries.second;
+      if (fHasEntryRange && !hasEntryList) {
+         clusterAndEntries.first =
+            ClipClusters(std::move(clusterAndEntries.first), fEntryRange.first, fEntryRange.second);
+         // The tasks are shared among the entries to process only
+         for (auto fileIdx = 0u; fileIdx < entriesToFuse.size(); ++fileIdx) {
+            entriesToFuse[fileIdx] = 0ll;
+            for (const auto &c : clusterAndEntries.first[fileIdx])
+               entriesToFuse[fileIdx] += c.end - c.start;
+         }
+      }
+      if (hasFriends) {
+         // Cut the tasks at cluster boundaries shared with the friends, as long as there are tasks for all workers
+         std::vector<std::vector<Long64_t>> friendClusterBoundaries;
+         friendEntries = GetFriendEntries(fFriendInfo, &friendClusterBoundaries);
+         clusterAndEntries.first = AlignClustersWithFriends(std::move(clusterAndEntries.first),
+                                                            friendClusterBoundaries, fPool.GetPoolSize());
+      }
+      clusterAndEntries.first = FuseClusters(std::move(clusterAndEntries.first), entriesToFuse, maxTasks);
+      if (hasEntryList) {
          clusterAndEntries.first = ConvertToElistClusters(std::move(clusterAndEntries.first), fEntryList, fTreeNames,
                                                           fFileNames, clusterAndEntries.second);
+         if (fHasEntryRange)
+            clusterAndEntries.first =
+               ClipClusters(std::move(clusterAndEntries.first), fEntryRange.first, fEntryRange.second);
+      }
+   } else {
+      const auto nFiles = fFileNames.size();
+      std::vector<std::size_t> fileIdxs(nFiles);
+      std::iota(fileIdxs.begin(), fileIdxs.end(), 0u);
+      auto getFileClusters = [&](std::size_t fileIdx) {
+         return MakeClusters({fTreeNames[fileIdx]}, {fFileNames[fileIdx]});
+      };
+      const auto clustersAndEntriesPerFile = fPool.Map(getFileClusters, fileIdxs);
+      auto &clustersPerFile = clusterAndEntries.first;
+      auto &entriesPerFile = clusterAndEntries.second;
+      for (const auto &c : clustersAndEntriesPerFile) {
+         clustersPerFile.emplace_back(c.first[0]);
+         entriesPerFile.emplace_back(c.second[0]);
+      }
+      // the number of tasks of each file depends on the entries of all other files
+      clustersPerFile = FuseClusters(std::move(clustersPerFile), entriesPerFile, maxTasks);
    }
 
    const auto &clusters = clusterAndEntries.first;
    const auto &entries = clusterAndEntries.second;
+   const auto nFiles = fileNames.size();
 
-   // Retrieve number of entries for each file for each friend tree
-   const auto friendEntries = hasFriends ? GetFriendEntries(fFriendInfo) : std::vector<std::vector<Long64_t>>{};
+   // The tasks of all files are scheduled together, so that threads that are done with the tasks of a file steal
+   // tasks of other files instead of idling while the last tasks of the file are processed.
+   // Tasks of the same file are kept next to each other, so that threads tend to process the tasks of the same file
+   // in a row and can reuse their TChain (see TTreeView::GetTreeReader).
+   struct RTask {
+      std::size_t fFileIdx;
+      EntryCluster fCluster;
+   };
+   std::vector<RTask> tasks;
+   for (auto fileIdx = 0u; fileIdx < nFiles; ++fileIdx) {
+      for (const auto &c : clusters[fileIdx])
+         tasks.push_back({fileIdx, c});
+   }
 
-   // Parent task, spawns tasks that process each of the entry clusters for each input file
-   // TODO: for readability we should have two versions of this lambda, for shouldRetrieveAllClusters == true/false
-   auto processFile = [&](std::size_t fileIdx) {
+   // When clusters have local entry numbers, each task only needs the file and tree names and number of entries of
+   // its own file
+   std::vector<std::vector<std::string>> fileNamesPerFile, treeNamesPerFile;
+   std::vector<std::vector<Long64_t>> entriesPerFile;
+   if (!shouldRetrieveAllClusters) {
+      for (auto fileIdx = 0u; fileIdx < nFiles; ++fileIdx) {
+         fileNamesPerFile.push_back({fFileNames[fileIdx]});
+         treeNamesPerFile.push_back({fTreeNames[fileIdx]});
+         entriesPerFile.push_back({entries[fileIdx]});
+      }
+   }
+
+   auto processTask = [&](const RTask &task) {
+      R__TRACE_SPAN("imt", "TTreeProcessorMT task", task.fCluster.start);
       // theseFiles contains either all files or just the single file to process
-      const auto &theseFiles = shouldRetrieveAllClusters ? fFileNames : std::vector<std::string>({fFileNames[fileIdx]});
+      const auto &theseFiles = shouldRetrieveAllClusters ? fileNames : fileNamesPerFile[task.fFileIdx];
       // either all tree names or just the single tree to process
-      const auto &theseTrees = shouldRetrieveAllClusters ? fTreeNames : std::vector<std::string>({fTreeNames[fileIdx]});
-      // Evaluate clusters (with local entry numbers) and number of entries for this file, if needed
-      const auto theseClustersAndEntries =
-         shouldRetrieveAllClusters ? ClustersAndEntries{} : MakeClusters(theseTrees, theseFiles, maxTasksPerFile);
-
-      // All clusters for the file to process, either with global or local entry numbers
-      const auto &thisFileClusters = shouldRetrieveAllClusters ? clusters[fileIdx] : theseClustersAndEntries.first[0];
-
+      const auto &theseTrees = shouldRetrieveAllClusters ? treeNames : treeNamesPerFile[task.fFileIdx];
       // Either all number of entries or just the ones for this file
-      const auto &theseEntries =
-         shouldRetrieveAllClusters ? entries : std::vector<Long64_t>({theseClustersAndEntries.second[0]});
+      const auto &theseEntries = shouldRetrieveAllClusters ? entries : entriesPerFile[task.fFileIdx];
 
-      auto processCluster = [&](const EntryCluster &c) {
-         auto r = fTreeView->GetTreeReader(c.start, c.end, theseTrees, theseFiles, fFriendInfo, fEntryList,
-                                           theseEntries, friendEntries);
-         func(*r);
-      };
-
-      fPool.Foreach(processCluster, thisFileClusters);
+      auto r = fTreeView->GetTreeReader(task.fCluster.start, task.fCluster.end, theseTrees, theseFiles, fFriendInfo,
+                                        fEntryList, theseEntries, friendEntries);
+      func(*r);
    };
 
-   std::vector<std::size_t> fileIdxs(fFileNames.size());
-   std::iota(fileIdxs.begin(), fileIdxs.end(), 0u);
-
-   fPool.Foreach(processFile, fileIdxs);
+   fPool.Foreach(processTask, tasks);
 }
 
 ////////////////////////////////////////////////////////////////////////
@@ -14,6 +14,7 @@
 #include "TChain.h"
 #include "TDirectory.h"
 #include "TEntryList.h"
+#include "TFriendElement.h"
 #include "TTreeCache.h"
 #include "TTreeReaderValue.h"
 #include "TFriendProxy.h"
@@ -368,6 +369,7 @@ Bool_t TTreeReader::SetProxies() {
    //    upon creation of the TTreeReader{Value, Array}s
    // 3. We stop the learning phase.
    // Operations 1, 2 and 3 need to happen in this order. See: https://sft.its.cern.ch/jira/browse/ROOT-9773?focusedCommentId=87837
+   // The friends matched by entry number (without tree index) read the same range: their caches get it too.
    if (fProxiesSet) {
       const auto curFile = fTree->GetCurrentFile();
       if (curFile && fTree->GetTree()->GetReadCache(curFile, true)) {
@@ -375,6 +377,16 @@ Bool_t TTreeReader::SetProxies() {
             // We need to avoid to pass -1 as end entry to the SetCacheEntryRange method
             const auto lastEntry = (-1LL == fEndEntry) ? fTree->GetEntriesFast() : fEndEntry;
             fTree->SetCacheEntryRange(fBeginEntry, lastEntry);
+            if (fTree->GetListOfFriends()) {
+               for (auto fe : TRangeDynCast<TFriendElement>(fTree->GetListOfFriends())) {
+                  TTree *friendTree = fe ? fe->GetTree() : nullptr;
+                  if (!friendTree || friendTree->GetTreeIndex() || !friendTree->GetTree())
+                     continue;
+                  const auto friendFile = friendTree->GetCurrentFile();
+                  if (friendFile && friendTree->GetTree()->GetReadCache(friendFile, true))
+                     friendTree->SetCacheEntryRange(fBeginEntry, lastEntry);
+               }
+            }
          }
          for (auto value: fValues) {
             fTree->AddBranchToCache(value->GetProxy()->GetBranchName(), true);
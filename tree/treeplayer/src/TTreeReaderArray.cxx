@@ -100,6 +100,11 @@ namespace {
             return myCollectionProxy->At(idx);
          }
       }
+
+      virtual bool IsContiguous(ROOT::Detail::TBranchProxy* proxy) {
+         TVirtualCollectionProxy *myCollectionProxy = GetCP(proxy);
+         return myCollectionProxy && (myCollectionProxy->GetProperties() & TVirtualCollectionProxy::kIsContiguous);
+      }
    };
 
    class TCollectionLessSTLReader final: public TVirtualCollectionReader {
@@ -146,6 +151,11 @@ namespace {
             return myCollectionProxy->At(idx);
          }
       }
+
+      virtual bool IsContiguous(ROOT::Detail::TBranchProxy* proxy) {
+         TVirtualCollectionProxy *myCollectionProxy = GetCP(proxy);
+         return myCollectionProxy && (myCollectionProxy->GetProperties() & TVirtualCollectionProxy::kIsContiguous);
+      }
    };
 
 
@@ -191,6 +201,8 @@ namespace {
          return (void*)((Byte_t*)array + (objectSize * idx));
       }
 
+      virtual bool IsContiguous(ROOT::Detail::TBranchProxy* /*proxy*/) { return true; }
+
       void SetBasicTypeSize(Int_t size){
          fBasicTypeSize = size;
       }
@@ -346,6 +358,8 @@ namespace {
          return (Byte_t*)address + (fElementSize * idx);
       }
 
+      virtual bool IsContiguous(ROOT::Detail::TBranchProxy* /*proxy*/) { return true; }
+
    protected:
       void ProxyRead(){
          fValueReader->ProxyRead();
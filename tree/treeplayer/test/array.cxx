@@ -29,6 +29,42 @@ TEST(TTreeReaderArray, Vector)
    EXPECT_FLOAT_EQ(17.f, vec[0]);
 }
 
+TEST(TTreeReaderArray, Span)
+{
+   TTree tree("TTreeReaderArraySpanTree", "In-memory test tree");
+   std::vector<float> vecf{17.f, 18.f, 19.f};
+   std::vector<bool> vecb{true, false, true};
+   double arr[3] = {1., 2., 3.};
+   tree.Branch("vec", &vecf);
+   tree.Branch("vecb", &vecb);
+   tree.Branch("arr", arr, "arr[3]/D");
+   tree.Fill();
+   vecf.push_back(22.f);
+   tree.Fill();
+   tree.ResetBranchAddresses();
+
+   TTreeReader tr(&tree);
+   TTreeReaderArray<float> vec(tr, "vec");
+   TTreeReaderArray<bool> vb(tr, "vecb");
+   TTreeReaderArray<double> ra(tr, "arr");
+
+   tr.SetEntry(1);
+
+   EXPECT_TRUE(vec.IsContiguous());
+   auto span = vec.GetSpan();
+   ASSERT_EQ(4u, span.size());
+   EXPECT_EQ(&vec[0], span.data());
+   EXPECT_FLOAT_EQ(22.f, span[3]);
+
+   EXPECT_TRUE(ra.IsContiguous());
+   EXPECT_EQ(3u, ra.GetSpan().size());
+   EXPECT_DOUBLE_EQ(3., ra.GetSpan()[2]);
+
+   // The elements of a std::vector<bool> are not addressable
+   EXPECT_FALSE(vb.IsContiguous());
+   EXPECT_TRUE(vb.GetSpan().empty());
+}
+
 TEST(TTreeReaderArray, MultiReaders)
 {
    // See https://root.cern.ch/phpBB3/viewtopic.php?f=3&t=22790
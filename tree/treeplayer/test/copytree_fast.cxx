@@ -0,0 +1,72 @@
+#include "TBranch.h"
+#include "TMemFile.h"
+#include "TTree.h"
+
+#include "gtest/gtest.h"
+
+#include <memory>
+#include <vector>
+
+TEST(TTreeCopyTree, FastSkim)
+{
+   TMemFile f("copytree_fast.root", "RECREATE");
+   {
+      TTree t("t", "t");
+      Int_t i = 0;
+      std::vector<float> v;
+      t.Branch("i", &i, "i/I");
+      t.Branch("v", &v);
+      t.SetAutoFlush(100);
+      for (i = 0; i < 1000; ++i) {
+         v.assign(i % 5, 0.5f * i);
+         t.Fill();
+      }
+      t.Write();
+   }
+
+   TTree *tree = nullptr;
+   f.GetObject("t", tree);
+   ASSERT_NE(tree, nullptr);
+   // The first three clusters are entirely selected
+   const char *selection = "i < 300 || i % 7 == 0";
+
+   TMemFile out("copytree_fast_out.root", "RECREATE");
+   std::unique_ptr<TTree> slow(tree->CopyTree(selection));
+   std::unique_ptr<TTree> fast(tree->CopyTree(selection, "fast"));
+   ASSERT_NE(slow, nullptr);
+   ASSERT_NE(fast, nullptr);
+   ASSERT_EQ(slow->GetEntries(), fast->GetEntries());
+   EXPECT_EQ(fast->GetEntries(), 300 + 100);
+
+   // The baskets of the selected clusters were copied as they are
+   TBranch *from = tree->GetBranch("v");
+   TBranch *to = fast->GetBranch("v");
+   for (Int_t b = 0; b < 3; ++b) {
+      EXPECT_EQ(to->GetBasketEntry()[b], from->GetBasketEntry()[b]);
+      EXPECT_EQ(to->GetBasketBytes()[b], from->GetBasketBytes()[b]);
+   }
+   auto clusters = fast->GetClusterIterator(0);
+   for (Long64_t start : {0, 100, 200, 300})
+      EXPECT_EQ(clusters(), start);
+
+   tree->ResetBranchAddresses();
+   Int_t si = -1, fi = -1;
+   std::vector<float> *sv = nullptr, *fv = nullptr;
+   slow->ResetBranchAddresses();
+   fast->ResetBranchAddresses();
+   slow->SetBranchAddress("i", &si);
+   slow->SetBranchAddress("v", &sv);
+   fast->SetBranchAddress("i", &fi);
+   fast->SetBranchAddress("v", &fv);
+   for (Long64_t e = 0; e < fast->GetEntries(); ++e) {
+      slow->GetEntry(e);
+      fast->GetEntry(e);
+      EXPECT_EQ(si, fi) << "entry " << e;
+      ASSERT_NE(fv, nullptr);
+      EXPECT_EQ(*sv, *fv) << "entry " << e;
+   }
+   fast->ResetBranchAddresses();
+   slow->ResetBranchAddresses();
+   delete sv;
+   delete fv;
+}
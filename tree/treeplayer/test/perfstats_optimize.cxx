@@ -0,0 +1,70 @@
+#include "TBranch.h"
+#include "TMemFile.h"
+#include "TTree.h"
+#include "TTreePerfStats.h"
+
+#include "gtest/gtest.h"
+
+#include <memory>
+
+TEST(TTreePerfStats, CloneOptimized)
+{
+   TMemFile f("perfstats_optimize.root", "RECREATE");
+   {
+      TTree t("t", "t");
+      Int_t a = 0;
+      Double_t b = 0;
+      Double_t c[50];
+      t.Branch("a", &a, "a/I");
+      t.Branch("b", &b, "b/D");
+      t.Branch("c", c, "c[50]/D");
+      t.SetBasketSize("*", 2000);
+      t.SetAutoFlush(1000);
+      for (Int_t i = 0; i < 20000; ++i) {
+         a = i;
+         b = 0.5 * i;
+         for (auto &x : c)
+            x = i;
+         t.Fill();
+      }
+      t.Write();
+   }
+
+   TTree *tree = nullptr;
+   f.GetObject("t", tree);
+   ASSERT_NE(tree, nullptr);
+   tree->SetCacheSize(1000000);
+   tree->SetBranchStatus("c", false);
+   TTreePerfStats ps("ioperf", tree);
+   Int_t a = -1;
+   Double_t b = -1;
+   tree->SetBranchAddress("a", &a);
+   tree->SetBranchAddress("b", &b);
+   for (Long64_t i = 0; i < tree->GetEntries(); ++i)
+      tree->GetEntry(i);
+   tree->SetBranchStatus("c", true);
+
+   TMemFile out("perfstats_optimize_out.root", "RECREATE");
+   std::unique_ptr<TTree> copy(ps.CloneOptimized());
+   ASSERT_NE(copy, nullptr);
+   EXPECT_EQ(copy->GetEntries(), tree->GetEntries());
+   // The cluster of the branches read fits in the cache, with one basket per branch
+   EXPECT_GT(copy->GetAutoFlush(), 1000);
+   EXPECT_LE(copy->GetAutoFlush(), 1000000 / 12);
+   EXPECT_LT(copy->GetBranch("a")->GetWriteBasket(), tree->GetBranch("a")->GetWriteBasket());
+   EXPECT_EQ(copy->GetBranch("a")->GetWriteBasket(), copy->GetBranch("c")->GetWriteBasket());
+
+   Int_t ca = -1;
+   Double_t cb = -1;
+   Double_t cc[50];
+   copy->SetBranchAddress("a", &ca);
+   copy->SetBranchAddress("b", &cb);
+   copy->SetBranchAddress("c", cc);
+   for (Long64_t i = 0; i < copy->GetEntries(); i += 997) {
+      copy->GetEntry(i);
+      EXPECT_EQ(ca, i);
+      EXPECT_DOUBLE_EQ(cb, 0.5 * i);
+      EXPECT_DOUBLE_EQ(cc[49], i);
+   }
+   tree->ResetBranchAddresses();
+}
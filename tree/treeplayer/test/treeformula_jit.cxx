@@ -0,0 +1,97 @@
+#include "TTree.h"
+#include "TTreeFormula.h"
+
+#include "gtest/gtest.h"
+
+#include <vector>
+
+namespace {
+
+struct CompiledModeRAII {
+   CompiledModeRAII() { TTreeFormula::SetCompiledMode(kTRUE); }
+   ~CompiledModeRAII() { TTreeFormula::SetCompiledMode(kFALSE); }
+};
+
+void FillTree(TTree &t)
+{
+   int n = 0;
+   float x[10];
+   double y = 0;
+   t.Branch("n", &n, "n/I");
+   t.Branch("x", x, "x[n]/F");
+   t.Branch("y", &y, "y/D");
+   for (int i = 0; i < 50; ++i) {
+      n = i % 10;
+      for (int j = 0; j < n; ++j)
+         x[j] = 0.5f * (i - j);
+      y = 0.1 * i - 2;
+      t.Fill();
+   }
+}
+
+std::vector<double> Evaluate(TTree &t, const char *expression, bool &isCompiled)
+{
+   std::vector<double> values;
+   TTreeFormula formula("f", expression, &t);
+   isCompiled = formula.IsCompiled();
+   for (Long64_t entry = 0; entry < t.GetEntries(); ++entry) {
+      t.LoadTree(entry);
+      const Int_t ndata = formula.GetNdata();
+      for (Int_t i = 0; i < ndata; ++i)
+         values.push_back(formula.EvalInstance(i));
+   }
+   return values;
+}
+
+} // anonymous namespace
+
+TEST(TTreeFormulaJit, SameResultsAsInterpreted)
+{
+   TTree t("t", "t");
+   t.SetDirectory(nullptr);
+   FillTree(t);
+
+   const char *expressions[] = {"y*2+1",
+                                "x*y-3",
+                                "sqrt(abs(y))+pow(y,2)",
+                                "y>0 && n>3",
+                                "y<0 || n==2",
+                                "y>0 ? x : -x",
+                                "Sum$(x)",
+                                "Length$(x)+n%3",
+                                "(n&1)|2"};
+   for (auto expression : expressions) {
+      bool isCompiled = false;
+      const auto interpreted = Evaluate(t, expression, isCompiled);
+      EXPECT_FALSE(isCompiled) << expression;
+      std::vector<double> compiled;
+      {
+         CompiledModeRAII compiledMode;
+         compiled = Evaluate(t, expression, isCompiled);
+      }
+      if (expression == expressions[0]) {
+         EXPECT_TRUE(isCompiled);
+      }
+      ASSERT_EQ(interpreted.size(), compiled.size()) << expression;
+      for (std::size_t i = 0; i < interpreted.size(); ++i)
+         EXPECT_DOUBLE_EQ(interpreted[i], compiled[i]) << expression << " instance " << i;
+   }
+}
+
+TEST(TTreeFormulaJit, Draw)
+{
+   TTree t("t", "t");
+   t.SetDirectory(nullptr);
+   FillTree(t);
+
+   const auto interpreted = t.Draw("x*y", "n>2 && y<1", "goff");
+   std::vector<double> values(t.GetV1(), t.GetV1() + interpreted);
+   Long64_t compiled = 0;
+   {
+      CompiledModeRAII compiledMode;
+      compiled = t.Draw("x*y", "n>2 && y<1", "goff");
+   }
+   ASSERT_EQ(interpreted, compiled);
+   for (Long64_t i = 0; i < compiled; ++i)
+      EXPECT_DOUBLE_EQ(values[i], t.GetV1()[i]);
+}
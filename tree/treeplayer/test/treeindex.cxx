@@ -0,0 +1,124 @@
+#include "TFile.h"
+#include "TROOT.h"
+#include "TSystem.h"
+#include "TTree.h"
+#include "TTreeIndex.h"
+
+#include "gtest/gtest.h"
+
+#include <map>
+#include <thread>
+#include <utility>
+#include <vector>
+
+static void FillRunEventTree(TTree &t, int n)
+{
+   int run, event;
+   t.Branch("run", &run);
+   t.Branch("event", &event);
+   for (int i = 0; i < n; ++i) {
+      // Entries are not ordered by (run, event) and some pairs appear twice.
+      run = (i * 7919) % 97;
+      event = (i * 104729) % (n / 2 + 1);
+      t.Fill();
+   }
+}
+
+static void CheckIndex(TTree &t, bool hashLookup = true)
+{
+   auto index = dynamic_cast<TTreeIndex *>(t.GetTreeIndex());
+   ASSERT_NE(index, nullptr);
+   index->SetHashLookup(hashLookup);
+   const Long64_t n = index->GetN();
+   ASSERT_EQ(n, t.GetEntries());
+
+   // The expected entry number for a pair is the one of its first occurrence in the sorted index.
+   std::map<std::pair<Long64_t, Long64_t>, Long64_t> expected;
+   for (Long64_t i = n - 1; i >= 0; --i)
+      expected[{index->GetIndexValues()[i], index->GetIndexValuesMinor()[i]}] = index->GetIndex()[i];
+
+   int run, event;
+   t.SetBranchAddress("run", &run);
+   t.SetBranchAddress("event", &event);
+   for (auto &e : expected) {
+      EXPECT_EQ(t.GetEntryNumberWithIndex(e.first.first, e.first.second), e.second);
+      ASSERT_GT(t.GetEntryWithIndex(e.first.first, e.first.second), 0);
+      EXPECT_EQ(run, e.first.first);
+      EXPECT_EQ(event, e.first.second);
+   }
+   EXPECT_EQ(t.GetEntryNumberWithIndex(97, 0), -1);
+   EXPECT_EQ(t.GetEntryNumberWithIndex(-1, 0), -1);
+}
+
+TEST(TTreeIndex, HashedLookup)
+{
+   const auto fname = "treeindex_hashedlookup.root";
+   {
+      TFile f(fname, "RECREATE");
+      TTree t("t", "t");
+      FillRunEventTree(t, 5000);
+      ASSERT_EQ(t.BuildIndex("run", "event"), 5000);
+      CheckIndex(t, false);
+      CheckIndex(t);
+      f.Write();
+   }
+   {
+      // The hash table is rebuilt for an index read from the file.
+      TFile f(fname);
+      auto t = f.Get<TTree>("t");
+      ASSERT_NE(t, nullptr);
+      CheckIndex(*t);
+   }
+   gSystem->Unlink(fname);
+}
+
+#ifdef R__USE_IMT
+TEST(TTreeIndex, ParallelSort)
+{
+   ROOT::EnableImplicitMT(4);
+   TTree t("t", "t");
+   t.SetDirectory(nullptr);
+   FillRunEventTree(t, 400000);
+   ASSERT_EQ(t.BuildIndex("run", "event"), 400000);
+   ROOT::DisableImplicitMT();
+
+   auto index = dynamic_cast<TTreeIndex *>(t.GetTreeIndex());
+   ASSERT_NE(index, nullptr);
+   const Long64_t *major = index->GetIndexValues();
+   const Long64_t *minor = index->GetIndexValuesMinor();
+   for (Long64_t i = 1; i < index->GetN(); ++i)
+      ASSERT_TRUE(major[i - 1] < major[i] || (major[i - 1] == major[i] && minor[i - 1] <= minor[i]));
+   CheckIndex(t);
+}
+#endif
+
+// Concurrent lookups in one index, the first of them building the hash table
+TEST(TTreeIndex, ConcurrentHashedLookup)
+{
+   TTree t("t", "t");
+   t.SetDirectory(nullptr);
+   FillRunEventTree(t, 20000);
+   ASSERT_EQ(t.BuildIndex("run", "event"), 20000);
+   auto index = dynamic_cast<TTreeIndex *>(t.GetTreeIndex());
+   ASSERT_NE(index, nullptr);
+
+   const Long64_t n = index->GetN();
+   std::vector<Long64_t> expected(n);
+   for (Long64_t i = 0; i < n; ++i)
+      expected[i] = index->GetEntryNumberWithIndex(index->GetIndexValues()[i], index->GetIndexValuesMinor()[i]);
+
+   index->SetHashLookup();
+   const int nThreads = 4;
+   std::vector<std::vector<Long64_t>> results(nThreads, std::vector<Long64_t>(n));
+   std::vector<std::thread> threads;
+   for (int i = 0; i < nThreads; ++i) {
+      threads.emplace_back([&, i]() {
+         for (Long64_t j = 0; j < n; ++j)
+            results[i][j] = index->GetEntryNumberWithIndex(index->GetIndexValues()[j], index->GetIndexValuesMinor()[j]);
+      });
+   }
+   for (auto &th : threads)
+      th.join();
+   for (int i = 0; i < nThreads; ++i)
+      EXPECT_EQ(results[i], expected);
+}
@@ -0,0 +1,110 @@
+#include <string>
+
+#include <TChain.h>
+#include <TFile.h>
+#include <TH2D.h>
+#include <TProfile.h>
+#include <TROOT.h>
+#include <TSystem.h>
+#include <TTree.h>
+
+#include "gtest/gtest.h"
+
+// Small clusters, so that the entries are processed by several tasks
+void WriteDrawMTFile(const char *filename, int first, int nentries)
+{
+   TFile file(filename, "recreate");
+   TTree t("t", "t");
+   t.SetAutoFlush(100);
+   int i = 0;
+   float x = 0.f;
+   float y[3];
+   int n = 0;
+   t.Branch("i", &i);
+   t.Branch("x", &x);
+   t.Branch("n", &n);
+   t.Branch("y", y, "y[n]/F");
+   for (i = first; i < first + nentries; ++i) {
+      x = (i % 97) * 0.1f;
+      n = i % 4;
+      for (int j = 0; j < n; ++j)
+         y[j] = (i % 13) + j * 0.5f;
+      t.Fill();
+   }
+   t.Write();
+}
+
+void ExpectSameHistograms(const TH1 &h1, const TH1 &h2)
+{
+   ASSERT_EQ(h1.GetNcells(), h2.GetNcells());
+   EXPECT_DOUBLE_EQ(h1.GetEntries(), h2.GetEntries());
+   for (int bin = 0; bin < h1.GetNcells(); ++bin) {
+      EXPECT_DOUBLE_EQ(h1.GetBinContent(bin), h2.GetBinContent(bin)) << "bin " << bin;
+      EXPECT_DOUBLE_EQ(h1.GetBinError(bin), h2.GetBinError(bin)) << "bin " << bin;
+   }
+   EXPECT_NEAR(h1.GetMean(), h2.GetMean(), 1e-12);
+   EXPECT_NEAR(h1.GetStdDev(), h2.GetStdDev(), 1e-12);
+}
+
+// Draw the same expressions sequentially and in parallel
+void CheckDrawMT(TTree &t)
+{
+   const char *exprs[] = {"x>>h%s(50,0,10)", "y:x>>h%s(20,0,10,20,0,20)", "y:x>>h%s(20,0,10)"};
+   const char *selection = "(i % 3 != 0) * (1 + n)";
+   const char *options[] = {"goff", "goff colz", "goff prof"};
+   for (int k = 0; k < 3; ++k) {
+      ROOT::DisableImplicitMT();
+      const auto seq = t.Draw(Form(exprs[k], "seq"), selection, options[k]);
+      ROOT::EnableImplicitMT(4);
+      const auto mt = t.Draw(Form(exprs[k], "mt"), selection, options[k]);
+      ROOT::DisableImplicitMT();
+      EXPECT_EQ(seq, mt);
+      auto hseq = static_cast<TH1 *>(gDirectory->Get("hseq"));
+      auto hmt = static_cast<TH1 *>(gDirectory->Get("hmt"));
+      ASSERT_NE(hseq, nullptr);
+      ASSERT_NE(hmt, nullptr);
+      ExpectSameHistograms(*hseq, *hmt);
+      delete hseq;
+      delete hmt;
+   }
+}
+
+TEST(TTreeDrawMT, Tree)
+{
+   const char *filename = "treeplayer_drawmt_tree.root";
+   WriteDrawMTFile(filename, 0, 5000);
+   {
+      TFile file(filename);
+      auto t = file.Get<TTree>("t");
+      t->SetEstimate(1000);
+      CheckDrawMT(*t);
+
+      // aliases and weights of the tree are used by the tasks
+      t->SetAlias("z", "2 * x");
+      t->SetWeight(0.5);
+      ROOT::EnableImplicitMT(4);
+      TH1D hmt("hmt", "", 50, 0, 20);
+      t->Project("hmt", "z", "i % 2");
+      ROOT::DisableImplicitMT();
+      TH1D hseq("hseq", "", 50, 0, 20);
+      t->Project("hseq", "z", "i % 2");
+      ExpectSameHistograms(hseq, hmt);
+   }
+   gSystem->Unlink(filename);
+}
+
+TEST(TTreeDrawMT, Chain)
+{
+   const std::string filenames[] = {"treeplayer_drawmt_chain0.root", "treeplayer_drawmt_chain1.root"};
+   WriteDrawMTFile(filenames[0].c_str(), 0, 3000);
+   WriteDrawMTFile(filenames[1].c_str(), 3000, 2000);
+   {
+      TChain c("t");
+      for (const auto &filename : filenames)
+         c.Add(filename.c_str());
+      c.SetEstimate(1000);
+      CheckDrawMT(c);
+   }
+   for (const auto &filename : filenames)
+      gSystem->Unlink(filename.c_str());
+}
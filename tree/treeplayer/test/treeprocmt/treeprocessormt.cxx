@@ -1,7 +1,9 @@
 #include <algorithm>
 #include <atomic>
 #include <chrono>
+#include <numeric>
 #include <random>
+#include <set>
 #include <string>
 #include <thread>
 #include <utility>
@@ -362,6 +364,88 @@ TEST(TreeProcessorMT, LimitNTasks_CheckClusters)
    gSystem->Unlink(filename);
 }
 
+TEST(TreeProcessorMT, LimitNTasks_SkewedFiles)
+{
+   // one large file with many clusters and many files with a single entry: the large file must still be split
+   // in about as many tasks as if it was processed alone
+   const auto nBigEvents = 500u;
+   const auto nSmallFiles = 9u;
+   const auto treename = "t";
+   std::vector<std::string> filenames{"TreeProcessorMT_LimitNTasks_SkewedFiles_big.root"};
+   WriteFileManyClusters(nBigEvents, treename, filenames[0].c_str());
+   for (auto i = 0u; i < nSmallFiles; ++i) {
+      filenames.emplace_back("TreeProcessorMT_LimitNTasks_SkewedFiles_" + std::to_string(i) + ".root");
+      WriteFileManyClusters(1u, treename, filenames.back().c_str());
+   }
+
+   std::mutex m;
+   auto nTasksBigFile = 0u;
+   auto nEntries = 0u;
+   auto f = [&](TTreeReader &r) {
+      auto n = 0u;
+      while (r.Next())
+         ++n;
+      std::lock_guard<std::mutex> lg(m);
+      nEntries += n;
+      if (filenames[0] == r.GetTree()->GetCurrentFile()->GetName())
+         ++nTasksBigFile;
+   };
+
+   const unsigned int nslots = std::min(4U, std::thread::hardware_concurrency());
+   ROOT::EnableImplicitMT(nslots);
+
+   std::vector<std::string_view> filenamesViews(filenames.begin(), filenames.end());
+   ROOT::TTreeProcessorMT p(filenamesViews, treename);
+   p.Process(f);
+
+   const auto nEventsTotal = nBigEvents + nSmallFiles;
+   const auto maxTasks = ROOT::TTreeProcessorMT::GetTasksPerWorkerHint() * nslots;
+   EXPECT_EQ(nEntries, nEventsTotal);
+   EXPECT_EQ(nTasksBigFile, (maxTasks * nBigEvents + nEventsTotal - 1) / nEventsTotal);
+
+   DeleteFiles(filenames);
+   ROOT::DisableImplicitMT();
+}
+
+TEST(TreeProcessorMT, EntryRange)
+{
+   std::vector<std::string> filenames;
+   for (auto i = 0u; i < 4u; ++i)
+      filenames.emplace_back("TreeProcessorMT_EntryRange_" + std::to_string(i) + ".root");
+   WriteFiles(std::vector<std::string>(filenames.size(), "t"), filenames);
+   // the last file is after the end of the range: it must not even be opened
+   gSystem->Unlink(filenames.back().c_str());
+
+   std::mutex m;
+   std::vector<int> values;
+   std::set<std::string> filesProcessed;
+   auto f = [&](TTreeReader &r) {
+      TTreeReaderValue<int> v(r, "v");
+      std::lock_guard<std::mutex> lg(m);
+      while (r.Next()) {
+         // global entry numbers, v is the entry number plus one
+         EXPECT_EQ(*v, r.GetCurrentEntry() + 1);
+         values.emplace_back(*v);
+      }
+      filesProcessed.insert(r.GetTree()->GetCurrentFile()->GetName());
+   };
+
+   ROOT::EnableImplicitMT(std::min(4U, std::thread::hardware_concurrency()));
+   std::vector<std::string_view> filenamesViews(filenames.begin(), filenames.end());
+   ROOT::TTreeProcessorMT p(filenamesViews, "t");
+   p.SetEntryRange(12, 25);
+   p.Process(f);
+   ROOT::DisableImplicitMT();
+
+   std::sort(values.begin(), values.end());
+   std::vector<int> expected(13);
+   std::iota(expected.begin(), expected.end(), 13);
+   EXPECT_EQ(values, expected);
+   EXPECT_EQ(filesProcessed, std::set<std::string>({filenames[1], filenames[2]}));
+
+   DeleteFiles({filenames[0], filenames[1], filenames[2]});
+}
+
 TEST(TreeProcessorMT, TreeWithFriendTree)
 {
    std::vector<std::string> fileNames = {"TreeWithFriendTree_Tree.root", "TreeWithFriendTree_Friend.root"};
@@ -394,6 +478,60 @@ TEST(TreeProcessorMT, TreeWithFriendTree)
    ROOT::DisableImplicitMT();
 }
 
+TEST(TreeProcessorMT, FriendWithDifferentClusters)
+{
+   // The tasks start at cluster boundaries of both the main tree (clusters of 10 entries) and its friend (30 entries)
+   std::vector<std::string> fileNames = {"FriendWithDifferentClusters_Tree.root",
+                                         "FriendWithDifferentClusters_Friend.root"};
+   const int clusterSizes[] = {10, 30};
+   for (auto i = 0u; i < fileNames.size(); ++i) {
+      TFile f(fileNames[i].c_str(), "RECREATE");
+      TTree t("t", "t");
+      int v = 0;
+      t.Branch("v", &v);
+      t.SetAutoFlush(clusterSizes[i]);
+      for (v = 0; v < 120; ++v)
+         t.Fill();
+      t.Write();
+   }
+
+   std::mutex m;
+   std::vector<std::pair<Long64_t, Long64_t>> ranges;
+   auto nEntries = 0u;
+   auto f = [&](TTreeReader &r) {
+      TTreeReaderValue<int> v(r, "v");
+      TTreeReaderValue<int> fv(r, "friend.v");
+      auto n = 0u;
+      while (r.Next()) {
+         EXPECT_EQ(*v, *fv);
+         ++n;
+      }
+      std::lock_guard<std::mutex> lg(m);
+      nEntries += n;
+      ranges.emplace_back(r.GetEntriesRange());
+   };
+
+   ROOT::EnableImplicitMT(2);
+   {
+      TFile f1(fileNames[0].c_str());
+      auto t1 = f1.Get<TTree>("t");
+      TFile f2(fileNames[1].c_str());
+      auto t2 = f2.Get<TTree>("t");
+      t1->AddFriend(t2, "friend");
+
+      ROOT::TTreeProcessorMT tp(*t1);
+      tp.Process(f);
+   }
+
+   EXPECT_EQ(nEntries, 120u);
+   EXPECT_GE(ranges.size(), 2u);
+   for (const auto &range : ranges)
+      EXPECT_EQ(range.first % 30, 0) << "task starting at entry " << range.first;
+
+   DeleteFiles(fileNames);
+   ROOT::DisableImplicitMT();
+}
+
 TEST(TreeProcessorMT, ChainWithFriendChain)
 {
    std::vector<std::string> fileNames = {"ChainWithFriendChain_Tree1.root", "ChainWithFriendChain_Tree2.root", "ChainWithFriendChain_Friend1.root", "ChainWithFriendChain_Friend2.root"};
@@ -26,7 +26,7 @@ public:
 RVec_UponCopyPrinter = ROOT.ROOT.VecOps.RVec(ROOT.UponCopyPrinter)
 
 # One of the essential features of RVec is its ability of adopting and owning memory.
-# Internally this is handled by the ROOT::Detail::VecOps::RAdoptAllocator class.
+# Small owning RVecs store their elements inline, larger ones on the heap.
 
 # Let's create an RVec of UponCopyPrinter instances. We expect no printout:
 v = RVec_UponCopyPrinter(3)
@@ -38,7 +38,7 @@ v2 = RVec_UponCopyPrinter(v.data(), v.size())
 print("%s and %s" %(v.data(), v2.data()))
 
 # Now, upon reallocation, the RVec stops adopting the memory and starts owning it. And yes,
-# a copy is triggered. Indeed internally the storage of the RVec is an std::vector. Moreover,
+# a copy is triggered: the adopted memory belongs to someone else, its content is not moved. Moreover,
 # the interface of the RVec is very, very similar to the one of std::vector: you have already
 # noticed it when the `data()` method was invoked, right?
 v2.resize(4)
@@ -384,21 +384,25 @@ sap.ui.define(['rootui5/eve7/lib/EveManager'], function(EveManager) {
       {
          vBuff = rnr_data.vtxBuff;
       }
-      else if (boxset.boxType == 2) // axis aligned
+      else if (boxset.boxType == 2 || boxset.boxType == 3) // axis aligned, fixed dimensions are sent as instances
       {
-         let N = rnr_data.vtxBuff.length/6;
+         let instanced = (boxset.boxType == 3);
+         let pos = instanced ? rnr_data.instBuff : rnr_data.vtxBuff;
+         let stride = instanced ? 3 : 6;
+         let N = pos.length/stride;
          vBuff = new Float32Array(N*8*3);
 
          let off = 0;
          for (let i = 0; i < N; ++i)
          {
-            let rdoff = i*6;
-            let x  =  rnr_data.vtxBuff[rdoff];
-            let y  =  rnr_data.vtxBuff[rdoff + 1];
-            let z  =  rnr_data.vtxBuff[rdoff + 2];
-            let dx =  rnr_data.vtxBuff[rdoff + 3];
-            let dy =  rnr_data.vtxBuff[rdoff + 4];
-            let dz =  rnr_data.vtxBuff[rdoff + 5];
+            let rdoff = i*stride;
+            let dimoff = instanced ? 0 : rdoff + 3;
+            let x  =  pos[rdoff];
+            let y  =  pos[rdoff + 1];
+            let z  =  pos[rdoff + 2];
+            let dx =  rnr_data.vtxBuff[dimoff];
+            let dy =  rnr_data.vtxBuff[dimoff + 1];
+            let dz =  rnr_data.vtxBuff[dimoff + 2];
 
             // top
             vBuff[off  ] = x;      vBuff[off + 1] = y + dy; vBuff[off + 2] = z;
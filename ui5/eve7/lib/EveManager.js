@@ -479,9 +479,24 @@ sap.ui.define([], function() {
             off += rd.index_size*4;
          }
 
+         if (rd.inst_size) {
+            rd.instBuff = new Float32Array(rawdata, off, rd.inst_size);
+            off += rd.inst_size*4;
+         }
+
          lastoff = off;
       }
 
+      // visibility-only changes, pairs of element id and rnr-self / rnr-children bits
+      let hdr = this.scene_changes ? this.scene_changes.header : null;
+      if (hdr && hdr.numVisibilityChanges) {
+         let vis = new Uint32Array(rawdata, offset + hdr.visibilityOffset, 2*hdr.numVisibilityChanges);
+         for (let i = 0; i < vis.length; i += 2)
+            this.scene_changes.arr.push({ fElementId: vis[i], changeBit: this.EChangeBits.kCBVisibility,
+                                          fRnrSelf: (vis[i+1] & 1) != 0, fRnrChildren: (vis[i+1] & 2) != 0 });
+         lastoff = offset + hdr.visibilityOffset + vis.byteLength;
+      }
+
       if (lastoff !== rawdata.byteLength)
          console.error('Raw data decoding error - length mismatch', lastoff, rawdata.byteLength);
 